@@ -0,0 +1,225 @@
+// Microbenchmarks of the hot paths the other benchmarks only reach as a
+// whole: command dispatch, handler delegates, scripts, word wrapping, the
+// scrollback and the input history. Each reports the heap allocations it makes per operation
+// as allocs_per_op.
+//
+//   mud_bench [--benchmark_filter=REGEX] [--benchmark_format=json] ...
+//
+// The bench-json target runs everything and writes mud_bench.json beside
+// the binaries, to keep and compare between builds.
+
+#include "../include/CommandLineEditor.h"
+#include "../include/ConsoleUI.h"
+#include "../include/GameEngine.h"
+#include "../include/InlineDelegate.h"
+#include "../include/TextWrap.h"
+#ifdef ENABLE_LUA_SCRIPTING
+#include "../include/ScriptRunner.h"
+#endif
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// Count every allocation made through operator new
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Allocations from construction to report(), as a per-iteration counter
+class AllocationCounter {
+public:
+    AllocationCounter() : m_start(g_allocations.load(std::memory_order_relaxed)) {}
+
+    void report(benchmark::State& state) const {
+        const std::size_t allocations = g_allocations.load(std::memory_order_relaxed) - m_start;
+        state.counters["allocs_per_op"] =
+            benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    std::size_t m_start;
+};
+
+// Combat-style output: varied lengths, color codes, some long enough to wrap
+std::string makeMessage(std::size_t i) {
+    static const char* kVerbs[] = {"hits", "misses", "slashes", "parries", "casts a spell at"};
+    std::string message = "{rThe goblin{x " + std::string(kVerbs[i % 5]) + " you";
+    if (i % 3 == 0) {
+        message += " \x1b[1;33mfor " + std::to_string(i % 97) + " damage\x1b[0m";
+    }
+    if (i % 7 == 0) {
+        message += ". The blow glances off your shield and the crowd roars while dust swirls"
+                   " around the arena floor in slow, lazy spirals";
+    }
+    return message;
+}
+
+// A command with its arguments, dispatched as the console does
+void BM_HandleCommand(benchmark::State& state, const char* command, const char* args) {
+    auto engine = GameEngine::create("Bench");
+    // The first call registers what is lazily registered and warms the caches
+    engine->handleCommand(command, args);
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine->handleCommand(command, args));
+    }
+    allocations.report(state);
+}
+BENCHMARK_CAPTURE(BM_HandleCommand, look, "look", "");
+BENCHMARK_CAPTURE(BM_HandleCommand, inventory, "inventory", "");
+BENCHMARK_CAPTURE(BM_HandleCommand, alias, "l", "");
+BENCHMARK_CAPTURE(BM_HandleCommand, unknown, "dance", "wildly");
+#ifdef ENABLE_LUA_SCRIPTING
+// say.lua replaces the built-in say where scripting is compiled in
+BENCHMARK_CAPTURE(BM_HandleCommand, say_script, "say", "Has anyone seen the rat?");
+#else
+BENCHMARK_CAPTURE(BM_HandleCommand, say, "say", "Has anyone seen the rat?");
+#endif
+
+// A handler made and called once, as each script command's is at boot, in
+// the engine's InlineDelegate and in the std::function it replaced. The
+// capture is four pointers: within the delegate, past what libstdc++'s and
+// libc++'s std::function keep inline
+using DelegateHandler = InlineDelegate<int(int)>;
+using FunctionHandler = std::function<int(int)>;
+
+template <typename Handler>
+void BM_MakeHandler(benchmark::State& state) {
+    int counts[4] = {1, 2, 3, 4};
+    int argument = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        Handler handler([a = &counts[0], b = &counts[1], c = &counts[2], d = &counts[3]](int x) {
+            return *a + *b + *c + *d + x;
+        });
+        benchmark::DoNotOptimize(handler(++argument));
+    }
+    allocations.report(state);
+}
+BENCHMARK_TEMPLATE(BM_MakeHandler, DelegateHandler);
+BENCHMARK_TEMPLATE(BM_MakeHandler, FunctionHandler);
+
+// A call through a handler made once, as dispatch makes
+template <typename Handler>
+void BM_CallHandler(benchmark::State& state) {
+    int counts[4] = {1, 2, 3, 4};
+    const Handler handler([a = &counts[0], b = &counts[1], c = &counts[2], d = &counts[3]](int x) {
+        return *a + *b + *c + *d + x;
+    });
+    int argument = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handler(++argument));
+    }
+}
+BENCHMARK_TEMPLATE(BM_CallHandler, DelegateHandler);
+BENCHMARK_TEMPLATE(BM_CallHandler, FunctionHandler);
+
+#ifdef ENABLE_LUA_SCRIPTING
+// A script called by name, with no engine around it
+void BM_ScriptRunnerRunCommand(benchmark::State& state) {
+    ScriptRunner runner;
+    if (!runner.loadScript("say", std::filesystem::path(ECHOMUD_SCRIPT_DIR) / "say.lua")) {
+        state.SkipWithError("Could not load say.lua");
+        return;
+    }
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runner.runCommand("say", "Has anyone seen the rat?"));
+    }
+    allocations.report(state);
+}
+BENCHMARK(BM_ScriptRunnerRunCommand);
+#endif
+
+// Wrapping a message of range(0) bytes to 80 columns, measured once as the
+// scrollback does
+void BM_WrapText(benchmark::State& state, bool ascii) {
+    const std::string word = ascii ? "lantern " : "l\xC3\xA4ntern ";   // "lantern" with an a-umlaut
+    std::string text;
+    while (text.size() < static_cast<std::size_t>(state.range(0))) {
+        text += word;
+    }
+    const TextMetrics metrics = TextWrap::measure(text);
+    std::vector<WrapSpan> rows;
+    rows.reserve(text.size() / 40 + 1);
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        rows.clear();
+        TextWrap::wrap(text, 80, rows, metrics);
+        benchmark::DoNotOptimize(rows.data());
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_WrapText, ascii, true)->Arg(60)->Arg(1000)->Arg(64 << 10);
+BENCHMARK_CAPTURE(BM_WrapText, utf8, false)->Arg(60)->Arg(1000)->Arg(64 << 10);
+
+// A message into a scrollback already full, so each evicts the oldest
+void BM_AddOutputMessage(benchmark::State& state) {
+    auto ui = ConsoleUI::createHeadless(50, 120);
+    if (!ui) {
+        state.SkipWithError("Could not create a headless screen");
+        return;
+    }
+    std::vector<std::string> messages;
+    for (std::size_t i = 0; i < 64; ++i) {
+        messages.push_back(makeMessage(i));
+    }
+    for (std::size_t i = 0; i < ui->scrollbackCapacity(); ++i) {
+        ui->addOutputMessage(messages[i % messages.size()]);
+    }
+    std::size_t next = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        ui->addOutputMessage(messages[next++ % messages.size()]);
+    }
+    allocations.report(state);
+}
+BENCHMARK(BM_AddOutputMessage);
+
+// A command into a history ring already full; with range(0), appended to a
+// history file too
+void BM_AddToHistory(benchmark::State& state) {
+    CommandLineEditor editor(80, nullptr);
+    const std::filesystem::path file = std::filesystem::temp_directory_path() / "mud_bench_history";
+    std::filesystem::remove(file);
+    if (state.range(0) != 0 && !editor.openHistoryFile(file)) {
+        state.SkipWithError("Could not open the history file");
+        return;
+    }
+    const std::string commands[] = {"look", "north", "get lantern", "say Has anyone seen the rat?"};
+    for (std::size_t i = 0; i < editor.getHistory().capacity(); ++i) {
+        editor.addToHistory(commands[i % std::size(commands)]);
+    }
+    std::size_t next = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        // Never the same twice running, which would not be added
+        benchmark::DoNotOptimize(editor.addToHistory(commands[next++ % std::size(commands)]));
+    }
+    allocations.report(state);
+    std::filesystem::remove(file);
+}
+BENCHMARK(BM_AddToHistory)->ArgName("file")->Arg(0)->Arg(1);
+
+} // namespace
+
+BENCHMARK_MAIN();
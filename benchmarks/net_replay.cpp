@@ -0,0 +1,339 @@
+// Server replay benchmark: connects a crowd of telnet clients to net_server
+// and has each play the same short session over and over, reporting how
+// many commands were answered and how long replies took. It is also the
+// training run the pgo-train target profiles the server with.
+//
+//   net_replay [--clients N] [--rounds N] [--port N] [--results FILE] [-- SERVER [ARGS...]]
+//
+// --results also writes the figures to FILE, one "net_replay MEASURE VALUE"
+// a line, for perf_compare to hold against the stored baselines.
+//
+// Given a server command line it starts that server on the port, on
+// 127.0.0.1, and stops it with SIGINT once every client has quit, so an
+// instrumented build gets to write its profile; otherwise it plays against
+// a server already listening there.
+
+#include "../include/LatencyHistogram.h"
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// One round: moving, talking, picking things up and looking around, with a
+// command sequence and a speedwalk among them
+constexpr std::string_view kScript[] = {
+    "look", "north", "get lantern", "inventory", "say Has anyone seen the rat?",
+    "drop lantern", "l;inventory", "south", "n1s", "help",
+};
+
+constexpr std::string_view kNamePrompt = "known? ";
+constexpr std::string_view kPrompt = "> ";
+// Telnet IAC DO GMCP, which every fourth client sends so out-of-band data is played too
+constexpr std::string_view kDoGmcp = "\xFF\xFD\xC9";
+constexpr auto kStallTimeout = std::chrono::seconds(10);
+
+enum class Stage { Naming, Entering, Playing, Leaving };
+
+struct Client {
+    int fd = -1;
+    Stage stage = Stage::Naming;
+    std::string name;
+    std::string unread;      // Received since the last prompt, to spot one split across reads
+    std::size_t step = 0;
+    Clock::time_point sent;
+};
+
+struct Totals {
+    LatencyHistogram replies;
+    std::uint64_t bytes = 0;
+};
+
+// Names are letters only: Replay, then the index in base 26
+std::string clientName(std::size_t index) {
+    std::string name = "Replay";
+    do {
+        name += static_cast<char>('a' + index % 26);
+        index /= 26;
+    } while (index > 0);
+    return name;
+}
+
+int connectTo(std::uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof address) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    const int on = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+bool sendLine(Client& client, std::string_view line) {
+    std::string out(line);
+    out += "\r\n";
+    client.sent = Clock::now();
+    // A line is far smaller than the socket buffer, which nothing else fills
+    return ::send(client.fd, out.data(), out.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(out.size());
+}
+
+// Whether what came since the last prompt holds another; only the end of
+// it is kept, enough to find a prompt the next read completes
+bool prompted(Client& client, std::string_view prompt) {
+    if (client.unread.find(prompt) != std::string::npos) {
+        client.unread.clear();
+        return true;
+    }
+    if (client.unread.size() >= prompt.size()) {
+        client.unread.erase(0, client.unread.size() - prompt.size() + 1);
+    }
+    return false;
+}
+
+// Move the client's session on a step if a prompt has come
+bool advance(Client& client, std::size_t commands, Totals& totals) {
+    switch (client.stage) {
+        case Stage::Naming:
+            if (!prompted(client, kNamePrompt)) {
+                return true;
+            }
+            client.stage = Stage::Entering;
+            return sendLine(client, client.name);
+        case Stage::Entering:
+        case Stage::Playing:
+            if (!prompted(client, kPrompt)) {
+                return true;
+            }
+            // Someone else's arrival or speech can end in a prompt too; it
+            // only ever makes a reply look sooner than it was
+            if (client.stage == Stage::Playing) {
+                totals.replies.record(Clock::now() - client.sent);
+            }
+            client.stage = Stage::Playing;
+            if (client.step == commands) {
+                client.stage = Stage::Leaving;
+                return sendLine(client, "quit");
+            }
+            return sendLine(client, kScript[client.step++ % std::size(kScript)]);
+        case Stage::Leaving:
+            return true;
+    }
+    return true;
+}
+
+// Start the server on port with the arguments given after --; 0 on failure
+pid_t spawnServer(char** command, std::uint16_t port) {
+    std::vector<char*> argv;
+    for (char** argument = command; *argument; ++argument) {
+        argv.push_back(*argument);
+    }
+    std::string portArgument = std::to_string(port);
+    std::string host = "127.0.0.1";
+    argv.push_back(portArgument.data());
+    argv.push_back(host.data());
+    argv.push_back(nullptr);
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        ::execvp(argv[0], argv.data());
+        std::fprintf(stderr, "Could not run %s: %s\n", argv[0], std::strerror(errno));
+        ::_exit(127);
+    }
+    if (pid < 0) {
+        return 0;
+    }
+    // Until it listens, or gives up
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (const int fd = connectTo(port); fd >= 0) {
+            ::close(fd);
+            return pid;
+        }
+        int status = 0;
+        if (::waitpid(pid, &status, WNOHANG) == pid) {
+            return 0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    ::kill(pid, SIGKILL);
+    ::waitpid(pid, nullptr, 0);
+    return 0;
+}
+
+bool stopServer(pid_t pid) {
+    ::kill(pid, SIGINT);
+    int status = 0;
+    if (::waitpid(pid, &status, 0) != pid) {
+        return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+bool writeResults(const char* path, const Totals& totals, double seconds) {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    std::fprintf(file, "net_replay replies_per_second %.1f\n", static_cast<double>(totals.replies.count()) / seconds);
+    std::fprintf(file, "net_replay p50_ms %.3f\n", milliseconds(totals.replies.percentile(0.5)));
+    std::fprintf(file, "net_replay p90_ms %.3f\n", milliseconds(totals.replies.percentile(0.9)));
+    std::fprintf(file, "net_replay p99_ms %.3f\n", milliseconds(totals.replies.percentile(0.99)));
+    return std::fclose(file) == 0;
+}
+
+bool parseCount(const char* text, std::size_t& value) {
+    const std::string_view view = text;
+    return std::from_chars(view.data(), view.data() + view.size(), value).ec == std::errc() && value > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t clientCount = 64;
+    std::size_t rounds = 10;
+    std::size_t port = 4000;
+    char** server = nullptr;
+    const char* resultsFile = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--") {
+            if (i + 1 < argc) {
+                server = argv + i + 1;
+            }
+            break;
+        }
+        if (arg == "--results" && i + 1 < argc) {
+            resultsFile = argv[++i];
+            continue;
+        }
+        std::size_t* value = arg == "--clients" ? &clientCount
+                             : arg == "--rounds" ? &rounds
+                             : arg == "--port"   ? &port
+                                                 : nullptr;
+        if (!value || i + 1 == argc || !parseCount(argv[++i], *value) || (value == &port && port > 65535)) {
+            std::fprintf(stderr, "Usage: net_replay [--clients N] [--rounds N] [--port N] [--results FILE] "
+                                 "[-- SERVER [ARGS...]]\n");
+            return 1;
+        }
+    }
+
+    pid_t pid = 0;
+    if (server) {
+        pid = spawnServer(server, static_cast<std::uint16_t>(port));
+        if (pid == 0) {
+            std::fprintf(stderr, "The server did not start listening on port %zu\n", port);
+            return 1;
+        }
+    }
+
+    std::vector<Client> clients(clientCount);
+    for (std::size_t i = 0; i < clients.size(); ++i) {
+        clients[i].fd = connectTo(static_cast<std::uint16_t>(port));
+        if (clients[i].fd < 0) {
+            std::fprintf(stderr, "Could not connect client %zu: %s\n", i, std::strerror(errno));
+            return 1;
+        }
+        clients[i].name = clientName(i);
+        if (i % 4 == 3) {
+            ::send(clients[i].fd, kDoGmcp.data(), kDoGmcp.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    const std::size_t commands = rounds * std::size(kScript);
+    Totals totals;
+    std::vector<pollfd> ready(clients.size());
+    std::size_t open = clients.size();
+    bool stalled = false;
+    const auto start = Clock::now();
+    char buffer[16 * 1024];
+    while (open > 0) {
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            ready[i] = {clients[i].fd, POLLIN, 0};
+        }
+        const int events = ::poll(ready.data(), ready.size(),
+                                  static_cast<int>(std::chrono::milliseconds(kStallTimeout).count()));
+        if (events == 0) {
+            stalled = true;
+            break;
+        }
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            Client& client = clients[i];
+            if (client.fd < 0 || ready[i].revents == 0) {
+                continue;
+            }
+            const ssize_t got = ::recv(client.fd, buffer, sizeof buffer, 0);
+            if (got < 0 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+            if (got > 0) {
+                totals.bytes += static_cast<std::uint64_t>(got);
+                client.unread.append(buffer, static_cast<std::size_t>(got));
+                if (advance(client, commands, totals)) {
+                    continue;
+                }
+            }
+            // The server closes the connection once the client quits
+            stalled |= client.stage != Stage::Leaving;
+            ::close(client.fd);
+            client.fd = -1;
+            --open;
+        }
+    }
+    const auto elapsed = Clock::now() - start;
+
+    // The replies a client's prompt still waits on count as lost with it
+    for (Client& client : clients) {
+        if (client.fd >= 0) {
+            ::close(client.fd);
+        }
+    }
+    const bool stopped = pid == 0 || stopServer(pid);
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%zu clients, %llu replies in %.2f s (%.0f per second), %llu bytes received\n", clients.size(),
+                static_cast<unsigned long long>(totals.replies.count()), seconds,
+                static_cast<double>(totals.replies.count()) / seconds, static_cast<unsigned long long>(totals.bytes));
+    std::printf("reply time: p50 %.3f ms  p90 %.3f ms  p99 %.3f ms  max %.3f ms\n",
+                milliseconds(totals.replies.percentile(0.5)), milliseconds(totals.replies.percentile(0.9)),
+                milliseconds(totals.replies.percentile(0.99)), milliseconds(totals.replies.max()));
+    if (resultsFile && !writeResults(resultsFile, totals, seconds)) {
+        std::fprintf(stderr, "Could not write %s: %s\n", resultsFile, std::strerror(errno));
+        return 1;
+    }
+    if (stalled) {
+        std::fprintf(stderr, "Some clients stopped getting replies before they were done\n");
+    }
+    if (!stopped) {
+        std::fprintf(stderr, "The server did not shut down cleanly\n");
+    }
+    return stalled || !stopped ? 1 : 0;
+}
@@ -0,0 +1,232 @@
+// Holds benchmark results against the baselines kept in the tree and fails
+// when any has got worse by more than the tolerance. The perf-regress target
+// runs mud_bench and a short net_replay and then this; perf-baseline runs
+// the same with --record, to write what was measured back as the baselines.
+//
+//   perf_compare BASELINE [--tolerance PERCENT] [--record] RESULTS...
+//
+// A results file is either mud_bench's CSV (--benchmark_out_format=csv),
+// of which the medians are taken when it ran repetitions, or lines of
+// "BENCHMARK MEASURE VALUE" as net_replay --results writes them. Baselines
+// are lines of the same kind; # starts a comment. Times are in nanoseconds.
+// A measure ending in _per_second is better higher, any other lower, so a
+// baseline of 0 allocs_per_op fails on any allocation at all.
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Benchmark name, then measure
+using Key = std::pair<std::string, std::string>;
+using Results = std::map<Key, double>;
+
+// What --record keeps of mud_bench's columns
+constexpr std::string_view kRecordedColumns[] = {"real_time", "allocs_per_op"};
+
+bool endsWith(std::string_view text, std::string_view suffix) {
+    return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+}
+
+bool parseNumber(std::string_view text, double& value) {
+    return !text.empty() && std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc();
+}
+
+// One CSV row, with Google Benchmark's quoting: fields in double quotes,
+// and a quote doubled inside them
+std::vector<std::string> splitCsv(std::string_view line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (c == '"') {
+            if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else {
+                quoted = !quoted;
+            }
+        } else if (c == ',' && !quoted) {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+double nanosecondsPer(std::string_view unit) {
+    return unit == "us" ? 1e3 : unit == "ms" ? 1e6 : unit == "s" ? 1e9 : 1.0;
+}
+
+// mud_bench's CSV; each benchmark's median when there are aggregates
+bool readCsv(std::istream& in, const std::string& header, Results& results) {
+    const std::vector<std::string> columns = splitCsv(header);
+    std::size_t timeUnit = columns.size();
+    std::size_t errorOccurred = columns.size();
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        timeUnit = columns[i] == "time_unit" ? i : timeUnit;
+        errorOccurred = columns[i] == "error_occurred" ? i : errorOccurred;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::vector<std::string> fields = splitCsv(line);
+        std::string name = fields[0];
+        if (fields.size() != columns.size() || endsWith(name, "_mean") || endsWith(name, "_stddev") ||
+            endsWith(name, "_cv")) {
+            continue;
+        }
+        if (errorOccurred < fields.size() && fields[errorOccurred] == "true") {
+            std::printf("  skipped  %s: it did not run\n", name.c_str());
+            continue;
+        }
+        if (endsWith(name, "_median")) {
+            name.resize(name.size() - std::string_view("_median").size());
+        }
+        const double scale = timeUnit < fields.size() ? nanosecondsPer(fields[timeUnit]) : 1.0;
+        for (const std::string_view column : kRecordedColumns) {
+            for (std::size_t i = 0; i < columns.size(); ++i) {
+                double value = 0;
+                if (columns[i] == column && parseNumber(fields[i], value)) {
+                    results[{name, columns[i]}] = column == "real_time" ? value * scale : value;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Lines of BENCHMARK MEASURE VALUE; comments kept for --record to write back
+bool readTriples(std::istream& in, std::string line, Results& results, std::vector<std::string>* comments) {
+    do {
+        if (line.empty() || line[0] == '#') {
+            if (comments) {
+                comments->push_back(line);
+            }
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string name;
+        std::string measure;
+        std::string value;
+        double number = 0;
+        if (!(fields >> name >> measure >> value) || !parseNumber(value, number)) {
+            std::fprintf(stderr, "Not a result: %s\n", line.c_str());
+            return false;
+        }
+        results[{name, measure}] = number;
+    } while (std::getline(in, line));
+    return true;
+}
+
+bool readFile(const char* path, Results& results, std::vector<std::string>* comments = nullptr) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "Could not read %s\n", path);
+        return false;
+    }
+    std::string first;
+    if (!std::getline(in, first)) {
+        return true;
+    }
+    if (first.starts_with("name,")) {
+        return readCsv(in, first, results);
+    }
+    return readTriples(in, std::move(first), results, comments);
+}
+
+bool record(const char* path, const std::vector<std::string>& comments, const Results& measured) {
+    std::ofstream out(path, std::ios::trunc);
+    for (const std::string& comment : comments) {
+        out << comment << '\n';
+    }
+    char number[64];
+    for (const auto& [key, value] : measured) {
+        std::snprintf(number, sizeof number, "%.6g", value);
+        out << key.first << ' ' << key.second << ' ' << number << '\n';
+    }
+    return static_cast<bool>(out.flush());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* baselineFile = nullptr;
+    double tolerance = 10;
+    bool recording = false;
+    std::vector<const char*> resultFiles;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--record") {
+            recording = true;
+        } else if (arg == "--tolerance" && i + 1 < argc && parseNumber(argv[i + 1], tolerance) && tolerance >= 0) {
+            ++i;
+        } else if (!arg.starts_with("--") && !baselineFile) {
+            baselineFile = argv[i];
+        } else if (!arg.starts_with("--")) {
+            resultFiles.push_back(argv[i]);
+        } else {
+            baselineFile = nullptr;
+            break;
+        }
+    }
+    if (!baselineFile || resultFiles.empty()) {
+        std::fprintf(stderr, "Usage: perf_compare BASELINE [--tolerance PERCENT] [--record] RESULTS...\n");
+        return 2;
+    }
+
+    Results baselines;
+    std::vector<std::string> comments;
+    Results measured;
+    if (!readFile(baselineFile, baselines, &comments)) {
+        return 2;
+    }
+    for (const char* file : resultFiles) {
+        if (!readFile(file, measured)) {
+            return 2;
+        }
+    }
+
+    if (recording) {
+        // What this build did not run keeps the baseline it had
+        measured.merge(baselines);
+        if (!record(baselineFile, comments, measured)) {
+            std::fprintf(stderr, "Could not write %s\n", baselineFile);
+            return 2;
+        }
+        std::printf("Recorded %zu baselines in %s\n", measured.size(), baselineFile);
+        return 0;
+    }
+
+    std::size_t worse = 0;
+    std::size_t checked = 0;
+    for (const auto& [key, baseline] : baselines) {
+        const auto found = measured.find(key);
+        const std::string label = key.first + " " + key.second;
+        if (found == measured.end()) {
+            // A benchmark this build leaves out, such as one needing Lua
+            std::printf("  missing  %s\n", label.c_str());
+            continue;
+        }
+        const double value = found->second;
+        const bool higherIsBetter = endsWith(key.second, "_per_second");
+        const double bound = higherIsBetter ? baseline * (1 - tolerance / 100) : baseline * (1 + tolerance / 100);
+        const bool regressed = higherIsBetter ? value < bound : value > bound;
+        const double change = baseline != 0 ? (value - baseline) / baseline * 100 : (value != 0 ? INFINITY : 0);
+        std::printf("  %-7s  %s: %.6g against %.6g (%+.1f%%)\n", regressed ? "WORSE" : "ok", label.c_str(), value,
+                    baseline, change);
+        worse += regressed ? 1 : 0;
+        ++checked;
+    }
+    std::printf("%zu of %zu measures worse than their baselines by more than %.0f%%\n", worse, checked, tolerance);
+    return worse > 0 ? 1 : 0;
+}
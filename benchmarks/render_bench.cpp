@@ -0,0 +1,147 @@
+// Rendering benchmark: replays a burst of output into a headless ConsoleUI
+// at several terminal widths, through the curses and the VT backend, and
+// reports frame times, allocations and the bytes each frame sends, with
+// the time those take over a slow link.
+//
+//   render_bench [messages-per-width]
+
+#include "../include/ConsoleUI.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Count every allocation made through operator new
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// An SSH session over a poor mobile or satellite link
+constexpr double kSlowLinkBitsPerSecond = 1'000'000;
+
+struct FrameStats {
+    std::vector<double> micros;
+    std::size_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+// Combat-style spam: varied lengths, some color codes, some long enough to wrap
+std::string makeMessage(std::size_t i) {
+    static const char* kVerbs[] = {"hits", "misses", "slashes", "parries", "casts a spell at"};
+    std::string message = "{rThe goblin{x " + std::string(kVerbs[i % 5]) + " you";
+    if (i % 3 == 0) {
+        message += " \x1b[1;33mfor " + std::to_string(i % 97) + " damage\x1b[0m";
+    }
+    if (i % 7 == 0) {
+        message += ". The blow glances off your shield and the crowd roars while dust swirls"
+                   " around the arena floor in slow, lazy spirals";
+    }
+    return message;
+}
+
+void timeFrame(ConsoleUI& ui, FrameStats& stats) {
+    const std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    ui.renderFrame();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    stats.allocations += g_allocations.load(std::memory_order_relaxed) - before;
+    stats.micros.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    stats.bytes += ui.takeTerminalBytes();
+}
+
+void report(const char* backend, const char* phase, int width, FrameStats& stats) {
+    if (stats.micros.empty()) return;
+    std::sort(stats.micros.begin(), stats.micros.end());
+    auto percentile = [&](double p) {
+        return stats.micros[std::min(stats.micros.size() - 1, static_cast<std::size_t>(p * stats.micros.size()))];
+    };
+    const double bytesPerFrame = static_cast<double>(stats.bytes) / stats.micros.size();
+    std::printf("%-6s %-8s width %4d  frames %6zu  p50 %8.1fus  p90 %8.1fus  p99 %8.1fus  max %8.1fus  allocs/frame %6.2f"
+                "  bytes/frame %8.1f  link %7.2fms\n",
+                backend, phase, width, stats.micros.size(), percentile(0.50), percentile(0.90), percentile(0.99),
+                stats.micros.back(), static_cast<double>(stats.allocations) / stats.micros.size(), bytesPerFrame,
+                bytesPerFrame * 8 * 1000 / kSlowLinkBitsPerSecond);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    constexpr int kHeight = 50;
+
+    const std::pair<const char*, ConsoleBackend> backends[] = {{"curses", ConsoleBackend::Curses},
+                                                               {"vt", ConsoleBackend::Vt}};
+    for (int width : {40, 80, 132, 200}) {
+        for (const auto& [backendName, backend] : backends) {
+            auto ui = ConsoleUI::createHeadless(kHeight, width, backend);
+            if (!ui) {
+                std::fprintf(stderr, "Could not create a headless %dx%d screen\n", kHeight, width);
+                return 1;
+            }
+            ui->renderFrame();
+            ui->takeTerminalBytes();
+
+            // One new message per frame, as during steady combat output
+            FrameStats append;
+            for (std::size_t i = 0; i < messages; ++i) {
+                ui->postOutput(makeMessage(i));
+                timeFrame(*ui, append);
+            }
+
+            // Bursts of 32 messages coalesced into one frame
+            FrameStats burst;
+            for (std::size_t i = 0; i < messages; i += 32) {
+                for (std::size_t j = i; j < std::min(messages, i + 32); ++j) {
+                    ui->postOutput(makeMessage(j));
+                }
+                timeFrame(*ui, burst);
+            }
+
+            // Full repaints with a full scrollback
+            FrameStats full;
+            for (std::size_t i = 0; i < std::max<std::size_t>(messages / 10, 1); ++i) {
+                ui->invalidate();
+                timeFrame(*ui, full);
+            }
+
+            // PageUp back through the scrollback and PageDown again, a step a frame
+            FrameStats scroll;
+            for (int i = 0; i < 400; ++i) {
+                ui->scrollOutput(i < 200 ? ConsoleUI::kScrollStep : -ConsoleUI::kScrollStep);
+                timeFrame(*ui, scroll);
+            }
+
+            // Resizes, as when a tmux pane is dragged: one column narrower and back
+            FrameStats resize;
+            for (int i = 0; i < 100; ++i) {
+                ui->resize(kHeight, width - (i % 2));
+                timeFrame(*ui, resize);
+            }
+
+            report(backendName, "append", width, append);
+            report(backendName, "burst", width, burst);
+            report(backendName, "full", width, full);
+            report(backendName, "scroll", width, scroll);
+            report(backendName, "resize", width, resize);
+        }
+    }
+    return 0;
+}
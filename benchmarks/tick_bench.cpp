@@ -0,0 +1,117 @@
+// World tick benchmark: runs a regeneration-style update over every room of
+// a large synthetic world with 0, 1, 3, ... worker threads and reports the
+// time per tick. The changes recorded in the command buffers are applied in
+// chunk order, so every thread count must end with the same world.
+//
+//   tick_bench [rooms] [ticks] [max-workers]
+
+#include "../include/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kMobsPerRoom = 8;
+constexpr std::size_t kRoomsPerChunk = 64;
+
+struct World {
+    std::vector<std::uint32_t> health;   // kMobsPerRoom per room
+    std::vector<std::uint64_t> log;      // Order the changes were applied in
+};
+
+// Enough arithmetic per mob to stand in for an NPC deciding what to do
+std::uint32_t think(std::uint32_t state) {
+    for (int i = 0; i < 64; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+    }
+    return state;
+}
+
+std::uint64_t checksum(const World& world) {
+    std::uint64_t sum = 1469598103934665603ull;
+    for (std::uint64_t entry : world.log) {
+        sum = (sum ^ entry) * 1099511628211ull;
+    }
+    for (std::uint32_t health : world.health) {
+        sum = (sum ^ health) * 1099511628211ull;
+    }
+    return sum;
+}
+
+void runTicks(JobSystem& jobs, World& world, std::size_t rooms, std::size_t ticks, double& millisPerTick,
+              std::uint64_t& sum) {
+    std::vector<CommandBuffer> buffers(JobSystem::chunkCount(rooms, kRoomsPerChunk));
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t tick = 0; tick < ticks; ++tick) {
+        jobs.parallelFor(rooms, kRoomsPerChunk, [&](const JobRange& range) {
+            CommandBuffer& commands = buffers[range.chunk];
+            for (std::size_t room = range.begin; room < range.end; ++room) {
+                for (std::size_t mob = 0; mob < kMobsPerRoom; ++mob) {
+                    const std::size_t index = room * kMobsPerRoom + mob;
+                    const std::uint32_t next = think(world.health[index] + static_cast<std::uint32_t>(tick));
+                    // Only some mobs change, as only some regenerate or act
+                    if ((next & 7) == 0) {
+                        commands.push([&world, index, next] {
+                            world.health[index] = next;
+                            world.log.push_back(index);
+                        });
+                    }
+                }
+            }
+        });
+        for (CommandBuffer& commands : buffers) {
+            commands.apply();
+        }
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    millisPerTick = elapsed.count() / static_cast<double>(ticks);
+    sum = checksum(world);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t rooms = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    const std::size_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+    const unsigned maxWorkers =
+        argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : JobSystem::defaultThreads();
+
+    std::vector<unsigned> threadCounts{0};
+    for (unsigned threads = 1; threads < maxWorkers; threads = threads * 2 + 1) {
+        threadCounts.push_back(threads);
+    }
+    if (threadCounts.back() != maxWorkers) {
+        threadCounts.push_back(maxWorkers);
+    }
+
+    std::printf("%zu rooms, %zu mobs each, %zu ticks\n", rooms, kMobsPerRoom, ticks);
+    std::printf("%8s %12s %9s %18s\n", "threads", "ms/tick", "speedup", "checksum");
+    double baseline = 0.0;
+    std::uint64_t expected = 0;
+    bool deterministic = true;
+    for (unsigned threads : threadCounts) {
+        World world{std::vector<std::uint32_t>(rooms * kMobsPerRoom, 1), {}};
+        JobSystem jobs(threads);
+        double millis = 0.0;
+        std::uint64_t sum = 0;
+        runTicks(jobs, world, rooms, ticks, millis, sum);
+        if (threads == 0) {
+            baseline = millis;
+            expected = sum;
+        }
+        deterministic = deterministic && sum == expected;
+        std::printf("%8u %12.3f %8.2fx %18llx\n", jobs.threadCount(), millis, baseline / millis,
+                    static_cast<unsigned long long>(sum));
+    }
+    if (!deterministic) {
+        std::printf("Results differ between thread counts\n");
+        return 1;
+    }
+    return 0;
+}
@@ -1,46 +0,0 @@
-// sol2
-
-// The MIT License (MIT)
-
-// Copyright (c) 2013-2022 Rapptz, ThePhD and contributors
-
-// Permission is hereby granted, free of charge, to any person obtaining a copy of
-// this software and associated documentation files (the "Software"), to deal in
-// the Software without restriction, including without limitation the rights to
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
-// the Software, and to permit persons to whom the Software is furnished to do so,
-// subject to the following conditions:
-
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
-// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
-// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
-// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
-// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-
-#ifndef SOL_FUNCTION_TYPES_CORE_HPP
-#define SOL_FUNCTION_TYPES_CORE_HPP
-
-#include <sol/stack.hpp>
-#include <sol/wrapper.hpp>
-
-#include <memory>
-
-namespace sol { namespace function_detail {
-	template <typename Fx, int start = 1, bool is_yielding = false>
-	int call(lua_State* L) {
-		Fx& fx = stack::get<user<Fx>>(L, upvalue_index(start));
-		int nr = fx(L);
-		if (is_yielding) {
-			return lua_yield(L, nr);
-		}
-		else {
-			return nr;
-		}
-	}
-}} // namespace sol::function_detail
-
-#endif // SOL_FUNCTION_TYPES_CORE_HPP
@@ -1,51 +0,0 @@
-// sol.hpp : Main include file for Sol2 library
-// This is a convenience header that includes all the necessary Sol2 components
-
-#pragma once
-
-#include "abort.hpp"
-#include "as_args.hpp"
-#include "as_returns.hpp"
-#include "assert.hpp"
-#include "base_traits.hpp"
-#include "bind_traits.hpp"
-#include "bytecode.hpp"
-#include "call.hpp"
-#include "compatibility.hpp"
-#include "config.hpp"
-#include "coroutine.hpp"
-#include "debug.hpp"
-#include "demangle.hpp"
-#include "deprecate.hpp"
-#include "dump_handler.hpp"
-#include "ebco.hpp"
-#include "environment.hpp"
-#include "epilogue.hpp"
-#include "error_handler.hpp"
-#include "error.hpp"
-#include "forward_as.hpp"
-#include "forward_detail.hpp"
-#include "forward.hpp"
-#include "function_result.hpp"
-#include "function_types_core.hpp"
-#include "function_types_overloaded.hpp"
-#include "function_types_stateful.hpp"
-#include "function_types_stateless.hpp"
-#include "function_types_templated.hpp"
-#include "function_types.hpp"
-#include "function.hpp"
-#include "in_place.hpp"
-#include "inheritance.hpp"
-#include "load_result.hpp"
-#include "lua_table.hpp"
-#include "lua_value.hpp"
-#include "make_reference.hpp"
-#include "metatable.hpp"
-#include "object_base.hpp"
-#include "object.hpp"
-#include "optional_implementation.hpp"
-#include "optional.hpp"
-#include "overload.hpp"
-#include "packaged_coroutine.hpp"
-#include "pairs_iterator.hpp"
-#include "pointer_like.hpp"
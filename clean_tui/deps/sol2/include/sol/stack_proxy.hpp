@@ -1,64 +0,0 @@
-// sol2
-
-// The MIT License (MIT)
-
-// Copyright (c) 2013-2022 Rapptz, ThePhD and contributors
-
-// Permission is hereby granted, free of charge, to any person obtaining a copy of
-// this software and associated documentation files (the "Software"), to deal in
-// the Software without restriction, including without limitation the rights to
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
-// the Software, and to permit persons to whom the Software is furnished to do so,
-// subject to the following conditions:
-
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
-// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
-// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
-// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
-// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-
-#ifndef SOL_STACK_PROXY_HPP
-#define SOL_STACK_PROXY_HPP
-
-#include <sol/stack_proxy_base.hpp>
-
-namespace sol {
-	struct stack_proxy : public stack_proxy_base {
-	public:
-		stack_proxy() : stack_proxy_base() {
-		}
-		stack_proxy(lua_State* L, int index) : stack_proxy_base(L, index) {
-		}
-
-		template <typename... Ret, typename... Args>
-		decltype(auto) call(Args&&... args);
-
-		template <typename... Args>
-		decltype(auto) operator()(Args&&... args) {
-			return call<>(std::forward<Args>(args)...);
-		}
-	};
-
-	namespace stack {
-		template <>
-		struct unqualified_getter<stack_proxy> {
-			static stack_proxy get(lua_State* L, int index, record& tracking) {
-				tracking.use(0);
-				return stack_proxy(L, index);
-			}
-		};
-
-		template <>
-		struct unqualified_pusher<stack_proxy> {
-			static int push(lua_State*, const stack_proxy& ref) {
-				return ref.push();
-			}
-		};
-	} // namespace stack
-} // namespace sol
-
-#endif // SOL_STACK_PROXY_HPP
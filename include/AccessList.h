@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Rcu.h"
+
+// An IPv4 or IPv6 address. An IPv4 one fills the first 4 bytes, and an
+// IPv4-mapped IPv6 one is taken as the IPv4 address it maps
+struct IpAddress {
+    std::array<std::uint8_t, 16> bytes{};
+    bool v6 = false;
+
+    static std::optional<IpAddress> parse(std::string_view text);
+    // The peer of a connected socket
+    static std::optional<IpAddress> ofPeer(int fd);
+
+    unsigned bits() const noexcept { return v6 ? 128 : 32; }
+    bool bit(unsigned index) const noexcept { return (bytes[index / 8] >> (7 - index % 8)) & 1; }
+    std::uint64_t hash() const noexcept;
+    std::string toString() const;
+};
+
+enum class AccessRule : std::uint8_t { None, Allow, Deny };
+
+/**
+ * Addresses allowed and banned, by CIDR prefix: a binary trie per address
+ * family, walked a bit at a time from the top. A lookup follows at most
+ * 32 or 128 links down one path and remembers the last rule it passed, so
+ * the most specific prefix holding the address wins, however many rules
+ * there are. "deny 0.0.0.0/0" with "allow 10.0.0.0/8" admits only 10/8.
+ * Built once, then only read: the server publishes each version whole.
+ */
+class AccessList {
+public:
+    AccessList();
+
+    // "allow|deny ADDRESS[/BITS]" lines, # starting a comment; the error names the line
+    static std::expected<AccessList, std::string> parse(std::string_view text);
+    static std::expected<AccessList, std::string> load(const std::filesystem::path& path);
+
+    // Bits past length are ignored; a later rule for the same prefix replaces an earlier
+    void add(const IpAddress& prefix, unsigned length, AccessRule rule);
+    // The rule of the longest prefix holding address; None if none does
+    AccessRule match(const IpAddress& address) const noexcept;
+
+    std::size_t rules() const noexcept { return m_rules; }
+    bool empty() const noexcept { return m_rules == 0; }
+
+private:
+    struct Node {
+        std::array<std::uint32_t, 2> child{};   // By the next bit; 0 for none, as no node points at a root
+        AccessRule rule = AccessRule::None;
+    };
+
+    std::vector<Node> m_nodes;   // [0] the IPv4 root, [1] the IPv6 root
+    std::size_t m_rules = 0;
+};
+
+/**
+ * Connections open per address, shared by every thread that accepts,
+ * without a lock. The counts are a count-min sketch: an address adds to
+ * one counter in each of four rows, picked by slices of its hash, and its
+ * count is the least of the four. Other addresses only ever add to those
+ * counters too, so a count can be overstated, by addresses colliding in
+ * all four rows at once, but never understated. Memory is fixed however
+ * many addresses connect, and nothing is ever evicted.
+ */
+class ConnectionCounts {
+public:
+    // Count a connection from address unless that would make more than
+    // limit (0 for none); the ticket to release it with, or 0 if refused.
+    // Two racing for the last place may both be refused
+    std::uint64_t acquire(const IpAddress& address, std::uint32_t limit) noexcept;
+    void release(std::uint64_t ticket) noexcept;
+    std::uint32_t count(const IpAddress& address) const noexcept;
+
+private:
+    static constexpr std::size_t kRows = 4;
+    static constexpr std::size_t kColumns = std::size_t{1} << 14;
+
+    static std::size_t column(std::uint64_t ticket, std::size_t row) noexcept {
+        return (ticket >> (16 * row)) & (kColumns - 1);
+    }
+
+    std::array<std::array<std::atomic<std::uint32_t>, kColumns>, kRows> m_counts{};
+};
+
+/**
+ * What the reactors ask before giving a connection a session: whether its
+ * address is banned, and whether it already has as many connections as an
+ * address may. With no rules and no limit, nothing is looked up, not even
+ * the peer's address.
+ */
+class AccessControl {
+public:
+    enum class Verdict : std::uint8_t { Admit, Denied, Limited };
+
+    // Any thread; ticket is set for an admitted connection, to release when it closes
+    Verdict admit(int fd, std::uint32_t limit, std::uint64_t& ticket) noexcept;
+    void release(std::uint64_t ticket) noexcept {
+        if (ticket != 0) {
+            m_counts.release(ticket);
+        }
+    }
+    // Any thread: whether the list bans fd's peer, without counting it
+    bool denied(int fd) const noexcept;
+
+    // One thread at a time, such as the game thread on SIGHUP
+    void publish(std::unique_ptr<AccessList> list);
+    std::size_t rules() const noexcept { return m_rules.load(std::memory_order_relaxed); }
+
+private:
+    bool deniedAddress(const IpAddress& address) const noexcept;
+
+    RcuPointer<AccessList> m_list;
+    std::atomic<std::size_t> m_rules{0};
+    ConnectionCounts m_counts;
+};
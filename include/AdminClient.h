@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/**
+ * console_app's end of the admin socket (see AdminProtocol.h): attached to
+ * a running net_server, the console only draws and sends lines, and the
+ * game never pays for the terminal.
+ *
+ * A thread of its own reads the server's frames and hands each message to
+ * the output callback, which ConsoleUI points at postOutput(), so a burst
+ * of output is queued, not drawn, by the time it is read. When the server
+ * goes the callback is told so once, and send() fails from then on.
+ */
+class AdminClient {
+public:
+    using OutputCallback = std::function<void(std::string)>;
+
+    // Connect to the socket at path and play as name; the error says why not
+    static std::expected<std::unique_ptr<AdminClient>, std::string> connect(const std::string& path,
+                                                                             std::string_view name,
+                                                                             OutputCallback output);
+    ~AdminClient();
+
+    AdminClient(const AdminClient&) = delete;
+    AdminClient& operator=(const AdminClient&) = delete;
+
+    // A command line for the server; false once it has gone. Any thread
+    bool send(std::string_view line);
+
+    bool connected() const noexcept { return m_connected.load(std::memory_order_relaxed); }
+
+private:
+    AdminClient(int fd, OutputCallback output) : m_fd(fd), m_output(std::move(output)) {}
+
+    void run();
+    bool write(std::string_view frame);
+
+    int m_fd = -1;
+    OutputCallback m_output;
+    std::atomic<bool> m_connected{true};
+    std::atomic<bool> m_detaching{false};   // This end is closing it
+    std::mutex m_sending;   // Frames from two threads must not interleave
+    std::thread m_thread;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * What goes over the admin socket between net_server and an attached
+ * console_app (see AdminServer and AdminClient).
+ *
+ * Each way it is a stream of frames: a 4-byte little-endian length, then
+ * that many bytes of text. The client's first frame is the name it plays
+ * under and each one after that a command line; the server's frames are
+ * what the operator is shown, one message each. Either side closing the
+ * socket ends the session.
+ */
+namespace admin {
+
+constexpr std::size_t kHeaderSize = 4;
+constexpr std::size_t kMaxFrame = 1 << 20;   // Longer frames are a broken peer
+
+inline void appendFrame(std::string& out, std::string_view text) {
+    const auto size = static_cast<std::uint32_t>(text.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((size >> shift) & 0xFF));
+    }
+    out.append(text);
+}
+
+// The first whole frame in buffer, which is advanced past it; nullopt when
+// it has not all arrived yet. broken is set for a frame over kMaxFrame
+inline std::optional<std::string_view> nextFrame(std::string_view& buffer, bool& broken) {
+    if (buffer.size() < kHeaderSize) {
+        return std::nullopt;
+    }
+    std::uint32_t size = 0;
+    for (std::size_t i = 0; i < kHeaderSize; ++i) {
+        size |= static_cast<std::uint32_t>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+    }
+    if (size > kMaxFrame) {
+        broken = true;
+        return std::nullopt;
+    }
+    if (buffer.size() < kHeaderSize + size) {
+        return std::nullopt;
+    }
+    const std::string_view frame = buffer.substr(kHeaderSize, size);
+    buffer.remove_prefix(kHeaderSize + size);
+    return frame;
+}
+
+} // namespace admin
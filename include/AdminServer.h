@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GameEvents.h"
+#include "NetInbox.h"
+#include "NetReactor.h"
+#include "SharedMessage.h"
+
+// An operator attaching, typing or going, for the game thread
+struct AdminEvent {
+    enum class Kind : std::uint8_t { Attached, Line, Detached };
+    Kind kind = Kind::Line;
+    std::uint64_t session = 0;
+    std::string text;   // The name to play under when attached, else the line
+};
+
+// Game thread to the admin thread: text for an operator, or their end
+struct AdminOutput {
+    std::uint64_t session = 0;
+    SharedMessage text;   // Null with close
+    bool close = false;
+};
+
+/**
+ * The server end of the admin socket (see AdminProtocol.h): a Unix domain
+ * socket that console_app --connect attaches to, so the terminal and its
+ * drawing live in a process of their own and any number of operators can
+ * watch and steer one running server.
+ *
+ * Only the server's own user, or root, may attach: the socket file is made
+ * private to that user and each peer's credentials are checked as well.
+ * Operators are few, so one thread polls them all. Their frames become
+ * AdminEvents in the inbox the game thread polls, and what the game thread
+ * sends back is queued by reference, the same shared text players get, and
+ * written from here. An operator whose output backs up past
+ * kMaxPendingBytes is cut off rather than left to grow.
+ *
+ * Given the engine's event bus, this thread is also a consumer of it:
+ * operators are told as players enter and leave the game, in text made
+ * here, and only while anyone is attached to read it.
+ */
+class AdminServer {
+public:
+    static constexpr std::size_t kMaxPendingBytes = 4 << 20;
+
+    // bus, if given, must outlive the server; it subscribes at once
+    static std::expected<std::unique_ptr<AdminServer>, NetError> start(const std::string& path,
+                                                                        NetInbox<AdminEvent>& events,
+                                                                        GameEventBus* bus = nullptr);
+    // Detaches everyone and removes the socket file
+    ~AdminServer();
+
+    AdminServer(const AdminServer&) = delete;
+    AdminServer& operator=(const AdminServer&) = delete;
+
+    // Any thread
+    void send(std::uint64_t session, SharedMessage text) { m_output.push({session, std::move(text), false}); }
+    void close(std::uint64_t session) { m_output.push({session, nullptr, true}); }
+
+    std::size_t operators() const noexcept { return m_attached.load(std::memory_order_relaxed); }
+
+private:
+    struct Operator {
+        int fd = -1;
+        std::uint64_t session = 0;
+        bool named = false;     // Its first frame, the name, has come
+        bool closing = false;   // Goes once out is written
+        std::string in;
+        std::string out;
+    };
+
+    AdminServer(std::string path, NetInbox<AdminEvent>& events) : m_path(std::move(path)), m_events(events) {}
+
+    void run();
+    void accept();
+    bool read(Operator& op);    // False once the operator is gone
+    bool write(Operator& op);
+    void detach(Operator& op);
+    void subscribe();
+    // A line for every named operator still attached
+    void notice(std::string_view text);
+
+    std::string m_path;
+    NetInbox<AdminEvent>& m_events;
+    NetInbox<AdminOutput> m_output;
+    int m_listenFd = -1;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<std::size_t> m_attached{0};
+    GameEventBus* m_bus = nullptr;
+    GameEventBus::ConsumerId m_consumer = 0;
+
+    // This thread's alone
+    std::vector<Operator> m_operators;
+    std::uint64_t m_nextSession = 1;
+
+    std::thread m_thread;
+};
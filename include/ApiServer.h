@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "NetReactor.h"
+#include "Rcu.h"
+#include "WorldStatus.h"
+
+/**
+ * Read-only HTTP endpoint for a website, answering in JSON:
+ *
+ *   GET /api/who     everyone online, by name, with their zone
+ *   GET /api/top     the most powerful players, strongest first
+ *   GET /api/zones   how many players each zone has, and which are loaded
+ *
+ * Each body also carries the status's serial and when it was taken.
+ * Anything else is a 404.
+ *
+ * Nothing it serves comes from live state. The game thread fills one of
+ * the two WorldStatus buffers about once a second and swaps it in, and
+ * this thread reads the other under an rcu::Guard. It renders each body
+ * once per status and serves that copy to every request until the next
+ * status arrives, so a website polling it hard costs the game nothing.
+ *
+ * It has a thread of its own, which serves up to kMaxClients connections
+ * at once from one poll() loop on non-blocking sockets. Each connection has
+ * kClientDeadline, all told, to send its request and take the reply, so
+ * one that trickles its bytes holds up no other and is cut off when its
+ * time is up. It listens on an address of its own, and sends
+ * Access-Control-Allow-Origin only when it is given an origin to allow.
+ */
+class ApiServer {
+public:
+    static constexpr std::size_t kMaxClients = 64;   // Served at once; the rest wait in the listen backlog
+    static constexpr std::chrono::seconds kClientDeadline{3};
+
+    // origin is sent as Access-Control-Allow-Origin, such as * or
+    // https://example.org; empty sends none, so only same-origin pages read it
+    static std::expected<std::unique_ptr<ApiServer>, NetError> start(const std::string& address, std::uint16_t port,
+                                                                    const std::string& origin,
+                                                                    const RcuDoubleBuffer<WorldStatus>& status);
+    ~ApiServer();
+
+    ApiServer(const ApiServer&) = delete;
+    ApiServer& operator=(const ApiServer&) = delete;
+
+    std::uint64_t requests() const noexcept { return m_requests.load(std::memory_order_relaxed); }
+
+private:
+    // A connection being served: its request as it comes, then its reply as it goes
+    struct Client {
+        int fd = -1;
+        std::chrono::steady_clock::time_point deadline{};
+        std::string request;
+        std::string reply;   // Empty until the request is whole
+        std::size_t sent = 0;
+    };
+
+    ApiServer(const RcuDoubleBuffer<WorldStatus>& status, std::string corsHeader)
+        : m_status(status), m_corsHeader(std::move(corsHeader)) {}
+
+    void run();
+    void accept(std::chrono::steady_clock::time_point now);
+    // Read what has come or write what is left; false once the client is done
+    bool serve(Client& client);
+    void respond(Client& client);
+    void render();
+
+    const RcuDoubleBuffer<WorldStatus>& m_status;
+    const std::string m_corsHeader;   // The whole header line, or empty
+    int m_listenFd = -1;
+    int m_wakeFds[2] = {-1, -1};   // Written to stop the thread
+    std::atomic<std::uint64_t> m_requests{0};
+    std::vector<Client> m_clients;   // This thread's alone
+
+    // The bodies of the status with this serial; this thread's alone
+    std::uint64_t m_rendered = 0;
+    std::string m_who;
+    std::string m_top;
+    std::string m_zones;
+
+    std::thread m_thread;
+};
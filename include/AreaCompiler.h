@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "AreaFile.h"
+#include "GameWorld.h"
+
+/**
+ * Compiles the text areas builders write into an AreaSource, which worldc
+ * writes out as an area file for the server to map.
+ *
+ * A text area is a line per statement, a keyword and its arguments; blank
+ * lines and lines starting with # are skipped, and keywords are not case
+ * sensitive:
+ *
+ *     zone Midgaard                 rooms after it are in Midgaard
+ *     room Temple Square            names are unique across every file
+ *     desc A wide square of worn    descriptions may run over several
+ *     desc white stone.             desc lines, joined with a space
+ *     exit north Market Street      one way; write the return exit too
+ *     item lantern                  one lying here when the zone loads
+ *     npc rat wander 3 health 50/100 regen 2
+ *     prototype lantern decay 0     a kind of item; desc lines that
+ *     desc A battered lantern.      follow describe it
+ *     start Temple Square           where players appear; else the first room
+ *
+ * Each file starts outside any named zone. Zones are numbered in the order
+ * they first appear, and a zone may be continued in another file. Exits,
+ * items and NPCs may refer to rooms and prototypes defined later or in
+ * other files; finish() resolves them once everything is added. It numbers
+ * the rooms zone by zone, in the order written within each, so a zone's
+ * rooms and their text lie together in the area file. Strings are interned
+ * as they are read, and AreaFile::write() stores each distinct one once, so
+ * a description shared by a hundred rooms costs its bytes once.
+ *
+ * Every problem found is reported, as "file:line: message", rather than
+ * only the first.
+ */
+class AreaCompiler {
+public:
+    // Read one file's text; the name is only used in errors
+    void add(std::string_view text, std::string_view file);
+
+    // Resolve every reference and lay the world out; nullopt if anything
+    // added, or any reference, was in error. The rooms' text is the
+    // compiler's, so keep it until the source is written
+    std::optional<AreaSource> finish();
+
+    const std::vector<std::string>& errors() const noexcept { return m_errors; }
+
+private:
+    struct Where {
+        std::string_view file;
+        std::size_t line = 0;
+    };
+
+    struct Room {
+        std::string_view name;
+        std::string description;
+        ZoneId zone = 0;
+        Where where;
+        std::array<std::string_view, kDirectionCount> exits{};   // Empty for none
+        std::array<Where, kDirectionCount> exitsWhere{};
+    };
+
+    struct Npc {
+        AreaSource::Npc npc;
+        std::string_view room;
+        Where where;
+    };
+
+    struct Item {
+        std::string_view prototype;
+        std::string_view room;
+        Where where;
+    };
+
+    // What a desc line continues
+    enum class Describing : std::uint8_t { Nothing, Room, Prototype };
+
+    std::string_view intern(std::string_view text) { return *m_strings.emplace(text).first; }
+    void error(Where where, std::string_view message);
+    void readLine(std::string_view line, Where where);
+    void readNpc(std::string_view args, Where where);
+    ZoneId zone(std::string_view name, Where where);
+
+    std::unordered_set<std::string> m_strings;   // Node-based, so the views stay good
+    std::deque<Room> m_rooms;
+    std::unordered_map<std::string_view, std::size_t> m_roomsByName;
+    std::vector<ItemPrototype> m_prototypes;
+    std::vector<Where> m_prototypesWhere;
+    std::unordered_map<std::string_view, std::uint32_t> m_prototypesByName;
+    std::vector<Npc> m_npcs;
+    std::vector<Item> m_items;
+    std::unordered_map<std::string_view, ZoneId> m_zones;
+    std::size_t m_zoneCount = 0;
+    std::optional<ZoneId> m_zone;                 // Of the file being read; none until its first zone line
+    std::optional<std::size_t> m_room;            // The room exit, item and npc lines are for
+    Describing m_describing = Describing::Nothing;
+    std::string_view m_start;
+    Where m_startWhere;
+    std::vector<std::string> m_errors;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "FileView.h"
+#include "GameWorld.h"
+#include "ItemCatalog.h"
+#include "MappedRecords.h"
+
+// The sections are read in place as these structs, so the layout is the
+// host's; only little-endian hosts are supported
+static_assert(std::endian::native == std::endian::little, "Area files are little-endian");
+
+struct AreaHeader {
+    std::array<char, 8> magic{};
+    std::uint16_t version = 0;
+    std::uint16_t headerSize = 0;     // Room for later versions to grow the header
+    RoomId startRoom = kInvalidRoomId;
+    std::uint64_t fileSize = 0;
+    SavedSection strings;             // Bytes
+    SavedSection exits;               // A RoomGraph::ExitArray per room
+    SavedSection roomZones;           // A ZoneId per room
+    SavedSection roomText;            // An AreaRoomText per room
+    SavedSection nameIndex;           // Every RoomId, in order of room name
+    SavedSection zones;               // An AreaZone per zone
+    SavedSection prototypes;          // AreaPrototype records
+    SavedSection npcs;                // AreaNpc records, grouped by zone
+    SavedSection items;               // AreaItem records, grouped by zone
+    // Since version 2: the dictionary packed descriptions were packed
+    // against, and a byte per room, 1 where its description is a frame
+    // rather than text; both empty when nothing was packed
+    SavedSection dictionary;          // Bytes
+    SavedSection packedRooms;         // A std::uint8_t per room
+    std::uint64_t packedTextSize = 0; // What the packed descriptions come to unpacked
+    std::uint64_t reserved = 0;
+};
+
+struct AreaRoomText {
+    SavedString name;
+    SavedString description;
+};
+
+// Where a zone's NPCs and items lie in their sections
+struct AreaZone {
+    std::uint32_t firstNpc = 0;
+    std::uint32_t npcCount = 0;
+    std::uint32_t firstItem = 0;
+    std::uint32_t itemCount = 0;
+};
+
+struct AreaPrototype {
+    SavedString name;
+    SavedString description;
+    std::uint32_t decayTicks = 0;
+    std::uint32_t reserved = 0;
+};
+
+struct AreaNpc {
+    SavedString name;
+    RoomId room = kInvalidRoomId;
+    std::uint32_t wanderTicks = 0;
+    std::int32_t health = 100;
+    std::int32_t maxHealth = 100;
+    std::int32_t regen = 1;
+    std::uint32_t reserved = 0;
+};
+
+// An item lying in a room when the zone first loads
+struct AreaItem {
+    std::uint32_t prototype = 0;      // Index into the prototypes
+    RoomId room = kInvalidRoomId;
+};
+
+static_assert(std::is_trivially_copyable_v<AreaHeader> && sizeof(AreaHeader) == 128);
+static_assert(std::is_trivially_copyable_v<AreaRoomText> && sizeof(AreaRoomText) == 16);
+static_assert(std::is_trivially_copyable_v<AreaZone> && sizeof(AreaZone) == 16);
+static_assert(std::is_trivially_copyable_v<AreaPrototype> && sizeof(AreaPrototype) == 24);
+static_assert(std::is_trivially_copyable_v<AreaNpc> && sizeof(AreaNpc) == 32);
+static_assert(std::is_trivially_copyable_v<AreaItem> && sizeof(AreaItem) == 8);
+static_assert(sizeof(RoomGraph::ExitArray) == kDirectionCount * sizeof(RoomId));
+
+// A world as AreaFile::write() takes it
+struct AreaSource {
+    struct Npc {
+        std::string name;
+        RoomId room = kInvalidRoomId;
+        std::uint32_t wanderTicks = 0;
+        std::int32_t health = 100;
+        std::int32_t maxHealth = 100;
+        std::int32_t regen = 1;
+    };
+    struct Item {
+        std::uint32_t prototype = 0;  // Index into prototypes
+        RoomId room = kInvalidRoomId;
+    };
+
+    RoomGraph rooms;
+    RoomId startRoom = kInvalidRoomId;
+    std::vector<ItemPrototype> prototypes;
+    std::vector<Npc> npcs;
+    std::vector<Item> items;
+};
+
+/**
+ * A world map, mapped and read where it lies.
+ *
+ * The file is a 128-byte header, then sections of the structs above at
+ * aligned offsets, then a table of the strings they refer to, each distinct
+ * string stored once. Rooms are column-wise as in RoomGraph, so the engine
+ * copies the exits and zones it walks on every move and points the graph's
+ * name and description columns straight into the string table, which is
+ * paged in only for the rooms someone looks at. The NPCs and items are
+ * grouped by zone and spawned by the engine the first time a player enters
+ * their zone, so a world of thousands of zones starts in the time it takes
+ * to copy its exits and keeps resident only the zones in use.
+ *
+ * Room descriptions long enough to gain are packed as zstd frames against
+ * a dictionary trained on the whole world (see DescriptionPacker), when
+ * write() has zstd to hand; the engine unpacks them as rooms are looked
+ * at. A file with packed rooms does not open without zstd.
+ *
+ * open() checks the header and every room, prototype and zone range once,
+ * in place, but not a checksum, which would read every description at
+ * startup; zone() checks a zone's records when they are asked for. After
+ * that the accessors hand out views into the mapping, which the room graph
+ * keeps alive through mapping().
+ */
+class AreaFile {
+public:
+    static constexpr std::uint16_t kVersion = 2;
+
+    // A zone's share of the NPC and item sections
+    struct Zone {
+        std::span<const AreaNpc> npcs;
+        std::span<const AreaItem> items;
+    };
+
+    AreaFile() = default;
+
+    // An empty area, failing valid(), when the file is missing or damaged
+    static AreaFile open(const std::filesystem::path& path);
+    // Lay out source's world; false when it cannot be, such as two rooms or
+    // prototypes with one name, or when the file could not be written
+    static bool write(const std::filesystem::path& path, const AreaSource& source);
+
+    bool valid() const noexcept { return m_header != nullptr; }
+    const AreaHeader& header() const noexcept { return *m_header; }
+    const std::shared_ptr<const FileView>& mapping() const noexcept { return m_file; }
+
+    std::size_t roomCount() const noexcept { return m_exits.size(); }
+    std::span<const RoomGraph::ExitArray> exits() const noexcept { return m_exits; }
+    std::span<const ZoneId> roomZones() const noexcept { return m_roomZones; }
+    std::span<const AreaRoomText> roomText() const noexcept { return m_roomText; }
+    std::span<const RoomId> nameIndex() const noexcept { return m_nameIndex; }
+    std::span<const AreaPrototype> prototypes() const noexcept { return m_prototypes; }
+    // Empty when no description is packed
+    std::span<const std::uint8_t> packedRooms() const noexcept { return m_packedRooms; }
+    std::string_view dictionary() const noexcept { return m_dictionary; }
+    std::size_t zoneCount() const noexcept { return m_zones.size(); }
+
+    // The zone's NPCs and items, checked as they are handed out; nullopt
+    // when any of them names a room outside the zone or a missing prototype
+    std::optional<Zone> zone(ZoneId zone) const;
+
+    // Have the pages under the zone's records, or a room's name and
+    // description, read in ahead of use. From any thread
+    void willNeed(ZoneId zone) const;
+    void willNeedRoom(RoomId room) const;
+
+    // Checked against the table by open() or zone(), so any string a record
+    // handed out holds is safe
+    std::string_view string(SavedString ref) const noexcept { return m_strings.substr(ref.offset, ref.size); }
+
+private:
+    std::shared_ptr<const FileView> m_file;
+    const AreaHeader* m_header = nullptr;
+    std::string_view m_strings;
+    std::span<const RoomGraph::ExitArray> m_exits;
+    std::span<const ZoneId> m_roomZones;
+    std::span<const AreaRoomText> m_roomText;
+    std::span<const RoomId> m_nameIndex;
+    std::span<const AreaZone> m_zones;
+    std::span<const AreaPrototype> m_prototypes;
+    std::span<const AreaNpc> m_npcs;
+    std::span<const AreaItem> m_items;
+    std::span<const std::uint8_t> m_packedRooms;
+    std::string_view m_dictionary;
+};
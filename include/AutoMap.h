@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "GameWorld.h"
+#include "InlineDelegate.h"
+
+/**
+ * ASCII maps of the rooms around a player, for the map command.
+ *
+ * Rooms carry no coordinates, so each zone is laid out from its exits: a
+ * breadth-first walk from its lowest room puts each neighbour one step
+ * north, south, east or west of the room it was reached from, and parts of
+ * the zone no exit joins are set side by side. Rooms whose exits do not fit
+ * a grid end up sharing a cell. Exits out of the zone are drawn as stubs.
+ *
+ * The drawing is a tile per zone: the rooms as '#' and the exits between
+ * them as '-' and '|', drawn once when the zone loads (prepare()) and kept
+ * until RoomGraph::layoutVersion() says an exit or a room changed; a
+ * description changing leaves it be. A view copies the window around the
+ * viewer out of the tile and lays only the overlay on it: '@' for the
+ * viewer and whatever the marker gives the other rooms in sight.
+ *
+ * One thread keeps the tiles. render() from any other (a zone actor) reads
+ * a tile only while it is current, and draws itself a scratch one when it
+ * is not, the way lookAround() does with room views.
+ */
+class AutoMap {
+public:
+    static constexpr int kAcross = 4;   // Rooms shown either side of the viewer
+    static constexpr int kDown = 2;     // Rooms shown above and below
+
+    // The overlay for a room in sight that is not the viewer's, or 0 for none
+    using Marker = InlineDelegate<char(RoomId)>;
+
+    // Draw the zone's tile now, unless the one kept is current; the keeping thread only
+    void prepare(const RoomGraph& world, ZoneId zone);
+
+    // Append the map around room to out, a line per row of rooms and exits;
+    // false, and nothing appended, for a room not on any map. keep is false
+    // off the keeping thread
+    bool render(const RoomGraph& world, RoomId room, const Marker& marker, std::string& out, bool keep = true);
+
+    // Tiles drawn to be kept, since the map was made
+    std::uint64_t tilesBuilt() const noexcept { return m_tilesBuilt; }
+
+private:
+    // A room's character on its zone's tile
+    struct Placed {
+        RoomId room;
+        std::uint32_t x;
+        std::uint32_t y;
+    };
+
+    struct Tile {
+        std::uint64_t layout = ~std::uint64_t{0};   // The layoutVersion() drawn from
+        std::uint32_t width = 0;                    // In characters
+        std::uint32_t height = 0;
+        std::string cells;                          // height rows of width, no line breaks
+        std::vector<Placed> byRoom;                 // Sorted by room, to find the viewer
+        std::vector<Placed> byRow;                  // Sorted by row then column, to find what is in sight
+    };
+
+    void index(const RoomGraph& world);
+    void draw(const RoomGraph& world, std::span<const RoomId> rooms, Tile& tile);
+
+    std::vector<Tile> m_tiles;   // By ZoneId
+
+    // The rooms of each zone, in order: zone z's are
+    // m_zoneRooms[m_zoneStart[z] .. m_zoneStart[z + 1])
+    std::uint64_t m_indexed = ~std::uint64_t{0};   // The layoutVersion() indexed
+    std::vector<std::uint32_t> m_zoneStart;
+    std::vector<RoomId> m_zoneRooms;
+
+    std::uint64_t m_tilesBuilt = 0;
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "MessageTemplate.h"
+
+using BehaviorId = std::uint32_t;
+inline constexpr BehaviorId kNoBehavior = UINT32_MAX;
+
+enum class BehaviorOp : std::uint8_t {
+    // Composites: their children follow them in the array
+    Sequence,     // Each child in turn until one fails
+    Selector,     // Each child in turn until one succeeds
+    Invert,       // Its one child's result, the other way round
+    // Conditions
+    PlayerHere,   // A player is in the room
+    Fighting,
+    Hurt,         // Health below arg percent of its most
+    Chance,       // Succeeds arg percent of the time
+    // Actions
+    Wander,       // A step to a room of its zone; not while fighting
+    Flee,         // Out of its fight, and a step away
+    Attack,       // Starts on a player in the room
+    Emote,        // Shows templates[data] to the room, {0} the NPC's name
+    Lua,          // Calls luaLeaves[data]; only where nothing else will do
+};
+
+// One node, in a tree's array in the order a walk reaches them: a node's
+// children follow it, the first straight after and each next one at the end
+// of the one before
+struct BehaviorNode {
+    BehaviorOp op;
+    std::uint8_t arg = 0;     // Hurt's and Chance's percent
+    std::uint16_t line = 0;   // In the file, for errors
+    std::uint32_t end = 0;    // One past the last node under it
+    std::uint32_t data = 0;   // Into the templates or the Lua leaves
+};
+
+static_assert(sizeof(BehaviorNode) == 12);
+
+// A leaf the file hands to a script: the function hook of the script, called
+// with the NPC's and its room's names; it succeeds when that returns true
+struct BehaviorLuaLeaf {
+    std::string script;
+    std::string hook;
+    std::uint16_t line = 0;
+};
+
+/**
+ * NPC behaviour as data: trees of sequences, selectors and leaves, written
+ * in a file and compiled when it is loaded into one flat array of
+ * BehaviorNode for every tree, each in the order a walk reaches its nodes.
+ *
+ * The engine runs a zone's NPCs that are due together, grouped by tree, so
+ * one tree's nodes stay in cache through the batch. A tree is walked from
+ * its root each time it runs and keeps no state between runs: a composite
+ * moves through its children by their end offsets and a leaf is a switch
+ * in the engine, so most of a run is native and reads a few cache lines.
+ * A Lua leaf calls into a script through the pool's hook call, at the cost
+ * of one Lua call; use it for what the built-in leaves cannot do.
+ *
+ * A file is written a line per node, indented under its parent; blank
+ * lines and lines starting with # are skipped. Each tree starts with
+ * `tree NAME`, then optionally `for` and the names of the NPCs it is given
+ * to, split by commas, and has one root:
+ *
+ *     tree scavenger for rat, sewer mouse
+ *       selector
+ *         sequence
+ *           hurt 50
+ *           flee
+ *         sequence
+ *           chance 10
+ *           emote The {0} squeaks.
+ *         wander
+ *
+ * sequence and selector take one child or more, and not exactly one; the
+ * conditions are player-here, fighting, hurt PERCENT and chance PERCENT;
+ * the actions are wander, flee, attack, emote TEXT and lua SCRIPT FUNCTION.
+ * A tree is not told how long its last run took: each run starts afresh,
+ * so an action that takes time is one the NPC takes a step of per run.
+ */
+class BehaviorTrees {
+public:
+    static constexpr std::size_t kMaxDepth = 16;
+
+    struct Tree {
+        std::string name;
+        std::uint32_t root = 0;   // Into nodes()
+        std::uint32_t end = 0;
+    };
+
+    // Every problem found, as "line N: message", one per line
+    static std::expected<BehaviorTrees, std::string> parse(std::string_view text);
+
+    BehaviorId find(std::string_view name) const;
+    // The tree the NPCs by that name are given, or kNoBehavior
+    BehaviorId forNpc(std::string_view name) const;
+
+    std::span<const Tree> trees() const noexcept { return m_trees; }
+    std::span<const BehaviorNode> nodes() const noexcept { return m_nodes; }
+    std::span<const MessageTemplate> templates() const noexcept { return m_templates; }
+    std::span<const BehaviorLuaLeaf> luaLeaves() const noexcept { return m_luaLeaves; }
+    bool empty() const noexcept { return m_trees.empty(); }
+
+    // Walk tree for one NPC. leaf(node) does a condition or an action and
+    // says whether it succeeded; visited counts the nodes reached
+    template <typename Leaf>
+    bool run(BehaviorId tree, Leaf&& leaf, std::size_t& visited) const {
+        return walk(m_trees[tree].root, leaf, visited);
+    }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+    };
+
+    template <typename Leaf>
+    bool walk(std::uint32_t at, Leaf& leaf, std::size_t& visited) const {
+        const BehaviorNode& node = m_nodes[at];
+        ++visited;
+        switch (node.op) {
+            case BehaviorOp::Sequence:
+            case BehaviorOp::Selector: {
+                // A sequence stops at its first failure, a selector at its first success
+                const bool stopOn = node.op == BehaviorOp::Selector;
+                for (std::uint32_t child = at + 1; child < node.end; child = m_nodes[child].end) {
+                    if (walk(child, leaf, visited) == stopOn) {
+                        return stopOn;
+                    }
+                }
+                return !stopOn;
+            }
+            case BehaviorOp::Invert:
+                return !walk(at + 1, leaf, visited);
+            default:
+                return leaf(node);
+        }
+    }
+
+    std::vector<Tree> m_trees;
+    std::vector<BehaviorNode> m_nodes;
+    std::vector<MessageTemplate> m_templates;
+    std::vector<BehaviorLuaLeaf> m_luaLeaves;
+    std::unordered_map<std::string, BehaviorId, Hash, std::equal_to<>> m_byName;
+    std::unordered_map<std::string, BehaviorId, Hash, std::equal_to<>> m_byNpc;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * Compile-time table of the engine's built-in command verbs.
+ *
+ * The built-in set is fixed at build time, so instead of probing a
+ * std::unordered_map the engine resolves these names through a perfect hash
+ * whose seed is searched for by the compiler. A lookup is one hash, one table
+ * load and one string compare, with no allocation.
+ */
+enum class BuiltinCommand : std::uint8_t {
+    Say,
+    Look,
+    Get,
+    Drop,
+    Inventory,
+    North,
+    South,
+    East,
+    West,
+    Exit,
+    Help,
+    Count
+};
+
+inline constexpr std::size_t kBuiltinCommandCount = static_cast<std::size_t>(BuiltinCommand::Count);
+
+// Names indexed by BuiltinCommand
+inline constexpr std::array<std::string_view, kBuiltinCommandCount> kBuiltinCommandNames = {
+    "say", "look", "get", "drop", "inventory", "north", "south", "east", "west", "exit", "help"
+};
+
+namespace builtin_detail {
+    // Power of two so the slot index is a mask rather than a modulo
+    inline constexpr std::size_t kSlotCount = 32;
+    inline constexpr std::uint8_t kEmptySlot = 0xFF;
+
+    // Seeded FNV-1a
+    constexpr std::uint32_t hash(std::string_view key, std::uint32_t seed) noexcept {
+        std::uint32_t h = 2166136261u ^ seed;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    constexpr std::size_t slotFor(std::string_view key, std::uint32_t seed) noexcept {
+        return hash(key, seed) & (kSlotCount - 1);
+    }
+
+    // Find the first seed that maps every built-in name to a distinct slot
+    consteval std::uint32_t findSeed() {
+        for (std::uint32_t seed = 0; seed < 100000; ++seed) {
+            std::array<bool, kSlotCount> used{};
+            bool collision = false;
+            for (std::string_view name : kBuiltinCommandNames) {
+                std::size_t slot = slotFor(name, seed);
+                if (used[slot]) {
+                    collision = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (!collision) {
+                return seed;
+            }
+        }
+        throw "no perfect hash seed found for built-in commands";
+    }
+
+    inline constexpr std::uint32_t kSeed = findSeed();
+
+    // Slot -> BuiltinCommand index, kEmptySlot for unused slots
+    consteval std::array<std::uint8_t, kSlotCount> buildSlots() {
+        std::array<std::uint8_t, kSlotCount> slots{};
+        slots.fill(kEmptySlot);
+        for (std::size_t i = 0; i < kBuiltinCommandCount; ++i) {
+            slots[slotFor(kBuiltinCommandNames[i], kSeed)] = static_cast<std::uint8_t>(i);
+        }
+        return slots;
+    }
+
+    inline constexpr std::array<std::uint8_t, kSlotCount> kSlots = buildSlots();
+}
+
+// Resolve a verb to a built-in command, or std::nullopt if it is not one
+constexpr std::optional<BuiltinCommand> findBuiltinCommand(std::string_view name) noexcept {
+    std::uint8_t index = builtin_detail::kSlots[builtin_detail::slotFor(name, builtin_detail::kSeed)];
+    if (index == builtin_detail::kEmptySlot || kBuiltinCommandNames[index] != name) {
+        return std::nullopt;
+    }
+    return static_cast<BuiltinCommand>(index);
+}
+
+constexpr std::string_view builtinCommandName(BuiltinCommand cmd) noexcept {
+    return kBuiltinCommandNames[static_cast<std::size_t>(cmd)];
+}
+
+static_assert(findBuiltinCommand("look") == BuiltinCommand::Look);
+static_assert(findBuiltinCommand("help") == BuiltinCommand::Help);
+static_assert(!findBuiltinCommand("dance").has_value());
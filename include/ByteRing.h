@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Bounded lock-free single-producer, single-consumer ring of bytes.
+ *
+ * The producer copies bytes in with write(), which never waits: it fails,
+ * copying nothing, when they do not fit. What it writes stays invisible
+ * until publish(), so several writes can be handed over as one group. The
+ * consumer takes everything published with read(). Each side owns its own
+ * index and only reads the other's, so neither ever locks; the indices
+ * count bytes forever and are masked into the buffer, whose capacity is a
+ * power of two.
+ */
+class ByteRing {
+public:
+    explicit ByteRing(std::size_t capacity)
+        : m_bytes(std::bit_ceil(std::max<std::size_t>(capacity, 64)))
+        , m_mask(m_bytes.size() - 1) {}
+
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+
+    std::size_t capacity() const noexcept { return m_bytes.size(); }
+
+    // Producer only
+    bool write(std::string_view bytes) noexcept {
+        if (bytes.size() > capacity() - (m_written - m_tailSeen)) {
+            m_tailSeen = m_tail.load(std::memory_order_acquire);
+            if (bytes.size() > capacity() - (m_written - m_tailSeen)) {
+                return false;
+            }
+        }
+        const std::size_t start = m_written & m_mask;
+        const std::size_t first = std::min(bytes.size(), capacity() - start);
+        std::memcpy(m_bytes.data() + start, bytes.data(), first);
+        std::memcpy(m_bytes.data(), bytes.data() + first, bytes.size() - first);
+        m_written += bytes.size();
+        return true;
+    }
+
+    // Producer only
+    void publish() noexcept { m_head.store(m_written, std::memory_order_release); }
+
+    // Consumer only: append everything published to out and free its room;
+    // returns how many bytes that was
+    std::size_t read(std::string& out) {
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t size = head - tail;
+        const std::size_t start = tail & m_mask;
+        const std::size_t first = std::min(size, capacity() - start);
+        out.append(m_bytes.data() + start, first);
+        out.append(m_bytes.data(), size - first);
+        m_tail.store(head, std::memory_order_release);
+        return size;
+    }
+
+private:
+    std::vector<char> m_bytes;
+    std::size_t m_mask;
+
+    // The producer's: written so far, and the consumer's index as last seen
+    std::size_t m_written = 0;
+    std::size_t m_tailSeen = 0;
+
+    // Each on its own cache line, so the two sides do not fight over one
+    alignas(64) std::atomic<std::size_t> m_head{0};   // Published by the producer
+    alignas(64) std::atomic<std::size_t> m_tail{0};   // Freed by the consumer
+};
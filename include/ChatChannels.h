@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GameWorld.h"
+
+using ChannelId = std::uint8_t;
+
+// A set of player ids, one bit each; ids are dense, so it stays small
+class PlayerBitset {
+public:
+    void insert(PlayerId id) {
+        const std::size_t word = id / 64;
+        if (word >= m_words.size()) {
+            m_words.resize(word + 1);
+        }
+        m_words[word] |= std::uint64_t{1} << (id % 64);
+    }
+
+    void erase(PlayerId id) noexcept {
+        if (id / 64 < m_words.size()) {
+            m_words[id / 64] &= ~(std::uint64_t{1} << (id % 64));
+        }
+    }
+
+    bool contains(PlayerId id) const noexcept {
+        return id / 64 < m_words.size() && (m_words[id / 64] >> (id % 64) & 1) != 0;
+    }
+
+    std::size_t count() const noexcept {
+        std::size_t total = 0;
+        for (const std::uint64_t word : m_words) {
+            total += static_cast<std::size_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    // Every member in order of id, a word of 64 at a time
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (std::size_t i = 0; i < m_words.size(); ++i) {
+            for (std::uint64_t bits = m_words[i]; bits != 0; bits &= bits - 1) {
+                fn(static_cast<PlayerId>(i * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+            }
+        }
+    }
+
+private:
+    std::vector<std::uint64_t> m_words;
+};
+
+/**
+ * Chat channels such as gossip and newbie: a name and the set of players
+ * listening to it, as a PlayerBitset over player ids.
+ *
+ * Sending to a channel is one pass over the set bits, each listener
+ * getting the same SharedMessage (see GameEngine::sendToChannel). Players
+ * join the channels that are on by default when they enter and leave
+ * every channel when they go, so a recycled id starts out clean.
+ */
+class ChatChannels {
+public:
+    struct Channel {
+        std::string name;
+        std::string description;
+        bool onByDefault = true;
+        PlayerBitset listeners;
+    };
+
+    static constexpr std::size_t kMaxChannels = 64;
+
+    // nullopt when the name is taken or there are kMaxChannels already
+    std::optional<ChannelId> add(std::string name, std::string description, bool onByDefault = true) {
+        if (find(name) || m_channels.size() >= kMaxChannels) {
+            return std::nullopt;
+        }
+        m_channels.push_back({std::move(name), std::move(description), onByDefault, {}});
+        return static_cast<ChannelId>(m_channels.size() - 1);
+    }
+
+    std::optional<ChannelId> find(std::string_view name) const noexcept {
+        const auto found = std::find_if(m_channels.begin(), m_channels.end(),
+                                        [name](const Channel& channel) { return channel.name == name; });
+        if (found == m_channels.end()) {
+            return std::nullopt;
+        }
+        return static_cast<ChannelId>(found - m_channels.begin());
+    }
+
+    std::size_t size() const noexcept { return m_channels.size(); }
+    const Channel& channel(ChannelId id) const { return m_channels[id]; }
+
+    bool listening(ChannelId id, PlayerId player) const noexcept { return m_channels[id].listeners.contains(player); }
+    void setListening(ChannelId id, PlayerId player, bool on) {
+        if (on) {
+            m_channels[id].listeners.insert(player);
+        } else {
+            m_channels[id].listeners.erase(player);
+        }
+    }
+
+    void join(PlayerId player) {
+        for (Channel& channel : m_channels) {
+            if (channel.onByDefault) {
+                channel.listeners.insert(player);
+            }
+        }
+    }
+
+    void leave(PlayerId player) noexcept {
+        for (Channel& channel : m_channels) {
+            channel.listeners.erase(player);
+        }
+    }
+
+    template <typename Fn>
+    void forEachListener(ChannelId id, Fn&& fn) const {
+        m_channels[id].listeners.forEach(fn);
+    }
+
+private:
+    std::vector<Channel> m_channels;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include "WorldSnapshot.h"
+
+// Totals since the checkpointer was made, copied out under its lock
+struct CheckpointStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t written = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t skipped = 0;           // Replaced by a newer snapshot before being written
+    std::chrono::nanoseconds longestWrite{0};
+};
+
+/**
+ * Whole-world checkpoints, written on a thread of their own.
+ *
+ * The game thread takes a WorldSnapshot, which is cheap, and hands it over;
+ * serializing and writing it, which for a large world takes far longer
+ * than a tick, happens here while the game goes on. One checkpoint is
+ * written at a time. A snapshot submitted while another is still waiting
+ * replaces it, since only the newest is worth having. Whatever is waiting
+ * is written before the destructor returns.
+ */
+class Checkpointer {
+public:
+    explicit Checkpointer(std::filesystem::path path);
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    void submit(WorldSnapshot snapshot);
+    // Return once everything submitted so far is written
+    void flush();
+
+    CheckpointStats stats() const;
+
+private:
+    void work();
+
+    std::filesystem::path m_path;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::optional<WorldSnapshot> m_waiting;
+    bool m_writing = false;
+    bool m_stopping = false;
+    CheckpointStats m_stats;
+    std::thread m_thread;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "MemoryAccounting.h"
+
+// Queued bytes as a list of links to pool chunks; the front link is partly sent
+struct ChunkChain {
+    std::uint32_t head = 0xFFFFFFFFu;
+    std::uint32_t tail = 0xFFFFFFFFu;
+    std::size_t size = 0;   // Bytes not yet consumed
+
+    bool empty() const noexcept { return size == 0; }
+};
+
+/**
+ * Fixed-size chunks carved from large slabs, for queued socket output.
+ *
+ * Slabs are allocated as needed up to a limit and never move, so a chunk can
+ * be handed to the kernel while more bytes are appended after it, and a
+ * backend that registers memory with the kernel (io_uring fixed buffers) does
+ * so once per slab through the slab callback. An idle chain holds no chunks.
+ *
+ * A chain is a list of links, each naming a run of bytes in a chunk, and
+ * chunks are reference counted. appendShared() links part of one chain into
+ * another without copying it, so a broadcast is encoded into chunks once and
+ * queued for every recipient by reference; a chunk goes back to the pool
+ * when the last chain holding it has consumed it.
+ */
+class ChunkPool {
+public:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+    static constexpr std::size_t kChunkSize = 2048;
+    static constexpr std::size_t kChunksPerSlab = 512;
+    static constexpr std::size_t kSlabSize = kChunkSize * kChunksPerSlab;
+
+    // Called with each new slab
+    using SlabCallback = std::function<void(std::size_t slab, char* data, std::size_t size)>;
+
+    explicit ChunkPool(std::size_t maxSlabs) : m_maxSlabs(maxSlabs) {}
+
+    void setSlabCallback(SlabCallback callback) { m_onSlab = std::move(callback); }
+    std::size_t maxSlabs() const noexcept { return m_maxSlabs; }
+    std::size_t slabCount() const noexcept { return m_slabs.size(); }
+    std::size_t chunksInUse() const noexcept { return m_chunks.size() - m_free.size(); }
+
+    // Append bytes to chain; false, leaving chain as it was, when the pool is exhausted
+    bool append(ChunkChain& chain, std::string_view bytes);
+
+    // Append count bytes of source, from offset, to chain; source is unchanged
+    // and may be cleared at once. Its chunks are shared rather than copied
+    // unless the bytes fit in the room left in chain's last chunk
+    void appendShared(ChunkChain& chain, const ChunkChain& source, std::size_t offset, std::size_t count);
+
+    // Drop count bytes from the front of chain
+    void consume(ChunkChain& chain, std::size_t count);
+
+    // Consume everything in chain but keep the free room of its last chunk,
+    // so a chain used for staging packs what comes next into the same chunk
+    void consumeAll(ChunkChain& chain);
+
+    void clear(ChunkChain& chain);
+
+    // Unconsumed bytes of the head link, and the slab holding them
+    std::string_view front(const ChunkChain& chain) const noexcept;
+    std::size_t frontSlab(const ChunkChain& chain) const noexcept { return m_links[chain.head].chunk / kChunksPerSlab; }
+
+    // Call fn with each unconsumed run of bytes in order until it returns false
+    template <typename Fn>
+    void forEachSegment(const ChunkChain& chain, Fn&& fn) const {
+        for (std::uint32_t link = chain.head; link != kNone; link = m_links[link].next) {
+            if (!fn(segment(m_links[link]))) {
+                return;
+            }
+        }
+    }
+
+private:
+    struct Chunk {
+        std::uint32_t size = 0;        // Bytes written
+        std::uint32_t refs = 0;        // Links naming it
+        std::uint32_t writer = kNone;  // The link that may append to it, if it still needs to
+    };
+
+    struct Link {
+        std::uint32_t chunk = kNone;
+        std::uint32_t next = kNone;
+        std::uint32_t begin = 0;   // Unconsumed bytes of the chunk, [begin, end)
+        std::uint32_t end = 0;
+    };
+
+    char* data(std::uint32_t chunk) const noexcept {
+        return m_slabs[chunk / kChunksPerSlab].get() + (chunk % kChunksPerSlab) * kChunkSize;
+    }
+    std::string_view segment(const Link& link) const noexcept {
+        return std::string_view(data(link.chunk) + link.begin, link.end - link.begin);
+    }
+
+    // Free room at the end of chain's last chunk, if chain wrote it
+    std::size_t tailRoom(const ChunkChain& chain) const noexcept;
+
+    // A fresh chunk, or kNone when the pool is exhausted
+    std::uint32_t allocate();
+
+    // A link naming [begin, end) of chunk, which gains a reference
+    std::uint32_t addLink(std::uint32_t chunk, std::uint32_t begin, std::uint32_t end);
+
+    // Drop a link and its chunk reference; the chunk returns to the pool with its last
+    void releaseLink(std::uint32_t link);
+
+    std::vector<TrackedBuffer> m_slabs;   // Counted as the sessions' memory
+    std::vector<Chunk> m_chunks;
+    std::vector<std::uint32_t> m_free;
+    std::vector<Link> m_links;
+    std::vector<std::uint32_t> m_freeLinks;
+    std::size_t m_maxSlabs;
+    SlabCallback m_onSlab;
+};
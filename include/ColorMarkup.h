@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <curses.h>
+
+// Attributes in effect from offset up to the next run (or the end of the text)
+struct AttributeRun {
+    std::uint32_t offset;
+    attr_t attributes;
+};
+
+/**
+ * Converts MUD color markup into plain text plus attribute runs.
+ *
+ * Two notations are understood:
+ *  - ANSI SGR escapes (ESC [ ... m): reset, bold, underline, blink, reverse,
+ *    the 8 standard and 8 bright foreground colors and the 8 backgrounds.
+ *    Other CSI sequences are dropped.
+ *  - Inline codes: {r {g {y {b {m {c {w {d set the foreground (upper case
+ *    for bold), {x resets and {{ is a literal brace.
+ *
+ * Parsing happens once, when a message enters the scrollback, so drawing is
+ * one wattrset and one waddnstr per run.
+ */
+namespace ColorMarkup {
+
+// Define the color pairs markup uses; call after start_color()
+void initColorPairs();
+
+// Strip markup from text into plain (both cleared first) and record a run
+// wherever the attributes change. Text drawn with base needs no run, so
+// plain text without markup produces no runs at all.
+void parse(std::string_view text, attr_t base, std::string& plain, std::vector<AttributeRun>& runs);
+
+} // namespace ColorMarkup
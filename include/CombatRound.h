@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Components.h"
+#include "EntityStore.h"
+#include "GameWorld.h"
+
+/**
+ * The fights going on, as parallel arrays with one slot per combatant:
+ * who it is, whom it attacks, its combat stats, and the room and health
+ * the engine gathers into it before each round.
+ *
+ * resolve() runs a whole round as one pass over the arrays: every
+ * combatant whose target is alive and in the same room swings once, in
+ * slot order, and the outcome of each swing goes into a list of hits the
+ * engine turns into one message per room. It touches nothing but the
+ * arrays, so a round over a thousand fights stays in cache; the engine
+ * copies health back out afterwards. Rolls come from each combatant's own
+ * xorshift state, so the same fights always go the same way.
+ */
+class CombatRound {
+public:
+    using Slot = std::uint32_t;
+    static constexpr Slot kNoSlot = UINT32_MAX;
+
+    struct Hit {
+        Slot attacker;
+        Slot target;
+        std::int32_t damage;   // 0 for a miss
+        bool killed;           // This swing took the target to 0 or below
+    };
+
+    // Start attacker on target, or turn it on a new one; either may be new
+    // to combat. The slot is attacker's
+    Slot engage(Entity attacker, Entity target, const CombatStats& attackerStats, const CombatStats& targetStats);
+    // Out of combat; anyone fighting it stops
+    void remove(Entity entity);
+    // A combatant's stats changed mid-fight; nothing if it isn't fighting
+    void setStats(Entity entity, const CombatStats& stats);
+
+    bool fighting(Entity entity) const noexcept { return slot(entity) != kNoSlot; }
+    Slot slot(Entity entity) const noexcept {
+        const Slot found = entity.index < m_slots.size() ? m_slots[entity.index] : kNoSlot;
+        return found != kNoSlot && m_entities[found] == entity ? found : kNoSlot;
+    }
+    // Whom entity attacks, or kInvalidEntity
+    Entity target(Entity entity) const noexcept {
+        const Slot found = slot(entity);
+        return found != kNoSlot && m_targets[found] != kNoSlot ? m_entities[m_targets[found]] : kInvalidEntity;
+    }
+
+    std::size_t size() const noexcept { return m_entities.size(); }
+    bool empty() const noexcept { return m_entities.empty(); }
+
+    // Filled in by the engine before a round and read back after it
+    std::span<const Entity> entities() const noexcept { return m_entities; }
+    std::span<RoomId> rooms() noexcept { return m_rooms; }
+    std::span<std::int32_t> health() noexcept { return m_health; }
+    std::span<const std::int32_t> health() const noexcept { return m_health; }
+    std::span<const std::int32_t> attack() const noexcept { return m_attack; }
+    std::span<const std::int32_t> defense() const noexcept { return m_defense; }
+    std::span<const std::int32_t> damage() const noexcept { return m_damage; }
+
+    // One round; hits is replaced with every swing taken
+    void resolve(std::vector<Hit>& hits);
+
+    // After a round: combatants whose target died, went elsewhere or left
+    // turn on someone fighting them, and those with no one are let go and
+    // put in left
+    void settle(std::vector<Entity>& left);
+
+private:
+    Slot add(Entity entity, const CombatStats& stats);
+    void removeSlot(Slot slot);
+
+    // Parallel, by slot
+    std::vector<Entity> m_entities;
+    std::vector<Slot> m_targets;
+    std::vector<RoomId> m_rooms;
+    std::vector<std::int32_t> m_health;
+    std::vector<std::int32_t> m_attack;
+    std::vector<std::int32_t> m_defense;
+    std::vector<std::int32_t> m_damage;
+    std::vector<std::uint32_t> m_random;
+
+    std::vector<Slot> m_slots;   // By entity index
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GameWorld.h"
+
+// What one field of a command's arguments accepts
+enum class ArgKind : std::uint8_t {
+    Word,        // One whitespace-delimited word
+    Number,      // A decimal integer
+    Direction,   // north/south/east/west or its initial
+    Target,      // A player in the same room, resolved by the engine
+    Rest         // Everything left on the line; only valid last
+};
+
+// One parsed field; text views into the submitted line
+struct CommandArg {
+    ArgKind kind = ArgKind::Word;
+    bool present = false;                    // False for an optional field that was left out
+    std::string_view text{};                 // As typed
+    std::int64_t number = 0;                 // Set for Number
+    Direction direction = Direction::Count;  // Set for Direction
+    PlayerId target = kInvalidPlayerId;      // Set for Target once resolved
+};
+
+class ArgumentSchema;
+
+/**
+ * A command's arguments after matching them against its schema.
+ *
+ * Fields sit in declaration order in a fixed inline array, so parsing a line
+ * never allocates. The raw arguments stay available for handlers that want
+ * them; a command without a schema only has those.
+ */
+class CommandArgs {
+public:
+    static constexpr std::size_t kMaxFields = 8;
+
+    std::string_view raw() const noexcept { return m_raw; }
+    std::size_t size() const noexcept { return m_count; }
+    bool empty() const noexcept { return m_count == 0; }
+
+    const CommandArg& operator[](std::size_t index) const noexcept { return m_fields[index]; }
+    CommandArg& operator[](std::size_t index) noexcept { return m_fields[index]; }
+
+    // Name the schema gave field index
+    std::string_view name(std::size_t index) const noexcept;
+
+    // Field called name, or null if the schema has none
+    const CommandArg* find(std::string_view name) const noexcept;
+
+private:
+    friend class ArgumentSchema;
+
+    const ArgumentSchema* m_schema = nullptr;
+    std::array<CommandArg, kMaxFields> m_fields{};
+    std::size_t m_count = 0;
+    std::string_view m_raw;
+};
+
+/**
+ * Argument grammar of one command, compiled once when it is registered.
+ *
+ * A spec lists the fields in order as `name:kind`, with a trailing `?` on
+ * optional ones, for example `count:number? item:rest`. The kinds are word,
+ * number, direction, target and rest. Matching walks the fields once over the
+ * line; an optional field whose kind does not fit the next word is skipped,
+ * so `get 3 coins` and `get coins` both match the spec above.
+ */
+class ArgumentSchema {
+public:
+    struct Field {
+        std::string name;
+        ArgKind kind = ArgKind::Word;
+        bool optional = false;
+    };
+
+    // Compile a spec; the error describes what is wrong with it
+    static std::expected<ArgumentSchema, std::string> compile(std::string_view spec);
+
+    bool empty() const noexcept { return m_fields.empty(); }
+    const std::vector<Field>& fields() const noexcept { return m_fields; }
+
+    // Match args into out; the error is meant for the player. Target fields
+    // are left for the caller to resolve
+    std::expected<void, std::string> parse(std::string_view args, CommandArgs& out) const;
+
+private:
+    std::vector<Field> m_fields;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct CommandEntry;
+
+/**
+ * Flat lookup table from every accepted spelling of a command to its entry.
+ *
+ * The table is rebuilt whenever the command set changes and holds, for each
+ * command, its full name, every prefix no other command shares, and any
+ * aliases naming it. Exact names win over aliases and aliases over
+ * abbreviations, so `e` can mean east although exit also starts with it.
+ * Spellings are packed into one byte buffer and found by open addressing, so
+ * resolving an abbreviation costs one hash and one compare, the same as an
+ * exact hit, and never allocates.
+ */
+class CommandIndex {
+public:
+    struct Command {
+        std::string_view name;
+        const CommandEntry* entry = nullptr;
+        bool abbreviate = true;   // Whether unique prefixes of the name resolve to it
+    };
+
+    // Alias spelling and the name of the command it stands for
+    using Alias = std::pair<std::string, std::string>;
+
+    void rebuild(std::vector<Command> commands, const std::vector<Alias>& aliases);
+    void clear() noexcept;
+
+    const CommandEntry* find(std::string_view spelling) const noexcept;
+
+    // Number of spellings that resolve to some command
+    std::size_t size() const noexcept { return m_count; }
+
+private:
+    struct Slot {
+        std::uint32_t hash = 0;
+        std::uint32_t offset = 0;   // Spelling bytes in m_keys
+        std::uint32_t length = 0;
+        const CommandEntry* entry = nullptr;   // Null marks an empty slot
+    };
+
+    static std::uint32_t hash(std::string_view key) noexcept {
+        std::uint32_t h = 2166136261u;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    std::string_view keyAt(const Slot& slot) const noexcept {
+        return std::string_view(m_keys).substr(slot.offset, slot.length);
+    }
+
+    // Add the spelling stored at offset unless it is already taken
+    bool insert(std::uint32_t offset, std::size_t length, const CommandEntry* entry);
+
+    std::vector<Slot> m_slots;   // Power-of-two size, at most half full
+    std::string m_keys;
+    std::size_t m_count = 0;
+};
@@ -8,7 +8,16 @@
 #include <memory>
 #include <expected>
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <algorithm>
 #include <curses.h>
+#include "CompletionTrie.h"
+#include "GapBuffer.h"
+#include "HistoryFile.h"
+#include "HistoryIndex.h"
+#include "RingBuffer.h"
+#include "TickClock.h"
 
 // Forward declaration to avoid circular dependencies
 class ConsoleUI;
@@ -25,18 +34,26 @@ struct KeyProcessResult {
     bool needsRedraw = false;
     bool commandSubmitted = false;
     std::string submittedCommand;
+    std::vector<std::string> completions;   // Tab found several matches to show
 };
 
 // History entry with timestamp for better management
 struct HistoryEntry {
     std::string command;
-    std::chrono::time_point<std::chrono::system_clock> timestamp;
+    std::uint32_t timestamp = 0;   // Seconds since the Unix epoch, as stored on disk
+
+    HistoryEntry() = default;
 
     // Constructor with current time as default
     explicit HistoryEntry(std::string cmd) 
         : command(std::move(cmd)), 
-          timestamp(std::chrono::system_clock::now()) 
+          timestamp(now()) 
     {}
+
+    // As of the console's current frame, not a clock call per entry
+    static std::uint32_t now() noexcept {
+        return static_cast<std::uint32_t>(TickClock::wallSeconds());
+    }
 };
 
 class CommandLineEditor {
@@ -47,32 +64,75 @@ public:
     // Process a keypress, return true if command was submitted
     KeyProcessResult processKey(int key);
     
+    // Insert text at the cursor as one edit, as for a paste; bytes that
+    // processKey would not insert as characters are dropped
+    void insertText(std::string_view text);
+    
     // Drawing-related methods
-    void draw();
-    [[nodiscard]] int getCursorPosition() const noexcept { return m_cursorPos; }
+    void draw();                 // Repaints only what changed since the last draw
+    void invalidate() noexcept;  // Make the next draw repaint the whole line
+    [[nodiscard]] int getCursorPosition() const noexcept { return m_cursorColumn; }  // Window column as of the last draw
     
     // Content accessors
-    [[nodiscard]] const std::string& getCurrentInput() const noexcept { return m_inputBuffer; }
+    [[nodiscard]] std::string getCurrentInput() const { return m_input.str(); }
     [[nodiscard]] std::string takeCurrentInput();
     
     // History methods
     std::expected<void, CommandError> addToHistory(std::string_view command);
     void clearHistory() noexcept;
-    [[nodiscard]] const std::vector<HistoryEntry>& getHistory() const noexcept { return m_commandHistory; }
+    [[nodiscard]] const RingBuffer<HistoryEntry>& getHistory() const noexcept { return m_commandHistory; }
+    void setHistorySize(std::size_t size);
+    
+    // Keep history in an append-only file, loading the entries it already holds
+    std::expected<void, CommandError> openHistoryFile(const std::filesystem::path& path);
+    
+    // Tab completion: given the text before the cursor, the matches for its last word
+    using CompletionProvider = std::function<Completion(std::string_view line)>;
+    void setCompletionProvider(CompletionProvider provider) { m_completer = std::move(provider); }
     
     // Window management
     void setWindow(WINDOW* window) noexcept;
     void resize(int width) noexcept;
     
 private:
-    // Input state
-    std::string m_inputBuffer;
-    int m_cursorPos = 0;
+    // Input state: UTF-8 text with the gap at the cursor, always on a code point boundary
+    GapBuffer m_input;
+    
+    // Display state: the line scrolls horizontally to keep the cursor in view.
+    // Bytes from m_damageFrom on may differ from what the window shows
+    static constexpr std::size_t kUndamaged = static_cast<std::size_t>(-1);
+    std::size_t m_damageFrom = 0;
+    std::size_t m_scrollColumn = 0;   // First display column shown
+    int m_cursorColumn = 0;
+    std::string m_drawScratch;
     
-    // History management
-    std::vector<HistoryEntry> m_commandHistory;
+    // History management: the newest entries in memory, all of them on disk
+    static constexpr size_t DEFAULT_HISTORY_SIZE = 100;
+    static constexpr size_t HISTORY_FILE_SLACK = 4;   // Rewrite the file past this many times the size
+    RingBuffer<HistoryEntry> m_commandHistory{DEFAULT_HISTORY_SIZE};
     int m_historyIndex = -1;
-    static constexpr size_t MAX_HISTORY_SIZE = 100;
+    HistoryFile m_historyFile;
+    std::uint32_t m_nextHistoryId = 0;   // Entries are numbered for the search index
+    void compactHistoryFile();
+    HistoryEntry& pushHistory();
+    std::uint32_t firstHistoryId() const noexcept {
+        return m_nextHistoryId - static_cast<std::uint32_t>(m_commandHistory.size());
+    }
+    
+    // Reverse incremental search (Ctrl-R). The index is built on the first
+    // search and then only catches up with entries added since
+    bool m_searching = false;
+    bool m_searchFailed = false;
+    std::string m_searchQuery;
+    std::string m_lastSearchQuery;   // Reused by Ctrl-R on an empty query
+    std::string m_searchSavedLine;   // Restored if the search is cancelled
+    std::optional<std::uint32_t> m_searchMatch;
+    HistoryIndex m_searchIndex;
+    void startSearch();
+    bool handleSearchKey(int key);
+    void searchHistory(std::uint32_t before);
+    void finishSearch(bool accept);
+    void drawSearch();
     
     // Window reference (not owned)
     WINDOW* m_window = nullptr;
@@ -88,7 +148,11 @@ private:
     void handleHome() noexcept;
     void handleEnd() noexcept;
     void handleCharacter(int ch) noexcept;
+    void handleTab(KeyProcessResult& result);
+    
+    CompletionProvider m_completer;
     
-    // Safety check for cursor position
-    void ensureCursorInBounds() noexcept;
+    // Record an edit starting at byte offset pos
+    void markDamaged(std::size_t pos) noexcept { m_damageFrom = std::min(m_damageFrom, pos); }
+    void replaceInput(std::string_view text);
 };
\ No newline at end of file
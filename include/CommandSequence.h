@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * A submitted line split into the commands it asks for, without copying.
+ *
+ * Commands are separated by `;`, and a word of digits and direction letters
+ * such as `4n2e3s` walks: four north, two east, three south. A speedwalk
+ * needs at least one digit, so `n`, `news` and every other plain word stay
+ * ordinary commands, and a letter without a count moves once. Each step is
+ * a view into the line (walking steps view the direction's name) with a
+ * repeat count, so `4n` is one step taken four times; empty segments are
+ * skipped. A line asking for more than kMaxCommands in all is refused
+ * rather than cut short.
+ */
+class CommandSequence {
+public:
+    static constexpr std::size_t kMaxSteps = 32;
+    static constexpr std::size_t kMaxCommands = 64;
+
+    struct Step {
+        std::string_view line;   // Verb and arguments, as CommandTokens reads them
+        std::uint32_t repeat;
+        bool walk;               // From a speedwalk; stops the sequence if it goes nowhere
+    };
+
+    explicit CommandSequence(std::string_view line) noexcept {
+        while (!m_tooLong) {
+            const std::size_t end = line.find(';');
+            addSegment(line.substr(0, end));
+            if (end == std::string_view::npos) {
+                break;
+            }
+            line.remove_prefix(end + 1);
+        }
+    }
+
+    // The steps view into the line and into this object
+    CommandSequence(const CommandSequence&) = delete;
+    CommandSequence& operator=(const CommandSequence&) = delete;
+
+    // More than one command in all; a lone command takes the ordinary path
+    bool isSequence() const noexcept { return m_commands > 1; }
+    bool tooLong() const noexcept { return m_tooLong; }
+    std::size_t size() const noexcept { return m_size; }
+    std::size_t commandCount() const noexcept { return m_commands; }
+    const Step& operator[](std::size_t i) const noexcept { return m_steps[i]; }
+    const Step* begin() const noexcept { return m_steps.data(); }
+    const Step* end() const noexcept { return m_steps.data() + m_size; }
+
+private:
+    static constexpr std::string_view kSpace = " \t\n\r\f\v";
+
+    static bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    // Name of the direction a speedwalk letter stands for, or empty
+    static std::string_view walkDirection(char c) noexcept {
+        switch (c | 0x20) {
+            case 'n': return "north";
+            case 's': return "south";
+            case 'e': return "east";
+            case 'w': return "west";
+            default: return {};
+        }
+    }
+
+    static bool isSpeedwalk(std::string_view word) noexcept {
+        bool counted = false;
+        for (std::size_t i = 0; i < word.size(); ++i) {
+            if (isDigit(word[i])) {
+                counted = true;
+            } else if (walkDirection(word[i]).empty()) {
+                return false;
+            }
+        }
+        // A count must lead up to a letter
+        return counted && !isDigit(word.back());
+    }
+
+    void addSegment(std::string_view segment) noexcept {
+        const std::size_t start = segment.find_first_not_of(kSpace);
+        if (start == std::string_view::npos) {
+            return;
+        }
+        segment = segment.substr(start, segment.find_last_not_of(kSpace) + 1 - start);
+        if (!isSpeedwalk(segment)) {
+            addStep(segment, 1, false);
+            return;
+        }
+        std::uint32_t count = 0;
+        for (char c : segment) {
+            if (isDigit(c)) {
+                // Clamped well past kMaxCommands, so it cannot overflow
+                count = count < kMaxCommands ? count * 10 + static_cast<std::uint32_t>(c - '0') : count;
+                continue;
+            }
+            addStep(walkDirection(c), count == 0 ? 1 : count, true);
+            count = 0;
+        }
+    }
+
+    void addStep(std::string_view line, std::uint32_t repeat, bool walk) noexcept {
+        // Consecutive walks the same way merge, so "nn3n" is one step
+        if (walk && m_size > 0 && m_steps[m_size - 1].walk && m_steps[m_size - 1].line == line) {
+            m_steps[m_size - 1].repeat += repeat;
+        } else if (m_size == kMaxSteps) {
+            m_tooLong = true;
+            return;
+        } else {
+            m_steps[m_size++] = {line, repeat, walk};
+        }
+        m_commands += repeat;
+        m_tooLong = m_tooLong || m_commands > kMaxCommands;
+    }
+
+    std::array<Step, kMaxSteps> m_steps;
+    std::size_t m_size = 0;
+    std::size_t m_commands = 0;
+    bool m_tooLong = false;
+};
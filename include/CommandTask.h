@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MpscQueue.h"
+
+/**
+ * A command handler, or part of one, that can wait for slow work.
+ *
+ * A Task is a coroutine that starts suspended. The engine starts a
+ * command's task on the game thread (see GameEngine::runAsync), and it
+ * runs until it awaits work that is not ready, typically
+ * GameEngine::offload() of a file read. The command then replies nothing,
+ * and the game goes on. When the work is done the task resumes on the game
+ * thread, inside GameEngine::idle(), with the engine free to touch. Its
+ * co_return value is sent to the player as the command's reply.
+ *
+ * Tasks can co_await other Tasks, which then run inline until they too
+ * wait. The frame outlives the handler call that made it, so a coroutine
+ * takes its arguments by value: a std::string, not the std::string_view a
+ * CommandContext hands out. Name a lambda before awaiting work made from
+ * it; GCC 12 frees a lambda's captures early inside a co_await expression.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    struct promise_type {
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;   // The task awaiting this one, if any
+
+        Task get_return_object() noexcept { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Hand the thread straight to whoever was waiting for the result
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+                const std::coroutine_handle<> next = self.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        template <typename U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    // Run it until it first waits or finishes; for the owner of the outermost task
+    void start() { m_handle.resume(); }
+    bool done() const noexcept { return !m_handle || m_handle.done(); }
+
+    // The result of a finished task; rethrows what escaped it
+    T take() {
+        promise_type& promise = m_handle.promise();
+        if (promise.error) {
+            std::rethrow_exception(promise.error);
+        }
+        return std::move(*promise.value);
+    }
+
+    // co_await runs the task, resuming the awaiting coroutine when it is done
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Task& task;
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                task.m_handle.promise().continuation = awaiting;
+                return task.m_handle;
+            }
+            T await_resume() { return task.take(); }
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    explicit Task(Handle handle) noexcept : m_handle(handle) {}
+
+    void reset() noexcept {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+        m_handle = {};
+    }
+
+    Handle m_handle;
+};
+
+/**
+ * The worker threads that async commands' slow work runs on, and the queue
+ * of coroutines waiting to be resumed on the game thread once it is done.
+ *
+ * run() makes an awaitable: awaiting it queues the work and suspends the
+ * coroutine; a worker calls the work, keeps its result (or exception) in
+ * the awaitable, which lives in the suspended frame, and posts the frame
+ * to the ready queue, calling wake so the game thread stops waiting.
+ * resumeReady(), on the game thread, resumes them. A coroutine therefore
+ * only ever runs on the game thread, whatever its work ran on.
+ *
+ * The destructor joins the workers. Work not yet started is dropped, and
+ * its coroutines stay suspended for whoever owns their Tasks to destroy.
+ */
+class AsyncExecutor {
+public:
+    explicit AsyncExecutor(unsigned threads, std::function<void()> wake = {});
+    ~AsyncExecutor();
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    template <typename F>
+    class Offload {
+    public:
+        using Result = std::invoke_result_t<F&>;
+
+        Offload(AsyncExecutor& executor, F work) : m_executor(executor), m_work(std::move(work)) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting) {
+            m_executor.submit([this] {
+                try {
+                    if constexpr (std::is_void_v<Result>) {
+                        m_work();
+                    } else {
+                        m_result.emplace(m_work());
+                    }
+                } catch (...) {
+                    m_error = std::current_exception();
+                }
+            }, awaiting);
+        }
+        Result await_resume() {
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+            if constexpr (!std::is_void_v<Result>) {
+                return std::move(*m_result);
+            }
+        }
+
+    private:
+        struct Nothing {};
+
+        AsyncExecutor& m_executor;
+        F m_work;
+        std::optional<std::conditional_t<std::is_void_v<Result>, Nothing, Result>> m_result;
+        std::exception_ptr m_error;
+    };
+
+    // co_await run(work): work() on a worker, the coroutine resumed with its result on the game thread
+    template <typename F>
+    Offload<F> run(F work) {
+        return Offload<F>(*this, std::move(work));
+    }
+
+    // Game thread: resume the coroutines whose work has finished; how many
+    std::size_t resumeReady();
+    // Work queued or running, not yet resumed
+    std::size_t inFlight() const noexcept { return m_inFlight.load(std::memory_order_relaxed); }
+
+    // For a coroutine whose work runs somewhere else, such as Storage's
+    // thread: hold() as it suspends, then post() it from wherever the work
+    // finishes, to resume it in resumeReady()
+    void hold() noexcept { m_inFlight.fetch_add(1, std::memory_order_relaxed); }
+    void post(std::coroutine_handle<> resume);
+
+    // Any thread; takes effect for the next post
+    void setWake(std::function<void()> wake);
+
+private:
+    struct Job {
+        std::function<void()> work;
+        std::coroutine_handle<> resume;
+    };
+
+    void submit(std::function<void()> work, std::coroutine_handle<> resume);
+    void workerLoop();
+
+    std::mutex m_wakeMutex;
+    std::function<void()> m_wake;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<Job> m_jobs;
+    bool m_stopping = false;
+    std::vector<std::thread> m_threads;
+    MpscQueue<std::coroutine_handle<>> m_done;
+    std::atomic<std::size_t> m_inFlight{0};
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+/**
+ * A submitted line split into its verb and arguments, without copying.
+ *
+ * Surrounding whitespace is dropped, the verb ends at the first whitespace
+ * and the arguments are the rest with leading whitespace removed. The
+ * arguments are a view into the line, which must outlive the tokens; the
+ * verb is lowercased (ASCII) into a small buffer held inline. A verb longer
+ * than the buffer, which cannot name any command, is passed through as typed.
+ * A line opening with punctuation takes that one mark as its verb, so the
+ * usual MUD shorthand `'hello` reads as the verb `'` with argument `hello`.
+ */
+class CommandTokens {
+public:
+    static constexpr std::size_t kMaxVerbLength = 32;
+
+    explicit CommandTokens(std::string_view line) noexcept {
+        constexpr std::string_view kSpace = " \t\n\r\f\v";
+        const std::size_t start = line.find_first_not_of(kSpace);
+        if (start == std::string_view::npos) {
+            return;
+        }
+        line = line.substr(start, line.find_last_not_of(kSpace) + 1 - start);
+
+        const std::string_view verb = isPunctuation(line.front()) ? line.substr(0, 1)
+                                                                  : line.substr(0, line.find_first_of(kSpace));
+        if (verb.size() <= kMaxVerbLength) {
+            std::transform(verb.begin(), verb.end(), m_verbBuffer.begin(), [](char c) {
+                return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+            });
+            m_verb = {m_verbBuffer.data(), verb.size()};
+        } else {
+            m_verb = verb;
+        }
+
+        if (verb.size() < line.size()) {
+            m_args = line.substr(verb.size());
+            m_args.remove_prefix(std::min(m_args.find_first_not_of(kSpace), m_args.size()));
+        }
+    }
+
+    // The tokens view into this object's buffer, so they are not copied
+    CommandTokens(const CommandTokens&) = delete;
+    CommandTokens& operator=(const CommandTokens&) = delete;
+
+    bool empty() const noexcept { return m_verb.empty(); }
+    std::string_view verb() const noexcept { return m_verb; }
+    std::string_view args() const noexcept { return m_args; }
+
+private:
+    static bool isPunctuation(char c) noexcept {
+        return c >= '!' && c <= '~' && !(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'z') && !(c >= 'A' && c <= 'Z');
+    }
+
+    std::array<char, kMaxVerbLength> m_verbBuffer;
+    std::string_view m_verb;
+    std::string_view m_args;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Result of a Tab completion lookup for one partial word
+struct Completion {
+    std::string extension;              // Text every match continues the word with
+    std::vector<std::string> matches;   // Whole words, in order; at most kMaxMatches
+    std::size_t total = 0;              // Words found, including any not listed or repeated
+
+    static constexpr std::size_t kMaxMatches = 64;
+
+    // Combine with the matches of another source
+    void merge(Completion&& other);
+};
+
+/**
+ * Prefix tree of words for Tab completion.
+ *
+ * Words are keyed case-insensitively (ASCII) and keep their own spelling.
+ * Nodes live in one vector and hold their children as a small sorted array,
+ * so finding a prefix costs one short scan per character no matter how many
+ * words are stored, and the shared extension is read off the single-child
+ * path below it. Each node counts the words beneath it: insert and erase
+ * adjust those counts along one path, so the trie is updated in place as
+ * commands or players come and go, and emptied branches are simply skipped.
+ * The same word may be inserted more than once and is kept until erased as
+ * often.
+ */
+class CompletionTrie {
+public:
+    CompletionTrie() { clear(); }
+
+    void insert(std::string_view word);
+    void erase(std::string_view word);
+    void clear();
+
+    bool contains(std::string_view word) const;
+    bool empty() const noexcept { return m_nodes[0].words == 0; }
+
+    // Add the words starting with prefix to completion
+    void complete(std::string_view prefix, Completion& completion) const;
+
+private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Node {
+        std::vector<std::pair<char, std::uint32_t>> children;   // Sorted by key byte
+        std::uint32_t words = 0;        // Words ending at or below this node
+        std::uint32_t terminal = 0;     // Words ending here
+        std::string word;               // Spelling of the word ending here
+    };
+
+    static char fold(char ch) noexcept {
+        return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch;
+    }
+
+    std::uint32_t child(std::uint32_t node, char key) const noexcept;
+    std::uint32_t find(std::string_view prefix) const noexcept;
+    void collect(std::uint32_t node, std::vector<std::string>& out) const;
+
+    std::vector<Node> m_nodes;   // m_nodes[0] is the root
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "EntityStore.h"
+#include "GameWorld.h"
+#include "ItemCatalog.h"
+#include "SmallVector.h"
+#include "StringInterner.h"
+
+// Components the engine attaches to world entities. Anything else may be
+// attached by scripts or extensions the same way; the store takes any type.
+
+// What players call it, as they would type it; items take theirs from the
+// prototype. Interned, so a spawn allocates nothing for it and a checkpoint
+// reading an old page never sees it freed
+struct Named {
+    Symbol name = kNoSymbol;
+};
+
+// An instance of a kind of item
+struct Item {
+    const ItemPrototype* prototype = nullptr;
+};
+
+// Lying in a room rather than being carried
+struct InRoom {
+    RoomId room = kInvalidRoomId;
+};
+
+// In someone's Inventory
+struct CarriedBy {
+    Entity holder;
+};
+
+// What an entity is carrying; each item has a CarriedBy naming the holder.
+// Most carry a handful, which fit without allocating
+struct Inventory {
+    SmallVector<Entity, 16> items;
+};
+
+// The body a connected player acts through
+struct PlayerBody {
+    PlayerId player = kInvalidPlayerId;
+};
+
+// A creature the game moves itself. One that wanders takes a random exit
+// within its zone every wanderTicks, but only while players are in the zone.
+// One with a behaviour tree runs that instead, every wanderTicks or, for 0,
+// the engine's default
+struct Npc {
+    std::uint32_t wanderTicks = 0;   // 0 to stay put
+    std::uint64_t nextMove = 0;      // Boundary of its next move, counted like timers
+    std::uint32_t random = 1;        // Its own xorshift state, so its moves are reproducible
+    std::uint32_t behavior = UINT32_MAX;   // Its tree (see BehaviorTree.h), or kNoBehavior
+};
+
+// Regained by regen every regeneration tick, up to max
+struct Health {
+    std::int32_t current = 100;
+    std::int32_t max = 100;
+    std::int32_t regen = 1;
+};
+
+// How an entity fights; one without this fights as the defaults do. These
+// are its own; what it carries and its affects are added on top (see
+// DerivedStats)
+struct CombatStats {
+    std::int32_t attack = 5;    // Added to its rolls to hit
+    std::int32_t defense = 5;   // Taken off its attackers' rolls
+    std::int32_t damage = 6;    // Most one hit does
+};
+
+// Something on an entity that changes its stats for a while, like a spell
+struct Affect {
+    Symbol name = kNoSymbol;
+    StatBonus bonus;
+    std::uint32_t ticksLeft = 0;   // Worn off when it reaches 0; 0 from the start for until taken off
+};
+
+struct Affects {
+    SmallVector<Affect, 4> active;
+};
+
+// CombatStats with everything carried and every affect added, kept until
+// one of them changes. GameEngine::invalidateStats marks it dirty; the
+// dirty are worked out again together at the start of the next tick, or
+// on the spot by anything that reads them first
+struct DerivedStats {
+    CombatStats effective;
+    bool dirty = true;
+};
+
+// Gone once it has lived this many more ticks, wherever it is
+struct Decay {
+    std::uint32_t ticksLeft = 0;
+};
@@ -3,31 +3,31 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <deque>
+#include <cstdint>
+#include <string_view>
 #include <atomic>
 #include <optional>
-#include <mutex>
+#include <chrono>
+#include <thread>
 #include <functional>
 #include <unordered_map>
-#include <fstream>  // For debug logging
+#include <utility>
+#include <cstdio>   // For the headless terminal streams
 #include <expected>  // For std::expected
 #include <curses.h>
+#include "AdminClient.h"
 #include "GameEngine.h"
+#include "LatencyHistogram.h"
 #include "CommandLineEditor.h"
+#include "ColorMarkup.h"
+#include "MpscQueue.h"
+#include "RingBuffer.h"
+#include "ScrollbackExport.h"
+#include "TextArena.h"
+#include "TextWrap.h"
 #include "SignalHandler.h"  // For SignalHandler and SignalError
-
-// Enable debug mode
-#define DEBUG_MODE 1
-
-// Rename DEBUG_LOG to CONSOLE_DEBUG_LOG
-#undef DEBUG_LOG
-#define CONSOLE_DEBUG_LOG(msg) ConsoleUI::logDebug(msg)
-
-// Debug macros
-#if DEBUG_MODE
-    #define DEBUG_LOG(msg) ConsoleUI::logDebug(msg)
-#else
-    #define DEBUG_LOG(msg)
-#endif
+#include "VtRenderer.h"
 
 // Define error types for window resizing
 enum class ResizeError {
@@ -43,6 +43,13 @@ enum class InitError {
     TERMINAL_TOO_SMALL
 };
 
+// What draws the screen: curses' doupdate(), or VtRenderer's own cell grid
+// and escape sequences, with curses left only to decode keys
+enum class ConsoleBackend {
+    Curses,
+    Vt
+};
+
 /**
  * ConsoleUI class manages the user interface of the application using ncurses.
  * It handles input/output, window management, and coordinates with the game engine.
@@ -52,17 +59,37 @@ private:
     // Define the signal callback type
     using SignalCallback = SignalHandler::SignalCallback;
     
+    // Off-screen ncurses terminal used by createHeadless(); output goes to an
+    // anonymous temporary file, so drawing and doupdate() do their full work
+    // unseen and takeTerminalBytes() can count what they sent. The VT backend
+    // uses one too, reading the real terminal's keys (interactive).
+    // Declared before the windows so they are deleted before its screen.
+    struct HeadlessTerminal {
+        SCREEN* screen = nullptr;
+        std::FILE* out = nullptr;
+        std::FILE* in = nullptr;
+        bool interactive = false;
+        ~HeadlessTerminal();
+    };
+    std::unique_ptr<HeadlessTerminal> m_headless;
+
+    // Draws the screen in place of doupdate() when the VT backend is in use
+    std::unique_ptr<VtRenderer> m_vt;
+    std::string m_vtScratch;   // The input line, read back from its window
+
     // Window management with RAII unique pointers
     std::unique_ptr<WINDOW, decltype(&delwin)> m_outputWin{nullptr, delwin};
     std::unique_ptr<WINDOW, decltype(&delwin)> m_outputBorderWin{nullptr, delwin};
     std::unique_ptr<WINDOW, decltype(&delwin)> m_inputWin{nullptr, delwin};
     std::unique_ptr<WINDOW, decltype(&delwin)> m_inputBorderWin{nullptr, delwin};
+    std::unique_ptr<WINDOW, decltype(&delwin)> m_statusWin{nullptr, delwin};   // Absent on short terminals
 
     // Terminal dimensions
     int m_termHeight;
     int m_termWidth;
     int m_outputHeight = 20;
     int m_inputHeight = 3;
+    int m_statusHeight = 0;
     const int m_minHeight = 3;
     const int m_minWidth = 10;
     
@@ -75,12 +102,97 @@ private:
     // Game engine instance (now a shared_ptr)
     GameEnginePtr m_game;
     
+    // Last dispatched command, cached so repeated commands skip the registry lookup
+    std::string m_cachedCommandName;
+    CommandHandle m_cachedCommand;
+    
     // Command line editor that handles input and history
     std::unique_ptr<CommandLineEditor> m_lineEditor;
 
-    // Output buffer for game messages
-    std::vector<std::string> m_outputBuffer;
-    int m_scrollOffset = 0;
+    // One screen row of a message: a slice of its text
+    using WrappedRow = WrapSpan;
+
+    // A scrollback message with its rows wrapped to m_wrapWidth
+    struct OutputMessage {
+        TextArena::Span text;         // Bytes in m_outputText, markup removed
+        attr_t attributes = 0;        // ncurses attributes for text before the first run
+        std::vector<AttributeRun> runs;
+        TextMetrics metrics;          // Display width etc., measured once for every rewrap
+        std::vector<WrappedRow> rows;
+        std::uint64_t firstRow = 0;   // Scrollback-wide number of rows[0]
+    };
+
+    // Scrollback of game messages; the oldest message is overwritten once full.
+    // Messages are wrapped once when added and again only when the width changes.
+    // Their text lives in m_outputText, whose chunks are recycled as the window slides.
+    RingBuffer<OutputMessage> m_outputBuffer;
+    TextArena m_outputText{TextArena::kDefaultChunkSize, MemoryTag::UiBuffer};
+    std::string m_markupScratch;   // Reused while stripping color markup
+    int m_wrapWidth = 0;
+    std::uint64_t m_nextRow = 0;   // Row number the next message starts at
+    int m_scrollOffset = 0;        // Rows scrolled back from the newest
+
+    // After a width change only the newest messages are rewrapped at once;
+    // messages before m_wrappedFrom still hold rows for the old width and are
+    // rewrapped newest-first on idle passes or when scrolled into. Row numbers
+    // restart at kFirstRow so they can count down into that history.
+    static constexpr std::uint64_t kFirstRow = std::uint64_t{1} << 62;
+    static constexpr std::size_t kRewrapBatch = 256;   // Messages per idle pass
+    std::size_t m_wrappedFrom = 0;
+
+    // Wrapped rows are rendered once into a pad as they are first shown, and
+    // scrolling only stages a different part of it. Row r lives in pad line
+    // r % m_padRows; the pad holds the contiguous rows [m_padFrom, m_padTo),
+    // at most m_padRows of them, and reuses the lines of the rows furthest
+    // from whatever it renders next. A width change starts it over.
+    static constexpr int kOutputPadRows = 1024;
+    std::unique_ptr<WINDOW, decltype(&delwin)> m_outputPad{nullptr, delwin};
+    int m_padRows = 0;
+    std::uint64_t m_padFrom = 0;
+    std::uint64_t m_padTo = 0;
+
+    // Scrollback search (/search TEXT). Every message holding the needle is
+    // indexed when the search starts and each new one as it arrives, so F3 and
+    // Shift+F3 step to the next hit without scanning. Hits are session-wide
+    // message numbers, which stay valid as the ring slides; those of evicted
+    // messages are dropped from the front.
+    std::uint64_t m_nextMessage = 0;          // Number the next message gets
+    std::string m_searchNeedle;               // Empty when not searching
+    std::deque<std::uint64_t> m_searchHits;   // Matching message numbers, oldest first
+    std::size_t m_searchCursor = 0;           // Hit last jumped to
+
+    // Screen regions that need repainting. Set from any thread; the UI loop
+    // repaints and flushes only what is marked, and nothing when it is clean
+    enum RedrawRegion : std::uint8_t {
+        RedrawNone      = 0,
+        RedrawFrame     = 1 << 0,   // Borders and titles
+        RedrawOutput    = 1 << 1,
+        RedrawInput     = 1 << 2,
+        RedrawCursor    = 1 << 3,
+        RedrawStatus    = 1 << 4,   // The latency readout on the input frame
+        RedrawStatusBar = 1 << 5,   // Status bar fields whose value changed
+        RedrawAll       = RedrawFrame | RedrawOutput | RedrawInput | RedrawCursor | RedrawStatus | RedrawStatusBar
+    };
+    std::atomic<std::uint8_t> m_dirty{RedrawAll};
+
+    // Output that arrives without a keystroke (engine messages, other threads)
+    // is coalesced so a burst costs one doupdate per frame interval
+    static constexpr std::chrono::milliseconds kFrameInterval{16};
+    std::chrono::steady_clock::time_point m_nextFrame{};
+
+    void markDirty(std::uint8_t regions) { m_dirty.fetch_or(regions, std::memory_order_release); }
+
+    // The run loop sleeps in poll() on stdin and this pipe; wake() writes to
+    // it so messages from other threads are shown without waiting for a key
+    int m_wakeReadFd = -1;
+    std::atomic<int> m_wakeWriteFd{-1};
+
+    void openWakeup();
+    void closeWakeup();
+    void waitForEvents(std::chrono::steady_clock::time_point deadline);
+
+    // Cleared in a moved-from object so its destructor leaves ncurses alone
+    bool m_ownsScreen = true;
 
     // Thread-safe flag indicating if the UI is running
     std::atomic<bool> m_isRunning{false};
@@ -88,24 +200,125 @@ private:
     // Result of window setup - may contain error if the terminal is too small
     std::optional<bool> m_resizeStatus;
     
-    // Mutex for thread-safe access to the output buffer
-    std::mutex m_outputMutex;
+    // Messages posted from other threads; the UI thread moves them into the
+    // scrollback at the start of each frame, so producers never wait on drawing
+    MpscQueue<std::string> m_pendingOutput;
+    
+    // Bracketed paste: the terminal wraps pasted text in these keys, defined
+    // to ncurses at startup, and the text between them is gathered here and
+    // taken in one pass rather than as a key, and a redraw, a character
+    bool m_pasting = false;
+    std::string m_pasteBuffer;
+    
+    // Input-to-echo latency. Each key is stamped when wgetch() returns it and
+    // measured when the frame showing its effect has been flushed; a command
+    // from its submission to the flush of the first output after its echo.
+    // F12 shows percentiles of the last half minute or so on the input
+    // frame's bottom edge, refreshed at most every kLatencyStatusInterval.
+    static constexpr std::chrono::seconds kLatencyWindow{30};
+    static constexpr std::chrono::milliseconds kLatencyStatusInterval{500};
+    static constexpr std::size_t kMaxUnechoedKeys = 256;   // Stamps kept for one frame
+    struct EchoLatency {
+        LatencyWindow keys{kLatencyWindow};
+        LatencyWindow commands{kLatencyWindow};
+    };
+    std::unique_ptr<EchoLatency> m_latency;   // On the heap: the histograms cannot move
+    std::vector<std::chrono::steady_clock::time_point> m_keysUnechoed;
+    std::optional<std::chrono::steady_clock::time_point> m_commandSubmitted;
+    bool m_commandAnswered = false;
+    bool m_showLatency = false;
+    std::uint64_t m_latencyRecords = 0;
+    std::uint64_t m_latencyShown = 0;         // m_latencyRecords as of the status last drawn
+    std::chrono::steady_clock::time_point m_nextLatencyStatus{};
+    
+    // Status bar: a row of fields under the input, each a label and a value
+    // its provider is asked for once per interval. A field whose value has
+    // not changed is not drawn again, and a field keeps a column slot of its
+    // own width, so one changing never moves the others.
+    static constexpr int kStatusBarMinHeight = 8;   // Terminal rows below which there is no bar
+    struct StatusField {
+        std::string label;
+        int width = 0;   // Value columns
+        std::chrono::milliseconds interval{};
+        std::function<std::string()> provider;
+        std::string value;
+        std::chrono::steady_clock::time_point due{};
+        int column = -1;   // Where the label starts; -1 when it does not fit
+        bool changed = true;
+    };
+    std::vector<StatusField> m_statusFields;
+    
+    // /export [FILE]: the scrollback is snapshotted here and written on the
+    // export's own thread, which reports back through postOutput(). Declared
+    // after m_pendingOutput so it is joined before the queue goes away.
+    std::unique_ptr<ScrollbackExport> m_export;
+    
+    // Attached to a running server (attach()), lines go over its admin
+    // socket and what it sends comes back through postOutput(); there is no
+    // engine in this process then. After m_pendingOutput for the same reason
+    std::unique_ptr<AdminClient> m_remote;
+    void startExport(std::string_view file);
+    
+    void addDefaultStatusFields();
+    void layoutStatusFields();
+    std::chrono::steady_clock::time_point refreshStatusFields(std::chrono::steady_clock::time_point now);
+    void drawStatusBar(bool all);
+    void composeVtStatusBar(bool all);
     
     // Signal handler callbacks
     SignalCallback m_interruptCallback;
     SignalCallback m_terminateCallback;
 
-    // Debug logging
-    static std::ofstream debugLogFile;
-
     // UI methods
-    void handleInput();
+    bool handleInput();   // False when no key was waiting
+    void finishPaste();
+    void submitCommand(const std::string& command);
     void handleResize();
-    void drawLayout();
+    void drawLayout(std::uint8_t regions = RedrawAll);
+    bool render();   // False when nothing was dirty
+    bool framePending() const;
+    void placeCursor();
+    void stampKey(std::chrono::steady_clock::time_point arrived);
+    void recordFrameLatency();
+    std::string latencyStatus();
+    void drawLatencyStatus();
+    void composeVtStatus();
     void drawOutputWindow();
+    void ensurePadRows(std::uint64_t from, std::uint64_t to);
+    void renderPadRows(std::uint64_t from, std::uint64_t to);
+    void stagePadRows(std::uint64_t from, int rows);
+    std::pair<std::uint64_t, std::uint64_t> visibleOutputRows(int winHeight, int winWidth);
+    template <typename BeginRow, typename DrawRun>
+    void forEachOutputRun(std::uint64_t from, std::uint64_t to, BeginRow&& beginRow, DrawRun&& drawRun) const;
+    static std::optional<ConsoleUI> createVt();
+    void composeVt(std::uint8_t regions);
+    void composeVtBox(WINDOW* window, const char* title);
+    void composeVtOutput();
+    VtStyle vtStyle(attr_t attributes) const;
+    void resizeFromTerminal();
     void drawInputWindow();
-    void addOutputMessage(const std::string& message);
-    void processCommand(const std::string& command);
+    void appendOutput(std::string_view text, attr_t attributes = COLOR_PAIR(1));
+    void releaseEvictedText();
+    void drainPendingOutput();
+    void rewrapOutput(int width);
+    void wrapOlder(std::size_t index);
+    void ensureRows(std::uint64_t rows);
+    bool rewrapStep(std::size_t messages);
+    int outputWindowHeight() const;
+    std::uint64_t outputRowCount() const;
+    std::size_t messageAtRow(std::uint64_t row) const;
+    std::uint64_t maxScrollOffset() const;
+    std::uint64_t topVisibleRow() const;
+    void scrollBy(int rows);
+    void scrollToRow(std::uint64_t row);
+    bool searchOutput(std::string_view needle, bool older);
+    bool startSearch(std::string_view needle);
+    bool stepSearch(bool older);
+    void jumpToMessage(std::size_t index);
+    void dropEvictedHits();
+    std::uint64_t firstMessageNumber() const { return m_nextMessage - m_outputBuffer.size(); }
+    std::string outputTitle() const;
+    void processCommand(std::string_view command);
     void cleanupNcurses();
     bool initializeNcurses();
     std::optional<bool> setupWindows(int height, int width);
@@ -125,6 +338,14 @@ private:
     void cleanupSignalHandlers();
 
 public:
+    // Messages kept in the scrollback unless setScrollbackCapacity() says otherwise
+    static constexpr std::size_t kDefaultScrollback = 10'000;
+    static constexpr int kScrollStep = 5;       // Rows per PageUp/PageDown
+    static constexpr const char* kHistoryFile = ".echomud_history";   // In the working directory
+    static constexpr int kKeyPasteBegin = KEY_MAX + 1;   // ESC [ 200 ~
+    static constexpr int kKeyPasteEnd = KEY_MAX + 2;     // ESC [ 201 ~
+    static constexpr std::size_t kMaxPasteBytes = 1 << 20;   // Beyond this a paste is cut short
+
     // Constructor with terminal dimensions and player name
     ConsoleUI(int termHeight, int termWidth, const std::string& playerName = "Kieran");
     
@@ -140,7 +361,41 @@ public:
     ConsoleUI& operator=(ConsoleUI&& other) noexcept;
 
     // Factory method to create and initialize the UI
-    static std::optional<ConsoleUI> create();
+    static std::optional<ConsoleUI> create(ConsoleBackend backend = ConsoleBackend::Curses);
+    
+    // Create a UI drawing to an in-memory ncurses screen of the given size,
+    // with no terminal or signal handlers; for benchmarks and tooling
+    static std::optional<ConsoleUI> createHeadless(int height, int width,
+                                                   ConsoleBackend backend = ConsoleBackend::Curses);
+    
+    // Bytes drawing has sent to a headless UI's screen since the last call;
+    // 0 for a UI on a real terminal
+    std::uint64_t takeTerminalBytes();
+    
+    // One frame of the run loop: drain posted output, draw what is dirty and
+    // flush it. Returns false if nothing needed drawing.
+    bool renderFrame() { return render(); }
+    
+    // Produces a status bar field's current value; called on the UI thread
+    using StatusProvider = std::function<std::string()>;
+    
+    // Ask for a value to show in the status bar every interval, after label,
+    // in width columns. Values longer than that are cut short. Returns the
+    // field's index; the bar is laid out again on the next resize.
+    std::size_t addStatusField(std::string label, int width, std::chrono::milliseconds interval,
+                               StatusProvider provider);
+    
+    // Mark every window for repainting on the next frame
+    void invalidate() {
+        if (m_lineEditor) m_lineEditor->invalidate();
+        markDirty(RedrawAll);
+    }
+    
+    // Resize the screen and windows as a terminal resize would
+    void resize(int height, int width);
+    
+    // Scroll the output as PageUp/PageDown do: positive rows are older
+    void scrollOutput(int rows) { scrollBy(rows); }
     
     // Main UI loop
     void run();
@@ -148,11 +403,28 @@ public:
     // Stop the UI loop
     void stop();
     
+    // Make the run loop check for new output now; callable from any thread
+    void wake();
+    
+    // Queue a message for the output window; callable from any thread
+    void postOutput(std::string message);
+    
+    // Add a message to the scrollback now, as a frame does with posted ones; UI thread only
+    void addOutputMessage(const std::string& message);
+    
+    // Resize the scrollback, keeping the newest messages that fit; UI thread only
+    void setScrollbackCapacity(std::size_t messages);
+    std::size_t scrollbackCapacity() const { return m_outputBuffer.capacity(); }
+    
     // Process a game command
-    void handleGameCommand(const std::string& cmd, const std::string& args);
+    void handleGameCommand(std::string_view cmd, std::string_view args);
+    
+    // Drive the server listening on the admin socket at path, playing as
+    // name, instead of the engine in this process. Only once the UI is
+    // where it will stay: the socket's reader posts to this object
+    std::expected<void, std::string> attach(const std::string& path, std::string_view name);
 
     // Debug methods
     static void initDebugLog();
-    static void logDebug(const std::string& message);
     void logMemoryStats() const;
 };
\ No newline at end of file
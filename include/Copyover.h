@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A connection as one process hands it to the next
+struct CopyoverSession {
+    std::uint16_t reactor = 0;
+    int fd = -1;
+    bool compressed = false;        // MCCP2 was on: the stream was ended, the client's DO stands
+    std::uint16_t width = 0;        // Columns the client reported with NAWS; 0 for none
+    std::string input;              // Typed since the last line break
+    std::vector<std::string> queued;   // Lines waiting for their ticks
+    std::uint32_t outOfBand = 0;    // OutOfBand::subscriptions(); 0 for none
+    std::string name;               // Empty while logging in
+    std::string player;             // PlayerSave::encode() of the character, once playing
+    bool echoOff = false;           // At the password prompt, so the client is not echoing
+};
+
+// Everything the process being replaced passes on: the listening sockets
+// of each reactor (telnet, then WebSocket or -1) and every connection
+struct CopyoverState {
+    std::vector<std::array<int, 2>> listeners;
+    std::vector<CopyoverSession> sessions;
+};
+
+/**
+ * Hot restart ("copyover"): the process execs a new binary in its place
+ * and the sockets go with it, so players stay connected across a deploy.
+ *
+ * The only state not carried in a descriptor is the CopyoverState, written
+ * to an unlinked temporary file whose descriptor is inherited as well and
+ * named on the new process's command line. Fields are netstrings
+ * ("5:hello,"), so names, typed input and the binary player saves need no
+ * escaping.
+ */
+class Copyover {
+public:
+    // The new process's command line: the old one's, one of these added
+    static constexpr std::string_view kOption = "--copyover";
+
+    // The state in a file that survives exec; -1 if it could not be written
+    static int save(const CopyoverState& state);
+    // Read the state that file holds, and close it; empty if it is damaged
+    static std::optional<CopyoverState> load(int fd);
+
+    // Replace the process with executable, run with arguments and then
+    // kOption and stateFd, every descriptor the state names inherited.
+    // Returns only if the exec failed, with errno set
+    static void exec(const std::filesystem::path& executable, const std::vector<std::string>& arguments,
+                     const CopyoverState& state, int stateFd);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "GameWorld.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+// What packing an area's descriptions saves, and what reading them costs
+struct DescriptionStats {
+    std::size_t packed = 0;               // Distinct descriptions stored packed
+    std::uint64_t textBytes = 0;          // Their size as text
+    std::uint64_t packedBytes = 0;        // Their size packed, with the dictionary
+    std::size_t hotEntries = 0;
+    std::uint64_t hotBytes = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;             // Each one a decompression
+    std::chrono::nanoseconds unpackTime{0};
+};
+
+/**
+ * Packs descriptions for an area file as zstd frames against a dictionary
+ * trained on them all, which holds the phrases a world repeats ("a narrow
+ * passage", "the walls are") once instead of in every room. Frames carry
+ * neither dictionary id nor checksum, as the file has only one dictionary.
+ *
+ * Without zstd built in, or with too little text to learn from, there is
+ * no dictionary and nothing is packed.
+ */
+class DescriptionPacker {
+public:
+    // Descriptions shorter than this gain less than the frame costs
+    static constexpr std::size_t kMinPackedSize = 64;
+
+    explicit DescriptionPacker(std::span<const std::string_view> samples);
+    ~DescriptionPacker();
+
+    DescriptionPacker(const DescriptionPacker&) = delete;
+    DescriptionPacker& operator=(const DescriptionPacker&) = delete;
+
+    bool ready() const noexcept { return m_dictionary != nullptr; }
+    std::string_view dictionary() const noexcept { return m_dictionaryBytes; }
+
+    // text as a frame in out; false when it would not come out smaller
+    bool pack(std::string_view text, std::string& out);
+
+private:
+    std::string m_dictionaryBytes;
+    ZSTD_CDict_s* m_dictionary = nullptr;
+    ZSTD_CCtx_s* m_context = nullptr;
+};
+
+/**
+ * The room descriptions an area file keeps packed, unpacked as rooms are
+ * looked at.
+ *
+ * The frames stay in the mapping, so a cold description costs its
+ * compressed pages and nothing else. The last hotBytes of text unpacked
+ * are kept in a least-recently-used list, keyed by frame so rooms sharing a
+ * description share an entry; rooms people keep walking through are
+ * unpacked once, and the engine's render cache copies from here when a
+ * room's view goes stale. Zone actors render on their own threads, so the
+ * list is behind a mutex that is never held while unpacking.
+ */
+class DescriptionStore {
+public:
+    static constexpr std::size_t kDefaultHotBytes = std::size_t{4} << 20;
+
+    // Whether zstd is built in; area files with packed rooms need it
+    static bool available() noexcept;
+
+    // frames[room] is the room's packed description, or empty where it is
+    // stored as text; the views, like the dictionary, live in the mapping
+    DescriptionStore(std::string_view dictionary, std::vector<std::string_view> frames, std::uint64_t textBytes,
+                     std::size_t hotBytes = kDefaultHotBytes);
+    ~DescriptionStore();
+
+    DescriptionStore(const DescriptionStore&) = delete;
+    DescriptionStore& operator=(const DescriptionStore&) = delete;
+
+    // False when the dictionary would not load
+    bool valid() const noexcept { return m_dictionary != nullptr; }
+    bool packed(RoomId room) const noexcept { return room < m_frames.size() && !m_frames[room].empty(); }
+
+    // Append room's description to out; false when it is not packed here
+    // or its frame is damaged. From any thread
+    bool append(RoomId room, std::string& out);
+
+    DescriptionStats stats() const;
+
+private:
+    struct Hot {
+        const char* frame;
+        std::string text;
+    };
+
+    std::vector<std::string_view> m_frames;   // By RoomId
+    ZSTD_DDict_s* m_dictionary = nullptr;
+    std::size_t m_hotLimit;
+    DescriptionStats m_totals;                // The packed sizes, counted once
+
+    mutable std::mutex m_mutex;
+    std::list<Hot> m_hot;                     // Most recently read first
+    std::unordered_map<const char*, std::list<Hot>::iterator> m_hotIndex;
+    std::uint64_t m_hotBytes = 0;
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+    std::chrono::nanoseconds m_unpackTime{0};
+};
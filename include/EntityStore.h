@@ -0,0 +1,442 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MemoryAccounting.h"
+
+/**
+ * Handle to something in the world: an item, an NPC or a player's body.
+ *
+ * The index picks the entity's slot and the generation says which of the
+ * entities that have used the slot this is, so a handle kept after its
+ * entity was destroyed is simply no longer alive instead of dangling or
+ * naming whatever took the slot next.
+ */
+struct Entity {
+    static constexpr std::uint32_t kNoIndex = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = kNoIndex;
+    std::uint32_t generation = 0;
+
+    friend bool operator==(Entity, Entity) = default;
+};
+
+inline constexpr Entity kInvalidEntity{};
+
+namespace entity_detail {
+    inline std::size_t nextComponentType() {
+        static std::atomic<std::size_t> next{0};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A dense id per component type, handed out on first use
+    template <typename T>
+    std::size_t componentType() {
+        static const std::size_t type = nextComponentType();
+        return type;
+    }
+
+    // What a snapshot holds of one pool
+    struct PoolImage {
+        virtual ~PoolImage() = default;
+    };
+
+    struct PoolBase {
+        virtual ~PoolBase() = default;
+        virtual void remove(std::uint32_t index) = 0;
+        virtual std::unique_ptr<PoolImage> capture() = 0;
+        virtual std::uint64_t pagesCopied() const noexcept = 0;
+    };
+
+    // A fixed block of components and the entities that own them
+    template <typename T, std::size_t Size>
+    struct Page {
+        std::array<T, Size> values{};
+        std::array<Entity, Size> owners{};
+    };
+
+    template <typename T, std::size_t Size>
+    struct PoolImageOf final : PoolImage {
+        std::vector<std::shared_ptr<const Page<T, Size>>> pages;
+        std::size_t size = 0;
+    };
+
+    // Sparse set: the components of one type packed densely, with a sparse
+    // array from entity index to position for constant-time lookup. The
+    // dense side is a list of fixed pages rather than one array, so a pool
+    // of millions grows a page at a time, never copies what it holds, and a
+    // component stays where it is until one before it is removed.
+    //
+    // Pages are shared with snapshots: capture() hands every page to the
+    // image as it stands and counts a new share, and any page last made
+    // private under an older count is copied before its next change. Reads
+    // through const access never copy; changes copy at most a page a
+    // snapshot, and only the pages they touch
+    template <typename T>
+    struct Pool final : PoolBase {
+        static constexpr std::uint32_t kAbsent = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::size_t kPageBits = 8;
+        static constexpr std::size_t kPageSize = std::size_t{1} << kPageBits;
+        using PageType = Page<T, kPageSize>;
+
+        std::vector<std::uint32_t> positions;   // By entity index; kAbsent if it has none
+        std::vector<std::shared_ptr<PageType>> pages;
+        std::vector<std::uint32_t> pageShares;  // By page; the share count it was last made private under
+        std::uint32_t shares = 0;               // Snapshots taken of this pool
+        std::uint64_t copies = 0;               // Pages copied because a snapshot held them
+        std::size_t count = 0;
+
+        std::size_t size() const noexcept { return count; }
+
+        // The page to change, copied first if a snapshot may still see it
+        PageType& writable(std::size_t page) {
+            if (pageShares[page] != shares) {
+                pages[page] = std::allocate_shared<PageType>(TrackedAllocator<PageType>(MemoryTag::World), *pages[page]);
+                pageShares[page] = shares;
+                ++copies;
+            }
+            return *pages[page];
+        }
+
+        T& at(std::size_t position) {
+            return writable(position >> kPageBits).values[position & (kPageSize - 1)];
+        }
+
+        const T& at(std::size_t position) const noexcept {
+            return pages[position >> kPageBits]->values[position & (kPageSize - 1)];
+        }
+
+        Entity owner(std::size_t position) const noexcept {
+            return pages[position >> kPageBits]->owners[position & (kPageSize - 1)];
+        }
+
+        void setOwner(std::size_t position, Entity entity) {
+            writable(position >> kPageBits).owners[position & (kPageSize - 1)] = entity;
+        }
+
+        T* find(std::uint32_t index) {
+            if (index >= positions.size() || positions[index] == kAbsent) {
+                return nullptr;
+            }
+            return &at(positions[index]);
+        }
+
+        const T* find(std::uint32_t index) const {
+            if (index >= positions.size() || positions[index] == kAbsent) {
+                return nullptr;
+            }
+            return &at(positions[index]);
+        }
+
+        template <typename... Args>
+        T& emplace(Entity entity, Args&&... args) {
+            if (T* existing = find(entity.index)) {
+                *existing = T{std::forward<Args>(args)...};
+                return *existing;
+            }
+            if (entity.index >= positions.size()) {
+                positions.resize(static_cast<std::size_t>(entity.index) + 1, kAbsent);
+            }
+            const std::size_t position = count++;
+            if (position == pages.size() * kPageSize) {
+                // Pages are counted as the world's until the last snapshot holding one lets go
+                pages.push_back(std::allocate_shared<PageType>(TrackedAllocator<PageType>(MemoryTag::World)));
+                pageShares.push_back(shares);
+            }
+            positions[entity.index] = static_cast<std::uint32_t>(position);
+            setOwner(position, entity);
+            T& value = at(position);
+            value = T{std::forward<Args>(args)...};
+            return value;
+        }
+
+        // The last component takes the removed one's place, keeping the pool
+        // dense; the slot it leaves is reset so it holds on to nothing
+        void remove(std::uint32_t index) override {
+            if (index >= positions.size() || positions[index] == kAbsent) {
+                return;
+            }
+            const std::uint32_t position = std::exchange(positions[index], kAbsent);
+            const std::size_t last = --count;
+            if (position != last) {
+                at(position) = std::move(at(last));
+                const Entity moved = owner(last);
+                setOwner(position, moved);
+                positions[moved.index] = position;
+            }
+            at(last) = T{};
+        }
+
+        std::unique_ptr<PoolImage> capture() override {
+            auto image = std::make_unique<PoolImageOf<T, kPageSize>>();
+            image->pages.assign(pages.begin(), pages.end());
+            image->size = count;
+            ++shares;
+            return image;
+        }
+
+        std::uint64_t pagesCopied() const noexcept override { return copies; }
+    };
+} // namespace entity_detail
+
+/**
+ * Entity-component storage for the world's items, NPCs and bodies.
+ *
+ * An entity is only a handle; what it is comes from the components attached
+ * to it, any copyable, default-constructible struct. Each component type
+ * lives in its own sparse set, so the components a system reads (every
+ * Health for regeneration, every Decay for rot) sit packed together in
+ * pages of their own and are visited without touching anything else. The
+ * pages are the pool every component, item instances included, is carved
+ * from. Looking up, adding and removing a component are constant time.
+ *
+ * snapshot() takes a point-in-time image of every pool for a checkpoint
+ * thread to read while the game carries on, sharing the pages copy-on-write.
+ *
+ * each() walks its first component type's pool and skips entities missing
+ * the others, so put the rarest type first. While it runs, entities may not
+ * be created or destroyed and the visited types may not be added or removed;
+ * collect the handles and make such changes afterwards.
+ */
+class EntityStore {
+    template <typename T>
+    using Pool = entity_detail::Pool<T>;
+
+public:
+    EntityStore() = default;
+    EntityStore(EntityStore&&) noexcept = default;
+    EntityStore& operator=(EntityStore&&) noexcept = default;
+
+    Entity create() {
+        if (!m_freeIndices.empty()) {
+            const std::uint32_t index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+            ++m_alive;
+            return {index, m_generations[index]};
+        }
+        m_generations.push_back(0);
+        ++m_alive;
+        return {static_cast<std::uint32_t>(m_generations.size() - 1), 0};
+    }
+
+    // Destroy an entity and all its components; stale handles are ignored
+    void destroy(Entity entity) {
+        if (!alive(entity)) {
+            return;
+        }
+        for (const auto& pool : m_pools) {
+            if (pool) {
+                pool->remove(entity.index);
+            }
+        }
+        ++m_generations[entity.index];
+        m_freeIndices.push_back(entity.index);
+        --m_alive;
+    }
+
+    bool alive(Entity entity) const noexcept {
+        return entity.index < m_generations.size() && m_generations[entity.index] == entity.generation;
+    }
+
+    // Live entities
+    std::size_t size() const noexcept { return m_alive; }
+
+    // Attach a component, replacing any of the same type already there
+    template <typename T, typename... Args>
+    T& add(Entity entity, Args&&... args) {
+        return pool<T>().emplace(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void remove(Entity entity) {
+        if (alive(entity)) {
+            pool<T>().remove(entity.index);
+        }
+    }
+
+    // The entity's component of type T, or nullptr
+    template <typename T>
+    T* find(Entity entity) {
+        Pool<T>* found = alive(entity) ? existingPool<T>() : nullptr;
+        return found ? found->find(entity.index) : nullptr;
+    }
+
+    template <typename T>
+    const T* find(Entity entity) const {
+        const Pool<T>* found = alive(entity) ? existingPool<T>() : nullptr;
+        return found ? found->find(entity.index) : nullptr;
+    }
+
+    template <typename T>
+    bool has(Entity entity) const {
+        return find<T>(entity) != nullptr;
+    }
+
+    // Entities with a component of type T
+    template <typename T>
+    std::size_t count() const {
+        const Pool<T>* found = existingPool<T>();
+        return found ? found->size() : 0;
+    }
+
+    // Call fn(entity, first, others...) for every entity with all the types
+    template <typename First, typename... Others, typename Fn>
+    void each(Fn&& fn) {
+        visit<true, First, Others...>(pool<First>(), std::tuple<Pool<Others>*...>{&pool<Others>()...}, fn);
+    }
+
+    // The same with const components; allocates and copies nothing, so
+    // readers on several threads may share the store while nobody changes it
+    template <typename First, typename... Others, typename Fn>
+    void each(Fn&& fn) const {
+        Pool<First>* first = existingPool<First>();
+        const std::tuple<Pool<Others>*...> others{existingPool<Others>()...};
+        if (!first || ((std::get<Pool<Others>*>(others) == nullptr) || ...)) {
+            return;
+        }
+        visit<false, First, Others...>(*first, others, fn);
+    }
+
+    /**
+     * The store's components as they were when it was taken, for reading
+     * on another thread while the game goes on. Taking one copies no
+     * components: it shares every page, and the store copies a page the
+     * first time it changes one afterwards. A snapshot may outlive the
+     * store, but item prototypes and the like that components point to
+     * must outlive the snapshot.
+     */
+    class Snapshot {
+    public:
+        // Live entities when it was taken
+        std::size_t size() const noexcept { return m_alive; }
+
+        template <typename T>
+        std::size_t count() const {
+            const Image<T>* image = find<T>();
+            return image ? image->size : 0;
+        }
+
+        // Call fn(entity, component) for every component of type T
+        template <typename T, typename Fn>
+        void each(Fn&& fn) const {
+            const Image<T>* image = find<T>();
+            if (!image) {
+                return;
+            }
+            for (std::size_t position = 0; position < image->size; ++position) {
+                const auto& page = *image->pages[position >> Pool<T>::kPageBits];
+                const std::size_t slot = position & (Pool<T>::kPageSize - 1);
+                fn(page.owners[slot], static_cast<const T&>(page.values[slot]));
+            }
+        }
+
+    private:
+        friend class EntityStore;
+
+        template <typename T>
+        using Image = entity_detail::PoolImageOf<T, Pool<T>::kPageSize>;
+
+        template <typename T>
+        const Image<T>* find() const {
+            const std::size_t type = entity_detail::componentType<T>();
+            return type < m_pools.size() ? static_cast<const Image<T>*>(m_pools[type].get()) : nullptr;
+        }
+
+        std::vector<std::unique_ptr<entity_detail::PoolImage>> m_pools;   // By component type
+        std::size_t m_alive = 0;
+    };
+
+    Snapshot snapshot() {
+        Snapshot image;
+        image.m_pools.resize(m_pools.size());
+        for (std::size_t type = 0; type < m_pools.size(); ++type) {
+            if (m_pools[type]) {
+                image.m_pools[type] = m_pools[type]->capture();
+            }
+        }
+        image.m_alive = m_alive;
+        return image;
+    }
+
+    // Pages copied so far because a snapshot still shared them
+    std::uint64_t pagesCopied() const noexcept {
+        std::uint64_t copies = 0;
+        for (const auto& pool : m_pools) {
+            copies += pool ? pool->pagesCopied() : 0;
+        }
+        return copies;
+    }
+
+private:
+    template <typename T>
+    Pool<T>& pool() {
+        const std::size_t type = entity_detail::componentType<T>();
+        if (type >= m_pools.size()) {
+            m_pools.resize(type + 1);
+        }
+        if (!m_pools[type]) {
+            m_pools[type] = std::make_unique<Pool<T>>();
+        }
+        return static_cast<Pool<T>&>(*m_pools[type]);
+    }
+
+    // A component for changing, or for reading without copying its page
+    template <bool Writing, typename T>
+    static auto lookup(Pool<T>* pool, std::uint32_t index) {
+        if constexpr (Writing) {
+            return pool->find(index);
+        } else {
+            return std::as_const(*pool).find(index);
+        }
+    }
+
+    template <bool Writing, typename First, typename... Others, typename Fn>
+    static void visit(Pool<First>& first, const std::tuple<Pool<Others>*...>& others, Fn& fn) {
+        using Block = std::conditional_t<Writing, typename Pool<First>::PageType, const typename Pool<First>::PageType>;
+        // Page by page, so the inner loop walks one contiguous block
+        const std::size_t count = first.size();
+        for (std::size_t page = 0; page * Pool<First>::kPageSize < count; ++page) {
+            Block* block = nullptr;
+            if constexpr (Writing) {
+                block = &first.writable(page);
+            } else {
+                block = first.pages[page].get();
+            }
+            const std::size_t base = page * Pool<First>::kPageSize;
+            const std::size_t end = std::min(Pool<First>::kPageSize, count - base);
+            for (std::size_t i = 0; i < end; ++i) {
+                const Entity entity = block->owners[i];
+                if constexpr (sizeof...(Others) == 0) {
+                    fn(entity, block->values[i]);
+                } else {
+                    const auto found = std::make_tuple(lookup<Writing>(std::get<Pool<Others>*>(others), entity.index)...);
+                    std::apply([&](auto*... rest) {
+                        if (((rest != nullptr) && ...)) {
+                            fn(entity, block->values[i], *rest...);
+                        }
+                    }, found);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    Pool<T>* existingPool() const {
+        const std::size_t type = entity_detail::componentType<T>();
+        return type < m_pools.size() ? static_cast<Pool<T>*>(m_pools[type].get()) : nullptr;
+    }
+
+    std::vector<std::uint32_t> m_generations;   // By entity index; bumped on destroy
+    std::vector<std::uint32_t> m_freeIndices;
+    std::size_t m_alive = 0;
+    std::vector<std::unique_ptr<entity_detail::PoolBase>> m_pools;   // By component type
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "InlineDelegate.h"
+#include "MpscQueue.h"
+
+/**
+ * Typed events from the threads that cause them to the threads that care,
+ * with no lock and no text on the way.
+ *
+ * The event types are fixed by the bus's own type, so each has an id at
+ * compile time (idOf<E>) and a bit in a mask of what anyone listens for;
+ * publishing a type nobody subscribed to is that one test, and nothing is
+ * formatted for an event no one renders. A consumer is a thread that
+ * drains: it is added, with a way to wake it, and subscribes handlers to
+ * the types it wants, an array of them per type, before anything is
+ * published, so none of that changes under a publisher.
+ *
+ * Each publishing thread has a Publisher of its own, which gathers events
+ * into a batch and hands it over at flush(): one MpscQueue push to each
+ * consumer that wants anything in it, the batch shared among them, and a
+ * wake for any consumer not already woken. drain() then runs the consumer's
+ * handlers over every batch waiting, in the order its publisher flushed
+ * them; events from two publishers have no order between them.
+ */
+template <typename... Events>
+class EventBus {
+public:
+    static_assert(sizeof...(Events) <= 64, "One mask bit per event type");
+
+    using Event = std::variant<Events...>;
+    using ConsumerId = std::uint32_t;
+    template <typename E>
+    using Handler = InlineDelegate<void(const E&)>;
+
+    template <typename E>
+    static constexpr std::size_t idOf = [] {
+        std::size_t id = 0;
+        (void)((std::is_same_v<E, Events> ? false : (++id, true)) && ...);
+        return id;
+    }();
+
+    // Gathers one thread's events; flushes what is left when it goes
+    class Publisher {
+    public:
+        explicit Publisher(EventBus& bus) : m_bus(&bus) {}
+        ~Publisher() { flush(); }
+
+        Publisher(Publisher&& other) noexcept
+            : m_bus(other.m_bus), m_batch(std::move(other.m_batch)), m_mask(std::exchange(other.m_mask, 0)) {
+            other.m_batch.clear();
+        }
+        Publisher(const Publisher&) = delete;
+        Publisher& operator=(const Publisher&) = delete;
+
+        template <typename E>
+        void publish(E event) {
+            if (m_bus->listening<E>()) {
+                m_batch.emplace_back(std::in_place_type<E>, std::move(event));
+                m_mask |= bit<E>();
+            }
+        }
+
+        // Hand what has gathered to the consumers that want any of it
+        void flush() {
+            if (m_batch.empty()) {
+                return;
+            }
+            const auto batch = std::make_shared<const std::vector<Event>>(std::move(m_batch));
+            m_batch = {};
+            m_batch.reserve(batch->size());
+            for (const auto& consumer : m_bus->m_consumers) {
+                if (consumer->mask.load(std::memory_order_relaxed) & m_mask) {
+                    consumer->batches.push(batch);
+                    if (!consumer->signalled.exchange(true, std::memory_order_acq_rel) && consumer->wake) {
+                        consumer->wake();
+                    }
+                }
+            }
+            m_mask = 0;
+        }
+
+    private:
+        EventBus* m_bus;
+        std::vector<Event> m_batch;
+        std::uint64_t m_mask = 0;   // The types in m_batch
+    };
+
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Before anything is published. wake is called from a publisher's
+    // thread when batches start waiting; it should make the consumer drain
+    ConsumerId addConsumer(std::function<void()> wake) {
+        auto& consumer = m_consumers.emplace_back(std::make_unique<Consumer>());
+        consumer->wake = std::move(wake);
+        return static_cast<ConsumerId>(m_consumers.size() - 1);
+    }
+
+    // Before anything is published; handlers run on the consumer's thread
+    template <typename E>
+    void subscribe(ConsumerId consumer, Handler<E> handler) {
+        Consumer& into = *m_consumers[consumer];
+        std::get<std::vector<Handler<E>>>(into.handlers).push_back(std::move(handler));
+        into.mask.fetch_or(bit<E>(), std::memory_order_relaxed);
+        m_mask.fetch_or(bit<E>(), std::memory_order_relaxed);
+    }
+
+    // Nothing more is queued for the consumer or wakes it, and what waits
+    // is dropped with the bus. On the publishers' thread, or once none of
+    // them is flushing, since one part way through may still wake it
+    void removeConsumer(ConsumerId id) {
+        m_consumers[id]->mask.store(0, std::memory_order_relaxed);
+        std::uint64_t mask = 0;
+        for (const auto& consumer : m_consumers) {
+            mask |= consumer->mask.load(std::memory_order_relaxed);
+        }
+        m_mask.store(mask, std::memory_order_relaxed);
+    }
+
+    template <typename E>
+    bool listening() const noexcept {
+        return (m_mask.load(std::memory_order_relaxed) & bit<E>()) != 0;
+    }
+
+    // The consumer's thread only: run its handlers over every waiting
+    // batch; returns how many events they were given
+    std::size_t drain(ConsumerId id) {
+        Consumer& consumer = *m_consumers[id];
+        consumer.signalled.store(false, std::memory_order_seq_cst);
+        std::size_t handled = 0;
+        while (const auto batch = consumer.batches.pop()) {
+            for (const Event& event : **batch) {
+                handled += std::visit([&consumer](const auto& each) { return consumer.dispatch(each); }, event);
+            }
+        }
+        return handled;
+    }
+
+private:
+    template <typename E>
+    static constexpr std::uint64_t bit() noexcept {
+        static_assert(idOf<E> < sizeof...(Events), "Not one of this bus's events");
+        return std::uint64_t{1} << idOf<E>;
+    }
+
+    struct Consumer {
+        MpscQueue<std::shared_ptr<const std::vector<Event>>> batches;
+        std::tuple<std::vector<Handler<Events>>...> handlers;
+        std::atomic<std::uint64_t> mask{0};   // The types subscribed to
+        std::function<void()> wake;
+        std::atomic<bool> signalled{false};   // Woken since the last drain
+
+        template <typename E>
+        std::size_t dispatch(const E& event) const {
+            const auto& subscribed = std::get<std::vector<Handler<E>>>(handlers);
+            for (const Handler<E>& handler : subscribed) {
+                handler(event);
+            }
+            return subscribed.empty() ? 0 : 1;
+        }
+    };
+
+    std::vector<std::unique_ptr<Consumer>> m_consumers;
+    std::atomic<std::uint64_t> m_mask{0};   // Every consumer's together
+};
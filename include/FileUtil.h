@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <unistd.h>
+
+/**
+ * What the append-only segment files have in common: the journal's and the
+ * message store's. Both lay records end to end at 8-byte boundaries and
+ * make them durable with the cheapest sync the platform offers.
+ */
+namespace FileUtil {
+
+// size rounded up to the next record boundary
+inline std::size_t padded(std::size_t size) {
+    return (size + 7) / 8 * 8;
+}
+
+// The file's data on disk. fdatasync skips the metadata a reader does not
+// need; macOS has only fsync
+inline bool syncFile(int fd) {
+#ifdef __APPLE__
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0;
+#endif
+}
+
+} // namespace FileUtil
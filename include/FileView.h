@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#include <string>
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Read-only view of a whole file: mapped where the platform allows it,
+ * otherwise read into memory. Empty when the file is missing or empty.
+ * Moving keeps the bytes where they are, so views into them stay valid.
+ * A file's bytes already in memory can be viewed the same way, taken over
+ * by the view.
+ */
+class FileView {
+public:
+    FileView() = default;
+
+    explicit FileView(const std::filesystem::path& path) {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary);
+        m_copy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        m_bytes = m_copy;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat info{};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                m_bytes = {static_cast<const char*>(mapping), static_cast<std::size_t>(info.st_size)};
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    // Heap-allocated, so aligned as operator new aligns
+    explicit FileView(std::string bytes) : m_copy(std::move(bytes)), m_bytes(m_copy) {}
+
+    ~FileView() { release(); }
+
+    FileView(FileView&& other) noexcept { *this = std::move(other); }
+
+    FileView& operator=(FileView&& other) noexcept {
+        if (this != &other) {
+            release();
+            if (other.m_bytes.data() == other.m_copy.data()) {
+                // A short copy may live inside the string, so the view is remade
+                m_copy = std::move(other.m_copy);
+                m_bytes = m_copy;
+                other.m_copy.clear();
+                other.m_bytes = {};
+            } else {
+                m_bytes = std::exchange(other.m_bytes, {});
+            }
+        }
+        return *this;
+    }
+
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+
+    std::string_view bytes() const noexcept { return m_bytes; }
+
+    // Ask for the pages under range, a part of bytes(), to be read in ahead
+    // of use; nothing for bytes that are not mapped
+    void willNeed(std::string_view range) const noexcept {
+#ifndef _WIN32
+        if (range.empty() || m_bytes.data() == m_copy.data() || range.data() < m_bytes.data() ||
+            range.data() + range.size() > m_bytes.data() + m_bytes.size()) {
+            return;
+        }
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t from = static_cast<std::size_t>(range.data() - m_bytes.data()) / page * page;
+        const std::size_t to = static_cast<std::size_t>(range.data() + range.size() - m_bytes.data());
+        ::madvise(const_cast<char*>(m_bytes.data()) + from, to - from, MADV_WILLNEED);
+#else
+        (void)range;
+#endif
+    }
+
+private:
+    void release() noexcept {
+#ifndef _WIN32
+        if (!m_bytes.empty() && m_bytes.data() != m_copy.data()) {
+            ::munmap(const_cast<char*>(m_bytes.data()), m_bytes.size());
+        }
+#endif
+        m_copy.clear();
+        m_bytes = {};
+    }
+
+    std::string m_copy;   // Bytes read or handed over rather than mapped
+    std::string_view m_bytes;
+};
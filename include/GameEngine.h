@@ -3,67 +3,858 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <memory_resource>
+#include <format>
+#include <iterator>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <variant>
 #include <optional>
+#include <expected>
 #include <filesystem>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <span>
 #include "GameWorld.h"
-
-// Forward declaration of ConsoleUI for DEBUG_LOG
-class ConsoleUI;
-
-// Define DEBUG_LOG for GameEngine.cpp
-// This makes sure it's defined regardless of inclusion order
-#ifndef DEBUG_LOG
-    // Forward declare the logging function
-    namespace internal {
-        void logDebug(const std::string& msg);
-    }
-    #define DEBUG_LOG(msg) internal::logDebug(msg)
+#include "Components.h"
+#include "KeywordIndex.h"
+#include "NameIndex.h"
+#include "BuiltinCommands.h"
+#include "InlineDelegate.h"
+#include "HookPipeline.h"
+#include "GameEvents.h"
+#include "CompletionTrie.h"
+#include "CommandIndex.h"
+#include "Rcu.h"
+#include "CommandArgs.h"
+#include "CommandSequence.h"
+#include "ChatChannels.h"
+#include "CommandTask.h"
+#include "MessageStore.h"
+#include "Storage.h"
+#include "Socials.h"
+#include "ScriptStore.h"
+#include "CombatRound.h"
+#include "ReplyPool.h"
+#include "SharedMessage.h"
+#include "TextFiles.h"
+#include "ShardMap.h"
+#include "Random.h"
+#include "TickScheduler.h"
+#include "JobSystem.h"
+#include "Pathfinder.h"
+#include "AutoMap.h"
+#include "WorldSnapshot.h"
+#include "AreaFile.h"
+#include "DescriptionStore.h"
+#include "ZonePrefetcher.h"
+#include "ZoneAmbience.h"
+#include "BehaviorTree.h"
+#include "Logger.h"
+#include "Metrics.h"
+#ifdef ENABLE_LUA_SCRIPTING
+#include "ScriptRunnerPool.h"
+#include "ScriptWatcher.h"
 #endif
 
+class PlayerSave;
+struct WorldStatus;
+
 // Forward declaration for shared_ptr usage
 class GameEngine;
 using GameEnginePtr = std::shared_ptr<GameEngine>;
 
+// The ways the command pipeline itself fails, each with a fixed reply
+enum class DispatchError : std::uint8_t {
+    UnknownPlayer,
+    UnknownCommand,   // The reply names the command
+    StaleHandle,
+    Blocked,          // A before-hook refused it
+    ExitInSequence,
+    Failed            // The handler threw; the reply names the command
+};
+
+// A player bound for a zone another shard runs (see GameEngine::takeHandoffs)
+struct ShardHandoff {
+    PlayerId player;
+    RoomId room;
+};
+
+// Called with the channel's name and the line whenever a player speaks on
+// one, for a front end to relay to the other shards
+using ChannelRelay = InlineDelegate<void(std::string_view channel, std::string_view message)>;
+
 // Command result can be a success with a message or an error
 struct CommandResult {
     enum class Status { Success, Error };
-    Status status;
+    Status status = Status::Success;
     std::string message;
+    std::uint32_t lag = 0;   // Ticks the player waits before their next command runs
+    
+    CommandResult() = default;
+    CommandResult(Status status, std::string message) noexcept : status(status), message(std::move(message)) {}
+    CommandResult(const CommandResult&) = default;
+    CommandResult(CommandResult&&) noexcept = default;
+    CommandResult& operator=(const CommandResult&) = default;
+    // Swapped, so the message replaced goes back to the pool with other
+    CommandResult& operator=(CommandResult&& other) noexcept {
+        status = other.status;
+        message.swap(other.message);
+        lag = other.lag;
+        return *this;
+    }
+    // The reply has been sent by now; its buffer serves the next one
+    ~CommandResult() { ReplyPool::recycle(message); }
     
     // Static factory methods for cleaner code
     static CommandResult success(std::string msg) {
         return CommandResult{Status::Success, std::move(msg)};
     }
+    static CommandResult success(const char* msg) { return success(literal(msg)); }
     
     static CommandResult error(std::string msg) {
         return CommandResult{Status::Error, std::move(msg)};
     }
+    static CommandResult error(const char* msg) { return error(literal(msg)); }
+    // The reply for a pipeline failure; subject is the command it concerns
+    static CommandResult error(DispatchError failure, std::string_view subject = {});
+    
+private:
+    static std::string literal(const char* msg) {
+        std::string text = ReplyPool::take();
+        text.append(msg);
+        return text;
+    }
 };
 
-// Define the structure for command entries
-struct CommandEntry {
+// A text built a line at a time, with where each line ends recorded as it
+// goes, so what pages through it walks the offsets instead of looking for
+// the breaks again
+struct TextLines {
+    std::string text;
+    std::vector<std::uint32_t> ends;   // Offset of the '\n' closing each line
+
+    // Close the line appended to text since the last one
+    void endLine() {
+        ends.push_back(static_cast<std::uint32_t>(text.size()));
+        text += '\n';
+    }
+    std::size_t size() const noexcept { return ends.size(); }
+    std::string_view line(std::size_t i) const noexcept {
+        const std::size_t start = i == 0 ? 0 : ends[i - 1] + 1;
+        return std::string_view(text).substr(start, ends[i] - start);
+    }
+};
+
+// A player's line for GameEngine::runCommands; the result is filled in
+struct QueuedCommand {
+    PlayerId player = kInvalidPlayerId;
+    std::string line;
+    CommandResult result{};
+};
+
+// How GameEngine::runCommands executes a batch
+enum class ExecutionMode : std::uint8_t {
+    Serial,       // In order, on the calling thread
+    ZoneActors    // Each zone's commands on its own actor, zones in parallel
+};
+
+// Totals for the NPCs of every zone since the engine started
+struct NpcStats {
+    std::uint64_t zoneWakes = 0;   // Zones a player entered while they slept
+    std::uint64_t moves = 0;       // Made while someone could see
+    std::uint64_t caughtUp = 0;    // Made unseen on waking, for the time a zone slept
+    std::uint64_t deferred = 0;    // Zone turns passed up while the ticks were shedding work
+    std::uint64_t zonesLoaded = 0; // Area zones whose NPCs and items were spawned on first entry
+    std::uint64_t zonesUnloaded = 0; // Put away after standing empty, to be spawned afresh
+};
+
+// What running one behaviour tree has cost since it was loaded
+struct BehaviorStats {
+    std::uint64_t runs = 0;            // NPCs it was walked for
+    std::uint64_t nodes = 0;           // Nodes those walks reached
+    std::chrono::nanoseconds time{};   // Spent walking it, its Lua leaves included
+    std::uint64_t luaCalls = 0;
+    std::chrono::nanoseconds luaTime{};
+};
+
+// Spawning done to populate and reset one area zone since the engine started
+struct ZoneRepopStats {
+    std::uint64_t spawned = 0;         // NPCs and items put in place
+    std::uint64_t slices = 0;          // Ticks, or arrivals, that did some of it
+    std::chrono::nanoseconds time{};   // Spent spawning, taken from those ticks
+};
+
+// Private copies of zones (see GameEngine::createInstance) since the engine started
+struct InstanceStats {
+    std::uint64_t created = 0;   // Opened, on fresh rooms or a closed instance's
+    std::uint64_t reused = 0;    // Of those, on a closed instance's rooms and zone
+    std::uint64_t closed = 0;    // Put away after standing empty
+    std::uint64_t live = 0;      // Open now
+    std::uint64_t rooms = 0;     // Copies in the room graph, open or waiting for reuse
+};
+
+// Totals for ExecutionMode::ZoneActors
+struct ZoneStats {
+    std::uint64_t batches = 0;          // Batches run on zone actors
+    std::uint64_t zoneRuns = 0;         // Zone mailboxes run, summed over the batches
+    std::uint64_t commands = 0;         // Commands run on a zone actor
+    std::uint64_t serialCommands = 0;   // Not zone-local, so run on the calling thread afterwards
+    std::uint64_t handoffs = 0;         // Moves into another zone
+};
+
+// Counters and latencies of one command, kept by name across re-registration.
+// Recorded into from whichever thread dispatches it, without locking
+struct CommandMetrics {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> errors{0};    // Ended in CommandResult::error
+    std::atomic<std::uint64_t> blocked{0};   // Of those, stopped by a before hook
+    LatencyHistogram dispatch;               // The whole of it: hooks, arguments and handler
+    LatencyHistogram hooks;                  // Before and after hooks, when there are any
+    LatencyHistogram handler;
+    LatencyHistogram script;                 // Time in Lua, for script commands
+    PerfTotals counters;                     // Hardware counters over dispatch, while PerfCounters is enabled
+};
+
+// Per-invocation state handed to command handlers. Built on the stack for each
+// dispatch so the hot path does no reference counting.
+struct CommandContext {
+    GameEngine& engine;
+    PlayerId player;
+    const CommandArgs& args;   // Parsed by the entry's syntax; only raw() without one
+    CommandMetrics* metrics = nullptr;
+    std::string_view verb = {};   // As typed; the entry's name when run by handle
+};
+
+// Command handlers are stored inline; captures that don't fit fall back to std::function
+using CommandHandler = InlineDelegate<CommandResult(CommandContext&, std::string_view)>;
+
+// Slot of a command in the engine's command table: built-ins by their
+// BuiltinCommand value, runtime commands after them in registration order
+using CommandId = std::uint32_t;
+
+// A command as it is registered. The engine keeps what dispatch reads as a
+// CommandEntry and the text only help and errors read as a CommandText
+struct CommandSpec {
     std::string name;
     std::string help;
     std::string description;
-    std::function<CommandResult(GameEnginePtr, std::string_view)> handler;
+    CommandHandler handler;
+    bool abbreviate = true;   // Whether unique prefixes of the name resolve to it
+    std::string syntax{};     // Argument spec (see ArgumentSchema); empty passes args through
+    // Reads only the world and changes it only through sendToPlayer, the
+    // broadcasts and moves, so it may run on a zone actor
+    bool zoneLocal = false;
+    // Wait state it leaves its player in, in ticks; a handler may ask for more
+    std::uint32_t lag = 0;
+    // Where a line running it ranks among a busy tick's (see TickScheduler)
+    CommandPriority priority = CommandPriority::Normal;
+};
+
+// The dispatch record of a registered command. Only what every call reads
+// is here, so a lookup and dispatch never pull help text into cache
+struct CommandEntry {
+    CommandHandler handler;
+    ArgumentSchema arguments{};          // Compiled from the spec's syntax
+    CommandMetrics* metrics = nullptr;   // The engine owns it
+    Symbol symbol = kNoSymbol;           // Interned name
+    CommandId id = 0;                    // Its slot, and its CommandText's
+    std::uint32_t lag = 0;
+    bool abbreviate = true;
+    bool zoneLocal = false;
+    CommandPriority priority = CommandPriority::Normal;
+
+    std::string_view name() const noexcept { return StringInterner::global().view(symbol); }
+};
+
+// A registered command's text, kept apart from its CommandEntry
+struct CommandText {
+    std::string help;
+    std::string description;
+    std::string syntax;
+};
+
+// The commands as lookups and dispatch see them, by CommandId: built-ins in
+// the fixed slots a compile-time perfect hash picks, runtime commands after
+// them. The game thread builds a new snapshot for every change and
+// publishes it whole (see Rcu.h); a published one never changes, so readers
+// on any thread need no lock. Entries and text are shared between
+// snapshots, so a change copies pointers, not commands.
+struct CommandSnapshot {
+    std::vector<std::shared_ptr<const CommandEntry>> entries;   // Null for an empty slot
+    std::vector<std::shared_ptr<const CommandText>> text;
+    CommandIndex index;   // Names, aliases and abbreviations, into entries
+    std::uint64_t generation = 0;
+};
+
+// Transparent hash so the registry can be probed with std::string_view
+// without materializing a temporary std::string
+struct TransparentStringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const noexcept {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+// Slots of runtime-registered (e.g. Lua script) commands by interned name
+using CommandRegistry = std::pmr::unordered_map<Symbol, CommandId>;
+
+// A world update for one room, run on a worker thread
+using RoomUpdate = InlineDelegate<void(RoomId, CommandBuffer&)>;
+
+/**
+ * Pre-resolved reference to a registered command.
+ * Callers that dispatch the same command repeatedly can resolve it once and
+ * reuse the handle. A handle is tied to the registry generation it was
+ * resolved against and must be re-resolved once GameEngine::isCurrent()
+ * reports it as stale.
+ */
+class CommandHandle {
+public:
+    CommandHandle() = default;
+
+    explicit operator bool() const noexcept { return m_entry != nullptr; }
+    const CommandEntry* entry() const noexcept { return m_entry; }
+
+private:
+    friend class GameEngine;
+
+    CommandHandle(const CommandEntry* entry, std::uint64_t generation) noexcept
+        : m_entry(entry), m_generation(generation) {}
+
+    const CommandEntry* m_entry = nullptr;
+    std::uint64_t m_generation = 0;
 };
 
 class GameEngine : public std::enable_shared_from_this<GameEngine> {
 private:
-    Player m_player;
-    FakeHookSystem m_hookSystem;
-    std::unordered_map<std::string, CommandEntry> m_commands;
+    // Column-wise storage for every player in the world
+    PlayerRegistry m_players;
+    
+    // Messages waiting for each player, indexed by PlayerId; a broadcast's
+    // recipients share one copy of its text
+    std::vector<std::vector<SharedMessage>> m_outbox;
+    
+    // Players whose outbox gained messages since takeRecipients(), each listed once
+    std::vector<PlayerId> m_recipients;
+    std::vector<std::uint8_t> m_listed;
+    
+    // Players changed since takeDirtyPlayers(), by PlayerId: a flag each, so
+    // zone actors mark their own players without sharing a list
+    std::vector<std::uint8_t> m_dirty;
+    
+    // World map; new players start in m_startRoom
+    RoomGraph m_world;
+    RoomId m_startRoom = kInvalidRoomId;
+    // The map as snapshots last saw it, reused until it changes
+    std::shared_ptr<const RoomGraph> m_worldImage;
+    std::uint64_t m_worldImageVersion = 0;
+    Pathfinder m_paths;
+    // A tile per zone, drawn as the zone loads; see handleMap()
+    AutoMap m_map;
+    
+    // Items, NPCs and the players' bodies. The systems update regenerates
+    // Health and counts down Decay, and is only registered while either has
+    // anything to do
+    EntityStore m_entities;
+    // What lies in each room by keyword, by RoomId; kept in step by
+    // placeInRoom() and removeFromRoom(), the only ways into and out of a room
+    std::vector<KeywordIndex> m_roomContents;
+    ItemCatalog m_items;
+    std::vector<Entity> m_playerBodies;   // By PlayerId
+    std::vector<std::string> m_playerHosts;   // By PlayerId; see setPlayerHost()
+    // A reply being paged (see paged()), by PlayerId
+    struct Pager {
+        std::function<bool(std::string&)> lines;   // A LineSource; empty unless paging
+        std::string held;   // The line after the last page, read to learn there was one
+    };
+    std::vector<Pager> m_pagers;
+    // Who follows whom, both ways, by PlayerId. A leader never follows
+    // anyone, so a group is one leader and the players listed under them
+    std::vector<PlayerId> m_leaders;
+    std::vector<std::vector<PlayerId>> m_followers;
+    enum class WatchKind : std::uint8_t { Snoop, Spectate };
+    // Who snoops or spectates whom; each watcher watches one player at
+    // most. Few at any time, so a list, and PlayerFlag::Watched kept in
+    // step so a message to someone unwatched costs one more load
+    struct Watch {
+        PlayerId watcher;
+        PlayerId source;
+        WatchKind kind;
+    };
+    std::vector<Watch> m_watches;
+    TickUpdateId m_systemsUpdate = kInvalidTickUpdateId;
+    std::vector<Entity> m_expired;
+    std::vector<std::pair<Entity, Symbol>> m_wornOff;   // Affects, by bearer and name
+    // Entities whose DerivedStats went dirty, worked out again together by
+    // m_statsUpdate at the next tick's start; registered only while any wait
+    std::vector<Entity> m_staleStats;
+    TickUpdateId m_statsUpdate = kInvalidTickUpdateId;
+    std::uint64_t m_statRecomputes = 0;
+    
+    // Fights, resolved a round at a time while there are any
+    CombatRound m_combat;
+    TickUpdateId m_combatUpdate = kInvalidTickUpdateId;
+    
+    // The day, the weather and zones' scenery, a pass every kAmbienceTicks
+    // over the zones with players in them
+    static constexpr unsigned kAmbienceTicks = 50;
+    ZoneAmbience m_ambience;
+    TickUpdateId m_ambienceUpdate = kInvalidTickUpdateId;
+    std::vector<ZoneId> m_ambientZones;
+    std::vector<AmbientBroadcast> m_ambientOut;
+    std::vector<CombatRound::Hit> m_hits;
+    std::vector<std::uint32_t> m_hitOrder;   // Into m_hits, grouped by room
+    std::vector<Entity> m_combatLeft;
+    
+    // The area file the map came from, if any. Its zones' NPCs and items
+    // are spawned the first time a player enters the zone, and put away
+    // again once nobody has been there for kZoneUnloadTicks (see unloadZone).
+    // Every kZoneResetTicks a loaded zone's records whose NPC or item is gone
+    // are queued to spawn again. Spawning is spread over the ticks, at most
+    // kRepopPerTick records a tick, zones with players in them first; a
+    // player's arrival spawns one slice at once so a small zone is whole
+    static constexpr std::uint64_t kZoneUnloadTicks = 3000;
+    static constexpr std::uint64_t kZoneResetTicks = 6000;
+    static constexpr std::size_t kRepopPerTick = 64;
+    AreaFile m_area;
+    std::vector<std::uint8_t> m_zoneLoaded;             // By ZoneId
+    std::vector<const ItemPrototype*> m_areaPrototypes; // By index in the file
+    std::unique_ptr<DescriptionStore> m_descriptions;   // When the file packed any
+    // Zones a player has come within m_prefetchRooms exits of, readied off
+    // the game thread before they load; see prefetchAround()
+    static constexpr unsigned kPrefetchRooms = 3;
+    unsigned m_prefetchRooms = kPrefetchRooms;
+    std::unique_ptr<ZonePrefetcher> m_prefetcher;       // With an area, unless turned off
+    std::vector<std::uint8_t> m_zonePrefetched;         // By ZoneId of the area; submitted since last unloaded
+    std::vector<std::uint32_t> m_prefetchSeen;          // By RoomId, the last walk to reach it
+    std::uint32_t m_prefetchWalk = 0;
+    std::vector<std::pair<RoomId, unsigned>> m_prefetchQueue;   // Rooms and steps from the start
+    
+    // The player driven by the local console
+    PlayerId m_localPlayer = kInvalidPlayerId;
+    
+    // Before/after hooks registered by modules and scripts
+    HookPipeline m_hooks;
+    // Events for other threads; the bus stays put when the engine moves.
+    // m_events is the game thread's publisher, flushed by flushEvents()
+    std::unique_ptr<GameEventBus> m_eventBus = std::make_unique<GameEventBus>();
+    GameEventBus::Publisher m_events{*m_eventBus};
+    
+    // World updates and queued player commands, run at fixed tick boundaries
+    TickScheduler m_ticks;
+    // The game thread's dice, on a stream of its own so the same seed and
+    // the same commands roll the same
+    Random m_random{Random::seed(), Random::kEngineStream};
+    
+    // The NPCs of each zone, by ZoneId. Only zones with players in them are
+    // awake and have their timer set for the next NPC to act; the rest are
+    // left alone and caught up on the moves they missed when a player
+    // arrives. After m_ticks, so the timers are cancelled before the wheel goes.
+    // What a zone keeps while it is loaded comes from a pool of its own, so
+    // unloading it hands the memory back in one release
+    struct NpcZone {
+        NpcZone()
+            : memory(&TrackedResource::of(MemoryTag::World))
+            , npcs(&memory)
+            , spawned(&memory)
+            , pending(&memory) {}
+
+        std::pmr::unsynchronized_pool_resource memory;
+        std::pmr::vector<Entity> npcs;
+        // By record, items then NPCs: what each put there, if anything yet
+        std::pmr::vector<Entity> spawned;
+        std::pmr::vector<std::uint32_t> pending;   // Records waiting to spawn, the next last
+        AreaFile::Zone records;                    // Checked when the zone loaded
+        Timer timer;
+        Timer unloadTimer;
+        Timer resetTimer;
+        bool awake = false;
+        bool queued = false;   // In m_repopQueue
+    };
+    std::vector<std::unique_ptr<NpcZone>> m_npcZones;
+    NpcStats m_npcStats;
+    // NPC behaviour trees, and what each has cost; the lock is for a metrics
+    // scrape on another thread. An NPC with a tree and no wanderTicks runs it
+    // every kBehaviorTicks
+    static constexpr std::uint32_t kBehaviorTicks = 20;
+    BehaviorTrees m_behaviors;
+    std::vector<BehaviorStats> m_behaviorStats;   // By BehaviorId
+    mutable std::mutex m_behaviorStatsMutex;
+    std::vector<Entity> m_thinking;               // A zone's NPCs due to run their trees
+    std::vector<ZoneId> m_repopQueue;   // Zones with records pending, in the order they asked
+    TickUpdateId m_repopUpdate = kInvalidTickUpdateId;
+    // By ZoneId; the lock is for a metrics scrape on another thread
+    std::vector<ZoneRepopStats> m_repopStats;
+    mutable std::mutex m_repopStatsMutex;
+    
+    // Private copies of zones. An instance is a zone of its own whose rooms
+    // follow all the world's others, one per room of its prototype zone and
+    // in the same order. They share the prototype's names and descriptions,
+    // read from the mapped area file, and spawn from its records; what an
+    // instance has of its own is its exits, 16 bytes a room, and whatever is
+    // in it. A closed instance keeps its rooms and zone for the next
+    // instance of the same zone
+    struct ZoneInstance {
+        ZoneId prototype = 0;
+        RoomId first = kInvalidRoomId;   // kInvalidRoomId for a zone that is no instance
+        bool open = false;
+    };
+    std::vector<ZoneInstance> m_instances;                       // By ZoneId
+    std::unordered_map<ZoneId, std::vector<RoomId>> m_zoneRooms;   // By prototype, found once
+    RoomId m_instanceBase = kInvalidRoomId;                      // The first instance's first room
+    InstanceStats m_instanceStats;
+    
+    // Workers for room updates and zone actors, started when first needed;
+    // a buffer per chunk of rooms
+    std::unique_ptr<JobSystem> m_jobs;
+    std::vector<int> m_workerCores;   // Where the workers run; empty for anywhere
+    std::vector<CommandBuffer> m_roomCommands;
+    
+    // A change a command made on a zone actor, made once every zone is done
+    struct ZoneEffect {
+        enum class Kind : std::uint8_t { Send, Broadcast, ZoneBroadcast, ChannelSend, Move, Handoff };
+        Kind kind;
+        PlayerId player;     // Send: to; the broadcasts and ChannelSend: except; Move and Handoff: who
+        RoomId room;         // Broadcast: where; ZoneBroadcast: the zone; ChannelSend: the channel; Move and Handoff: to
+        RoomId from;         // Move
+        Direction direction; // Move
+        std::pmr::string text;   // Send and Broadcast; in the actor's scratch
+    };
+    
+    struct ZoneMail {
+        std::size_t command;   // Index into the batch
+        const CommandEntry* entry;
+    };
+    
+    // A zone's mailbox for the batch being run and what its commands did
+    struct ZoneActor {
+        std::vector<ZoneMail> mailbox;
+        std::vector<ZoneEffect> effects;
+        std::vector<ZoneEffect> arrivals;   // Moves handed over by other zones
+        // The effects' text, taken back once the batch's effects are made
+        std::unique_ptr<ScratchArena> scratch;
+    };
+    static constexpr std::size_t kZoneScratchSize = 4 * 1024;
+    
+    ExecutionMode m_executionMode = ExecutionMode::Serial;
+    std::vector<ZoneActor> m_zoneActors;    // By ZoneId
+    std::vector<ZoneId> m_activeZones;      // With mail in the batch being run
+    std::vector<ZoneId> m_arrivalZones;     // With moves handed to them
+    std::vector<std::size_t> m_serialCommands;
+    ZoneStats m_zoneStats;
+    
+    // The actor running on this thread, if any; what it does is recorded
+    static thread_local ZoneActor* t_zone;
+    
+    // The published commands. Anything that looks one up holds an rcu::Guard
+    // for as long as it uses the entry; the game thread alone publishes
+    RcuPointer<CommandSnapshot> m_commandSnapshot;
+    
+    // Runtime command slots by name, for registration on the game thread.
+    // Their nodes come from a pool of their own, kept together with the engine
+    std::pmr::unsynchronized_pool_resource m_commandMemory{&TrackedResource::of(MemoryTag::Engine)};
+    CommandRegistry m_commands{&m_commandMemory};
+    
+    // Bumped whenever the registries change so outstanding handles can be
+    // detected as stale; each snapshot carries the value it was published at
+    std::uint64_t m_commandGeneration = 0;
+    
+    // Aliases the next snapshot's index is built with
+    std::vector<CommandIndex::Alias> m_aliases;
+    
+    // What help shows, rendered and sorted whenever the commands change, so
+    // help only copies it out; immutable once built, and replaced whole
+    struct HelpIndex {
+        struct Topic {
+            std::string name;
+            std::string summary;      // Its line of the full list, without the break
+            std::string detail;       // What help NAME shows
+            std::string searchable;   // Name, usage and description in lower case
+        };
+        TextLines list;
+        std::vector<Topic> topics;    // By name
+    };
+    std::shared_ptr<const HelpIndex> m_helpIndex;
+    
+    // What look shows of each room, by RoomId, rendered again only once the
+    // room has changed: touchRoom() bumps its version whenever an item, NPC
+    // or player arrives or leaves, and any edit to the world bumps the
+    // world's. The other players are listed once for all of them, with each
+    // one's span so a viewer can be cut out of the list without formatting.
+    // Zone actors render their own zone's rooms, so the vector is only
+    // resized on the game thread
+    struct RoomView {
+        struct Occupant {
+            PlayerId player;
+            std::uint32_t begin;   // What to cut from occupants to leave them out
+            std::uint32_t end;
+        };
+        std::uint64_t version = 0;
+        std::uint64_t renderedVersion = ~std::uint64_t{0};
+        std::uint64_t renderedWorld = 0;
+        std::string text;                  // Name, description and what lies here
+        std::string occupants;             // Every player here, or empty
+        std::vector<Occupant> spans;
+    };
+    std::vector<RoomView> m_roomViews;
+    
+    // Metrics for every command name ever registered; entries point into it.
+    // The lock is for a scrape walking it from another thread, not dispatch
+    std::unordered_map<std::string, std::unique_ptr<CommandMetrics>, TransparentStringHash, std::equal_to<>>
+        m_commandMetrics;
+    mutable std::mutex m_commandMetricsMutex;
+    
+    // What stats memory last showed, for its rates since then; under m_memoryStatsMutex
+    std::array<MemoryTagStats, kMemoryTagCount> m_memoryStatsSeen{};
+    std::chrono::steady_clock::time_point m_memoryStatsTime = MemoryAccounting::started();
+    std::mutex m_memoryStatsMutex;
+    
+    // Names for Tab completion, updated as commands are registered and players come and go
+    CompletionTrie m_commandNames;
+    CompletionTrie m_playerNames;
+    
+    // Online players by case-folded name, for tell and finger; readable
+    // from any thread, written as players come and go
+    NameIndex m_playerIndex;
+    
+    // What who shows, sorted by name: the players' list, and the admins'
+    // with each player's host beside the name, which no one else sees. Each
+    // is rebuilt at most once a second, and only when someone has come or
+    // gone since, so who is a copy in between
+    static constexpr std::chrono::seconds kWhoInterval{1};
+    struct WhoList {
+        std::shared_ptr<const TextLines> lines;
+        std::uint64_t version = 0;   // The roster it shows
+        std::chrono::steady_clock::time_point built{};
+    };
+    std::array<WhoList, 2> m_whoLists;   // The players', then the admins'
+    std::uint64_t m_rosterVersion = 1;   // Bumped as players come and go, and as their hosts are learned
+    
+    // Who listens to which channel; each channel's command is registered with the rest
+    ChatChannels m_channels;
+    ChannelRelay m_channelRelay;
+    
+    // Every social runs as the one socials command, which findCommand falls
+    // back to for a verb that names no command but a social
+    SocialTable m_socials = SocialTable::builtin();
+    
+    // The zones this engine runs, and players bound for the others
+    ShardMap m_shard;
+    std::vector<ShardHandoff> m_handoffs;
+    
+    // What scripts keep between calls, reloads and restarts; behind a
+    // pointer so the spaces scripts hold stay put as the engine moves
+    std::unique_ptr<ScriptStore> m_scriptStore = std::make_unique<ScriptStore>();
+    
+    // Commands waiting on slow work, for the player each will reply to, or
+    // kInvalidPlayerId once they have left. The tasks hold the engine they
+    // started on, so moving an engine leaves them behind. The executor comes
+    // after them so its workers are stopped before the tasks are destroyed
+    struct AsyncCommand {
+        PlayerId player = kInvalidPlayerId;
+        Task<CommandResult> task;
+    };
+    std::vector<AsyncCommand> m_asyncCommands;
+    std::filesystem::path m_saveDirectory;
+    std::function<void()> m_asyncWake;
+    std::unique_ptr<AsyncExecutor> m_async;
+    // After the executor, so its thread has posted its last query before the executor goes
+    std::unique_ptr<Storage> m_database;
+    // Boards and mail; null, and the commands say so, until the front end opens one
+    std::unique_ptr<MessageStore> m_messages;
+    std::unique_ptr<TextFiles> m_texts;   // Null, with none but the built-in help, until the front end sets a directory
+    
+#ifdef ENABLE_LUA_SCRIPTING
+    // Lua states running script commands; pure scripts may use any of them
+    std::unique_ptr<ScriptRunnerPool> m_scriptRunner;
+    std::filesystem::path m_scriptDir;
+    
+    // Hot reload: the watcher compiles changed files in the background and
+    // m_scriptFiles maps each watched file back to its command
+    std::unique_ptr<ScriptWatcher> m_scriptWatcher;
+    std::unordered_map<std::string, std::string> m_scriptFiles;
+    
+    // Hooks registered by each script, removed again when it is reloaded
+    std::unordered_map<std::string, std::vector<HookId>> m_scriptHooks;
+    
+    // Runs the scripts' tick handlers; only registered while there are any
+    TickUpdateId m_scriptTickUpdate = kInvalidTickUpdateId;
+#endif
     
     // Internal methods
+    void buildWorld();
+    void loadArea(AreaFile area);
+    void loadZone(ZoneId zone);
+    void unloadZone(ZoneId zone);
+    void prefetchAround(RoomId room);
+    void resetZone(ZoneId zone);
+    void queueRepop(NpcZone& record, ZoneId zone);
+    std::size_t repopZone(ZoneId zone, std::size_t budget);
+    void runRepop();
+    void despawn(Entity entity);
+    CombatStats computeStats(Entity entity) const;
+    void refreshStats();
+    const ZoneInstance* instanceOf(ZoneId zone) const;
+    RoomId prototypeRoom(RoomId room) const;
+    void closeInstance(ZoneId zone);
+    void registerDefaultHooks();
     void registerCommands();
-    CommandResult handleHelpCommand(std::string_view args);
+    // Readers: call under an rcu::Guard and drop the result with it
+    const CommandSnapshot& commands() const noexcept { return *m_commandSnapshot.load(); }
+    const CommandText& commandText(const CommandEntry& entry) const { return *commands().text[entry.id]; }
+    const CommandEntry* findCommand(std::string_view cmd) const;
+    // Writers, on the game thread: edit a copy of the current snapshot and publish it
+    CommandSnapshot copyCommands() const;
+    void storeCommand(CommandSnapshot& next, CommandId id, CommandSpec&& spec, ArgumentSchema&& arguments);
+    void publishCommands(CommandSnapshot&& next);
+    void rebuildCommandIndex();
+    void rebuildHelpIndex();
+    void touchRoom(RoomId room) {
+        if (room < m_roomViews.size()) {
+            ++m_roomViews[room].version;
+        }
+    }
+    // look for player, from the cached view of its room where there is one
+    CommandResult lookAround(PlayerId player);
+    CommandResult handleMap(PlayerId player);
+    CommandResult handleMotd(PlayerId player);
+    CommandResult handleWeather(PlayerId player);
+    void renderRoomView(RoomId room, RoomView& view) const;
+    void appendDescription(RoomId room, std::string& out) const;
+    CommandMetrics& metricsFor(std::string_view name);
+    void runRoomUpdate(const RoomUpdate& update);
+    // Start m_jobs on m_workerCores
+    void startJobs();
+    void runZone(ZoneActor& actor, std::span<QueuedCommand> commands);
+    void applyZoneEffect(ZoneEffect& effect);
+    void finishMove(const ZoneEffect& move);
+    void listRecipient(PlayerId player) {
+        if (!m_listed[player]) {
+            m_listed[player] = 1;
+            m_recipients.push_back(player);
+        }
+    }
+    // Into player's outbox, and by reference those of whoever watches them
+    void queueMessage(PlayerId player, const SharedMessage& message) {
+        if (m_players.state(player).flags.test(PlayerFlag::Watched)) {
+            tee(player, message);
+        }
+        pushMessage(player, message);
+    }
+    // A watcher in the room a broadcast is for is reached both ways, one
+    // straight after the other; it is told once
+    void pushMessage(PlayerId player, const SharedMessage& message) {
+        std::vector<SharedMessage>& outbox = m_outbox[player];
+        if (outbox.empty() || outbox.back() != message) {
+            outbox.push_back(message);
+            listRecipient(player);
+        }
+    }
+    void markDirty(Entity body) {
+        // Read through const access, which never copies a snapshot's page
+        if (const PlayerBody* owner = std::as_const(m_entities).find<PlayerBody>(body)) {
+            m_dirty[owner->player] = 1;
+        }
+    }
+    static std::optional<ArgumentSchema> compileSyntax(std::string_view name, std::string_view syntax);
+    std::string_view currentRoomName(PlayerId player) const;
+    CommandResult handleHelpCommand(PlayerId player, std::string_view args);
+    CommandResult handleMove(PlayerId player, Direction dir);
+    CommandResult handleGet(PlayerId player, std::string_view item);
+    CommandResult handleDrop(PlayerId player, std::string_view item);
+    CommandResult handleChannel(PlayerId player, ChannelId channel, std::string_view message);
+    CommandResult handleKill(PlayerId player, std::string_view target);
+    CommandResult handleFlee(PlayerId player);
+    CommandResult handleTell(PlayerId player, std::string_view name, std::string_view message);
+    CommandResult handleSocial(PlayerId player, std::string_view verb, const CommandArg& target);
+    CommandResult handleWho(PlayerId player);
+    CommandResult handleFinger(PlayerId player, std::string_view name);
+    CommandResult handleFollow(PlayerId player, std::string_view name);
+    // Stop player following anyone, and let go of anyone following them
+    void leaveGroup(PlayerId player);
+    void unfollow(PlayerId player);
+    // The leader's move made, taking along those following them from the room
+    void moveGroup(const MoveEvent& move);
+    CommandResult handleWatch(PlayerId player, std::string_view name, WatchKind kind);
+    // End player's watches, both ways; those watching them are told why
+    void endWatches(PlayerId player, std::string_view why);
+    void endFinishedSpectating();
+    void refreshWatched();
+    Task<CommandResult> fingerSaved(std::string name);
+    CommandResult handleBoard(PlayerId player, std::string_view board, std::string_view rest);
+    CommandResult handlePost(PlayerId player, std::string_view board, std::string_view message);
+    CommandResult handleMail(PlayerId player, std::string_view what, std::string_view rest);
+    // Made on first use, with its threads
+    AsyncExecutor& asyncExecutor();
+    // Reply for the async commands that have finished and forget them
+    void finishAsyncCommands();
+    CommandResult handleInstance(PlayerId player, std::string_view who);
+    CommandResult handleScore(PlayerId player);
+    void indexPlayers();
+    void runCombat();
+    void runAmbience(std::uint64_t tick);
+    void appendCombatant(std::pmr::string& text, Entity entity, bool capital) const;
+    RoomId roomOf(Entity entity) const;
+    void die(Entity entity);
+    void registerChannelCommand(ChannelId channel);
+    CommandResult handleInventory(PlayerId player) const;
+    Entity findInRoom(RoomId room, std::string_view name) const;
+    Entity findCarried(Entity holder, std::string_view name) const;
+    void carry(Entity holder, Entity item);
+    void putDown(Entity item, RoomId room);
+    void placeInRoom(Entity entity, RoomId room);
+    void removeFromRoom(Entity entity);
+    const KeywordIndex& roomContents(RoomId room) const {
+        static const KeywordIndex kNothing;
+        return room < m_roomContents.size() ? m_roomContents[room] : kNothing;
+    }
+    void runSystems(std::uint64_t tick);
+    void movePlayer(PlayerId player, RoomId to);
+    // Everyone given, all in one room, into to as one transition
+    void movePlayers(std::span<const PlayerId> players, RoomId to);
+    NpcZone& npcZone(ZoneId zone);
+    void wakeZone(ZoneId zone);
+    void sleepZone(ZoneId zone);
+    void runNpcs(ZoneId zone);
+    void scheduleNpcs(ZoneId zone);
+    bool wander(Entity npc, Npc& state, bool seen);
+    static std::uint32_t npcPeriod(const Npc& npc) noexcept {
+        return npc.wanderTicks != 0 || npc.behavior == kNoBehavior ? npc.wanderTicks : kBehaviorTicks;
+    }
+    // Walk the trees of m_thinking, a batch per tree
+    void runBehaviors();
+    bool behave(Entity npc, const BehaviorNode& node, BehaviorStats& stats);
+    // The entry a command runs, or why it can't; applies pending script
+    // reloads first, so the entry found is the one dispatched
+    std::expected<const CommandEntry*, DispatchError> prepareCommand(PlayerId player, std::string_view cmd);
+    std::expected<const CommandEntry*, DispatchError> prepareCommand(PlayerId player, const CommandHandle& handle);
+    CommandResult dispatch(PlayerId player, const CommandEntry& entry, std::string_view verb, std::string_view args);
+    CommandResult runSequence(PlayerId player, const CommandSequence& sequence);
+#ifdef ENABLE_LUA_SCRIPTING
+    void registerScripts();
+    void registerScriptCommand(const std::string& name, ScriptHandle handle, const std::filesystem::path& scriptPath);
+    void registerScriptHooks(const std::string& name);
+    // The script runner when a script handles event, nullptr otherwise
+    ScriptRunnerPool* scriptEvents(ScriptEvent event) {
+        return m_scriptRunner && m_scriptRunner->subscribed(event) ? m_scriptRunner.get() : nullptr;
+    }
+    CommandResult handleScriptCommand(PlayerId player, ScriptHandle script, const CommandArgs& args,
+                                      CommandMetrics* metrics);
+    CommandResult handleScriptStatsCommand();
+    CommandResult handleLuaProfileCommand(std::string_view action, std::string_view argument);
+#endif
 
 public:
-    // Constructor with player name
+    // Constructor with player name; the world is the built-in one, or the
+    // area's when it is valid()
     explicit GameEngine(std::string playerName);
+    GameEngine(std::string playerName, AreaFile area);
     
     // Initialize the game engine after construction
     void initialize();
@@ -82,18 +873,399 @@ public:
         engine->initialize();
         return engine;
     }
+    static GameEnginePtr create(std::string playerName, AreaFile area) {
+        auto engine = std::make_shared<GameEngine>(std::move(playerName), std::move(area));
+        engine->initialize();
+        return engine;
+    }
     
     // Get a shared_ptr to this
     GameEnginePtr getPtr() {
         return shared_from_this();
     }
     
-    // Command handlers
+    // Command handlers (the overloads without a player act for the local player)
     CommandResult handleCommand(std::string_view cmd, std::string_view args);
+    CommandResult handleCommand(const CommandHandle& handle, std::string_view args);
+    CommandResult handleCommand(PlayerId player, std::string_view cmd, std::string_view args);
+    CommandResult handleCommand(PlayerId player, const CommandHandle& handle, std::string_view args);
+    
+    // Run a whole submitted line, which may hold several commands separated
+    // by ';' and speedwalks such as 4n2e (see CommandSequence.h). Each
+    // command is dispatched as handleCommand would, hooks and all, and their
+    // replies are joined into one result, so a walk costs the front end one
+    // flush, and the result's lag holds a tick for each command after the
+    // first. The sequence stops at the first error or a walk that goes
+    // nowhere; exit only counts on a line of its own
+    CommandResult handleCommandLine(std::string_view line);
+    CommandResult handleCommandLine(PlayerId player, std::string_view line);
+    
+    // Resolve a command name once so repeated dispatches skip the registry lookup
+    CommandHandle resolveCommand(std::string_view cmd) const;
+    
+    // Check whether a handle still refers to the current registry contents
+    bool isCurrent(const CommandHandle& handle) const noexcept {
+        const rcu::Guard guard;
+        return handle.m_entry != nullptr && handle.m_generation == commands().generation;
+    }
     
     // Quit check
     bool shouldQuit(std::string_view cmd, std::string_view args);
     
+    // How a queued line ranks (see TickScheduler::setCommandClassifier):
+    // anything an admin types is Urgent, and otherwise its command's
+    // priority; Enter alone turns a page, and so is Bulk
+    CommandPriority commandPriority(PlayerId player, std::string_view line) const;
+    
+    // Tab completion for the last word of a partly typed line: command names
+    // for the first word (and after 'help'), otherwise player names and the
+    // exits out of the player's room
+    Completion complete(PlayerId player, std::string_view line) const;
+    
+    // Player management
+    PlayerId addPlayer(std::string name);
+    // keepBelongings is for players whose save holds what they carried;
+    // otherwise it is left in their room
+    void removePlayer(PlayerId player, bool keepBelongings = false);
+    // Where the player connected from, which who lists beside the name for
+    // admins; the front end sets it as it learns it, and a player with none
+    // shows only the name
+    void setPlayerHost(PlayerId player, std::string host);
+    
+    // Long replies are paged: a command hands paged() a source of lines,
+    // which is asked for a page of them now and each further page only
+    // when the player presses Enter, so a list read no further than its
+    // first page is formatted no further either. A line may hold line
+    // breaks, counted as rows; the source returns false once it has no more.
+    // It runs as the player pages, not under the command's rcu::Guard, so it
+    // keeps hold of whatever it reads from
+    using LineSource = std::function<bool(std::string& line)>;
+    CommandResult paged(PlayerId player, LineSource lines);
+    // Rows per page, from the client's window height; 0, the default, sends
+    // every line at once
+    void setPageLines(PlayerId player, std::uint16_t rows);
+    bool paging(PlayerId player) const noexcept { return player < m_pagers.size() && m_pagers[player].lines; }
+    // The next page of what player is paging through, or empty if nothing is
+    CommandResult nextPage(PlayerId player);
+    // Any command but Enter ends a paged reply
+    void stopPaging(PlayerId player) {
+        if (paging(player)) {
+            m_pagers[player] = {};
+        }
+    }
+    // Admins may snoop and use stats; the console's own player always may
+    void setAdmin(PlayerId player, bool admin);
+    bool isAdmin(PlayerId player) const {
+        return player == m_localPlayer ||
+               (player < m_players.capacity() && m_players.state(player).flags.test(PlayerFlag::Admin));
+    }
+    // Whether anyone snoops or spectates player, whose command replies the
+    // front end then hands to tee() as well
+    bool watched(PlayerId player) const noexcept {
+        return player < m_players.capacity() && m_players.state(player).flags.test(PlayerFlag::Watched);
+    }
+    // message, already sent to source, for everyone watching source: each
+    // gets the same shared text, so a watcher costs a reference per message
+    void tee(PlayerId source, const SharedMessage& message);
+    PlayerId localPlayer() const { return m_localPlayer; }
+    const PlayerRegistry& players() const { return m_players; }
+    // The online player by that name, in any case; safe from any thread
+    PlayerId findPlayer(std::string_view name) const { return m_playerIndex.find(name); }
+    const RoomGraph& world() const { return m_world; }
+    // A room's description, unpacked where the area file packed it; from
+    // any thread
+    std::string roomDescription(RoomId room) const;
+    
+    // Shortest walk between two rooms, for NPCs and movement commands;
+    // nullopt when there is none. Shares one cache, so not for zone actors
+    std::optional<std::span<const Direction>> findPath(RoomId from, RoomId to) { return m_paths.path(m_world, from, to); }
+    const PathStats& pathStats() const { return m_paths.stats(); }
+
+    // How many exits ahead of a player an area zone not yet loaded is
+    // readied (see ZonePrefetcher); 0 turns it off
+    void setZonePrefetch(unsigned rooms);
+    PrefetchStats prefetchStats() const { return m_prefetcher ? m_prefetcher->stats() : PrefetchStats{}; }
+    
+    // A line said now and then to everyone in a zone (see ZoneAmbience)
+    void addAmbientLine(ZoneId zone, std::string_view text) { m_ambience.addLine(zone, text); }
+    const ZoneAmbience& ambience() const noexcept { return m_ambience; }
+    
+    // Memory for text that is copied on before the tick is out, such as a
+    // broadcast formatted for broadcastToRoom: a zone actor's own on its
+    // thread, the tick scheduler's scratch during a tick, else the heap
+    std::pmr::memory_resource& scratch();
+    template <typename... Args>
+    std::pmr::string formatScratch(std::format_string<Args...> format, Args&&... args) {
+        std::pmr::string text(&scratch());
+        std::format_to(std::back_inserter(text), format, std::forward<Args>(args)...);
+        return text;
+    }
+    
+    // Queue a message for a player; front ends drain the queue after each command
+    void sendToPlayer(PlayerId player, std::string message);
+    
+    // Send to everyone in a room, optionally skipping one player (usually the speaker)
+    void broadcastToRoom(RoomId room, std::string_view message, PlayerId except = kInvalidPlayerId);
+    
+    // Send to everyone in every room of a zone, for area-wide effects and announcements
+    void broadcastToZone(ZoneId zone, std::string_view message, PlayerId except = kInvalidPlayerId);
+    
+    // A channel players talk on by its name as a command: "gossip hello",
+    // or the name alone to turn it off and on. nullopt if the name is taken
+    std::optional<ChannelId> addChannel(std::string name, std::string description, bool onByDefault = true);
+    const ChatChannels& channels() const noexcept { return m_channels; }
+    
+    // Replace the socials with a table in the format Socials.h describes;
+    // on error the ones there are kept. A social named like a command is
+    // shadowed by it
+    std::expected<void, std::string> loadSocials(std::string_view text);
+    
+    // Replace the NPC behaviour trees with those in text, in the format
+    // BehaviorTree.h describes, and give every NPC the one for its name; on
+    // error the ones there are kept
+    std::expected<void, std::string> loadBehaviors(std::string_view text);
+    const BehaviorTrees& behaviors() const noexcept { return m_behaviors; }
+    // By BehaviorId; from any thread
+    std::vector<BehaviorStats> behaviorStats() const;
+    const SocialTable& socials() const noexcept { return m_socials; }
+    
+    // Shared by every Lua state; a server with accounts saves it beside them
+    ScriptStore& scriptStore() noexcept { return *m_scriptStore; }
+    const ScriptStore& scriptStore() const noexcept { return *m_scriptStore; }
+    // Send to everyone listening to a channel but the speaker, one message shared by all
+    void sendToChannel(ChannelId channel, std::string_view message, PlayerId except = kInvalidPlayerId);
+    
+    // Player in room with the given name (ASCII case ignored), or kInvalidPlayerId
+    PlayerId findPlayerInRoom(RoomId room, std::string_view name) const;
+    
+    // Take the messages queued for a player. The second form swaps them into
+    // out, so a front end reusing out allocates nothing per delivery
+    std::vector<SharedMessage> takeMessages(PlayerId player);
+    void takeMessages(PlayerId player, std::vector<SharedMessage>& out);
+    
+    // Replace out with the players sent messages since the last call, so a
+    // front end serving many players need not check every outbox
+    void takeRecipients(std::vector<PlayerId>& out);
+    
+    // Background work for the idle part of the front end's loop: resuming
+    // async commands whose work is done and suspended script commands,
+    // script GC slices and the tick that is due,
+    // if any. Returns when it next needs to run; time_point::max() when
+    // nothing is scheduled
+    std::chrono::steady_clock::time_point idle(std::chrono::microseconds budget);
+    
+    // Hook registration for modules
+    HookPipeline& hooks() { return m_hooks; }
+    
+    // Joins, leaves and moves for consumers on other threads, which
+    // subscribe at startup (see EventBus.h). What the game thread published
+    // is handed over at each idle() and flushEvents(); front ends call the
+    // latter once a pass, after the input that caused the events
+    GameEventBus& events() { return *m_eventBus; }
+    void flushEvents() { m_events.flush(); }
+    
+    // World updates register here; front ends queue player commands here
+    // and set the runner that executes them at each tick
+    TickScheduler& ticks() { return m_ticks; }
+    const TickScheduler& ticks() const { return m_ticks; }
+    // Random numbers for game-thread code; workers use Random::forThread()
+    Random& random() noexcept { return m_random; }
+    
+    // Items, NPCs and player bodies, with whatever components they carry
+    EntityStore& entities() { return m_entities; }
+    const EntityStore& entities() const { return m_entities; }
+    Entity playerBody(PlayerId player) const {
+        return player < m_playerBodies.size() ? m_playerBodies[player] : kInvalidEntity;
+    }
+    
+    // Kinds of item; nullptr when the name is already defined
+    const ItemPrototype* defineItem(ItemPrototype prototype) { return m_items.define(std::move(prototype)); }
+    const ItemCatalog& items() const { return m_items; }
+    
+    // Place an instance of an item in a room; it starts decaying if the prototype does
+    Entity spawnItem(const ItemPrototype& prototype, RoomId room);
+    Entity spawnNpc(std::string_view name, RoomId room, Health health = {}, std::uint32_t wanderTicks = 0);
+    const NpcStats& npcStats() const { return m_npcStats; }
+    
+    // Open a private copy of a zone, such as a dungeon for one group, and
+    // return its zone; players are moved in with instanceRoom(). An
+    // instance left empty for kZoneUnloadTicks closes, and what is in it goes
+    std::expected<ZoneId, std::string> createInstance(ZoneId prototype);
+    // The copy of a prototype room in an instance of its zone; room itself
+    // when it is outside that zone
+    RoomId instanceRoom(ZoneId instance, RoomId room) const;
+    bool isInstance(ZoneId zone) const { return instanceOf(zone) != nullptr; }
+    const InstanceStats& instanceStats() const { return m_instanceStats; }
+    
+    // What players call an entity: its prototype's name for an item, else its Named
+    std::string_view nameOf(Entity entity) const;
+    
+    // Make sure regeneration and decay run; call after hurting something or
+    // attaching a Decay directly through entities()
+    void wakeSystems();
+    
+    // Set attacker on target, and target on attacker if it isn't fighting
+    // already; rounds run every kCombatRoundTicks while anyone fights. Each
+    // round's swings are reported in one message per room. Either may be a
+    // player's body or an NPC, with CombatStats or the defaults
+    static constexpr unsigned kCombatRoundTicks = 20;
+    void startCombat(Entity attacker, Entity target);
+    const CombatRound& combat() const noexcept { return m_combat; }
+    
+    // CombatStats with what the entity carries and its affects added; kept,
+    // and only worked out again once invalidateStats has been called
+    CombatStats effectiveStats(Entity entity);
+    // Something effectiveStats adds up has changed, such as CombatStats set
+    // through entities(); carrying, dropping and affects call it themselves
+    void invalidateStats(Entity entity);
+    // A timed affect wears off by itself, an untimed one when removed
+    void addAffect(Entity entity, Affect affect);
+    void removeAffect(Entity entity, Symbol name);
+    std::uint64_t statRecomputes() const noexcept { return m_statRecomputes; }
+    
+    // Run update for every room every interval ticks, spread over all cores.
+    // It may only read the world; changes go into the CommandBuffer and are
+    // made on this thread once every room is done, in room order
+    TickUpdateId addRoomUpdate(unsigned interval, RoomUpdate update);
+    
+    // Zone actors start a worker per core; see runCommands
+    void setExecutionMode(ExecutionMode mode);
+    
+    // Pin the workers one to each of cores, starting one per core rather
+    // than one per core the machine has; empty leaves them to the scheduler
+    void setWorkerCores(std::vector<int> cores);
+    std::size_t workerCount() const { return m_jobs ? m_jobs->threadCount() - 1 : 0; }
+    ExecutionMode executionMode() const { return m_executionMode; }
+    
+    // Run a batch of lines, at most one per player, such as a tick's worth.
+    // Serially each runs in turn as handleCommand would. On zone actors each
+    // is mailed to the zone its player stands in, and every zone runs its
+    // mailbox in order, in parallel with the others and without locking:
+    // what the commands send and where they move is recorded, then made on
+    // this thread in zone order, and a move into another zone is handed to
+    // that zone and made last. Commands that are not zoneLocal run here
+    // once the zones are done, in batch order
+    void runCommands(std::span<QueuedCommand> commands);
+    const ZoneStats& zoneStats() const { return m_zoneStats; }
+    
     // Game state access (for save/load etc.)
-    const Player& getPlayer() const { return m_player; }
-};
\ No newline at end of file
+    Player getPlayer(PlayerId player) const;
+    Player getPlayer() const { return getPlayer(m_localPlayer); }
+    // Players whose room, health or belongings changed since the last call,
+    // for a front end that saves them; taking them clears the marks
+    void takeDirtyPlayers(std::vector<PlayerId>& out);
+    // The world as it stands, for a checkpoint thread to serialize while the
+    // game goes on; cheap to take (see WorldSnapshot). Game thread only
+    WorldSnapshot snapshot();
+    // The map, prototypes, NPCs and the items lying in rooms, as an area
+    // file would hold them; what players carry is theirs and left out
+    AreaSource areaSource() const;
+    // Put a player back as a save left them, read straight from the mapping.
+    // A room or item prototype that no longer exists is skipped, and one in
+    // a zone another shard runs is left to a handoff
+    void restorePlayer(PlayerId player, const PlayerSave& save);
+    
+    // Sharded deployments (see ShardMap): this engine never enters a zone
+    // another shard runs. A move into one, or a save restored into one, is
+    // told as usual but leaves the player where it was and lists it here,
+    // for the front end to hand over to the shard that does run it
+    void setShard(ShardMap shard) noexcept { m_shard = shard; }
+    const ShardMap& shard() const noexcept { return m_shard; }
+    void takeHandoffs(std::vector<ShardHandoff>& out) {
+        out.clear();
+        out.swap(m_handoffs);
+    }
+    void setChannelRelay(ChannelRelay relay) { m_channelRelay = std::move(relay); }
+    
+    // Commands that wait on slow work (see CommandTask.h). runAsync starts
+    // a command's task on the game thread, from a handler that isn't
+    // zoneLocal: its reply if it finishes without waiting, and otherwise an
+    // empty one, with what it returns sent to the player once it does.
+    // Inside the task, co_await offload(work) runs work on a background
+    // thread and resumes the task here, in idle(), with work's result
+    CommandResult runAsync(PlayerId player, Task<CommandResult> task);
+    template <typename F>
+    auto offload(F work) {
+        return asyncExecutor().run(std::move(work));
+    }
+    // Any thread may call wake to have the front end call idle() soon;
+    // without one, idle() asks to be called back while work is out
+    void setAsyncWake(std::function<void()> wake);
+    std::size_t asyncCommands() const noexcept { return m_asyncCommands.size(); }
+    // Where players' saves are, <name>.save, for finger of someone offline
+    void setSaveDirectory(std::filesystem::path directory) { m_saveDirectory = std::move(directory); }
+    
+    // The database, if the front end opened one (see Storage.h). Inside a
+    // task, co_await query(...) runs a statement on its thread and resumes
+    // the task here with the rows, or with an error where there is none
+    void setDatabase(std::unique_ptr<Storage> database) { m_database = std::move(database); }
+    Storage* database() noexcept { return m_database.get(); }
+    Storage::Query query(Storage::Kind kind, std::string sql, std::vector<StorageValue> params = {}) {
+        return Storage::Query(m_database.get(), asyncExecutor(), kind, std::move(sql), std::move(params));
+    }
+    // Where the board and mail commands keep their posts (see MessageStore.h)
+    void setMessageStore(std::unique_ptr<MessageStore> messages) { m_messages = std::move(messages); }
+    MessageStore* messageStore() noexcept { return m_messages.get(); }
+    // Where the greeting and help files are kept (see TextFiles.h); help
+    // looks there before it builds a topic, and motd shows DIR/motd.txt
+    void setTextDirectory(std::filesystem::path directory) {
+        m_texts = std::make_unique<TextFiles>(std::move(directory));
+    }
+    TextFiles* texts() noexcept { return m_texts.get(); }
+    
+    // Calls, errors and latency percentiles of every command that has run,
+    // busiest first, as the stats command shows them; a name narrows it to
+    // that command. Safe while commands run
+    std::string commandStatsReport(std::string_view command = {}) const;
+    // Cycles, instructions, cache and branch misses per command and per tick phase
+    std::string counterStatsReport() const;
+    // Copy out who is online, the strongest of them and where they are,
+    // over what into held, for other threads to read (see WorldStatus)
+    void status(WorldStatus& into);
+    void resetCommandStats();
+    // Live and peak bytes of every MemoryTag, with allocation and byte rates
+    // since the report before this one, as stats memory shows them
+    std::string memoryStatsReport();
+    // The same as metric families for a scrape (see Metrics), from any thread
+    void writeCommandMetrics(std::string& out) const;
+    // Spawned records and time spent spawning per area zone, likewise
+    void writeZoneMetrics(std::string& out) const;
+    // Each behaviour tree's runs and cost, labelled by its name
+    void writeBehaviorMetrics(std::string& out) const;
+    std::vector<ZoneRepopStats> repopStats() const;
+    // What packing the area's room descriptions saves and what unpacking
+    // them costs; all zero when none are packed
+    DescriptionStats descriptionStats() const;
+    // Copy the tick scheduler's totals and the Lua memory into the game
+    // thread's shard; game thread only
+    void publishMetrics(MetricsShard& shard);
+    
+    // Register a command at runtime; a built-in with the same name is overridden.
+    // Fails, leaving the commands as they were, if the spec's syntax is malformed
+    bool registerCommand(CommandSpec spec);
+    
+    // Make alias another spelling of command, replacing any earlier meaning;
+    // a command registered with the same name still takes precedence
+    void registerAlias(std::string alias, std::string command);
+    
+#ifdef ENABLE_LUA_SCRIPTING
+    // Load and register a script command
+    bool loadScriptCommand(const std::string& name, const std::filesystem::path& scriptPath);
+    
+    // Swap in scripts the watcher has recompiled; called between commands
+    void applyScriptReloads();
+
+    // Each script's counters summed over every Lua state, as scriptstats shows them
+    std::vector<std::pair<std::string, ScriptRunner::ScriptStats>> scriptStats() { return m_scriptRunner->stats(); }
+#endif
+};
+
+// Adapt a handler that needs an owning GameEnginePtr (e.g. to keep the engine
+// alive across deferred work) to the CommandContext signature. The shared_ptr
+// is only created for handlers wrapped this way.
+template <typename F>
+CommandHandler withOwningEngine(F&& handler) {
+    return [fn = std::forward<F>(handler)](CommandContext& ctx, std::string_view args) -> CommandResult {
+        return fn(ctx.engine.getPtr(), args);
+    };
+}
\ No newline at end of file
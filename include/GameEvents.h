@@ -0,0 +1,28 @@
+#pragma once
+
+#include "EventBus.h"
+#include "GameWorld.h"
+#include "StringInterner.h"
+
+// What the engine tells other threads has happened, through
+// GameEngine::events(). Ids and interned names only: whoever renders one
+// does the formatting, and an event nobody subscribed to costs a mask test
+
+struct PlayerJoined {
+    PlayerId player;
+    Symbol name;
+    RoomId room;
+};
+
+struct PlayerLeft {
+    PlayerId player;
+    Symbol name;
+};
+
+struct PlayerMoved {
+    PlayerId player;
+    RoomId from;
+    RoomId to;
+};
+
+using GameEventBus = EventBus<PlayerJoined, PlayerLeft, PlayerMoved>;
@@ -1,28 +1,29 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <string_view>
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <span>
+#include "MemoryAccounting.h"
+#include "PlayerState.h"
+#include "StringInterner.h"
 
-class FakeHookSystem {
-public:
-    // Simulate a hook: return true if command should be blocked
-    bool beforeCommand(std::string_view command, std::string_view /*args*/) {
-        // Example rule: handle exit command
-        if (command == "exit" || command == "quit") {
-            return true; // exit the game
-        }
-        return false; // continue processing
-    }
+// Dense integer identifiers for world objects
+using PlayerId = std::uint32_t;
+using RoomId = std::uint32_t;
+using ZoneId = std::uint16_t;   // Rooms grouped into an area; dense from 0
 
-    // Simulate a hook: return true if movement should be blocked
-    bool beforeMove(std::string_view playerName, std::string_view direction) {
-        // Example rule: block Kieran from going north
-        if (playerName == "Kieran" && direction == "north") {
-            return true; // block
-        }
-        return false; // allow
-    }
-};
+inline constexpr PlayerId kInvalidPlayerId = std::numeric_limits<PlayerId>::max();
+inline constexpr RoomId kInvalidRoomId = std::numeric_limits<RoomId>::max();
 
 class Player {
 public:
@@ -30,6 +31,20 @@ public:
     std::string name;
     std::string currentRoom;
 
+    // Something carried, by item prototype
+    struct Belonging {
+        std::string prototype;
+        std::uint32_t decayTicks = 0;   // Left to live; 0 when it does not decay
+    };
+
+    // The body's state, as a save needs it
+    std::int32_t health = 100;
+    std::int32_t maxHealth = 100;
+    std::int32_t regen = 1;
+    std::vector<Belonging> inventory;
+    // The last journal record this state is as up to date as; 0 for none
+    std::uint64_t journaled = 0;
+
     // Default constructor
     Player() : 
         name("Unknown"),
@@ -41,4 +56,442 @@ public:
         name(std::move(playerName)),
         currentRoom("Start Room")
     {}
-}; 
\ No newline at end of file
+};
+
+// Exit directions; values index RoomGraph adjacency arrays
+enum class Direction : std::uint8_t {
+    North,
+    South,
+    East,
+    West,
+    Count
+};
+
+inline constexpr std::size_t kDirectionCount = static_cast<std::size_t>(Direction::Count);
+
+constexpr std::string_view directionName(Direction dir) {
+    constexpr std::array<std::string_view, kDirectionCount> names = {"north", "south", "east", "west"};
+    return names[static_cast<std::size_t>(dir)];
+}
+
+// The direction a word names, in full or by its initial (ASCII case ignored);
+// Direction::Count if it names none
+constexpr Direction parseDirection(std::string_view word) {
+    for (std::size_t i = 0; i < kDirectionCount; ++i) {
+        const std::string_view name = directionName(static_cast<Direction>(i));
+        if (word.size() != 1 && word.size() != name.size()) {
+            continue;
+        }
+        bool same = true;
+        for (std::size_t c = 0; c < word.size() && same; ++c) {
+            same = (word[c] | 0x20) == name[c];
+        }
+        if (same) {
+            return static_cast<Direction>(i);
+        }
+    }
+    return Direction::Count;
+}
+
+constexpr Direction oppositeDirection(Direction dir) {
+    constexpr std::array<Direction, kDirectionCount> opposites = {
+        Direction::South, Direction::North, Direction::West, Direction::East
+    };
+    return opposites[static_cast<std::size_t>(dir)];
+}
+
+/**
+ * World map with interned integer room ids.
+ *
+ * Each room gets a dense RoomId on creation. Exits are stored as a fixed
+ * array of RoomIds per room indexed by Direction, so following an exit is a
+ * single array load regardless of world size. Names and descriptions are
+ * stored once per room in cold columns, separate from the adjacency data
+ * touched by movement. Every room belongs to a zone, zone 0 unless placed
+ * elsewhere, which is the unit the engine's zone actors run commands on.
+ *
+ * The cold columns are views. Text given to addRoom() is kept in a store
+ * that copies of the graph share and that only ever grows; addRoomView()
+ * takes text that lives elsewhere, such as in a mapped area file, whose
+ * owner keepAlive() holds on to. Rooms loaded that way can also be found by
+ * name through a sorted index the file carries, so a world of a million
+ * rooms is searchable without a name of it being read until asked for.
+ */
+class RoomGraph {
+public:
+    using ExitArray = std::array<RoomId, kDirectionCount>;
+
+    // Add a room, or update the description and zone of an existing room with the same name
+    RoomId addRoom(std::string_view name, std::string description = {}, ZoneId zone = 0) {
+        const RoomId existing = find(name);
+        if (existing != kInvalidRoomId) {
+            m_descriptions[existing] = keep(std::move(description));
+            m_layoutVersion += m_zones[existing] != zone ? 1 : 0;
+            m_zones[existing] = zone;
+            m_zoneCount = std::max<std::size_t>(m_zoneCount, static_cast<std::size_t>(zone) + 1);
+            ++m_version;
+            return existing;
+        }
+        const std::string_view kept = keep(std::move(description));
+        return addRoomView(keep(std::string(name)), kept, zone);
+    }
+
+    // Add a room whose text outlives the graph or is held by keepAlive();
+    // the caller makes sure no other room has its name
+    RoomId addRoomView(std::string_view name, std::string_view description, ZoneId zone = 0) {
+        const RoomId id = addUnnamed(name, description, zone);
+        if (id >= m_nameIndex.size()) {
+            m_ids.emplace(name, id);
+        }
+        return id;
+    }
+
+    // Add a room showing another's name and description, shared rather
+    // than copied, with no exits yet; find() goes on finding the original
+    RoomId addCopy(RoomId original, ZoneId zone) {
+        return addUnnamed(m_names[original], m_descriptions[original], zone);
+    }
+
+    // Give a room its description as text, such as one that was packed
+    void setDescription(RoomId room, std::string description) {
+        m_descriptions[room] = keep(std::move(description));
+        ++m_version;
+    }
+
+    // Drop every room from `rooms` on, such as a world's instanced copies
+    // when it is saved; no room left may have an exit into them
+    void truncate(std::size_t rooms) {
+        if (rooms >= size()) {
+            return;
+        }
+        std::erase_if(m_ids, [rooms](const auto& entry) { return entry.second >= rooms; });
+        m_exits.resize(rooms);
+        m_zones.resize(rooms);
+        m_names.resize(rooms);
+        m_descriptions.resize(rooms);
+        const auto highest = std::max_element(m_zones.begin(), m_zones.end());
+        m_zoneCount = highest == m_zones.end() ? 1 : static_cast<std::size_t>(*highest) + 1;
+        ++m_version;
+        ++m_layoutVersion;
+    }
+
+    // Hold whatever the text of rooms added by view lives in, for as long
+    // as this graph or any copy of it does
+    void keepAlive(std::shared_ptr<const void> owner) {
+        text().owners.push_back(std::move(owner));
+    }
+
+    // Rooms 0 to index.size() - 1 in order of name, to be found by binary
+    // search instead of each being hashed; set before any other room is added
+    void setNameIndex(std::span<const RoomId> index) { m_nameIndex = index; }
+
+    // Create a one-way exit, or remove one with kInvalidRoomId
+    void link(RoomId from, Direction dir, RoomId to) {
+        m_exits[from][static_cast<std::size_t>(dir)] = to;
+        ++m_version;
+        ++m_layoutVersion;
+    }
+
+    // Create an exit and the matching return exit
+    void linkBoth(RoomId from, Direction dir, RoomId to) {
+        link(from, dir, to);
+        link(to, oppositeDirection(dir), from);
+    }
+
+    // Room reached by leaving `from` in `dir`, or kInvalidRoomId if there is no exit
+    RoomId exit(RoomId from, Direction dir) const {
+        return from < m_exits.size() ? m_exits[from][static_cast<std::size_t>(dir)] : kInvalidRoomId;
+    }
+
+    const ExitArray& exits(RoomId room) const { return m_exits[room]; }
+    // The whole adjacency column, kDirectionCount exits per room
+    std::span<const ExitArray> exitTable() const noexcept { return m_exits; }
+
+    // Look up a room by name (used when loading data, not on the movement path)
+    RoomId find(std::string_view name) const {
+        if (auto it = m_ids.find(name); it != m_ids.end()) {
+            return it->second;
+        }
+        const auto found = std::lower_bound(m_nameIndex.begin(), m_nameIndex.end(), name,
+                                            [this](RoomId room, std::string_view key) { return m_names[room] < key; });
+        return found != m_nameIndex.end() && m_names[*found] == name ? *found : kInvalidRoomId;
+    }
+
+    bool contains(RoomId room) const { return room < m_exits.size(); }
+
+    std::string_view name(RoomId room) const {
+        return contains(room) ? m_names[room] : std::string_view{};
+    }
+
+    std::string_view description(RoomId room) const {
+        return contains(room) ? m_descriptions[room] : std::string_view{};
+    }
+
+    ZoneId zone(RoomId room) const { return contains(room) ? m_zones[room] : ZoneId{0}; }
+
+    // One past the highest zone any room was placed in
+    std::size_t zoneCount() const { return m_zoneCount; }
+
+    std::size_t size() const { return m_exits.size(); }
+
+    // Changes whenever a room, zone or exit does; lets derived tables tell they are stale
+    std::uint64_t version() const noexcept { return m_version; }
+    // Changes when a room comes or goes, or an exit or zone changes, but not
+    // for text; what is drawn from the exits alone is stale only then
+    std::uint64_t layoutVersion() const noexcept { return m_layoutVersion; }
+
+    void reserve(std::size_t rooms) {
+        m_exits.reserve(rooms);
+        m_zones.reserve(rooms);
+        m_names.reserve(rooms);
+        m_descriptions.reserve(rooms);
+    }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    // What the cold columns point into. Copies share it; strings are only
+    // ever added, and a deque never moves them, so a copy's views stay good
+    // while the original goes on adding rooms. Counted as the world's
+    struct Text {
+        std::pmr::deque<std::pmr::string> strings{&TrackedResource::of(MemoryTag::World)};
+        std::vector<std::shared_ptr<const void>> owners;
+    };
+
+    Text& text() {
+        if (!m_text) {
+            m_text = std::allocate_shared<Text>(TrackedAllocator<Text>(MemoryTag::World));
+        }
+        return *m_text;
+    }
+
+    std::string_view keep(std::string value) {
+        return value.empty() ? std::string_view{} : std::string_view{text().strings.emplace_back(value)};
+    }
+
+    // A room find() does not know by name
+    RoomId addUnnamed(std::string_view name, std::string_view description, ZoneId zone) {
+        m_zoneCount = std::max<std::size_t>(m_zoneCount, static_cast<std::size_t>(zone) + 1);
+        ++m_version;
+        ++m_layoutVersion;
+        const RoomId id = static_cast<RoomId>(m_exits.size());
+        ExitArray noExits;
+        noExits.fill(kInvalidRoomId);
+        m_exits.push_back(noExits);
+        m_zones.push_back(zone);
+        m_names.push_back(name);
+        m_descriptions.push_back(description);
+        return id;
+    }
+
+    // Hot columns: adjacency and zone per room, counted as the world's so
+    // they go on huge pages with it (see HugePages)
+    std::vector<ExitArray, TrackedAllocator<ExitArray>> m_exits{TrackedAllocator<ExitArray>(MemoryTag::World)};
+    std::vector<ZoneId, TrackedAllocator<ZoneId>> m_zones{TrackedAllocator<ZoneId>(MemoryTag::World)};
+    std::size_t m_zoneCount = 1;
+    std::uint64_t m_version = 0;
+    std::uint64_t m_layoutVersion = 0;
+
+    // Cold columns
+    std::vector<std::string_view> m_names;
+    std::vector<std::string_view> m_descriptions;
+    std::shared_ptr<Text> m_text;
+    std::unordered_map<std::string_view, RoomId, Hash, std::equal_to<>> m_ids;   // Rooms past m_nameIndex
+    std::span<const RoomId> m_nameIndex;
+};
+
+/**
+ * Struct-of-arrays storage for all connected players.
+ *
+ * Player ids are dense indices into parallel columns. Hot columns (current
+ * room and zone) are kept separate from cold ones (name). Freed ids are
+ * recycled; a free slot is marked with kInvalidRoomId in the room column.
+ *
+ * Each room and each zone also keeps a dense array of the players in it, and
+ * every player remembers its index in both, so a move is two swap-removes and
+ * two appends and "who is in this room" or "everyone in this zone" visits
+ * only the players there, however many are connected elsewhere. Occupants
+ * are in no particular order.
+ *
+ * Names are interned (see StringInterner.h), as typed and with ASCII
+ * letters lowered, so finding a player by name compares integers.
+ */
+class PlayerRegistry {
+public:
+    PlayerId add(std::string_view name, RoomId room, ZoneId zone = 0) {
+        StringInterner& names = StringInterner::global();
+        const Symbol symbol = names.intern(name);
+        const Symbol key = names.intern(foldedName(name));
+        PlayerId id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+            m_names[id] = symbol;
+            m_nameKeys[id] = key;
+            m_states[id] = {};
+        } else {
+            id = static_cast<PlayerId>(m_rooms.size());
+            m_rooms.push_back(kInvalidRoomId);
+            m_zones.push_back(0);
+            m_roomSlots.push_back(0);
+            m_zoneSlots.push_back(0);
+            m_states.emplace_back();
+            m_names.push_back(symbol);
+            m_nameKeys.push_back(key);
+        }
+        place(id, room, zone);
+        ++m_activeCount;
+        return id;
+    }
+
+    void remove(PlayerId id) {
+        if (!isActive(id)) {
+            return;
+        }
+        unplace(id);
+        m_rooms[id] = kInvalidRoomId;
+        m_names[id] = kNoSymbol;
+        m_nameKeys[id] = kNoSymbol;
+        m_states[id] = {};
+        m_freeIds.push_back(id);
+        --m_activeCount;
+    }
+
+    bool isActive(PlayerId id) const {
+        return id < m_rooms.size() && m_rooms[id] != kInvalidRoomId;
+    }
+
+    // Number of live players
+    std::size_t size() const { return m_activeCount; }
+
+    // Size of the id space (live and free slots)
+    std::size_t capacity() const { return m_rooms.size(); }
+
+    // Hot column accessors
+    RoomId room(PlayerId id) const { return m_rooms[id]; }
+    ZoneId zone(PlayerId id) const { return m_zones[id]; }
+    // Room per id, kInvalidRoomId for free ids; moves when the id space grows
+    std::span<const RoomId> roomColumn() const noexcept { return m_rooms; }
+
+    // Flags and settings, packed; see PlayerState.h. Any id below
+    // capacity() has one, a free id's all clear
+    const PlayerState& state(PlayerId id) const { return m_states[id]; }
+    PlayerState& state(PlayerId id) { return m_states[id]; }
+
+    // Move a live player; zone is the room's, as the RoomGraph has it
+    void setRoom(PlayerId id, RoomId room, ZoneId zone = 0) {
+        if (!isActive(id) || (m_rooms[id] == room && m_zones[id] == zone)) {
+            return;
+        }
+        unplace(id);
+        place(id, room, zone);
+    }
+
+    // Cold column accessors
+    std::string_view name(PlayerId id) const { return StringInterner::global().view(m_names[id]); }
+    Symbol nameSymbol(PlayerId id) const { return m_names[id]; }
+    // The name with ASCII letters lowered, for matching what players type
+    Symbol nameKey(PlayerId id) const { return m_nameKeys[id]; }
+
+    // What nameKey() is interned from
+    static std::string foldedName(std::string_view name) {
+        std::string folded(name);
+        for (char& c : folded) {
+            if (c >= 'A' && c <= 'Z') {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+        return folded;
+    }
+
+    // Visit every player in a room; fn must not move or remove players
+    template <typename Fn>
+    void forEachInRoom(RoomId room, Fn&& fn) const {
+        if (room < m_roomOccupants.size()) {
+            for (PlayerId id : m_roomOccupants[room]) {
+                fn(id);
+            }
+        }
+    }
+
+    // Visit every player in a zone; fn must not move or remove players
+    template <typename Fn>
+    void forEachInZone(ZoneId zone, Fn&& fn) const {
+        if (zone < m_zoneOccupants.size()) {
+            for (PlayerId id : m_zoneOccupants[zone]) {
+                fn(id);
+            }
+        }
+    }
+
+    std::size_t occupantCount(RoomId room) const {
+        return room < m_roomOccupants.size() ? m_roomOccupants[room].size() : 0;
+    }
+
+    std::size_t zoneOccupantCount(ZoneId zone) const {
+        return zone < m_zoneOccupants.size() ? m_zoneOccupants[zone].size() : 0;
+    }
+
+    std::vector<PlayerId> playersInRoom(RoomId room) const {
+        std::vector<PlayerId> result;
+        forEachInRoom(room, [&result](PlayerId id) { result.push_back(id); });
+        return result;
+    }
+
+private:
+    void place(PlayerId id, RoomId room, ZoneId zone) {
+        m_rooms[id] = room;
+        m_zones[id] = zone;
+        if (room == kInvalidRoomId) {
+            return;
+        }
+        if (room >= m_roomOccupants.size()) {
+            m_roomOccupants.resize(static_cast<std::size_t>(room) + 1);
+        }
+        if (zone >= m_zoneOccupants.size()) {
+            m_zoneOccupants.resize(static_cast<std::size_t>(zone) + 1);
+        }
+        m_roomSlots[id] = static_cast<std::uint32_t>(m_roomOccupants[room].size());
+        m_roomOccupants[room].push_back(id);
+        m_zoneSlots[id] = static_cast<std::uint32_t>(m_zoneOccupants[zone].size());
+        m_zoneOccupants[zone].push_back(id);
+    }
+
+    // Take a player out of its room's and zone's arrays; the last one in each takes its place
+    void unplace(PlayerId id) {
+        if (m_rooms[id] == kInvalidRoomId) {
+            return;
+        }
+        swapRemove(m_roomOccupants[m_rooms[id]], m_roomSlots, m_roomSlots[id]);
+        swapRemove(m_zoneOccupants[m_zones[id]], m_zoneSlots, m_zoneSlots[id]);
+    }
+
+    static void swapRemove(std::vector<PlayerId>& occupants, std::vector<std::uint32_t>& slots, std::uint32_t slot) {
+        const PlayerId last = occupants.back();
+        occupants[slot] = last;
+        slots[last] = slot;
+        occupants.pop_back();
+    }
+
+    // Hot columns
+    std::vector<RoomId> m_rooms;
+    std::vector<ZoneId> m_zones;
+    std::vector<std::uint32_t> m_roomSlots;   // Index in the room's occupants
+    std::vector<std::uint32_t> m_zoneSlots;   // Index in the zone's occupants
+    std::vector<PlayerState> m_states;
+
+    // Cold columns
+    std::vector<Symbol> m_names;
+    std::vector<Symbol> m_nameKeys;
+
+    std::vector<std::vector<PlayerId>> m_roomOccupants;   // By RoomId
+    std::vector<std::vector<PlayerId>> m_zoneOccupants;   // By ZoneId
+
+    std::vector<PlayerId> m_freeIds;
+    std::size_t m_activeCount = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Text buffer with a movable gap at the cursor.
+ *
+ * The bytes before the cursor sit at the front of the storage and the bytes
+ * after it at the back, with the unused space in between. Typing or deleting
+ * at the cursor only moves the gap's edges, so editing a very long line costs
+ * the same as editing a short one; moving the cursor shifts just the bytes it
+ * passes over. When the gap fills up, the storage doubles.
+ */
+class GapBuffer {
+public:
+    static constexpr std::size_t kMinCapacity = 64;
+
+    std::size_t size() const noexcept { return m_data.size() - (m_gapEnd - m_gapStart); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Byte offset of the cursor, which is where the gap starts
+    std::size_t cursor() const noexcept { return m_gapStart; }
+
+    // The text on either side of the cursor; both stay valid until the next edit
+    std::string_view before() const noexcept { return {m_data.data(), m_gapStart}; }
+    std::string_view after() const noexcept { return {m_data.data() + m_gapEnd, m_data.size() - m_gapEnd}; }
+
+    char operator[](std::size_t pos) const noexcept {
+        return pos < m_gapStart ? m_data[pos] : m_data[pos + (m_gapEnd - m_gapStart)];
+    }
+
+    std::string str() const {
+        std::string text;
+        text.reserve(size());
+        text.append(before());
+        text.append(after());
+        return text;
+    }
+
+    // Move the cursor to pos, clamped to the text
+    void moveCursor(std::size_t pos) noexcept {
+        pos = std::min(pos, size());
+        if (pos < m_gapStart) {
+            const std::size_t count = m_gapStart - pos;
+            std::memmove(m_data.data() + m_gapEnd - count, m_data.data() + pos, count);
+            m_gapStart -= count;
+            m_gapEnd -= count;
+        } else if (pos > m_gapStart) {
+            const std::size_t count = pos - m_gapStart;
+            std::memmove(m_data.data() + m_gapStart, m_data.data() + m_gapEnd, count);
+            m_gapStart += count;
+            m_gapEnd += count;
+        }
+    }
+
+    // Insert text at the cursor and move the cursor past it
+    void insert(std::string_view text) {
+        if (text.empty()) {
+            return;
+        }
+        reserveGap(text.size());
+        std::memcpy(m_data.data() + m_gapStart, text.data(), text.size());
+        m_gapStart += text.size();
+    }
+
+    void insert(char ch) { insert(std::string_view(&ch, 1)); }
+
+    // Remove up to count bytes before / after the cursor
+    void eraseBefore(std::size_t count) noexcept { m_gapStart -= std::min(count, m_gapStart); }
+    void eraseAfter(std::size_t count) noexcept { m_gapEnd += std::min(count, m_data.size() - m_gapEnd); }
+
+    // Replace the whole text, leaving the cursor at the end
+    void assign(std::string_view text) {
+        clear();
+        insert(text);
+    }
+
+    void clear() noexcept {
+        m_gapStart = 0;
+        m_gapEnd = m_data.size();
+    }
+
+private:
+    void reserveGap(std::size_t needed) {
+        if (m_gapEnd - m_gapStart >= needed) {
+            return;
+        }
+        const std::size_t tail = m_data.size() - m_gapEnd;
+        std::size_t capacity = std::max(m_data.size() * 2, kMinCapacity);
+        while (capacity - size() < needed) {
+            capacity *= 2;
+        }
+        std::vector<char> grown(capacity);
+        if (!m_data.empty()) {
+            std::memcpy(grown.data(), m_data.data(), m_gapStart);
+            std::memcpy(grown.data() + capacity - tail, m_data.data() + m_gapEnd, tail);
+        }
+        m_data = std::move(grown);
+        m_gapEnd = capacity - tail;
+    }
+
+    std::vector<char> m_data;
+    std::size_t m_gapStart = 0;
+    std::size_t m_gapEnd = 0;
+};
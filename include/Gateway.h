@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "NetReactor.h"
+#include "ShardLink.h"
+#include "TlsAcceptor.h"
+
+/**
+ * The front of a world split over several net_server shards (see
+ * ShardMap): every player's connection is held here, telnet or WebSocket,
+ * on NetReactor threads as net_server holds them, with MCCP2 and
+ * permessage-deflate done on them too, and each shard is one ShardLink
+ * away, however many sessions it serves.
+ *
+ * The game thread of a gateway is only a switchboard. A new client is a
+ * session on shard 0, which logs it in; its lines go to whichever shard
+ * its player is on and whatever that shard sends back goes to its
+ * reactor, one batch per reactor per iteration as in NetServer. When a
+ * shard hands a player off, the session is moved to the shard named and
+ * the player's save image is attached there, so the next line the client
+ * types is already played on the new shard. Channel messages from one
+ * shard are relayed to all the others.
+ *
+ * A shard going down parks its players here first, each with a save
+ * image. Parked sessions stay connected and keep what their clients type,
+ * up to kMaxHeldLines; the gateway calls the shard again every
+ * kReconnectInterval and, once it answers, attaches them there and sends
+ * what was held, so a shard restarting for a new build costs its players
+ * a pause rather than their connection. Anyone else on a lost shard is
+ * disconnected.
+ *
+ * Telnet options end here: GMCP and MSDP are not carried over the links.
+ */
+class Gateway {
+public:
+    static constexpr std::size_t kMaxHeldLines = 32;
+    static constexpr std::chrono::milliseconds kReconnectInterval{1000};
+
+    struct Options {
+        std::string address = "0.0.0.0";
+        std::uint16_t port = 4000;
+        std::uint16_t webSocketPort = 0;   // Also serve browsers over WebSocket here; 0 for none
+        std::uint16_t tlsPort = 0;         // Also serve telnet over TLS here, where built with OpenSSL; 0 for none
+        std::string tlsCertificate{};      // PEM certificate chain and key, with a TLS port
+        std::string tlsKey{};
+        unsigned tlsWorkers = 2;           // Threads running TLS handshakes
+        bool useIoUring = true;            // Where the kernel supports it; epoll otherwise
+        unsigned reactors = 1;
+        bool compression = true;           // Offer MCCP2 and permessage-deflate, where built with zlib
+        std::chrono::seconds idleCompaction{300};   // Compact sessions quiet this long; 0 never
+        std::vector<std::pair<std::string, std::uint16_t>> shards{};   // Address and shard port, in shard order
+    };
+
+    // Connects to every shard first, waiting a moment for each to answer
+    static std::expected<std::unique_ptr<Gateway>, NetError> create(const Options& options);
+
+    ~Gateway();
+
+    // Reactors hold a reference to the inbox, so the gateway stays put
+    Gateway(const Gateway&) = delete;
+    Gateway& operator=(const Gateway&) = delete;
+
+    // Serve until requestStop()
+    void run();
+    // Safe to call from a signal handler or another thread
+    void requestStop() noexcept;
+
+    std::size_t sessionCount() const noexcept { return m_sessions.size(); }
+    std::size_t shardCount() const noexcept { return m_shards.size(); }
+
+private:
+    struct Session {
+        ConnectionId connection;
+        std::uint64_t number = 0;
+        std::uint16_t shard = 0;           // Where its player is, or is to be attached
+        bool parked = false;               // Waiting for its shard to come back
+        std::string name{};                // While parked, the player and its save image
+        std::string image{};
+        std::vector<std::string> held{};   // Typed while parked
+    };
+
+    struct Shard {
+        std::string address;
+        std::uint16_t port = 0;
+        std::unique_ptr<ShardLink> link{};   // Null while it is down
+    };
+
+    Gateway() = default;
+
+    void handleInput(NetInput& input);
+    void handleMessage(std::uint16_t shard, const ShardMessage& message);
+    void park(Session& session, std::uint16_t shard, const ShardMessage& message);
+    void send(const Session& session, ShardMessageKind kind, std::string_view body = {});
+    void loseShard(std::uint16_t shard);
+    void reconnect();
+    void close(const ConnectionId& connection, std::string_view text);
+    void write(const ConnectionId& connection, std::string_view text);
+    void publish();
+
+    NetInbox<NetInputBatch> m_inbox;   // Lines from every reactor; also woken by requestStop()
+    std::vector<std::unique_ptr<NetReactor>> m_reactors;
+    std::unique_ptr<TlsAcceptor> m_tls;   // Hands sessions to m_reactors, so it stops first
+    std::vector<Shard> m_shards;
+    std::atomic<bool> m_stopRequested{false};
+    std::chrono::steady_clock::time_point m_nextReconnect{};
+
+    // Sessions are numbered here, below 2^48 so a shard can key them as
+    // connections of its own
+    std::unordered_map<std::uint64_t, Session> m_sessions;          // By session number
+    std::unordered_map<std::uint64_t, std::uint64_t> m_numbers;     // Session numbers by ConnectionId::key()
+    std::uint64_t m_nextSession = 1;
+
+    std::vector<NetOutputBatch> m_pending;   // Per reactor
+    std::vector<ShardMessage> m_messages;   // Views of the link they came on, until its next receive
+};
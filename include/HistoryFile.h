@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string_view>
+
+/**
+ * Append-only command history file.
+ *
+ * The file is an 8-byte header followed by records of a 32-bit timestamp
+ * (seconds since the Unix epoch), a 16-bit length and the command bytes, all
+ * little-endian. Opening maps the file and walks the record headers; the
+ * newest records are handed out as views into the mapping, so nothing is
+ * parsed and only the commands kept are copied. New commands are appended
+ * with one write each. A record cut short by a crash is dropped.
+ */
+class HistoryFile {
+public:
+    struct Record {
+        std::uint32_t timestamp;
+        std::string_view command;   // Valid only during the open() callback
+    };
+
+    static constexpr std::size_t kMaxCommandLength = 0xFFFF;
+
+    HistoryFile() = default;
+    ~HistoryFile();
+
+    HistoryFile(HistoryFile&& other) noexcept;
+    HistoryFile& operator=(HistoryFile&& other) noexcept;
+    HistoryFile(const HistoryFile&) = delete;
+    HistoryFile& operator=(const HistoryFile&) = delete;
+
+    // Open or create the file and pass its newest keep records to onRecord,
+    // oldest first. Fails if the file cannot be opened or is not a history file
+    bool open(const std::filesystem::path& path, std::size_t keep, const std::function<void(const Record&)>& onRecord);
+    void close() noexcept;
+    bool isOpen() const noexcept { return m_file != nullptr; }
+
+    // Records in the file, including ones no longer kept in memory
+    std::size_t recordCount() const noexcept { return m_records; }
+
+    // Append one record; commands longer than kMaxCommandLength are not saved
+    bool append(std::uint32_t timestamp, std::string_view command);
+
+    // Replace the file's contents with records, e.g. to drop old entries
+    bool rewrite(std::span<const Record> records);
+
+private:
+    bool openForAppend();
+
+    std::filesystem::path m_path;
+    std::FILE* m_file = nullptr;
+    std::size_t m_records = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * N-gram index over command history, for incremental substring search.
+ *
+ * Every entry has an id that only grows, and each sequence of one to three
+ * bytes maps to the ascending ids of the entries containing it. A query is
+ * answered by walking the shortest posting list among its own trigrams (or
+ * its single gram, if shorter) from the newest id down, checking each
+ * candidate with a plain substring search; a gram no entry contains rules
+ * out a match without touching any text. Entries that fall out of the
+ * history are skipped by id and pruned in bulk later.
+ */
+class HistoryIndex {
+public:
+    static constexpr std::size_t kMaxGram = 3;
+
+    // Index an entry; ids must be added in increasing order
+    void add(std::uint32_t id, std::string_view command);
+
+    // Entries below firstLive are gone from the history
+    void forgetBefore(std::uint32_t firstLive);
+
+    void clear() noexcept;
+
+    // Id the next added entry should have
+    std::uint32_t end() const noexcept { return m_end; }
+
+    // Newest live id below before for which isMatch(id) holds, among the
+    // entries containing every gram of needle, which must not be empty
+    template <typename IsMatch>
+    std::optional<std::uint32_t> findBefore(std::string_view needle, std::uint32_t before, IsMatch&& isMatch) const {
+        const std::vector<std::uint32_t>* postings = rarestPostings(needle);
+        if (!postings) {
+            return std::nullopt;
+        }
+        auto it = std::lower_bound(postings->begin(), postings->end(), before);
+        while (it != postings->begin()) {
+            const std::uint32_t id = *--it;
+            if (id < m_firstLive) {
+                break;
+            }
+            if (isMatch(id)) {
+                return id;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    // The gram's bytes, tagged with its length so grams of different lengths never collide
+    static std::uint32_t key(std::string_view text, std::size_t pos, std::size_t length) noexcept {
+        std::uint32_t bytes = static_cast<std::uint32_t>(length) << 24;
+        for (std::size_t i = 0; i < length; ++i) {
+            bytes |= static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + i])) << (8 * i);
+        }
+        return bytes;
+    }
+
+    // Shortest posting list among the grams of needle, or null if one has none
+    const std::vector<std::uint32_t>* rarestPostings(std::string_view needle) const;
+
+    void prune();
+
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> m_postings;
+    std::uint32_t m_end = 0;
+    std::uint32_t m_firstLive = 0;
+    std::uint32_t m_prunedTo = 0;   // No posting holds an id below this
+};
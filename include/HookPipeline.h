@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include "GameWorld.h"
+#include "InlineDelegate.h"
+#include "TraceLog.h"
+
+// Events that hooks can subscribe to
+enum class HookEvent : std::uint8_t {
+    Command,
+    Move,
+    PlayerJoin,
+    PlayerLeave,
+    Count
+};
+
+// Before hooks may block the event; after hooks observe it once it has happened
+enum class HookPhase : std::uint8_t {
+    Before,
+    After
+};
+
+enum class HookDecision : std::uint8_t {
+    Continue,
+    Block
+};
+
+// Event payloads passed to hooks
+struct CommandEvent {
+    PlayerId player;
+    std::string_view command;
+    std::string_view args;
+};
+
+struct MoveEvent {
+    PlayerId player;
+    Direction direction;
+    RoomId from;
+    RoomId to;   // kInvalidRoomId if there is no exit that way
+};
+
+struct PlayerEvent {
+    PlayerId player;
+    std::string_view name;
+};
+
+template <typename Event>
+using Hook = InlineDelegate<HookDecision(const Event&)>;
+
+using HookId = std::uint32_t;
+inline constexpr HookId kInvalidHookId = 0;
+
+/**
+ * Registry and dispatcher for game event hooks.
+ *
+ * Modules and scripts register hooks per event type and phase. A bitmask
+ * records which (event, phase) pairs have at least one subscriber, so the
+ * dispatch helpers return immediately for events nobody listens to and the
+ * engine only pays for hooks that exist.
+ */
+class HookPipeline {
+public:
+    HookId addCommandHook(HookPhase phase, Hook<CommandEvent> hook);
+    HookId addMoveHook(HookPhase phase, Hook<MoveEvent> hook);
+    HookId addPlayerHook(HookEvent event, Hook<PlayerEvent> hook);
+
+    // Remove a previously registered hook; safe to call from inside a hook
+    void remove(HookId id);
+
+    bool hasSubscribers(HookEvent event, HookPhase phase) const noexcept {
+        return (m_mask & bit(event, phase)) != 0;
+    }
+
+    // Dispatch helpers: a single mask test when there are no subscribers
+    HookDecision run(HookPhase phase, const CommandEvent& event) {
+        if (!hasSubscribers(HookEvent::Command, phase)) return HookDecision::Continue;
+        return dispatch(m_commandHooks[index(phase)], event);
+    }
+
+    HookDecision run(HookPhase phase, const MoveEvent& event) {
+        if (!hasSubscribers(HookEvent::Move, phase)) return HookDecision::Continue;
+        return dispatch(m_moveHooks[index(phase)], event);
+    }
+
+    void run(HookEvent playerEvent, const PlayerEvent& event) {
+        if (!hasSubscribers(playerEvent, HookPhase::After)) return;
+        auto& hooks = playerEvent == HookEvent::PlayerJoin ? m_joinHooks : m_leaveHooks;
+        dispatch(hooks, event);
+    }
+
+private:
+    template <typename Event>
+    struct Entry {
+        HookId id;
+        Hook<Event> hook;
+    };
+
+    template <typename Event>
+    using HookList = std::vector<Entry<Event>>;
+
+    static constexpr std::uint32_t bit(HookEvent event, HookPhase phase) noexcept {
+        return 1u << (static_cast<std::uint32_t>(event) * 2 + static_cast<std::uint32_t>(phase));
+    }
+
+    static constexpr std::size_t index(HookPhase phase) noexcept {
+        return static_cast<std::size_t>(phase);
+    }
+
+    template <typename Event>
+    HookDecision dispatch(HookList<Event>& hooks, const Event& event);
+
+    template <typename Event>
+    HookId add(HookList<Event>& hooks, std::uint32_t maskBit, Hook<Event> hook);
+
+    template <typename Event>
+    bool removeFrom(HookList<Event>& hooks, HookId id);
+
+    void compact();
+    void rebuildMask();
+    void finishDispatch();
+
+    std::uint32_t m_mask = 0;
+    HookId m_nextId = 1;
+
+    // Changes made while a hook is running are deferred until dispatch unwinds:
+    // removal tombstones the entry and additions are queued, so no list is
+    // resized and no callable is destroyed underneath a running hook. Zone
+    // actors dispatch from several threads at once, so the depth is counted
+    // atomically; hooks they run must not register or remove hooks
+    int m_dispatchDepth = 0;
+    bool m_needsCompaction = false;
+    std::vector<std::function<void()>> m_pendingAdds;
+    std::vector<HookId> m_pendingRemovals;
+
+    HookList<CommandEvent> m_commandHooks[2];
+    HookList<MoveEvent> m_moveHooks[2];
+    HookList<PlayerEvent> m_joinHooks;
+    HookList<PlayerEvent> m_leaveHooks;
+};
+
+template <typename Event>
+HookDecision HookPipeline::dispatch(HookList<Event>& hooks, const Event& event) {
+    HookDecision decision = HookDecision::Continue;
+    std::atomic_ref<int>(m_dispatchDepth).fetch_add(1, std::memory_order_relaxed);
+    try {
+        // Hooks removed during this dispatch stay in place as tombstones
+        for (auto& entry : hooks) {
+            if (entry.id != kInvalidHookId && entry.hook(event) == HookDecision::Block) {
+                TRACE_EVENT("hook {} blocked", entry.id);
+                decision = HookDecision::Block;
+                break;
+            }
+        }
+    } catch (...) {
+        finishDispatch();
+        throw;
+    }
+    finishDispatch();
+    return decision;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "NetInbox.h"
+
+// The name found for a session's address
+struct ResolvedHost {
+    std::uint64_t session = 0;   // As given to submit()
+    std::string address;
+    std::string host;            // Empty when the address has no name, or one that does not lead back to it
+};
+
+// Totals since the resolver was made
+struct ResolverStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t cached = 0;     // Answered from the cache, or joined to a lookup under way
+    std::uint64_t lookups = 0;
+    std::uint64_t named = 0;      // Lookups that found a confirmed name
+    std::uint64_t dropped = 0;    // Refused with the queue full; those sessions keep their address
+};
+
+/**
+ * Host names for new connections, looked up off the game thread.
+ *
+ * getnameinfo() blocks for as long as the DNS server takes, seconds when it
+ * is slow or the address has no PTR record, so no reactor or game thread
+ * ever calls it. The front end submits a session's address once the
+ * session opens. A few workers do the reverse lookup and then look the name
+ * up forwards, keeping it only if it leads back to the address, since
+ * whoever owns an address's reverse zone can claim any name. Each result is
+ * posted to the inbox the front end polls, and shown once it arrives.
+ *
+ * Answers are cached by address for ttl, and addresses with no name for a
+ * shorter time, so a client that reconnects is named at once. Sessions that
+ * share an address while its lookup is under way wait on the same lookup.
+ * The queue is bounded; past it, sessions simply go unnamed. submit() and
+ * stats() are for one thread.
+ */
+class HostResolver {
+public:
+    static constexpr std::chrono::seconds kDefaultTtl = std::chrono::hours(1);
+    static constexpr std::chrono::seconds kUnnamedTtl = std::chrono::minutes(5);
+    static constexpr std::size_t kQueueLimit = 256;     // Addresses waiting for a worker
+    static constexpr std::size_t kCacheLimit = 4096;
+
+    HostResolver(NetInbox<ResolvedHost>& results, unsigned threads, std::chrono::seconds ttl = kDefaultTtl);
+    // Waits for lookups under way, which the resolver's own timeouts bound
+    ~HostResolver();
+
+    HostResolver(const HostResolver&) = delete;
+    HostResolver& operator=(const HostResolver&) = delete;
+
+    // The cached name for address (empty for one known to have none), or
+    // nullopt once a lookup is queued, whose result is posted for session
+    std::optional<std::string> submit(std::uint64_t session, const std::string& address);
+
+    ResolverStats stats() const;
+
+private:
+    struct Entry {
+        std::string host;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    void work();
+    static std::string lookup(const std::string& address);
+    void remember(const std::string& address, std::string host, std::chrono::steady_clock::time_point now);
+
+    NetInbox<ResolvedHost>& m_results;
+    std::chrono::seconds m_ttl;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::string> m_queue;
+    std::unordered_map<std::string, std::vector<std::uint64_t>> m_waiting;   // By address queued or being looked up
+    std::unordered_map<std::string, Entry> m_cache;
+    ResolverStats m_stats;
+    bool m_stopping = false;
+    std::vector<std::thread> m_threads;
+};
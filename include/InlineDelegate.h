@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Fixed-size, non-allocating callable wrapper.
+ *
+ * Callables up to InlineSize bytes (function pointers, captureless lambdas,
+ * lambdas capturing a pointer or a std::string) are stored directly in the
+ * delegate, so construction never allocates and a call is one indirect jump
+ * through a static ops table. Larger callables are adapted through a
+ * std::function held in the same inline buffer, which keeps the object size
+ * fixed while still accepting arbitrary captures. The buffer is four
+ * pointers, or a std::function where that is bigger, as it is on MSVC.
+ */
+template <typename Signature, std::size_t InlineSize = std::max(4 * sizeof(void*), sizeof(std::function<Signature>))>
+class InlineDelegate;
+
+template <typename R, typename... Args, std::size_t InlineSize>
+class InlineDelegate<R(Args...), InlineSize> {
+public:
+    using Fallback = std::function<R(Args...)>;
+
+    static_assert(sizeof(Fallback) <= InlineSize, "InlineSize must be able to hold the std::function fallback");
+
+    InlineDelegate() noexcept = default;
+    InlineDelegate(std::nullptr_t) noexcept {}
+
+    template <typename F>
+        requires (!std::is_same_v<std::remove_cvref_t<F>, InlineDelegate> &&
+                  std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    InlineDelegate(F&& callable) {
+        emplace(std::forward<F>(callable));
+    }
+
+    InlineDelegate(const InlineDelegate& other) : m_ops(other.m_ops) {
+        if (m_ops) {
+            m_ops->copy(m_storage, other.m_storage);
+        }
+    }
+
+    InlineDelegate(InlineDelegate&& other) noexcept : m_ops(other.m_ops) {
+        if (m_ops) {
+            m_ops->move(m_storage, other.m_storage);
+            other.reset();
+        }
+    }
+
+    InlineDelegate& operator=(const InlineDelegate& other) {
+        if (this != &other) {
+            InlineDelegate copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    InlineDelegate& operator=(InlineDelegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.m_ops) {
+                m_ops = other.m_ops;
+                m_ops->move(m_storage, other.m_storage);
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    InlineDelegate& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~InlineDelegate() { reset(); }
+
+    R operator()(Args... args) const {
+        return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+    // True when the callable had to be wrapped in the std::function fallback
+    bool usesFallback() const noexcept { return m_ops != nullptr && m_ops->fallback; }
+
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+        bool fallback;
+    };
+
+    template <typename F>
+    static constexpr bool fitsInline =
+        sizeof(F) <= InlineSize &&
+        alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static constexpr Ops opsFor{
+        [](void* storage, Args&&... args) -> R {
+            return std::invoke(*static_cast<F*>(storage), std::forward<Args>(args)...);
+        },
+        [](void* dst, const void* src) {
+            ::new (dst) F(*static_cast<const F*>(src));
+        },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+        },
+        [](void* storage) noexcept {
+            static_cast<F*>(storage)->~F();
+        },
+        std::is_same_v<F, Fallback>
+    };
+
+    template <typename F>
+    void emplace(F&& callable) {
+        using Stored = std::decay_t<F>;
+        if constexpr (std::is_pointer_v<Stored> || std::is_member_pointer_v<Stored>) {
+            if (callable == nullptr) {
+                return;
+            }
+        } else if constexpr (std::is_same_v<Stored, Fallback>) {
+            if (!callable) {
+                return;
+            }
+        }
+
+        if constexpr (fitsInline<Stored>) {
+            ::new (static_cast<void*>(m_storage)) Stored(std::forward<F>(callable));
+            m_ops = &opsFor<Stored>;
+        } else {
+            ::new (static_cast<void*>(m_storage)) Fallback(std::forward<F>(callable));
+            m_ops = &opsFor<Fallback>;
+        }
+    }
+
+    alignas(std::max_align_t) mutable unsigned char m_storage[InlineSize];
+    const Ops* m_ops = nullptr;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <linux/io_uring.h>
+
+/**
+ * Minimal io_uring instance driven through the raw system calls.
+ *
+ * Wraps the submission and completion rings, a provided buffer ring that
+ * multishot receives pick their buffers from (group kBufferGroup), and a
+ * sparse table of registered buffers that zero-copy sends can name by index
+ * instead of passing addresses the kernel has to pin on every call. Submissions queue
+ * in user memory and go to the kernel in one io_uring_enter with the wait for
+ * completions, so a loop iteration costs a single system call however many
+ * sockets it serves.
+ *
+ * create() returns null when the kernel lacks any of the features used
+ * (Linux 6.0 or later); callers fall back to another backend.
+ */
+class IoUring {
+public:
+    static constexpr std::uint16_t kBufferGroup = 0;
+
+    struct Completion {
+        std::uint64_t data;
+        std::int32_t result;
+        std::uint32_t flags;
+    };
+
+    // entries submissions in flight between waits, receiveBuffers of
+    // receiveBufferSize bytes (a power of two), fixedSlots registered buffers
+    static std::unique_ptr<IoUring> create(unsigned entries, unsigned receiveBuffers, std::size_t receiveBufferSize,
+                                           unsigned fixedSlots);
+
+    ~IoUring();
+
+    // The kernel holds the ring addresses
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // A zeroed submission entry, submitting what is queued first if the ring is full
+    io_uring_sqe& next();
+
+    // Submit everything queued and wait up to timeoutMs (-1 for no limit) for
+    // a completion, unless some are already waiting
+    void submitAndWait(int timeoutMs);
+
+    // Call fn with each waiting completion. fn may queue new submissions
+    template <typename Fn>
+    void drain(Fn&& fn) {
+        std::atomic_ref<std::uint32_t> tail(*m_cqTail);
+        std::atomic_ref<std::uint32_t> head(*m_cqHead);
+        for (std::uint32_t at = head.load(std::memory_order_relaxed); at != tail.load(std::memory_order_acquire);) {
+            const io_uring_cqe& cqe = m_cqes[at & m_cqMask];
+            const Completion completion{cqe.user_data, cqe.res, cqe.flags};
+            head.store(++at, std::memory_order_release);
+            fn(completion);
+        }
+    }
+
+    // Registered buffers; false if the kernel refused the memory
+    bool registerBuffer(unsigned slot, void* data, std::size_t size);
+
+    // Provided buffers
+    const char* receiveBuffer(unsigned id) const noexcept { return m_receiveData.get() + id * m_receiveBufferSize; }
+    void recycle(unsigned id) noexcept;
+
+private:
+    IoUring() = default;
+
+    bool setup(unsigned entries);
+    bool setupReceiveBuffers(unsigned count, std::size_t size);
+    void enter(unsigned minComplete, unsigned flags, const void* arg, std::size_t argSize);
+
+    int m_fd = -1;
+    void* m_rings = nullptr;         // Both rings, in one mapping
+    std::size_t m_ringsSize = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    std::size_t m_sqesSize = 0;
+
+    std::uint32_t* m_sqHead = nullptr;
+    std::uint32_t* m_sqTail = nullptr;
+    std::uint32_t m_sqMask = 0;
+    std::uint32_t m_sqEntries = 0;
+    std::uint32_t m_sqQueued = 0;    // Local tail, published on submit
+
+    std::uint32_t* m_cqHead = nullptr;
+    std::uint32_t* m_cqTail = nullptr;
+    std::uint32_t m_cqMask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+
+    io_uring_buf* m_receiveRing = nullptr;
+    std::size_t m_receiveRingSize = 0;
+    std::uint16_t m_receiveMask = 0;
+    std::uint16_t m_receiveTail = 0;
+    std::unique_ptr<char[]> m_receiveData;
+    std::size_t m_receiveBufferSize = 0;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Added to combat stats, by an item carried or an affect
+struct StatBonus {
+    std::int32_t attack = 0;
+    std::int32_t defense = 0;
+    std::int32_t damage = 0;
+};
+
+// What every instance of a kind of item has in common; never changes once defined
+struct ItemPrototype {
+    std::string name;               // What players call it, as they would type it
+    std::string description;
+    std::uint32_t decayTicks = 0;   // Instances crumble this long after they appear; 0 for never
+    StatBonus bonus{};              // To whoever carries one
+};
+
+/**
+ * The kinds of item the world knows, each defined once.
+ *
+ * An item instance is an entity whose Item component points at its
+ * prototype, so a million lanterns share one name and description and each
+ * costs a pointer plus wherever it lies. Prototypes are immutable and never
+ * move or go away, which is what lets instances hold plain pointers.
+ */
+class ItemCatalog {
+public:
+    // Add a prototype; nullptr when one with that name already exists
+    const ItemPrototype* define(ItemPrototype prototype) {
+        if (m_byName.contains(prototype.name)) {
+            return nullptr;
+        }
+        const ItemPrototype& stored = m_prototypes.emplace_back(std::move(prototype));
+        m_byName.emplace(stored.name, &stored);
+        return &stored;
+    }
+
+    const ItemPrototype* find(std::string_view name) const {
+        const auto found = m_byName.find(name);
+        return found != m_byName.end() ? found->second : nullptr;
+    }
+
+    std::size_t size() const noexcept { return m_prototypes.size(); }
+
+    // In the order they were defined
+    template <typename Fn>
+    void each(Fn&& visit) const {
+        for (const ItemPrototype& prototype : m_prototypes) {
+            visit(prototype);
+        }
+    }
+
+private:
+    std::deque<ItemPrototype> m_prototypes;   // A deque, so defining more moves none
+    std::unordered_map<std::string_view, const ItemPrototype*> m_byName;   // Names point into m_prototypes
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "InlineDelegate.h"
+
+// One piece of a parallelFor
+struct JobRange {
+    std::size_t begin;
+    std::size_t end;
+    std::size_t chunk;   // begin / grain; the same on any number of threads
+    unsigned worker;     // 0 for the thread that called parallelFor
+};
+
+/**
+ * World changes recorded during a parallel update, made afterwards.
+ *
+ * Workers only read the world; what they would change they push here as
+ * closures, and the game thread applies the buffers once every worker is
+ * done. Each chunk of a parallelFor records into its own buffer, and the
+ * buffers are applied in chunk order, so the result is the same whichever
+ * thread ran which chunk, or how many there were. Capacity is kept between
+ * ticks, so a steady update allocates nothing.
+ */
+class CommandBuffer {
+public:
+    using Command = InlineDelegate<void()>;
+
+    template <typename F>
+    void push(F&& command) {
+        m_commands.emplace_back(std::forward<F>(command));
+    }
+
+    bool empty() const noexcept { return m_commands.empty(); }
+    std::size_t size() const noexcept { return m_commands.size(); }
+
+    // Run the commands in the order they were pushed, then forget them
+    std::size_t apply() {
+        for (const Command& command : m_commands) {
+            command();
+        }
+        const std::size_t count = m_commands.size();
+        m_commands.clear();
+        return count;
+    }
+
+private:
+    std::vector<Command> m_commands;
+};
+
+/**
+ * Fixed pool of worker threads for data-parallel world updates.
+ *
+ * parallelFor cuts [0, count) into chunks of grain indices and hands each
+ * thread, the caller included, a contiguous span of chunks. A thread claims
+ * chunks from the front of its own span with one fetch_add, and once that
+ * runs dry it steals from the other spans the same way, so an uneven span
+ * (a crowded zone, a busy room) is finished by whoever is free and no
+ * thread waits while work is left. Workers sleep on an atomic between jobs.
+ *
+ * parallelFor is called from one thread at a time and returns once every
+ * chunk has run; the body must not throw.
+ */
+class JobSystem {
+public:
+    using Body = InlineDelegate<void(const JobRange&)>;
+
+    // Workers beside the calling thread; 0 runs everything on the caller.
+    // With cores, each worker is pinned to the next of them in turn
+    explicit JobSystem(unsigned threads, std::span<const int> cores = {});
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // One worker per core beside the caller
+    static unsigned defaultThreads();
+
+    static std::size_t chunkCount(std::size_t count, std::size_t grain) noexcept {
+        return grain == 0 ? count : (count + grain - 1) / grain;
+    }
+
+    // Threads taking part, the caller included
+    unsigned threadCount() const noexcept { return static_cast<unsigned>(m_threads.size()) + 1; }
+
+    void parallelFor(std::size_t count, std::size_t grain, const Body& body);
+
+private:
+    // A thread's chunks; padded so claiming one does not disturb the next
+    struct alignas(64) Span {
+        std::atomic<std::size_t> next{0};
+        std::size_t end = 0;
+    };
+
+    void workerLoop(unsigned worker);
+    void work(unsigned worker);
+    void runChunk(std::size_t chunk, unsigned worker) const;
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<Span[]> m_spans;   // One per thread taking part
+
+    // The job in progress, published by bumping m_generation
+    const Body* m_body = nullptr;
+    std::size_t m_count = 0;
+    std::size_t m_grain = 1;
+
+    std::atomic<std::uint64_t> m_generation{0};
+    std::atomic<unsigned> m_running{0};   // Workers not yet done with the current job
+    std::atomic<bool> m_stop{false};
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "ByteRing.h"
+
+// When the writer asks the disk to keep what it wrote
+enum class JournalSync : std::uint8_t {
+    Never,      // Whenever the kernel gets round to it; fastest, and lost with the machine
+    Always,     // After every group commit
+    Interval,   // After a group commit at most once an interval
+};
+
+// Totals since the journal was opened
+struct JournalStats {
+    std::uint64_t records = 0;     // Written to disk
+    std::uint64_t batches = 0;     // Group commits: one write, and a sync if due, each
+    std::uint64_t bytes = 0;
+    std::uint64_t syncs = 0;
+    std::uint64_t failed = 0;      // Writes or syncs the disk refused
+    std::uint64_t overflowed = 0;  // Records that found the ring full and waited beside it
+    std::chrono::nanoseconds longestSync{0};
+};
+
+// Precedes each record in a segment, which is a run of these, each padded
+// to 8 bytes. A record is the key and then the payload
+struct JournalRecordHeader {
+    std::uint32_t size = 0;        // Of the key and payload
+    std::uint32_t checksum = 0;    // FNV-1a of the key and payload
+    std::uint64_t sequence = 0;    // From 1, one more for each record ever appended
+    std::uint32_t keySize = 0;
+    std::uint32_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<JournalRecordHeader> && sizeof(JournalRecordHeader) == 24);
+
+/**
+ * An append-only journal of records written behind the game, for putting
+ * back what a crash would otherwise lose between saves.
+ *
+ * The game thread append()s records into a lock-free ring and commit()s
+ * once a pass, which publishes everything appended since as one group and
+ * wakes the writer thread; neither ever waits on the writer or the disk.
+ * Should the writer fall so far behind that the ring is full, records wait
+ * in a queue on the game thread's side and go in at a later commit, so the
+ * game still does not wait, only uses more memory. The writer takes each
+ * group with one write and then syncs it as the JournalSync says.
+ *
+ * The journal is a series of segment files in its directory, named after
+ * the first sequence number each may hold. release() says the records up
+ * to a sequence number are kept elsewhere now, such as in saves that are
+ * on disk; the writer then starts a new segment and deletes those holding
+ * nothing newer, so the journal only ever holds what came after the last
+ * save. Unless the JournalSync is Never it syncs the file system first, so
+ * whatever took the records over is on disk before they go. recover() reads whatever segments a previous run left, oldest
+ * first, stopping in each at the first torn or damaged record.
+ *
+ * Once the constructor has opened the first segment, segment files are only
+ * touched by the writer; the destructor writes and syncs everything
+ * appended before it returns.
+ */
+class Journal {
+public:
+    static constexpr std::size_t kDefaultRingBytes = std::size_t{1} << 20;
+    static constexpr std::chrono::milliseconds kDefaultSyncInterval{100};
+
+    struct Recovered {
+        std::uint64_t nextSequence = 1;   // Where a new journal should carry on
+        std::uint64_t records = 0;
+        std::uint64_t segments = 0;
+        std::uint64_t tornBytes = 0;      // Past the last good record of a segment
+    };
+
+    // Call apply(key, sequence, payload) for every intact record in the
+    // directory's segments, in sequence order
+    static Recovered recover(const std::filesystem::path& directory,
+                             const std::function<void(std::string_view, std::uint64_t, std::string_view)>& apply);
+
+    // Journal into directory, numbering records from firstSequence; the
+    // segments already there are left until release() passes them
+    Journal(std::filesystem::path directory, std::uint64_t firstSequence, JournalSync sync,
+            std::chrono::milliseconds syncInterval = kDefaultSyncInterval, std::size_t ringBytes = kDefaultRingBytes);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Game thread: queue a record and return its sequence number; the writer
+    // sees it at the next commit()
+    std::uint64_t append(std::string_view key, std::string_view payload);
+    // Game thread: hand everything appended over as one group
+    void commit();
+    // Game thread: records up to through need keeping no longer
+    void release(std::uint64_t through);
+
+    // Of the last record appended, and the one the next will have
+    std::uint64_t sequence() const noexcept { return m_next - 1; }
+    std::uint64_t nextSequence() const noexcept { return m_next; }
+    // Records waiting beside a full ring; commit() again soon when true
+    bool backlogged() const noexcept { return !m_overflow.empty(); }
+    // Of the newest record written, and synced unless the JournalSync is Never
+    std::uint64_t durable() const noexcept { return m_durable.load(std::memory_order_acquire); }
+    JournalStats stats() const;
+
+private:
+    struct Segment {
+        std::filesystem::path path;
+        std::uint64_t last = 0;   // Sequence of its newest record
+    };
+
+    std::filesystem::path segmentPath(std::uint64_t first) const;
+    void work();
+    bool openSegment(std::uint64_t first);
+    void writeBatch(const std::string& batch);
+    void releaseSegments(std::uint64_t through);
+
+    std::filesystem::path m_directory;
+    JournalSync m_sync;
+    std::chrono::milliseconds m_syncInterval;
+
+    // The game thread's side
+    ByteRing m_ring;
+    std::uint64_t m_next;
+    std::string m_record;                  // Scratch, reused for every append
+    std::deque<std::string> m_overflow;    // Records that did not fit, oldest first
+    std::uint64_t m_overflowed = 0;
+
+    // Handed across: commits and releases wake the writer through m_signal
+    std::atomic<std::uint64_t> m_signal{0};
+    std::atomic<std::uint64_t> m_release{0};
+    std::atomic<bool> m_stopping{false};
+    std::atomic<std::uint64_t> m_durable{0};
+
+    // The writer's side
+    int m_fd = -1;
+    std::vector<Segment> m_segments;       // Oldest first; the last is being written
+    std::chrono::steady_clock::time_point m_lastSync;
+    bool m_unsynced = false;
+    mutable std::mutex m_statsMutex;
+    JournalStats m_stats;
+
+    std::thread m_thread;
+};
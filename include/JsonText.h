@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// text as a JSON string, quotes included: quotes and backslashes escaped and
+// control characters as \u00XX. Other bytes pass as they are, so text that
+// is UTF-8 stays UTF-8. Shared by the API's bodies and GMCP's payloads
+inline void appendJsonString(std::string& out, std::string_view text) {
+    constexpr char kHex[] = "0123456789abcdef";
+    out.push_back('"');
+    for (const char ch : text) {
+        const auto byte = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\') {
+            out.push_back('\\');
+            out.push_back(ch);
+        } else if (byte < 0x20) {
+            out.append("\\u00");
+            out.push_back(kHex[byte >> 4]);
+            out.push_back(kHex[byte & 0xF]);
+        } else {
+            out.push_back(ch);
+        }
+    }
+    out.push_back('"');
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "EntityStore.h"
+#include "SmallVector.h"
+#include "StringInterner.h"
+
+// The keywords an entity answers to, interned once when it is made
+struct Keywords {
+    SmallVector<Symbol, 4> symbols;
+};
+
+/**
+ * What lies in one room, by keyword, so `get sword` or `kill 2.orc` finds
+ * its target without comparing names against everything in the world.
+ *
+ * An entity's keywords are the words of its name, folded to lower case,
+ * and the whole name when it has several, so "a rusty sword" answers to
+ * sword, rusty and "a rusty sword". Entries are kept sorted by keyword and,
+ * under one keyword, in the order the entities arrived, so a lookup is a
+ * binary search and `N.keyword` is the Nth entry from there. The engine
+ * adds and removes entities as they enter and leave the room.
+ */
+class KeywordIndex {
+public:
+    // A typed target: `2.orc` is the second orc, `orc` the first
+    struct Target {
+        std::size_t nth = 1;
+        Symbol keyword = kNoSymbol;   // kNoSymbol when nothing was ever called that
+    };
+
+    // Interns the keywords of name
+    static Keywords keywordsOf(std::string_view name);
+    // Folds and looks up what a player typed; never interns
+    static Target parse(std::string_view typed);
+
+    void add(Entity entity, const Keywords& keywords);
+    void remove(Entity entity, const Keywords& keywords);
+
+    // The nth entity under keyword that accept takes, in arrival order
+    template <typename Accept>
+    Entity find(const Target& target, Accept&& accept) const {
+        std::size_t left = target.nth;
+        for (auto it = lowerBound(target.keyword); it != m_entries.end() && it->keyword == target.keyword; ++it) {
+            if (accept(it->entity) && --left == 0) {
+                return it->entity;
+            }
+        }
+        return kInvalidEntity;
+    }
+
+    Entity find(const Target& target) const {
+        return find(target, [](Entity) { return true; });
+    }
+
+    bool empty() const noexcept { return m_entries.empty(); }
+
+private:
+    struct Entry {
+        Symbol keyword;
+        std::uint32_t arrival;   // Orders entries under one keyword
+        Entity entity;
+    };
+
+    std::vector<Entry>::const_iterator lowerBound(Symbol keyword) const;
+
+    std::vector<Entry> m_entries;
+    std::uint32_t m_arrivals = 0;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Latency histogram in the manner of HdrHistogram, safe to record into from
+ * any thread.
+ *
+ * Nanosecond values fall into buckets that widen with the value: exact below
+ * 16, then 16 buckets to each power of two, so a bucket is never wider than
+ * about 6% of what it holds, from nanoseconds up to 2^40 ns (some 18
+ * minutes; longer is counted there). The buckets are a fixed array, so
+ * record() allocates nothing and costs a few shifts and relaxed adds.
+ * Readers load the counts as they stand; a read racing records may be a
+ * record or two out, which a percentile does not notice.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBits = 4;
+    static constexpr unsigned kMaxBits = 40;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBits;
+    static constexpr std::size_t kBuckets = (kMaxBits - kSubBits + 1) * kSubBuckets;
+
+    void record(std::chrono::nanoseconds time) noexcept {
+        const auto value = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(time.count(), 0));
+        m_counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(value, std::memory_order_relaxed);
+        std::uint64_t longest = m_max.load(std::memory_order_relaxed);
+        while (value > longest && !m_max.compare_exchange_weak(longest, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    std::chrono::nanoseconds max() const noexcept {
+        return std::chrono::nanoseconds(m_max.load(std::memory_order_relaxed));
+    }
+    std::chrono::nanoseconds total() const noexcept {
+        return std::chrono::nanoseconds(m_total.load(std::memory_order_relaxed));
+    }
+    std::chrono::nanoseconds mean() const noexcept {
+        const std::uint64_t n = count();
+        return std::chrono::nanoseconds(n ? m_total.load(std::memory_order_relaxed) / n : 0);
+    }
+
+    // The value a fraction q (0 to 1) of the records lie at or below, as the
+    // top of its bucket but never more than the largest recorded
+    std::chrono::nanoseconds percentile(double q) const noexcept {
+        const std::uint64_t n = count();
+        if (n == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const auto rank =
+            std::max<std::uint64_t>(static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(n)), 1);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += m_counts[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(std::chrono::nanoseconds(static_cast<std::int64_t>(highest(i))), max());
+            }
+        }
+        return max();
+    }
+
+    // Add other's records to these, such as to sum per-thread histograms
+    void merge(const LatencyHistogram& other) noexcept {
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            if (const std::uint64_t n = other.m_counts[i].load(std::memory_order_relaxed); n > 0) {
+                m_counts[i].fetch_add(n, std::memory_order_relaxed);
+            }
+        }
+        m_count.fetch_add(other.count(), std::memory_order_relaxed);
+        m_total.fetch_add(other.m_total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        const std::uint64_t longest = other.m_max.load(std::memory_order_relaxed);
+        std::uint64_t current = m_max.load(std::memory_order_relaxed);
+        while (longest > current && !m_max.compare_exchange_weak(current, longest, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Not atomic as a whole: records made meanwhile may survive in part
+    void reset() noexcept {
+        for (auto& count : m_counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_total.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t bucket(std::uint64_t value) noexcept {
+        value = std::min<std::uint64_t>(value, (std::uint64_t{1} << kMaxBits) - 1);
+        if (value < kSubBuckets) {
+            return static_cast<std::size_t>(value);
+        }
+        const unsigned top = static_cast<unsigned>(std::bit_width(value)) - 1;
+        const unsigned shift = top - kSubBits;
+        return (shift + 1) * kSubBuckets + static_cast<std::size_t>((value >> shift) & (kSubBuckets - 1));
+    }
+
+    // The largest value that falls into the bucket
+    static constexpr std::uint64_t highest(std::size_t index) noexcept {
+        if (index < kSubBuckets) {
+            return index;
+        }
+        const std::size_t shift = index / kSubBuckets - 1;
+        const std::uint64_t lowest = (kSubBuckets + index % kSubBuckets) << shift;
+        return lowest + (std::uint64_t{1} << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> m_counts{};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_total{0};   // Nanoseconds, for the mean
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+static_assert(LatencyHistogram::bucket(15) == 15 && LatencyHistogram::bucket(16) == 16 &&
+              LatencyHistogram::bucket(32) == 32 && LatencyHistogram::highest(LatencyHistogram::bucket(1000)) >= 1000);
+static_assert(LatencyHistogram::bucket(~std::uint64_t{0}) == LatencyHistogram::kBuckets - 1);
+
+/**
+ * Percentiles over recent records only, for a live readout that should
+ * show the effect of a change rather than the whole run's history.
+ *
+ * Records go to the newer of two histograms; each time the window passes,
+ * the older one is cleared and becomes the newer, so a snapshot covers
+ * between one and two windows of records. For one thread.
+ */
+class LatencyWindow {
+public:
+    explicit LatencyWindow(std::chrono::steady_clock::duration window) : m_window(window) {}
+
+    void record(std::chrono::nanoseconds time, std::chrono::steady_clock::time_point now) noexcept {
+        advance(now);
+        m_halves[m_newer].record(time);
+    }
+
+    // The records still in the window, merged into one histogram owned by this
+    const LatencyHistogram& snapshot(std::chrono::steady_clock::time_point now) noexcept {
+        advance(now);
+        m_merged.reset();
+        m_merged.merge(m_halves[0]);
+        m_merged.merge(m_halves[1]);
+        return m_merged;
+    }
+
+private:
+    void advance(std::chrono::steady_clock::time_point now) noexcept {
+        if (now < m_rotateAt) {
+            return;
+        }
+        if (now >= m_rotateAt + m_window) {
+            m_halves[m_newer].reset();   // Idle for a whole window: both are stale
+        }
+        m_newer ^= 1;
+        m_halves[m_newer].reset();
+        m_rotateAt = now + m_window;
+    }
+
+    std::chrono::steady_clock::duration m_window;
+    std::chrono::steady_clock::time_point m_rotateAt{};
+    std::array<LatencyHistogram, 2> m_halves;
+    LatencyHistogram m_merged;
+    std::size_t m_newer = 0;
+};
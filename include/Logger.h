@@ -0,0 +1,270 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "ByteRing.h"
+
+enum class LogLevel : std::uint8_t { Trace, Debug, Info, Warn, Error, Off };
+
+// Calls below this level compile to nothing; set with -DECHOMUD_LOG_LEVEL=N,
+// N being a LogLevel's value (0 Trace to 5 Off)
+#ifndef ECHOMUD_LOG_LEVEL
+#define ECHOMUD_LOG_LEVEL 1
+#endif
+inline constexpr LogLevel kCompiledLogLevel = static_cast<LogLevel>(ECHOMUD_LOG_LEVEL);
+
+// LOG_INFO("Listening on {}:{}", address, port). The arguments are copied
+// as they are, not formatted, and the format string must be a literal
+#define ECHOMUD_LOG(level, ...)                                   \
+    do {                                                          \
+        if constexpr ((level) >= kCompiledLogLevel) {             \
+            Logger::instance().log((level), __VA_ARGS__);         \
+        }                                                         \
+    } while (0)
+#define LOG_TRACE(...) ECHOMUD_LOG(LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) ECHOMUD_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) ECHOMUD_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) ECHOMUD_LOG(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) ECHOMUD_LOG(LogLevel::Error, __VA_ARGS__)
+// A message already made into one string
+#define DEBUG_LOG(msg) LOG_DEBUG("{}", msg)
+
+// Totals since the logger started
+struct LogStats {
+    std::uint64_t written = 0;      // Lines that reached the outputs
+    std::uint64_t dropped = 0;      // Found their thread's buffer full
+    std::uint64_t rotated = 0;      // Files moved aside for a fresh one
+    std::uint64_t compressed = 0;   // Of those, gzipped since
+};
+
+// When the sink moves the log file aside and starts a fresh one. A file
+// moved aside is named after it with the time, FILE.YYYYMMDD-HHMMSS-mmm,
+// and then gzipped to that name with .gz, where built with zlib
+struct LogRotation {
+    static constexpr std::uint64_t kDefaultBytes = std::uint64_t{64} << 20;
+
+    std::uint64_t maxBytes = kDefaultBytes;           // Once the file is this big; 0 for any size
+    std::chrono::seconds maxAge = std::chrono::hours(24);   // Once it has been open this long; 0 for any age
+    unsigned keep = 10;                               // Moved-aside files kept, the newest; 0 for all
+    bool compress = true;
+};
+
+namespace logdetail {
+
+// What a record keeps of an argument: text by value, everything else as its bytes
+template <typename T>
+using Stored = std::conditional_t<std::is_convertible_v<const std::decay_t<T>&, std::string_view>, std::string_view,
+                                  std::decay_t<T>>;
+
+template <typename T>
+void encode(std::string& out, const T& value) {
+    using S = Stored<T>;
+    if constexpr (std::is_same_v<S, std::string_view>) {
+        const std::string_view text = value;
+        const auto size = static_cast<std::uint32_t>(text.size());
+        out.append(reinterpret_cast<const char*>(&size), sizeof size);
+        out.append(text);
+    } else {
+        static_assert(std::is_trivially_copyable_v<S> && std::is_copy_constructible_v<S> &&
+                          std::is_default_constructible_v<S>,
+                      "Log arguments are copied and formatted later; format this one into a string first");
+        out.append(reinterpret_cast<const char*>(&value), sizeof value);
+    }
+}
+
+template <typename S>
+S decode(const char*& in) {
+    if constexpr (std::is_same_v<S, std::string_view>) {
+        std::uint32_t size = 0;
+        std::memcpy(&size, in, sizeof size);
+        const std::string_view text(in + sizeof size, size);
+        in += sizeof size + size;
+        return text;
+    } else {
+        S value;
+        std::memcpy(&value, in, sizeof value);
+        in += sizeof value;
+        return value;
+    }
+}
+
+// Runs on the sink: format a record's arguments, decoded as they were stored
+template <typename... S>
+void render(std::string& out, std::string_view format, [[maybe_unused]] const char* arguments) {
+    // Braced, so the arguments are decoded in order
+    std::tuple<S...> values{decode<S>(arguments)...};
+    std::apply([&](auto&... value) { std::vformat_to(std::back_inserter(out), format, std::make_format_args(value...)); },
+               values);
+}
+
+using Renderer = void (*)(std::string&, std::string_view, const char*);
+
+// Precedes each record's arguments in a thread's ring; records are padded to 8 bytes
+struct RecordHeader {
+    std::uint32_t size = 0;   // Of the whole record, padding included
+    LogLevel level = LogLevel::Debug;
+    std::int64_t time = 0;    // System clock, in nanoseconds since the epoch
+    const char* format = nullptr;
+    std::size_t formatSize = 0;
+    Renderer render = nullptr;
+};
+
+static_assert(std::is_trivially_copyable_v<RecordHeader>);
+
+// One logging thread's records, shared with the sink until both are done with it
+struct ThreadBuffer {
+    static constexpr std::size_t kBytes = 256 * 1024;
+
+    ByteRing ring{kBytes};
+    std::string record;                       // The owning thread's scratch
+    std::atomic<std::uint64_t> dropped{0};    // Written by the owning thread only
+    std::uint64_t reported = 0;               // Of those, the ones the sink has counted
+    std::atomic<bool> finished{false};        // Its thread has exited
+};
+
+} // namespace logdetail
+
+/**
+ * The one logger every module writes through, asynchronous and lock-free
+ * on the logging side.
+ *
+ * Each thread that logs gets a ring of its own (a ByteRing), registered
+ * with the logger the first time it logs. A call copies the level, the
+ * time, a pointer to the format string and the arguments' values into it,
+ * nothing more: formatting happens later, on a sink thread, which wakes
+ * every few milliseconds, takes every thread's records, formats them in
+ * time order and writes them out with one write per output. A call never
+ * waits and never does I/O; when a thread's ring is full its records are
+ * dropped and counted, and the sink reports how many.
+ *
+ * Arguments are stored by value, so they may be anything trivially
+ * copyable that std::format takes, or text (copied). Levels below
+ * kCompiledLogLevel compile away entirely; setLevel() filters further at
+ * run time.
+ *
+ * The outputs are standard error and, from its first line, the file
+ * game_engine_debug.log in the working directory; the console front end
+ * moves the file and turns standard error off, where the screen is.
+ *
+ * The file is rotated by the sink as it writes (see LogRotation), between
+ * batches, so a logging thread never sees it happen. Gzipping the file
+ * moved aside, and deleting those past the number kept, is left to a
+ * housekeeping thread started with the first rotation, which runs at idle
+ * priority where the platform has one, so a rotation costs the sink only a
+ * rename and an open.
+ */
+class Logger {
+public:
+    static constexpr std::chrono::milliseconds kSinkInterval{20};
+
+    static Logger& instance();
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    template <typename... Args>
+    void log(LogLevel level, std::format_string<Args...> format, Args&&... args) {
+        if (level < m_level.load(std::memory_order_relaxed)) {
+            return;
+        }
+        logdetail::ThreadBuffer& buffer = threadBuffer();
+        std::string& record = buffer.record;
+        const std::string_view text = format.get();
+        record.assign(sizeof(logdetail::RecordHeader), '\0');
+        (logdetail::encode(record, args), ...);
+        record.resize((record.size() + 7) / 8 * 8, '\0');
+
+        logdetail::RecordHeader header;
+        header.size = static_cast<std::uint32_t>(record.size());
+        header.level = level;
+        header.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count();
+        header.format = text.data();
+        header.formatSize = text.size();
+        header.render = &logdetail::render<logdetail::Stored<Args>...>;
+        std::memcpy(record.data(), &header, sizeof header);
+
+        if (buffer.ring.write(record)) {
+            buffer.ring.publish();
+        } else {
+            buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    // Where lines go: a file, appended to, or none for an empty path
+    void setFile(const std::filesystem::path& path);
+    void setRotation(const LogRotation& rotation);
+    void setStderr(bool enabled);
+    // Calls below level return at once
+    void setLevel(LogLevel level) noexcept { m_level.store(level, std::memory_order_relaxed); }
+
+    // Return once everything logged before the call is written out
+    void flush();
+    LogStats stats() const;
+
+private:
+    Logger();
+
+    logdetail::ThreadBuffer& threadBuffer();
+    void work();
+    // Take every thread's records and write them out; sink only
+    void drain();
+    // Move the file aside and open a fresh one; sink only
+    void rotate(const std::filesystem::path& path, const LogRotation& rotation);
+    void keepHouse();
+
+    std::atomic<LogLevel> m_level{LogLevel::Trace};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    std::vector<std::shared_ptr<logdetail::ThreadBuffer>> m_buffers;
+    std::uint64_t m_flushRequested = 0;
+    std::uint64_t m_flushDone = 0;
+    bool m_stopping = false;
+
+    // The outputs, changed under m_mutex and used by the sink
+    std::filesystem::path m_path{"game_engine_debug.log"};
+    bool m_reopen = true;
+    bool m_stderr = true;
+    LogRotation m_rotation;
+
+    // Moved-aside files for the housekeeper, and whether to gzip them;
+    // under m_mutex
+    struct Rotated {
+        std::filesystem::path path;
+        std::filesystem::path current;   // The file it was moved aside from
+        LogRotation rotation;
+    };
+    std::vector<Rotated> m_rotated;
+    std::condition_variable m_housekeeping;
+    std::thread m_housekeeper;   // Started with the first rotation
+
+    // The sink's own
+    std::FILE* m_file = nullptr;
+    std::uint64_t m_fileBytes = 0;
+    std::chrono::steady_clock::time_point m_opened{};
+    std::string m_batch;
+    std::string m_lines;
+    LogStats m_stats;
+
+    std::thread m_thread;
+};
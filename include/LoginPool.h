@@ -0,0 +1,107 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NetInbox.h"
+
+// What the workers made of one login
+struct LoginResult {
+    enum class Outcome : std::uint8_t {
+        Accepted,        // The password matched the account's
+        Created,         // No account had the name, so one was made with this password
+        WrongPassword,
+        Failed           // The account file could not be read or written
+    };
+
+    std::uint64_t session = 0;   // As given to submit()
+    std::string name;
+    Outcome outcome = Outcome::Failed;
+};
+
+// Totals since the pool was made; only the game thread reads them
+struct LoginStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t refused = 0;   // submit() found the pool full
+    std::uint64_t accepted = 0;
+    std::uint64_t created = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t failed = 0;
+};
+
+/**
+ * Password checks and account loading, off the game thread.
+ *
+ * Hashing a password is meant to be slow (PBKDF2 with a high iteration
+ * count), so after a reboot the logins of everyone reconnecting at once
+ * would stall the game for seconds if it hashed them itself. Instead the
+ * front end submits each name and password here. A fixed set of workers
+ * reads the account file, hashes, and creates the account when the name
+ * is new, then posts a LoginResult to the inbox the front end polls. The
+ * queue is bounded: submit() refuses once queueLimit logins are waiting or
+ * being worked on, and the front end keeps the overflow in its own
+ * admission line, where players can see their place.
+ *
+ * Accounts are one small file each, <name>.account in the directory,
+ * holding the iteration count, a random salt and the derived key. Names
+ * must already be safe to use as file names (the front end takes letters
+ * only). submit(), drain and statistics are for one thread.
+ */
+class LoginPool {
+public:
+    static constexpr std::uint32_t kDefaultIterations = 100'000;
+    static constexpr std::size_t kDefaultQueueLimit = 64;
+
+    LoginPool(std::filesystem::path directory, NetInbox<LoginResult>& results, unsigned threads,
+              std::uint32_t iterations = kDefaultIterations, std::size_t queueLimit = kDefaultQueueLimit);
+    ~LoginPool();
+
+    LoginPool(const LoginPool&) = delete;
+    LoginPool& operator=(const LoginPool&) = delete;
+
+    // Check the password for name, or make the account; false, taking
+    // nothing, when the pool is full
+    bool submit(std::uint64_t session, std::string name, std::string password);
+
+    // Call for each result taken from the inbox, which frees its place
+    void finished(const LoginResult& result) noexcept;
+
+    bool full() const noexcept { return m_inFlight >= m_queueLimit; }
+    std::size_t inFlight() const noexcept { return m_inFlight; }
+    const LoginStats& stats() const noexcept { return m_stats; }
+
+    // The stored form of a password, as an account file line; exposed so
+    // tools can make accounts offline
+    static std::string hashPassword(std::string_view password, std::uint32_t iterations);
+    // Whether password matches a line made by hashPassword()
+    static bool verifyPassword(std::string_view stored, std::string_view password);
+
+private:
+    struct Request {
+        std::uint64_t session;
+        std::string name;
+        std::string password;
+    };
+
+    void work();
+    LoginResult check(Request& request) const;
+
+    std::filesystem::path m_directory;
+    NetInbox<LoginResult>& m_results;
+    std::uint32_t m_iterations;
+    std::size_t m_queueLimit;
+    std::size_t m_inFlight = 0;   // Submitted and not yet finished(); game thread only
+    LoginStats m_stats;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Request> m_requests;
+    bool m_stopping = false;
+    std::vector<std::thread> m_threads;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Pooled allocator for a single Lua state, usable as a lua_Alloc.
+ *
+ * Lua allocates huge numbers of short strings, table nodes and closures.
+ * Requests up to kMaxSmallSize bytes are served from per-size-class free
+ * lists carved out of large chunks, so they never touch the process heap
+ * after warm-up and script garbage doesn't fragment it. Larger blocks go to
+ * malloc. Live and peak byte counts are tracked, and an optional ceiling
+ * makes growing allocations fail once the state would exceed it, which Lua
+ * reports to the script as a "not enough memory" error. The live bytes go
+ * to MemoryTag::Lua too, in steps of kReportBytes or kReportAllocations
+ * allocations, so accounting costs Lua next to nothing.
+ *
+ * Not thread-safe: one arena belongs to one Lua state.
+ */
+class LuaArena {
+public:
+    // Blocks up to this size come from the size-class pools
+    static constexpr std::size_t kMaxSmallSize = 256;
+
+    // 0 means no ceiling
+    explicit LuaArena(std::size_t limitBytes = 0);
+    ~LuaArena();
+
+    LuaArena(const LuaArena&) = delete;
+    LuaArena& operator=(const LuaArena&) = delete;
+
+    // lua_Alloc entry point; userData is the LuaArena
+    static void* allocate(void* userData, void* block, std::size_t oldSize, std::size_t newSize);
+
+    void setLimit(std::size_t limitBytes) { m_limit = limitBytes; }
+    std::size_t limit() const { return m_limit; }
+    std::size_t liveBytes() const { return m_live; }
+    std::size_t peakBytes() const { return m_peak; }
+
+private:
+    static constexpr std::size_t kGranularity = 16;
+    static constexpr std::size_t kClassCount = kMaxSmallSize / kGranularity;
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+    static constexpr std::int64_t kReportBytes = 64 * 1024;
+    static constexpr std::uint64_t kReportAllocations = 1024;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr std::size_t sizeClass(std::size_t size) { return (size - 1) / kGranularity; }
+    static constexpr std::size_t classSize(std::size_t cls) { return (cls + 1) * kGranularity; }
+
+    void* reallocate(void* block, std::size_t oldSize, std::size_t newSize);
+    void* allocateBlock(std::size_t size);
+    void freeBlock(void* block, std::size_t size);
+    void* allocateSmall(std::size_t cls);
+    // A block of allocated bytes taken, grown to that size, or 0 for a shrink or free
+    void account(std::size_t allocated);
+
+    std::array<FreeBlock*, kClassCount> m_freeLists{};
+    std::vector<void*> m_chunks;
+    char* m_cursor = nullptr;
+    std::size_t m_remaining = 0;
+
+    std::size_t m_limit;
+    std::size_t m_live = 0;
+    std::size_t m_peak = 0;
+    std::size_t m_reported = 0;                 // Live bytes MemoryAccounting has been told of
+    std::uint64_t m_unreportedAllocations = 0;
+    std::uint64_t m_unreportedBytes = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Building blocks of the binary files read in place, such as player saves
+// and area files: sections of fixed-layout records and a string table,
+// which a mapped file can be read as once it has been bounds-checked.
+
+// A string in a file's string table
+struct SavedString {
+    std::uint32_t offset = 0;   // From the start of the table
+    std::uint32_t size = 0;
+};
+
+// Where a section lies in the file, in records of its type
+struct SavedSection {
+    std::uint32_t offset = 0;   // From the start of the file
+    std::uint32_t count = 0;
+};
+
+namespace mapped {
+
+// The section's records if they lie inside bytes and are aligned for T
+template <typename T>
+const T* section(std::string_view bytes, const SavedSection& where) noexcept {
+    if (where.offset % alignof(T) != 0 || where.offset > bytes.size()
+        || where.count > (bytes.size() - where.offset) / sizeof(T)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(bytes.data() + where.offset);
+}
+
+inline bool inTable(SavedString ref, std::size_t tableSize) noexcept {
+    return ref.offset <= tableSize && ref.size <= tableSize - ref.offset;
+}
+
+inline std::uint32_t fnv1a(std::string_view bytes) noexcept {
+    std::uint32_t hash = 2166136261u;
+    for (char c : bytes) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+// Append records at the next offset aligned for them
+template <typename T>
+SavedSection append(std::string& out, std::span<const T> records) {
+    out.resize((out.size() + alignof(T) - 1) / alignof(T) * alignof(T), '\0');
+    const SavedSection where{static_cast<std::uint32_t>(out.size()), static_cast<std::uint32_t>(records.size())};
+    out.append(reinterpret_cast<const char*>(records.data()), records.size_bytes());
+    return where;
+}
+
+inline SavedString addString(std::string& table, std::string_view text) {
+    const SavedString ref{static_cast<std::uint32_t>(table.size()), static_cast<std::uint32_t>(text.size())};
+    table.append(text);
+    return ref;
+}
+
+// Write contents beside path and rename it over, so a crash leaves either
+// the old file or the new one, never half of one
+inline bool replaceFile(const std::filesystem::path& path, std::string_view contents) {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    std::FILE* out = std::fopen(temporary.string().c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+    const bool ok = std::fwrite(contents.data(), 1, contents.size(), out) == contents.size();
+    std::error_code ec;
+    if (std::fclose(out) != 0 || !ok) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace mapped
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "ObjectPool.h"
+
+struct z_stream_s;
+
+/**
+ * One session's MCCP2 output stream (telnet option 86, COMPRESS2).
+ *
+ * Once the client has agreed to the option, everything the server sends it
+ * is one zlib stream. compress() takes the telnet-encoded bytes queued for
+ * the session and flush() ends a batch of them with a sync flush, so the
+ * client can decode everything sent so far without waiting for more. The
+ * window is kept small (4 KiB, about 32 KiB of state per stream) so that
+ * thousands of compressed sessions stay affordable; MUD output is short and
+ * repetitive enough that a larger window gains little.
+ */
+class MccpStream : public PoolLink<MccpStream> {
+public:
+    static constexpr unsigned char kOption = 86;
+
+    // nullptr when zlib cannot set up a stream
+    static std::unique_ptr<MccpStream> create();
+
+    ~MccpStream();
+
+    MccpStream(const MccpStream&) = delete;
+    MccpStream& operator=(const MccpStream&) = delete;
+
+    // Append the compressed form of bytes to out; false on a zlib error
+    bool compress(std::string_view bytes, std::string& out);
+
+    // Flush what compress() has taken so far onto out. With finish the
+    // stream ends and the client returns to plain telnet
+    bool flush(bool finish, std::string& out);
+
+    // Start over as a new stream for another session, keeping zlib's
+    // buffers; false on a zlib error
+    bool recycle();
+
+    // Bytes given to the stream, and what they compressed to so far
+    std::uint64_t bytesIn() const noexcept;
+    std::uint64_t bytesOut() const noexcept;
+
+private:
+    MccpStream();
+
+    bool deflateInto(int mode, std::string& out);
+
+    std::unique_ptr<z_stream_s> m_stream;
+};
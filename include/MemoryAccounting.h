@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+
+// The subsystems memory is counted against
+enum class MemoryTag : std::uint8_t {
+    Engine,     // Messages on their way to players
+    Lua,        // Every Lua state's objects
+    UiBuffer,   // The console's scrollback text
+    Sessions,   // Queued socket output
+    World,      // Entity pages and room text
+    Count
+};
+
+inline constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+// A tag's totals since the process started
+struct MemoryTagStats {
+    std::uint64_t liveBytes = 0;
+    std::uint64_t peakBytes = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t allocatedBytes = 0;   // Every allocation's size, summed
+};
+
+/**
+ * Tagged memory accounting: live and peak bytes and allocation counts per
+ * subsystem, for the stats command and for finding which part of the game
+ * a blow-up is in.
+ *
+ * Subsystems allocate through the types below, which count into their tag
+ * and pass the request on to the heap: TrackedAllocator for containers and
+ * allocate_shared, TrackedResource as a std::pmr::memory_resource, and
+ * TrackedBuffer for the raw blocks pools carve up. Counting is a few
+ * relaxed atomic adds on the tag's own cache line, so any thread may
+ * allocate and free; an allocator as hot as Lua's adds up locally and
+ * reports through record() in batches.
+ */
+class MemoryAccounting {
+public:
+    static void allocated(MemoryTag tag, std::size_t bytes) noexcept {
+        record(tag, static_cast<std::int64_t>(bytes), 1, bytes);
+    }
+    static void freed(MemoryTag tag, std::size_t bytes) noexcept { record(tag, -static_cast<std::int64_t>(bytes), 0, 0); }
+    // liveDelta bytes more live, after allocations new allocations of allocatedBytes in all
+    static void record(MemoryTag tag, std::int64_t liveDelta, std::uint64_t allocations,
+                       std::uint64_t allocatedBytes) noexcept;
+
+    static MemoryTagStats stats(MemoryTag tag) noexcept;
+    static std::string_view name(MemoryTag tag) noexcept;
+    // When counting began, for rates over the whole run
+    static std::chrono::steady_clock::time_point started() noexcept;
+
+private:
+    struct alignas(64) Counters {
+        std::atomic<std::int64_t> live{0};
+        std::atomic<std::int64_t> peak{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> allocatedBytes{0};
+    };
+
+    static std::array<Counters, kMemoryTagCount> s_counters;
+};
+
+enum class HugePageMode : std::uint8_t {
+    Off,
+    Transparent,   // Ordinary pages the kernel is asked to merge (MADV_HUGEPAGE)
+    Explicit       // MAP_HUGETLB, from the pages reserved in vm.nr_hugepages
+};
+
+// The huge-page arena's mappings, and how much of them the kernel put on huge pages
+struct HugePageStats {
+    HugePageMode mode = HugePageMode::Off;
+    std::size_t mappings = 0;
+    std::uint64_t mappedBytes = 0;
+    std::uint64_t explicitBytes = 0;   // Mapped MAP_HUGETLB
+    std::uint64_t fallbacks = 0;       // MAP_HUGETLB refused; it is not asked again
+    std::uint64_t hugeBytes = 0;       // On huge pages now, as /proc/self/smaps tells it
+};
+
+/**
+ * Huge pages under the memory that is large, lasts and is walked at random:
+ * the World and Sessions tags, so room and entity storage, zone pools and
+ * session pools. With a mode set, the tracked types below take those tags'
+ * blocks from an arena of 2 MiB-aligned mappings instead of the heap, and
+ * one TLB entry covers 2 MiB of them rather than 4 KiB.
+ *
+ * Blocks up to kLargestClass are carved from 2 MiB mappings by power-of-two
+ * size class, and a freed one waits on its class's list for the next; the
+ * mappings themselves are kept. Bigger blocks, such as a large world's
+ * exit column, get mappings of their own, unmapped when freed. Explicit
+ * mappings that the kernel refuses, as it does with no pages reserved, are
+ * made transparent instead, and so is everything after the first refusal.
+ * Without mmap (Windows) every block comes from the heap.
+ *
+ * configure() comes before the world is built; blocks already taken from
+ * the heap go back to it. Thread-safe behind one lock, which only these
+ * tags' allocations take.
+ */
+class HugePages {
+public:
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+    static constexpr std::size_t kLargestClass = std::size_t{256} << 10;
+
+    static void configure(HugePageMode mode) noexcept;
+    static HugePageMode mode() noexcept { return s_mode.load(std::memory_order_relaxed); }
+
+    // Whether tag's blocks come from the arena now
+    static bool covers(MemoryTag tag) noexcept { return mode() != HugePageMode::Off && coversTag(tag); }
+    // Whether a block of tag's may have come from it, so release() should be asked
+    static bool mayOwn(MemoryTag tag) noexcept { return s_used.load(std::memory_order_relaxed) && coversTag(tag); }
+
+    // A block of at least bytes, aligned to alignment; nullptr when the
+    // arena cannot map one, for the caller to take from the heap
+    static void* allocate(std::size_t bytes, std::size_t alignment) noexcept;
+    // Give block back to the arena; false when it did not come from there
+    static bool release(void* block, std::size_t bytes, std::size_t alignment) noexcept;
+
+    static HugePageStats stats();
+    static std::string_view name(HugePageMode mode) noexcept;
+    // "off", "transparent" or "explicit"
+    static bool parse(std::string_view text, HugePageMode& mode) noexcept;
+    // One line saying how much landed on huge pages, for the startup log
+    static std::string report();
+
+private:
+    static constexpr bool coversTag(MemoryTag tag) noexcept {
+        return tag == MemoryTag::World || tag == MemoryTag::Sessions;
+    }
+
+    static std::atomic<HugePageMode> s_mode;
+    static std::atomic<bool> s_used;   // Any block ever taken from the arena
+};
+
+// A std allocator that counts into a tag; copies and rebinds keep the tag
+template <typename T>
+class TrackedAllocator {
+public:
+    using value_type = T;
+
+    explicit TrackedAllocator(MemoryTag tag) noexcept : m_tag(tag) {}
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U>& other) noexcept : m_tag(other.tag()) {}
+
+    T* allocate(std::size_t count) {
+        void* arena = HugePages::covers(m_tag) ? HugePages::allocate(count * sizeof(T), alignof(T)) : nullptr;
+        T* block = arena ? static_cast<T*>(arena) : std::allocator<T>().allocate(count);
+        MemoryAccounting::allocated(m_tag, count * sizeof(T));
+        return block;
+    }
+    void deallocate(T* block, std::size_t count) noexcept {
+        MemoryAccounting::freed(m_tag, count * sizeof(T));
+        if (!HugePages::mayOwn(m_tag) || !HugePages::release(block, count * sizeof(T), alignof(T))) {
+            std::allocator<T>().deallocate(block, count);
+        }
+    }
+
+    MemoryTag tag() const noexcept { return m_tag; }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U>& other) const noexcept { return m_tag == other.tag(); }
+
+private:
+    MemoryTag m_tag;
+};
+
+// The same as a memory resource, for pmr containers; one per tag via of()
+class TrackedResource final : public std::pmr::memory_resource {
+public:
+    explicit TrackedResource(MemoryTag tag, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : m_tag(tag), m_upstream(upstream) {}
+
+    static TrackedResource& of(MemoryTag tag) noexcept;
+
+    MemoryTag tag() const noexcept { return m_tag; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* block = HugePages::covers(m_tag) ? HugePages::allocate(bytes, alignment) : nullptr;
+        if (!block) {
+            block = m_upstream->allocate(bytes, alignment);
+        }
+        MemoryAccounting::allocated(m_tag, bytes);
+        return block;
+    }
+    void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override {
+        MemoryAccounting::freed(m_tag, bytes);
+        if (!HugePages::mayOwn(m_tag) || !HugePages::release(block, bytes, alignment)) {
+            m_upstream->deallocate(block, bytes, alignment);
+        }
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    MemoryTag m_tag;
+    std::pmr::memory_resource* m_upstream;
+};
+
+// Frees a TrackedBuffer and takes its bytes off the tag
+struct TrackedBufferDelete {
+    MemoryTag tag = MemoryTag::Engine;
+    std::size_t size = 0;
+
+    void operator()(char* block) const noexcept {
+        MemoryAccounting::freed(tag, size);
+        if (!HugePages::mayOwn(tag) || !HugePages::release(block, size, alignof(std::max_align_t))) {
+            delete[] block;
+        }
+    }
+};
+
+// An uninitialised block of bytes counted against a tag while it lives
+using TrackedBuffer = std::unique_ptr<char[], TrackedBufferDelete>;
+
+inline TrackedBuffer makeTrackedBuffer(MemoryTag tag, std::size_t size) {
+    void* arena = HugePages::covers(tag) ? HugePages::allocate(size, alignof(std::max_align_t)) : nullptr;
+    TrackedBuffer buffer(arena ? static_cast<char*>(arena) : new char[size], TrackedBufferDelete{tag, size});
+    MemoryAccounting::allocated(tag, size);
+    return buffer;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+enum class MessageRecordKind : std::uint8_t {
+    Post,
+    Removal   // Takes back the post with its serial
+};
+
+// Precedes each record in a segment, which is a run of these, each padded
+// to 8 bytes. A record is its folder, then for a post the author, subject
+// and body
+struct MessageRecordHeader {
+    std::uint32_t size = 0;        // Of the text after the header
+    std::uint32_t checksum = 0;    // FNV-1a of that text
+    std::uint64_t serial = 0;      // From 1, one more for each post ever made
+    std::uint64_t postedAt = 0;    // Wall seconds
+    std::uint16_t folderSize = 0;
+    std::uint16_t authorSize = 0;
+    std::uint16_t subjectSize = 0;
+    MessageRecordKind kind = MessageRecordKind::Post;
+    std::uint8_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<MessageRecordHeader> && sizeof(MessageRecordHeader) == 32);
+
+// A post where it lies in its mapped segment; reading it parses nothing
+class MessageView {
+public:
+    explicit MessageView(const MessageRecordHeader* record) noexcept : m_record(record) {}
+
+    std::uint64_t serial() const noexcept { return m_record->serial; }
+    std::uint64_t postedAt() const noexcept { return m_record->postedAt; }
+    std::string_view folder() const noexcept { return {text(), m_record->folderSize}; }
+    std::string_view author() const noexcept { return {text() + m_record->folderSize, m_record->authorSize}; }
+    std::string_view subject() const noexcept {
+        return {text() + m_record->folderSize + m_record->authorSize, m_record->subjectSize};
+    }
+    std::string_view body() const noexcept {
+        const std::size_t before = std::size_t{m_record->folderSize} + m_record->authorSize + m_record->subjectSize;
+        return {text() + before, m_record->size - before};
+    }
+    // Its header and text, as a segment holds them, unpadded
+    std::size_t bytes() const noexcept { return sizeof(MessageRecordHeader) + m_record->size; }
+    const MessageRecordHeader* record() const noexcept { return m_record; }
+
+private:
+    const char* text() const noexcept { return reinterpret_cast<const char*>(m_record + 1); }
+
+    const MessageRecordHeader* m_record;
+};
+
+// Totals since the store was opened, but for the sizes, which are now
+struct MessageStats {
+    std::size_t posts = 0;
+    std::size_t folders = 0;
+    std::size_t segments = 0;
+    std::uint64_t liveBytes = 0;     // Of posts still listed
+    std::uint64_t deadBytes = 0;     // Of removed posts and removals, until compaction
+    std::uint64_t syncs = 0;
+    std::uint64_t compactions = 0;
+    std::uint64_t failed = 0;        // Writes or syncs the disk refused
+};
+
+/**
+ * Boards and mailboxes: folders of posts, kept in append-only segment files.
+ *
+ * Each segment is mapped once at its full size, and a post is written into
+ * it with pwrite(), so the mapping shows it straight away. A folder's
+ * index is the posts' headers in their segments, oldest first, so
+ * listing a board and reading a post are both pointer reads into the page
+ * cache. Nothing is copied and nothing is parsed.
+ *
+ * Writes are on the game thread, but syncs are not. A syncer thread
+ * fdatasync()s the segments written since it last looked, at most once
+ * an interval, so a burst of posts shares one sync, and a crash can lose
+ * the last interval's posts. On opening, each segment is read up to its
+ * first torn or damaged record, and the rest is cut off.
+ *
+ * remove() appends a removal record and drops the post from its folder.
+ * Once removed and dead records outweigh the live ones, the store compacts:
+ * it writes the live posts into new segments, syncs them itself, and only
+ * then deletes the old ones. A crash in between leaves both, and opening keeps
+ * the first copy of each serial.
+ *
+ * Everything but the syncer is the game thread's. Views, and the spans
+ * folder() returns, are good until the next post() or remove(), since
+ * either can grow a folder's index or compact.
+ */
+class MessageStore {
+public:
+    static constexpr std::size_t kSegmentBytes = std::size_t{8} << 20;
+    static constexpr std::chrono::milliseconds kDefaultSyncInterval{100};
+    static constexpr std::size_t kMaxText = 16 * 1024;   // Of a record's folder, author, subject and body
+
+    static std::expected<std::unique_ptr<MessageStore>, std::string> open(
+        const std::filesystem::path& directory, std::chrono::milliseconds syncInterval = kDefaultSyncInterval);
+
+    // Syncs whatever was written
+    ~MessageStore();
+
+    MessageStore(const MessageStore&) = delete;
+    MessageStore& operator=(const MessageStore&) = delete;
+
+    // A folder's posts, oldest first; empty for a folder never posted to
+    std::span<const MessageView> folder(std::string_view name) const;
+
+    // The new post's serial, or why it wasn't written
+    std::expected<std::uint64_t, std::string> post(std::string_view folder, std::string_view author,
+                                                   std::string_view subject, std::string_view body,
+                                                   std::uint64_t postedAt);
+    // Take back a folder's index-th post (oldest is 0); false if there is none
+    bool remove(std::string_view folder, std::size_t index);
+    // Rewrite the live posts into new segments, dropping what was removed
+    bool compact();
+
+    MessageStats stats() const;
+
+private:
+    struct Segment {
+        std::filesystem::path path;
+        std::uint32_t number = 0;
+        int fd = -1;
+        char* base = nullptr;       // Mapped for mapped bytes, written up to size
+        std::size_t mapped = 0;
+        std::size_t size = 0;
+    };
+
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+    };
+
+    MessageStore(std::filesystem::path directory, std::chrono::milliseconds syncInterval);
+
+    std::filesystem::path segmentPath(std::uint32_t number) const;
+    bool openSegment(std::uint32_t number);
+    bool load(std::uint32_t number, std::unordered_set<std::uint64_t>& seen);
+    void closeSegments(std::vector<Segment>& segments, bool erase);
+    const MessageRecordHeader* append(MessageRecordHeader header, std::span<const std::string_view> text);
+    void index(const MessageRecordHeader* record);
+    std::uint64_t writtenBytes() const noexcept;
+    void sync();
+
+    std::filesystem::path m_directory;
+    std::chrono::milliseconds m_syncInterval;
+    std::vector<Segment> m_segments;   // Oldest first; the last is written to
+    std::unordered_map<std::string, std::vector<MessageView>, Hash, std::equal_to<>> m_folders;
+    std::uint64_t m_nextSerial = 1;
+    std::uint64_t m_liveBytes = 0;     // Padded, as the segments hold them
+    std::uint64_t m_compactions = 0;
+    std::string m_record;              // Scratch, reused for every append
+
+    // Shared with the syncer, which syncs duplicates of the descriptors so
+    // that appends never wait for it; a segment leaves m_unsynced before it closes
+    mutable std::mutex m_syncMutex;
+    std::condition_variable m_syncWake;
+    std::vector<int> m_unsynced;
+    bool m_stopping = false;
+    std::uint64_t m_syncs = 0;
+    std::uint64_t m_failed = 0;
+
+    std::thread m_syncer;
+};
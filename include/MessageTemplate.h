@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "ReplyPool.h"
+
+// One run of a message template: literal text, or where an argument goes
+struct MessagePiece {
+    std::uint16_t begin = 0;     // Literal text: offset in the template
+    std::uint16_t length = 0;
+    std::int16_t argument = -1;  // Argument index, or -1 for literal text
+};
+
+namespace message_detail {
+
+inline constexpr std::size_t kMaxArguments = 16;
+
+struct Shape {
+    std::size_t pieces = 0;
+    std::size_t arguments = 0;
+    const char* error = nullptr;
+};
+
+// Splits text into pieces at its {} and {N} placeholders, with {{ and }} for
+// literal braces. Writes the pieces to out unless it is null; the same at
+// compile time as at load
+constexpr Shape parse(std::string_view text, MessagePiece* out) {
+    Shape shape;
+    std::size_t next = 0;   // Index of the next {}
+    const auto add = [&](MessagePiece piece) {
+        if (out) {
+            out[shape.pieces] = piece;
+        }
+        ++shape.pieces;
+    };
+    const auto literal = [&](std::size_t begin, std::size_t end) {
+        if (end > begin) {
+            add({static_cast<std::uint16_t>(begin), static_cast<std::uint16_t>(end - begin), -1});
+        }
+    };
+    if (text.size() > 0xffff) {
+        shape.error = "longer than 65535 bytes";
+        return shape;
+    }
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '}') {
+            if (i + 1 == text.size() || text[i + 1] != '}') {
+                shape.error = "a } without its {";
+                return shape;
+            }
+            literal(start, i + 1);   // One of the two
+            start = ++i + 1;
+            continue;
+        }
+        if (text[i] != '{') {
+            continue;
+        }
+        if (i + 1 < text.size() && text[i + 1] == '{') {
+            literal(start, i + 1);
+            start = ++i + 1;
+            continue;
+        }
+        literal(start, i);
+        std::size_t j = i + 1;
+        std::size_t index = 0;
+        for (; j < text.size() && text[j] >= '0' && text[j] <= '9' && index < kMaxArguments; ++j) {
+            index = index * 10 + static_cast<std::size_t>(text[j] - '0');
+        }
+        if (j == text.size() || text[j] != '}' || index >= kMaxArguments) {
+            shape.error = "a placeholder other than {} or {N} below 16";
+            return shape;
+        }
+        if (j == i + 1) {
+            index = next++;
+        }
+        add({0, 0, static_cast<std::int16_t>(index)});
+        shape.arguments = index + 1 > shape.arguments ? index + 1 : shape.arguments;
+        i = j;
+        start = j + 1;
+    }
+    literal(start, text.size());
+    return shape;
+}
+
+// Text as it is, numbers in decimal
+template <typename Out, typename T>
+void appendArgument(Out& out, const T& value) {
+    if constexpr (std::is_integral_v<T>) {
+        char digits[24];
+        const auto end = std::to_chars(digits, digits + sizeof digits, value).ptr;
+        out.append(digits, static_cast<std::size_t>(end - digits));
+    } else {
+        const std::string_view text(value);
+        out.append(text.data(), text.size());
+    }
+}
+
+template <typename Out, typename... Args>
+void render(Out& out, std::string_view text, std::span<const MessagePiece> pieces, const Args&... args) {
+    for (const MessagePiece& piece : pieces) {
+        if (piece.argument < 0) {
+            out.append(text.data() + piece.begin, piece.length);
+            continue;
+        }
+        std::size_t index = 0;
+        ((index++ == static_cast<std::size_t>(piece.argument) ? appendArgument(out, args) : void()), ...);
+    }
+}
+
+// A string literal as a template argument
+template <std::size_t N>
+struct Literal {
+    char text[N]{};
+    consteval Literal(const char (&value)[N]) {
+        for (std::size_t i = 0; i < N; ++i) {
+            text[i] = value[i];
+        }
+    }
+    constexpr std::string_view view() const { return {text, N - 1}; }
+};
+
+} // namespace message_detail
+
+/**
+ * A message whose template is split into literal text and placeholders at
+ * compile time, so sending it is a run of appends: nothing is parsed, and
+ * nothing is formatted into a string of its own first. Placeholders are {}
+ * or {N}; arguments are text, or integers written in decimal. A malformed
+ * template or the wrong number of arguments fails to compile.
+ *
+ *     Message<"You move {} into {}.">::reply(directionName(dir), roomName)
+ */
+template <message_detail::Literal Text>
+class Message {
+    static constexpr message_detail::Shape kShape = message_detail::parse(Text.view(), nullptr);
+    static_assert(kShape.error == nullptr, "Malformed message template");
+    static constexpr auto kPieces = [] {
+        std::array<MessagePiece, kShape.pieces> pieces{};
+        message_detail::parse(Text.view(), pieces.data());
+        return pieces;
+    }();
+
+public:
+    static constexpr std::size_t kArguments = kShape.arguments;
+
+    // At the end of out, anything with append(const char*, size)
+    template <typename Out, typename... Args>
+    static void append(Out& out, const Args&... args) {
+        static_assert(sizeof...(Args) == kArguments, "Wrong number of arguments for this message");
+        message_detail::render(out, Text.view(), kPieces, args...);
+    }
+
+    // In a recycled buffer, for a command's reply
+    template <typename... Args>
+    static std::string reply(const Args&... args) {
+        std::string text = ReplyPool::take();
+        append(text, args...);
+        return text;
+    }
+
+    // In memory, such as GameEngine::scratch(), for text copied on shortly
+    template <typename... Args>
+    static std::pmr::string in(std::pmr::memory_resource& memory, const Args&... args) {
+        std::pmr::string text(&memory);
+        append(text, args...);
+        return text;
+    }
+};
+
+/**
+ * The same for a template that comes as data, such as a builder's text in
+ * an area file: parsed once when it is loaded, then rendered like Message.
+ * Arguments come as text; one the template names but isn't given is left
+ * empty.
+ */
+class MessageTemplate {
+public:
+    static std::expected<MessageTemplate, std::string> parse(std::string text) {
+        MessageTemplate parsed;
+        const message_detail::Shape shape = message_detail::parse(text, nullptr);
+        if (shape.error) {
+            return std::unexpected(std::string(shape.error));
+        }
+        parsed.m_pieces.resize(shape.pieces);
+        message_detail::parse(text, parsed.m_pieces.data());
+        parsed.m_arguments = shape.arguments;
+        parsed.m_text = std::move(text);
+        return parsed;
+    }
+
+    std::size_t arguments() const noexcept { return m_arguments; }
+    std::string_view text() const noexcept { return m_text; }
+
+    template <typename Out>
+    void append(Out& out, std::span<const std::string_view> args) const {
+        for (const MessagePiece& piece : m_pieces) {
+            if (piece.argument < 0) {
+                out.append(m_text.data() + piece.begin, piece.length);
+            } else if (static_cast<std::size_t>(piece.argument) < args.size()) {
+                const std::string_view arg = args[static_cast<std::size_t>(piece.argument)];
+                out.append(arg.data(), arg.size());
+            }
+        }
+    }
+
+    std::string reply(std::span<const std::string_view> args) const {
+        std::string text = ReplyPool::take();
+        append(text, args);
+        return text;
+    }
+
+private:
+    MessageTemplate() = default;
+
+    std::string m_text;
+    std::vector<MessagePiece> m_pieces;
+    std::size_t m_arguments = 0;
+};
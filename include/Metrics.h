@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LatencyHistogram.h"
+
+// Engine-wide counters and gauges, summed over every thread's shard
+enum class Metric : std::uint8_t {
+    Sessions,             // Gauge: connections open
+    SessionsOpened,
+    SessionsRefused,      // Banned addresses, and addresses at their connection limit
+    OutputChunks,         // Gauge: output pool chunks holding queued bytes
+    OutputPoolBytes,      // Gauge: slabs the output pools have allocated
+    OutputDroppedBytes,   // Discarded past a session's high-water mark
+    SessionsCompacted,    // Idle sessions whose buffers were let go
+    TextsWrapped,         // Output wrapped to a client's NAWS width
+    Ticks,
+    TickOverruns,
+    CommandsRun,
+    CommandsDeferred,
+    CommandsDropped,
+    CommandsThrottled,
+    LoadStage,            // Gauge: the scheduler's LoadStage, 0 when not shedding work
+    TicksDeferring,
+    TicksThrottling,
+    LuaMemoryBytes,       // Gauge
+    LuaMemoryPeakBytes,   // Gauge
+    Count
+};
+
+// The queue delays are in CommandPriority order
+enum class MetricHistogram : std::uint8_t { TickDuration, QueueDelayUrgent, QueueDelayNormal, QueueDelayBulk, Count };
+
+inline constexpr std::size_t kMetricCount = static_cast<std::size_t>(Metric::Count);
+inline constexpr std::size_t kMetricHistogramCount = static_cast<std::size_t>(MetricHistogram::Count);
+
+/**
+ * One thread's metrics. Only its own thread writes to it, so a counter is
+ * bumped with a relaxed load and store rather than a locked add, and no two
+ * threads ever write the same cache line; a scrape reads every shard's
+ * values as they stand and sums them.
+ */
+class alignas(64) MetricsShard {
+public:
+    void add(Metric metric, std::uint64_t amount = 1) noexcept {
+        std::atomic<std::uint64_t>& value = m_values[static_cast<std::size_t>(metric)];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+    // For gauges, and for totals the owning thread already keeps
+    void set(Metric metric, std::uint64_t value) noexcept {
+        m_values[static_cast<std::size_t>(metric)].store(value, std::memory_order_relaxed);
+    }
+    std::uint64_t value(Metric metric) const noexcept {
+        return m_values[static_cast<std::size_t>(metric)].load(std::memory_order_relaxed);
+    }
+
+    LatencyHistogram& histogram(MetricHistogram histogram) noexcept {
+        return m_histograms[static_cast<std::size_t>(histogram)];
+    }
+    const LatencyHistogram& histogram(MetricHistogram histogram) const noexcept {
+        return m_histograms[static_cast<std::size_t>(histogram)];
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, kMetricCount> m_values{};
+    std::array<LatencyHistogram, kMetricHistogramCount> m_histograms;
+};
+
+/**
+ * The process's metrics, for the Prometheus endpoint (see MetricsServer).
+ *
+ * Each thread records into a shard of its own, made the first time it
+ * asks for local(); recording never locks and never allocates. Only a
+ * scrape does any work: it sums the shards, runs the collectors modules
+ * registered for metrics they keep themselves (such as the engine's
+ * per-command ones) and renders it all as OpenMetrics text. Shards outlive
+ * their threads, so counters never go backwards; a gauge keeps the last
+ * value its thread set.
+ */
+class Metrics {
+public:
+    // Appends whole metric families, in the exposition format, to a scrape
+    using Collector = std::function<void(std::string&)>;
+
+    static Metrics& instance();
+    static MetricsShard& local() {
+        thread_local MetricsShard& shard = instance().addShard();
+        return shard;
+    }
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    // Returns an id for removeCollector(), which waits for a scrape using it
+    std::uint64_t addCollector(Collector collector);
+    void removeCollector(std::uint64_t id);
+
+    // Everything, as OpenMetrics text ending in # EOF
+    std::string scrape() const;
+
+    // One metric summed over the shards, as a scrape reports it, for readers
+    // that want a few values often (such as the console's status bar)
+    std::uint64_t total(Metric metric) const;
+    // Add every shard's records of histogram to into
+    void mergeInto(MetricHistogram histogram, LatencyHistogram& into) const;
+
+    // Exposition helpers for collectors. A family's TYPE and HELP lines
+    static void family(std::string& out, std::string_view name, std::string_view type, std::string_view help);
+    // key="value", the value escaped as the format requires
+    static std::string label(std::string_view key, std::string_view value);
+    // One sample line; value is formatted without trailing zeros
+    static void sample(std::string& out, std::string_view name, std::string_view labels, double value);
+    // A summary's samples: quantiles, sum and count of a latency histogram, in seconds
+    static void summary(std::string& out, std::string_view name, std::string_view labels,
+                        const LatencyHistogram& histogram);
+
+private:
+    Metrics() = default;
+
+    MetricsShard& addShard();
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<MetricsShard>> m_shards;
+    std::vector<std::pair<std::uint64_t, Collector>> m_collectors;
+    std::uint64_t m_nextCollector = 1;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <thread>
+#include "NetReactor.h"
+
+/**
+ * HTTP endpoint Prometheus scrapes: GET /metrics answers with
+ * Metrics::instance().scrape() as OpenMetrics text; anything else is a 404.
+ *
+ * It has a thread of its own and serves one short request at a time, so a
+ * scrape costs the game and the reactors nothing beyond the shards they
+ * keep anyway. A client gets a few seconds to send its request before it
+ * is dropped.
+ */
+class MetricsServer {
+public:
+    static std::expected<std::unique_ptr<MetricsServer>, NetError> start(const std::string& address,
+                                                                        std::uint16_t port);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    std::uint64_t scrapes() const noexcept { return m_scrapes.load(std::memory_order_relaxed); }
+
+private:
+    MetricsServer() = default;
+
+    void run();
+    void serve(int fd);
+
+    int m_listenFd = -1;
+    int m_wakeFds[2] = {-1, -1};   // Written to stop the thread
+    std::atomic<std::uint64_t> m_scrapes{0};
+    std::thread m_thread;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * Unbounded lock-free multi-producer, single-consumer queue.
+ *
+ * Producers link a new node in with a single atomic exchange, so push()
+ * never waits on the consumer or on other producers. The consumer owns the
+ * tail and is the only caller of pop(). Based on Dmitry Vyukov's intrusive
+ * MPSC queue, with a stub node so the list is never empty.
+ *
+ * A producer preempted between its exchange and its link leaves the
+ * elements behind it invisible until it resumes; pop() then reports the
+ * queue as empty rather than blocking.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+    ~MpscQueue() {
+        while (pop()) {
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread
+    void push(T value) {
+        Node* node = new Node{std::move(value)};
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer thread only
+    std::optional<T> pop() {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return std::nullopt;
+        }
+
+        // next becomes the new stub; its value moves out and the old stub goes
+        m_tail = next;
+        std::optional<T> value(std::move(*next->value));
+        next->value.reset();
+        if (tail != &m_stub) {
+            delete tail;
+        }
+        return value;
+    }
+
+    // Consumer thread only; a hint, since producers may be mid-push
+    bool empty() const {
+        return m_tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T&& v) : value(std::move(v)) {}
+
+        std::optional<T> value;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    Node m_stub;
+    std::atomic<Node*> m_head;   // Most recently pushed node; producers swap it
+    Node* m_tail;                // Current stub; consumer only
+};
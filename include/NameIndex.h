@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include "GameWorld.h"
+#include "StringInterner.h"
+
+/**
+ * Who is online under which name, for tell and finger, safe to read from
+ * any thread while the game thread adds and removes players.
+ *
+ * Keys are the interned, case-folded names PlayerRegistry already keeps
+ * (PlayerRegistry::nameKey), so a lookup folds the typed name, finds its
+ * symbol without interning it and probes one of 16 shards under a shared
+ * lock; a name nobody ever had is refused before any lock. The shard is
+ * picked by the symbol's low bits, which are handed out in sequence and
+ * so spread evenly.
+ */
+class NameIndex {
+public:
+    void insert(Symbol key, PlayerId player);
+    // Only while key still names player, so a later login under the name stays
+    void erase(Symbol key, PlayerId player);
+
+    PlayerId find(Symbol key) const;
+    PlayerId find(std::string_view name) const;
+
+    std::size_t size() const;
+    void clear();
+
+private:
+    static constexpr unsigned kShardBits = 4;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Symbol, PlayerId> players;
+    };
+
+    Shard& shard(Symbol key) noexcept { return m_shards[key & (m_shards.size() - 1)]; }
+    const Shard& shard(Symbol key) const noexcept { return m_shards[key & (m_shards.size() - 1)]; }
+
+    std::array<Shard, std::size_t{1} << kShardBits> m_shards;
+};
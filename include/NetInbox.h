@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <unistd.h>
+#include <fcntl.h>
+#include "MpscQueue.h"
+
+/**
+ * Lock-free queue between network threads, with a descriptor the consumer's
+ * poller can wait on.
+ *
+ * push() writes a byte to a self-pipe only when the consumer has not been
+ * signalled since its last drain(), so a burst of batches costs one wakeup.
+ * drain() clears the signal before popping: a push that lands afterwards
+ * signals again and the consumer's next wait returns at once.
+ */
+template <typename T>
+class NetInbox {
+public:
+    NetInbox() = default;
+
+    ~NetInbox() {
+        for (int fd : m_pipe) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    NetInbox(const NetInbox&) = delete;
+    NetInbox& operator=(const NetInbox&) = delete;
+
+    // Create the self-pipe; false if the process is out of descriptors
+    bool open() {
+        if (pipe(m_pipe.data()) != 0) {
+            return false;
+        }
+        for (int fd : m_pipe) {
+            const int flags = fcntl(fd, F_GETFL, 0);
+            if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Readable when batches are waiting
+    int fd() const noexcept { return m_pipe[0]; }
+
+    // Any thread
+    void push(T batch) {
+        m_queue.push(std::move(batch));
+        if (!m_signalled.exchange(true, std::memory_order_acq_rel)) {
+            wake();
+        }
+    }
+
+    // Any thread, including a signal handler: make the consumer's wait return
+    void wake() noexcept {
+        const char byte = 0;
+        [[maybe_unused]] const auto written = write(m_pipe[1], &byte, 1);
+    }
+
+    // Consumer thread only: call fn with each waiting batch in order
+    template <typename Fn>
+    void drain(Fn&& fn) {
+        m_signalled.store(false, std::memory_order_seq_cst);
+        char bytes[64];
+        while (read(m_pipe[0], bytes, sizeof(bytes)) > 0) {
+        }
+        while (auto batch = m_queue.pop()) {
+            fn(std::move(*batch));
+        }
+    }
+
+private:
+    MpscQueue<T> m_queue;
+    std::array<int, 2> m_pipe{-1, -1};
+    std::atomic<bool> m_signalled{false};
+};
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "ChunkPool.h"
+#include "IoUring.h"
+#include "NetInbox.h"
+#include "ObjectPool.h"
+#include "Rcu.h"
+#include "SharedMessage.h"
+#include "TelnetParser.h"
+#include "TextWrap.h"
+#include "WebSocket.h"
+#if defined(ENABLE_MCCP)
+#include "MccpStream.h"
+#endif
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+#include "WebSocketDeflate.h"
+#endif
+#if defined(ENABLE_TLS)
+#include "TlsStream.h"
+#endif
+
+class MetricsShard;
+class AccessControl;
+struct ServerConfig;
+
+// Error codes for NetServer::create
+enum class NetError {
+    SOCKET_FAILED,
+    BIND_FAILED,
+    LISTEN_FAILED,
+    POLLER_FAILED,
+    COPYOVER_FAILED,
+    TLS_FAILED,
+    CONFIG_FAILED,
+    DATABASE_FAILED
+};
+
+// A connection as the game thread names it. Descriptors are reused, so the
+// serial, unique within its reactor, tells a new connection from an old one
+struct ConnectionId {
+    std::uint64_t serial = 0;
+    int fd = -1;
+    std::uint16_t reactor = 0;
+
+    std::uint64_t key() const noexcept { return (static_cast<std::uint64_t>(reactor) << 48) | serial; }
+};
+
+// Reactor to game thread
+struct NetInput {
+    // OptionOn and OptionOff report the client's DO or DONT for GMCP or MSDP;
+    // Subnegotiation carries what it sent for one of them. WindowSize carries
+    // the rows of a NAWS report in option's stead, as NetServer pages by them
+    enum class Kind : std::uint8_t { Opened, Line, Closed, OptionOn, OptionOff, Subnegotiation, WindowSize };
+
+    Kind kind;
+    ConnectionId connection;
+    std::string line;            // Telnet stripped, without the line break; or the payload; or
+                                 // for Opened, the client's address, empty if not known
+    unsigned char option = 0;    // Telnet option of OptionOn, OptionOff and Subnegotiation
+    std::uint16_t rows = 0;      // WindowSize's height; 0 when the client does not know it
+};
+
+// Game thread to reactor
+struct NetOutput {
+    ConnectionId connection;
+    std::string raw;    // Telnet protocol bytes (GMCP, MSDP), sent as they are ahead of text
+    std::string text;   // Plain text; the reactor converts line breaks and escapes IAC
+    SharedMessage line; // Sent as a line after text; encoded once however many connections get it
+    bool close = false; // Close once text is written
+};
+
+// What happens to a session whose unsent output passes the high-water mark
+enum class SlowClientPolicy : std::uint8_t {
+    DropOutput,   // Discard whole messages until it catches up, then say how much was lost
+    Disconnect    // Close the connection
+};
+
+// Session output compressed with MCCP2: what it was before and what was sent
+struct CompressionStats {
+    std::uint64_t bytesIn = 0;
+    std::uint64_t bytesOut = 0;
+};
+
+using NetInputBatch = std::vector<NetInput>;
+using NetOutputBatch = std::vector<NetOutput>;
+
+// A telnet session a reactor let go of, still open, for a new process to adopt
+struct HandedSession {
+    ConnectionId connection;
+    std::string line;          // Typed since the last line break
+    bool compressed = false;   // MCCP2 was on; the stream was ended, but the client's DO stands
+    std::uint16_t width = 0;   // From NAWS; 0 for none
+};
+
+// What NetReactor::handOver leaves: its listening sockets (see
+// NetReactor::Config::listenFds) and the sessions it no longer serves
+struct ReactorHandover {
+    std::array<int, 2> listenFds{-1, -1};
+    std::vector<HandedSession> sessions;
+};
+
+/**
+ * One network thread serving its share of the telnet connections.
+ *
+ * Each reactor has its own listening socket bound with SO_REUSEPORT, so the
+ * kernel spreads new connections across reactors and a connection stays on
+ * the reactor (and core) that accepted it. Sockets wait in the reactor's own
+ * epoll (Linux) or kqueue (BSD/macOS) set, so an idle connection costs a
+ * little memory and no CPU. The reactor parses telnet (see TelnetParser),
+ * assembles lines with backspace handling as the console editor does, and
+ * posts them, along with the client's GMCP and MSDP requests,
+ * to the game thread's inbox, one batch per loop iteration; it never touches
+ * the game state. Output comes back through the reactor's own inbox and is
+ * queued per session in chunks from the reactor's pool until the socket
+ * takes it, all of them in one sendmsg where the socket has room. A client
+ * that stops reading is held to a high-water mark (see SlowClientPolicy), so
+ * it can neither grow memory without limit nor hold up anyone else.
+ *
+ * Telnet clients are asked for their width (NAWS, RFC 1073) and text sent
+ * to one that reports it is word wrapped to fit. A shared line is wrapped
+ * once per width among the sessions of a batch, not once per session, and
+ * each width's wrapping is encoded once and linked into every session of
+ * that width, so a room of players on a few common widths costs a few wraps.
+ *
+ * Sessions live in a vector by descriptor and keep their line buffer from
+ * one connection to the next; their WebSocket and MCCP2 states come from
+ * per-reactor ObjectPools, so connection churn reuses memory rather than
+ * allocating each connection afresh.
+ *
+ * A session that has neither sent nor been sent anything for
+ * Config::idleCompaction is compacted by a sweep on the reactor's thread:
+ * its line buffer is shrunk and its MCCP2 stream, by far the largest thing
+ * a session holds, is ended and given back. The next input or output
+ * rehydrates it, starting a fresh stream, as MCCP2 lets a server do at any
+ * time, so a near-empty server of idle players holds almost nothing.
+ *
+ * Built with zlib (ENABLE_MCCP), the reactor offers MCCP2 to every client.
+ * A session that accepts has its output staged as it is queued and
+ * deflated at each flush, on the reactor's thread, so the game thread never
+ * compresses anything and a broadcast is still shared up to the point
+ * where each recipient's stream diverges.
+ *
+ * Built with OpenSSL (ENABLE_TLS), a TlsAcceptor hands the reactor telnet
+ * sessions whose handshake it has done, through attach(). Kernel TLS
+ * leaves the reactor plain text to read and write; whatever the kernel did
+ * not take is staged and sealed at each flush, as MCCP2 output is deflated.
+ *
+ * With a WebSocket port configured, each reactor listens on it as well.
+ * Browser sessions are upgraded and framed by WebSocket and then join the
+ * same line handling, output chains and high-water mark as telnet ones;
+ * a shared line is framed (and, with permessage-deflate, compressed) once
+ * per batch for all browser sessions alike, just as it is encoded once for
+ * the telnet ones.
+ *
+ * On Linux 6.0 and later the reactor set is replaced by io_uring: one
+ * multishot accept, one multishot receive per session reading into
+ * kernel-selected provided buffers, and zero-copy sends straight from the
+ * output chunks, whose slabs are registered with the ring. Everything a loop
+ * iteration queues is submitted with the wait for the next completions, so a
+ * broadcast to a full room costs one system call rather than one per
+ * recipient.
+ */
+class NetReactor {
+public:
+    struct Config {
+        std::string address;
+        std::uint16_t port = 0;
+        bool useIoUring = true;
+        SlowClientPolicy slowClients = SlowClientPolicy::DropOutput;
+        std::size_t outputHighWater = 64 * 1024;   // Unsent bytes per session
+        bool compression = true;                   // Offer MCCP2 and permessage-deflate, where built with zlib
+        std::uint16_t webSocketPort = 0;           // Browser clients; 0 for none
+        std::chrono::seconds idleCompaction{300};  // Quiet this long, a session is compacted; 0 never
+        // Where newer values of the three above are published; null to keep these
+        const RcuPointer<ServerConfig>* tuning = nullptr;
+        // Asked about each connection before it is given a session; null to admit all
+        AccessControl* access = nullptr;
+        std::uint32_t connectionsPerIp = 0;        // Open at once from one address; 0 for no limit
+        // Listening sockets inherited from the process this one replaced,
+        // served instead of binding new ones; -1 for none
+        std::array<int, 2> listenFds{-1, -1};
+    };
+
+    static std::expected<std::unique_ptr<NetReactor>, NetError> create(std::uint16_t index, NetInbox<NetInputBatch>& game,
+                                                                      const Config& config);
+
+    ~NetReactor();
+
+    // The reactor set, ring and sessions are keyed by descriptor, so the reactor stays put
+    NetReactor(const NetReactor&) = delete;
+    NetReactor& operator=(const NetReactor&) = delete;
+
+    // Run on a thread of its own, pinned to core when that is not negative
+    void start(int core);
+
+    // Stops and joins the thread
+    void stop();
+
+    // Stop, then end every telnet session's MCCP2 stream, close browser
+    // sessions with "service restart" and write out what is queued, until
+    // deadline at the latest. Nothing more is read or accepted: what clients
+    // send waits in the kernel for the next process. Lines read on the way
+    // out are posted to the game inbox. The listeners and the sessions
+    // still open are given up, left open for the next process
+    ReactorHandover handOver(std::chrono::steady_clock::time_point deadline);
+
+    // Serve a telnet session another process handed over, before start();
+    // no Opened is posted. width is what its client last reported with NAWS
+    ConnectionId adopt(int fd, std::string line, bool compressed, std::uint16_t width);
+
+#if defined(ENABLE_TLS)
+    // Any thread: serve a telnet session whose TLS handshake is done, from
+    // the next loop iteration; tls is nullptr when the kernel has all of it
+    void attach(int fd, std::unique_ptr<TlsStream> tls);
+#endif
+
+    // Any thread
+    NetInbox<NetOutputBatch>& inbox() noexcept { return m_inbox; }
+    std::size_t sessionCount() const noexcept { return m_sessionCount.load(std::memory_order_relaxed); }
+    bool usingIoUring() const noexcept;
+    CompressionStats compression() const noexcept;
+
+private:
+    static constexpr std::size_t kMaxSendSegments = 64;   // 128 KiB of chunks per sendmsg
+    static constexpr std::size_t kTelnetListener = 0;
+    static constexpr std::size_t kWebSocketListener = 1;
+    // Free objects a reactor keeps for new sessions; an MCCP2 stream holds about 30 KiB
+    static constexpr std::size_t kPooledWebSockets = 1024;
+    static constexpr std::size_t kPooledStreams = 256;
+    static constexpr std::chrono::seconds kLongestSweep{30};   // Between looks for idle sessions
+
+    // How a session's text is put on the wire; shared lines are encoded once per kind
+    enum class Encoding : std::uint8_t { Telnet, WebSocket, WebSocketDeflate, Count };
+
+    struct Session {
+        std::string line;              // Input since the last line break
+        ChunkChain output;             // Queued for the socket, in m_output
+        std::uint64_t serial = 0;
+        std::uint64_t peerTicket = 0;  // Its address's place in the per-address counts; 0 if not counted
+        TelnetParser telnet;
+        ObjectPool<WebSocket>::Handle webSocket;   // Browser sessions only; they skip the telnet parser
+        bool open = false;
+        bool afterCr = false;          // A NUL or LF completing CR LF is skipped
+        bool overlong = false;         // Rest of the current line is dropped
+        bool closing = false;          // Close once output is written
+        bool dropped = false;          // Too far behind; close without writing
+        bool dirty = false;            // Listed in m_dirty
+        bool writeWatched = false;     // Reactor reports writability
+        std::size_t droppedBytes = 0;  // Output discarded past the high-water mark
+        bool secure = false;           // Over TLS, which is offered no MCCP2
+        bool compacted = false;        // Idle; see compact()
+        std::uint16_t width = 0;       // Columns from NAWS to wrap text to; 0 for none
+        std::chrono::steady_clock::time_point active{};   // Last input or output
+        // MCCP2 or userspace TLS: output is queued here and deflated or
+        // sealed into output at each flush
+        ChunkChain staged;
+#if defined(ENABLE_MCCP)
+        ObjectPool<MccpStream>::Handle compressor;
+        bool resumeCompression = false;   // Compacted with a stream; one starts with the next output
+#endif
+#if defined(ENABLE_TLS)
+        std::unique_ptr<TlsStream> tls;   // What the kernel does not do of the session's TLS
+#endif
+
+        // io_uring: the descriptor is closed only once no operation refers to it
+        bool sendInFlight = false;
+        bool draining = false;         // Closed; waiting for pendingOps to finish
+        std::int32_t sendResult = 0;   // Applied once a zero-copy send releases its chunk
+        std::uint8_t pendingOps = 0;
+    };
+
+    struct PollEvent {
+        int fd;
+        bool readable;   // Also set on errors and hangups, which the read then reports
+        bool writable;
+    };
+
+    NetReactor(std::uint16_t index, NetInbox<NetInputBatch>& game, const Config& config);
+
+    void run();
+    void applyTuning();
+    void applyOutput(NetOutputBatch& batch);
+
+    // Reactor set (epoll or kqueue)
+    bool watch(int fd);
+    bool watchListeners();
+    void watchWrites(int fd, bool enable);
+    void unwatch(int fd);
+    void poll(int timeoutMs);
+
+#if defined(__linux__)
+    // io_uring backend. Operations carry (Op << 32) | fd as their user data
+    enum class Op : std::uint32_t { Accept = 1, Receive, Send, Wake, Cancel };
+    static constexpr std::uint64_t tag(Op op, int fd) {
+        return (static_cast<std::uint64_t>(op) << 32) | static_cast<std::uint32_t>(fd);
+    }
+
+    // A multi-chunk send, kept until the ring is submitted
+    struct SendMessage {
+        msghdr header{};
+        std::array<iovec, kMaxSendSegments> segments;
+    };
+
+    void armAccepts();
+    void armReceive(int fd, Session& session);
+    void armWake();
+    void submitSend(int fd, Session& session);
+    void waitRing(int timeoutMs);
+    void complete(const IoUring::Completion& completion);
+    void completeReceive(int fd, const IoUring::Completion& completion);
+    void completeSend(int fd, const IoUring::Completion& completion);
+    void finishClose(int fd);
+#endif
+
+    void acceptConnections(int listenFd);
+    void openSession(int fd, bool webSocket);
+    Session* beginSession(int fd);
+    static void recycleSession(Session& session);
+    void greet(Session& session, int fd);
+    void refuse(int fd, std::string_view reason);
+    void closeSession(int fd);
+    void readFrom(int fd);
+    bool feed(int fd, std::string_view bytes);
+    bool receiveData(int fd, char ch);
+    bool negotiate(int fd, unsigned char verb, unsigned char option);
+    bool subnegotiate(int fd, unsigned char option, std::string_view payload);
+    bool feedWebSocket(int fd, std::string_view bytes);
+    bool receiveMessage(int fd, std::string_view payload);
+    void endLine(int fd);
+    void post(NetInput::Kind kind, int fd, std::string line = {}, unsigned char option = 0);
+
+    // Queue text for a session: line breaks become CR LF and IAC bytes are
+    // escaped. queueRaw sends protocol bytes as they are
+    void queue(Session& session, int fd, std::string_view text);
+    void queueRaw(Session& session, int fd, std::string_view bytes);
+    void queueLine(Session& session, int fd, const std::string& line);
+    std::string_view wrapped(const Session& session, std::string_view text, const TextMetrics& metrics);
+    bool encode(ChunkChain& chain, std::string_view text);
+    bool frame(ChunkChain& chain, std::string_view text, std::string_view end, bool deflate);
+    void sendControl(Session& session, int fd, WebSocket::Opcode opcode, std::string_view payload);
+    void sendClose(Session& session, int fd, std::uint16_t code);
+    void closeWhenSent(Session& session, int fd);
+    static Encoding encodingOf(const Session& session) noexcept;
+    void queued(Session& session, int fd, bool fitted);
+    bool admit(Session& session, int fd, std::size_t bytes);
+    ChunkChain& sink(Session& session) noexcept;
+    std::size_t pending(const Session& session) const noexcept;
+    void resumeOutput(Session& session, int fd);
+    void flush(int fd);
+
+    // Idle sessions: compacted by a sweep every so often, rehydrated by the
+    // next input or output
+    int sweepTimeout() const noexcept;
+    void sweepIdle();
+    void compact(Session& session, int fd);
+    void touch(Session& session, int fd);
+
+#if defined(ENABLE_MCCP)
+    void startCompression(Session& session, int fd);
+    void compressOutput(Session& session, int fd, bool finish);
+    void endCompression(Session& session, int fd);
+#endif
+#if defined(ENABLE_TLS)
+    void attachSessions();
+    void encryptOutput(Session& session, int fd);
+#endif
+
+    std::uint16_t m_index;
+    Config m_config;
+    std::uint64_t m_tuningGeneration = 0;   // Of the tuning last copied into m_config
+    NetInbox<NetInputBatch>& m_game;
+    NetInbox<NetOutputBatch> m_inbox;       // Its descriptor also wakes the loop for stop()
+    ChunkPool m_output;                     // Every session's queued output
+    std::array<int, 2> m_listenFds{-1, -1};   // Telnet, then WebSocket if configured
+    int m_pollFd = -1;
+    std::atomic<bool> m_stopRequested{false};
+    bool m_acceptPaused = false;            // Out of descriptors; resumed when a session closes
+    bool m_handingOver = false;             // In handOver(): cancelled receives are not an error
+    std::thread m_thread;
+
+    // Before m_sessions, whose handles give their objects back as they go
+    ObjectPool<WebSocket> m_webSockets{kPooledWebSockets};
+#if defined(ENABLE_MCCP)
+    ObjectPool<MccpStream> m_mccpStreams{kPooledStreams};
+#endif
+    std::vector<Session> m_sessions;        // Indexed by socket descriptor
+    std::uint64_t m_nextSerial = 1;
+    std::atomic<std::size_t> m_sessionCount{0};
+    MetricsShard* m_metrics = nullptr;      // The reactor thread's, once it runs
+
+    std::vector<int> m_dirty;               // Sessions with output to write
+    std::chrono::steady_clock::time_point m_now;         // Since the last wait, for idle times
+    std::chrono::steady_clock::time_point m_nextSweep;
+    std::vector<PollEvent> m_events;
+    NetInputBatch m_posted;                 // For the game thread, sent once per iteration
+
+    // Shared lines of the batch being applied, encoded once each per
+    // Encoding and wrap width into m_sharedLines and linked from there into
+    // their sessions' chains; a size of 0 is an encoding not made yet. The
+    // unwrapped entry, width 0, also holds the line's measurements
+    struct EncodedSpan {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+    struct EncodedLine {
+        std::array<EncodedSpan, static_cast<std::size_t>(Encoding::Count)> spans{};
+        TextMetrics metrics;
+        bool measured = false;
+    };
+    struct LineKey {
+        const std::string* line;
+        std::uint16_t width;
+        bool operator==(const LineKey&) const = default;
+    };
+    struct LineKeyHash {
+        std::size_t operator()(const LineKey& key) const noexcept {
+            return std::hash<const std::string*>{}(key.line) ^ (std::size_t{key.width} * 0x9E3779B97F4A7C15ull);
+        }
+    };
+    ChunkChain m_sharedLines;
+    std::unordered_map<LineKey, EncodedLine, LineKeyHash> m_encodedLines;
+    std::string m_wrapped;                  // Text wrapped to a session's width, before encoding
+    std::vector<WrapSpan> m_wrapRows;
+
+    std::string m_compressed;               // Deflate output on its way into a session's chain
+    std::string m_frameText;                // A WebSocket message being framed
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+    std::unique_ptr<WebSocketDeflater> m_deflater;   // Every WebSocket message, each on its own
+#endif
+    std::atomic<std::uint64_t> m_compressedIn{0};
+    std::atomic<std::uint64_t> m_compressedOut{0};
+    std::vector<char> m_readBuffer;
+
+#if defined(ENABLE_TLS)
+    struct Attaching {
+        int fd;
+        std::unique_ptr<TlsStream> tls;
+    };
+    std::mutex m_attachMutex;
+    std::vector<Attaching> m_attaching;     // Under m_attachMutex, opened at the top of the loop
+    std::vector<Attaching> m_attached;      // Taken from m_attaching
+    std::string m_decrypted;                // A read's plain text on its way to the telnet parser
+    std::string m_encrypted;                // Records on their way into a session's chain
+#endif
+
+#if defined(__linux__)
+    // Declared after m_output so it goes first, releasing the registered slabs
+    std::unique_ptr<IoUring> m_ring;
+    std::vector<bool> m_fixedSlabs;         // Output slabs registered with m_ring
+    std::deque<SendMessage> m_sendMessages; // Submitted this iteration; a deque keeps them in place
+    bool m_zeroCopy = true;                 // Cleared if the socket type refuses it
+    std::array<bool, 2> m_acceptArmed{};
+#endif
+};
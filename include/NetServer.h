@@ -0,0 +1,382 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Checkpointer.h"
+#include "Copyover.h"
+#include "GameEngine.h"
+#include "HostResolver.h"
+#include "Journal.h"
+#include "LoginPool.h"
+#include "MemoryAccounting.h"
+#include "MetricsServer.h"
+#include "AccessList.h"
+#include "AdminServer.h"
+#include "ApiServer.h"
+#include "NetReactor.h"
+#include "ObjectPool.h"
+#include "OutOfBand.h"
+#include "SaveWriter.h"
+#include "ServerConfig.h"
+#include "SessionRecorder.h"
+#include "StateSegment.h"
+#include "ShardLink.h"
+#include "ThreadTopology.h"
+#include "TlsAcceptor.h"
+#include "Watchdog.h"
+
+/**
+ * Telnet front end serving many players from several network threads.
+ *
+ * Connections are spread over NetReactor threads, each with its own
+ * listening socket, sessions and output buffers (see NetReactor). The thread
+ * that calls run() is the only one touching the game: it takes the lines
+ * the reactors post to its inbox and queues them on the engine's
+ * TickScheduler, which hands each connection one line per tick to log the
+ * player in or run through GameEngine::handleCommand; what they produce is
+ * sent back to the reactor owning each recipient, one batch per reactor per
+ * iteration.
+ * Messages between players are routed through takeRecipients(), so a say
+ * into a room whose occupants sit on other reactors costs one inbox push
+ * per reactor rather than any locking. The text itself is never copied on
+ * the way: the engine formats it once, every recipient's output names the
+ * same SharedMessage, and each reactor encodes it once for all of its
+ * sessions.
+ *
+ * Clients that agree to GMCP or MSDP get their character and room as
+ * structured data (see OutOfBand), refreshed after each of their commands;
+ * the players in a room are refreshed once per iteration for every such
+ * client in a room someone entered or left.
+ *
+ * With an account directory, logging in takes a password as well as a name.
+ * The game thread only collects them: a LoginPool hashes and checks them on
+ * its own threads and posts the outcome to a second inbox this thread polls
+ * with the first. Logins past what the pool will hold wait in an admission
+ * line, told their place when they join it and every few seconds after,
+ * so a reconnect storm costs the game nothing but queue bookkeeping.
+ * Players are saved there too: those the engine marks changed are
+ * snapshotted once a save interval and handed to a SaveWriter, which
+ * writes them on its own thread, and a player who leaves is saved at once.
+ * With a journal as well, every changed player is also appended to a
+ * Journal (beside the accounts) as it changes, each pass, so a crash loses
+ * nothing older than the journal's last sync rather than a save interval;
+ * the next start writes whatever the journal holds newer than a save over
+ * it before anyone logs in, and records go once the saves after them land.
+ * With a state segment too, every journaled image is also kept in a named
+ * shared-memory StateSegment; a start after a crash that finds it whole,
+ * and left by the run the journal directory names, takes the images from
+ * it and skips reading the journal back, falling back to the journal when
+ * it is not.
+ *
+ * With a checkpoint file the whole world is snapshotted every checkpoint
+ * interval and a Checkpointer writes it out on its own thread.
+ *
+ * With a recording directory, a SessionRecorder there records every tick
+ * and what each player did, for mud_replay to play back.
+ *
+ * requestCopyover() ends run() the way requestStop() does, except that
+ * the connections outlive it: the reactors write out what they have queued
+ * and let go of their sockets, everyone is saved as at a shutdown, and
+ * handover() holds what the next process needs to carry on (see Copyover).
+ * A server created from that state serves the same sockets: players keep
+ * their characters, prompts, GMCP or MSDP subscriptions and the lines they
+ * had queued, and never see the connection drop.
+ *
+ * With a shard port the server is one shard of a world split by zone (see
+ * ShardMap), and a gateway (mud_gateway) holding the players' telnet
+ * connections links to it there. Each gateway session is a connection like
+ * any other, kept in m_pending's slot past the reactors' and sent back as
+ * Output frames. A player walking into a zone another shard owns is saved,
+ * taken out of this world and handed to the gateway as a PlayerSave image,
+ * which the gateway attaches to the owning shard; channels are relayed
+ * the same way, so every shard hears them. A shard going down, for a
+ * copyover or for good, parks its gateway players the same way: the
+ * gateway holds them and attaches them again once the shard is back.
+ */
+class NetServer {
+public:
+    struct Options {
+        std::string address = "0.0.0.0";
+        std::uint16_t port = 4000;
+        bool useIoUring = true;   // Where the kernel supports it; epoll otherwise
+        unsigned reactors = 0;    // Network threads; 0 for one per core beside the game thread, or per reactor core
+        ThreadTopology topology{};   // Cores the game, reactor and worker threads run on; empty for anywhere
+        SlowClientPolicy slowClients = SlowClientPolicy::DropOutput;
+        std::size_t outputHighWater = 64 * 1024;   // Unsent bytes per session before the policy applies
+        bool compression = true;                   // Offer MCCP2 and permessage-deflate, where built with zlib
+        std::uint16_t webSocketPort = 0;           // Also serve browsers over WebSocket here; 0 for none
+        std::chrono::seconds idleCompaction{300};  // Compact sessions quiet this long; 0 never
+        std::uint16_t tlsPort = 0;                 // Also serve telnet over TLS here, where built with OpenSSL; 0 for none
+        std::string tlsCertificate{};              // PEM certificate chain and key, with a TLS port
+        std::string tlsKey{};
+        unsigned tlsWorkers = 2;                   // Threads running TLS handshakes
+        bool zoneActors = false;                   // Run each tick's commands zone by zone on worker threads
+        std::string accounts{};                    // Directory of password accounts; empty for name-only logins
+        unsigned loginThreads = 2;                 // Workers hashing passwords, with accounts
+        std::uint32_t rateLimit = TickScheduler::kDefaultRateLimit;   // Lines per second per session; 0 for no limit
+        std::chrono::milliseconds saveInterval = SaveWriter::kDefaultInterval;   // Longest a change waits to be saved
+        bool journal = false;                      // Journal changed players between saves, with accounts
+        JournalSync journalSync = JournalSync::Interval;
+        std::chrono::milliseconds journalSyncInterval = Journal::kDefaultSyncInterval;
+        std::string stateSegment{};                // Shared memory to keep journaled players in too, with a journal; empty for none
+        std::string checkpoint{};                  // File for whole-world checkpoints; empty for none
+        std::chrono::milliseconds checkpointInterval = std::chrono::minutes(1);
+        std::string record{};                      // Directory to record every session into for replays; empty for none
+        std::chrono::milliseconds statsInterval{0};   // Log the command stats this often; 0 for never
+        std::uint16_t metricsPort = 0;             // Serve Prometheus metrics over HTTP here; 0 for none
+        std::uint16_t apiPort = 0;                 // Serve the world's status as JSON here (see ApiServer); 0 for none
+        std::string apiAddress = "127.0.0.1";      // The API's own, not the game's; loopback behind a proxy
+        std::string apiOrigin{};                   // Sites whose pages may read the API: * or one; empty for none
+        std::uint16_t shardPort = 0;               // Take a gateway's link here, as a shard; 0 for none
+        ShardMap shard{};                          // This server's share of the zones
+        int copyoverFd = -1;                       // State the process before handed over; -1 for a fresh start
+        std::string config{};                      // File of tunables over these (see ServerConfig); empty for none
+        std::chrono::milliseconds watchdog{0};     // Report the game loop stuck this long (see Watchdog); 0 for never
+        std::string database{};                    // SQLite file for the session log (see Storage); empty for none
+        std::string access{};                      // Addresses allowed and banned (see AccessList); empty for none
+        std::uint32_t connectionsPerIp = 0;        // Open at once from one address; 0 for no limit
+        unsigned resolvers = 0;                    // Threads naming clients' addresses (see HostResolver); 0 for none
+        std::vector<std::string> admins{};         // Players who may snoop, with accounts to hold their names
+        std::string adminSocket{};                 // Unix socket console_app --connect attaches to; empty for none
+        std::string texts{};                       // Directory of the greeting and help files (see TextFiles); empty for the built-in ones
+    };
+
+    static std::expected<std::unique_ptr<NetServer>, NetError> create(GameEnginePtr engine, const Options& options);
+
+    ~NetServer();
+
+    // Reactors hold a reference to the game inbox, so the server stays put
+    NetServer(const NetServer&) = delete;
+    NetServer& operator=(const NetServer&) = delete;
+
+    // Serve until requestStop(); the calling thread becomes the game thread
+    void run();
+
+    // Safe to call from a signal handler or another thread
+    void requestStop() noexcept;
+    // The same, but run() hands the connections over rather than closing them
+    void requestCopyover() noexcept;
+    // Read the config and access files again and publish what they set; a
+    // bad file leaves its settings as they were. On the game thread, as on SIGHUP
+    void reloadConfig();
+    // Once run() has returned for a copyover, what the next process is given
+    const std::optional<CopyoverState>& handover() const noexcept { return m_handover; }
+
+    std::size_t sessionCount() const noexcept;
+    std::size_t reactorCount() const noexcept { return m_reactors.size(); }
+    bool usingIoUring() const noexcept { return !m_reactors.empty() && m_reactors.front()->usingIoUring(); }
+    CompressionStats compression() const noexcept;
+    // Null without accounts
+    const LoginStats* logins() const noexcept { return m_loginPool ? &m_loginPool->stats() : nullptr; }
+    // Empty without accounts
+    std::uint64_t metricsScrapes() const noexcept { return m_metricsServer ? m_metricsServer->scrapes() : 0; }
+    std::optional<SaveStats> saves() const { return m_saves ? std::optional(m_saves->stats()) : std::nullopt; }
+    // Empty without a journal
+    std::optional<JournalStats> journal() const {
+        return m_journal ? std::optional(m_journal->stats()) : std::nullopt;
+    }
+    // Empty without a recording
+    std::optional<JournalStats> recording() const {
+        return m_recorder ? std::optional(m_recorder->stats()) : std::nullopt;
+    }
+    // Empty without a checkpoint file
+    std::optional<CheckpointStats> checkpoints() const {
+        return m_checkpoints ? std::optional(m_checkpoints->stats()) : std::nullopt;
+    }
+
+private:
+    // How far a connection has got with logging in
+    enum class LoginStage : std::uint8_t {
+        Name,
+        Password,   // Named; with accounts only
+        Waiting,    // In the admission line for the login pool
+        Checking,   // With the login pool
+        Playing
+    };
+
+    // A connection as the game thread tracks it, from Opened until Closed
+    struct Connection {
+        ConnectionId id;
+        LoginStage stage = LoginStage::Name;
+        std::string name{};                   // As displayed, once given; reserved in m_names from then on
+        std::string password{};               // Only while Waiting
+        std::uint8_t attempts = 0;            // Wrong passwords so far
+        PlayerId player = kInvalidPlayerId;   // Set once the connection has logged in
+        bool closing = false;                 // Quit; later lines are ignored
+        RoomId room = kInvalidRoomId;         // Where the player was after its last command
+        ObjectPool<OutOfBand>::Handle oob{};  // Once the client agrees to GMCP or MSDP
+        std::string address{};                // The client's, as the reactor saw it; empty through the gateway
+        std::string host{};                   // Its name, once the resolver finds one
+        std::uint16_t rows = 0;               // The client's window height, from NAWS; 0 if not known
+    };
+
+    explicit NetServer(GameEnginePtr engine);
+
+    void handleInput(NetInput& input);
+    void runLine(std::uint64_t key, std::string& line);
+    void handleLine(Connection& connection, std::string& line);
+    void runBatch();
+    void login(Connection& connection, std::string& line);
+    void checkPassword(Connection& connection, std::string password);
+    void handleLoginResult(LoginResult& result);
+    void admitLogins();
+    void announceLoginQueue();
+    void enterGame(Connection& connection);
+    void addPlayer(Connection& connection, const PlayerSave& save);
+    void releaseName(const Connection& connection);
+    void resolveHost(Connection& connection);
+    void handleResolved(ResolvedHost& resolved);
+    void nameHost(Connection& connection, std::string host);
+    void handleAdmin(AdminEvent& event);
+    // A login or logout in the database's session log, if there is a database
+    void logSession(std::string_view name, std::string_view event);
+    void savePlayer(const Connection& connection, bool leaving);
+    void openJournal(const Options& options);
+    void applyTuning(ServerConfig tuning);
+    void journalChangedPlayers();
+    void journalPlayer(const Connection& connection);
+    void saveChangedPlayers();
+    void saveScriptStore();
+    void checkpoint();
+    void logCommandStats();
+    void publishMetrics();
+    void publishStatus();
+    void logout(Connection& connection);
+    void handleOption(Connection& connection, const NetInput& input);
+    void handOver();
+    void adopt(CopyoverState& state);
+    void updateOutOfBand(Connection& connection);
+    ObjectPool<OutOfBand>::Handle makeOutOfBand();
+    void markRoom(RoomId room);
+    void refreshRoomPlayers();
+    void pollGateway();
+    void handleMessage(const ShardMessage& message);
+    void attach(const ShardMessage& message);
+    void handOffPlayers();
+    void parkGatewayPlayers();
+    void dropGateway();
+    bool viaGateway(const Connection& connection) const noexcept {
+        return m_gateway && connection.id.reactor == m_gatewayReactor;
+    }
+
+    // Queue text for a connection's reactor; sent at the end of the iteration
+    void send(const ConnectionId& id, std::string_view text, bool close = false);
+    void sendLine(const ConnectionId& id, const SharedMessage& line);
+    void sendReply(const Connection& connection, std::string& reply);
+    void sendRaw(const ConnectionId& id, std::string_view bytes);
+    void deliverMessages();
+    void publish();
+    void publishGateway();
+    void writeGatewayOutput();
+
+    GameEnginePtr m_engine;
+    NetInbox<NetInputBatch> m_inbox;   // Lines from every reactor; also woken by requestStop()
+    std::vector<std::unique_ptr<NetReactor>> m_reactors;
+    std::unique_ptr<TlsAcceptor> m_tls;   // Hands sessions to m_reactors, so it stops first
+    ThreadTopology m_topology;
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<bool> m_copyoverRequested{false};
+    std::optional<CopyoverState> m_handover;
+
+    // Connections' map nodes and GMCP/MSDP states are kept for the next
+    // connection rather than freed, so reconnect loops do not churn the heap
+    static constexpr std::size_t kPooledOutOfBand = 1024;
+    std::pmr::unsynchronized_pool_resource m_connectionMemory{&TrackedResource::of(MemoryTag::Sessions)};
+    ObjectPool<OutOfBand> m_outOfBandPool{kPooledOutOfBand};
+    std::pmr::unordered_map<std::uint64_t, Connection> m_connections{&m_connectionMemory};   // By ConnectionId::key()
+    std::vector<ConnectionId> m_playerConnections;                 // By PlayerId; fd -1 if none
+    std::unordered_set<std::string, TransparentStringHash, std::equal_to<>> m_names;   // Lowercased, in use
+
+    std::vector<NetOutputBatch> m_pending;   // Per reactor
+    std::vector<PlayerId> m_recipients;
+    std::vector<SharedMessage> m_messages;
+
+    // A tick's commands, collected for the engine's zone actors
+    std::vector<QueuedCommand> m_batch;
+    std::vector<std::uint64_t> m_batchKeys;
+
+    // Password checks, posted back by the pool's workers; the pool goes
+    // first, so no worker is left pushing into a destroyed inbox
+    NetInbox<LoginResult> m_loginResults;
+    std::unique_ptr<LoginPool> m_loginPool;
+    NetInbox<ResolvedHost> m_resolved;
+    std::unique_ptr<HostResolver> m_resolver;
+    // Operators attached over the admin socket, each playing as an admin;
+    // their output goes back through the socket rather than a reactor
+    NetInbox<AdminEvent> m_adminEvents;
+    std::unique_ptr<AdminServer> m_adminServer;
+    std::unordered_map<std::uint64_t, PlayerId> m_operators;   // By admin session
+    std::vector<std::uint64_t> m_operatorSessions;             // By PlayerId; 0 for none
+    std::unique_ptr<SaveWriter> m_saves;              // Beside the accounts
+    std::chrono::milliseconds m_saveInterval{};
+    std::chrono::steady_clock::time_point m_lastSave{};
+    std::uint64_t m_savedStore = 0;                   // The script store's version as last submitted
+    std::vector<PlayerId> m_changed;                  // With a journal, every one journaled since the last save
+    std::unique_ptr<Journal> m_journal;
+    std::unique_ptr<StateSegment> m_state;          // With a journal, what it holds newest per player
+    std::vector<PlayerId> m_journaling;             // Changed this pass
+    // A journal sequence number, and the SaveWriter::stats().submitted once
+    // the saves taking over everything through it were submitted
+    std::deque<std::pair<std::uint64_t, std::uint64_t>> m_releases;
+
+    std::unique_ptr<SessionRecorder> m_recorder;
+
+    std::unique_ptr<Checkpointer> m_checkpoints;
+    std::chrono::milliseconds m_checkpointInterval{};
+    std::chrono::steady_clock::time_point m_lastCheckpoint{};
+
+    std::chrono::milliseconds m_statsInterval{};
+    std::chrono::steady_clock::time_point m_lastStats{};
+
+    // The tunables the reactors read, published whole; the file is loaded
+    // over what the command line gave each time
+    RcuPointer<ServerConfig> m_tuning;
+    ServerConfig m_tuningBase{};
+    std::string m_configPath;
+    // Asked by the reactors and the TLS acceptor about each connection
+    AccessControl m_access;
+    std::string m_accessPath;
+    std::vector<std::string> m_admins;   // Lowercased
+    std::chrono::milliseconds m_watchdogThreshold{};
+    std::chrono::milliseconds m_idleBudget{2};
+
+    // The game thread's totals reach its shard at most this often
+    static constexpr std::chrono::milliseconds kMetricsInterval{100};
+    std::unique_ptr<MetricsServer> m_metricsServer;
+    // What ApiServer serves, refilled this often into whichever buffer it is not reading
+    static constexpr std::chrono::seconds kStatusInterval{1};
+    RcuDoubleBuffer<WorldStatus> m_status;
+    std::uint64_t m_statusSerial = 0;
+    std::chrono::steady_clock::time_point m_lastStatus{};
+    std::unique_ptr<ApiServer> m_apiServer;
+    std::uint64_t m_metricsCollector = 0;
+    std::chrono::steady_clock::time_point m_lastMetrics{};
+    std::deque<std::uint64_t> m_admission;            // Waiting connections by key, first come first served
+    std::size_t m_admissionWaiting = 0;               // Of those, the ones still waiting
+    std::chrono::steady_clock::time_point m_lastAnnounce{};
+
+    std::size_t m_outOfBandCount = 0;   // Connections with an OutOfBand state
+    std::vector<RoomId> m_changedRooms;  // Entered or left this iteration, while any have one
+    std::string m_raw;
+
+    // As a shard, the gateway's link; its sessions are connections of the
+    // pseudo-reactor m_gatewayReactor, past the real ones
+    int m_shardListenFd = -1;
+    std::unique_ptr<ShardLink> m_gateway;
+    std::uint16_t m_gatewayReactor = 0;
+    std::vector<ShardMessage> m_shardMessages;
+    std::vector<ShardHandoff> m_handoffs;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+template <typename T>
+class ObjectPool;
+
+// A base for objects ObjectPool recycles: the link that strings a free one
+// onto the pool's list, so keeping it there allocates nothing
+template <typename T>
+class PoolLink {
+    friend class ObjectPool<T>;
+    T* m_nextFree = nullptr;
+};
+
+/**
+ * Per-session objects kept for the next session rather than freed, on one
+ * thread.
+ *
+ * A handle let go of puts its object on the front of an intrusive free list
+ * (the object derives from PoolLink) instead of deleting it, so the next
+ * connection gets it back with the buffers and library state it had grown,
+ * and connect-disconnect churn stops reaching the allocator. take() hands
+ * back the most recently released object, still warm in cache, for the
+ * caller to put back to its starting state, or nullptr when none is free;
+ * objects are made by the caller and given to adopt(). At most limit objects
+ * wait on the list, so a burst of connections does not hold its memory
+ * after it has passed.
+ *
+ * The pool must outlive its handles.
+ */
+template <typename T>
+class ObjectPool {
+public:
+    class Recycle {
+    public:
+        Recycle() noexcept = default;
+        explicit Recycle(ObjectPool* pool) noexcept : m_pool(pool) {}
+
+        void operator()(T* object) const noexcept {
+            if (m_pool) {
+                m_pool->release(object);
+            } else {
+                delete object;
+            }
+        }
+
+    private:
+        ObjectPool* m_pool = nullptr;
+    };
+
+    using Handle = std::unique_ptr<T, Recycle>;
+
+    explicit ObjectPool(std::size_t limit) noexcept : m_limit(limit) {}
+
+    ~ObjectPool() {
+        while (m_free) {
+            delete std::exchange(m_free, m_free->m_nextFree);
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // A released object as it was left, or nullptr
+    Handle take() noexcept {
+        if (!m_free) {
+            return Handle(nullptr, Recycle(this));
+        }
+        T* const object = std::exchange(m_free, m_free->m_nextFree);
+        object->m_nextFree = nullptr;
+        --m_available;
+        ++m_reused;
+        return Handle(object, Recycle(this));
+    }
+
+    // One made elsewhere, returned here once its handle lets go
+    Handle adopt(std::unique_ptr<T> object) noexcept { return Handle(object.release(), Recycle(this)); }
+
+    std::size_t available() const noexcept { return m_available; }
+    // take() calls that found an object
+    std::size_t reused() const noexcept { return m_reused; }
+
+private:
+    void release(T* object) noexcept {
+        if (m_available >= m_limit) {
+            delete object;
+            return;
+        }
+        object->m_nextFree = m_free;
+        m_free = object;
+        ++m_available;
+    }
+
+    T* m_free = nullptr;
+    std::size_t m_available = 0;
+    std::size_t m_limit;
+    std::size_t m_reused = 0;
+};
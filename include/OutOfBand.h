@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "ObjectPool.h"
+
+/**
+ * GMCP (telnet option 201) and MSDP (option 69) state for one connection.
+ *
+ * The game thread sets each variable whenever it may have changed. A value
+ * equal to the one already held is dropped on the spot, and flush() writes
+ * one subnegotiation per changed value the client asked for, so a client
+ * tracking its room or the players in it hears about them only when they
+ * change instead of polling with look. MSDP clients pick variables with
+ * REPORT (and ask once with SEND); GMCP clients pick packages (Char, Room)
+ * with Core.Supports.Set/Add/Remove. Both are answered with complete
+ * subnegotiations, IAC bytes escaped, ready to be queued as they are.
+ */
+class OutOfBand : public PoolLink<OutOfBand> {
+public:
+    static constexpr unsigned char kMsdp = 69;
+    static constexpr unsigned char kGmcp = 201;
+
+    enum class Variable : std::uint8_t { CharacterName, RoomVnum, RoomName, RoomExits, RoomPlayers, Count };
+    static constexpr std::size_t kVariableCount = static_cast<std::size_t>(Variable::Count);
+
+    // A string for most variables; RoomExits is a table of direction to
+    // room number and RoomPlayers a list of names
+    struct Value {
+        std::string text;
+        std::vector<std::pair<std::string, std::string>> fields;
+        std::vector<std::string> items;
+
+        bool operator==(const Value&) const = default;
+    };
+
+    // The client agreed to (DO) or refused (DONT) one of the two options
+    void setEnabled(unsigned char option, bool enabled);
+    bool enabled() const noexcept { return m_msdp || m_gmcp; }
+
+    // What the client asked for (the protocols, MSDP reports and GMCP
+    // modules) as bits, for a process taking the connection over to restore.
+    // A restored state has sent nothing, so its first flush sends everything
+    std::uint32_t subscriptions() const noexcept;
+    void restoreSubscriptions(std::uint32_t bits);
+
+    // Start over for another connection, as constructed, keeping the values' buffers
+    void recycle();
+
+    // A subnegotiation the client sent; any reply is appended to out
+    void receive(unsigned char option, std::string_view payload, std::string& out);
+
+    void set(Variable variable, Value value);
+
+    // Append what changed since the last flush, for whichever protocols want it
+    void flush(std::string& out);
+
+private:
+    // GMCP messages; the Char module carries the first, Room the other two
+    enum class Message : std::uint8_t { CharName, RoomInfo, RoomPlayers, Count };
+    static constexpr std::size_t kMessageCount = static_cast<std::size_t>(Message::Count);
+
+    void receiveMsdp(std::string_view payload, std::string& out);
+    void runMsdp(std::string_view command, const std::vector<std::string_view>& arguments, std::string& out);
+    void receiveGmcp(std::string_view payload, std::string& out);
+    void writeMsdp(Variable variable, std::string& out) const;
+    void writeGmcp(Message message, std::string& out) const;
+
+    std::array<Value, kVariableCount> m_values;
+    std::bitset<kVariableCount> m_known;      // Set at least once
+    std::bitset<kVariableCount> m_changed;    // Since the last flush
+    std::bitset<kVariableCount> m_reported;   // MSDP REPORT
+    std::bitset<kMessageCount> m_supported;   // GMCP, by the modules in Core.Supports
+    std::bitset<kMessageCount> m_due;         // GMCP messages newly supported, sent at the next flush
+    bool m_msdp = false;
+    bool m_gmcp = false;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+#include "GameWorld.h"
+
+// Totals since the pathfinder was made
+struct PathStats {
+    std::uint64_t queries = 0;
+    std::uint64_t cacheHits = 0;
+    std::uint64_t searches = 0;       // Bidirectional searches actually run
+    std::uint64_t roomsVisited = 0;   // Summed over the searches, both directions
+    std::uint64_t zonePrunes = 0;     // Answered "no path" from the zone table alone
+    std::uint64_t rebuilds = 0;       // Times the world changed underneath
+};
+
+/**
+ * Shortest paths between rooms, for tracking, speedwalking and NPCs.
+ *
+ * A query runs a bidirectional breadth-first search: forwards from the
+ * start over each room's exit array and backwards from the goal over a
+ * reverse adjacency built from the same arrays, expanding whichever
+ * frontier is smaller one level at a time, so it visits about the square
+ * root of the rooms a one-sided search would. Every scratch array (visit
+ * stamps, parents, both queues) is sized to the world once and reused, and
+ * a stamp per query stands in for clearing them, so a query allocates
+ * nothing.
+ *
+ * Recent answers are kept in a small direct-mapped cache. The zone table,
+ * when enabled, holds the fewest zone crossings between every pair of zones
+ * and answers queries between disconnected parts of the world without
+ * searching them. Both, and the reverse adjacency, are rebuilt the first
+ * time a query sees that RoomGraph::version() moved on.
+ *
+ * Exits are directed, so a path from A to B need not reverse into one from
+ * B to A. One thread at a time; the span a query returns stays valid until
+ * the next query.
+ */
+class Pathfinder {
+public:
+    static constexpr std::uint32_t kUnreachable = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t kCacheSize = 256;
+
+    // Directions to walk from from to reach to, empty when they are the same
+    // room; nullopt when to cannot be reached
+    std::optional<std::span<const Direction>> path(const RoomGraph& world, RoomId from, RoomId to);
+
+    // Steps from from to to, or kUnreachable
+    std::uint32_t distance(const RoomGraph& world, RoomId from, RoomId to);
+
+    // Keep the zone-to-zone table; costs zoneCount() squared bytes times two
+    void setZoneTable(bool enabled) noexcept { m_zoneTableWanted = enabled; }
+
+    // Fewest zone borders crossed between any rooms of the two zones, or
+    // kUnreachable; needs the zone table, and is 0 without it
+    std::uint32_t zoneHops(const RoomGraph& world, ZoneId from, ZoneId to);
+
+    const PathStats& stats() const noexcept { return m_stats; }
+
+private:
+    // A room as one direction of a search reached it
+    struct Visit {
+        std::uint32_t stamp = 0;    // Query that reached it; anything else means unseen
+        std::uint32_t depth = 0;
+        RoomId via = kInvalidRoomId;   // Forwards: the room before; backwards: the room after
+        Direction dir = Direction::Count;
+    };
+
+    struct CacheEntry {
+        RoomId from = kInvalidRoomId;
+        RoomId to = kInvalidRoomId;
+        bool reachable = false;
+        std::vector<Direction> path;   // Capacity is kept when the entry is replaced
+    };
+
+    struct ReverseExit {
+        RoomId from;
+        Direction dir;
+    };
+
+    void refresh(const RoomGraph& world);
+    void buildZoneTable(const RoomGraph& world);
+    bool search(const RoomGraph& world, RoomId from, RoomId to, std::vector<Direction>& out);
+    CacheEntry& cacheSlot(RoomId from, RoomId to) noexcept;
+
+    const RoomGraph* m_world = nullptr;
+    std::uint64_t m_version = 0;
+
+    // Reverse adjacency in compressed rows: the exits into room r are
+    // m_reverse[m_reverseStart[r] .. m_reverseStart[r + 1])
+    std::vector<std::uint32_t> m_reverseStart;
+    std::vector<ReverseExit> m_reverse;
+
+    std::vector<Visit> m_forward;
+    std::vector<Visit> m_backward;
+    std::vector<RoomId> m_forwardQueue;
+    std::vector<RoomId> m_backwardQueue;
+    std::uint32_t m_stamp = 0;
+
+    std::array<CacheEntry, kCacheSize> m_cache{};
+
+    bool m_zoneTableWanted = false;
+    bool m_zoneTableBuilt = false;
+    std::size_t m_zoneCount = 0;
+    std::vector<std::uint16_t> m_zoneHops;   // zoneCount() squared, row by source zone
+
+    PathStats m_stats;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// The hardware events PerfCounters reads, in the order of their values
+enum class PerfEvent : std::uint8_t {
+    Cycles,
+    Instructions,
+    CacheMisses,    // Last-level cache misses, as the PMU counts them
+    BranchMisses,
+    Count
+};
+
+inline constexpr std::size_t kPerfEventCount = static_cast<std::size_t>(PerfEvent::Count);
+
+// Counts of each event over some stretch of one thread's user-space work
+struct PerfSample {
+    std::array<std::uint64_t, kPerfEventCount> values{};
+
+    std::uint64_t operator[](PerfEvent event) const noexcept { return values[static_cast<std::size_t>(event)]; }
+};
+
+// Samples added up from whichever threads took them, with relaxed adds
+class PerfTotals {
+public:
+    void add(const PerfSample& sample) noexcept {
+        m_samples.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+            m_values[i].fetch_add(sample.values[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t samples() const noexcept { return m_samples.load(std::memory_order_relaxed); }
+    PerfSample sum() const noexcept {
+        PerfSample total;
+        for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+            total.values[i] = m_values[i].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void reset() noexcept {
+        m_samples.store(0, std::memory_order_relaxed);
+        for (auto& value : m_values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> m_samples{0};
+    std::array<std::atomic<std::uint64_t>, kPerfEventCount> m_values{};
+};
+
+/**
+ * Hardware performance counters around hot code, for telling whether a
+ * change made it touch less memory or mispredict less rather than only
+ * take less time.
+ *
+ * Off unless enable() is called, and then only where perf_event_open lets
+ * this process count its own threads (Linux, perf_event_paranoid at 2 or
+ * below). Each thread opens its own group of the four events on first use,
+ * counting user space only, and a PerfScope reads the group on entry and
+ * exit, one read() each, adding the difference to a PerfTotals. While off,
+ * a PerfScope costs one relaxed load.
+ */
+class PerfCounters {
+public:
+    // False, with the reason logged, when this machine or process cannot count
+    static bool enable();
+    static void disable() noexcept { s_enabled.store(false, std::memory_order_relaxed); }
+    static bool enabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+    // The calling thread's counts so far; false if it cannot count
+    static bool read(PerfSample& sample) noexcept;
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+// Adds what the calling thread counts during its lifetime to totals, while
+// counting is enabled; a null totals counts nothing
+class PerfScope {
+public:
+    explicit PerfScope(PerfTotals* totals) noexcept {
+        if (totals && PerfCounters::enabled() && PerfCounters::read(m_start)) {
+            m_totals = totals;
+        }
+    }
+
+    ~PerfScope() {
+        PerfSample end;
+        if (m_totals && PerfCounters::read(end)) {
+            for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+                end.values[i] -= m_start.values[i];
+            }
+            m_totals->add(end);
+        }
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfTotals* m_totals = nullptr;
+    PerfSample m_start;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "FileView.h"
+#include "GameWorld.h"
+#include "MappedRecords.h"
+
+// The sections are read in place as these structs, so the layout is the
+// host's; only little-endian hosts are supported
+static_assert(std::endian::native == std::endian::little, "Player saves are little-endian");
+
+struct PlayerSaveHeader {
+    std::array<char, 8> magic{};
+    std::uint16_t version = 0;
+    std::uint16_t headerSize = 0;     // Room for later versions to grow the header
+    std::uint32_t checksum = 0;       // FNV-1a of everything after the header
+    std::uint64_t fileSize = 0;
+    std::uint64_t savedAt = 0;        // Seconds since the Unix epoch
+    SavedSection strings;             // Bytes
+    SavedSection player;              // One SavedPlayer
+    SavedSection items;               // SavedItem records
+    std::uint64_t journaled = 0;      // The last journal record this save is as up to date as; 0 for none
+};
+
+struct SavedPlayer {
+    SavedString name;
+    SavedString room;                 // By name, so a world rebuilt around it still places the player
+    std::int32_t health = 0;
+    std::int32_t maxHealth = 0;
+    std::int32_t regen = 0;
+    std::uint32_t reserved = 0;
+};
+
+// Something carried, by prototype name
+struct SavedItem {
+    SavedString prototype;
+    std::uint32_t decayTicks = 0;     // Left to live; 0 when it does not decay
+    std::uint32_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<PlayerSaveHeader> && sizeof(PlayerSaveHeader) == 64);
+static_assert(std::is_trivially_copyable_v<SavedPlayer> && sizeof(SavedPlayer) == 32);
+static_assert(std::is_trivially_copyable_v<SavedItem> && sizeof(SavedItem) == 16);
+
+/**
+ * A player's saved state, mapped and read where it lies.
+ *
+ * The file is a fixed 64-byte header, then sections of the structs above at
+ * aligned offsets, then a table of the strings they refer to. open() maps
+ * the file and checks it once, in place: the magic and version, that every
+ * section and every string lies inside the file, and the checksum. After
+ * that the accessors hand out references and views into the mapping with
+ * no further checks and nothing parsed or copied, so a login can open a
+ * save and restore from it in well under a millisecond.
+ *
+ * write() lays the same structs out in a buffer and renames it over the
+ * old file, so a crash leaves either save, never half of one.
+ */
+class PlayerSave {
+public:
+    static constexpr std::uint16_t kVersion = 1;
+
+    PlayerSave() = default;
+
+    // An empty save, failing valid(), when the file is missing or damaged
+    static PlayerSave open(const std::filesystem::path& path);
+    // The same for a file encode() made, held in memory rather than on disk
+    static PlayerSave decode(std::string image);
+    // Save what snapshot holds; false when the file could not be written
+    static bool write(const std::filesystem::path& path, const Player& snapshot, std::uint64_t savedAt);
+    // The file write() would write, such as for a journal to hold; empty if
+    // it would be too big for the format
+    static std::string encode(const Player& snapshot, std::uint64_t savedAt);
+
+    bool valid() const noexcept { return m_header != nullptr; }
+    const PlayerSaveHeader& header() const noexcept { return *m_header; }
+    const SavedPlayer& player() const noexcept { return *m_player; }
+    std::span<const SavedItem> items() const noexcept { return m_items; }
+    // Checked against the table by open(), so any string a record holds is safe
+    std::string_view string(SavedString ref) const noexcept { return m_strings.substr(ref.offset, ref.size); }
+
+private:
+    static PlayerSave check(FileView file);
+
+    FileView m_file;
+    const PlayerSaveHeader* m_header = nullptr;
+    const SavedPlayer* m_player = nullptr;
+    std::span<const SavedItem> m_items;
+    std::string_view m_strings;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Yes-or-no facts about a player, each one bit of PlayerFlags; there is
+// room for 32, so another is a line here rather than another column
+enum class PlayerFlag : std::uint8_t {
+    Admin,     // May snoop; see GameEngine::setAdmin()
+    Watched,   // Snooped or spectated, so what is sent to them is teed
+    Count
+};
+
+class PlayerFlags {
+public:
+    constexpr bool test(PlayerFlag flag) const noexcept { return (m_bits & mask(flag)) != 0; }
+    constexpr void set(PlayerFlag flag, bool on = true) noexcept {
+        m_bits = on ? (m_bits | mask(flag)) : (m_bits & ~mask(flag));
+    }
+    constexpr std::uint32_t bits() const noexcept { return m_bits; }
+
+private:
+    static constexpr std::uint32_t mask(PlayerFlag flag) noexcept { return std::uint32_t{1} << static_cast<unsigned>(flag); }
+
+    std::uint32_t m_bits = 0;
+};
+
+static_assert(static_cast<unsigned>(PlayerFlag::Count) <= 32, "PlayerFlags holds 32 flags");
+
+// What PlayerRegistry keeps for each player beside their room and name,
+// packed into eight bytes: a cache line holds eight players' worth, so a
+// pass over everyone's flags reads no more than it needs. Trivially
+// copyable, so a save or snapshot can take it as it lies
+struct PlayerState {
+    PlayerFlags flags;
+    std::uint16_t pageRows = 0;   // Of a long reply per page; 0 sends it whole
+    std::uint16_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<PlayerState> && sizeof(PlayerState) == 8);
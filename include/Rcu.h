@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Read-copy-update: data many threads read and one thread at a time
+ * replaces. Readers load it through an atomic pointer and take no lock; a
+ * writer never changes a published version but builds a new one and swaps
+ * it in (RcuPointer).
+ *
+ * Old versions are reclaimed by epoch. A reader holds an rcu::Guard while
+ * it uses what it loaded, which copies the global epoch into the thread's
+ * own slot, a cache line no other reader writes. A writer that swaps a
+ * version out bumps the epoch and frees the old one once no slot shows an
+ * earlier epoch, so readers never wait and writers never block them.
+ * Guards nest; only a thread's outermost one pins.
+ */
+namespace rcu {
+
+// Pins the current epoch on this thread for the guard's lifetime
+class Guard {
+public:
+    Guard() noexcept;
+    ~Guard();
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+};
+
+// Start a new epoch; what was unpublished before the call may be freed
+// once quiescent() says so for the epoch returned
+std::uint64_t advance() noexcept;
+
+// Whether every reader has let go of what it loaded before epoch began
+bool quiescent(std::uint64_t epoch) noexcept;
+
+} // namespace rcu
+
+/**
+ * A version of T published for rcu readers. publish() takes ownership of
+ * the new version and retires the old one, which is freed by a later
+ * publish() or reclaim() once no guard from before the swap is left.
+ * Publishing and reclaiming must not run on two threads at once.
+ */
+template <typename T>
+class RcuPointer {
+public:
+    RcuPointer() : m_current(new T()) {}
+    explicit RcuPointer(std::unique_ptr<T> initial) : m_current(initial.release()) {}
+    // No reader may be left by now
+    ~RcuPointer() { delete m_current.load(std::memory_order_relaxed); }
+
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+
+    // The published version; valid while the caller holds an rcu::Guard
+    const T* load() const noexcept { return m_current.load(std::memory_order_seq_cst); }
+
+    void publish(std::unique_ptr<T> next) {
+        std::unique_ptr<T> old(m_current.exchange(next.release(), std::memory_order_seq_cst));
+        m_retired.emplace_back(rcu::advance(), std::move(old));
+        reclaim();
+    }
+
+    // Free the retired versions no reader can still hold
+    void reclaim() noexcept {
+        std::erase_if(m_retired, [](const auto& retired) { return rcu::quiescent(retired.first); });
+    }
+
+    std::size_t retired() const noexcept { return m_retired.size(); }
+
+private:
+    std::atomic<T*> m_current;
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<T>>> m_retired;   // With the epoch each waits for
+};
+
+/**
+ * Two Ts that a writer takes turns filling and rcu readers read, so a
+ * version published every so often reuses the memory of the one before
+ * last rather than allocating anew. The writer fills back() and swaps it
+ * in; back() is null while a reader from before the last swap may still
+ * hold it, and the writer then waits for its next turn. One writer thread.
+ */
+template <typename T>
+class RcuDoubleBuffer {
+public:
+    // The published one; valid while the caller holds an rcu::Guard
+    const T& load() const noexcept { return m_slots[m_current.load(std::memory_order_seq_cst)]; }
+
+    // The one not published, to fill; null while readers may hold it
+    T* back() noexcept {
+        return rcu::quiescent(m_swappedAt) ? &m_slots[1 - m_current.load(std::memory_order_relaxed)] : nullptr;
+    }
+
+    // Publish what back() returned
+    void swap() noexcept {
+        m_current.store(1 - m_current.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+        m_swappedAt = rcu::advance();
+    }
+
+private:
+    std::array<T, 2> m_slots{};
+    std::atomic<unsigned> m_current{0};
+    std::uint64_t m_swappedAt = 0;   // The epoch the last swap began; 0 before the first
+};
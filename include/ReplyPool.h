@@ -0,0 +1,36 @@
+#pragma once
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <utility>
+
+/**
+ * Recycled buffers for command replies.
+ *
+ * A CommandResult gives its message's buffer back here when it is done
+ * with, after the front end has copied the reply out, and take() hands it
+ * to the next command cleared but with its capacity; a handler that builds
+ * its reply in one with format() or std::format_to() touches no heap once
+ * the pool is warm. Each thread keeps a few buffers of its own, so no locks
+ * are involved; a buffer freed on another thread than the one that took it
+ * simply joins that thread's pool. Very large buffers are let go instead.
+ */
+class ReplyPool {
+public:
+    static constexpr std::size_t kBuffers = 16;           // Per thread
+    static constexpr std::size_t kMaxCapacity = 4096;
+
+    // An empty string, with room left by an earlier reply if there is one
+    static std::string take() noexcept;
+    // Keep text's buffer for a later reply; text is left empty
+    static void recycle(std::string& text) noexcept;
+
+    // Format into a recycled buffer
+    template <typename... Args>
+    static std::string format(std::format_string<Args...> format, Args&&... args) {
+        std::string text = take();
+        std::format_to(std::back_inserter(text), format, std::forward<Args>(args)...);
+        return text;
+    }
+};
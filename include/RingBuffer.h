@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed-capacity FIFO that overwrites its oldest element once full.
+ *
+ * Slots are allocated up front and never destroyed while the buffer lives,
+ * so appending is O(1) and, for types such as std::string, push() hands back
+ * the evicted element's slot with its storage intact for reuse. Index 0 is
+ * the oldest element and size() - 1 the newest.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(std::size_t capacity = 1)
+        : m_slots(std::max<std::size_t>(capacity, 1)) {}
+
+    // A moved-from buffer is empty with no slots; its next push() allocates one
+    RingBuffer(RingBuffer&& other) noexcept
+        : m_slots(std::move(other.m_slots))
+        , m_head(std::exchange(other.m_head, 0))
+        , m_size(std::exchange(other.m_size, 0)) {}
+
+    RingBuffer& operator=(RingBuffer&& other) noexcept {
+        m_slots = std::move(other.m_slots);
+        m_head = std::exchange(other.m_head, 0);
+        m_size = std::exchange(other.m_size, 0);
+        return *this;
+    }
+
+    RingBuffer(const RingBuffer&) = default;
+    RingBuffer& operator=(const RingBuffer&) = default;
+
+    std::size_t size() const noexcept { return m_size; }
+    std::size_t capacity() const noexcept { return m_slots.size(); }
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == m_slots.size(); }
+
+    // Slot for a new newest element; once full it still holds the evicted oldest value
+    T& push() {
+        if (m_slots.empty()) [[unlikely]] {
+            m_slots.resize(1);
+        }
+        std::size_t slot = wrap(m_head + m_size);
+        if (m_size < m_slots.size()) {
+            ++m_size;
+        } else {
+            m_head = wrap(m_head + 1);
+        }
+        return m_slots[slot];
+    }
+
+    void push_back(const T& value) { push() = value; }
+    void push_back(T&& value) { push() = std::move(value); }
+
+    T& operator[](std::size_t index) noexcept { return m_slots[wrap(m_head + index)]; }
+    const T& operator[](std::size_t index) const noexcept { return m_slots[wrap(m_head + index)]; }
+
+    T& front() noexcept { return (*this)[0]; }
+    T& back() noexcept { return (*this)[m_size - 1]; }
+
+    // Forget every element; the slots keep their storage
+    void clear() noexcept {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    // Change the capacity, keeping the newest elements that still fit
+    void setCapacity(std::size_t capacity) {
+        capacity = std::max<std::size_t>(capacity, 1);
+        if (capacity == m_slots.size()) {
+            return;
+        }
+        std::vector<T> slots(capacity);
+        const std::size_t kept = std::min(m_size, capacity);
+        for (std::size_t i = 0; i < kept; ++i) {
+            slots[i] = std::move((*this)[m_size - kept + i]);
+        }
+        m_slots = std::move(slots);
+        m_head = 0;
+        m_size = kept;
+    }
+
+private:
+    std::size_t wrap(std::size_t index) const noexcept {
+        return index >= m_slots.size() ? index - m_slots.size() : index;
+    }
+
+    std::vector<T> m_slots;
+    std::size_t m_head = 0;   // Slot of the oldest element
+    std::size_t m_size = 0;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "GameWorld.h"
+
+// Totals since the writer was made, copied out under its lock
+struct SaveStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t coalesced = 0;   // Replaced a snapshot still waiting, so one write was saved
+    std::uint64_t written = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t filesWritten = 0;   // Whole files, such as the script store
+    std::uint64_t filesFailed = 0;
+};
+
+/**
+ * Player saves written behind the game, on a thread of their own.
+ *
+ * The game thread hands over a snapshot of each player that changed and
+ * goes straight back to work; the writer wakes once an interval, takes
+ * everything waiting and writes it with PlayerSave::write (a temporary
+ * file renamed over the old save). A player snapshotted again before the
+ * writer got to them replaces the older snapshot, so however busy a
+ * player is they cost at most one write an interval. An urgent snapshot,
+ * for a player who has left, wakes the writer at once; settle() waits for
+ * a name's save to land, so a quick return never reads the save before
+ * last. Whatever is waiting is written before the destructor returns.
+ *
+ * Saves are <key>.save in the directory; keys must be safe as file names.
+ *
+ * Other state written behind the game, such as the script store, comes as
+ * a whole file's contents under its name, coalesced and written in the
+ * same batches. Those files are not counted in submitted or completed(),
+ * which are about players.
+ */
+class SaveWriter {
+public:
+    static constexpr std::chrono::milliseconds kDefaultInterval{5000};
+
+    explicit SaveWriter(std::filesystem::path directory, std::chrono::milliseconds interval = kDefaultInterval);
+    ~SaveWriter();
+
+    SaveWriter(const SaveWriter&) = delete;
+    SaveWriter& operator=(const SaveWriter&) = delete;
+
+    // Save snapshot under key within an interval, or at once when urgent
+    void submit(std::string key, Player snapshot, bool urgent = false);
+    // Replace name in the directory with contents within an interval
+    void submitFile(std::string name, std::string contents);
+    // Return once nothing is waiting for key or being written under it
+    void settle(const std::string& key);
+    // Return once everything submitted so far is written
+    void flush();
+
+    std::filesystem::path path(std::string_view key) const;
+    SaveStats stats() const;
+    // How many of the snapshots stats().submitted counts are on disk, or
+    // replaced by a newer one that is. Stops growing at the first failed
+    // write, since whatever that snapshot held is not
+    std::uint64_t completed() const;
+
+private:
+    void work();
+
+    std::filesystem::path m_directory;
+    std::chrono::milliseconds m_interval;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_settled;
+    std::unordered_map<std::string, Player> m_waiting;
+    std::unordered_map<std::string, std::string> m_waitingFiles;
+    std::vector<std::string> m_writing;   // Keys of the batch being written
+    SaveStats m_stats;
+    std::uint64_t m_completed = 0;
+    bool m_urgent = false;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include "MemoryAccounting.h"
+
+/**
+ * Memory for work that is over by a known point, such as the end of a tick.
+ *
+ * A std::pmr::monotonic_buffer_resource over a block of its own: allocating
+ * bumps a pointer, freeing does nothing, and release() takes everything back
+ * at once. The block is kept across releases, so work that fits in it never
+ * reaches the heap; what spills over comes from the heap, counted against
+ * the tag, and goes back at the release.
+ *
+ * Not thread-safe: one arena belongs to one thread at a time.
+ */
+class ScratchArena {
+public:
+    explicit ScratchArena(std::size_t size, MemoryTag tag = MemoryTag::Engine)
+        : m_block(makeTrackedBuffer(tag, size)), m_resource(m_block.get(), size, &TrackedResource::of(tag)) {}
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    std::pmr::memory_resource& resource() noexcept { return m_resource; }
+    void release() noexcept { m_resource.release(); }
+
+private:
+    TrackedBuffer m_block;
+    std::pmr::monotonic_buffer_resource m_resource;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include "GameWorld.h"
+
+class GameEngine;
+struct lua_State;
+
+namespace sol {
+    class state;
+}
+
+// Handles to game objects as seen from Lua. They hold ids rather than copies,
+// so every field read goes straight to the engine's live columns.
+struct ScriptPlayer {
+    GameEngine* engine;
+    PlayerId id;
+};
+
+struct ScriptRoom {
+    GameEngine* engine;
+    RoomId id;
+};
+
+// The engine's hot columns as LuaJIT FFI sees them (struct EchoView in the
+// cdef in ScriptBindings.cpp, which must match it field for field).
+// game.view() refreshes the pointers, which move as the columns grow, and
+// returns it; indexes are not checked, so scripts stay below the counts
+struct ScriptStateView {
+    const RoomId* playerRooms;        // By PlayerId; kInvalidRoomId for free ids
+    const RoomId* exits;              // directions per room, in Direction order
+    const std::int32_t* combatHealth; // By combat slot, as of the last round
+    const std::int32_t* combatAttack;
+    const std::int32_t* combatDefense;
+    const std::int32_t* combatDamage;
+    std::uint32_t playerCount;        // Size of the id space
+    std::uint32_t roomCount;
+    std::uint32_t directions;
+    std::uint32_t combatants;
+};
+
+/**
+ * Registers the Player and Room usertypes and the `game` table in a Lua state.
+ *
+ * Player: id, name, room, valid, send(message)
+ * Room:   id, name, description, exit(direction), players(), broadcast(message [, except])
+ * game:   caller(), player(id), room(name), sendMessage(player, message),
+ *         broadcast(room, message [, except]), getPlayerName(), getPlayerLocation(),
+ *         getCurrentRoom(), getPlayersInRoom(), and with LuaJIT view()
+ */
+void registerGameBindings(sol::state& lua, GameEngine& engine);
+
+// Pushes the `store` table a script's environment gets: get(key),
+// set(key, value), add(key, number), keys(), all on the script's own
+// space in the engine's ScriptStore. Pushes nil if the state has no game
+// bindings
+void pushScriptStore(lua_State* L, std::string_view script);
+
+// Replaces the global table `name` with a read-only view of it: reads go
+// through, writes raise an error and its metatable can't be reached
+void freezeGlobal(sol::state& lua, const char* name);
+
+// Marks the player a script is running for, for game.caller() and the getCurrent* helpers
+class ScriptCallerScope {
+public:
+    explicit ScriptCallerScope(const ScriptPlayer* caller);
+    ~ScriptCallerScope();
+
+    ScriptCallerScope(const ScriptCallerScope&) = delete;
+    ScriptCallerScope& operator=(const ScriptCallerScope&) = delete;
+
+private:
+    const ScriptPlayer* m_previous;
+};
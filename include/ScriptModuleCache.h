@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Compiled Lua modules, shared by every state in the process.
+ *
+ * require() in a script compiles a module file the first time any state
+ * asks for it and leaves the bytecode here, keyed by the file's path and
+ * modification time; every other state, and every later reload, loads that
+ * bytecode from memory instead of reading and parsing the source again.
+ * A module whose file has changed since is compiled afresh and replaces
+ * the old entry. Chunks are shared pointers, so a state still loading one
+ * keeps it alive while another replaces it.
+ */
+class ScriptModuleCache {
+public:
+    using Chunk = std::shared_ptr<const std::string>;
+
+    struct Stats {
+        std::size_t modules = 0;
+        std::size_t bytes = 0;
+        std::uint64_t hits = 0;       // Loads served from memory
+        std::uint64_t compiles = 0;
+    };
+
+    ScriptModuleCache() = default;
+    ScriptModuleCache(const ScriptModuleCache&) = delete;
+    ScriptModuleCache& operator=(const ScriptModuleCache&) = delete;
+
+    // The one every ScriptRunner compiles into
+    static ScriptModuleCache& global();
+
+    // The bytecode of path as it was at modified; null if it isn't cached
+    Chunk find(const std::filesystem::path& path, std::filesystem::file_time_type modified) const;
+    // Cache bytecode compiled from path at modified, replacing any older entry
+    Chunk insert(const std::filesystem::path& path, std::filesystem::file_time_type modified, std::string bytecode);
+
+    Stats stats() const;
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type modified;
+        Chunk bytecode;
+    };
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    mutable std::atomic<std::uint64_t> m_hits{0};
+    std::atomic<std::uint64_t> m_compiles{0};
+};
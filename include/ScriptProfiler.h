@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Folded stacks, "outer;inner" to how many samples ended in them, merged
+// over every state that was sampled
+using FoldedStacks = std::unordered_map<std::string, std::uint64_t>;
+
+// Summed over every state's last run
+struct ScriptProfileTotals {
+    std::uint64_t samples = 0;
+    std::uint64_t dropped = 0;   // With the state's buffer full
+    bool running = false;
+};
+
+/**
+ * Lua call stacks sampled by a state's count hook, for flame graphs.
+ *
+ * The runner only installs its sampling hook while profiling, so a state
+ * that isn't being profiled runs its usual budget hook and nothing else.
+ * While it is, every period-th hook call walks the stack; each frame is
+ * named once, the first time it is seen, and after that a sample is its
+ * frame ids appended to a buffer sized when profiling starts. Once the
+ * buffer is full, samples are counted as dropped rather than growing it,
+ * so a burst of profiling costs a known amount of memory.
+ */
+class ScriptProfiler {
+public:
+    static constexpr std::size_t kDefaultWords = std::size_t{1} << 18;   // 1 MiB of frame ids
+    static constexpr std::size_t kMaxDepth = 64;                        // Deeper frames are cut off
+
+    explicit ScriptProfiler(std::uint32_t period, std::size_t words = kDefaultWords);
+
+    // Called on every hook; true for the ones to sample
+    bool due() noexcept {
+        if (++m_countdown < m_period) {
+            return false;
+        }
+        m_countdown = 0;
+        return true;
+    }
+
+    // The id of a frame, named "function (source:line)" or "source:line"
+    std::uint32_t frame(std::string_view function, std::string_view source, int line);
+    // One sample's frames, innermost first
+    void record(std::span<const std::uint32_t> stack);
+
+    std::uint64_t samples() const noexcept { return m_samples; }
+    std::uint64_t dropped() const noexcept { return m_dropped; }
+
+    // Add this state's samples to stacks
+    void fold(FoldedStacks& stacks) const;
+    // One "stack count" line per stack, most samples first, as flamegraph.pl reads them
+    static std::string render(const FoldedStacks& stacks);
+
+private:
+    std::uint32_t m_period;
+    std::uint32_t m_countdown = 0;
+    std::vector<std::uint32_t> m_words;      // Per sample: its depth, then its frames
+    std::size_t m_capacity;
+    std::vector<std::string> m_frames;       // By id
+    std::unordered_map<std::string, std::uint32_t> m_frameIds;
+    std::string m_name;                      // Reused to look frames up without allocating
+    std::uint64_t m_samples = 0;
+    std::uint64_t m_dropped = 0;
+};
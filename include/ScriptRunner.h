@@ -1,10 +1,37 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <span>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <filesystem>
 #include <expected>
+#include <optional>
 #include <sol/sol.hpp>
+#include "LuaArena.h"
+#include "Random.h"
+#include "ScriptBindings.h"
+#include "ScriptModuleCache.h"
+#include "ScriptProfiler.h"
+#include "CommandArgs.h"
+
+// Stable index of a loaded script; survives reloading the script under the same name
+using ScriptHandle = std::uint32_t;
+
+// Engine events a script handles through its `events` table, under the
+// names enter_room, tick, say and combat_round
+enum class ScriptEvent : std::uint8_t {
+    EnterRoom,     // (player, room) after a player moves into a room
+    Tick,          // (tick) every tick
+    Say,           // (player, message) after a player says something
+    CombatRound,   // (room, report) after a combat round is told in a room
+    Count
+};
 
 /**
  * @class ScriptRunner
@@ -21,19 +48,142 @@ public:
         LoadFailed,
         ExecutionFailed,
         CommandNotFound,
-        InvalidScript
+        InvalidScript,
+        BudgetExceeded
     };
 
-    // Constructor initializes the Lua state
-    ScriptRunner();
+    // Per-script execution counters, accumulated over every call into the script
+    struct ScriptStats {
+        std::uint64_t calls = 0;
+        std::uint64_t instructions = 0;   // Counted in steps of kInstructionHookInterval
+        std::chrono::nanoseconds wallTime{0};
+        std::uint64_t budgetExceeded = 0;
+    };
+
+    // VM instructions between budget checks. LuaJIT doesn't run count hooks
+    // inside compiled traces, so there only interpreted code is metered
+    static constexpr int kInstructionHookInterval = 1000;
+
+    // Default per-call instruction budget
+    static constexpr std::uint64_t kDefaultInstructionBudget = 10'000'000;
+
+    // Memory accounting for the state's allocator
+    struct MemoryStats {
+        std::size_t liveBytes = 0;
+        std::size_t peakBytes = 0;
+        std::size_t limitBytes = 0;   // 0 when unlimited
+    };
+
+    // How the Lua garbage collector is driven
+    enum class GcMode {
+        Automatic,      // Lua's default: collect whenever allocation triggers it
+        Incremental,    // Incremental collector (Lua 5.4), triggered by allocation
+        Generational,   // Generational collector (Lua 5.4), triggered by allocation
+        Scheduled       // Never triggered by allocation; work happens in collectStep()
+    };
+
+    // Time spent in collectStep() slices
+    struct GcStats {
+        std::uint64_t slices = 0;
+        std::uint64_t cycles = 0;
+        std::chrono::nanoseconds totalPause{0};
+        std::chrono::nanoseconds maxPause{0};
+    };
+
+    // A suspended call that finished (or failed) while being resumed by resumeTasks()
+    struct TaskResult {
+        PlayerId player;   // kInvalidPlayerId if the call had no caller
+        std::expected<std::string, ScriptError> output;
+    };
+
+    // One invocation in a runBatch() call
+    struct BatchCall {
+        std::string_view args;
+        const ScriptPlayer* caller = nullptr;
+    };
+
+    // Metadata a script declares in `--@key value` comment lines at its top,
+    // read without compiling it (see readHeader)
+    struct ScriptHeader {
+        std::string help;
+        std::string description;
+        std::string syntax;
+        bool pure = false;
+    };
+
+    // Suspended calls a state holds at once; wait() fails beyond this
+    static constexpr std::size_t kMaxSuspendedTasks = 10'000;
+
+    /**
+     * @brief Initializes the Lua state on a pooled allocator
+     * @param memoryLimit Ceiling for the state's heap in bytes; 0 for no limit
+     */
+    explicit ScriptRunner(std::size_t memoryLimit = 0);
+
+    // The Lua state keeps a pointer to m_arena, so the runner stays put
+    ScriptRunner(const ScriptRunner&) = delete;
+    ScriptRunner& operator=(const ScriptRunner&) = delete;
 
     /**
      * @brief Loads a Lua script from file and registers it as a command
      * @param name The command name to register
      * @param scriptPath Path to the Lua script file
-     * @return Success or an error code
+     * @return A handle for the loaded script or an error code
+     */
+    std::expected<ScriptHandle, ScriptError> loadScript(const std::string& name, const std::filesystem::path& scriptPath);
+
+    /**
+     * @brief Reads the header of a script that asks to be loaded lazily
+     *
+     * Only the leading comment lines are read. A script is lazy when they
+     * include `--@lazy` along with `--@help` and `--@description`; `--@syntax`
+     * and `--@pure` are optional. Lua sees these as comments, so the script
+     * loads the same when compiled at once.
+     *
+     * @param scriptPath Path to the Lua script file
+     * @return The declared metadata, or nullopt if the script is not lazy
+     */
+    static std::optional<ScriptHeader> readHeader(const std::filesystem::path& scriptPath);
+
+    /**
+     * @brief Registers a script whose source is compiled on its first call
+     *
+     * Until then help, description, syntax and purity come from @p header,
+     * the script has no hooks, and its events table is not seen, so only
+     * commands without either should be lazy.
+     *
+     * @param name The command name to register; an existing script of that name is replaced
+     * @param scriptPath Path to the Lua script file
+     * @param header Metadata returned by readHeader
+     * @return A handle for the script or an error code
      */
-    std::expected<void, ScriptError> loadScript(const std::string& name, const std::filesystem::path& scriptPath);
+    std::expected<ScriptHandle, ScriptError> deferScript(const std::string& name, const std::filesystem::path& scriptPath,
+                                                         ScriptHeader header);
+
+    /**
+     * @brief Loads a script from bytecode compiled elsewhere (see compileToBytecode)
+     * @param name The command name to register; an existing script of that name is replaced
+     * @param scriptPath Path of the source file, used for error messages
+     * @param bytecode The compiled chunk
+     * @param modified Modification time of the source the chunk was compiled from
+     * @return A handle for the loaded script or an error code
+     */
+    std::expected<ScriptHandle, ScriptError> loadCompiled(const std::string& name, const std::filesystem::path& scriptPath,
+                                                          std::string_view bytecode, std::filesystem::file_time_type modified);
+
+    /**
+     * @brief Compiles a script file to bytecode in the given Lua state
+     *
+     * Only touches @p lua, so it can run on another thread with a state of its own.
+     *
+     * @param lua State used for compilation
+     * @param scriptPath Path to the Lua script file
+     * @param modified Modification time of the script, used to validate the bytecode cache
+     * @param useCache Whether to return a still-valid cached chunk and store newly compiled ones
+     * @return The bytecode or an error code
+     */
+    static std::expected<std::string, ScriptError> compileToBytecode(sol::state& lua, const std::filesystem::path& scriptPath,
+                                                                      std::filesystem::file_time_type modified, bool useCache);
 
     /**
      * @brief Executes a loaded script command with arguments
@@ -41,7 +191,50 @@ public:
      * @param args Arguments to pass to the script
      * @return The script's output or an error message
      */
-    std::expected<std::string, ScriptError> runCommand(const std::string& name, const std::string& args);
+    std::expected<std::string, ScriptError> runCommand(const std::string& name, std::string_view args);
+
+    /**
+     * @brief Executes a loaded script through its cached run function
+     *
+     * The run function executes as a coroutine. If it calls wait(), the call
+     * is suspended, @p output is left empty and the rest of the call happens
+     * in a later resumeTasks().
+     *
+     * @param handle Handle returned by loadScript or resolve
+     * @param args Arguments to pass to the script, pushed to Lua without copying
+     * @param output Buffer the script's output is written into (replacing its contents)
+     * @param caller Player the command runs for, passed to run as its second argument
+     * @param parsed Fields matched by the command's syntax, passed to run as a table
+     *               in its third argument; null for a command without one
+     * @return Success or an error code
+     */
+    std::expected<void, ScriptError> run(ScriptHandle handle, std::string_view args, std::string& output,
+                                         const ScriptPlayer* caller = nullptr, const CommandArgs* parsed = nullptr);
+
+    /**
+     * @brief Executes a script once per record with a single transition into Lua
+     *
+     * The run function is fetched once and every record is called from the
+     * same C loop, so per-call setup is paid once per batch. Each record gets
+     * its own instruction budget and result; a failing record does not stop
+     * the rest. Batched calls run on the main thread and cannot wait().
+     *
+     * @param name The command name to execute
+     * @param calls Arguments and caller of each invocation
+     * @param results Resized to calls.size(); strings already in it are reused
+     * @return Success, or an error if the script could not be run at all
+     */
+    std::expected<void, ScriptError> runBatch(const std::string& name, std::span<const BatchCall> calls,
+                                              std::vector<std::expected<std::string, ScriptError>>& results);
+    std::expected<void, ScriptError> runBatch(ScriptHandle handle, std::span<const BatchCall> calls,
+                                              std::vector<std::expected<std::string, ScriptError>>& results);
+
+    /**
+     * @brief Looks up the handle of a loaded script
+     * @param name The command name
+     * @return The handle or CommandNotFound
+     */
+    std::expected<ScriptHandle, ScriptError> resolve(const std::string& name) const;
 
     /**
      * @brief Gets the help string for a command
@@ -57,6 +250,13 @@ public:
      */
     std::expected<std::string, ScriptError> getDescription(const std::string& name);
 
+    /**
+     * @brief Gets the argument syntax a command declares (see ArgumentSchema)
+     * @param name The command name
+     * @return The syntax, empty if the script declares none, or an error
+     */
+    std::expected<std::string, ScriptError> getSyntax(const std::string& name);
+
     /**
      * @brief Checks if a command script is loaded
      * @param name The command name
@@ -64,18 +264,287 @@ public:
      */
     bool hasCommand(const std::string& name) const;
 
+    /**
+     * @brief Checks if a script declared itself pure (`pure = true`)
+     * @param handle The script handle
+     * @return True if the script keeps no state between calls
+     */
+    bool isPure(ScriptHandle handle) const;
+
+    /**
+     * @brief Checks if a loaded script defines an optional hook function
+     * @param name The command name the script was loaded as
+     * @param hookName The hook field, e.g. "before_command" or "before_move"
+     * @return True if the script table has a function under that field
+     */
+    bool hasHook(const std::string& name, const std::string& hookName);
+
+    /**
+     * @brief Calls a hook function defined by a loaded script
+     * @param name The command name the script was loaded as
+     * @param hookName The hook field to call
+     * @param first First argument passed to the hook
+     * @param second Second argument passed to the hook
+     * @return False if the hook returned false (block the event), true otherwise
+     */
+    std::expected<bool, ScriptError> runHook(const std::string& name, const std::string& hookName,
+                                             std::string_view first, std::string_view second);
+
+    // Whether any loaded script handles event; one relaxed load, safe from any thread
+    bool subscribed(ScriptEvent event) const noexcept {
+        return (m_eventMask.load(std::memory_order_relaxed) >> static_cast<unsigned>(event) & 1) != 0;
+    }
+
+    /**
+     * @brief Calls every script's handler for an event, in load order
+     *
+     * Handlers are resolved when a script is installed and kept per event,
+     * so an emit is one protected call per handler with no table lookups.
+     * Errors and exceeded budgets are reported and the next handler still runs.
+     */
+    void emitEnterRoom(const ScriptPlayer& player, const ScriptRoom& room);
+    void emitTick(std::uint64_t tick);
+    void emitSay(const ScriptPlayer& player, std::string_view message);
+    void emitCombatRound(const ScriptRoom& room, std::string_view report);
+
+    /**
+     * @brief Enables or disables the on-disk bytecode cache (enabled by default)
+     *
+     * Compiled chunks are stored in a `.luac` directory next to each script and
+     * reused while the script's modification time is unchanged.
+     */
+    void setBytecodeCacheEnabled(bool enabled) { m_bytecodeCache = enabled; }
+    bool bytecodeCacheEnabled() const { return m_bytecodeCache; }
+
+    /**
+     * @brief Enables or disables lazy loading (enabled by default)
+     *
+     * While enabled, loadScript() defers a script whose header asks for it
+     * (see readHeader) instead of compiling it, so rarely used commands cost
+     * neither startup time nor Lua heap until someone runs them.
+     */
+    void setLazyLoading(bool enabled) { m_lazyLoading = enabled; }
+    bool lazyLoadingEnabled() const { return m_lazyLoading; }
+
+    /**
+     * @brief Sets the directory require() finds modules in
+     *
+     * require("util.text") loads util/text.lua under root, compiled through
+     * ScriptModuleCache::global() so other states load the same bytecode
+     * from memory. Empty, the default, leaves require() with nothing to find.
+     */
+    void setModuleRoot(std::filesystem::path root) { m_moduleRoot = std::move(root); }
+    const std::filesystem::path& moduleRoot() const { return m_moduleRoot; }
+
+    // Direct access to the state, e.g. for registering bindings before scripts load
+    sol::state& lua() { return m_lua; }
+
+    /**
+     * @brief Sets the instruction budget for each call into a script
+     *
+     * A call that runs past the budget is aborted with a Lua error and
+     * reported as BudgetExceeded. Zero disables the limit.
+     */
+    void setInstructionBudget(std::uint64_t instructions) { m_instructionBudget = instructions; }
+    std::uint64_t instructionBudget() const { return m_instructionBudget; }
+
+    /**
+     * @brief The calling thread's interrupt flag
+     *
+     * Setting it from any thread aborts the script call the owning thread
+     * is running at its next instruction check, as an exceeded budget is;
+     * the next call on that thread clears it. For a watchdog.
+     */
+    static std::atomic<bool>& interruptFlag() noexcept;
+
+    /**
+     * @brief Gets the execution counters of every loaded script
+     * @return Pairs of command name and counters, in handle order
+     */
+    std::vector<std::pair<std::string, ScriptStats>> stats() const;
+
+    /**
+     * @brief Selects how the garbage collector runs
+     *
+     * Incremental and Generational fall back to Automatic on Lua versions
+     * without them. Scheduled stops allocation-triggered collection entirely,
+     * so the caller must call collectStep() regularly.
+     */
+    void setGcMode(GcMode mode);
+    GcMode gcMode() const { return m_gcMode; }
+
+    /**
+     * @brief Runs incremental collection for at most the given time
+     *
+     * Does nothing unless a cycle is in progress or the heap has grown
+     * noticeably since the last completed cycle, so calling it from an idle
+     * loop costs nothing when scripts are quiet.
+     *
+     * @param budget Wall-time budget for this slice
+     * @return True if a collection cycle finished during the slice
+     */
+    bool collectStep(std::chrono::microseconds budget);
+
+    GcStats gcStats() const { return m_gcStats; }
+
+    /**
+     * @brief Resumes suspended calls whose timer has expired or whose event was signalled
+     *
+     * Each resumption is metered like a fresh call and gets its own
+     * instruction budget. Returns immediately while nothing is due.
+     *
+     * @param now Current time, compared against wait(ms) deadlines
+     * @param finished Calls that returned or failed are appended here
+     * @return Number of calls resumed
+     */
+    std::size_t resumeTasks(std::chrono::steady_clock::time_point now, std::vector<TaskResult>& finished);
+
+    // Wake every call suspended in wait(event); they resume in the next resumeTasks()
+    void signal(std::string_view event);
+
+    // Drop the suspended calls made for a player, e.g. when the player leaves
+    void cancelTasks(PlayerId player);
+
+    std::size_t suspendedTasks() const { return m_tasks.size(); }
+
+    // When resumeTasks() next has work: the earliest timer, time_point::min() once
+    // an event was signalled, or time_point::max() with nothing suspended on a timer
+    std::chrono::steady_clock::time_point nextWake() const {
+        if (m_tasksSignalled) {
+            return std::chrono::steady_clock::time_point::min();
+        }
+        return m_tasks.empty() ? std::chrono::steady_clock::time_point::max() : m_nextWake;
+    }
+
+    // True while a collection cycle started by collectStep() is unfinished
+    bool collecting() const { return m_gcCycleActive; }
+
+    // Allocator counters; the limit can be changed at any time and applies to growth from then on
+    MemoryStats memoryStats() const { return {m_arena.liveBytes(), m_arena.peakBytes(), m_arena.limit()}; }
+    void setMemoryLimit(std::size_t bytes) { m_arena.setLimit(bytes); }
+
+    /**
+     * @brief Starts sampling this state's Lua stacks, dropping earlier samples
+     *
+     * The count hook is swapped for one that also records the stack every
+     * period-th time it runs, which is every period * kInstructionHookInterval
+     * instructions (see ScriptProfiler); stopProfiling() swaps it back, so a
+     * state that isn't being profiled pays nothing for the profiler.
+     */
+    void startProfiling(std::uint32_t period, std::size_t words = ScriptProfiler::kDefaultWords);
+    void stopProfiling();
+    bool profiling() const { return m_profiling; }
+    // The samples of the last run, stopped or not; null before the first
+    const ScriptProfiler* profiler() const { return m_profiler.get(); }
+
+    // Put math.random on a stream of its own, from the process seed; a
+    // pool gives each state Random::kScriptStream plus its index
+    void seedRandom(std::uint64_t stream) { m_random.reseed(Random::seed(), stream); }
+
 private:
+    // Allocator for the Lua state; declared first so it outlives the state
+    LuaArena m_arena;
+    // What math.random and the dice functions draw from; the state points at it
+    Random m_random{Random::seed(), Random::kScriptStream};
+    // Where require() looks; the state points at it too
+    std::filesystem::path m_moduleRoot;
+
     // The Lua state
     sol::state m_lua;
 
-    // Map of command names to loaded script objects
-    std::unordered_map<std::string, sol::table> m_scripts;
+    // Metatable of every script's environment; its __index is the globals
+    sol::table m_sandbox;
+
+    // A loaded script with its run function resolved once at load time
+    struct LoadedScript {
+        std::string name;
+        sol::table table;
+        sol::protected_function run;
+        bool pure = false;
+        ScriptStats stats;
+        std::filesystem::path deferred;   // Source still to compile on the first call; empty once loaded
+        ScriptHeader header;              // What a deferred script declared
+    };
+
+    // A run function suspended in wait(); the thread reference keeps its coroutine alive
+    struct Task {
+        ScriptHandle script;
+        sol::thread thread;
+        ScriptPlayer caller;   // engine is null when the call had no caller
+        std::chrono::steady_clock::time_point wakeAt;
+        std::string event;     // Non-empty while waiting for signal(event)
+    };
+
+    // Loaded scripts indexed by ScriptHandle, and the name -> handle index
+    std::vector<LoadedScript> m_scripts;
+    std::unordered_map<std::string, ScriptHandle> m_handles;
+
+    // Event handlers by ScriptEvent, and a bit for each event that has any
+    struct EventHandler {
+        ScriptHandle script;
+        sol::protected_function handler;
+    };
+    std::array<std::vector<EventHandler>, static_cast<std::size_t>(ScriptEvent::Count)> m_eventHandlers;
+    std::atomic<std::uint32_t> m_eventMask{0};
+
+    // Replace the handlers a script had with those in its events table
+    void bindEvents(ScriptHandle handle, const sol::table& scriptTable);
+
+    template <typename... Args>
+    void emit(ScriptEvent event, const ScriptPlayer* caller, const Args&... args);
 
     // Map of script paths to track file modifications
     std::unordered_map<std::string, std::filesystem::file_time_type> m_scriptTimes;
 
-    // Get the script table for a command
-    std::expected<sol::table, ScriptError> getScript(const std::string& name);
+    // Whether compiled chunks are read from and written to the bytecode cache
+    bool m_bytecodeCache = true;
+
+    // Whether loadScript() defers scripts whose header asks for it
+    bool m_lazyLoading = true;
+
+    // Instructions allowed per call; 0 for no limit
+    std::uint64_t m_instructionBudget = kDefaultInstructionBudget;
+
+    // The sampling profiler's buffers, kept after it stops until the next start
+    std::unique_ptr<ScriptProfiler> m_profiler;
+    bool m_profiling = false;
+
+    // Install hook as the count hook of the state and of every suspended call
+    void setCountHook(lua_Hook hook);
+
+    // Collector scheduling state
+    GcMode m_gcMode = GcMode::Automatic;
+    GcStats m_gcStats;
+    bool m_gcCycleActive = false;
+    std::size_t m_gcBaseline = 0;   // Live bytes after the last completed cycle
+
+    // Suspended calls, the earliest timer among them, and whether any event was signalled
+    std::vector<Task> m_tasks;
+    std::chrono::steady_clock::time_point m_nextWake = std::chrono::steady_clock::time_point::max();
+    bool m_tasksSignalled = false;
+
+    // Run or continue a task's coroutine; true if it finished, false if it suspended again
+    std::expected<bool, ScriptError> resume(Task& task, int nargs, std::string& output);
+
+    // Compile a script file, going through the bytecode cache when enabled
+    std::expected<sol::protected_function, ScriptError> compileScript(
+        const std::filesystem::path& scriptPath, std::filesystem::file_time_type modified);
+
+    // Compile a script file now and install it, whatever its header says
+    std::expected<ScriptHandle, ScriptError> compileAndInstall(const std::string& name, const std::filesystem::path& scriptPath);
+
+    // Compile a deferred script; does nothing once it is loaded
+    std::expected<void, ScriptError> ensureLoaded(ScriptHandle handle);
+
+    // Put a script in the slot its name already has, or a new one
+    ScriptHandle store(LoadedScript script);
+
+    // Run a compiled chunk and store the returned script table under name
+    std::expected<ScriptHandle, ScriptError> install(const std::string& name, const std::filesystem::path& scriptPath,
+                                                     sol::protected_function& chunk, std::filesystem::file_time_type modified);
+
+    // Get the loaded script for a command
+    std::expected<LoadedScript*, ScriptError> getScript(const std::string& name);
 
     // Helper to validate that script has required elements
     bool validateScript(const sol::table& script) const;
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "ScriptRunner.h"
+
+/**
+ * @class ScriptRunnerPool
+ * @brief A fixed set of independent Lua states running the same scripts
+ *
+ * Every script is loaded into each state in the same order, so a ScriptHandle
+ * names the same script in all of them. Scripts that declare `pure = true`
+ * keep no state between calls and may run on whichever state is free, which
+ * lets callers on different threads execute them concurrently. All other
+ * scripts, and all hooks, run on the primary state so their Lua globals stay
+ * in one place.
+ */
+class ScriptRunnerPool {
+public:
+    using ScriptError = ScriptRunner::ScriptError;
+
+    /**
+     * @brief Creates the pool
+     * @param size Number of Lua states; at least one is always created
+     */
+    explicit ScriptRunnerPool(std::size_t size = defaultSize());
+
+    // One state per hardware thread, capped so startup isn't dominated by loading copies
+    static std::size_t defaultSize();
+
+    std::size_t size() const { return m_slots.size(); }
+
+    /**
+     * @brief Loads a script into every state in the pool
+     * @param name The command name to register
+     * @param scriptPath Path to the Lua script file
+     * @return A handle valid for every state, or an error code
+     */
+    std::expected<ScriptHandle, ScriptError> loadScript(const std::string& name, const std::filesystem::path& scriptPath);
+
+    // Replace a script in every state with bytecode compiled off the main thread
+    std::expected<ScriptHandle, ScriptError> loadCompiled(const std::string& name, const std::filesystem::path& scriptPath,
+                                                          std::string_view bytecode, std::filesystem::file_time_type modified);
+
+    bool bytecodeCacheEnabled() { return primary().runner.bytecodeCacheEnabled(); }
+
+    // Applies lazy loading to every state (see ScriptRunner::setLazyLoading);
+    // each state then compiles a deferred script on its own first call
+    void setLazyLoading(bool enabled);
+    bool lazyLoadingEnabled() { return primary().runner.lazyLoadingEnabled(); }
+
+    // Points every state's require() at root (see ScriptRunner::setModuleRoot)
+    void setModuleRoot(const std::filesystem::path& root);
+
+    // Applies the per-call instruction budget to every state
+    void setInstructionBudget(std::uint64_t instructions);
+    std::uint64_t instructionBudget();
+
+    // Applies a collector mode to every state
+    void setGcMode(ScriptRunner::GcMode mode);
+
+    /**
+     * @brief Gives each idle state a garbage collection slice
+     * @param budget Time budget per state; states busy running a script are skipped
+     * @return True if collection work remains (a cycle is unfinished or a state was busy)
+     */
+    bool collectIdle(std::chrono::microseconds budget);
+
+    // Collector slice counters summed over every state (maxPause is the largest of any state)
+    ScriptRunner::GcStats gcStats();
+
+    /**
+     * @brief Resumes due suspended calls in every state
+     *
+     * Events passed to signal() since the last call are delivered first.
+     *
+     * @param now Current time, compared against wait(ms) deadlines
+     * @param finished Calls that returned or failed are appended here
+     * @return When a suspended call is next due; time_point::max() if none is on a timer
+     */
+    std::chrono::steady_clock::time_point resumeTasks(std::chrono::steady_clock::time_point now, std::vector<ScriptRunner::TaskResult>& finished);
+
+    // Queue an event for calls waiting in wait(event); never blocks on a busy state
+    void signal(std::string event);
+
+    // Drop the suspended calls made for a player in every state
+    void cancelTasks(PlayerId player);
+
+    // Suspended calls summed over every state
+    std::size_t suspendedTasks();
+
+    // Caps the heap of each state; 0 for no limit
+    void setMemoryLimit(std::size_t bytesPerState);
+
+    // Allocator counters summed over every state
+    ScriptRunner::MemoryStats memoryStats();
+
+    // Sample every state's Lua stacks (see ScriptRunner::startProfiling)
+    void startProfiling(std::uint32_t period);
+    void stopProfiling();
+    // Add every state's samples to stacks
+    ScriptProfileTotals foldProfiles(FoldedStacks& stacks);
+
+    // Execution counters summed over every state, in handle order
+    std::vector<std::pair<std::string, ScriptRunner::ScriptStats>> stats();
+
+    /**
+     * @brief Executes a script on a free state (pure scripts) or the primary state
+     * @param handle Handle returned by loadScript
+     * @param args Arguments to pass to the script
+     * @param output Buffer the script's output is written into
+     * @return Success or an error code
+     */
+    std::expected<void, ScriptError> run(ScriptHandle handle, std::string_view args, std::string& output,
+                                         const ScriptPlayer* caller = nullptr, const CommandArgs* parsed = nullptr);
+
+    // Batch form of run(); the whole batch executes on one state (see ScriptRunner::runBatch)
+    std::expected<void, ScriptError> runBatch(ScriptHandle handle, std::span<const ScriptRunner::BatchCall> calls,
+                                              std::vector<std::expected<std::string, ScriptError>>& results);
+
+    // Run setup (such as binding registration) against every state
+    template <typename Fn>
+    void forEachState(Fn&& fn) {
+        for (auto& slot : m_slots) {
+            std::lock_guard<std::mutex> lock(slot->mutex);
+            fn(slot->runner.lua());
+        }
+    }
+
+    // Name-based execution; resolves the handle then behaves like run()
+    std::expected<std::string, ScriptError> runCommand(const std::string& name, std::string_view args);
+
+    // Metadata and hooks are served by the primary state
+    std::expected<std::string, ScriptError> getHelp(const std::string& name);
+    std::expected<std::string, ScriptError> getDescription(const std::string& name);
+    std::expected<std::string, ScriptError> getSyntax(const std::string& name);
+    bool hasCommand(const std::string& name);
+    bool hasHook(const std::string& name, const std::string& hookName);
+    std::expected<bool, ScriptError> runHook(const std::string& name, const std::string& hookName,
+                                             std::string_view first, std::string_view second);
+
+    // Events too run on the primary state; subscribed() takes no lock, so an
+    // event nobody handles costs one load
+    bool subscribed(ScriptEvent event) const noexcept { return m_slots.front()->runner.subscribed(event); }
+    void emitEnterRoom(const ScriptPlayer& player, const ScriptRoom& room);
+    void emitTick(std::uint64_t tick);
+    void emitSay(const ScriptPlayer& player, std::string_view message);
+    void emitCombatRound(const ScriptRoom& room, std::string_view report);
+
+private:
+    struct Slot {
+        ScriptRunner runner;
+        std::mutex mutex;
+    };
+
+    Slot& primary() { return *m_slots.front(); }
+
+    // Load into the primary state, then every replica, holding all states throughout
+    template <typename Load>
+    std::expected<ScriptHandle, ScriptError> loadEverywhere(const std::string& name, Load&& load);
+
+    // Lock a free state, starting from a rotating position; waits on that
+    // position if every state is busy
+    std::unique_lock<std::mutex> acquire(Slot*& slot);
+
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    std::atomic<std::size_t> m_next{0};
+
+    // Events signalled since the last resumeTasks()
+    std::mutex m_signalMutex;
+    std::vector<std::string> m_signals;
+};
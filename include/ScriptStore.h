@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "MappedRecords.h"
+
+static_assert(std::endian::native == std::endian::little, "Script stores are little-endian");
+
+// What a script may keep: Lua's booleans, integers, numbers and strings
+using ScriptValue = std::variant<bool, std::int64_t, double, std::string>;
+
+struct ScriptStoreHeader {
+    std::array<char, 8> magic{};
+    std::uint16_t version = 0;
+    std::uint16_t headerSize = 0;
+    std::uint32_t checksum = 0;       // FNV-1a of everything after the header
+    std::uint64_t fileSize = 0;
+    SavedSection strings;             // Bytes
+    SavedSection entries;             // SavedScriptEntry records
+    std::uint64_t reserved = 0;
+};
+
+struct SavedScriptEntry {
+    SavedString space;                // The script's name
+    SavedString key;
+    std::uint32_t type = 0;           // The ScriptValue alternative
+    std::uint32_t reserved = 0;
+    std::uint64_t value = 0;          // A bool, int64 or double's bits, or a SavedString
+};
+
+static_assert(std::is_trivially_copyable_v<ScriptStoreHeader> && sizeof(ScriptStoreHeader) == 48);
+static_assert(std::is_trivially_copyable_v<SavedScriptEntry> && sizeof(SavedScriptEntry) == 32);
+
+/**
+ * State scripts keep across reloads and restarts, owned by the engine rather
+ * than by any Lua state, so every state in the pool sees the same values.
+ *
+ * Each script has a space of its own, named after it, holding typed values
+ * by key. Values are native, not Lua tables serialized: a read is a hash
+ * probe under the space's shared lock and hands back one boolean, number
+ * or string. Spaces live as long as the store, so a script's environment
+ * keeps a pointer to its own. Every change bumps version(), which is how
+ * whoever persists the store knows it has something new to write.
+ *
+ * encode() lays the store out as a file of fixed records and a string
+ * table (see MappedRecords.h), which decode() checks and reads back.
+ */
+class ScriptStore {
+public:
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr std::string_view kFileName = "scripts.store";
+    static constexpr std::size_t kMaxKeyBytes = 256;
+    static constexpr std::size_t kMaxStringBytes = 64 * 1024;
+
+    class Space {
+    public:
+        const std::string& name() const noexcept { return m_name; }
+
+        std::optional<ScriptValue> get(std::string_view key) const;
+        // False, changing nothing, when the key or a string is too long
+        bool set(std::string_view key, ScriptValue value);
+        bool remove(std::string_view key);
+        // Add a number to the one under key, missing counting as 0, in one
+        // step however many states share the key; integers stay integers.
+        // nullopt when either is not a number
+        std::optional<ScriptValue> add(std::string_view key, const ScriptValue& amount);
+        std::vector<std::string> keys() const;
+        std::size_t size() const;
+
+    private:
+        friend class ScriptStore;
+
+        struct Hash {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+        };
+
+        Space(std::string name, std::atomic<std::uint64_t>& version) : m_name(std::move(name)), m_version(version) {}
+
+        std::string m_name;
+        std::atomic<std::uint64_t>& m_version;
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<std::string, ScriptValue, Hash, std::equal_to<>> m_values;
+    };
+
+    ScriptStore() = default;
+    ScriptStore(const ScriptStore&) = delete;
+    ScriptStore& operator=(const ScriptStore&) = delete;
+
+    // The space named name, made empty the first time it is asked for
+    Space& space(std::string_view name);
+    const Space* find(std::string_view name) const;
+
+    std::uint64_t version() const noexcept { return m_version.load(std::memory_order_acquire); }
+    std::size_t values() const;
+
+    std::string encode() const;
+    // Replace what is stored with a file encode() made; false, leaving the
+    // store as it was, when it is damaged
+    bool decode(std::string_view bytes);
+
+private:
+    std::atomic<std::uint64_t> m_version{0};
+    mutable std::mutex m_mutex;   // Guards the map, not the spaces in it
+    std::unordered_map<std::string, std::unique_ptr<Space>, Space::Hash, std::equal_to<>> m_spaces;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sol {
+    class state;
+}
+
+/**
+ * @class ScriptWatcher
+ * @brief Hot reload of Lua scripts driven by file-change notifications
+ *
+ * A worker thread blocks on the operating system's change feed for the
+ * directories holding watched scripts (inotify on Linux, ReadDirectoryChangesW
+ * on Windows). When a watched script is written it is compiled to bytecode on
+ * that thread, in a Lua state of its own, and queued. The engine drains the
+ * queue between commands, so the main loop only loads finished bytecode and
+ * never stat()s script files itself.
+ */
+class ScriptWatcher {
+public:
+    // A changed script, compiled and ready to be loaded
+    struct CompiledScript {
+        std::filesystem::path path;
+        std::filesystem::file_time_type modified;
+        std::string bytecode;
+    };
+
+    /**
+     * @brief Creates an idle watcher
+     * @param writeBytecodeCache Whether recompiled scripts also refresh the bytecode cache
+     */
+    explicit ScriptWatcher(bool writeBytecodeCache);
+    ~ScriptWatcher();
+
+    ScriptWatcher(const ScriptWatcher&) = delete;
+    ScriptWatcher& operator=(const ScriptWatcher&) = delete;
+
+    // Normalized absolute form used to match change notifications to watched files
+    static std::filesystem::path normalize(const std::filesystem::path& path);
+
+    // Add a script file to watch; must be called before start()
+    void watch(const std::filesystem::path& scriptPath);
+
+    /**
+     * @brief Starts the worker thread
+     * @return False if change notifications are unavailable on this platform
+     */
+    bool start();
+
+    // Stops and joins the worker thread
+    void stop();
+
+    // Cheap check for the main loop: true once at least one script is waiting
+    bool hasPending() const noexcept { return m_pending.load(std::memory_order_acquire); }
+
+    // Take every script compiled since the last call
+    std::vector<CompiledScript> takeCompiled();
+
+private:
+    void run();
+    void fileChanged(sol::state& compiler, const std::filesystem::path& path);
+
+    std::vector<std::filesystem::path> m_files;
+    std::vector<std::filesystem::path> m_directories;
+    bool m_writeCache;
+
+    std::thread m_thread;
+    std::atomic<bool> m_pending{false};
+
+    std::mutex m_mutex;
+    std::vector<CompiledScript> m_compiled;
+
+#ifdef _WIN32
+    void* m_stopEvent = nullptr;
+#else
+    int m_notifyFd = -1;
+    int m_wakeFd = -1;
+    std::vector<int> m_watches;   // inotify watch descriptor per directory
+#endif
+};
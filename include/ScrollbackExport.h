@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * The console's scrollback written to a file on a thread of its own.
+ *
+ * The UI thread only takes a snapshot: a view of each message and a pin on
+ * the arena chunks they live in (see TextArena::pin), so no text is copied
+ * and the console goes straight back to drawing. The export thread gathers
+ * the messages, a line each, into 1 MiB blocks and writes each block in one
+ * call, to a temporary file renamed into place when complete. A path ending
+ * in .gz is written gzip-compressed when the build has zlib.
+ */
+class ScrollbackExport {
+public:
+    struct Snapshot {
+        std::vector<std::shared_ptr<const char[]>> pins;   // Keep the lines' chunks alive
+        std::vector<std::string_view> lines;
+    };
+
+    struct Result {
+        std::uint64_t lines = 0;
+        std::uint64_t bytes = 0;          // Text written, before compression
+        std::uint64_t fileBytes = 0;      // Size of the file
+        bool compressed = false;
+    };
+
+    // Called once, on the export thread, when the file is written or has failed
+    using Done = std::function<void(const std::filesystem::path&, const std::expected<Result, std::string>&)>;
+
+    static constexpr std::size_t kBlockSize = 1 << 20;
+
+    ScrollbackExport(std::filesystem::path path, Snapshot snapshot, Done done);
+    // Waits for the file to be written
+    ~ScrollbackExport();
+
+    ScrollbackExport(const ScrollbackExport&) = delete;
+    ScrollbackExport& operator=(const ScrollbackExport&) = delete;
+
+    bool finished() const noexcept { return m_finished.load(std::memory_order_acquire); }
+
+    // Whether a .gz path is compressed in this build
+    static bool compressionAvailable() noexcept;
+
+private:
+    std::expected<Result, std::string> write() const;
+
+    std::filesystem::path m_path;
+    Snapshot m_snapshot;
+    Done m_done;
+    std::atomic<bool> m_finished{false};
+    std::thread m_thread;
+};
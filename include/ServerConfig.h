@@ -0,0 +1,46 @@
+#pragma once
+
+#include "NetReactor.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/**
+ * The server's tunables that may change while it runs, read from a file of
+ * `key = value` lines (# starts a comment):
+ *
+ *   rate_limit = 20              lines per second per session; 0 for none
+ *   save_interval_ms = 5000      longest a changed player waits to be saved
+ *   checkpoint_interval_ms = 60000
+ *   stats_interval_s = 0         log the command stats this often; 0 never
+ *   idle_budget_ms = 2           script work the engine does per loop pass
+ *   output_high_water = 65536    unsent bytes per session before slow_clients applies
+ *   slow_clients = drop          or disconnect
+ *   idle_compaction_s = 300      compact sessions quiet this long; 0 never
+ *   connections_per_ip = 0       open at once from one address; 0 for no limit
+ *
+ * A key the file leaves out keeps the value it is loaded over, which is
+ * what the command line gave. The server publishes each version whole
+ * through an RcuPointer and never changes one once published, so reactor
+ * threads read it without a lock; SIGHUP loads the file again.
+ */
+struct ServerConfig {
+    std::uint32_t rateLimit = 0;
+    std::chrono::milliseconds saveInterval{};
+    std::chrono::milliseconds checkpointInterval{};
+    std::chrono::milliseconds statsInterval{};
+    std::chrono::milliseconds idleBudget{2};
+    std::size_t outputHighWater = 0;
+    SlowClientPolicy slowClients = SlowClientPolicy::DropOutput;
+    std::chrono::seconds idleCompaction{};
+    std::uint32_t connectionsPerIp = 0;
+    std::uint64_t generation = 0;   // Bumped by each publish, so a reader can tell a new version
+
+    // The settings in text over base; the error names the offending line
+    static std::expected<ServerConfig, std::string> parse(std::string_view text, const ServerConfig& base);
+    static std::expected<ServerConfig, std::string> load(const std::filesystem::path& path, const ServerConfig& base);
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include "Journal.h"
+#include "TickScheduler.h"
+
+// What a record in a session recording stands for
+enum class RecordedKind : std::uint8_t {
+    Tick,      // A tick began
+    Join,      // A player entered the game; the line is PlayerSave::encode() of them as they entered
+    Command,   // A player's line ran as a command
+    Leave,     // A player left the game; the line is "1" if their belongings went with them
+};
+
+// Leads each record's payload, the line following it; the key is the player's name
+struct RecordedHeader {
+    std::uint64_t tick = 0;       // TickScheduler::tickCount() at the time
+    std::uint64_t boundary = 0;   // TickScheduler::boundary() at the time
+    RecordedKind kind = RecordedKind::Tick;
+    std::uint8_t inTick = 0;      // While a tick ran, rather than between two
+    std::uint8_t reserved[6] = {};
+};
+
+static_assert(std::is_trivially_copyable_v<RecordedHeader> && sizeof(RecordedHeader) == 24);
+
+struct RecordedEvent {
+    RecordedHeader header;
+    std::string_view name;   // Empty for ticks
+    std::string_view line;
+};
+
+/**
+ * A recording of everything players did, for replaying against a
+ * GameEngine elsewhere, as fast as it will go or at the original pace.
+ *
+ * Every tick, every player entering or leaving and every line run as a
+ * command is a record in a Journal of its own, stamped with the tick count
+ * and boundary it happened at. Ticks are recorded as they start, through
+ * an update run each tick; that keeps the scheduler ticking at every
+ * boundary while recording, so the replay runs the same ticks at the same
+ * boundaries and the world's updates and timers see what they saw here.
+ * Nothing is synced: a recording is for profiling and testing, and the
+ * journal's writer thread keeps its cost off the game thread.
+ *
+ * Opening a recording replaces whatever the directory held before, so each
+ * start of a server begins a new one.
+ */
+class SessionRecorder {
+public:
+    SessionRecorder(std::filesystem::path directory, TickScheduler& ticks);
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    void join(std::string_view name, std::string_view image) { append(RecordedKind::Join, name, image); }
+    void command(std::string_view name, std::string_view line) { append(RecordedKind::Command, name, line); }
+    void leave(std::string_view name, bool keepBelongings) {
+        append(RecordedKind::Leave, name, keepBelongings ? "1" : "0");
+    }
+    // Once a pass, like Journal::commit()
+    void commit() { m_journal.commit(); }
+
+    JournalStats stats() const { return m_journal.stats(); }
+
+    // Call apply for every event the directory's recording holds, in the
+    // order they happened; returns how many there were
+    static std::uint64_t read(const std::filesystem::path& directory,
+                              const std::function<void(const RecordedEvent&)>& apply);
+
+private:
+    void append(RecordedKind kind, std::string_view name, std::string_view line);
+
+    TickScheduler& m_ticks;
+    Journal m_journal;
+    TickUpdateId m_update = kInvalidTickUpdateId;
+    std::string m_payload;   // Scratch, reused for every record
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "NetReactor.h"
+#include "ShardMap.h"
+
+// Messages are read in place with the host's layout, as player saves are;
+// only little-endian hosts are supported
+static_assert(std::endian::native == std::endian::little, "Shard links are little-endian");
+
+// What goes between the gateway and a shard. Sessions are the gateway's
+// numbers for its clients, the same on every shard
+enum class ShardMessageKind : std::uint8_t {
+    Opened,    // Gateway to shard: a client connected; log it in
+    Line,      // Gateway to shard: a line the client typed, in body
+    Closed,    // Gateway to shard: the client went
+    Attach,    // Gateway to shard: a player handed over; name, and its PlayerSave image in body
+    Output,    // Shard to gateway: text for the client
+    Close,     // Shard to gateway: close the client once its output is written
+    Handoff,   // Shard to gateway: the player in name now belongs to shard; body as for Attach
+    Channel,   // Either way: what was said (body) on the channel called name
+    Park,      // Shard to gateway: the shard is going down; hold the player in name and attach body once it is back
+    Count
+};
+
+// Frames are batches: this, then count messages back to back
+struct ShardBatchHeader {
+    std::uint32_t size = 0;    // Bytes, this header included
+    std::uint32_t count = 0;
+};
+
+// Each message: this, then the name and the body
+struct ShardMessageHeader {
+    std::uint32_t size = 0;    // Bytes, this header included
+    std::uint8_t kind = 0;
+    std::uint8_t reserved = 0;
+    std::uint16_t shard = 0;
+    std::uint64_t session = 0;
+    std::uint32_t nameSize = 0;
+    std::uint32_t reserved2 = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<ShardBatchHeader> && sizeof(ShardBatchHeader) == 8);
+static_assert(std::is_trivially_copyable_v<ShardMessageHeader> && sizeof(ShardMessageHeader) == 24);
+
+// One message as it lies in ShardLink's receive buffer: the header is
+// copied out, the name and body are views of the bytes that arrived
+class ShardMessage {
+public:
+    using Kind = ShardMessageKind;
+
+    // bytes is a whole message that ShardLink::receive() has checked
+    explicit ShardMessage(std::string_view bytes) noexcept : m_bytes(bytes) {
+        std::memcpy(&m_header, bytes.data(), sizeof(m_header));
+    }
+
+    Kind kind() const noexcept { return static_cast<Kind>(m_header.kind); }
+    std::uint16_t shard() const noexcept { return m_header.shard; }
+    std::uint64_t session() const noexcept { return m_header.session; }
+    std::string_view name() const noexcept { return m_bytes.substr(sizeof(m_header), m_header.nameSize); }
+    std::string_view body() const noexcept { return m_bytes.substr(sizeof(m_header) + m_header.nameSize); }
+    // The message as it arrived, for passing on untouched
+    std::string_view bytes() const noexcept { return m_bytes; }
+
+private:
+    ShardMessageHeader m_header;
+    std::string_view m_bytes;
+};
+
+/**
+ * A framed connection between the gateway and one shard.
+ *
+ * send() appends a message to the batch being built in the outgoing
+ * buffer, its header and parts copied straight in; flush() closes the
+ * batch and writes what the non-blocking socket takes, so a loop polls
+ * for writability while wantsWrite(). Everything one pass sends to a link
+ * goes as one frame, however many sessions it is for, up to kBatchBytes
+ * each. forward() passes on a message received from another link without
+ * decoding it, as the gateway relays a channel.
+ *
+ * receive() reads what has arrived and hands back every message of each
+ * whole batch as a ShardMessage viewing the receive buffer, decoding
+ * nothing but the headers; the views last until the next receive().
+ */
+class ShardLink {
+public:
+    static constexpr std::size_t kMaxFrame = 16 * 1024 * 1024;
+    static constexpr std::size_t kBatchBytes = 64 * 1024;
+
+    // A listening socket for the gateway, non-blocking
+    static std::expected<int, NetError> listen(const std::string& address, std::uint16_t port);
+    // Connect to a shard, waiting at most timeout for it to answer
+    static std::expected<std::unique_ptr<ShardLink>, NetError> connect(const std::string& address, std::uint16_t port,
+                                                                       std::chrono::milliseconds timeout);
+
+    // Takes over a connected socket, made non-blocking here
+    explicit ShardLink(int fd);
+    ~ShardLink();
+
+    ShardLink(const ShardLink&) = delete;
+    ShardLink& operator=(const ShardLink&) = delete;
+
+    int fd() const noexcept { return m_fd; }
+
+    // The body is the parts one after another
+    void send(ShardMessageKind kind, std::uint16_t shard, std::uint64_t session, std::string_view name,
+              std::initializer_list<std::string_view> body = {});
+    void forward(const ShardMessage& message);
+    // Write what the socket takes; false once the peer is gone
+    bool flush();
+    bool wantsWrite() const noexcept { return m_written < m_out.size(); }
+
+    // Replace messages with every one of the whole batches that have
+    // arrived; false once the peer is gone or sent something that is not
+    // a batch
+    bool receive(std::vector<ShardMessage>& messages);
+
+private:
+    // Room in the batch being built for a message of size bytes
+    void reserve(std::size_t size);
+    void seal() noexcept;
+
+    int m_fd;
+    std::string m_in;
+    std::size_t m_consumed = 0;   // Of m_in, by the views the last receive() handed out
+    std::string m_out;
+    std::size_t m_written = 0;    // Of m_out
+    std::size_t m_batch = 0;      // Where the batch being built starts in m_out, if m_count > 0
+    std::uint32_t m_count = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include "GameWorld.h"
+
+// Which zones a shard runs in a sharded deployment: zone z belongs to
+// shard z % count, so neighbouring zones spread over the shards
+struct ShardMap {
+    std::uint16_t index = 0;
+    std::uint16_t count = 1;
+
+    std::uint16_t shardOf(ZoneId zone) const noexcept { return static_cast<std::uint16_t>(zone % count); }
+    bool owns(ZoneId zone) const noexcept { return shardOf(zone) == index; }
+    bool sharded() const noexcept { return count > 1; }
+};
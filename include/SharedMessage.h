@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "MemoryAccounting.h"
+
+// Immutable message text, formatted once and shared by every player it is sent
+// to, so broadcasting to a full room copies a pointer per recipient rather
+// than the text
+using SharedMessage = std::shared_ptr<const std::string>;
+
+// What a SharedMessage made by makeSharedMessage points into: the text,
+// counted as the engine's memory until the last recipient lets it go
+struct SharedMessageText {
+    explicit SharedMessageText(std::string value)
+        : text(std::move(value)), heapBytes(text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0) {
+        MemoryAccounting::record(MemoryTag::Engine, static_cast<std::int64_t>(heapBytes), heapBytes > 0 ? 1 : 0,
+                                 heapBytes);
+    }
+    ~SharedMessageText() { MemoryAccounting::freed(MemoryTag::Engine, heapBytes); }
+
+    SharedMessageText(const SharedMessageText&) = delete;
+    SharedMessageText& operator=(const SharedMessageText&) = delete;
+
+    std::string text;
+    std::size_t heapBytes;   // Beyond the string itself; 0 for text short enough to sit inside it
+};
+
+// One allocation for the count and the string, as make_shared would, and
+// the text's own if it is long
+inline SharedMessage makeSharedMessage(std::string text) {
+    auto owner = std::allocate_shared<SharedMessageText>(TrackedAllocator<SharedMessageText>(MemoryTag::Engine),
+                                                         std::move(text));
+    const std::string* message = &owner->text;
+    return SharedMessage(std::move(owner), message);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <csignal>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
@@ -15,37 +18,70 @@ enum class SignalError {
 
 /**
  * @class SignalHandler
- * @brief Manages signal handling with thread-safe registration and callback execution
+ * @brief Turns signals into events an event loop handles on its own thread
+ *
+ * The real signal handler only does what is async-signal-safe: it marks the
+ * signal pending and writes its number to a self-pipe. The loop polls fd()
+ * beside its other descriptors and calls dispatchPending(), which runs the
+ * registered callbacks there, so they may lock, allocate and log freely.
+ * A signal that arrives again before it is dispatched runs its callback once.
  */
 class SignalHandler {
 public:
     using SignalCallback = std::function<void()>;
-    
+
     /**
      * @brief Registers a callback function for a specific signal
      * @param signal The signal number to handle
-     * @param callback The function to call when the signal is received
+     * @param callback The function dispatchPending() calls once the signal is received
      * @return Success or an error code
      */
     static std::expected<void, SignalError> registerHandler(int signal, SignalCallback callback);
-    
+
     /**
      * @brief Unregisters a previously registered signal handler
      * @param signal The signal number to unregister
      * @return Success or an error code
      */
     static std::expected<void, SignalError> unregisterHandler(int signal);
-    
+
     /**
-     * @brief Processes a received signal by calling the appropriate callback
+     * @brief Records a received signal; the only part that runs in the signal handler
      * @param signal The signal that was received
      */
-    static void handleSignal(int signal);
-    
+    static void handleSignal(int signal) noexcept;
+
+    /**
+     * @brief Readable while signals are waiting to be dispatched
+     * @return The self-pipe's read end, or -1 before the first registration
+     *         or where there is no pipe (callers then poll dispatchPending())
+     */
+    static int fd() noexcept { return s_pipe[0].load(std::memory_order_acquire); }
+
+    /**
+     * @brief Runs the callbacks of the signals received since the last call
+     * @return True if any callback ran
+     */
+    static bool dispatchPending();
+
 private:
+#ifdef NSIG
+    static constexpr int kMaxSignal = NSIG;
+#else
+    static constexpr int kMaxSignal = 65;
+#endif
+
+    static bool openPipe();
+
     // Map of signal numbers to callback functions
     static std::unordered_map<int, SignalCallback> s_signalCallbacks;
-    
-    // Mutex for thread safety when accessing the callbacks map
+
+    // Guards the callbacks map; never taken inside the signal handler
     static std::mutex s_signalMutex;
-}; 
\ No newline at end of file
+
+    // Set by handleSignal(), cleared by dispatchPending(); lock-free atomics
+    // are safe to store to from a signal handler
+    static std::array<std::atomic<bool>, kMaxSignal> s_pending;
+    static std::atomic<bool> s_anyPending;
+    static std::array<std::atomic<int>, 2> s_pipe;
+};
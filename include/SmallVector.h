@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Vector whose first N elements live inside the object.
+ *
+ * For short lists held in large numbers, such as what each entity carries:
+ * while the list fits in N it costs no allocation and sits next to its
+ * owner; past that it moves to the heap and grows like a std::vector.
+ * Elements must be trivially copyable (handles and ids), which keeps
+ * growth and erasure to memmove.
+ */
+template <typename T, std::size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                  "SmallVector holds handles and ids");
+    static_assert(N > 0);
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(const SmallVector& other) { assign(other.begin(), other.end()); }
+
+    SmallVector(SmallVector&& other) noexcept { take(other); }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            m_size = 0;
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            m_heap.reset();
+            m_capacity = N;
+            take(other);
+        }
+        return *this;
+    }
+
+    T* data() noexcept { return m_heap ? m_heap.get() : m_inline; }
+    const T* data() const noexcept { return m_heap ? m_heap.get() : m_inline; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + m_size; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + m_size; }
+
+    std::size_t size() const noexcept { return m_size; }
+    std::size_t capacity() const noexcept { return m_capacity; }
+    bool empty() const noexcept { return m_size == 0; }
+    // Still within the inline elements
+    bool isInline() const noexcept { return !m_heap; }
+
+    T& operator[](std::size_t i) noexcept { return data()[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+    T& back() noexcept { return data()[m_size - 1]; }
+
+    void push_back(const T& value) {
+        if (m_size == m_capacity) {
+            // value may live in this vector
+            const T copy = value;
+            grow(m_capacity * 2);
+            data()[m_size++] = copy;
+            return;
+        }
+        data()[m_size++] = value;
+    }
+
+    void pop_back() noexcept { --m_size; }
+
+    // Remove the element at it, keeping the others in order
+    iterator erase(iterator it) noexcept {
+        std::memmove(it, it + 1, static_cast<std::size_t>(end() - (it + 1)) * sizeof(T));
+        --m_size;
+        return it;
+    }
+
+    // Remove every element equal to value; returns how many went
+    std::size_t eraseValue(const T& value) noexcept {
+        const iterator last = std::remove(begin(), end(), value);
+        const auto removed = static_cast<std::size_t>(end() - last);
+        m_size -= removed;
+        return removed;
+    }
+
+    // Forget the elements but keep the heap block, if any
+    void clear() noexcept { m_size = 0; }
+
+    void reserve(std::size_t capacity) {
+        if (capacity > m_capacity) {
+            grow(capacity);
+        }
+    }
+
+private:
+    template <typename It>
+    void assign(It first, It last) {
+        reserve(static_cast<std::size_t>(last - first));
+        std::copy(first, last, data());
+        m_size = static_cast<std::size_t>(last - first);
+    }
+
+    // Steal other's heap block or copy its inline elements; other is left empty
+    void take(SmallVector& other) noexcept {
+        if (other.m_heap) {
+            m_heap = std::move(other.m_heap);
+            m_capacity = other.m_capacity;
+        } else {
+            std::memcpy(m_inline, other.m_inline, other.m_size * sizeof(T));
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+        other.m_capacity = N;
+    }
+
+    void grow(std::size_t capacity) {
+        auto heap = std::make_unique_for_overwrite<T[]>(capacity);
+        std::memcpy(heap.get(), data(), m_size * sizeof(T));
+        m_heap = std::move(heap);
+        m_capacity = capacity;
+    }
+
+    T m_inline[N]{};
+    std::unique_ptr<T[]> m_heap;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = N;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "MessageTemplate.h"
+
+// Who sees which line of a social. {0} in a line is the actor's name and
+// {1} the target's
+enum class SocialView : std::uint8_t {
+    Alone,      // The actor, with no target
+    AloneRoom,  // Everyone else in the room, likewise
+    Actor,      // The actor, at someone
+    Target,     // The one it is done to
+    Room,       // Everyone else
+    Self,       // The actor, at themselves
+    SelfRoom,   // Everyone else, likewise
+    Count
+};
+
+inline constexpr std::size_t kSocialViewCount = static_cast<std::size_t>(SocialView::Count);
+
+/**
+ * The socials, smile, bow and the rest, as a table rather than a command
+ * each: every line of every social is parsed into a MessageTemplate once,
+ * when the table is loaded, so acting one out is a hash probe for the
+ * verb and a render per line sent. The engine dispatches them all through
+ * its one socials command.
+ *
+ * A table is written a line per statement, as areas are (see
+ * AreaCompiler.h): blank lines and lines starting with # are skipped, and
+ * each social is its name and then its lines, keyed by who sees them.
+ * alone and alone-room are required; without actor, target and room the
+ * social cannot be done at someone, and without self and self-room doing
+ * it at yourself is the same as doing it alone:
+ *
+ *     social bow
+ *     alone      You bow deeply.
+ *     alone-room {0} bows deeply.
+ *     actor      You bow before {1}.
+ *     target     {0} bows before you.
+ *     room       {0} bows before {1}.
+ */
+class SocialTable {
+public:
+    struct Social {
+        std::string name;
+        std::array<std::optional<MessageTemplate>, kSocialViewCount> lines;
+
+        const MessageTemplate* line(SocialView view) const noexcept {
+            const auto& line = lines[static_cast<std::size_t>(view)];
+            return line ? &*line : nullptr;
+        }
+    };
+
+    // Every problem found, as "line N: message", one per line
+    static std::expected<SocialTable, std::string> parse(std::string_view text);
+    // The table the engine starts with
+    static const SocialTable& builtin();
+
+    const Social* find(std::string_view name) const {
+        const auto found = m_index.find(name);
+        return found != m_index.end() ? &m_socials[found->second] : nullptr;
+    }
+
+    // In order of name
+    std::span<const Social> socials() const noexcept { return m_socials; }
+    // Every name, laid out for the socials command
+    const std::string& list() const noexcept { return m_list; }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+    };
+
+    std::vector<Social> m_socials;
+    std::unordered_map<std::string, std::uint32_t, Hash, std::equal_to<>> m_index;
+    std::string m_list;
+};
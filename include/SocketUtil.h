@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+/**
+ * What the servers' POSIX sockets have in common: the reactors, the shard
+ * links, the TLS workers, the admin socket and the HTTP endpoints.
+ *
+ * A send never raises SIGPIPE where the platform has MSG_NOSIGNAL. Where it
+ * has not, net_server and mud_gateway ignore SIGPIPE, and the reactors set
+ * SO_NOSIGPIPE on each client socket as well.
+ */
+namespace SocketUtil {
+
+#if defined(MSG_NOSIGNAL)
+inline constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+inline constexpr int kSendFlags = 0;
+#endif
+
+// Non-blocking and closed on exec, as every server socket is
+inline bool setNonBlocking(int fd) {
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 && ::fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+}
+
+// All of bytes on a blocking socket; false once the peer is gone or the
+// socket's send timeout passes
+inline bool sendAll(int fd, std::string_view bytes) {
+    while (!bytes.empty()) {
+        const ssize_t sent = ::send(fd, bytes.data(), bytes.size(), kSendFlags);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(sent));
+    }
+    return true;
+}
+
+} // namespace SocketUtil
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Logger.h"
+
+/**
+ * Startup as a graph of named phases, each run once the phases it comes
+ * after have finished.
+ *
+ * Phases that do not depend on one another run at the same time: whenever
+ * some become ready, the thread that called run() takes the first for
+ * itself and starts a thread for each of the others, so binding listeners
+ * does not wait on a certificate being loaded or a journal being replayed.
+ * A phase can only come after phases added before it, so the graph has no
+ * cycles. Each phase's time is logged as it finishes, and the whole
+ * stage's once run() is done.
+ *
+ * The first phase to fail stops any more from starting; those already
+ * running finish, and run() returns its error. Phases share what they
+ * capture, so two that may run together must write different things, and
+ * none may throw.
+ */
+template <typename Error>
+class StartupPhases {
+public:
+    using Phase = std::size_t;
+    using Step = std::function<std::expected<void, Error>()>;
+
+    // stage begins each log line, such as "net_server"
+    explicit StartupPhases(std::string stage) : m_stage(std::move(stage)) {}
+
+    StartupPhases(const StartupPhases&) = delete;
+    StartupPhases& operator=(const StartupPhases&) = delete;
+
+    // Every phase in after is one add() already returned
+    Phase add(std::string name, const std::vector<Phase>& after, Step step) {
+        const Phase phase = m_phases.size();
+        m_phases.push_back({std::move(name), std::move(step), after.size(), {}});
+        for (const Phase before : after) {
+            m_phases[before].next.push_back(phase);
+        }
+        return phase;
+    }
+
+    // Once; returns after every phase started has finished
+    std::expected<void, Error> run() {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point started = Clock::now();
+        for (Phase phase = 0; phase < m_phases.size(); ++phase) {
+            if (m_phases[phase].waiting == 0) {
+                m_ready.push_back(phase);
+            }
+        }
+
+        std::vector<std::thread> threads;
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            if (!m_failure && !m_ready.empty()) {
+                const std::vector<Phase> ready = std::exchange(m_ready, {});
+                m_running += ready.size();
+                lock.unlock();
+                for (std::size_t i = 1; i < ready.size(); ++i) {
+                    threads.emplace_back([this, phase = ready[i]] { execute(phase); });
+                }
+                execute(ready.front());
+                lock.lock();
+                continue;
+            }
+            if (m_running == 0) {
+                break;
+            }
+            m_finished.wait(lock);
+        }
+        lock.unlock();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        LOG_INFO("{}: started in {:.1f} ms, {:.1f} ms of it in {} phases", m_stage, milliseconds(Clock::now() - started),
+                 milliseconds(m_busy), m_phases.size());
+        if (m_failure) {
+            return std::unexpected(std::move(*m_failure));
+        }
+        return {};
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        Step step;
+        std::size_t waiting;        // Phases before it still to finish
+        std::vector<Phase> next;    // Phases that come after it
+    };
+
+    static double milliseconds(std::chrono::steady_clock::duration time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
+    void execute(Phase phase) {
+        Entry& entry = m_phases[phase];
+        const std::chrono::steady_clock::time_point begun = std::chrono::steady_clock::now();
+        std::expected<void, Error> result = entry.step();
+        const std::chrono::steady_clock::duration took = std::chrono::steady_clock::now() - begun;
+        if (result) {
+            LOG_INFO("{}: {} in {:.1f} ms", m_stage, entry.name, milliseconds(took));
+        } else {
+            LOG_ERROR("{}: {} failed after {:.1f} ms", m_stage, entry.name, milliseconds(took));
+        }
+
+        const std::lock_guard lock(m_mutex);
+        --m_running;
+        m_busy += took;
+        if (!result) {
+            if (!m_failure) {
+                m_failure = std::move(result.error());
+            }
+        } else {
+            for (const Phase after : entry.next) {
+                if (--m_phases[after].waiting == 0) {
+                    m_ready.push_back(after);
+                }
+            }
+        }
+        m_finished.notify_one();
+    }
+
+    std::string m_stage;
+    std::vector<Entry> m_phases;
+
+    std::mutex m_mutex;                       // Guards what follows, and each entry's waiting during run()
+    std::condition_variable m_finished;
+    std::vector<Phase> m_ready;
+    std::size_t m_running = 0;
+    std::chrono::steady_clock::duration m_busy{};
+    std::optional<Error> m_failure;
+};
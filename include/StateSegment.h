@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+// At the start of the segment. Everything after it is found by offset from
+// the segment's start, never by address, so any process mapping it anywhere
+// reads the same thing
+struct StateSegmentHeader {
+    std::array<char, 8> magic{};
+    std::uint16_t version = 0;
+    std::uint16_t headerSize = 0;
+    std::uint32_t slotBytes = 0;      // Each slot's, its header included
+    std::uint32_t slotCount = 0;
+    std::uint32_t used = 0;           // Slots handed out, from the first
+    std::uint64_t token = 0;          // The run that last reset it
+    std::uint64_t nextSequence = 1;   // One past the newest record put
+    std::uint32_t overflowed = 0;     // Set once a record did not fit; the segment is not resumed from
+    std::uint32_t reserved = 0;
+};
+
+// At the start of each slot, before its key and then its image
+struct StateSlotHeader {
+    std::uint32_t seal = 0;        // Odd while the slot is being written
+    std::uint32_t checksum = 0;    // FNV-1a of the key and image
+    std::uint64_t sequence = 0;    // The journal's, for the image
+    std::uint32_t keySize = 0;
+    std::uint32_t imageSize = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<StateSegmentHeader> && sizeof(StateSegmentHeader) == 48);
+static_assert(std::is_trivially_copyable_v<StateSlotHeader> && sizeof(StateSlotHeader) == 24);
+
+/**
+ * The newest journaled image of every player, in a named POSIX shared-memory
+ * segment that outlives the process, so a restart after a crash can take
+ * them straight from memory instead of reading the journal back.
+ *
+ * Each key has a fixed-size slot, handed out in order the first time it is
+ * put and rewritten in place after that. A slot is sealed the way a seqlock
+ * is: its seal is odd from before the first byte changes until after the
+ * last, and the checksum covers the key and image, so a process dying mid
+ * write leaves a slot check() refuses. The header's token names the run
+ * that last reset the segment; the server records it beside the journal, so
+ * a segment some other run has since changed, or that fell behind a run
+ * journaling without it, is not taken for current.
+ *
+ * The segment is for a crashed process, not a crashed machine: it lives in
+ * memory only, and the journal is what survives a power cut.
+ *
+ * One process at a time, and one thread of it.
+ */
+class StateSegment {
+public:
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr std::size_t kSlotBytes = 8 * 1024;
+    static constexpr std::size_t kDefaultSlots = 4096;
+
+    // Map the segment called name ('/' is put in front if it is missing),
+    // made with room for slots keys if there is none yet, or why not. One
+    // that exists keeps the size it was made with; unlink() it to change that
+    static std::expected<std::unique_ptr<StateSegment>, std::string> open(std::string name,
+                                                                          std::size_t slots = kDefaultSlots);
+    // Remove the named segment; a process that has it mapped keeps it until it exits
+    static void unlink(std::string name);
+
+    ~StateSegment();
+
+    StateSegment(const StateSegment&) = delete;
+    StateSegment& operator=(const StateSegment&) = delete;
+
+    // Whether it holds a whole, untorn image of what the run known by token
+    // put, or why not
+    std::expected<void, std::string> check(std::uint64_t token) const;
+    // Call apply(key, sequence, image) for every key held; after check() passes
+    void each(const std::function<void(std::string_view, std::uint64_t, std::string_view)>& apply) const;
+    std::uint64_t nextSequence() const noexcept { return m_header->nextSequence; }
+
+    // Empty it, for the run known by token to put into from nextSequence on
+    void reset(std::uint64_t token, std::uint64_t nextSequence);
+    // Hold image as key's newest, put into the journal at sequence; false,
+    // and check() failing from then on, once the slots are all taken or the
+    // image is too big for one
+    bool put(std::string_view key, std::uint64_t sequence, std::string_view image);
+
+    const std::string& name() const noexcept { return m_name; }
+    std::size_t size() const noexcept { return m_header->used; }
+
+private:
+    StateSegment(std::string name, int fd, char* base, std::size_t bytes) noexcept;
+
+    StateSlotHeader& slot(std::size_t index) const noexcept;
+
+    std::string m_name;
+    int m_fd = -1;
+    char* m_base = nullptr;
+    std::size_t m_bytes = 0;
+    StateSegmentHeader* m_header = nullptr;
+    std::unordered_map<std::string, std::uint32_t> m_keys;     // Slot by key, since the last reset
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "CommandTask.h"
+
+// A column or parameter: SQL NULL, an integer, a real or text
+using StorageValue = std::variant<std::monostate, std::int64_t, double, std::string>;
+using StorageRow = std::vector<StorageValue>;
+
+struct StorageRows {
+    std::vector<StorageRow> rows;
+    std::int64_t changes = 0;          // Rows a write changed
+    std::int64_t lastInsertId = 0;
+};
+
+using StorageResult = std::expected<StorageRows, std::string>;
+
+// Totals since the database was opened
+struct StorageStats {
+    std::uint64_t reads = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t batches = 0;          // Write transactions committed
+    std::uint64_t failed = 0;
+    std::uint64_t cacheHits = 0;        // Lookups answered from memory
+    std::uint64_t cacheMisses = 0;
+    std::uint64_t prepared = 0;         // Statements compiled; the rest came from the statement cache
+    std::size_t queued = 0;             // Waiting for the thread now
+};
+
+/**
+ * A SQLite database, in WAL mode, that only one I/O thread ever touches.
+ *
+ * Callers queue statements and are called back on that thread with the
+ * rows. The thread takes whatever has queued up since it last looked, and
+ * runs the writes among it in one transaction, so a burst of writes costs
+ * one commit and one fsync. Reads between them run in the same pass, in
+ * queue order, so a read sees every write queued before it. Compiled
+ * statements are kept by their SQL text in a small LRU cache, so a
+ * statement run over and over is parsed once.
+ *
+ * A Lookup is a read through an LRU cache of results, keyed by the SQL and
+ * its parameters, for reads that far outnumber writes, such as account
+ * details. A hit never leaves the calling thread. Any write empties the
+ * cache when it is queued, so a lookup never returns rows older than a
+ * write queued before it. A result read before the write, but delivered
+ * after it, isn't cached either.
+ *
+ * future() and query() wrap the callbacks. query() is awaited in a
+ * Task: the coroutine is resumed on the game thread through an
+ * AsyncExecutor once the rows are in (see GameEngine::query).
+ *
+ * Built without SQLite, open() fails and nothing else is reachable.
+ */
+class Storage {
+public:
+    enum class Kind : std::uint8_t {
+        Read,
+        Lookup,   // A read answered from the result cache when it can be
+        Write
+    };
+
+    struct Options {
+        std::size_t cachedResults = 4096;      // Lookups kept; 0 turns the cache off
+        std::size_t cachedStatements = 64;
+        std::size_t maxBatch = 512;            // Statements a pass takes at most
+        std::chrono::milliseconds busyTimeout{5000};
+    };
+
+    using Callback = std::function<void(StorageResult)>;
+
+    static std::expected<std::unique_ptr<Storage>, std::string> open(const std::filesystem::path& path,
+                                                                      Options options);
+    static std::expected<std::unique_ptr<Storage>, std::string> open(const std::filesystem::path& path) {
+        return open(path, Options{});
+    }
+
+    // Runs what was queued, then closes the database
+    ~Storage();
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    // Any thread: run sql with params bound to its ?s in order. done runs on
+    // the I/O thread, or at once on the caller's for a cached lookup
+    void submit(Kind kind, std::string sql, std::vector<StorageValue> params, Callback done);
+
+    std::future<StorageResult> future(Kind kind, std::string sql, std::vector<StorageValue> params);
+
+    // co_await query(...) in a Task; the Task resumes on the executor's thread.
+    // Made with no storage, it fails at once, as where no database is open
+    class Query {
+    public:
+        Query(Storage* storage, AsyncExecutor& executor, Kind kind, std::string sql, std::vector<StorageValue> params)
+            : m_storage(storage), m_executor(executor), m_kind(kind), m_sql(std::move(sql)),
+              m_params(std::move(params)) {}
+
+        bool await_ready() {
+            if (!m_storage) {
+                m_result.emplace(std::unexpected(std::string("No database is open")));
+            } else if (m_kind == Kind::Lookup) {
+                // A cached lookup needs no trip through the thread
+                m_result = m_storage->cached(m_sql, m_params);
+            }
+            return m_result.has_value();
+        }
+        void await_suspend(std::coroutine_handle<> awaiting) {
+            m_executor.hold();
+            // Straight to the queue; await_ready has already missed the cache
+            m_storage->enqueue(m_kind, std::move(m_sql), std::move(m_params), [this, awaiting](StorageResult result) {
+                m_result.emplace(std::move(result));
+                m_executor.post(awaiting);
+            });
+        }
+        StorageResult await_resume() { return std::move(*m_result); }
+
+    private:
+        Storage* m_storage;
+        AsyncExecutor& m_executor;
+        Kind m_kind;
+        std::string m_sql;
+        std::vector<StorageValue> m_params;
+        std::optional<StorageResult> m_result;
+    };
+
+    Query query(AsyncExecutor& executor, Kind kind, std::string sql, std::vector<StorageValue> params) {
+        return Query(this, executor, kind, std::move(sql), std::move(params));
+    }
+
+    // The cached rows of a lookup, if it is cached
+    std::optional<StorageResult> cached(std::string_view sql, const std::vector<StorageValue>& params);
+
+    StorageStats stats() const;
+
+private:
+    struct Request {
+        Kind kind = Kind::Read;
+        std::string sql;
+        std::vector<StorageValue> params;
+        Callback done;
+        std::uint64_t generation = 0;   // The cache's when it was queued, for a lookup
+    };
+
+    struct Connection;   // The database and its statement cache; the I/O thread's alone
+
+    Storage(std::unique_ptr<Connection> connection, Options options);
+
+    void enqueue(Kind kind, std::string sql, std::vector<StorageValue> params, Callback done);
+    void run();
+    void runPass(std::vector<Request>& pass);
+    void remember(const Request& request, const StorageRows& rows);
+    static std::string cacheKey(std::string_view sql, const std::vector<StorageValue>& params);
+
+    Options m_options;
+    std::unique_ptr<Connection> m_connection;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Request> m_queue;
+    bool m_stopping = false;
+    StorageStats m_stats;
+
+    // Lookup results, most recent first; under m_cacheMutex
+    mutable std::mutex m_cacheMutex;
+    std::list<std::pair<std::string, StorageRows>> m_results;
+    std::unordered_map<std::string_view, std::list<std::pair<std::string, StorageRows>>::iterator> m_resultIndex;
+    std::uint64_t m_generation = 0;   // Bumped by every write queued
+    std::uint64_t m_cacheHits = 0;
+    std::uint64_t m_cacheMisses = 0;
+
+    std::thread m_thread;   // Last, so it starts once the rest is built
+};
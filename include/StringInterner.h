@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+#include "MemoryAccounting.h"
+
+// A string interned by StringInterner: equal strings, equal symbols
+using Symbol = std::uint32_t;
+inline constexpr Symbol kNoSymbol = 0;
+
+/**
+ * Hands out a stable 32-bit symbol per distinct string, so names that are
+ * compared and stored a lot, player names and command verbs, compare as
+ * integers and are held once however many places refer to them.
+ *
+ * The bytes are copied into blocks that are never moved or freed while the
+ * interner lives, so a view of a symbol stays valid; symbols are never
+ * taken back either, which suits names, of which there are only so many.
+ * Lookups hash into one of 16 shards, each an open-addressing table behind
+ * a reader-writer lock, so threads interning different names rarely wait
+ * on each other and finding a known one only takes a shared lock. view()
+ * takes no lock at all. Memory is counted against MemoryTag::World.
+ */
+class StringInterner {
+public:
+    StringInterner() = default;
+    ~StringInterner();
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // The one the engine's names go through
+    static StringInterner& global();
+
+    // The symbol for text, interning it if it's new
+    Symbol intern(std::string_view text);
+    // The symbol for text if it has one, kNoSymbol otherwise
+    Symbol find(std::string_view text) const;
+
+    // The text of a symbol this interner gave out; empty for kNoSymbol
+    std::string_view view(Symbol symbol) const noexcept {
+        if (symbol == kNoSymbol || (symbol >> kSegmentBits) >= kMaxSegments) {
+            return {};
+        }
+        const Entry* segment = m_segments[symbol >> kSegmentBits].load(std::memory_order_acquire);
+        if (!segment) {
+            return {};
+        }
+        const Entry& entry = segment[symbol & (kSegmentSize - 1)];
+        return {entry.data, entry.size};
+    }
+
+    // Distinct strings interned
+    std::size_t size() const noexcept { return m_next.load(std::memory_order_relaxed) - 1; }
+
+private:
+    static constexpr unsigned kShardBits = 4;
+    static constexpr unsigned kSegmentBits = 12;
+    static constexpr std::size_t kSegmentSize = std::size_t{1} << kSegmentBits;
+    static constexpr std::size_t kMaxSegments = 4096;        // 16M symbols
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+    struct Entry {
+        const char* data = nullptr;
+        std::uint32_t size = 0;
+    };
+
+    struct Slot {
+        std::uint32_t hash = 0;
+        Symbol symbol = kNoSymbol;   // kNoSymbol for an empty slot
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::vector<Slot> slots;     // A power of two in size, or empty
+        std::size_t used = 0;
+    };
+
+    static std::uint32_t hashOf(std::string_view text) noexcept;
+    Symbol probe(const Shard& shard, std::uint32_t hash, std::string_view text) const noexcept;
+    static void insert(Shard& shard, Slot slot);
+    Symbol store(std::string_view text);
+
+    std::array<Shard, std::size_t{1} << kShardBits> m_shards;
+
+    // Symbol to text, in segments that are allocated once and then stay put
+    std::array<std::atomic<Entry*>, kMaxSegments> m_segments{};
+    std::atomic<Symbol> m_next{1};
+
+    // The bytes, copied in as strings arrive; guarded with the symbol count
+    std::mutex m_storeMutex;
+    std::vector<TrackedBuffer> m_blocks;
+    char* m_cursor = nullptr;
+    std::size_t m_left = 0;
+};
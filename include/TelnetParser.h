@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Incremental telnet protocol parser (RFC 854/855), driven by a table.
+ *
+ * Each byte is classified (IAC, SB, SE, one of the four negotiation verbs,
+ * or anything else) and the pair of parser state and byte class picks the
+ * next state and one action from a constant table, so the per-byte cost is
+ * one lookup and no nested branching. Bytes may arrive split anywhere; the
+ * state carries over between feed() calls. The handler gets:
+ *
+ *   bool data(char ch)                                   a byte of user data
+ *   bool negotiate(unsigned char verb, unsigned char option)    WILL/WONT/DO/DONT
+ *   bool subnegotiate(unsigned char option, std::string_view payload)
+ *
+ * A handler returning false stops the feed. Escaped IAC bytes (IAC IAC) are
+ * unescaped in data and payloads alike. Other commands (NOP, GA, AYT and
+ * such) are dropped, and a payload past kMaxPayload is cut short there.
+ */
+class TelnetParser {
+public:
+    // Protocol bytes
+    static constexpr unsigned char kIac = 255;
+    static constexpr unsigned char kDont = 254;
+    static constexpr unsigned char kDo = 253;
+    static constexpr unsigned char kWont = 252;
+    static constexpr unsigned char kWill = 251;
+    static constexpr unsigned char kSb = 250;
+    static constexpr unsigned char kSe = 240;
+
+    static constexpr std::size_t kMaxPayload = 8 * 1024;
+
+    template <typename Handler>
+    bool feed(std::string_view bytes, Handler& handler) {
+        for (const char ch : bytes) {
+            const auto byte = static_cast<unsigned char>(ch);
+            const Transition step = kTable[static_cast<std::size_t>(m_state)][static_cast<std::size_t>(classify(byte))];
+            m_state = step.next;
+            switch (step.action) {
+                case Action::None:
+                    break;
+                case Action::Data:
+                    if (!handler.data(ch)) {
+                        return false;
+                    }
+                    break;
+                case Action::Verb:
+                    m_verb = byte;
+                    break;
+                case Action::Negotiate:
+                    if (!handler.negotiate(m_verb, byte)) {
+                        return false;
+                    }
+                    break;
+                case Action::BeginPayload:
+                    m_option = byte;
+                    m_payload.clear();
+                    break;
+                case Action::Payload:
+                    if (m_payload.size() < kMaxPayload) {
+                        m_payload.push_back(ch);
+                    }
+                    break;
+                case Action::EndPayload:
+                    if (!handler.subnegotiate(m_option, m_payload)) {
+                        return false;
+                    }
+                    // An idle session keeps no buffer
+                    m_payload = std::string();
+                    break;
+            }
+        }
+        return true;
+    }
+
+private:
+    enum class State : std::uint8_t { Data, Command, Option, PayloadOption, Payload, PayloadCommand, Count };
+    enum class ByteClass : std::uint8_t { Other, Iac, Sb, Se, Verb, Count };
+    enum class Action : std::uint8_t { None, Data, Verb, Negotiate, BeginPayload, Payload, EndPayload };
+
+    struct Transition {
+        State next;
+        Action action;
+    };
+
+    static constexpr ByteClass classify(unsigned char byte) noexcept {
+        if (byte == kIac) {
+            return ByteClass::Iac;
+        }
+        if (byte == kSb) {
+            return ByteClass::Sb;
+        }
+        if (byte == kSe) {
+            return ByteClass::Se;
+        }
+        return byte >= kWill && byte <= kDont ? ByteClass::Verb : ByteClass::Other;
+    }
+
+    static constexpr std::size_t kStates = static_cast<std::size_t>(State::Count);
+    static constexpr std::size_t kClasses = static_cast<std::size_t>(ByteClass::Count);
+
+    //                      Other                        IAC                           SB                              SE                             WILL/WONT/DO/DONT
+    static constexpr std::array<std::array<Transition, kClasses>, kStates> kTable = {{
+        /* Data */           {{{State::Data, Action::Data}, {State::Command, Action::None}, {State::Data, Action::Data}, {State::Data, Action::Data}, {State::Data, Action::Data}}},
+        /* Command */        {{{State::Data, Action::None}, {State::Data, Action::Data}, {State::PayloadOption, Action::None}, {State::Data, Action::None}, {State::Option, Action::Verb}}},
+        /* Option */         {{{State::Data, Action::Negotiate}, {State::Data, Action::Negotiate}, {State::Data, Action::Negotiate}, {State::Data, Action::Negotiate}, {State::Data, Action::Negotiate}}},
+        /* PayloadOption */  {{{State::Payload, Action::BeginPayload}, {State::Payload, Action::BeginPayload}, {State::Payload, Action::BeginPayload}, {State::Payload, Action::BeginPayload}, {State::Payload, Action::BeginPayload}}},
+        /* Payload */        {{{State::Payload, Action::Payload}, {State::PayloadCommand, Action::None}, {State::Payload, Action::Payload}, {State::Payload, Action::Payload}, {State::Payload, Action::Payload}}},
+        /* PayloadCommand */ {{{State::Payload, Action::None}, {State::Payload, Action::Payload}, {State::Payload, Action::None}, {State::Data, Action::EndPayload}, {State::Payload, Action::None}}},
+    }};
+
+    std::string m_payload;
+    State m_state = State::Data;
+    unsigned char m_verb = 0;
+    unsigned char m_option = 0;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "MemoryAccounting.h"
+
+/**
+ * Append-only text storage carved out of large fixed-size chunks.
+ *
+ * Text is copied into the newest chunk and referred to by a Span, so storing
+ * a message costs a memcpy rather than a heap allocation. Chunks are numbered
+ * in the order they were opened; once the oldest text still in use lives in
+ * chunk N, release(N) retires every earlier chunk to a small free list and
+ * the next chunk is reopened from it. A scrollback that slides along at a
+ * steady rate therefore cycles through the same few blocks of memory.
+ * Text larger than a chunk gets a chunk of its own. Chunks are counted
+ * against the arena's MemoryTag.
+ *
+ * Stored text never changes, so pin() lets another thread read it: the
+ * chunks stay alive while pinned and a pinned chunk is never recycled.
+ */
+class TextArena {
+public:
+    static constexpr std::size_t kDefaultChunkSize = 64 * 1024;
+
+    struct Span {
+        std::uint32_t chunk = 0;    // Sequence number of the owning chunk
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    explicit TextArena(std::size_t chunkSize = kDefaultChunkSize, MemoryTag tag = MemoryTag::Engine)
+        : m_chunkSize(chunkSize > 0 ? chunkSize : kDefaultChunkSize), m_tag(tag) {}
+
+    TextArena(TextArena&&) noexcept = default;
+    TextArena& operator=(TextArena&&) noexcept = default;
+
+    // Copy text into the arena; the span stays valid until its chunk is released
+    Span store(std::string_view text) {
+        if (text.empty()) {
+            return {m_chunks.empty() ? m_nextSeq : m_chunks.back().seq, 0, 0};
+        }
+        if (m_chunks.empty() || m_chunks.back().capacity - m_chunks.back().used < text.size()) {
+            openChunk(text.size());
+        }
+        Chunk& chunk = m_chunks.back();
+        std::memcpy(chunk.data.get() + chunk.used, text.data(), text.size());
+        Span span{chunk.seq, static_cast<std::uint32_t>(chunk.used), static_cast<std::uint32_t>(text.size())};
+        chunk.used += text.size();
+        return span;
+    }
+
+    std::string_view view(const Span& span) const noexcept {
+        if (span.length == 0) {
+            return {};
+        }
+        const Chunk& chunk = m_chunks[span.chunk - m_chunks.front().seq];
+        return {chunk.data.get() + span.offset, span.length};
+    }
+
+    // Retire every chunk older than oldestChunk; spans into them become invalid
+    void release(std::uint32_t oldestChunk) {
+        while (!m_chunks.empty() && static_cast<std::int32_t>(m_chunks.front().seq - oldestChunk) < 0) {
+            retire(std::move(m_chunks.front()));
+            m_chunks.pop_front();
+        }
+    }
+
+    // Drop all text; chunk memory is kept for reuse up to the free-list limit
+    void clear() {
+        while (!m_chunks.empty()) {
+            retire(std::move(m_chunks.front()));
+            m_chunks.pop_front();
+        }
+    }
+
+    // Keep every open chunk alive, and out of the free list, for as long as
+    // the pins are held; views of text stored so far stay readable from any thread
+    void pin(std::vector<std::shared_ptr<const char[]>>& pins) const {
+        for (const Chunk& chunk : m_chunks) pins.push_back(chunk.data);
+    }
+
+    std::size_t chunkCount() const noexcept { return m_chunks.size(); }
+
+    std::size_t bytesReserved() const noexcept {
+        std::size_t total = 0;
+        for (const Chunk& chunk : m_chunks) total += chunk.capacity;
+        for (const Chunk& chunk : m_free) total += chunk.capacity;
+        return total;
+    }
+
+private:
+    struct Chunk {
+        std::shared_ptr<char[]> data;   // Shared only with pin() holders
+        std::size_t capacity = 0;
+        std::size_t used = 0;
+        std::uint32_t seq = 0;
+    };
+
+    // Enough spare chunks for a sliding window to never touch the allocator
+    static constexpr std::size_t kMaxFreeChunks = 2;
+
+    void openChunk(std::size_t minimum) {
+        Chunk chunk;
+        if (minimum <= m_chunkSize && !m_free.empty()) {
+            chunk = std::move(m_free.back());
+            m_free.pop_back();
+        } else {
+            chunk.capacity = std::max(minimum, m_chunkSize);
+            chunk.data = std::shared_ptr<char[]>(makeTrackedBuffer(m_tag, chunk.capacity));
+        }
+        chunk.used = 0;
+        chunk.seq = m_nextSeq++;
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    void retire(Chunk&& chunk) {
+        // Oversized chunks go back to the allocator rather than pinning memory;
+        // a chunk pinned elsewhere is left to its last holder to free
+        if (chunk.capacity == m_chunkSize && m_free.size() < kMaxFreeChunks && chunk.data.use_count() == 1) {
+            m_free.push_back(std::move(chunk));
+        }
+    }
+
+    std::size_t m_chunkSize;
+    MemoryTag m_tag;
+    std::deque<Chunk> m_chunks;     // Open chunks, oldest first
+    std::vector<Chunk> m_free;      // Retired chunks of m_chunkSize bytes
+    std::uint32_t m_nextSeq = 0;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "FileView.h"
+#include "SharedMessage.h"
+
+// One version of a text file, mapped and never changed; whoever holds it
+// keeps the mapping, however often the file is replaced meanwhile
+struct MappedText {
+    FileView file;
+    std::vector<std::uint32_t> ends;   // Offset of each line's end, found once when mapped
+    SharedMessage whole;               // The text as one message, line breaks as '\n'
+
+    std::size_t size() const noexcept { return ends.size(); }
+    // Without its line break, or the CR of one written as CR LF
+    std::string_view line(std::size_t i) const noexcept;
+};
+
+// Totals since the files were first asked for
+struct TextFileStats {
+    std::uint64_t reads = 0;     // get() and message() calls that found a text
+    std::uint64_t maps = 0;      // Versions mapped, the first of each file included
+    std::uint64_t checks = 0;    // Times a file was stat()ed for a change
+};
+
+/**
+ * The long texts that are sent as they are written, such as the greeting
+ * and help files: DIR/motd.txt, DIR/help/combat.txt and so on, by name
+ * without the .txt.
+ *
+ * Each is mapped the first time it is asked for and its lines found then,
+ * and every request after that hands out the same MappedText by reference:
+ * nothing is read or copied per request, and a pager walks the line offsets
+ * straight out of the mapping. Sent whole, it is the one SharedMessage made
+ * when it was mapped, which each reactor encodes once per batch and links
+ * into every session's output, as it does a broadcast. A file asked for
+ * again once kRecheck has passed is stat()ed, and mapped afresh if its time
+ * or size changed; those still paging through the old version keep it
+ * until they are done. A name with no file, or an empty one, is not kept,
+ * so it is stat()ed each time it is asked for.
+ * Replace a file by writing a new one and renaming it over, as editors that
+ * save safely do, or a reader may see it half written.
+ *
+ * For any thread.
+ */
+class TextFiles {
+public:
+    static constexpr std::chrono::seconds kRecheck{2};
+
+    explicit TextFiles(std::filesystem::path directory);
+
+    // The named text, or null when there is no such file, it is empty or the
+    // name is not one (letters, digits, '-', '_' and '/' between parts)
+    std::shared_ptr<const MappedText> get(std::string_view name);
+
+    TextFileStats stats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<const MappedText> text;
+        std::filesystem::file_time_type modified{};
+        std::uintmax_t size = 0;
+        std::chrono::steady_clock::time_point checked{};
+    };
+
+    std::filesystem::path m_directory;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;   // By name; only files that were there and not empty
+    TextFileStats m_stats;
+};
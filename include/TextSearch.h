@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * Substring search over scrollback text, ignoring ASCII case.
+ *
+ * Candidates are found a vector at a time by comparing each block against
+ * the needle's first byte and, at the needle's length on, its last byte
+ * (AVX2 or SSE2 on x86, NEON on ARM, a scalar loop elsewhere), both with
+ * case folded out; only positions where both match are compared in full.
+ * Text that rarely holds the needle's ends is passed over at close to
+ * memory speed, with no per-byte branch.
+ */
+namespace TextSearch {
+
+// Offset of the first occurrence of needle in text at or after from, letters
+// of either case matching; npos when there is none. An empty needle matches
+// nothing.
+std::size_t find(std::string_view text, std::string_view needle, std::size_t from = 0) noexcept;
+
+} // namespace TextSearch
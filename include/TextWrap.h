@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One wrapped row: a slice of the original text, never a copy
+struct WrapSpan {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+// What wrapping needs to know about a text, measured once per message
+struct TextMetrics {
+    std::uint32_t columns = 0;   // Display width, newlines excluded
+    bool ascii = true;
+    bool multiline = false;
+};
+
+/**
+ * Word wrapping for the output window, in display columns.
+ *
+ * A message measured to fit on one row is a single span without scanning.
+ * For ASCII text, newlines and spaces are located in a single vectorized
+ * pass (AVX2 or SSE2 on x86, NEON on ARM, a scalar loop elsewhere), and rows
+ * are cut from those boundaries as they stream past. Other text is walked a
+ * UTF-8 code point at a time with its display widths. Either way ingesting
+ * a large dump costs one scan of the text and no per-line copies.
+ */
+namespace TextWrap {
+
+TextMetrics measure(std::string_view text) noexcept;
+
+// Append the rows of text wrapped to width columns: each line is split at its
+// last space within the width, or hard at the width when there is none.
+// Empty lines produce no rows. Rows are byte spans and never split a code point.
+void wrap(std::string_view text, int width, std::vector<WrapSpan>& rows, const TextMetrics& metrics);
+
+inline void wrap(std::string_view text, int width, std::vector<WrapSpan>& rows) {
+    wrap(text, width, rows, measure(text));
+}
+
+// Append text to out with each line wider than width columns broken into
+// rows as wrap() breaks it. Unlike wrap(), blank lines and every line break
+// are kept, so the result is the text as a terminal that wide should show
+// it. rows is scratch space.
+void wrapLines(std::string_view text, int width, std::string& out, std::vector<WrapSpan>& rows);
+
+} // namespace TextWrap
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// The threads a ThreadTopology places
+enum class ThreadRole : std::uint8_t {
+    Game,       // The thread running NetServer::run()
+    Reactors,   // One network thread per core, in turn
+    Workers,    // The engine's job system, one worker per core
+    Count
+};
+
+/**
+ * Which cores, and so which NUMA nodes, the server's threads run on.
+ *
+ * Given as roles and their cores, such as "game=0;reactors=1-7;workers=node1":
+ * each role's cores are a comma-separated list of cores, ranges of them and
+ * NUMA nodes (nodeN, every core the node has). A role left out runs on the
+ * cores no role names, so pinning the game thread alone keeps everything
+ * else off its core. Reactors and workers take one core each in turn; the
+ * game thread may run on any of its own.
+ *
+ * Memory follows the threads: Linux puts a page on the node of the core
+ * that first touches it, so a reactor's sessions, output chunks and pools
+ * land on its node when it builds them already placed there (see
+ * ScopedAffinity), and nothing needs libnuma.
+ *
+ * Placement is only applied on Linux; elsewhere every thread runs where
+ * the scheduler puts it.
+ */
+class ThreadTopology {
+public:
+    // Empty, leaving every thread to the scheduler
+    ThreadTopology() = default;
+
+    // A description of what is wrong with the spec on failure
+    static std::expected<ThreadTopology, std::string> parse(std::string_view spec);
+
+    bool empty() const noexcept { return !m_configured; }
+
+    // Cores the role runs on, those no role names if it was left out; empty
+    // when nothing was configured
+    std::span<const int> cores(ThreadRole role) const noexcept;
+
+    // The core of a role's index-th thread, cycling through its cores; -1 for anywhere
+    int core(ThreadRole role, std::size_t index) const noexcept;
+
+    // Log where each thread goes, with the node of each core
+    void report(std::size_t reactors, std::size_t workers) const;
+
+    // The NUMA node a core belongs to; -1 where it cannot be told
+    static int nodeOf(int core);
+
+    // Restrict a thread to cores; false where it could not be, or cores is empty
+    static bool pin(std::thread::native_handle_type thread, std::span<const int> cores);
+    static bool pinCurrent(std::span<const int> cores);
+
+private:
+    static constexpr std::size_t kRoles = static_cast<std::size_t>(ThreadRole::Count);
+
+    std::array<std::vector<int>, kRoles> m_cores{};
+    bool m_configured = false;
+};
+
+// Keeps the calling thread on some cores until it goes out of scope, so
+// memory it touches meanwhile comes from their node; no cores does nothing
+class ScopedAffinity {
+public:
+    explicit ScopedAffinity(std::span<const int> cores);
+    ~ScopedAffinity();
+
+    ScopedAffinity(const ScopedAffinity&) = delete;
+    ScopedAffinity& operator=(const ScopedAffinity&) = delete;
+
+private:
+#if defined(__linux__)
+    cpu_set_t m_previous{};
+#endif
+    bool m_restore = false;
+};
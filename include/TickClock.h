@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * The time as of the current tick or frame, for paths that stamp many events.
+ *
+ * Whatever drives a loop (GameEngine::idle(), the console's frame loop)
+ * calls advance() once a pass, as it wakes; everything else reads the
+ * sampled monotonic and wall time with a relaxed load instead of asking
+ * the OS. Before the first advance() the readers fall back to the real
+ * clocks, so a tool that never runs a loop still sees the right time.
+ *
+ * A reading is as old as the pass, which suits history stamps, save
+ * times and the like, not measuring how long something took.
+ */
+class TickClock {
+public:
+    // Sample both clocks; returns the monotonic reading
+    static std::chrono::steady_clock::time_point advance() noexcept {
+        const auto steady = std::chrono::steady_clock::now();
+        const auto wall = std::chrono::system_clock::now();
+        // Loops on several threads advance the clock; it never goes back
+        std::int64_t seen = s_steady.load(std::memory_order_relaxed);
+        const std::int64_t ticks = steady.time_since_epoch().count();
+        while (seen < ticks && !s_steady.compare_exchange_weak(seen, ticks, std::memory_order_relaxed)) {
+        }
+        s_wall.store(wall.time_since_epoch().count(), std::memory_order_relaxed);
+        return steady;
+    }
+
+    static std::chrono::steady_clock::time_point monotonic() noexcept {
+        const std::int64_t ticks = s_steady.load(std::memory_order_relaxed);
+        return ticks != 0 ? std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ticks))
+                          : std::chrono::steady_clock::now();
+    }
+
+    static std::chrono::system_clock::time_point wall() noexcept {
+        const std::int64_t ticks = s_wall.load(std::memory_order_relaxed);
+        return ticks != 0 ? std::chrono::system_clock::time_point(std::chrono::system_clock::duration(ticks))
+                          : std::chrono::system_clock::now();
+    }
+
+    // Seconds since the Unix epoch
+    static std::uint64_t wallSeconds() noexcept {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::seconds>(wall().time_since_epoch()).count());
+    }
+
+private:
+    // Clock ticks since each clock's epoch; 0 until the first advance()
+    static inline std::atomic<std::int64_t> s_steady{0};
+    static inline std::atomic<std::int64_t> s_wall{0};
+};
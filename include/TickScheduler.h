@@ -0,0 +1,279 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "InlineDelegate.h"
+#include "PerfCounters.h"
+#include "ScratchArena.h"
+#include "TimingWheel.h"
+
+using TickUpdateId = std::uint32_t;
+inline constexpr TickUpdateId kInvalidTickUpdateId = 0;
+
+// Whoever queued a command: a front end's key for a connection
+using SessionId = std::uint64_t;
+
+// What became of a line handed to TickScheduler::enqueue
+enum class EnqueueResult : std::uint8_t {
+    Queued,
+    QueueFull,   // The session already has kMaxQueuedCommands waiting
+    Throttled    // The session is sending faster than its rate limit
+};
+
+// Which sessions a tick serves first when its budget will not reach them
+// all; a session's turn ranks by the line it would run next
+enum class CommandPriority : std::uint8_t {
+    Urgent,   // Admins', and moving and fighting, which a player feels at once
+    Normal,
+    Bulk,     // Long listings such as who and help, which can wait a tick
+    Count
+};
+
+inline constexpr std::size_t kCommandPriorityCount = static_cast<std::size_t>(CommandPriority::Count);
+
+// How far a run of slow ticks has pushed the scheduler into shedding work,
+// worst last; the engine and front ends look at it before optional work
+enum class LoadStage : std::uint8_t {
+    Normal,
+    Deferring,    // Ambient work waits: NPC wandering, room player lists sent out of band
+    Throttling    // As well, commands get half the budget and sessions half their rate
+};
+
+// Totals since the scheduler was made; times are summed over every tick
+struct TickStats {
+    std::uint64_t ticks = 0;
+    std::uint64_t overruns = 0;           // Ticks that took longer than the period
+    std::uint64_t missed = 0;             // Boundaries skipped because the previous tick ran late
+    std::uint64_t timersRun = 0;
+    std::uint64_t commandsRun = 0;
+    std::uint64_t commandsDeferred = 0;   // Left for a later tick once the command budget was spent
+    std::uint64_t commandsDropped = 0;    // Refused because the session's queue was full
+    std::uint64_t commandsThrottled = 0;  // Refused because the session ran out of tokens
+    std::uint64_t turnsWaited = 0;        // Turns a session passed up while in a wait state
+    std::uint64_t ticksDeferring = 0;     // Ticks run at LoadStage::Deferring
+    std::uint64_t ticksThrottling = 0;    // Ticks run at LoadStage::Throttling
+    std::chrono::nanoseconds updateTime{};   // Timers and updates
+    std::chrono::nanoseconds commandTime{};
+    std::chrono::nanoseconds longestTick{};
+};
+
+/**
+ * Fixed-rate game clock.
+ *
+ * World updates (regeneration, NPC actions, timed effects) register with an
+ * interval in ticks and run at the boundaries of a fixed period, whatever
+ * the players are doing. One-off delays (durations, respawns, timeouts) are
+ * Timers on the scheduler's TimingWheel, which counts boundaries, so a
+ * timer keeps to the clock even across ticks that ran late; due timers run
+ * just before the updates. Player commands do not run the moment they
+ * arrive: front ends queue them per session and the scheduler drains the
+ * queues at each boundary after the updates, one command per session per tick in
+ * round-robin order, so a player pasting a screenful of commands cannot
+ * starve the others and every command sees the world as that tick left it.
+ * Commands are given a share of the period; whatever the budget does not
+ * reach waits for the next tick rather than making this one late. With a
+ * classifier set, each line is ranked by CommandPriority as it is queued
+ * and a tick takes its sessions Urgent first, then Normal, then Bulk, in
+ * turn order within each, so what the budget leaves behind is the bulk
+ * work. A line is promoted a rank for every kAgingTicks it has waited, so
+ * a listing is late under load but never starved. How long each line
+ * waited is recorded per rank (MetricHistogram::QueueDelayUrgent onwards).
+ *
+ * Flood control is per session and costs the same for every line. Each
+ * session has a token bucket, topped up by the boundaries since it last
+ * sent and charged one token per line before the line is even stored, so
+ * a client past its rate is refused without being parsed. A command may
+ * also put its session into a wait state, the MUD "lag" after a heavy
+ * action: the session keeps its turn in the rotation but runs nothing until
+ * the wait is over, and its lines stay queued meanwhile.
+ *
+ * Under load the scheduler sheds work in stages rather than fall behind.
+ * It keeps a moving average of tick time, counting a tick that missed
+ * boundaries as a whole period, and moves to LoadStage::Deferring once
+ * the average reaches three quarters of the period, then to Throttling
+ * once it reaches the period itself; each stage is left only when the
+ * average is back a quarter of a period below where it began, so the
+ * stage does not flap on one quick tick.
+ *
+ * Boundaries stay on one grid from construction. A tick that runs past the
+ * next boundary skips it instead of running twice to catch up. While nothing
+ * is registered, queued or pending the scheduler asks for no wake-ups at all.
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    // Called with the number of the tick being run
+    using Update = InlineDelegate<void(std::uint64_t)>;
+    // Runs one queued line for a session; may queue more or drop the session
+    using CommandRunner = InlineDelegate<void(SessionId, std::string&)>;
+    // Called once a tick's commands have all been handed to the runner
+    using CommandFlush = InlineDelegate<void()>;
+    // Ranks a line as it is queued; see CommandPriority
+    using CommandClassifier = InlineDelegate<CommandPriority(SessionId, std::string_view)>;
+
+    static constexpr Clock::duration kDefaultPeriod = std::chrono::milliseconds(100);
+    static constexpr std::size_t kMaxQueuedCommands = 32;   // Per session
+    static constexpr std::uint32_t kDefaultRateLimit = 10;   // Lines per second, roughly what a tick drains
+    static constexpr std::size_t kScratchSize = 64 * 1024;
+    static constexpr std::uint32_t kAgingTicks = 5;   // Waited per rank a line is promoted
+
+    explicit TickScheduler(Clock::duration period = kDefaultPeriod);
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    // Run update every interval ticks (at least 1); safe to call from inside an update
+    TickUpdateId addUpdate(unsigned interval, Update update);
+    void removeUpdate(TickUpdateId id);
+
+    // Run timer at the boundary delay ticks from the latest one (the next
+    // for 0); moves it if it is already pending. Cancel it through the timer
+    void schedule(Timer& timer, std::uint64_t delay);
+    std::size_t pendingTimers() const noexcept { return m_timers.pending(); }
+
+    // Index of the latest boundary on the grid, whether or not a tick ran
+    // there; timers count in these, and so does anything fast-forwarded
+    std::uint64_t boundary() const { return m_idle ? boundaryIndex(currentTime()) : m_timers.now(); }
+    // When boundary runs, on the grid
+    Clock::time_point boundaryTime(std::uint64_t boundary) const { return m_origin + boundary * m_period; }
+    // Whether run() is running a tick, the updates or the commands
+    bool ticking() const noexcept { return m_ticking; }
+
+    // Memory for passing work during a tick, such as text formatted to be
+    // copied on; all of it is taken back as the tick ends. Only while ticking()
+    std::pmr::memory_resource& scratch() noexcept { return m_scratch.resource(); }
+
+    // From now on the grid follows the time given here rather than the
+    // clock, so a replay driven faster or slower than real time still sees
+    // the same boundaries; run() moves it on to the time it is given too
+    void setTime(Clock::time_point now) noexcept {
+        m_manualClock = true;
+        m_now = now;
+    }
+
+    // A runner that only collects lines runs them together in flush, which
+    // then counts as command time
+    void setCommandRunner(CommandRunner runner, CommandFlush flush = nullptr) {
+        m_runner = std::move(runner);
+        m_flush = std::move(flush);
+    }
+
+    // Without one every line is Normal, and turns go in plain rotation
+    void setCommandClassifier(CommandClassifier classifier) { m_classifier = std::move(classifier); }
+
+    // Share of each period commands may use; the rest is left to updates and I/O
+    void setCommandBudget(Clock::duration budget) noexcept { m_commandBudget = budget; }
+
+    // Sustained lines per second each session may send, and how many it
+    // may send at once after a quiet spell; 0 turns rate limiting off
+    void setRateLimit(std::uint32_t perSecond, std::uint32_t burst = kMaxQueuedCommands);
+
+    // Queue a line to run at a coming tick, unless the session is over its
+    // rate or already has kMaxQueuedCommands waiting; a refused line is dropped
+    EnqueueResult enqueue(SessionId session, std::string line);
+
+    // Hold back the session's next command by ticks more than it would have
+    // waited anyway; a wait already longer is left alone
+    void delaySession(SessionId session, std::uint32_t ticks);
+
+    // Forget a session's queue, tokens and wait state; front ends call this
+    // when the connection goes
+    void dropSession(SessionId session);
+    std::size_t queuedCommands(SessionId session) const;
+    // The lines a session has waiting, in order, taken from its queue
+    std::vector<std::string> takeQueued(SessionId session);
+
+    // Run the tick due by now, if any. Returns when the next one is due, or
+    // time_point::max() when nothing is registered, queued or pending
+    Clock::time_point run(Clock::time_point now);
+    Clock::time_point nextTick() const;
+
+    Clock::duration period() const noexcept { return m_period; }
+    LoadStage loadStage() const noexcept { return m_stage; }
+    std::uint64_t tickCount() const noexcept { return m_stats.ticks; }
+    const TickStats& stats() const noexcept { return m_stats; }
+
+    // Hardware counters over each tick's timers and updates, and over its
+    // commands, while PerfCounters is enabled
+    const PerfTotals& updateCounters() const noexcept { return m_updateCounters; }
+    const PerfTotals& commandCounters() const noexcept { return m_commandCounters; }
+    void resetCounters() noexcept {
+        m_updateCounters.reset();
+        m_commandCounters.reset();
+    }
+
+private:
+    struct UpdateEntry {
+        TickUpdateId id;
+        unsigned interval;
+        Update update;
+    };
+
+    // Lines before head have run. Kept from a session's first line until
+    // dropSession, so its tokens and wait state survive an empty queue
+    struct QueuedStamp {
+        Clock::time_point at;
+        CommandPriority priority;
+    };
+    struct CommandQueue {
+        std::vector<std::string> lines;
+        std::vector<QueuedStamp> stamps;   // One per line
+        std::size_t head = 0;
+        std::uint32_t tokens = 0;      // Lines it may still send, 16.16 fixed point
+        std::uint64_t refilled = 0;    // Boundary the tokens were last topped up at
+        std::uint64_t readyAt = 0;     // First boundary its next command may run at
+        bool listed = false;           // In m_ready or m_waiting
+    };
+
+    bool busy() const noexcept { return !m_updates.empty() || !m_ready.empty() || m_timers.pending() != 0; }
+    Clock::time_point currentTime() const { return m_manualClock ? m_now : Clock::now(); }
+    std::uint64_t boundaryIndex(Clock::time_point boundary) const { return (boundary - m_origin) / m_period; }
+    Clock::time_point boundaryAfter(Clock::time_point now) const;
+    void wake();
+    void runUpdates();
+    void runCommands(Clock::time_point start);
+    void rankTurns(Clock::time_point now);
+    void updateLoad(Clock::duration took);
+
+    Clock::duration m_period;
+    Clock::duration m_commandBudget;
+    Clock::time_point m_origin;
+    Clock::time_point m_next;
+    bool m_idle = true;   // m_next is stale until the first boundary after work arrives
+    bool m_ticking = false;
+    bool m_manualClock = false;   // Following setTime()
+    Clock::time_point m_now{};
+
+    TimingWheel m_timers;                        // In boundaries since m_origin
+    std::vector<UpdateEntry> m_updates;
+    std::vector<UpdateEntry> m_pendingUpdates;   // Added while the updates were running
+    TickUpdateId m_nextUpdateId = 1;
+    bool m_runningUpdates = false;
+    bool m_needsCompaction = false;
+
+    ScratchArena m_scratch{kScratchSize};
+
+    CommandRunner m_runner;
+    CommandFlush m_flush;
+    CommandClassifier m_classifier;
+    std::uint32_t m_refill = 0;      // Tokens gained per boundary, 16.16; 0 when unlimited
+    std::uint32_t m_burst = 0;       // Bucket size, 16.16
+    std::unordered_map<SessionId, CommandQueue> m_queues;
+    std::vector<SessionId> m_ready;    // Sessions with queued lines, in turn order
+    std::vector<SessionId> m_waiting;  // Swapped with m_ready while a tick runs its commands
+    std::array<std::vector<SessionId>, kCommandPriorityCount> m_ranked;   // Scratch for rankTurns()
+
+    // Average tick time, an exponential moving average over about 8 ticks
+    Clock::duration m_load{};
+    LoadStage m_stage = LoadStage::Normal;
+
+    TickStats m_stats;
+    PerfTotals m_updateCounters;
+    PerfTotals m_commandCounters;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "InlineDelegate.h"
+
+class TimingWheel;
+
+// Link in a wheel slot's circular list; a slot's own link is its sentinel
+struct TimerLink {
+    TimerLink* prev = nullptr;
+    TimerLink* next = nullptr;
+};
+
+/**
+ * A callback to run at a later tick, embedded in whatever owns it.
+ *
+ * The timer is its own list node, so scheduling and cancelling neither
+ * allocate nor search: a timer is linked into one wheel slot and unlinked in
+ * constant time. It may be rescheduled from its own callback but not
+ * destroyed by it, and it cancels itself when destroyed. Timers hold their wheel's address and so cannot be
+ * copied or moved.
+ */
+class Timer : private TimerLink {
+public:
+    using Callback = InlineDelegate<void()>;
+
+    Timer() = default;
+    explicit Timer(Callback callback) : m_callback(std::move(callback)) {}
+    ~Timer() { cancel(); }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    void setCallback(Callback callback) { m_callback = std::move(callback); }
+
+    bool pending() const noexcept { return m_wheel != nullptr; }
+    // The tick it is due at; meaningful while pending
+    std::uint64_t expires() const noexcept { return m_expires; }
+
+    void cancel() noexcept;
+
+private:
+    friend class TimingWheel;
+
+    std::uint64_t m_expires = 0;
+    TimingWheel* m_wheel = nullptr;
+    Callback m_callback;
+};
+
+/**
+ * Hierarchical timing wheel: every pending timer at O(1) per operation.
+ *
+ * Four wheels of 256, 64, 64 and 64 slots cover 2^26 ticks (about a week at
+ * ten ticks a second). A timer goes into the slot of the coarsest wheel its
+ * remaining time needs; when a finer wheel wraps, the next slot of the wheel
+ * above is emptied into the finer ones, so each timer is moved at most once
+ * per level on its way down and a tick only touches the timers that are due
+ * or being cascaded, however many are pending. Timers further out than the
+ * wheels reach wait in the last slot of the top wheel and are placed again
+ * each time it comes round.
+ */
+class TimingWheel {
+public:
+    explicit TimingWheel(std::uint64_t now = 0);
+    ~TimingWheel();
+
+    // Timers and slots point at one another
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // Run timer delay ticks from now (at the next tick for 0), moving it if
+    // it is already pending, here or on another wheel
+    void schedule(Timer& timer, std::uint64_t delay);
+
+    // Run every timer due up to and including tick now, in tick order;
+    // returns how many ran. Callbacks may schedule and cancel freely
+    std::size_t advance(std::uint64_t now);
+
+    // Move the clock without running anything; only while nothing is pending
+    void rebase(std::uint64_t now) noexcept;
+
+    std::uint64_t now() const noexcept { return m_now; }
+    std::size_t pending() const noexcept { return m_pending; }
+
+private:
+    friend class Timer;
+
+    static constexpr unsigned kLevels = 4;
+    static constexpr unsigned kFirstBits = 8;
+    static constexpr unsigned kLevelBits = 6;
+    static constexpr std::size_t kSlotCount = (std::size_t{1} << kFirstBits) + (kLevels - 1) * (std::size_t{1} << kLevelBits);
+    static constexpr std::uint64_t kRange = std::uint64_t{1} << (kFirstBits + (kLevels - 1) * kLevelBits);
+
+    // Bits of a tick below the ones that pick its slot at level
+    static constexpr unsigned shiftOf(unsigned level) noexcept {
+        return level == 0 ? 0 : kFirstBits + (level - 1) * kLevelBits;
+    }
+
+    static constexpr std::size_t slotOf(unsigned level, std::uint64_t tick) noexcept {
+        if (level == 0) {
+            return static_cast<std::size_t>(tick & ((std::uint64_t{1} << kFirstBits) - 1));
+        }
+        return (std::size_t{1} << kFirstBits) + (level - 1) * (std::size_t{1} << kLevelBits) +
+               static_cast<std::size_t>((tick >> shiftOf(level)) & ((std::uint64_t{1} << kLevelBits) - 1));
+    }
+
+    void place(Timer& timer);
+    void cascade(unsigned level);
+    void unlink(Timer& timer) noexcept;
+
+    std::array<TimerLink, kSlotCount> m_slots;   // Level by level, finest first
+    std::uint64_t m_now;
+    std::size_t m_pending = 0;
+};
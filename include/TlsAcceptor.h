@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NetReactor.h"
+
+struct ssl_ctx_st;
+struct ssl_st;
+
+// Handshakes TlsAcceptor has finished, by where the records went
+struct TlsStats {
+    std::uint64_t kernel = 0;     // Both directions in the kernel
+    std::uint64_t partial = 0;    // One direction in the kernel, the other in userspace
+    std::uint64_t userspace = 0;
+    std::uint64_t failed = 0;     // Refused, timed out or not TLS at all
+};
+
+/**
+ * TLS for telnet clients (as Mudlet's "secure" connections speak it) on a
+ * port of its own.
+ *
+ * A fixed set of workers takes connections off the listening socket and
+ * carries their handshakes, certificate signatures and all, through to
+ * completion or the timeout, each worker up to kMaxHandshakes at once on
+ * non-blocking sockets, so a client that stalls mid-handshake holds up no
+ * one else. A storm of new connections queues in the listen backlog and at
+ * the workers rather than stalling a reactor whose sessions are already
+ * playing. Built with kernel TLS, OpenSSL hands the session keys to
+ * the socket once the handshake is done; the worker then hands the socket
+ * to the reactor with the fewest sessions, which reads and writes plain
+ * text on it from then on, io_uring sends and all. A direction the kernel
+ * could not take is left to a TlsStream that travels with the session.
+ *
+ * TLS sessions are offered no MCCP2: compressing before encrypting lets an
+ * eavesdropper guess at secrets from record sizes.
+ */
+class TlsAcceptor {
+public:
+    static constexpr std::size_t kMaxHandshakes = 256;   // Under way at once, per worker
+
+    struct Config {
+        std::string address;
+        std::uint16_t port = 0;
+        std::string certificate;   // PEM, the chain after the server's own
+        std::string key;           // PEM private key
+        unsigned workers = 2;
+        std::chrono::milliseconds handshakeTimeout = std::chrono::seconds(10);
+        bool kernelTls = true;     // Have OpenSSL try kernel TLS after each handshake
+        // Banned addresses are closed before any handshake; the reactor
+        // the session goes to applies the rest
+        const AccessControl* access = nullptr;
+    };
+
+    // Listening, with the certificate and key loaded; start() sets the
+    // workers going. Sessions go to reactors, which outlive this
+    static std::expected<std::unique_ptr<TlsAcceptor>, NetError> create(const Config& config,
+                                                                       std::vector<NetReactor*> reactors);
+
+    ~TlsAcceptor();
+
+    TlsAcceptor(const TlsAcceptor&) = delete;
+    TlsAcceptor& operator=(const TlsAcceptor&) = delete;
+
+    void start();
+    // Stops the workers; handshakes under way are abandoned
+    void stop();
+
+    // Any thread
+    TlsStats stats() const noexcept;
+
+private:
+    TlsAcceptor(const Config& config, std::vector<NetReactor*> reactors);
+
+    struct Handshake {
+        int fd;
+        ssl_st* ssl;
+        std::chrono::steady_clock::time_point deadline;
+        short events;   // What SSL_accept waits for
+    };
+
+    void work();
+    void accept(std::vector<Handshake>& handshakes);
+    bool advance(Handshake& handshake);
+    void fail(Handshake& handshake);
+    void finish(Handshake& handshake);
+    // The reactor with the fewest sessions
+    NetReactor& pickReactor() const noexcept;
+
+    Config m_config;
+    std::vector<NetReactor*> m_reactors;
+    ssl_ctx_st* m_context = nullptr;
+    int m_listenFd = -1;
+    std::array<int, 2> m_stopPipe{-1, -1};   // Readable once stop() is called, waking every worker
+    std::vector<std::thread> m_workers;
+
+    std::atomic<std::uint64_t> m_kernel{0};
+    std::atomic<std::uint64_t> m_partial{0};
+    std::atomic<std::uint64_t> m_userspace{0};
+    std::atomic<std::uint64_t> m_failed{0};
+};
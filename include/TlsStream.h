@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct ssl_st;
+
+/**
+ * The userspace half of one TLS session, after TlsAcceptor's handshake.
+ *
+ * With kernel TLS the socket itself encrypts and decrypts once the
+ * handshake is done, and the reactor reads and writes plain text on it.
+ * Whichever direction the kernel did not take over (no tls module, a
+ * cipher it lacks, or records already read ahead) goes on here instead,
+ * over memory BIOs: decrypt() takes what the socket read and encrypt()
+ * the output staged at each flush, so the reactor keeps its own reads,
+ * io_uring receives and chunked sends either way. Buffers are released
+ * between records, so an idle session costs a few hundred bytes.
+ */
+class TlsStream {
+public:
+    // Takes ssl, handshake done on its descriptor. nullptr, with ssl
+    // freed, when the kernel does both directions and nothing is left here
+    static std::unique_ptr<TlsStream> adopt(ssl_st* ssl);
+
+    ~TlsStream();
+
+    TlsStream(const TlsStream&) = delete;
+    TlsStream& operator=(const TlsStream&) = delete;
+
+    // Whether the socket carries records this stream has to open or seal
+    bool decrypts() const noexcept { return m_decrypts; }
+    bool encrypts() const noexcept { return m_encrypts; }
+
+    // Append the plain text of records to out; false on a TLS error or
+    // once the client has closed the session
+    bool decrypt(std::string_view records, std::string& out);
+
+    // Append text, sealed into records, to out, along with any records the
+    // stream owes the client (alerts, key updates); text may be empty
+    bool encrypt(std::string_view text, std::string& out);
+
+    // Records the stream has made on its own since the last encrypt()
+    bool owes() const noexcept;
+
+    // Append a close_notify to out, once
+    void close(std::string& out);
+
+private:
+    TlsStream(ssl_st* ssl, bool decrypts, bool encrypts) noexcept;
+
+    bool drain(std::string& out);
+
+    ssl_st* m_ssl;
+    bool m_decrypts;
+    bool m_encrypts;
+    bool m_closed = false;
+};
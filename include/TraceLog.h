@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "FileView.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, "Trace files are little-endian");
+
+// TRACE_EVENT("command {} by player {}", verb, player). Costs one relaxed
+// load when no trace is running. Arguments are integers, floating point or
+// text, of which the first 8 bytes are kept; at most kTraceArgs of them
+#define TRACE_EVENT(format, ...)                                                 \
+    do {                                                                         \
+        if (TraceLog* const trace_ = TraceLog::active()) {                       \
+            static const std::uint16_t traceEvent_ = TraceLog::define(format);   \
+            trace_->record(traceEvent_ __VA_OPT__(,) __VA_ARGS__);               \
+        }                                                                        \
+    } while (0)
+
+inline constexpr std::size_t kTraceArgs = 6;
+
+enum class TraceArg : std::uint8_t { UInt, Int, Double, Text };
+
+// One event as it lies in a trace file
+struct TraceRecord {
+    std::uint64_t ticks = 0;      // See TraceChunkHeader
+    std::uint16_t event = 0;      // Index into the file's format strings, from 1
+    std::uint16_t reserved = 0;
+    std::uint8_t argCount = 0;
+    std::uint8_t reserved2 = 0;
+    std::uint16_t kinds = 0;      // A TraceArg in each two bits, first argument lowest
+    std::uint64_t args[kTraceArgs] = {};
+};
+
+// The first record-sized slot of every chunk
+struct TraceChunkHeader {
+    std::uint64_t generation = 0;   // One more than the claim that took it; 0 for never
+    std::uint32_t thread = 0;       // Small number given each tracing thread
+    std::uint32_t count = 0;        // Records written, published after each
+    std::uint64_t claimTicks = 0;   // The clock as ticks and steady nanoseconds when claimed,
+    std::uint64_t claimSteady = 0;  // so a reader can turn ticks into time
+    std::uint64_t reserved[4] = {};
+};
+
+// Fixed-layout start of a trace file
+struct TraceFileHeader {
+    char magic[8] = {'E', 'M', 'T', 'R', 'A', 'C', 'E', '1'};
+    std::uint32_t version = 1;
+    std::uint32_t recordSize = sizeof(TraceRecord);
+    std::uint32_t chunkRecords = 0;   // Slots per chunk, the header's included
+    std::uint32_t chunkCount = 0;
+    std::uint64_t eventsOffset = 0;   // Format strings: u16 id, u16 size, text, padded to 4
+    std::uint64_t eventsCapacity = 0;
+    std::uint64_t eventsUsed = 0;     // Bytes, published after each format string
+    std::uint64_t chunksOffset = 0;
+    std::uint64_t nextChunk = 0;      // Claims so far; chunk = claim % chunkCount
+    std::uint64_t startTicks = 0;
+    std::uint64_t startSteady = 0;    // Nanoseconds
+    std::uint64_t startSystem = 0;    // Nanoseconds since the epoch
+    std::uint32_t ticksAreNanoseconds = 0;
+    std::uint32_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<TraceRecord> && sizeof(TraceRecord) == 64);
+static_assert(std::is_trivially_copyable_v<TraceChunkHeader> && sizeof(TraceChunkHeader) == sizeof(TraceRecord));
+static_assert(std::is_trivially_copyable_v<TraceFileHeader> && sizeof(TraceFileHeader) == 96);
+
+// The time stamp counter where there is one, otherwise steady nanoseconds
+inline std::uint64_t traceTicks() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * Binary event tracing into a memory-mapped file, cheap enough to leave on.
+ *
+ * A trace point names a format string, which is given a small id the first
+ * time that point runs while tracing (define()) and written once into the
+ * file's table of them. Each event is then one fixed 64-byte record: the
+ * clock in ticks, the id and the arguments' raw values. Nothing is
+ * formatted while tracing; tracedump does that afterwards.
+ *
+ * The file is a header, the format strings and a run of chunks of 1023
+ * records. Every tracing thread claims a chunk of its own with one atomic
+ * add and writes records straight into the mapping, so a record costs a
+ * clock read and a 64-byte copy, and threads never share a cache line.
+ * Records reach the file through the page cache however the process ends.
+ * Claims go round the chunks, so once the file is full the oldest chunks
+ * are reused and it holds the latest events, as a flight recorder would; a
+ * thread still filling a chunk the others have lapped all the way round
+ * onto can lose it to them.
+ *
+ * Only one trace runs at a time. Destroy it once the threads that trace
+ * have stopped.
+ */
+class TraceLog {
+public:
+    static constexpr std::size_t kChunkRecords = 1024;
+    static constexpr std::size_t kEventsBytes = 64 * 1024;
+    static constexpr std::size_t kDefaultBytes = std::size_t{64} << 20;
+
+    // Map a new trace file of about the given size and start tracing into
+    // it; null if the file could not be made or a trace is already running
+    static std::unique_ptr<TraceLog> start(const std::filesystem::path& path, std::size_t bytes = kDefaultBytes);
+    ~TraceLog();
+
+    TraceLog(const TraceLog&) = delete;
+    TraceLog& operator=(const TraceLog&) = delete;
+
+    static TraceLog* active() noexcept { return s_active.load(std::memory_order_relaxed); }
+
+    // Number a format string for this process; once per trace point
+    static std::uint16_t define(std::string_view format);
+
+    template <typename... Args>
+    void record(std::uint16_t event, const Args&... args) noexcept {
+        static_assert(sizeof...(Args) <= kTraceArgs, "Too many trace arguments");
+        Cursor& cursor = t_cursor;
+        if (cursor.trace != m_id || cursor.next == cursor.end) {
+            claim(cursor);
+        }
+        TraceRecord& record = *cursor.next++;
+        record.ticks = traceTicks();
+        record.event = event;
+        record.argCount = static_cast<std::uint8_t>(sizeof...(Args));
+        std::uint16_t kinds = 0;
+        [[maybe_unused]] std::size_t slot = 0;
+        ((kinds |= static_cast<std::uint16_t>(static_cast<unsigned>(store(record.args[slot], args)) << (2 * slot)),
+          ++slot), ...);
+        record.kinds = kinds;
+        std::atomic_ref<std::uint32_t>(cursor.chunk->count)
+            .store(static_cast<std::uint32_t>(cursor.next - first(cursor.chunk)), std::memory_order_release);
+    }
+
+    const std::filesystem::path& path() const noexcept { return m_path; }
+    std::uint64_t chunksClaimed() const noexcept;
+    std::uint32_t chunkCount() const noexcept { return m_header->chunkCount; }
+
+private:
+    // A thread's place in its chunk of the running trace
+    struct Cursor {
+        std::uint64_t trace = 0;   // The TraceLog's id; a new trace starts every thread afresh
+        TraceChunkHeader* chunk = nullptr;
+        TraceRecord* next = nullptr;
+        TraceRecord* end = nullptr;
+        std::uint32_t thread = 0;
+    };
+
+    TraceLog() = default;
+
+    template <typename T>
+    static TraceArg store(std::uint64_t& slot, const T& value) noexcept {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            const std::string_view text = value;
+            slot = 0;
+            std::memcpy(&slot, text.data(), std::min<std::size_t>(text.size(), sizeof slot));
+            return TraceArg::Text;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            slot = std::bit_cast<std::uint64_t>(static_cast<double>(value));
+            return TraceArg::Double;
+        } else if constexpr (std::is_enum_v<T>) {
+            return store(slot, static_cast<std::underlying_type_t<T>>(value));
+        } else {
+            static_assert(std::is_integral_v<T>, "Trace arguments are integers, floating point or text");
+            if constexpr (std::is_signed_v<T>) {
+                slot = static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+                return TraceArg::Int;
+            } else {
+                slot = static_cast<std::uint64_t>(value);
+                return TraceArg::UInt;
+            }
+        }
+    }
+
+    static TraceRecord* first(TraceChunkHeader* chunk) noexcept { return reinterpret_cast<TraceRecord*>(chunk) + 1; }
+    void claim(Cursor& cursor) noexcept;
+    void writeEvent(std::uint16_t id, std::string_view format);
+
+    static std::atomic<TraceLog*> s_active;
+    static thread_local Cursor t_cursor;
+
+    std::filesystem::path m_path;
+    std::uint64_t m_id = 0;
+    char* m_mapping = nullptr;
+    std::size_t m_size = 0;
+    TraceFileHeader* m_header = nullptr;
+    TraceChunkHeader* m_chunks = nullptr;
+};
+
+inline thread_local TraceLog::Cursor TraceLog::t_cursor{};
+
+/**
+ * A trace file read back: its format strings, and every record the chunks
+ * hold in time order, for tracedump. Opening checks the header and the
+ * chunks' bounds; records naming an unknown format string are kept and
+ * shown as such.
+ */
+class TraceReader {
+public:
+    struct Entry {
+        std::uint64_t nanoseconds;   // Since the trace started
+        std::uint32_t thread;
+        const TraceRecord* record;
+    };
+
+    // An empty reader, failing valid(), when the file is missing or damaged
+    static TraceReader open(const std::filesystem::path& path);
+
+    bool valid() const noexcept { return m_header != nullptr; }
+    const TraceFileHeader& header() const noexcept { return *m_header; }
+    const std::vector<Entry>& entries() const noexcept { return m_entries; }
+    std::size_t eventCount() const noexcept { return m_events.size(); }
+    // The record's format string with its arguments filled in
+    std::string format(const TraceRecord& record) const;
+
+private:
+    FileView m_file;
+    const TraceFileHeader* m_header = nullptr;
+    std::unordered_map<std::uint16_t, std::string_view> m_events;
+    std::vector<Entry> m_entries;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * UTF-8 decoding and terminal display widths.
+ *
+ * Text is walked a code point at a time; invalid or truncated sequences
+ * decode as one U+FFFD per byte so a column count never stalls. Widths follow
+ * wcwidth(): combining marks and zero-width characters take no column, East
+ * Asian wide and fullwidth characters and emoji take two, everything else
+ * one. ASCII runs are detected eight bytes at a time and counted directly.
+ */
+namespace Utf8 {
+
+struct Decoded {
+    char32_t codepoint;
+    std::uint8_t length;   // Bytes consumed, at least 1
+};
+
+inline constexpr char32_t kReplacement = 0xFFFD;
+
+// Decode the code point starting at pos, which must be inside text
+Decoded decode(std::string_view text, std::size_t pos) noexcept;
+
+// Columns a code point occupies: 0, 1 or 2
+int codepointWidth(char32_t codepoint) noexcept;
+
+bool isAscii(std::string_view text) noexcept;
+
+// Columns needed to draw text; newlines count as zero
+std::size_t displayWidth(std::string_view text) noexcept;
+
+// Bytes in the longest prefix of text that fits in columns
+std::size_t bytesForColumns(std::string_view text, std::size_t columns) noexcept;
+
+// Start of the code point after / before the one at pos
+std::size_t nextBoundary(std::string_view text, std::size_t pos) noexcept;
+std::size_t prevBoundary(std::string_view text, std::size_t pos) noexcept;
+
+} // namespace Utf8
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#if !defined(_WIN32)
+#include <termios.h>
+#endif
+
+// How a cell is drawn; colors are 0-255, or -1 for the terminal's default
+struct VtStyle {
+    enum Flag : std::uint8_t {
+        Bold      = 1 << 0,
+        Underline = 1 << 1,
+        Blink     = 1 << 2,
+        Reverse   = 1 << 3
+    };
+
+    std::int16_t fg = -1;
+    std::int16_t bg = -1;
+    std::uint8_t flags = 0;
+
+    bool operator==(const VtStyle&) const = default;
+};
+
+/**
+ * Draws frames straight to a VT100-compatible terminal, without curses.
+ *
+ * A frame is composed into a back grid of cells and present() compares it
+ * with a front grid holding what the terminal already shows. Only changed
+ * cells are sent, reached with cursor moves, and a row whose end went blank
+ * is erased with one EL. When rows inside the scroll region have moved up
+ * or down as a block, as when output arrives or the user pages back, the
+ * terminal is asked to scroll them with DECSTBM and line feeds (or reverse
+ * index) before the diff. Then only the rows that came into view are drawn.
+ * Everything a frame sends goes out in one write().
+ *
+ * Each cell holds one character: a code point with any combining marks
+ * that fit in its eight bytes. A wide character's second column is a
+ * continuation cell.
+ */
+class VtRenderer {
+public:
+    // Frames are written to fd, which is not closed
+    explicit VtRenderer(int fd);
+    ~VtRenderer();
+
+    VtRenderer(const VtRenderer&) = delete;
+    VtRenderer& operator=(const VtRenderer&) = delete;
+
+    // Take over the terminal: raw input on inputFd, the alternate screen and
+    // whatever enter asks for (keypad mode and so on), undone by end() with
+    // leave. False, changing nothing, when inputFd is not a terminal.
+    bool begin(int inputFd, std::string_view enter, std::string_view leave);
+    void end();
+
+    // A new screen size; the next frame repaints everything
+    void resize(int rows, int cols);
+    int rows() const noexcept { return m_rows; }
+    int cols() const noexcept { return m_cols; }
+
+    // Set count cells of a row to blanks in style
+    void fill(int row, int col, int count, VtStyle style = {});
+
+    // Draw UTF-8 text from col, stopping before endCol; returns the column after it
+    int put(int row, int col, int endCol, std::string_view text, VtStyle style);
+
+    void setCursor(int row, int col, bool visible = true) noexcept;
+
+    // Rows [top, bottom] whose content may move up or down as a block; a
+    // negative top turns scrolling off
+    void setScrollRegion(int top, int bottom) noexcept;
+
+    // Send what changed since the last frame in one write(); returns the bytes sent
+    std::size_t present();
+
+    // Make the next present() clear the screen and draw every cell
+    void invalidate() noexcept { m_invalid = true; }
+
+    std::uint64_t bytesWritten() const noexcept { return m_bytesWritten; }
+
+private:
+    struct Cell {
+        std::array<char, 8> glyph{' '};
+        std::uint8_t length = 1;   // Bytes of glyph in use
+        std::uint8_t width = 1;    // Columns: 2 for wide, 0 for the column after one
+        VtStyle style;
+
+        bool operator==(const Cell&) const = default;
+    };
+
+    Cell* row(std::vector<Cell>& grid, int index) noexcept { return grid.data() + std::size_t(index) * m_cols; }
+    std::uint64_t rowHash(const std::vector<Cell>& grid, int index) const noexcept;
+    void scrollIfMoved();
+    void diffRow(int index);
+    void moveTo(int row, int col);
+    void setStyle(const VtStyle& style);
+    void emit(const Cell& cell);
+    void flush();
+
+    int m_fd;
+    int m_rows = 0;
+    int m_cols = 0;
+    std::vector<Cell> m_front;   // What the terminal shows
+    std::vector<Cell> m_back;    // The frame being composed
+    std::vector<std::uint64_t> m_frontHashes;
+    std::vector<std::uint64_t> m_backHashes;
+    std::string m_out;           // One frame's bytes, reused
+
+    int m_scrollTop = -1;
+    int m_scrollBottom = -1;
+    int m_wantRow = 0;
+    int m_wantCol = 0;
+    bool m_wantVisible = true;
+
+    // Terminal state as of the last frame; unknown state is always resent
+    int m_atRow = -1;            // -1 when the cursor's position is not known
+    int m_atCol = -1;
+    VtStyle m_style;
+    bool m_styleKnown = false;
+    bool m_cursorVisible = true;
+    bool m_invalid = true;
+
+    std::uint64_t m_bytesWritten = 0;
+
+    // Session state for begin()/end()
+    bool m_active = false;
+    int m_inputFd = -1;
+    std::string m_leave;
+#if !defined(_WIN32)
+    termios m_savedModes{};
+#endif
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+/**
+ * Notices a game or UI loop that has stopped coming round, and says where
+ * it is stuck.
+ *
+ * Made and destroyed on the thread to watch, which calls beat() each time
+ * round its loop and rest() just before it blocks waiting for work, so a
+ * quiet server asleep in poll() is never taken for a stuck one. A thread of the
+ * watchdog's own looks at the beats a few times per threshold; once the
+ * loop has been busy for a whole threshold without a beat it interrupts the
+ * watched thread with a signal, whose handler records the thread's stack,
+ * and logs that stack with what the thread said it was doing (see
+ * Activity). Each stall is reported once, then onStall runs, which may for
+ * instance abort the script the thread is stuck in.
+ *
+ * Stacks are captured where <execinfo.h> exists; elsewhere the report
+ * gives only the activity. The capture signal is process-wide, so one
+ * watchdog runs at a time.
+ */
+class Watchdog {
+public:
+    static constexpr std::chrono::milliseconds kDefaultThreshold{5000};
+    static constexpr int kMaxFrames = 64;
+
+    struct Options {
+        std::chrono::milliseconds threshold = kDefaultThreshold;
+        // On the watchdog's thread, after a stall is logged
+        std::function<void()> onStall;
+    };
+
+    /**
+     * What the watched thread is running, such as a command or a script,
+     * for the stall report; nested activities read outermost first. Costs a
+     * thread-local read on any thread no watchdog watches.
+     */
+    class Activity {
+    public:
+        Activity(std::string_view kind, std::string_view name);
+        ~Activity();
+
+        Activity(const Activity&) = delete;
+        Activity& operator=(const Activity&) = delete;
+
+    private:
+        Watchdog* m_watchdog;
+        std::size_t m_previous = 0;   // Length of the description before this one
+    };
+
+    explicit Watchdog(Options options);
+    ~Watchdog();
+
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    // From the watched thread: it is working and has come round its loop
+    void beat() noexcept {
+        m_beats.fetch_add(1, std::memory_order_relaxed);
+        m_resting.store(false, std::memory_order_relaxed);
+    }
+    // From the watched thread, before it blocks waiting for work
+    void rest() noexcept {
+        m_beats.fetch_add(1, std::memory_order_relaxed);
+        m_resting.store(true, std::memory_order_relaxed);
+    }
+
+    std::uint64_t stalls() const noexcept { return m_stalls.load(std::memory_order_relaxed); }
+
+private:
+    void watch();
+    void report(std::chrono::steady_clock::duration stuck);
+
+    Options m_options;
+    std::atomic<std::uint64_t> m_beats{0};
+    std::atomic<bool> m_resting{false};
+    std::atomic<std::uint64_t> m_stalls{0};
+#ifndef _WIN32
+    pthread_t m_watched{};
+#endif
+
+    std::mutex m_activityMutex;
+    std::string m_activity;   // "command say > script greet"
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "ObjectPool.h"
+
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+class WebSocketInflater;
+#endif
+
+/**
+ * One browser connection's WebSocket protocol state (RFC 6455).
+ *
+ * The connection starts as HTTP: feed() collects the upgrade request, checks
+ * it and hands back the 101 response (or a 400, 426 or 431 refusal). After that
+ * it parses client frames, which arrive masked and may be fragmented or
+ * split across reads, and reports whole messages, pings and the close
+ * handshake. Protocol errors are reported as a close with the matching code.
+ *
+ * Built with zlib (ENABLE_WEBSOCKET_DEFLATE), permessage-deflate (RFC 7692)
+ * is accepted when offered, always with server_no_context_takeover: every
+ * server message is compressed on its own, so a message sent to many
+ * sessions compresses to the same frame for all of them and is still built
+ * only once. Client messages keep their context and are inflated here, with
+ * the client's window held to 1 KiB where it lets the server choose.
+ *
+ * The static helpers build server frames, which are never masked.
+ */
+class WebSocket : public PoolLink<WebSocket> {
+public:
+    enum class Opcode : std::uint8_t { Continuation = 0x0, Text = 0x1, Binary = 0x2, Close = 0x8, Ping = 0x9, Pong = 0xA };
+
+    // Close codes (RFC 6455 section 7.4.1)
+    static constexpr std::uint16_t kNormalClosure = 1000;
+    static constexpr std::uint16_t kProtocolError = 1002;
+    static constexpr std::uint16_t kInvalidData = 1007;
+    static constexpr std::uint16_t kMessageTooBig = 1009;
+    static constexpr std::uint16_t kServiceRestart = 1012;   // Come back shortly
+
+    static constexpr std::size_t kMaxRequest = 8 * 1024;    // The upgrade request and its headers
+    static constexpr std::size_t kMaxMessage = 16 * 1024;   // Reassembled and inflated
+    static constexpr std::size_t kMaxFrameHeader = 10;      // Server frames carry no mask
+
+    using FrameHeader = std::array<char, kMaxFrameHeader>;
+
+    // What feed() reports; any call returning false stops it
+    class Events {
+    public:
+        // The response to the upgrade request, to be sent as it is. A refused
+        // connection is closed once it is written
+        virtual bool handshake(std::string_view response, bool accepted) = 0;
+        // A complete text or binary message, at most kMaxMessage bytes
+        virtual bool message(std::string_view payload) = 0;
+        virtual bool ping(std::string_view payload) = 0;
+        // The client closed, or broke the protocol; answer with code and close
+        virtual bool close(std::uint16_t code) = 0;
+
+    protected:
+        ~Events() = default;
+    };
+
+    // With allowDeflate, a permessage-deflate offer is accepted
+    explicit WebSocket(bool allowDeflate);
+    ~WebSocket();
+
+    WebSocket(const WebSocket&) = delete;
+    WebSocket& operator=(const WebSocket&) = delete;
+
+    // Start over for another connection, as constructed, keeping the buffers
+    void recycle(bool allowDeflate);
+
+    bool feed(std::string_view bytes, Events& events);
+
+    bool upgraded() const noexcept { return m_upgraded; }
+    // The session's server messages may be sent compressed
+    bool deflate() const noexcept { return m_deflate; }
+
+    // Header of an unmasked frame carrying length bytes; returns its size
+    static std::size_t frameHeader(Opcode opcode, bool compressed, std::size_t length, FrameHeader& out) noexcept;
+
+    // Append text with every invalid UTF-8 sequence replaced by U+FFFD, as a
+    // text frame must hold; players can send any bytes over telnet
+    static void appendUtf8(std::string_view text, std::string& out);
+
+private:
+    bool handshake(Events& events);
+    bool acceptExtensions(std::string_view offers, std::string& response);
+    bool parseFrames(Events& events);
+    bool endMessage(Events& events);
+
+    std::string m_buffer;             // Request, then frames, not yet parsed
+    std::string m_message;            // Fragments of the message in progress
+    Opcode m_messageOpcode = Opcode::Continuation;   // Continuation: none in progress
+    bool m_messageCompressed = false;
+    bool m_allowDeflate = false;
+    bool m_deflate = false;
+    bool m_upgraded = false;
+    bool m_closed = false;
+    int m_clientWindowBits = 15;
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+    std::unique_ptr<WebSocketInflater> m_inflater;   // Made when the first compressed message arrives
+#endif
+};
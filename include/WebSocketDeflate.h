@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct z_stream_s;
+
+/**
+ * permessage-deflate (RFC 7692) compression of WebSocket messages.
+ *
+ * A WebSocketDeflater compresses each message on its own, which is what
+ * server_no_context_takeover promises the client, so one deflater serves
+ * every session of a reactor and equal messages compress to equal bytes.
+ * A WebSocketInflater belongs to one session and keeps its context, since
+ * the client may refer back to its earlier messages.
+ */
+class WebSocketDeflater {
+public:
+    // nullptr when zlib cannot set up a stream
+    static std::unique_ptr<WebSocketDeflater> create();
+
+    ~WebSocketDeflater();
+
+    WebSocketDeflater(const WebSocketDeflater&) = delete;
+    WebSocketDeflater& operator=(const WebSocketDeflater&) = delete;
+
+    // Replace out with the compressed message, less the 00 00 FF FF tail the
+    // extension leaves off; false on a zlib error
+    bool compress(std::string_view message, std::string& out);
+
+private:
+    WebSocketDeflater();
+
+    std::unique_ptr<z_stream_s> m_stream;
+};
+
+class WebSocketInflater {
+public:
+    enum class Result { Ok, TooBig, Invalid };
+
+    // windowBits as agreed in the handshake (9 to 15)
+    static std::unique_ptr<WebSocketInflater> create(int windowBits);
+
+    ~WebSocketInflater();
+
+    WebSocketInflater(const WebSocketInflater&) = delete;
+    WebSocketInflater& operator=(const WebSocketInflater&) = delete;
+
+    // Replace out with the inflated message, stopping at limit bytes
+    Result inflate(std::string_view message, std::string& out, std::size_t limit);
+
+private:
+    WebSocketInflater();
+
+    Result inflateInto(std::string_view bytes, std::string& out, std::size_t limit);
+
+    std::unique_ptr<z_stream_s> m_stream;
+};
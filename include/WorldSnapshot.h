@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Components.h"
+#include "EntityStore.h"
+#include "GameWorld.h"
+
+/**
+ * The whole world at one tick, taken by GameEngine::snapshot() for a
+ * checkpoint thread to write out while the game goes on.
+ *
+ * Nothing in it is shared with the live world in a way the game can
+ * change: the entities are an EntityStore::Snapshot, whose pages the store
+ * copies before changing; the room graph is a copy, shared by every
+ * snapshot until the map next changes; and the players are copied out,
+ * being few. Taking one costs a pointer per page of components, not the
+ * components themselves.
+ */
+struct WorldSnapshot {
+    struct PlayerImage {
+        PlayerId id = kInvalidPlayerId;
+        std::string_view name;   // Interned, so it outlives the snapshot
+        RoomId room = kInvalidRoomId;
+        Entity body;
+    };
+
+    std::uint64_t tick = 0;                     // Of the last tick run before it was taken
+    std::shared_ptr<const RoomGraph> rooms;
+    std::vector<PlayerImage> players;
+    EntityStore::Snapshot entities;
+
+    // The image as text, one line per player, NPC and item, written beside
+    // path and renamed over it. For any thread; the item prototypes the
+    // entities name must still exist
+    bool write(const std::filesystem::path& path) const;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameWorld.h"
+
+/**
+ * What the outside world may see of the game: who is online, the
+ * strongest of them and how the zones are filled. The game thread copies
+ * it out (GameEngine::status) for other threads, such as ApiServer's, to
+ * read at leisure. Everything is by value, so nothing in it points into
+ * live state, and filling one again reuses its vectors' and strings' memory.
+ */
+struct WorldStatus {
+    static constexpr std::size_t kTopPlayers = 10;
+
+    struct Player {
+        std::string name;
+        ZoneId zone = 0;
+        std::int32_t health = 0;
+        std::int32_t maxHealth = 0;
+        std::int32_t power = 0;   // Attack, defense and damage together, with gear and affects
+    };
+
+    struct Zone {
+        ZoneId id = 0;
+        std::uint32_t players = 0;
+        bool loaded = false;
+    };
+
+    std::uint64_t serial = 0;         // Set by whoever publishes it, one more each time; 0 for never
+    std::uint64_t takenAt = 0;        // Wall seconds
+    std::vector<Player> players;      // Online, by name
+    std::vector<std::uint32_t> top;   // Into players: the most powerful first, at most kTopPlayers
+    std::vector<Zone> zones;          // Loaded or with players in, by id
+};
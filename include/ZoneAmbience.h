@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GameWorld.h"
+#include "Random.h"
+#include "SharedMessage.h"
+
+enum class DayPhase : std::uint8_t { Night, Dawn, Day, Dusk, Count };
+enum class Weather : std::uint8_t { Clear, Cloudy, Rain, Storm, Count };
+
+// A message for everyone in a zone
+struct AmbientBroadcast {
+    ZoneId zone;
+    SharedMessage message;
+};
+
+// Totals since the engine started
+struct AmbientStats {
+    std::uint64_t passes = 0;        // advance() calls
+    std::uint64_t zoneUpdates = 0;   // Zones advanced, one per occupied zone a pass
+    std::uint64_t broadcasts = 0;    // Messages handed out for a zone
+    std::uint64_t deliveries = 0;    // Players they reached, as the engine counts them
+};
+
+/**
+ * The time of day, each zone's weather and the lines that set a zone's
+ * scene, worked out once per zone rather than per room or per player.
+ *
+ * The day is one game clock for the whole world, kTicksPerHour ticks to
+ * the hour. Weather is a zone's own and moves a step at a time, clear to
+ * cloudy to rain to storm and back, with a roll per zone per pass. Every
+ * message is made into a SharedMessage once, the day's and the weather's
+ * when this is built and a zone's lines when they are added, so a pass
+ * formats nothing: a change in an occupied zone hands out the one message
+ * for the engine to link into each occupant's outbox through the zone's
+ * occupancy list, as broadcastToZone does. The dawn everyone sees is the
+ * same message in every zone.
+ *
+ * Zones nobody is in are not advanced; nobody would see their weather
+ * change, so it picks up where it was when someone arrives.
+ *
+ * Game thread only.
+ */
+class ZoneAmbience {
+public:
+    static constexpr std::uint64_t kTicksPerHour = 600;   // A game day is 24 minutes at 10 ticks a second
+    static constexpr std::uint64_t kTicksPerDay = 24 * kTicksPerHour;
+    static constexpr std::uint64_t kWeatherOdds = 30;   // A zone's weather moves once in this many passes
+    static constexpr std::uint64_t kLineOdds = 12;      // A zone with lines says one once in this many passes
+
+    ZoneAmbience();
+
+    // A line said now and then to everyone in zone, such as birdsong
+    void addLine(ZoneId zone, std::string_view text);
+    std::size_t lineCount(ZoneId zone) const noexcept { return zone < m_lines.size() ? m_lines[zone].size() : 0; }
+
+    // Move the day on to tick and each of occupied's weather and lines by
+    // one pass, appending what each zone is to be told to out
+    void advance(std::uint64_t tick, std::span<const ZoneId> occupied, Random& random,
+                 std::vector<AmbientBroadcast>& out);
+    // The engine's count of players the last pass's broadcasts reached
+    void delivered(std::size_t players) noexcept { m_stats.deliveries += players; }
+
+    static DayPhase phaseAt(std::uint64_t tick) noexcept;
+    static unsigned hourAt(std::uint64_t tick) noexcept {
+        return static_cast<unsigned>(tick % kTicksPerDay / kTicksPerHour);
+    }
+    DayPhase phase() const noexcept { return m_phase; }
+    // Clear for a zone not yet advanced
+    Weather weather(ZoneId zone) const noexcept {
+        return zone < m_weather.size() ? m_weather[zone] : Weather::Clear;
+    }
+    // "It is night, and the sky is clear.", for the weather command
+    std::string describe(std::uint64_t tick, ZoneId zone) const;
+
+    const AmbientStats& stats() const noexcept { return m_stats; }
+
+private:
+    static constexpr std::size_t kPhases = static_cast<std::size_t>(DayPhase::Count);
+    static constexpr std::size_t kWeathers = static_cast<std::size_t>(Weather::Count);
+
+    DayPhase m_phase = DayPhase::Count;   // Count until the first pass
+    std::vector<Weather> m_weather;       // By ZoneId
+    std::vector<std::uint8_t> m_seen;     // By ZoneId; advanced at least once
+    std::vector<std::vector<SharedMessage>> m_lines;   // By ZoneId
+    std::array<SharedMessage, kPhases> m_phaseMessages;
+    // By the weather it moves to; the one step up, the other down
+    std::array<SharedMessage, kWeathers> m_worsens;
+    std::array<SharedMessage, kWeathers> m_clears;
+    AmbientStats m_stats;
+};
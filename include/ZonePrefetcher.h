@@ -0,0 +1,84 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "AreaFile.h"
+#include "DescriptionStore.h"
+#include "GameWorld.h"
+
+// Totals since the prefetcher started
+struct PrefetchStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t readied = 0;   // Zones whose records a worker checked
+    std::uint64_t taken = 0;     // Readied zones a load then used
+    std::uint64_t dropped = 0;   // Refused with the queue full; those load as before
+};
+
+/**
+ * Readies area zones before anyone walks into them.
+ *
+ * A zone is spawned from its records the first time a player enters it,
+ * and on a cold start those records, and the text of the rooms the player
+ * first sees, are pages of the area file that have never been read: the
+ * player's move waits on the disk. The engine submits a zone once a player
+ * comes within a few rooms of it, with the rooms of it that are nearest.
+ * A worker asks the kernel for the pages under the zone's records and those
+ * rooms' text (madvise(MADV_WILLNEED)), checks the records as
+ * AreaFile::zone() does, which reads them in, and unpacks the rooms' packed
+ * descriptions into the description store's hot list. The checked records
+ * wait here until the zone loads and take()s them, so the load neither
+ * checks nor faults them in again.
+ *
+ * Spawning stays on the game thread; the worker only reads the mapping.
+ * The area and description store must outlive the prefetcher. submit(),
+ * take() and stats() are from one thread.
+ */
+class ZonePrefetcher {
+public:
+    static constexpr std::size_t kQueueLimit = 64;   // Zones waiting for the worker
+
+    ZonePrefetcher(const AreaFile& area, DescriptionStore* descriptions);
+    // Finishes the zone under way, and drops the rest
+    ~ZonePrefetcher();
+
+    ZonePrefetcher(const ZonePrefetcher&) = delete;
+    ZonePrefetcher& operator=(const ZonePrefetcher&) = delete;
+
+    // Ready the area's zone and the given rooms of it; false when the queue is full
+    bool submit(ZoneId zone, std::span<const RoomId> rooms);
+
+    // The zone's checked records, forgotten here, if the worker has readied
+    // them; nullopt when it has not, or found them damaged
+    std::optional<AreaFile::Zone> take(ZoneId zone);
+
+    PrefetchStats stats() const;
+
+private:
+    struct Job {
+        ZoneId zone = 0;
+        std::vector<RoomId> rooms;
+    };
+
+    void work();
+    void ready(const Job& job, std::string& scratch);
+
+    const AreaFile& m_area;
+    DescriptionStore* m_descriptions;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Job> m_queue;
+    std::unordered_map<ZoneId, std::optional<AreaFile::Zone>> m_ready;
+    PrefetchStats m_stats;
+    bool m_stopping = false;
+    std::thread m_thread;   // Last, so it starts once the rest is made
+};
@@ -0,0 +1,26 @@
+-- say.lua - Script for the 'say' command
+-- This command sends a message to everyone in the current room
+
+-- Command metadata
+local script = {
+    help = "say <message> - Speak a message to everyone in the room",
+    description = "Broadcasts a message to all players in your current location",
+    syntax = "message:rest?",
+    
+    -- Main command function
+    run = function(args, player, fields)
+        local message = fields and fields.message
+        if not message then
+            return "Say what?"
+        end
+        
+        -- Everyone else in the room hears it; the speaker gets the return value
+        if player then
+            player.room:broadcast(string.format("%s says: \"%s\"", player.name, message), player)
+        end
+        return string.format("You say: \"%s\"", message)
+    end
+}
+
+-- Return the script table
+return script
\ No newline at end of file
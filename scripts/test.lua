@@ -1,4 +1,7 @@
 -- test.lua - A simple test script to verify Lua integration
+--@lazy
+--@help test - A test command to verify script loading
+--@description Tests the Lua script integration system
 
 -- Command metadata
 local script = {
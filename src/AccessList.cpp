@@ -0,0 +1,236 @@
+#include "../include/AccessList.h"
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+// ::ffff:a.b.c.d, as a dual-stack socket reports an IPv4 peer
+constexpr std::array<std::uint8_t, 12> kMappedPrefix = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+IpAddress fromV6(const std::uint8_t* bytes) {
+    IpAddress address;
+    if (std::memcmp(bytes, kMappedPrefix.data(), kMappedPrefix.size()) == 0) {
+        std::memcpy(address.bytes.data(), bytes + kMappedPrefix.size(), 4);
+        return address;
+    }
+    std::memcpy(address.bytes.data(), bytes, 16);
+    address.v6 = true;
+    return address;
+}
+
+} // namespace
+
+std::optional<IpAddress> IpAddress::parse(std::string_view text) {
+    char buffer[INET6_ADDRSTRLEN];
+    if (text.empty() || text.size() >= sizeof buffer) {
+        return std::nullopt;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    IpAddress address;
+    if (::inet_pton(AF_INET, buffer, address.bytes.data()) == 1) {
+        return address;
+    }
+    std::uint8_t v6[16];
+    if (::inet_pton(AF_INET6, buffer, v6) == 1) {
+        return fromV6(v6);
+    }
+    return std::nullopt;
+}
+
+std::optional<IpAddress> IpAddress::ofPeer(int fd) {
+    sockaddr_storage peer{};
+    socklen_t size = sizeof peer;
+    if (::getpeername(fd, reinterpret_cast<sockaddr*>(&peer), &size) != 0) {
+        return std::nullopt;
+    }
+    if (peer.ss_family == AF_INET) {
+        IpAddress address;
+        std::memcpy(address.bytes.data(), &reinterpret_cast<const sockaddr_in&>(peer).sin_addr, 4);
+        return address;
+    }
+    if (peer.ss_family == AF_INET6) {
+        return fromV6(reinterpret_cast<const sockaddr_in6&>(peer).sin6_addr.s6_addr);
+    }
+    return std::nullopt;
+}
+
+std::uint64_t IpAddress::hash() const noexcept {
+    // FNV-1a, finished with a splitmix64 round so every slice of it is well mixed
+    std::uint64_t hash = 14695981039346656037ull ^ (v6 ? 1 : 0);
+    for (unsigned i = 0; i < bits() / 8; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+}
+
+std::string IpAddress::toString() const {
+    char buffer[INET6_ADDRSTRLEN] = {};
+    ::inet_ntop(v6 ? AF_INET6 : AF_INET, bytes.data(), buffer, sizeof buffer);
+    return buffer;
+}
+
+AccessList::AccessList() : m_nodes(2) {}
+
+std::expected<AccessList, std::string> AccessList::parse(std::string_view text) {
+    AccessList list;
+    std::size_t lineNumber = 0;
+    while (!text.empty()) {
+        const std::size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+        ++lineNumber;
+
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        const std::size_t space = line.find_first_of(" \t");
+        const std::string_view verb = line.substr(0, space);
+        const std::string_view target = space == std::string_view::npos ? std::string_view() : trim(line.substr(space));
+        const AccessRule rule = verb == "allow" ? AccessRule::Allow : verb == "deny" ? AccessRule::Deny : AccessRule::None;
+        if (rule == AccessRule::None) {
+            return std::unexpected(std::format("line {}: '{}' is not allow or deny", lineNumber, verb));
+        }
+        const std::size_t slash = target.find('/');
+        const std::optional<IpAddress> prefix = IpAddress::parse(target.substr(0, slash));
+        if (!prefix) {
+            return std::unexpected(std::format("line {}: bad address {}", lineNumber, target));
+        }
+        unsigned length = prefix->bits();
+        if (slash != std::string_view::npos) {
+            const std::string_view digits = target.substr(slash + 1);
+            const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), length);
+            if (ec != std::errc() || end != digits.data() + digits.size() || length > prefix->bits()) {
+                return std::unexpected(std::format("line {}: bad prefix length in {}", lineNumber, target));
+            }
+        }
+        list.add(*prefix, length, rule);
+    }
+    return list;
+}
+
+std::expected<AccessList, std::string> AccessList::load(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return std::unexpected(std::format("cannot open {}", path.string()));
+    }
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (in.bad()) {
+        return std::unexpected(std::format("cannot read {}", path.string()));
+    }
+    return parse(text);
+}
+
+void AccessList::add(const IpAddress& prefix, unsigned length, AccessRule rule) {
+    std::uint32_t node = prefix.v6 ? 1 : 0;
+    length = std::min(length, prefix.bits());
+    for (unsigned i = 0; i < length; ++i) {
+        const bool bit = prefix.bit(i);
+        if (m_nodes[node].child[bit] == 0) {
+            m_nodes[node].child[bit] = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        node = m_nodes[node].child[bit];
+    }
+    if (m_nodes[node].rule == AccessRule::None) {
+        ++m_rules;
+    }
+    m_nodes[node].rule = rule;
+}
+
+AccessRule AccessList::match(const IpAddress& address) const noexcept {
+    std::uint32_t node = address.v6 ? 1 : 0;
+    AccessRule found = m_nodes[node].rule;
+    for (unsigned i = 0; i < address.bits(); ++i) {
+        node = m_nodes[node].child[address.bit(i)];
+        if (node == 0) {
+            break;
+        }
+        if (m_nodes[node].rule != AccessRule::None) {
+            found = m_nodes[node].rule;
+        }
+    }
+    return found;
+}
+
+std::uint64_t ConnectionCounts::acquire(const IpAddress& address, std::uint32_t limit) noexcept {
+    // Never 0, which means refused
+    const std::uint64_t ticket = address.hash() | (std::uint64_t{1} << 63);
+    std::uint32_t least = UINT32_MAX;
+    for (std::size_t row = 0; row < kRows; ++row) {
+        least = std::min(least, m_counts[row][column(ticket, row)].fetch_add(1, std::memory_order_relaxed) + 1);
+    }
+    if (limit != 0 && least > limit) {
+        release(ticket);
+        return 0;
+    }
+    return ticket;
+}
+
+void ConnectionCounts::release(std::uint64_t ticket) noexcept {
+    for (std::size_t row = 0; row < kRows; ++row) {
+        m_counts[row][column(ticket, row)].fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+std::uint32_t ConnectionCounts::count(const IpAddress& address) const noexcept {
+    const std::uint64_t ticket = address.hash() | (std::uint64_t{1} << 63);
+    std::uint32_t least = UINT32_MAX;
+    for (std::size_t row = 0; row < kRows; ++row) {
+        least = std::min(least, m_counts[row][column(ticket, row)].load(std::memory_order_relaxed));
+    }
+    return least;
+}
+
+AccessControl::Verdict AccessControl::admit(int fd, std::uint32_t limit, std::uint64_t& ticket) noexcept {
+    ticket = 0;
+    if (limit == 0 && m_rules.load(std::memory_order_relaxed) == 0) {
+        return Verdict::Admit;
+    }
+    // A peer already gone has no address; the session fails on its own
+    const std::optional<IpAddress> peer = IpAddress::ofPeer(fd);
+    if (!peer) {
+        return Verdict::Admit;
+    }
+    if (deniedAddress(*peer)) {
+        return Verdict::Denied;
+    }
+    ticket = m_counts.acquire(*peer, limit);
+    return ticket != 0 ? Verdict::Admit : Verdict::Limited;
+}
+
+bool AccessControl::denied(int fd) const noexcept {
+    if (m_rules.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    const std::optional<IpAddress> peer = IpAddress::ofPeer(fd);
+    return peer && deniedAddress(*peer);
+}
+
+bool AccessControl::deniedAddress(const IpAddress& address) const noexcept {
+    const rcu::Guard guard;
+    return m_list.load()->match(address) == AccessRule::Deny;
+}
+
+void AccessControl::publish(std::unique_ptr<AccessList> list) {
+    const std::size_t rules = list->rules();
+    m_list.publish(std::move(list));
+    m_rules.store(rules, std::memory_order_relaxed);
+}
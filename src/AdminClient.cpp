@@ -0,0 +1,114 @@
+#include "../include/AdminClient.h"
+#include "../include/AdminProtocol.h"
+#include <cerrno>
+#include <cstring>
+#include <format>
+#ifndef _WIN32
+#include "../include/SocketUtil.h"
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+// net_server has no Windows build, so there is nothing to attach to
+std::expected<std::unique_ptr<AdminClient>, std::string> AdminClient::connect(const std::string&, std::string_view,
+                                                                              OutputCallback) {
+    return std::unexpected(std::string("Attaching to a server needs a POSIX system"));
+}
+
+AdminClient::~AdminClient() = default;
+
+bool AdminClient::send(std::string_view) {
+    return false;
+}
+
+#else
+
+std::expected<std::unique_ptr<AdminClient>, std::string> AdminClient::connect(const std::string& path,
+                                                                              std::string_view name,
+                                                                              OutputCallback output) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return std::unexpected(std::format("{}: not a usable socket path", path));
+    }
+    std::memcpy(address.sun_path, path.data(), path.size());
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return std::unexpected(std::format("socket: {}", std::strerror(errno)));
+    }
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        return std::unexpected(std::format("{}: {}", path, std::strerror(error)));
+    }
+    std::unique_ptr<AdminClient> client(new AdminClient(fd, std::move(output)));
+    if (!client->send(name)) {
+        return std::unexpected(std::format("{}: the server hung up", path));
+    }
+    client->m_thread = std::thread([raw = client.get()] { raw->run(); });
+    return client;
+}
+
+AdminClient::~AdminClient() {
+    // Wakes the reader out of recv(), which then goes quietly
+    m_detaching.store(true);
+    ::shutdown(m_fd, SHUT_RDWR);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    ::close(m_fd);
+}
+
+bool AdminClient::send(std::string_view line) {
+    std::string frame;
+    admin::appendFrame(frame, line);
+    const std::lock_guard<std::mutex> lock(m_sending);
+    return connected() && write(frame);
+}
+
+bool AdminClient::write(std::string_view frame) {
+    while (!frame.empty()) {
+        const ssize_t sent = ::send(m_fd, frame.data(), frame.size(), SocketUtil::kSendFlags);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            m_connected.store(false, std::memory_order_relaxed);
+            return false;
+        }
+        frame.remove_prefix(static_cast<std::size_t>(sent));
+    }
+    return true;
+}
+
+void AdminClient::run() {
+    std::string in;
+    char buffer[16 * 1024];
+    bool broken = false;
+    while (!broken) {
+        const ssize_t got = ::recv(m_fd, buffer, sizeof buffer, 0);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break;
+        }
+        in.append(buffer, static_cast<std::size_t>(got));
+        std::string_view pending = in;
+        while (const auto frame = admin::nextFrame(pending, broken)) {
+            m_output(std::string(*frame));
+        }
+        in.erase(0, in.size() - pending.size());
+    }
+    m_connected.store(false, std::memory_order_relaxed);
+    if (!m_detaching.load()) {
+        m_output("The server closed the admin connection.");
+    }
+}
+
+#endif
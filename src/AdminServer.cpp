@@ -0,0 +1,237 @@
+#include "../include/AdminServer.h"
+#include "../include/AdminProtocol.h"
+#include "../include/Logger.h"
+#include "../include/SocketUtil.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <utility>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Whether the peer runs as this process's user, or as root
+bool trusted(int fd) {
+#if defined(SO_PEERCRED)
+    ucred credentials{};
+    socklen_t size = sizeof(credentials);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0) {
+        return false;
+    }
+    const uid_t uid = credentials.uid;
+#else
+    uid_t uid = 0;
+    gid_t gid = 0;
+    if (::getpeereid(fd, &uid, &gid) != 0) {
+        return false;
+    }
+#endif
+    return uid == 0 || uid == ::geteuid();
+}
+
+} // namespace
+
+std::expected<std::unique_ptr<AdminServer>, NetError> AdminServer::start(const std::string& path,
+                                                                         NetInbox<AdminEvent>& events,
+                                                                         GameEventBus* bus) {
+    std::unique_ptr<AdminServer> server(new AdminServer(path, events));
+    sockaddr_un bound{};
+    bound.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(bound.sun_path)) {
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    std::memcpy(bound.sun_path, path.data(), path.size());
+    server->m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->m_listenFd < 0 || !SocketUtil::setNonBlocking(server->m_listenFd) || !server->m_output.open()) {
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    // A file left by a server that did not shut down is stale; a copyover's
+    // new process takes the path over from the old one the same way
+    ::unlink(path.c_str());
+    // Private from the moment it exists, not just once chmod() gets to it
+    const mode_t mask = ::umask(0077);
+    const int bind = ::bind(server->m_listenFd, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound));
+    ::umask(mask);
+    if (bind != 0) {
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    if (::listen(server->m_listenFd, 8) != 0) {
+        return std::unexpected(NetError::LISTEN_FAILED);
+    }
+    if (bus) {
+        server->m_bus = bus;
+        server->subscribe();
+    }
+    server->m_thread = std::thread([raw = server.get()] { raw->run(); });
+    return server;
+}
+
+void AdminServer::subscribe() {
+    m_consumer = m_bus->addConsumer([this] { m_output.wake(); });
+    m_bus->subscribe<PlayerJoined>(m_consumer, [this](const PlayerJoined& joined) {
+        if (!m_operators.empty()) {
+            notice(std::format("-- {} enters the game.", StringInterner::global().view(joined.name)));
+        }
+    });
+    m_bus->subscribe<PlayerLeft>(m_consumer, [this](const PlayerLeft& left) {
+        if (!m_operators.empty()) {
+            notice(std::format("-- {} leaves the game.", StringInterner::global().view(left.name)));
+        }
+    });
+}
+
+void AdminServer::notice(std::string_view text) {
+    for (Operator& op : m_operators) {
+        if (op.named && !op.closing) {
+            admin::appendFrame(op.out, text);
+        }
+    }
+}
+
+AdminServer::~AdminServer() {
+    if (m_thread.joinable()) {
+        m_stopping.store(true);
+        m_output.wake();
+        m_thread.join();
+    }
+    if (m_bus) {
+        m_bus->removeConsumer(m_consumer);
+    }
+    for (Operator& op : m_operators) {
+        ::close(op.fd);
+    }
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        ::unlink(m_path.c_str());
+    }
+}
+
+void AdminServer::run() {
+    std::vector<pollfd> ready;
+    while (!m_stopping.load()) {
+        ready.clear();
+        ready.push_back({m_listenFd, POLLIN, 0});
+        ready.push_back({m_output.fd(), POLLIN, 0});
+        for (const Operator& op : m_operators) {
+            ready.push_back({op.fd, static_cast<short>(POLLIN | (op.out.empty() ? 0 : POLLOUT)), 0});
+        }
+        if (::poll(ready.data(), ready.size(), -1) < 0 && errno != EINTR) {
+            return;
+        }
+
+        // What the game thread sent, queued behind what is already waiting
+        m_output.drain([this](AdminOutput&& output) {
+            const auto op = std::ranges::find(m_operators, output.session, &Operator::session);
+            if (op == m_operators.end()) {
+                return;
+            }
+            if (output.close) {
+                op->closing = true;
+            } else {
+                admin::appendFrame(op->out, *output.text);
+            }
+        });
+        if (m_bus) {
+            m_bus->drain(m_consumer);
+        }
+
+        // Operators by index, as ready has them; the ones gone are dropped after
+        for (std::size_t i = 0; i < m_operators.size(); ++i) {
+            Operator& op = m_operators[i];
+            const short events = i + 2 < ready.size() ? ready[i + 2].revents : 0;
+            const bool alive = ((events & (POLLIN | POLLHUP | POLLERR)) == 0 || read(op)) && write(op);
+            if (!alive || (op.closing && op.out.empty())) {
+                detach(op);
+            }
+        }
+        std::erase_if(m_operators, [](const Operator& op) { return op.fd < 0; });
+
+        if (ready[0].revents & POLLIN) {
+            accept();
+        }
+    }
+}
+
+void AdminServer::accept() {
+    for (;;) {
+        const int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (!trusted(fd) || !SocketUtil::setNonBlocking(fd)) {
+            LOG_WARN("Refused an admin connection from another user");
+            ::close(fd);
+            continue;
+        }
+        Operator& op = m_operators.emplace_back();
+        op.fd = fd;
+        op.session = m_nextSession++;
+        m_attached.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// What arrived before the operator went still counts
+bool AdminServer::read(Operator& op) {
+    char buffer[4096];
+    bool open = true;
+    for (;;) {
+        const ssize_t got = ::recv(op.fd, buffer, sizeof buffer, 0);
+        if (got > 0) {
+            op.in.append(buffer, static_cast<std::size_t>(got));
+            continue;
+        }
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        open = got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        break;
+    }
+    std::string_view pending = op.in;
+    bool broken = false;
+    while (const auto frame = admin::nextFrame(pending, broken)) {
+        if (op.closing) {
+            continue;   // Being let go; what it typed since is dropped
+        }
+        const AdminEvent::Kind kind = op.named ? AdminEvent::Kind::Line : AdminEvent::Kind::Attached;
+        op.named = true;
+        m_events.push({kind, op.session, std::string(*frame)});
+    }
+    op.in.erase(0, op.in.size() - pending.size());
+    return open && !broken;
+}
+
+bool AdminServer::write(Operator& op) {
+    while (!op.out.empty()) {
+        const ssize_t sent = ::send(op.fd, op.out.data(), op.out.size(), SocketUtil::kSendFlags);
+        if (sent > 0) {
+            op.out.erase(0, static_cast<std::size_t>(sent));
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+    if (op.out.size() > kMaxPendingBytes) {
+        LOG_WARN("Admin session {} fell {} bytes behind; detached", op.session, op.out.size());
+        return false;
+    }
+    return true;
+}
+
+void AdminServer::detach(Operator& op) {
+    ::close(std::exchange(op.fd, -1));
+    m_attached.fetch_sub(1, std::memory_order_relaxed);
+    if (op.named) {
+        m_events.push({AdminEvent::Kind::Detached, op.session, {}});
+    }
+}
@@ -0,0 +1,241 @@
+#include "../include/ApiServer.h"
+#include "../include/JsonText.h"
+#include "../include/SocketUtil.h"
+#include <algorithm>
+#include <cerrno>
+#include <format>
+#include <iterator>
+#include <string_view>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kMaxRequest = 8 * 1024;
+
+bool wouldBlock() noexcept {
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+// {"serial":N,"takenAt":T,"<list>":[ ... the caller's items, then closeList
+void openList(std::string& out, const WorldStatus& status, std::string_view list) {
+    out.clear();
+    std::format_to(std::back_inserter(out), "{{\"serial\":{},\"takenAt\":{},\"{}\":[", status.serial, status.takenAt,
+                   list);
+}
+
+void closeList(std::string& out) {
+    if (out.back() == ',') {
+        out.pop_back();
+    }
+    out.append("]}\n");
+}
+
+} // namespace
+
+std::expected<std::unique_ptr<ApiServer>, NetError> ApiServer::start(const std::string& address, std::uint16_t port,
+                                                                     const std::string& origin,
+                                                                     const RcuDoubleBuffer<WorldStatus>& status) {
+    std::string corsHeader;
+    if (!origin.empty()) {
+        corsHeader = std::format("Access-Control-Allow-Origin: {}\r\n", origin);
+    }
+    std::unique_ptr<ApiServer> server(new ApiServer(status, std::move(corsHeader)));
+    server->m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server->m_listenFd < 0 || !SocketUtil::setNonBlocking(server->m_listenFd) || ::pipe(server->m_wakeFds) != 0) {
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    const int on = 1;
+    ::setsockopt(server->m_listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in bound{};
+    bound.sin_family = AF_INET;
+    bound.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &bound.sin_addr) != 1 ||
+        ::bind(server->m_listenFd, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound)) != 0) {
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    if (::listen(server->m_listenFd, 64) != 0) {
+        return std::unexpected(NetError::LISTEN_FAILED);
+    }
+    server->m_thread = std::thread([raw = server.get()] { raw->run(); });
+    return server;
+}
+
+ApiServer::~ApiServer() {
+    if (m_thread.joinable()) {
+        const char stop = 0;
+        [[maybe_unused]] const ssize_t wrote = ::write(m_wakeFds[1], &stop, 1);
+        m_thread.join();
+    }
+    for (const int fd : {m_listenFd, m_wakeFds[0], m_wakeFds[1]}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    for (const Client& client : m_clients) {
+        ::close(client.fd);
+    }
+}
+
+void ApiServer::run() {
+    std::vector<pollfd> ready;
+    for (;;) {
+        // Those out of time are cut off, whether still sending or still being sent to
+        const auto now = std::chrono::steady_clock::now();
+        std::erase_if(m_clients, [now](const Client& client) {
+            if (now < client.deadline) {
+                return false;
+            }
+            ::close(client.fd);
+            return true;
+        });
+
+        // While it is full, the listening socket is left for the backlog
+        ready.clear();
+        ready.push_back({m_wakeFds[0], POLLIN, 0});
+        ready.push_back({m_listenFd, static_cast<short>(m_clients.size() < kMaxClients ? POLLIN : 0), 0});
+        int timeout = -1;
+        for (const Client& client : m_clients) {
+            ready.push_back({client.fd, static_cast<short>(client.reply.empty() ? POLLIN : POLLOUT), 0});
+            const auto left = std::chrono::ceil<std::chrono::milliseconds>(client.deadline - now).count();
+            timeout = timeout < 0 ? static_cast<int>(left) : std::min(timeout, static_cast<int>(left));
+        }
+        if (::poll(ready.data(), ready.size(), timeout) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (ready[0].revents != 0) {
+            return;
+        }
+
+        // The clients polled, before any accepted now are added after them
+        for (std::size_t i = 0; i < m_clients.size(); ++i) {
+            Client& client = m_clients[i];
+            if (ready[i + 2].revents != 0 && !serve(client)) {
+                ::close(client.fd);
+                client.fd = -1;
+            }
+        }
+        std::erase_if(m_clients, [](const Client& client) { return client.fd < 0; });
+        if (ready[1].revents & POLLIN) {
+            accept(std::chrono::steady_clock::now());
+        }
+    }
+}
+
+void ApiServer::accept(std::chrono::steady_clock::time_point now) {
+    while (m_clients.size() < kMaxClients) {
+        const int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (!SocketUtil::setNonBlocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+        m_clients.push_back({fd, now + kClientDeadline, {}, {}, 0});
+    }
+}
+
+bool ApiServer::serve(Client& client) {
+    if (client.reply.empty()) {
+        char buffer[1024];
+        while (client.request.find("\r\n\r\n") == std::string::npos && client.request.size() < kMaxRequest) {
+            const ssize_t got = ::recv(client.fd, buffer, sizeof buffer, 0);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got < 0 && wouldBlock()) {
+                return true;
+            }
+            if (got <= 0) {
+                return false;
+            }
+            client.request.append(buffer, static_cast<std::size_t>(got));
+        }
+        respond(client);
+    }
+    while (client.sent < client.reply.size()) {
+        const ssize_t sent = ::send(client.fd, client.reply.data() + client.sent, client.reply.size() - client.sent,
+                                    SocketUtil::kSendFlags);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && wouldBlock()) {
+            return true;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        client.sent += static_cast<std::size_t>(sent);
+    }
+    return false;
+}
+
+void ApiServer::respond(Client& client) {
+    // Only the request line matters, and of the target only its path
+    const std::string_view line = std::string_view(client.request).substr(0, client.request.find("\r\n"));
+    std::string_view target = line.starts_with("GET ") ? line.substr(4, line.find(' ', 4) - 4) : "";
+    target = target.substr(0, target.find('?'));
+
+    render();
+    const std::string* body = target == "/api/who"     ? &m_who
+                              : target == "/api/top"   ? &m_top
+                              : target == "/api/zones" ? &m_zones
+                                                       : nullptr;
+    if (!body) {
+        client.reply = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 10\r\n"
+                       "Connection: close\r\n\r\nNot found\n";
+        return;
+    }
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+    // A status is a second old at most. The body is copied, as the next
+    // status may be rendered over it before this reply is all sent
+    client.reply = std::format("HTTP/1.1 200 OK\r\n"
+                               "Content-Type: application/json\r\n"
+                               "Cache-Control: max-age=1\r\n"
+                               "{}"
+                               "Content-Length: {}\r\nConnection: close\r\n\r\n",
+                               m_corsHeader, body->size());
+    client.reply += *body;
+}
+
+// The bodies, again only if a newer status has been published
+void ApiServer::render() {
+    const rcu::Guard guard;
+    const WorldStatus& status = m_status.load();
+    if (status.serial == m_rendered && !m_who.empty()) {
+        return;
+    }
+    m_rendered = status.serial;
+
+    openList(m_who, status, "players");
+    for (const WorldStatus::Player& player : status.players) {
+        m_who.append("{\"name\":");
+        appendJsonString(m_who, player.name);
+        std::format_to(std::back_inserter(m_who), ",\"zone\":{}}},", player.zone);
+    }
+    closeList(m_who);
+
+    openList(m_top, status, "players");
+    for (const std::uint32_t index : status.top) {
+        const WorldStatus::Player& player = status.players[index];
+        m_top.append("{\"name\":");
+        appendJsonString(m_top, player.name);
+        std::format_to(std::back_inserter(m_top), ",\"power\":{},\"health\":{},\"maxHealth\":{}}},", player.power,
+                       player.health, player.maxHealth);
+    }
+    closeList(m_top);
+
+    openList(m_zones, status, "zones");
+    for (const WorldStatus::Zone& zone : status.zones) {
+        std::format_to(std::back_inserter(m_zones), "{{\"id\":{},\"players\":{},\"loaded\":{}}},", zone.id,
+                       zone.players, zone.loaded);
+    }
+    closeList(m_zones);
+}
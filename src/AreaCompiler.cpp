@@ -0,0 +1,284 @@
+#include "../include/AreaCompiler.h"
+#include "../include/CommandTokens.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+constexpr std::string_view kSpace = " \t\r\f\v";
+
+// Split off the first whitespace-separated word of text
+std::string_view nextWord(std::string_view& text) {
+    text.remove_prefix(std::min(text.find_first_not_of(kSpace), text.size()));
+    const std::string_view word = text.substr(0, text.find_first_of(kSpace));
+    text.remove_prefix(word.size());
+    text.remove_prefix(std::min(text.find_first_not_of(kSpace), text.size()));
+    return word;
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && ec == std::errc() && end == text.data() + text.size();
+}
+
+} // namespace
+
+void AreaCompiler::add(std::string_view text, std::string_view file) {
+    const Where start{intern(file), 0};
+    m_zone.reset();
+    m_room.reset();
+    m_describing = Describing::Nothing;
+    std::size_t line = 0;
+    while (!text.empty()) {
+        const std::size_t end = std::min(text.find('\n'), text.size());
+        readLine(text.substr(0, end), {start.file, ++line});
+        text.remove_prefix(std::min(end + 1, text.size()));
+    }
+}
+
+void AreaCompiler::error(Where where, std::string_view message) {
+    m_errors.push_back(where.file.empty() ? std::string(message)
+                                          : std::format("{}:{}: {}", where.file, where.line, message));
+}
+
+ZoneId AreaCompiler::zone(std::string_view name, Where where) {
+    if (const auto found = m_zones.find(name); found != m_zones.end()) {
+        return found->second;
+    }
+    if (m_zoneCount > std::numeric_limits<ZoneId>::max()) {
+        const std::size_t most = std::size_t{std::numeric_limits<ZoneId>::max()} + 1;
+        error(where, std::format("too many zones; at most {} fit", most));
+        return 0;
+    }
+    const ZoneId id = static_cast<ZoneId>(m_zoneCount++);
+    m_zones.emplace(intern(name), id);
+    return id;
+}
+
+void AreaCompiler::readLine(std::string_view line, Where where) {
+    const CommandTokens tokens(line);
+    if (tokens.empty() || tokens.verb() == "#") {
+        return;
+    }
+    const std::string_view keyword = tokens.verb();
+    std::string_view args = tokens.args();
+
+    if (keyword == "zone") {
+        if (args.empty()) {
+            error(where, "zone needs a name");
+            return;
+        }
+        m_zone = zone(args, where);
+        m_room.reset();
+        m_describing = Describing::Nothing;
+    } else if (keyword == "room") {
+        if (args.empty()) {
+            error(where, "room needs a name");
+            return;
+        }
+        if (const auto found = m_roomsByName.find(args); found != m_roomsByName.end()) {
+            const Where first = m_rooms[found->second].where;
+            error(where, std::format("room '{}' is already defined at {}:{}", args, first.file, first.line));
+            m_room.reset();
+            m_describing = Describing::Nothing;
+            return;
+        }
+        Room& room = m_rooms.emplace_back();
+        room.name = intern(args);
+        room.zone = m_zone ? *m_zone : zone({}, where);
+        room.where = where;
+        m_roomsByName.emplace(room.name, m_rooms.size() - 1);
+        m_room = m_rooms.size() - 1;
+        m_describing = Describing::Room;
+    } else if (keyword == "desc") {
+        std::string* description = m_describing == Describing::Room ? &m_rooms[*m_room].description
+                                 : m_describing == Describing::Prototype ? &m_prototypes.back().description
+                                 : nullptr;
+        if (!description) {
+            error(where, "desc outside a room or prototype");
+            return;
+        }
+        if (!description->empty() && !args.empty()) {
+            *description += ' ';
+        }
+        *description += args;
+    } else if (keyword == "exit" || keyword == "item" || keyword == "npc") {
+        if (!m_room) {
+            error(where, std::format("{} outside a room", keyword));
+            return;
+        }
+        Room& room = m_rooms[*m_room];
+        if (keyword == "exit") {
+            const std::string_view word = nextWord(args);
+            const Direction dir = parseDirection(word);
+            if (dir == Direction::Count || args.empty()) {
+                error(where, "exit needs a direction and a room");
+                return;
+            }
+            const std::size_t slot = static_cast<std::size_t>(dir);
+            if (!room.exits[slot].empty()) {
+                error(where, std::format("room '{}' already has an exit {}", room.name, directionName(dir)));
+                return;
+            }
+            room.exits[slot] = intern(args);
+            room.exitsWhere[slot] = where;
+        } else if (keyword == "item") {
+            if (args.empty()) {
+                error(where, "item needs a prototype");
+                return;
+            }
+            m_items.push_back({intern(args), room.name, where});
+        } else {
+            readNpc(args, where);
+        }
+        m_describing = Describing::Room;
+    } else if (keyword == "prototype") {
+        const std::string_view name = nextWord(args);
+        if (name.empty()) {
+            error(where, "prototype needs a name");
+            return;
+        }
+        ItemPrototype prototype{std::string(name), {}, 0};
+        while (!args.empty()) {
+            const std::string_view option = nextWord(args);
+            if (option != "decay" || !parseNumber(nextWord(args), prototype.decayTicks)) {
+                error(where, std::format("prototype '{}': expected decay TICKS", name));
+                return;
+            }
+        }
+        if (const auto found = m_prototypesByName.find(name); found != m_prototypesByName.end()) {
+            const Where first = m_prototypesWhere[found->second];
+            error(where, std::format("prototype '{}' is already defined at {}:{}", name, first.file, first.line));
+            m_describing = Describing::Nothing;
+            return;
+        }
+        m_prototypesByName.emplace(intern(name), static_cast<std::uint32_t>(m_prototypes.size()));
+        m_prototypes.push_back(std::move(prototype));
+        m_prototypesWhere.push_back(where);
+        m_room.reset();
+        m_describing = Describing::Prototype;
+    } else if (keyword == "start") {
+        if (args.empty()) {
+            error(where, "start needs a room");
+            return;
+        }
+        if (!m_start.empty()) {
+            error(where, std::format("start is already set at {}:{}", m_startWhere.file, m_startWhere.line));
+            return;
+        }
+        m_start = intern(args);
+        m_startWhere = where;
+    } else {
+        error(where, std::format("unknown keyword '{}'", keyword));
+    }
+}
+
+void AreaCompiler::readNpc(std::string_view args, Where where) {
+    Npc npc;
+    const std::string_view name = nextWord(args);
+    if (name.empty()) {
+        error(where, "npc needs a name");
+        return;
+    }
+    npc.npc.name = name;
+    while (!args.empty()) {
+        const std::string_view option = nextWord(args);
+        const std::string_view value = nextWord(args);
+        bool ok = false;
+        if (option == "wander") {
+            ok = parseNumber(value, npc.npc.wanderTicks);
+        } else if (option == "regen") {
+            ok = parseNumber(value, npc.npc.regen);
+        } else if (option == "health") {
+            // CURRENT/MAX, or one number for both
+            const std::size_t slash = value.find('/');
+            ok = parseNumber(value.substr(0, slash), npc.npc.health);
+            npc.npc.maxHealth = npc.npc.health;
+            if (ok && slash != std::string_view::npos) {
+                ok = parseNumber(value.substr(slash + 1), npc.npc.maxHealth) && npc.npc.health <= npc.npc.maxHealth;
+            }
+        }
+        if (!ok) {
+            error(where, std::format("npc '{}': expected wander TICKS, health CURRENT/MAX or regen AMOUNT", name));
+            return;
+        }
+    }
+    npc.room = m_rooms[*m_room].name;
+    npc.where = where;
+    m_npcs.push_back(std::move(npc));
+}
+
+std::optional<AreaSource> AreaCompiler::finish() {
+    if (m_rooms.empty()) {
+        error({}, "no rooms");
+        return std::nullopt;
+    }
+    if (m_rooms.size() >= kInvalidRoomId) {
+        error({}, "too many rooms");
+        return std::nullopt;
+    }
+
+    // Zone by zone, in the order written within each
+    std::vector<std::size_t> order(m_rooms.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [this](std::size_t a, std::size_t b) { return m_rooms[a].zone < m_rooms[b].zone; });
+    std::vector<RoomId> ids(m_rooms.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        ids[order[i]] = static_cast<RoomId>(i);
+    }
+    const auto roomId = [&](std::string_view name) {
+        const auto found = m_roomsByName.find(name);
+        return found != m_roomsByName.end() ? ids[found->second] : kInvalidRoomId;
+    };
+
+    AreaSource source;
+    source.rooms.reserve(m_rooms.size());
+    for (std::size_t index : order) {
+        const Room& room = m_rooms[index];
+        source.rooms.addRoomView(room.name, intern(room.description), room.zone);
+    }
+    for (std::size_t index : order) {
+        const Room& room = m_rooms[index];
+        for (std::size_t dir = 0; dir < kDirectionCount; ++dir) {
+            if (room.exits[dir].empty()) {
+                continue;
+            }
+            const RoomId to = roomId(room.exits[dir]);
+            if (to == kInvalidRoomId) {
+                error(room.exitsWhere[dir], std::format("exit {} of '{}' leads to unknown room '{}'",
+                                                        directionName(static_cast<Direction>(dir)), room.name,
+                                                        room.exits[dir]));
+                continue;
+            }
+            source.rooms.link(ids[index], static_cast<Direction>(dir), to);
+        }
+    }
+
+    source.startRoom = m_start.empty() ? ids[0] : roomId(m_start);
+    if (source.startRoom == kInvalidRoomId) {
+        error(m_startWhere, std::format("start room '{}' is not defined", m_start));
+    }
+    source.prototypes = m_prototypes;
+    for (const Npc& npc : m_npcs) {
+        source.npcs.push_back(npc.npc);
+        source.npcs.back().room = roomId(npc.room);
+    }
+    for (const Item& item : m_items) {
+        const auto prototype = m_prototypesByName.find(item.prototype);
+        if (prototype == m_prototypesByName.end()) {
+            error(item.where, std::format("item '{}' has no prototype", item.prototype));
+            continue;
+        }
+        source.items.push_back({prototype->second, roomId(item.room)});
+    }
+
+    if (!m_errors.empty()) {
+        return std::nullopt;
+    }
+    return source;
+}
@@ -0,0 +1,304 @@
+#include "../include/AreaFile.h"
+#include "../include/DescriptionStore.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'E', 'M', 'A', 'R', 'E', 'A', '1', '\n'};
+
+bool inZone(std::span<const ZoneId> roomZones, RoomId room, ZoneId zone) {
+    return room < roomZones.size() && roomZones[room] == zone;
+}
+
+// Each distinct string once, in order of first use; worlds repeat
+// descriptions and NPC names a great deal. The views are the source's,
+// which outlives the write
+class StringTable {
+public:
+    SavedString add(std::string_view text) {
+        const auto [found, added] = m_refs.try_emplace(text);
+        if (added) {
+            found->second = mapped::addString(m_bytes, text);
+        }
+        return found->second;
+    }
+
+    // Bytes no other string shares, such as a packed description
+    SavedString addUnshared(std::string_view bytes) { return mapped::addString(m_bytes, bytes); }
+
+    const std::string& bytes() const noexcept { return m_bytes; }
+
+private:
+    std::string m_bytes;
+    std::unordered_map<std::string_view, SavedString> m_refs;
+};
+
+} // namespace
+
+AreaFile AreaFile::open(const std::filesystem::path& path) {
+    AreaFile area;
+    auto file = std::make_shared<const FileView>(path);
+    const std::string_view bytes = file->bytes();
+
+    // Mappings are page-aligned; anything less could not be read as the structs
+    if (bytes.size() < sizeof(AreaHeader)
+        || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(AreaHeader) != 0) {
+        return {};
+    }
+    const auto* header = reinterpret_cast<const AreaHeader*>(bytes.data());
+    // Version 1 files are version 2 with nothing packed
+    if (header->magic != kMagic || header->version < 1 || header->version > kVersion
+        || header->headerSize < sizeof(AreaHeader)
+        || header->headerSize > bytes.size() || header->fileSize != bytes.size()) {
+        return {};
+    }
+
+    const char* strings = mapped::section<char>(bytes, header->strings);
+    const auto* exits = mapped::section<RoomGraph::ExitArray>(bytes, header->exits);
+    const auto* roomZones = mapped::section<ZoneId>(bytes, header->roomZones);
+    const auto* roomText = mapped::section<AreaRoomText>(bytes, header->roomText);
+    const auto* nameIndex = mapped::section<RoomId>(bytes, header->nameIndex);
+    const auto* zones = mapped::section<AreaZone>(bytes, header->zones);
+    const auto* prototypes = mapped::section<AreaPrototype>(bytes, header->prototypes);
+    const auto* npcs = mapped::section<AreaNpc>(bytes, header->npcs);
+    const auto* items = mapped::section<AreaItem>(bytes, header->items);
+    const char* dictionary = mapped::section<char>(bytes, header->dictionary);
+    const auto* packedRooms = mapped::section<std::uint8_t>(bytes, header->packedRooms);
+    if (!strings || !exits || !roomZones || !roomText || !nameIndex || !zones || !prototypes || !npcs || !items
+        || !dictionary || !packedRooms) {
+        return {};
+    }
+    const std::uint32_t rooms = header->exits.count;
+    if (rooms == 0 || header->roomZones.count != rooms || header->roomText.count != rooms
+        || header->nameIndex.count != rooms || header->startRoom >= rooms || header->zones.count == 0
+        || header->zones.count > std::size_t{std::numeric_limits<ZoneId>::max()} + 1) {
+        return {};
+    }
+    // Packed rooms are unreadable without zstd, and without the dictionary
+    if (header->packedRooms.count != 0
+        && (header->packedRooms.count != rooms || header->dictionary.count == 0 || !DescriptionStore::available())) {
+        return {};
+    }
+
+    // One pass over the fixed-size columns the engine copies anyway; the
+    // strings they refer to are only bounds-checked, not read
+    const std::size_t tableSize = header->strings.count;
+    for (std::uint32_t room = 0; room < rooms; ++room) {
+        for (RoomId to : exits[room]) {
+            if (to >= rooms && to != kInvalidRoomId) {
+                return {};
+            }
+        }
+        if (roomZones[room] >= header->zones.count || nameIndex[room] >= rooms
+            || !mapped::inTable(roomText[room].name, tableSize)
+            || !mapped::inTable(roomText[room].description, tableSize)) {
+            return {};
+        }
+    }
+    for (std::uint32_t i = 0; i < header->prototypes.count; ++i) {
+        if (!mapped::inTable(prototypes[i].name, tableSize) || !mapped::inTable(prototypes[i].description, tableSize)) {
+            return {};
+        }
+    }
+    for (std::uint32_t i = 0; i < header->zones.count; ++i) {
+        if (std::uint64_t{zones[i].firstNpc} + zones[i].npcCount > header->npcs.count
+            || std::uint64_t{zones[i].firstItem} + zones[i].itemCount > header->items.count) {
+            return {};
+        }
+    }
+
+    area.m_header = header;
+    area.m_strings = {strings, tableSize};
+    area.m_exits = {exits, rooms};
+    area.m_roomZones = {roomZones, rooms};
+    area.m_roomText = {roomText, rooms};
+    area.m_nameIndex = {nameIndex, rooms};
+    area.m_zones = {zones, header->zones.count};
+    area.m_prototypes = {prototypes, header->prototypes.count};
+    area.m_npcs = {npcs, header->npcs.count};
+    area.m_items = {items, header->items.count};
+    area.m_packedRooms = {packedRooms, header->packedRooms.count};
+    area.m_dictionary = {dictionary, header->dictionary.count};
+    area.m_file = std::move(file);
+    return area;
+}
+
+std::optional<AreaFile::Zone> AreaFile::zone(ZoneId zone) const {
+    if (zone >= m_zones.size()) {
+        return std::nullopt;
+    }
+    const AreaZone& where = m_zones[zone];
+    const Zone records{m_npcs.subspan(where.firstNpc, where.npcCount), m_items.subspan(where.firstItem, where.itemCount)};
+    for (const AreaNpc& npc : records.npcs) {
+        if (!mapped::inTable(npc.name, m_strings.size()) || !inZone(m_roomZones, npc.room, zone)) {
+            return std::nullopt;
+        }
+    }
+    for (const AreaItem& item : records.items) {
+        if (item.prototype >= m_prototypes.size() || !inZone(m_roomZones, item.room, zone)) {
+            return std::nullopt;
+        }
+    }
+    return records;
+}
+
+void AreaFile::willNeed(ZoneId zone) const {
+    if (zone >= m_zones.size()) {
+        return;
+    }
+    const AreaZone& where = m_zones[zone];
+    const auto bytes = [](auto records) {
+        return std::string_view(reinterpret_cast<const char*>(records.data()), records.size_bytes());
+    };
+    m_file->willNeed(bytes(m_npcs.subspan(where.firstNpc, where.npcCount)));
+    m_file->willNeed(bytes(m_items.subspan(where.firstItem, where.itemCount)));
+}
+
+void AreaFile::willNeedRoom(RoomId room) const {
+    if (room < m_roomText.size()) {
+        m_file->willNeed(string(m_roomText[room].name));
+        m_file->willNeed(string(m_roomText[room].description));
+    }
+}
+
+bool AreaFile::write(const std::filesystem::path& path, const AreaSource& source) {
+    const RoomGraph& graph = source.rooms;
+    const std::size_t rooms = graph.size();
+    if (rooms == 0 || rooms >= kInvalidRoomId || source.startRoom >= rooms) {
+        return false;
+    }
+
+    // Rooms in order of name, which is also how two with one name are caught
+    std::vector<RoomId> nameIndex(rooms);
+    std::iota(nameIndex.begin(), nameIndex.end(), RoomId{0});
+    std::sort(nameIndex.begin(), nameIndex.end(),
+              [&graph](RoomId a, RoomId b) { return graph.name(a) < graph.name(b); });
+    const auto sameName = [&graph](RoomId a, RoomId b) { return graph.name(a) == graph.name(b); };
+    if (std::adjacent_find(nameIndex.begin(), nameIndex.end(), sameName) != nameIndex.end()) {
+        return false;
+    }
+
+    // The dictionary learns from every distinct description worth packing
+    std::vector<std::string_view> samples;
+    std::unordered_map<std::string_view, SavedString> packed;
+    for (RoomId room = 0; room < rooms; ++room) {
+        const std::string_view description = graph.description(room);
+        if (description.size() >= DescriptionPacker::kMinPackedSize && packed.try_emplace(description).second) {
+            samples.push_back(description);
+        }
+    }
+    DescriptionPacker packer(samples);
+    packed.clear();
+
+    // A room's name and description side by side, rooms in id order, so
+    // looking around one zone reads few pages of the table when its rooms
+    // are numbered together, as worldc numbers them
+    StringTable table;
+    std::vector<RoomGraph::ExitArray> exits(rooms);
+    std::vector<ZoneId> roomZones(rooms);
+    std::vector<AreaRoomText> roomText(rooms);
+    std::vector<std::uint8_t> packedRooms(packer.ready() ? rooms : 0);
+    std::uint64_t packedTextSize = 0;
+    std::string frame;
+    for (RoomId room = 0; room < rooms; ++room) {
+        exits[room] = graph.exits(room);
+        roomZones[room] = graph.zone(room);
+        const SavedString name = table.add(graph.name(room));
+        const std::string_view description = graph.description(room);
+        if (const auto found = packed.find(description); found != packed.end()) {
+            roomText[room] = {name, found->second};
+            packedRooms[room] = 1;
+        } else if (packer.ready() && packer.pack(description, frame)) {
+            const SavedString ref = table.addUnshared(frame);
+            packed.emplace(description, ref);
+            packedTextSize += description.size();
+            roomText[room] = {name, ref};
+            packedRooms[room] = 1;
+        } else {
+            roomText[room] = {name, table.add(description)};
+        }
+    }
+    if (packed.empty()) {
+        packedRooms.clear();
+    }
+
+    std::vector<AreaPrototype> prototypes;
+    prototypes.reserve(source.prototypes.size());
+    for (const ItemPrototype& prototype : source.prototypes) {
+        const bool taken = std::any_of(source.prototypes.data(), &prototype,
+                                       [&prototype](const ItemPrototype& other) { return other.name == prototype.name; });
+        if (taken) {
+            return false;
+        }
+        prototypes.push_back({table.add(prototype.name), table.add(prototype.description), prototype.decayTicks});
+    }
+
+    // NPCs and items grouped by the zone they start in, each group in the
+    // order given
+    std::vector<AreaZone> zones(graph.zoneCount());
+    for (const AreaSource::Npc& npc : source.npcs) {
+        if (npc.room >= rooms) {
+            return false;
+        }
+        ++zones[graph.zone(npc.room)].npcCount;
+    }
+    for (const AreaSource::Item& item : source.items) {
+        if (item.room >= rooms || item.prototype >= prototypes.size()) {
+            return false;
+        }
+        ++zones[graph.zone(item.room)].itemCount;
+    }
+    std::uint32_t npcCount = 0;
+    std::uint32_t itemCount = 0;
+    for (AreaZone& zone : zones) {
+        zone.firstNpc = npcCount;
+        zone.firstItem = itemCount;
+        npcCount += zone.npcCount;
+        itemCount += zone.itemCount;
+    }
+    std::vector<AreaNpc> npcs(npcCount);
+    std::vector<AreaItem> items(itemCount);
+    std::vector<std::uint32_t> npcsPlaced(zones.size());
+    std::vector<std::uint32_t> itemsPlaced(zones.size());
+    for (const AreaSource::Npc& npc : source.npcs) {
+        const ZoneId zone = graph.zone(npc.room);
+        npcs[zones[zone].firstNpc + npcsPlaced[zone]++] = {table.add(npc.name), npc.room, npc.wanderTicks,
+                                                           npc.health, npc.maxHealth, npc.regen};
+    }
+    for (const AreaSource::Item& item : source.items) {
+        const ZoneId zone = graph.zone(item.room);
+        items[zones[zone].firstItem + itemsPlaced[zone]++] = {item.prototype, item.room};
+    }
+
+    AreaHeader header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.headerSize = sizeof(AreaHeader);
+    header.startRoom = source.startRoom;
+    std::string contents(sizeof(AreaHeader), '\0');
+    header.exits = mapped::append(contents, std::span<const RoomGraph::ExitArray>(exits));
+    header.roomZones = mapped::append(contents, std::span<const ZoneId>(roomZones));
+    header.roomText = mapped::append(contents, std::span<const AreaRoomText>(roomText));
+    header.nameIndex = mapped::append(contents, std::span<const RoomId>(nameIndex));
+    header.zones = mapped::append(contents, std::span<const AreaZone>(zones));
+    header.prototypes = mapped::append(contents, std::span<const AreaPrototype>(prototypes));
+    header.npcs = mapped::append(contents, std::span<const AreaNpc>(npcs));
+    header.items = mapped::append(contents, std::span<const AreaItem>(items));
+    if (!packedRooms.empty()) {
+        header.dictionary = mapped::append(contents, std::span<const char>(packer.dictionary()));
+        header.packedRooms = mapped::append(contents, std::span<const std::uint8_t>(packedRooms));
+        header.packedTextSize = packedTextSize;
+    }
+    header.strings = mapped::append(contents, std::span<const char>(table.bytes()));
+    if (contents.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+    header.fileSize = contents.size();
+    std::memcpy(contents.data(), &header, sizeof header);
+
+    return mapped::replaceFile(path, contents);
+}
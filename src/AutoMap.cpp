@@ -0,0 +1,187 @@
+#include "../include/AutoMap.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// Cells a step in each direction moves; north is up
+constexpr std::array<int, kDirectionCount> kStepX = {0, 0, 1, -1};
+constexpr std::array<int, kDirectionCount> kStepY = {-1, 1, 0, 0};
+
+} // namespace
+
+void AutoMap::prepare(const RoomGraph& world, ZoneId zone) {
+    if (zone >= m_tiles.size()) {
+        m_tiles.resize(world.zoneCount());
+    }
+    if (zone >= m_tiles.size() || m_tiles[zone].layout == world.layoutVersion()) {
+        return;
+    }
+    index(world);
+    const std::span<const RoomId> rooms(m_zoneRooms.data() + m_zoneStart[zone],
+                                        m_zoneStart[zone + 1] - m_zoneStart[zone]);
+    draw(world, rooms, m_tiles[zone]);
+    ++m_tilesBuilt;
+}
+
+bool AutoMap::render(const RoomGraph& world, RoomId room, const Marker& marker, std::string& out, bool keep) {
+    if (!world.contains(room)) {
+        return false;
+    }
+    const ZoneId zone = world.zone(room);
+    if (keep) {
+        prepare(world, zone);
+    }
+    Tile scratch;
+    const Tile* tile = zone < m_tiles.size() ? &m_tiles[zone] : nullptr;
+    if (!tile || tile->layout != world.layoutVersion()) {
+        // Off the keeping thread, with the tile stale: draw the zone for this view alone
+        std::vector<RoomId> rooms;
+        for (RoomId each = 0; each < world.size(); ++each) {
+            if (world.zone(each) == zone) {
+                rooms.push_back(each);
+            }
+        }
+        draw(world, rooms, scratch);
+        tile = &scratch;
+    }
+    const auto at = std::ranges::lower_bound(tile->byRoom, room, {}, &Placed::room);
+    if (at == tile->byRoom.end() || at->room != room) {
+        return false;
+    }
+
+    // The window, the viewer at its middle, blank past the tile's edges
+    constexpr long kHalfWidth = 2 * kAcross;
+    constexpr long kHalfHeight = 2 * kDown;
+    constexpr long kWidth = 2 * kHalfWidth + 1;
+    const long left = static_cast<long>(at->x) - kHalfWidth;
+    const long top = static_cast<long>(at->y) - kHalfHeight;
+    const std::size_t base = out.size();
+    for (long y = top; y <= top + 2 * kHalfHeight; ++y) {
+        if (y < 0 || y >= static_cast<long>(tile->height)) {
+            out.append(kWidth, ' ');
+        } else {
+            const long from = std::max(left, 0L);
+            const long to = std::min(left + kWidth, static_cast<long>(tile->width));
+            out.append(static_cast<std::size_t>(from - left), ' ');
+            if (from < to) {
+                out.append(tile->cells, static_cast<std::size_t>(y) * tile->width + static_cast<std::size_t>(from),
+                           static_cast<std::size_t>(to - from));
+            }
+            out.append(static_cast<std::size_t>(left + kWidth - std::max(from, to)), ' ');
+        }
+        out += '\n';
+    }
+
+    // Then the overlay, on the rooms in sight alone
+    const auto cell = [&](const Placed& placed) -> char& {
+        return out[base + static_cast<std::size_t>(static_cast<long>(placed.y) - top) * (kWidth + 1) +
+                   static_cast<std::size_t>(static_cast<long>(placed.x) - left)];
+    };
+    const auto firstRow = std::ranges::lower_bound(tile->byRow, std::max(top, 0L), {},
+                                                   [](const Placed& placed) { return static_cast<long>(placed.y); });
+    for (auto it = firstRow; it != tile->byRow.end() && static_cast<long>(it->y) <= top + 2 * kHalfHeight; ++it) {
+        if (it->room != room && static_cast<long>(it->x) >= left && static_cast<long>(it->x) < left + kWidth) {
+            if (const char mark = marker ? marker(it->room) : '\0') {
+                cell(*it) = mark;
+            }
+        }
+    }
+    cell(*at) = '@';
+    return true;
+}
+
+// Every room by zone, in order of id, with a counting sort
+void AutoMap::index(const RoomGraph& world) {
+    if (m_indexed == world.layoutVersion()) {
+        return;
+    }
+    m_indexed = world.layoutVersion();
+    const std::size_t zones = world.zoneCount();
+    m_zoneStart.assign(zones + 1, 0);
+    for (RoomId room = 0; room < world.size(); ++room) {
+        ++m_zoneStart[world.zone(room) + 1];
+    }
+    for (std::size_t zone = 0; zone < zones; ++zone) {
+        m_zoneStart[zone + 1] += m_zoneStart[zone];
+    }
+    m_zoneRooms.resize(world.size());
+    std::vector<std::uint32_t> fill(m_zoneStart.begin(), m_zoneStart.end() - 1);
+    for (RoomId room = 0; room < world.size(); ++room) {
+        m_zoneRooms[fill[world.zone(room)]++] = room;
+    }
+}
+
+void AutoMap::draw(const RoomGraph& world, std::span<const RoomId> rooms, Tile& tile) {
+    tile.layout = world.layoutVersion();
+    tile.byRoom.clear();
+    tile.byRow.clear();
+
+    // Lay each part of the zone out on its own, in cells relative to where
+    // the walk began, then set it to the right of the parts before it
+    struct Cell {
+        int x = 0;
+        int y = 0;
+        bool placed = false;
+    };
+    std::vector<Cell> cells(rooms.size());
+    const auto slot = [&rooms](RoomId room) -> std::size_t {
+        const auto found = std::ranges::lower_bound(rooms, room);
+        return found != rooms.end() && *found == room ? static_cast<std::size_t>(found - rooms.begin()) : rooms.size();
+    };
+    std::vector<std::size_t> queue;
+    int right = 0;   // Columns taken by the parts laid out so far
+    int rows = 0;
+    for (std::size_t start = 0; start < rooms.size(); ++start) {
+        if (cells[start].placed) {
+            continue;
+        }
+        queue.assign(1, start);
+        cells[start].placed = true;
+        int minX = 0, maxX = 0, minY = 0, maxY = 0;
+        for (std::size_t next = 0; next < queue.size(); ++next) {
+            const Cell from = cells[queue[next]];
+            minX = std::min(minX, from.x);
+            maxX = std::max(maxX, from.x);
+            minY = std::min(minY, from.y);
+            maxY = std::max(maxY, from.y);
+            const RoomGraph::ExitArray& exits = world.exits(rooms[queue[next]]);
+            for (std::size_t dir = 0; dir < kDirectionCount; ++dir) {
+                const std::size_t to = exits[dir] == kInvalidRoomId ? rooms.size() : slot(exits[dir]);
+                if (to < rooms.size() && !cells[to].placed) {
+                    cells[to] = {from.x + kStepX[dir], from.y + kStepY[dir], true};
+                    queue.push_back(to);
+                }
+            }
+        }
+        for (const std::size_t placed : queue) {
+            cells[placed].x += right - minX;
+            cells[placed].y -= minY;
+        }
+        right += maxX - minX + 2;   // A blank column between parts
+        rows = std::max(rows, maxY - minY + 1);
+    }
+
+    // Room (x, y) is character (2x + 1, 2y + 1), leaving a border for stubs
+    const int columns = std::max(right - 1, 0);
+    tile.width = static_cast<std::uint32_t>(2 * columns + 1);
+    tile.height = static_cast<std::uint32_t>(2 * rows + 1);
+    tile.cells.assign(static_cast<std::size_t>(tile.width) * tile.height, ' ');
+    constexpr std::array<char, kDirectionCount> kExitMark = {'|', '|', '-', '-'};
+    for (std::size_t i = 0; i < rooms.size(); ++i) {
+        const std::uint32_t x = static_cast<std::uint32_t>(2 * cells[i].x + 1);
+        const std::uint32_t y = static_cast<std::uint32_t>(2 * cells[i].y + 1);
+        tile.cells[static_cast<std::size_t>(y) * tile.width + x] = '#';
+        const RoomGraph::ExitArray& exits = world.exits(rooms[i]);
+        for (std::size_t dir = 0; dir < kDirectionCount; ++dir) {
+            if (exits[dir] != kInvalidRoomId) {
+                const std::size_t at = static_cast<std::size_t>(static_cast<int>(y) + kStepY[dir]) * tile.width +
+                                       static_cast<std::size_t>(static_cast<int>(x) + kStepX[dir]);
+                tile.cells[at] = kExitMark[dir];
+            }
+        }
+        tile.byRoom.push_back({rooms[i], x, y});
+    }
+    tile.byRow = tile.byRoom;
+    std::ranges::sort(tile.byRow, [](const Placed& a, const Placed& b) { return a.y != b.y ? a.y < b.y : a.x < b.x; });
+}
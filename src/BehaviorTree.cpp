@@ -0,0 +1,247 @@
+#include "../include/BehaviorTree.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <iterator>
+
+namespace {
+
+struct Keyword {
+    std::string_view name;
+    BehaviorOp op;
+};
+
+constexpr Keyword kKeywords[] = {
+    {"sequence", BehaviorOp::Sequence}, {"selector", BehaviorOp::Selector}, {"not", BehaviorOp::Invert},
+    {"player-here", BehaviorOp::PlayerHere}, {"fighting", BehaviorOp::Fighting}, {"hurt", BehaviorOp::Hurt},
+    {"chance", BehaviorOp::Chance}, {"wander", BehaviorOp::Wander}, {"flee", BehaviorOp::Flee},
+    {"attack", BehaviorOp::Attack}, {"emote", BehaviorOp::Emote}, {"lua", BehaviorOp::Lua},
+};
+
+bool isComposite(BehaviorOp op) {
+    return op == BehaviorOp::Sequence || op == BehaviorOp::Selector || op == BehaviorOp::Invert;
+}
+
+bool isName(std::string_view name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+    });
+}
+
+std::string_view trimmed(std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+std::string folded(std::string_view text) {
+    std::string lower(text);
+    for (char& c : lower) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return lower;
+}
+
+} // namespace
+
+std::expected<BehaviorTrees, std::string> BehaviorTrees::parse(std::string_view text) {
+    BehaviorTrees trees;
+    std::string errors;
+    const auto fail = [&errors](std::size_t line, std::string_view message) {
+        std::format_to(std::back_inserter(errors), "{}line {}: {}", errors.empty() ? "" : "\n", line, message);
+    };
+
+    // The composites still taking children, innermost last
+    struct Open {
+        std::size_t indent;
+        std::uint32_t node;
+        std::uint32_t children;
+    };
+    std::vector<Open> open;
+    std::size_t treeIndent = 0;
+    std::size_t leafIndent = std::string_view::npos;   // The last node's, when it was a leaf
+    std::size_t started = 0;
+    const auto close = [&](std::size_t indent) {
+        while (!open.empty() && open.back().indent >= indent) {
+            const Open done = open.back();
+            open.pop_back();
+            BehaviorNode& node = trees.m_nodes[done.node];
+            node.end = static_cast<std::uint32_t>(trees.m_nodes.size());
+            if (node.op == BehaviorOp::Invert ? done.children != 1 : done.children == 0) {
+                fail(node.line, node.op == BehaviorOp::Invert ? "not takes one child"
+                                                              : "a sequence or selector needs children");
+            }
+        }
+    };
+    const auto finish = [&] {
+        close(0);
+        if (!trees.m_trees.empty()) {
+            Tree& tree = trees.m_trees.back();
+            tree.end = static_cast<std::uint32_t>(trees.m_nodes.size());
+            if (tree.root == tree.end) {
+                fail(started, std::format("{} has no nodes", tree.name));
+            }
+        }
+    };
+
+    std::size_t number = 0;
+    while (!text.empty()) {
+        const std::size_t lineEnd = std::min(text.find('\n'), text.size());
+        const std::string_view raw = text.substr(0, lineEnd);
+        text.remove_prefix(std::min(lineEnd + 1, text.size()));
+        ++number;
+        const std::string_view line = trimmed(raw);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        const std::size_t indent = raw.find_first_not_of(" \t");
+        const std::size_t space = std::min(line.find_first_of(" \t"), line.size());
+        const std::string keyword = folded(line.substr(0, space));
+        const std::string_view rest = trimmed(line.substr(space));
+
+        if (keyword == "tree") {
+            finish();
+            const std::size_t nameEnd = std::min(rest.find_first_of(" \t"), rest.size());
+            const std::string_view name = rest.substr(0, nameEnd);
+            std::string_view npcs = trimmed(rest.substr(nameEnd));
+            if (!isName(name)) {
+                fail(number, std::format("'{}' is not a tree's name, a lowercase word", name));
+            } else if (trees.m_byName.contains(name)) {
+                fail(number, std::format("{} is defined twice", name));
+            }
+            const auto id = static_cast<BehaviorId>(trees.m_trees.size());
+            trees.m_byName.emplace(std::string(name), id);
+            trees.m_trees.push_back({std::string(name), static_cast<std::uint32_t>(trees.m_nodes.size()), 0});
+            treeIndent = indent;
+            leafIndent = std::string_view::npos;
+            started = number;
+            if (!npcs.empty()) {
+                if (!npcs.starts_with("for ") && !npcs.starts_with("for\t")) {
+                    fail(number, "after the tree's name comes for and the NPCs it is given to");
+                    continue;
+                }
+                // Names may be several words, so they are split on commas
+                npcs = trimmed(npcs.substr(3));
+                while (!npcs.empty()) {
+                    const std::size_t comma = std::min(npcs.find(','), npcs.size());
+                    const std::string npc = folded(trimmed(npcs.substr(0, comma)));
+                    npcs.remove_prefix(std::min(comma + 1, npcs.size()));
+                    if (npc.empty()) {
+                        fail(number, "an empty NPC name");
+                    } else if (!trees.m_byNpc.emplace(npc, id).second) {
+                        fail(number, std::format("the {} already has a tree", npc));
+                    }
+                }
+            }
+            continue;
+        }
+
+        const auto known = std::ranges::find(kKeywords, keyword, &Keyword::name);
+        if (known == std::end(kKeywords)) {
+            fail(number, std::format("unknown keyword '{}'", keyword));
+            continue;
+        }
+        if (trees.m_trees.empty()) {
+            fail(number, std::format("{} before any tree", keyword));
+            continue;
+        }
+        if (indent <= treeIndent) {
+            fail(number, std::format("{} is not indented under its tree", keyword));
+            continue;
+        }
+        if (leafIndent != std::string_view::npos && indent > leafIndent) {
+            fail(number, std::format("{} is indented under a condition or action, which takes no children", keyword));
+            continue;
+        }
+        close(indent);
+        if (open.empty() && trees.m_nodes.size() > trees.m_trees.back().root) {
+            fail(number, "a second root; a tree has one node at the top");
+            continue;
+        }
+        if (open.size() >= kMaxDepth) {
+            fail(number, std::format("nested deeper than {}", kMaxDepth));
+            continue;
+        }
+
+        BehaviorNode node{known->op};
+        node.line = static_cast<std::uint16_t>(std::min<std::size_t>(number, UINT16_MAX));
+        switch (node.op) {
+            case BehaviorOp::Hurt:
+            case BehaviorOp::Chance: {
+                unsigned percent = 0;
+                const auto [end, error] = std::from_chars(rest.data(), rest.data() + rest.size(), percent);
+                if (error != std::errc() || end != rest.data() + rest.size() || percent == 0 || percent > 100) {
+                    fail(number, std::format("{} takes a percent from 1 to 100", keyword));
+                    continue;
+                }
+                node.arg = static_cast<std::uint8_t>(percent);
+                break;
+            }
+            case BehaviorOp::Emote: {
+                auto parsed = MessageTemplate::parse(std::string(rest));
+                if (!parsed) {
+                    fail(number, parsed.error());
+                    continue;
+                }
+                if (rest.empty() || parsed->arguments() > 1) {
+                    fail(number, "emote takes text, in which {0} is the NPC's name");
+                    continue;
+                }
+                node.data = static_cast<std::uint32_t>(trees.m_templates.size());
+                trees.m_templates.push_back(std::move(*parsed));
+                break;
+            }
+            case BehaviorOp::Lua: {
+                const std::size_t split = std::min(rest.find_first_of(" \t"), rest.size());
+                const std::string_view script = rest.substr(0, split);
+                const std::string_view hook = trimmed(rest.substr(split));
+                if (script.empty() || hook.empty() || hook.find_first_of(" \t") != std::string_view::npos) {
+                    fail(number, "lua takes a script and the name of its function");
+                    continue;
+                }
+                node.data = static_cast<std::uint32_t>(trees.m_luaLeaves.size());
+                trees.m_luaLeaves.push_back({std::string(script), std::string(hook), node.line});
+                break;
+            }
+            default:
+                if (!rest.empty()) {
+                    fail(number, std::format("{} takes nothing after it", keyword));
+                    continue;
+                }
+                break;
+        }
+
+        if (!open.empty()) {
+            ++open.back().children;
+        }
+        const auto at = static_cast<std::uint32_t>(trees.m_nodes.size());
+        node.end = at + 1;
+        trees.m_nodes.push_back(node);
+        if (isComposite(node.op)) {
+            open.push_back({indent, at, 0});
+            leafIndent = std::string_view::npos;
+        } else {
+            leafIndent = indent;
+        }
+    }
+    finish();
+
+    if (!errors.empty()) {
+        return std::unexpected(std::move(errors));
+    }
+    return trees;
+}
+
+BehaviorId BehaviorTrees::find(std::string_view name) const {
+    const auto found = m_byName.find(name);
+    return found != m_byName.end() ? found->second : kNoBehavior;
+}
+
+BehaviorId BehaviorTrees::forNpc(std::string_view name) const {
+    const auto found = m_byNpc.find(folded(name));
+    return found != m_byNpc.end() ? found->second : kNoBehavior;
+}
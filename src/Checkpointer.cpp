@@ -0,0 +1,67 @@
+#include "../include/Checkpointer.h"
+#include <algorithm>
+#include <utility>
+
+Checkpointer::Checkpointer(std::filesystem::path path)
+    : m_path(std::move(path)) {
+    m_thread = std::thread([this] { work(); });
+}
+
+Checkpointer::~Checkpointer() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void Checkpointer::submit(WorldSnapshot snapshot) {
+    // The snapshot replaced, if any, lets go of its pages outside the lock
+    std::optional<WorldSnapshot> replaced;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.submitted;
+        if (m_waiting) {
+            ++m_stats.skipped;
+            replaced = std::move(m_waiting);
+        }
+        m_waiting = std::move(snapshot);
+    }
+    m_wake.notify_one();
+}
+
+void Checkpointer::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return !m_waiting && !m_writing; });
+}
+
+CheckpointStats Checkpointer::stats() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void Checkpointer::work() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_stopping || m_waiting; });
+        if (!m_waiting) {
+            return;
+        }
+        std::optional<WorldSnapshot> snapshot = std::exchange(m_waiting, std::nullopt);
+        m_writing = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = snapshot->write(m_path);
+        const auto took = std::chrono::steady_clock::now() - start;
+        // Pages only the snapshot still held are freed here, not on the game thread
+        snapshot.reset();
+
+        lock.lock();
+        ++(ok ? m_stats.written : m_stats.failed);
+        m_stats.longestWrite = std::max(m_stats.longestWrite, std::chrono::duration_cast<std::chrono::nanoseconds>(took));
+        m_writing = false;
+        m_idle.notify_all();
+    }
+}
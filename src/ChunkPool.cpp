@@ -0,0 +1,208 @@
+#include "../include/ChunkPool.h"
+#include <algorithm>
+#include <cstring>
+
+bool ChunkPool::append(ChunkChain& chain, std::string_view bytes) {
+    if (bytes.empty()) {
+        return true;
+    }
+    const std::size_t total = bytes.size();
+
+    // Take every chunk the bytes need beyond the tail's free room first, so
+    // running out leaves the chain untouched
+    const std::size_t room = tailRoom(chain);
+    std::uint32_t first = kNone;
+    std::uint32_t last = kNone;
+    for (std::size_t reserved = room; reserved < total; reserved += kChunkSize) {
+        const std::uint32_t chunk = allocate();
+        if (chunk == kNone) {
+            while (first != kNone) {
+                const std::uint32_t next = m_links[first].next;
+                releaseLink(first);
+                first = next;
+            }
+            return false;
+        }
+        const std::uint32_t link = addLink(chunk, 0, 0);
+        m_chunks[chunk].writer = link;
+        if (last == kNone) {
+            first = link;
+        } else {
+            m_links[last].next = link;
+        }
+        last = link;
+    }
+
+    if (room > 0) {
+        Link& tail = m_links[chain.tail];
+        const std::size_t count = std::min(room, bytes.size());
+        std::memcpy(data(tail.chunk) + tail.end, bytes.data(), count);
+        tail.end += static_cast<std::uint32_t>(count);
+        m_chunks[tail.chunk].size = tail.end;
+        bytes.remove_prefix(count);
+    }
+    for (std::uint32_t link = first; link != kNone; link = m_links[link].next) {
+        const std::size_t count = std::min(kChunkSize, bytes.size());
+        std::memcpy(data(m_links[link].chunk), bytes.data(), count);
+        m_links[link].end = static_cast<std::uint32_t>(count);
+        m_chunks[m_links[link].chunk].size = static_cast<std::uint32_t>(count);
+        bytes.remove_prefix(count);
+    }
+
+    if (first != kNone) {
+        if (chain.tail == kNone) {
+            chain.head = first;
+        } else {
+            m_links[chain.tail].next = first;
+        }
+        chain.tail = last;
+    }
+    chain.size += total;
+    return true;
+}
+
+void ChunkPool::appendShared(ChunkChain& chain, const ChunkChain& source, std::size_t offset, std::size_t count) {
+    count = std::min(count, source.size - std::min(offset, source.size));
+    if (count == 0) {
+        return;
+    }
+    // A short message copied into room the chain already holds costs less
+    // than a link, and leaves that room usable for what follows it
+    const bool copy = count <= tailRoom(chain);
+    chain.size += copy ? 0 : count;
+    for (std::uint32_t from = source.head; from != kNone && count > 0; from = m_links[from].next) {
+        const Link& piece = m_links[from];
+        const std::size_t available = piece.end - piece.begin;
+        if (offset >= available) {
+            offset -= available;
+            continue;
+        }
+        const auto begin = piece.begin + static_cast<std::uint32_t>(offset);
+        const auto end = begin + static_cast<std::uint32_t>(std::min<std::size_t>(count, available - offset));
+        offset = 0;
+        count -= end - begin;
+        if (copy) {
+            append(chain, std::string_view(data(piece.chunk) + begin, end - begin));
+        } else if (chain.tail != kNone && m_links[chain.tail].chunk == piece.chunk && m_links[chain.tail].end == begin) {
+            // Follows on from the last message shared out of this chunk
+            m_links[chain.tail].end = end;
+        } else {
+            const std::uint32_t link = addLink(piece.chunk, begin, end);
+            if (chain.tail == kNone) {
+                chain.head = link;
+            } else {
+                m_links[chain.tail].next = link;
+            }
+            chain.tail = link;
+        }
+    }
+}
+
+void ChunkPool::consume(ChunkChain& chain, std::size_t count) {
+    count = std::min(count, chain.size);
+    chain.size -= count;
+    while (chain.head != kNone) {
+        Link& head = m_links[chain.head];
+        const std::size_t available = head.end - head.begin;
+        if (count < available) {
+            head.begin += static_cast<std::uint32_t>(count);
+            return;
+        }
+        // Fully consumed links go straight back, so an idle chain holds no chunks
+        count -= available;
+        const std::uint32_t next = head.next;
+        releaseLink(chain.head);
+        chain.head = next;
+    }
+    chain.tail = kNone;
+}
+
+void ChunkPool::consumeAll(ChunkChain& chain) {
+    if (chain.tail == kNone || tailRoom(chain) == 0) {
+        clear(chain);
+        return;
+    }
+    while (chain.head != chain.tail) {
+        const std::uint32_t next = m_links[chain.head].next;
+        releaseLink(chain.head);
+        chain.head = next;
+    }
+    m_links[chain.tail].begin = m_links[chain.tail].end;
+    chain.size = 0;
+}
+
+void ChunkPool::clear(ChunkChain& chain) {
+    while (chain.head != kNone) {
+        const std::uint32_t next = m_links[chain.head].next;
+        releaseLink(chain.head);
+        chain.head = next;
+    }
+    chain = ChunkChain{};
+}
+
+std::string_view ChunkPool::front(const ChunkChain& chain) const noexcept {
+    if (chain.head == kNone) {
+        return {};
+    }
+    return segment(m_links[chain.head]);
+}
+
+std::size_t ChunkPool::tailRoom(const ChunkChain& chain) const noexcept {
+    if (chain.tail == kNone) {
+        return 0;
+    }
+    // Only the link that filled a chunk appends to it. Links sharing the
+    // chunk name bytes before its end, so writing past it cannot disturb
+    // them or a send in flight
+    const Link& tail = m_links[chain.tail];
+    const Chunk& chunk = m_chunks[tail.chunk];
+    return chunk.writer == chain.tail ? kChunkSize - chunk.size : 0;
+}
+
+std::uint32_t ChunkPool::allocate() {
+    if (m_free.empty()) {
+        if (m_slabs.size() >= m_maxSlabs) {
+            return kNone;
+        }
+        TrackedBuffer slab = makeTrackedBuffer(MemoryTag::Sessions, kSlabSize);
+        if (m_onSlab) {
+            m_onSlab(m_slabs.size(), slab.get(), kSlabSize);
+        }
+        const auto base = static_cast<std::uint32_t>(m_chunks.size());
+        m_slabs.push_back(std::move(slab));
+        m_chunks.resize(m_chunks.size() + kChunksPerSlab);
+        // Lowest ids are handed out first
+        for (std::size_t i = kChunksPerSlab; i-- > 0;) {
+            m_free.push_back(base + static_cast<std::uint32_t>(i));
+        }
+    }
+    const std::uint32_t chunk = m_free.back();
+    m_free.pop_back();
+    m_chunks[chunk] = Chunk{};
+    return chunk;
+}
+
+std::uint32_t ChunkPool::addLink(std::uint32_t chunk, std::uint32_t begin, std::uint32_t end) {
+    std::uint32_t link;
+    if (m_freeLinks.empty()) {
+        link = static_cast<std::uint32_t>(m_links.size());
+        m_links.emplace_back();
+    } else {
+        link = m_freeLinks.back();
+        m_freeLinks.pop_back();
+    }
+    m_links[link] = Link{chunk, kNone, begin, end};
+    ++m_chunks[chunk].refs;
+    return link;
+}
+
+void ChunkPool::releaseLink(std::uint32_t link) {
+    const std::uint32_t chunk = m_links[link].chunk;
+    if (m_chunks[chunk].writer == link) {
+        m_chunks[chunk].writer = kNone;
+    }
+    if (--m_chunks[chunk].refs == 0) {
+        m_free.push_back(chunk);
+    }
+    m_freeLinks.push_back(link);
+}
@@ -0,0 +1,170 @@
+#include "../include/ColorMarkup.h"
+#include <charconv>
+
+namespace {
+
+// Markup colors use pairs kPairBase + fg * 8 + bg, clear of the UI's own pairs
+constexpr short kPairBase = 16;
+constexpr short kColorCount = 8;
+bool g_pairsReady = false;
+
+struct MarkupState {
+    short fg = -1;   // -1 keeps the base attributes' color
+    short bg = -1;
+    attr_t flags = A_NORMAL;
+};
+
+attr_t resolve(const MarkupState& state, attr_t base) {
+    if (state.fg < 0 && state.bg < 0) {
+        return base | state.flags;
+    }
+    attr_t color = base & A_COLOR;
+    if (g_pairsReady) {
+        short fg = state.fg < 0 ? COLOR_WHITE : state.fg;
+        short bg = state.bg < 0 ? COLOR_BLACK : state.bg;
+        color = COLOR_PAIR(kPairBase + fg * kColorCount + bg);
+    }
+    return (base & ~A_COLOR) | color | state.flags;
+}
+
+void applySgr(MarkupState& state, int code) {
+    switch (code) {
+        case 0:  state = MarkupState{};         break;
+        case 1:  state.flags |= A_BOLD;         break;
+        case 4:  state.flags |= A_UNDERLINE;    break;
+        case 5:  state.flags |= A_BLINK;        break;
+        case 7:  state.flags |= A_REVERSE;      break;
+        case 22: state.flags &= ~A_BOLD;        break;
+        case 24: state.flags &= ~A_UNDERLINE;   break;
+        case 25: state.flags &= ~A_BLINK;       break;
+        case 27: state.flags &= ~A_REVERSE;     break;
+        case 39: state.fg = -1;                 break;
+        case 49: state.bg = -1;                 break;
+        default:
+            if (code >= 30 && code <= 37) {
+                state.fg = static_cast<short>(code - 30);
+            } else if (code >= 40 && code <= 47) {
+                state.bg = static_cast<short>(code - 40);
+            } else if (code >= 90 && code <= 97) {
+                // Bright colors are drawn as bold on 8-color terminals
+                state.fg = static_cast<short>(code - 90);
+                state.flags |= A_BOLD;
+            }
+            break;
+    }
+}
+
+// Apply the parameters of "ESC [ params m"; 38/48 extended colors are skipped
+void applySgrParams(MarkupState& state, std::string_view params) {
+    if (params.empty()) {
+        applySgr(state, 0);
+        return;
+    }
+    int skip = 0;
+    while (true) {
+        std::size_t end = params.find(';');
+        std::string_view param = params.substr(0, end);
+        int code = 0;
+        std::from_chars(param.data(), param.data() + param.size(), code);
+
+        if (skip != 0) {
+            // A "5;n" form has one argument, a "2;r;g;b" form three
+            skip = skip == -1 ? (code == 5 ? 1 : code == 2 ? 3 : 0) : skip - 1;
+        } else if (code == 38 || code == 48) {
+            skip = -1;
+        } else {
+            applySgr(state, code);
+        }
+
+        if (end == std::string_view::npos) break;
+        params.remove_prefix(end + 1);
+    }
+}
+
+// Apply an inline {c code; false if c is not a markup code
+bool applyBraceCode(MarkupState& state, char code) {
+    static constexpr std::string_view kCodes = "dbgcrmyw";   // Indexed by curses color number
+    if (code == 'x') {
+        state = MarkupState{};
+        return true;
+    }
+    bool bold = code >= 'A' && code <= 'Z';
+    char lower = bold ? static_cast<char>(code - 'A' + 'a') : code;
+    std::size_t color = kCodes.find(lower);
+    if (color == std::string_view::npos) {
+        return false;
+    }
+    state.fg = static_cast<short>(color);
+    state.flags = bold ? (state.flags | A_BOLD) : (state.flags & ~A_BOLD);
+    return true;
+}
+
+} // namespace
+
+namespace ColorMarkup {
+
+void initColorPairs() {
+    if (!has_colors() || COLORS < kColorCount || COLOR_PAIRS < kPairBase + kColorCount * kColorCount) {
+        g_pairsReady = false;
+        return;
+    }
+    for (short fg = 0; fg < kColorCount; ++fg) {
+        for (short bg = 0; bg < kColorCount; ++bg) {
+            init_pair(static_cast<short>(kPairBase + fg * kColorCount + bg), fg, bg);
+        }
+    }
+    g_pairsReady = true;
+}
+
+void parse(std::string_view text, attr_t base, std::string& plain, std::vector<AttributeRun>& runs) {
+    plain.clear();
+    runs.clear();
+
+    MarkupState state;
+    attr_t current = base;   // Attributes of the last character emitted
+    auto emit = [&](std::string_view chunk) {
+        attr_t wanted = resolve(state, base);
+        if (wanted != current) {
+            runs.push_back({static_cast<std::uint32_t>(plain.size()), wanted});
+            current = wanted;
+        }
+        plain.append(chunk);
+    };
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        // Copy plain characters up to the next escape or brace in one go
+        std::size_t next = text.find_first_of("\x1b{", pos);
+        if (next != pos) {
+            emit(text.substr(pos, next - pos));
+            if (next == std::string_view::npos) break;
+            pos = next;
+        }
+
+        if (text[pos] == '\x1b') {
+            if (pos + 1 < text.size() && text[pos + 1] == '[') {
+                // CSI: parameters, then a final byte in @..~
+                std::size_t end = pos + 2;
+                while (end < text.size() && (text[end] < 0x40 || text[end] > 0x7e)) {
+                    ++end;
+                }
+                if (end < text.size() && text[end] == 'm') {
+                    applySgrParams(state, text.substr(pos + 2, end - pos - 2));
+                }
+                pos = end + 1;
+            } else {
+                pos += 1;   // Stray escape
+            }
+        } else if (pos + 1 < text.size() && text[pos + 1] == '{') {
+            emit("{");   // "{{" is a literal brace
+            pos += 2;
+        } else if (pos + 1 < text.size() && applyBraceCode(state, text[pos + 1])) {
+            pos += 2;
+        } else {
+            emit("{");   // Not a code; keep the brace
+            pos += 1;
+        }
+    }
+}
+
+} // namespace ColorMarkup
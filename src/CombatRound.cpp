@@ -0,0 +1,127 @@
+#include "../include/CombatRound.h"
+#include <algorithm>
+
+CombatRound::Slot CombatRound::engage(Entity attacker, Entity target, const CombatStats& attackerStats,
+                                      const CombatStats& targetStats) {
+    Slot from = slot(attacker);
+    if (from == kNoSlot) {
+        from = add(attacker, attackerStats);
+    }
+    Slot to = slot(target);
+    if (to == kNoSlot) {
+        to = add(target, targetStats);
+    }
+    m_targets[from] = to;
+    return from;
+}
+
+void CombatRound::remove(Entity entity) {
+    if (const Slot found = slot(entity); found != kNoSlot) {
+        removeSlot(found);
+    }
+}
+
+void CombatRound::setStats(Entity entity, const CombatStats& stats) {
+    if (const Slot found = slot(entity); found != kNoSlot) {
+        m_attack[found] = stats.attack;
+        m_defense[found] = stats.defense;
+        m_damage[found] = stats.damage;
+    }
+}
+
+void CombatRound::resolve(std::vector<Hit>& hits) {
+    hits.clear();
+    for (Slot i = 0; i < m_entities.size(); ++i) {
+        const Slot target = m_targets[i];
+        if (target == kNoSlot || m_health[i] <= 0 || m_health[target] <= 0 || m_rooms[i] != m_rooms[target]) {
+            continue;
+        }
+        std::uint32_t& random = m_random[i];
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        // A d20 plus attack against ten plus the target's defense
+        const std::int32_t roll = static_cast<std::int32_t>(random % 20) + 1 + m_attack[i];
+        if (roll < 10 + m_defense[target]) {
+            hits.push_back({i, target, 0, false});
+            continue;
+        }
+        const std::int32_t damage = 1 + static_cast<std::int32_t>((random >> 8) % static_cast<std::uint32_t>(
+                                            std::max<std::int32_t>(1, m_damage[i])));
+        const bool alive = m_health[target] > 0;
+        m_health[target] -= damage;
+        hits.push_back({i, target, damage, alive && m_health[target] <= 0});
+    }
+}
+
+void CombatRound::settle(std::vector<Entity>& left) {
+    left.clear();
+    for (Slot i = 0; i < m_entities.size(); ++i) {
+        const Slot target = m_targets[i];
+        if (target != kNoSlot && (m_health[target] <= 0 || m_rooms[target] != m_rooms[i])) {
+            m_targets[i] = kNoSlot;
+        }
+    }
+    // Anyone without a target fights back against someone fighting them
+    for (Slot i = 0; i < m_entities.size(); ++i) {
+        const Slot target = m_targets[i];
+        if (target != kNoSlot && m_targets[target] == kNoSlot && m_health[target] > 0) {
+            m_targets[target] = i;
+        }
+    }
+    for (Slot i = static_cast<Slot>(m_entities.size()); i-- > 0;) {
+        if (m_targets[i] == kNoSlot || m_health[i] <= 0) {
+            left.push_back(m_entities[i]);
+            removeSlot(i);
+        }
+    }
+}
+
+CombatRound::Slot CombatRound::add(Entity entity, const CombatStats& stats) {
+    const Slot added = static_cast<Slot>(m_entities.size());
+    m_entities.push_back(entity);
+    m_targets.push_back(kNoSlot);
+    m_rooms.push_back(kInvalidRoomId);
+    m_health.push_back(1);
+    m_attack.push_back(stats.attack);
+    m_defense.push_back(stats.defense);
+    m_damage.push_back(stats.damage);
+    m_random.push_back(entity.index * 2654435761u | 1u);
+    if (entity.index >= m_slots.size()) {
+        m_slots.resize(entity.index + 1, kNoSlot);
+    }
+    m_slots[entity.index] = added;
+    return added;
+}
+
+void CombatRound::removeSlot(Slot removed) {
+    const Slot last = static_cast<Slot>(m_entities.size() - 1);
+    // The last slot moves into the removed one; whoever fought either follows
+    for (Slot& target : m_targets) {
+        if (target == removed) {
+            target = kNoSlot;
+        } else if (target == last) {
+            target = removed;
+        }
+    }
+    m_slots[m_entities[removed].index] = kNoSlot;
+    if (removed != last) {
+        m_entities[removed] = m_entities[last];
+        m_targets[removed] = m_targets[last];
+        m_rooms[removed] = m_rooms[last];
+        m_health[removed] = m_health[last];
+        m_attack[removed] = m_attack[last];
+        m_defense[removed] = m_defense[last];
+        m_damage[removed] = m_damage[last];
+        m_random[removed] = m_random[last];
+        m_slots[m_entities[removed].index] = removed;
+    }
+    m_entities.pop_back();
+    m_targets.pop_back();
+    m_rooms.pop_back();
+    m_health.pop_back();
+    m_attack.pop_back();
+    m_defense.pop_back();
+    m_damage.pop_back();
+    m_random.pop_back();
+}
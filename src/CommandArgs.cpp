@@ -0,0 +1,138 @@
+#include "../include/CommandArgs.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace {
+
+constexpr std::string_view kSpace = " \t";
+
+std::string_view trimLeft(std::string_view text) noexcept {
+    text.remove_prefix(std::min(text.find_first_not_of(kSpace), text.size()));
+    return text;
+}
+
+std::string_view trimRight(std::string_view text) noexcept {
+    const std::size_t end = text.find_last_not_of(kSpace);
+    return text.substr(0, end == std::string_view::npos ? 0 : end + 1);
+}
+
+bool parseKind(std::string_view name, ArgKind& kind) noexcept {
+    constexpr std::array<std::pair<std::string_view, ArgKind>, 5> kinds = {{
+        {"word", ArgKind::Word}, {"number", ArgKind::Number}, {"direction", ArgKind::Direction},
+        {"target", ArgKind::Target}, {"rest", ArgKind::Rest}
+    }};
+    for (const auto& [kindName, value] : kinds) {
+        if (kindName == name) {
+            kind = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+std::string_view CommandArgs::name(std::size_t index) const noexcept {
+    return m_schema && index < m_count ? std::string_view(m_schema->fields()[index].name) : std::string_view();
+}
+
+const CommandArg* CommandArgs::find(std::string_view name) const noexcept {
+    for (std::size_t i = 0; i < m_count; ++i) {
+        if (m_schema->fields()[i].name == name) {
+            return &m_fields[i];
+        }
+    }
+    return nullptr;
+}
+
+std::expected<ArgumentSchema, std::string> ArgumentSchema::compile(std::string_view spec) {
+    ArgumentSchema schema;
+    for (spec = trimLeft(spec); !spec.empty(); spec = trimLeft(spec)) {
+        std::string_view token = spec.substr(0, spec.find_first_of(kSpace));
+        spec.remove_prefix(token.size());
+
+        Field field;
+        if (token.ends_with('?')) {
+            field.optional = true;
+            token.remove_suffix(1);
+        }
+        const std::size_t colon = token.find(':');
+        if (colon == 0 || colon == std::string_view::npos) {
+            return std::unexpected(std::format("field '{}' is not name:kind", token));
+        }
+        if (!parseKind(token.substr(colon + 1), field.kind)) {
+            return std::unexpected(std::format("unknown kind '{}'", token.substr(colon + 1)));
+        }
+        field.name.assign(token.substr(0, colon));
+
+        if (!schema.m_fields.empty() && schema.m_fields.back().kind == ArgKind::Rest) {
+            return std::unexpected("a rest field must come last");
+        }
+        if (schema.m_fields.size() == CommandArgs::kMaxFields) {
+            return std::unexpected(std::format("more than {} fields", CommandArgs::kMaxFields));
+        }
+        if (std::any_of(schema.m_fields.begin(), schema.m_fields.end(),
+                        [&](const Field& other) { return other.name == field.name; })) {
+            return std::unexpected(std::format("field '{}' is declared twice", field.name));
+        }
+        schema.m_fields.push_back(std::move(field));
+    }
+    return schema;
+}
+
+std::expected<void, std::string> ArgumentSchema::parse(std::string_view args, CommandArgs& out) const {
+    out.m_schema = this;
+    out.m_raw = args;
+    out.m_count = m_fields.size();
+
+    std::string_view rest = trimLeft(args);
+    for (std::size_t i = 0; i < m_fields.size(); ++i) {
+        const Field& field = m_fields[i];
+        CommandArg& arg = out.m_fields[i];
+        arg = CommandArg{.kind = field.kind};
+
+        if (rest.empty()) {
+            if (!field.optional) {
+                return std::unexpected(std::format("Missing <{}>.", field.name));
+            }
+            continue;
+        }
+        if (field.kind == ArgKind::Rest) {
+            arg.present = true;
+            arg.text = trimRight(rest);
+            rest = {};
+            continue;
+        }
+
+        const std::string_view word = rest.substr(0, rest.find_first_of(kSpace));
+        bool fits = true;
+        if (field.kind == ArgKind::Number) {
+            const auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), arg.number);
+            fits = error == std::errc() && end == word.data() + word.size();
+        } else if (field.kind == ArgKind::Direction) {
+            arg.direction = parseDirection(word);
+            fits = arg.direction != Direction::Count;
+        }
+        if (!fits) {
+            // Leave the word for the next field
+            if (field.optional) {
+                arg = CommandArg{.kind = field.kind};
+                continue;
+            }
+            if (field.kind == ArgKind::Number) {
+                return std::unexpected(std::format("<{}> must be a number, not '{}'.", field.name, word));
+            }
+            return std::unexpected(std::format("'{}' is not a direction.", word));
+        }
+
+        arg.present = true;
+        arg.text = word;
+        rest = trimLeft(rest.substr(word.size()));
+    }
+
+    if (!rest.empty()) {
+        return std::unexpected(std::format("Unexpected '{}'.", trimRight(rest)));
+    }
+    return {};
+}
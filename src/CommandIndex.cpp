@@ -0,0 +1,110 @@
+#include "../include/CommandIndex.h"
+#include <algorithm>
+
+namespace {
+
+std::size_t sharedPrefix(std::string_view a, std::string_view b) noexcept {
+    return static_cast<std::size_t>(std::mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin());
+}
+
+} // namespace
+
+void CommandIndex::rebuild(std::vector<Command> commands, const std::vector<Alias>& aliases) {
+    std::erase_if(commands, [](const Command& command) { return command.name.empty() || !command.entry; });
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) { return a.name < b.name; });
+
+    // Every prefix of every name is the most the table can hold
+    std::size_t spellings = aliases.size();
+    std::size_t bytes = 0;
+    for (const Command& command : commands) {
+        spellings += command.name.size();
+        bytes += command.name.size();
+    }
+    for (const Alias& alias : aliases) {
+        bytes += alias.first.size();
+    }
+
+    clear();
+    std::size_t capacity = 8;
+    while (capacity < spellings * 2) {
+        capacity *= 2;
+    }
+    m_slots.assign(capacity, Slot{});
+    m_keys.reserve(bytes);
+
+    // Names are stored whole, and their prefixes are slots over the same bytes
+    std::vector<std::uint32_t> offsets(commands.size());
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        offsets[i] = static_cast<std::uint32_t>(m_keys.size());
+        m_keys += commands[i].name;
+        insert(offsets[i], commands[i].name.size(), commands[i].entry);
+    }
+
+    for (const auto& [spelling, target] : aliases) {
+        auto it = std::lower_bound(commands.begin(), commands.end(), target,
+                                   [](const Command& command, std::string_view name) { return command.name < name; });
+        if (spelling.empty() || it == commands.end() || it->name != target) {
+            continue;
+        }
+        const auto offset = static_cast<std::uint32_t>(m_keys.size());
+        m_keys += spelling;
+        if (!insert(offset, spelling.size(), it->entry)) {
+            m_keys.resize(offset);
+        }
+    }
+
+    // Sorted, a name shares its longest prefix with one of its neighbours, so
+    // one character past that is where it stops being ambiguous
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const Command& command = commands[i];
+        if (!command.abbreviate) {
+            continue;
+        }
+        std::size_t shared = 0;
+        if (i > 0) {
+            shared = sharedPrefix(command.name, commands[i - 1].name);
+        }
+        if (i + 1 < commands.size()) {
+            shared = std::max(shared, sharedPrefix(command.name, commands[i + 1].name));
+        }
+        for (std::size_t length = shared + 1; length < command.name.size(); ++length) {
+            insert(offsets[i], length, command.entry);
+        }
+    }
+}
+
+void CommandIndex::clear() noexcept {
+    m_slots.clear();
+    m_keys.clear();
+    m_count = 0;
+}
+
+const CommandEntry* CommandIndex::find(std::string_view spelling) const noexcept {
+    if (m_slots.empty()) {
+        return nullptr;
+    }
+    const std::uint32_t h = hash(spelling);
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t index = h & mask; m_slots[index].entry; index = (index + 1) & mask) {
+        const Slot& slot = m_slots[index];
+        if (slot.hash == h && keyAt(slot) == spelling) {
+            return slot.entry;
+        }
+    }
+    return nullptr;
+}
+
+bool CommandIndex::insert(std::uint32_t offset, std::size_t length, const CommandEntry* entry) {
+    const std::string_view spelling = std::string_view(m_keys).substr(offset, length);
+    const std::uint32_t h = hash(spelling);
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t index = h & mask;
+    for (; m_slots[index].entry; index = (index + 1) & mask) {
+        if (m_slots[index].hash == h && keyAt(m_slots[index]) == spelling) {
+            return false;
+        }
+    }
+    m_slots[index] = Slot{h, offset, static_cast<std::uint32_t>(length), entry};
+    ++m_count;
+    return true;
+}
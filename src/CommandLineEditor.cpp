@@ -1,9 +1,18 @@
 #include "../include/CommandLineEditor.h"
+#include "../include/Utf8.h"
 #include <algorithm>
 #include <limits>
 #include <format>
 #include <chrono>
 
+namespace {
+
+constexpr int kCtrlG = 7;
+constexpr int kCtrlR = 18;
+constexpr int kEscape = 27;
+
+} // namespace
+
 CommandLineEditor::CommandLineEditor(int width, WINDOW* inputWindow)
     : m_window(inputWindow), m_width(width)
 {
@@ -14,7 +23,19 @@ KeyProcessResult CommandLineEditor::processKey(int key) {
     KeyProcessResult result;
     result.needsRedraw = true;
     
+    // While searching, keys edit the query; any other key ends the search
+    // and is then handled as usual on the line it found
+    if (m_searching && handleSearchKey(key)) {
+        return result;
+    }
+    
     switch (key) {
+        case kCtrlR:
+            startSearch();
+            break;
+        case '\t':
+            handleTab(result);
+            break;
         case KEY_BACKSPACE: case 127: case 8:
             handleBackspace();
             break;
@@ -40,18 +61,19 @@ KeyProcessResult CommandLineEditor::processKey(int key) {
             handleDownArrow();
             break;
         case KEY_ENTER: case 10: case 13: // Enter key (different representations)
-            if (!m_inputBuffer.empty()) {
+            if (!m_input.empty()) {
                 result.commandSubmitted = true;
-                result.submittedCommand = m_inputBuffer;
-                addToHistory(m_inputBuffer);
-                m_inputBuffer.clear();
-                m_cursorPos = 0;
+                result.submittedCommand = m_input.str();
+                addToHistory(result.submittedCommand);
+                m_input.clear();
+                markDamaged(0);
                 m_historyIndex = -1;
             }
             break;
         default:
-            // Handle printable characters
-            if (key >= 32 && key <= 126) {
+            // Printable ASCII, or one byte of a UTF-8 sequence; wgetch delivers
+            // multibyte characters a byte at a time
+            if ((key >= 32 && key <= 126) || (key >= 0x80 && key <= 0xFF)) {
                 handleCharacter(key);
             }
             break;
@@ -60,17 +82,103 @@ KeyProcessResult CommandLineEditor::processKey(int key) {
     return result;
 }
 
+void CommandLineEditor::insertText(std::string_view text) {
+    // Like any key that is not a search key, the paste ends a search on the
+    // line it found
+    if (m_searching) {
+        finishSearch(true);
+    }
+    
+    std::string accepted;
+    accepted.reserve(text.size());
+    for (const char ch : text) {
+        const auto byte = static_cast<unsigned char>(ch);
+        if (byte == '\t') {
+            accepted += ' ';
+        } else if ((byte >= 32 && byte <= 126) || byte >= 0x80) {
+            accepted += ch;
+        }
+    }
+    if (accepted.empty()) return;
+    markDamaged(m_input.cursor());
+    m_input.insert(accepted);
+}
+
 void CommandLineEditor::draw() {
     if (!m_window) return;
+    if (m_searching) {
+        drawSearch();
+        return;
+    }
     
-    werase(m_window);
-    mvwaddnstr(m_window, 0, 0, m_inputBuffer.c_str(), m_width - 1);
+    // The last column stays free for the cursor at the end of the line
+    const std::size_t visible = static_cast<std::size_t>(std::max(m_width - 1, 0));
+    const std::size_t cursorColumn = Utf8::displayWidth(m_input.before());
+    
+    // When the cursor leaves the view, scroll so it sits in the middle; typing
+    // along a long line then shifts the view every half width, not every key
+    if (cursorColumn < m_scrollColumn || cursorColumn > m_scrollColumn + visible) {
+        m_scrollColumn = cursorColumn > visible / 2 ? cursorColumn - visible / 2 : 0;
+        m_damageFrom = 0;
+    }
+    m_cursorColumn = static_cast<int>(cursorColumn - m_scrollColumn);
+    if (m_damageFrom == kUndamaged) return;
+    
+    // One pass over the line: find the window column of the first damaged
+    // byte and collect the code points from there to the edge of the view
+    const std::size_t viewEnd = m_scrollColumn + visible;
+    std::size_t column = 0;
+    int clearFrom = -1;
+    int drawFrom = -1;
+    m_drawScratch.clear();
+    auto walk = [&](std::string_view segment, std::size_t base) {
+        std::size_t pos = 0;
+        while (pos < segment.size()) {
+            const Utf8::Decoded decoded = Utf8::decode(segment, pos);
+            const auto width = static_cast<std::size_t>(Utf8::codepointWidth(decoded.codepoint));
+            if (column + width > viewEnd) {
+                return false;
+            }
+            if (clearFrom < 0 && base + pos >= m_damageFrom) {
+                // A wide character cut by the left edge is left blank
+                clearFrom = static_cast<int>(column > m_scrollColumn ? column - m_scrollColumn : 0);
+            }
+            if (clearFrom >= 0 && column >= m_scrollColumn) {
+                if (drawFrom < 0) {
+                    drawFrom = static_cast<int>(column - m_scrollColumn);
+                }
+                m_drawScratch.append(segment.substr(pos, decoded.length));
+            }
+            column += width;
+            pos += decoded.length;
+        }
+        return true;
+    };
+    if (walk(m_input.before(), 0)) {
+        walk(m_input.after(), m_input.cursor());
+    }
+    if (clearFrom < 0) {
+        // The edit was past the last code point shown, as after deleting at the
+        // end of the line; only the cells from there to the edge went stale
+        clearFrom = static_cast<int>(column > m_scrollColumn ? column - m_scrollColumn : 0);
+    }
+    m_damageFrom = kUndamaged;
+    
+    wmove(m_window, 0, clearFrom);
+    wclrtoeol(m_window);
+    if (drawFrom >= 0) {
+        mvwaddnstr(m_window, 0, drawFrom, m_drawScratch.data(), static_cast<int>(m_drawScratch.size()));
+    }
+}
+
+void CommandLineEditor::invalidate() noexcept {
+    m_damageFrom = 0;
 }
 
 std::string CommandLineEditor::takeCurrentInput() {
-    std::string temp = m_inputBuffer;
-    m_inputBuffer.clear();
-    m_cursorPos = 0;
+    std::string temp = m_input.str();
+    m_input.clear();
+    markDamaged(0);
     return temp;
 }
 
@@ -86,12 +194,17 @@ std::expected<void, CommandError> CommandLineEditor::addToHistory(std::string_vi
             return {}; // Success but nothing added
         }
         
-        // Create new history entry with current timestamp
-        m_commandHistory.emplace_back(std::string{command});
+        // Once full, the ring hands back the oldest entry's slot; its string
+        // storage is reused rather than shifting every entry down
+        HistoryEntry& entry = pushHistory();
+        entry.command.assign(command);
+        entry.timestamp = HistoryEntry::now();
         
-        // Limit history size to MAX_HISTORY_SIZE entries
-        if (m_commandHistory.size() > MAX_HISTORY_SIZE) {
-            m_commandHistory.erase(m_commandHistory.begin());
+        if (m_historyFile.isOpen()) {
+            m_historyFile.append(entry.timestamp, entry.command);
+            if (m_historyFile.recordCount() > m_commandHistory.capacity() * HISTORY_FILE_SLACK) {
+                compactHistoryFile();
+            }
         }
         
         return {};  // Success
@@ -101,66 +214,101 @@ std::expected<void, CommandError> CommandLineEditor::addToHistory(std::string_vi
 }
 
 void CommandLineEditor::clearHistory() noexcept {
+    m_commandHistory.clear();
+    m_historyIndex = -1;
+    m_searchIndex.clear();
+    try {
+        if (m_historyFile.isOpen()) {
+            m_historyFile.rewrite({});
+        }
+    } catch (...) {
+        // The file keeps its old entries; they are not loaded until the next start
+    }
+}
+
+void CommandLineEditor::setHistorySize(std::size_t size) {
+    m_commandHistory.setCapacity(size);
+    m_historyIndex = -1;
+}
+
+std::expected<void, CommandError> CommandLineEditor::openHistoryFile(const std::filesystem::path& path) {
     try {
         m_commandHistory.clear();
         m_historyIndex = -1;
+        const bool opened = m_historyFile.open(path, m_commandHistory.capacity(), [this](const HistoryFile::Record& record) {
+            HistoryEntry& entry = pushHistory();
+            entry.command.assign(record.command);
+            entry.timestamp = record.timestamp;
+        });
+        if (!opened) {
+            return std::unexpected(CommandError::HistoryError);
+        }
+        if (m_historyFile.recordCount() > m_commandHistory.capacity() * HISTORY_FILE_SLACK) {
+            compactHistoryFile();
+        }
+        return {};
     } catch (...) {
-        // If clear throws (shouldn't happen), silently maintain exception neutrality
+        return std::unexpected(CommandError::HistoryError);
     }
 }
 
+HistoryEntry& CommandLineEditor::pushHistory() {
+    ++m_nextHistoryId;
+    return m_commandHistory.push();
+}
+
+// Rewrite the history file with only the entries still kept in memory
+void CommandLineEditor::compactHistoryFile() {
+    std::vector<HistoryFile::Record> records;
+    records.reserve(m_commandHistory.size());
+    for (std::size_t i = 0; i < m_commandHistory.size(); ++i) {
+        records.push_back({m_commandHistory[i].timestamp, m_commandHistory[i].command});
+    }
+    m_historyFile.rewrite(records);
+}
+
 void CommandLineEditor::setWindow(WINDOW* window) noexcept {
     m_window = window;
+    invalidate();
 }
 
 void CommandLineEditor::resize(int width) noexcept {
     m_width = width;
-    // Make sure cursor position is still valid
-    ensureCursorInBounds();
+    invalidate();
 }
 
 // Private methods for handling specific key presses
 
 void CommandLineEditor::handleBackspace() noexcept {
-    if (m_cursorPos > 0) {
-        try {
-            m_inputBuffer.erase(m_cursorPos - 1, 1);
-            m_cursorPos--;
-        } catch (...) {
-            // Maintain exception neutrality
-        }
+    const std::size_t cursor = m_input.cursor();
+    if (cursor > 0) {
+        const std::size_t start = Utf8::prevBoundary(m_input.before(), cursor);
+        m_input.eraseBefore(cursor - start);
+        markDamaged(start);
     }
 }
 
 void CommandLineEditor::handleDelete() noexcept {
-    if (m_cursorPos < static_cast<int>(m_inputBuffer.length())) {
-        try {
-            m_inputBuffer.erase(m_cursorPos, 1);
-        } catch (...) {
-            // Maintain exception neutrality
-        }
+    if (!m_input.after().empty()) {
+        m_input.eraseAfter(Utf8::nextBoundary(m_input.after(), 0));
+        markDamaged(m_input.cursor());
     }
 }
 
 void CommandLineEditor::handleLeftArrow() noexcept {
-    if (m_cursorPos > 0) {
-        m_cursorPos--;
-    }
+    m_input.moveCursor(Utf8::prevBoundary(m_input.before(), m_input.cursor()));
 }
 
 void CommandLineEditor::handleRightArrow() noexcept {
-    if (m_cursorPos < static_cast<int>(m_inputBuffer.length())) {
-        m_cursorPos++;
-    }
+    m_input.moveCursor(m_input.cursor() + Utf8::nextBoundary(m_input.after(), 0));
 }
 
 void CommandLineEditor::handleHome() noexcept {
-    m_cursorPos = 0;
+    m_input.moveCursor(0);
 }
 
 void CommandLineEditor::handleEnd() noexcept {
-    m_cursorPos = static_cast<int>(std::min(m_inputBuffer.length(), 
-        static_cast<size_t>(std::numeric_limits<int>::max())));
+    m_input.moveCursor(m_input.size());
 }
 
 void CommandLineEditor::handleUpArrow() noexcept {
@@ -174,9 +322,7 @@ void CommandLineEditor::handleUpArrow() noexcept {
         }
         
         if (m_historyIndex >= 0 && m_historyIndex < static_cast<int>(m_commandHistory.size())) {
-            m_inputBuffer = m_commandHistory[m_historyIndex].command;
-            m_cursorPos = static_cast<int>(std::min(m_inputBuffer.length(), 
-                static_cast<size_t>(std::numeric_limits<int>::max())));
+            replaceInput(m_commandHistory[m_historyIndex].command);
         }
     } catch (...) {
         // Maintain exception neutrality
@@ -189,13 +335,10 @@ void CommandLineEditor::handleDownArrow() noexcept {
     try {
         if (m_historyIndex < static_cast<int>(m_commandHistory.size()) - 1) {
             m_historyIndex++;
-            m_inputBuffer = m_commandHistory[m_historyIndex].command;
-            m_cursorPos = static_cast<int>(std::min(m_inputBuffer.length(), 
-                static_cast<size_t>(std::numeric_limits<int>::max())));
+            replaceInput(m_commandHistory[m_historyIndex].command);
         } else {
             m_historyIndex = -1;
-            m_inputBuffer.clear();
-            m_cursorPos = 0;
+            replaceInput({});
         }
     } catch (...) {
         // Maintain exception neutrality
@@ -204,20 +347,133 @@ void CommandLineEditor::handleDownArrow() noexcept {
 
 void CommandLineEditor::handleCharacter(int ch) noexcept {
     try {
-        m_inputBuffer.insert(m_cursorPos, 1, static_cast<char>(ch));
-        m_cursorPos++;
+        markDamaged(m_input.cursor());
+        m_input.insert(static_cast<char>(ch));
     } catch (...) {
         // Maintain exception neutrality
     }
 }
 
-void CommandLineEditor::ensureCursorInBounds() noexcept {
-    try {
-        int maxPos = static_cast<int>(std::min(m_inputBuffer.length(), 
-            static_cast<size_t>(std::numeric_limits<int>::max())));
-        m_cursorPos = std::min(std::max(0, m_cursorPos), maxPos);
-    } catch (...) {
-        // Maintain exception neutrality
-        m_cursorPos = 0;
+// Complete the word before the cursor: a single match replaces it, several
+// extend it as far as they agree, or are listed when they do not agree at all
+void CommandLineEditor::handleTab(KeyProcessResult& result) {
+    if (!m_completer) return;
+    
+    Completion completion = m_completer(m_input.before());
+    if (completion.matches.empty()) return;
+    
+    const std::size_t cursor = m_input.cursor();
+    if (completion.matches.size() == 1) {
+        const std::size_t wordStart = m_input.before().find_last_of(' ') + 1;   // npos wraps to 0
+        m_input.eraseBefore(cursor - wordStart);
+        m_input.insert(completion.matches.front());
+        if (m_input.after().empty() || m_input.after().front() != ' ') {
+            m_input.insert(' ');
+        }
+        markDamaged(wordStart);
+    } else if (!completion.extension.empty()) {
+        m_input.insert(completion.extension);
+        markDamaged(cursor);
+    } else {
+        result.completions = std::move(completion.matches);
+    }
+}
+
+void CommandLineEditor::replaceInput(std::string_view text) {
+    m_input.assign(text);
+    markDamaged(0);
+}
+
+// Reverse incremental search
+
+void CommandLineEditor::startSearch() {
+    m_searching = true;
+    m_searchFailed = false;
+    m_searchQuery.clear();
+    m_searchMatch.reset();
+    m_searchSavedLine = m_input.str();
+}
+
+// Returns false if the key ended the search and still needs handling
+bool CommandLineEditor::handleSearchKey(int key) {
+    switch (key) {
+        case kCtrlR:
+            // Again: the next older match; on an empty query, the previous search
+            if (m_searchQuery.empty()) {
+                m_searchQuery = m_lastSearchQuery;
+            }
+            searchHistory(m_searchMatch ? *m_searchMatch : m_nextHistoryId);
+            return true;
+        case kCtrlG: case kEscape:
+            finishSearch(false);
+            return true;
+        case KEY_BACKSPACE: case 127: case 8:
+            m_searchQuery.erase(Utf8::prevBoundary(m_searchQuery, m_searchQuery.size()));
+            m_searchMatch.reset();
+            searchHistory(m_nextHistoryId);
+            return true;
+        default:
+            if ((key >= 32 && key <= 126) || (key >= 0x80 && key <= 0xFF)) {
+                // The current match may still contain the longer query
+                m_searchQuery.push_back(static_cast<char>(key));
+                searchHistory(m_searchMatch ? *m_searchMatch + 1 : m_nextHistoryId);
+                return true;
+            }
+            finishSearch(true);
+            return false;
+    }
+}
+
+// Find the newest entry older than id before that contains the query
+void CommandLineEditor::searchHistory(std::uint32_t before) {
+    // Index whatever was added since the last search
+    const std::uint32_t first = firstHistoryId();
+    m_searchIndex.forgetBefore(first);
+    for (std::uint32_t id = std::max(m_searchIndex.end(), first); id != m_nextHistoryId; ++id) {
+        m_searchIndex.add(id, m_commandHistory[id - first].command);
+    }
+    
+    auto contains = [&](std::uint32_t id) {
+        return m_commandHistory[id - first].command.find(m_searchQuery) != std::string::npos;
+    };
+    std::optional<std::uint32_t> match;
+    if (!m_searchQuery.empty()) {
+        match = m_searchIndex.findBefore(m_searchQuery, before, contains);
+    }
+    
+    // A failed search keeps showing the last match, as readline does
+    m_searchFailed = !match && !m_searchQuery.empty();
+    if (match) {
+        m_searchMatch = match;
     }
-} 
\ No newline at end of file
+}
+
+void CommandLineEditor::finishSearch(bool accept) {
+    m_searching = false;
+    if (!m_searchQuery.empty()) {
+        m_lastSearchQuery = m_searchQuery;
+    }
+    if (accept && m_searchMatch && *m_searchMatch >= firstHistoryId()) {
+        replaceInput(m_commandHistory[*m_searchMatch - firstHistoryId()].command);
+    } else {
+        replaceInput(m_searchSavedLine);
+    }
+    m_historyIndex = -1;
+}
+
+// The search prompt replaces the line; it is short, so it is redrawn whole
+void CommandLineEditor::drawSearch() {
+    m_drawScratch.assign(m_searchFailed ? "(failed reverse-i-search)`" : "(reverse-i-search)`");
+    m_drawScratch.append(m_searchQuery);
+    const std::size_t cursorColumn = Utf8::displayWidth(m_drawScratch);
+    m_drawScratch.append("': ");
+    if (m_searchMatch && *m_searchMatch >= firstHistoryId()) {
+        m_drawScratch.append(m_commandHistory[*m_searchMatch - firstHistoryId()].command);
+    }
+    
+    const std::size_t visible = static_cast<std::size_t>(std::max(m_width - 1, 0));
+    m_cursorColumn = static_cast<int>(std::min(cursorColumn, visible));
+    werase(m_window);
+    mvwaddnstr(m_window, 0, 0, m_drawScratch.data(), static_cast<int>(Utf8::bytesForColumns(m_drawScratch, visible)));
+    m_damageFrom = 0;   // The line is repainted whole once the search ends
+}
@@ -0,0 +1,71 @@
+#include "../include/CommandTask.h"
+#include <algorithm>
+
+AsyncExecutor::AsyncExecutor(unsigned threads, std::function<void()> wake) : m_wake(std::move(wake)) {
+    threads = std::max(threads, 1u);
+    m_threads.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        m_threads.emplace_back([this] { workerLoop(); });
+    }
+}
+
+AsyncExecutor::~AsyncExecutor() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_ready.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void AsyncExecutor::submit(std::function<void()> work, std::coroutine_handle<> resume) {
+    hold();
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({std::move(work), resume});
+    }
+    m_ready.notify_one();
+}
+
+void AsyncExecutor::post(std::coroutine_handle<> resume) {
+    m_done.push(resume);
+    const std::lock_guard<std::mutex> lock(m_wakeMutex);
+    if (m_wake) {
+        m_wake();
+    }
+}
+
+void AsyncExecutor::setWake(std::function<void()> wake) {
+    const std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wake = std::move(wake);
+}
+
+std::size_t AsyncExecutor::resumeReady() {
+    std::size_t resumed = 0;
+    while (auto handle = m_done.pop()) {
+        m_inFlight.fetch_sub(1, std::memory_order_relaxed);
+        handle->resume();
+        ++resumed;
+    }
+    return resumed;
+}
+
+void AsyncExecutor::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_ready.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job.work();
+        post(job.resume);
+    }
+}
@@ -0,0 +1,131 @@
+#include "../include/CompletionTrie.h"
+#include <algorithm>
+#include <iterator>
+
+void Completion::merge(Completion&& other) {
+    if (other.total == 0) {
+        return;
+    }
+    if (total == 0) {
+        *this = std::move(other);
+        return;
+    }
+    std::size_t shared = 0;
+    while (shared < extension.size() && shared < other.extension.size() && extension[shared] == other.extension[shared]) {
+        ++shared;
+    }
+    extension.resize(shared);
+    total += other.total;
+    matches.insert(matches.end(), std::make_move_iterator(other.matches.begin()), std::make_move_iterator(other.matches.end()));
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+    if (matches.size() > kMaxMatches) {
+        matches.resize(kMaxMatches);
+    }
+}
+
+void CompletionTrie::insert(std::string_view word) {
+    std::uint32_t node = 0;
+    ++m_nodes[node].words;
+    for (char ch : word) {
+        const char key = fold(ch);
+        std::uint32_t next = child(node, key);
+        if (next == kNone) {
+            next = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+            auto& children = m_nodes[node].children;
+            auto at = std::lower_bound(children.begin(), children.end(), key,
+                                       [](const auto& edge, char k) { return edge.first < k; });
+            children.insert(at, {key, next});
+        }
+        node = next;
+        ++m_nodes[node].words;
+    }
+    Node& last = m_nodes[node];
+    if (last.terminal++ == 0) {
+        last.word.assign(word);
+    }
+}
+
+void CompletionTrie::erase(std::string_view word) {
+    if (!contains(word)) {
+        return;
+    }
+    std::uint32_t node = 0;
+    --m_nodes[node].words;
+    for (char ch : word) {
+        node = child(node, fold(ch));
+        --m_nodes[node].words;
+    }
+    // The node itself stays; a branch whose count drops to zero is skipped
+    --m_nodes[node].terminal;
+}
+
+void CompletionTrie::clear() {
+    m_nodes.clear();
+    m_nodes.emplace_back();
+}
+
+bool CompletionTrie::contains(std::string_view word) const {
+    const std::uint32_t node = find(word);
+    return node != kNone && m_nodes[node].terminal > 0;
+}
+
+void CompletionTrie::complete(std::string_view prefix, Completion& completion) const {
+    std::uint32_t node = find(prefix);
+    if (node == kNone || m_nodes[node].words == 0) {
+        return;
+    }
+    completion.total += m_nodes[node].words;
+    collect(node, completion.matches);
+
+    // Follow the path while exactly one branch has words and no word ends on it
+    std::string extension;
+    while (m_nodes[node].terminal == 0) {
+        std::uint32_t only = kNone;
+        char key = 0;
+        for (const auto& [edgeKey, next] : m_nodes[node].children) {
+            if (m_nodes[next].words == 0) continue;
+            if (only != kNone) {
+                only = kNone;
+                break;
+            }
+            only = next;
+            key = edgeKey;
+        }
+        if (only == kNone) break;
+        extension.push_back(key);
+        node = only;
+    }
+    completion.extension = std::move(extension);
+}
+
+std::uint32_t CompletionTrie::child(std::uint32_t node, char key) const noexcept {
+    for (const auto& [edgeKey, next] : m_nodes[node].children) {
+        if (edgeKey == key) return next;
+        if (edgeKey > key) break;
+    }
+    return kNone;
+}
+
+std::uint32_t CompletionTrie::find(std::string_view prefix) const noexcept {
+    std::uint32_t node = 0;
+    for (char ch : prefix) {
+        node = child(node, fold(ch));
+        if (node == kNone) break;
+    }
+    return node;
+}
+
+// Depth-first, so words come out in key order; stops at kMaxMatches
+void CompletionTrie::collect(std::uint32_t node, std::vector<std::string>& out) const {
+    if (out.size() >= Completion::kMaxMatches || m_nodes[node].words == 0) {
+        return;
+    }
+    if (m_nodes[node].terminal > 0) {
+        out.push_back(m_nodes[node].word);
+    }
+    for (const auto& edge : m_nodes[node].children) {
+        collect(edge.second, out);
+    }
+}
@@ -1,11 +1,17 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "../include/ConsoleUI.h"
+#include "../include/CommandTokens.h"
+#include "../include/CommandSequence.h"
+#include "../include/MemoryAccounting.h"
+#include "../include/Metrics.h"
+#include "../include/TextSearch.h"
+#include "../include/TickClock.h"
+#include "../include/Watchdog.h"
 #include <clocale>
 #include <stdexcept>
 #include <format>
 #include <iostream>
 #include <csignal>
-#include <mutex>
 #include <chrono>
 #include <thread>
 #include <algorithm>
@@ -15,76 +21,38 @@
 #include <limits>
 #include <filesystem> // For creating debug log directory
 #include <optional>
-#include <sstream>  // For std::stringstream used in logMemoryStats
-#include <ctime>    // For std::time_t, std::tm, std::localtime_r, std::strftime used in logDebug
+#include <ctime>    // For std::time_t, naming the debug log
 #include <cstdio>   // For std::FILE, fprintf etc. if used as fallback (check if needed)
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
 
-// Initialize static debug log file
-std::ofstream ConsoleUI::debugLogFile;
-
-// Initialize debug log file
+// Send the log to a timestamped file under logs/, and not to the screen's stderr
 void ConsoleUI::initDebugLog() {
-#if DEBUG_MODE
     try {
-        // Create logs directory if it doesn't exist
-        std::filesystem::path logDir = "logs";
-        if (!std::filesystem::exists(logDir)) {
-            std::filesystem::create_directory(logDir);
-        }
-        
-        // Create a timestamped log file
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::system_clock::to_time_t(now);
-        std::stringstream filename;
-        filename << "logs/console_debug_" << timestamp << ".log";
-        
-        // Open the log file
-        debugLogFile.open(filename.str(), std::ios::out | std::ios::trunc);
-        
-        if (debugLogFile.is_open()) {
-            debugLogFile << "=== Debug Log Started at " << std::ctime(&timestamp) << " ===" << std::endl;
-            debugLogFile.flush();
-        } else {
-            std::cerr << "Failed to open debug log file" << std::endl;
-        }
+        const std::filesystem::path logDir = "logs";
+        std::filesystem::create_directories(logDir);
+        const auto timestamp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        Logger::instance().setStderr(false);
+        Logger::instance().setFile(logDir / std::format("console_debug_{}.log", static_cast<long long>(timestamp)));
+        LOG_INFO("=== Debug log started ===");
     } catch (const std::exception& e) {
         std::cerr << "Error initializing debug log: " << e.what() << std::endl;
     }
-#endif
-}
-
-// Log a debug message
-void ConsoleUI::logDebug(const std::string& message) {
-#if DEBUG_MODE
-    if (debugLogFile.is_open()) {
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::system_clock::to_time_t(now);
-        
-        // Get local time
-        std::tm timeInfo;
-#ifdef _WIN32
-        localtime_s(&timeInfo, &timestamp);
-#else
-        localtime_r(&timestamp, &timeInfo);
-#endif
-        
-        // Format timestamp
-        char timeBuffer[20];
-        strftime(timeBuffer, sizeof(timeBuffer), "%H:%M:%S", &timeInfo);
-        
-        // Write to log file
-        debugLogFile << "[" << timeBuffer << "] " << message << std::endl;
-        debugLogFile.flush();
-    }
-#endif
 }
 
 // Helper method to create a ConsoleUI instance
-std::optional<ConsoleUI> ConsoleUI::create() {
+std::optional<ConsoleUI> ConsoleUI::create(ConsoleBackend backend) {
+    if (backend == ConsoleBackend::Vt) {
+        return createVt();
+    }
     try {
         // Initialize debug logging
         initDebugLog();
-        DEBUG_LOG("ConsoleUI::create() - Starting initialization");
+        LOG_DEBUG("ConsoleUI::create() - Starting initialization");
 
         // Set the locale for proper character handling (important for UTF-8)
         if (!std::setlocale(LC_ALL, "")) {
@@ -103,6 +71,16 @@ std::optional<ConsoleUI> ConsoleUI::create() {
         keypad(stdscr, TRUE);   // Enable function keys, arrow keys, etc.
         curs_set(1);            // Show cursor
 
+        // Ask the terminal to bracket pastes, and ncurses to report the
+        // brackets as keys; a terminal without the mode ignores the request
+        // and a paste arrives as typed keys
+#if defined(NCURSES_VERSION)
+        define_key("\x1b[200~", kKeyPasteBegin);
+        define_key("\x1b[201~", kKeyPasteEnd);
+        std::fputs("\x1b[?2004h", stdout);
+        std::fflush(stdout);
+#endif
+
         // Check color support
         if (!has_colors()) {
             endwin();
@@ -122,6 +100,9 @@ std::optional<ConsoleUI> ConsoleUI::create() {
             init_pair(2, COLOR_CYAN, COLOR_BLACK);   // Borders
             init_pair(3, COLOR_YELLOW, COLOR_BLACK); // Highlighted text
         } // Else use default colors
+        
+        // Pairs for the ANSI and inline color codes in game output
+        ColorMarkup::initColorPairs();
 
         // Get terminal dimensions for initial setup
         int height, width;
@@ -169,6 +150,140 @@ std::optional<ConsoleUI> ConsoleUI::create() {
     }
 }
 
+// Build a UI on an ncurses screen whose output is discarded
+std::optional<ConsoleUI> ConsoleUI::createHeadless(int height, int width, ConsoleBackend backend) {
+#ifdef _WIN32
+    constexpr const char* kNullDevice = "NUL";
+#else
+    constexpr const char* kNullDevice = "/dev/null";
+#endif
+    try {
+        auto terminal = std::make_unique<HeadlessTerminal>();
+        terminal->out = std::tmpfile();
+        terminal->in = std::fopen(kNullDevice, "r");
+        if (!terminal->out || !terminal->in) {
+            return std::nullopt;
+        }
+        
+        // Any cursor-addressable terminal type will do; the bytes go nowhere
+        for (const char* type : {"xterm-256color", "xterm", "vt100"}) {
+            terminal->screen = newterm(type, terminal->out, terminal->in);
+            if (terminal->screen) break;
+        }
+        if (!terminal->screen) {
+            return std::nullopt;
+        }
+        set_term(terminal->screen);
+        resize_term(height, width);
+        noecho();
+        if (has_colors() && start_color() == OK) {
+            init_pair(1, COLOR_WHITE, COLOR_BLACK);
+            init_pair(2, COLOR_CYAN, COLOR_BLACK);
+            init_pair(3, COLOR_YELLOW, COLOR_BLACK);
+            ColorMarkup::initColorPairs();
+        }
+        
+        ConsoleUI ui(height, width, "Kieran");
+        if (backend == ConsoleBackend::Vt) {
+            ui.m_vt = std::make_unique<VtRenderer>(fileno(terminal->out));
+            ui.m_vt->resize(height, width);
+        }
+        ui.m_headless = std::move(terminal);
+        ui.m_resizeStatus = ui.createWindows(height, width);
+        return ui;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception during headless initialization: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+// Build a UI that draws through VtRenderer. Curses runs on a screen whose
+// output is discarded, only to decode the keys read from the terminal with
+// its terminfo entry; the renderer puts the terminal in raw mode itself.
+std::optional<ConsoleUI> ConsoleUI::createVt() {
+#if defined(NCURSES_VERSION) && !defined(_WIN32)
+    try {
+        initDebugLog();
+        if (!std::setlocale(LC_ALL, "")) {
+            std::cerr << "Warning: Failed to set locale.\n";
+        }
+        winsize size{};
+        if (!isatty(STDIN_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0) {
+            std::cerr << "The VT backend needs a terminal on stdin and stdout\n";
+            return std::nullopt;
+        }
+        const int height = std::max<int>(size.ws_row, 2);
+        const int width = std::max<int>(size.ws_col, 5);
+        
+        auto terminal = std::make_unique<HeadlessTerminal>();
+        terminal->interactive = true;
+        terminal->out = std::fopen("/dev/null", "w");
+        const int input = dup(STDIN_FILENO);
+        terminal->in = input >= 0 ? fdopen(input, "r") : nullptr;
+        if (!terminal->in && input >= 0) {
+            close(input);
+        }
+        if (!terminal->out || !terminal->in) {
+            return std::nullopt;
+        }
+        terminal->screen = newterm(nullptr, terminal->out, terminal->in);
+        if (!terminal->screen) {
+            std::cerr << "No terminfo entry for $TERM\n";
+            return std::nullopt;
+        }
+        set_term(terminal->screen);
+        resize_term(height, width);
+        noecho();
+        nodelay(stdscr, TRUE);
+        keypad(stdscr, TRUE);
+        define_key("\x1b[200~", kKeyPasteBegin);
+        define_key("\x1b[201~", kKeyPasteEnd);
+        if (has_colors() && start_color() == OK) {
+            init_pair(1, COLOR_WHITE, COLOR_BLACK);
+            init_pair(2, COLOR_CYAN, COLOR_BLACK);
+            init_pair(3, COLOR_YELLOW, COLOR_BLACK);
+            ColorMarkup::initColorPairs();
+        }
+        
+        // Keypad transmit mode makes the keys send what terminfo says they do
+        std::string enter = "\x1b[?2004h";
+        std::string leave = "\x1b[?2004l";
+        for (auto [name, sequence] : {std::pair{"smkx", &enter}, std::pair{"rmkx", &leave}}) {
+            const char* capability = tigetstr(name);
+            if (capability && capability != reinterpret_cast<char*>(-1)) {
+                sequence->append(capability);
+            }
+        }
+        
+        ConsoleUI ui(height, width, "Kieran");
+        ui.m_vt = std::make_unique<VtRenderer>(STDOUT_FILENO);
+        if (!ui.m_vt->begin(STDIN_FILENO, enter, leave)) {
+            return std::nullopt;
+        }
+        ui.m_vt->resize(height, width);
+        ui.m_headless = std::move(terminal);
+        ui.m_resizeStatus = ui.createWindows(height, width);
+        ui.setupSignalHandlers();
+        return ui;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception during initialization: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+#else
+    std::cerr << "The VT backend needs ncurses on a POSIX terminal\n";
+    return std::nullopt;
+#endif
+}
+
+ConsoleUI::HeadlessTerminal::~HeadlessTerminal() {
+    if (screen) {
+        if (!isendwin()) endwin();
+        delscreen(screen);
+    }
+    if (out) std::fclose(out);
+    if (in) std::fclose(in);
+}
+
 // Constructor initializes members but doesn't set up ncurses or windows
 ConsoleUI::ConsoleUI(int termHeight, int termWidth, const std::string& playerName)
     : m_outputWin(nullptr, delwin),         // Initialize window pointers with null
@@ -181,16 +296,17 @@ ConsoleUI::ConsoleUI(int termHeight, int termWidth, const std::string& playerNam
       m_inputHeight(3),
       m_game(GameEngine::create(playerName)), // Initialize game engine with player name using shared_ptr
       m_lineEditor(nullptr),                // Line editor will be set up later
-      m_outputBuffer(),                     // Empty output buffer
+      m_outputBuffer(kDefaultScrollback),   // Empty scrollback
       m_scrollOffset(0),                    // Start with no scroll
       m_isRunning(false),                   // UI starts in stopped state
       m_resizeStatus(),                     // No resize status yet
+      m_latency(std::make_unique<EchoLatency>()),
       // Define signal handler callbacks as lambdas that call stop()
       m_interruptCallback([this]() { this->stop(); }),
-      m_terminateCallback([this]() { this->stop(); }),
-      m_outputMutex()
+      m_terminateCallback([this]() { this->stop(); })
 {
     // Line editor will be initialized when we have a valid input window
+    addDefaultStatusFields();
 }
 
 // Set up signal handlers for clean termination
@@ -198,15 +314,23 @@ void ConsoleUI::setupSignalHandlers() {
     // Register the callbacks with the SignalHandler
     auto result1 = SignalHandler::registerHandler(SIGINT, m_interruptCallback);   // Ctrl+C
     if (!result1) {
-        DEBUG_LOG("Failed to register SIGINT handler: " + 
-                  std::to_string(static_cast<int>(result1.error())));
+        LOG_WARN("Failed to register SIGINT handler: {}", static_cast<int>(result1.error()));
     }
     
     auto result2 = SignalHandler::registerHandler(SIGTERM, m_terminateCallback);  // Termination request
     if (!result2) {
-        DEBUG_LOG("Failed to register SIGTERM handler: " + 
-                  std::to_string(static_cast<int>(result2.error())));
+        LOG_WARN("Failed to register SIGTERM handler: {}", static_cast<int>(result2.error()));
+    }
+    
+#ifdef SIGWINCH
+    // Curses never sees the terminal under the VT backend, so resizes come from here
+    if (m_vt && m_headless && m_headless->interactive) {
+        auto result3 = SignalHandler::registerHandler(SIGWINCH, [this]() { resizeFromTerminal(); });
+        if (!result3) {
+            LOG_WARN("Failed to register SIGWINCH handler: {}", static_cast<int>(result3.error()));
+        }
     }
+#endif
 }
 
 // Clean up signal handlers
@@ -214,34 +338,63 @@ void ConsoleUI::cleanupSignalHandlers() {
     // Unregister the handlers to ensure clean shutdown
     auto result1 = SignalHandler::unregisterHandler(SIGINT);
     if (!result1) {
-        DEBUG_LOG("Failed to unregister SIGINT handler: " + 
-                  std::to_string(static_cast<int>(result1.error())));
+        LOG_WARN("Failed to unregister SIGINT handler: {}", static_cast<int>(result1.error()));
     }
     
     auto result2 = SignalHandler::unregisterHandler(SIGTERM);
     if (!result2) {
-        DEBUG_LOG("Failed to unregister SIGTERM handler: " + 
-                  std::to_string(static_cast<int>(result2.error())));
+        LOG_WARN("Failed to unregister SIGTERM handler: {}", static_cast<int>(result2.error()));
+    }
+    
+#ifdef SIGWINCH
+    if (m_vt && m_headless && m_headless->interactive) {
+        auto result3 = SignalHandler::unregisterHandler(SIGWINCH);
+        if (!result3) {
+            LOG_WARN("Failed to unregister SIGWINCH handler: {}", static_cast<int>(result3.error()));
+        }
     }
+#endif
 }
 
 // Move constructor transfers ownership of all resources
 ConsoleUI::ConsoleUI(ConsoleUI&& other) noexcept
-    : m_outputWin(std::move(other.m_outputWin)),
+    : m_headless(std::move(other.m_headless)),
+      m_vt(std::move(other.m_vt)),
+      m_outputWin(std::move(other.m_outputWin)),
       m_outputBorderWin(std::move(other.m_outputBorderWin)),
       m_inputWin(std::move(other.m_inputWin)),
       m_inputBorderWin(std::move(other.m_inputBorderWin)),
+      m_statusWin(std::move(other.m_statusWin)),
       m_termHeight(other.m_termHeight),
       m_termWidth(other.m_termWidth),
       m_outputHeight(other.m_outputHeight),
       m_inputHeight(other.m_inputHeight),
+      m_statusHeight(other.m_statusHeight),
       m_game(std::move(other.m_game)), // Move the shared_ptr
+      m_cachedCommandName(std::move(other.m_cachedCommandName)),
+      m_cachedCommand(other.m_cachedCommand),
       m_lineEditor(std::move(other.m_lineEditor)),
       m_outputBuffer(std::move(other.m_outputBuffer)),
+      m_outputText(std::move(other.m_outputText)),
+      m_wrapWidth(other.m_wrapWidth),
+      m_nextRow(other.m_nextRow),
       m_scrollOffset(other.m_scrollOffset),
+      m_wrappedFrom(other.m_wrappedFrom),
+      m_outputPad(std::move(other.m_outputPad)),
+      m_padRows(other.m_padRows),
+      m_padFrom(other.m_padFrom),
+      m_padTo(other.m_padTo),
+      m_nextMessage(other.m_nextMessage),
+      m_searchNeedle(std::move(other.m_searchNeedle)),
+      m_searchHits(std::move(other.m_searchHits)),
+      m_searchCursor(other.m_searchCursor),
+      m_ownsScreen(other.m_ownsScreen),
       m_isRunning(other.m_isRunning.load()),
       m_resizeStatus(std::move(other.m_resizeStatus)),
-      m_outputMutex(),  // Create a new mutex, can't move mutexes
+      m_pendingOutput(),  // Fresh queue; the UI has not run yet, so nothing is pending
+      m_latency(std::move(other.m_latency)),
+      m_showLatency(other.m_showLatency),
+      m_statusFields(std::move(other.m_statusFields)),
       // Create new callbacks that reference this object, not the moved-from object
       m_interruptCallback([this]() { this->stop(); }),
       m_terminateCallback([this]() { this->stop(); })
@@ -253,11 +406,13 @@ ConsoleUI::ConsoleUI(ConsoleUI&& other) noexcept
     other.m_inputHeight = 0;
     other.m_scrollOffset = 0;
     other.m_isRunning.store(false);
+    other.m_ownsScreen = false;
     // Explicitly reset pointers in moved-from object
     other.m_outputWin.reset();
     other.m_outputBorderWin.reset();
     other.m_inputWin.reset();
     other.m_inputBorderWin.reset();
+    other.m_statusWin.reset();
     other.m_lineEditor.reset();
     other.m_game.reset(); // Reset the shared_ptr in the moved-from object
 
@@ -266,8 +421,10 @@ ConsoleUI::ConsoleUI(ConsoleUI&& other) noexcept
         m_lineEditor->setWindow(m_inputWin.get());
     }
 
-    // Re-register signal handlers with this instance
-    setupSignalHandlers();
+    // Re-register signal handlers with this instance; a headless UI has none
+    if (!m_headless || m_headless->interactive) {
+        setupSignalHandlers();
+    }
 }
 
 // Move assignment operator transfers ownership of all resources
@@ -281,17 +438,39 @@ ConsoleUI& ConsoleUI::operator=(ConsoleUI&& other) noexcept {
         m_outputBorderWin = std::move(other.m_outputBorderWin);
         m_inputWin = std::move(other.m_inputWin);
         m_inputBorderWin = std::move(other.m_inputBorderWin);
+        m_statusWin = std::move(other.m_statusWin);
         m_termHeight = other.m_termHeight;
         m_termWidth = other.m_termWidth;
         m_outputHeight = other.m_outputHeight;
         m_inputHeight = other.m_inputHeight;
+        m_statusHeight = other.m_statusHeight;
         m_game = std::move(other.m_game); // Move the shared_ptr
+        m_cachedCommandName = std::move(other.m_cachedCommandName);
+        m_cachedCommand = other.m_cachedCommand;
         m_lineEditor = std::move(other.m_lineEditor);
         m_outputBuffer = std::move(other.m_outputBuffer);
+        m_outputText = std::move(other.m_outputText);
+        m_wrapWidth = other.m_wrapWidth;
+        m_nextRow = other.m_nextRow;
+        m_wrappedFrom = other.m_wrappedFrom;
+        m_outputPad = std::move(other.m_outputPad);
+        m_padRows = other.m_padRows;
+        m_padFrom = other.m_padFrom;
+        m_padTo = other.m_padTo;
+        m_nextMessage = other.m_nextMessage;
+        m_searchNeedle = std::move(other.m_searchNeedle);
+        m_searchHits = std::move(other.m_searchHits);
+        m_searchCursor = other.m_searchCursor;
+        m_latency = std::move(other.m_latency);
+        m_showLatency = other.m_showLatency;
+        m_statusFields = std::move(other.m_statusFields);
         m_scrollOffset = other.m_scrollOffset;
         m_isRunning.store(other.m_isRunning.load());
+        m_ownsScreen = other.m_ownsScreen;
+        m_headless = std::move(other.m_headless);
+        m_vt = std::move(other.m_vt);
         m_resizeStatus = std::move(other.m_resizeStatus);
-        // Note: we don't move m_outputMutex - mutexes can't be moved or copied
+        // Note: m_pendingOutput and m_export are not moved - both are only filled once run() starts
 
         // Re-create the callbacks to point to this instance
         m_interruptCallback = [this]() { this->stop(); };
@@ -304,18 +483,22 @@ ConsoleUI& ConsoleUI::operator=(ConsoleUI&& other) noexcept {
         other.m_inputHeight = 0;
         other.m_scrollOffset = 0;
         other.m_isRunning.store(false);
+        other.m_ownsScreen = false;
         // Explicitly reset pointers in moved-from object
         other.m_outputWin.reset();
         other.m_outputBorderWin.reset();
         other.m_inputWin.reset();
         other.m_inputBorderWin.reset();
+        other.m_statusWin.reset();
         other.m_lineEditor.reset();
         other.m_game.reset(); // Reset the shared_ptr in the moved-from object
 
         // Re-register signal handlers with this instance
         // (Crucially, this must happen *after* moving members and *after*
         // setting up the new callbacks for 'this' instance)
-        setupSignalHandlers();
+        if (!m_headless || m_headless->interactive) {
+            setupSignalHandlers();
+        }
 
         // Update line editor's window reference if needed
         if (m_lineEditor && m_inputWin) {
@@ -327,6 +510,10 @@ ConsoleUI& ConsoleUI::operator=(ConsoleUI&& other) noexcept {
 
 // Destructor ensures proper cleanup
 ConsoleUI::~ConsoleUI() {
+    // A moved-from object must not unregister the new owner's signal handlers
+    // or take the terminal out of raw mode underneath it
+    if (!m_ownsScreen) return;
+    
     // Clean up signal handlers
     cleanupSignalHandlers();
     
@@ -343,8 +530,10 @@ void ConsoleUI::cleanupNcurses() {
     m_lineEditor.reset();
     m_inputWin.reset();
     m_outputWin.reset();
+    m_outputPad.reset();
     m_inputBorderWin.reset();
     m_outputBorderWin.reset();
+    m_statusWin.reset();
 
     // Reset terminal state
     curs_set(1);         // Show cursor
@@ -352,6 +541,12 @@ void ConsoleUI::cleanupNcurses() {
     echo();              // Re-enable echo
     keypad(stdscr, FALSE); // Disable keypad
     nodelay(stdscr, FALSE); // Disable non-blocking mode
+#if defined(NCURSES_VERSION)
+    if (!m_headless) {
+        std::fputs("\x1b[?2004l", stdout);   // Stop bracketing pastes
+        std::fflush(stdout);
+    }
+#endif
 
     // End ncurses
     endwin();
@@ -370,8 +565,11 @@ void ConsoleUI::calculateWindowSizes(int termHeight, int termWidth) {
     m_inputHeight = std::min(3, termHeight / 5);
     m_inputHeight = std::max(1, m_inputHeight);
     
+    // The status bar is the bottom row, when there are rows to spare
+    m_statusHeight = termHeight >= kStatusBarMinHeight && !m_statusFields.empty() ? 1 : 0;
+    
     // Output window takes the rest of the space
-    m_outputHeight = termHeight - m_inputHeight;
+    m_outputHeight = termHeight - m_inputHeight - m_statusHeight;
     
     // Calculate inner window sizes (inside borders)
     // Ensure we have at least some space for inner windows
@@ -397,9 +595,18 @@ bool ConsoleUI::createBorderWindows() {
         return false;
     }
 
+    // The status bar is optional; without it there is just more output
+    if (m_statusHeight > 0) {
+        m_statusWin.reset(newwin(m_statusHeight, m_termWidth, m_outputHeight + m_inputHeight, 0));
+    }
+
     // Configure the windows
     wbkgd(m_outputBorderWin.get(), COLOR_PAIR(2));
     wbkgd(m_inputBorderWin.get(), COLOR_PAIR(2));
+    if (m_statusWin) {
+        wbkgd(m_statusWin.get(), COLOR_PAIR(2));
+    }
+    layoutStatusFields();
 
     return true;
 }
@@ -430,6 +637,7 @@ bool ConsoleUI::createInnerWindows() {
     wbkgd(m_outputWin.get(), COLOR_PAIR(1)); // Set background color
     wbkgd(m_inputWin.get(), COLOR_PAIR(1));
     keypad(m_inputWin.get(), TRUE);        // Enable special keys in input window
+    nodelay(m_inputWin.get(), TRUE);       // The run loop waits in poll(), never in wgetch()
 
     return true;
 }
@@ -439,6 +647,15 @@ void ConsoleUI::setupLineEditor() {
     if (!m_lineEditor) {
         // First time initialization
         m_lineEditor = std::make_unique<CommandLineEditor>(m_inputInnerWidth, m_inputWin.get());
+        
+        // Tab completes against the engine's names; a weak reference, as the
+        // editor may outlive a moved-from UI's engine pointer
+        if (m_game) {
+            m_lineEditor->setCompletionProvider([game = std::weak_ptr<GameEngine>(m_game)](std::string_view line) {
+                auto engine = game.lock();
+                return engine ? engine->complete(engine->localPlayer(), line) : Completion{};
+            });
+        }
     } else {
         // Update existing line editor
         m_lineEditor->setWindow(m_inputWin.get());
@@ -452,6 +669,7 @@ void ConsoleUI::destroyWindows() {
     m_outputWin.reset();
     m_inputBorderWin.reset();
     m_inputWin.reset();
+    m_statusWin.reset();
 }
 
 // Set up the windows with the given dimensions
@@ -501,17 +719,16 @@ std::optional<bool> ConsoleUI::createWindows(int height, int width) {
     // Set up the line editor
     setupLineEditor();
 
-    // Prepare the screen
+    // Prepare the screen; the next render() draws every window on top
     werase(stdscr);
     wnoutrefresh(stdscr);
-    drawLayout();  // Draw initial layout
-    doupdate();  // Update physical screen
+    markDirty(RedrawAll);
     
     return true;
 }
 
 // Draw all UI elements
-void ConsoleUI::drawLayout() {
+void ConsoleUI::drawLayout(std::uint8_t regions) {
     // Check if we have valid windows
     if (!m_outputWin || !m_inputWin || !m_outputBorderWin || !m_inputBorderWin) {
         // Show simple fallback message
@@ -523,419 +740,1259 @@ void ConsoleUI::drawLayout() {
         return;
     }
     
-    // Draw output window border with title if there's enough space
-    if (m_outputBorderWin) {
+    if (regions & RedrawFrame) {
+        // Draw output window border with title if there's enough space
         box(m_outputBorderWin.get(), 0, 0);
         if (m_termWidth > 8) {
-            mvwprintw(m_outputBorderWin.get(), 0, 2, " Out ");
+            mvwaddnstr(m_outputBorderWin.get(), 0, 2, outputTitle().c_str(), m_termWidth - 4);
         }
         wnoutrefresh(m_outputBorderWin.get());
-    }
-    
-    // Draw input window border with title if there's enough space
-    if (m_inputBorderWin) {
+        
+        // Draw input window border with title if there's enough space
         box(m_inputBorderWin.get(), 0, 0);
         if (m_termWidth > 7) {
             mvwprintw(m_inputBorderWin.get(), 0, 2, " In ");
         }
         wnoutrefresh(m_inputBorderWin.get());
     }
+    if (regions & (RedrawFrame | RedrawStatus)) {
+        drawLatencyStatus();
+    }
+    if (regions & RedrawStatusBar) {
+        drawStatusBar(regions & RedrawFrame);
+    }
     
-    // Draw content in windows
-    drawOutputWindow();
-    drawInputWindow();
+    // Draw content in windows and stage them for update; the border window
+    // covers the output area, so staging it means staging the output again
+    if (regions & (RedrawFrame | RedrawOutput)) {
+        drawOutputWindow();
+    }
+    if (regions & RedrawInput) {
+        drawInputWindow();
+    }
     
-    // Stage changes for update
-    if (m_outputWin) wnoutrefresh(m_outputWin.get());
-    if (m_inputWin) wnoutrefresh(m_inputWin.get());
+    // doupdate() is handled in render() for efficiency
+}
+
+// Repaint whatever was marked dirty since the last frame and flush it
+bool ConsoleUI::render() {
+    drainPendingOutput();
+    
+    std::uint8_t regions = m_dirty.exchange(RedrawNone, std::memory_order_acquire);
+    if (regions == RedrawNone) {
+        m_keysUnechoed.clear();   // Keys that changed nothing have nothing to echo
+        return false;
+    }
+    
+    if (m_vt) {
+        composeVt(regions);
+        m_vt->present();
+        recordFrameLatency();
+        return true;
+    }
+    
+    drawLayout(regions);
+    
+    // Staging any window can move the terminal cursor, so put it back
+    placeCursor();
+    doupdate();
+    recordFrameLatency();
+    return true;
+}
+
+void ConsoleUI::stampKey(std::chrono::steady_clock::time_point arrived) {
+    if (m_keysUnechoed.size() < kMaxUnechoedKeys) {
+        m_keysUnechoed.push_back(arrived);
+    }
+}
+
+// A frame has just been flushed: it shows every key stamped since the last
+// one, and the reply to a command if any output has arrived since its echo
+void ConsoleUI::recordFrameLatency() {
+    if (!m_latency) return;
+    const bool answered = m_commandSubmitted && m_commandAnswered;
+    if (m_keysUnechoed.empty() && !answered) return;
     
-    // doupdate() is handled in run loop for efficiency
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto arrived : m_keysUnechoed) {
+        m_latency->keys.record(now - arrived, now);
+        ++m_latencyRecords;
+    }
+    m_keysUnechoed.clear();
+    if (answered) {
+        m_latency->commands.record(now - *m_commandSubmitted, now);
+        ++m_latencyRecords;
+        m_commandSubmitted.reset();
+    }
 }
 
-// Helper function to wrap text to fit within a specified width
-std::vector<std::string> wrapText(const std::string& text, int width) {
-    std::vector<std::string> lines;
-    if (width <= 0) return lines;
+namespace {
 
-    size_t start = 0;
-    while (start < text.length()) {
-        size_t end = start + width;
-        if (end >= text.length()) {
-            lines.push_back(text.substr(start));
-            break;
+std::string formatLatency(std::chrono::nanoseconds time) {
+    const double ms = std::chrono::duration<double, std::milli>(time).count();
+    return ms < 10.0 ? std::format("{:.1f}ms", ms) : std::format("{:.0f}ms", ms);
+}
+
+std::string describeLatency(const LatencyHistogram& histogram) {
+    if (histogram.count() == 0) return "-";
+    return std::format("p50 {} p99 {}", formatLatency(histogram.percentile(0.5)),
+                       formatLatency(histogram.percentile(0.99)));
+}
+
+}  // namespace
+
+// The readout the status line shows, such as " key p50 0.4ms p99 2.1ms | cmd p50 1.2ms p99 9.0ms "
+std::string ConsoleUI::latencyStatus() {
+    if (!m_latency) return {};
+    m_latencyShown = m_latencyRecords;
+    const auto now = std::chrono::steady_clock::now();
+    return " key " + describeLatency(m_latency->keys.snapshot(now)) + " | cmd " +
+           describeLatency(m_latency->commands.snapshot(now)) + " ";
+}
+
+// The input frame's bottom edge, with the latency readout on it when shown.
+// Only that line is touched, so staging the frame leaves the input alone
+void ConsoleUI::drawLatencyStatus() {
+    WINDOW* border = m_inputBorderWin.get();
+    int height, width;
+    getmaxyx(border, height, width);
+    if (height < 2 || width < 4) return;
+    
+    mvwhline(border, height - 1, 1, ACS_HLINE, width - 2);
+    if (m_showLatency) {
+        mvwaddnstr(border, height - 1, 2, latencyStatus().c_str(), width - 4);
+    }
+    wnoutrefresh(border);
+}
+
+namespace {
+
+// A status bar field as drawn: the label, then the value cut or padded to width
+std::string statusSlot(std::string_view label, std::string_view value, int width) {
+    std::string slot(label);
+    slot += ' ';
+    slot += value.substr(0, static_cast<std::size_t>(width));
+    slot.resize(label.size() + 1 + static_cast<std::size_t>(width), ' ');
+    return slot;
+}
+
+}  // namespace
+
+std::size_t ConsoleUI::addStatusField(std::string label, int width, std::chrono::milliseconds interval,
+                                      StatusProvider provider) {
+    StatusField& field = m_statusFields.emplace_back();
+    field.label = std::move(label);
+    field.width = std::max(width, 1);
+    field.interval = interval;
+    field.provider = std::move(provider);
+    return m_statusFields.size() - 1;
+}
+
+// Sessions, tick time, commands a second and tracked memory. The providers
+// keep what they need between calls themselves and read the metric shards,
+// never this UI, so they survive a move
+void ConsoleUI::addDefaultStatusFields() {
+    using namespace std::chrono_literals;
+    addStatusField("sessions", 5, 1s, [] { return std::to_string(Metrics::instance().total(Metric::Sessions)); });
+    // The mean of the ticks run since the last reading
+    addStatusField("tick", 7, 1s, [seen = std::uint64_t{0}, spent = std::chrono::nanoseconds{0}]() mutable {
+        LatencyHistogram ticks;
+        Metrics::instance().mergeInto(MetricHistogram::TickDuration, ticks);
+        const std::uint64_t count = ticks.count() - seen;
+        const std::chrono::nanoseconds time = ticks.total() - spent;
+        seen = ticks.count();
+        spent = ticks.total();
+        return count > 0 ? formatLatency(time / count) : std::string("-");
+    });
+    addStatusField("cmd/s", 6, 1s,
+                   [run = Metrics::instance().total(Metric::CommandsRun), at = std::chrono::steady_clock::now()]() mutable {
+        const auto now = std::chrono::steady_clock::now();
+        const std::uint64_t total = Metrics::instance().total(Metric::CommandsRun);
+        const double seconds = std::chrono::duration<double>(now - at).count();
+        const double rate = seconds > 0 ? static_cast<double>(total - run) / seconds : 0.0;
+        run = total;
+        at = now;
+        return std::format("{:.0f}", rate);
+    });
+    addStatusField("mem", 10, 2s, [] {
+        std::uint64_t live = 0;
+        for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+            live += MemoryAccounting::stats(static_cast<MemoryTag>(i)).liveBytes;
         }
+        return std::format("{} KiB", live / 1024);
+    });
+}
 
-        // Find the last space before the width limit
-        size_t spacePos = text.find_last_of(' ', end);
-        if (spacePos != std::string::npos && spacePos > start) {
-            lines.push_back(text.substr(start, spacePos - start));
-            start = spacePos + 1; // Skip the space
+// Give each field a column slot, left to right; the fields that do not fit
+// the width are left off the end
+void ConsoleUI::layoutStatusFields() {
+    int column = 1;
+    for (StatusField& field : m_statusFields) {
+        const int slot = static_cast<int>(field.label.size()) + 1 + field.width;
+        if (column >= 0 && column + slot <= m_termWidth - 1) {
+            field.column = column;
+            column += slot + 2;
         } else {
-            // No space found, cut at width
-            lines.push_back(text.substr(start, width));
-            start += width;
+            field.column = -1;
+            column = -1;
         }
+        field.changed = true;
     }
-    return lines;
 }
 
-// Draw the output window content
-void ConsoleUI::drawOutputWindow() {
-    // Skip if window doesn't exist
-    if (!m_outputWin) return;
-    
-    // Clear window
-    werase(m_outputWin.get());
-    
-    // Get window dimensions
-    int winHeight, winWidth;
-    getmaxyx(m_outputWin.get(), winHeight, winWidth);
-    
-    // Skip if window is too small
-    if (winHeight <= 0 || winWidth <= 0) return;
+// Ask the fields that are due for their values and mark the bar for a
+// frame if any changed; returns when the next field is due
+std::chrono::steady_clock::time_point ConsoleUI::refreshStatusFields(std::chrono::steady_clock::time_point now) {
+    auto next = std::chrono::steady_clock::time_point::max();
+    if (!m_statusWin) {
+        return next;
+    }
     
-    // Lock output buffer while accessing it
-    std::lock_guard<std::mutex> lock(m_outputMutex);
-    
-    int currentLine = 0;
-    int screenY = 0;
-
-    // Calculate which lines to display based on scroll position
-    int bufferSize = static_cast<int>(m_outputBuffer.size());
-    
-    // Set text color
-    wattron(m_outputWin.get(), COLOR_PAIR(1));
-    
-    // Iterate through messages
-    for (int i = 0; i < bufferSize && screenY < winHeight; ++i) {
-        const std::string& message = m_outputBuffer[i];
-        std::istringstream iss(message);
-        std::string subLine;
-
-        while (std::getline(iss, subLine)) {
-            auto wrappedLines = wrapText(subLine, winWidth);
-            for (const auto& wrappedLine : wrappedLines) {
-                if (currentLine >= m_scrollOffset) {
-                    if (screenY < winHeight) {
-                        mvwaddstr(m_outputWin.get(), screenY, 0, wrappedLine.c_str());
-                        screenY++;
-                    } else {
-                        break;
-                    }
-                }
-                currentLine++;
+    bool published = false;
+    bool changed = false;
+    for (StatusField& field : m_statusFields) {
+        if (field.column < 0) {
+            continue;
+        }
+        if (now >= field.due) {
+            // The engine's counters reach the shards when asked, as a scrape would ask
+            if (!published && m_game) {
+                m_game->publishMetrics(Metrics::local());
+                published = true;
+            }
+            field.due = now + field.interval;
+            std::string value = field.provider();
+            if (value != field.value) {
+                field.value = std::move(value);
+                field.changed = true;
+                changed = true;
             }
-            if (screenY >= winHeight) break;
         }
+        next = std::min(next, field.due);
     }
-    
-    // Reset text attributes
-    wattroff(m_outputWin.get(), COLOR_PAIR(1));
+    if (changed) {
+        markDirty(RedrawStatusBar);
+    }
+    return next;
 }
 
-// Draw the input window content
-void ConsoleUI::drawInputWindow() {
-    // Skip if window or line editor doesn't exist
-    if (!m_inputWin || !m_lineEditor) return;
-    
-    // Let the line editor draw itself
-    m_lineEditor->draw();
+// Draw the fields whose value changed, or the whole bar when all is set
+void ConsoleUI::drawStatusBar(bool all) {
+    WINDOW* bar = m_statusWin.get();
+    if (!bar) return;
     
-    // Stage changes for update
-    wnoutrefresh(m_inputWin.get());
+    if (all) {
+        werase(bar);
+    }
+    for (StatusField& field : m_statusFields) {
+        if (field.column < 0 || !(all || field.changed)) {
+            continue;
+        }
+        const std::string slot = statusSlot(field.label, field.value, field.width);
+        mvwaddnstr(bar, 0, field.column, slot.c_str(), static_cast<int>(slot.size()));
+        field.changed = false;
+    }
+    wnoutrefresh(bar);
 }
 
-// Process user input
-void ConsoleUI::handleInput() {
-    try {
-        // Get input window or use stdscr if none exists
-        WINDOW* inputSource = m_inputWin ? m_inputWin.get() : stdscr;
-        
-        // Get a character (non-blocking)
-        int ch = wgetch(inputSource);
-        
-        // Skip if no input
-        if (ch == ERR) return;
+// True when a deferred frame has something to draw
+bool ConsoleUI::framePending() const {
+    return m_dirty.load(std::memory_order_acquire) != RedrawNone || !m_pendingOutput.empty();
+}
 
-        // Handle window resize event
-        if (ch == KEY_RESIZE) {
-            handleResize();
-            return;
-        }
-        
-        // Handle scrolling keys
-        if (ch == KEY_PPAGE) { // Page Up
-            // Increase scroll offset to see older messages
-            m_scrollOffset += 5;
-            
-            // Prevent scrolling beyond buffer size
-            int bufferSize = static_cast<int>(m_outputBuffer.size());
-            int winHeight = 0;
-            if (m_outputWin) {
-                getmaxyx(m_outputWin.get(), winHeight, std::ignore);
-            }
-            
-            // Cap scroll offset to prevent blank screens
-            if (m_scrollOffset > bufferSize - winHeight) {
-                m_scrollOffset = bufferSize - winHeight;
-            }
-            
-            // Ensure it's not negative
-            if (m_scrollOffset < 0) {
-                m_scrollOffset = 0;
-            }
-            
-            // Redraw with new scroll position
-            drawOutputWindow();
-            wnoutrefresh(m_outputWin.get());
-            doupdate();
-            return;
-        }
+// Stage the terminal cursor at the line editor's position
+void ConsoleUI::placeCursor() {
+    if (m_inputWin && m_lineEditor) {
+        // Get window dimensions
+        int winWidth;
+        getmaxyx(m_inputWin.get(), std::ignore, winWidth);
         
-        if (ch == KEY_NPAGE) { // Page Down
-            // Decrease scroll offset to see newer messages
-            m_scrollOffset -= 5;
-            
-            // Prevent negative scroll
-            if (m_scrollOffset < 0) {
-                m_scrollOffset = 0;
-            }
-            
-            // Redraw with new scroll position
-            drawOutputWindow();
-            wnoutrefresh(m_outputWin.get());
-            doupdate();
-            return;
-        }
+        // Get cursor position from line editor and ensure it's valid
+        int adjPos = std::min(m_lineEditor->getCursorPosition(), std::max(0, winWidth - 1));
         
-        // Process input with the line editor
-        if (m_lineEditor) {
-            try {
-                // Let the line editor process the key
-                auto result = m_lineEditor->processKey(ch);
-                
-                // Handle command submission
-                if (result.commandSubmitted) {
-                    // Echo command to output
-                    addOutputMessage("> " + result.submittedCommand);
-                    
-                    // Reset scroll offset to show latest messages when a command is submitted
-                    m_scrollOffset = 0;
-                    
-                    // Process the command
-                    try {
-                        processCommand(result.submittedCommand);
-                    } catch (const std::exception& e) {
-                        addOutputMessage("ERROR: Exception in processCommand: " + std::string(e.what()));
-                    } catch (...) {
-                        addOutputMessage("ERROR: Unknown exception in processCommand");
-                    }
-                }
-                
-                // Redraw if needed
-                if (result.needsRedraw) {
-                    drawInputWindow();
-                }
-            } catch (const std::exception& e) {
-                addOutputMessage("ERROR: Exception in line editor: " + std::string(e.what()));
-            } catch (...) {
-                addOutputMessage("ERROR: Unknown exception in line editor");
-            }
-        }
-    } catch (const std::exception& e) {
-        addOutputMessage("ERROR: Exception in handleInput: " + std::string(e.what()));
-    } catch (...) {
-        addOutputMessage("ERROR: Unknown exception in handleInput");
+        // Position cursor
+        wmove(m_inputWin.get(), 0, adjPos);
+        curs_set(1);  // Make cursor visible
+        wnoutrefresh(m_inputWin.get());  // Stage window for update
+    } else {
+        curs_set(0);  // Hide cursor if no input window
+        wnoutrefresh(stdscr);  // Update stdscr if showing error message
     }
 }
 
-// Handle terminal resize events
-void ConsoleUI::handleResize() {
-    // Get new terminal dimensions
-    int h, w;
-    getmaxyx(stdscr, h, w);
-    
-    // Update stored dimensions
-    m_termHeight = h;
-    m_termWidth = w;
-    
-    // Check if terminal was previously too small
-    bool wasTooSmall = !m_resizeStatus.has_value();
-    
-    // Attempt to create windows with new dimensions
-    m_resizeStatus = createWindows(h, w);
-    
-    // Notify user if terminal is now usable
-    if (wasTooSmall && m_resizeStatus.has_value()) {
-        addOutputMessage("Terminal resized to usable dimensions.");
+// Store a message in the scrollback and wrap it to the current width
+void ConsoleUI::appendOutput(std::string_view text, attr_t attributes) {
+    // Color markup is parsed here, once; the scrollback keeps the plain text
+    // and the attribute runs, so drawing never looks at the codes again
+    if (m_outputBuffer.full() && m_wrappedFrom > 0) {
+        --m_wrappedFrom;   // The evicted oldest message shifts every index down
     }
+    OutputMessage& message = m_outputBuffer.push();
+    const std::uint64_t number = m_nextMessage++;
+    ColorMarkup::parse(text, attributes, m_markupScratch, message.runs);
+    text = m_markupScratch;
     
-    // Force refresh to ensure clean redraw
-    refresh();
+    // Release only after storing: push() may have evicted the oldest message,
+    // and its chunk must stay open until the new text is in the arena
+    message.text = m_outputText.store(text);
+    message.attributes = attributes;
+    message.metrics = TextWrap::measure(text);
+    message.rows.clear();
+    message.firstRow = m_nextRow;
+    if (m_wrapWidth > 0) {
+        TextWrap::wrap(text, m_wrapWidth, message.rows, message.metrics);
+    }
+    m_nextRow += message.rows.size();
+    if (!m_searchNeedle.empty() && TextSearch::find(text, m_searchNeedle) != std::string_view::npos) {
+        m_searchHits.push_back(number);
+        markDirty(RedrawFrame);   // The hit count is in the title
+    }
+    releaseEvictedText();
 }
 
-// Process a game command
-void ConsoleUI::handleGameCommand(const std::string& cmd, const std::string& args) {
-    try {
-        DEBUG_LOG("handleGameCommand: cmd='" + cmd + "', args='" + args + "'");
-        
-        // Check if command should quit the application
-        if (m_game->shouldQuit(cmd, args)) {
-            DEBUG_LOG("Command triggers application exit");
-            addOutputMessage("Exiting game...");
-            stop();  // End the run loop
-            return;
-        }
-        
-        // Get response from game engine and display it
-        DEBUG_LOG("Calling game engine handler");
-        try {
-            CommandResult result = m_game->handleCommand(cmd, args);
-            DEBUG_LOG("Game engine response: '" + result.message + "'");
-            
-            // Add the response to the output buffer
-            addOutputMessage(result.message);
-            
-            // If this is the help command with no arguments, add info about scrolling
-            if (cmd == "help" && args.empty()) {
-                addOutputMessage("(Use PageUp/PageDown keys to scroll through output)");
+// Recycle the text chunks that only evicted messages were using
+void ConsoleUI::releaseEvictedText() {
+    if (m_outputBuffer.empty()) {
+        m_outputText.clear();
+    } else {
+        m_outputText.release(m_outputBuffer.front().text.chunk);
+    }
+    dropEvictedHits();
+}
+
+// Switch to a new wrap width. Nothing is wrapped yet: drawing wraps the
+// newest messages it needs and rewrapStep() works through the rest.
+void ConsoleUI::rewrapOutput(int width) {
+    m_wrapWidth = width;
+    m_nextRow = kFirstRow;
+    m_wrappedFrom = m_outputBuffer.size();
+    m_padFrom = m_padTo = m_nextRow;   // Row numbers start over
+}
+
+// Rewrap older messages, newest first, until the message at index is done
+void ConsoleUI::wrapOlder(std::size_t index) {
+    if (m_wrapWidth <= 0) return;
+    while (m_wrappedFrom > index) {
+        const std::uint64_t end = m_wrappedFrom < m_outputBuffer.size()
+            ? m_outputBuffer[m_wrappedFrom].firstRow : m_nextRow;
+        OutputMessage& message = m_outputBuffer[--m_wrappedFrom];
+        message.rows.clear();
+        TextWrap::wrap(m_outputText.view(message.text), m_wrapWidth, message.rows, message.metrics);
+        message.firstRow = end - message.rows.size();
+    }
+}
+
+// Rewrap older messages until at least rows rows are wrapped, or all messages are
+void ConsoleUI::ensureRows(std::uint64_t rows) {
+    while (m_wrappedFrom > 0 && outputRowCount() < rows) {
+        wrapOlder(m_wrappedFrom - 1);
+    }
+}
+
+// Rewrap up to messages more of the history; true while some is left
+bool ConsoleUI::rewrapStep(std::size_t messages) {
+    wrapOlder(m_wrappedFrom > messages ? m_wrappedFrom - messages : 0);
+    return m_wrappedFrom > 0;
+}
+
+// Rows currently wrapped at the current width
+std::uint64_t ConsoleUI::outputRowCount() const {
+    return m_wrappedFrom < m_outputBuffer.size() ? m_nextRow - m_outputBuffer[m_wrappedFrom].firstRow : 0;
+}
+
+int ConsoleUI::outputWindowHeight() const {
+    int winHeight = 0;
+    if (m_outputWin) {
+        getmaxyx(m_outputWin.get(), winHeight, std::ignore);
+    }
+    return std::max(winHeight, 0);
+}
+
+// Index of the message holding a scrollback row, found by binary search over
+// the wrapped messages' first rows; at least one message must be wrapped
+std::size_t ConsoleUI::messageAtRow(std::uint64_t row) const {
+    std::size_t low = m_wrappedFrom;
+    std::size_t high = m_outputBuffer.size();
+    while (low < high) {
+        std::size_t mid = low + (high - low) / 2;
+        if (m_outputBuffer[mid].firstRow <= row) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low > m_wrappedFrom ? low - 1 : m_wrappedFrom;
+}
+
+// Largest scroll offset that still fills the output window
+std::uint64_t ConsoleUI::maxScrollOffset() const {
+    const std::uint64_t totalRows = outputRowCount();
+    return totalRows - std::min<std::uint64_t>(totalRows, static_cast<std::uint64_t>(outputWindowHeight()));
+}
+
+// Row shown on the first line of the output window
+std::uint64_t ConsoleUI::topVisibleRow() const {
+    const std::uint64_t maxOffset = maxScrollOffset();
+    const std::uint64_t scroll = std::min<std::uint64_t>(static_cast<std::uint64_t>(std::max(m_scrollOffset, 0)), maxOffset);
+    return m_nextRow - (outputRowCount() - maxOffset) - scroll;
+}
+
+// Scroll back (positive) or forward (negative), clamped to the scrollback
+void ConsoleUI::scrollBy(int rows) {
+    // Scrolling back into history that has not been rewrapped yet wraps it now
+    if (rows > 0) {
+        ensureRows(static_cast<std::uint64_t>(std::max(m_scrollOffset, 0)) + rows + outputWindowHeight());
+    }
+    const std::int64_t offset = std::clamp<std::int64_t>(std::int64_t{m_scrollOffset} + rows, 0,
+        static_cast<std::int64_t>(std::min<std::uint64_t>(maxScrollOffset(), std::numeric_limits<int>::max())));
+    m_scrollOffset = static_cast<int>(offset);
+    markDirty(RedrawOutput);
+}
+
+// Scroll so that row is the first visible line, or as close as the scrollback allows
+void ConsoleUI::scrollToRow(std::uint64_t row) {
+    const std::uint64_t maxOffset = maxScrollOffset();
+    const std::uint64_t bottomTop = m_nextRow - (outputRowCount() - maxOffset);
+    const std::uint64_t offset = row < bottomTop ? std::min(bottomTop - row, maxOffset) : 0;
+    m_scrollOffset = static_cast<int>(std::min<std::uint64_t>(offset, std::numeric_limits<int>::max()));
+    markDirty(RedrawOutput);
+}
+
+// Jump to the nearest message above (older) or below the top visible line that
+// contains needle. Returns false, leaving the view alone, when there is none.
+bool ConsoleUI::searchOutput(std::string_view needle, bool older) {
+    if (needle.empty() || m_outputBuffer.empty()) {
+        return false;
+    }
+    const std::size_t top = messageAtRow(topVisibleRow());
+    auto matches = [&](std::size_t index) {
+        return m_outputText.view(m_outputBuffer[index].text).find(needle) != std::string_view::npos;
+    };
+    
+    if (older) {
+        for (std::size_t index = top; index-- > 0; ) {
+            if (matches(index)) {
+                jumpToMessage(index);
+                return true;
             }
-            
-            // If there was an error, log it
-            if (result.status == CommandResult::Status::Error) {
-                DEBUG_LOG("ERROR: " + result.message);
+        }
+    } else {
+        for (std::size_t index = top + 1; index < m_outputBuffer.size(); ++index) {
+            if (matches(index)) {
+                jumpToMessage(index);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Scroll so the message at index starts the view, wrapping it first if needed
+void ConsoleUI::jumpToMessage(std::size_t index) {
+    wrapOlder(index);
+    scrollToRow(m_outputBuffer[index].firstRow);
+}
+
+// Index every message holding needle and jump to the newest; an empty needle
+// ends the search. Returns false when nothing matches.
+bool ConsoleUI::startSearch(std::string_view needle) {
+    m_searchNeedle.assign(needle);
+    m_searchHits.clear();
+    m_searchCursor = 0;
+    // Rows in the pad were drawn without (or with other) highlights
+    m_padFrom = m_padTo = m_nextRow;
+    markDirty(RedrawFrame | RedrawOutput);
+    if (needle.empty()) {
+        return true;
+    }
+    
+    const std::uint64_t first = firstMessageNumber();
+    for (std::size_t index = 0; index < m_outputBuffer.size(); ++index) {
+        if (TextSearch::find(m_outputText.view(m_outputBuffer[index].text), needle) != std::string_view::npos) {
+            m_searchHits.push_back(first + index);
+        }
+    }
+    if (m_searchHits.empty()) {
+        return false;
+    }
+    m_searchCursor = m_searchHits.size() - 1;
+    jumpToMessage(static_cast<std::size_t>(m_searchHits.back() - first));
+    return true;
+}
+
+// Jump to the hit before (older) or after the one last jumped to. Returns
+// false, leaving the view alone, at either end.
+bool ConsoleUI::stepSearch(bool older) {
+    if (m_searchHits.empty()) {
+        return false;
+    }
+    if (older) {
+        if (m_searchCursor == 0) return false;
+        --m_searchCursor;
+    } else {
+        if (m_searchCursor + 1 >= m_searchHits.size()) return false;
+        ++m_searchCursor;
+    }
+    jumpToMessage(static_cast<std::size_t>(m_searchHits[m_searchCursor] - firstMessageNumber()));
+    markDirty(RedrawFrame);
+    return true;
+}
+
+// Write the scrollback to file, or a timestamped file in the working
+// directory, on a thread of its own. Only views of the messages are taken
+// here, with pins on the arena chunks holding them.
+void ConsoleUI::startExport(std::string_view file) {
+    if (m_export && !m_export->finished()) {
+        addOutputMessage("An export is already being written.");
+        return;
+    }
+    m_export.reset();   // Joins a finished export's thread
+    
+    std::filesystem::path path(file);
+    if (path.empty()) {
+        const std::time_t now = std::time(nullptr);
+        char stamp[32];
+        std::strftime(stamp, sizeof stamp, "%Y%m%d-%H%M%S", std::localtime(&now));
+        path = std::format("scrollback-{}.txt", stamp);
+    }
+    
+    ScrollbackExport::Snapshot snapshot;
+    m_outputText.pin(snapshot.pins);
+    snapshot.lines.reserve(m_outputBuffer.size());
+    for (std::size_t index = 0; index < m_outputBuffer.size(); ++index) {
+        snapshot.lines.push_back(m_outputText.view(m_outputBuffer[index].text));
+    }
+    
+    const auto started = std::chrono::steady_clock::now();
+    m_export = std::make_unique<ScrollbackExport>(std::move(path), std::move(snapshot),
+        [this, started](const std::filesystem::path& written,
+                        const std::expected<ScrollbackExport::Result, std::string>& result) {
+            if (!result) {
+                postOutput(std::format("Export to {} failed: {}", written.string(), result.error()));
+                return;
+            }
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started);
+            postOutput(result->compressed
+                ? std::format("Exported {} lines ({} KiB, {} KiB compressed) to {} in {} ms", result->lines,
+                              result->bytes / 1024, result->fileBytes / 1024, written.string(), elapsed.count())
+                : std::format("Exported {} lines ({} KiB) to {} in {} ms", result->lines,
+                              result->bytes / 1024, written.string(), elapsed.count()));
+        });
+}
+
+// Forget hits on messages the ring has overwritten
+void ConsoleUI::dropEvictedHits() {
+    const std::uint64_t first = firstMessageNumber();
+    bool dropped = false;
+    while (!m_searchHits.empty() && m_searchHits.front() < first) {
+        m_searchHits.pop_front();
+        if (m_searchCursor > 0) --m_searchCursor;
+        dropped = true;
+    }
+    if (dropped) {
+        markDirty(RedrawFrame);
+    }
+}
+
+// The output frame's title, with the search and its position when one is active
+std::string ConsoleUI::outputTitle() const {
+    if (m_searchNeedle.empty()) {
+        return " Out ";
+    }
+    if (m_searchHits.empty()) {
+        return std::format(" Out - {}: no matches ", m_searchNeedle);
+    }
+    return std::format(" Out - {}: {}/{} ", m_searchNeedle, m_searchCursor + 1, m_searchHits.size());
+}
+
+// Stage the visible part of the scrollback, rendering into the pad only
+// the rows it does not hold yet
+void ConsoleUI::drawOutputWindow() {
+    // Skip if window doesn't exist
+    if (!m_outputWin) return;
+    
+    // Get window dimensions
+    int winHeight, winWidth;
+    getmaxyx(m_outputWin.get(), winHeight, winWidth);
+    
+    // Skip if window is too small
+    if (winHeight <= 0 || winWidth <= 0) return;
+    
+    if (!m_outputPad || getmaxx(m_outputPad.get()) != winWidth || m_padRows < winHeight) {
+        const int padRows = std::max(kOutputPadRows, winHeight);
+        m_outputPad.reset(newpad(padRows, winWidth));
+        if (!m_outputPad) return;
+        wbkgd(m_outputPad.get(), COLOR_PAIR(1));
+        m_padRows = padRows;
+        m_padFrom = m_padTo = m_nextRow;
+    }
+    const auto [firstRow, visibleRows] = visibleOutputRows(winHeight, winWidth);
+    
+    // Until the scrollback fills the window, the lines below it are blank
+    if (visibleRows < static_cast<std::uint64_t>(winHeight)) {
+        werase(m_outputWin.get());
+        wnoutrefresh(m_outputWin.get());
+    }
+    if (visibleRows == 0) return;
+    
+    ensurePadRows(firstRow, firstRow + visibleRows);
+    stagePadRows(firstRow, static_cast<int>(visibleRows));
+}
+
+// Make the pad hold rows [from, to), which must be wrapped and number no
+// more than it has lines. Rows it already holds are kept; a run that grows
+// past the pad gives up the rows at its other end.
+void ConsoleUI::ensurePadRows(std::uint64_t from, std::uint64_t to) {
+    const auto padRows = static_cast<std::uint64_t>(m_padRows);
+    if (to > m_padTo) {
+        // Past a gap, or once the rows it ended with have left the
+        // scrollback, nothing held is next to the new rows: the run restarts
+        if (from > m_padTo || m_padTo < m_outputBuffer[m_wrappedFrom].firstRow) {
+            m_padFrom = from;
+            m_padTo = from;
+        }
+        renderPadRows(m_padTo, to);
+        m_padTo = to;
+        m_padFrom = std::max(m_padFrom, to - std::min(to, padRows));
+    }
+    if (from < m_padFrom) {
+        if (to < m_padFrom) {
+            m_padFrom = to;
+            m_padTo = to;
+        }
+        renderPadRows(from, m_padFrom);
+        m_padFrom = from;
+        m_padTo = std::min(m_padTo, from + padRows);
+    }
+}
+
+// The first scrollback row the output window shows and how many it shows:
+// the newest rows, moved back by the scroll offset, and fewer than the
+// window's height while the scrollback is short. Wraps whatever they need.
+std::pair<std::uint64_t, std::uint64_t> ConsoleUI::visibleOutputRows(int winHeight, int winWidth) {
+    if (winWidth != m_wrapWidth) {
+        rewrapOutput(winWidth);
+    }
+    ensureRows(static_cast<std::uint64_t>(std::max(m_scrollOffset, 0)) + winHeight);
+    
+    const std::uint64_t totalRows = outputRowCount();
+    const std::uint64_t visibleRows = std::min<std::uint64_t>(totalRows, static_cast<std::uint64_t>(winHeight));
+    const std::uint64_t scroll = std::min<std::uint64_t>(static_cast<std::uint64_t>(std::max(m_scrollOffset, 0)), 
+                                                         totalRows - visibleRows);
+    return {m_nextRow - visibleRows - scroll, visibleRows};
+}
+
+// Walk rows [from, to), which must be wrapped: beginRow(row) at the start of
+// each, then drawRun(attributes, text) for each attribute run it overlaps.
+// While a search is active runs are also cut at its matches, which are
+// drawn reversed.
+template <typename BeginRow, typename DrawRun>
+void ConsoleUI::forEachOutputRun(std::uint64_t from, std::uint64_t to, BeginRow&& beginRow, DrawRun&& drawRun) const {
+    if (from >= to) return;
+    
+    // Binary search for the message holding the first row
+    std::size_t index = messageAtRow(from);
+    std::size_t row = static_cast<std::size_t>(from - m_outputBuffer[index].firstRow);
+    
+    // Match offsets in the current message, found when its first row is drawn
+    const std::size_t needle = m_searchNeedle.size();
+    std::vector<std::uint32_t> matches;
+    std::size_t matchedIndex = std::numeric_limits<std::size_t>::max();
+    std::size_t match = 0;
+    
+    for (std::uint64_t at = from; at < to; ) {
+        const OutputMessage& message = m_outputBuffer[index];
+        if (row >= message.rows.size()) {
+            ++index;
+            row = 0;
+            continue;
+        }
+        const std::string_view text = m_outputText.view(message.text);
+        if (needle != 0 && matchedIndex != index) {
+            matches.clear();
+            match = 0;
+            matchedIndex = index;
+            for (std::size_t found = TextSearch::find(text, m_searchNeedle); found != std::string_view::npos;
+                 found = TextSearch::find(text, m_searchNeedle, found + needle)) {
+                matches.push_back(static_cast<std::uint32_t>(found));
+            }
+        }
+        auto draw = [&](attr_t attributes, std::uint32_t start, std::uint32_t end) {
+            while (start < end) {
+                while (match < matches.size() && matches[match] + needle <= start) ++match;
+                if (match == matches.size() || matches[match] >= end) {
+                    drawRun(attributes, text.substr(start, end - start));
+                    return;
+                }
+                if (matches[match] > start) {
+                    drawRun(attributes, text.substr(start, matches[match] - start));
+                    start = matches[match];
+                }
+                const auto stop = static_cast<std::uint32_t>(std::min<std::size_t>(end, matches[match] + needle));
+                drawRun(attributes | A_REVERSE, text.substr(start, stop - start));
+                start = stop;
+            }
+        };
+        const WrappedRow& wrapped = message.rows[row++];
+        beginRow(at++);
+        
+        const std::uint32_t rowEnd = wrapped.offset + wrapped.length;
+        auto run = std::upper_bound(message.runs.begin(), message.runs.end(), wrapped.offset,
+                                    [](std::uint32_t offset, const AttributeRun& r) { return offset < r.offset; });
+        std::uint32_t start = wrapped.offset;
+        attr_t attributes = run == message.runs.begin() ? message.attributes : std::prev(run)->attributes;
+        while (start < rowEnd) {
+            const std::uint32_t end = run == message.runs.end() ? rowEnd : std::min(run->offset, rowEnd);
+            draw(attributes, start, end);
+            start = end;
+            if (run != message.runs.end()) {
+                attributes = run->attributes;
+                ++run;
             }
-        } catch (const std::bad_alloc& e) {
-            // Handle memory allocation errors specifically
-            std::string errorMsg = "Memory error in game engine (bad_alloc): " + std::string(e.what());
-            DEBUG_LOG("ERROR: " + errorMsg);
-            addOutputMessage("ERROR: Out of memory. Please try a simpler command.");
-        } catch (const std::exception& e) {
-            std::string errorMsg = "Exception in handleGameCommand: " + std::string(e.what());
-            DEBUG_LOG("ERROR: " + errorMsg);
-            addOutputMessage("ERROR: " + errorMsg);
         }
-    } catch (const std::bad_alloc& e) {
-        // Handle memory allocation errors specifically
-        DEBUG_LOG("ERROR: Memory allocation failure in handleGameCommand: " + std::string(e.what()));
-        addOutputMessage("ERROR: Out of memory. Please try a simpler command.");
-    } catch (const std::exception& e) {
-        std::string errorMsg = "Exception in handleGameCommand: " + std::string(e.what());
-        DEBUG_LOG("ERROR: " + errorMsg);
-        addOutputMessage("ERROR: " + errorMsg);
-    } catch (...) {
-        std::string errorMsg = "Unknown exception in handleGameCommand";
-        DEBUG_LOG("ERROR: " + errorMsg);
-        addOutputMessage("ERROR: " + errorMsg);
     }
 }
 
-// Parse and process a user command
-void ConsoleUI::processCommand(const std::string& command) {
+// Draw rows [from, to) into their pad lines, straight from the arena text
+void ConsoleUI::renderPadRows(std::uint64_t from, std::uint64_t to) {
+    WINDOW* pad = m_outputPad.get();
+    const auto padRows = static_cast<std::uint64_t>(m_padRows);
+    forEachOutputRun(from, to,
+        [&](std::uint64_t row) {
+            // Clear first: a row that fills the line leaves the cursor on the next
+            wattrset(pad, A_NORMAL);
+            wmove(pad, static_cast<int>(row % padRows), 0);
+            wclrtoeol(pad);
+        },
+        // One wattrset and waddnstr per attribute run the row overlaps
+        [&](attr_t attributes, std::string_view text) {
+            wattrset(pad, attributes);
+            waddnstr(pad, text.data(), static_cast<int>(text.size()));
+        });
+    
+    // Reset text attributes
+    wattrset(pad, A_NORMAL);
+}
+
+// Stage rows pad lines from the one holding row onto the output window's
+// place on screen; where they run past the pad's last line, in two parts
+void ConsoleUI::stagePadRows(std::uint64_t row, int rows) {
+    int top, left, winWidth;
+    getbegyx(m_outputWin.get(), top, left);
+    winWidth = getmaxx(m_outputWin.get());
+    
+    const int line = static_cast<int>(row % static_cast<std::uint64_t>(m_padRows));
+    const int first = std::min(rows, m_padRows - line);
+    pnoutrefresh(m_outputPad.get(), line, 0, top, left, top + first - 1, left + winWidth - 1);
+    if (first < rows) {
+        pnoutrefresh(m_outputPad.get(), 0, 0, top + first, left, top + rows - 1, left + winWidth - 1);
+    }
+}
+
+// The cell style curses would draw attributes with
+VtStyle ConsoleUI::vtStyle(attr_t attributes) const {
+    VtStyle style;
+    short fg = -1;
+    short bg = -1;
+    const short pair = static_cast<short>(PAIR_NUMBER(attributes));
+    if (pair != 0 && pair_content(pair, &fg, &bg) == OK) {
+        style.fg = fg;
+        style.bg = bg;
+    }
+    if (attributes & A_BOLD) style.flags |= VtStyle::Bold;
+    if (attributes & A_UNDERLINE) style.flags |= VtStyle::Underline;
+    if (attributes & A_BLINK) style.flags |= VtStyle::Blink;
+    if (attributes & A_REVERSE) style.flags |= VtStyle::Reverse;
+    return style;
+}
+
+// Compose what is dirty into the VT renderer's grid, laid out by the same
+// windows the curses backend draws in; those are never flushed here, except
+// the input window, which the line editor draws and this reads back
+void ConsoleUI::composeVt(std::uint8_t regions) {
+    VtRenderer& vt = *m_vt;
+    if (!m_outputWin || !m_inputWin || !m_outputBorderWin || !m_inputBorderWin) {
+        for (int row = 0; row < vt.rows(); ++row) {
+            vt.fill(row, 0, vt.cols());
+        }
+        vt.put(0, 0, vt.cols(), "Console", vtStyle(COLOR_PAIR(1)));
+        vt.setCursor(0, 0, false);
+        return;
+    }
+    
+    if (regions & RedrawFrame) {
+        composeVtBox(m_outputBorderWin.get(), m_termWidth > 8 ? outputTitle().c_str() : nullptr);
+        composeVtBox(m_inputBorderWin.get(), m_termWidth > 7 ? " In " : nullptr);
+    }
+    if (regions & (RedrawFrame | RedrawStatus)) {
+        composeVtStatus();
+    }
+    if (regions & RedrawStatusBar) {
+        composeVtStatusBar(regions & RedrawFrame);
+    }
+    if (regions & RedrawOutput) {
+        composeVtOutput();
+    }
+    
+    int top, left, height, width;
+    getbegyx(m_inputWin.get(), top, left);
+    getmaxyx(m_inputWin.get(), height, width);
+    if ((regions & RedrawInput) && m_lineEditor) {
+        m_lineEditor->draw();
+        m_vtScratch.resize(static_cast<std::size_t>(width) * 8 + 1);
+        const int length = mvwinnstr(m_inputWin.get(), 0, 0, m_vtScratch.data(), static_cast<int>(m_vtScratch.size() - 1));
+        const VtStyle base = vtStyle(COLOR_PAIR(1));
+        for (int row = 0; row < height; ++row) {
+            vt.fill(top + row, left, width, base);
+        }
+        vt.put(top, left, left + width, std::string_view(m_vtScratch.data(), static_cast<std::size_t>(std::max(length, 0))), base);
+    }
+    const int column = m_lineEditor ? std::min(m_lineEditor->getCursorPosition(), std::max(0, width - 1)) : 0;
+    vt.setCursor(top, left + column, m_lineEditor != nullptr);
+}
+
+void ConsoleUI::composeVtBox(WINDOW* window, const char* title) {
+    int top, left, height, width;
+    getbegyx(window, top, left);
+    getmaxyx(window, height, width);
+    if (height < 2 || width < 2) return;
+    
+    const VtStyle style = vtStyle(COLOR_PAIR(2));
+    std::string edge;
+    for (int col = 1; col < width - 1; ++col) {
+        edge += "\u2500";
+    }
+    m_vt->put(top, left, left + width, "\u250c" + edge + "\u2510", style);
+    m_vt->put(top + height - 1, left, left + width, "\u2514" + edge + "\u2518", style);
+    for (int row = 1; row < height - 1; ++row) {
+        m_vt->put(top + row, left, left + 1, "\u2502", style);
+        m_vt->put(top + row, left + width - 1, left + width, "\u2502", style);
+    }
+    if (title) {
+        m_vt->put(top, left + 2, left + width - 1, title, style);
+    }
+}
+
+void ConsoleUI::composeVtStatus() {
+    int top, left, height, width;
+    getbegyx(m_inputBorderWin.get(), top, left);
+    getmaxyx(m_inputBorderWin.get(), height, width);
+    if (height < 2 || width < 4) return;
+    
+    const VtStyle style = vtStyle(COLOR_PAIR(2));
+    std::string edge;
+    for (int col = 1; col < width - 1; ++col) {
+        edge += "\u2500";
+    }
+    m_vt->put(top + height - 1, left + 1, left + width - 1, edge, style);
+    if (m_showLatency) {
+        m_vt->put(top + height - 1, left + 2, left + width - 2, latencyStatus(), style);
+    }
+}
+
+void ConsoleUI::composeVtStatusBar(bool all) {
+    if (!m_statusWin) return;
+    int top, left;
+    getbegyx(m_statusWin.get(), top, left);
+    const int width = getmaxx(m_statusWin.get());
+    
+    const VtStyle style = vtStyle(COLOR_PAIR(2));
+    if (all) {
+        m_vt->fill(top, left, width, style);
+    }
+    for (StatusField& field : m_statusFields) {
+        if (field.column < 0 || !(all || field.changed)) {
+            continue;
+        }
+        m_vt->put(top, left + field.column, left + width, statusSlot(field.label, field.value, field.width), style);
+        field.changed = false;
+    }
+}
+
+// The visible rows, composed in full; the renderer sends only what changed,
+// scrolling the region when the rows moved as a block
+void ConsoleUI::composeVtOutput() {
+    int top, left, height, width;
+    getbegyx(m_outputWin.get(), top, left);
+    getmaxyx(m_outputWin.get(), height, width);
+    if (height <= 0 || width <= 0) return;
+    m_vt->setScrollRegion(top, top + height - 1);
+    
+    const auto [firstRow, visibleRows] = visibleOutputRows(height, width);
+    const VtStyle base = vtStyle(COLOR_PAIR(1));
+    int line = top;
+    int column = left;
+    forEachOutputRun(firstRow, firstRow + visibleRows,
+        [&](std::uint64_t row) {
+            line = top + static_cast<int>(row - firstRow);
+            column = left;
+            m_vt->fill(line, left, width, base);
+        },
+        [&](attr_t attributes, std::string_view text) {
+            column = m_vt->put(line, column, left + width, text, vtStyle(attributes));
+        });
+    for (int row = static_cast<int>(visibleRows); row < height; ++row) {
+        m_vt->fill(top + row, left, width, base);
+    }
+}
+
+// Draw the input window content
+void ConsoleUI::drawInputWindow() {
+    // Skip if window or line editor doesn't exist
+    if (!m_inputWin || !m_lineEditor) return;
+    
+    // Let the line editor draw itself
+    m_lineEditor->draw();
+    
+    // Stage changes for update
+    wnoutrefresh(m_inputWin.get());
+}
+
+// Process user input
+bool ConsoleUI::handleInput() {
     try {
-        DEBUG_LOG("Processing command: '" + command + "'");
+        // Get input window or use stdscr if none exists. Under the VT backend
+        // stdscr, which nothing draws on, so wgetch() never refreshes a window
+        WINDOW* inputSource = m_inputWin && !m_vt ? m_inputWin.get() : stdscr;
         
-        if (command.empty()) {
-            DEBUG_LOG("Empty command, ignoring");
-            return;
+        // Get a character (non-blocking)
+        int ch = wgetch(inputSource);
+        
+        // Skip if no input
+        if (ch == ERR) return false;
+        const auto arrived = std::chrono::steady_clock::now();
+
+        // Inside a bracketed paste every key is text, gathered until the end
+        // bracket; nothing is drawn until then
+        if (m_pasting) {
+            if (ch == kKeyPasteEnd) {
+                stampKey(arrived);   // A paste is echoed as one key
+                finishPaste();
+            } else if (ch == KEY_ENTER) {
+                m_pasteBuffer += '\n';
+            } else if (ch >= 0 && ch <= 0xFF && m_pasteBuffer.size() < kMaxPasteBytes) {
+                m_pasteBuffer += static_cast<char>(ch);
+            }
+            return true;
+        }
+
+        if (ch == kKeyPasteBegin) {
+            m_pasting = true;
+            m_pasteBuffer.clear();
+            return true;
+        }
+
+        if (ch == kKeyPasteEnd) return true;   // Stray, as after a resize mid-paste
+
+        // Handle window resize event
+        if (ch == KEY_RESIZE) {
+            handleResize();
+            return true;
         }
         
-        // Make a copy of the command before processing
-        std::string trimmedCommand;
-        try {
-            trimmedCommand = command;
-            
-            // Trim leading spaces safely
-            size_t start = trimmedCommand.find_first_not_of(" \t\n\r\f\v");
-            if (start == std::string::npos) {
-                // Command is only whitespace, ignore
-                DEBUG_LOG("Empty command (whitespace only), ignoring");
-                return;
+        stampKey(arrived);
+        
+        // F12: show or hide the input-to-echo latency readout
+        if (ch == KEY_F(12)) {
+            m_showLatency = !m_showLatency;
+            markDirty(RedrawStatus);
+            return true;
+        }
+        
+        // Handle scrolling keys; each maps to a row through the message index
+        if (ch == KEY_PPAGE) { // Page Up: older rows
+            scrollBy(kScrollStep);
+            return true;
+        }
+        
+        if (ch == KEY_NPAGE) { // Page Down: newer rows
+            scrollBy(-kScrollStep);
+            return true;
+        }
+        
+        if (ch == KEY_SHOME) { // Shift+Home: oldest message
+            wrapOlder(0);
+            scrollToRow(0);
+            return true;
+        }
+        
+        if (ch == KEY_SEND) { // Shift+End: newest message
+            m_scrollOffset = 0;
+            markDirty(RedrawOutput);
+            return true;
+        }
+        
+        // F3 / Shift+F3: step to the previous / next hit of an active /search,
+        // or else the previous / next message containing the input line
+        if (ch == KEY_F(3) || ch == KEY_F(15)) {
+            const bool found = !m_searchNeedle.empty()
+                ? stepSearch(ch == KEY_F(3))
+                : m_lineEditor && searchOutput(m_lineEditor->getCurrentInput(), ch == KEY_F(3));
+            if (!found) {
+                beep();
             }
+            return true;
+        }
+        
+        // Process input with the line editor
+        if (m_lineEditor) {
+            // Let the line editor process the key
+            auto result = m_lineEditor->processKey(ch);
             
-            if (start > 0) {
-                try {
-                    trimmedCommand = trimmedCommand.substr(start);
-                } catch (const std::exception& e) {
-                    DEBUG_LOG("Error trimming leading spaces: " + std::string(e.what()));
-                    // Continue with original command
-                    trimmedCommand = command;
+            // Several Tab matches that share nothing more are listed in the output
+            if (!result.completions.empty()) {
+                std::string list;
+                for (const std::string& match : result.completions) {
+                    if (!list.empty()) list += "  ";
+                    list += match;
                 }
+                addOutputMessage(list);
             }
             
-            // Trim trailing spaces safely
-            size_t end = trimmedCommand.find_last_not_of(" \t\n\r\f\v");
-            if (end != std::string::npos && end + 1 < trimmedCommand.length()) {
-                try {
-                    trimmedCommand = trimmedCommand.substr(0, end + 1);
-                } catch (const std::exception& e) {
-                    DEBUG_LOG("Error trimming trailing spaces: " + std::string(e.what()));
-                    // Proceed with what we have
-                }
+            // Handle command submission
+            if (result.commandSubmitted) {
+                submitCommand(result.submittedCommand);
             }
             
-            DEBUG_LOG("Trimmed command: '" + trimmedCommand + "'");
-        } catch (const std::exception& e) {
-            DEBUG_LOG("Error in command preprocessing: " + std::string(e.what()));
-            // Fall back to the original command
-            trimmedCommand = command;
+            // Redraw the line if it changed; the cursor may have moved either way
+            markDirty(result.needsRedraw ? RedrawInput | RedrawCursor : RedrawCursor);
         }
+    } catch (const std::exception& e) {
+        addOutputMessage("ERROR: Exception in handleInput: " + std::string(e.what()));
+    } catch (...) {
+        addOutputMessage("ERROR: Unknown exception in handleInput");
+    }
+    return true;
+}
+
+// Take a bracketed paste in one pass: each complete line is submitted as a
+// command in turn, the first joined to what was already typed, and what
+// follows the last line break is left on the input line for editing
+void ConsoleUI::finishPaste() {
+    m_pasting = false;
+    if (!m_lineEditor) {
+        m_pasteBuffer.clear();
+        return;
+    }
+    
+    std::string_view rest = m_pasteBuffer;
+    while (!rest.empty()) {
+        const std::size_t lineEnd = rest.find_first_of("\r\n");
+        if (lineEnd == std::string_view::npos) {
+            m_lineEditor->insertText(rest);
+            break;
+        }
+        m_lineEditor->insertText(rest.substr(0, lineEnd));
+        // CR LF is one line break
+        const std::size_t next = rest.compare(lineEnd, 2, "\r\n") == 0 ? lineEnd + 2 : lineEnd + 1;
+        rest.remove_prefix(next);
         
-        // Parse command and arguments safely
-        try {
-            // Parse command and arguments (split at first space)
-            size_t spacePos = trimmedCommand.find(' ');
-            if (spacePos != std::string::npos && spacePos > 0) {
-                // Command has arguments
-                std::string cmd;
-                std::string args;
-                
-                try {
-                    cmd = trimmedCommand.substr(0, spacePos);
-                    std::transform(cmd.begin(), cmd.end(), cmd.begin(), 
-                        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-                } catch (const std::exception& e) {
-                    DEBUG_LOG("Error extracting command: " + std::string(e.what()));
-                    return;
-                }
-                
-                try {
-                    args = trimmedCommand.substr(spacePos + 1);
-                    // Trim leading spaces from args
-                    size_t argsStart = args.find_first_not_of(" \t\n\r\f\v");
-                    if (argsStart != std::string::npos) {
-                        args = args.substr(argsStart);
-                    }
-                } catch (const std::exception& e) {
-                    DEBUG_LOG("Error extracting arguments: " + std::string(e.what()));
-                    args = "";
-                }
-                
-                DEBUG_LOG("Executing command: '" + cmd + "' with args: '" + args + "'");
-                handleGameCommand(cmd, args);
-            } else {
-                // Command with no arguments
-                std::string cmd = trimmedCommand;
-                std::transform(cmd.begin(), cmd.end(), cmd.begin(), 
-                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-                DEBUG_LOG("Executing command: '" + cmd + "' with no args");
-                handleGameCommand(cmd, "");
+        const auto result = m_lineEditor->processKey('\n');
+        if (result.commandSubmitted) {
+            submitCommand(result.submittedCommand);
+        }
+    }
+    m_pasteBuffer.clear();
+    if (m_pasteBuffer.capacity() > kMaxPasteBytes / 16) {
+        m_pasteBuffer.shrink_to_fit();   // Don't hold on to a large paste's buffer
+    }
+    markDirty(RedrawInput | RedrawCursor);
+}
+
+void ConsoleUI::submitCommand(const std::string& command) {
+    // /search is the console's own and is not echoed, so the echo is not a hit
+    if (command == "/search" || command.starts_with("/search ")) {
+        std::string_view needle(command);
+        needle.remove_prefix(std::min<std::size_t>(needle.size(), 8));
+        if (!startSearch(needle)) {
+            beep();
+        }
+        return;
+    }
+    if (command == "/export" || command.starts_with("/export ")) {
+        std::string_view file(command);
+        file.remove_prefix(std::min<std::size_t>(file.size(), 8));
+        startExport(file);
+        return;
+    }
+    
+    // Time from here to the first output after the echo reaching the screen
+    const auto submitted = std::chrono::steady_clock::now();
+    
+    // Echo command to output
+    addOutputMessage("> " + command);
+    m_commandSubmitted = submitted;
+    m_commandAnswered = false;
+    
+    // Reset scroll offset to show latest messages when a command is submitted
+    m_scrollOffset = 0;
+    
+    // Process the command
+    processCommand(command);
+}
+
+// Handle terminal resize events
+void ConsoleUI::handleResize() {
+    // Get new terminal dimensions
+    int h, w;
+    getmaxyx(stdscr, h, w);
+    
+    // Update stored dimensions
+    m_termHeight = h;
+    m_termWidth = w;
+    if (m_vt) {
+        m_vt->resize(h, w);
+    }
+    
+    // Check if terminal was previously too small
+    bool wasTooSmall = !m_resizeStatus.has_value();
+    
+    // Attempt to create windows with new dimensions
+    m_resizeStatus = createWindows(h, w);
+    
+    // Notify user if terminal is now usable
+    if (wasTooSmall && m_resizeStatus.has_value()) {
+        addOutputMessage("Terminal resized to usable dimensions.");
+    }
+    
+    // Force refresh to ensure clean redraw, and repaint everything next frame
+    refresh();
+    markDirty(RedrawAll);
+}
+
+void ConsoleUI::resize(int height, int width) {
+    resize_term(height, width);
+    handleResize();
+}
+
+// Follow the terminal's new size, which curses cannot see under the VT backend
+void ConsoleUI::resizeFromTerminal() {
+#ifndef _WIN32
+    winsize size{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+        resize(size.ws_row, size.ws_col);
+    }
+#endif
+}
+
+std::uint64_t ConsoleUI::takeTerminalBytes() {
+#ifndef _WIN32
+    if (!m_headless || m_headless->interactive) {
+        return 0;
+    }
+    // The screen writes at the file's offset; rewinding keeps the file small
+    std::fflush(m_headless->out);
+    const int fd = fileno(m_headless->out);
+    const off_t written = lseek(fd, 0, SEEK_CUR);
+    if (written <= 0 || ftruncate(fd, 0) != 0) {
+        return 0;
+    }
+    lseek(fd, 0, SEEK_SET);
+    return static_cast<std::uint64_t>(written);
+#else
+    return 0;
+#endif
+}
+
+// Process a game command
+void ConsoleUI::handleGameCommand(std::string_view cmd, std::string_view args) {
+    // Check if command should quit the application
+    if (m_game->shouldQuit(cmd, args)) {
+        addOutputMessage("Exiting game...");
+        stop();  // End the run loop
+        return;
+    }
+    
+    // Reuse the cached handle when the same command is repeated; the
+    // name is assigned into its existing storage
+    if (cmd != m_cachedCommandName || !m_game->isCurrent(m_cachedCommand)) {
+        m_cachedCommand = m_game->resolveCommand(cmd);
+        m_cachedCommandName.assign(cmd);
+    }
+    
+    CommandResult result = m_cachedCommand
+        ? m_game->handleCommand(m_cachedCommand, args)
+        : m_game->handleCommand(cmd, args);
+    
+    // Add the response to the output buffer, then anything sent to us meanwhile
+    addOutputMessage(result.message);
+    for (const auto& message : m_game->takeMessages(m_game->localPlayer())) {
+        addOutputMessage(*message);
+    }
+    
+    // If this is the help command with no arguments, add info about scrolling
+    if (cmd == "help" && args.empty()) {
+        addOutputMessage("(Use PageUp/PageDown keys to scroll through output)");
+    }
+    
+    // If there was an error, log it
+    if (result.status == CommandResult::Status::Error) {
+        LOG_ERROR("{}", result.message);
+    }
+}
+
+std::expected<void, std::string> ConsoleUI::attach(const std::string& path, std::string_view name) {
+    auto client = AdminClient::connect(path, name, [this](std::string message) { postOutput(std::move(message)); });
+    if (!client) {
+        return std::unexpected(std::move(client.error()));
+    }
+    m_remote = std::move(*client);
+    // The default fields read this process's metrics, with no game in them now
+    m_game.reset();
+    m_statusFields.clear();
+    addStatusField("server", 4, std::chrono::seconds(1), [remote = m_remote.get()] {
+        return std::string(remote->connected() ? "up" : "down");
+    });
+    layoutStatusFields();
+    markDirty(RedrawAll);
+    return {};
+}
+
+// Parse and process a user command; the console's one boundary for
+// exceptions out of the engine, whose errors otherwise come back as results
+void ConsoleUI::processCommand(std::string_view command) {
+    try {
+        // The verb is lowercased into the tokens' own buffer and the arguments
+        // stay a view into the line, so nothing is copied on the way to the engine
+        const CommandTokens tokens(command);
+        if (tokens.empty()) {
+            return;   // Blank or whitespace only
+        }
+        
+        // Attached, the server has the line as typed; leaving only detaches
+        if (m_remote) {
+            if (tokens.verb() == "exit" || tokens.verb() == "quit") {
+                addOutputMessage("Detaching from the server...");
+                stop();
+            } else if (!m_remote->send(command)) {
+                addOutputMessage("Not attached to a server.");
             }
-        } catch (const std::exception& e) {
-            DEBUG_LOG("Error parsing command and args: " + std::string(e.what()));
-            addOutputMessage("ERROR: Could not process command: " + std::string(e.what()));
+            return;
         }
+        
+        // Commands separated by ';' and speedwalks go to the engine whole,
+        // which joins their replies into one
+        if (const CommandSequence sequence(command); sequence.isSequence() || sequence.tooLong()) {
+            const CommandResult result = m_game->handleCommandLine(command);
+            addOutputMessage(result.message);
+            for (const auto& message : m_game->takeMessages(m_game->localPlayer())) {
+                addOutputMessage(*message);
+            }
+            return;
+        }
+        handleGameCommand(tokens.verb(), tokens.args());
     } catch (const std::bad_alloc& e) {
         // Handle memory allocation errors specifically
-        DEBUG_LOG("ERROR: Memory allocation failure in processCommand: " + std::string(e.what()));
+        LOG_ERROR("Memory allocation failure in processCommand: {}", e.what());
         addOutputMessage("ERROR: Out of memory. Please try a simpler command.");
     } catch (const std::exception& e) {
         std::string errorMsg = "Exception while processing command: " + std::string(e.what());
-        DEBUG_LOG("ERROR: " + errorMsg);
+        LOG_ERROR("{}", errorMsg);
         addOutputMessage("ERROR: " + errorMsg);
     } catch (...) {
         std::string errorMsg = "Unknown exception while processing command";
-        DEBUG_LOG("ERROR: " + errorMsg);
+        LOG_ERROR("{}", errorMsg);
         addOutputMessage("ERROR: " + errorMsg);
     }
 }
@@ -943,61 +2000,48 @@ void ConsoleUI::processCommand(const std::string& command) {
 // Add a message to the output buffer
 void ConsoleUI::addOutputMessage(const std::string& message) {
     try {
-        // Lock the mutex to ensure thread safety
-        std::lock_guard<std::mutex> lock(m_outputMutex); // Using member mutex
+        // Only the UI thread touches the scrollback; other threads use postOutput()
 
-        // Add message to buffer
+        // Append in O(1); once the scrollback is full this overwrites the
+        // oldest message, reusing its string's storage
         try {
-             m_outputBuffer.push_back(message);
+            appendOutput(message);
+            markDirty(RedrawOutput);
+            m_commandAnswered = m_commandSubmitted.has_value();
         } catch (const std::bad_alloc& e) {
-            // Emergency cleanup on allocation failure during push_back
-            DEBUG_LOG("ERROR: bad_alloc adding message: " + std::string(e.what()));
+            // Emergency cleanup on allocation failure
+            LOG_ERROR("bad_alloc adding message: {}", e.what());
             m_outputBuffer.clear();
-            m_outputBuffer.shrink_to_fit(); // Try to release memory
-             try {
-                 // Try adding an error message and the original message (truncated)
-                 m_outputBuffer.push_back("WARNING: Memory limits reached. Buffer was cleared.");
-                 m_outputBuffer.push_back("Last message: " + message.substr(0, 50) + (message.length() > 50 ? "..." : ""));
-             } catch (...) {
-                  // If even that fails, we can't do much more.
-             }
-             // Skip buffer trimming since we just cleared it.
-             return; // Exit after handling allocation failure
-        }
-
-
-        // Limit buffer size to prevent memory issues
-        const size_t MAX_BUFFER_SIZE = 1000;
-        if (m_outputBuffer.size() > MAX_BUFFER_SIZE) {
+            m_outputText.clear();
+            m_wrappedFrom = 0;
+            markDirty(RedrawOutput);
             try {
-                // Use erase for trimming
-                size_t elementsToRemove = m_outputBuffer.size() - MAX_BUFFER_SIZE;
-                m_outputBuffer.erase(m_outputBuffer.begin(), m_outputBuffer.begin() + elementsToRemove);
-
-            } catch (const std::exception& e) {
-                // If error during pruning, log and potentially clear buffer as fallback
-                DEBUG_LOG("Error during buffer pruning: " + std::string(e.what()) + ". Clearing buffer.");
-                m_outputBuffer.clear();
-                m_outputBuffer.shrink_to_fit(); // Attempt to release memory
-                 try {
-                     m_outputBuffer.push_back("WARNING: Buffer pruning failed. Buffer cleared.");
-                 } catch (...) { /* Ignore if this fails too */ }
+                appendOutput("WARNING: Memory limits reached. Buffer was cleared.");
+                appendOutput("Last message: " + message.substr(0, 50) + (message.length() > 50 ? "..." : ""));
+            } catch (...) {
+                // If even that fails, we can't do much more.
             }
         }
     } catch (const std::exception& e) {
-        // Last resort if we can't even lock the mutex or other general exception
-         // Use CONSOLE_DEBUG_LOG if available, otherwise cerr
-        #ifdef CONSOLE_DEBUG_LOG
-            CONSOLE_DEBUG_LOG("ERROR in addOutputMessage (outer catch): " + std::string(e.what()));
-        #else
-             std::cerr << "ERROR in addOutputMessage (outer catch): " << e.what() << std::endl;
-        #endif
+        // Last resort for any other general exception
+        LOG_ERROR("ERROR in addOutputMessage (outer catch): {}", e.what());
     } catch (...) {
-        #ifdef CONSOLE_DEBUG_LOG
-            CONSOLE_DEBUG_LOG("Unknown ERROR in addOutputMessage (outer catch)");
-        #else
-            std::cerr << "Unknown ERROR in addOutputMessage (outer catch)" << std::endl;
-        #endif
+        LOG_ERROR("Unknown ERROR in addOutputMessage (outer catch)");
+    }
+}
+
+// Queue a message from any thread; push() is a single atomic exchange, so
+// the caller never blocks on the UI thread
+void ConsoleUI::postOutput(std::string message) {
+    m_pendingOutput.push(std::move(message));
+    markDirty(RedrawOutput);
+    wake();
+}
+
+// Move messages posted by other threads into the scrollback, oldest first
+void ConsoleUI::drainPendingOutput() {
+    while (auto message = m_pendingOutput.pop()) {
+        addOutputMessage(*message);
     }
 }
 
@@ -1005,63 +2049,100 @@ void ConsoleUI::addOutputMessage(const std::string& message) {
 void ConsoleUI::run() {
     // Set running flag
     m_isRunning = true;
+    openWakeup();
+    
+    // Keep command history across sessions
+    if (m_lineEditor && !m_lineEditor->openHistoryFile(kHistoryFile)) {
+        addOutputMessage(std::string("Command history will not be saved: cannot open ") + kHistoryFile);
+    }
     
     // Show welcome message
     addOutputMessage("Console UI Ready. Type 'help' or 'exit'.");
     
     // Draw the UI immediately on startup
-    drawLayout();
-    
-    // Position cursor at input position
-    if (m_inputWin && m_lineEditor) {
-        // Get window dimensions
-        int winWidth;
-        getmaxyx(m_inputWin.get(), std::ignore, winWidth);
-        
-        // Get cursor position from line editor and ensure it's valid
-        int adjPos = std::min(m_lineEditor->getCursorPosition(), std::max(0, winWidth - 1));
-        
-        // Position cursor
-        wmove(m_inputWin.get(), 0, adjPos);
-        curs_set(1);  // Make cursor visible
-        wnoutrefresh(m_inputWin.get());  // Stage window for update
-    }
-    
-    // Apply all pending changes to make UI visible immediately
-    doupdate();
+    markDirty(RedrawAll);
+    render();
+
+    // Reports the loop stuck, and stops a runaway script it is stuck in
+    Watchdog::Options watching;
+#ifdef ENABLE_LUA_SCRIPTING
+    watching.onStall = [interrupt = &ScriptRunner::interruptFlag()] {
+        interrupt->store(true, std::memory_order_relaxed);
+    };
+#endif
+    Watchdog watchdog(std::move(watching));
 
     // Main loop
     while (m_isRunning.load(std::memory_order_relaxed)) {
+        watchdog.beat();
         try {
-            // Process input
-            handleInput();
+            // Ctrl+C and SIGTERM only mark themselves in the signal handler;
+            // their callbacks (stop()) run here on the UI thread
+            SignalHandler::dispatchPending();
+            if (!m_isRunning.load(std::memory_order_relaxed)) {
+                break;
+            }
             
-            // Update display
-            drawLayout();
+            // Sample the clock once for the keys and commands of this pass
+            TickClock::advance();
             
-            // Position cursor at input position
-            if (m_inputWin && m_lineEditor) {
-                // Get window dimensions
-                int winWidth;
-                getmaxyx(m_inputWin.get(), std::ignore, winWidth);
-                
-                // Get cursor position from line editor and ensure it's valid
-                int adjPos = std::min(m_lineEditor->getCursorPosition(), std::max(0, winWidth - 1));
-                
-                // Position cursor
-                wmove(m_inputWin.get(), 0, adjPos);
-                curs_set(1);  // Make cursor visible
-                wnoutrefresh(m_inputWin.get());  // Stage window for update
-            } else {
-                curs_set(0);  // Hide cursor if no input window
-                wnoutrefresh(stdscr);  // Update stdscr if showing error message
+            // Process every key that has arrived; ncurses may have buffered
+            // several, and poll() would not report those again
+            bool hadInput = false;
+            while (handleInput()) {
+                hadInput = true;
             }
             
-            // Apply all pending changes
-            doupdate();  // Apply all refresh calls at once
+            // Let the engine use part of the idle time (suspended scripts,
+            // script GC) and show what it sent us
+            auto deadline = std::chrono::steady_clock::time_point::max();
+            if (m_game) {
+                deadline = m_game->idle(std::chrono::milliseconds(2));
+                for (const auto& message : m_game->takeMessages(m_game->localPlayer())) {
+                    addOutputMessage(*message);
+                }
+            }
+            
+            // Read the status bar fields that are due; changed ones are
+            // repainted with the next frame
+            deadline = std::min(deadline, refreshStatusFields(std::chrono::steady_clock::now()));
             
-            // Prevent CPU spinning in main loop
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // Repaint only what changed; an idle console does no terminal I/O.
+            // Keystrokes are echoed at once, anything else waits for the next
+            // frame so a burst of messages is flushed with a single doupdate
+            const auto now = std::chrono::steady_clock::now();
+            if (hadInput || now >= m_nextFrame) {
+                if (render()) {
+                    m_nextFrame = now + kFrameInterval;
+                }
+            } else if (framePending()) {
+                deadline = std::min(deadline, m_nextFrame);
+            }
+            
+            // A shown latency readout picks up new records on a later frame,
+            // no more often than kLatencyStatusInterval
+            if (m_showLatency && m_latencyRecords != m_latencyShown) {
+                const auto due = std::max(m_nextLatencyStatus, m_nextFrame);
+                if (now >= due) {
+                    markDirty(RedrawStatus);
+                    m_nextLatencyStatus = now + kLatencyStatusInterval;
+                    deadline = now;
+                } else {
+                    deadline = std::min(deadline, due);
+                }
+            }
+            
+            // Rewrap a slice of the history left over from a resize; keep
+            // polling without sleeping until it is done
+            if (m_wrappedFrom > 0 && rewrapStep(kRewrapBatch)) {
+                deadline = now;
+            }
+            
+            // Sleep until a key, a signal, a wake() from another thread, or the engine's deadline
+            if (m_isRunning.load(std::memory_order_relaxed)) {
+                watchdog.rest();
+                waitForEvents(deadline);
+            }
         } catch (const std::exception& e) {
             addOutputMessage("ERROR: Exception in main loop: " + std::string(e.what()));
             // Continue running despite error
@@ -1071,6 +2152,8 @@ void ConsoleUI::run() {
         }
     }
     
+    closeWakeup();
+    
     // Clean up resources
     cleanupSignalHandlers();
     cleanupNcurses();
@@ -1079,28 +2162,112 @@ void ConsoleUI::run() {
 // Stop the UI loop
 void ConsoleUI::stop() {
     m_isRunning.store(false, std::memory_order_relaxed);
+    wake();
+}
+
+// Create the pipe other threads (and signal handlers) use to interrupt waitForEvents()
+void ConsoleUI::openWakeup() {
+#ifndef _WIN32
+    int fds[2];
+    if (pipe(fds) != 0) {
+        LOG_WARN("Failed to create wakeup pipe; falling back to polling");
+        return;
+    }
+    for (int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    m_wakeReadFd = fds[0];
+    m_wakeWriteFd.store(fds[1], std::memory_order_release);
+#endif
+}
+
+void ConsoleUI::closeWakeup() {
+#ifndef _WIN32
+    int writeFd = m_wakeWriteFd.exchange(-1, std::memory_order_acq_rel);
+    if (writeFd >= 0) {
+        close(writeFd);
+    }
+    if (m_wakeReadFd >= 0) {
+        close(m_wakeReadFd);
+        m_wakeReadFd = -1;
+    }
+#endif
+}
+
+// Interrupt waitForEvents(); safe from any thread and from signal handlers
+void ConsoleUI::wake() {
+#ifndef _WIN32
+    int fd = m_wakeWriteFd.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        // A full pipe already guarantees a wakeup, so a failed write is fine
+        const char byte = 1;
+        [[maybe_unused]] auto written = write(fd, &byte, 1);
+    }
+#endif
+}
+
+// Block until input is ready, wake() is called or the deadline passes
+void ConsoleUI::waitForEvents(std::chrono::steady_clock::time_point deadline) {
+    using namespace std::chrono;
+    
+    // Without the wakeup pipe (or on Windows) poll at the old 10 ms interval
+    milliseconds fallback(10);
+    
+#ifndef _WIN32
+    if (m_wakeReadFd >= 0) {
+        int timeout = -1;
+        if (deadline != steady_clock::time_point::max()) {
+            // Round up so the deadline has passed when we wake
+            auto remaining = ceil<milliseconds>(deadline - steady_clock::now());
+            timeout = static_cast<int>(std::clamp<milliseconds::rep>(remaining.count(), 0, std::numeric_limits<int>::max()));
+        }
+        
+        // The signal pipe is -1 until a handler is registered, which poll skips
+        pollfd fds[3] = {
+            {STDIN_FILENO, POLLIN, 0},
+            {m_wakeReadFd, POLLIN, 0},
+            {SignalHandler::fd(), POLLIN, 0}
+        };
+        // EINTR (e.g. SIGWINCH) just returns to the loop, where wgetch reports the resize;
+        // the signal pipe is drained by SignalHandler::dispatchPending() there
+        poll(fds, 3, timeout);
+        
+        if (fds[1].revents & POLLIN) {
+            char drain[64];
+            while (read(m_wakeReadFd, drain, sizeof(drain)) > 0) {
+            }
+        }
+        return;
+    }
+#endif
+    
+    if (deadline != steady_clock::time_point::max()) {
+        fallback = std::min(fallback, ceil<milliseconds>(std::max(deadline - steady_clock::now(), steady_clock::duration::zero())));
+    }
+    std::this_thread::sleep_for(fallback);
+}
+
+void ConsoleUI::setScrollbackCapacity(std::size_t messages) {
+    const std::size_t before = m_outputBuffer.size();
+    m_outputBuffer.setCapacity(messages);
+    const std::size_t dropped = before - m_outputBuffer.size();
+    m_wrappedFrom = m_wrappedFrom > dropped ? m_wrappedFrom - dropped : 0;
+    releaseEvictedText();
+    m_scrollOffset = 0;
+    markDirty(RedrawOutput);
 }
 
 // Debug method implementation (Optional)
 void ConsoleUI::logMemoryStats() const {
-    // Use const_cast if mutex needs to be locked in a const method,
-    // or make the mutex mutable if stats logging is common.
-    // Or avoid locking if brief inconsistency is acceptable for debug stats.
-    // std::lock_guard<std::mutex> lock(m_outputMutex); // May require mutable mutex or const_cast
-    try {
-        std::stringstream ss;
-        ss << "Memory stats - Output buffer: size=" << m_outputBuffer.size()
-           << ", capacity=" << m_outputBuffer.capacity();
-        #ifdef CONSOLE_DEBUG_LOG
-            CONSOLE_DEBUG_LOG(ss.str());
-        #else
-            std::cerr << ss.str() << std::endl;
-        #endif
-    } catch (const std::exception& e) {
-         #ifdef CONSOLE_DEBUG_LOG
-             CONSOLE_DEBUG_LOG("Exception in logMemoryStats: " + std::string(e.what()));
-         #else
-              std::cerr << "Exception in logMemoryStats: " << e.what() << std::endl;
-         #endif
+    // Reads the scrollback without synchronisation; call it from the UI thread
+    LOG_DEBUG("Memory stats - Output buffer: size={}, capacity={}, text chunks={}, text bytes={}",
+              m_outputBuffer.size(), m_outputBuffer.capacity(), m_outputText.chunkCount(),
+              m_outputText.bytesReserved());
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+        const auto tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = MemoryAccounting::stats(tag);
+        LOG_DEBUG("Memory stats - {}: live={}, peak={}, allocations={}", MemoryAccounting::name(tag),
+                  stats.liveBytes, stats.peakBytes, stats.allocations);
     }
 } 
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "../include/Copyover.h"
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::string_view kMagic = "echomud-copyover/2";
+constexpr std::string_view kMagicBeforeWidth = "echomud-copyover/1";   // Sessions carry no width
+
+void put(std::string& out, std::string_view field) {
+    out += std::to_string(field.size());
+    out += ':';
+    out += field;
+    out += ',';
+}
+
+void put(std::string& out, std::uint64_t number) {
+    put(out, std::to_string(number));
+}
+
+// Takes fields off the front of the state; fails for good at the first bad one
+class Fields {
+public:
+    explicit Fields(std::string_view bytes) : m_rest(bytes) {}
+
+    bool ok() const noexcept { return m_ok; }
+
+    std::string_view field() {
+        std::size_t size = 0;
+        const auto [end, error] = std::from_chars(m_rest.data(), m_rest.data() + m_rest.size(), size);
+        const std::size_t skip = static_cast<std::size_t>(end - m_rest.data());
+        if (!m_ok || error != std::errc() || skip >= m_rest.size() || m_rest[skip] != ':' ||
+            m_rest.size() - skip - 1 <= size || m_rest[skip + 1 + size] != ',') {
+            m_ok = false;
+            return {};
+        }
+        const std::string_view field = m_rest.substr(skip + 1, size);
+        m_rest.remove_prefix(skip + size + 2);
+        return field;
+    }
+
+    template <typename T>
+    T number() {
+        const std::string_view text = field();
+        T value{};
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (error != std::errc() || end != text.data() + text.size()) {
+            m_ok = false;
+        }
+        return value;
+    }
+
+    bool done() const noexcept { return m_ok && m_rest.empty(); }
+
+private:
+    std::string_view m_rest;
+    bool m_ok = true;
+};
+
+bool inherit(int fd) {
+    const int flags = fcntl(fd, F_GETFD);
+    return flags >= 0 && fcntl(fd, F_SETFD, flags & ~FD_CLOEXEC) == 0;
+}
+
+} // namespace
+
+int Copyover::save(const CopyoverState& state) {
+    std::string out;
+    put(out, kMagic);
+    put(out, state.listeners.size());
+    for (const auto& listeners : state.listeners) {
+        put(out, static_cast<std::uint64_t>(listeners[0] + 1));
+        put(out, static_cast<std::uint64_t>(listeners[1] + 1));
+    }
+    put(out, state.sessions.size());
+    for (const CopyoverSession& session : state.sessions) {
+        put(out, session.reactor);
+        put(out, static_cast<std::uint64_t>(session.fd));
+        put(out, session.compressed);
+        put(out, session.width);
+        put(out, session.input);
+        put(out, session.queued.size());
+        for (const std::string& line : session.queued) {
+            put(out, line);
+        }
+        put(out, session.outOfBand);
+        put(out, session.name);
+        put(out, session.player);
+        put(out, session.echoOff);
+    }
+
+    // Unlinked at once: nothing is left behind whether or not the exec works
+    std::string path = (std::filesystem::temp_directory_path() / "echomud-copyover-XXXXXX").string();
+    const int fd = ::mkstemp(path.data());
+    if (fd < 0) {
+        return -1;
+    }
+    ::unlink(path.c_str());
+    std::string_view rest = out;
+    while (!rest.empty()) {
+        const ssize_t written = ::write(fd, rest.data(), rest.size());
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            ::close(fd);
+            return -1;
+        }
+        rest.remove_prefix(static_cast<std::size_t>(written));
+    }
+    if (::lseek(fd, 0, SEEK_SET) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+std::optional<CopyoverState> Copyover::load(int fd) {
+    std::string bytes;
+    char buffer[64 * 1024];
+    for (;;) {
+        const ssize_t got = ::read(fd, buffer, sizeof buffer);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break;
+        }
+        bytes.append(buffer, static_cast<std::size_t>(got));
+    }
+    ::close(fd);
+
+    Fields fields(bytes);
+    // A process built before widths were carried may be the one handing over
+    const std::string_view magic = fields.field();
+    const bool widths = magic == kMagic;
+    if (!widths && magic != kMagicBeforeWidth) {
+        return std::nullopt;
+    }
+    CopyoverState state;
+    state.listeners.resize(fields.number<std::size_t>());
+    for (auto& listeners : state.listeners) {
+        // Stored one up, so a missing listener (-1) is 0
+        listeners[0] = fields.number<int>() - 1;
+        listeners[1] = fields.number<int>() - 1;
+    }
+    const std::size_t sessions = fields.number<std::size_t>();
+    for (std::size_t i = 0; i < sessions && fields.ok(); ++i) {
+        CopyoverSession& session = state.sessions.emplace_back();
+        session.reactor = fields.number<std::uint16_t>();
+        session.fd = fields.number<int>();
+        session.compressed = fields.number<int>() != 0;
+        session.width = widths ? fields.number<std::uint16_t>() : 0;
+        session.input = fields.field();
+        session.queued.resize(fields.number<std::size_t>());
+        for (std::string& line : session.queued) {
+            line = fields.field();
+        }
+        session.outOfBand = fields.number<std::uint32_t>();
+        session.name = fields.field();
+        session.player = fields.field();
+        session.echoOff = fields.number<int>() != 0;
+    }
+    if (!fields.done()) {
+        return std::nullopt;
+    }
+    return state;
+}
+
+void Copyover::exec(const std::filesystem::path& executable, const std::vector<std::string>& arguments,
+                    const CopyoverState& state, int stateFd) {
+    for (const auto& listeners : state.listeners) {
+        for (const int fd : listeners) {
+            if (fd >= 0 && !inherit(fd)) {
+                return;
+            }
+        }
+    }
+    for (const CopyoverSession& session : state.sessions) {
+        if (!inherit(session.fd)) {
+            return;
+        }
+    }
+    if (!inherit(stateFd)) {
+        return;
+    }
+
+    const std::string path = executable.string();
+    const std::string stateArgument = std::to_string(stateFd);
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(path.c_str()));
+    for (const std::string& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    const std::string option(kOption);
+    argv.push_back(const_cast<char*>(option.c_str()));
+    argv.push_back(const_cast<char*>(stateArgument.c_str()));
+    argv.push_back(nullptr);
+    ::execv(path.c_str(), argv.data());
+}
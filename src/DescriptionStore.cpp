@@ -0,0 +1,201 @@
+#include "../include/DescriptionStore.h"
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#ifdef ENABLE_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace {
+
+#ifdef ENABLE_ZSTD
+// Worlds are packed offline, once, so the writer can afford to search hard
+constexpr int kPackLevel = 19;
+// The dictionary zstd suggests: a hundredth of the text or so, within limits
+constexpr std::size_t kMaxDictionaryBytes = 112 * 1024;
+constexpr std::size_t kMinDictionaryBytes = 1024;
+// Below this there is too little to learn from; above it training slows
+// without learning much more
+constexpr std::size_t kMinSampleBytes = 8 * 1024;
+constexpr std::size_t kMaxSampleBytes = 32 * 1024 * 1024;
+// No description is this long; a frame that says so is damaged
+constexpr unsigned long long kMaxTextBytes = 1 << 20;
+
+struct FreeContext {
+    void operator()(ZSTD_DCtx* context) const noexcept { ZSTD_freeDCtx(context); }
+};
+
+// One per thread that unpacks, kept for its buffers
+thread_local std::unique_ptr<ZSTD_DCtx, FreeContext> t_context;
+
+bool unpack(std::string_view frame, const ZSTD_DDict* dictionary, std::string& out) {
+    const unsigned long long size = ZSTD_getFrameContentSize(frame.data(), frame.size());
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR || size > kMaxTextBytes) {
+        return false;
+    }
+    if (!t_context) {
+        t_context.reset(ZSTD_createDCtx());
+        if (!t_context) {
+            return false;
+        }
+    }
+    out.resize(static_cast<std::size_t>(size));
+    const std::size_t written = ZSTD_decompress_usingDDict(t_context.get(), out.data(), out.size(), frame.data(),
+                                                           frame.size(), dictionary);
+    return !ZSTD_isError(written) && written == out.size();
+}
+#endif
+
+} // namespace
+
+DescriptionPacker::DescriptionPacker(std::span<const std::string_view> samples) {
+#ifdef ENABLE_ZSTD
+    std::string joined;
+    std::vector<std::size_t> sizes;
+    for (const std::string_view sample : samples) {
+        if (joined.size() + sample.size() > kMaxSampleBytes) {
+            break;
+        }
+        joined += sample;
+        sizes.push_back(sample.size());
+    }
+    if (joined.size() < kMinSampleBytes) {
+        return;
+    }
+    m_dictionaryBytes.resize(std::clamp(joined.size() / 100, kMinDictionaryBytes, kMaxDictionaryBytes));
+    const std::size_t trained = ZDICT_trainFromBuffer(m_dictionaryBytes.data(), m_dictionaryBytes.size(),
+                                                      joined.data(), sizes.data(),
+                                                      static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(trained)) {
+        m_dictionaryBytes.clear();
+        return;
+    }
+    m_dictionaryBytes.resize(trained);
+    m_dictionary = ZSTD_createCDict(m_dictionaryBytes.data(), m_dictionaryBytes.size(), kPackLevel);
+    m_context = ZSTD_createCCtx();
+    if (!m_context || !m_dictionary || ZSTD_isError(ZSTD_CCtx_refCDict(m_context, m_dictionary))
+        || ZSTD_isError(ZSTD_CCtx_setParameter(m_context, ZSTD_c_dictIDFlag, 0))) {
+        ZSTD_freeCDict(m_dictionary);
+        m_dictionary = nullptr;
+        m_dictionaryBytes.clear();
+    }
+#else
+    (void)samples;
+#endif
+}
+
+DescriptionPacker::~DescriptionPacker() {
+#ifdef ENABLE_ZSTD
+    ZSTD_freeCCtx(m_context);
+    ZSTD_freeCDict(m_dictionary);
+#endif
+}
+
+bool DescriptionPacker::pack(std::string_view text, std::string& out) {
+#ifdef ENABLE_ZSTD
+    if (!m_dictionary || text.size() < kMinPackedSize) {
+        return false;
+    }
+    out.resize(ZSTD_compressBound(text.size()));
+    const std::size_t written = ZSTD_compress2(m_context, out.data(), out.size(), text.data(), text.size());
+    if (ZSTD_isError(written) || written >= text.size()) {
+        return false;
+    }
+    out.resize(written);
+    return true;
+#else
+    (void)text;
+    (void)out;
+    return false;
+#endif
+}
+
+bool DescriptionStore::available() noexcept {
+#ifdef ENABLE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+DescriptionStore::DescriptionStore(std::string_view dictionary, std::vector<std::string_view> frames,
+                                   std::uint64_t textBytes, std::size_t hotBytes)
+    : m_frames(std::move(frames)), m_hotLimit(hotBytes) {
+    // Rooms sharing a description share its frame; only the views are
+    // read, not the frames, which stay paged out
+    std::unordered_set<const char*> distinct;
+    for (const std::string_view frame : m_frames) {
+        if (!frame.empty() && distinct.insert(frame.data()).second) {
+            m_totals.packedBytes += frame.size();
+        }
+    }
+    m_totals.packed = distinct.size();
+    m_totals.packedBytes += dictionary.size();
+    m_totals.textBytes = textBytes;
+#ifdef ENABLE_ZSTD
+    m_dictionary = ZSTD_createDDict(dictionary.data(), dictionary.size());
+#endif
+}
+
+DescriptionStore::~DescriptionStore() {
+#ifdef ENABLE_ZSTD
+    ZSTD_freeDDict(m_dictionary);
+#endif
+}
+
+bool DescriptionStore::append(RoomId room, std::string& out) {
+    if (!packed(room) || !m_dictionary) {
+        return false;
+    }
+    const std::string_view frame = m_frames[room];
+    {
+        const std::lock_guard lock(m_mutex);
+        if (const auto found = m_hotIndex.find(frame.data()); found != m_hotIndex.end()) {
+            m_hot.splice(m_hot.begin(), m_hot, found->second);
+            out += found->second->text;
+            ++m_hits;
+            return true;
+        }
+    }
+#ifdef ENABLE_ZSTD
+    const auto started = std::chrono::steady_clock::now();
+    std::string text;
+    if (!unpack(frame, m_dictionary, text)) {
+        return false;
+    }
+    const auto took = std::chrono::steady_clock::now() - started;
+    out += text;
+
+    const std::lock_guard lock(m_mutex);
+    ++m_misses;
+    m_unpackTime += std::chrono::duration_cast<std::chrono::nanoseconds>(took);
+    // Another thread may have unpacked it meanwhile
+    if (text.size() > m_hotLimit || m_hotIndex.contains(frame.data())) {
+        return true;
+    }
+    m_hotBytes += text.size();
+    m_hot.push_front({frame.data(), std::move(text)});
+    m_hotIndex.emplace(frame.data(), m_hot.begin());
+    while (m_hotBytes > m_hotLimit) {
+        const Hot& coldest = m_hot.back();
+        m_hotBytes -= coldest.text.size();
+        m_hotIndex.erase(coldest.frame);
+        m_hot.pop_back();
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+DescriptionStats DescriptionStore::stats() const {
+    DescriptionStats stats = m_totals;
+    const std::lock_guard lock(m_mutex);
+    stats.hotEntries = m_hot.size();
+    stats.hotBytes = m_hotBytes;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.unpackTime = m_unpackTime;
+    return stats;
+}
@@ -1,23 +1,46 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "../include/GameEngine.h"
+#include "../include/CommandTokens.h"
+#include "../include/MessageTemplate.h"
+#include "../include/PlayerSave.h"
+#include "../include/TickClock.h"
+#include "../include/TraceLog.h"
+#include "../include/Watchdog.h"
+#include "../include/WorldStatus.h"
 #include <algorithm>
 #include <sstream>  // For stringstream
 #include <iostream> // For debugging
-#include <fstream>  // For file logging
 #include <format>   // For std::format
+#include <charconv>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
-// Implementation of internal logging function
-namespace internal {
-    void logDebug(const std::string& msg) {
-        // Simple file logging implementation
-        static std::ofstream logFile("game_engine_debug.log", std::ios::app);
-        if (logFile) {
-            logFile << "[DEBUG] " << msg << std::endl;
-        }
-        // Also log to stderr for debugging
-        std::cerr << "[DEBUG] " << msg << std::endl;
+thread_local GameEngine::ZoneActor* GameEngine::t_zone = nullptr;
+
+CommandResult CommandResult::error(DispatchError failure, std::string_view subject) {
+    // Fixed text into a recycled buffer, so a flood of unknown commands
+    // neither allocates nor formats
+    switch (failure) {
+        case DispatchError::UnknownPlayer:
+            return CommandResult::error("Unknown player.");
+        case DispatchError::UnknownCommand:
+            return CommandResult::error(
+                Message<"Unknown command: '{}'. Type 'help' for a list of commands.">::reply(subject));
+        case DispatchError::StaleHandle:
+            return CommandResult::error("Command handle is no longer valid. Please try again.");
+        case DispatchError::Blocked:
+            return CommandResult::error("Something prevents you from doing that.");
+        case DispatchError::ExitInSequence:
+            return CommandResult::error("Type exit on a line of its own to leave.");
+        case DispatchError::Failed:
+            break;
     }
+    return CommandResult::error(Message<"Error executing command '{}'">::reply(subject));
 }
 
 // Safe string copy function to avoid memory issues
@@ -30,8 +53,29 @@ static void safeStringAppend(std::string& dest, const char* src) {
 }
 
 GameEngine::GameEngine(std::string playerName)
-    : m_player(std::move(playerName))
+    : GameEngine(std::move(playerName), AreaFile{})
+{
+}
+
+GameEngine::GameEngine(std::string playerName, AreaFile area)
+#ifdef ENABLE_LUA_SCRIPTING
+    : m_scriptRunner(std::make_unique<ScriptRunnerPool>())
+    , m_scriptDir("scripts")
+#endif
 {
+    // Rooms must exist before players can be placed in them
+    if (area.valid()) {
+        loadArea(std::move(area));
+    } else {
+        buildWorld();
+    }
+    
+    // Hooks must be in place before the first player joins
+    registerDefaultHooks();
+    
+    // The console player is the first registered player
+    m_localPlayer = addPlayer(std::move(playerName));
+    
     // Don't call registerCommands() here as it uses shared_from_this()
     // It will be called from initialize() after the shared_ptr is fully constructed
 }
@@ -40,289 +84,4539 @@ GameEngine::GameEngine(std::string playerName)
 void GameEngine::initialize() {
     // Register all available commands
     registerCommands();
+    
+    if (m_ambienceUpdate == kInvalidTickUpdateId) {
+        m_ambienceUpdate = m_ticks.addUpdate(kAmbienceTicks, [this](std::uint64_t tick) { runAmbience(tick); });
+    }
+    
+#ifdef ENABLE_LUA_SCRIPTING
+    // Register script commands (these may override built-ins such as 'say')
+    registerScripts();
+#endif
 }
 
 // Move constructor implementation
 GameEngine::GameEngine(GameEngine&& other) noexcept
-    : m_player(std::move(other.m_player)),
-      m_hookSystem(std::move(other.m_hookSystem)),
-      m_commands() // Initialize empty map
+    : m_players(std::move(other.m_players)),
+      m_outbox(std::move(other.m_outbox)),
+      m_recipients(std::move(other.m_recipients)),
+      m_listed(std::move(other.m_listed)),
+      m_dirty(std::move(other.m_dirty)),
+      m_world(std::move(other.m_world)),
+      m_startRoom(other.m_startRoom),
+      m_entities(std::move(other.m_entities)),
+      m_roomContents(std::move(other.m_roomContents)),
+      m_items(std::move(other.m_items)),
+      m_playerBodies(std::move(other.m_playerBodies)),
+      m_ambience(std::move(other.m_ambience)),
+      m_area(std::move(other.m_area)),
+      m_zoneLoaded(std::move(other.m_zoneLoaded)),
+      m_areaPrototypes(std::move(other.m_areaPrototypes)),
+      m_descriptions(std::move(other.m_descriptions)),
+      m_localPlayer(other.m_localPlayer),
+      m_hooks(std::move(other.m_hooks)),
+      m_eventBus(std::move(other.m_eventBus)),
+      m_events(std::move(other.m_events)),
+      m_behaviors(std::move(other.m_behaviors)),
+      m_instances(std::move(other.m_instances)),
+      m_zoneRooms(std::move(other.m_zoneRooms)),
+      m_instanceBase(other.m_instanceBase),
+      m_instanceStats(other.m_instanceStats),
+      m_commandSnapshot(), // Commands are re-registered by initialize(), with their text
+      m_commands(&m_commandMemory), // Initialize empty map
+      m_commandGeneration(other.m_commandGeneration + 1), // Invalidate handles resolved on other
+      m_aliases(), // Registered again with the commands
+      m_commandNames(), // Refilled as initialize() registers commands
+      m_playerNames(std::move(other.m_playerNames)),
+      m_channels(std::move(other.m_channels)),
+      m_channelRelay(std::move(other.m_channelRelay)),
+      m_socials(std::move(other.m_socials)),
+      m_shard(other.m_shard),
+      m_scriptStore(std::move(other.m_scriptStore))
+#ifdef ENABLE_LUA_SCRIPTING
+    , m_scriptRunner(std::move(other.m_scriptRunner))
+    , m_scriptDir(std::move(other.m_scriptDir))
+    , m_scriptWatcher(std::move(other.m_scriptWatcher))
+    , m_scriptFiles(std::move(other.m_scriptFiles))
+    , m_scriptHooks(std::move(other.m_scriptHooks))
+#endif
 {
+    // The index's locks stay put, so it is filled again rather than moved
+    indexPlayers();
     // Command registration will be handled by initialize()
 }
 
 // Move assignment operator implementation
 GameEngine& GameEngine::operator=(GameEngine&& other) noexcept {
     if (this != &other) {
-        m_player = std::move(other.m_player);
-        m_hookSystem = std::move(other.m_hookSystem);
+        m_players = std::move(other.m_players);
+        m_outbox = std::move(other.m_outbox);
+        m_recipients = std::move(other.m_recipients);
+        m_listed = std::move(other.m_listed);
+        m_dirty = std::move(other.m_dirty);
+        m_world = std::move(other.m_world);
+        m_startRoom = other.m_startRoom;
+        m_entities = std::move(other.m_entities);
+        m_roomContents = std::move(other.m_roomContents);
+        m_items = std::move(other.m_items);
+        m_playerBodies = std::move(other.m_playerBodies);
+        m_area = std::move(other.m_area);
+        m_zoneLoaded = std::move(other.m_zoneLoaded);
+        m_areaPrototypes = std::move(other.m_areaPrototypes);
+        m_descriptions = std::move(other.m_descriptions);
+        m_instances = std::move(other.m_instances);
+        m_zoneRooms = std::move(other.m_zoneRooms);
+        m_instanceBase = other.m_instanceBase;
+        m_instanceStats = other.m_instanceStats;
+        m_ambience = std::move(other.m_ambience);
+        m_behaviors = std::move(other.m_behaviors);
+        m_localPlayer = other.m_localPlayer;
+        m_hooks = std::move(other.m_hooks);
+        m_playerNames = std::move(other.m_playerNames);
+        m_channels = std::move(other.m_channels);
+        m_channelRelay = std::move(other.m_channelRelay);
+        m_socials = std::move(other.m_socials);
+        m_shard = other.m_shard;
+        m_scriptStore = std::move(other.m_scriptStore);
+#ifdef ENABLE_LUA_SCRIPTING
+        m_scriptRunner = std::move(other.m_scriptRunner);
+        m_scriptDir = std::move(other.m_scriptDir);
+        m_scriptWatcher = std::move(other.m_scriptWatcher);
+        m_scriptFiles = std::move(other.m_scriptFiles);
+        m_scriptHooks = std::move(other.m_scriptHooks);
+#endif
         // Clear existing commands
         m_commands.clear();
+        m_commandNames.clear();
+        m_aliases.clear();
+        ++m_commandGeneration;
+        m_commandSnapshot.publish(std::make_unique<CommandSnapshot>());
+        // Rendered from other's rooms and entities
+        m_roomViews.clear();
+        indexPlayers();
         // Command registration will be handled by initialize()
     }
     return *this;
 }
 
-void GameEngine::registerCommands() {
-    // Get a shared pointer to this instance for safe capturing
-    auto self = shared_from_this();
+// Build the default world map
+void GameEngine::buildWorld() {
+    m_startRoom = m_world.addRoom("Start Room",
+        "This is the starting area, a simple room with stone walls and a wooden floor. "
+        "There's a door leading north and a small window on the east wall.");
+    
+    RoomId northRoom = m_world.addRoom("North Room",
+        "This is a larger chamber with a high ceiling. Dusty tapestries hang on the walls, "
+        "and there's an old desk in the corner. The exit to the south leads back to the starting room.", 1);
+    
+    m_world.linkBoth(m_startRoom, Direction::North, northRoom);
+    
+    if (const ItemPrototype* lantern = defineItem({"lantern", "A battered brass lantern, long since out of oil."})) {
+        spawnItem(*lantern, northRoom);
+    }
+    spawnNpc("rat", northRoom);
+    m_ambience.addLine(1, "The tapestries stir in a draught you cannot feel.");
+    m_ambience.addLine(1, "Somewhere behind the desk, something small scratches at the floor.");
+}
 
-    // Register the 'say' command directly
-    m_commands["say"] = {
-        .name = "say",
-        .help = "say <message>",
-        .description = "Speak aloud in the room for others to hear.",
-        .handler = [](GameEnginePtr engine, std::string_view args) -> CommandResult {
-            try {
-                return CommandResult::success(std::format("You say: '{}'", args));
-            } catch (const std::exception& e) {
-                return CommandResult::error(std::format("Error processing say command: {}", e.what()));
+// Take the map from an area file, leaving its zones' contents for loadZone
+void GameEngine::loadArea(AreaFile area) {
+    // The exits and zones are walked on every move, so they are copied; the
+    // names and descriptions stay in the mapping, which the graph keeps
+    // alive, and are only paged in when someone reads them. Packed
+    // descriptions are left out of the graph, and unpacked by
+    // m_descriptions as rooms are looked at
+    const std::span<const AreaRoomText> text = area.roomText();
+    const std::span<const ZoneId> zones = area.roomZones();
+    const std::span<const std::uint8_t> packed = area.packedRooms();
+    m_prefetcher.reset();   // It reads the area and descriptions being replaced
+    std::vector<std::string_view> frames(packed.size());
+    m_world.reserve(area.roomCount());
+    m_world.keepAlive(area.mapping());
+    m_world.setNameIndex(area.nameIndex());
+    for (std::size_t room = 0; room < area.roomCount(); ++room) {
+        std::string_view description = area.string(text[room].description);
+        if (!packed.empty() && packed[room]) {
+            frames[room] = std::exchange(description, std::string_view{});
+        }
+        m_world.addRoomView(area.string(text[room].name), description, zones[room]);
+    }
+    m_descriptions.reset();
+    if (!packed.empty()) {
+        m_descriptions = std::make_unique<DescriptionStore>(area.dictionary(), std::move(frames),
+                                                            area.header().packedTextSize);
+        if (!m_descriptions->valid()) {
+            LOG_ERROR("The area's description dictionary is damaged; packed rooms will go undescribed");
+        }
+    }
+    const std::span<const RoomGraph::ExitArray> exits = area.exits();
+    for (RoomId room = 0; room < exits.size(); ++room) {
+        for (std::size_t dir = 0; dir < kDirectionCount; ++dir) {
+            if (exits[room][dir] != kInvalidRoomId) {
+                m_world.link(room, static_cast<Direction>(dir), exits[room][dir]);
             }
         }
-    };
+    }
+    m_startRoom = area.header().startRoom;
     
-    // Register the 'look' command
-    m_commands["look"] = {
-        .name = "look",
-        .help = "look",
-        .description = "Look around and examine your surroundings.",
-        .handler = [](GameEnginePtr engine, std::string_view /*args*/) -> CommandResult {
-            try {
-                // Get current room name
-                const std::string& roomName = engine->m_player.currentRoom.empty() ? 
-                    "an unknown location" : engine->m_player.currentRoom;
-                
-                // Build response using string formatting
-                std::string response = std::format("You are in: {}\n\n", roomName);
-                
-                // Add room-specific description
-                if (engine->m_player.currentRoom == "Start Room") {
-                    response += "This is the starting area, a simple room with stone walls and a wooden floor. "
-                               "There's a door leading north and a small window on the east wall.";
-                }
-                else if (engine->m_player.currentRoom == "North Room") {
-                    response += "This is a larger chamber with a high ceiling. Dusty tapestries hang on the walls, "
-                               "and there's an old desk in the corner. The exit to the south leads back to the starting room.";
-                }
-                else {
-                    response += "This area has not been fully explored yet. There are exits in various directions.";
-                }
-                
-                return CommandResult::success(response);
-            } catch (...) {
-                return CommandResult::error("Critical error processing look command.");
-            }
+    // Prototypes are few and items point at them, so they are defined now
+    m_areaPrototypes.reserve(area.prototypes().size());
+    for (const AreaPrototype& prototype : area.prototypes()) {
+        m_areaPrototypes.push_back(defineItem({std::string(area.string(prototype.name)),
+                                               std::string(area.string(prototype.description)),
+                                               prototype.decayTicks}));
+    }
+    m_zoneLoaded.assign(area.zoneCount(), 0);
+    m_zonePrefetched.assign(area.zoneCount(), 0);
+    m_area = std::move(area);
+    m_instances.clear();
+    m_zoneRooms.clear();
+    m_instanceBase = kInvalidRoomId;
+    setZonePrefetch(m_prefetchRooms);
+}
+
+void GameEngine::setZonePrefetch(unsigned rooms) {
+    m_prefetchRooms = rooms;
+    if (rooms == 0 || !m_area.valid()) {
+        m_prefetcher.reset();
+    } else if (!m_prefetcher) {
+        m_prefetcher = std::make_unique<ZonePrefetcher>(m_area, m_descriptions.get());
+    }
+}
+
+// Install the engine's built-in example hooks
+void GameEngine::registerDefaultHooks() {
+    // Example rule: block Kieran from going north. The name is matched once on
+    // join so the move hook itself only compares ids.
+    auto blockedPlayer = std::make_shared<PlayerId>(kInvalidPlayerId);
+    
+    m_hooks.addPlayerHook(HookEvent::PlayerJoin, [blockedPlayer](const PlayerEvent& event) {
+        if (event.name == "Kieran") {
+            *blockedPlayer = event.player;
         }
-    };
+        return HookDecision::Continue;
+    });
     
-    // Register the 'get' command
-    m_commands["get"] = {
-        .name = "get",
-        .help = "get <item>",
-        .description = "Pick up an item from the current room.",
-        .handler = [](GameEnginePtr engine, std::string_view args) -> CommandResult {
-            try {
-                return CommandResult::success(std::format("You pick up the '{}'.", args));
-            } catch (...) {
-                return CommandResult::error("Error processing get command.");
-            }
+    m_hooks.addPlayerHook(HookEvent::PlayerLeave, [blockedPlayer](const PlayerEvent& event) {
+        if (event.player == *blockedPlayer) {
+            *blockedPlayer = kInvalidPlayerId;
         }
+        return HookDecision::Continue;
+    });
+    
+    m_hooks.addMoveHook(HookPhase::Before, [blockedPlayer](const MoveEvent& event) {
+        return (event.player == *blockedPlayer && event.direction == Direction::North)
+            ? HookDecision::Block : HookDecision::Continue;
+    });
+}
+
+#ifdef ENABLE_LUA_SCRIPTING
+void GameEngine::registerScripts() {
+    // Get current directory
+    std::error_code ec;
+    auto currentPath = std::filesystem::current_path(ec);
+    if (ec) {
+        LOG_WARN("Error getting current path: {}", ec.message());
+    }
+    
+    // Multiple possible script paths to try
+    std::vector<std::filesystem::path> scriptPaths = {
+        m_scriptDir,                            // Current specified dir
+        "scripts",                              // Relative to working dir
+        currentPath / "scripts",                // Absolute path in working dir
+        std::filesystem::path("..") / "scripts" // Parent directory
     };
+
+    // Scripts see the game through native usertypes; bind before any script runs
+    m_scriptRunner->forEachState([this](sol::state& lua) {
+        registerGameBindings(lua, *this);
+    });
     
-    // Register the 'north' command
-    m_commands["north"] = {
-        .name = "north",
-        .help = "north",
-        .description = "Move to the north if possible.",
-        .handler = [](GameEnginePtr engine, std::string_view /*args*/) -> CommandResult {
-            try {
-                if (engine->m_hookSystem.beforeMove(engine->m_player.name, "north")) {
-                    return CommandResult::success("You feel a mysterious force preventing you from moving north.");
-                } else {
-                    // Check if movement is valid from current room
-                    if (engine->m_player.currentRoom == "Start Room") {
-                        // Update player's current room
-                        engine->m_player.currentRoom = "North Room";
-                        
-                        return CommandResult::success(std::format("You move north into {}.", engine->m_player.currentRoom));
-                    } else {
-                        return CommandResult::success("You can't go that way.");
-                    }
-                }
-            } catch (...) {
-                return CommandResult::error("Error processing north command.");
-            }
+    // Collect garbage in idle() slices rather than in the middle of commands
+    m_scriptRunner->setGcMode(ScriptRunner::GcMode::Scheduled);
+    
+    // Wake commands suspended in wait("move"), wait("join") or wait("leave").
+    // The pool only queues the event here; delivery happens in idle()
+    m_hooks.addMoveHook(HookPhase::After, [this](const MoveEvent&) {
+        m_scriptRunner->signal("move");
+        return HookDecision::Continue;
+    });
+    m_hooks.addPlayerHook(HookEvent::PlayerJoin, [this](const PlayerEvent&) {
+        m_scriptRunner->signal("join");
+        return HookDecision::Continue;
+    });
+    m_hooks.addPlayerHook(HookEvent::PlayerLeave, [this](const PlayerEvent&) {
+        m_scriptRunner->signal("leave");
+        return HookDecision::Continue;
+    });
+    
+    // Use the first candidate that is a directory and list it once; every
+    // *.lua file in it becomes a command named after the file
+    std::filesystem::path scriptDir;
+    for (const auto& basePath : scriptPaths) {
+        if (std::filesystem::is_directory(basePath, ec)) {
+            scriptDir = basePath;
+            break;
         }
+    }
+    if (scriptDir.empty()) {
+        LOG_WARN("Failed to find a scripts directory in any of the search paths");
+        return;
+    }
+    LOG_INFO("Loading scripts from: {}", scriptDir.string());
+    // Modules for require() sit in lib/, which the listing below doesn't enter
+    m_scriptRunner->setModuleRoot(scriptDir / "lib");
+    
+    struct ScriptFile {
+        std::string name;
+        std::filesystem::path path;
+        std::filesystem::file_time_type modified;
+        std::expected<std::string, ScriptRunner::ScriptError> bytecode;
+        bool lazy = false;
     };
+    std::vector<ScriptFile> scripts;
+    for (const auto& file : std::filesystem::directory_iterator(scriptDir, ec)) {
+        if (file.is_regular_file(ec) && file.path().extension() == ".lua") {
+            scripts.push_back({file.path().stem().string(), file.path(), file.last_write_time(ec), {}, false});
+        }
+    }
     
-    // Register the 'south' command
-    m_commands["south"] = {
-        .name = "south",
-        .help = "south",
-        .description = "Move to the south if possible.",
-        .handler = [](GameEnginePtr engine, std::string_view /*args*/) -> CommandResult {
-            try {
-                if (engine->m_hookSystem.beforeMove(engine->m_player.name, "south")) {
-                    return CommandResult::success("You feel a mysterious force preventing you from moving south.");
-                } else {
-                    // Check if movement is valid from current room
-                    if (engine->m_player.currentRoom == "North Room") {
-                        // Update player's current room
-                        engine->m_player.currentRoom = "Start Room";
-                        
-                        return CommandResult::success(std::format("You move south into {}.", engine->m_player.currentRoom));
-                    } else {
-                        return CommandResult::success("You can't go that way.");
-                    }
+    // Sorted so registration order (and therefore ScriptHandles) is stable across runs
+    std::sort(scripts.begin(), scripts.end(),
+              [](const ScriptFile& a, const ScriptFile& b) { return a.name < b.name; });
+    
+    // Read and compile in parallel, each worker in a Lua state of its own.
+    // Scripts whose header asks to be lazy are only read that far
+    const bool useCache = m_scriptRunner->bytecodeCacheEnabled();
+    const bool lazy = m_scriptRunner->lazyLoadingEnabled();
+    const std::size_t workerCount = std::min<std::size_t>(
+        scripts.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<std::size_t> nextScript{0};
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back([&]() {
+            sol::state compiler;
+            for (std::size_t index = nextScript++; index < scripts.size(); index = nextScript++) {
+                ScriptFile& script = scripts[index];
+                if (lazy && ScriptRunner::readHeader(script.path)) {
+                    script.lazy = true;
+                    continue;
                 }
-            } catch (...) {
-                return CommandResult::error("Error processing south command.");
+                script.bytecode = ScriptRunner::compileToBytecode(compiler, script.path, script.modified, useCache);
             }
-        }
-    };
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
     
-    // Register the 'east' command
-    m_commands["east"] = {
-        .name = "east",
-        .help = "east",
-        .description = "Move to the east if possible.",
-        .handler = [](GameEnginePtr engine, std::string_view /*args*/) -> CommandResult {
-            try {
-                if (engine->m_hookSystem.beforeMove(engine->m_player.name, "east")) {
-                    return CommandResult::success("You feel a mysterious force preventing you from moving east.");
-                } else {
-                    // No valid east paths in our simple demo
-                    return CommandResult::success("You can't go that way.");
-                }
-            } catch (...) {
-                return CommandResult::error("Error processing east command.");
+    // Registration touches the engine and the pool, so it stays on this thread
+    std::size_t deferred = 0;
+    for (auto& script : scripts) {
+        if (script.lazy) {
+            // Deferred in every state until its first call
+            deferred += loadScriptCommand(script.name, script.path) ? 1 : 0;
+            continue;
+        }
+        if (!script.bytecode) {
+            LOG_ERROR("Failed to compile script command '{}' from {}", script.name, script.path.string());
+            continue;
+        }
+        
+        auto handle = m_scriptRunner->loadCompiled(script.name, script.path, *script.bytecode, script.modified);
+        if (!handle) {
+            // e.g. cached bytecode this Lua build cannot load; fall back to the source
+            if (!loadScriptCommand(script.name, script.path)) {
+                LOG_ERROR("Failed to load script command '{}' from {}", script.name, script.path.string());
             }
+            continue;
         }
-    };
+        registerScriptCommand(script.name, *handle, script.path);
+    }
+    if (deferred != 0) {
+        LOG_INFO("Deferred {} of {} script commands until first use", deferred, scripts.size());
+    }
+    
+    // Report per-script CPU accounting
+    registerCommand({
+        .name = "scriptstats",
+        .help = "scriptstats - Show execution statistics for script commands",
+        .description = "Lists call counts, VM instructions and wall time spent in each script",
+        .handler = [](CommandContext& ctx, std::string_view) -> CommandResult {
+            return ctx.engine.handleScriptStatsCommand();
+        }
+    });
+    
+    // Sampled Lua stacks, for finding the slow functions
+    registerCommand({
+        .name = "luaprofile",
+        .help = "luaprofile [start [instructions]|stop|dump [file]]",
+        .description = "Sample the Lua call stacks, every 10000 instructions unless told otherwise, and write them "
+                       "out as folded stacks for a flame graph. Alone, shows whether it is running.",
+        .handler = [](CommandContext& ctx, std::string_view) -> CommandResult {
+            return ctx.engine.handleLuaProfileCommand(ctx.args[0].text, ctx.args[1].text);
+        },
+        .syntax = "action:word? argument:word?"
+    });
+    
+    // Watch the loaded scripts so edits are picked up without a restart
+    if (!m_scriptFiles.empty()) {
+        m_scriptWatcher = std::make_unique<ScriptWatcher>(m_scriptRunner->bytecodeCacheEnabled());
+        for (const auto& [file, cmdName] : m_scriptFiles) {
+            m_scriptWatcher->watch(file);
+        }
+        if (!m_scriptWatcher->start()) {
+            LOG_INFO("Script hot reload is not available on this platform");
+            m_scriptWatcher.reset();
+        }
+    }
+}
+
+bool GameEngine::loadScriptCommand(const std::string& name, const std::filesystem::path& scriptPath) {
+    // Try to load the script
+    auto handle = m_scriptRunner->loadScript(name, scriptPath);
+    if (!handle) {
+        LOG_ERROR("Failed to load script command '{}' from {}", 
+                  name, scriptPath.string());
+        return false;
+    }
+    
+    registerScriptCommand(name, *handle, scriptPath);
+    return true;
+}
+
+void GameEngine::registerScriptCommand(const std::string& name, ScriptHandle handle, const std::filesystem::path& scriptPath) {
+    // Get help and description from the script
+    auto helpResult = m_scriptRunner->getHelp(name);
+    auto descResult = m_scriptRunner->getDescription(name);
+    
+    auto syntaxResult = m_scriptRunner->getSyntax(name);
+    
+    std::string help = helpResult ? helpResult.value() : name;
+    std::string desc = descResult ? descResult.value() : "Script command";
+    
+    // Register the command
+    const bool registered = registerCommand({
+        .name = name,
+        .help = help,
+        .description = desc,
+        .handler = [script = handle](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleScriptCommand(ctx.player, script, ctx.args, ctx.metrics);
+        },
+        .syntax = syntaxResult ? std::move(*syntaxResult) : std::string()
+    });
+    if (!registered) {
+        LOG_ERROR("Script command '{}' declares a malformed syntax", name);
+        return;
+    }
+    
+    registerScriptHooks(name);
+    m_scriptFiles.insert_or_assign(ScriptWatcher::normalize(scriptPath).string(), name);
     
-    // Register the 'west' command
-    m_commands["west"] = {
-        .name = "west",
-        .help = "west",
-        .description = "Move to the west if possible.",
-        .handler = [](GameEnginePtr engine, std::string_view /*args*/) -> CommandResult {
-            try {
-                if (engine->m_hookSystem.beforeMove(engine->m_player.name, "west")) {
-                    return CommandResult::success("You feel a mysterious force preventing you from moving west.");
-                } else {
-                    // No valid west paths in our simple demo
-                    return CommandResult::success("You can't go that way.");
+    LOG_DEBUG("Successfully registered script command '{}'", name);
+}
+
+void GameEngine::registerScriptHooks(const std::string& name) {
+    // Drop hooks from a previous version of this script
+    auto& hookIds = m_scriptHooks[name];
+    for (HookId id : hookIds) {
+        m_hooks.remove(id);
+    }
+    hookIds.clear();
+    
+    // Scripts may also define optional hooks; returning false from a before hook blocks the event
+    if (m_scriptRunner->hasHook(name, "before_command")) {
+        hookIds.push_back(m_hooks.addCommandHook(HookPhase::Before, [this, name](const CommandEvent& event) {
+            auto allowed = m_scriptRunner->runHook(name, "before_command", event.command, event.args);
+            return (allowed && !*allowed) ? HookDecision::Block : HookDecision::Continue;
+        }));
+    }
+    if (m_scriptRunner->hasHook(name, "after_command")) {
+        hookIds.push_back(m_hooks.addCommandHook(HookPhase::After, [this, name](const CommandEvent& event) {
+            m_scriptRunner->runHook(name, "after_command", event.command, event.args);
+            return HookDecision::Continue;
+        }));
+    }
+    if (m_scriptRunner->hasHook(name, "before_move")) {
+        hookIds.push_back(m_hooks.addMoveHook(HookPhase::Before, [this, name](const MoveEvent& event) {
+            auto allowed = m_scriptRunner->runHook(name, "before_move", directionName(event.direction), m_world.name(event.to));
+            return (allowed && !*allowed) ? HookDecision::Block : HookDecision::Continue;
+        }));
+    }
+    
+    // Tick handlers need a tick to run in, so the scheduler only keeps one
+    // while some script has them
+    const bool ticking = m_scriptRunner->subscribed(ScriptEvent::Tick);
+    if (ticking && m_scriptTickUpdate == kInvalidTickUpdateId) {
+        m_scriptTickUpdate = m_ticks.addUpdate(1, [this](std::uint64_t tick) { m_scriptRunner->emitTick(tick); });
+    } else if (!ticking && m_scriptTickUpdate != kInvalidTickUpdateId) {
+        m_ticks.removeUpdate(std::exchange(m_scriptTickUpdate, kInvalidTickUpdateId));
+    }
+}
+
+void GameEngine::applyScriptReloads() {
+    // One atomic load per command when nothing has changed
+    if (!m_scriptWatcher || !m_scriptWatcher->hasPending()) {
+        return;
+    }
+    
+    for (auto& compiled : m_scriptWatcher->takeCompiled()) {
+        auto file = m_scriptFiles.find(compiled.path.string());
+        if (file == m_scriptFiles.end()) {
+            continue;
+        }
+        const std::string& name = file->second;
+        
+        // The handle is reused, so the registered command keeps working; only
+        // its help text and the script's hooks need refreshing
+        auto handle = m_scriptRunner->loadCompiled(name, compiled.path, compiled.bytecode, compiled.modified);
+        if (!handle) {
+            LOG_ERROR("Failed to reload script command '{}'", name);
+            continue;
+        }
+        
+        std::optional<CommandId> id;
+        if (auto cmd = findBuiltinCommand(name)) {
+            id = static_cast<CommandId>(*cmd);
+        } else if (auto it = m_commands.find(StringInterner::global().find(name)); it != m_commands.end()) {
+            id = it->second;
+        }
+        // Published entries never change: the new text, and the entry when
+        // the syntax changed, go into copies that the next snapshot shares
+        CommandSnapshot next = copyCommands();
+        if (id && next.entries[*id] && next.entries[*id]->handler) {
+            CommandText text = *next.text[*id];
+            if (auto help = m_scriptRunner->getHelp(name)) {
+                text.help = std::move(*help);
+            }
+            if (auto desc = m_scriptRunner->getDescription(name)) {
+                text.description = std::move(*desc);
+            }
+            // A malformed new syntax keeps the old one
+            if (auto syntax = m_scriptRunner->getSyntax(name); syntax && *syntax != text.syntax) {
+                if (auto arguments = compileSyntax(name, *syntax)) {
+                    CommandEntry entry = *next.entries[*id];
+                    entry.arguments = std::move(*arguments);
+                    next.entries[*id] = std::make_shared<const CommandEntry>(std::move(entry));
+                    text.syntax = std::move(*syntax);
                 }
-            } catch (...) {
-                return CommandResult::error("Error processing west command.");
             }
+            next.text[*id] = std::make_shared<const CommandText>(std::move(text));
+            publishCommands(std::move(next));
         }
-    };
+        registerScriptHooks(name);
+        
+        LOG_INFO("Reloaded script command '{}'", name);
+    }
+}
+
+// What a player is told when their script command fails
+static std::string scriptErrorMessage(ScriptRunner::ScriptError error) {
+    if (error == ScriptRunner::ScriptError::BudgetExceeded) {
+        return "The script took too long and was stopped.";
+    }
+    return std::format("Script error: {}", static_cast<int>(error));
+}
+
+CommandResult GameEngine::handleScriptCommand(PlayerId player, ScriptHandle script, const CommandArgs& args,
+                                              CommandMetrics* metrics) {
+    // The script writes its output directly into the result message, so the
+    // arguments and output are each copied at most once. A script that calls
+    // wait() returns no output here; the rest arrives through idle()
+    CommandResult output = CommandResult::success(std::string());
+    const ScriptPlayer caller{this, player};
+    TRACE_EVENT("script {} for player {}", script, player);
+    const auto started = std::chrono::steady_clock::now();
+    auto result = m_scriptRunner->run(script, args.raw(), output.message, &caller, args.empty() ? nullptr : &args);
+    if (metrics) {
+        metrics->script.record(std::chrono::steady_clock::now() - started);
+    }
+    TRACE_EVENT("script {} for player {} returned {}", script, player, result ? 0 : static_cast<int>(result.error()));
+    if (!result) {
+        return CommandResult::error(scriptErrorMessage(result.error()));
+    }
     
-    // Register the 'exit' command
-    m_commands["exit"] = {
-        .name = "exit",
-        .help = "exit",
-        .description = "Exit the game.",
-        .handler = [](GameEnginePtr /*engine*/, std::string_view /*args*/) -> CommandResult {
-            return CommandResult::success("Exiting game...");
-        }
-    };
+    return output;
+}
+
+CommandResult GameEngine::handleScriptStatsCommand() {
+    auto stats = m_scriptRunner->stats();
+    if (stats.empty()) {
+        return CommandResult::success("No scripts are loaded.");
+    }
     
-    // Register the 'quit' command (alias for exit)
-    m_commands["quit"] = {
-        .name = "quit",
-        .help = "quit",
-        .description = "Exit the game.",
-        .handler = [](GameEnginePtr /*engine*/, std::string_view /*args*/) -> CommandResult {
-            return CommandResult::success("Exiting game...");
+    // Most expensive first
+    std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+        return a.second.wallTime > b.second.wallTime;
+    });
+    
+    std::string output = std::format("{:<16}{:>10}{:>16}{:>12}{:>12}{:>8}\n", 
+        "Script", "Calls", "Instructions", "Total ms", "Avg ms", "Over");
+    for (const auto& [name, stat] : stats) {
+        const double totalMs = std::chrono::duration<double, std::milli>(stat.wallTime).count();
+        const double avgMs = stat.calls ? totalMs / static_cast<double>(stat.calls) : 0.0;
+        output += std::format("{:<16}{:>10}{:>16}{:>12.3f}{:>12.3f}{:>8}\n", 
+            name, stat.calls, stat.instructions, totalMs, avgMs, stat.budgetExceeded);
+    }
+    output += std::format("Instruction budget per call: {}\n", 
+        m_scriptRunner->instructionBudget());
+    
+    const auto memory = m_scriptRunner->memoryStats();
+    output += std::format("Lua memory: {} KiB live, {} KiB peak across {} states", 
+        memory.liveBytes / 1024, memory.peakBytes / 1024, m_scriptRunner->size());
+    if (memory.limitBytes != 0) {
+        output += std::format(" (limit {} KiB)", memory.limitBytes / 1024);
+    }
+    
+    const auto gc = m_scriptRunner->gcStats();
+    const double totalPauseMs = std::chrono::duration<double, std::milli>(gc.totalPause).count();
+    output += std::format("\nLua GC: {} cycles in {} idle slices, {:.3f} ms total, {:.3f} ms max pause", 
+        gc.cycles, gc.slices, totalPauseMs, std::chrono::duration<double, std::milli>(gc.maxPause).count());
+    output += std::format("\nSuspended script calls: {}", m_scriptRunner->suspendedTasks());
+    const auto modules = ScriptModuleCache::global().stats();
+    output += std::format("\nCompiled modules: {} ({} KiB), {} compiles, {} loads from memory",
+        modules.modules, modules.bytes / 1024, modules.compiles, modules.hits);
+    return CommandResult::success(output);
+}
+
+CommandResult GameEngine::handleLuaProfileCommand(std::string_view action, std::string_view argument) {
+    constexpr std::uint32_t kDefaultInstructions = 10'000;
+    constexpr std::string_view kDefaultFile = "luaprofile.folded";
+    if (action == "start") {
+        std::uint32_t instructions = kDefaultInstructions;
+        if (!argument.empty() && (std::from_chars(argument.data(), argument.data() + argument.size(), instructions).ec
+                                      != std::errc() || instructions == 0)) {
+            return CommandResult::error(Message<"'{}' is not a number of instructions.">::reply(argument));
         }
-    };
+        // Samples are taken at the count hook, so the period is in its steps
+        const std::uint32_t period =
+            std::max<std::uint32_t>(1, instructions / ScriptRunner::kInstructionHookInterval);
+        m_scriptRunner->startProfiling(period);
+        return CommandResult::success(std::format("Sampling Lua stacks every {} instructions in {} states.",
+                                                  period * ScriptRunner::kInstructionHookInterval,
+                                                  m_scriptRunner->size()));
+    }
+    if (action == "stop") {
+        m_scriptRunner->stopProfiling();
+    } else if (action == "dump") {
+        FoldedStacks stacks;
+        const ScriptProfileTotals totals = m_scriptRunner->foldProfiles(stacks);
+        const std::filesystem::path file = argument.empty() ? kDefaultFile : argument;
+        if (!mapped::replaceFile(file, ScriptProfiler::render(stacks))) {
+            return CommandResult::error(std::format("Couldn't write {}.", file.string()));
+        }
+        return CommandResult::success(std::format("Wrote {} stacks from {} samples to {}; flamegraph.pl {} > lua.svg "
+                                                  "draws them.", stacks.size(), totals.samples, file.string(),
+                                                  file.string()));
+    } else if (!action.empty()) {
+        return CommandResult::error("Usage: luaprofile [start [instructions]|stop|dump [file]]");
+    }
+    FoldedStacks stacks;
+    const ScriptProfileTotals totals = m_scriptRunner->foldProfiles(stacks);
+    return CommandResult::success(std::format("Lua profiling is {}: {} samples, {} distinct stacks, {} dropped.",
+                                              totals.running ? "running" : "stopped", totals.samples, stacks.size(),
+                                              totals.dropped));
+}
+#endif
+
+std::optional<ArgumentSchema> GameEngine::compileSyntax(std::string_view name, std::string_view syntax) {
+    auto schema = ArgumentSchema::compile(syntax);
+    if (!schema) {
+        LOG_ERROR("Bad syntax for command '{}': {}", name, schema.error());
+        return std::nullopt;
+    }
+    return std::move(*schema);
+}
+
+CommandSnapshot GameEngine::copyCommands() const {
+    // The game thread is the only writer, so the current snapshot cannot
+    // be retired while it is copied
+    const CommandSnapshot& current = commands();
+    CommandSnapshot next;
+    next.entries = current.entries;
+    next.text = current.text;
+    next.entries.resize(std::max<std::size_t>(next.entries.size(), kBuiltinCommandCount));
+    next.text.resize(next.entries.size());
+    return next;
+}
+
+// Fill slot id of the next snapshot: the dispatch record, and the text beside it
+void GameEngine::storeCommand(CommandSnapshot& next, CommandId id, CommandSpec&& spec, ArgumentSchema&& arguments) {
+    if (!m_commandNames.contains(spec.name)) {
+        m_commandNames.insert(spec.name);
+    }
+    if (next.entries.size() <= id) {
+        next.entries.resize(id + 1);
+        next.text.resize(id + 1);
+    }
+    next.entries[id] = std::make_shared<const CommandEntry>(CommandEntry{
+        .handler = std::move(spec.handler),
+        .arguments = std::move(arguments),
+        .metrics = &metricsFor(spec.name),
+        .symbol = StringInterner::global().intern(spec.name),
+        .id = id,
+        .lag = spec.lag,
+        .abbreviate = spec.abbreviate,
+        .zoneLocal = spec.zoneLocal,
+        .priority = spec.priority
+    });
+    next.text[id] = std::make_shared<const CommandText>(
+        CommandText{std::move(spec.help), std::move(spec.description), std::move(spec.syntax)});
+}
+
+// Index the next snapshot and swap it in; readers still holding the old one
+// keep it until their guards are gone
+void GameEngine::publishCommands(CommandSnapshot&& next) {
+    std::vector<CommandIndex::Command> index;
+    index.reserve(next.entries.size());
+    for (const auto& entry : next.entries) {
+        if (entry && entry->handler) {
+            index.push_back({entry->name(), entry.get(), entry->abbreviate});
+        }
+    }
+    next.index.rebuild(std::move(index), m_aliases);
+    // Invalidate any handles that might refer to a replaced entry
+    next.generation = ++m_commandGeneration;
+    m_commandSnapshot.publish(std::make_unique<CommandSnapshot>(std::move(next)));
+    rebuildHelpIndex();
+}
+
+bool GameEngine::registerCommand(CommandSpec spec) {
+    auto arguments = compileSyntax(spec.name, spec.syntax);
+    if (!arguments) {
+        return false;
+    }
     
-    // Register the 'help' command
-    m_commands["help"] = {
-        .name = "help",
-        .help = "help [command]",
-        .description = "Display help for all commands or a specific command.",
-        .handler = [](GameEnginePtr engine, std::string_view args) -> CommandResult {
-            return engine->handleHelpCommand(args);
+    // Built-in names keep their fixed slot so lookups stay on the perfect-hash
+    // path; a runtime name keeps the slot it was first given
+    CommandId id = 0;
+    if (auto cmd = findBuiltinCommand(spec.name)) {
+        id = static_cast<CommandId>(*cmd);
+    } else {
+        const Symbol name = StringInterner::global().intern(spec.name);
+        // The map holds one slot per runtime command, so its size is the next free one
+        const auto [slot, added] = m_commands.try_emplace(
+            name, static_cast<CommandId>(kBuiltinCommandCount + m_commands.size()));
+        id = slot->second;
+    }
+    CommandSnapshot next = copyCommands();
+    storeCommand(next, id, std::move(spec), std::move(*arguments));
+    publishCommands(std::move(next));
+    return true;
+}
+
+const CommandEntry* GameEngine::findCommand(std::string_view cmd) const {
+    // Names, aliases and abbreviations all resolve through the one flat table
+    const CommandSnapshot& snapshot = commands();
+    if (const CommandEntry* found = snapshot.index.find(cmd)) {
+        return found;
+    }
+    // Socials aren't in it; they go to the command that acts them out
+    return m_socials.find(cmd) ? snapshot.index.find("socials") : nullptr;
+}
+
+void GameEngine::registerAlias(std::string alias, std::string command) {
+    if (alias.size() > 1 && !m_commandNames.contains(alias)) {
+        m_commandNames.insert(alias);
+    }
+    
+    auto it = std::find_if(m_aliases.begin(), m_aliases.end(), [&](const auto& entry) { return entry.first == alias; });
+    if (it != m_aliases.end()) {
+        it->second = std::move(command);
+    } else {
+        m_aliases.emplace_back(std::move(alias), std::move(command));
+    }
+    rebuildCommandIndex();
+}
+
+CommandMetrics& GameEngine::metricsFor(std::string_view name) {
+    const std::lock_guard<std::mutex> lock(m_commandMetricsMutex);
+    auto found = m_commandMetrics.find(name);
+    if (found == m_commandMetrics.end()) {
+        found = m_commandMetrics.emplace(std::string(name), std::make_unique<CommandMetrics>()).first;
+    }
+    return *found->second;
+}
+
+std::string GameEngine::commandStatsReport(std::string_view command) const {
+    const std::lock_guard<std::mutex> lock(m_commandMetricsMutex);
+    std::vector<std::pair<std::string_view, const CommandMetrics*>> rows;
+    for (const auto& [name, metrics] : m_commandMetrics) {
+        if (metrics->calls.load(std::memory_order_relaxed) > 0 && (command.empty() || name == command)) {
+            rows.emplace_back(name, metrics.get());
         }
-    };
+    }
+    if (rows.empty()) {
+        return command.empty() ? std::string("No commands have run yet.")
+                               : std::format("'{}' has not run yet.", command);
+    }
+    
+    // Busiest first
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second->calls.load(std::memory_order_relaxed) > b.second->calls.load(std::memory_order_relaxed);
+    });
+    
+    const auto us = [](std::chrono::nanoseconds time) { return static_cast<double>(time.count()) / 1000.0; };
+    std::string output = std::format("{:<12}{:>9}{:>8}{:>8}{:>10}{:>10}{:>10}{:>10}{:>10}{:>10}{:>10}\n",
+        "Command", "Calls", "Errors", "Blocked", "p50 us", "p90 us", "p99 us", "Max us",
+        "Hooks p99", "Run p99", "Lua p99");
+    for (const auto& [name, metrics] : rows) {
+        const LatencyHistogram& total = metrics->dispatch;
+        output += std::format("{:<12}{:>9}{:>8}{:>8}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}\n",
+            name, metrics->calls.load(std::memory_order_relaxed), metrics->errors.load(std::memory_order_relaxed),
+            metrics->blocked.load(std::memory_order_relaxed), us(total.percentile(0.5)), us(total.percentile(0.9)),
+            us(total.percentile(0.99)), us(total.max()), us(metrics->hooks.percentile(0.99)),
+            us(metrics->handler.percentile(0.99)), us(metrics->script.percentile(0.99)));
+    }
+    output += "Dispatch covers hooks, argument matching and the handler; Run is the handler alone.";
+    return output;
 }
 
-CommandResult GameEngine::handleHelpCommand(std::string_view args) {
-    try {
-        // Use std::string instead of fixed buffer
-        std::string helpText;
-        
-        if (args.empty()) {
-            // List all commands with their help strings
-            helpText = "Available commands:\n";
-            
-            // Add each command
-            for (const auto& [cmdName, entry] : m_commands) {
-                helpText += std::format("  {} - {}\n", cmdName, entry.description);
-            }
-            
-            return CommandResult::success(helpText);
-        } else {
-            // Convert string_view to string for map lookup
-            std::string argStr{args};
-            
-            // Show detailed help for a specific command
-            auto cmdIt = m_commands.find(argStr);
-            if (cmdIt != m_commands.end()) {
-                const auto& entry = cmdIt->second;
-                
-                // Build help text using string formatting
-                std::string detailedHelp = std::format(
-                    "{} - {}\nUsage: {}\n{}", 
-                    entry.name, entry.help, entry.help, entry.description
-                );
-                
-                return CommandResult::success(detailedHelp);
-            } else {
-                return CommandResult::error(std::format("Unknown command: '{}'. Type 'help' for a list of commands.", args));
+std::string GameEngine::counterStatsReport() const {
+    std::vector<std::pair<std::string_view, const PerfTotals*>> rows;
+    {
+        const std::lock_guard<std::mutex> lock(m_commandMetricsMutex);
+        for (const auto& [name, metrics] : m_commandMetrics) {
+            if (metrics->counters.samples() > 0) {
+                rows.emplace_back(name, &metrics->counters);
             }
         }
-    } catch (...) {
-        return CommandResult::error("Error processing help command");
     }
+    // Most cycles in all first, as that is where a layout change pays
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second->sum()[PerfEvent::Cycles] > b.second->sum()[PerfEvent::Cycles];
+    });
+    rows.emplace_back("tick:update", &m_ticks.updateCounters());
+    rows.emplace_back("tick:command", &m_ticks.commandCounters());
+    const bool counted = std::any_of(rows.begin(), rows.end(), [](const auto& row) { return row.second->samples() > 0; });
+    if (!counted) {
+        return PerfCounters::enabled() ? std::string("Nothing has been counted yet.")
+                                       : std::string("Hardware counters are off; start the server with --perf-counters.");
+    }
+    
+    std::string output = std::format("{:<14}{:>9}{:>12}{:>12}{:>7}{:>12}{:>12}\n",
+        "Command", "Samples", "Cycles", "Instrs", "IPC", "LLC misses", "Br misses");
+    for (const auto& [name, totals] : rows) {
+        const std::uint64_t samples = totals->samples();
+        if (samples == 0) {
+            continue;
+        }
+        const PerfSample sum = totals->sum();
+        const auto each = [samples](std::uint64_t value) { return static_cast<double>(value) / static_cast<double>(samples); };
+        const double ipc = sum[PerfEvent::Cycles] == 0 ? 0.0
+            : static_cast<double>(sum[PerfEvent::Instructions]) / static_cast<double>(sum[PerfEvent::Cycles]);
+        output += std::format("{:<14}{:>9}{:>12.0f}{:>12.0f}{:>7.2f}{:>12.1f}{:>12.1f}\n",
+            name, samples, each(sum[PerfEvent::Cycles]), each(sum[PerfEvent::Instructions]), ipc,
+            each(sum[PerfEvent::CacheMisses]), each(sum[PerfEvent::BranchMisses]));
+    }
+    output += "Per sample, user space only; a sample is one dispatch, or one tick's updates or commands.";
+    return output;
 }
 
-CommandResult GameEngine::handleCommand(std::string_view cmd, std::string_view args) {
-    try {
-        // Convert string_view to string for map lookup
-        std::string cmdStr{cmd};
-        
-        // Look up the command in the registry
-        auto cmdIt = m_commands.find(cmdStr);
-        
-        if (cmdIt != m_commands.end()) {
-            // Execute the command handler with try/catch for safety
-            try {
-                return cmdIt->second.handler(shared_from_this(), args);
-            } catch (...) {
-                return CommandResult::error(std::format("Error executing command '{}'", cmd));
-            }
-        } else {
-            return CommandResult::error(std::format("Unknown command: '{}'. Type 'help' for a list of commands.", cmd));
+std::string GameEngine::memoryStatsReport() {
+    const std::lock_guard<std::mutex> lock(m_memoryStatsMutex);
+    const auto now = std::chrono::steady_clock::now();
+    const double seconds = std::max(std::chrono::duration<double>(now - m_memoryStatsTime).count(), 1e-6);
+    const auto kib = [](std::uint64_t bytes) { return static_cast<double>(bytes) / 1024.0; };
+    
+    std::string output = std::format("{:<12}{:>12}{:>12}{:>12}{:>12}{:>12}\n",
+        "Subsystem", "Live KiB", "Peak KiB", "Allocs", "Allocs/s", "KiB/s");
+    MemoryTagStats total;
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+        const auto tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = MemoryAccounting::stats(tag);
+        const MemoryTagStats& seen = m_memoryStatsSeen[i];
+        output += std::format("{:<12}{:>12.1f}{:>12.1f}{:>12}{:>12.1f}{:>12.1f}\n",
+            MemoryAccounting::name(tag), kib(stats.liveBytes), kib(stats.peakBytes), stats.allocations,
+            static_cast<double>(stats.allocations - seen.allocations) / seconds,
+            kib(stats.allocatedBytes - seen.allocatedBytes) / seconds);
+        total.liveBytes += stats.liveBytes;
+        total.allocations += stats.allocations;
+        m_memoryStatsSeen[i] = stats;
+    }
+    output += std::format("{} KiB live over {} allocations; rates are since the last report, {:.1f} s ago.",
+        static_cast<std::uint64_t>(kib(total.liveBytes)), total.allocations, seconds);
+    // Packed descriptions live in the mapping rather than on the heap
+    if (const DescriptionStats packed = descriptionStats(); packed.packed > 0) {
+        const std::uint64_t reads = packed.hits + packed.misses;
+        const double perUnpack = packed.misses > 0 ? std::chrono::duration<double, std::micro>(packed.unpackTime).count()
+                                                         / static_cast<double>(packed.misses)
+                                                   : 0.0;
+        output += std::format("\nRoom descriptions: {} packed, {:.1f} KiB of text in {:.1f} KiB with the dictionary "
+                              "({:.1f} KiB saved); {:.1f} KiB hot in {} entries, {:.1f}% of reads hit, "
+                              "{:.1f} us per unpack.",
+            packed.packed, kib(packed.textBytes), kib(packed.packedBytes),
+            kib(packed.textBytes) - kib(packed.packedBytes), kib(packed.hotBytes), packed.hotEntries,
+            reads > 0 ? 100.0 * static_cast<double>(packed.hits) / static_cast<double>(reads) : 0.0, perUnpack);
+    }
+    if (HugePages::mode() != HugePageMode::Off) {
+        output += "\n" + HugePages::report() + ".";
+    }
+    m_memoryStatsTime = now;
+    return output;
+}
+
+void GameEngine::resetCommandStats() {
+    const std::lock_guard<std::mutex> lock(m_commandMetricsMutex);
+    for (const auto& [name, metrics] : m_commandMetrics) {
+        metrics->calls.store(0, std::memory_order_relaxed);
+        metrics->errors.store(0, std::memory_order_relaxed);
+        metrics->blocked.store(0, std::memory_order_relaxed);
+        metrics->dispatch.reset();
+        metrics->hooks.reset();
+        metrics->handler.reset();
+        metrics->script.reset();
+        metrics->counters.reset();
+    }
+    m_ticks.resetCounters();
+}
+
+void GameEngine::writeCommandMetrics(std::string& out) const {
+    const std::lock_guard<std::mutex> lock(m_commandMetricsMutex);
+    Metrics::family(out, "echomud_commands", "counter", "Commands dispatched");
+    for (const auto& [name, metrics] : m_commandMetrics) {
+        Metrics::sample(out, "echomud_commands_total", Metrics::label("command", name),
+                        static_cast<double>(metrics->calls.load(std::memory_order_relaxed)));
+    }
+    Metrics::family(out, "echomud_command_errors", "counter", "Commands that ended in an error");
+    for (const auto& [name, metrics] : m_commandMetrics) {
+        Metrics::sample(out, "echomud_command_errors_total", Metrics::label("command", name),
+                        static_cast<double>(metrics->errors.load(std::memory_order_relaxed)));
+    }
+    Metrics::family(out, "echomud_command_duration_seconds", "summary",
+                    "Time to dispatch a command: hooks, arguments and handler");
+    for (const auto& [name, metrics] : m_commandMetrics) {
+        if (metrics->dispatch.count() > 0) {
+            Metrics::summary(out, "echomud_command_duration_seconds", Metrics::label("command", name),
+                             metrics->dispatch);
+        }
+    }
+    Metrics::family(out, "echomud_command_lua_seconds", "summary", "Time script commands spend in Lua");
+    for (const auto& [name, metrics] : m_commandMetrics) {
+        if (metrics->script.count() > 0) {
+            Metrics::summary(out, "echomud_command_lua_seconds", Metrics::label("command", name), metrics->script);
         }
-    } catch (...) {
-        return CommandResult::error("Error processing command");
     }
 }
 
-bool GameEngine::shouldQuit(std::string_view cmd, std::string_view args) {
-    // Check for exit/quit commands directly
-    if (cmd == "exit" || cmd == "quit") {
-        return true;
+void GameEngine::writeZoneMetrics(std::string& out) const {
+    const std::lock_guard<std::mutex> lock(m_repopStatsMutex);
+    Metrics::family(out, "echomud_zone_repop_spawned", "counter", "NPCs and items an area zone's records spawned");
+    for (std::size_t zone = 0; zone < m_repopStats.size(); ++zone) {
+        if (m_repopStats[zone].slices > 0) {
+            Metrics::sample(out, "echomud_zone_repop_spawned_total", Metrics::label("zone", std::to_string(zone)),
+                            static_cast<double>(m_repopStats[zone].spawned));
+        }
+    }
+    Metrics::family(out, "echomud_zone_repop_seconds", "counter", "Tick time spent spawning an area zone's records");
+    for (std::size_t zone = 0; zone < m_repopStats.size(); ++zone) {
+        if (m_repopStats[zone].slices > 0) {
+            Metrics::sample(out, "echomud_zone_repop_seconds_total", Metrics::label("zone", std::to_string(zone)),
+                            std::chrono::duration<double>(m_repopStats[zone].time).count());
+        }
     }
+}
+
+void GameEngine::writeBehaviorMetrics(std::string& out) const {
+    const std::lock_guard<std::mutex> lock(m_behaviorStatsMutex);
+    const auto trees = m_behaviors.trees();
+    const auto each = [&](std::string_view name, std::string_view help, auto&& value) {
+        Metrics::family(out, name, "counter", help);
+        const std::string total = std::format("{}_total", name);
+        for (std::size_t tree = 0; tree < m_behaviorStats.size() && tree < trees.size(); ++tree) {
+            if (m_behaviorStats[tree].runs > 0) {
+                Metrics::sample(out, total, Metrics::label("tree", trees[tree].name), value(m_behaviorStats[tree]));
+            }
+        }
+    };
+    each("echomud_behavior_runs", "Times an NPC behaviour tree was walked",
+         [](const BehaviorStats& stats) { return static_cast<double>(stats.runs); });
+    each("echomud_behavior_nodes", "Nodes a behaviour tree's walks reached",
+         [](const BehaviorStats& stats) { return static_cast<double>(stats.nodes); });
+    each("echomud_behavior_seconds", "Tick time spent walking a behaviour tree, its Lua leaves included",
+         [](const BehaviorStats& stats) { return std::chrono::duration<double>(stats.time).count(); });
+    each("echomud_behavior_lua_calls", "Calls a behaviour tree's Lua leaves made",
+         [](const BehaviorStats& stats) { return static_cast<double>(stats.luaCalls); });
+    each("echomud_behavior_lua_seconds", "Time a behaviour tree's Lua leaves spent in Lua",
+         [](const BehaviorStats& stats) { return std::chrono::duration<double>(stats.luaTime).count(); });
+}
+
+std::vector<ZoneRepopStats> GameEngine::repopStats() const {
+    const std::lock_guard<std::mutex> lock(m_repopStatsMutex);
+    return m_repopStats;
+}
+
+void GameEngine::publishMetrics(MetricsShard& shard) {
+    const TickStats& ticks = m_ticks.stats();
+    shard.set(Metric::Ticks, ticks.ticks);
+    shard.set(Metric::TickOverruns, ticks.overruns);
+    shard.set(Metric::CommandsRun, ticks.commandsRun);
+    shard.set(Metric::CommandsDeferred, ticks.commandsDeferred);
+    shard.set(Metric::CommandsDropped, ticks.commandsDropped);
+    shard.set(Metric::CommandsThrottled, ticks.commandsThrottled);
+    shard.set(Metric::LoadStage, static_cast<std::uint64_t>(m_ticks.loadStage()));
+    shard.set(Metric::TicksDeferring, ticks.ticksDeferring);
+    shard.set(Metric::TicksThrottling, ticks.ticksThrottling);
+#ifdef ENABLE_LUA_SCRIPTING
+    const auto memory = m_scriptRunner->memoryStats();
+    shard.set(Metric::LuaMemoryBytes, memory.liveBytes);
+    shard.set(Metric::LuaMemoryPeakBytes, memory.peakBytes);
+#endif
+}
+
+void GameEngine::rebuildCommandIndex() {
+    publishCommands(copyCommands());
+}
+
+void GameEngine::registerCommands() {
+    // Get a shared pointer to this instance for safe capturing
+    auto self = shared_from_this();
+
+    // Built-ins go straight to their slots of one snapshot, published once
+    // they are all in; one with a malformed syntax is left out. None of them
+    // reaches beyond its player's zone, but picking up and putting down
+    // change the entity store
+    CommandSnapshot next = copyCommands();
+    const auto setBuiltin = [this, &next](BuiltinCommand cmd, CommandSpec spec) {
+        spec.zoneLocal = cmd != BuiltinCommand::Get && cmd != BuiltinCommand::Drop;
+        if (auto arguments = compileSyntax(spec.name, spec.syntax)) {
+            storeCommand(next, static_cast<CommandId>(cmd), std::move(spec), std::move(*arguments));
+        } else {
+            next.entries[static_cast<std::size_t>(cmd)] = nullptr;
+        }
+    };
+
+    // Register the 'say' command directly
+    setBuiltin(BuiltinCommand::Say, {
+        .name = "say",
+        .help = "say <message>",
+        .description = "Speak aloud in the room for others to hear.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            const std::string_view message = ctx.args[0].text;
+            if (message.empty()) {
+                return CommandResult::success("Say what?");
+            }
+            ctx.engine.broadcastToRoom(ctx.engine.m_players.room(ctx.player),
+                Message<"{} says: '{}'">::in(ctx.engine.scratch(), ctx.engine.m_players.name(ctx.player), message),
+                ctx.player);
+#ifdef ENABLE_LUA_SCRIPTING
+            if (ScriptRunnerPool* scripts = ctx.engine.scriptEvents(ScriptEvent::Say)) {
+                scripts->emitSay({&ctx.engine, ctx.player}, message);
+            }
+#endif
+            return CommandResult::success(Message<"You say: '{}'">::reply(message));
+        },
+        .syntax = "message:rest?"
+    });
     
-    // Convert string_view to string for hook system
-    std::string cmdStr{cmd};
-    std::string argsStr{args};
+    // Register the 'look' command
+    setBuiltin(BuiltinCommand::Look, {
+        .name = "look",
+        .help = "look",
+        .description = "Look around and examine your surroundings.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.lookAround(ctx.player);
+        }
+    });
     
-    // Also check the hook system for any other quit conditions
-    return m_hookSystem.beforeCommand(cmdStr, argsStr);
+    // Register the 'get' command
+    setBuiltin(BuiltinCommand::Get, {
+        .name = "get",
+        .help = "get <item>",
+        .description = "Pick up an item from the current room.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleGet(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "item:rest"
+    });
+    
+    // Register the 'drop' command
+    setBuiltin(BuiltinCommand::Drop, {
+        .name = "drop",
+        .help = "drop <item>",
+        .description = "Put down an item you are carrying.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleDrop(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "item:rest"
+    });
+    
+    // Register the 'inventory' command
+    setBuiltin(BuiltinCommand::Inventory, {
+        .name = "inventory",
+        .help = "inventory",
+        .description = "List what you are carrying.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleInventory(ctx.player);
+        }
+    });
+    
+    // Register the movement commands; all four share one handler parametrized by direction
+    for (Direction dir : {Direction::North, Direction::South, Direction::East, Direction::West}) {
+        std::string_view dirName = directionName(dir);
+        setBuiltin(*findBuiltinCommand(dirName), {
+            .name = std::string(dirName),
+            .help = std::string(dirName),
+            .description = std::format("Move to the {} if possible.", dirName),
+            .handler = [dir](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+                return ctx.engine.handleMove(ctx.player, dir);
+            },
+            .priority = CommandPriority::Urgent
+        });
+    }
+    
+    // Register the 'exit' command
+    setBuiltin(BuiltinCommand::Exit, {
+        .name = "exit",
+        .help = "exit",
+        .description = "Exit the game.",
+        .handler = [](CommandContext& /*ctx*/, std::string_view /*args*/) -> CommandResult {
+            return CommandResult::success("Exiting game...");
+        },
+        // Leaving should take the whole word, not a slip of the keyboard
+        .abbreviate = false
+    });
+    
+    // Register the 'help' command
+    setBuiltin(BuiltinCommand::Help, {
+        .name = "help",
+        .help = "help [command|words]",
+        .description = "Display help for all commands or a specific command, or search the help for words.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleHelpCommand(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "topic:rest?",
+        .priority = CommandPriority::Bulk
+    });
+    
+    publishCommands(std::move(next));
+    
+    // Per-command counters and latencies, for operators chasing a slow verb
+    registerCommand({
+        .name = "stats",
+        .help = "stats [command|memory|counters|reset]",
+        .description = "Admins only: show call counts and latency percentiles for each command, memory use by "
+                       "subsystem, or hardware counters per command and tick phase.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            if (!ctx.engine.isAdmin(ctx.player)) {
+                return CommandResult::error("Only admins may see or reset the statistics.");
+            }
+            const std::string_view command = ctx.args[0].text;
+            if (command == "reset") {
+                ctx.engine.resetCommandStats();
+                return CommandResult::success("Command statistics reset.");
+            }
+            if (command == "memory") {
+                return CommandResult::success(ctx.engine.memoryStatsReport());
+            }
+            if (command == "counters") {
+                return CommandResult::success(ctx.engine.counterStatsReport());
+            }
+            return CommandResult::success(ctx.engine.commandStatsReport(command));
+        },
+        .syntax = "command:word?",
+        .priority = CommandPriority::Bulk
+    });
+    
+    // Fighting NPCs; a round every two seconds at the default tick rate
+    registerCommand({
+        .name = "kill",
+        .help = "kill <creature>",
+        .description = "Attack a creature in the room until one of you falls.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleKill(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "creature:rest",
+        .priority = CommandPriority::Urgent
+    });
+    registerCommand({
+        .name = "score",
+        .help = "score",
+        .description = "See your health, how you fight and what is affecting you.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleScore(ctx.player);
+        }
+    });
+    registerCommand({
+        .name = "flee",
+        .help = "flee",
+        .description = "Run from a fight through a random exit.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleFlee(ctx.player);
+        },
+        .priority = CommandPriority::Urgent
+    });
+    registerCommand({
+        .name = "follow",
+        .help = "follow [player]",
+        .description = "Follow a player in the room wherever they walk, as one group with anyone else following "
+                       "them. Alone, stop following.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleFollow(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "player:word?"
+    });
+    
+    // A command per channel, and one to see them all; the channels, and who
+    // listens, outlive re-registration
+    if (m_channels.size() == 0) {
+        m_channels.add("gossip", "Chat with everyone in the game.");
+        m_channels.add("newbie", "Ask and answer questions about playing.");
+    }
+    for (std::size_t i = 0; i < m_channels.size(); ++i) {
+        registerChannelCommand(static_cast<ChannelId>(i));
+    }
+    
+    // Finding a player by name is a hash probe, wherever they are
+    registerCommand({
+        .name = "tell",
+        .help = "tell <player> <message>",
+        .description = "Say something only one player hears, wherever they are.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleTell(ctx.player, ctx.args[0].text, ctx.args[1].text);
+        },
+        .syntax = "player:word message:rest"
+    });
+    registerCommand({
+        .name = "who",
+        .help = "who",
+        .description = "List the players in the game.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleWho(ctx.player);
+        },
+        .priority = CommandPriority::Bulk
+    });
+    registerCommand({
+        .name = "finger",
+        .help = "finger <player>",
+        .description = "See whether a player is in the game, and where, or when they were last seen.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleFinger(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "player:word"
+    });
+    registerCommand({
+        .name = "map",
+        .help = "map",
+        .description = "Draw the rooms around you: @ is you, * a room with other players in it.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleMap(ctx.player);
+        }
+    });
+    registerCommand({
+        .name = "motd",
+        .help = "motd",
+        .description = "Read the message of the day again.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleMotd(ctx.player);
+        }
+    });
+    registerCommand({
+        .name = "weather",
+        .help = "weather",
+        .description = "See the time of day and the weather where you are.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleWeather(ctx.player);
+        }
+    });
+    registerCommand({
+        .name = "snoop",
+        .help = "snoop [player]",
+        .description = "Admins only: see everything a player sees, or with no name stop.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleWatch(ctx.player, ctx.args[0].text, WatchKind::Snoop);
+        },
+        .syntax = "player:word?"
+    });
+    registerCommand({
+        .name = "spectate",
+        .help = "spectate [player]",
+        .description = "Watch a player's fight as they see it, or with no name stop.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleWatch(ctx.player, ctx.args[0].text, WatchKind::Spectate);
+        },
+        .syntax = "player:word?"
+    });
+    
+    // Boards and mail, read in place from their mapped files
+    registerCommand({
+        .name = "board",
+        .help = "board [name] [number|remove <number>]",
+        .description = "List the boards, a board's posts, or read one; you may remove your own.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleBoard(ctx.player, ctx.args[0].text, ctx.args[1].text);
+        },
+        .syntax = "board:word? what:rest?",
+        .priority = CommandPriority::Bulk
+    });
+    registerCommand({
+        .name = "post",
+        .help = "post <board> <subject> | <message>",
+        .description = "Post a message on a board for everyone to read.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handlePost(ctx.player, ctx.args[0].text, ctx.args[1].text);
+        },
+        .syntax = "board:word message:rest"
+    });
+    registerCommand({
+        .name = "mail",
+        .help = "mail [number|remove <number>], or mail <player> <subject> | <message>",
+        .description = "List or read your mail, remove a letter, or send one to any player.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleMail(ctx.player, ctx.args[0].text, ctx.args[1].text);
+        },
+        .syntax = "what:word? rest:rest?",
+        .priority = CommandPriority::Bulk
+    });
+    
+    // Private copies of a zone, for a group to have a dungeon to itself
+    registerCommand({
+        .name = "instance",
+        .help = "instance [player|leave]",
+        .description = "Step into a copy of this area of your own, join the copy another player is in, or leave.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleInstance(ctx.player, ctx.args[0].text);
+        },
+        .syntax = "who:word?"
+    });
+    // One command for every social, acted out by the verb it was typed as
+    registerCommand({
+        .name = "socials",
+        .help = "socials, or <social> [player]",
+        .description = "List the socials: smile, bow and the rest, done alone or at someone in the room.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleSocial(ctx.player, ctx.verb, ctx.args[0]);
+        },
+        .syntax = "who:target?",
+        .priority = CommandPriority::Bulk
+    });
+    registerCommand({
+        .name = "channels",
+        .help = "channels",
+        .description = "List the chat channels and whether you are listening to each.",
+        .handler = [](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            std::string text = ReplyPool::take();
+            const ChatChannels& channels = ctx.engine.m_channels;
+            for (std::size_t i = 0; i < channels.size(); ++i) {
+                const ChatChannels::Channel& channel = channels.channel(static_cast<ChannelId>(i));
+                std::format_to(std::back_inserter(text), "{}{:<8} {:<3}  {}", text.empty() ? "" : "\n", channel.name,
+                               channels.listening(static_cast<ChannelId>(i), ctx.player) ? "on" : "off",
+                               channel.description);
+            }
+            return CommandResult::success(std::move(text));
+        },
+        .priority = CommandPriority::Bulk
+    });
+    
+    // The usual MUD shorthands; any other unique prefix also works
+    m_aliases.clear();
+    for (auto [alias, command] : {std::pair{"n", "north"}, {"s", "south"}, {"e", "east"}, {"w", "west"},
+                                  {"l", "look"}, {"'", "say"}, {"g", "get"},
+                                  {"quit", "exit"}}) {
+        registerAlias(alias, command);
+    }
+}
+
+namespace {
+
+std::string asciiLowered(std::string_view text) {
+    std::string lowered(text);
+    for (char& c : lowered) {
+        c = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    return lowered;
+}
+
+} // namespace
+
+void GameEngine::rebuildHelpIndex() {
+    auto index = std::make_shared<HelpIndex>();
+    const auto addTopic = [this, &index](const CommandEntry& entry) {
+        const std::string_view name = entry.name();
+        const CommandText& text = commandText(entry);
+        index->topics.push_back({std::string(name), std::format("  {} - {}", name, text.description),
+                                 std::format("{} - {}\nUsage: {}\n{}", name, text.help, text.help, text.description),
+                                 asciiLowered(std::format("{} {} {}", name, text.help, text.description))});
+    };
+    // Each built-in command, then any runtime-registered ones; a script
+    // replacing a built-in has taken its slot, so no name comes twice
+    for (const auto& entry : commands().entries) {
+        if (entry && entry->handler) {
+            addTopic(*entry);
+        }
+    }
+    std::sort(index->topics.begin(), index->topics.end(),
+              [](const HelpIndex::Topic& a, const HelpIndex::Topic& b) { return a.name < b.name; });
+    
+    TextLines& list = index->list;
+    list.text = "Available commands:";
+    list.endLine();
+    for (const HelpIndex::Topic& topic : index->topics) {
+        list.text += topic.summary;
+        list.endLine();
+    }
+    if (!m_aliases.empty()) {
+        list.text += "Aliases:";
+        for (const auto& [alias, command] : m_aliases) {
+            std::format_to(std::back_inserter(list.text), " {}={}", alias, command);
+        }
+        list.endLine();
+        list.text += "Any unambiguous abbreviation of a command other than exit also works.";
+        list.endLine();
+    }
+    m_helpIndex = std::move(index);
+}
+
+namespace {
+
+// The lines of a shared text, which the source keeps alive while paged
+GameEngine::LineSource linesOf(std::shared_ptr<const TextLines> text) {
+    return [text = std::move(text), at = std::size_t{0}](std::string& line) mutable {
+        if (at == text->size()) {
+            return false;
+        }
+        line += text->line(at++);
+        return true;
+    };
+}
+
+// The lines of a mapped text file, straight out of the mapping, which the
+// source keeps however often the file changes while it is paged
+GameEngine::LineSource linesOf(std::shared_ptr<const MappedText> text) {
+    return [text = std::move(text), at = std::size_t{0}](std::string& line) mutable {
+        if (at == text->size()) {
+            return false;
+        }
+        line += text->line(at++);
+        return true;
+    };
+}
+
+// A heading, then item(0, line), item(1, line), ... until one returns false
+GameEngine::LineSource listLines(std::string heading, std::function<bool(std::size_t, std::string&)> item) {
+    return [heading = std::move(heading), item = std::move(item), at = std::size_t{0},
+            headed = false](std::string& line) mutable {
+        if (!headed) {
+            headed = true;
+            line += heading;
+            return true;
+        }
+        return item(at++, line);
+    };
+}
+
+} // namespace
+
+CommandResult GameEngine::paged(PlayerId player, LineSource lines) {
+    Pager& pager = m_pagers[player];
+    pager.lines = std::move(lines);
+    pager.held.clear();
+    if (!pager.lines(pager.held)) {
+        stopPaging(player);
+        return CommandResult::success(ReplyPool::take());
+    }
+    return nextPage(player);
+}
+
+CommandResult GameEngine::nextPage(PlayerId player) {
+    std::string text = ReplyPool::take();
+    if (!paging(player)) {
+        return CommandResult::success(std::move(text));
+    }
+    Pager& pager = m_pagers[player];
+    const std::uint16_t pageRows = m_players.state(player).pageRows;
+    // The held line opens every page; one more is read past a full page
+    // only to learn whether to ask for Enter
+    std::size_t rows = 0;
+    for (;;) {
+        rows += 1 + static_cast<std::size_t>(std::ranges::count(pager.held, '\n'));
+        text += pager.held;
+        pager.held.clear();
+        if (!pager.lines(pager.held)) {
+            stopPaging(player);
+            return CommandResult::success(std::move(text));
+        }
+        if (pageRows != 0 && rows >= pageRows) {
+            break;
+        }
+        text += '\n';
+    }
+    text += "\n[--more-- Enter for the next page; any command stops]";
+    return CommandResult::success(std::move(text));
+}
+
+void GameEngine::setPageLines(PlayerId player, std::uint16_t rows) {
+    if (m_players.isActive(player)) {
+        m_players.state(player).pageRows = rows;
+    }
+}
+
+CommandResult GameEngine::handleHelpCommand(PlayerId player, std::string_view args) {
+    const rcu::Guard guard;
+    const HelpIndex& index = *m_helpIndex;
+    // Shared with the index, not copied; the pager keeps it alive
+    if (args.empty()) {
+        return paged(player, linesOf(std::shared_ptr<const TextLines>(m_helpIndex, &index.list)));
+    }
+    // A help file written for the topic first, as it stands on disk
+    if (m_texts) {
+        std::string topic = asciiLowered(args);
+        std::ranges::replace(topic, ' ', '_');
+        if (auto file = m_texts->get("help/" + topic)) {
+            return paged(player, linesOf(std::move(file)));
+        }
+    }
+    std::string text = ReplyPool::take();
+    
+    // Then a command by name or abbreviation
+    if (const CommandEntry* found = findCommand(args)) {
+        const auto topic = std::lower_bound(index.topics.begin(), index.topics.end(), found->name(),
+            [](const HelpIndex::Topic& topic, std::string_view name) { return topic.name < name; });
+        if (topic != index.topics.end() && topic->name == found->name()) {
+            text += topic->detail;
+            return CommandResult::success(std::move(text));
+        }
+    }
+    
+    // Otherwise every topic mentioning all the words; past the first,
+    // each is searched for only when the page before it has been read
+    const auto mentions = [query = asciiLowered(args)](const HelpIndex::Topic& topic) {
+        bool matches = true;
+        for (std::size_t start = query.find_first_not_of(' '); matches && start != std::string::npos;) {
+            const std::size_t stop = std::min(query.find(' ', start), query.size());
+            matches = topic.searchable.find(std::string_view(query).substr(start, stop - start)) != std::string::npos;
+            start = query.find_first_not_of(' ', stop);
+        }
+        return matches;
+    };
+    const auto first = std::ranges::find_if(index.topics, mentions);
+    if (first == index.topics.end()) {
+        return CommandResult::error(DispatchError::UnknownCommand, args);
+    }
+    return paged(player, listLines(std::format("Help topics mentioning '{}':", args),
+        [shared = m_helpIndex, mentions, next = first - index.topics.begin()](std::size_t, std::string& line) mutable {
+            const std::span<const HelpIndex::Topic> topics = shared->topics;
+            if (next >= std::ssize(topics)) {
+                return false;
+            }
+            line += topics[next].summary;
+            next = std::find_if(topics.begin() + next + 1, topics.end(), mentions) - topics.begin();
+            return true;
+        }));
+}
+
+CommandResult GameEngine::handleMotd(PlayerId player) {
+    auto motd = m_texts ? m_texts->get("motd") : nullptr;
+    if (!motd) {
+        return CommandResult::error("There is no message of the day.");
+    }
+    return paged(player, linesOf(std::move(motd)));
+}
+
+CommandResult GameEngine::handleWeather(PlayerId player) {
+    return CommandResult::success(m_ambience.describe(m_ticks.boundary(), m_players.zone(player)));
+}
+
+CommandResult GameEngine::handleCommand(std::string_view cmd, std::string_view args) {
+    return handleCommand(m_localPlayer, cmd, args);
+}
+
+CommandResult GameEngine::handleCommand(const CommandHandle& handle, std::string_view args) {
+    return handleCommand(m_localPlayer, handle, args);
+}
+
+CommandResult GameEngine::handleCommand(PlayerId player, std::string_view cmd, std::string_view args) {
+    // Keeps the entry alive while it runs, whatever the handler registers
+    const rcu::Guard guard;
+    const auto entry = prepareCommand(player, cmd);
+    if (!entry) {
+        return CommandResult::error(entry.error(), cmd);
+    }
+    return dispatch(player, **entry, cmd, args);
+}
+
+CommandResult GameEngine::handleCommand(PlayerId player, const CommandHandle& handle, std::string_view args) {
+    const rcu::Guard guard;
+    const auto entry = prepareCommand(player, handle);
+    if (!entry) {
+        return CommandResult::error(entry.error());
+    }
+    return dispatch(player, **entry, (*entry)->name(), args);
+}
+
+std::expected<const CommandEntry*, DispatchError> GameEngine::prepareCommand(PlayerId player, std::string_view cmd) {
+    if (!m_players.isActive(player)) {
+        return std::unexpected(DispatchError::UnknownPlayer);
+    }
+    
+#ifdef ENABLE_LUA_SCRIPTING
+    applyScriptReloads();
+#endif
+    
+    // Look up the command (built-in perfect hash first, then the runtime registry)
+    if (const CommandEntry* entry = findCommand(cmd)) {
+        return entry;
+    }
+    return std::unexpected(DispatchError::UnknownCommand);
+}
+
+std::expected<const CommandEntry*, DispatchError> GameEngine::prepareCommand(PlayerId player,
+                                                                            const CommandHandle& handle) {
+    // A stale handle may point at an entry that no longer exists
+    if (!isCurrent(handle)) {
+        return std::unexpected(DispatchError::StaleHandle);
+    }
+    
+    if (!m_players.isActive(player)) {
+        return std::unexpected(DispatchError::UnknownPlayer);
+    }
+    
+#ifdef ENABLE_LUA_SCRIPTING
+    // A reload publishes new entries; the command keeps its slot, so the
+    // handle's entry is swapped for the one now published there
+    if (applyScriptReloads(); !isCurrent(handle)) {
+        if (const CommandEntry* entry = commands().entries[handle.m_entry->id].get()) {
+            return entry;
+        }
+        return std::unexpected(DispatchError::StaleHandle);
+    }
+#endif
+    
+    return handle.m_entry;
+}
+
+CommandResult GameEngine::handleCommandLine(std::string_view line) {
+    return handleCommandLine(m_localPlayer, line);
+}
+
+CommandResult GameEngine::handleCommandLine(PlayerId player, std::string_view line) {
+    const rcu::Guard guard;
+    const CommandSequence sequence(line);
+    if (sequence.tooLong()) {
+        return CommandResult::error(ReplyPool::format("That is too much at once; at most {} commands to a line.",
+                                                CommandSequence::kMaxCommands));
+    }
+    if (!sequence.isSequence()) {
+        const CommandTokens tokens(line);
+        return handleCommand(player, tokens.verb(), tokens.args());
+    }
+    if (!m_players.isActive(player)) {
+        return CommandResult::error(DispatchError::UnknownPlayer);
+    }
+
+#ifdef ENABLE_LUA_SCRIPTING
+    applyScriptReloads();
+#endif
+
+    return runSequence(player, sequence);
+}
+
+CommandResult GameEngine::runSequence(PlayerId player, const CommandSequence& sequence) {
+    // Each reply is appended to the first, so the whole line builds one
+    // message. Every command after the first adds a tick of lag, so a walk
+    // takes as many turns as typing it out would
+    CommandResult combined = CommandResult::success(std::string());
+    bool first = true;
+    const auto append = [&combined, &first](CommandResult&& result) {
+        combined.lag += result.lag + (first ? 0 : 1);
+        first = false;
+        if (combined.message.empty()) {
+            combined.message = std::move(result.message);
+        } else if (!result.message.empty()) {
+            combined.message += '\n';
+            combined.message += result.message;
+        }
+        combined.status = result.status;
+        return result.status != CommandResult::Status::Error;
+    };
+
+    for (const CommandSequence::Step& step : sequence) {
+        // Resolved once however often the step repeats
+        const CommandTokens tokens(step.line);
+        const CommandEntry* entry = findCommand(tokens.verb());
+        if (!entry) {
+            append(CommandResult::error(DispatchError::UnknownCommand, tokens.verb()));
+            break;
+        }
+        if (entry->id == static_cast<CommandId>(BuiltinCommand::Exit)) {
+            append(CommandResult::error(DispatchError::ExitInSequence));
+            break;
+        }
+        for (std::uint32_t i = 0; i < step.repeat; ++i) {
+            const RoomId before = m_players.room(player);
+            if (!append(dispatch(player, *entry, tokens.verb(), tokens.args()))) {
+                return combined;
+            }
+            // A blocked or missing exit ends the walk rather than repeating the refusal
+            if (step.walk && m_players.room(player) == before) {
+                return combined;
+            }
+        }
+    }
+    return combined;
+}
+
+CommandResult GameEngine::dispatch(PlayerId player, const CommandEntry& entry, std::string_view verb,
+                                   std::string_view args) {
+    TRACE_EVENT("command {} by player {}", entry.name(), player);
+    const Watchdog::Activity doing("command", entry.name());
+    using Clock = std::chrono::steady_clock;
+    CommandMetrics* const metrics = entry.metrics;
+    const PerfScope counted(metrics ? &metrics->counters : nullptr);
+    const bool hooked = m_hooks.hasSubscribers(HookEvent::Command, HookPhase::Before) ||
+                        m_hooks.hasSubscribers(HookEvent::Command, HookPhase::After);
+    const Clock::time_point started = Clock::now();
+    std::chrono::nanoseconds inHooks{0};
+    // However the dispatch ends, it is counted and timed
+    const auto finish = [&](CommandResult result, bool blocked = false) {
+        if (metrics) {
+            metrics->calls.fetch_add(1, std::memory_order_relaxed);
+            if (result.status == CommandResult::Status::Error) {
+                metrics->errors.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (blocked) {
+                metrics->blocked.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (hooked) {
+                metrics->hooks.record(inHooks);
+            }
+            metrics->dispatch.record(Clock::now() - started);
+        }
+        return result;
+    };
+    
+    // Hooks are only consulted when something is subscribed
+    const CommandEvent event{player, entry.name(), args};
+    if (m_hooks.run(HookPhase::Before, event) == HookDecision::Block) {
+        TRACE_EVENT("command {} by player {} blocked", entry.name(), player);
+        inHooks = Clock::now() - started;
+        return finish(CommandResult::error(DispatchError::Blocked), true);
+    }
+    if (hooked) {
+        inHooks = Clock::now() - started;
+    }
+    
+    // Match the arguments against the entry's syntax before calling it
+    CommandArgs parsed;
+    if (auto matched = entry.arguments.parse(args, parsed); !matched) {
+        return finish(CommandResult::error(ReplyPool::format("{} Usage: {}", matched.error(), commandText(entry).help)));
+    }
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        CommandArg& arg = parsed[i];
+        if (arg.kind == ArgKind::Target && arg.present) {
+            arg.target = findPlayerInRoom(m_players.room(player), arg.text);
+            if (arg.target == kInvalidPlayerId) {
+                return finish(CommandResult::error(Message<"You don't see '{}' here.">::reply(arg.text)));
+            }
+        }
+    }
+    
+    // The one place exceptions are caught: handlers, Lua ones above all,
+    // are code the pipeline doesn't control. Everything else reports errors
+    // as results
+    try {
+        CommandContext ctx{*this, player, parsed, metrics, verb};
+        const Clock::time_point handling = Clock::now();
+        CommandResult result = entry.handler(ctx, args);
+        const Clock::time_point handled = Clock::now();
+        if (metrics) {
+            metrics->handler.record(handled - handling);
+        }
+        result.lag = std::max(result.lag, entry.lag);
+        m_hooks.run(HookPhase::After, event);
+        if (hooked) {
+            inHooks += Clock::now() - handled;
+        }
+        TRACE_EVENT("command {} by player {} done, status {} lag {}", entry.name(), player, result.status, result.lag);
+        return finish(std::move(result));
+    } catch (...) {
+        TRACE_EVENT("command {} by player {} threw", entry.name(), player);
+        return finish(CommandResult::error(DispatchError::Failed, entry.name()));
+    }
+}
+
+CommandResult GameEngine::handleMove(PlayerId player, Direction dir) {
+    // Follow the exit from the current room (single array lookup)
+    RoomId from = m_players.room(player);
+    RoomId target = m_world.exit(from, dir);
+    
+    const MoveEvent event{player, dir, from, target};
+    if (m_hooks.run(HookPhase::Before, event) == HookDecision::Block) {
+        return CommandResult::success(ReplyPool::format("You feel a mysterious force preventing you from moving {}.", directionName(dir)));
+    }
+    
+    if (target == kInvalidRoomId) {
+        return CommandResult::success("You can't go that way.");
+    }
+    
+    // Update player's current room; a zone actor leaves that for later, and
+    // a zone another shard runs is the front end's to hand the player over to
+    if (!m_shard.owns(m_world.zone(target))) {
+        if (ZoneActor* zone = t_zone) {
+            zone->effects.push_back({ZoneEffect::Kind::Handoff, player, target, from, dir, std::pmr::string()});
+        } else {
+            m_handoffs.push_back({player, target});
+        }
+    } else if (ZoneActor* zone = t_zone) {
+        zone->effects.push_back({ZoneEffect::Kind::Move, player, target, from, dir, std::pmr::string()});
+    } else {
+        moveGroup(event);
+    }
+    return CommandResult::success(Message<"You move {} into {}.">::reply(directionName(dir), m_world.name(target)));
+}
+
+CommandResult GameEngine::handleFollow(PlayerId player, std::string_view name) {
+    const PlayerId following = m_leaders[player];
+    if (name.empty()) {
+        if (following == kInvalidPlayerId) {
+            return CommandResult::success("You are not following anyone.");
+        }
+        unfollow(player);
+        sendToPlayer(following, Message<"{} stops following you.">::reply(m_players.name(player)));
+        return CommandResult::success(Message<"You stop following {}.">::reply(m_players.name(following)));
+    }
+    const PlayerId named = findPlayerInRoom(m_players.room(player), name);
+    if (named == kInvalidPlayerId) {
+        return CommandResult::error(Message<"No one called '{}' is here.">::reply(name));
+    }
+    // Following a follower is falling in behind their leader
+    const PlayerId leader = m_leaders[named] != kInvalidPlayerId ? m_leaders[named] : named;
+    if (named == player) {
+        return CommandResult::error("You cannot follow yourself; 'follow' alone stops following.");
+    }
+    if (leader == player) {
+        return CommandResult::error(Message<"{} already follows you.">::reply(m_players.name(named)));
+    }
+    if (leader == following) {
+        return CommandResult::success(Message<"You already follow {}.">::reply(m_players.name(leader)));
+    }
+    if (following != kInvalidPlayerId) {
+        unfollow(player);
+        sendToPlayer(following, Message<"{} stops following you.">::reply(m_players.name(player)));
+    }
+    // Anyone following player comes along, so leaders still follow no one
+    for (const PlayerId follower : std::exchange(m_followers[player], {})) {
+        m_leaders[follower] = leader;
+        m_followers[leader].push_back(follower);
+        sendToPlayer(follower, Message<"{} now follows {}, and so do you.">::reply(m_players.name(player),
+                                                                                 m_players.name(leader)));
+    }
+    m_leaders[player] = leader;
+    m_followers[leader].push_back(player);
+    sendToPlayer(leader, Message<"{} now follows you.">::reply(m_players.name(player)));
+    return CommandResult::success(Message<"You now follow {}.">::reply(m_players.name(leader)));
+}
+
+void GameEngine::unfollow(PlayerId player) {
+    const PlayerId leader = std::exchange(m_leaders[player], kInvalidPlayerId);
+    if (leader != kInvalidPlayerId) {
+        std::erase(m_followers[leader], player);
+    }
+}
+
+void GameEngine::leaveGroup(PlayerId player) {
+    unfollow(player);
+    for (const PlayerId follower : std::exchange(m_followers[player], {})) {
+        m_leaders[follower] = kInvalidPlayerId;
+        sendToPlayer(follower, Message<"{} is gone; you follow no one now.">::reply(m_players.name(player)));
+    }
+}
+
+PlayerId GameEngine::addPlayer(std::string name) {
+    m_playerNames.insert(name);
+    loadZone(m_world.zone(m_startRoom));
+    PlayerId player = m_players.add(std::move(name), m_startRoom, m_world.zone(m_startRoom));
+    touchRoom(m_startRoom);
+    if (m_outbox.size() < m_players.capacity()) {
+        m_outbox.resize(m_players.capacity());
+        m_listed.resize(m_players.capacity());
+        m_dirty.resize(m_players.capacity());
+        m_playerBodies.resize(m_players.capacity());
+        m_playerHosts.resize(m_players.capacity());
+        m_pagers.resize(m_players.capacity());
+        m_leaders.resize(m_players.capacity(), kInvalidPlayerId);
+        m_followers.resize(m_players.capacity());
+    }
+    const Entity body = m_entities.create();
+    m_entities.add<PlayerBody>(body, player);
+    m_entities.add<Health>(body);
+    m_entities.add<Inventory>(body);
+    m_playerBodies[player] = body;
+    m_playerIndex.insert(m_players.nameKey(player), player);
+    ++m_rosterVersion;
+    m_channels.join(player);
+    wakeZone(m_players.zone(player));
+    m_hooks.run(HookEvent::PlayerJoin, PlayerEvent{player, m_players.name(player)});
+    m_events.publish(PlayerJoined{player, m_players.nameSymbol(player), m_players.room(player)});
+    return player;
+}
+
+void GameEngine::removePlayer(PlayerId player, bool keepBelongings) {
+    if (!m_players.isActive(player)) {
+        return;
+    }
+    m_hooks.run(HookEvent::PlayerLeave, PlayerEvent{player, m_players.name(player)});
+    m_events.publish(PlayerLeft{player, m_players.nameSymbol(player)});
+#ifdef ENABLE_LUA_SCRIPTING
+    if (m_scriptRunner) {
+        m_scriptRunner->cancelTasks(player);
+    }
+#endif
+    // A command still waiting finishes, but with no one to reply to
+    for (AsyncCommand& command : m_asyncCommands) {
+        if (command.player == player) {
+            command.player = kInvalidPlayerId;
+        }
+    }
+    // What the player carried stays behind where they left, unless it was
+    // saved with them and would come back twice
+    const Entity body = std::exchange(m_playerBodies[player], kInvalidEntity);
+    if (Inventory* inventory = m_entities.find<Inventory>(body)) {
+        for (Entity item : std::exchange(inventory->items, {})) {
+            putDown(item, keepBelongings ? kInvalidRoomId : m_players.room(player));
+        }
+    }
+    m_combat.remove(body);
+    m_entities.destroy(body);
+    m_playerNames.erase(m_players.name(player));
+    m_playerIndex.erase(m_players.nameKey(player), player);
+    m_playerHosts[player].clear();
+    m_pagers[player] = {};
+    leaveGroup(player);
+    endWatches(player, "has left the game");
+    ++m_rosterVersion;
+    m_channels.leave(player);
+    const ZoneId zone = m_players.zone(player);
+    touchRoom(m_players.room(player));
+    m_players.remove(player);
+    m_outbox[player].clear();
+    m_dirty[player] = 0;
+    if (m_players.zoneOccupantCount(zone) == 0) {
+        sleepZone(zone);
+    }
+}
+
+std::pmr::memory_resource& GameEngine::scratch() {
+    if (t_zone) {
+        return t_zone->scratch->resource();
+    }
+    // Nothing would take back what a command run between ticks left there
+    return m_ticks.ticking() ? m_ticks.scratch() : *std::pmr::get_default_resource();
+}
+
+void GameEngine::sendToPlayer(PlayerId player, std::string message) {
+    if (ZoneActor* zone = t_zone) {
+        zone->effects.push_back({ZoneEffect::Kind::Send, player, kInvalidRoomId, kInvalidRoomId, Direction::Count,
+                                 std::pmr::string(message, &zone->scratch->resource())});
+        return;
+    }
+    if (m_players.isActive(player)) {
+        queueMessage(player, makeSharedMessage(std::move(message)));
+    }
+}
+
+void GameEngine::broadcastToRoom(RoomId room, std::string_view message, PlayerId except) {
+    if (room == kInvalidRoomId) {
+        return;
+    }
+    if (ZoneActor* zone = t_zone) {
+        zone->effects.push_back({ZoneEffect::Kind::Broadcast, except, room, kInvalidRoomId, Direction::Count,
+                                 std::pmr::string(message, &zone->scratch->resource())});
+        return;
+    }
+    // Formatted once, however many are in the room
+    SharedMessage shared;
+    m_players.forEachInRoom(room, [&](PlayerId player) {
+        if (player != except) {
+            if (!shared) {
+                shared = makeSharedMessage(std::string(message));
+            }
+            queueMessage(player, shared);
+        }
+    });
+}
+
+std::optional<ChannelId> GameEngine::addChannel(std::string name, std::string description, bool onByDefault) {
+    if (m_commandNames.contains(name)) {
+        return std::nullopt;   // A command by that name already
+    }
+    const auto channel = m_channels.add(std::move(name), std::move(description), onByDefault);
+    if (channel) {
+        registerChannelCommand(*channel);
+    }
+    return channel;
+}
+
+void GameEngine::registerChannelCommand(ChannelId channel) {
+    const ChatChannels::Channel& info = m_channels.channel(channel);
+    registerCommand({
+        .name = info.name,
+        .help = std::format("{} [message]", info.name),
+        .description = std::format("{} Alone, turns the channel off or back on.", info.description),
+        .handler = [channel](CommandContext& ctx, std::string_view /*args*/) -> CommandResult {
+            return ctx.engine.handleChannel(ctx.player, channel, ctx.args[0].text);
+        },
+        .syntax = "message:rest?"
+    });
+}
+
+CommandResult GameEngine::handleChannel(PlayerId player, ChannelId channel, std::string_view message) {
+    const std::string_view name = m_channels.channel(channel).name;
+    const bool listening = m_channels.listening(channel, player);
+    if (message.empty()) {
+        m_channels.setListening(channel, player, !listening);
+        return CommandResult::success(listening ? Message<"You turn {} off.">::reply(name)
+                                                : Message<"You turn {} on.">::reply(name));
+    }
+    if (!listening) {
+        return CommandResult::error(Message<"You have {} turned off.">::reply(name));
+    }
+    sendToChannel(channel, Message<"[{}] {}: {}">::in(scratch(), name, m_players.name(player), message), player);
+    return CommandResult::success(Message<"[{}] You: {}">::reply(name, message));
+}
+
+CommandResult GameEngine::handleTell(PlayerId player, std::string_view name, std::string_view message) {
+    const PlayerId target = m_playerIndex.find(name);
+    if (target == kInvalidPlayerId) {
+        return CommandResult::error(Message<"No one called '{}' is in the game.">::reply(name));
+    }
+    if (target == player) {
+        return CommandResult::success(Message<"You tell yourself: {}">::reply(message));
+    }
+    sendToPlayer(target, std::format("{} tells you: {}", m_players.name(player), message));
+    return CommandResult::success(Message<"You tell {}: {}">::reply(m_players.name(target), message));
+}
+
+CommandResult GameEngine::handleSocial(PlayerId player, std::string_view verb, const CommandArg& target) {
+    const SocialTable::Social* social = m_socials.find(verb);
+    if (!social) {
+        std::string text = ReplyPool::take();
+        text += m_socials.list();
+        return CommandResult::success(std::move(text));
+    }
+    // Each line was parsed when the table was loaded; sending one is
+    // copying its pieces and the two names
+    const RoomId room = m_players.room(player);
+    const std::array<std::string_view, 2> names = {m_players.name(player),
+                                                   target.present ? m_players.name(target.target) : ""};
+    std::pmr::string seen(&scratch());
+    // Alone, or at yourself when the social has nothing special for that
+    const bool self = target.present && target.target == player;
+    if (!target.present || (self && !social->line(SocialView::Self))) {
+        social->line(SocialView::AloneRoom)->append(seen, names);
+        broadcastToRoom(room, seen, player);
+        return CommandResult::success(social->line(SocialView::Alone)->reply(names));
+    }
+    if (self) {
+        social->line(SocialView::SelfRoom)->append(seen, names);
+        broadcastToRoom(room, seen, player);
+        return CommandResult::success(social->line(SocialView::Self)->reply(names));
+    }
+    if (!social->line(SocialView::Actor)) {
+        return CommandResult::error(Message<"You can't {} at someone.">::reply(social->name));
+    }
+    sendToPlayer(target.target, social->line(SocialView::Target)->reply(names));
+    // Everyone else shares one copy, as broadcastToRoom's do; socials run
+    // serially, never on a zone actor
+    social->line(SocialView::Room)->append(seen, names);
+    SharedMessage shared;
+    m_players.forEachInRoom(room, [&](PlayerId other) {
+        if (other != player && other != target.target) {
+            if (!shared) {
+                shared = makeSharedMessage(std::string(seen));
+            }
+            queueMessage(other, shared);
+        }
+    });
+    return CommandResult::success(social->line(SocialView::Actor)->reply(names));
+}
+
+std::expected<void, std::string> GameEngine::loadSocials(std::string_view text) {
+    auto table = SocialTable::parse(text);
+    if (!table) {
+        return std::unexpected(std::move(table.error()));
+    }
+    m_socials = std::move(*table);
+    return {};
+}
+
+std::expected<void, std::string> GameEngine::loadBehaviors(std::string_view text) {
+    auto trees = BehaviorTrees::parse(text);
+    if (!trees) {
+        return std::unexpected(std::move(trees.error()));
+    }
+    // A Lua leaf must name a function there is, checked now rather than at every call
+    std::string errors;
+    for (const BehaviorLuaLeaf& leaf : trees->luaLeaves()) {
+#ifdef ENABLE_LUA_SCRIPTING
+        if (m_scriptRunner->hasHook(leaf.script, leaf.hook)) {
+            continue;
+        }
+        std::format_to(std::back_inserter(errors), "{}line {}: script {} has no function {}", errors.empty() ? "" : "\n",
+                       leaf.line, leaf.script, leaf.hook);
+#else
+        std::format_to(std::back_inserter(errors), "{}line {}: lua needs a build with Lua scripting",
+                       errors.empty() ? "" : "\n", leaf.line);
+#endif
+    }
+    if (!errors.empty()) {
+        return std::unexpected(std::move(errors));
+    }
+
+    {
+        // A metrics scrape reads the trees' names
+        const std::lock_guard<std::mutex> lock(m_behaviorStatsMutex);
+        m_behaviors = std::move(*trees);
+        m_behaviorStats.assign(m_behaviors.trees().size(), {});
+    }
+    const std::uint64_t now = m_ticks.boundary();
+    for (ZoneId zone = 0; zone < m_npcZones.size(); ++zone) {
+        if (!m_npcZones[zone]) {
+            continue;
+        }
+        for (Entity npc : m_npcZones[zone]->npcs) {
+            if (Npc* state = m_entities.find<Npc>(npc)) {
+                state->behavior = m_behaviors.forNpc(nameOf(npc));
+                state->nextMove = std::max(state->nextMove, now + 1);
+            }
+        }
+        if (m_npcZones[zone]->awake) {
+            scheduleNpcs(zone);
+        }
+    }
+    return {};
+}
+
+std::vector<BehaviorStats> GameEngine::behaviorStats() const {
+    const std::lock_guard<std::mutex> lock(m_behaviorStatsMutex);
+    return m_behaviorStats;
+}
+
+void GameEngine::setPlayerHost(PlayerId player, std::string host) {
+    if (!m_players.isActive(player) || m_playerHosts[player] == host) {
+        return;
+    }
+    m_playerHosts[player] = std::move(host);
+    ++m_rosterVersion;
+}
+
+void GameEngine::setAdmin(PlayerId player, bool admin) {
+    if (m_players.isActive(player)) {
+        m_players.state(player).flags.set(PlayerFlag::Admin, admin);
+    }
+}
+
+void GameEngine::tee(PlayerId source, const SharedMessage& message) {
+    // Straight into the watchers' outboxes, not through queueMessage(), so
+    // a watcher's own watchers see only what is sent to the watcher
+    for (const Watch& watch : m_watches) {
+        if (watch.source == source) {
+            pushMessage(watch.watcher, message);
+        }
+    }
+}
+
+void GameEngine::refreshWatched() {
+    for (PlayerId id = 0; id < m_players.capacity(); ++id) {
+        m_players.state(id).flags.set(PlayerFlag::Watched, false);
+    }
+    for (const Watch& watch : m_watches) {
+        m_players.state(watch.source).flags.set(PlayerFlag::Watched);
+    }
+}
+
+// Those watching are told once the list is settled, since telling them
+// goes through tee()
+void GameEngine::endWatches(PlayerId player, std::string_view why) {
+    std::vector<PlayerId> told;
+    const auto ended = std::erase_if(m_watches, [&](const Watch& watch) {
+        if (watch.source == player) {
+            told.push_back(watch.watcher);
+        }
+        return watch.source == player || watch.watcher == player;
+    });
+    if (ended == 0) {
+        return;
+    }
+    refreshWatched();
+    for (const PlayerId watcher : told) {
+        sendToPlayer(watcher, std::format("{} {}; you stop watching.", m_players.name(player), why));
+    }
+}
+
+// Spectators watch a fight, not the fighter
+void GameEngine::endFinishedSpectating() {
+    std::vector<Watch> ended;
+    std::erase_if(m_watches, [&](const Watch& watch) {
+        if (watch.kind != WatchKind::Spectate || m_combat.fighting(m_playerBodies[watch.source])) {
+            return false;
+        }
+        ended.push_back(watch);
+        return true;
+    });
+    if (ended.empty()) {
+        return;
+    }
+    refreshWatched();
+    for (const Watch& watch : ended) {
+        sendToPlayer(watch.watcher, std::format("{}'s fight is over; you stop watching.", m_players.name(watch.source)));
+    }
+}
+
+CommandResult GameEngine::handleWatch(PlayerId player, std::string_view name, WatchKind kind) {
+    if (kind == WatchKind::Snoop && !isAdmin(player)) {
+        return CommandResult::error("Only admins may snoop.");
+    }
+    const auto mine = std::ranges::find(m_watches, player, &Watch::watcher);
+    if (name.empty()) {
+        if (mine == m_watches.end()) {
+            return CommandResult::error("You aren't watching anyone.");
+        }
+        const PlayerId source = mine->source;
+        m_watches.erase(mine);
+        refreshWatched();
+        return CommandResult::success(Message<"You stop watching {}.">::reply(m_players.name(source)));
+    }
+    const PlayerId target = m_playerIndex.find(name);
+    if (target == kInvalidPlayerId) {
+        return CommandResult::error(Message<"No one called '{}' is in the game.">::reply(name));
+    }
+    if (target == player) {
+        return CommandResult::error("You can't watch yourself.");
+    }
+    if (kind == WatchKind::Spectate && !m_combat.fighting(m_playerBodies[target])) {
+        return CommandResult::error(Message<"{} isn't fighting anyone.">::reply(m_players.name(target)));
+    }
+    // One at a time; watching someone new stops watching the last
+    if (mine != m_watches.end()) {
+        *mine = Watch{player, target, kind};
+    } else {
+        m_watches.push_back(Watch{player, target, kind});
+    }
+    refreshWatched();
+    // A snoop is unseen; a fighter knows they have an audience
+    if (kind == WatchKind::Spectate) {
+        sendToPlayer(target, std::format("{} is watching your fight.", m_players.name(player)));
+    }
+    return CommandResult::success(Message<"You are now watching {}.">::reply(m_players.name(target)));
+}
+
+void GameEngine::status(WorldStatus& into) {
+    into.takenAt = TickClock::wallSeconds();
+    // Entries are assigned over rather than rebuilt, so the names' strings keep their memory
+    std::size_t count = 0;
+    for (PlayerId id = 0; id < m_players.capacity(); ++id) {
+        if (!m_players.isActive(id)) {
+            continue;
+        }
+        if (count == into.players.size()) {
+            into.players.emplace_back();
+        }
+        WorldStatus::Player& player = into.players[count++];
+        const Entity body = playerBody(id);
+        const Health* health = m_entities.find<Health>(body);
+        const CombatStats stats = effectiveStats(body);
+        player.name.assign(m_players.name(id));
+        player.zone = m_players.zone(id);
+        player.health = health ? health->current : 0;
+        player.maxHealth = health ? health->max : 0;
+        player.power = stats.attack + stats.defense + stats.damage;
+    }
+    into.players.resize(count);
+    std::ranges::sort(into.players, {}, &WorldStatus::Player::name);
+
+    into.top.resize(count);
+    std::iota(into.top.begin(), into.top.end(), 0u);
+    const std::size_t top = std::min(count, WorldStatus::kTopPlayers);
+    std::ranges::partial_sort(into.top, into.top.begin() + static_cast<std::ptrdiff_t>(top),
+                              [&](std::uint32_t a, std::uint32_t b) {
+                                  return into.players[a].power != into.players[b].power
+                                             ? into.players[a].power > into.players[b].power
+                                             : a < b;
+                              });
+    into.top.resize(top);
+
+    into.zones.clear();
+    for (ZoneId zone = 0; zone < m_world.zoneCount(); ++zone) {
+        const bool loaded = zone >= m_zoneLoaded.size() || m_zoneLoaded[zone] != 0;
+        if (loaded) {
+            into.zones.push_back({zone, 0, true});
+        }
+    }
+    for (const WorldStatus::Player& player : into.players) {
+        auto found = std::ranges::lower_bound(into.zones, player.zone, {}, &WorldStatus::Zone::id);
+        if (found == into.zones.end() || found->id != player.zone) {
+            found = into.zones.insert(found, {player.zone, 0, false});
+        }
+        ++found->players;
+    }
+}
+
+CommandResult GameEngine::handleWho(PlayerId player) {
+    const auto now = TickClock::monotonic();
+    const bool hosts = isAdmin(player);
+    WhoList& who = m_whoLists[hosts ? 1 : 0];
+    if (!who.lines || (who.version != m_rosterVersion && now - who.built >= kWhoInterval)) {
+        std::vector<PlayerId> listed;
+        listed.reserve(m_players.size());
+        for (PlayerId id = 0; id < m_players.capacity(); ++id) {
+            if (m_players.isActive(id)) {
+                listed.push_back(id);
+            }
+        }
+        std::ranges::sort(listed, [this](PlayerId left, PlayerId right) {
+            const std::string_view a = m_players.name(left);
+            const std::string_view b = m_players.name(right);
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+                return (x >= 'A' && x <= 'Z' ? x | 0x20 : x) < (y >= 'A' && y <= 'Z' ? y | 0x20 : y);
+            });
+        });
+        auto list = std::make_shared<TextLines>();
+        list->text = std::format("Players in the game ({}):", listed.size());
+        list->endLine();
+        for (const PlayerId id : listed) {
+            list->text += "  ";
+            list->text += m_players.name(id);
+            if (hosts && !m_playerHosts[id].empty()) {
+                std::format_to(std::back_inserter(list->text), " ({})", m_playerHosts[id]);
+            }
+            list->endLine();
+        }
+        who = {std::move(list), m_rosterVersion, now};
+    }
+    // The cached list itself, which a rebuild replaces rather than changes
+    return paged(player, linesOf(who.lines));
+}
+
+namespace {
+
+// "3 hours ago", or as near as is worth saying
+std::string timeAgo(std::uint64_t then) {
+    const std::uint64_t now = TickClock::wallSeconds();
+    const std::uint64_t ago = now > then ? now - then : 0;
+    if (ago >= 2 * 86'400) {
+        return std::format("{} days ago", ago / 86'400);
+    }
+    if (ago >= 2 * 3'600) {
+        return std::format("{} hours ago", ago / 3'600);
+    }
+    if (ago >= 2 * 60) {
+        return std::format("{} minutes ago", ago / 60);
+    }
+    return "moments ago";
+}
+
+bool isLetters(std::string_view name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    });
+}
+
+struct Board {
+    std::string_view name;
+    std::string_view description;
+};
+
+constexpr std::array<Board, 3> kBoards = {{
+    {"general", "News and talk for everyone."},
+    {"ideas", "What the game should have next."},
+    {"trade", "Things wanted and things for sale."},
+}};
+
+const Board* findBoard(std::string_view name) {
+    for (const Board& board : kBoards) {
+        if (board.name.size() == name.size()
+            && std::equal(name.begin(), name.end(), board.name.begin(),
+                          [](char a, char b) { return (a | 0x20) == b; })) {
+            return &board;
+        }
+    }
+    return nullptr;
+}
+
+std::string mailbox(std::string_view player) {
+    std::string folder = "mail/";
+    for (const char c : player) {
+        folder += static_cast<char>(c >= 'A' && c <= 'Z' ? c | 0x20 : c);
+    }
+    return folder;
+}
+
+// "subject | message", or just the message
+std::pair<std::string_view, std::string_view> splitSubject(std::string_view text) {
+    const auto trim = [](std::string_view part) {
+        while (!part.empty() && part.front() == ' ') {
+            part.remove_prefix(1);
+        }
+        while (!part.empty() && part.back() == ' ') {
+            part.remove_suffix(1);
+        }
+        return part;
+    };
+    const std::size_t bar = text.find('|');
+    if (bar == std::string_view::npos) {
+        return {"(no subject)", trim(text)};
+    }
+    return {trim(text.substr(0, bar)), trim(text.substr(bar + 1))};
+}
+
+// The 1-based number a player typed for a post among count, or 0
+std::size_t postNumber(std::string_view typed, std::size_t count) {
+    std::size_t number = 0;
+    const auto [end, ec] = std::from_chars(typed.data(), typed.data() + typed.size(), number);
+    return ec == std::errc() && end == typed.data() + typed.size() && number <= count ? number : 0;
+}
+
+} // namespace
+
+CommandResult GameEngine::handleFinger(PlayerId player, std::string_view name) {
+    const PlayerId target = m_playerIndex.find(name);
+    if (target != kInvalidPlayerId) {
+        return CommandResult::success(
+            Message<"{} is in the game, in {}.">::reply(m_players.name(target), m_world.name(m_players.room(target))));
+    }
+    // Saves are named for players, and players' names are letters
+    if (m_saveDirectory.empty() || !isLetters(name)) {
+        return CommandResult::error(Message<"No one called '{}' is in the game.">::reply(name));
+    }
+    // Their save is read off the game thread
+    return runAsync(player, fingerSaved(std::string(name)));
+}
+
+Task<CommandResult> GameEngine::fingerSaved(std::string name) {
+    struct LastSeen {
+        std::string name;
+        std::string room;
+        std::uint64_t savedAt = 0;
+    };
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(), [](char c) { return static_cast<char>(c | 0x20); });
+    const std::filesystem::path path = m_saveDirectory / (key + ".save");
+    const auto read = [path] {
+        const PlayerSave save = PlayerSave::open(path);
+        if (!save.valid()) {
+            return std::optional<LastSeen>();
+        }
+        return std::optional<LastSeen>(LastSeen{std::string(save.string(save.player().name)),
+                                                std::string(save.string(save.player().room)),
+                                                save.header().savedAt});
+    };
+    const std::optional<LastSeen> seen = co_await offload(read);
+    if (!seen) {
+        co_return CommandResult::error(Message<"No one called '{}' has played here.">::reply(name));
+    }
+    co_return CommandResult::success(Message<"{} is not in the game; they were last seen in {}, {}.">::reply(
+        seen->name, seen->room, timeAgo(seen->savedAt)));
+}
+
+CommandResult GameEngine::handleBoard(PlayerId player, std::string_view name, std::string_view rest) {
+    if (!m_messages) {
+        return CommandResult::error("There are no boards here.");
+    }
+    std::string text = ReplyPool::take();
+    if (name.empty()) {
+        text += "Boards:";
+        for (const Board& board : kBoards) {
+            const std::size_t posts = m_messages->folder(std::format("board/{}", board.name)).size();
+            std::format_to(std::back_inserter(text), "\n  {:<8} {:>4} post{}  {}", board.name, posts,
+                           posts == 1 ? " " : "s", board.description);
+        }
+        return CommandResult::success(std::move(text));
+    }
+    const Board* board = findBoard(name);
+    if (!board) {
+        return CommandResult::error(Message<"There is no board called '{}'.">::reply(name));
+    }
+    const std::string folder = std::format("board/{}", board->name);
+    const std::span<const MessageView> posts = m_messages->folder(folder);
+    if (rest.empty()) {
+        if (posts.empty()) {
+            return CommandResult::success(Message<"Nothing has been posted on {}.">::reply(board->name));
+        }
+        // Each post is looked up again as its line is paged to, so one
+        // removed meanwhile ends the list rather than being read freed
+        return paged(player, listLines(std::format("{}:", board->name), [this, folder](std::size_t i, std::string& line) {
+            const std::span<const MessageView> posts = m_messages->folder(folder);
+            if (i >= posts.size()) {
+                return false;
+            }
+            std::format_to(std::back_inserter(line), "  {:>3}. {} - {}, {}", i + 1, posts[i].subject(),
+                           posts[i].author(), timeAgo(posts[i].postedAt()));
+            return true;
+        }));
+    }
+    if (rest.starts_with("remove ")) {
+        const std::size_t number = postNumber(rest.substr(7), posts.size());
+        if (number == 0) {
+            return CommandResult::error(Message<"There is no post {} on {}.">::reply(rest.substr(7), board->name));
+        }
+        const std::string_view author = posts[number - 1].author();
+        const std::string_view self = m_players.name(player);
+        if (author.size() != self.size() || !std::equal(author.begin(), author.end(), self.begin(), [](char a, char b) {
+                return (a | 0x20) == (b | 0x20);
+            })) {
+            return CommandResult::error("You may only remove your own posts.");
+        }
+        if (!m_messages->remove(folder, number - 1)) {
+            return CommandResult::error("That post could not be removed.");
+        }
+        return CommandResult::success(Message<"Post {} removed from {}.">::reply(number, board->name));
+    }
+    const std::size_t number = postNumber(rest, posts.size());
+    if (number == 0) {
+        return CommandResult::error(Message<"There is no post {} on {}.">::reply(rest, board->name));
+    }
+    const MessageView& post = posts[number - 1];
+    std::format_to(std::back_inserter(text), "{} #{}: {}\nFrom {}, {}\n\n{}", board->name, number, post.subject(),
+                   post.author(), timeAgo(post.postedAt()), post.body());
+    return CommandResult::success(std::move(text));
+}
+
+CommandResult GameEngine::handlePost(PlayerId player, std::string_view name, std::string_view message) {
+    if (!m_messages) {
+        return CommandResult::error("There are no boards here.");
+    }
+    const Board* board = findBoard(name);
+    if (!board) {
+        return CommandResult::error(Message<"There is no board called '{}'.">::reply(name));
+    }
+    const auto [subject, body] = splitSubject(message);
+    if (subject.empty() || subject.size() > 60) {
+        return CommandResult::error("A subject takes 1 to 60 characters.");
+    }
+    const auto posted = m_messages->post(std::format("board/{}", board->name), m_players.name(player), subject,
+                                         body, TickClock::wallSeconds());
+    if (!posted) {
+        return CommandResult::error(posted.error());
+    }
+    return CommandResult::success(Message<"You post '{}' on {}.">::reply(subject, board->name));
+}
+
+CommandResult GameEngine::handleMail(PlayerId player, std::string_view what, std::string_view rest) {
+    if (!m_messages) {
+        return CommandResult::error("There is no mail here.");
+    }
+    const std::string folder = mailbox(m_players.name(player));
+    const std::span<const MessageView> letters = m_messages->folder(folder);
+    std::string text = ReplyPool::take();
+    if (what.empty()) {
+        if (letters.empty()) {
+            return CommandResult::success("You have no mail.");
+        }
+        // Formatted a page at a time, as the board list is
+        return paged(player, listLines(std::format("Your mail ({}):", letters.size()), [this, folder](std::size_t i,
+                                                                                               std::string& line) {
+            const std::span<const MessageView> letters = m_messages->folder(folder);
+            if (i >= letters.size()) {
+                return false;
+            }
+            std::format_to(std::back_inserter(line), "  {:>3}. {} - from {}, {}", i + 1, letters[i].subject(),
+                           letters[i].author(), timeAgo(letters[i].postedAt()));
+            return true;
+        }));
+    }
+    if (what == "remove") {
+        const std::size_t number = postNumber(rest, letters.size());
+        if (number == 0 || !m_messages->remove(folder, number - 1)) {
+            return CommandResult::error(Message<"You have no letter {}.">::reply(rest));
+        }
+        return CommandResult::success(Message<"Letter {} removed.">::reply(number));
+    }
+    if (what.front() >= '0' && what.front() <= '9') {
+        const std::size_t number = postNumber(what, letters.size());
+        if (number == 0) {
+            return CommandResult::error(Message<"You have no letter {}.">::reply(what));
+        }
+        const MessageView& letter = letters[number - 1];
+        std::format_to(std::back_inserter(text), "Letter {}: {}\nFrom {}, {}\n\n{}", number, letter.subject(),
+                       letter.author(), timeAgo(letter.postedAt()), letter.body());
+        return CommandResult::success(std::move(text));
+    }
+
+    // Mail for anyone with a name a player could have, in the game or not
+    if (!isLetters(what)) {
+        return CommandResult::error(Message<"'{}' is not a player's name.">::reply(what));
+    }
+    const auto [subject, body] = splitSubject(rest);
+    if (body.empty()) {
+        return CommandResult::error("Usage: mail <player> <subject> | <message>");
+    }
+    if (subject.empty() || subject.size() > 60) {
+        return CommandResult::error("A subject takes 1 to 60 characters.");
+    }
+    const PlayerId target = m_playerIndex.find(what);
+    const std::string_view to = target != kInvalidPlayerId ? m_players.name(target) : what;
+    const auto sent = m_messages->post(mailbox(to), m_players.name(player), subject, body, TickClock::wallSeconds());
+    if (!sent) {
+        return CommandResult::error(sent.error());
+    }
+    if (target != kInvalidPlayerId && target != player) {
+        sendToPlayer(target, std::format("You have new mail from {}.", m_players.name(player)));
+    }
+    return CommandResult::success(Message<"You send '{}' to {}.">::reply(subject, to));
+}
+
+CommandResult GameEngine::runAsync(PlayerId player, Task<CommandResult> task) {
+    try {
+        task.start();
+        if (task.done()) {
+            return task.take();
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Async command failed: {}", e.what());
+        return CommandResult::error("That command failed.");
+    }
+    m_asyncCommands.push_back({player, std::move(task)});
+    return CommandResult::success(std::string());
+}
+
+void GameEngine::setAsyncWake(std::function<void()> wake) {
+    m_asyncWake = std::move(wake);
+    if (m_async) {
+        m_async->setWake(m_asyncWake);
+    }
+}
+
+AsyncExecutor& GameEngine::asyncExecutor() {
+    // Workers mostly wait on files, so a couple keeps several commands moving
+    constexpr unsigned kAsyncThreads = 2;
+    if (!m_async) {
+        m_async = std::make_unique<AsyncExecutor>(kAsyncThreads, m_asyncWake);
+    }
+    return *m_async;
+}
+
+void GameEngine::finishAsyncCommands() {
+    std::erase_if(m_asyncCommands, [this](AsyncCommand& command) {
+        if (!command.task.done()) {
+            return false;
+        }
+        try {
+            CommandResult result = command.task.take();
+            if (command.player != kInvalidPlayerId && !result.message.empty()) {
+                sendToPlayer(command.player, std::move(result.message));
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Async command failed: {}", e.what());
+            if (command.player != kInvalidPlayerId) {
+                sendToPlayer(command.player, "That command failed.");
+            }
+        }
+        return true;
+    });
+}
+
+void GameEngine::indexPlayers() {
+    m_playerIndex.clear();
+    for (PlayerId id = 0; id < m_players.capacity(); ++id) {
+        if (m_players.isActive(id)) {
+            m_playerIndex.insert(m_players.nameKey(id), id);
+        }
+    }
+    ++m_rosterVersion;
+}
+
+void GameEngine::sendToChannel(ChannelId channel, std::string_view message, PlayerId except) {
+    if (channel >= m_channels.size()) {
+        return;
+    }
+    // Other zones' players are another actor's to touch
+    if (ZoneActor* actor = t_zone) {
+        actor->effects.push_back({ZoneEffect::Kind::ChannelSend, except, channel, kInvalidRoomId, Direction::Count,
+                                  std::pmr::string(message, &actor->scratch->resource())});
+        return;
+    }
+    // A player spoke, rather than another shard relaying what was said there
+    if (except != kInvalidPlayerId && m_channelRelay) {
+        m_channelRelay(m_channels.channel(channel).name, message);
+    }
+    // One pass over the set bits, everyone sharing the one copy; the front
+    // end hands each reactor its share in the tick's one batch
+    SharedMessage shared;
+    m_channels.forEachListener(channel, [&](PlayerId player) {
+        if (player != except && m_players.isActive(player)) {
+            if (!shared) {
+                shared = makeSharedMessage(std::string(message));
+            }
+            queueMessage(player, shared);
+        }
+    });
+}
+
+void GameEngine::broadcastToZone(ZoneId zone, std::string_view message, PlayerId except) {
+    if (ZoneActor* actor = t_zone) {
+        actor->effects.push_back({ZoneEffect::Kind::ZoneBroadcast, except, zone, kInvalidRoomId, Direction::Count,
+                                  std::pmr::string(message, &actor->scratch->resource())});
+        return;
+    }
+    SharedMessage shared;
+    m_players.forEachInZone(zone, [&](PlayerId player) {
+        if (player != except) {
+            if (!shared) {
+                shared = makeSharedMessage(std::string(message));
+            }
+            queueMessage(player, shared);
+        }
+    });
+}
+
+PlayerId GameEngine::findPlayerInRoom(RoomId room, std::string_view name) const {
+    PlayerId found = kInvalidPlayerId;
+    if (room == kInvalidRoomId) {
+        return found;
+    }
+    // A name no player has ever had is no one's; otherwise an integer compare
+    const Symbol key = StringInterner::global().find(PlayerRegistry::foldedName(name));
+    if (key == kNoSymbol) {
+        return found;
+    }
+    m_players.forEachInRoom(room, [&](PlayerId player) {
+        if (found == kInvalidPlayerId && m_players.nameKey(player) == key) {
+            found = player;
+        }
+    });
+    return found;
+}
+
+// Only items can be picked up, so `get 2.sword` counts the swords lying
+// here and not a creature called one
+Entity GameEngine::findInRoom(RoomId room, std::string_view name) const {
+    return roomContents(room).find(KeywordIndex::parse(name),
+                                   [this](Entity entity) { return m_entities.has<Item>(entity); });
+}
+
+// A handful of items, so a scan, but of interned keywords rather than names
+Entity GameEngine::findCarried(Entity holder, std::string_view name) const {
+    const Inventory* inventory = m_entities.find<Inventory>(holder);
+    const KeywordIndex::Target target = KeywordIndex::parse(name);
+    if (!inventory || target.keyword == kNoSymbol) {
+        return kInvalidEntity;
+    }
+    std::size_t left = target.nth;
+    for (Entity item : inventory->items) {
+        const Keywords* keywords = m_entities.find<Keywords>(item);
+        if (keywords && std::ranges::find(keywords->symbols, target.keyword) != keywords->symbols.end() &&
+            --left == 0) {
+            return item;
+        }
+    }
+    return kInvalidEntity;
+}
+
+void GameEngine::placeInRoom(Entity entity, RoomId room) {
+    const Keywords* keywords = m_entities.find<Keywords>(entity);
+    if (InRoom* where = m_entities.find<InRoom>(entity)) {
+        // Moved in place, so it keeps its spot among what the room lists
+        if (keywords && where->room < m_roomContents.size()) {
+            m_roomContents[where->room].remove(entity, *keywords);
+        }
+        where->room = room;
+    } else {
+        m_entities.add<InRoom>(entity, room);
+    }
+    if (keywords) {
+        if (m_roomContents.size() <= room) {
+            m_roomContents.resize(std::max<std::size_t>(m_world.size(), room + 1));
+        }
+        m_roomContents[room].add(entity, *keywords);
+    }
+}
+
+void GameEngine::removeFromRoom(Entity entity) {
+    const InRoom* where = m_entities.find<InRoom>(entity);
+    if (!where) {
+        return;
+    }
+    const Keywords* keywords = m_entities.find<Keywords>(entity);
+    if (keywords && where->room < m_roomContents.size()) {
+        m_roomContents[where->room].remove(entity, *keywords);
+    }
+    m_entities.remove<InRoom>(entity);
+}
+
+void GameEngine::carry(Entity holder, Entity item) {
+    Inventory* inventory = m_entities.find<Inventory>(holder);
+    if (!inventory || !m_entities.alive(item)) {
+        return;
+    }
+    if (const InRoom* where = m_entities.find<InRoom>(item)) {
+        touchRoom(where->room);
+    }
+    removeFromRoom(item);
+    inventory->items.push_back(item);
+    m_entities.add<CarriedBy>(item, holder);
+    markDirty(holder);
+    invalidateStats(holder);
+}
+
+void GameEngine::putDown(Entity item, RoomId room) {
+    if (const InRoom* where = m_entities.find<InRoom>(item)) {
+        touchRoom(where->room);
+    }
+    if (const CarriedBy* carried = m_entities.find<CarriedBy>(item)) {
+        if (Inventory* inventory = m_entities.find<Inventory>(carried->holder)) {
+            inventory->items.eraseValue(item);
+        }
+        markDirty(carried->holder);
+        invalidateStats(carried->holder);
+        m_entities.remove<CarriedBy>(item);
+    }
+    if (room == kInvalidRoomId) {
+        removeFromRoom(item);
+        m_entities.destroy(item);
+    } else {
+        placeInRoom(item, room);
+        touchRoom(room);
+    }
+}
+
+CommandResult GameEngine::handleGet(PlayerId player, std::string_view item) {
+    const RoomId room = m_players.room(player);
+    const Entity found = findInRoom(room, item);
+    // NPCs are in rooms too, but only items can be picked up
+    if (found == kInvalidEntity || !m_entities.has<Item>(found)) {
+        return CommandResult::error(Message<"You don't see '{}' here.">::reply(item));
+    }
+    const std::string_view name = nameOf(found);
+    carry(playerBody(player), found);
+    broadcastToRoom(room, Message<"{} picks up the {}.">::in(scratch(), m_players.name(player), name), player);
+    return CommandResult::success(Message<"You pick up the {}.">::reply(name));
+}
+
+CommandResult GameEngine::handleDrop(PlayerId player, std::string_view item) {
+    const Entity found = findCarried(playerBody(player), item);
+    if (found == kInvalidEntity) {
+        return CommandResult::error(Message<"You aren't carrying '{}'.">::reply(item));
+    }
+    const std::string_view name = nameOf(found);
+    const RoomId room = m_players.room(player);
+    putDown(found, room);
+    broadcastToRoom(room, Message<"{} drops the {}.">::in(scratch(), m_players.name(player), name), player);
+    return CommandResult::success(Message<"You drop the {}.">::reply(name));
+}
+
+CommandResult GameEngine::handleInventory(PlayerId player) const {
+    const Inventory* inventory = m_entities.find<Inventory>(playerBody(player));
+    std::string response = ReplyPool::take();
+    if (inventory) {
+        for (Entity item : inventory->items) {
+            response += response.empty() ? "You are carrying: " : ", ";
+            response += nameOf(item);
+        }
+    }
+    // Into the same buffer either way, so it goes back to the pool with the reply
+    if (response.empty()) {
+        response += "You are carrying nothing";
+    }
+    response += '.';
+    return CommandResult::success(std::move(response));
+}
+
+CommandResult GameEngine::lookAround(PlayerId player) {
+    const RoomId room = m_players.room(player);
+    if (!t_zone && m_roomViews.size() < m_world.size()) {
+        m_roomViews.resize(m_world.size());
+    }
+    std::string response = ReplyPool::take();
+    RoomView scratch;
+    RoomView& view = room < m_roomViews.size() ? m_roomViews[room] : scratch;
+    if (view.renderedVersion != view.version || view.renderedWorld != m_world.version()) {
+        renderRoomView(room, view);
+    }
+    response += view.text;
+    
+    // Everyone here but the viewer, cut out of the shared list
+    const auto self = std::find_if(view.spans.begin(), view.spans.end(),
+                                   [player](const RoomView::Occupant& occupant) { return occupant.player == player; });
+    if (self == view.spans.end()) {
+        response += view.occupants;
+    } else if (view.spans.size() > 1) {
+        const std::string_view occupants = view.occupants;
+        response += occupants.substr(0, self->begin);
+        response += occupants.substr(self->end);
+    }
+    return CommandResult::success(std::move(response));
+}
+
+// The zone's tile copied around the player, with only the markers drawn per view
+CommandResult GameEngine::handleMap(PlayerId player) {
+    std::string response = ReplyPool::take();
+    const auto others = [this](RoomId room) -> char { return m_players.occupantCount(room) > 0 ? '*' : '\0'; };
+    if (!m_map.render(m_world, m_players.room(player), others, response, !t_zone)) {
+        return CommandResult::error("You cannot make out a map of this place.");
+    }
+    response += "@ you   * other players";
+    return CommandResult::success(std::move(response));
+}
+
+void GameEngine::renderRoomView(RoomId room, RoomView& view) const {
+    view.renderedVersion = view.version;
+    view.renderedWorld = m_world.version();
+    
+    const std::string_view name = m_world.name(room);
+    view.text.clear();
+    std::format_to(std::back_inserter(view.text), "You are in: {}\n\n", name.empty() ? "an unknown location" : name);
+    // The room's description, stored once in the room graph or packed
+    const std::size_t described = view.text.size();
+    appendDescription(room, view.text);
+    if (view.text.size() == described) {
+        view.text += "This area has not been fully explored yet. There are exits in various directions.";
+    }
+    
+    // Then whatever lies here or wanders about
+    std::size_t seen = 0;
+    m_entities.each<InRoom>([&](Entity entity, const InRoom& where) {
+        const std::string_view thing = where.room == room ? nameOf(entity) : std::string_view();
+        if (!thing.empty()) {
+            view.text += seen++ == 0 ? "\n\nYou see: " : ", ";
+            view.text += thing;
+        }
+    });
+    if (seen > 0) {
+        view.text += '.';
+    }
+    
+    // Each player's span takes the separator after it, the last one the
+    // separator before it, so cutting any one out leaves a proper list
+    view.occupants.clear();
+    view.spans.clear();
+    m_players.forEachInRoom(room, [&](PlayerId occupant) {
+        if (view.spans.empty()) {
+            view.occupants += "\n\nAlso here: ";
+        } else {
+            view.spans.back().end = static_cast<std::uint32_t>(view.occupants.size() + 2);
+            view.occupants += ", ";
+        }
+        const auto begin = static_cast<std::uint32_t>(view.occupants.size());
+        view.occupants += m_players.name(occupant);
+        view.spans.push_back({occupant, begin, static_cast<std::uint32_t>(view.occupants.size())});
+    });
+    if (view.spans.size() > 1) {
+        RoomView::Occupant& last = view.spans.back();
+        last.begin = view.spans[view.spans.size() - 2].end - 2;
+    }
+    if (!view.spans.empty()) {
+        view.occupants += '.';
+    }
+}
+
+// Text the graph holds wins, so a packed room given a description since
+// shows that; instance rooms read their prototype's frame
+void GameEngine::appendDescription(RoomId room, std::string& out) const {
+    const std::string_view description = m_world.description(room);
+    if (!description.empty()) {
+        out += description;
+    } else if (m_descriptions) {
+        m_descriptions->append(prototypeRoom(room), out);
+    }
+}
+
+std::string GameEngine::roomDescription(RoomId room) const {
+    std::string description;
+    appendDescription(room, description);
+    return description;
+}
+
+DescriptionStats GameEngine::descriptionStats() const {
+    return m_descriptions ? m_descriptions->stats() : DescriptionStats{};
+}
+
+Entity GameEngine::spawnItem(const ItemPrototype& prototype, RoomId room) {
+    const Entity item = m_entities.create();
+    m_entities.add<Item>(item, &prototype);
+    m_entities.add<Keywords>(item, KeywordIndex::keywordsOf(prototype.name));
+    placeInRoom(item, room);
+    touchRoom(room);
+    if (prototype.decayTicks > 0) {
+        m_entities.add<Decay>(item, prototype.decayTicks);
+        wakeSystems();
+    }
+    return item;
+}
+
+std::string_view GameEngine::nameOf(Entity entity) const {
+    if (const Item* item = m_entities.find<Item>(entity)) {
+        return item->prototype->name;
+    }
+    const Named* named = m_entities.find<Named>(entity);
+    return named ? StringInterner::global().view(named->name) : std::string_view();
+}
+
+Entity GameEngine::spawnNpc(std::string_view name, RoomId room, Health health, std::uint32_t wanderTicks) {
+    const Entity npc = m_entities.create();
+    m_entities.add<Keywords>(npc, KeywordIndex::keywordsOf(name));
+    m_entities.add<Named>(npc, StringInterner::global().intern(name));
+    placeInRoom(npc, room);
+    touchRoom(room);
+    Npc state{wanderTicks, 0, static_cast<std::uint32_t>(m_random.next()) | 1u, m_behaviors.forNpc(name)};
+    state.nextMove = m_ticks.boundary() + npcPeriod(state);
+    m_entities.add<Npc>(npc, state);
+    m_entities.add<Health>(npc, health);
+    if (health.current < health.max) {
+        wakeSystems();
+    }
+    const ZoneId zone = m_world.zone(room);
+    npcZone(zone).npcs.push_back(npc);
+    if (m_players.zoneOccupantCount(zone) > 0) {
+        wakeZone(zone);
+        scheduleNpcs(zone);
+    }
+    return npc;
+}
+
+void GameEngine::movePlayer(PlayerId player, RoomId to) {
+    movePlayers({&player, 1}, to);
+}
+
+void GameEngine::movePlayers(std::span<const PlayerId> players, RoomId to) {
+    const RoomId fromRoom = m_players.room(players.front());
+    const ZoneId from = m_players.zone(players.front());
+    const ZoneId zone = m_world.zone(to);
+    // Before anyone arrives, so the zone wakes once with everything in it
+    loadZone(zone);
+    touchRoom(fromRoom);
+    touchRoom(to);
+    for (const PlayerId player : players) {
+        m_events.publish(PlayerMoved{player, fromRoom, to});
+        m_players.setRoom(player, to, zone);
+        m_dirty[player] = 1;
+    }
+    if (zone != from) {
+        if (m_players.zoneOccupantCount(from) == 0) {
+            sleepZone(from);
+        }
+        wakeZone(zone);
+    }
+    if (m_prefetcher) {
+        prefetchAround(to);
+    }
+#ifdef ENABLE_LUA_SCRIPTING
+    if (ScriptRunnerPool* scripts = scriptEvents(ScriptEvent::EnterRoom)) {
+        for (const PlayerId player : players) {
+            scripts->emitEnterRoom({this, player}, {this, to});
+        }
+    }
+#endif
+}
+
+// Followers standing with the leader each have their hook asked, then all
+// of them move at once; each room is told of the group in one message, and
+// the room they arrive in is rendered once for all of them to look at
+void GameEngine::moveGroup(const MoveEvent& move) {
+    SmallVector<PlayerId, 16> group;
+    group.push_back(move.player);
+    for (const PlayerId follower : m_followers[move.player]) {
+        if (m_players.room(follower) != move.from) {
+            continue;   // Left behind some other way
+        }
+        if (m_hooks.run(HookPhase::Before, MoveEvent{follower, move.direction, move.from, move.to}) ==
+            HookDecision::Block) {
+            sendToPlayer(follower, Message<"You feel a mysterious force preventing you from following {}.">::reply(
+                                       m_players.name(move.player)));
+            continue;
+        }
+        group.push_back(follower);
+    }
+    const std::span<const PlayerId> members(group.data(), group.size());
+    if (members.size() == 1) {
+        movePlayer(move.player, move.to);
+        m_hooks.run(HookPhase::After, move);
+        return;
+    }
+
+    // "Bob", "Bob and Carl", "Bob, Carl and Dora"
+    std::string followers;
+    for (std::size_t i = 1; i < members.size(); ++i) {
+        followers += i == 1 ? "" : i + 1 == members.size() ? " and " : ", ";
+        followers += m_players.name(members[i]);
+    }
+    const std::string_view leader = m_players.name(move.player);
+    const std::string_view direction = directionName(move.direction);
+    broadcastToRoom(move.to, std::format("{} arrives, leading {}.", leader, followers));
+    movePlayers(members, move.to);
+    broadcastToRoom(move.from, std::format("{} leads {} {}.", leader, followers, direction));
+    for (const PlayerId follower : members.subspan(1)) {
+        std::string text = Message<"You follow {} {}.\n">::reply(leader, direction);
+        text += lookAround(follower).message;
+        sendToPlayer(follower, std::move(text));
+    }
+    for (const PlayerId member : members) {
+        m_hooks.run(HookPhase::After, MoveEvent{member, move.direction, move.from, move.to});
+    }
+}
+
+GameEngine::NpcZone& GameEngine::npcZone(ZoneId zone) {
+    if (zone >= m_npcZones.size()) {
+        m_npcZones.resize(static_cast<std::size_t>(zone) + 1);
+    }
+    if (!m_npcZones[zone]) {
+        m_npcZones[zone] = std::make_unique<NpcZone>();
+        m_npcZones[zone]->timer.setCallback([this, zone] { runNpcs(zone); });
+        m_npcZones[zone]->unloadTimer.setCallback([this, zone] { unloadZone(zone); });
+        m_npcZones[zone]->resetTimer.setCallback([this, zone] { resetZone(zone); });
+    }
+    return *m_npcZones[zone];
+}
+
+void GameEngine::loadZone(ZoneId zone) {
+    if (zone >= m_zoneLoaded.size() || m_zoneLoaded[zone]) {
+        return;
+    }
+    m_zoneLoaded[zone] = 1;
+    m_map.prepare(m_world, zone);
+    NpcZone& record = npcZone(zone);
+    // An instance spawns from its prototype's records, into its own rooms
+    const ZoneInstance* instance = instanceOf(zone);
+    // Records a prefetch has checked are not checked, or read in, again
+    std::optional<AreaFile::Zone> contents = m_prefetcher && !instance ? m_prefetcher->take(zone) : std::nullopt;
+    if (!contents) {
+        contents = m_area.zone(instance ? instance->prototype : zone);
+    }
+    if (!contents) {
+        if (m_area.valid()) {
+            LOG_WARN("Area zone {} is damaged; it stays empty", zone);
+        }
+        return;
+    }
+    record.records = *contents;
+    const std::size_t count = contents->items.size() + contents->npcs.size();
+    record.spawned.assign(count, kInvalidEntity);
+    record.pending.resize(count);
+    std::iota(record.pending.rbegin(), record.pending.rend(), std::uint32_t{0});
+    ++m_npcStats.zonesLoaded;
+    m_ticks.schedule(record.resetTimer, kZoneResetTicks);
+    queueRepop(record, zone);
+    // The arriving player finds a small zone whole and a large one filling in
+    repopZone(zone, kRepopPerTick);
+}
+
+// Every so often, queue again the records whose NPC has died or whose item
+// has been carried off or destroyed
+void GameEngine::resetZone(ZoneId zone) {
+    if (zone >= m_zoneLoaded.size() || !m_zoneLoaded[zone]) {
+        return;
+    }
+    NpcZone& record = npcZone(zone);
+    m_ticks.schedule(record.resetTimer, kZoneResetTicks);
+    if (!record.pending.empty()) {
+        return;
+    }
+    for (std::size_t index = record.spawned.size(); index-- > 0;) {
+        const Entity entity = record.spawned[index];
+        const InRoom* where = m_entities.alive(entity) ? m_entities.find<InRoom>(entity) : nullptr;
+        if (!where || m_world.zone(where->room) != zone) {
+            record.spawned[index] = kInvalidEntity;
+            record.pending.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+    queueRepop(record, zone);
+}
+
+void GameEngine::queueRepop(NpcZone& record, ZoneId zone) {
+    if (record.pending.empty() || record.queued) {
+        return;
+    }
+    record.queued = true;
+    m_repopQueue.push_back(zone);
+    if (m_repopUpdate == kInvalidTickUpdateId) {
+        m_repopUpdate = m_ticks.addUpdate(1, [this](std::uint64_t) { runRepop(); });
+    }
+}
+
+// Spawn up to budget of a zone's pending records; returns how many it took
+std::size_t GameEngine::repopZone(ZoneId zone, std::size_t budget) {
+    NpcZone& record = npcZone(zone);
+    const auto started = std::chrono::steady_clock::now();
+    const std::size_t items = record.records.items.size();
+    std::size_t done = 0;
+    for (; done < budget && !record.pending.empty(); ++done) {
+        const std::uint32_t index = record.pending.back();
+        record.pending.pop_back();
+        if (index < items) {
+            const AreaItem& item = record.records.items[index];
+            if (const ItemPrototype* prototype = m_areaPrototypes[item.prototype]) {
+                record.spawned[index] = spawnItem(*prototype, instanceRoom(zone, item.room));
+            }
+        } else {
+            const AreaNpc& npc = record.records.npcs[index - items];
+            record.spawned[index] = spawnNpc(m_area.string(npc.name), instanceRoom(zone, npc.room),
+                                             Health{npc.health, npc.maxHealth, npc.regen}, npc.wanderTicks);
+        }
+    }
+    if (done > 0) {
+        const auto took = std::chrono::steady_clock::now() - started;
+        const std::lock_guard<std::mutex> lock(m_repopStatsMutex);
+        if (zone >= m_repopStats.size()) {
+            m_repopStats.resize(static_cast<std::size_t>(zone) + 1);
+        }
+        ZoneRepopStats& stats = m_repopStats[zone];
+        stats.spawned += done;
+        ++stats.slices;
+        stats.time += std::chrono::duration_cast<std::chrono::nanoseconds>(took);
+    }
+    return done;
+}
+
+// One tick's slice of spawning: zones someone can see first, then the rest
+// in the order they asked, kRepopPerTick records in all
+void GameEngine::runRepop() {
+    std::size_t budget = kRepopPerTick;
+    for (const bool occupied : {true, false}) {
+        for (std::size_t i = 0; i < m_repopQueue.size() && budget > 0; ++i) {
+            const ZoneId zone = m_repopQueue[i];
+            if ((m_players.zoneOccupantCount(zone) > 0) == occupied) {
+                budget -= repopZone(zone, budget);
+            }
+        }
+    }
+    std::erase_if(m_repopQueue, [this](ZoneId zone) {
+        NpcZone& record = npcZone(zone);
+        if (!record.pending.empty()) {
+            return false;
+        }
+        record.queued = false;
+        return true;
+    });
+    if (m_repopQueue.empty()) {
+        m_ticks.removeUpdate(std::exchange(m_repopUpdate, kInvalidTickUpdateId));
+    }
+}
+
+// Walk up to m_prefetchRooms exits out from room and submit each area zone
+// not yet loaded that the walk reaches, with the rooms of it reached first
+void GameEngine::prefetchAround(RoomId room) {
+    if (m_prefetchSeen.size() < m_world.size()) {
+        m_prefetchSeen.resize(m_world.size(), 0);
+    }
+    if (++m_prefetchWalk == 0) {
+        std::ranges::fill(m_prefetchSeen, 0);
+        m_prefetchWalk = 1;
+    }
+    struct Cold {
+        ZoneId zone;
+        RoomId room;
+    };
+    SmallVector<Cold, 16> cold;
+    m_prefetchQueue.assign(1, {room, 0u});
+    m_prefetchSeen[room] = m_prefetchWalk;
+    for (std::size_t next = 0; next < m_prefetchQueue.size(); ++next) {
+        const auto [at, steps] = m_prefetchQueue[next];
+        const ZoneId zone = m_world.zone(at);
+        if (zone < m_zonePrefetched.size() && !m_zoneLoaded[zone] && !m_zonePrefetched[zone]) {
+            cold.push_back({zone, at});
+        }
+        if (steps == m_prefetchRooms) {
+            continue;
+        }
+        for (const RoomId to : m_world.exits(at)) {
+            if (to != kInvalidRoomId && m_prefetchSeen[to] != m_prefetchWalk) {
+                m_prefetchSeen[to] = m_prefetchWalk;
+                m_prefetchQueue.push_back({to, steps + 1});
+            }
+        }
+    }
+
+    // A zone at a time, its rooms nearest first
+    std::stable_sort(cold.begin(), cold.end(), [](const Cold& a, const Cold& b) { return a.zone < b.zone; });
+    for (auto first = cold.begin(); first != cold.end();) {
+        SmallVector<RoomId, 16> rooms;
+        auto last = first;
+        for (; last != cold.end() && last->zone == first->zone; ++last) {
+            rooms.push_back(last->room);
+        }
+        m_zonePrefetched[first->zone] = m_prefetcher->submit(first->zone, {rooms.data(), rooms.size()}) ? 1 : 0;
+        first = last;
+    }
+}
+
+// Take back what a zone's records spawned, unless it has left the zone, so
+// the next player to come finds it as the file has it
+void GameEngine::unloadZone(ZoneId zone) {
+    if (zone >= m_zoneLoaded.size() || !m_zoneLoaded[zone] || m_players.zoneOccupantCount(zone) > 0) {
+        return;
+    }
+    if (zone < m_zonePrefetched.size()) {
+        m_zonePrefetched[zone] = 0;
+    }
+    NpcZone& record = npcZone(zone);
+    record.resetTimer.cancel();
+    if (record.queued) {
+        std::erase(m_repopQueue, zone);
+        record.queued = false;
+    }
+    for (Entity entity : record.spawned) {
+        const InRoom* where = m_entities.alive(entity) ? m_entities.find<InRoom>(entity) : nullptr;
+        if (where && m_world.zone(where->room) == zone) {
+            despawn(entity);
+        }
+    }
+    if (instanceOf(zone)) {
+        closeInstance(zone);
+    }
+    // NPCs made some other way stay, and are copied out of the pool while it goes
+    std::vector<Entity> staying;
+    std::copy_if(record.npcs.begin(), record.npcs.end(), std::back_inserter(staying),
+                 [this](Entity npc) { return m_entities.alive(npc); });
+    record.npcs = std::pmr::vector<Entity>(&record.memory);
+    record.spawned = std::pmr::vector<Entity>(&record.memory);
+    record.pending = std::pmr::vector<std::uint32_t>(&record.memory);
+    record.records = {};
+    record.memory.release();
+    record.npcs.assign(staying.begin(), staying.end());
+    m_zoneLoaded[zone] = 0;
+    ++m_npcStats.zonesUnloaded;
+}
+
+// Take an NPC or item out of the world for good, with what it carries
+void GameEngine::despawn(Entity entity) {
+    if (const InRoom* where = m_entities.find<InRoom>(entity)) {
+        touchRoom(where->room);
+    }
+    m_combat.remove(entity);
+    if (Inventory* inventory = m_entities.find<Inventory>(entity)) {
+        for (Entity item : std::exchange(inventory->items, {})) {
+            putDown(item, kInvalidRoomId);
+        }
+    }
+    removeFromRoom(entity);
+    m_entities.destroy(entity);
+}
+
+const GameEngine::ZoneInstance* GameEngine::instanceOf(ZoneId zone) const {
+    return zone < m_instances.size() && m_instances[zone].first != kInvalidRoomId ? &m_instances[zone] : nullptr;
+}
+
+std::expected<ZoneId, std::string> GameEngine::createInstance(ZoneId prototype) {
+    if (instanceOf(prototype)) {
+        return std::unexpected("An instance cannot be copied in turn.");
+    }
+    std::vector<RoomId>& rooms = m_zoneRooms[prototype];
+    if (rooms.empty()) {
+        const RoomId end = m_instanceBase != kInvalidRoomId ? m_instanceBase : static_cast<RoomId>(m_world.size());
+        for (RoomId room = 0; room < end; ++room) {
+            if (m_world.zone(room) == prototype) {
+                rooms.push_back(room);
+            }
+        }
+        if (rooms.empty()) {
+            m_zoneRooms.erase(prototype);
+            return std::unexpected("That zone has no rooms to copy.");
+        }
+    }
+
+    // A closed instance of the zone lends its rooms and zone; failing one,
+    // the copies go on the end, in a zone this shard runs
+    ZoneId zone = 0;
+    const auto closed = std::find_if(m_instances.begin(), m_instances.end(), [prototype](const ZoneInstance& each) {
+        return each.first != kInvalidRoomId && !each.open && each.prototype == prototype;
+    });
+    if (closed != m_instances.end()) {
+        zone = static_cast<ZoneId>(closed - m_instances.begin());
+        ++m_instanceStats.reused;
+    } else {
+        std::size_t next = std::max(m_world.zoneCount(), m_instances.size());
+        while (next < std::numeric_limits<ZoneId>::max() && !m_shard.owns(static_cast<ZoneId>(next))) {
+            ++next;
+        }
+        if (next >= std::numeric_limits<ZoneId>::max()) {
+            return std::unexpected("There is no room for another instance.");
+        }
+        zone = static_cast<ZoneId>(next);
+        if (m_instanceBase == kInvalidRoomId) {
+            m_instanceBase = static_cast<RoomId>(m_world.size());
+        }
+        m_instances.resize(next + 1);
+        m_instances[zone] = {prototype, static_cast<RoomId>(m_world.size()), false};
+        for (const RoomId room : rooms) {
+            m_world.addCopy(room, zone);
+        }
+        m_zoneLoaded.resize(std::max(m_zoneLoaded.size(), next + 1), 0);
+        m_instanceStats.rooms += rooms.size();
+    }
+
+    // The prototype's exits, turned to the copies where they stay in the
+    // zone; those leaving it lead back out into the world. Anything the last
+    // instance changed is put back
+    ZoneInstance& instance = m_instances[zone];
+    instance.open = true;
+    for (std::size_t i = 0; i < rooms.size(); ++i) {
+        for (std::size_t dir = 0; dir < kDirectionCount; ++dir) {
+            const RoomId to = m_world.exit(rooms[i], static_cast<Direction>(dir));
+            m_world.link(instance.first + static_cast<RoomId>(i), static_cast<Direction>(dir),
+                         to == kInvalidRoomId ? to : instanceRoom(zone, to));
+        }
+    }
+    ++m_instanceStats.created;
+    ++m_instanceStats.live;
+    return zone;
+}
+
+RoomId GameEngine::instanceRoom(ZoneId instance, RoomId room) const {
+    const ZoneInstance* copy = instanceOf(instance);
+    if (!copy || m_world.zone(room) != copy->prototype) {
+        return room;
+    }
+    const std::vector<RoomId>& rooms = m_zoneRooms.at(copy->prototype);
+    const auto found = std::lower_bound(rooms.begin(), rooms.end(), room);
+    return copy->first + static_cast<RoomId>(found - rooms.begin());
+}
+
+// The prototype room an instance's room copies; room itself outside any instance
+RoomId GameEngine::prototypeRoom(RoomId room) const {
+    const ZoneInstance* copy = instanceOf(m_world.zone(room));
+    return copy ? m_zoneRooms.at(copy->prototype)[room - copy->first] : room;
+}
+
+// Whatever players left in an instance goes with it, since nobody can
+// reach it again; its rooms wait for the next instance of the zone
+void GameEngine::closeInstance(ZoneId zone) {
+    std::vector<Entity> left;
+    std::as_const(m_entities).each<InRoom>([&](Entity entity, const InRoom& where) {
+        if (m_world.zone(where.room) == zone) {
+            left.push_back(entity);
+        }
+    });
+    for (const Entity entity : left) {
+        despawn(entity);
+    }
+    m_instances[zone].open = false;
+    --m_instanceStats.live;
+    ++m_instanceStats.closed;
+}
+
+CommandResult GameEngine::handleInstance(PlayerId player, std::string_view who) {
+    const RoomId room = m_players.room(player);
+    const ZoneId zone = m_world.zone(room);
+    if (who == "leave") {
+        if (!instanceOf(zone)) {
+            return CommandResult::error("You are not in an instance.");
+        }
+        const RoomId to = prototypeRoom(room);
+        movePlayer(player, to);
+        return CommandResult::success(Message<"You step back out into {}.">::reply(m_world.name(to)));
+    }
+    if (instanceOf(zone)) {
+        return CommandResult::error("You are in an instance already; type 'instance leave' first.");
+    }
+
+    // Alone, a fresh copy of the zone; naming a player, the copy they are
+    // in, which makes a group of whoever follows them
+    ZoneId into = zone;
+    if (who.empty()) {
+        auto created = createInstance(zone);
+        if (!created) {
+            return CommandResult::error(std::move(created.error()));
+        }
+        into = *created;
+    } else {
+        const PlayerId leader = m_playerIndex.find(who);
+        if (leader == kInvalidPlayerId) {
+            return CommandResult::error(Message<"No one called '{}' is in the game.">::reply(who));
+        }
+        const ZoneInstance* theirs = instanceOf(m_players.zone(leader));
+        if (!theirs || theirs->prototype != zone) {
+            return CommandResult::error(Message<"{} is not in a copy of this area.">::reply(m_players.name(leader)));
+        }
+        into = m_players.zone(leader);
+    }
+    const RoomId to = instanceRoom(into, room);
+    movePlayer(player, to);
+    return CommandResult::success(Message<"You step into a copy of {} all your own.">::reply(m_world.name(to)));
+}
+
+void GameEngine::wakeZone(ZoneId zone) {
+    // Most zones have nobody in them, and many have no NPCs either
+    if (zone >= m_npcZones.size() || !m_npcZones[zone]) {
+        return;
+    }
+    m_npcZones[zone]->unloadTimer.cancel();
+    if (m_npcZones[zone]->awake) {
+        return;
+    }
+    // A random walk forgets where it started after a few steps, so a zone
+    // that slept for hours costs no more to catch up than one that napped
+    constexpr std::uint64_t kMaxCatchUpMoves = 8;
+    
+    NpcZone& npcs = *m_npcZones[zone];
+    npcs.awake = true;
+    ++m_npcStats.zoneWakes;
+    const std::uint64_t now = m_ticks.boundary();
+    for (Entity npc : npcs.npcs) {
+        Npc* state = m_entities.find<Npc>(npc);
+        const std::uint32_t period = state ? npcPeriod(*state) : 0;
+        if (period == 0 || state->nextMove > now) {
+            continue;
+        }
+        // A tree acts on what is around it, so it only runs while someone is
+        const std::uint64_t missed = (now - state->nextMove) / period + 1;
+        for (std::uint64_t i = 0; state->behavior == kNoBehavior && i < std::min(missed, kMaxCatchUpMoves); ++i) {
+            m_npcStats.caughtUp += wander(npc, *state, false) ? 1 : 0;
+        }
+        state->nextMove += missed * period;
+    }
+    scheduleNpcs(zone);
+}
+
+void GameEngine::sleepZone(ZoneId zone) {
+    if (zone < m_npcZones.size() && m_npcZones[zone]) {
+        m_npcZones[zone]->awake = false;
+        m_npcZones[zone]->timer.cancel();
+        if (zone < m_zoneLoaded.size() && m_zoneLoaded[zone]) {
+            m_ticks.schedule(m_npcZones[zone]->unloadTimer, kZoneUnloadTicks);
+        }
+    }
+}
+
+void GameEngine::scheduleNpcs(ZoneId zone) {
+    NpcZone& npcs = *m_npcZones[zone];
+    std::erase_if(npcs.npcs, [this](Entity npc) { return !m_entities.alive(npc); });
+    std::uint64_t next = std::numeric_limits<std::uint64_t>::max();
+    for (Entity npc : npcs.npcs) {
+        const Npc* state = m_entities.find<Npc>(npc);
+        if (state && npcPeriod(*state) > 0) {
+            next = std::min(next, state->nextMove);
+        }
+    }
+    if (!npcs.awake || next == std::numeric_limits<std::uint64_t>::max()) {
+        npcs.timer.cancel();
+        return;
+    }
+    const std::uint64_t now = m_ticks.boundary();
+    m_ticks.schedule(npcs.timer, next > now ? next - now : 0);
+}
+
+// One pass of the day and the weather. Each message was made once, so a
+// zone's broadcast is a walk of its occupants linking it into their outboxes
+void GameEngine::runAmbience(std::uint64_t tick) {
+    // Scenery, like wandering; under load the pass waits for the next
+    if (m_ticks.loadStage() != LoadStage::Normal) {
+        return;
+    }
+    m_ambientZones.clear();
+    for (ZoneId zone = 0; zone < m_world.zoneCount(); ++zone) {
+        if (m_players.zoneOccupantCount(zone) > 0) {
+            m_ambientZones.push_back(zone);
+        }
+    }
+    m_ambientOut.clear();
+    m_ambience.advance(tick, m_ambientZones, m_random, m_ambientOut);
+    std::size_t players = 0;
+    for (const AmbientBroadcast& broadcast : m_ambientOut) {
+        m_players.forEachInZone(broadcast.zone, [&](PlayerId player) {
+            queueMessage(player, broadcast.message);
+            ++players;
+        });
+    }
+    m_ambience.delivered(players);
+}
+
+void GameEngine::runNpcs(ZoneId zone) {
+    // Wandering is scenery; under load the NPCs stand still and try again next tick
+    if (m_ticks.loadStage() != LoadStage::Normal) {
+        ++m_npcStats.deferred;
+        m_ticks.schedule(m_npcZones[zone]->timer, 0);
+        return;
+    }
+    const std::uint64_t now = m_ticks.boundary();
+    m_thinking.clear();
+    for (Entity npc : m_npcZones[zone]->npcs) {
+        Npc* state = m_entities.find<Npc>(npc);
+        const std::uint32_t period = state ? npcPeriod(*state) : 0;
+        if (period == 0 || state->nextMove > now) {
+            continue;
+        }
+        // A tree decides for itself what to do in a fight
+        if (state->behavior != kNoBehavior) {
+            m_thinking.push_back(npc);
+            state->nextMove = std::max(state->nextMove + period, now + 1);
+            continue;
+        }
+        // One in a fight stands its ground
+        if (m_combat.fighting(npc)) {
+            continue;
+        }
+        m_npcStats.moves += wander(npc, *state, true) ? 1 : 0;
+        state->nextMove = std::max(state->nextMove + period, now + 1);
+    }
+    runBehaviors();
+    scheduleNpcs(zone);
+}
+
+// Those running the same tree one after the other, so its nodes stay in
+// cache; each batch is timed once rather than each walk
+void GameEngine::runBehaviors() {
+    if (m_thinking.empty()) {
+        return;
+    }
+    const auto treeOf = [this](Entity npc) {
+        const Npc* state = m_entities.find<Npc>(npc);
+        return state ? state->behavior : kNoBehavior;
+    };
+    std::ranges::stable_sort(m_thinking, {}, treeOf);
+    const std::size_t trees = m_behaviors.trees().size();
+    for (std::size_t begin = 0; begin < m_thinking.size();) {
+        const BehaviorId tree = treeOf(m_thinking[begin]);
+        std::size_t end = begin;
+        while (end < m_thinking.size() && treeOf(m_thinking[end]) == tree) {
+            ++end;
+        }
+        BehaviorStats batch;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = begin; i < end && tree < trees; ++i) {
+            const Entity npc = m_thinking[i];
+            // An earlier walk's Lua leaf may have done away with it
+            if (!m_entities.alive(npc)) {
+                continue;
+            }
+            std::size_t visited = 0;
+            m_behaviors.run(tree, [&](const BehaviorNode& node) { return behave(npc, node, batch); }, visited);
+            ++batch.runs;
+            batch.nodes += visited;
+        }
+        batch.time = std::chrono::steady_clock::now() - start;
+        begin = end;
+        if (tree >= trees) {
+            continue;
+        }
+        const std::lock_guard<std::mutex> lock(m_behaviorStatsMutex);
+        if (m_behaviorStats.size() < trees) {
+            m_behaviorStats.resize(trees);
+        }
+        BehaviorStats& stats = m_behaviorStats[tree];
+        stats.runs += batch.runs;
+        stats.nodes += batch.nodes;
+        stats.time += batch.time;
+        stats.luaCalls += batch.luaCalls;
+        stats.luaTime += batch.luaTime;
+    }
+}
+
+bool GameEngine::behave(Entity npc, const BehaviorNode& node, BehaviorStats& stats) {
+    Npc* state = m_entities.find<Npc>(npc);
+    const InRoom* where = m_entities.find<InRoom>(npc);
+    if (!state || !where) {
+        return false;
+    }
+    const RoomId room = where->room;
+    switch (node.op) {
+        case BehaviorOp::PlayerHere:
+            return m_players.occupantCount(room) > 0;
+        case BehaviorOp::Fighting:
+            return m_combat.fighting(npc);
+        case BehaviorOp::Hurt: {
+            const Health* health = m_entities.find<Health>(npc);
+            return health && std::int64_t{health->current} * 100 < std::int64_t{health->max} * node.arg;
+        }
+        case BehaviorOp::Chance:
+            return m_random.below(100) < node.arg;
+        case BehaviorOp::Wander:
+            return !m_combat.fighting(npc) && wander(npc, *state, true);
+        case BehaviorOp::Flee: {
+            if (!m_combat.fighting(npc)) {
+                return false;
+            }
+            m_combat.remove(npc);
+            broadcastToRoom(room, Message<"The {} flees!">::in(scratch(), nameOf(npc)));
+            wander(npc, *state, true);
+            return true;
+        }
+        case BehaviorOp::Attack: {
+            if (m_combat.fighting(npc) || m_players.occupantCount(room) == 0) {
+                return false;
+            }
+            PlayerId victim = kInvalidPlayerId;
+            m_players.forEachInRoom(room, [&victim](PlayerId player) {
+                victim = victim == kInvalidPlayerId ? player : victim;
+            });
+            startCombat(npc, playerBody(victim));
+            broadcastToRoom(room, Message<"The {} attacks {}!">::in(scratch(), nameOf(npc), m_players.name(victim)));
+            return true;
+        }
+        case BehaviorOp::Emote: {
+            const std::array<std::string_view, 1> name = {nameOf(npc)};
+            std::pmr::string text(&scratch());
+            m_behaviors.templates()[node.data].append(text, name);
+            broadcastToRoom(room, text);
+            return true;
+        }
+        case BehaviorOp::Lua: {
+#ifdef ENABLE_LUA_SCRIPTING
+            const BehaviorLuaLeaf& leaf = m_behaviors.luaLeaves()[node.data];
+            const auto start = std::chrono::steady_clock::now();
+            const auto result = m_scriptRunner->runHook(leaf.script, leaf.hook, nameOf(npc), m_world.name(room));
+            ++stats.luaCalls;
+            stats.luaTime += std::chrono::steady_clock::now() - start;
+            return result && *result;
+#else
+            (void)stats;
+            return false;
+#endif
+        }
+        default:
+            return false;
+    }
+}
+
+bool GameEngine::wander(Entity npc, Npc& state, bool seen) {
+    InRoom* where = m_entities.find<InRoom>(npc);
+    if (!where) {
+        return false;
+    }
+    state.random ^= state.random << 13;
+    state.random ^= state.random >> 17;
+    state.random ^= state.random << 5;
+    
+    // NPCs keep to their own zone
+    const RoomId from = where->room;
+    std::array<Direction, kDirectionCount> exits{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < kDirectionCount; ++i) {
+        const RoomId to = m_world.exit(from, static_cast<Direction>(i));
+        if (to != kInvalidRoomId && m_world.zone(to) == m_world.zone(from)) {
+            exits[count++] = static_cast<Direction>(i);
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+    const Direction dir = exits[state.random % count];
+    const RoomId to = m_world.exit(from, dir);
+    placeInRoom(npc, to);
+    touchRoom(from);
+    touchRoom(to);
+    if (seen) {
+        const std::string_view name = nameOf(npc);
+        broadcastToRoom(from, Message<"The {} leaves {}.">::in(scratch(), name, directionName(dir)));
+        broadcastToRoom(to, Message<"The {} arrives.">::in(scratch(), name));
+    }
+    return true;
+}
+
+void GameEngine::wakeSystems() {
+    if (m_systemsUpdate == kInvalidTickUpdateId) {
+        m_systemsUpdate = m_ticks.addUpdate(1, [this](std::uint64_t tick) { runSystems(tick); });
+    }
+}
+
+void GameEngine::runSystems(std::uint64_t tick) {
+    // Health comes back once a second at the default tick rate
+    constexpr std::uint64_t kRegenerationInterval = 10;
+    
+    // Affects wear off first, so anything they held up goes with them
+    bool timed = false;
+    m_wornOff.clear();
+    m_entities.each<Affects>([this, &timed](Entity entity, Affects& affects) {
+        for (Affect* affect = affects.active.begin(); affect != affects.active.end();) {
+            if (affect->ticksLeft == 0) {
+                ++affect;
+            } else if (--affect->ticksLeft == 0) {
+                m_wornOff.emplace_back(entity, affect->name);
+                affect = affects.active.erase(affect);
+            } else {
+                timed = true;
+                ++affect;
+            }
+        }
+    });
+    for (const auto& [entity, name] : m_wornOff) {
+        if (const PlayerBody* body = m_entities.find<PlayerBody>(entity)) {
+            sendToPlayer(body->player, std::format("Your {} wears off.", StringInterner::global().view(name)));
+        }
+        if (const Affects* affects = m_entities.find<Affects>(entity); affects && affects->active.empty()) {
+            m_entities.remove<Affects>(entity);
+        }
+        invalidateStats(entity);
+    }
+
+    bool hurt = true;
+    if (tick % kRegenerationInterval == 0) {
+        hurt = false;
+        m_entities.each<Health>([this, &hurt](Entity entity, Health& health) {
+            if (health.current < health.max) {
+                health.current = std::min(health.max, health.current + health.regen);
+                hurt = hurt || health.current < health.max;
+                markDirty(entity);
+            }
+        });
+    }
+    
+    m_expired.clear();
+    m_entities.each<Decay>([this](Entity entity, Decay& decay) {
+        if (--decay.ticksLeft == 0) {
+            m_expired.push_back(entity);
+        }
+    });
+    for (Entity item : m_expired) {
+        const std::string_view name = nameOf(item);
+        if (const InRoom* where = m_entities.find<InRoom>(item)) {
+            broadcastToRoom(where->room, Message<"The {} crumbles to dust.">::in(scratch(), name));
+        } else if (const CarriedBy* carried = m_entities.find<CarriedBy>(item)) {
+            if (const PlayerBody* body = m_entities.find<PlayerBody>(carried->holder)) {
+                sendToPlayer(body->player, std::format("The {} crumbles to dust in your hands.", name));
+            }
+        }
+        putDown(item, kInvalidRoomId);
+    }
+    
+    // Nothing left to do until something is hurt, set to decay or affected again
+    if (!hurt && !timed && m_entities.count<Decay>() == 0) {
+        m_ticks.removeUpdate(std::exchange(m_systemsUpdate, kInvalidTickUpdateId));
+    }
+}
+
+CombatStats GameEngine::computeStats(Entity entity) const {
+    const CombatStats* own = m_entities.find<CombatStats>(entity);
+    CombatStats stats = own ? *own : CombatStats{};
+    const auto add = [&stats](const StatBonus& bonus) {
+        stats.attack += bonus.attack;
+        stats.defense += bonus.defense;
+        stats.damage += bonus.damage;
+    };
+    if (const Inventory* inventory = m_entities.find<Inventory>(entity)) {
+        for (const Entity item : inventory->items) {
+            if (const Item* kind = m_entities.find<Item>(item)) {
+                add(kind->prototype->bonus);
+            }
+        }
+    }
+    if (const Affects* affects = m_entities.find<Affects>(entity)) {
+        for (const Affect& affect : affects->active) {
+            add(affect.bonus);
+        }
+    }
+    return stats;
+}
+
+CombatStats GameEngine::effectiveStats(Entity entity) {
+    if (!m_entities.alive(entity)) {
+        return CombatStats{};
+    }
+    DerivedStats* derived = m_entities.find<DerivedStats>(entity);
+    if (!derived) {
+        ++m_statRecomputes;
+        return m_entities.add<DerivedStats>(entity, computeStats(entity), false).effective;
+    }
+    if (derived->dirty) {
+        derived->effective = computeStats(entity);
+        derived->dirty = false;
+        ++m_statRecomputes;
+        m_combat.setStats(entity, derived->effective);
+    }
+    return derived->effective;
+}
+
+void GameEngine::invalidateStats(Entity entity) {
+    // Stats nobody has asked for yet are worked out when someone does
+    DerivedStats* derived = m_entities.find<DerivedStats>(entity);
+    if (!derived || derived->dirty) {
+        return;
+    }
+    derived->dirty = true;
+    m_staleStats.push_back(entity);
+    if (m_statsUpdate == kInvalidTickUpdateId) {
+        m_statsUpdate = m_ticks.addUpdate(1, [this](std::uint64_t) {
+            refreshStats();
+            m_ticks.removeUpdate(std::exchange(m_statsUpdate, kInvalidTickUpdateId));
+        });
+    }
+}
+
+// Work out again everything that went dirty since the last tick, however
+// many times it did, and hand fighters theirs
+void GameEngine::refreshStats() {
+    for (const Entity entity : m_staleStats) {
+        DerivedStats* derived = m_entities.find<DerivedStats>(entity);
+        if (derived && derived->dirty) {
+            derived->effective = computeStats(entity);
+            derived->dirty = false;
+            ++m_statRecomputes;
+            m_combat.setStats(entity, derived->effective);
+        }
+    }
+    m_staleStats.clear();
+}
+
+void GameEngine::addAffect(Entity entity, Affect affect) {
+    if (!m_entities.alive(entity)) {
+        return;
+    }
+    Affects* affects = m_entities.find<Affects>(entity);
+    if (!affects) {
+        affects = &m_entities.add<Affects>(entity);
+    }
+    affects->active.push_back(affect);
+    invalidateStats(entity);
+    if (affect.ticksLeft > 0) {
+        wakeSystems();
+    }
+}
+
+void GameEngine::removeAffect(Entity entity, Symbol name) {
+    Affects* affects = m_entities.find<Affects>(entity);
+    if (!affects) {
+        return;
+    }
+    const std::size_t before = affects->active.size();
+    for (Affect* affect = affects->active.begin(); affect != affects->active.end();) {
+        affect = affect->name == name ? affects->active.erase(affect) : affect + 1;
+    }
+    if (affects->active.size() != before) {
+        if (affects->active.empty()) {
+            m_entities.remove<Affects>(entity);
+        }
+        invalidateStats(entity);
+    }
+}
+
+void GameEngine::startCombat(Entity attacker, Entity target) {
+    const bool answering = m_combat.fighting(target);
+    m_combat.engage(attacker, target, effectiveStats(attacker), effectiveStats(target));
+    if (!answering) {
+        m_combat.engage(target, attacker, effectiveStats(target), effectiveStats(attacker));
+    }
+    if (m_combatUpdate == kInvalidTickUpdateId) {
+        m_combatUpdate = m_ticks.addUpdate(kCombatRoundTicks, [this](std::uint64_t) { runCombat(); });
+    }
+}
+
+CommandResult GameEngine::handleScore(PlayerId player) {
+    const Entity body = playerBody(player);
+    const Health* health = m_entities.find<Health>(body);
+    const CombatStats stats = effectiveStats(body);
+    std::string text = ReplyPool::take();
+    std::format_to(std::back_inserter(text), "You are {}, with {} of {} health.\nAttack {}, defense {}, damage {}.",
+                   m_players.name(player), health ? health->current : 0, health ? health->max : 0, stats.attack,
+                   stats.defense, stats.damage);
+    if (const Affects* affects = m_entities.find<Affects>(body)) {
+        for (const Affect& affect : affects->active) {
+            const auto left = std::chrono::duration_cast<std::chrono::seconds>(affect.ticksLeft * m_ticks.period());
+            std::format_to(std::back_inserter(text), "\nAffected by {}{}", StringInterner::global().view(affect.name),
+                           affect.ticksLeft > 0 ? std::format(" for {} more seconds", left.count()) : std::string());
+        }
+    }
+    return CommandResult::success(std::move(text));
+}
+
+CommandResult GameEngine::handleKill(PlayerId player, std::string_view target) {
+    const RoomId room = m_players.room(player);
+    const Entity found = roomContents(room).find(KeywordIndex::parse(target),
+                                                 [this](Entity entity) { return m_entities.has<Npc>(entity); });
+    if (found == kInvalidEntity) {
+        return CommandResult::error(Message<"You don't see '{}' here.">::reply(target));
+    }
+    const Entity body = playerBody(player);
+    const std::string_view name = nameOf(found);
+    if (m_combat.target(body) == found) {
+        return CommandResult::error(Message<"You are already fighting the {}.">::reply(name));
+    }
+    startCombat(body, found);
+    broadcastToRoom(room, Message<"{} attacks the {}!">::in(scratch(), m_players.name(player), name), player);
+    return CommandResult::success(Message<"You attack the {}!">::reply(name));
+}
+
+CommandResult GameEngine::handleFlee(PlayerId player) {
+    const Entity body = playerBody(player);
+    if (!m_combat.fighting(body)) {
+        return CommandResult::error("You aren't fighting anyone.");
+    }
+    const RoomId from = m_players.room(player);
+    std::array<Direction, kDirectionCount> exits{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < kDirectionCount; ++i) {
+        if (m_world.exit(from, static_cast<Direction>(i)) != kInvalidRoomId) {
+            exits[count++] = static_cast<Direction>(i);
+        }
+    }
+    if (count == 0) {
+        return CommandResult::error("There is nowhere to run!");
+    }
+    m_combat.remove(body);
+    broadcastToRoom(from, Message<"{} flees!">::in(scratch(), m_players.name(player)), player);
+    CommandResult moved = handleMove(player, exits[m_random.below(count)]);
+    moved.message.insert(0, "You flee!\n");
+    return moved;
+}
+
+RoomId GameEngine::roomOf(Entity entity) const {
+    if (const PlayerBody* body = m_entities.find<PlayerBody>(entity)) {
+        return m_players.isActive(body->player) ? m_players.room(body->player) : kInvalidRoomId;
+    }
+    const InRoom* where = m_entities.find<InRoom>(entity);
+    return where ? where->room : kInvalidRoomId;
+}
+
+void GameEngine::appendCombatant(std::pmr::string& text, Entity entity, bool capital) const {
+    if (const PlayerBody* body = m_entities.find<PlayerBody>(entity)) {
+        text += m_players.name(body->player);
+        return;
+    }
+    text += capital ? "The " : "the ";
+    text += nameOf(entity);
+}
+
+void GameEngine::runCombat() {
+    // Gather where everyone is and how they stand, resolve the round over
+    // the arrays, then write the health back. Stats that went dirty since
+    // the tick began are brought up to date first
+    refreshStats();
+    const std::span<const Entity> fighters = m_combat.entities();
+    const std::span<RoomId> rooms = m_combat.rooms();
+    const std::span<std::int32_t> health = m_combat.health();
+    for (std::size_t i = 0; i < fighters.size(); ++i) {
+        const Health* current = m_entities.find<Health>(fighters[i]);
+        rooms[i] = roomOf(fighters[i]);
+        health[i] = current && rooms[i] != kInvalidRoomId ? current->current : 0;
+    }
+    m_combat.resolve(m_hits);
+    bool hurt = false;
+    for (std::size_t i = 0; i < fighters.size(); ++i) {
+        if (Health* current = m_entities.find<Health>(fighters[i]); current && current->current != health[i]) {
+            current->current = std::max(health[i], 0);
+            hurt = true;
+            markDirty(fighters[i]);
+        }
+    }
+    if (hurt) {
+        wakeSystems();
+    }
+
+    // One message per room with every swing taken there, in the order taken
+    m_hitOrder.resize(m_hits.size());
+    for (std::uint32_t i = 0; i < m_hitOrder.size(); ++i) {
+        m_hitOrder[i] = i;
+    }
+    std::stable_sort(m_hitOrder.begin(), m_hitOrder.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return rooms[m_hits[a].attacker] < rooms[m_hits[b].attacker];
+    });
+    for (std::size_t begin = 0; begin < m_hitOrder.size();) {
+        const RoomId room = rooms[m_hits[m_hitOrder[begin]].attacker];
+        std::pmr::string text(&scratch());
+        std::size_t end = begin;
+        for (; end < m_hitOrder.size() && rooms[m_hits[m_hitOrder[end]].attacker] == room; ++end) {
+            const CombatRound::Hit& hit = m_hits[m_hitOrder[end]];
+            if (!text.empty()) {
+                text += '\n';
+            }
+            appendCombatant(text, fighters[hit.attacker], true);
+            if (hit.damage == 0) {
+                text += " misses ";
+                appendCombatant(text, fighters[hit.target], false);
+                text += '.';
+                continue;
+            }
+            text += " hits ";
+            appendCombatant(text, fighters[hit.target], false);
+            Message<" for {}.">::append(text, hit.damage);
+            if (hit.killed) {
+                text += '\n';
+                appendCombatant(text, fighters[hit.target], true);
+                text += " is dead!";
+            }
+        }
+        broadcastToRoom(room, text);
+#ifdef ENABLE_LUA_SCRIPTING
+        if (ScriptRunnerPool* scripts = scriptEvents(ScriptEvent::CombatRound)) {
+            scripts->emitCombatRound({this, room}, text);
+        }
+#endif
+        begin = end;
+    }
+
+    // The dead go once everyone's swings are told
+    for (const CombatRound::Hit& hit : m_hits) {
+        if (hit.killed) {
+            m_combatLeft.push_back(fighters[hit.target]);
+        }
+    }
+    for (const Entity dead : m_combatLeft) {
+        die(dead);
+    }
+    m_combatLeft.clear();
+    m_combat.settle(m_combatLeft);
+    if (!m_watches.empty()) {
+        endFinishedSpectating();
+    }
+    if (m_combat.empty()) {
+        m_ticks.removeUpdate(std::exchange(m_combatUpdate, kInvalidTickUpdateId));
+    }
+}
+
+void GameEngine::die(Entity entity) {
+    m_combat.remove(entity);
+    if (const PlayerBody* body = m_entities.find<PlayerBody>(entity)) {
+        // Players wake where they entered, whole again
+        const PlayerId player = body->player;
+        if (Health* health = m_entities.find<Health>(entity)) {
+            health->current = health->max;
+            markDirty(entity);
+        }
+        sendToPlayer(player, "You have been killed! You wake up somewhere safer.");
+        movePlayer(player, m_startRoom);
+        return;
+    }
+    // A creature leaves what it carried where it fell
+    const RoomId room = roomOf(entity);
+    if (Inventory* inventory = m_entities.find<Inventory>(entity)) {
+        for (Entity item : std::exchange(inventory->items, {})) {
+            putDown(item, room);
+        }
+    }
+    if (room != kInvalidRoomId) {
+        std::erase(npcZone(m_world.zone(room)).npcs, entity);
+    }
+    touchRoom(room);
+    removeFromRoom(entity);
+    m_entities.destroy(entity);
+}
+
+std::chrono::steady_clock::time_point GameEngine::idle([[maybe_unused]] std::chrono::microseconds budget) {
+    // The one clock reading of this pass; stamps taken until the next read it
+    const auto now = TickClock::advance();
+    m_events.flush();
+    // Free command snapshots readers have finished with since the last publish
+    m_commandSnapshot.reclaim();
+    auto next = std::chrono::steady_clock::time_point::max();
+    // Commands whose slow work is done go on from where they waited
+    if (m_async) {
+        m_async->resumeReady();
+        finishAsyncCommands();
+        if (!m_asyncWake && m_async->inFlight() != 0) {
+            next = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+        }
+    }
+#ifdef ENABLE_LUA_SCRIPTING
+    if (m_scriptRunner) {
+        // Continue suspended script commands first; their output is queued
+        // for the player they run for, like any other message
+        std::vector<ScriptRunner::TaskResult> finished;
+        next = m_scriptRunner->resumeTasks(now, finished);
+        for (auto& task : finished) {
+            if (!task.output) {
+                sendToPlayer(task.player, scriptErrorMessage(task.output.error()));
+            } else if (!task.output->empty()) {
+                sendToPlayer(task.player, std::move(*task.output));
+            }
+        }
+        
+        // An unfinished collection cycle wants its next slice shortly
+        if (m_scriptRunner->collectIdle(budget)) {
+            next = std::min(next, std::chrono::steady_clock::now() + std::chrono::milliseconds(10));
+        }
+    }
+#endif
+    return std::min(next, m_ticks.run(now));
+}
+
+TickUpdateId GameEngine::addRoomUpdate(unsigned interval, RoomUpdate update) {
+    if (!update) {
+        return kInvalidTickUpdateId;
+    }
+    if (!m_jobs) {
+        startJobs();
+    }
+    return m_ticks.addUpdate(interval, [this, update = std::move(update)](std::uint64_t) { runRoomUpdate(update); });
+}
+
+void GameEngine::runRoomUpdate(const RoomUpdate& update) {
+    // Enough rooms per chunk to cover the cost of claiming it
+    constexpr std::size_t kRoomsPerChunk = 64;
+    
+    const std::size_t rooms = m_world.size();
+    m_roomCommands.resize(JobSystem::chunkCount(rooms, kRoomsPerChunk));
+    m_jobs->parallelFor(rooms, kRoomsPerChunk, [this, &update](const JobRange& range) {
+        CommandBuffer& commands = m_roomCommands[range.chunk];
+        for (std::size_t room = range.begin; room < range.end; ++room) {
+            update(static_cast<RoomId>(room), commands);
+        }
+    });
+    
+    // Chunk order is room order, whichever threads ran them
+    for (CommandBuffer& commands : m_roomCommands) {
+        commands.apply();
+    }
+}
+
+void GameEngine::setExecutionMode(ExecutionMode mode) {
+    m_executionMode = mode;
+    if (mode == ExecutionMode::ZoneActors && !m_jobs) {
+        startJobs();
+    }
+}
+
+void GameEngine::setWorkerCores(std::vector<int> cores) {
+    m_workerCores = std::move(cores);
+    // Workers already running are started again where they now belong
+    if (m_jobs) {
+        m_jobs.reset();
+        startJobs();
+    }
+}
+
+void GameEngine::startJobs() {
+    // One worker per core given; without any, one per core beside this thread
+    const unsigned threads = m_workerCores.empty() ? JobSystem::defaultThreads()
+                                                   : static_cast<unsigned>(m_workerCores.size());
+    m_jobs = std::make_unique<JobSystem>(threads, m_workerCores);
+}
+
+void GameEngine::runCommands(std::span<QueuedCommand> commands) {
+    bool useZones = m_executionMode == ExecutionMode::ZoneActors && commands.size() > 1;
+#ifdef ENABLE_LUA_SCRIPTING
+    applyScriptReloads();
+    // Script hooks call into Lua states, which cannot be shared between threads
+    useZones = useZones && std::all_of(m_scriptHooks.begin(), m_scriptHooks.end(),
+                                       [](const auto& hooks) { return hooks.second.empty(); });
+#endif
+    // Zone actors dispatch entries looked up here; the guard outlives the batch
+    const rcu::Guard guard;
+    if (!useZones) {
+        for (QueuedCommand& command : commands) {
+            command.result = handleCommandLine(command.player, command.line);
+        }
+        return;
+    }
+    
+    // Mail each command to the zone its player stands in; look's cached
+    // views are filled in there, but only sized here
+    m_zoneActors.resize(m_world.zoneCount());
+    m_roomViews.resize(m_world.size());
+    m_activeZones.clear();
+    m_serialCommands.clear();
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const PlayerId player = commands[i].player;
+        // A sequence moves its player between commands, which only the serial pass can do
+        const CommandTokens tokens(commands[i].line);
+        const CommandEntry* entry = m_players.isActive(player) ? findCommand(tokens.verb()) : nullptr;
+        if (!entry || !entry->zoneLocal || CommandSequence(commands[i].line).isSequence()) {
+            m_serialCommands.push_back(i);
+            continue;
+        }
+        const ZoneId zone = m_world.zone(m_players.room(player));
+        ZoneActor& actor = m_zoneActors[zone];
+        if (actor.mailbox.empty()) {
+            m_activeZones.push_back(zone);
+            if (!actor.scratch) {
+                actor.scratch = std::make_unique<ScratchArena>(kZoneScratchSize);
+            }
+        }
+        actor.mailbox.push_back({i, entry});
+    }
+    std::sort(m_activeZones.begin(), m_activeZones.end());
+    
+    m_jobs->parallelFor(m_activeZones.size(), 1, [this, commands](const JobRange& range) {
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            runZone(m_zoneActors[m_activeZones[i]], commands);
+        }
+    });
+    
+    // What each zone did, in zone order, then the moves handed between zones
+    m_arrivalZones.clear();
+    for (ZoneId zone : m_activeZones) {
+        ZoneActor& actor = m_zoneActors[zone];
+        m_zoneStats.commands += actor.mailbox.size();
+        for (ZoneEffect& effect : actor.effects) {
+            applyZoneEffect(effect);
+        }
+        actor.effects.clear();
+        actor.mailbox.clear();
+    }
+    std::sort(m_arrivalZones.begin(), m_arrivalZones.end());
+    for (ZoneId zone : m_arrivalZones) {
+        ZoneActor& actor = m_zoneActors[zone];
+        for (const ZoneEffect& move : actor.arrivals) {
+            finishMove(move);
+        }
+        actor.arrivals.clear();
+    }
+    for (ZoneId zone : m_activeZones) {
+        m_zoneActors[zone].scratch->release();
+    }
+    ++m_zoneStats.batches;
+    m_zoneStats.zoneRuns += m_activeZones.size();
+    
+    for (std::size_t i : m_serialCommands) {
+        commands[i].result = handleCommandLine(commands[i].player, commands[i].line);
+    }
+    m_zoneStats.serialCommands += m_serialCommands.size();
+}
+
+void GameEngine::runZone(ZoneActor& actor, std::span<QueuedCommand> commands) {
+    t_zone = &actor;
+    for (const ZoneMail& mail : actor.mailbox) {
+        QueuedCommand& command = commands[mail.command];
+        const CommandTokens tokens(command.line);
+        try {
+            command.result = dispatch(command.player, *mail.entry, tokens.verb(), tokens.args());
+        } catch (...) {
+            command.result = CommandResult::error("Error processing command");
+        }
+    }
+    t_zone = nullptr;
+}
+
+void GameEngine::applyZoneEffect(ZoneEffect& effect) {
+    switch (effect.kind) {
+        case ZoneEffect::Kind::Send:
+            sendToPlayer(effect.player, std::string(effect.text));
+            break;
+        case ZoneEffect::Kind::Broadcast:
+            broadcastToRoom(effect.room, effect.text, effect.player);
+            break;
+        case ZoneEffect::Kind::ZoneBroadcast:
+            broadcastToZone(static_cast<ZoneId>(effect.room), effect.text, effect.player);
+            break;
+        case ZoneEffect::Kind::ChannelSend:
+            sendToChannel(static_cast<ChannelId>(effect.room), effect.text, effect.player);
+            break;
+        case ZoneEffect::Kind::Handoff:
+            m_handoffs.push_back({effect.player, effect.room});
+            break;
+        case ZoneEffect::Kind::Move: {
+            const ZoneId to = m_world.zone(effect.room);
+            if (to == m_world.zone(effect.from)) {
+                finishMove(effect);
+                break;
+            }
+            // The player stays where it was until the zone it is entering takes it
+            ZoneActor& target = m_zoneActors[to];
+            if (target.arrivals.empty()) {
+                m_arrivalZones.push_back(to);
+            }
+            target.arrivals.push_back(std::move(effect));
+            ++m_zoneStats.handoffs;
+            break;
+        }
+    }
+}
+
+void GameEngine::finishMove(const ZoneEffect& move) {
+    moveGroup(MoveEvent{move.player, move.direction, move.from, move.room});
+}
+
+void GameEngine::takeRecipients(std::vector<PlayerId>& out) {
+    out.clear();
+    out.swap(m_recipients);
+    for (PlayerId player : out) {
+        m_listed[player] = 0;
+    }
+}
+
+std::vector<SharedMessage> GameEngine::takeMessages(PlayerId player) {
+    std::vector<SharedMessage> messages;
+    takeMessages(player, messages);
+    return messages;
+}
+
+void GameEngine::takeMessages(PlayerId player, std::vector<SharedMessage>& out) {
+    out.clear();
+    if (player < m_outbox.size()) {
+        out.swap(m_outbox[player]);
+    }
+}
+
+Player GameEngine::getPlayer(PlayerId player) const {
+    Player snapshot{std::string(m_players.name(player))};
+    snapshot.currentRoom = std::string(currentRoomName(player));
+    const Entity body = playerBody(player);
+    if (const Health* health = m_entities.find<Health>(body)) {
+        snapshot.health = health->current;
+        snapshot.maxHealth = health->max;
+        snapshot.regen = health->regen;
+    }
+    if (const Inventory* inventory = m_entities.find<Inventory>(body)) {
+        for (Entity item : inventory->items) {
+            const Decay* decay = m_entities.find<Decay>(item);
+            snapshot.inventory.push_back({std::string(nameOf(item)), decay ? decay->ticksLeft : 0});
+        }
+    }
+    return snapshot;
+}
+
+void GameEngine::takeDirtyPlayers(std::vector<PlayerId>& out) {
+    out.clear();
+    for (PlayerId player = 0; player < m_dirty.size(); ++player) {
+        if (std::exchange(m_dirty[player], 0)) {
+            out.push_back(player);
+        }
+    }
+}
+
+WorldSnapshot GameEngine::snapshot() {
+    WorldSnapshot image;
+    image.tick = m_ticks.boundary();
+    if (!m_worldImage || m_worldImageVersion != m_world.version()) {
+        m_worldImage = std::make_shared<const RoomGraph>(m_world);
+        m_worldImageVersion = m_world.version();
+    }
+    image.rooms = m_worldImage;
+    image.players.reserve(m_players.size());
+    for (PlayerId player = 0; player < m_players.capacity(); ++player) {
+        if (m_players.isActive(player)) {
+            image.players.push_back({player, m_players.name(player), m_players.room(player), playerBody(player)});
+        }
+    }
+    image.entities = m_entities.snapshot();
+    return image;
+}
+
+AreaSource GameEngine::areaSource() const {
+    AreaSource area;
+    area.rooms = m_world;
+    // Instances are left out, and what is in them
+    const RoomId rooms = m_instanceBase != kInvalidRoomId ? m_instanceBase : static_cast<RoomId>(m_world.size());
+    area.rooms.truncate(rooms);
+    // Written as text, for AreaFile::write to pack again
+    if (m_descriptions) {
+        for (RoomId room = 0; room < rooms; ++room) {
+            if (m_descriptions->packed(room) && m_world.description(room).empty()) {
+                area.rooms.setDescription(room, roomDescription(room));
+            }
+        }
+    }
+    area.startRoom = m_startRoom;
+    std::unordered_map<const ItemPrototype*, std::uint32_t> prototypes;
+    m_items.each([&](const ItemPrototype& prototype) {
+        prototypes.emplace(&prototype, static_cast<std::uint32_t>(area.prototypes.size()));
+        area.prototypes.push_back(prototype);
+    });
+    // Areas the engine loaded itself may not have spawned every zone, or
+    // every record of a zone, yet; those records are carried over as the
+    // file had them
+    const auto carry = [&](const AreaFile::Zone& contents, std::size_t index) {
+        if (index < contents.items.size()) {
+            if (const ItemPrototype* prototype = m_areaPrototypes[contents.items[index].prototype]) {
+                area.items.push_back({prototypes.at(prototype), contents.items[index].room});
+            }
+            return;
+        }
+        const AreaNpc& npc = contents.npcs[index - contents.items.size()];
+        area.npcs.push_back({std::string(m_area.string(npc.name)), npc.room, npc.wanderTicks, npc.health,
+                             npc.maxHealth, npc.regen});
+    };
+    for (ZoneId zone = 0; zone < m_zoneLoaded.size(); ++zone) {
+        if (instanceOf(zone)) {
+            continue;
+        }
+        if (m_zoneLoaded[zone]) {
+            if (zone < m_npcZones.size() && m_npcZones[zone]) {
+                for (const std::uint32_t index : m_npcZones[zone]->pending) {
+                    carry(m_npcZones[zone]->records, index);
+                }
+            }
+        } else if (const std::optional<AreaFile::Zone> contents = m_area.zone(zone)) {
+            for (std::size_t index = 0; index < contents->items.size() + contents->npcs.size(); ++index) {
+                carry(*contents, index);
+            }
+        }
+    }
+    m_entities.each<Item, InRoom>([&](Entity, const Item& item, const InRoom& where) {
+        if (where.room < rooms) {
+            area.items.push_back({prototypes.at(item.prototype), where.room});
+        }
+    });
+    m_entities.each<Npc, InRoom, Named, Health>([&area, rooms](Entity, const Npc& npc, const InRoom& where,
+                                                               const Named& named, const Health& health) {
+        if (where.room >= rooms) {
+            return;
+        }
+        area.npcs.push_back({std::string(StringInterner::global().view(named.name)), where.room, npc.wanderTicks,
+                             health.current, health.max, health.regen});
+    });
+    return area;
+}
+
+void GameEngine::restorePlayer(PlayerId player, const PlayerSave& save) {
+    if (!m_players.isActive(player) || !save.valid()) {
+        return;
+    }
+    const SavedPlayer& saved = save.player();
+    const RoomId room = m_world.find(save.string(saved.room));
+    if (room != kInvalidRoomId && !m_shard.owns(m_world.zone(room))) {
+        m_handoffs.push_back({player, room});
+    } else if (room != kInvalidRoomId) {
+        movePlayer(player, room);
+    }
+    const Entity body = playerBody(player);
+    if (Health* health = m_entities.find<Health>(body)) {
+        *health = {saved.health, saved.maxHealth, saved.regen};
+        markDirty(body);
+    }
+    for (const SavedItem& belonging : save.items()) {
+        const ItemPrototype* prototype = m_items.find(save.string(belonging.prototype));
+        if (!prototype) {
+            continue;
+        }
+        const Entity item = spawnItem(*prototype, m_players.room(player));
+        if (Decay* decay = m_entities.find<Decay>(item); decay && belonging.decayTicks > 0) {
+            decay->ticksLeft = belonging.decayTicks;
+        }
+        carry(body, item);
+    }
+}
+
+std::string_view GameEngine::currentRoomName(PlayerId player) const {
+    return m_world.name(m_players.room(player));
+}
+
+CommandHandle GameEngine::resolveCommand(std::string_view cmd) const {
+    const rcu::Guard guard;
+    // Not findCommand: a handle can't carry which social was meant, so
+    // socials are left to be dispatched by name
+    const CommandEntry* entry = commands().index.find(cmd);
+    if (!entry) {
+        return {};
+    }
+    return CommandHandle{entry, commands().generation};
+}
+
+bool GameEngine::shouldQuit(std::string_view cmd, std::string_view /*args*/) {
+    // Whatever spelling was typed, only the exit command quits
+    const rcu::Guard guard;
+    const CommandEntry* entry = findCommand(cmd);
+    return entry && entry->id == static_cast<CommandId>(BuiltinCommand::Exit);
+}
+
+CommandPriority GameEngine::commandPriority(PlayerId player, std::string_view line) const {
+    if (isAdmin(player)) {
+        return CommandPriority::Urgent;
+    }
+    const CommandTokens tokens(line);
+    if (tokens.empty()) {
+        return CommandPriority::Bulk;
+    }
+    // Not findCommand(): a social goes to the socials listing, but acting
+    // one out is an ordinary command
+    const rcu::Guard guard;
+    const CommandEntry* entry = commands().index.find(tokens.verb());
+    return entry ? entry->priority : CommandPriority::Normal;
+}
+
+Completion GameEngine::complete(PlayerId player, std::string_view line) const {
+    const std::size_t wordStart = line.find_last_of(' ') + 1;   // npos wraps to 0
+    const std::string_view word = line.substr(wordStart);
+    const std::size_t verbStart = std::min(line.find_first_not_of(' '), wordStart);
+    const std::string_view verb = line.substr(verbStart, line.find(' ', verbStart) - verbStart);
+    
+    Completion completion;
+    if (verbStart == wordStart || verb == "help") {
+        m_commandNames.complete(word, completion);
+        return completion;
+    }
+    
+    m_playerNames.complete(word, completion);
+    if (m_players.isActive(player)) {
+        // At most one exit per direction, so a throwaway trie is cheap
+        CompletionTrie exits;
+        const RoomGraph::ExitArray& roomExits = m_world.exits(m_players.room(player));
+        for (std::size_t dir = 0; dir < kDirectionCount; ++dir) {
+            if (roomExits[dir] != kInvalidRoomId) {
+                exits.insert(directionName(static_cast<Direction>(dir)));
+            }
+        }
+        Completion exitMatches;
+        exits.complete(word, exitMatches);
+        completion.merge(std::move(exitMatches));
+    }
+    return completion;
 }
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include "../include/Gateway.h"
+#include "../include/Logger.h"
+#include "../include/SignalHandler.h"
+#include "../include/StartupPhases.h"
+#include <algorithm>
+#include <format>
+#include <poll.h>
+
+namespace {
+
+constexpr auto kConnectTimeout = std::chrono::milliseconds(500);
+constexpr std::string_view kShardDown = "That part of the world has gone away; try again later.\n";
+constexpr std::string_view kHolding = "\nThe world holds still for a moment...\n";
+constexpr std::string_view kResumed = "...and goes on as if nothing had happened.\n";
+constexpr std::string_view kHeldFull = "The world is still holding; that line was dropped.\n";
+
+} // namespace
+
+std::expected<std::unique_ptr<Gateway>, NetError> Gateway::create(const Options& options) {
+    std::unique_ptr<Gateway> gateway(new Gateway());
+    if (!gateway->m_inbox.open()) {
+        return std::unexpected(NetError::POLLER_FAILED);
+    }
+    // Every shard is tried at once, so a down one costs one timeout in all,
+    // and the reactors bind meanwhile
+    StartupPhases<NetError> phases("mud_gateway");
+    std::vector<std::unique_ptr<ShardLink>> links(options.shards.size());
+    for (std::size_t i = 0; i < options.shards.size(); ++i) {
+        phases.add(std::format("shard {}", i), {}, [&, i]() -> std::expected<void, NetError> {
+            const auto& [address, port] = options.shards[i];
+            auto link = ShardLink::connect(address, port, kConnectTimeout);
+            if (!link) {
+                LOG_ERROR("Shard {} at {}:{} did not answer", i, address, port);
+                return std::unexpected(link.error());
+            }
+            links[i] = std::move(*link);
+            return {};
+        });
+    }
+
+    NetReactor::Config config{options.address, options.port, options.useIoUring};
+    config.compression = options.compression;
+    config.webSocketPort = options.webSocketPort;
+    config.idleCompaction = options.idleCompaction;
+    const unsigned count = std::max(options.reactors, 1u);
+    gateway->m_reactors.resize(count);
+    std::vector<StartupPhases<NetError>::Phase> listening;
+    for (unsigned i = 0; i < count; ++i) {
+        listening.push_back(phases.add(std::format("reactor {}", i), {}, [&, i]() -> std::expected<void, NetError> {
+            auto reactor = NetReactor::create(static_cast<std::uint16_t>(i), gateway->m_inbox, config);
+            if (!reactor) {
+                return std::unexpected(reactor.error());
+            }
+            gateway->m_reactors[i] = std::move(*reactor);
+            return {};
+        }));
+    }
+    if (options.tlsPort != 0) {
+        phases.add("TLS", listening, [&]() -> std::expected<void, NetError> {
+#if defined(ENABLE_TLS)
+            TlsAcceptor::Config tls;
+            tls.address = options.address;
+            tls.port = options.tlsPort;
+            tls.certificate = options.tlsCertificate;
+            tls.key = options.tlsKey;
+            tls.workers = options.tlsWorkers;
+            std::vector<NetReactor*> reactors;
+            for (const auto& reactor : gateway->m_reactors) {
+                reactors.push_back(reactor.get());
+            }
+            auto acceptor = TlsAcceptor::create(tls, std::move(reactors));
+            if (!acceptor) {
+                return std::unexpected(acceptor.error());
+            }
+            gateway->m_tls = std::move(*acceptor);
+            return {};
+#else
+            // Built without OpenSSL
+            return std::unexpected(NetError::TLS_FAILED);
+#endif
+        });
+    }
+    const auto started = phases.run();
+    // The destructor stops every reactor, so none of the slots may stay empty
+    std::erase(gateway->m_reactors, nullptr);
+    if (!started) {
+        return std::unexpected(started.error());
+    }
+    for (std::size_t i = 0; i < options.shards.size(); ++i) {
+        gateway->m_shards.push_back({options.shards[i].first, options.shards[i].second, std::move(links[i])});
+    }
+    gateway->m_pending.resize(count);
+
+    LOG_INFO("Gateway listening on {}:{} with {} reactor(s) in front of {} shard(s)", options.address, options.port,
+             count, gateway->m_shards.size());
+    if (options.webSocketPort != 0) {
+        LOG_INFO("Listening for WebSocket connections on {}:{}", options.address, options.webSocketPort);
+    }
+    if (options.tlsPort != 0) {
+        LOG_INFO("Listening for TLS connections on {}:{} with {} handshake worker(s)", options.address,
+                 options.tlsPort, options.tlsWorkers);
+    }
+    return gateway;
+}
+
+Gateway::~Gateway() {
+    m_tls.reset();
+    for (auto& reactor : m_reactors) {
+        reactor->stop();
+    }
+}
+
+void Gateway::requestStop() noexcept {
+    m_stopRequested.store(true);
+    m_inbox.wake();
+}
+
+void Gateway::run() {
+    for (auto& reactor : m_reactors) {
+        reactor->start(-1);
+    }
+    if (m_tls) {
+        m_tls->start();
+    }
+
+    std::vector<pollfd> ready;
+    while (!m_stopRequested.load()) {
+        if (SignalHandler::dispatchPending() && m_stopRequested.load()) {
+            break;
+        }
+
+        // The clients' lines, then what each shard sent back, then one
+        // batch per reactor and whatever each link can take
+        m_inbox.drain([this](NetInputBatch&& batch) {
+            for (NetInput& input : batch) {
+                handleInput(input);
+            }
+        });
+        for (std::uint16_t i = 0; i < m_shards.size(); ++i) {
+            if (!m_shards[i].link) {
+                continue;
+            }
+            const bool open = m_shards[i].link->receive(m_messages);
+            for (const ShardMessage& message : m_messages) {
+                handleMessage(i, message);
+            }
+            if (!open) {
+                loseShard(i);
+            }
+        }
+        reconnect();
+        publish();
+
+        ready.clear();
+        ready.push_back({m_inbox.fd(), POLLIN, 0});
+        ready.push_back({SignalHandler::fd(), POLLIN, 0});
+        bool down = false;
+        for (const Shard& shard : m_shards) {
+            if (shard.link) {
+                ready.push_back(
+                    {shard.link->fd(), static_cast<short>(POLLIN | (shard.link->wantsWrite() ? POLLOUT : 0)), 0});
+            } else {
+                down = true;
+            }
+        }
+        int timeoutMs = -1;
+        if (down) {
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(m_nextReconnect -
+                                                                          std::chrono::steady_clock::now());
+            timeoutMs = static_cast<int>(std::max<std::chrono::milliseconds::rep>(wait.count(), 0));
+        }
+        ::poll(ready.data(), ready.size(), timeoutMs);
+    }
+
+    if (m_tls) {
+        m_tls->stop();
+    }
+    for (auto& reactor : m_reactors) {
+        reactor->stop();
+    }
+}
+
+void Gateway::handleInput(NetInput& input) {
+    const std::uint64_t key = input.connection.key();
+    if (input.kind == NetInput::Kind::Opened) {
+        // Everyone logs in on the first shard, which hands them on from there
+        const std::uint64_t number = m_nextSession++;
+        const Session& session = m_sessions.insert_or_assign(number, Session{input.connection, number}).first->second;
+        m_numbers.insert_or_assign(key, number);
+        if (m_shards.empty() || !m_shards[0].link) {
+            close(input.connection, kShardDown);
+            return;
+        }
+        send(session, ShardMessageKind::Opened);
+        return;
+    }
+
+    const auto found = m_numbers.find(key);
+    if (found == m_numbers.end()) {
+        return;
+    }
+    const auto session = m_sessions.find(found->second);
+    switch (input.kind) {
+        case NetInput::Kind::Line:
+            if (!session->second.parked) {
+                send(session->second, ShardMessageKind::Line, input.line);
+            } else if (session->second.held.size() < kMaxHeldLines) {
+                session->second.held.push_back(std::move(input.line));
+            } else {
+                write(session->second.connection, kHeldFull);
+            }
+            break;
+        case NetInput::Kind::Closed:
+            // A parked player was saved by its shard on the way down
+            if (!session->second.parked) {
+                send(session->second, ShardMessageKind::Closed);
+            }
+            m_sessions.erase(session);
+            m_numbers.erase(found);
+            break;
+        default:
+            // GMCP and MSDP stop here
+            break;
+    }
+}
+
+void Gateway::handleMessage(std::uint16_t shard, const ShardMessage& message) {
+    if (message.kind() == ShardMessageKind::Channel) {
+        // Passed on as it came, undecoded
+        for (std::uint16_t i = 0; i < m_shards.size(); ++i) {
+            if (i != shard && m_shards[i].link) {
+                m_shards[i].link->forward(message);
+            }
+        }
+        return;
+    }
+    const auto found = m_sessions.find(message.session());
+    // A session that closed, or moved on, while this was on its way
+    if (found == m_sessions.end() || found->second.shard != shard || found->second.parked) {
+        return;
+    }
+    Session& session = found->second;
+    switch (message.kind()) {
+        case ShardMessageKind::Output:
+            write(session.connection, message.body());
+            break;
+        case ShardMessageKind::Close:
+            close(session.connection, {});
+            break;
+        case ShardMessageKind::Handoff:
+            if (message.shard() >= m_shards.size()) {
+                LOG_WARN("Shard {} handed {} to shard {}, which is not there", shard, message.name(), message.shard());
+                close(session.connection, kShardDown);
+                break;
+            }
+            session.shard = message.shard();
+            if (!m_shards[session.shard].link) {
+                // Attached once that shard is back
+                park(session, session.shard, message);
+                break;
+            }
+            m_shards[session.shard].link->send(ShardMessageKind::Attach, session.shard, session.number, message.name(),
+                                               {message.body()});
+            break;
+        case ShardMessageKind::Park:
+            park(session, shard, message);
+            break;
+        default:
+            break;
+    }
+}
+
+void Gateway::park(Session& session, std::uint16_t shard, const ShardMessage& message) {
+    session.shard = shard;
+    session.parked = true;
+    session.name.assign(message.name());
+    session.image.assign(message.body());
+    write(session.connection, kHolding);
+}
+
+void Gateway::send(const Session& session, ShardMessageKind kind, std::string_view body) {
+    if (ShardLink* link = m_shards[session.shard].link.get()) {
+        link->send(kind, session.shard, session.number, {}, {body});
+    }
+}
+
+// Its parked players wait for it; anyone else on it is disconnected
+void Gateway::loseShard(std::uint16_t shard) {
+    LOG_WARN("Lost the link to shard {}; calling it again every {} ms", shard, kReconnectInterval.count());
+    m_shards[shard].link.reset();
+    m_nextReconnect = std::min(m_nextReconnect, std::chrono::steady_clock::now());
+    for (const auto& [number, session] : m_sessions) {
+        if (session.shard == shard && !session.parked) {
+            close(session.connection, kShardDown);
+        }
+    }
+}
+
+// Call every shard that is down, and attach its parked players to any that answers
+void Gateway::reconnect() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_nextReconnect) {
+        return;
+    }
+    m_nextReconnect = now + kReconnectInterval;
+    for (std::uint16_t i = 0; i < m_shards.size(); ++i) {
+        Shard& shard = m_shards[i];
+        if (shard.link) {
+            continue;
+        }
+        auto link = ShardLink::connect(shard.address, shard.port, kConnectTimeout);
+        if (!link) {
+            continue;
+        }
+        shard.link = std::move(*link);
+        std::size_t attached = 0;
+        for (auto& [number, session] : m_sessions) {
+            if (session.shard != i || !session.parked) {
+                continue;
+            }
+            session.parked = false;
+            write(session.connection, kResumed);
+            shard.link->send(ShardMessageKind::Attach, i, number, session.name, {session.image});
+            for (const std::string& line : session.held) {
+                shard.link->send(ShardMessageKind::Line, i, number, {}, {line});
+            }
+            session.name.clear();
+            session.image.clear();
+            session.held.clear();
+            ++attached;
+        }
+        LOG_INFO("Shard {} is back; attached {} parked players to it", i, attached);
+    }
+}
+
+void Gateway::close(const ConnectionId& connection, std::string_view text) {
+    m_pending[connection.reactor].push_back({connection, std::string(), std::string(text), nullptr, true});
+}
+
+void Gateway::write(const ConnectionId& connection, std::string_view text) {
+    m_pending[connection.reactor].push_back({connection, std::string(), std::string(text), nullptr, false});
+}
+
+// The links first, so the clients of a shard found gone are told with the rest
+void Gateway::publish() {
+    for (std::uint16_t i = 0; i < m_shards.size(); ++i) {
+        if (m_shards[i].link && !m_shards[i].link->flush()) {
+            loseShard(i);
+        }
+    }
+    for (std::size_t i = 0; i < m_reactors.size(); ++i) {
+        if (!m_pending[i].empty()) {
+            m_reactors[i]->inbox().push(std::move(m_pending[i]));
+            m_pending[i] = NetOutputBatch();
+        }
+    }
+}
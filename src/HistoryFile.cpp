@@ -0,0 +1,171 @@
+#include "../include/HistoryFile.h"
+#include "../include/FileView.h"
+#include <array>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'E', 'M', 'H', 'I', 'S', 'T', '1', '\n'};
+constexpr std::size_t kRecordHeader = 6;
+
+std::uint32_t readLe(const char* bytes, std::size_t count) noexcept {
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+void writeRecord(std::string& out, std::uint32_t timestamp, std::string_view command) {
+    const auto length = static_cast<std::uint32_t>(command.size());
+    char header[kRecordHeader];
+    for (std::size_t i = 0; i < 4; ++i) header[i] = static_cast<char>(timestamp >> (8 * i));
+    for (std::size_t i = 0; i < 2; ++i) header[4 + i] = static_cast<char>(length >> (8 * i));
+    out.append(header, kRecordHeader);
+    out.append(command);
+}
+
+} // namespace
+
+HistoryFile::~HistoryFile() {
+    close();
+}
+
+HistoryFile::HistoryFile(HistoryFile&& other) noexcept
+    : m_path(std::move(other.m_path))
+    , m_file(std::exchange(other.m_file, nullptr))
+    , m_records(std::exchange(other.m_records, 0)) {}
+
+HistoryFile& HistoryFile::operator=(HistoryFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_path = std::move(other.m_path);
+        m_file = std::exchange(other.m_file, nullptr);
+        m_records = std::exchange(other.m_records, 0);
+    }
+    return *this;
+}
+
+bool HistoryFile::open(const std::filesystem::path& path, std::size_t keep,
+                       const std::function<void(const Record&)>& onRecord) {
+    close();
+    m_path = path;
+
+    std::size_t validBytes = 0;
+    {
+        FileView view(path);
+        const std::string_view bytes = view.bytes();
+        if (!bytes.empty()) {
+            if (bytes.size() < kMagic.size() || std::memcmp(bytes.data(), kMagic.data(), kMagic.size()) != 0) {
+                return false;   // Not ours; leave it alone
+            }
+
+            // Offsets of every complete record; only lengths are read
+            std::vector<std::size_t> offsets;
+            std::size_t pos = kMagic.size();
+            while (pos + kRecordHeader <= bytes.size()) {
+                const std::size_t length = readLe(bytes.data() + pos + 4, 2);
+                if (pos + kRecordHeader + length > bytes.size()) break;
+                offsets.push_back(pos);
+                pos += kRecordHeader + length;
+            }
+            validBytes = pos;
+            m_records = offsets.size();
+
+            const std::size_t first = offsets.size() > keep ? offsets.size() - keep : 0;
+            for (std::size_t i = first; i < offsets.size(); ++i) {
+                const char* record = bytes.data() + offsets[i];
+                onRecord({readLe(record, 4), {record + kRecordHeader, readLe(record + 4, 2)}});
+            }
+
+            // A torn last record would misalign every later append
+            if (validBytes < bytes.size()) {
+                std::error_code ec;
+                std::filesystem::resize_file(path, validBytes, ec);
+                if (ec) return false;
+            }
+        }
+    }
+
+    if (!openForAppend()) {
+        return false;
+    }
+    if (validBytes == 0) {
+        if (std::fwrite(kMagic.data(), 1, kMagic.size(), m_file) != kMagic.size() || std::fflush(m_file) != 0) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void HistoryFile::close() noexcept {
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_records = 0;
+}
+
+bool HistoryFile::append(std::uint32_t timestamp, std::string_view command) {
+    if (!m_file || command.size() > kMaxCommandLength) {
+        return false;
+    }
+    // One buffered write per record, flushed at once, so a crash loses at most the last one
+    std::string record;
+    writeRecord(record, timestamp, command);
+    if (std::fwrite(record.data(), 1, record.size(), m_file) != record.size() || std::fflush(m_file) != 0) {
+        return false;
+    }
+    ++m_records;
+    return true;
+}
+
+bool HistoryFile::rewrite(std::span<const Record> records) {
+    if (!m_file) {
+        return false;
+    }
+
+    std::string contents(kMagic.data(), kMagic.size());
+    std::size_t written = 0;
+    for (const Record& record : records) {
+        if (record.command.size() <= kMaxCommandLength) {
+            writeRecord(contents, record.timestamp, record.command);
+            ++written;
+        }
+    }
+
+    // Write a replacement beside the file and rename it over, so a crash
+    // leaves either the old history or the new one
+    std::filesystem::path temporary = m_path;
+    temporary += ".tmp";
+    std::FILE* out = std::fopen(temporary.string().c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+    const bool ok = std::fwrite(contents.data(), 1, contents.size(), out) == contents.size();
+    if (std::fclose(out) != 0 || !ok) {
+        std::error_code ec;
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+
+    std::fclose(std::exchange(m_file, nullptr));
+    std::error_code ec;
+    std::filesystem::rename(temporary, m_path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        openForAppend();
+        return false;
+    }
+    m_records = written;
+    return openForAppend();
+}
+
+bool HistoryFile::openForAppend() {
+    m_file = std::fopen(m_path.string().c_str(), "ab");
+    return m_file != nullptr;
+}
@@ -0,0 +1,64 @@
+#include "../include/HistoryIndex.h"
+
+namespace {
+
+// Prune once the forgotten ids outnumber this and the live ones
+constexpr std::uint32_t kPruneThreshold = 4096;
+
+} // namespace
+
+void HistoryIndex::add(std::uint32_t id, std::string_view command) {
+    m_end = id + 1;
+    for (std::size_t pos = 0; pos < command.size(); ++pos) {
+        for (std::size_t length = 1; length <= kMaxGram && pos + length <= command.size(); ++length) {
+            std::vector<std::uint32_t>& postings = m_postings[key(command, pos, length)];
+            // A gram repeated within one command is listed once
+            if (postings.empty() || postings.back() != id) {
+                postings.push_back(id);
+            }
+        }
+    }
+}
+
+void HistoryIndex::forgetBefore(std::uint32_t firstLive) {
+    m_firstLive = std::max(m_firstLive, firstLive);
+    const std::uint32_t forgotten = m_firstLive - m_prunedTo;
+    if (forgotten > kPruneThreshold && forgotten > m_end - m_firstLive) {
+        prune();
+    }
+}
+
+void HistoryIndex::clear() noexcept {
+    m_postings.clear();
+    m_firstLive = m_end;
+    m_prunedTo = m_end;
+}
+
+const std::vector<std::uint32_t>* HistoryIndex::rarestPostings(std::string_view needle) const {
+    const std::vector<std::uint32_t>* rarest = nullptr;
+    const std::size_t length = std::min(needle.size(), kMaxGram);
+    for (std::size_t pos = 0; pos + length <= needle.size() && length > 0; ++pos) {
+        auto it = m_postings.find(key(needle, pos, length));
+        if (it == m_postings.end()) {
+            return nullptr;
+        }
+        if (!rarest || it->second.size() < rarest->size()) {
+            rarest = &it->second;
+        }
+    }
+    return rarest;
+}
+
+// Drop forgotten ids from the front of every posting list
+void HistoryIndex::prune() {
+    for (auto it = m_postings.begin(); it != m_postings.end();) {
+        std::vector<std::uint32_t>& postings = it->second;
+        postings.erase(postings.begin(), std::lower_bound(postings.begin(), postings.end(), m_firstLive));
+        if (postings.empty()) {
+            it = m_postings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_prunedTo = m_firstLive;
+}
@@ -0,0 +1,121 @@
+#include "../include/HookPipeline.h"
+#include <algorithm>
+
+HookId HookPipeline::addCommandHook(HookPhase phase, Hook<CommandEvent> hook) {
+    return add(m_commandHooks[index(phase)], bit(HookEvent::Command, phase), std::move(hook));
+}
+
+HookId HookPipeline::addMoveHook(HookPhase phase, Hook<MoveEvent> hook) {
+    return add(m_moveHooks[index(phase)], bit(HookEvent::Move, phase), std::move(hook));
+}
+
+HookId HookPipeline::addPlayerHook(HookEvent event, Hook<PlayerEvent> hook) {
+    auto& hooks = event == HookEvent::PlayerJoin ? m_joinHooks : m_leaveHooks;
+    return add(hooks, bit(event, HookPhase::After), std::move(hook));
+}
+
+template <typename Event>
+HookId HookPipeline::add(HookList<Event>& hooks, std::uint32_t maskBit, Hook<Event> hook) {
+    if (!hook) {
+        return kInvalidHookId;
+    }
+
+    HookId id = m_nextId++;
+    if (m_dispatchDepth > 0) {
+        // Appending now could reallocate the list a running hook lives in
+        m_pendingAdds.push_back([this, &hooks, maskBit, id, hook = std::move(hook)]() mutable {
+            hooks.push_back({id, std::move(hook)});
+            m_mask |= maskBit;
+        });
+        return id;
+    }
+
+    hooks.push_back({id, std::move(hook)});
+    m_mask |= maskBit;
+    return id;
+}
+
+void HookPipeline::remove(HookId id) {
+    if (id == kInvalidHookId) {
+        return;
+    }
+
+    bool removed = removeFrom(m_commandHooks[0], id) || removeFrom(m_commandHooks[1], id) ||
+                   removeFrom(m_moveHooks[0], id) || removeFrom(m_moveHooks[1], id) ||
+                   removeFrom(m_joinHooks, id) || removeFrom(m_leaveHooks, id);
+    if (!removed) {
+        // The hook may still be queued from an add made during this dispatch
+        if (m_dispatchDepth > 0) {
+            m_pendingRemovals.push_back(id);
+        }
+        return;
+    }
+
+    if (m_dispatchDepth > 0) {
+        m_needsCompaction = true;
+    } else {
+        compact();
+    }
+}
+
+template <typename Event>
+bool HookPipeline::removeFrom(HookList<Event>& hooks, HookId id) {
+    auto it = std::find_if(hooks.begin(), hooks.end(), [id](const Entry<Event>& entry) { return entry.id == id; });
+    if (it == hooks.end()) {
+        return false;
+    }
+    // Tombstone only; the entry is erased by compact() once no dispatch is running
+    it->id = kInvalidHookId;
+    return true;
+}
+
+void HookPipeline::compact() {
+    auto prune = [](auto& hooks) {
+        std::erase_if(hooks, [](const auto& entry) { return entry.id == kInvalidHookId; });
+    };
+    prune(m_commandHooks[0]);
+    prune(m_commandHooks[1]);
+    prune(m_moveHooks[0]);
+    prune(m_moveHooks[1]);
+    prune(m_joinHooks);
+    prune(m_leaveHooks);
+    m_needsCompaction = false;
+    rebuildMask();
+}
+
+void HookPipeline::rebuildMask() {
+    m_mask = 0;
+    for (HookPhase phase : {HookPhase::Before, HookPhase::After}) {
+        if (!m_commandHooks[index(phase)].empty()) m_mask |= bit(HookEvent::Command, phase);
+        if (!m_moveHooks[index(phase)].empty()) m_mask |= bit(HookEvent::Move, phase);
+    }
+    if (!m_joinHooks.empty()) m_mask |= bit(HookEvent::PlayerJoin, HookPhase::After);
+    if (!m_leaveHooks.empty()) m_mask |= bit(HookEvent::PlayerLeave, HookPhase::After);
+}
+
+void HookPipeline::finishDispatch() {
+    if (std::atomic_ref<int>(m_dispatchDepth).fetch_sub(1, std::memory_order_acq_rel) > 1) {
+        return;
+    }
+
+    // Apply hooks registered while dispatching; they run from the next event on
+    if (!m_pendingAdds.empty()) {
+        auto pending = std::move(m_pendingAdds);
+        m_pendingAdds.clear();
+        for (auto& apply : pending) {
+            apply();
+        }
+    }
+
+    if (!m_pendingRemovals.empty()) {
+        auto removals = std::move(m_pendingRemovals);
+        m_pendingRemovals.clear();
+        for (HookId id : removals) {
+            remove(id);
+        }
+    }
+
+    if (m_needsCompaction) {
+        compact();
+    }
+}
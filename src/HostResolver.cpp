@@ -0,0 +1,163 @@
+#include "../include/HostResolver.h"
+#include "../include/AccessList.h"
+#include <algorithm>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace {
+
+bool sameAddress(const IpAddress& a, const IpAddress& b) noexcept {
+    return a.v6 == b.v6 && std::equal(a.bytes.begin(), a.bytes.begin() + a.bits() / 8, b.bytes.begin());
+}
+
+// The address a getaddrinfo() result holds, as IpAddress takes it
+std::optional<IpAddress> fromSockaddr(const sockaddr* address) {
+    char text[INET6_ADDRSTRLEN] = {};
+    if (address->sa_family == AF_INET) {
+        ::inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(address)->sin_addr, text, sizeof text);
+    } else if (address->sa_family == AF_INET6) {
+        ::inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6*>(address)->sin6_addr, text, sizeof text);
+    }
+    return IpAddress::parse(text);
+}
+
+} // namespace
+
+HostResolver::HostResolver(NetInbox<ResolvedHost>& results, unsigned threads, std::chrono::seconds ttl)
+    : m_results(results)
+    , m_ttl(ttl) {
+    for (unsigned i = 0; i < std::max(threads, 1u); ++i) {
+        m_threads.emplace_back([this] { work(); });
+    }
+}
+
+HostResolver::~HostResolver() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+std::optional<std::string> HostResolver::submit(std::uint64_t session, const std::string& address) {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.submitted;
+        const auto cached = m_cache.find(address);
+        if (cached != m_cache.end() && cached->second.expires > std::chrono::steady_clock::now()) {
+            ++m_stats.cached;
+            return cached->second.host;
+        }
+        const auto waiting = m_waiting.find(address);
+        if (waiting != m_waiting.end()) {
+            ++m_stats.cached;
+            waiting->second.push_back(session);
+            return std::nullopt;
+        }
+        if (m_queue.size() >= kQueueLimit) {
+            ++m_stats.dropped;
+            return std::nullopt;
+        }
+        m_waiting.emplace(address, std::vector<std::uint64_t>{session});
+        m_queue.push_back(address);
+    }
+    m_wake.notify_one();
+    return std::nullopt;
+}
+
+ResolverStats HostResolver::stats() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void HostResolver::work() {
+    for (;;) {
+        std::string address;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            address = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        std::string host = lookup(address);
+
+        std::vector<std::uint64_t> sessions;
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.lookups;
+            m_stats.named += host.empty() ? 0 : 1;
+            const auto waiting = m_waiting.find(address);
+            if (waiting != m_waiting.end()) {
+                sessions = std::move(waiting->second);
+                m_waiting.erase(waiting);
+            }
+            remember(address, host, std::chrono::steady_clock::now());
+        }
+        for (const std::uint64_t session : sessions) {
+            m_results.push(ResolvedHost{session, address, host});
+        }
+    }
+}
+
+// The name of address, confirmed by looking it up forwards; empty for none
+std::string HostResolver::lookup(const std::string& address) {
+    const std::optional<IpAddress> ip = IpAddress::parse(address);
+    if (!ip) {
+        return {};
+    }
+    sockaddr_storage storage{};
+    socklen_t size = 0;
+    if (ip->v6) {
+        auto& v6 = reinterpret_cast<sockaddr_in6&>(storage);
+        v6.sin6_family = AF_INET6;
+        std::memcpy(&v6.sin6_addr, ip->bytes.data(), 16);
+        size = sizeof v6;
+    } else {
+        auto& v4 = reinterpret_cast<sockaddr_in&>(storage);
+        v4.sin_family = AF_INET;
+        std::memcpy(&v4.sin_addr, ip->bytes.data(), 4);
+        size = sizeof v4;
+    }
+    char host[NI_MAXHOST] = {};
+    if (::getnameinfo(reinterpret_cast<const sockaddr*>(&storage), size, host, sizeof host, nullptr, 0,
+                      NI_NAMEREQD) != 0) {
+        return {};
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (::getaddrinfo(host, nullptr, &hints, &found) != 0) {
+        return {};
+    }
+    bool confirmed = false;
+    for (const addrinfo* entry = found; entry && !confirmed; entry = entry->ai_next) {
+        const std::optional<IpAddress> forward = fromSockaddr(entry->ai_addr);
+        confirmed = forward && sameAddress(*forward, *ip);
+    }
+    ::freeaddrinfo(found);
+    return confirmed ? std::string(host) : std::string();
+}
+
+// Under m_mutex. A full cache first loses what has expired, then, if
+// that is not enough, whatever entry comes first
+void HostResolver::remember(const std::string& address, std::string host, std::chrono::steady_clock::time_point now) {
+    if (m_cache.size() >= kCacheLimit && !m_cache.contains(address)) {
+        std::erase_if(m_cache, [now](const auto& entry) { return entry.second.expires <= now; });
+        if (m_cache.size() >= kCacheLimit) {
+            m_cache.erase(m_cache.begin());
+        }
+    }
+    const std::chrono::seconds ttl = host.empty() ? std::min(m_ttl, std::chrono::seconds(kUnnamedTtl)) : m_ttl;
+    m_cache.insert_or_assign(address, Entry{std::move(host), now + ttl});
+}
@@ -0,0 +1,260 @@
+#include "../include/MemoryAccounting.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <vector>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kSmallestClass = 16;
+constexpr std::size_t kClassCount = std::bit_width(HugePages::kLargestClass / kSmallestClass) + 1;
+
+// A mapping the arena made: 2 MiB-aligned, carved into size classes or
+// holding one big block
+struct Mapping {
+    std::uintptr_t begin;
+    std::size_t size;
+    bool carved;
+    bool explicitPages;
+};
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct Arena {
+    std::mutex mutex;
+    std::vector<Mapping> mappings;   // Sorted by begin
+    std::array<FreeBlock*, kClassCount> free{};
+    char* carving = nullptr;         // What is left of the newest carved mapping
+    std::size_t carvingLeft = 0;
+    bool explicitRefused = false;
+    HugePageStats stats;
+};
+
+Arena& arena() {
+    static Arena instance;
+    return instance;
+}
+
+std::size_t classOf(std::size_t bytes, std::size_t alignment) noexcept {
+    const std::size_t size = std::bit_ceil(std::max({bytes, alignment, kSmallestClass}));
+    return static_cast<std::size_t>(std::countr_zero(size / kSmallestClass));
+}
+
+#ifndef _WIN32
+// size bytes at a 2 MiB boundary, explicit pages when asked and granted;
+// nullptr when even ordinary pages cannot be mapped
+void* mapHuge(Arena& state, std::size_t size, bool& explicitPages) {
+    explicitPages = false;
+#ifdef MAP_HUGETLB
+    if (HugePages::mode() == HugePageMode::Explicit && !state.explicitRefused) {
+        void* pages = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pages != MAP_FAILED) {
+            explicitPages = true;
+            return pages;
+        }
+        state.explicitRefused = true;
+        ++state.stats.fallbacks;
+        LOG_WARN("Huge pages: MAP_HUGETLB refused (is vm.nr_hugepages set?); using transparent ones");
+    }
+#endif
+    // Over-mapped, then trimmed to the boundary, which THP needs to use a huge page
+    const std::size_t padded = size + HugePages::kHugePageSize;
+    void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    const auto start = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t aligned = (start + HugePages::kHugePageSize - 1) & ~(HugePages::kHugePageSize - 1);
+    if (aligned > start) {
+        ::munmap(raw, aligned - start);
+    }
+    if (const std::size_t tail = start + padded - (aligned + size)) {
+        ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void*>(aligned);
+}
+
+void remember(Arena& state, const Mapping& mapping) {
+    const auto at = std::ranges::upper_bound(state.mappings, mapping.begin, {}, &Mapping::begin);
+    state.mappings.insert(at, mapping);
+    ++state.stats.mappings;
+    state.stats.mappedBytes += mapping.size;
+    state.stats.explicitBytes += mapping.explicitPages ? mapping.size : 0;
+}
+#endif
+
+} // namespace
+
+std::atomic<HugePageMode> HugePages::s_mode{HugePageMode::Off};
+std::atomic<bool> HugePages::s_used{false};
+
+void HugePages::configure(HugePageMode mode) noexcept {
+#ifdef _WIN32
+    mode = HugePageMode::Off;
+#endif
+    s_mode.store(mode, std::memory_order_relaxed);
+}
+
+void* HugePages::allocate(std::size_t bytes, std::size_t alignment) noexcept {
+#ifdef _WIN32
+    (void)bytes;
+    (void)alignment;
+    return nullptr;
+#else
+    Arena& state = arena();
+    const std::lock_guard<std::mutex> lock(state.mutex);
+    if (alignment > kHugePageSize) {
+        return nullptr;
+    }
+    if (bytes > kLargestClass) {
+        const std::size_t size = (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        bool explicitPages = false;
+        void* block = mapHuge(state, size, explicitPages);
+        if (block) {
+            remember(state, {reinterpret_cast<std::uintptr_t>(block), size, false, explicitPages});
+            s_used.store(true, std::memory_order_relaxed);
+        }
+        return block;
+    }
+
+    const std::size_t sizeClass = classOf(bytes, alignment);
+    if (FreeBlock* reused = state.free[sizeClass]) {
+        state.free[sizeClass] = reused->next;
+        return reused;
+    }
+    // Each block starts at a multiple of its size into the mapping, so is aligned to it
+    const std::size_t size = kSmallestClass << sizeClass;
+    const std::size_t skip = state.carvingLeft % size;
+    if (state.carvingLeft - skip < size) {
+        bool explicitPages = false;
+        void* mapping = mapHuge(state, kHugePageSize, explicitPages);
+        if (!mapping) {
+            return nullptr;
+        }
+        remember(state, {reinterpret_cast<std::uintptr_t>(mapping), kHugePageSize, true, explicitPages});
+        state.carving = static_cast<char*>(mapping);
+        state.carvingLeft = kHugePageSize;
+    } else {
+        state.carving += skip;
+        state.carvingLeft -= skip;
+    }
+    void* block = state.carving;
+    state.carving += size;
+    state.carvingLeft -= size;
+    s_used.store(true, std::memory_order_relaxed);
+    return block;
+#endif
+}
+
+bool HugePages::release(void* block, std::size_t bytes, std::size_t alignment) noexcept {
+#ifdef _WIN32
+    (void)block;
+    (void)bytes;
+    (void)alignment;
+    return false;
+#else
+    Arena& state = arena();
+    const std::lock_guard<std::mutex> lock(state.mutex);
+    const auto address = reinterpret_cast<std::uintptr_t>(block);
+    auto at = std::ranges::upper_bound(state.mappings, address, {}, &Mapping::begin);
+    if (at == state.mappings.begin() || address >= std::prev(at)->begin + std::prev(at)->size) {
+        return false;
+    }
+    --at;
+    if (at->carved) {
+        auto* freed = static_cast<FreeBlock*>(block);
+        const std::size_t sizeClass = classOf(bytes, alignment);
+        freed->next = state.free[sizeClass];
+        state.free[sizeClass] = freed;
+        return true;
+    }
+    ::munmap(block, at->size);
+    --state.stats.mappings;
+    state.stats.mappedBytes -= at->size;
+    state.stats.explicitBytes -= at->explicitPages ? at->size : 0;
+    state.mappings.erase(at);
+    return true;
+#endif
+}
+
+HugePageStats HugePages::stats() {
+    Arena& state = arena();
+    HugePageStats stats;
+    std::vector<Mapping> mappings;
+    {
+        const std::lock_guard<std::mutex> lock(state.mutex);
+        stats = state.stats;
+        mappings = state.mappings;
+    }
+    stats.mode = mode();
+
+    // The kernel's account, from the areas whose start is one of ours: a
+    // transparent mapping's AnonHugePages, an explicit one's Hugetlb lines
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool ours = false;
+    while (std::getline(smaps, line)) {
+        const std::size_t dash = line.find('-');
+        const bool area = dash != std::string::npos && dash > 0 &&
+                          std::all_of(line.begin(), line.begin() + static_cast<std::ptrdiff_t>(dash),
+                                      [](unsigned char c) { return std::isxdigit(c) != 0; });
+        if (area) {
+            const std::uintptr_t begin = std::stoull(line.substr(0, dash), nullptr, 16);
+            const auto at = std::ranges::upper_bound(mappings, begin, {}, &Mapping::begin);
+            ours = at != mappings.begin() && begin < std::prev(at)->begin + std::prev(at)->size;
+            continue;
+        }
+        if (ours && (line.starts_with("AnonHugePages:") || line.starts_with("Private_Hugetlb:") ||
+                     line.starts_with("Shared_Hugetlb:"))) {
+            stats.hugeBytes += std::stoull(line.substr(line.find(':') + 1)) * 1024;
+        }
+    }
+    return stats;
+}
+
+std::string_view HugePages::name(HugePageMode mode) noexcept {
+    switch (mode) {
+        case HugePageMode::Transparent: return "transparent";
+        case HugePageMode::Explicit: return "explicit";
+        default: return "off";
+    }
+}
+
+bool HugePages::parse(std::string_view text, HugePageMode& mode) noexcept {
+    for (const HugePageMode each : {HugePageMode::Off, HugePageMode::Transparent, HugePageMode::Explicit}) {
+        if (text == name(each)) {
+            mode = each;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string HugePages::report() {
+    const HugePageStats stats = HugePages::stats();
+    const auto mebibytes = [](std::uint64_t bytes) { return static_cast<double>(bytes) / (1 << 20); };
+    std::string line = std::format("Huge pages ({}): {:.1f} MiB of world and session memory in {} mappings, "
+                                   "{:.1f} MiB on huge pages",
+                                   name(stats.mode), mebibytes(stats.mappedBytes), stats.mappings,
+                                   mebibytes(stats.hugeBytes));
+    if (stats.explicitBytes > 0) {
+        line += std::format(" ({:.1f} MiB MAP_HUGETLB)", mebibytes(stats.explicitBytes));
+    }
+    if (stats.fallbacks > 0) {
+        line += "; MAP_HUGETLB was refused, so the rest are transparent";
+    }
+    return line;
+}
@@ -0,0 +1,196 @@
+#include "../include/IoUring.h"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace {
+
+// Multishot receive, the newest feature relied on, arrived in Linux 6.0
+bool kernelSupported() {
+    utsname name{};
+    unsigned major = 0;
+    return uname(&name) == 0 && std::sscanf(name.release, "%u", &major) == 1 && major >= 6;
+}
+
+int registerWith(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+} // namespace
+
+std::unique_ptr<IoUring> IoUring::create(unsigned entries, unsigned receiveBuffers, std::size_t receiveBufferSize,
+                                         unsigned fixedSlots) {
+    if (!kernelSupported()) {
+        return nullptr;
+    }
+    std::unique_ptr<IoUring> ring(new IoUring());
+    if (!ring->setup(entries) || !ring->setupReceiveBuffers(receiveBuffers, receiveBufferSize)) {
+        return nullptr;
+    }
+
+    // One sparse table; slots are filled as output slabs are allocated
+    io_uring_rsrc_register table{};
+    table.nr = fixedSlots;
+    table.flags = IORING_RSRC_REGISTER_SPARSE;
+    if (registerWith(ring->m_fd, IORING_REGISTER_BUFFERS2, &table, sizeof(table)) < 0) {
+        return nullptr;
+    }
+    return ring;
+}
+
+IoUring::~IoUring() {
+    // Closing the ring drops the kernel's references before the memory goes
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+    if (m_sqes) {
+        munmap(m_sqes, m_sqesSize);
+    }
+    if (m_rings) {
+        munmap(m_rings, m_ringsSize);
+    }
+    if (m_receiveRing) {
+        munmap(m_receiveRing, m_receiveRingSize);
+    }
+}
+
+bool IoUring::setup(unsigned entries) {
+    // Completions can outnumber submissions (multishot), so the CQ is larger
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    params.cq_entries = entries * 8;
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (m_fd < 0) {
+        return false;
+    }
+    constexpr std::uint32_t kRequired = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+    if ((params.features & kRequired) != kRequired) {
+        return false;
+    }
+
+    m_ringsSize = std::max<std::size_t>(params.sq_off.array + params.sq_entries * sizeof(std::uint32_t),
+                                        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    void* rings = mmap(nullptr, m_ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                       IORING_OFF_SQ_RING);
+    if (rings == MAP_FAILED) {
+        return false;
+    }
+    m_rings = rings;
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* base = static_cast<char*>(m_rings);
+    m_sqHead = reinterpret_cast<std::uint32_t*>(base + params.sq_off.head);
+    m_sqTail = reinterpret_cast<std::uint32_t*>(base + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<std::uint32_t*>(base + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqQueued = *m_sqTail;
+    m_cqHead = reinterpret_cast<std::uint32_t*>(base + params.cq_off.head);
+    m_cqTail = reinterpret_cast<std::uint32_t*>(base + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<std::uint32_t*>(base + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+    // Entries are used in ring order, so the index array never changes
+    auto* array = reinterpret_cast<std::uint32_t*>(base + params.sq_off.array);
+    for (std::uint32_t i = 0; i < m_sqEntries; ++i) {
+        array[i] = i;
+    }
+    return true;
+}
+
+bool IoUring::setupReceiveBuffers(unsigned count, std::size_t size) {
+    if (count == 0 || count > 32768 || (count & (count - 1)) != 0) {
+        return false;
+    }
+    m_receiveRingSize = count * sizeof(io_uring_buf);
+    void* ring = mmap(nullptr, m_receiveRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        return false;
+    }
+    m_receiveRing = static_cast<io_uring_buf*>(ring);
+    m_receiveMask = static_cast<std::uint16_t>(count - 1);
+    m_receiveBufferSize = size;
+    m_receiveData = std::make_unique_for_overwrite<char[]>(count * size);
+
+    io_uring_buf_reg group{};
+    group.ring_addr = reinterpret_cast<std::uint64_t>(ring);
+    group.ring_entries = count;
+    group.bgid = kBufferGroup;
+    if (registerWith(m_fd, IORING_REGISTER_PBUF_RING, &group, 1) < 0) {
+        return false;
+    }
+    for (unsigned id = 0; id < count; ++id) {
+        recycle(id);
+    }
+    return true;
+}
+
+io_uring_sqe& IoUring::next() {
+    while (m_sqQueued - std::atomic_ref<std::uint32_t>(*m_sqHead).load(std::memory_order_acquire) >= m_sqEntries) {
+        enter(0, 0, nullptr, 0);
+    }
+    io_uring_sqe& sqe = m_sqes[m_sqQueued++ & m_sqMask];
+    sqe = io_uring_sqe{};
+    return sqe;
+}
+
+void IoUring::submitAndWait(int timeoutMs) {
+    if (std::atomic_ref<std::uint32_t>(*m_cqTail).load(std::memory_order_acquire) != *m_cqHead) {
+        enter(0, 0, nullptr, 0);
+        return;
+    }
+    __kernel_timespec timeout{};
+    io_uring_getevents_arg arg{};
+    arg.sigmask_sz = _NSIG / 8;
+    if (timeoutMs >= 0) {
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = (timeoutMs % 1000) * 1'000'000L;
+        arg.ts = reinterpret_cast<std::uint64_t>(&timeout);
+    }
+    enter(1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+}
+
+// Publish the queued entries and hand them to the kernel. Timeouts (ETIME)
+// and signals (EINTR) just return to the caller's loop
+void IoUring::enter(unsigned minComplete, unsigned flags, const void* arg, std::size_t argSize) {
+    std::atomic_ref<std::uint32_t>(*m_sqTail).store(m_sqQueued, std::memory_order_release);
+    const unsigned submit = m_sqQueued - std::atomic_ref<std::uint32_t>(*m_sqHead).load(std::memory_order_acquire);
+    if (submit == 0 && minComplete == 0) {
+        return;
+    }
+    syscall(__NR_io_uring_enter, m_fd, submit, minComplete, flags, arg, argSize);
+}
+
+bool IoUring::registerBuffer(unsigned slot, void* data, std::size_t size) {
+    iovec buffer{data, size};
+    io_uring_rsrc_update2 update{};
+    update.offset = slot;
+    update.data = reinterpret_cast<std::uint64_t>(&buffer);
+    update.nr = 1;
+    return registerWith(m_fd, IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof(update)) >= 0;
+}
+
+void IoUring::recycle(unsigned id) noexcept {
+    io_uring_buf& buffer = m_receiveRing[m_receiveTail & m_receiveMask];
+    buffer.addr = reinterpret_cast<std::uint64_t>(m_receiveData.get() + id * m_receiveBufferSize);
+    buffer.len = static_cast<std::uint32_t>(m_receiveBufferSize);
+    buffer.bid = static_cast<std::uint16_t>(id);
+    // The ring's tail shares its first entry's reserved field
+    auto* ring = reinterpret_cast<io_uring_buf_ring*>(m_receiveRing);
+    std::atomic_ref<std::uint16_t>(ring->tail).store(++m_receiveTail, std::memory_order_release);
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "../include/JobSystem.h"
+#include "../include/ThreadTopology.h"
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned threads, std::span<const int> cores)
+    : m_spans(std::make_unique<Span[]>(static_cast<std::size_t>(threads) + 1)) {
+    m_threads.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&JobSystem::workerLoop, this, i + 1);
+        if (!cores.empty()) {
+            ThreadTopology::pin(m_threads.back().native_handle(), cores.subspan(i % cores.size(), 1));
+        }
+    }
+}
+
+JobSystem::~JobSystem() {
+    m_stop.store(true, std::memory_order_relaxed);
+    m_generation.fetch_add(1, std::memory_order_release);
+    m_generation.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+unsigned JobSystem::defaultThreads() {
+    const unsigned cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, const Body& body) {
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = chunkCount(count, grain);
+    m_body = &body;
+    m_count = count;
+    m_grain = grain;
+
+    // Not worth waking anyone for
+    if (m_threads.empty() || chunks <= 1) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            runChunk(chunk, 0);
+        }
+        return;
+    }
+
+    const std::size_t threads = threadCount();
+    for (std::size_t i = 0; i < threads; ++i) {
+        m_spans[i].next.store(i * chunks / threads, std::memory_order_relaxed);
+        m_spans[i].end = (i + 1) * chunks / threads;
+    }
+    m_running.store(static_cast<unsigned>(m_threads.size()), std::memory_order_relaxed);
+    m_generation.fetch_add(1, std::memory_order_release);
+    m_generation.notify_all();
+
+    work(0);
+
+    // Every worker must be out before the body goes out of scope
+    for (unsigned running = m_running.load(std::memory_order_acquire); running != 0;
+         running = m_running.load(std::memory_order_acquire)) {
+        m_running.wait(running, std::memory_order_acquire);
+    }
+}
+
+void JobSystem::workerLoop(unsigned worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        m_generation.wait(seen, std::memory_order_acquire);
+        seen = m_generation.load(std::memory_order_acquire);
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return;
+        }
+        work(worker);
+        if (m_running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_running.notify_one();
+        }
+    }
+}
+
+void JobSystem::work(unsigned worker) {
+    // Own span first, then the others in turn from the next one along
+    const std::size_t threads = threadCount();
+    for (std::size_t offset = 0; offset < threads; ++offset) {
+        Span& span = m_spans[(worker + offset) % threads];
+        for (std::size_t chunk = span.next.fetch_add(1, std::memory_order_relaxed); chunk < span.end;
+             chunk = span.next.fetch_add(1, std::memory_order_relaxed)) {
+            runChunk(chunk, worker);
+        }
+    }
+}
+
+void JobSystem::runChunk(std::size_t chunk, unsigned worker) const {
+    const std::size_t begin = chunk * m_grain;
+    (*m_body)({begin, std::min(m_count, begin + m_grain), chunk, worker});
+}
@@ -0,0 +1,290 @@
+#include "../include/Journal.h"
+#include "../include/FileView.h"
+#include "../include/FileUtil.h"
+#include "../include/MappedRecords.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::string_view kPrefix = "journal-";
+constexpr std::string_view kSuffix = ".log";
+
+// The first sequence number a segment's name gives, or 0 for anything else
+std::uint64_t segmentFirst(const std::filesystem::path& path) {
+    const std::string name = path.filename().string();
+    if (!name.starts_with(kPrefix) || !name.ends_with(kSuffix)) {
+        return 0;
+    }
+    const std::string_view digits = std::string_view(name).substr(kPrefix.size(),
+                                                                  name.size() - kPrefix.size() - kSuffix.size());
+    std::uint64_t first = 0;
+    const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), first, 16);
+    return ec == std::errc() && end == digits.data() + digits.size() ? first : 0;
+}
+
+// Oldest first
+std::vector<std::pair<std::uint64_t, std::filesystem::path>> listSegments(const std::filesystem::path& directory) {
+    std::vector<std::pair<std::uint64_t, std::filesystem::path>> segments;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (const std::uint64_t first = segmentFirst(entry.path()); first != 0) {
+            segments.emplace_back(first, entry.path());
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+} // namespace
+
+Journal::Recovered Journal::recover(const std::filesystem::path& directory,
+                                    const std::function<void(std::string_view, std::uint64_t, std::string_view)>& apply) {
+    Recovered recovered;
+    for (const auto& [first, path] : listSegments(directory)) {
+        ++recovered.segments;
+        recovered.nextSequence = std::max(recovered.nextSequence, first);
+        const FileView file(path);
+        std::string_view bytes = file.bytes();
+        std::uint64_t last = first - 1;
+        while (bytes.size() >= sizeof(JournalRecordHeader)) {
+            JournalRecordHeader header;
+            std::memcpy(&header, bytes.data(), sizeof header);
+            // A crash mid-write leaves a short or garbled last record
+            if (header.size > bytes.size() - sizeof header || header.keySize > header.size
+                || header.sequence <= last) {
+                break;
+            }
+            const std::string_view body = bytes.substr(sizeof header, header.size);
+            if (mapped::fnv1a(body) != header.checksum) {
+                break;
+            }
+            apply(body.substr(0, header.keySize), header.sequence, body.substr(header.keySize));
+            ++recovered.records;
+            last = header.sequence;
+            recovered.nextSequence = std::max(recovered.nextSequence, last + 1);
+            bytes.remove_prefix(std::min(FileUtil::padded(sizeof header + header.size), bytes.size()));
+        }
+        recovered.tornBytes += bytes.size();
+    }
+    return recovered;
+}
+
+Journal::Journal(std::filesystem::path directory, std::uint64_t firstSequence, JournalSync sync,
+                 std::chrono::milliseconds syncInterval, std::size_t ringBytes)
+    : m_directory(std::move(directory))
+    , m_sync(sync)
+    , m_syncInterval(std::max(syncInterval, std::chrono::milliseconds(1)))
+    , m_ring(ringBytes)
+    , m_next(std::max<std::uint64_t>(firstSequence, 1)) {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    // What earlier runs left is only known to end before this one starts
+    for (const auto& [first, path] : listSegments(m_directory)) {
+        if (first != m_next) {
+            m_segments.push_back({path, m_next - 1});
+        }
+    }
+    openSegment(m_next);
+    m_durable.store(m_next - 1, std::memory_order_relaxed);
+    m_lastSync = std::chrono::steady_clock::now();
+    m_thread = std::thread([this] { work(); });
+}
+
+Journal::~Journal() {
+    // However far behind the writer is, nothing appended is dropped
+    while (!m_overflow.empty()) {
+        commit();
+        std::this_thread::yield();
+    }
+    commit();
+    m_stopping.store(true, std::memory_order_release);
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+    m_thread.join();
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+std::uint64_t Journal::append(std::string_view key, std::string_view payload) {
+    JournalRecordHeader header;
+    header.size = static_cast<std::uint32_t>(key.size() + payload.size());
+    header.sequence = m_next++;
+    header.keySize = static_cast<std::uint32_t>(key.size());
+
+    m_record.assign(sizeof header, '\0');
+    m_record.append(key);
+    m_record.append(payload);
+    header.checksum = mapped::fnv1a(std::string_view(m_record).substr(sizeof header));
+    std::memcpy(m_record.data(), &header, sizeof header);
+    m_record.resize(FileUtil::padded(m_record.size()), '\0');
+
+    // Behind anything already waiting, so the order holds
+    if (!m_overflow.empty() || !m_ring.write(m_record)) {
+        m_overflow.push_back(m_record);
+        ++m_overflowed;
+    }
+    return header.sequence;
+}
+
+void Journal::commit() {
+    while (!m_overflow.empty() && m_ring.write(m_overflow.front())) {
+        m_overflow.pop_front();
+    }
+    m_ring.publish();
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+}
+
+void Journal::release(std::uint64_t through) {
+    if (through <= m_release.load(std::memory_order_relaxed)) {
+        return;
+    }
+    m_release.store(through, std::memory_order_release);
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+}
+
+JournalStats Journal::stats() const {
+    const std::lock_guard<std::mutex> lock(m_statsMutex);
+    JournalStats stats = m_stats;
+    stats.overflowed = m_overflowed;
+    return stats;
+}
+
+std::filesystem::path Journal::segmentPath(std::uint64_t first) const {
+    return m_directory / std::format("{}{:016x}{}", kPrefix, first, kSuffix);
+}
+
+bool Journal::openSegment(std::uint64_t first) {
+    const std::filesystem::path path = segmentPath(first);
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        const std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.failed;
+        return false;
+    }
+    if (m_fd >= 0) {
+        // The old segment's records have to last as long as the new one's
+        if (m_unsynced && m_sync != JournalSync::Never) {
+            FileUtil::syncFile(m_fd);
+            m_unsynced = false;
+        }
+        ::close(m_fd);
+    }
+    m_fd = fd;
+    m_segments.push_back({path, first - 1});
+    return true;
+}
+
+void Journal::work() {
+    std::string batch;
+    std::uint64_t released = 0;
+    std::uint64_t unsyncedThrough = 0;
+    for (;;) {
+        // Loaded before draining, so a commit made meanwhile is not slept through
+        const std::uint64_t seen = m_signal.load(std::memory_order_acquire);
+        const bool stopping = m_stopping.load(std::memory_order_acquire);
+
+        batch.clear();
+        if (m_ring.read(batch) > 0) {
+            writeBatch(batch);
+            unsyncedThrough = m_segments.back().last;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        const bool due = m_sync == JournalSync::Always || stopping || now - m_lastSync >= m_syncInterval;
+        if (m_unsynced && m_sync != JournalSync::Never && due && m_fd >= 0) {
+            const bool synced = FileUtil::syncFile(m_fd);
+            const auto took = std::chrono::steady_clock::now() - now;
+            m_lastSync = std::chrono::steady_clock::now();
+            m_unsynced = false;
+            const std::lock_guard<std::mutex> lock(m_statsMutex);
+            ++m_stats.syncs;
+            m_stats.failed += synced ? 0 : 1;
+            m_stats.longestSync = std::max<std::chrono::nanoseconds>(m_stats.longestSync, took);
+        }
+        if (!m_unsynced) {
+            m_durable.store(std::max(m_durable.load(std::memory_order_relaxed), unsyncedThrough),
+                            std::memory_order_release);
+        }
+
+        if (const std::uint64_t through = m_release.load(std::memory_order_acquire); through > released) {
+            releaseSegments(through);
+            released = through;
+        }
+        if (stopping) {
+            return;
+        }
+
+        // An unsynced group on an interval is synced when its time comes even
+        // if nothing else is committed; otherwise sleep until something is
+        if (m_unsynced && m_sync == JournalSync::Interval) {
+            const auto deadline = std::min(m_lastSync + m_syncInterval,
+                                           std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+            std::this_thread::sleep_until(deadline);
+        } else {
+            m_signal.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+void Journal::writeBatch(const std::string& batch) {
+    bool written = m_fd >= 0;
+    for (std::size_t done = 0; written && done < batch.size();) {
+        const ssize_t wrote = ::write(m_fd, batch.data() + done, batch.size() - done);
+        if (wrote < 0 && errno == EINTR) {
+            continue;
+        }
+        written = wrote > 0;
+        done += written ? static_cast<std::size_t>(wrote) : 0;
+    }
+
+    // Commits end on record boundaries, so the batch is whole records
+    std::uint64_t records = 0;
+    for (std::size_t offset = 0; offset + sizeof(JournalRecordHeader) <= batch.size();) {
+        JournalRecordHeader header;
+        std::memcpy(&header, batch.data() + offset, sizeof header);
+        ++records;
+        m_segments.back().last = header.sequence;
+        offset += FileUtil::padded(sizeof header + header.size);
+    }
+    m_unsynced = m_unsynced || (written && m_sync != JournalSync::Never);
+
+    const std::lock_guard<std::mutex> lock(m_statsMutex);
+    ++m_stats.batches;
+    m_stats.records += records;
+    m_stats.bytes += batch.size();
+    m_stats.failed += written ? 0 : 1;
+}
+
+void Journal::releaseSegments(std::uint64_t through) {
+    // The segment being written goes too once everything in it is released,
+    // so later records go into a new one first
+    const Segment& current = m_segments.back();
+    if (current.last >= segmentFirst(current.path) && current.last <= through) {
+        openSegment(current.last + 1);
+    }
+    // What the records were released to, such as saves renamed into place
+    // without a sync of their own, reaches the disk before they go
+    const bool releasing = std::any_of(m_segments.begin(), m_segments.end() - 1,
+                                       [through](const Segment& segment) { return segment.last <= through; });
+    if (releasing && m_sync != JournalSync::Never) {
+        ::sync();
+    }
+    std::error_code error;
+    for (auto segment = m_segments.begin(); segment + 1 < m_segments.end();) {
+        if (segment->last <= through) {
+            std::filesystem::remove(segment->path, error);
+            segment = m_segments.erase(segment);
+        } else {
+            ++segment;
+        }
+    }
+}
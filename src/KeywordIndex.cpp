@@ -0,0 +1,95 @@
+#include "../include/KeywordIndex.h"
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <string>
+
+namespace {
+
+std::string folded(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+Keywords KeywordIndex::keywordsOf(std::string_view name) {
+    StringInterner& interner = StringInterner::global();
+    const std::string lowered = folded(name);
+    const std::string_view whole = lowered;
+    Keywords keywords;
+    std::size_t words = 0;
+    std::size_t start = 0;
+    while (start < whole.size()) {
+        const std::size_t space = std::min(whole.find(' ', start), whole.size());
+        if (space > start) {
+            const Symbol word = interner.intern(whole.substr(start, space - start));
+            if (std::find(keywords.symbols.begin(), keywords.symbols.end(), word) == keywords.symbols.end()) {
+                keywords.symbols.push_back(word);
+            }
+            ++words;
+        }
+        start = space + 1;
+    }
+    if (words > 1) {
+        keywords.symbols.push_back(interner.intern(whole));
+    }
+    return keywords;
+}
+
+KeywordIndex::Target KeywordIndex::parse(std::string_view typed) {
+    Target target;
+    if (const std::size_t dot = typed.find('.'); dot != std::string_view::npos && dot > 0) {
+        const auto [end, ec] = std::from_chars(typed.data(), typed.data() + dot, target.nth);
+        if (ec == std::errc() && end == typed.data() + dot) {
+            if (target.nth == 0) {
+                return target;
+            }
+            typed.remove_prefix(dot + 1);
+        } else {
+            target.nth = 1;
+        }
+    }
+    target.keyword = StringInterner::global().find(folded(typed));
+    return target;
+}
+
+void KeywordIndex::add(Entity entity, const Keywords& keywords) {
+    if (m_arrivals == std::numeric_limits<std::uint32_t>::max()) {
+        // Renumbering in the present order keeps every keyword's order
+        m_arrivals = 0;
+        for (Entry& entry : m_entries) {
+            entry.arrival = m_arrivals++;
+        }
+    }
+    const std::uint32_t arrival = m_arrivals++;
+    for (const Symbol keyword : keywords.symbols) {
+        // Last among its keyword, as the newest arrival
+        const auto at = std::upper_bound(m_entries.begin(), m_entries.end(), keyword,
+                                         [](Symbol key, const Entry& entry) { return key < entry.keyword; });
+        m_entries.insert(at, {keyword, arrival, entity});
+    }
+}
+
+void KeywordIndex::remove(Entity entity, const Keywords& keywords) {
+    for (const Symbol keyword : keywords.symbols) {
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), keyword,
+                                   [](const Entry& entry, Symbol key) { return entry.keyword < key; });
+        for (; it != m_entries.end() && it->keyword == keyword; ++it) {
+            if (it->entity == entity) {
+                m_entries.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+std::vector<KeywordIndex::Entry>::const_iterator KeywordIndex::lowerBound(Symbol keyword) const {
+    return std::lower_bound(m_entries.begin(), m_entries.end(), keyword,
+                            [](const Entry& entry, Symbol key) { return entry.keyword < key; });
+}
@@ -0,0 +1,365 @@
+#include "../include/Logger.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <ctime>
+#include <system_error>
+#include <utility>
+#if defined(ENABLE_LOG_GZIP)
+    #include <zlib.h>
+#endif
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace {
+
+constexpr std::array<std::string_view, 5> kLevelNames = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+
+// Keeps a thread's buffer registered until the thread exits; the sink
+// writes out what is left in it and then lets it go
+struct ThreadBufferOwner {
+    std::shared_ptr<logdetail::ThreadBuffer> buffer;
+
+    ~ThreadBufferOwner() {
+        if (buffer) {
+            buffer->finished.store(true, std::memory_order_release);
+        }
+    }
+};
+
+// HH:MM:SS of the last second a line was logged in, so a burst of lines
+// converts and formats the time once rather than once a line
+struct SecondStamp {
+    std::time_t second = -1;
+    char clock[16] = {};
+};
+
+// [HH:MM:SS.mmm] [LEVEL] message
+void appendPrefix(std::string& out, SecondStamp& stamp, std::int64_t time, LogLevel level) {
+    const std::time_t seconds = static_cast<std::time_t>(time / 1'000'000'000);
+    if (seconds != stamp.second) {
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        std::strftime(stamp.clock, sizeof stamp.clock, "%H:%M:%S", &local);
+        stamp.second = seconds;
+    }
+    std::format_to(std::back_inserter(out), "[{}.{:03}] [{}] ", stamp.clock, time / 1'000'000 % 1000,
+                   kLevelNames[std::min<std::size_t>(static_cast<std::size_t>(level), kLevelNames.size() - 1)]);
+}
+
+// The local time for a moved-aside file's name, to the millisecond, so the
+// names sort in the order the files were written
+std::string rotationStamp() {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    char stamp[32] = {};
+    std::strftime(stamp, sizeof stamp, "%Y%m%d-%H%M%S", &local);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    return std::format("{}-{:03}", stamp, millis);
+}
+
+// path gzipped beside it as path.gz, then removed; false, leaving path, on any failure
+bool gzipFile(const std::filesystem::path& path) {
+#if defined(ENABLE_LOG_GZIP)
+    std::FILE* in = std::fopen(path.string().c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+    std::filesystem::path packed = path;
+    packed += ".gz";
+    std::filesystem::path temporary = packed;
+    temporary += ".tmp";
+    gzFile out = gzopen(temporary.string().c_str(), "wb");
+    bool ok = out != nullptr;
+    std::array<char, 64 * 1024> block;
+    while (ok) {
+        const std::size_t read = std::fread(block.data(), 1, block.size(), in);
+        if (read == 0) {
+            ok = !std::ferror(in);
+            break;
+        }
+        ok = gzwrite(out, block.data(), static_cast<unsigned>(read)) == static_cast<int>(read);
+    }
+    std::fclose(in);
+    ok = out && gzclose(out) == Z_OK && ok;
+    std::error_code error;
+    if (ok) {
+        std::filesystem::rename(temporary, packed, error);
+        ok = !error;
+    }
+    if (!ok) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    std::filesystem::remove(path, error);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+// Delete the oldest files moved aside from current past the newest keep
+void pruneRotated(const std::filesystem::path& current, unsigned keep) {
+    if (keep == 0) {
+        return;
+    }
+    const std::string prefix = current.filename().string() + ".";
+    std::filesystem::path directory = current.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    std::vector<std::filesystem::path> rotated;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.starts_with(prefix) && !name.ends_with(".tmp")) {
+            rotated.push_back(entry.path());
+        }
+    }
+    if (rotated.size() <= keep) {
+        return;
+    }
+    // Newest first: the stamps sort, and a name with .gz is the same file
+    std::ranges::sort(rotated, std::greater<>());
+    for (std::size_t i = keep; i < rotated.size(); ++i) {
+        std::filesystem::remove(rotated[i], error);
+    }
+}
+
+} // namespace
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : m_thread([this] { work(); }) {}
+
+Logger::~Logger() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    // Once the sink is done, so it rotates nothing more; files it moved
+    // aside that are still waiting are left as they are
+    m_housekeeping.notify_one();
+    if (m_housekeeper.joinable()) {
+        m_housekeeper.join();
+    }
+    if (m_file) {
+        std::fclose(m_file);
+    }
+}
+
+logdetail::ThreadBuffer& Logger::threadBuffer() {
+    thread_local ThreadBufferOwner owner;
+    if (!owner.buffer) {
+        owner.buffer = std::make_shared<logdetail::ThreadBuffer>();
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffers.push_back(owner.buffer);
+    }
+    return *owner.buffer;
+}
+
+void Logger::setFile(const std::filesystem::path& path) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_path = path;
+    m_reopen = true;
+}
+
+void Logger::setRotation(const LogRotation& rotation) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_rotation = rotation;
+}
+
+void Logger::setStderr(bool enabled) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stderr = enabled;
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::uint64_t request = ++m_flushRequested;
+    m_wake.notify_one();
+    m_flushed.wait(lock, [&] { return m_flushDone >= request || m_stopping; });
+}
+
+LogStats Logger::stats() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void Logger::work() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait_for(lock, kSinkInterval, [this] { return m_stopping || m_flushDone < m_flushRequested; });
+        const bool stopping = m_stopping;
+        const std::uint64_t requested = m_flushRequested;
+        lock.unlock();
+        drain();
+        lock.lock();
+        m_flushDone = requested;
+        m_flushed.notify_all();
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void Logger::drain() {
+    std::vector<std::shared_ptr<logdetail::ThreadBuffer>> buffers;
+    std::filesystem::path path;
+    bool reopen = false;
+    bool toStderr = false;
+    LogRotation rotation;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        buffers = m_buffers;
+        path = m_path;
+        reopen = std::exchange(m_reopen, false);
+        toStderr = m_stderr;
+        rotation = m_rotation;
+    }
+
+    // Every thread's records, then formatted in the order they were logged
+    struct Line {
+        std::int64_t time;
+        std::size_t offset;   // Of its record in m_batch
+    };
+    std::vector<Line> lines;
+    std::vector<std::shared_ptr<logdetail::ThreadBuffer>> finished;
+    std::uint64_t dropped = 0;
+    m_batch.clear();
+    for (const auto& buffer : buffers) {
+        // Read before the records, so a thread's last ones are never missed
+        const bool done = buffer->finished.load(std::memory_order_acquire);
+        const std::size_t start = m_batch.size();
+        buffer->ring.read(m_batch);
+        for (std::size_t offset = start; offset < m_batch.size();) {
+            logdetail::RecordHeader header;
+            std::memcpy(&header, m_batch.data() + offset, sizeof header);
+            lines.push_back({header.time, offset});
+            offset += header.size;
+        }
+        const std::uint64_t total = buffer->dropped.load(std::memory_order_relaxed);
+        dropped += total - std::exchange(buffer->reported, total);
+        if (done) {
+            finished.push_back(buffer);
+        }
+    }
+    std::stable_sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.time < b.time; });
+
+    // Only the sink thread formats lines
+    static SecondStamp stamp;
+    m_lines.clear();
+    for (const Line& line : lines) {
+        logdetail::RecordHeader header;
+        std::memcpy(&header, m_batch.data() + line.offset, sizeof header);
+        appendPrefix(m_lines, stamp, header.time, header.level);
+        try {
+            header.render(m_lines, {header.format, header.formatSize}, m_batch.data() + line.offset + sizeof header);
+        } catch (const std::format_error& e) {
+            m_lines += std::format("(bad log format: {})", e.what());
+        }
+        m_lines += '\n';
+    }
+    if (dropped > 0) {
+        std::format_to(std::back_inserter(m_lines),
+                       "[logger] {} messages dropped: a thread logged faster than the sink kept up\n", dropped);
+    }
+
+    if (reopen) {
+        if (m_file) {
+            std::fclose(m_file);
+        }
+        m_file = path.empty() ? nullptr : std::fopen(path.string().c_str(), "a");
+        // Appending to what an earlier run left, which counts towards its size
+        m_fileBytes = m_file && std::fseek(m_file, 0, SEEK_END) == 0 ? static_cast<std::uint64_t>(std::ftell(m_file)) : 0;
+        m_opened = std::chrono::steady_clock::now();
+    }
+    if (!m_lines.empty()) {
+        if (m_file) {
+            std::fwrite(m_lines.data(), 1, m_lines.size(), m_file);
+            std::fflush(m_file);
+            m_fileBytes += m_lines.size();
+        }
+        if (toStderr) {
+            std::fwrite(m_lines.data(), 1, m_lines.size(), stderr);
+        }
+    }
+
+    if (m_file && ((rotation.maxBytes != 0 && m_fileBytes >= rotation.maxBytes) ||
+                   (rotation.maxAge.count() != 0 && std::chrono::steady_clock::now() - m_opened >= rotation.maxAge))) {
+        rotate(path, rotation);
+    }
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.written += lines.size();
+    m_stats.dropped += dropped;
+    for (const auto& buffer : finished) {
+        std::erase(m_buffers, buffer);
+    }
+}
+
+void Logger::rotate(const std::filesystem::path& path, const LogRotation& rotation) {
+    std::fclose(m_file);
+    m_file = nullptr;
+    std::filesystem::path aside = path;
+    aside += "." + rotationStamp();
+    std::error_code error;
+    std::filesystem::rename(path, aside, error);
+    // Whatever happened, the sink goes on writing; a file that could not be
+    // moved is appended to until the next try
+    m_file = std::fopen(path.string().c_str(), "a");
+    m_fileBytes = m_file && error && std::fseek(m_file, 0, SEEK_END) == 0 ? static_cast<std::uint64_t>(std::ftell(m_file)) : 0;
+    m_opened = std::chrono::steady_clock::now();
+    if (error) {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.rotated;
+    m_rotated.push_back({std::move(aside), path, rotation});
+    if (!m_housekeeper.joinable()) {
+        m_housekeeper = std::thread([this] { keepHouse(); });
+    }
+    m_housekeeping.notify_one();
+}
+
+// Gzip what the sink moved aside and keep only the newest, out of the way
+// of everything else
+void Logger::keepHouse() {
+#ifdef __linux__
+    const sched_param idle{};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &idle);
+#endif
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_housekeeping.wait(lock, [this] { return m_stopping || !m_rotated.empty(); });
+        if (m_stopping) {
+            return;
+        }
+        const Rotated rotated = std::move(m_rotated.front());
+        m_rotated.erase(m_rotated.begin());
+        lock.unlock();
+        const bool compressed = rotated.rotation.compress && gzipFile(rotated.path);
+        pruneRotated(rotated.current, rotated.rotation.keep);
+        lock.lock();
+        m_stats.compressed += compressed ? 1 : 0;
+    }
+}
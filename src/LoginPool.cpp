@@ -0,0 +1,323 @@
+#include "../include/LoginPool.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+constexpr std::string_view kScheme = "pbkdf2-sha256";
+constexpr std::size_t kSaltSize = 16;
+
+// SHA-256 (FIPS 180-4), streamed so HMAC can resume from its keyed states
+class Sha256 {
+public:
+    using Digest = std::array<unsigned char, 32>;
+
+    void update(const unsigned char* data, std::size_t size) noexcept {
+        m_length += size;
+        while (size > 0) {
+            const std::size_t take = std::min(size, m_block.size() - m_used);
+            std::memcpy(m_block.data() + m_used, data, take);
+            m_used += take;
+            data += take;
+            size -= take;
+            if (m_used == m_block.size()) {
+                compress();
+                m_used = 0;
+            }
+        }
+    }
+
+    Digest finish() noexcept {
+        const std::uint64_t bits = m_length * 8;
+        const unsigned char pad = 0x80;
+        update(&pad, 1);
+        const unsigned char zero = 0;
+        while (m_used != 56) {
+            update(&zero, 1);
+        }
+        unsigned char length[8];
+        for (int i = 0; i < 8; ++i) {
+            length[i] = static_cast<unsigned char>(bits >> (56 - i * 8));
+        }
+        update(length, sizeof(length));
+
+        Digest digest;
+        for (std::size_t i = 0; i < digest.size(); ++i) {
+            digest[i] = static_cast<unsigned char>(m_state[i / 4] >> (24 - (i % 4) * 8));
+        }
+        return digest;
+    }
+
+private:
+    static std::uint32_t rotate(std::uint32_t value, int bits) noexcept { return (value >> bits) | (value << (32 - bits)); }
+
+    void compress() noexcept {
+        static constexpr std::uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+        std::uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            const unsigned char* p = m_block.data() + i * 4;
+            w[i] = (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+        }
+        for (int i = 16; i < 64; ++i) {
+            const std::uint32_t s0 = rotate(w[i - 15], 7) ^ rotate(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const std::uint32_t s1 = rotate(w[i - 2], 17) ^ rotate(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        std::uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        std::uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+        for (int i = 0; i < 64; ++i) {
+            const std::uint32_t t1 = h + (rotate(e, 6) ^ rotate(e, 11) ^ rotate(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            const std::uint32_t t2 = (rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+        m_state[4] += e;
+        m_state[5] += f;
+        m_state[6] += g;
+        m_state[7] += h;
+    }
+
+    std::uint32_t m_state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::array<unsigned char, 64> m_block{};
+    std::size_t m_used = 0;
+    std::uint64_t m_length = 0;
+};
+
+// PBKDF2-HMAC-SHA256 (RFC 8018) for one block of output. The keyed inner
+// and outer states are computed once, so each iteration is two compressions
+Sha256::Digest pbkdf2(std::string_view password, const unsigned char* salt, std::size_t saltSize,
+                      std::uint32_t iterations) {
+    std::array<unsigned char, 64> key{};
+    if (password.size() > key.size()) {
+        Sha256 hashed;
+        hashed.update(reinterpret_cast<const unsigned char*>(password.data()), password.size());
+        const Sha256::Digest digest = hashed.finish();
+        std::copy(digest.begin(), digest.end(), key.begin());
+    } else {
+        std::memcpy(key.data(), password.data(), password.size());
+    }
+    std::array<unsigned char, 64> pad;
+    Sha256 inner;
+    Sha256 outer;
+    std::transform(key.begin(), key.end(), pad.begin(), [](unsigned char c) { return static_cast<unsigned char>(c ^ 0x36); });
+    inner.update(pad.data(), pad.size());
+    std::transform(key.begin(), key.end(), pad.begin(), [](unsigned char c) { return static_cast<unsigned char>(c ^ 0x5c); });
+    outer.update(pad.data(), pad.size());
+
+    const auto hmac = [&inner, &outer](const unsigned char* data, std::size_t size, const unsigned char* suffix,
+                                       std::size_t suffixSize) {
+        Sha256 first = inner;
+        first.update(data, size);
+        first.update(suffix, suffixSize);
+        const Sha256::Digest innerDigest = first.finish();
+        Sha256 second = outer;
+        second.update(innerDigest.data(), innerDigest.size());
+        return second.finish();
+    };
+
+    const unsigned char blockIndex[4] = {0, 0, 0, 1};
+    Sha256::Digest u = hmac(salt, saltSize, blockIndex, sizeof(blockIndex));
+    Sha256::Digest result = u;
+    for (std::uint32_t i = 1; i < iterations; ++i) {
+        u = hmac(u.data(), u.size(), nullptr, 0);
+        for (std::size_t b = 0; b < result.size(); ++b) {
+            result[b] ^= u[b];
+        }
+    }
+    return result;
+}
+
+std::string toHex(const unsigned char* data, std::size_t size) {
+    constexpr std::string_view kDigits = "0123456789abcdef";
+    std::string out;
+    out.reserve(size * 2);
+    for (std::size_t i = 0; i < size; ++i) {
+        out.push_back(kDigits[data[i] >> 4]);
+        out.push_back(kDigits[data[i] & 0x0F]);
+    }
+    return out;
+}
+
+bool fromHex(std::string_view text, unsigned char* out, std::size_t size) {
+    if (text.size() != size * 2) {
+        return false;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        const char* digits = text.data() + i * 2;
+        const auto [end, error] = std::from_chars(digits, digits + 2, out[i], 16);
+        if (error != std::errc() || end != digits + 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The next space-separated field of an account line
+std::string_view nextField(std::string_view& line) {
+    const std::size_t end = std::min(line.find(' '), line.size());
+    const std::string_view field = line.substr(0, end);
+    line.remove_prefix(std::min(end + 1, line.size()));
+    return field;
+}
+
+} // namespace
+
+LoginPool::LoginPool(std::filesystem::path directory, NetInbox<LoginResult>& results, unsigned threads,
+                     std::uint32_t iterations, std::size_t queueLimit)
+    : m_directory(std::move(directory))
+    , m_results(results)
+    , m_iterations(std::max(iterations, 1u))
+    , m_queueLimit(std::max<std::size_t>(queueLimit, 1)) {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    for (unsigned i = 0; i < std::max(threads, 1u); ++i) {
+        m_threads.emplace_back([this] { work(); });
+    }
+}
+
+LoginPool::~LoginPool() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+bool LoginPool::submit(std::uint64_t session, std::string name, std::string password) {
+    if (full()) {
+        ++m_stats.refused;
+        return false;
+    }
+    ++m_inFlight;
+    ++m_stats.submitted;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back({session, std::move(name), std::move(password)});
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+void LoginPool::finished(const LoginResult& result) noexcept {
+    --m_inFlight;
+    switch (result.outcome) {
+        case LoginResult::Outcome::Accepted: ++m_stats.accepted; break;
+        case LoginResult::Outcome::Created: ++m_stats.created; break;
+        case LoginResult::Outcome::WrongPassword: ++m_stats.rejected; break;
+        case LoginResult::Outcome::Failed: ++m_stats.failed; break;
+    }
+}
+
+void LoginPool::work() {
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_requests.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+        LoginResult result = check(request);
+        // The password is not kept a moment longer than it is needed
+        std::fill(request.password.begin(), request.password.end(), '\0');
+        m_results.push(std::move(result));
+    }
+}
+
+LoginResult LoginPool::check(Request& request) const {
+    LoginResult result{request.session, request.name, LoginResult::Outcome::Failed};
+    const std::filesystem::path path = m_directory / (request.name + ".account");
+
+    std::ifstream in(path);
+    if (in) {
+        std::string stored;
+        std::getline(in, stored);
+        result.outcome = verifyPassword(stored, request.password) ? LoginResult::Outcome::Accepted
+                                                                  : LoginResult::Outcome::WrongPassword;
+        return result;
+    }
+
+    // A new name: written aside and renamed into place, so a crash never leaves half an account
+    const std::filesystem::path partial = m_directory / (request.name + ".account.new");
+    {
+        std::ofstream out(partial, std::ios::trunc);
+        out << hashPassword(request.password, m_iterations) << '\n';
+        if (!out.flush()) {
+            return result;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(partial, path, error);
+    if (!error) {
+        result.outcome = LoginResult::Outcome::Created;
+    }
+    return result;
+}
+
+std::string LoginPool::hashPassword(std::string_view password, std::uint32_t iterations) {
+    std::array<unsigned char, kSaltSize> salt;
+    std::random_device random;
+    for (unsigned char& byte : salt) {
+        byte = static_cast<unsigned char>(random());
+    }
+    const Sha256::Digest key = pbkdf2(password, salt.data(), salt.size(), iterations);
+    return std::format("{} {} {} {}", kScheme, iterations, toHex(salt.data(), salt.size()), toHex(key.data(), key.size()));
+}
+
+bool LoginPool::verifyPassword(std::string_view stored, std::string_view password) {
+    std::string_view line = stored;
+    if (nextField(line) != kScheme) {
+        return false;
+    }
+    const std::string_view count = nextField(line);
+    std::uint32_t iterations = 0;
+    if (std::from_chars(count.data(), count.data() + count.size(), iterations).ec != std::errc() || iterations == 0) {
+        return false;
+    }
+    std::array<unsigned char, kSaltSize> salt;
+    Sha256::Digest expected;
+    if (!fromHex(nextField(line), salt.data(), salt.size()) || !fromHex(nextField(line), expected.data(), expected.size())) {
+        return false;
+    }
+
+    // Every byte is compared, so the time taken says nothing about where they differ
+    const Sha256::Digest key = pbkdf2(password, salt.data(), salt.size(), iterations);
+    unsigned char difference = 0;
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        difference |= static_cast<unsigned char>(key[i] ^ expected[i]);
+    }
+    return difference == 0;
+}
@@ -0,0 +1,140 @@
+#include "../include/LuaArena.h"
+#include "../include/MemoryAccounting.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+LuaArena::LuaArena(std::size_t limitBytes)
+    : m_limit(limitBytes) {
+}
+
+LuaArena::~LuaArena() {
+    MemoryAccounting::record(MemoryTag::Lua, -static_cast<std::int64_t>(m_reported), m_unreportedAllocations,
+                             m_unreportedBytes);
+    // Large blocks are all returned by lua_close before the arena goes away
+    for (void* chunk : m_chunks) {
+        ::operator delete(chunk);
+    }
+}
+
+void* LuaArena::allocate(void* userData, void* block, std::size_t oldSize, std::size_t newSize) {
+    return static_cast<LuaArena*>(userData)->reallocate(block, oldSize, newSize);
+}
+
+void* LuaArena::reallocate(void* block, std::size_t oldSize, std::size_t newSize) {
+    // For a new block Lua passes the object type in oldSize, not a size
+    if (!block) {
+        oldSize = 0;
+    }
+    
+    if (newSize == 0) {
+        if (block) {
+            freeBlock(block, oldSize);
+            m_live -= oldSize;
+            account(0);
+        }
+        return nullptr;
+    }
+    
+    // Growing past the ceiling fails; Lua assumes shrinking always succeeds
+    if (newSize > oldSize && m_limit != 0 && m_live - oldSize + newSize > m_limit) {
+        return nullptr;
+    }
+    
+    void* result = nullptr;
+    const bool oldSmall = block && oldSize <= kMaxSmallSize;
+    const bool newSmall = newSize <= kMaxSmallSize;
+    if (block && oldSmall && newSmall && sizeClass(oldSize) == sizeClass(newSize)) {
+        // Same size class: the block already fits
+        result = block;
+    } else if (block && !oldSmall && !newSmall) {
+        result = std::realloc(block, newSize);
+        if (!result) {
+            return nullptr;
+        }
+    } else {
+        result = allocateBlock(newSize);
+        if (!result) {
+            return nullptr;
+        }
+        if (block) {
+            std::memcpy(result, block, std::min(oldSize, newSize));
+            freeBlock(block, oldSize);
+        }
+    }
+    
+    m_live = m_live - oldSize + newSize;
+    m_peak = std::max(m_peak, m_live);
+    account(newSize > oldSize ? newSize : 0);
+    return result;
+}
+
+void LuaArena::account(std::size_t allocated) {
+    m_unreportedAllocations += allocated > 0 ? 1 : 0;
+    m_unreportedBytes += allocated;
+    const std::int64_t delta = static_cast<std::int64_t>(m_live) - static_cast<std::int64_t>(m_reported);
+    if (delta >= kReportBytes || delta <= -kReportBytes || m_unreportedAllocations >= kReportAllocations) {
+        MemoryAccounting::record(MemoryTag::Lua, delta, m_unreportedAllocations, m_unreportedBytes);
+        m_reported = m_live;
+        m_unreportedAllocations = 0;
+        m_unreportedBytes = 0;
+    }
+}
+
+void* LuaArena::allocateBlock(std::size_t size) {
+    if (size > kMaxSmallSize) {
+        return std::malloc(size);
+    }
+    return allocateSmall(sizeClass(size));
+}
+
+void LuaArena::freeBlock(void* block, std::size_t size) {
+    if (size > kMaxSmallSize) {
+        std::free(block);
+        return;
+    }
+    
+    // Back onto its class's free list; chunk memory is only returned when the arena dies
+    const std::size_t cls = sizeClass(size);
+    auto* freed = static_cast<FreeBlock*>(block);
+    freed->next = m_freeLists[cls];
+    m_freeLists[cls] = freed;
+}
+
+void* LuaArena::allocateSmall(std::size_t cls) {
+    if (FreeBlock* head = m_freeLists[cls]) {
+        m_freeLists[cls] = head->next;
+        return head;
+    }
+    
+    const std::size_t size = classSize(cls);
+    if (m_remaining < size) {
+        // The unused tail of the old chunk is handed to the matching free lists
+        while (m_remaining >= kGranularity) {
+            const std::size_t tailClass = std::min(m_remaining / kGranularity, kClassCount) - 1;
+            freeBlock(m_cursor, classSize(tailClass));
+            m_cursor += classSize(tailClass);
+            m_remaining -= classSize(tailClass);
+        }
+        
+        // lua_Alloc must not throw, so both allocations here report failure as nullptr
+        void* chunk = ::operator new(kChunkSize, std::nothrow);
+        if (!chunk) {
+            return nullptr;
+        }
+        try {
+            m_chunks.push_back(chunk);
+        } catch (const std::bad_alloc&) {
+            ::operator delete(chunk);
+            return nullptr;
+        }
+        m_cursor = static_cast<char*>(chunk);
+        m_remaining = kChunkSize;
+    }
+    
+    void* result = m_cursor;
+    m_cursor += size;
+    m_remaining -= size;
+    return result;
+}
@@ -0,0 +1,78 @@
+#include "../include/MccpStream.h"
+#include <zlib.h>
+
+namespace {
+
+constexpr int kWindowBits = 12;
+constexpr int kMemoryLevel = 5;
+constexpr std::size_t kDeflateChunk = 4096;
+
+} // namespace
+
+MccpStream::MccpStream()
+    : m_stream(std::make_unique<z_stream>()) {
+}
+
+MccpStream::~MccpStream() {
+    deflateEnd(m_stream.get());
+}
+
+std::unique_ptr<MccpStream> MccpStream::create() {
+    std::unique_ptr<MccpStream> stream(new MccpStream());
+    if (deflateInit2(stream->m_stream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED, kWindowBits, kMemoryLevel,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        // deflateEnd on a stream that never started is harmless
+        return nullptr;
+    }
+    return stream;
+}
+
+bool MccpStream::recycle() {
+    if (deflateReset(m_stream.get()) == Z_OK) {
+        return true;
+    }
+    // One zlib could not reset (or never started) is set up from scratch
+    deflateEnd(m_stream.get());
+    *m_stream = z_stream{};
+    return deflateInit2(m_stream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED, kWindowBits, kMemoryLevel,
+                        Z_DEFAULT_STRATEGY) == Z_OK;
+}
+
+bool MccpStream::compress(std::string_view bytes, std::string& out) {
+    m_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(bytes.data()));
+    m_stream->avail_in = static_cast<uInt>(bytes.size());
+    return deflateInto(Z_NO_FLUSH, out);
+}
+
+bool MccpStream::flush(bool finish, std::string& out) {
+    m_stream->next_in = nullptr;
+    m_stream->avail_in = 0;
+    return deflateInto(finish ? Z_FINISH : Z_SYNC_FLUSH, out);
+}
+
+std::uint64_t MccpStream::bytesIn() const noexcept {
+    return m_stream->total_in;
+}
+
+std::uint64_t MccpStream::bytesOut() const noexcept {
+    return m_stream->total_out;
+}
+
+// Deflate into out a buffer at a time until zlib has nothing more to give
+bool MccpStream::deflateInto(int mode, std::string& out) {
+    for (;;) {
+        const std::size_t used = out.size();
+        out.resize(used + kDeflateChunk);
+        m_stream->next_out = reinterpret_cast<Bytef*>(out.data() + used);
+        m_stream->avail_out = static_cast<uInt>(kDeflateChunk);
+        const int status = deflate(m_stream.get(), mode);
+        out.resize(used + kDeflateChunk - m_stream->avail_out);
+        if (status == Z_STREAM_ERROR) {
+            return false;
+        }
+        // A full buffer may mean more is waiting; Z_BUF_ERROR means nothing was
+        if (status == Z_STREAM_END || status == Z_BUF_ERROR || m_stream->avail_out != 0) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#include "../include/MemoryAccounting.h"
+
+namespace {
+
+constexpr std::array<std::string_view, kMemoryTagCount> kNames = {"engine", "lua", "ui buffer", "sessions", "world"};
+
+// Taken at static initialisation, before anything is counted
+const std::chrono::steady_clock::time_point g_started = std::chrono::steady_clock::now();
+
+} // namespace
+
+std::array<MemoryAccounting::Counters, kMemoryTagCount> MemoryAccounting::s_counters;
+
+void MemoryAccounting::record(MemoryTag tag, std::int64_t liveDelta, std::uint64_t allocations,
+                              std::uint64_t allocatedBytes) noexcept {
+    Counters& counters = s_counters[static_cast<std::size_t>(tag)];
+    const std::int64_t live = counters.live.fetch_add(liveDelta, std::memory_order_relaxed) + liveDelta;
+    if (allocations > 0) {
+        counters.allocations.fetch_add(allocations, std::memory_order_relaxed);
+        counters.allocatedBytes.fetch_add(allocatedBytes, std::memory_order_relaxed);
+    }
+    if (liveDelta > 0) {
+        std::int64_t peak = counters.peak.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+MemoryTagStats MemoryAccounting::stats(MemoryTag tag) noexcept {
+    const Counters& counters = s_counters[static_cast<std::size_t>(tag)];
+    // Frees racing allocations elsewhere can leave the sum a moment below zero
+    const std::int64_t live = counters.live.load(std::memory_order_relaxed);
+    return {static_cast<std::uint64_t>(live > 0 ? live : 0),
+            static_cast<std::uint64_t>(counters.peak.load(std::memory_order_relaxed)),
+            counters.allocations.load(std::memory_order_relaxed),
+            counters.allocatedBytes.load(std::memory_order_relaxed)};
+}
+
+std::string_view MemoryAccounting::name(MemoryTag tag) noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    return index < kNames.size() ? kNames[index] : std::string_view("unknown");
+}
+
+std::chrono::steady_clock::time_point MemoryAccounting::started() noexcept {
+    return g_started;
+}
+
+TrackedResource& TrackedResource::of(MemoryTag tag) noexcept {
+    static TrackedResource resources[kMemoryTagCount] = {
+        TrackedResource(MemoryTag::Engine), TrackedResource(MemoryTag::Lua), TrackedResource(MemoryTag::UiBuffer),
+        TrackedResource(MemoryTag::Sessions), TrackedResource(MemoryTag::World)};
+    return resources[static_cast<std::size_t>(tag)];
+}
@@ -0,0 +1,402 @@
+#include "../include/MessageStore.h"
+#include "../include/FileUtil.h"
+#include "../include/MappedRecords.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::string_view kPrefix = "messages-";
+constexpr std::string_view kSuffix = ".seg";
+
+// Dead bytes worth a compaction, once they also outweigh the live ones
+constexpr std::uint64_t kCompactBytes = std::uint64_t{1} << 20;
+
+// The number a segment's name gives, or 0 for anything else
+std::uint32_t segmentNumber(const std::filesystem::path& path) {
+    const std::string name = path.filename().string();
+    if (!name.starts_with(kPrefix) || !name.ends_with(kSuffix)) {
+        return 0;
+    }
+    const std::string_view digits = std::string_view(name).substr(kPrefix.size(),
+                                                                  name.size() - kPrefix.size() - kSuffix.size());
+    std::uint32_t number = 0;
+    const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), number, 16);
+    return ec == std::errc() && end == digits.data() + digits.size() ? number : 0;
+}
+
+bool writeAll(int fd, std::string_view bytes, std::size_t offset) {
+    while (!bytes.empty()) {
+        const ssize_t wrote = ::pwrite(fd, bytes.data(), bytes.size(), static_cast<off_t>(offset));
+        if (wrote < 0 && errno == EINTR) {
+            continue;
+        }
+        if (wrote <= 0) {
+            return false;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(wrote));
+        offset += static_cast<std::size_t>(wrote);
+    }
+    return true;
+}
+
+} // namespace
+
+std::expected<std::unique_ptr<MessageStore>, std::string> MessageStore::open(const std::filesystem::path& directory,
+                                                                             std::chrono::milliseconds syncInterval) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        return std::unexpected(std::format("{}: {}", directory.string(), error.message()));
+    }
+    std::vector<std::uint32_t> numbers;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (const std::uint32_t number = segmentNumber(entry.path()); number != 0) {
+            numbers.push_back(number);
+        }
+    }
+    std::sort(numbers.begin(), numbers.end());
+
+    std::unique_ptr<MessageStore> store(new MessageStore(directory, syncInterval));
+    std::unordered_set<std::uint64_t> seen;
+    for (const std::uint32_t number : numbers) {
+        if (!store->load(number, seen)) {
+            return std::unexpected(std::format("{}: {}", store->segmentPath(number).string(), std::strerror(errno)));
+        }
+    }
+    if (store->m_segments.empty() && !store->openSegment(1)) {
+        return std::unexpected(std::format("{}: {}", store->segmentPath(1).string(), std::strerror(errno)));
+    }
+    return store;
+}
+
+MessageStore::MessageStore(std::filesystem::path directory, std::chrono::milliseconds syncInterval)
+    : m_directory(std::move(directory))
+    , m_syncInterval(std::max(syncInterval, std::chrono::milliseconds(1)))
+    , m_syncer([this] { sync(); }) {}
+
+MessageStore::~MessageStore() {
+    {
+        const std::lock_guard<std::mutex> lock(m_syncMutex);
+        m_stopping = true;
+    }
+    m_syncWake.notify_one();
+    m_syncer.join();
+    closeSegments(m_segments, false);
+}
+
+std::filesystem::path MessageStore::segmentPath(std::uint32_t number) const {
+    return m_directory / std::format("{}{:08x}{}", kPrefix, number, kSuffix);
+}
+
+bool MessageStore::openSegment(std::uint32_t number) {
+    Segment segment;
+    segment.path = segmentPath(number);
+    segment.number = number;
+    segment.fd = ::open(segment.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (segment.fd < 0) {
+        return false;
+    }
+    struct stat info{};
+    if (::fstat(segment.fd, &info) != 0) {
+        ::close(segment.fd);
+        return false;
+    }
+    segment.size = static_cast<std::size_t>(info.st_size);
+    // Mapped past the end of the file, so what is appended later shows up
+    // without mapping again; only the written part is ever read
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    segment.mapped = std::max(kSegmentBytes, (segment.size + page - 1) / page * page);
+    void* mapping = ::mmap(nullptr, segment.mapped, PROT_READ, MAP_SHARED, segment.fd, 0);
+    if (mapping == MAP_FAILED) {
+        ::close(segment.fd);
+        return false;
+    }
+    segment.base = static_cast<char*>(mapping);
+    m_segments.push_back(std::move(segment));
+    return true;
+}
+
+bool MessageStore::load(std::uint32_t number, std::unordered_set<std::uint64_t>& seen) {
+    if (!openSegment(number)) {
+        return false;
+    }
+    Segment& segment = m_segments.back();
+    std::size_t offset = 0;
+    while (segment.size - offset >= sizeof(MessageRecordHeader)) {
+        const auto* record = reinterpret_cast<const MessageRecordHeader*>(segment.base + offset);
+        const std::size_t prefix = std::size_t{record->folderSize} + record->authorSize + record->subjectSize;
+        // A crash mid-write leaves a short or garbled last record
+        if (record->size > segment.size - offset - sizeof(MessageRecordHeader) || prefix > record->size
+            || record->kind > MessageRecordKind::Removal
+            || mapped::fnv1a({reinterpret_cast<const char*>(record + 1), record->size}) != record->checksum) {
+            break;
+        }
+        if (record->kind == MessageRecordKind::Post) {
+            // A post compaction copied, with the original still here from before a crash
+            if (seen.insert(record->serial).second) {
+                index(record);
+                m_nextSerial = std::max(m_nextSerial, record->serial + 1);
+            }
+        } else {
+            // Nor is a removed post's serial given out again
+            m_nextSerial = std::max(m_nextSerial, record->serial + 1);
+            const std::string_view name(reinterpret_cast<const char*>(record + 1), record->folderSize);
+            if (const auto found = m_folders.find(name); found != m_folders.end()) {
+                std::vector<MessageView>& posts = found->second;
+                const auto post = std::find_if(posts.begin(), posts.end(), [record](const MessageView& view) {
+                    return view.serial() == record->serial;
+                });
+                if (post != posts.end()) {
+                    m_liveBytes -= FileUtil::padded(post->bytes());
+                    posts.erase(post);
+                }
+                if (posts.empty()) {
+                    m_folders.erase(found);
+                }
+            }
+        }
+        offset += std::min(FileUtil::padded(sizeof(MessageRecordHeader) + record->size), segment.size - offset);
+    }
+    if (offset != segment.size) {
+        // New records go after the last good one
+        if (::ftruncate(segment.fd, static_cast<off_t>(offset)) != 0) {
+            return false;
+        }
+        segment.size = offset;
+    }
+    return true;
+}
+
+void MessageStore::closeSegments(std::vector<Segment>& segments, bool erase) {
+    {
+        const std::lock_guard<std::mutex> lock(m_syncMutex);
+        for (const Segment& segment : segments) {
+            std::erase(m_unsynced, segment.fd);
+        }
+    }
+    std::error_code error;
+    for (Segment& segment : segments) {
+        ::munmap(segment.base, segment.mapped);
+        ::close(segment.fd);
+        if (erase) {
+            std::filesystem::remove(segment.path, error);
+        }
+    }
+    segments.clear();
+}
+
+const MessageRecordHeader* MessageStore::append(MessageRecordHeader header, std::span<const std::string_view> text) {
+    m_record.assign(sizeof header, '\0');
+    for (const std::string_view piece : text) {
+        m_record.append(piece);
+    }
+    header.size = static_cast<std::uint32_t>(m_record.size() - sizeof header);
+    header.checksum = mapped::fnv1a(std::string_view(m_record).substr(sizeof header));
+    std::memcpy(m_record.data(), &header, sizeof header);
+    m_record.resize(FileUtil::padded(m_record.size()), '\0');
+
+    if (m_segments.empty() || m_segments.back().size + m_record.size() > m_segments.back().mapped) {
+        if (!openSegment(m_segments.empty() ? 1 : m_segments.back().number + 1)) {
+            const std::lock_guard<std::mutex> lock(m_syncMutex);
+            ++m_failed;
+            return nullptr;
+        }
+    }
+    Segment& segment = m_segments.back();
+    if (!writeAll(segment.fd, m_record, segment.size)) {
+        // Whatever part landed is cut off, so the next record starts clean
+        (void)::ftruncate(segment.fd, static_cast<off_t>(segment.size));
+        const std::lock_guard<std::mutex> lock(m_syncMutex);
+        ++m_failed;
+        return nullptr;
+    }
+    const auto* record = reinterpret_cast<const MessageRecordHeader*>(segment.base + segment.size);
+    segment.size += m_record.size();
+    {
+        const std::lock_guard<std::mutex> lock(m_syncMutex);
+        if (std::find(m_unsynced.begin(), m_unsynced.end(), segment.fd) == m_unsynced.end()) {
+            m_unsynced.push_back(segment.fd);
+        }
+    }
+    m_syncWake.notify_one();
+    return record;
+}
+
+void MessageStore::index(const MessageRecordHeader* record) {
+    const MessageView view(record);
+    const std::string_view name = view.folder();
+    auto found = m_folders.find(name);
+    if (found == m_folders.end()) {
+        found = m_folders.emplace(std::string(name), std::vector<MessageView>()).first;
+    }
+    found->second.push_back(view);
+    m_liveBytes += FileUtil::padded(view.bytes());
+}
+
+std::span<const MessageView> MessageStore::folder(std::string_view name) const {
+    const auto found = m_folders.find(name);
+    return found != m_folders.end() ? std::span<const MessageView>(found->second) : std::span<const MessageView>();
+}
+
+std::expected<std::uint64_t, std::string> MessageStore::post(std::string_view folder, std::string_view author,
+                                                             std::string_view subject, std::string_view body,
+                                                             std::uint64_t postedAt) {
+    if (folder.size() + author.size() + subject.size() + body.size() > kMaxText) {
+        return std::unexpected(std::string("That is too long to post."));
+    }
+    MessageRecordHeader header;
+    header.serial = m_nextSerial;
+    header.postedAt = postedAt;
+    header.folderSize = static_cast<std::uint16_t>(folder.size());
+    header.authorSize = static_cast<std::uint16_t>(author.size());
+    header.subjectSize = static_cast<std::uint16_t>(subject.size());
+    header.kind = MessageRecordKind::Post;
+    const std::string_view text[] = {folder, author, subject, body};
+    const MessageRecordHeader* record = append(header, text);
+    if (!record) {
+        return std::unexpected(std::string("The message could not be written."));
+    }
+    index(record);
+    return m_nextSerial++;
+}
+
+bool MessageStore::remove(std::string_view folder, std::size_t index) {
+    const auto found = m_folders.find(folder);
+    if (found == m_folders.end() || index >= found->second.size()) {
+        return false;
+    }
+    const MessageView view = found->second[index];
+    MessageRecordHeader header;
+    header.serial = view.serial();
+    header.postedAt = view.postedAt();
+    header.folderSize = static_cast<std::uint16_t>(folder.size());
+    header.kind = MessageRecordKind::Removal;
+    const std::string_view text[] = {folder};
+    if (!append(header, text)) {
+        return false;
+    }
+    m_liveBytes -= FileUtil::padded(view.bytes());
+    found->second.erase(found->second.begin() + static_cast<std::ptrdiff_t>(index));
+    if (found->second.empty()) {
+        m_folders.erase(found);
+    }
+
+    const std::uint64_t dead = writtenBytes() - m_liveBytes;
+    if (dead >= kCompactBytes && dead > m_liveBytes) {
+        compact();
+    }
+    return true;
+}
+
+bool MessageStore::compact() {
+    // Oldest first, so each folder comes out in the order it had
+    std::vector<MessageView> live;
+    for (const auto& [name, posts] : m_folders) {
+        live.insert(live.end(), posts.begin(), posts.end());
+    }
+    std::sort(live.begin(), live.end(),
+              [](const MessageView& a, const MessageView& b) { return a.serial() < b.serial(); });
+
+    std::vector<Segment> old = std::exchange(m_segments, {});
+    const std::uint32_t first = old.empty() ? 1 : old.back().number + 1;
+    const auto fail = [&] {
+        closeSegments(m_segments, true);
+        m_segments = std::move(old);
+        return false;
+    };
+    if (!openSegment(first)) {
+        return fail();
+    }
+    std::vector<const MessageRecordHeader*> copies;
+    copies.reserve(live.size());
+    for (const MessageView& view : live) {
+        const std::string_view text[] = {{reinterpret_cast<const char*>(view.record() + 1), view.record()->size}};
+        const MessageRecordHeader* copy = append(*view.record(), text);
+        if (!copy) {
+            return fail();
+        }
+        copies.push_back(copy);
+    }
+    // The copies are on disk, and in the directory, before the originals go
+    for (const Segment& segment : m_segments) {
+        if (!FileUtil::syncFile(segment.fd)) {
+            return fail();
+        }
+    }
+    if (const int directory = ::open(m_directory.c_str(), O_RDONLY | O_CLOEXEC); directory >= 0) {
+        ::fsync(directory);
+        ::close(directory);
+    }
+
+    m_folders.clear();
+    m_liveBytes = 0;
+    for (const MessageRecordHeader* copy : copies) {
+        index(copy);
+    }
+    closeSegments(old, true);
+    ++m_compactions;
+    return true;
+}
+
+std::uint64_t MessageStore::writtenBytes() const noexcept {
+    std::uint64_t bytes = 0;
+    for (const Segment& segment : m_segments) {
+        bytes += segment.size;
+    }
+    return bytes;
+}
+
+MessageStats MessageStore::stats() const {
+    MessageStats stats;
+    for (const auto& [name, posts] : m_folders) {
+        stats.posts += posts.size();
+    }
+    stats.folders = m_folders.size();
+    stats.segments = m_segments.size();
+    stats.liveBytes = m_liveBytes;
+    stats.deadBytes = writtenBytes() - m_liveBytes;
+    stats.compactions = m_compactions;
+    const std::lock_guard<std::mutex> lock(m_syncMutex);
+    stats.syncs = m_syncs;
+    stats.failed = m_failed;
+    return stats;
+}
+
+void MessageStore::sync() {
+    std::unique_lock<std::mutex> lock(m_syncMutex);
+    for (;;) {
+        m_syncWake.wait(lock, [this] { return m_stopping || !m_unsynced.empty(); });
+        if (m_unsynced.empty()) {
+            return;
+        }
+        // Let the rest of the interval's posts join this sync
+        m_syncWake.wait_for(lock, m_syncInterval, [this] { return m_stopping; });
+
+        // Synced through duplicates, off the lock, so appends and closes go on meanwhile
+        std::vector<int> descriptors;
+        for (const int fd : m_unsynced) {
+            if (const int copy = ::fcntl(fd, F_DUPFD_CLOEXEC, 0); copy >= 0) {
+                descriptors.push_back(copy);
+            }
+        }
+        const bool duplicated = descriptors.size() == m_unsynced.size();
+        m_unsynced.clear();
+        lock.unlock();
+        bool synced = duplicated;
+        for (const int fd : descriptors) {
+            synced = FileUtil::syncFile(fd) && synced;
+            ::close(fd);
+        }
+        lock.lock();
+        ++m_syncs;
+        m_failed += synced ? 0 : 1;
+    }
+}
@@ -0,0 +1,161 @@
+#include "../include/Metrics.h"
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace {
+
+struct MetricInfo {
+    std::string_view name;   // Without _total, which counters' samples add
+    std::string_view help;
+    bool gauge;
+};
+
+constexpr std::array<MetricInfo, kMetricCount> kMetrics = {{
+    {"echomud_sessions", "Connections open", true},
+    {"echomud_sessions_opened", "Connections accepted", false},
+    {"echomud_sessions_refused", "Connections closed unopened, from banned addresses or ones at their limit", false},
+    {"echomud_output_queued_chunks", "Output pool chunks of 2 KiB holding queued bytes", true},
+    {"echomud_output_pool_bytes", "Memory the output pools have allocated", true},
+    {"echomud_output_dropped_bytes", "Output discarded past a session's high-water mark", false},
+    {"echomud_sessions_compacted", "Idle sessions whose buffers and MCCP2 stream were let go", false},
+    {"echomud_texts_wrapped", "Output word wrapped to a client's width; a shared line once per width", false},
+    {"echomud_ticks", "Game ticks run", false},
+    {"echomud_tick_overruns", "Ticks that took longer than the period", false},
+    {"echomud_commands_run", "Player commands run at ticks", false},
+    {"echomud_commands_deferred", "Commands left for a later tick once the budget was spent", false},
+    {"echomud_commands_dropped", "Commands refused because the session's queue was full", false},
+    {"echomud_commands_throttled", "Commands refused by the rate limit", false},
+    {"echomud_load_stage", "Work shed under load: 0 none, 1 ambient work deferred, 2 commands throttled too", true},
+    {"echomud_ticks_deferring", "Ticks run with ambient work deferred", false},
+    {"echomud_ticks_throttling", "Ticks run with commands throttled", false},
+    {"echomud_lua_memory_bytes", "Memory the Lua states hold", true},
+    {"echomud_lua_memory_peak_bytes", "Most memory the Lua states have held", true},
+}};
+
+constexpr std::array<MetricInfo, kMetricHistogramCount> kHistograms = {{
+    {"echomud_tick_duration_seconds", "Time to run a tick's timers, updates and commands", false},
+    {"echomud_command_queue_urgent_seconds", "Time admins', movement and combat commands waited for their tick", false},
+    {"echomud_command_queue_normal_seconds", "Time ordinary commands waited for their tick", false},
+    {"echomud_command_queue_bulk_seconds", "Time long listings such as who and help waited for their tick", false},
+}};
+
+constexpr std::array<double, 3> kQuantiles = {0.5, 0.9, 0.99};
+
+double seconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double>(time).count();
+}
+
+} // namespace
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+MetricsShard& Metrics::addShard() {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_shards.push_back(std::make_unique<MetricsShard>());
+    return *m_shards.back();
+}
+
+std::uint64_t Metrics::addCollector(Collector collector) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const std::uint64_t id = m_nextCollector++;
+    m_collectors.emplace_back(id, std::move(collector));
+    return id;
+}
+
+void Metrics::removeCollector(std::uint64_t id) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_collectors, [id](const auto& collector) { return collector.first == id; });
+}
+
+void Metrics::family(std::string& out, std::string_view name, std::string_view type, std::string_view help) {
+    std::format_to(std::back_inserter(out), "# TYPE {} {}\n# HELP {} {}\n", name, type, name, help);
+}
+
+std::string Metrics::label(std::string_view key, std::string_view value) {
+    std::string out(key);
+    out += "=\"";
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+void Metrics::sample(std::string& out, std::string_view name, std::string_view labels, double value) {
+    if (labels.empty()) {
+        std::format_to(std::back_inserter(out), "{} {}\n", name, value);
+    } else {
+        std::format_to(std::back_inserter(out), "{}{{{}}} {}\n", name, labels, value);
+    }
+}
+
+void Metrics::summary(std::string& out, std::string_view name, std::string_view labels,
+                      const LatencyHistogram& histogram) {
+    const std::string_view separator = labels.empty() ? "" : ",";
+    for (const double quantile : kQuantiles) {
+        sample(out, name, std::format("{}{}quantile=\"{}\"", labels, separator, quantile),
+               seconds(histogram.percentile(quantile)));
+    }
+    sample(out, std::format("{}_sum", name), labels, seconds(histogram.total()));
+    sample(out, std::format("{}_count", name), labels, static_cast<double>(histogram.count()));
+}
+
+std::uint64_t Metrics::total(Metric metric) const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t total = 0;
+    for (const auto& shard : m_shards) {
+        total += shard->value(metric);
+    }
+    return total;
+}
+
+void Metrics::mergeInto(MetricHistogram histogram, LatencyHistogram& into) const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& shard : m_shards) {
+        into.merge(shard->histogram(histogram));
+    }
+}
+
+std::string Metrics::scrape() const {
+    std::string out;
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::array<std::uint64_t, kMetricCount> values{};
+    for (const auto& shard : m_shards) {
+        for (std::size_t i = 0; i < kMetricCount; ++i) {
+            values[i] += shard->value(static_cast<Metric>(i));
+        }
+    }
+    for (std::size_t i = 0; i < kMetricCount; ++i) {
+        const MetricInfo& info = kMetrics[i];
+        family(out, info.name, info.gauge ? "gauge" : "counter", info.help);
+        sample(out, info.gauge ? std::string(info.name) : std::format("{}_total", info.name), {},
+               static_cast<double>(values[i]));
+    }
+
+    for (std::size_t i = 0; i < kMetricHistogramCount; ++i) {
+        LatencyHistogram merged;
+        for (const auto& shard : m_shards) {
+            merged.merge(shard->histogram(static_cast<MetricHistogram>(i)));
+        }
+        family(out, kHistograms[i].name, "summary", kHistograms[i].help);
+        summary(out, kHistograms[i].name, {}, merged);
+    }
+
+    for (const auto& [id, collector] : m_collectors) {
+        collector(out);
+    }
+    out += "# EOF\n";
+    return out;
+}
@@ -0,0 +1,115 @@
+#include "../include/MetricsServer.h"
+#include "../include/Metrics.h"
+#include "../include/SocketUtil.h"
+#include <cerrno>
+#include <format>
+#include <string_view>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kMaxRequest = 8 * 1024;
+constexpr int kClientTimeoutSeconds = 3;
+
+} // namespace
+
+std::expected<std::unique_ptr<MetricsServer>, NetError> MetricsServer::start(const std::string& address,
+                                                                             std::uint16_t port) {
+    std::unique_ptr<MetricsServer> server(new MetricsServer());
+    server->m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server->m_listenFd < 0 || ::fcntl(server->m_listenFd, F_SETFD, FD_CLOEXEC) != 0 ||
+        ::pipe(server->m_wakeFds) != 0) {
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    const int on = 1;
+    ::setsockopt(server->m_listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in bound{};
+    bound.sin_family = AF_INET;
+    bound.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &bound.sin_addr) != 1 ||
+        ::bind(server->m_listenFd, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound)) != 0) {
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    if (::listen(server->m_listenFd, 16) != 0) {
+        return std::unexpected(NetError::LISTEN_FAILED);
+    }
+    server->m_thread = std::thread([raw = server.get()] { raw->run(); });
+    return server;
+}
+
+MetricsServer::~MetricsServer() {
+    if (m_thread.joinable()) {
+        const char stop = 0;
+        [[maybe_unused]] const ssize_t wrote = ::write(m_wakeFds[1], &stop, 1);
+        m_thread.join();
+    }
+    for (const int fd : {m_listenFd, m_wakeFds[0], m_wakeFds[1]}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+void MetricsServer::run() {
+    for (;;) {
+        pollfd ready[2] = {{m_listenFd, POLLIN, 0}, {m_wakeFds[0], POLLIN, 0}};
+        if (::poll(ready, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (ready[1].revents != 0) {
+            return;
+        }
+        if (ready[0].revents & POLLIN) {
+            const int fd = ::accept(m_listenFd, nullptr, nullptr);
+            if (fd >= 0) {
+                serve(fd);
+                ::close(fd);
+            }
+        }
+    }
+}
+
+void MetricsServer::serve(int fd) {
+    // A client that stalls is cut off rather than holding up the next scrape
+    const timeval timeout{kClientTimeoutSeconds, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequest) {
+        const ssize_t got = ::recv(fd, buffer, sizeof buffer, 0);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return;
+        }
+        request.append(buffer, static_cast<std::size_t>(got));
+    }
+
+    // Only the request line matters: GET /metrics, with or without a query
+    const std::string_view line = std::string_view(request).substr(0, request.find("\r\n"));
+    const std::string_view target = line.starts_with("GET ") ? line.substr(4, line.find(' ', 4) - 4) : "";
+    if (target != "/metrics" && !target.starts_with("/metrics?")) {
+        SocketUtil::sendAll(fd, "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 10\r\n"
+                    "Connection: close\r\n\r\nNot found\n");
+        return;
+    }
+    const std::string body = Metrics::instance().scrape();
+    m_scrapes.fetch_add(1, std::memory_order_relaxed);
+    SocketUtil::sendAll(fd, std::format("HTTP/1.1 200 OK\r\n"
+                            "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                            "Content-Length: {}\r\nConnection: close\r\n\r\n",
+                            body.size()));
+    SocketUtil::sendAll(fd, body);
+}
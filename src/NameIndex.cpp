@@ -0,0 +1,46 @@
+#include "../include/NameIndex.h"
+#include <mutex>
+
+void NameIndex::insert(Symbol key, PlayerId player) {
+    Shard& into = shard(key);
+    const std::unique_lock lock(into.mutex);
+    into.players[key] = player;
+}
+
+void NameIndex::erase(Symbol key, PlayerId player) {
+    Shard& from = shard(key);
+    const std::unique_lock lock(from.mutex);
+    if (const auto it = from.players.find(key); it != from.players.end() && it->second == player) {
+        from.players.erase(it);
+    }
+}
+
+PlayerId NameIndex::find(Symbol key) const {
+    if (key == kNoSymbol) {
+        return kInvalidPlayerId;
+    }
+    const Shard& in = shard(key);
+    const std::shared_lock lock(in.mutex);
+    const auto it = in.players.find(key);
+    return it != in.players.end() ? it->second : kInvalidPlayerId;
+}
+
+PlayerId NameIndex::find(std::string_view name) const {
+    return find(StringInterner::global().find(PlayerRegistry::foldedName(name)));
+}
+
+std::size_t NameIndex::size() const {
+    std::size_t count = 0;
+    for (const Shard& each : m_shards) {
+        const std::shared_lock lock(each.mutex);
+        count += each.players.size();
+    }
+    return count;
+}
+
+void NameIndex::clear() {
+    for (Shard& each : m_shards) {
+        const std::unique_lock lock(each.mutex);
+        each.players.clear();
+    }
+}
@@ -0,0 +1,1665 @@
+#include "../include/NetReactor.h"
+#include "../include/AccessList.h"
+#include "../include/GameEngine.h"
+#include "../include/Metrics.h"
+#include "../include/OutOfBand.h"
+#include "../include/ServerConfig.h"
+#include "../include/SocketUtil.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <format>
+#include <utility>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#else
+#include <sys/event.h>
+#include <sys/time.h>
+#endif
+
+namespace {
+
+constexpr unsigned char kIac = TelnetParser::kIac;
+constexpr unsigned char kDont = TelnetParser::kDont;
+constexpr unsigned char kDo = TelnetParser::kDo;
+constexpr unsigned char kWont = TelnetParser::kWont;
+constexpr unsigned char kWill = TelnetParser::kWill;
+constexpr unsigned char kSb = TelnetParser::kSb;
+constexpr unsigned char kSe = TelnetParser::kSe;
+constexpr unsigned char kEcho = 1;
+constexpr unsigned char kNaws = 31;
+#if defined(ENABLE_MCCP)
+constexpr unsigned char kCompress2 = MccpStream::kOption;
+#endif
+
+constexpr std::size_t kMaxLineLength = 4096;           // The rest of a longer line is dropped
+constexpr std::size_t kMaxPendingOutput = 256 * 1024;  // Hard limit past the high-water mark; cut off
+constexpr std::size_t kReadChunk = 16 * 1024;
+constexpr std::size_t kMaxEvents = 256;
+constexpr std::size_t kMaxOutputSlabs = 256;           // Of ChunkPool::kSlabSize each, per reactor
+constexpr unsigned kMinWrapWidth = 20;                  // Narrower NAWS reports (such as 0) leave text unwrapped
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+constexpr std::size_t kMinDeflate = 64;                 // Shorter WebSocket messages are sent as they are
+#endif
+
+#if defined(__linux__)
+constexpr unsigned kRingEntries = 4096;
+constexpr unsigned kReceiveBuffers = 1024;
+constexpr std::size_t kReceiveBufferSize = 2048;
+#endif
+
+// Spreads connections between the listeners bound to one port. FreeBSD
+// spells the balancing form SO_REUSEPORT_LB
+#if defined(SO_REUSEPORT_LB)
+constexpr int kReusePort = SO_REUSEPORT_LB;
+#else
+constexpr int kReusePort = SO_REUSEPORT;
+#endif
+
+// A listening socket shared with the other reactors through SO_REUSEPORT
+std::expected<int, NetError> listenOn(const std::string& address, std::uint16_t port) {
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    const auto fail = [fd](NetError error) {
+        close(fd);
+        return std::unexpected(error);
+    };
+    const int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (!SocketUtil::setNonBlocking(fd) || setsockopt(fd, SOL_SOCKET, kReusePort, &on, sizeof(on)) != 0) {
+        return fail(NetError::SOCKET_FAILED);
+    }
+
+    sockaddr_in bound{};
+    bound.sin_family = AF_INET;
+    bound.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &bound.sin_addr) != 1 ||
+        bind(fd, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound)) != 0) {
+        return fail(NetError::BIND_FAILED);
+    }
+    if (listen(fd, SOMAXCONN) != 0) {
+        return fail(NetError::LISTEN_FAILED);
+    }
+    return fd;
+}
+
+// One the process this one replaced was listening on, already bound
+std::expected<int, NetError> inheritListener(int fd) {
+    if (!SocketUtil::setNonBlocking(fd)) {
+        close(fd);
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    return fd;
+}
+
+// The client's numeric address, for the game thread to show or resolve; one getpeername()
+std::string peerAddress(int fd) {
+    const std::optional<IpAddress> peer = IpAddress::ofPeer(fd);
+    return peer ? peer->toString() : std::string();
+}
+
+} // namespace
+
+NetReactor::NetReactor(std::uint16_t index, NetInbox<NetInputBatch>& game, const Config& config)
+    : m_index(index),
+      m_config(config),
+      m_game(game),
+      m_output(kMaxOutputSlabs),
+      m_readBuffer(kReadChunk) {
+    m_events.reserve(kMaxEvents);
+}
+
+std::expected<std::unique_ptr<NetReactor>, NetError> NetReactor::create(std::uint16_t index, NetInbox<NetInputBatch>& game,
+                                                                        const Config& config) {
+    // Descriptors are owned by the reactor as soon as they exist, so every
+    // failure below closes them through its destructor
+    std::unique_ptr<NetReactor> reactor(new NetReactor(index, game, config));
+    reactor->m_config.outputHighWater = std::min(config.outputHighWater, kMaxPendingOutput);
+
+    const std::array<int, 2>& inherited = config.listenFds;
+    const auto telnet = inherited[kTelnetListener] >= 0 ? inheritListener(inherited[kTelnetListener])
+                                                        : listenOn(config.address, config.port);
+    if (!telnet) {
+        return std::unexpected(telnet.error());
+    }
+    reactor->m_listenFds[kTelnetListener] = *telnet;
+    if (config.webSocketPort == 0 && inherited[kWebSocketListener] >= 0) {
+        close(inherited[kWebSocketListener]);
+    }
+    if (config.webSocketPort != 0) {
+        const auto webSocket = inherited[kWebSocketListener] >= 0 ? inheritListener(inherited[kWebSocketListener])
+                                                                  : listenOn(config.address, config.webSocketPort);
+        if (!webSocket) {
+            return std::unexpected(webSocket.error());
+        }
+        reactor->m_listenFds[kWebSocketListener] = *webSocket;
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+        if (config.compression) {
+            reactor->m_deflater = WebSocketDeflater::create();
+        }
+#endif
+    }
+    if (!reactor->m_inbox.open()) {
+        return std::unexpected(NetError::POLLER_FAILED);
+    }
+
+#if defined(__linux__)
+    if (config.useIoUring) {
+        reactor->m_ring = IoUring::create(kRingEntries, kReceiveBuffers, kReceiveBufferSize, kMaxOutputSlabs);
+    }
+    if (reactor->m_ring) {
+        // Register each output slab as it is made, so sends name it by index.
+        // A slab the kernel refuses (over RLIMIT_MEMLOCK) is sent by copy
+        NetReactor* self = reactor.get();
+        self->m_fixedSlabs.resize(kMaxOutputSlabs);
+        self->m_output.setSlabCallback([self](std::size_t slab, char* data, std::size_t size) {
+            self->m_fixedSlabs[slab] = self->m_ring->registerBuffer(static_cast<unsigned>(slab), data, size);
+        });
+        return reactor;
+    }
+    reactor->m_pollFd = epoll_create1(EPOLL_CLOEXEC);
+#else
+    reactor->m_pollFd = kqueue();
+#endif
+    if (reactor->m_pollFd < 0 || !reactor->watchListeners() || !reactor->watch(reactor->m_inbox.fd())) {
+        return std::unexpected(NetError::POLLER_FAILED);
+    }
+    return reactor;
+}
+
+NetReactor::~NetReactor() {
+    stop();
+    for (std::size_t fd = 0; fd < m_sessions.size(); ++fd) {
+        if (m_sessions[fd].open || m_sessions[fd].draining) {
+            close(static_cast<int>(fd));
+        }
+    }
+#if defined(ENABLE_TLS)
+    for (const Attaching& attaching : m_attaching) {
+        close(attaching.fd);
+    }
+#endif
+    for (int fd : {m_listenFds[kTelnetListener], m_listenFds[kWebSocketListener], m_pollFd}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void NetReactor::start(int core) {
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_stopRequested.store(false);
+    m_thread = std::thread(&NetReactor::run, this);
+#if defined(__linux__)
+    // Keeps the reactor's sessions, and their cache lines, on one core
+    if (core >= 0 && core < CPU_SETSIZE) {
+        cpu_set_t cores;
+        CPU_ZERO(&cores);
+        CPU_SET(core, &cores);
+        pthread_setaffinity_np(m_thread.native_handle(), sizeof(cores), &cores);
+    }
+#else
+    static_cast<void>(core);
+#endif
+}
+
+void NetReactor::stop() {
+    if (m_thread.joinable()) {
+        m_stopRequested.store(true);
+        m_inbox.wake();
+        m_thread.join();
+    }
+}
+
+ReactorHandover NetReactor::handOver(std::chrono::steady_clock::time_point deadline) {
+    stop();
+    m_handingOver = true;
+    m_acceptPaused = true;   // Connections arriving now wait in the listeners' backlog
+    // Whatever the game thread sent before the thread stopped
+    m_inbox.drain([this](NetOutputBatch&& batch) { applyOutput(batch); });
+
+    std::vector<bool> compressed(m_sessions.size());
+    for (std::size_t i = 0; i < m_sessions.size(); ++i) {
+        Session& session = m_sessions[i];
+        const int fd = static_cast<int>(i);
+        if (!session.open || session.closing) {
+            continue;
+        }
+        if (session.webSocket) {
+            // Its framing and inflate state cannot follow it; the browser reconnects
+            if (session.webSocket->upgraded()) {
+                sendClose(session, fd, WebSocket::kServiceRestart);
+            }
+            closeWhenSent(session, fd);
+            continue;
+        }
+        if (session.secure) {
+            // Nor can TLS record state, whether in the kernel or here
+            queue(session, fd, "The server is restarting; reconnect in a moment.\n");
+            closeWhenSent(session, fd);
+            continue;
+        }
+#if defined(ENABLE_MCCP)
+        // Ended so the client reads plain text until the next process starts a stream
+        if (session.compressor) {
+            compressed[i] = true;
+            compressOutput(session, fd, true);
+        }
+        // A compacted session's already was
+        compressed[i] = compressed[i] || session.resumeCompression;
+#endif
+        if (!session.dirty) {
+            session.dirty = true;
+            m_dirty.push_back(fd);
+        }
+    }
+
+#if defined(__linux__)
+    if (m_ring) {
+        for (std::size_t listener = 0; listener < m_listenFds.size(); ++listener) {
+            if (m_acceptArmed[listener]) {
+                io_uring_sqe& sqe = m_ring->next();
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.addr = tag(Op::Accept, m_listenFds[listener]);
+                sqe.user_data = tag(Op::Cancel, m_listenFds[listener]);
+            }
+        }
+        for (std::size_t fd = 0; fd < m_sessions.size(); ++fd) {
+            if (m_sessions[fd].open) {
+                io_uring_sqe& sqe = m_ring->next();
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.addr = tag(Op::Receive, static_cast<int>(fd));
+                sqe.user_data = tag(Op::Cancel, static_cast<int>(fd));
+            }
+        }
+    }
+#endif
+
+    // Write out everything queued, waiting only on the sessions that still have some
+    std::vector<pollfd> waiting;
+    for (;;) {
+        for (std::size_t i = 0; i < m_dirty.size(); ++i) {
+            flush(m_dirty[i]);
+        }
+        m_dirty.clear();
+        const auto now = std::chrono::steady_clock::now();
+        const int timeoutMs =
+            now < deadline ? static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count()) : 0;
+#if defined(__linux__)
+        if (m_ring) {
+            // Until every receive is cancelled and every send completed
+            const bool busy = std::any_of(m_sessions.begin(), m_sessions.end(),
+                                          [](const Session& session) { return session.pendingOps > 0; });
+            if (!busy || timeoutMs == 0) {
+                break;
+            }
+            waitRing(timeoutMs);
+            continue;
+        }
+#endif
+        waiting.clear();
+        for (std::size_t fd = 0; fd < m_sessions.size(); ++fd) {
+            if (m_sessions[fd].open && !m_sessions[fd].output.empty()) {
+                waiting.push_back({static_cast<int>(fd), POLLOUT, 0});
+            }
+        }
+        if (waiting.empty() || timeoutMs == 0) {
+            break;
+        }
+        ::poll(waiting.data(), waiting.size(), timeoutMs);
+        for (const pollfd& ready : waiting) {
+            if (ready.revents != 0) {
+                flush(ready.fd);
+            }
+        }
+    }
+
+    // Given up without closing: the descriptors are the next process's now
+    ReactorHandover handover;
+    handover.listenFds = std::exchange(m_listenFds, {-1, -1});
+    for (std::size_t i = 0; i < m_sessions.size(); ++i) {
+        Session& session = m_sessions[i];
+        if (!session.open || session.closing || session.webSocket || session.secure) {
+            continue;
+        }
+        handover.sessions.push_back({ConnectionId{session.serial, static_cast<int>(i), m_index}, std::move(session.line),
+                                     i < compressed.size() && compressed[i], session.width});
+        m_output.clear(session.output);
+        m_output.clear(session.staged);
+        session = Session{};
+        --m_sessionCount;
+    }
+    if (!m_posted.empty()) {
+        m_game.push(std::move(m_posted));
+        m_posted = NetInputBatch();
+    }
+    return handover;
+}
+
+ConnectionId NetReactor::adopt(int fd, std::string line, bool compressed, std::uint16_t width) {
+    if (!SocketUtil::setNonBlocking(fd) || (!usingIoUring() && !watch(fd))) {
+        close(fd);
+        return {};
+    }
+    if (static_cast<std::size_t>(fd) >= m_sessions.size()) {
+        m_sessions.resize(static_cast<std::size_t>(fd) + 1);
+    }
+    // Counted against its address, though over any limit: it was let in before
+    std::uint64_t ticket = 0;
+    if (m_config.access) {
+        m_config.access->admit(fd, 0, ticket);
+    }
+    Session& session = m_sessions[fd];
+    recycleSession(session);
+    session.open = true;
+    session.serial = m_nextSerial++;
+    session.peerTicket = ticket;
+    session.active = std::chrono::steady_clock::now();
+    session.line = std::move(line);
+    session.width = width;   // The client agreed to NAWS before and only reports again on a resize
+    ++m_sessionCount;
+#if defined(__linux__)
+    if (m_ring) {
+        armReceive(fd, session);
+    }
+#endif
+#if defined(ENABLE_MCCP)
+    // The client agreed to MCCP2 with the process before; a new stream just starts
+    if (compressed && m_config.compression) {
+        startCompression(session, fd);
+    }
+#else
+    static_cast<void>(compressed);
+#endif
+    return {session.serial, fd, m_index};
+}
+
+bool NetReactor::usingIoUring() const noexcept {
+#if defined(__linux__)
+    return m_ring != nullptr;
+#else
+    return false;
+#endif
+}
+
+CompressionStats NetReactor::compression() const noexcept {
+    return {m_compressedIn.load(std::memory_order_relaxed), m_compressedOut.load(std::memory_order_relaxed)};
+}
+
+// Copy in what the server last published; while nothing changes that is
+// one load and a compare a pass
+void NetReactor::applyTuning() {
+    if (!m_config.tuning) {
+        return;
+    }
+    const rcu::Guard guard;
+    const ServerConfig& tuning = *m_config.tuning->load();
+    if (tuning.generation == m_tuningGeneration) {
+        return;
+    }
+    m_tuningGeneration = tuning.generation;
+    m_config.slowClients = tuning.slowClients;
+    m_config.outputHighWater = std::min(tuning.outputHighWater, kMaxPendingOutput);
+    m_config.connectionsPerIp = tuning.connectionsPerIp;
+    if (tuning.idleCompaction != m_config.idleCompaction) {
+        // The sweep's spacing follows from it, so the next one is due now
+        m_config.idleCompaction = tuning.idleCompaction;
+        m_nextSweep = m_now;
+    }
+}
+
+void NetReactor::run() {
+    m_metrics = &Metrics::local();
+    // Sessions adopted before the thread started
+    m_metrics->set(Metric::Sessions, m_sessionCount.load(std::memory_order_relaxed));
+#if defined(__linux__)
+    if (m_ring) {
+        armAccepts();
+        armWake();
+    }
+#endif
+    m_now = std::chrono::steady_clock::now();
+    m_nextSweep = m_now;
+    while (!m_stopRequested.load()) {
+        applyTuning();
+#if defined(ENABLE_TLS)
+        attachSessions();
+#endif
+        // Output from the game thread, then whatever the sockets produced
+        m_inbox.drain([this](NetOutputBatch&& batch) { applyOutput(batch); });
+        if (m_config.idleCompaction.count() > 0 && m_now >= m_nextSweep) {
+            sweepIdle();
+        }
+        for (std::size_t i = 0; i < m_dirty.size(); ++i) {
+            flush(m_dirty[i]);
+        }
+        m_dirty.clear();
+        m_metrics->set(Metric::OutputChunks, m_output.chunksInUse());
+        m_metrics->set(Metric::OutputPoolBytes, m_output.slabCount() * ChunkPool::kSlabSize);
+        if (!m_posted.empty()) {
+            m_game.push(std::move(m_posted));
+            m_posted = NetInputBatch();
+        }
+
+        // Sleep until a socket is ready, the inbox is written or the next sweep is due
+#if defined(__linux__)
+        if (m_ring) {
+            waitRing(sweepTimeout());
+            continue;
+        }
+#endif
+        poll(sweepTimeout());
+
+        for (const PollEvent& event : m_events) {
+            if (event.fd == m_listenFds[kTelnetListener] || event.fd == m_listenFds[kWebSocketListener]) {
+                acceptConnections(event.fd);
+            } else if (event.fd == m_inbox.fd()) {
+                // Drained at the top of the loop
+            } else if (static_cast<std::size_t>(event.fd) < m_sessions.size() && m_sessions[event.fd].open) {
+                // A descriptor closed and reused earlier in this batch may see a
+                // stale event; reading it just finds nothing yet
+                if (event.readable) {
+                    readFrom(event.fd);
+                }
+                if (event.writable && m_sessions[event.fd].open) {
+                    flush(event.fd);
+                }
+            }
+        }
+    }
+}
+
+void NetReactor::applyOutput(NetOutputBatch& batch) {
+    for (NetOutput& output : batch) {
+        const int fd = output.connection.fd;
+        // Meant for a connection that has since closed
+        if (static_cast<std::size_t>(fd) >= m_sessions.size() || !m_sessions[fd].open ||
+            m_sessions[fd].serial != output.connection.serial) {
+            continue;
+        }
+        Session& session = m_sessions[fd];
+        touch(session, fd);
+        resumeOutput(session, fd);
+        // Protocol state is never dropped; a client missing it would be left out of step.
+        // Telnet options mean nothing to a browser
+        if (!output.raw.empty() && !session.webSocket) {
+            queueRaw(session, fd, output.raw);
+        }
+        if (!output.text.empty() && admit(session, fd, output.text.size())) {
+            queue(session, fd, session.width > 0 ? wrapped(session, output.text, TextWrap::measure(output.text))
+                                                 : std::string_view(output.text));
+        }
+        if (output.line) {
+            queueLine(session, fd, *output.line);
+        }
+        if (output.close && !session.closing) {
+            if (session.webSocket) {
+                sendClose(session, fd, WebSocket::kNormalClosure);
+            }
+            closeWhenSent(session, fd);
+        }
+    }
+
+    // The sessions hold their own references to the shared lines' chunks;
+    // the next batch's lines are packed in after these
+    m_output.consumeAll(m_sharedLines);
+    m_encodedLines.clear();
+}
+
+void NetReactor::post(NetInput::Kind kind, int fd, std::string line, unsigned char option) {
+    m_posted.push_back({kind, ConnectionId{m_sessions[fd].serial, fd, m_index}, std::move(line), option});
+}
+
+#if defined(__linux__)
+
+bool NetReactor::watch(int fd) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    return epoll_ctl(m_pollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+void NetReactor::watchWrites(int fd, bool enable) {
+    epoll_event event{};
+    event.events = EPOLLIN | (enable ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+    epoll_ctl(m_pollFd, EPOLL_CTL_MOD, fd, &event);
+}
+
+void NetReactor::unwatch(int fd) {
+    epoll_ctl(m_pollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void NetReactor::poll(int timeoutMs) {
+    std::array<epoll_event, kMaxEvents> ready;
+    m_events.clear();
+    const int count = epoll_wait(m_pollFd, ready.data(), static_cast<int>(ready.size()), timeoutMs);
+    m_now = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        const std::uint32_t flags = ready[i].events;
+        m_events.push_back({ready[i].data.fd, (flags & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0, (flags & EPOLLOUT) != 0});
+    }
+}
+
+#else
+
+bool NetReactor::watch(int fd) {
+    struct kevent change;
+    EV_SET(&change, fd, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+    return kevent(m_pollFd, &change, 1, nullptr, 0, nullptr) == 0;
+}
+
+void NetReactor::watchWrites(int fd, bool enable) {
+    struct kevent change;
+    EV_SET(&change, fd, EVFILT_WRITE, enable ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+    kevent(m_pollFd, &change, 1, nullptr, 0, nullptr);
+}
+
+void NetReactor::unwatch(int fd) {
+    struct kevent change;
+    EV_SET(&change, fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+    kevent(m_pollFd, &change, 1, nullptr, 0, nullptr);
+}
+
+void NetReactor::poll(int timeoutMs) {
+    std::array<struct kevent, kMaxEvents> ready;
+    timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1'000'000L};
+    m_events.clear();
+    const int count = kevent(m_pollFd, nullptr, 0, ready.data(), static_cast<int>(ready.size()),
+                             timeoutMs < 0 ? nullptr : &timeout);
+    m_now = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        const int fd = static_cast<int>(ready[i].ident);
+        const bool writable = ready[i].filter == EVFILT_WRITE;
+        m_events.push_back({fd, !writable || (ready[i].flags & EV_EOF) != 0, writable});
+    }
+}
+
+#endif
+
+#if defined(__linux__)
+
+// io_uring backend
+
+void NetReactor::armAccepts() {
+    for (std::size_t listener = 0; listener < m_listenFds.size(); ++listener) {
+        const int fd = m_listenFds[listener];
+        if (fd < 0 || m_acceptArmed[listener]) {
+            continue;
+        }
+        io_uring_sqe& sqe = m_ring->next();
+        sqe.opcode = IORING_OP_ACCEPT;
+        sqe.fd = fd;
+        sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe.accept_flags = SOCK_CLOEXEC;
+        sqe.user_data = tag(Op::Accept, fd);
+        m_acceptArmed[listener] = true;
+    }
+}
+
+// One receive per session stays armed for its lifetime; the kernel picks a
+// provided buffer only when data arrives, so idle sessions hold none
+void NetReactor::armReceive(int fd, Session& session) {
+    io_uring_sqe& sqe = m_ring->next();
+    sqe.opcode = IORING_OP_RECV;
+    sqe.fd = fd;
+    sqe.ioprio = IORING_RECV_MULTISHOT;
+    sqe.flags = IOSQE_BUFFER_SELECT;
+    sqe.buf_group = IoUring::kBufferGroup;
+    sqe.user_data = tag(Op::Receive, fd);
+    ++session.pendingOps;
+}
+
+void NetReactor::armWake() {
+    io_uring_sqe& sqe = m_ring->next();
+    sqe.opcode = IORING_OP_POLL_ADD;
+    sqe.fd = m_inbox.fd();
+    sqe.poll32_events = POLLIN;
+    sqe.len = IORING_POLL_ADD_MULTI;
+    sqe.user_data = tag(Op::Wake, m_inbox.fd());
+}
+
+// One send in flight per session, straight from its head chunk; the
+// completion sends the rest. A zero-copy send completes twice, the second
+// time when the kernel is done with the chunk
+void NetReactor::submitSend(int fd, Session& session) {
+    if (session.sendInFlight) {
+        return;
+    }
+    if (session.output.empty()) {
+        if (session.closing) {
+            closeSession(fd);
+        }
+        return;
+    }
+    io_uring_sqe& sqe = m_ring->next();
+    sqe.fd = fd;
+    sqe.msg_flags = MSG_NOSIGNAL;
+    if (session.output.head == session.output.tail) {
+        // One chunk: straight from its registered slab
+        const std::string_view bytes = m_output.front(session.output);
+        const std::size_t slab = m_output.frontSlab(session.output);
+        sqe.opcode = IORING_OP_SEND;
+        sqe.addr = reinterpret_cast<std::uint64_t>(bytes.data());
+        sqe.len = static_cast<std::uint32_t>(bytes.size());
+        if (m_zeroCopy && m_fixedSlabs[slab]) {
+            sqe.opcode = IORING_OP_SEND_ZC;
+            sqe.ioprio = IORING_RECVSEND_FIXED_BUF;
+            sqe.buf_index = static_cast<std::uint16_t>(slab);
+        }
+    } else {
+        // A backlog goes in one operation rather than a chunk per round trip.
+        // The kernel copies the header when the ring is submitted, so it only
+        // has to outlive this iteration
+        SendMessage& message = m_sendMessages.emplace_back();
+        std::size_t count = 0;
+        m_output.forEachSegment(session.output, [&](std::string_view segment) {
+            message.segments[count++] = iovec{const_cast<char*>(segment.data()), segment.size()};
+            return count < message.segments.size();
+        });
+        message.header.msg_iov = message.segments.data();
+        message.header.msg_iovlen = count;
+        sqe.opcode = m_zeroCopy ? IORING_OP_SENDMSG_ZC : IORING_OP_SENDMSG;
+        sqe.addr = reinterpret_cast<std::uint64_t>(&message.header);
+        sqe.len = 1;
+    }
+    sqe.user_data = tag(Op::Send, fd);
+    session.sendInFlight = true;
+    ++session.pendingOps;
+}
+
+void NetReactor::waitRing(int timeoutMs) {
+    m_ring->submitAndWait(timeoutMs);
+    m_now = std::chrono::steady_clock::now();
+    m_sendMessages.clear();
+    m_ring->drain([this](const IoUring::Completion& completion) { complete(completion); });
+}
+
+void NetReactor::complete(const IoUring::Completion& completion) {
+    const int fd = static_cast<int>(completion.data & 0xFFFFFFFFu);
+    const bool more = (completion.flags & IORING_CQE_F_MORE) != 0;
+    switch (static_cast<Op>(completion.data >> 32)) {
+        case Op::Accept: {
+            const bool webSocket = fd == m_listenFds[kWebSocketListener];
+            if (completion.result >= 0) {
+                openSession(completion.result, webSocket);
+            } else if (const int error = -completion.result;
+                       !m_acceptPaused && (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM)) {
+                // Stop accepting on every listener until a session ends
+                LOG_WARN("Not accepting connections with {} open: out of descriptors", sessionCount());
+                m_acceptPaused = true;
+                for (std::size_t listener = 0; listener < m_listenFds.size(); ++listener) {
+                    if (m_acceptArmed[listener]) {
+                        io_uring_sqe& sqe = m_ring->next();
+                        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                        sqe.addr = tag(Op::Accept, m_listenFds[listener]);
+                        sqe.user_data = tag(Op::Cancel, m_listenFds[listener]);
+                    }
+                }
+            }
+            if (!more) {
+                m_acceptArmed[webSocket ? kWebSocketListener : kTelnetListener] = false;
+                if (!m_acceptPaused) {
+                    armAccepts();
+                }
+            }
+            break;
+        }
+        case Op::Receive:
+            completeReceive(fd, completion);
+            break;
+        case Op::Send:
+            completeSend(fd, completion);
+            break;
+        case Op::Wake:
+            // The inbox is drained at the top of the loop
+            if (!more) {
+                armWake();
+            }
+            break;
+        case Op::Cancel:
+            break;
+    }
+}
+
+void NetReactor::completeReceive(int fd, const IoUring::Completion& completion) {
+    const bool more = (completion.flags & IORING_CQE_F_MORE) != 0;
+    if (!more) {
+        --m_sessions[fd].pendingOps;
+    }
+    if ((completion.flags & IORING_CQE_F_BUFFER) != 0) {
+        // Parsed in place, then the buffer goes straight back to the ring
+        const unsigned id = completion.flags >> IORING_CQE_BUFFER_SHIFT;
+        if (completion.result > 0 && m_sessions[fd].open) {
+            feed(fd, std::string_view(m_ring->receiveBuffer(id), static_cast<std::size_t>(completion.result)));
+        }
+        m_ring->recycle(id);
+    }
+
+    Session& session = m_sessions[fd];
+    if (session.draining) {
+        if (session.pendingOps == 0) {
+            finishClose(fd);
+        }
+        return;
+    }
+    const bool failed =
+        completion.result == 0 || (completion.result < 0 && completion.result != -ENOBUFS && completion.result != -EINTR);
+    if (m_handingOver) {
+        // handOver() cancelled the receive; the connection stays open for
+        // the next process, unless the client has gone
+        if (failed && completion.result != -ECANCELED) {
+            closeSession(fd);
+        }
+        return;
+    }
+    if (failed) {
+        closeSession(fd);
+        return;
+    }
+    // Out of provided buffers, or ended for another reason: ask again
+    if (!more) {
+        armReceive(fd, session);
+    }
+}
+
+void NetReactor::completeSend(int fd, const IoUring::Completion& completion) {
+    Session& session = m_sessions[fd];
+    if ((completion.flags & IORING_CQE_F_NOTIF) == 0) {
+        session.sendResult = completion.result;
+        if ((completion.flags & IORING_CQE_F_MORE) != 0) {
+            return;
+        }
+    }
+    session.sendInFlight = false;
+    --session.pendingOps;
+    if (session.draining) {
+        if (session.pendingOps == 0) {
+            finishClose(fd);
+        }
+        return;
+    }
+
+    const std::int32_t result = session.sendResult;
+    if (result > 0) {
+        m_output.consume(session.output, static_cast<std::size_t>(result));
+    } else if (result == -EOPNOTSUPP && m_zeroCopy) {
+        LOG_INFO("Zero-copy sends unsupported; copying instead");
+        m_zeroCopy = false;
+    } else if (result != -EINTR && result != -EAGAIN) {
+        closeSession(fd);
+        return;
+    }
+    flush(fd);
+}
+
+void NetReactor::finishClose(int fd) {
+    Session& session = m_sessions[fd];
+    close(fd);
+    m_output.clear(session.output);
+    m_output.clear(session.staged);
+    recycleSession(session);
+    if (m_acceptPaused && !m_handingOver) {
+        m_acceptPaused = false;
+        armAccepts();
+    }
+}
+
+#endif
+
+bool NetReactor::watchListeners() {
+    for (const int fd : m_listenFds) {
+        if (fd >= 0 && !watch(fd)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NetReactor::acceptConnections(int listenFd) {
+    for (;;) {
+#if defined(__linux__)
+        const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+        const int fd = accept(listenFd, nullptr, nullptr);
+#endif
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // The listeners would stay readable; stop watching them until a session ends
+                LOG_WARN("Not accepting connections with {} open: out of descriptors", sessionCount());
+                for (const int listener : m_listenFds) {
+                    if (listener >= 0) {
+                        unwatch(listener);
+                    }
+                }
+                m_acceptPaused = true;
+            }
+            return;
+        }
+#if !defined(__linux__)
+        if (!SocketUtil::setNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+#endif
+        openSession(fd, listenFd == m_listenFds[kWebSocketListener]);
+    }
+}
+
+void NetReactor::openSession(int fd, bool webSocket) {
+    Session* const session = beginSession(fd);
+    if (!session) {
+        return;
+    }
+    if (webSocket) {
+        // Opened is posted once the upgrade is done; a browser is offered no telnet options
+        bool deflate = false;
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+        deflate = m_deflater != nullptr;
+#endif
+        session->webSocket = m_webSockets.take();
+        if (session->webSocket) {
+            session->webSocket->recycle(deflate);
+        } else {
+            session->webSocket = m_webSockets.adopt(std::make_unique<WebSocket>(deflate));
+        }
+        return;
+    }
+    greet(*session, fd);
+}
+
+// A new session on fd, watched and receiving; nullptr if its address is
+// refused or it could not be watched
+NetReactor::Session* NetReactor::beginSession(int fd) {
+    std::uint64_t ticket = 0;
+    if (m_config.access) {
+        const AccessControl::Verdict verdict = m_config.access->admit(fd, m_config.connectionsPerIp, ticket);
+        if (verdict != AccessControl::Verdict::Admit) {
+            refuse(fd, verdict == AccessControl::Verdict::Denied
+                           ? "Connections from your address are not accepted.\r\n"
+                           : "Too many connections from your address; try again later.\r\n");
+            return nullptr;
+        }
+    }
+    const int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+#if defined(SO_NOSIGPIPE)
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    if (!usingIoUring() && !watch(fd)) {
+        if (ticket != 0) {
+            m_config.access->release(ticket);
+        }
+        close(fd);
+        return nullptr;
+    }
+    if (static_cast<std::size_t>(fd) >= m_sessions.size()) {
+        m_sessions.resize(static_cast<std::size_t>(fd) + 1);
+    }
+    Session& session = m_sessions[fd];
+    recycleSession(session);
+    session.open = true;
+    session.serial = m_nextSerial++;
+    session.peerTicket = ticket;
+    session.active = m_now;
+    ++m_sessionCount;
+    m_metrics->add(Metric::SessionsOpened);
+    m_metrics->set(Metric::Sessions, m_sessionCount.load(std::memory_order_relaxed));
+#if defined(__linux__)
+    if (m_ring) {
+        armReceive(fd, session);
+    }
+#endif
+    return &session;
+}
+
+// Tell a refused connection why, if its socket takes the line at once, and close it
+void NetReactor::refuse(int fd, std::string_view reason) {
+    static_cast<void>(send(fd, reason.data(), reason.size(), MSG_DONTWAIT | SocketUtil::kSendFlags));
+    close(fd);
+    m_metrics->add(Metric::SessionsRefused);
+}
+
+// Offer a telnet session its options and tell the game thread it is there
+void NetReactor::greet(Session& session, int fd) {
+    // GMCP, MSDP and, where built with zlib and not over TLS, MCCP2; and
+    // ask for the client's width
+    const char offer[] = {static_cast<char>(kIac), static_cast<char>(kWill), static_cast<char>(OutOfBand::kGmcp),
+                          static_cast<char>(kIac), static_cast<char>(kWill), static_cast<char>(OutOfBand::kMsdp),
+                          static_cast<char>(kIac), static_cast<char>(kDo),   static_cast<char>(kNaws)};
+    queueRaw(session, fd, std::string_view(offer, sizeof(offer)));
+#if defined(ENABLE_MCCP)
+    if (m_config.compression && !session.secure) {
+        const char compress[] = {static_cast<char>(kIac), static_cast<char>(kWill), static_cast<char>(kCompress2)};
+        queueRaw(session, fd, std::string_view(compress, sizeof(compress)));
+    }
+#endif
+    post(NetInput::Kind::Opened, fd, peerAddress(fd));
+}
+
+// Back to a fresh session, its pooled objects returned, with the line
+// buffer kept for the next connection on the descriptor
+void NetReactor::recycleSession(Session& session) {
+    std::string line = std::move(session.line);
+    line.clear();
+    session = Session{};
+    session.line = std::move(line);
+}
+
+void NetReactor::closeSession(int fd) {
+    Session& session = m_sessions[fd];
+    if (!session.open) {
+        return;
+    }
+    if (!session.webSocket || session.webSocket->upgraded()) {
+        post(NetInput::Kind::Closed, fd);
+    }
+    if (session.peerTicket != 0) {
+        m_config.access->release(session.peerTicket);
+        session.peerTicket = 0;
+    }
+    --m_sessionCount;
+    m_metrics->set(Metric::Sessions, m_sessionCount.load(std::memory_order_relaxed));
+#if defined(ENABLE_MCCP)
+    if (session.compressor) {
+        endCompression(session, fd);
+    }
+#endif
+
+#if defined(__linux__)
+    if (m_ring) {
+        // Ends the armed receive and any send in flight; the descriptor and
+        // the chunks being sent are released when they complete
+        shutdown(fd, SHUT_RDWR);
+        session.open = false;
+        session.draining = true;
+        if (session.pendingOps == 0) {
+            finishClose(fd);
+        }
+        return;
+    }
+#endif
+
+    unwatch(fd);
+    close(fd);
+    m_output.clear(session.output);
+    m_output.clear(session.staged);
+    recycleSession(session);
+
+    if (m_acceptPaused && !m_handingOver && watchListeners()) {
+        m_acceptPaused = false;
+    }
+}
+
+void NetReactor::readFrom(int fd) {
+    const ssize_t count = read(fd, m_readBuffer.data(), m_readBuffer.size());
+    if (count > 0) {
+        feed(fd, std::string_view(m_readBuffer.data(), static_cast<std::size_t>(count)));
+    } else if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        closeSession(fd);
+    }
+}
+
+// Strip telnet commands, answer option requests and assemble lines for the
+// game thread. Returns false once the session is closing
+bool NetReactor::feed(int fd, std::string_view bytes) {
+    touch(m_sessions[fd], fd);
+#if defined(ENABLE_TLS)
+    if (Session& session = m_sessions[fd]; session.tls && session.tls->decrypts()) {
+        m_decrypted.clear();
+        if (!session.tls->decrypt(bytes, m_decrypted)) {
+            // Bad records, or the client's close_notify
+            closeSession(fd);
+            return false;
+        }
+        if (session.tls->owes()) {
+            queued(session, fd, true);
+        }
+        bytes = m_decrypted;
+    }
+#endif
+    if (m_sessions[fd].webSocket) {
+        return feedWebSocket(fd, bytes);
+    }
+    // The parser lives in the session; callbacks reach it by descriptor
+    struct Handler {
+        NetReactor& reactor;
+        int fd;
+
+        bool data(char ch) { return reactor.receiveData(fd, ch); }
+        bool negotiate(unsigned char verb, unsigned char option) { return reactor.negotiate(fd, verb, option); }
+        bool subnegotiate(unsigned char option, std::string_view payload) {
+            return reactor.subnegotiate(fd, option, payload);
+        }
+    };
+    Handler handler{*this, fd};
+    return m_sessions[fd].telnet.feed(bytes, handler);
+}
+
+bool NetReactor::negotiate(int fd, unsigned char verb, unsigned char option) {
+    Session& session = m_sessions[fd];
+    if (session.closing) {
+        return false;
+    }
+#if defined(ENABLE_MCCP)
+    // The answer to our MCCP2 offer, or a later change of mind
+    if (option == kCompress2 && m_config.compression && !session.secure && (verb == kDo || verb == kDont)) {
+        if (verb == kDo && !session.compressor) {
+            startCompression(session, fd);
+        } else if (verb == kDont && session.compressor) {
+            compressOutput(session, fd, true);
+        }
+        return true;
+    }
+#endif
+    // GMCP and MSDP are the game thread's business once agreed
+    if ((option == OutOfBand::kGmcp || option == OutOfBand::kMsdp) && (verb == kDo || verb == kDont)) {
+        post(verb == kDo ? NetInput::Kind::OptionOn : NetInput::Kind::OptionOff, fd, {}, option);
+        return true;
+    }
+    // The answer to our NAWS request; the width itself follows as a subnegotiation
+    if (option == kNaws && (verb == kWill || verb == kWont)) {
+        if (verb == kWont) {
+            session.width = 0;
+        }
+        return true;
+    }
+    // The game thread offers to echo only to hide a password being typed,
+    // and withdraws the offer after; the client's answers need no reply
+    if (option == kEcho && (verb == kDo || verb == kDont)) {
+        return true;
+    }
+    // Refuse every other option, which leaves the client in plain line mode
+    if (verb == kDo || verb == kWill) {
+        const char reply[] = {static_cast<char>(kIac), static_cast<char>(verb == kDo ? kWont : kDont),
+                              static_cast<char>(option)};
+        queueRaw(session, fd, std::string_view(reply, sizeof(reply)));
+    }
+    return true;
+}
+
+bool NetReactor::subnegotiate(int fd, unsigned char option, std::string_view payload) {
+    if (m_sessions[fd].closing) {
+        return false;
+    }
+    if (option == OutOfBand::kGmcp || option == OutOfBand::kMsdp) {
+        post(NetInput::Kind::Subnegotiation, fd, std::string(payload), option);
+    } else if (option == kNaws && payload.size() >= 4) {
+        // Width and height, 16 bits each, most significant byte first; sent
+        // again whenever the client's window changes size
+        const unsigned width = (static_cast<unsigned>(static_cast<unsigned char>(payload[0])) << 8) |
+                               static_cast<unsigned char>(payload[1]);
+        m_sessions[fd].width = width >= kMinWrapWidth ? static_cast<std::uint16_t>(width) : 0;
+        post(NetInput::Kind::WindowSize, fd);
+        m_posted.back().rows = static_cast<std::uint16_t>((static_cast<unsigned>(static_cast<unsigned char>(payload[2])) << 8) |
+                                                          static_cast<unsigned char>(payload[3]));
+    }
+    return true;
+}
+
+// A browser session: the upgrade, then frames. Each message is read as a
+// line, or several if it holds line breaks
+bool NetReactor::feedWebSocket(int fd, std::string_view bytes) {
+    struct Events final : WebSocket::Events {
+        NetReactor& reactor;
+        int fd;
+
+        Events(NetReactor& owner, int descriptor) : reactor(owner), fd(descriptor) {}
+
+        bool handshake(std::string_view response, bool accepted) override {
+            Session& session = reactor.m_sessions[fd];
+            reactor.queueRaw(session, fd, response);
+            if (!accepted) {
+                reactor.closeWhenSent(session, fd);
+                return false;
+            }
+            reactor.post(NetInput::Kind::Opened, fd, peerAddress(fd));
+            return true;
+        }
+        bool message(std::string_view payload) override { return reactor.receiveMessage(fd, payload); }
+        bool ping(std::string_view payload) override {
+            reactor.sendControl(reactor.m_sessions[fd], fd, WebSocket::Opcode::Pong, payload);
+            return true;
+        }
+        bool close(std::uint16_t code) override {
+            Session& session = reactor.m_sessions[fd];
+            reactor.sendClose(session, fd, code);
+            reactor.closeWhenSent(session, fd);
+            return false;
+        }
+    };
+    if (m_sessions[fd].closing) {
+        return false;
+    }
+    Events events(*this, fd);
+    return m_sessions[fd].webSocket->feed(bytes, events);
+}
+
+bool NetReactor::receiveMessage(int fd, std::string_view payload) {
+    for (const char ch : payload) {
+        if (!receiveData(fd, ch)) {
+            return false;
+        }
+    }
+    // The end of a message ends its line, break or not
+    if (payload.empty() || (payload.back() != '\r' && payload.back() != '\n')) {
+        endLine(fd);
+    }
+    m_sessions[fd].afterCr = false;
+    return !m_sessions[fd].closing;
+}
+
+// One byte of user data: lines end at CR, LF, CR LF or CR NUL
+bool NetReactor::receiveData(int fd, char ch) {
+    Session& session = m_sessions[fd];
+    if (session.closing) {
+        return false;
+    }
+    const bool afterCr = std::exchange(session.afterCr, false);
+    if (ch == '\r' || ch == '\n') {
+        if (ch == '\n' && afterCr) {
+            return true;
+        }
+        session.afterCr = ch == '\r';
+        endLine(fd);
+        return true;
+    }
+    if (ch == '\0') {
+        return true;
+    }
+    if (ch == '\b' || ch == 0x7F) {
+        // Erase one UTF-8 character
+        while (!session.line.empty() && (static_cast<unsigned char>(session.line.back()) & 0xC0) == 0x80) {
+            session.line.pop_back();
+        }
+        if (!session.line.empty()) {
+            session.line.pop_back();
+        }
+        return true;
+    }
+    if (session.line.size() < kMaxLineLength) {
+        session.line.push_back(ch);
+    } else {
+        session.overlong = true;
+    }
+    return true;
+}
+
+void NetReactor::endLine(int fd) {
+    Session& session = m_sessions[fd];
+    if (session.overlong) {
+        session.overlong = false;
+        session.line.clear();
+        queue(session, fd, "That line was too long.\n> ");
+        return;
+    }
+    post(NetInput::Kind::Line, fd, std::move(session.line));
+    session.line = std::string();
+}
+
+void NetReactor::queue(Session& session, int fd, std::string_view text) {
+    if (session.closing) {
+        return;
+    }
+    const bool encoded = session.webSocket ? frame(sink(session), text, {}, session.webSocket->deflate())
+                                           : encode(sink(session), text);
+    queued(session, fd, encoded && pending(session) <= kMaxPendingOutput);
+}
+
+void NetReactor::queueRaw(Session& session, int fd, std::string_view bytes) {
+    if (session.closing) {
+        return;
+    }
+    queued(session, fd, m_output.append(sink(session), bytes) && pending(session) <= kMaxPendingOutput);
+}
+
+// A line shared by several sessions is encoded the first time the batch
+// sends it in each session's protocol, and wrapped first if the session's
+// width calls for it, and linked into every later session's chain with the
+// same protocol and width without a copy
+void NetReactor::queueLine(Session& session, int fd, const std::string& line) {
+    if (session.closing) {
+        return;
+    }
+    const auto encoding = static_cast<std::size_t>(encodingOf(session));
+    // Unordered_map nodes stay put, so plain survives the insertion of a wrapped entry
+    EncodedLine& plain = m_encodedLines[LineKey{&line, 0}];
+    if (!plain.measured) {
+        plain.metrics = TextWrap::measure(line);
+        plain.measured = true;
+    }
+    const bool wraps =
+        session.width > 0 && (plain.metrics.multiline || plain.metrics.columns > session.width);
+    EncodedLine& encodings = wraps ? m_encodedLines[LineKey{&line, session.width}] : plain;
+    EncodedSpan& encoded = encodings.spans[encoding];
+    // Nothing is encoded for a session that would discard it
+    if (!admit(session, fd, encoded.size != 0 ? encoded.size : line.size() + 1)) {
+        return;
+    }
+    if (encoded.size == 0) {
+        const std::string_view text = wraps ? wrapped(session, line, plain.metrics) : std::string_view(line);
+        const std::size_t offset = m_sharedLines.size;
+        const bool built = session.webSocket ? frame(m_sharedLines, text, "\n", session.webSocket->deflate())
+                                             : encode(m_sharedLines, text) && encode(m_sharedLines, "\n");
+        if (!built) {
+            queued(session, fd, false);
+            return;
+        }
+        encoded = EncodedSpan{offset, m_sharedLines.size - offset};
+    }
+    const bool fitted = pending(session) + encoded.size <= kMaxPendingOutput;
+    if (fitted) {
+        m_output.appendShared(sink(session), m_sharedLines, encoded.offset, encoded.size);
+    }
+    queued(session, fd, fitted);
+}
+
+// text word wrapped to the session's width, in m_wrapped until the next call;
+// text itself when it already fits
+std::string_view NetReactor::wrapped(const Session& session, std::string_view text, const TextMetrics& metrics) {
+    if (session.width == 0 || (!metrics.multiline && metrics.columns <= session.width)) {
+        return text;
+    }
+    m_wrapped.clear();
+    TextWrap::wrapLines(text, session.width, m_wrapped, m_wrapRows);
+    m_metrics->add(Metric::TextsWrapped);
+    return m_wrapped;
+}
+
+// Append text to chain with line breaks as CR LF and IAC bytes escaped; false
+// if the pool ran out
+bool NetReactor::encode(ChunkChain& chain, std::string_view text) {
+    // Translated a stack buffer at a time
+    char staged[512];
+    std::size_t used = 0;
+    for (const char ch : text) {
+        if (used + 2 > sizeof(staged)) {
+            if (!m_output.append(chain, std::string_view(staged, used))) {
+                return false;
+            }
+            used = 0;
+        }
+        if (ch == '\n') {
+            staged[used++] = '\r';
+            staged[used++] = '\n';
+        } else if (static_cast<unsigned char>(ch) == kIac) {
+            staged[used++] = static_cast<char>(kIac);
+            staged[used++] = static_cast<char>(kIac);
+        } else {
+            staged[used++] = ch;
+        }
+    }
+    return m_output.append(chain, std::string_view(staged, used));
+}
+
+// Append text and end to chain as one WebSocket text frame, compressed when
+// the session agreed to it and that makes it smaller; false if the pool ran out
+bool NetReactor::frame(ChunkChain& chain, std::string_view text, std::string_view end, bool deflate) {
+    m_frameText.clear();
+    WebSocket::appendUtf8(text, m_frameText);
+    m_frameText.append(end);
+    std::string_view payload = m_frameText;
+    bool compressed = false;
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+    if (deflate && m_deflater && payload.size() >= kMinDeflate && m_deflater->compress(payload, m_compressed) &&
+        m_compressed.size() < payload.size()) {
+        payload = m_compressed;
+        compressed = true;
+    }
+#else
+    static_cast<void>(deflate);
+#endif
+    WebSocket::FrameHeader header;
+    const std::size_t size = WebSocket::frameHeader(WebSocket::Opcode::Text, compressed, payload.size(), header);
+    return m_output.append(chain, std::string_view(header.data(), size)) && m_output.append(chain, payload);
+}
+
+void NetReactor::sendControl(Session& session, int fd, WebSocket::Opcode opcode, std::string_view payload) {
+    WebSocket::FrameHeader header;
+    const std::size_t size = WebSocket::frameHeader(opcode, false, payload.size(), header);
+    queueRaw(session, fd, std::string_view(header.data(), size));
+    queueRaw(session, fd, payload);
+}
+
+void NetReactor::sendClose(Session& session, int fd, std::uint16_t code) {
+    const char status[] = {static_cast<char>(code >> 8), static_cast<char>(code)};
+    sendControl(session, fd, WebSocket::Opcode::Close, std::string_view(status, sizeof(status)));
+}
+
+// Close once what is queued has been written
+void NetReactor::closeWhenSent(Session& session, int fd) {
+    session.closing = true;
+    if (!session.dirty) {
+        session.dirty = true;
+        m_dirty.push_back(fd);
+    }
+}
+
+NetReactor::Encoding NetReactor::encodingOf(const Session& session) noexcept {
+    if (!session.webSocket) {
+        return Encoding::Telnet;
+    }
+    return session.webSocket->deflate() ? Encoding::WebSocketDeflate : Encoding::WebSocket;
+}
+
+// Mark a session for the next flush after queueing; one whose output did not
+// fit is dropped there instead
+void NetReactor::queued(Session& session, int fd, bool fitted) {
+    if (!fitted) {
+        // Not reading what it is sent (or the pool is spent)
+        LOG_INFO("Dropping connection {}: {} bytes unsent", fd, pending(session));
+        session.closing = true;
+        session.dropped = true;
+    }
+    if (!session.dirty) {
+        session.dirty = true;
+        m_dirty.push_back(fd);
+    }
+}
+
+// Whether bytes more of output fit under the high-water mark; if not the
+// policy either discards them or cuts the client off
+bool NetReactor::admit(Session& session, int fd, std::size_t bytes) {
+    if (session.closing || pending(session) + bytes <= m_config.outputHighWater) {
+        return true;
+    }
+    if (m_config.slowClients == SlowClientPolicy::Disconnect) {
+        queued(session, fd, false);
+        return false;
+    }
+    session.droppedBytes += bytes;
+    m_metrics->add(Metric::OutputDroppedBytes, bytes);
+    return false;
+}
+
+// Once a throttled client has drained to half the mark, tell it what it missed
+void NetReactor::resumeOutput(Session& session, int fd) {
+    if (session.droppedBytes > 0 && pending(session) <= m_config.outputHighWater / 2) {
+        const std::size_t dropped = std::exchange(session.droppedBytes, 0);
+        queue(session, fd, std::format("[{} bytes of output were dropped while you were behind.]\n", dropped));
+    }
+}
+
+// Where queued output goes: straight to the socket's chain, or to be deflated first
+ChunkChain& NetReactor::sink(Session& session) noexcept {
+#if defined(ENABLE_MCCP)
+    if (session.compressor) {
+        return session.staged;
+    }
+#endif
+#if defined(ENABLE_TLS)
+    if (session.tls && session.tls->encrypts()) {
+        return session.staged;
+    }
+#endif
+    return session.output;
+}
+
+std::size_t NetReactor::pending(const Session& session) const noexcept {
+    return session.output.size + session.staged.size;
+}
+
+void NetReactor::flush(int fd) {
+    Session& session = m_sessions[fd];
+    session.dirty = false;
+    if (!session.open) {
+        return;
+    }
+    if (session.dropped) {
+        closeSession(fd);
+        return;
+    }
+    resumeOutput(session, fd);
+#if defined(ENABLE_MCCP)
+    if (session.compressor) {
+        // A closing session's stream is ended so the client sees it finish
+        compressOutput(session, fd, session.closing);
+        if (session.dropped) {
+            closeSession(fd);
+            return;
+        }
+    }
+#endif
+#if defined(ENABLE_TLS)
+    if (session.tls && session.tls->encrypts()) {
+        encryptOutput(session, fd);
+        if (session.dropped) {
+            closeSession(fd);
+            return;
+        }
+    }
+#endif
+#if defined(__linux__)
+    if (m_ring) {
+        submitSend(fd, session);
+        return;
+    }
+#endif
+    while (!session.output.empty()) {
+        // Every queued chunk in one call
+        std::array<iovec, kMaxSendSegments> segments;
+        std::size_t count = 0;
+        m_output.forEachSegment(session.output, [&](std::string_view segment) {
+            segments[count++] = iovec{const_cast<char*>(segment.data()), segment.size()};
+            return count < segments.size();
+        });
+        msghdr message{};
+        message.msg_iov = segments.data();
+        message.msg_iovlen = count;
+        const ssize_t sent = sendmsg(fd, &message, SocketUtil::kSendFlags);
+        if (sent > 0) {
+            m_output.consume(session.output, static_cast<std::size_t>(sent));
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Finish when the socket drains
+            if (!session.writeWatched) {
+                session.writeWatched = true;
+                watchWrites(fd, true);
+            }
+            return;
+        } else {
+            closeSession(fd);
+            return;
+        }
+    }
+
+    // Everything is out, and an empty chain holds no chunks
+    if (session.writeWatched) {
+        session.writeWatched = false;
+        watchWrites(fd, false);
+    }
+    if (session.closing) {
+        closeSession(fd);
+    }
+}
+
+// How long the loop may sleep before the next sweep for idle sessions is due
+int NetReactor::sweepTimeout() const noexcept {
+    if (m_config.idleCompaction.count() <= 0) {
+        return -1;
+    }
+    return static_cast<int>(
+        std::max<std::int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(m_nextSweep - m_now).count()));
+}
+
+void NetReactor::sweepIdle() {
+    // Often enough that no session waits much past its threshold
+    m_nextSweep = m_now + std::clamp<std::chrono::seconds>(m_config.idleCompaction / 4, std::chrono::seconds(1),
+                                                           kLongestSweep);
+    const std::chrono::steady_clock::time_point quietSince = m_now - m_config.idleCompaction;
+    for (std::size_t i = 0; i < m_sessions.size(); ++i) {
+        Session& session = m_sessions[i];
+        // Output still going out is not idle, however long the socket takes it
+        if (session.open && !session.closing && !session.compacted && session.active <= quietSince &&
+            pending(session) == 0) {
+            compact(session, static_cast<int>(i));
+        }
+    }
+}
+
+// Let go of what a quiet session holds for its next input or output
+void NetReactor::compact(Session& session, int fd) {
+    session.compacted = true;
+    // A partial line keeps its bytes, just not the room it had grown
+    session.line.shrink_to_fit();
+#if defined(ENABLE_MCCP)
+    if (session.compressor) {
+        // Ended as for DONT COMPRESS2; the stream goes back to the pool, which
+        // frees it once kPooledStreams wait there
+        session.resumeCompression = true;
+        compressOutput(session, fd, true);
+    }
+#endif
+    m_metrics->add(Metric::SessionsCompacted);
+}
+
+// A session just read from or written to
+void NetReactor::touch(Session& session, int fd) {
+    session.active = m_now;
+    if (!session.compacted) {
+        return;
+    }
+    session.compacted = false;
+#if defined(ENABLE_MCCP)
+    // The client agreed to MCCP2 once and has not taken it back
+    if (std::exchange(session.resumeCompression, false) && !session.closing) {
+        startCompression(session, fd);
+    }
+#else
+    static_cast<void>(fd);
+#endif
+}
+
+#if defined(ENABLE_MCCP)
+
+// Confirm MCCP2 to the client; everything queued after the confirmation is compressed
+void NetReactor::startCompression(Session& session, int fd) {
+    // A stream another session ended, if the reactor has one to spare
+    ObjectPool<MccpStream>::Handle stream = m_mccpStreams.take();
+    if (!stream) {
+        stream = m_mccpStreams.adopt(MccpStream::create());
+    } else if (!stream->recycle()) {
+        return;
+    }
+    if (!stream) {
+        return;
+    }
+    const char start[] = {static_cast<char>(kIac), static_cast<char>(kSb), static_cast<char>(kCompress2),
+                          static_cast<char>(kIac), static_cast<char>(kSe)};
+    queueRaw(session, fd, std::string_view(start, sizeof(start)));
+    session.compressor = std::move(stream);
+}
+
+// Deflate the session's staged output onto its chain; finish ends the
+// stream and the session goes back to plain output
+void NetReactor::compressOutput(Session& session, int fd, bool finish) {
+    if (session.staged.empty() && !finish) {
+        return;
+    }
+    MccpStream& stream = *session.compressor;
+    const std::uint64_t before = stream.bytesIn();
+    const std::uint64_t after = stream.bytesOut();
+    m_compressed.clear();
+    bool deflated = true;
+    m_output.forEachSegment(session.staged, [&](std::string_view bytes) {
+        deflated = stream.compress(bytes, m_compressed);
+        return deflated;
+    });
+    deflated = deflated && stream.flush(finish, m_compressed);
+    m_output.clear(session.staged);
+    m_compressedIn.fetch_add(stream.bytesIn() - before, std::memory_order_relaxed);
+    m_compressedOut.fetch_add(stream.bytesOut() - after, std::memory_order_relaxed);
+
+    queued(session, fd,
+           deflated && m_output.append(session.output, m_compressed) && session.output.size <= kMaxPendingOutput);
+    if (finish) {
+        endCompression(session, fd);
+    }
+}
+
+void NetReactor::endCompression(Session& session, int fd) {
+    LOG_DEBUG("Connection {}: MCCP2 sent {} bytes as {}", fd, session.compressor->bytesIn(),
+              session.compressor->bytesOut());
+    m_output.clear(session.staged);
+    session.compressor.reset();
+}
+
+#endif
+
+#if defined(ENABLE_TLS)
+
+void NetReactor::attach(int fd, std::unique_ptr<TlsStream> tls) {
+    {
+        const std::lock_guard lock(m_attachMutex);
+        m_attaching.push_back({fd, std::move(tls)});
+    }
+    m_inbox.wake();
+}
+
+// Sessions TlsAcceptor finished the handshake for since the last iteration
+void NetReactor::attachSessions() {
+    {
+        const std::lock_guard lock(m_attachMutex);
+        if (m_attaching.empty()) {
+            return;
+        }
+        m_attached.swap(m_attaching);
+    }
+    for (Attaching& attaching : m_attached) {
+        const int fd = attaching.fd;
+        Session* const session = beginSession(fd);
+        if (!session) {
+            continue;
+        }
+        session->secure = true;
+        session->tls = std::move(attaching.tls);
+        greet(*session, fd);
+        // Whatever the client sent with the end of the handshake
+        if (session->tls && session->tls->decrypts()) {
+            feed(fd, {});
+        }
+    }
+    m_attached.clear();
+}
+
+// Seal the session's staged output into records on its chain, ending
+// with a close_notify once it is closing
+void NetReactor::encryptOutput(Session& session, int fd) {
+    TlsStream& stream = *session.tls;
+    m_encrypted.clear();
+    bool sealed = true;
+    if (session.staged.empty()) {
+        sealed = stream.encrypt({}, m_encrypted);
+    }
+    m_output.forEachSegment(session.staged, [&](std::string_view text) {
+        sealed = stream.encrypt(text, m_encrypted);
+        return sealed;
+    });
+    m_output.clear(session.staged);
+    if (session.closing) {
+        stream.close(m_encrypted);
+    }
+    if (!sealed || (!m_encrypted.empty() && !m_output.append(session.output, m_encrypted)) ||
+        session.output.size > kMaxPendingOutput) {
+        queued(session, fd, false);
+    }
+}
+
+#endif
@@ -0,0 +1,1837 @@
+#include "../include/NetServer.h"
+#include "../include/CommandTokens.h"
+#include "../include/FileView.h"
+#include "../include/MappedRecords.h"
+#include "../include/PlayerSave.h"
+#include "../include/SignalHandler.h"
+#include "../include/StartupPhases.h"
+#include "../include/TickClock.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <random>
+#include <thread>
+#include <poll.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kMaxNameLength = 16;
+constexpr unsigned kMaxReactors = 256;
+
+constexpr std::string_view kNamePrompt = "By what name do you wish to be known? ";
+constexpr std::string_view kQueueFull = "You are typing faster than the game can keep up; that line was dropped.\n";
+constexpr std::string_view kThrottled = "You are sending commands too quickly; that line was ignored.\n";
+constexpr std::string_view kPasswordPrompt = "Password: ";
+constexpr std::uint8_t kMaxPasswordAttempts = 3;
+constexpr auto kAnnounceInterval = std::chrono::seconds(5);
+// Longest the reactors spend writing out queued output before a copyover
+constexpr auto kHandoverTimeout = std::chrono::milliseconds(500);
+constexpr std::string_view kCopyoverStarting = "\nThe world holds still for a moment...\n";
+constexpr std::string_view kCopyoverDone = "...and goes on as if nothing had happened.\n";
+constexpr std::string_view kNoGateway = "That way lies another shard, reachable only through the gateway; you stay here.\n> ";
+
+// IAC WILL ECHO makes the client stop echoing what is typed, so a password
+// stays off the screen; IAC WONT ECHO hands echoing back
+constexpr std::string_view kEchoOff = "\xFF\xFB\x01";
+constexpr std::string_view kEchoOn = "\xFF\xFC\x01";
+
+// Let the process hold as many sockets as its hard limit allows
+void raiseFileLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur >= limit.rlim_max) {
+        return;
+    }
+    limit.rlim_cur = limit.rlim_max;
+#if defined(__APPLE__)
+    // macOS rejects an unlimited soft limit for descriptors
+    limit.rlim_cur = std::min<rlim_t>(limit.rlim_cur, OPEN_MAX);
+#endif
+    setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+// Two to sixteen ASCII letters
+bool isValidName(std::string_view name) {
+    return name.size() >= 2 && name.size() <= kMaxNameLength &&
+           std::all_of(name.begin(), name.end(), [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); });
+}
+
+// Names are ASCII letters, so setting the case bit lowercases them
+std::string lowercase(std::string_view name) {
+    std::string lowered(name);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](char c) { return static_cast<char>(c | 0x20); });
+    return lowered;
+}
+
+// A page fills the window but for the --more-- line and the prompt; a
+// window too small to page in, or one never reported, gets replies whole
+std::uint16_t pageLines(std::uint16_t rows) {
+    return rows > 3 ? static_cast<std::uint16_t>(rows - 2) : 0;
+}
+
+} // namespace
+
+NetServer::NetServer(GameEnginePtr engine)
+    : m_engine(std::move(engine)) {
+    // Lines wait in the engine's per-session queues and run at its ticks
+    m_engine->ticks().setCommandRunner([this](SessionId key, std::string& line) { runLine(key, line); },
+                                       [this] { runBatch(); });
+    // A busy tick serves admins, moves and fights before listings; lines
+    // typed while logging in are ordinary
+    m_engine->ticks().setCommandClassifier([this](SessionId key, std::string_view line) {
+        const auto found = m_connections.find(key);
+        return found == m_connections.end() || found->second.player == kInvalidPlayerId
+                   ? CommandPriority::Normal
+                   : m_engine->commandPriority(found->second.player, line);
+    });
+}
+
+std::expected<std::unique_ptr<NetServer>, NetError> NetServer::create(GameEnginePtr engine, const Options& options) {
+    raiseFileLimit();
+
+    std::unique_ptr<NetServer> server(new NetServer(std::move(engine)));
+    if (!server->m_inbox.open()) {
+        return std::unexpected(NetError::POLLER_FAILED);
+    }
+
+    // The tunables as the command line gave them, then with the file's over them
+    ServerConfig& base = server->m_tuningBase;
+    base.rateLimit = options.rateLimit;
+    base.saveInterval = options.saveInterval;
+    base.checkpointInterval = options.checkpointInterval;
+    base.statsInterval = options.statsInterval;
+    base.outputHighWater = options.outputHighWater;
+    base.slowClients = options.slowClients;
+    base.idleCompaction = options.idleCompaction;
+    base.connectionsPerIp = options.connectionsPerIp;
+    server->m_configPath = options.config;
+    server->m_watchdogThreshold = options.watchdog;
+    auto tuning = options.config.empty() ? std::expected<ServerConfig, std::string>(base)
+                                         : ServerConfig::load(options.config, base);
+    if (!tuning) {
+        LOG_ERROR("Config {}: {}", options.config, tuning.error());
+        return std::unexpected(NetError::CONFIG_FAILED);
+    }
+    server->m_accessPath = options.access;
+    if (!options.access.empty()) {
+        auto list = AccessList::load(options.access);
+        if (!list) {
+            LOG_ERROR("Access list {}: {}", options.access, list.error());
+            return std::unexpected(NetError::CONFIG_FAILED);
+        }
+        LOG_INFO("Access list {}: {} rules", options.access, list->rules());
+        server->m_access.publish(std::make_unique<AccessList>(std::move(*list)));
+    }
+    // Without passwords anyone could log in by an admin's name
+    if (!options.admins.empty() && options.accounts.empty()) {
+        LOG_WARN("Admins need accounts; there are none");
+    } else {
+        for (const std::string& name : options.admins) {
+            server->m_admins.push_back(lowercase(name));
+        }
+    }
+    if (!options.texts.empty()) {
+        server->m_engine->setTextDirectory(options.texts);
+    }
+    if (options.resolvers > 0) {
+        if (!server->m_resolved.open()) {
+            return std::unexpected(NetError::POLLER_FAILED);
+        }
+        server->m_resolver = std::make_unique<HostResolver>(server->m_resolved, options.resolvers);
+    }
+
+    unsigned count = options.reactors;
+    if (count == 0 && !options.topology.empty()) {
+        count = static_cast<unsigned>(std::max<std::size_t>(options.topology.cores(ThreadRole::Reactors).size(), 1));
+    } else if (count == 0) {
+        const unsigned cores = std::thread::hardware_concurrency();
+        count = cores > 1 ? cores - 1 : 1;
+    }
+    count = std::min(count, kMaxReactors);
+    // Only what the engine settings below do not touch runs as phases,
+    // each writing members the others leave alone
+    StartupPhases<NetError> phases("net_server");
+    std::optional<CopyoverState> adopted;
+    const auto handedOver = phases.add("copyover state", {}, [&]() -> std::expected<void, NetError> {
+        if (options.copyoverFd < 0) {
+            return {};
+        }
+        adopted = Copyover::load(options.copyoverFd);
+        if (!adopted) {
+            return std::unexpected(NetError::COPYOVER_FAILED);
+        }
+        for (std::size_t i = count; i < adopted->listeners.size(); ++i) {
+            for (const int fd : adopted->listeners[i]) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        }
+        return {};
+    });
+    // Each reactor binds and registers its ring's buffers on its own
+    NetReactor::Config config{options.address, options.port, options.useIoUring, tuning->slowClients,
+                              tuning->outputHighWater, options.compression, options.webSocketPort,
+                              tuning->idleCompaction};
+    config.tuning = &server->m_tuning;
+    config.access = &server->m_access;
+    config.connectionsPerIp = tuning->connectionsPerIp;
+    server->m_reactors.resize(count);
+    std::vector<StartupPhases<NetError>::Phase> listening;
+    for (unsigned i = 0; i < count; ++i) {
+        const auto reactor = [&, i]() -> std::expected<void, NetError> {
+            // Each reactor serves the listeners its namesake had, if there was one
+            NetReactor::Config own = config;
+            own.listenFds = adopted && i < adopted->listeners.size() ? adopted->listeners[i] : std::array{-1, -1};
+            // Built on the core it will run on, so its pools come from that core's node
+            const int core = options.topology.core(ThreadRole::Reactors, i);
+            const ScopedAffinity local(core < 0 ? std::span<const int>() : std::span(&core, 1));
+            auto created = NetReactor::create(static_cast<std::uint16_t>(i), server->m_inbox, own);
+            if (!created) {
+                return std::unexpected(created.error());
+            }
+            server->m_reactors[i] = std::move(*created);
+            return {};
+        };
+        listening.push_back(phases.add(std::format("reactor {}", i), {handedOver}, reactor));
+    }
+    if (options.tlsPort != 0) {
+        phases.add("TLS", listening, [&]() -> std::expected<void, NetError> {
+#if defined(ENABLE_TLS)
+            TlsAcceptor::Config tls;
+            tls.address = options.address;
+            tls.port = options.tlsPort;
+            tls.certificate = options.tlsCertificate;
+            tls.key = options.tlsKey;
+            tls.workers = options.tlsWorkers;
+            tls.access = &server->m_access;
+            std::vector<NetReactor*> reactors;
+            for (const auto& reactor : server->m_reactors) {
+                reactors.push_back(reactor.get());
+            }
+            auto acceptor = TlsAcceptor::create(tls, std::move(reactors));
+            if (!acceptor) {
+                return std::unexpected(acceptor.error());
+            }
+            server->m_tls = std::move(*acceptor);
+            return {};
+#else
+            // Built without OpenSSL
+            return std::unexpected(NetError::TLS_FAILED);
+#endif
+        });
+    }
+    if (options.shardPort != 0) {
+        phases.add("shard listener", {}, [&]() -> std::expected<void, NetError> {
+            const auto listener = ShardLink::listen(options.address, options.shardPort);
+            if (!listener) {
+                return std::unexpected(listener.error());
+            }
+            server->m_shardListenFd = *listener;
+            return {};
+        });
+    }
+    if (!options.accounts.empty()) {
+        // Replaying the journal into the saves is the slow part
+        phases.add("accounts", {}, [&]() -> std::expected<void, NetError> {
+            if (!server->m_loginResults.open()) {
+                return std::unexpected(NetError::POLLER_FAILED);
+            }
+            server->m_loginPool =
+                std::make_unique<LoginPool>(options.accounts, server->m_loginResults, options.loginThreads);
+            server->m_saves = std::make_unique<SaveWriter>(options.accounts, tuning->saveInterval);
+            server->m_engine->setSaveDirectory(options.accounts);
+            // What scripts kept is saved beside the accounts, and they go on from it
+            ScriptStore& store = server->m_engine->scriptStore();
+            const FileView stored(std::filesystem::path(options.accounts) / ScriptStore::kFileName);
+            if (!stored.bytes().empty() && !store.decode(stored.bytes())) {
+                LOG_WARN("Script store in {} is damaged; scripts start without it", options.accounts);
+            }
+            server->m_savedStore = store.version();
+            // Boards and mail are kept beside the accounts too
+            auto messages = MessageStore::open(std::filesystem::path(options.accounts) / "messages");
+            if (!messages) {
+                LOG_ERROR("Couldn't open the boards and mail: {}", messages.error());
+                return std::unexpected(NetError::DATABASE_FAILED);
+            }
+            server->m_engine->setMessageStore(std::move(*messages));
+            if (options.journal) {
+                server->openJournal(options);
+            }
+            return {};
+        });
+    }
+    if (!options.database.empty()) {
+        phases.add("database", {}, [&]() -> std::expected<void, NetError> {
+            auto database = Storage::open(options.database);
+            if (!database) {
+                LOG_ERROR("Couldn't open the database {}", database.error());
+                return std::unexpected(NetError::DATABASE_FAILED);
+            }
+            // Queued ahead of every login, so it exists before the first insert
+            (*database)->submit(Storage::Kind::Write,
+                                "CREATE TABLE IF NOT EXISTS sessions "
+                                "(name TEXT NOT NULL, event TEXT NOT NULL, at INTEGER NOT NULL)",
+                                {}, {});
+            server->m_engine->setDatabase(std::move(*database));
+            return {};
+        });
+    }
+    if (options.apiPort != 0) {
+        phases.add("api", {}, [&]() -> std::expected<void, NetError> {
+            auto api = ApiServer::start(options.apiAddress, options.apiPort, options.apiOrigin, server->m_status);
+            if (!api) {
+                return std::unexpected(api.error());
+            }
+            server->m_apiServer = std::move(*api);
+            return {};
+        });
+    }
+    if (!options.adminSocket.empty()) {
+        phases.add("admin", {}, [&]() -> std::expected<void, NetError> {
+            if (!server->m_adminEvents.open()) {
+                return std::unexpected(NetError::POLLER_FAILED);
+            }
+            auto admin = AdminServer::start(options.adminSocket, server->m_adminEvents, &server->m_engine->events());
+            if (!admin) {
+                LOG_ERROR("Couldn't open the admin socket {}", options.adminSocket);
+                return std::unexpected(admin.error());
+            }
+            server->m_adminServer = std::move(*admin);
+            return {};
+        });
+    }
+    if (options.metricsPort != 0) {
+        phases.add("metrics", {}, [&]() -> std::expected<void, NetError> {
+            auto metrics = MetricsServer::start(options.address, options.metricsPort);
+            if (!metrics) {
+                return std::unexpected(metrics.error());
+            }
+            server->m_metricsServer = std::move(*metrics);
+            server->m_metricsCollector = Metrics::instance().addCollector(
+                [engine = server->m_engine.get()](std::string& out) {
+                    engine->writeCommandMetrics(out);
+                    engine->writeZoneMetrics(out);
+                    engine->writeBehaviorMetrics(out);
+                });
+            return {};
+        });
+    }
+    const auto started = phases.run();
+    // The destructor stops every reactor, so none of the slots may stay empty
+    std::erase(server->m_reactors, nullptr);
+    if (!started) {
+        return std::unexpected(started.error());
+    }
+
+    server->m_pending.resize(count);
+    server->m_engine->setShard(options.shard);
+    // Async commands' finished work gets the game thread out of poll
+    server->m_engine->setAsyncWake([raw = server.get()] { raw->m_inbox.wake(); });
+    if (options.shardPort != 0) {
+        // The gateway's sessions get m_pending's last slot
+        server->m_gatewayReactor = static_cast<std::uint16_t>(count);
+        server->m_pending.resize(count + 1);
+        server->m_engine->setChannelRelay([raw = server.get()](std::string_view channel, std::string_view message) {
+            if (raw->m_gateway) {
+                raw->m_gateway->send(ShardMessageKind::Channel, 0, 0, channel, {message});
+            }
+        });
+    }
+    server->m_topology = options.topology;
+    if (!options.topology.empty()) {
+        const std::span<const int> workers = options.topology.cores(ThreadRole::Workers);
+        server->m_engine->setWorkerCores(std::vector<int>(workers.begin(), workers.end()));
+    }
+    if (options.zoneActors) {
+        server->m_engine->setExecutionMode(ExecutionMode::ZoneActors);
+    }
+    if (!options.record.empty()) {
+        server->m_recorder = std::make_unique<SessionRecorder>(options.record, server->m_engine->ticks());
+        LOG_INFO("Recording sessions into {}", options.record);
+    }
+    if (!options.checkpoint.empty()) {
+        server->m_checkpoints = std::make_unique<Checkpointer>(options.checkpoint);
+        server->m_lastCheckpoint = std::chrono::steady_clock::now();
+    }
+    server->applyTuning(std::move(*tuning));
+    server->m_lastStats = std::chrono::steady_clock::now();
+    if (adopted) {
+        server->adopt(*adopted);
+    }
+
+    LOG_INFO("Listening for telnet connections on {}:{} with {} reactor(s){}", options.address,
+             options.port, count, server->usingIoUring() ? " on io_uring" : "");
+    if (options.webSocketPort != 0) {
+        LOG_INFO("Listening for WebSocket connections on {}:{}", options.address, options.webSocketPort);
+    }
+    if (options.tlsPort != 0) {
+        LOG_INFO("Listening for TLS connections on {}:{} with {} handshake worker(s)", options.address,
+                 options.tlsPort, options.tlsWorkers);
+    }
+    if (options.apiPort != 0) {
+        LOG_INFO("Serving the world's status on http://{}:{}/api/", options.apiAddress, options.apiPort);
+    }
+    if (options.metricsPort != 0) {
+        LOG_INFO("Serving metrics on http://{}:{}/metrics", options.address, options.metricsPort);
+    }
+    if (options.shardPort != 0) {
+        LOG_INFO("Listening for the gateway on {}:{} as shard {} of {}", options.address, options.shardPort,
+                 options.shard.index, options.shard.count);
+    }
+    options.topology.report(count, server->m_engine->workerCount());
+    return server;
+}
+
+// Put back whatever a crash kept out of the saves, then journal afresh
+void NetServer::openJournal(const Options& options) {
+    const std::filesystem::path directory = std::filesystem::path(options.accounts) / "journal";
+    std::unordered_map<std::string, std::pair<std::uint64_t, std::string>> latest;
+    const auto keep = [&latest](std::string_view key, std::uint64_t sequence, std::string_view image) {
+        // Keys become file names, so only ever a player's
+        if (isValidName(key)) {
+            latest.insert_or_assign(std::string(key), std::pair(sequence, std::string(image)));
+        }
+    };
+
+    // The state segment the last run kept beside the journal, as its name
+    // and the token it reset it with
+    const std::filesystem::path pairing = directory / "state-segment";
+    std::string pairedName;
+    std::uint64_t pairedToken = 0;
+    {
+        const FileView paired(pairing);
+        const std::string_view text = paired.bytes();
+        const std::size_t space = text.find(' ');
+        if (space != std::string_view::npos) {
+            pairedName = text.substr(0, space);
+            const std::string_view token = text.substr(space + 1);
+            std::from_chars(token.data(), token.data() + token.size(), pairedToken, 16);
+        }
+    }
+    std::uint64_t nextSequence = 0;
+    if (!options.stateSegment.empty()) {
+        auto segment = StateSegment::open(options.stateSegment);
+        if (!segment) {
+            LOG_WARN("Couldn't open the state segment {}; journaling without it", segment.error());
+        } else {
+            const std::expected<void, std::string> whole =
+                pairedName == (*segment)->name() ? (*segment)->check(pairedToken)
+                                                 : std::unexpected(std::string("the journal was not kept with it"));
+            if (whole) {
+                (*segment)->each(keep);
+                nextSequence = (*segment)->nextSequence();
+                LOG_INFO("Resuming from state segment {}: {} players", (*segment)->name(), (*segment)->size());
+            } else if (!pairedName.empty()) {
+                LOG_WARN("State segment {} can't be resumed from, as {}; reading the journal back",
+                         (*segment)->name(), whole.error());
+            }
+            m_state = std::move(*segment);
+        }
+    } else if (!pairedName.empty()) {
+        // This run journals without it, so from here on it would only fall behind
+        StateSegment::unlink(pairedName);
+        std::error_code error;
+        std::filesystem::remove(pairing, error);
+    }
+    const Journal::Recovered recovered = nextSequence == 0 ? Journal::recover(directory, keep) : Journal::Recovered{};
+    nextSequence = std::max(nextSequence, recovered.nextSequence);
+
+    std::size_t replayed = 0;
+    for (const auto& [key, record] : latest) {
+        const std::filesystem::path path = m_saves->path(key);
+        const PlayerSave save = PlayerSave::open(path);
+        if ((!save.valid() || save.header().journaled < record.first) && mapped::replaceFile(path, record.second)) {
+            ++replayed;
+        }
+    }
+    if (replayed > 0 && options.journalSync != JournalSync::Never) {
+        ::sync();
+    }
+
+    m_journal = std::make_unique<Journal>(directory, nextSequence, options.journalSync,
+                                          options.journalSyncInterval);
+    // Everything recovered is in the saves now
+    m_journal->release(nextSequence - 1);
+    if (recovered.records > 0) {
+        LOG_INFO("Recovered {} journal records from {} segments ({} torn bytes): {} saves replayed",
+                 recovered.records, recovered.segments, recovered.tornBytes, replayed);
+    } else if (replayed > 0) {
+        LOG_INFO("{} saves replayed from the state segment", replayed);
+    }
+
+    // The segment starts over with this run, under a token of its own. A
+    // crash before the pairing is written leaves the old token there, which
+    // no longer matches, and the saves already hold what the segment did
+    if (m_state) {
+        const std::uint64_t token = (std::uint64_t{std::random_device{}()} << 32) | std::random_device{}();
+        m_state->reset(token, nextSequence);
+        if (!mapped::replaceFile(pairing, std::format("{} {:016x}", m_state->name(), token))) {
+            LOG_WARN("Couldn't write {}; journaling without the state segment", pairing.string());
+            m_state.reset();
+        }
+    }
+}
+
+NetServer::~NetServer() {
+    m_tls.reset();
+    // No scrape reaches into the engine once this returns
+    m_metricsServer.reset();
+    m_apiServer.reset();
+    m_adminServer.reset();
+    if (m_metricsCollector != 0) {
+        Metrics::instance().removeCollector(m_metricsCollector);
+    }
+    for (auto& reactor : m_reactors) {
+        reactor->stop();
+    }
+    // The engine may outlive the server
+    for (const auto& [key, connection] : m_connections) {
+        m_engine->ticks().dropSession(key);
+    }
+    m_engine->ticks().setCommandRunner(nullptr);
+    m_engine->setChannelRelay(nullptr);
+    m_engine->setAsyncWake(nullptr);
+    if (m_shardListenFd >= 0) {
+        ::close(m_shardListenFd);
+    }
+}
+
+void NetServer::requestStop() noexcept {
+    m_stopRequested.store(true);
+    m_inbox.wake();
+}
+
+void NetServer::requestCopyover() noexcept {
+    m_copyoverRequested.store(true);
+    requestStop();
+}
+
+void NetServer::reloadConfig() {
+    if (!m_accessPath.empty()) {
+        auto list = AccessList::load(m_accessPath);
+        if (list) {
+            LOG_INFO("Reloaded access list from {}: {} rules", m_accessPath, list->rules());
+            m_access.publish(std::make_unique<AccessList>(std::move(*list)));
+        } else {
+            LOG_ERROR("Access list {}: {}; the rules are unchanged", m_accessPath, list.error());
+        }
+    }
+    if (m_configPath.empty()) {
+        if (m_accessPath.empty()) {
+            LOG_INFO("No config file to reload; start with --config FILE");
+        }
+        return;
+    }
+    auto tuning = ServerConfig::load(m_configPath, m_tuningBase);
+    if (!tuning) {
+        LOG_ERROR("Config {}: {}; the settings are unchanged", m_configPath, tuning.error());
+        return;
+    }
+    applyTuning(std::move(*tuning));
+    LOG_INFO("Reloaded config from {}", m_configPath);
+}
+
+// The game thread's settings take effect here; the reactors copy theirs in
+// from the published version when they next wake
+void NetServer::applyTuning(ServerConfig tuning) {
+    m_engine->ticks().setRateLimit(tuning.rateLimit);
+    m_saveInterval = tuning.saveInterval;
+    m_checkpointInterval = tuning.checkpointInterval;
+    m_statsInterval = tuning.statsInterval;
+    m_idleBudget = tuning.idleBudget;
+    tuning.generation = m_tuning.load()->generation + 1;
+    m_tuning.publish(std::make_unique<ServerConfig>(std::move(tuning)));
+}
+
+std::size_t NetServer::sessionCount() const noexcept {
+    std::size_t count = 0;
+    for (const auto& reactor : m_reactors) {
+        count += reactor->sessionCount();
+    }
+    return count;
+}
+
+CompressionStats NetServer::compression() const noexcept {
+    CompressionStats total;
+    for (const auto& reactor : m_reactors) {
+        const CompressionStats stats = reactor->compression();
+        total.bytesIn += stats.bytesIn;
+        total.bytesOut += stats.bytesOut;
+    }
+    return total;
+}
+
+void NetServer::run() {
+    if (!m_topology.empty()) {
+        for (std::size_t i = 0; i < m_reactors.size(); ++i) {
+            m_reactors[i]->start(m_topology.core(ThreadRole::Reactors, i));
+        }
+    } else {
+        // Reactor i on core i + 1, leaving the first for this thread, when they fit
+        const unsigned cores = std::thread::hardware_concurrency();
+        for (std::size_t i = 0; i < m_reactors.size(); ++i) {
+            m_reactors[i]->start(m_reactors.size() < cores ? static_cast<int>(i + 1) : -1);
+        }
+    }
+    if (m_tls) {
+        m_tls->start();
+    }
+    // Last, as threads start from here on would begin on the game's cores
+    if (!m_topology.empty()) {
+        ThreadTopology::pinCurrent(m_topology.cores(ThreadRole::Game));
+    }
+
+    // Made here, on the thread it watches
+    std::optional<Watchdog> watchdog;
+    if (m_watchdogThreshold.count() > 0) {
+        watchdog.emplace(Watchdog::Options{m_watchdogThreshold, nullptr});
+    }
+
+    while (!m_stopRequested.load()) {
+        if (watchdog) {
+            watchdog->beat();
+        }
+        // Signals are events like any other: their handlers only wrote to
+        // a pipe, and the callbacks registered for them run here
+        if (SignalHandler::dispatchPending() && m_stopRequested.load()) {
+            break;
+        }
+
+        // Scripted work and the tick the engine has due, which runs the
+        // commands queued before it, then every reactor's input, then
+        // everything they produced, one batch per reactor
+        // Scripted work between ticks gets half its time while they are throttled
+        const LoadStage load = m_engine->ticks().loadStage();
+        auto next = m_engine->idle(load == LoadStage::Throttling ? m_idleBudget / 2 : m_idleBudget);
+        m_inbox.drain([this](NetInputBatch&& batch) {
+            for (NetInput& input : batch) {
+                handleInput(input);
+            }
+        });
+        if (m_loginPool) {
+            m_loginResults.drain([this](LoginResult&& result) { handleLoginResult(result); });
+        }
+        if (m_resolver) {
+            m_resolved.drain([this](ResolvedHost&& resolved) { handleResolved(resolved); });
+        }
+        if (m_adminServer) {
+            m_adminEvents.drain([this](AdminEvent&& event) { handleAdmin(event); });
+        }
+        pollGateway();
+        handOffPlayers();
+        deliverMessages();
+        m_engine->flushEvents();
+        refreshRoomPlayers();
+        publish();
+        journalChangedPlayers();
+        if (m_recorder) {
+            m_recorder->commit();
+        }
+        saveChangedPlayers();
+        checkpoint();
+        logCommandStats();
+        publishMetrics();
+        publishStatus();
+
+        // Sleep until a reactor posts or the engine's next deadline, which
+        // is the coming tick once a line has just been queued, or until
+        // changed players or the world are due to be saved
+        next = std::min(next, m_engine->ticks().nextTick());
+        if (m_saves) {
+            next = std::min(next, m_lastSave + m_saveInterval);
+        }
+        if (m_journal && m_journal->backlogged()) {
+            next = std::chrono::steady_clock::now();
+        }
+        if (m_checkpoints) {
+            next = std::min(next, m_lastCheckpoint + m_checkpointInterval);
+        }
+        if (m_statsInterval.count() > 0) {
+            next = std::min(next, m_lastStats + m_statsInterval);
+        }
+        if (m_apiServer) {
+            next = std::min<std::chrono::steady_clock::time_point>(next, m_lastStatus + kStatusInterval);
+        }
+        int timeoutMs = -1;
+        if (next != std::chrono::steady_clock::time_point::max()) {
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(next - std::chrono::steady_clock::now());
+            timeoutMs = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(wait.count(), 0, 60'000));
+        }
+        // Without accounts the second descriptor is -1, which poll skips, as
+        // is the third without a resolver, the fourth without an admin
+        // socket, the fifth while no signal handler is registered, and the
+        // last two unless this is a shard; the gateway is only accepted while
+        // there is none, and written to while its frames back up
+        const int gateway = m_gateway ? m_gateway->fd() : -1;
+        pollfd ready[7] = {{m_inbox.fd(), POLLIN, 0},
+                           {m_loginResults.fd(), POLLIN, 0},
+                           {m_resolved.fd(), POLLIN, 0},
+                           {m_adminEvents.fd(), POLLIN, 0},
+                           {SignalHandler::fd(), POLLIN, 0},
+                           {m_gateway ? -1 : m_shardListenFd, POLLIN, 0},
+                           {gateway, static_cast<short>(POLLIN | (m_gateway && m_gateway->wantsWrite() ? POLLOUT : 0)), 0}};
+        if (watchdog) {
+            watchdog->rest();
+        }
+        ::poll(ready, 7, timeoutMs);
+    }
+
+    // No handshake finishes into a reactor that has stopped
+    if (m_tls) {
+        m_tls->stop();
+    }
+    parkGatewayPlayers();
+    if (m_copyoverRequested.load()) {
+        handOver();
+    } else {
+        for (auto& reactor : m_reactors) {
+            reactor->stop();
+        }
+    }
+    // Everyone still playing is saved as if they had left
+    if (m_saves) {
+        for (const auto& [key, connection] : m_connections) {
+            savePlayer(connection, false);
+        }
+        saveScriptStore();
+        m_saves->flush();
+        if (m_journal && m_saves->completed() == m_saves->stats().submitted) {
+            m_journal->release(m_journal->sequence());
+        }
+    }
+    if (m_checkpoints) {
+        m_checkpoints->submit(m_engine->snapshot());
+        m_checkpoints->flush();
+    }
+}
+
+// Let the reactors write out and give up every connection, and gather what
+// the next process needs to carry each one on. The saves and checkpoint at
+// the end of run() follow, so the state on disk is as current as after a
+// shutdown should the new process never start
+void NetServer::handOver() {
+    for (const auto& [key, connection] : m_connections) {
+        // The gateway tells its own what is happening
+        if (!connection.closing && !viaGateway(connection)) {
+            send(connection.id, kCopyoverStarting);
+        }
+    }
+    publish();
+
+    const auto deadline = std::chrono::steady_clock::now() + kHandoverTimeout;
+    CopyoverState state;
+    std::unordered_map<std::uint64_t, HandedSession> handed;
+    for (auto& reactor : m_reactors) {
+        ReactorHandover handover = reactor->handOver(deadline);
+        state.listeners.push_back(handover.listenFds);
+        for (HandedSession& session : handover.sessions) {
+            handed.emplace(session.connection.key(), std::move(session));
+        }
+    }
+    // What the reactors read on their way out: lines join the queues carried
+    // over, and whoever went is logged out as usual
+    m_inbox.drain([this](NetInputBatch&& batch) {
+        for (NetInput& input : batch) {
+            handleInput(input);
+        }
+    });
+
+    for (auto& [key, connection] : m_connections) {
+        const auto found = handed.find(key);
+        if (found == handed.end() || connection.closing) {
+            continue;
+        }
+        CopyoverSession& session = state.sessions.emplace_back();
+        session.reactor = connection.id.reactor;
+        session.fd = connection.id.fd;
+        session.compressed = found->second.compressed;
+        session.width = found->second.width;
+        session.input = std::move(found->second.line);
+        session.queued = m_engine->ticks().takeQueued(key);
+        session.outOfBand = connection.oob ? connection.oob->subscriptions() : 0;
+        if (connection.player != kInvalidPlayerId) {
+            session.name = connection.name;
+            Player snapshot = m_engine->getPlayer(connection.player);
+            if (m_journal) {
+                snapshot.journaled = m_journal->sequence();
+            }
+            session.player = PlayerSave::encode(snapshot, TickClock::wallSeconds());
+        } else {
+            // Anyone part way through logging in starts again from the name
+            session.echoOff = connection.stage == LoginStage::Password;
+        }
+    }
+    LOG_INFO("Handing {} connections over to the next process", state.sessions.size());
+    m_handover = std::move(state);
+}
+
+// Serve the connections the process before handed over as if they had never left
+void NetServer::adopt(CopyoverState& state) {
+    std::size_t playing = 0;
+    for (CopyoverSession& session : state.sessions) {
+        // Spread over the reactors there are, should there be fewer than before
+        NetReactor& reactor = *m_reactors[session.reactor % m_reactors.size()];
+        const ConnectionId id = reactor.adopt(session.fd, std::move(session.input), session.compressed, session.width);
+        if (id.fd < 0) {
+            continue;
+        }
+        Connection& connection = m_connections.insert_or_assign(id.key(), Connection{id}).first->second;
+        if (m_resolver) {
+            if (const std::optional<IpAddress> peer = IpAddress::ofPeer(id.fd)) {
+                connection.address = peer->toString();
+                resolveHost(connection);
+            }
+        }
+        if (session.outOfBand != 0) {
+            connection.oob = makeOutOfBand();
+            connection.oob->restoreSubscriptions(session.outOfBand);
+            ++m_outOfBandCount;
+        }
+        if (session.name.empty() || !m_names.emplace(lowercase(session.name)).second) {
+            if (session.echoOff) {
+                sendRaw(id, kEchoOn);
+            }
+            send(id, kCopyoverDone);
+            send(id, kNamePrompt);
+        } else {
+            connection.name = std::move(session.name);
+            PlayerSave save = PlayerSave::decode(std::move(session.player));
+            if (!save.valid() && m_saves) {
+                save = PlayerSave::open(m_saves->path(lowercase(connection.name)));
+            }
+            addPlayer(connection, save);
+            send(id, kCopyoverDone);
+            send(id, "> ");
+            ++playing;
+        }
+        for (std::string& line : session.queued) {
+            m_engine->ticks().enqueue(id.key(), std::move(line));
+        }
+    }
+    LOG_INFO("Took over {} connections, {} of them playing, from the process before", m_connections.size(), playing);
+}
+
+void NetServer::handleInput(NetInput& input) {
+    const std::uint64_t key = input.connection.key();
+    switch (input.kind) {
+        case NetInput::Kind::Opened: {
+            Connection& connection = m_connections.insert_or_assign(key, Connection{input.connection}).first->second;
+            connection.address = std::move(input.line);
+            resolveHost(connection);
+            // The message of the day as mapped, shared by everyone who connects while it stands
+            TextFiles* const texts = m_engine->texts();
+            if (const auto motd = texts ? texts->get("motd") : nullptr) {
+                sendLine(input.connection, motd->whole);
+            } else {
+                send(input.connection, "Welcome to EchoMUD!\n");
+            }
+            send(input.connection, kNamePrompt);
+            break;
+        }
+        case NetInput::Kind::Line: {
+            const auto found = m_connections.find(key);
+            if (found == m_connections.end() || found->second.closing) {
+                break;
+            }
+            switch (m_engine->ticks().enqueue(key, std::move(input.line))) {
+                case EnqueueResult::Queued:
+                    break;
+                case EnqueueResult::QueueFull:
+                    send(input.connection, kQueueFull);
+                    break;
+                case EnqueueResult::Throttled:
+                    send(input.connection, kThrottled);
+                    break;
+            }
+            break;
+        }
+        case NetInput::Kind::Closed: {
+            m_engine->ticks().dropSession(key);
+            const auto found = m_connections.find(key);
+            if (found != m_connections.end()) {
+                logout(found->second);
+                if (found->second.oob) {
+                    --m_outOfBandCount;
+                }
+                m_connections.erase(found);
+            }
+            break;
+        }
+        case NetInput::Kind::OptionOn:
+        case NetInput::Kind::OptionOff:
+        case NetInput::Kind::Subnegotiation: {
+            const auto found = m_connections.find(key);
+            if (found != m_connections.end() && !found->second.closing) {
+                handleOption(found->second, input);
+            }
+            break;
+        }
+        case NetInput::Kind::WindowSize: {
+            const auto found = m_connections.find(key);
+            if (found != m_connections.end()) {
+                found->second.rows = input.rows;
+                if (found->second.player != kInvalidPlayerId) {
+                    m_engine->setPageLines(found->second.player, pageLines(input.rows));
+                }
+            }
+            break;
+        }
+    }
+}
+
+// A fresh GMCP and MSDP state, one a closed connection left if there is one
+ObjectPool<OutOfBand>::Handle NetServer::makeOutOfBand() {
+    ObjectPool<OutOfBand>::Handle oob = m_outOfBandPool.take();
+    if (oob) {
+        oob->recycle();
+        return oob;
+    }
+    return m_outOfBandPool.adopt(std::make_unique<OutOfBand>());
+}
+
+void NetServer::handleOption(Connection& connection, const NetInput& input) {
+    if (!connection.oob) {
+        if (input.kind != NetInput::Kind::OptionOn) {
+            return;
+        }
+        connection.oob = makeOutOfBand();
+        ++m_outOfBandCount;
+        // Its room's player list is only kept while someone is watching
+        markRoom(connection.room);
+    }
+    switch (input.kind) {
+        case NetInput::Kind::OptionOn:
+            connection.oob->setEnabled(input.option, true);
+            break;
+        case NetInput::Kind::OptionOff:
+            connection.oob->setEnabled(input.option, false);
+            break;
+        default:
+            m_raw.clear();
+            connection.oob->receive(input.option, input.line, m_raw);
+            connection.oob->flush(m_raw);
+            sendRaw(connection.id, m_raw);
+            break;
+    }
+    updateOutOfBand(connection);
+}
+
+void NetServer::runLine(std::uint64_t key, std::string& line) {
+    const auto found = m_connections.find(key);
+    if (found != m_connections.end() && !found->second.closing) {
+        handleLine(found->second, line);
+    }
+}
+
+void NetServer::handleLine(Connection& connection, std::string& line) {
+    if (connection.player == kInvalidPlayerId) {
+        login(connection, line);
+        return;
+    }
+
+    // Enter alone turns a paged reply's page; anything else ends it
+    const CommandTokens tokens(line);
+    if (tokens.empty()) {
+        if (m_engine->paging(connection.player)) {
+            CommandResult page = m_engine->nextPage(connection.player);
+            sendReply(connection, page.message);
+        }
+        send(connection.id, "> ");
+        return;
+    }
+    m_engine->stopPaging(connection.player);
+    if (m_engine->shouldQuit(tokens.verb(), tokens.args())) {
+        // The reactor reports the close later; until then the connection is ignored
+        send(connection.id, "Goodbye.\n", true);
+        logout(connection);
+        connection.closing = true;
+        m_engine->ticks().dropSession(connection.id.key());
+        return;
+    }
+    if (m_recorder) {
+        m_recorder->command(connection.name, line);
+    }
+
+    // Zone actors run the tick's commands together once they are all in
+    if (m_engine->executionMode() == ExecutionMode::ZoneActors) {
+        m_batch.push_back({connection.player, std::move(line)});
+        m_batchKeys.push_back(connection.id.key());
+        return;
+    }
+
+    // A line of several commands comes back as one reply, sent in one go
+    CommandResult result = m_engine->handleCommandLine(connection.player, line);
+    m_engine->ticks().delaySession(connection.id.key(), result.lag);
+    sendReply(connection, result.message);
+
+    // Anything the command sent this player goes before the prompt
+    deliverMessages();
+    updateOutOfBand(connection);
+    send(connection.id, "> ");
+}
+
+void NetServer::runBatch() {
+    if (m_batch.empty()) {
+        return;
+    }
+    m_engine->runCommands(m_batch);
+    for (std::size_t i = 0; i < m_batch.size(); ++i) {
+        const auto found = m_connections.find(m_batchKeys[i]);
+        if (found == m_connections.end() || found->second.closing) {
+            continue;
+        }
+        Connection& connection = found->second;
+        m_engine->ticks().delaySession(m_batchKeys[i], m_batch[i].result.lag);
+        sendReply(connection, m_batch[i].result.message);
+        deliverMessages();
+        updateOutOfBand(connection);
+        send(connection.id, "> ");
+    }
+    m_batch.clear();
+    m_batchKeys.clear();
+}
+
+void NetServer::login(Connection& connection, std::string& line) {
+    switch (connection.stage) {
+        case LoginStage::Name:
+            break;
+        case LoginStage::Password:
+            checkPassword(connection, std::move(line));
+            return;
+        case LoginStage::Waiting:
+        case LoginStage::Checking:
+            send(connection.id, "Still checking your password; a moment more.\n");
+            return;
+        case LoginStage::Playing:
+            return;
+    }
+
+    const CommandTokens tokens(line);
+    const std::string_view name = tokens.verb();
+    if (!isValidName(name)) {
+        send(connection.id, "Names are 2 to 16 letters.\n");
+        send(connection.id, kNamePrompt);
+        return;
+    }
+    // The tokens lowercased the verb; players see it capitalized. The name
+    // stays reserved while its password is checked
+    if (!m_names.emplace(name).second) {
+        send(connection.id, "That name is taken.\n");
+        send(connection.id, kNamePrompt);
+        return;
+    }
+    connection.name.assign(name);
+    connection.name[0] = static_cast<char>(connection.name[0] - 'a' + 'A');
+
+    if (!m_loginPool) {
+        enterGame(connection);
+        return;
+    }
+    connection.stage = LoginStage::Password;
+    sendRaw(connection.id, kEchoOff);
+    send(connection.id, kPasswordPrompt);
+}
+
+void NetServer::checkPassword(Connection& connection, std::string password) {
+    // The client echoed neither the password nor the line break after it
+    sendRaw(connection.id, kEchoOn);
+    send(connection.id, "\n");
+    if (password.empty()) {
+        sendRaw(connection.id, kEchoOff);
+        send(connection.id, kPasswordPrompt);
+        return;
+    }
+
+    // Nobody jumps the line, even when the pool has room for one more
+    if (m_admission.empty() && !m_loginPool->full()) {
+        connection.stage = LoginStage::Checking;
+        m_loginPool->submit(connection.id.key(), lowercase(connection.name), std::move(password));
+        return;
+    }
+    connection.stage = LoginStage::Waiting;
+    connection.password = std::move(password);
+    m_admission.push_back(connection.id.key());
+    ++m_admissionWaiting;
+    send(connection.id, std::format("Many players are logging in; you are number {} in line.\n", m_admissionWaiting));
+}
+
+void NetServer::handleLoginResult(LoginResult& result) {
+    m_loginPool->finished(result);
+    admitLogins();
+
+    // A connection that went while its password was checked has given its name back
+    const auto found = m_connections.find(result.session);
+    if (found == m_connections.end() || found->second.stage != LoginStage::Checking) {
+        return;
+    }
+    Connection& connection = found->second;
+    switch (result.outcome) {
+        case LoginResult::Outcome::Accepted:
+            enterGame(connection);
+            break;
+        case LoginResult::Outcome::Created:
+            send(connection.id, "A new character is born.\n");
+            enterGame(connection);
+            break;
+        case LoginResult::Outcome::WrongPassword:
+            if (++connection.attempts < kMaxPasswordAttempts) {
+                connection.stage = LoginStage::Password;
+                send(connection.id, "Wrong password.\n");
+                sendRaw(connection.id, kEchoOff);
+                send(connection.id, kPasswordPrompt);
+                break;
+            }
+            [[fallthrough]];
+        case LoginResult::Outcome::Failed:
+            // The reactor reports the close later; until then the connection is ignored
+            send(connection.id,
+                 result.outcome == LoginResult::Outcome::Failed ? "Your account could not be read; try again later.\n"
+                                                                : "Wrong password. Goodbye.\n",
+                 true);
+            releaseName(connection);
+            connection.stage = LoginStage::Name;
+            connection.closing = true;
+            m_engine->ticks().dropSession(connection.id.key());
+            break;
+    }
+}
+
+void NetServer::admitLogins() {
+    while (!m_admission.empty() && !m_loginPool->full()) {
+        const std::uint64_t key = m_admission.front();
+        m_admission.pop_front();
+        // Connections that left the line stay in it until they reach the front
+        const auto found = m_connections.find(key);
+        if (found == m_connections.end() || found->second.stage != LoginStage::Waiting) {
+            continue;
+        }
+        Connection& connection = found->second;
+        --m_admissionWaiting;
+        connection.stage = LoginStage::Checking;
+        m_loginPool->submit(key, lowercase(connection.name), std::exchange(connection.password, {}));
+    }
+    announceLoginQueue();
+}
+
+void NetServer::announceLoginQueue() {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_admissionWaiting == 0 || now - m_lastAnnounce < kAnnounceInterval) {
+        return;
+    }
+    m_lastAnnounce = now;
+    std::size_t place = 0;
+    for (std::uint64_t key : m_admission) {
+        const auto found = m_connections.find(key);
+        if (found != m_connections.end() && found->second.stage == LoginStage::Waiting) {
+            send(found->second.id, std::format("You are number {} in line.\n", ++place));
+        }
+    }
+}
+
+void NetServer::enterGame(Connection& connection) {
+    PlayerSave save;
+    if (m_saves) {
+        // A save from leaving moments ago may still be on its way to disk;
+        // a new character has none and starts afresh
+        const std::string key = lowercase(connection.name);
+        m_saves->settle(key);
+        save = PlayerSave::open(m_saves->path(key));
+    }
+    addPlayer(connection, save);
+    const PlayerId player = connection.player;
+
+    m_engine->broadcastToRoom(m_engine->players().room(player),
+                              m_engine->formatScratch("{} has arrived.", connection.name), player);
+    const CommandResult look = m_engine->handleCommand(player, "look", {});
+    send(connection.id, std::format("Welcome, {}.\n\n", connection.name));
+    send(connection.id, look.message);
+    send(connection.id, "\n> ");
+}
+
+// The named connection's character, as save left it if it is valid
+void NetServer::addPlayer(Connection& connection, const PlayerSave& save) {
+    const PlayerId player = m_engine->addPlayer(connection.name);
+    if (player >= m_playerConnections.size()) {
+        m_playerConnections.resize(static_cast<std::size_t>(player) + 1);
+    }
+    m_playerConnections[player] = connection.id;
+    connection.player = player;
+    connection.stage = LoginStage::Playing;
+    m_engine->restorePlayer(player, save);
+    m_engine->setPageLines(player, pageLines(connection.rows));
+    if (!m_admins.empty()) {
+        m_engine->setAdmin(player, std::ranges::find(m_admins, lowercase(connection.name)) != m_admins.end());
+    }
+    if (m_recorder) {
+        m_recorder->join(connection.name, PlayerSave::encode(m_engine->getPlayer(player), 0));
+    }
+    logSession(connection.name, "login");
+    if (m_resolver) {
+        // Shown as its address until the name comes, if one does
+        const std::string& from = connection.host.empty() ? connection.address : connection.host;
+        m_engine->setPlayerHost(player, from);
+        LOG_INFO("{} logged in from {}", connection.name, from);
+    }
+    updateOutOfBand(connection);
+}
+
+// Look up the name of the connection's address, if there is a resolver;
+// a name already cached is known at once, and any other is posted once found
+void NetServer::resolveHost(Connection& connection) {
+    if (!m_resolver || connection.address.empty()) {
+        return;
+    }
+    if (std::optional<std::string> host = m_resolver->submit(connection.id.key(), connection.address)) {
+        nameHost(connection, std::move(*host));
+    }
+}
+
+// A lookup the resolver finished, for a connection that may have gone since
+void NetServer::handleResolved(ResolvedHost& resolved) {
+    const auto found = m_connections.find(resolved.session);
+    if (found == m_connections.end() || found->second.address != resolved.address) {
+        return;
+    }
+    nameHost(found->second, std::move(resolved.host));
+}
+
+void NetServer::nameHost(Connection& connection, std::string host) {
+    if (host.empty()) {
+        return;
+    }
+    connection.host = std::move(host);
+    if (connection.player != kInvalidPlayerId) {
+        m_engine->setPlayerHost(connection.player, connection.host);
+        LOG_INFO("{} is connected from {} ({})", connection.name, connection.host, connection.address);
+    }
+}
+
+// An operator over the admin socket plays as an admin under the name they
+// gave, and their commands run as they come, not with a tick's batch
+void NetServer::handleAdmin(AdminEvent& event) {
+    const auto reply = [this, session = event.session](std::string text) {
+        m_adminServer->send(session, makeSharedMessage(std::move(text)));
+    };
+    const auto found = m_operators.find(event.session);
+    switch (event.kind) {
+        case AdminEvent::Kind::Attached: {
+            if (!isValidName(event.text) || !m_names.emplace(lowercase(event.text)).second) {
+                reply("That name is taken, or is not 2 to 16 letters.");
+                m_adminServer->close(event.session);
+                return;
+            }
+            std::string name = lowercase(event.text);
+            name[0] = static_cast<char>(name[0] - 'a' + 'A');
+            const PlayerId player = m_engine->addPlayer(name);
+            m_engine->setAdmin(player, true);
+            if (player >= m_playerConnections.size()) {
+                m_playerConnections.resize(static_cast<std::size_t>(player) + 1);
+            }
+            m_playerConnections[player] = ConnectionId{};
+            if (player >= m_operatorSessions.size()) {
+                m_operatorSessions.resize(static_cast<std::size_t>(player) + 1);
+            }
+            m_operatorSessions[player] = event.session;
+            m_operators.emplace(event.session, player);
+            LOG_INFO("{} attached to the admin socket", name);
+            reply(std::format("Welcome, {}. You are attached as an operator.", name));
+            reply(m_engine->handleCommand(player, "look", {}).message);
+            return;
+        }
+        case AdminEvent::Kind::Line: {
+            if (found == m_operators.end()) {
+                return;
+            }
+            const CommandTokens tokens(event.text);
+            if (tokens.empty()) {
+                return;
+            }
+            if (m_engine->shouldQuit(tokens.verb(), tokens.args())) {
+                reply("Detaching.");
+                m_adminServer->close(event.session);
+                return;
+            }
+            CommandResult result = m_engine->handleCommandLine(found->second, event.text);
+            if (!result.message.empty()) {
+                reply(std::move(result.message));
+            }
+            return;
+        }
+        case AdminEvent::Kind::Detached: {
+            if (found == m_operators.end()) {
+                return;
+            }
+            const PlayerId player = found->second;
+            m_operators.erase(found);
+            m_operatorSessions[player] = 0;
+            const std::string name(m_engine->players().name(player));
+            m_names.erase(lowercase(name));
+            m_engine->removePlayer(player);
+            LOG_INFO("{} detached from the admin socket", name);
+            return;
+        }
+    }
+}
+
+void NetServer::releaseName(const Connection& connection) {
+    m_names.erase(lowercase(connection.name));
+}
+
+void NetServer::logSession(std::string_view name, std::string_view event) {
+    Storage* database = m_engine->database();
+    if (!database) {
+        return;
+    }
+    // Nothing waits on it; the I/O thread commits a login storm's rows together
+    database->submit(Storage::Kind::Write, "INSERT INTO sessions (name, event, at) VALUES (?, ?, ?)",
+                     {std::string(name), std::string(event), static_cast<std::int64_t>(TickClock::wallSeconds())},
+                     [](StorageResult result) {
+                         if (!result) {
+                             LOG_WARN("Couldn't log a session: {}", result.error());
+                         }
+                     });
+}
+
+void NetServer::savePlayer(const Connection& connection, bool leaving) {
+    if (!m_saves || connection.player == kInvalidPlayerId) {
+        return;
+    }
+    if (m_journal && leaving) {
+        // Whatever they did since the last pass, in case the save never lands
+        journalPlayer(connection);
+        m_journal->commit();
+    }
+    Player snapshot = m_engine->getPlayer(connection.player);
+    if (m_journal) {
+        // Every change so far is journaled by now, this player's included
+        snapshot.journaled = m_journal->sequence();
+    }
+    m_saves->submit(lowercase(connection.name), std::move(snapshot), leaving);
+}
+
+void NetServer::journalPlayer(const Connection& connection) {
+    Player snapshot = m_engine->getPlayer(connection.player);
+    snapshot.journaled = m_journal->nextSequence();
+    const std::string key = lowercase(connection.name);
+    const std::string image = PlayerSave::encode(snapshot, TickClock::wallSeconds());
+    const std::uint64_t sequence = m_journal->append(key, image);
+    if (m_state && !m_state->put(key, sequence, image)) {
+        // Marked so the next start reads the journal back instead
+        LOG_WARN("State segment {} is full; the journal alone keeps players from here", m_state->name());
+        m_state.reset();
+    }
+}
+
+// Every pass, the players changed since the last, as one group commit; the
+// journal's writer does the rest on its own thread
+void NetServer::journalChangedPlayers() {
+    if (!m_journal) {
+        return;
+    }
+    m_engine->takeDirtyPlayers(m_journaling);
+    for (PlayerId player : m_journaling) {
+        if (player >= m_playerConnections.size()) {
+            continue;
+        }
+        const auto found = m_connections.find(m_playerConnections[player].key());
+        if (found != m_connections.end() && found->second.player == player) {
+            journalPlayer(found->second);
+        }
+    }
+    // Players busy every pass would otherwise pile up between saves
+    m_changed.insert(m_changed.end(), m_journaling.begin(), m_journaling.end());
+    if (m_changed.size() > 2 * std::max<std::size_t>(m_playerConnections.size(), 64)) {
+        std::sort(m_changed.begin(), m_changed.end());
+        m_changed.erase(std::unique(m_changed.begin(), m_changed.end()), m_changed.end());
+    }
+    // A backlog keeps the loop turning until it is in the ring
+    if (!m_journaling.empty() || m_journal->backlogged()) {
+        m_journal->commit();
+    }
+}
+
+// Snapshots of the players changed since last time, at most once an
+// interval; the writer does the rest on its own thread
+void NetServer::saveChangedPlayers() {
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_saves || now - m_lastSave < m_saveInterval) {
+        return;
+    }
+    m_lastSave = now;
+    saveScriptStore();
+    if (m_journal) {
+        // Gathered pass by pass as they were journaled, some more than once
+        std::sort(m_changed.begin(), m_changed.end());
+        m_changed.erase(std::unique(m_changed.begin(), m_changed.end()), m_changed.end());
+    } else {
+        m_engine->takeDirtyPlayers(m_changed);
+    }
+    for (PlayerId player : m_changed) {
+        // The engine's own local player has no connection and no save
+        if (player >= m_playerConnections.size()) {
+            continue;
+        }
+        const auto found = m_connections.find(m_playerConnections[player].key());
+        if (found != m_connections.end() && found->second.player == player) {
+            savePlayer(found->second, false);
+        }
+    }
+    if (m_journal) {
+        m_changed.clear();
+        // Records go once the saves taking them over are written
+        m_releases.emplace_back(m_journal->sequence(), m_saves->stats().submitted);
+        const std::uint64_t completed = m_saves->completed();
+        std::uint64_t through = 0;
+        while (!m_releases.empty() && m_releases.front().second <= completed) {
+            through = m_releases.front().first;
+            m_releases.pop_front();
+        }
+        if (through > 0) {
+            m_journal->release(through);
+        }
+    }
+}
+
+// The whole store, when a script has changed it since it was last submitted;
+// scripts change it on their own threads, so whatever they change while it
+// is encoded bumps the version again and goes with the next save
+void NetServer::saveScriptStore() {
+    const ScriptStore& store = m_engine->scriptStore();
+    const std::uint64_t version = store.version();
+    if (version == m_savedStore) {
+        return;
+    }
+    m_savedStore = version;
+    m_saves->submitFile(std::string(ScriptStore::kFileName), store.encode());
+}
+
+// Between ticks, so the snapshot is of one consistent moment
+void NetServer::checkpoint() {
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_checkpoints || now - m_lastCheckpoint < m_checkpointInterval) {
+        return;
+    }
+    m_lastCheckpoint = now;
+    m_checkpoints->submit(m_engine->snapshot());
+}
+
+// What the stats command shows, into the log every so often, so a slow
+// verb shows up without anyone asking
+void NetServer::logCommandStats() {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_statsInterval.count() == 0 || now - m_lastStats < m_statsInterval) {
+        return;
+    }
+    m_lastStats = now;
+    LOG_INFO("Command stats:\n{}", m_engine->commandStatsReport());
+}
+
+void NetServer::publishMetrics() {
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_metricsServer || now - m_lastMetrics < kMetricsInterval) {
+        return;
+    }
+    m_lastMetrics = now;
+    m_engine->publishMetrics(Metrics::local());
+}
+
+// Refill the buffer ApiServer is not reading and swap it in; should the
+// thread still be reading the one before, this waits a pass
+void NetServer::publishStatus() {
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_apiServer || now - m_lastStatus < kStatusInterval) {
+        return;
+    }
+    WorldStatus* const status = m_status.back();
+    if (!status) {
+        return;
+    }
+    m_engine->status(*status);
+    status->serial = ++m_statusSerial;
+    m_status.swap();
+    m_lastStatus = now;
+}
+
+void NetServer::logout(Connection& connection) {
+    if (connection.player == kInvalidPlayerId) {
+        // Named but not yet playing: the name goes back, and a place in line with it
+        if (connection.stage == LoginStage::Waiting) {
+            --m_admissionWaiting;
+        }
+        if (connection.stage != LoginStage::Name) {
+            releaseName(connection);
+        }
+        connection.stage = LoginStage::Name;
+        connection.password.clear();
+        return;
+    }
+    savePlayer(connection, true);
+    const PlayerId player = std::exchange(connection.player, kInvalidPlayerId);
+    m_engine->broadcastToRoom(m_engine->players().room(player),
+                              m_engine->formatScratch("{} has left.", connection.name), player);
+    releaseName(connection);
+    m_playerConnections[player] = ConnectionId{};
+    if (m_recorder) {
+        m_recorder->leave(connection.name, m_saves != nullptr);
+    }
+    logSession(connection.name, "logout");
+    // A saved player takes their belongings along
+    m_engine->removePlayer(player, m_saves != nullptr);
+    markRoom(std::exchange(connection.room, kInvalidRoomId));
+    deliverMessages();
+}
+
+// Bring a connection's variables up to date and send what changed
+void NetServer::updateOutOfBand(Connection& connection) {
+    const RoomId room = connection.player != kInvalidPlayerId ? m_engine->players().room(connection.player)
+                                                              : kInvalidRoomId;
+    if (room != connection.room) {
+        markRoom(std::exchange(connection.room, room));
+        markRoom(room);
+    }
+    OutOfBand* oob = connection.oob.get();
+    if (!oob || !oob->enabled() || connection.player == kInvalidPlayerId) {
+        return;
+    }
+
+    const RoomGraph& world = m_engine->world();
+    oob->set(OutOfBand::Variable::CharacterName, {std::string(m_engine->players().name(connection.player)), {}, {}});
+    oob->set(OutOfBand::Variable::RoomVnum, {std::to_string(room), {}, {}});
+    oob->set(OutOfBand::Variable::RoomName, {std::string(world.name(room)), {}, {}});
+    OutOfBand::Value exits;
+    const auto& targets = world.exits(room);
+    for (std::size_t i = 0; i < kDirectionCount; ++i) {
+        if (targets[i] != kInvalidRoomId) {
+            exits.fields.emplace_back(directionName(static_cast<Direction>(i)).substr(0, 1), std::to_string(targets[i]));
+        }
+    }
+    oob->set(OutOfBand::Variable::RoomExits, std::move(exits));
+
+    m_raw.clear();
+    oob->flush(m_raw);
+    sendRaw(connection.id, m_raw);
+}
+
+void NetServer::markRoom(RoomId room) {
+    if (m_outOfBandCount > 0 && room != kInvalidRoomId) {
+        m_changedRooms.push_back(room);
+    }
+}
+
+// Tell every GMCP or MSDP client in a room someone entered or left who is there
+// now; while the ticks shed work the rooms stay marked and are sent once after
+void NetServer::refreshRoomPlayers() {
+    if (m_changedRooms.empty()) {
+        return;
+    }
+    std::sort(m_changedRooms.begin(), m_changedRooms.end());
+    m_changedRooms.erase(std::unique(m_changedRooms.begin(), m_changedRooms.end()), m_changedRooms.end());
+    if (m_engine->ticks().loadStage() != LoadStage::Normal) {
+        return;
+    }
+
+    const PlayerRegistry& players = m_engine->players();
+    OutOfBand::Value present;
+    for (RoomId room : m_changedRooms) {
+        present.items.clear();
+        players.forEachInRoom(room, [&](PlayerId player) { present.items.emplace_back(players.name(player)); });
+        players.forEachInRoom(room, [&](PlayerId player) {
+            if (player >= m_playerConnections.size()) {
+                return;
+            }
+            const ConnectionId id = m_playerConnections[player];
+            const auto found = m_connections.find(id.key());
+            if (found == m_connections.end() || !found->second.oob || !found->second.oob->enabled()) {
+                return;
+            }
+            found->second.oob->set(OutOfBand::Variable::RoomPlayers, present);
+            m_raw.clear();
+            found->second.oob->flush(m_raw);
+            sendRaw(id, m_raw);
+        });
+    }
+    m_changedRooms.clear();
+}
+
+
+void NetServer::send(const ConnectionId& id, std::string_view text, bool close) {
+    NetOutputBatch& batch = m_pending[id.reactor];
+    // Consecutive text for one connection shares an entry, until a line follows it
+    if (!batch.empty() && batch.back().connection.fd == id.fd && batch.back().connection.serial == id.serial &&
+        !batch.back().line && !batch.back().close) {
+        batch.back().text.append(text);
+        batch.back().close = close;
+        return;
+    }
+    batch.push_back({id, std::string(), std::string(text), nullptr, close});
+}
+
+// A command's reply as a line; a watched player's is shared with their
+// watchers, not copied
+void NetServer::sendReply(const Connection& connection, std::string& reply) {
+    if (m_engine->watched(connection.player)) {
+        const SharedMessage shared = makeSharedMessage(std::move(reply));
+        m_engine->tee(connection.player, shared);
+        sendLine(connection.id, shared);
+        return;
+    }
+    send(connection.id, reply);
+    send(connection.id, "\n");
+}
+
+void NetServer::sendLine(const ConnectionId& id, const SharedMessage& line) {
+    NetOutputBatch& batch = m_pending[id.reactor];
+    if (!batch.empty() && batch.back().connection.fd == id.fd && batch.back().connection.serial == id.serial &&
+        !batch.back().line && !batch.back().close) {
+        batch.back().line = line;
+        return;
+    }
+    batch.push_back({id, std::string(), std::string(), line, false});
+}
+
+void NetServer::sendRaw(const ConnectionId& id, std::string_view bytes) {
+    if (bytes.empty()) {
+        return;
+    }
+    NetOutputBatch& batch = m_pending[id.reactor];
+    // Protocol bytes go ahead of an entry's text, so only an entry with none yet can take them
+    if (!batch.empty() && batch.back().connection.fd == id.fd && batch.back().connection.serial == id.serial &&
+        batch.back().text.empty() && !batch.back().line && !batch.back().close) {
+        batch.back().raw.append(bytes);
+        return;
+    }
+    batch.push_back({id, std::string(bytes), std::string(), nullptr, false});
+}
+
+void NetServer::deliverMessages() {
+    m_engine->takeRecipients(m_recipients);
+    for (PlayerId player : m_recipients) {
+        const ConnectionId id = player < m_playerConnections.size() ? m_playerConnections[player] : ConnectionId{};
+        m_engine->takeMessages(player, m_messages);
+        if (id.fd < 0) {
+            // An operator's, for the admin socket
+            if (player < m_operatorSessions.size() && m_operatorSessions[player] != 0) {
+                for (const SharedMessage& message : m_messages) {
+                    m_adminServer->send(m_operatorSessions[player], message);
+                }
+            }
+            continue;
+        }
+        for (const SharedMessage& message : m_messages) {
+            sendLine(id, message);
+        }
+    }
+    m_messages.clear();
+}
+
+void NetServer::publish() {
+    for (std::size_t i = 0; i < m_reactors.size(); ++i) {
+        if (!m_pending[i].empty()) {
+            // The next batch is likely as large; growing into it would move every entry again
+            const std::size_t size = m_pending[i].size();
+            m_reactors[i]->inbox().push(std::move(m_pending[i]));
+            m_pending[i] = NetOutputBatch();
+            m_pending[i].reserve(size);
+        }
+    }
+    publishGateway();
+}
+
+// The gateway's sessions' output, as frames; GMCP and MSDP stay behind,
+// since only the reactor that negotiated them could encode them
+void NetServer::publishGateway() {
+    if (!m_gateway) {
+        return;
+    }
+    writeGatewayOutput();
+    if (!m_gateway->flush()) {
+        dropGateway();
+    }
+}
+
+// Into the link's batch, each entry one message copied straight from its
+// text and shared line
+void NetServer::writeGatewayOutput() {
+    NetOutputBatch& batch = m_pending[m_gatewayReactor];
+    for (const NetOutput& output : batch) {
+        const std::uint64_t session = output.connection.serial;
+        if (output.line) {
+            m_gateway->send(ShardMessageKind::Output, 0, session, {}, {output.text, *output.line, "\n"});
+        } else if (!output.text.empty()) {
+            m_gateway->send(ShardMessageKind::Output, 0, session, {}, {output.text});
+        }
+        if (output.close) {
+            m_gateway->send(ShardMessageKind::Close, 0, session, {});
+        }
+    }
+    batch.clear();
+}
+
+// Take the gateway's link if it is calling, and whatever it sent
+void NetServer::pollGateway() {
+    if (m_shardListenFd < 0) {
+        return;
+    }
+    if (!m_gateway) {
+        const int fd = ::accept(m_shardListenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        m_gateway = std::make_unique<ShardLink>(fd);
+        LOG_INFO("The gateway linked up");
+    }
+    const bool open = m_gateway->receive(m_shardMessages);
+    for (const ShardMessage& message : m_shardMessages) {
+        handleMessage(message);
+    }
+    if (!open) {
+        LOG_WARN("Lost the gateway; its players are logged out");
+        dropGateway();
+    }
+}
+
+void NetServer::handleMessage(const ShardMessage& message) {
+    NetInput input{NetInput::Kind::Opened, ConnectionId{message.session(), m_gateway->fd(), m_gatewayReactor}, {}};
+    switch (message.kind()) {
+        case ShardMessageKind::Opened:
+            handleInput(input);
+            break;
+        case ShardMessageKind::Line:
+            input.kind = NetInput::Kind::Line;
+            input.line.assign(message.body());
+            handleInput(input);
+            break;
+        case ShardMessageKind::Closed:
+            input.kind = NetInput::Kind::Closed;
+            handleInput(input);
+            break;
+        case ShardMessageKind::Attach:
+            attach(message);
+            break;
+        case ShardMessageKind::Channel:
+            // Said on another shard; the relay only passes on what is said here
+            if (const auto channel = m_engine->channels().find(message.name())) {
+                m_engine->sendToChannel(*channel, message.body());
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// A player another shard handed over, carried on from its save image as a
+// copyover would
+void NetServer::attach(const ShardMessage& message) {
+    const ConnectionId id{message.session(), m_gateway->fd(), m_gatewayReactor};
+    Connection& connection = m_connections.insert_or_assign(id.key(), Connection{id}).first->second;
+    if (!isValidName(message.name()) || !m_names.emplace(lowercase(message.name())).second) {
+        send(id, "Someone of that name is already here; log in again.\n", true);
+        connection.closing = true;
+        return;
+    }
+    connection.name.assign(message.name());
+    addPlayer(connection, PlayerSave::decode(std::string(message.body())));
+    const CommandResult look = m_engine->handleCommand(connection.player, "look", {});
+    send(id, look.message);
+    send(id, "\n> ");
+}
+
+// Players the engine turned back at another shard's border: gateway
+// sessions go over to it, with what they have sent so far, and anyone
+// connected here directly stays put
+void NetServer::handOffPlayers() {
+    m_engine->takeHandoffs(m_handoffs);
+    for (const ShardHandoff& handoff : m_handoffs) {
+        if (handoff.player >= m_playerConnections.size()) {
+            continue;
+        }
+        const auto found = m_connections.find(m_playerConnections[handoff.player].key());
+        if (found == m_connections.end() || found->second.player != handoff.player) {
+            continue;
+        }
+        Connection& connection = found->second;
+        if (!viaGateway(connection)) {
+            send(connection.id, kNoGateway);
+            continue;
+        }
+        // Everything this shard still has for them goes ahead of the handoff
+        deliverMessages();
+
+        Player snapshot = m_engine->getPlayer(connection.player);
+        snapshot.currentRoom = std::string(m_engine->world().name(handoff.room));
+        if (m_journal) {
+            snapshot.journaled = m_journal->sequence();
+        }
+        const std::uint16_t shard = m_engine->shard().shardOf(m_engine->world().zone(handoff.room));
+        const std::uint64_t session = connection.id.serial;
+        const std::string name = connection.name;
+        const std::string image = PlayerSave::encode(snapshot, TickClock::wallSeconds());
+        if (m_saves) {
+            m_saves->submit(lowercase(connection.name), std::move(snapshot), true);
+        }
+        // The lines it queued here are lost; the gateway sends the next
+        // ones to the new shard
+        m_engine->ticks().dropSession(found->first);
+        const PlayerId player = std::exchange(connection.player, kInvalidPlayerId);
+        releaseName(connection);
+        m_playerConnections[player] = ConnectionId{};
+        if (m_recorder) {
+            m_recorder->leave(connection.name, true);
+        }
+        // Their belongings travel in the image
+        m_engine->removePlayer(player, true);
+        markRoom(connection.room);
+        m_connections.erase(found);
+        writeGatewayOutput();
+        m_gateway->send(ShardMessageKind::Handoff, shard, session, name, {image});
+    }
+}
+
+// On the way down, each of the gateway's players goes back to it as a save
+// image, for the gateway to attach them from once this shard serves again;
+// they are saved with everyone else after this, as at any shutdown
+void NetServer::parkGatewayPlayers() {
+    if (!m_gateway) {
+        return;
+    }
+    writeGatewayOutput();
+    std::size_t parked = 0;
+    for (const auto& [key, connection] : m_connections) {
+        if (!viaGateway(connection) || connection.player == kInvalidPlayerId || connection.closing) {
+            continue;
+        }
+        Player snapshot = m_engine->getPlayer(connection.player);
+        if (m_journal) {
+            snapshot.journaled = m_journal->sequence();
+        }
+        m_gateway->send(ShardMessageKind::Park, m_engine->shard().index, connection.id.serial, connection.name,
+                        {PlayerSave::encode(snapshot, TickClock::wallSeconds())});
+        ++parked;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + kHandoverTimeout;
+    while (m_gateway->flush() && m_gateway->wantsWrite() && std::chrono::steady_clock::now() < deadline) {
+        pollfd writable{m_gateway->fd(), POLLOUT, 0};
+        ::poll(&writable, 1, 10);
+    }
+    LOG_INFO("Parked {} players with the gateway", parked);
+}
+
+// Everyone who came through the gateway leaves as if their connection closed
+void NetServer::dropGateway() {
+    std::vector<ConnectionId> sessions;
+    for (const auto& [key, connection] : m_connections) {
+        if (connection.id.reactor == m_gatewayReactor) {
+            sessions.push_back(connection.id);
+        }
+    }
+    m_gateway.reset();
+    m_pending[m_gatewayReactor].clear();
+    for (const ConnectionId& id : sessions) {
+        NetInput input{NetInput::Kind::Closed, id, {}};
+        handleInput(input);
+    }
+    m_pending[m_gatewayReactor].clear();
+}
@@ -0,0 +1,386 @@
+#include "../include/OutOfBand.h"
+#include "../include/JsonText.h"
+#include <algorithm>
+
+namespace {
+
+constexpr unsigned char kIac = 255;
+constexpr unsigned char kSb = 250;
+constexpr unsigned char kSe = 240;
+
+// MSDP markers
+constexpr unsigned char kMsdpVar = 1;
+constexpr unsigned char kMsdpVal = 2;
+constexpr unsigned char kMsdpTableOpen = 3;
+constexpr unsigned char kMsdpTableClose = 4;
+constexpr unsigned char kMsdpArrayOpen = 5;
+constexpr unsigned char kMsdpArrayClose = 6;
+
+enum class Shape : std::uint8_t { Text, Number, Table, List };
+
+struct VariableInfo {
+    std::string_view msdpName;
+    Shape shape;
+    std::uint8_t message;   // OutOfBand::Message carrying it over GMCP
+};
+
+// Indexed by OutOfBand::Variable
+constexpr std::array<VariableInfo, OutOfBand::kVariableCount> kVariables = {{
+    {"CHARACTER_NAME", Shape::Text, 0},
+    {"ROOM_VNUM", Shape::Number, 1},
+    {"ROOM_NAME", Shape::Text, 1},
+    {"ROOM_EXITS", Shape::Table, 1},
+    {"ROOM_PLAYERS", Shape::List, 2},
+}};
+
+constexpr std::array<std::string_view, 5> kMsdpCommands = {"LIST", "REPORT", "RESET", "SEND", "UNREPORT"};
+constexpr std::array<std::string_view, 5> kMsdpLists = {"COMMANDS", "LISTS", "REPORTABLE_VARIABLES",
+                                                        "REPORTED_VARIABLES", "SENDABLE_VARIABLES"};
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](char x, char y) { return (x | 0x20) == (y | 0x20); });
+}
+
+// Payload bytes inside IAC SB ... IAC SE, with IAC doubled
+void appendEscaped(std::string& out, std::string_view bytes) {
+    for (const char ch : bytes) {
+        out.push_back(ch);
+        if (static_cast<unsigned char>(ch) == kIac) {
+            out.push_back(ch);
+        }
+    }
+}
+
+void beginSubnegotiation(std::string& out, unsigned char option) {
+    out.push_back(static_cast<char>(kIac));
+    out.push_back(static_cast<char>(kSb));
+    out.push_back(static_cast<char>(option));
+}
+
+void endSubnegotiation(std::string& out) {
+    out.push_back(static_cast<char>(kIac));
+    out.push_back(static_cast<char>(kSe));
+}
+
+// An MSDP name/list reply: VAR name VAL ARRAY_OPEN (VAL item)... ARRAY_CLOSE
+template <typename Names>
+void appendMsdpArray(std::string& out, std::string_view name, const Names& names) {
+    beginSubnegotiation(out, OutOfBand::kMsdp);
+    out.push_back(static_cast<char>(kMsdpVar));
+    appendEscaped(out, name);
+    out.push_back(static_cast<char>(kMsdpVal));
+    out.push_back(static_cast<char>(kMsdpArrayOpen));
+    for (const auto& item : names) {
+        out.push_back(static_cast<char>(kMsdpVal));
+        appendEscaped(out, item);
+    }
+    out.push_back(static_cast<char>(kMsdpArrayClose));
+    endSubnegotiation(out);
+}
+
+std::size_t findVariable(std::string_view name) {
+    for (std::size_t i = 0; i < kVariables.size(); ++i) {
+        if (equalsIgnoreCase(kVariables[i].msdpName, name)) {
+            return i;
+        }
+    }
+    return kVariables.size();
+}
+
+} // namespace
+
+void OutOfBand::setEnabled(unsigned char option, bool enabled) {
+    if (option == kMsdp) {
+        m_msdp = enabled;
+        m_reported.reset();
+    } else if (option == kGmcp) {
+        m_gmcp = enabled;
+        m_supported.reset();
+        m_due.reset();
+    }
+}
+
+std::uint32_t OutOfBand::subscriptions() const noexcept {
+    return static_cast<std::uint32_t>(m_msdp) | static_cast<std::uint32_t>(m_gmcp) << 1 |
+           static_cast<std::uint32_t>(m_reported.to_ulong()) << 8 | static_cast<std::uint32_t>(m_supported.to_ulong()) << 16;
+}
+
+void OutOfBand::restoreSubscriptions(std::uint32_t bits) {
+    m_msdp = (bits & 1) != 0;
+    m_gmcp = (bits & 2) != 0;
+    m_reported = decltype(m_reported)((bits >> 8) & 0xFF);
+    m_supported = decltype(m_supported)((bits >> 16) & 0xFF);
+    m_due = m_supported;
+    m_known.reset();
+    m_changed.reset();
+}
+
+void OutOfBand::recycle() {
+    for (Value& value : m_values) {
+        value.text.clear();
+        value.fields.clear();
+        value.items.clear();
+    }
+    m_known.reset();
+    m_changed.reset();
+    m_reported.reset();
+    m_supported.reset();
+    m_due.reset();
+    m_msdp = false;
+    m_gmcp = false;
+}
+
+void OutOfBand::receive(unsigned char option, std::string_view payload, std::string& out) {
+    if (option == kMsdp && m_msdp) {
+        receiveMsdp(payload, out);
+    } else if (option == kGmcp && m_gmcp) {
+        receiveGmcp(payload, out);
+    }
+}
+
+void OutOfBand::set(Variable variable, Value value) {
+    const auto index = static_cast<std::size_t>(variable);
+    if (m_known[index] && m_values[index] == value) {
+        return;
+    }
+    m_values[index] = std::move(value);
+    m_known.set(index);
+    m_changed.set(index);
+}
+
+void OutOfBand::flush(std::string& out) {
+    if (m_msdp) {
+        for (std::size_t i = 0; i < kVariableCount; ++i) {
+            if (m_changed[i] && m_reported[i]) {
+                writeMsdp(static_cast<Variable>(i), out);
+            }
+        }
+    }
+    if (m_gmcp) {
+        std::bitset<kMessageCount> messages = m_due;
+        for (std::size_t i = 0; i < kVariableCount; ++i) {
+            if (m_changed[i]) {
+                messages.set(kVariables[i].message);
+            }
+        }
+        messages &= m_supported;
+        for (std::size_t i = 0; i < kMessageCount; ++i) {
+            if (messages[i]) {
+                writeGmcp(static_cast<Message>(i), out);
+            }
+        }
+        m_due.reset();
+    }
+    m_changed.reset();
+}
+
+// VAR command (VAL argument)...; several commands may share a subnegotiation
+void OutOfBand::receiveMsdp(std::string_view payload, std::string& out) {
+    std::string_view command;
+    std::vector<std::string_view> arguments;
+    std::size_t at = 0;
+    while (at < payload.size()) {
+        const auto marker = static_cast<unsigned char>(payload[at++]);
+        if (marker != kMsdpVar && marker != kMsdpVal) {
+            continue;   // Array and table brackets; arguments are taken flat
+        }
+        std::size_t end = at;
+        while (end < payload.size() && static_cast<unsigned char>(payload[end]) > kMsdpArrayClose) {
+            ++end;
+        }
+        const std::string_view token = payload.substr(at, end - at);
+        at = end;
+        if (marker == kMsdpVar) {
+            runMsdp(command, arguments, out);
+            command = token;
+            arguments.clear();
+        } else {
+            arguments.push_back(token);
+        }
+    }
+    runMsdp(command, arguments, out);
+}
+
+void OutOfBand::runMsdp(std::string_view command, const std::vector<std::string_view>& arguments, std::string& out) {
+    if (equalsIgnoreCase(command, "LIST")) {
+        for (const std::string_view list : arguments) {
+            if (equalsIgnoreCase(list, "COMMANDS")) {
+                appendMsdpArray(out, "COMMANDS", kMsdpCommands);
+            } else if (equalsIgnoreCase(list, "LISTS")) {
+                appendMsdpArray(out, "LISTS", kMsdpLists);
+            } else if (equalsIgnoreCase(list, "REPORTABLE_VARIABLES") || equalsIgnoreCase(list, "SENDABLE_VARIABLES")) {
+                std::vector<std::string_view> names;
+                for (const VariableInfo& info : kVariables) {
+                    names.push_back(info.msdpName);
+                }
+                appendMsdpArray(out, equalsIgnoreCase(list, "REPORTABLE_VARIABLES") ? "REPORTABLE_VARIABLES"
+                                                                                      : "SENDABLE_VARIABLES", names);
+            } else if (equalsIgnoreCase(list, "REPORTED_VARIABLES")) {
+                std::vector<std::string_view> names;
+                for (std::size_t i = 0; i < kVariableCount; ++i) {
+                    if (m_reported[i]) {
+                        names.push_back(kVariables[i].msdpName);
+                    }
+                }
+                appendMsdpArray(out, "REPORTED_VARIABLES", names);
+            }
+        }
+    } else if (equalsIgnoreCase(command, "REPORT") || equalsIgnoreCase(command, "SEND")) {
+        // Either way the current value goes now; a reported one follows each change
+        const bool report = equalsIgnoreCase(command, "REPORT");
+        for (const std::string_view name : arguments) {
+            const std::size_t index = findVariable(name);
+            if (index == kVariableCount) {
+                continue;
+            }
+            if (report) {
+                m_reported.set(index);
+            }
+            if (m_known[index]) {
+                writeMsdp(static_cast<Variable>(index), out);
+            }
+        }
+    } else if (equalsIgnoreCase(command, "UNREPORT")) {
+        for (const std::string_view name : arguments) {
+            if (const std::size_t index = findVariable(name); index != kVariableCount) {
+                m_reported.reset(index);
+            }
+        }
+    } else if (equalsIgnoreCase(command, "RESET")) {
+        m_reported.reset();
+    }
+}
+
+// Package.Message JSON; only Core.Supports is acted on
+void OutOfBand::receiveGmcp(std::string_view payload, std::string& /*out*/) {
+    const std::size_t space = payload.find(' ');
+    const std::string_view package = payload.substr(0, space);
+    const std::string_view data = space == std::string_view::npos ? std::string_view() : payload.substr(space + 1);
+    const bool set = equalsIgnoreCase(package, "Core.Supports.Set");
+    const bool add = equalsIgnoreCase(package, "Core.Supports.Add");
+    if (!set && !add && !equalsIgnoreCase(package, "Core.Supports.Remove")) {
+        return;
+    }
+    if (set) {
+        m_supported.reset();
+    }
+
+    // ["Char 1", "Room 1", ...]: each string names a module and its version
+    std::bitset<kMessageCount> named;
+    for (std::size_t open = data.find('"'); open != std::string_view::npos; open = data.find('"', open + 1)) {
+        const std::size_t close = data.find('"', open + 1);
+        if (close == std::string_view::npos) {
+            break;
+        }
+        std::string_view module = data.substr(open + 1, close - open - 1);
+        module = module.substr(0, module.find(' '));
+        if (equalsIgnoreCase(module, "Char")) {
+            named.set(static_cast<std::size_t>(Message::CharName));
+        } else if (equalsIgnoreCase(module, "Room")) {
+            named.set(static_cast<std::size_t>(Message::RoomInfo));
+            named.set(static_cast<std::size_t>(Message::RoomPlayers));
+        }
+        open = close;
+    }
+    if (set || add) {
+        // Newly supported messages are sent in full at the next flush
+        m_due |= named & ~m_supported;
+        m_supported |= named;
+    } else {
+        m_supported &= ~named;
+        m_due &= ~named;
+    }
+}
+
+void OutOfBand::writeMsdp(Variable variable, std::string& out) const {
+    const auto index = static_cast<std::size_t>(variable);
+    const VariableInfo& info = kVariables[index];
+    const Value& value = m_values[index];
+    beginSubnegotiation(out, kMsdp);
+    out.push_back(static_cast<char>(kMsdpVar));
+    appendEscaped(out, info.msdpName);
+    out.push_back(static_cast<char>(kMsdpVal));
+    switch (info.shape) {
+        case Shape::Text:
+        case Shape::Number:
+            appendEscaped(out, value.text);
+            break;
+        case Shape::Table:
+            out.push_back(static_cast<char>(kMsdpTableOpen));
+            for (const auto& [name, field] : value.fields) {
+                out.push_back(static_cast<char>(kMsdpVar));
+                appendEscaped(out, name);
+                out.push_back(static_cast<char>(kMsdpVal));
+                appendEscaped(out, field);
+            }
+            out.push_back(static_cast<char>(kMsdpTableClose));
+            break;
+        case Shape::List:
+            out.push_back(static_cast<char>(kMsdpArrayOpen));
+            for (const std::string& item : value.items) {
+                out.push_back(static_cast<char>(kMsdpVal));
+                appendEscaped(out, item);
+            }
+            out.push_back(static_cast<char>(kMsdpArrayClose));
+            break;
+    }
+    endSubnegotiation(out);
+}
+
+void OutOfBand::writeGmcp(Message message, std::string& out) const {
+    const auto value = [this](Variable variable) -> const Value& { return m_values[static_cast<std::size_t>(variable)]; };
+    const auto known = [this](Variable variable) { return m_known[static_cast<std::size_t>(variable)]; };
+
+    std::string payload;
+    switch (message) {
+        case Message::CharName:
+            if (!known(Variable::CharacterName)) {
+                return;
+            }
+            payload = "Char.Name {\"name\":";
+            appendJsonString(payload, value(Variable::CharacterName).text);
+            payload.push_back('}');
+            break;
+        case Message::RoomInfo:
+            if (!known(Variable::RoomVnum)) {
+                return;
+            }
+            // Room numbers are digits, so they go in unquoted
+            payload = "Room.Info {\"num\":";
+            payload.append(value(Variable::RoomVnum).text);
+            payload.append(",\"name\":");
+            appendJsonString(payload, value(Variable::RoomName).text);
+            payload.append(",\"exits\":{");
+            for (const auto& [direction, room] : value(Variable::RoomExits).fields) {
+                if (payload.back() != '{') {
+                    payload.push_back(',');
+                }
+                appendJsonString(payload, direction);
+                payload.push_back(':');
+                payload.append(room);
+            }
+            payload.append("}}");
+            break;
+        case Message::RoomPlayers:
+            if (!known(Variable::RoomPlayers)) {
+                return;
+            }
+            payload = "Room.Players [";
+            for (const std::string& name : value(Variable::RoomPlayers).items) {
+                if (payload.back() != '[') {
+                    payload.push_back(',');
+                }
+                payload.append("{\"name\":");
+                appendJsonString(payload, name);
+                payload.push_back('}');
+            }
+            payload.push_back(']');
+            break;
+        case Message::Count:
+            return;
+    }
+    beginSubnegotiation(out, kGmcp);
+    appendEscaped(out, payload);
+    endSubnegotiation(out);
+}
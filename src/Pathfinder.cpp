@@ -0,0 +1,234 @@
+#include "../include/Pathfinder.h"
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint16_t kNoHops = std::numeric_limits<std::uint16_t>::max();
+
+} // namespace
+
+std::optional<std::span<const Direction>> Pathfinder::path(const RoomGraph& world, RoomId from, RoomId to) {
+    ++m_stats.queries;
+    refresh(world);
+    if (!world.contains(from) || !world.contains(to)) {
+        return std::nullopt;
+    }
+    if (from == to) {
+        return std::span<const Direction>{};
+    }
+
+    CacheEntry& entry = cacheSlot(from, to);
+    if (entry.from == from && entry.to == to) {
+        ++m_stats.cacheHits;
+        return entry.reachable ? std::optional(std::span<const Direction>(entry.path)) : std::nullopt;
+    }
+
+    // The search writes straight into the entry, reusing its capacity
+    entry.from = from;
+    entry.to = to;
+    entry.path.clear();
+    if (m_zoneTableWanted && zoneHops(world, world.zone(from), world.zone(to)) == kUnreachable) {
+        ++m_stats.zonePrunes;
+        entry.reachable = false;
+    } else {
+        entry.reachable = search(world, from, to, entry.path);
+    }
+    return entry.reachable ? std::optional(std::span<const Direction>(entry.path)) : std::nullopt;
+}
+
+std::uint32_t Pathfinder::distance(const RoomGraph& world, RoomId from, RoomId to) {
+    const auto found = path(world, from, to);
+    return found ? static_cast<std::uint32_t>(found->size()) : kUnreachable;
+}
+
+std::uint32_t Pathfinder::zoneHops(const RoomGraph& world, ZoneId from, ZoneId to) {
+    refresh(world);
+    if (!m_zoneTableWanted) {
+        return 0;
+    }
+    if (!m_zoneTableBuilt) {
+        buildZoneTable(world);
+    }
+    if (from >= m_zoneCount || to >= m_zoneCount) {
+        return kUnreachable;
+    }
+    const std::uint16_t hops = m_zoneHops[static_cast<std::size_t>(from) * m_zoneCount + to];
+    return hops == kNoHops ? kUnreachable : hops;
+}
+
+void Pathfinder::refresh(const RoomGraph& world) {
+    if (m_world == &world && m_version == world.version()) {
+        return;
+    }
+    if (m_world) {
+        ++m_stats.rebuilds;
+    }
+    m_world = &world;
+    m_version = world.version();
+
+    // Count the exits into each room, then place them
+    const std::size_t rooms = world.size();
+    m_reverseStart.assign(rooms + 1, 0);
+    for (RoomId room = 0; room < rooms; ++room) {
+        for (RoomId to : world.exits(room)) {
+            if (to != kInvalidRoomId) {
+                ++m_reverseStart[to + 1];
+            }
+        }
+    }
+    for (std::size_t room = 0; room < rooms; ++room) {
+        m_reverseStart[room + 1] += m_reverseStart[room];
+    }
+    m_reverse.resize(m_reverseStart[rooms]);
+    std::vector<std::uint32_t> fill(m_reverseStart.begin(), m_reverseStart.end() - 1);
+    for (RoomId room = 0; room < rooms; ++room) {
+        const RoomGraph::ExitArray& exits = world.exits(room);
+        for (std::size_t i = 0; i < kDirectionCount; ++i) {
+            if (exits[i] != kInvalidRoomId) {
+                m_reverse[fill[exits[i]]++] = {room, static_cast<Direction>(i)};
+            }
+        }
+    }
+
+    m_forward.assign(rooms, {});
+    m_backward.assign(rooms, {});
+    m_forwardQueue.clear();
+    m_backwardQueue.clear();
+    m_forwardQueue.reserve(rooms);
+    m_backwardQueue.reserve(rooms);
+    m_stamp = 0;
+
+    for (CacheEntry& entry : m_cache) {
+        entry.from = kInvalidRoomId;
+        entry.to = kInvalidRoomId;
+    }
+    m_zoneTableBuilt = false;
+}
+
+void Pathfinder::buildZoneTable(const RoomGraph& world) {
+    // Zones joined by at least one exit, without repeats
+    m_zoneCount = world.zoneCount();
+    std::vector<std::pair<ZoneId, ZoneId>> borders;
+    for (RoomId room = 0; room < world.size(); ++room) {
+        for (RoomId to : world.exits(room)) {
+            if (to != kInvalidRoomId && world.zone(to) != world.zone(room)) {
+                borders.emplace_back(world.zone(room), world.zone(to));
+            }
+        }
+    }
+    std::sort(borders.begin(), borders.end());
+    borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+    std::vector<std::uint32_t> start(m_zoneCount + 1, 0);
+    for (const auto& border : borders) {
+        ++start[border.first + 1];
+    }
+    for (std::size_t zone = 0; zone < m_zoneCount; ++zone) {
+        start[zone + 1] += start[zone];
+    }
+
+    // One breadth-first search of the zone graph from every zone
+    m_zoneHops.assign(m_zoneCount * m_zoneCount, kNoHops);
+    std::vector<ZoneId> queue;
+    queue.reserve(m_zoneCount);
+    for (std::size_t source = 0; source < m_zoneCount; ++source) {
+        std::uint16_t* hops = m_zoneHops.data() + source * m_zoneCount;
+        hops[source] = 0;
+        queue.assign(1, static_cast<ZoneId>(source));
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const ZoneId zone = queue[head];
+            for (std::uint32_t i = start[zone]; i < start[zone + 1]; ++i) {
+                const ZoneId next = borders[i].second;
+                if (hops[next] == kNoHops) {
+                    hops[next] = static_cast<std::uint16_t>(hops[zone] + 1);
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+    m_zoneTableBuilt = true;
+}
+
+bool Pathfinder::search(const RoomGraph& world, RoomId from, RoomId to, std::vector<Direction>& out) {
+    ++m_stats.searches;
+    // A fresh stamp marks every room unseen at once; after four billion
+    // queries the stamps are cleared for real
+    if (++m_stamp == 0) {
+        std::fill(m_forward.begin(), m_forward.end(), Visit{});
+        std::fill(m_backward.begin(), m_backward.end(), Visit{});
+        m_stamp = 1;
+    }
+    const std::uint32_t stamp = m_stamp;
+    m_forwardQueue.clear();
+    m_backwardQueue.clear();
+    m_forward[from] = {stamp, 0, kInvalidRoomId, Direction::Count};
+    m_backward[to] = {stamp, 0, kInvalidRoomId, Direction::Count};
+    m_forwardQueue.push_back(from);
+    m_backwardQueue.push_back(to);
+
+    // Until the frontiers touch, no room is on both sides, so the first room
+    // one side reaches that the other has seen closes a shortest path
+    std::size_t forwardHead = 0;
+    std::size_t backwardHead = 0;
+    std::uint32_t forwardDepth = 0;
+    std::uint32_t backwardDepth = 0;
+    RoomId meet = kInvalidRoomId;
+    while (meet == kInvalidRoomId && forwardHead < m_forwardQueue.size() && backwardHead < m_backwardQueue.size()) {
+        if (m_forwardQueue.size() - forwardHead <= m_backwardQueue.size() - backwardHead) {
+            const std::size_t levelEnd = m_forwardQueue.size();
+            for (; forwardHead < levelEnd && meet == kInvalidRoomId; ++forwardHead) {
+                const RoomId room = m_forwardQueue[forwardHead];
+                const RoomGraph::ExitArray& exits = world.exits(room);
+                for (std::size_t i = 0; i < kDirectionCount; ++i) {
+                    const RoomId next = exits[i];
+                    if (next == kInvalidRoomId || m_forward[next].stamp == stamp) {
+                        continue;
+                    }
+                    m_forward[next] = {stamp, forwardDepth + 1, room, static_cast<Direction>(i)};
+                    m_forwardQueue.push_back(next);
+                    if (m_backward[next].stamp == stamp) {
+                        meet = next;
+                        break;
+                    }
+                }
+            }
+            ++forwardDepth;
+        } else {
+            const std::size_t levelEnd = m_backwardQueue.size();
+            for (; backwardHead < levelEnd && meet == kInvalidRoomId; ++backwardHead) {
+                const RoomId room = m_backwardQueue[backwardHead];
+                for (std::uint32_t i = m_reverseStart[room]; i < m_reverseStart[room + 1]; ++i) {
+                    const RoomId prev = m_reverse[i].from;
+                    if (m_backward[prev].stamp == stamp) {
+                        continue;
+                    }
+                    m_backward[prev] = {stamp, backwardDepth + 1, room, m_reverse[i].dir};
+                    m_backwardQueue.push_back(prev);
+                    if (m_forward[prev].stamp == stamp) {
+                        meet = prev;
+                        break;
+                    }
+                }
+            }
+            ++backwardDepth;
+        }
+    }
+    m_stats.roomsVisited += m_forwardQueue.size() + m_backwardQueue.size();
+    if (meet == kInvalidRoomId) {
+        return false;
+    }
+
+    // The start's half is recorded goal-first, so it is reversed in place
+    for (RoomId room = meet; room != from; room = m_forward[room].via) {
+        out.push_back(m_forward[room].dir);
+    }
+    std::reverse(out.begin(), out.end());
+    for (RoomId room = meet; room != to; room = m_backward[room].via) {
+        out.push_back(m_backward[room].dir);
+    }
+    return true;
+}
+
+Pathfinder::CacheEntry& Pathfinder::cacheSlot(RoomId from, RoomId to) noexcept {
+    const std::uint32_t hash = (from * 0x9E3779B1u) ^ (to * 0x85EBCA77u);
+    return m_cache[(hash ^ (hash >> 16)) & (kCacheSize - 1)];
+}
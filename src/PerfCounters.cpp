@@ -0,0 +1,111 @@
+#include "../include/PerfCounters.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+std::atomic<bool> PerfCounters::s_enabled{false};
+
+namespace {
+
+#if defined(__linux__)
+constexpr std::array<std::uint64_t, kPerfEventCount> kEventConfigs{
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+// One thread's events, opened as a group so they are counted over exactly
+// the same stretches; closed when the thread exits
+class CounterGroup {
+public:
+    CounterGroup() {
+        for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = kEventConfigs[i];
+            attr.disabled = i == 0 ? 1 : 0;   // The group starts as one
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            const int leader = i == 0 ? -1 : m_fds[0];
+            m_fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC));
+            if (m_fds[i] < 0) {
+                m_error = errno;
+                close();
+                return;
+            }
+        }
+        ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~CounterGroup() { close(); }
+
+    CounterGroup(const CounterGroup&) = delete;
+    CounterGroup& operator=(const CounterGroup&) = delete;
+
+    bool open() const noexcept { return m_fds[0] >= 0; }
+    int error() const noexcept { return m_error; }
+
+    bool read(PerfSample& sample) const noexcept {
+        // PERF_FORMAT_GROUP: the number of events, then each one's value
+        std::array<std::uint64_t, kPerfEventCount + 1> buffer{};
+        if (!open() || ::read(m_fds[0], buffer.data(), sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+            return false;
+        }
+        std::copy(buffer.begin() + 1, buffer.end(), sample.values.begin());
+        return true;
+    }
+
+private:
+    void close() noexcept {
+        // Members first, then the leader
+        for (std::size_t i = kPerfEventCount; i-- > 0;) {
+            if (m_fds[i] >= 0) {
+                ::close(m_fds[i]);
+                m_fds[i] = -1;
+            }
+        }
+    }
+
+    std::array<int, kPerfEventCount> m_fds{-1, -1, -1, -1};
+    int m_error = 0;
+};
+
+CounterGroup& threadGroup() {
+    thread_local CounterGroup group;
+    return group;
+}
+#endif
+
+}  // namespace
+
+bool PerfCounters::enable() {
+#if defined(__linux__)
+    const CounterGroup& group = threadGroup();
+    if (!group.open()) {
+        LOG_WARN("Hardware counters are not available: {} (is kernel.perf_event_paranoid above 2, or is there no PMU?)",
+                 std::strerror(group.error()));
+        return false;
+    }
+    s_enabled.store(true, std::memory_order_relaxed);
+    return true;
+#else
+    LOG_WARN("Hardware counters are only read on Linux");
+    return false;
+#endif
+}
+
+bool PerfCounters::read(PerfSample& sample) noexcept {
+#if defined(__linux__)
+    return threadGroup().read(sample);
+#else
+    static_cast<void>(sample);
+    return false;
+#endif
+}
@@ -0,0 +1,98 @@
+#include "../include/PlayerSave.h"
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'E', 'M', 'S', 'A', 'V', 'E', '1', '\n'};
+
+} // namespace
+
+PlayerSave PlayerSave::open(const std::filesystem::path& path) {
+    return check(FileView(path));
+}
+
+PlayerSave PlayerSave::decode(std::string image) {
+    return check(FileView(std::move(image)));
+}
+
+PlayerSave PlayerSave::check(FileView file) {
+    PlayerSave save;
+    save.m_file = std::move(file);
+    const std::string_view bytes = save.m_file.bytes();
+
+    // Mappings are page-aligned and copies aligned as new aligns; anything
+    // less could not be read as the structs
+    if (bytes.size() < sizeof(PlayerSaveHeader)
+        || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(PlayerSaveHeader) != 0) {
+        return {};
+    }
+    const auto* header = reinterpret_cast<const PlayerSaveHeader*>(bytes.data());
+    if (header->magic != kMagic || header->version != kVersion || header->headerSize < sizeof(PlayerSaveHeader)
+        || header->headerSize > bytes.size() || header->fileSize != bytes.size()
+        || header->checksum != mapped::fnv1a(bytes.substr(header->headerSize))) {
+        return {};
+    }
+
+    const char* strings = mapped::section<char>(bytes, header->strings);
+    const SavedPlayer* player = mapped::section<SavedPlayer>(bytes, header->player);
+    const SavedItem* items = mapped::section<SavedItem>(bytes, header->items);
+    if (!strings || !player || !items || header->player.count != 1) {
+        return {};
+    }
+    const std::size_t tableSize = header->strings.count;
+    if (!mapped::inTable(player->name, tableSize) || !mapped::inTable(player->room, tableSize)) {
+        return {};
+    }
+    for (std::uint32_t i = 0; i < header->items.count; ++i) {
+        if (!mapped::inTable(items[i].prototype, tableSize)) {
+            return {};
+        }
+    }
+
+    save.m_header = header;
+    save.m_player = player;
+    save.m_items = {items, header->items.count};
+    save.m_strings = {strings, tableSize};
+    return save;
+}
+
+bool PlayerSave::write(const std::filesystem::path& path, const Player& snapshot, std::uint64_t savedAt) {
+    const std::string contents = encode(snapshot, savedAt);
+    return !contents.empty() && mapped::replaceFile(path, contents);
+}
+
+std::string PlayerSave::encode(const Player& snapshot, std::uint64_t savedAt) {
+    std::string table;
+    SavedPlayer player;
+    player.name = mapped::addString(table, snapshot.name);
+    player.room = mapped::addString(table, snapshot.currentRoom);
+    player.health = snapshot.health;
+    player.maxHealth = snapshot.maxHealth;
+    player.regen = snapshot.regen;
+    std::vector<SavedItem> items;
+    items.reserve(snapshot.inventory.size());
+    for (const Player::Belonging& belonging : snapshot.inventory) {
+        items.push_back({mapped::addString(table, belonging.prototype), belonging.decayTicks});
+    }
+
+    PlayerSaveHeader header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.headerSize = sizeof(PlayerSaveHeader);
+    header.savedAt = savedAt;
+    header.journaled = snapshot.journaled;
+    std::string contents(sizeof(PlayerSaveHeader), '\0');
+    header.player = mapped::append(contents, std::span<const SavedPlayer>(&player, 1));
+    header.items = mapped::append(contents, std::span<const SavedItem>(items));
+    header.strings = mapped::append(contents, std::span<const char>(table));
+    if (contents.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return {};
+    }
+    header.fileSize = contents.size();
+    header.checksum = mapped::fnv1a(std::string_view(contents).substr(sizeof(PlayerSaveHeader)));
+    std::memcpy(contents.data(), &header, sizeof header);
+    return contents;
+}
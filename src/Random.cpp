@@ -0,0 +1,135 @@
+#include "../include/Random.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+std::atomic<std::uint64_t> s_seed{0};
+// Bumped by setSeed(); a thread's generator reseeds when it sees a new one
+std::atomic<std::uint64_t> s_generation{0};
+std::atomic<std::uint64_t> s_nextThreadStream{Random::kFirstThreadStream};
+
+struct ThreadRandom {
+    static constexpr std::uint64_t kUnseeded = ~std::uint64_t{0};
+
+    Random random;
+    std::uint64_t stream = kUnseeded;
+    std::uint64_t generation = kUnseeded;
+};
+
+thread_local ThreadRandom t_random;
+
+std::uint64_t splitMix(std::uint64_t& x) noexcept {
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// 32-bit draws for dice, taken two to a 64-bit one
+class Halves {
+public:
+    explicit Halves(Random& random) noexcept : m_random(random) {}
+
+    std::uint32_t operator()() noexcept {
+        m_high = !m_high;
+        if (m_high) {
+            m_draw = m_random.next();
+            return static_cast<std::uint32_t>(m_draw >> 32);
+        }
+        return static_cast<std::uint32_t>(m_draw);
+    }
+
+private:
+    Random& m_random;
+    std::uint64_t m_draw = 0;
+    bool m_high = false;
+};
+
+} // namespace
+
+void Random::reseed(std::uint64_t seed, std::uint64_t stream) noexcept {
+    // SplitMix64 spreads even neighbouring seeds and streams over the whole
+    // state, and never leaves it all zero
+    std::uint64_t x = seed ^ splitMix(stream);
+    for (std::uint64_t& word : m_state) {
+        word = splitMix(x);
+    }
+}
+
+std::uint64_t Random::below(std::uint64_t bound) noexcept {
+    if (bound == 0) {
+        return 0;
+    }
+    if (bound <= UINT32_MAX) {
+        return die(static_cast<std::uint32_t>(bound), [this] { return static_cast<std::uint32_t>(next() >> 32); }) - 1;
+    }
+    // Draws below the threshold would favour the low results
+    const std::uint64_t threshold = (0 - bound) % bound;
+    std::uint64_t draw = next();
+    while (draw < threshold) {
+        draw = next();
+    }
+    return draw % bound;
+}
+
+std::int64_t Random::between(std::int64_t low, std::int64_t high) noexcept {
+    if (high <= low) {
+        return low;
+    }
+    const std::uint64_t span = static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low);
+    const std::uint64_t offset = span == UINT64_MAX ? next() : below(span + 1);
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(low) + offset);
+}
+
+std::uint64_t Random::roll(std::uint32_t count, std::uint32_t sides) noexcept {
+    if (sides == 0) {
+        return 0;
+    }
+    std::uint64_t total = 0;
+    Halves draw(*this);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        total += die(sides, draw);
+    }
+    return total;
+}
+
+void Random::fill(std::span<std::uint32_t> out, std::uint32_t sides) noexcept {
+    if (sides == 0) {
+        std::fill(out.begin(), out.end(), 0u);
+        return;
+    }
+    Halves draw(*this);
+    for (std::uint32_t& roll : out) {
+        roll = die(sides, draw);
+    }
+}
+
+Random& Random::forThread() noexcept {
+    ThreadRandom& local = t_random;
+    const std::uint64_t generation = s_generation.load(std::memory_order_acquire);
+    if (local.generation != generation) {
+        if (local.stream == ThreadRandom::kUnseeded) {
+            local.stream = s_nextThreadStream.fetch_add(1, std::memory_order_relaxed);
+        }
+        local.random.reseed(s_seed.load(std::memory_order_relaxed), local.stream);
+        local.generation = generation;
+    }
+    return local.random;
+}
+
+void Random::seedThread(std::uint64_t stream) noexcept {
+    ThreadRandom& local = t_random;
+    local.stream = stream;
+    local.generation = s_generation.load(std::memory_order_acquire);
+    local.random.reseed(s_seed.load(std::memory_order_relaxed), stream);
+}
+
+void Random::setSeed(std::uint64_t seed) noexcept {
+    s_seed.store(seed, std::memory_order_relaxed);
+    s_generation.fetch_add(1, std::memory_order_release);
+}
+
+std::uint64_t Random::seed() noexcept {
+    return s_seed.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,97 @@
+#include "../include/Rcu.h"
+#include <array>
+#include <cstddef>
+
+namespace {
+
+// One reader thread's pinned epoch, 0 while it holds no guard
+struct alignas(64) ReaderSlot {
+    std::atomic<std::uint64_t> epoch{0};
+    std::atomic<bool> claimed{false};
+};
+
+constexpr std::size_t kMaxReaders = 256;
+
+std::atomic<std::uint64_t> g_epoch{1};
+std::array<ReaderSlot, kMaxReaders> g_slots;
+// Readers that found every slot taken; while any is reading nothing is freed
+std::atomic<std::uint32_t> g_overflow{0};
+
+// The calling thread's slot, claimed on its first guard and given back
+// when the thread ends
+struct ThreadSlot {
+    ReaderSlot* slot = nullptr;
+    unsigned depth = 0;
+
+    ThreadSlot() {
+        for (ReaderSlot& candidate : g_slots) {
+            bool expected = false;
+            if (candidate.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                slot = &candidate;
+                return;
+            }
+        }
+    }
+
+    ~ThreadSlot() {
+        if (slot) {
+            slot->epoch.store(0, std::memory_order_release);
+            slot->claimed.store(false, std::memory_order_release);
+        }
+    }
+};
+
+ThreadSlot& threadSlot() {
+    thread_local ThreadSlot slot;
+    return slot;
+}
+
+} // namespace
+
+namespace rcu {
+
+Guard::Guard() noexcept {
+    ThreadSlot& self = threadSlot();
+    if (self.depth++ != 0) {
+        return;
+    }
+    // Sequentially consistent with the writer's swap and epoch bump: a
+    // writer that misses this pin bumped the epoch after the swap, so the
+    // loads under this guard see the new version
+    if (self.slot) {
+        self.slot->epoch.store(g_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    } else {
+        g_overflow.fetch_add(1, std::memory_order_seq_cst);
+    }
+}
+
+Guard::~Guard() {
+    ThreadSlot& self = threadSlot();
+    if (--self.depth != 0) {
+        return;
+    }
+    if (self.slot) {
+        self.slot->epoch.store(0, std::memory_order_release);
+    } else {
+        g_overflow.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+std::uint64_t advance() noexcept {
+    return g_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+}
+
+bool quiescent(std::uint64_t epoch) noexcept {
+    if (g_overflow.load(std::memory_order_seq_cst) != 0) {
+        return false;
+    }
+    for (const ReaderSlot& slot : g_slots) {
+        const std::uint64_t pinned = slot.epoch.load(std::memory_order_seq_cst);
+        if (pinned != 0 && pinned < epoch) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace rcu
@@ -0,0 +1,39 @@
+#include "../include/ReplyPool.h"
+#include <array>
+
+namespace {
+
+struct Buffers {
+    std::array<std::string, ReplyPool::kBuffers> free;
+    std::size_t count = 0;
+    ~Buffers();
+};
+
+thread_local Buffers t_buffers;
+// Outlives t_buffers, for replies destroyed while the thread shuts down
+thread_local bool t_buffersGone = false;
+
+Buffers::~Buffers() {
+    t_buffersGone = true;
+}
+
+} // namespace
+
+std::string ReplyPool::take() noexcept {
+    std::string text;
+    if (!t_buffersGone && t_buffers.count > 0) {
+        text.swap(t_buffers.free[--t_buffers.count]);
+        text.clear();
+    }
+    return text;
+}
+
+void ReplyPool::recycle(std::string& text) noexcept {
+    const std::size_t capacity = text.capacity();
+    // Short text sits inside the string and has no buffer worth keeping
+    if (capacity <= std::string().capacity() || capacity > kMaxCapacity || t_buffersGone ||
+        t_buffers.count == kBuffers) {
+        return;
+    }
+    t_buffers.free[t_buffers.count++].swap(text);
+}
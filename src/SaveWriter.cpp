@@ -0,0 +1,128 @@
+#include "../include/SaveWriter.h"
+#include "../include/PlayerSave.h"
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+SaveWriter::SaveWriter(std::filesystem::path directory, std::chrono::milliseconds interval)
+    : m_directory(std::move(directory))
+    , m_interval(std::max(interval, std::chrono::milliseconds(1))) {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    m_thread = std::thread([this] { work(); });
+}
+
+SaveWriter::~SaveWriter() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void SaveWriter::submit(std::string key, Player snapshot, bool urgent) {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.submitted;
+        const auto [slot, added] = m_waiting.try_emplace(std::move(key), std::move(snapshot));
+        if (!added) {
+            // Only the newest state of a player is worth writing
+            slot->second = std::move(snapshot);
+            ++m_stats.coalesced;
+        }
+        if (!urgent) {
+            return;
+        }
+        m_urgent = true;
+    }
+    m_wake.notify_one();
+}
+
+void SaveWriter::submitFile(std::string name, std::string contents) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_waitingFiles.insert_or_assign(std::move(name), std::move(contents));
+}
+
+void SaveWriter::settle(const std::string& key) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_waiting.contains(key)) {
+        m_urgent = true;
+        m_wake.notify_one();
+    }
+    m_settled.wait(lock, [this, &key] {
+        return !m_waiting.contains(key) && std::find(m_writing.begin(), m_writing.end(), key) == m_writing.end();
+    });
+}
+
+void SaveWriter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_waiting.empty() || !m_waitingFiles.empty()) {
+        m_urgent = true;
+        m_wake.notify_one();
+    }
+    m_settled.wait(lock, [this] { return m_waiting.empty() && m_waitingFiles.empty() && m_writing.empty(); });
+}
+
+std::filesystem::path SaveWriter::path(std::string_view key) const {
+    return m_directory / (std::string(key) + ".save");
+}
+
+SaveStats SaveWriter::stats() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::uint64_t SaveWriter::completed() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completed;
+}
+
+void SaveWriter::work() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait_for(lock, m_interval, [this] { return m_stopping || m_urgent; });
+        m_urgent = false;
+        if (m_waiting.empty() && m_waitingFiles.empty()) {
+            if (m_stopping) {
+                return;
+            }
+            continue;
+        }
+
+        // The game keeps submitting into a fresh map while the batch is written
+        std::unordered_map<std::string, Player> batch;
+        batch.swap(m_waiting);
+        std::unordered_map<std::string, std::string> files;
+        files.swap(m_waitingFiles);
+        const std::uint64_t taken = m_stats.submitted;
+        m_writing.clear();
+        for (const auto& [key, snapshot] : batch) {
+            m_writing.push_back(key);
+        }
+        lock.unlock();
+
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        const auto savedAt = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(now).count());
+        std::uint64_t written = 0;
+        for (const auto& [key, snapshot] : batch) {
+            written += PlayerSave::write(path(key), snapshot, savedAt) ? 1 : 0;
+        }
+        std::uint64_t filesWritten = 0;
+        for (const auto& [name, contents] : files) {
+            filesWritten += mapped::replaceFile(m_directory / name, contents) ? 1 : 0;
+        }
+
+        lock.lock();
+        ++m_stats.batches;
+        m_stats.written += written;
+        m_stats.failed += batch.size() - written;
+        m_stats.filesWritten += filesWritten;
+        m_stats.filesFailed += files.size() - filesWritten;
+        if (m_stats.failed == 0) {
+            m_completed = taken;
+        }
+        m_writing.clear();
+        m_settled.notify_all();
+    }
+}
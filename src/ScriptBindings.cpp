@@ -0,0 +1,357 @@
+#include "../include/ScriptBindings.h"
+#include "../include/GameEngine.h"
+#include <sol/sol.hpp>
+#include <cmath>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // Player the current script call runs for; set per thread by ScriptCallerScope
+    thread_local const ScriptPlayer* t_caller = nullptr;
+
+    bool isValid(const ScriptPlayer& player) {
+        return player.engine->players().isActive(player.id);
+    }
+
+    std::string_view playerName(const ScriptPlayer& player) {
+        return isValid(player) ? std::string_view{player.engine->players().name(player.id)} : std::string_view{};
+    }
+
+    ScriptRoom playerRoom(const ScriptPlayer& player) {
+        RoomId room = isValid(player) ? player.engine->players().room(player.id) : kInvalidRoomId;
+        return ScriptRoom{player.engine, room};
+    }
+
+    std::vector<ScriptPlayer> roomPlayers(const ScriptRoom& room) {
+        std::vector<ScriptPlayer> players;
+        if (room.id != kInvalidRoomId) {
+            room.engine->players().forEachInRoom(room.id, [&](PlayerId id) {
+                players.push_back(ScriptPlayer{room.engine, id});
+            });
+        }
+        return players;
+    }
+
+    void broadcast(const ScriptRoom& room, std::string_view message, sol::optional<ScriptPlayer> except) {
+        room.engine->broadcastToRoom(room.id, message, except ? except->id : kInvalidPlayerId);
+    }
+
+    sol::optional<ScriptRoom> roomExit(const ScriptRoom& room, std::string_view direction) {
+        for (std::size_t i = 0; i < kDirectionCount; ++i) {
+            auto dir = static_cast<Direction>(i);
+            if (directionName(dir) == direction) {
+                RoomId target = room.engine->world().exit(room.id, dir);
+                if (target != kInvalidRoomId) {
+                    return ScriptRoom{room.engine, target};
+                }
+                break;
+            }
+        }
+        return sol::nullopt;
+    }
+
+    int rejectWrite(lua_State* L) {
+        return luaL_error(L, "attempt to modify a read-only table");
+    }
+    
+    // The store functions are plain C closures over their script's space;
+    // every check that can raise an error is made before any C++ object
+    // that would need destroying exists
+    ScriptStore::Space& storeSpace(lua_State* L) {
+        return *static_cast<ScriptStore::Space*>(lua_touserdata(L, lua_upvalueindex(1)));
+    }
+    
+    std::string_view storeKey(lua_State* L) {
+        std::size_t size = 0;
+        const char* key = luaL_checklstring(L, 1, &size);
+        luaL_argcheck(L, size <= ScriptStore::kMaxKeyBytes, 1, "key too long");
+        return {key, size};
+    }
+    
+    int pushValue(lua_State* L, const std::optional<ScriptValue>& value) {
+        if (!value) {
+            lua_pushnil(L);
+        } else if (const auto* flag = std::get_if<bool>(&*value)) {
+            lua_pushboolean(L, *flag);
+        } else if (const auto* whole = std::get_if<std::int64_t>(&*value)) {
+            lua_pushinteger(L, static_cast<lua_Integer>(*whole));
+        } else if (const auto* number = std::get_if<double>(&*value)) {
+            lua_pushnumber(L, *number);
+        } else {
+            const std::string& text = std::get<std::string>(*value);
+            lua_pushlstring(L, text.data(), text.size());
+        }
+        return 1;
+    }
+    
+    // The boolean, number or string at index, which the caller has checked
+    ScriptValue toValue(lua_State* L, int index) {
+        switch (lua_type(L, index)) {
+        case LUA_TBOOLEAN:
+            return lua_toboolean(L, index) != 0;
+        case LUA_TNUMBER: {
+#if LUA_VERSION_NUM >= 503
+            if (lua_isinteger(L, index)) {
+                return static_cast<std::int64_t>(lua_tointeger(L, index));
+            }
+            return static_cast<double>(lua_tonumber(L, index));
+#else
+            // Every number is a double here; whole ones are kept as integers
+            const double number = lua_tonumber(L, index);
+            if (number == std::trunc(number) && std::abs(number) < 0x1p63) {
+                return static_cast<std::int64_t>(number);
+            }
+            return number;
+#endif
+        }
+        default: {
+            std::size_t size = 0;
+            const char* text = lua_tolstring(L, index, &size);
+            return std::string(text, size);
+        }
+        }
+    }
+    
+    // store.get(key): the value, or nil
+    int storeGet(lua_State* L) {
+        const std::string_view key = storeKey(L);
+        return pushValue(L, storeSpace(L).get(key));
+    }
+    
+    // store.set(key, value): a boolean, number or string; nil removes the key
+    int storeSet(lua_State* L) {
+        const std::string_view key = storeKey(L);
+        const int type = lua_type(L, 2);
+        if (type == LUA_TNIL || type == LUA_TNONE) {
+            storeSpace(L).remove(key);
+            return 0;
+        }
+        luaL_argcheck(L, type == LUA_TBOOLEAN || type == LUA_TNUMBER || type == LUA_TSTRING, 2,
+                      "boolean, number or string expected");
+        std::size_t length = 0;
+        if (type == LUA_TSTRING) {
+            lua_tolstring(L, 2, &length);
+        }
+        luaL_argcheck(L, length <= ScriptStore::kMaxStringBytes, 2, "string too long");
+        storeSpace(L).set(key, toValue(L, 2));
+        return 0;
+    }
+    
+    // store.add(key, number): the new total, in one step across every state
+    int storeAdd(lua_State* L) {
+        const std::string_view key = storeKey(L);
+        luaL_checktype(L, 2, LUA_TNUMBER);
+        bool added = false;
+        {
+            const std::optional<ScriptValue> sum = storeSpace(L).add(key, toValue(L, 2));
+            if (sum) {
+                pushValue(L, sum);
+                added = true;
+            }
+        }
+        if (!added) {
+            return luaL_error(L, "store key '%s' does not hold a number", lua_tostring(L, 1));
+        }
+        return 1;
+    }
+    
+    // store.keys(): every key, sorted
+    int storeKeys(lua_State* L) {
+        const std::vector<std::string> keys = storeSpace(L).keys();
+        lua_createtable(L, static_cast<int>(keys.size()), 0);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            lua_pushlstring(L, keys[i].data(), keys[i].size());
+            lua_rawseti(L, -2, static_cast<int>(i + 1));
+        }
+        return 1;
+    }
+
+#if SOL_LUAJIT
+    // Called from Lua through an FFI function pointer, so a JIT-compiled
+    // script reaches it with a plain call rather than through the C API
+    void refreshView(GameEngine* engine, ScriptStateView* view) {
+        const PlayerRegistry& players = engine->players();
+        const CombatRound& combat = engine->combat();
+        view->playerRooms = players.roomColumn().data();
+        view->exits = reinterpret_cast<const RoomId*>(engine->world().exitTable().data());
+        view->combatHealth = combat.health().data();
+        view->combatAttack = combat.attack().data();
+        view->combatDefense = combat.defense().data();
+        view->combatDamage = combat.damage().data();
+        view->playerCount = static_cast<std::uint32_t>(players.capacity());
+        view->roomCount = static_cast<std::uint32_t>(engine->world().size());
+        view->directions = static_cast<std::uint32_t>(kDirectionCount);
+        view->combatants = static_cast<std::uint32_t>(combat.size());
+    }
+
+    // Runs on the unsandboxed state with the ffi module the runner put aside;
+    // scripts only ever see the function it returns, never ffi itself
+    constexpr const char* kViewChunk = R"lua(
+        local ffi, storage, refresh, engine = ...
+        ffi.cdef[[
+            struct EchoView {
+                const uint32_t* playerRooms;
+                const uint32_t* exits;
+                const int32_t* combatHealth;
+                const int32_t* combatAttack;
+                const int32_t* combatDefense;
+                const int32_t* combatDamage;
+                uint32_t playerCount;
+                uint32_t roomCount;
+                uint32_t directions;
+                uint32_t combatants;
+            };
+        ]]
+        local view = ffi.cast("const struct EchoView*", storage)
+        refresh = ffi.cast("void (*)(void*, const struct EchoView*)", refresh)
+        return function()
+            refresh(engine, view)
+            return view
+        end
+    )lua";
+
+    void registerStateView(sol::state& lua, sol::table& api, GameEngine& engine) {
+        sol::object ffi = lua.registry()["echomud.ffi"];
+        if (!ffi.valid() || ffi.get_type() != sol::type::table) {
+            return;
+        }
+        // The view lives in a userdata the registry keeps for the state's lifetime
+        lua_State* L = lua.lua_state();
+        new (lua_newuserdata(L, sizeof(ScriptStateView))) ScriptStateView{};
+        sol::object storage(L, -1);
+        lua_pop(L, 1);
+        lua.registry()["echomud.view"] = storage;
+        
+        sol::protected_function chunk = lua.load(kViewChunk, "=view");
+        auto made = chunk(ffi, storage, reinterpret_cast<void*>(&refreshView), static_cast<void*>(&engine));
+        if (made.valid()) {
+            api["view"] = made.get<sol::protected_function>();
+        }
+    }
+#endif
+}
+
+void freezeGlobal(sol::state& lua, const char* name) {
+    lua_State* L = lua.lua_state();
+    lua_getglobal(L, name);
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        return;
+    }
+    lua_newtable(L);                   // The view, always empty
+    lua_newtable(L);                   // Its metatable
+    lua_pushvalue(L, -3);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, &rejectWrite);
+    lua_setfield(L, -2, "__newindex");
+    lua_pushboolean(L, 0);
+    lua_setfield(L, -2, "__metatable");
+    lua_setmetatable(L, -2);
+    lua_setglobal(L, name);
+    lua_pop(L, 1);
+}
+
+void pushScriptStore(lua_State* L, std::string_view script) {
+    lua_getfield(L, LUA_REGISTRYINDEX, "echomud.store");
+    auto* store = static_cast<ScriptStore*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!store) {
+        lua_pushnil(L);
+        return;
+    }
+    ScriptStore::Space& space = store->space(script);
+    lua_createtable(L, 0, 4);
+    for (const auto& [name, function] : {std::pair{"get", &storeGet},
+                                         {"set", &storeSet},
+                                         {"add", &storeAdd},
+                                         {"keys", &storeKeys}}) {
+        lua_pushlightuserdata(L, &space);
+        lua_pushcclosure(L, function, 1);
+        lua_setfield(L, -2, name);
+    }
+}
+
+ScriptCallerScope::ScriptCallerScope(const ScriptPlayer* caller)
+    : m_previous(t_caller) {
+    t_caller = caller;
+}
+
+ScriptCallerScope::~ScriptCallerScope() {
+    t_caller = m_previous;
+}
+
+void registerGameBindings(sol::state& lua, GameEngine& engine) {
+    lua.new_usertype<ScriptPlayer>("Player", sol::no_constructor,
+        "id", sol::readonly_property([](const ScriptPlayer& player) { return player.id; }),
+        "name", sol::readonly_property(&playerName),
+        "room", sol::readonly_property(&playerRoom),
+        "valid", sol::readonly_property(&isValid),
+        "send", [](const ScriptPlayer& player, std::string_view message) {
+            player.engine->sendToPlayer(player.id, std::string(message));
+        },
+        sol::meta_function::equal_to, [](const ScriptPlayer& a, const ScriptPlayer& b) { return a.id == b.id; },
+        sol::meta_function::to_string, [](const ScriptPlayer& player) { return std::string(playerName(player)); }
+    );
+    
+    lua.new_usertype<ScriptRoom>("Room", sol::no_constructor,
+        "id", sol::readonly_property([](const ScriptRoom& room) { return room.id; }),
+        "name", sol::readonly_property([](const ScriptRoom& room) { return room.engine->world().name(room.id); }),
+        "description", sol::readonly_property([](const ScriptRoom& room) { return room.engine->roomDescription(room.id); }),
+        "exit", &roomExit,
+        "players", [](const ScriptRoom& room) { return sol::as_table(roomPlayers(room)); },
+        "broadcast", &broadcast,
+        sol::meta_function::equal_to, [](const ScriptRoom& a, const ScriptRoom& b) { return a.id == b.id; },
+        sol::meta_function::to_string, [](const ScriptRoom& room) { return std::string(room.engine->world().name(room.id)); }
+    );
+    
+    GameEngine* game = &engine;
+    sol::table api = lua.create_named_table("game");
+    
+    // Found by pushScriptStore as each script is installed
+    lua_pushlightuserdata(lua.lua_state(), &engine.scriptStore());
+    lua_setfield(lua.lua_state(), LUA_REGISTRYINDEX, "echomud.store");
+    
+    api["caller"] = []() -> sol::optional<ScriptPlayer> {
+        return t_caller ? sol::optional<ScriptPlayer>(*t_caller) : sol::nullopt;
+    };
+    api["player"] = [game](PlayerId id) -> sol::optional<ScriptPlayer> {
+        return game->players().isActive(id) ? sol::optional<ScriptPlayer>(ScriptPlayer{game, id}) : sol::nullopt;
+    };
+    api["room"] = [game](std::string_view name) -> sol::optional<ScriptRoom> {
+        RoomId room = game->world().find(name);
+        return room != kInvalidRoomId ? sol::optional<ScriptRoom>(ScriptRoom{game, room}) : sol::nullopt;
+    };
+    api["sendMessage"] = [](const ScriptPlayer& player, std::string_view message) {
+        player.engine->sendToPlayer(player.id, std::string(message));
+    };
+    api["broadcast"] = &broadcast;
+    
+    // Shorthands for the player the script is running for
+    api["getPlayerName"] = []() -> std::string_view {
+        return t_caller ? playerName(*t_caller) : std::string_view{};
+    };
+    api["getPlayerLocation"] = []() -> std::string_view {
+        if (!t_caller) {
+            return {};
+        }
+        ScriptRoom room = playerRoom(*t_caller);
+        return room.engine->world().name(room.id);
+    };
+    api["getCurrentRoom"] = []() -> sol::optional<ScriptRoom> {
+        return t_caller ? sol::optional<ScriptRoom>(playerRoom(*t_caller)) : sol::nullopt;
+    };
+    api["getPlayersInRoom"] = []() {
+        return sol::as_table(t_caller ? roomPlayers(playerRoom(*t_caller)) : std::vector<ScriptPlayer>{});
+    };
+    
+#if SOL_LUAJIT
+    registerStateView(lua, api, engine);
+#endif
+    
+    // Shared by every script's environment, so no script may change them
+    freezeGlobal(lua, "Player");
+    freezeGlobal(lua, "Room");
+    freezeGlobal(lua, "game");
+}
@@ -0,0 +1,41 @@
+#include "../include/ScriptModuleCache.h"
+#include <mutex>
+
+ScriptModuleCache& ScriptModuleCache::global() {
+    static ScriptModuleCache cache;
+    return cache;
+}
+
+ScriptModuleCache::Chunk ScriptModuleCache::find(const std::filesystem::path& path,
+                                                 std::filesystem::file_time_type modified) const {
+    const std::shared_lock lock(m_mutex);
+    const auto found = m_entries.find(path.string());
+    if (found == m_entries.end() || found->second.modified != modified) {
+        return nullptr;
+    }
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return found->second.bytecode;
+}
+
+ScriptModuleCache::Chunk ScriptModuleCache::insert(const std::filesystem::path& path,
+                                                   std::filesystem::file_time_type modified, std::string bytecode) {
+    auto chunk = std::make_shared<const std::string>(std::move(bytecode));
+    m_compiles.fetch_add(1, std::memory_order_relaxed);
+    const std::unique_lock lock(m_mutex);
+    m_entries.insert_or_assign(path.string(), Entry{modified, chunk});
+    return chunk;
+}
+
+ScriptModuleCache::Stats ScriptModuleCache::stats() const {
+    Stats stats;
+    {
+        const std::shared_lock lock(m_mutex);
+        stats.modules = m_entries.size();
+        for (const auto& [path, entry] : m_entries) {
+            stats.bytes += entry.bytecode->size();
+        }
+    }
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.compiles = m_compiles.load(std::memory_order_relaxed);
+    return stats;
+}
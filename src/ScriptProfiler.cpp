@@ -0,0 +1,83 @@
+#include "../include/ScriptProfiler.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <iterator>
+
+ScriptProfiler::ScriptProfiler(std::uint32_t period, std::size_t words)
+    : m_period(std::max<std::uint32_t>(period, 1)), m_capacity(words) {
+    m_words.reserve(words);
+}
+
+std::uint32_t ScriptProfiler::frame(std::string_view function, std::string_view source, int line) {
+    m_name.clear();
+    if (!function.empty()) {
+        m_name.append(function).append(" (");
+    }
+    m_name.append(source);
+    if (line > 0) {
+        char digits[16];
+        const auto end = std::to_chars(digits, digits + sizeof digits, line).ptr;
+        m_name.append(":").append(digits, end);
+    }
+    if (!function.empty()) {
+        m_name.append(")");
+    }
+    // A ; would split the frame in two in the folded output
+    std::replace(m_name.begin(), m_name.end(), ';', ':');
+
+    if (const auto found = m_frameIds.find(m_name); found != m_frameIds.end()) {
+        return found->second;
+    }
+    const auto id = static_cast<std::uint32_t>(m_frames.size());
+    m_frames.push_back(m_name);
+    m_frameIds.emplace(m_name, id);
+    return id;
+}
+
+void ScriptProfiler::record(std::span<const std::uint32_t> stack) {
+    if (stack.empty()) {
+        return;
+    }
+    if (m_words.size() + stack.size() + 1 > m_capacity) {
+        ++m_dropped;
+        return;
+    }
+    m_words.push_back(static_cast<std::uint32_t>(stack.size()));
+    m_words.insert(m_words.end(), stack.begin(), stack.end());
+    ++m_samples;
+}
+
+void ScriptProfiler::fold(FoldedStacks& stacks) const {
+    std::string folded;
+    for (std::size_t at = 0; at < m_words.size();) {
+        const std::uint32_t depth = m_words[at];
+        const std::span<const std::uint32_t> frames(m_words.data() + at + 1, depth);
+        at += depth + 1;
+        folded.clear();
+        // Stored innermost first; folded stacks start at the root
+        for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+            if (!folded.empty()) {
+                folded += ';';
+            }
+            folded += m_frames[*frame];
+        }
+        ++stacks[folded];
+    }
+}
+
+std::string ScriptProfiler::render(const FoldedStacks& stacks) {
+    std::vector<const FoldedStacks::value_type*> sorted;
+    sorted.reserve(stacks.size());
+    for (const auto& stack : stacks) {
+        sorted.push_back(&stack);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) {
+        return a->second != b->second ? a->second > b->second : a->first < b->first;
+    });
+    std::string text;
+    for (const auto* stack : sorted) {
+        std::format_to(std::back_inserter(text), "{} {}\n", stack->first, stack->second);
+    }
+    return text;
+}
@@ -1,18 +1,443 @@
 #include "../include/ScriptRunner.h"
+#include "../include/Logger.h"
+#include "../include/Watchdog.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <format>
 #include <iostream>
+#include <iterator>
+#include <optional>
 
-ScriptRunner::ScriptRunner() {
+namespace {
+    // Cache file layout: magic, source modification time, source path length,
+    // source path, then the chunk as produced by lua_dump
+    constexpr char kBytecodeMagic[4] = {'E', 'M', 'B', 'C'};
+
+    std::filesystem::path bytecodePath(const std::filesystem::path& scriptPath) {
+        return scriptPath.parent_path() / ".luac" / (scriptPath.filename().string() + "c");
+    }
+
+    std::string bytecodeHeader(const std::string& source, std::filesystem::file_time_type modified) {
+        const std::int64_t ticks = modified.time_since_epoch().count();
+        const std::uint32_t length = static_cast<std::uint32_t>(source.size());
+
+        std::string header(kBytecodeMagic, sizeof(kBytecodeMagic));
+        header.append(reinterpret_cast<const char*>(&ticks), sizeof(ticks));
+        header.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        header.append(source);
+        return header;
+    }
+
+    // Budget of the script call running on this thread. The count hook is
+    // installed once per state and does nothing outside a metered call.
+    struct CallBudget {
+        std::uint64_t used = 0;
+        std::uint64_t limit = 0;
+        bool exceeded = false;
+    };
+    
+    thread_local CallBudget* t_callBudget = nullptr;
+    // Set from another thread (a watchdog) to stop this thread's script call
+    thread_local std::atomic<bool> t_interrupt{false};
+    
+    void countInstructions(lua_State* L, lua_Debug*) {
+        CallBudget* budget = t_callBudget;
+        if (!budget) {
+            return;
+        }
+        budget->used += ScriptRunner::kInstructionHookInterval;
+        if (t_interrupt.load(std::memory_order_relaxed)) {
+            budget->exceeded = true;
+            luaL_error(L, "interrupted: the thread running it stalled");
+        }
+        if (budget->limit != 0 && budget->used > budget->limit) {
+            // Raised again on every check, so a script can't pcall its way past the limit
+            budget->exceeded = true;
+            luaL_error(L, "instruction budget exceeded");
+        }
+    }
+    
+    // Where the sampling hook finds the state's profiler
+    constexpr const char* kProfilerKey = "echomud.profiler";
+    
+    // countInstructions with a stack sample now and then, in its place while
+    // the state is being profiled. Names come from the debug info, so a
+    // frame costs a lookup by name and nothing is allocated once it is known
+    void sampleInstructions(lua_State* L, lua_Debug* ar) {
+        lua_getfield(L, LUA_REGISTRYINDEX, kProfilerKey);
+        auto* profiler = static_cast<ScriptProfiler*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+        if (profiler && profiler->due()) {
+            std::array<std::uint32_t, ScriptProfiler::kMaxDepth> stack;
+            std::size_t depth = 0;
+            lua_Debug frame;
+            for (int level = 0; depth < stack.size() && lua_getstack(L, level, &frame) != 0; ++level) {
+                lua_getinfo(L, "Sn", &frame);
+                const std::string_view what = frame.what ? frame.what : "";
+                const std::string_view name = frame.name ? frame.name : what == "main" ? "main" : "";
+                stack[depth++] = profiler->frame(name, frame.short_src, what == "C" ? 0 : frame.linedefined);
+            }
+            profiler->record(std::span(stack).first(depth));
+        }
+        countInstructions(L, ar);
+    }
+    
+    // lua_dump's writer, appending the chunk to a string
+    int appendChunk(lua_State*, const void* bytes, std::size_t size, void* out) {
+        static_cast<std::string*>(out)->append(static_cast<const char*>(bytes), size);
+        return 0;
+    }
+    
+    // Dotted words, so a module name can't climb out of the module root
+    bool isModuleName(std::string_view name) {
+        bool wordStart = true;
+        for (const char c : name) {
+            if (c == '.') {
+                if (wordStart) {
+                    return false;
+                }
+                wordStart = true;
+            } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_') {
+                wordStart = false;
+            } else {
+                return false;
+            }
+        }
+        return !wordStart;
+    }
+    
+    enum class ModuleLoad { Failed, Current, Chunk };
+    
+    // For scriptRequire: push the time of module name's file as a number,
+    // then, unless the state already ran the module from the file as it is
+    // (Current), its chunk, loaded from the process-wide cache or compiled
+    // from the file and added to it. On failure push a message instead.
+    // Kept apart so nothing here is alive when scriptRequire raises it
+    ModuleLoad pushModule(lua_State* L, const std::filesystem::path& root, const char* name) {
+        if (!isModuleName(name)) {
+            lua_pushfstring(L, "'%s' is not a module name, words separated by dots", name);
+            return ModuleLoad::Failed;
+        }
+        std::string relative(name);
+        std::replace(relative.begin(), relative.end(), '.', '/');
+        const std::filesystem::path path = root / (relative + ".lua");
+        std::error_code ec;
+        const auto modified = std::filesystem::last_write_time(path, ec);
+        if (root.empty() || ec) {
+            lua_pushfstring(L, "module '%s' not found: no file %s", name, path.string().c_str());
+            return ModuleLoad::Failed;
+        }
+        lua_pushnumber(L, static_cast<lua_Number>(modified.time_since_epoch().count()));
+        lua_getfield(L, lua_upvalueindex(4), name);
+        const bool current = lua_rawequal(L, -1, -2) != 0;
+        lua_pop(L, 1);
+        if (current) {
+            return ModuleLoad::Current;
+        }
+        
+        const std::string chunkName = "@" + path.string();
+        ScriptModuleCache& cache = ScriptModuleCache::global();
+        if (const auto chunk = cache.find(path, modified)) {
+            if (luaL_loadbuffer(L, chunk->data(), chunk->size(), chunkName.c_str()) == 0) {
+                return ModuleLoad::Chunk;
+            }
+            lua_pop(L, 1);   // Bytecode from another Lua build; compile it here instead
+        }
+        
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            lua_pushfstring(L, "module '%s' could not be read from %s", name, path.string().c_str());
+            return ModuleLoad::Failed;
+        }
+        const std::string source{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        if (luaL_loadbuffer(L, source.data(), source.size(), chunkName.c_str()) != 0) {
+            return ModuleLoad::Failed;   // The compiler's message is on the stack
+        }
+        std::string bytecode;
+#if LUA_VERSION_NUM >= 503
+        lua_dump(L, &appendChunk, &bytecode, 0);
+#else
+        lua_dump(L, &appendChunk, &bytecode);
+#endif
+        cache.insert(path, modified, std::move(bytecode));
+        return ModuleLoad::Chunk;
+    }
+    
+    // require(name): a module from the module root, run once per state in an
+    // environment of its own over the sandbox, like a script's. Upvalues: the
+    // root, the sandbox, the state's modules by name and their files' times;
+    // a module is run again when its file has changed since it was
+    int scriptRequire(lua_State* L) {
+        const char* name = luaL_checkstring(L, 1);
+        const auto& root = *static_cast<const std::filesystem::path*>(lua_touserdata(L, lua_upvalueindex(1)));
+        switch (pushModule(L, root, name)) {
+        case ModuleLoad::Failed:
+            return lua_error(L);
+        case ModuleLoad::Current:
+            lua_getfield(L, lua_upvalueindex(3), name);
+            return 1;
+        case ModuleLoad::Chunk:
+            break;
+        }
+        // Stack: name, time, chunk
+        lua_newtable(L);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -2, "_G");
+        lua_pushvalue(L, lua_upvalueindex(2));
+        lua_setmetatable(L, -2);
+#if LUA_VERSION_NUM >= 502
+        lua_setupvalue(L, 3, 1);   // A main chunk's one upvalue is its _ENV
+#else
+        lua_setfenv(L, 3);
+#endif
+        lua_pushvalue(L, 1);
+        lua_call(L, 1, 1);
+        if (lua_isnil(L, -1)) {
+            lua_pop(L, 1);
+            lua_pushboolean(L, 1);
+        }
+        lua_pushvalue(L, -1);
+        lua_setfield(L, lua_upvalueindex(3), name);
+        lua_pushvalue(L, 2);
+        lua_setfield(L, lua_upvalueindex(4), name);
+        return 1;
+    }
+    
+    // Meters one call into a script and adds the result to its counters on scope exit
+    class MeteredCall {
+    public:
+        MeteredCall(ScriptRunner::ScriptStats& stats, std::uint64_t limit)
+            : m_stats(stats)
+            , m_budget{0, limit, false}
+            , m_previous(t_callBudget)
+            , m_start(std::chrono::steady_clock::now()) {
+            // An interrupt is for the call it was raised during, not the next
+            if (!m_previous) {
+                t_interrupt.store(false, std::memory_order_relaxed);
+            }
+            t_callBudget = &m_budget;
+        }
+        
+        ~MeteredCall() {
+            t_callBudget = m_previous;
+            settle();
+            m_stats.wallTime += std::chrono::steady_clock::now() - m_start;
+        }
+        
+        MeteredCall(const MeteredCall&) = delete;
+        MeteredCall& operator=(const MeteredCall&) = delete;
+        
+        bool exceeded() const { return m_budget.exceeded; }
+        
+        // Count the call so far and meter the next one in a batch with a fresh budget
+        void next() {
+            settle();
+            m_budget.used = 0;
+            m_budget.exceeded = false;
+        }
+        
+    private:
+        void settle() {
+            ++m_stats.calls;
+            m_stats.instructions += m_budget.used;
+            if (m_budget.exceeded) {
+                ++m_stats.budgetExceeded;
+            }
+        }
+        
+        ScriptRunner::ScriptStats& m_stats;
+        CallBudget m_budget;
+        CallBudget* m_previous;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // lua_resume across the Lua versions sol2 supports; nresults is the number
+    // of values returned or yielded, left on top of the thread's stack
+    int resumeThread(lua_State* thread, lua_State* from, int nargs, int& nresults) {
+#if LUA_VERSION_NUM >= 504
+        return lua_resume(thread, from, nargs, &nresults);
+#elif LUA_VERSION_NUM >= 502
+        const int status = lua_resume(thread, from, nargs);
+        nresults = lua_gettop(thread);
+        return status;
+#else
+        (void)from;
+        const int status = lua_resume(thread, nargs);
+        nresults = lua_gettop(thread);
+        return status;
+#endif
+    }
+    
+    // wait([ms | event]): suspend the running command. The yielded value tells
+    // the runner when to resume it: a delay in milliseconds, an event name, or
+    // nothing for the next scheduler pass.
+    int scriptWait(lua_State* L) {
+#if LUA_VERSION_NUM >= 503
+        if (!lua_isyieldable(L)) {
+            return luaL_error(L, "wait() can only be called from a command's run function");
+        }
+#endif
+        lua_settop(L, 1);
+        return lua_yield(L, lua_isnoneornil(L, 1) ? 0 : 1);
+    }
+    
+    // The state's generator, which math's functions carry as an upvalue
+    Random& stateRandom(lua_State* L) {
+        return *static_cast<Random*>(lua_touserdata(L, lua_upvalueindex(1)));
+    }
+    
+    // math.random as Lua 5.4 has it: no arguments for a number in [0, 1),
+    // m for an integer in [1, m], m and n for one in [m, n]
+    int scriptRandom(lua_State* L) {
+        Random& random = stateRandom(L);
+        lua_Integer low = 1;
+        lua_Integer high = 0;
+        switch (lua_gettop(L)) {
+        case 0:
+            lua_pushnumber(L, random.unit());
+            return 1;
+        case 1:
+            high = luaL_checkinteger(L, 1);
+            break;
+        case 2:
+            low = luaL_checkinteger(L, 1);
+            high = luaL_checkinteger(L, 2);
+            break;
+        default:
+            return luaL_error(L, "wrong number of arguments");
+        }
+        luaL_argcheck(L, low <= high, lua_gettop(L), "interval is empty");
+        lua_pushinteger(L, static_cast<lua_Integer>(random.between(low, high)));
+        return 1;
+    }
+    
+    // math.randomseed([n]): start the state's numbers over from n
+    int scriptRandomSeed(lua_State* L) {
+        stateRandom(L).reseed(static_cast<std::uint64_t>(luaL_optinteger(L, 1, 0)));
+        return 0;
+    }
+    
+    // math.dice(count, sides): the total of count dice
+    int scriptDice(lua_State* L) {
+        const lua_Integer count = luaL_checkinteger(L, 1);
+        const lua_Integer sides = luaL_checkinteger(L, 2);
+        luaL_argcheck(L, count >= 0 && count <= UINT32_MAX, 1, "out of range");
+        luaL_argcheck(L, sides >= 1 && sides <= UINT32_MAX, 2, "out of range");
+        const std::uint64_t total =
+            stateRandom(L).roll(static_cast<std::uint32_t>(count), static_cast<std::uint32_t>(sides));
+        lua_pushinteger(L, static_cast<lua_Integer>(total));
+        return 1;
+    }
+    
+    // math.rolls(n, sides): a table of n rolls of one die, filled a batch at a time
+    int scriptRolls(lua_State* L) {
+        constexpr lua_Integer kMaxRolls = 1 << 16;
+        const lua_Integer count = luaL_checkinteger(L, 1);
+        const lua_Integer sides = luaL_checkinteger(L, 2);
+        luaL_argcheck(L, count >= 0 && count <= kMaxRolls, 1, "out of range");
+        luaL_argcheck(L, sides >= 1 && sides <= UINT32_MAX, 2, "out of range");
+        Random& random = stateRandom(L);
+        lua_createtable(L, static_cast<int>(count), 0);
+        std::array<std::uint32_t, 64> batch;
+        for (lua_Integer done = 0; done < count;) {
+            const std::size_t take = static_cast<std::size_t>(std::min<lua_Integer>(count - done, batch.size()));
+            random.fill(std::span(batch).first(take), static_cast<std::uint32_t>(sides));
+            for (std::size_t i = 0; i < take; ++i) {
+                lua_pushinteger(L, static_cast<lua_Integer>(batch[i]));
+                lua_rawseti(L, -2, static_cast<int>(done) + static_cast<int>(i) + 1);
+            }
+            done += static_cast<lua_Integer>(take);
+        }
+        return 1;
+    }
+    
+    // The cached chunk for a script, if one was written for this source at this modification time
+    std::optional<std::string> readBytecodeCache(const std::filesystem::path& cachePath, const std::string& header) {
+        std::ifstream in(cachePath, std::ios::binary);
+        if (!in) {
+            return std::nullopt;
+        }
+        std::string cached((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (cached.size() <= header.size() || cached.compare(0, header.size(), header) != 0) {
+            return std::nullopt;
+        }
+        return cached.substr(header.size());
+    }
+
+    // Write the cache through a temporary file so a reader never sees a partial chunk.
+    // Failing to write the cache is not an error; the script has already compiled.
+    void writeBytecodeCache(const std::filesystem::path& cachePath, const std::string& header, std::string_view bytecode) {
+        std::error_code ec;
+        std::filesystem::create_directories(cachePath.parent_path(), ec);
+        
+        const std::filesystem::path tempPath = cachePath.string() + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            out.write(header.data(), static_cast<std::streamsize>(header.size()));
+            out.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+            if (!out) {
+                ec = std::make_error_code(std::errc::io_error);
+            }
+        }
+        if (!ec) {
+            std::filesystem::rename(tempPath, cachePath, ec);
+        }
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+        }
+    }
+
+    // Fields parsed by the command's syntax, as a table keyed by field name.
+    // Targets become Player objects when there is an engine to bind them to
+    void pushArguments(lua_State* L, const CommandArgs& parsed, GameEngine* engine) {
+        lua_createtable(L, 0, static_cast<int>(parsed.size()));
+        for (std::size_t i = 0; i < parsed.size(); ++i) {
+            const CommandArg& arg = parsed[i];
+            if (!arg.present) {
+                continue;
+            }
+            const std::string_view name = parsed.name(i);
+            lua_pushlstring(L, name.data(), name.size());
+            if (arg.kind == ArgKind::Number) {
+                lua_pushinteger(L, static_cast<lua_Integer>(arg.number));
+            } else if (arg.kind == ArgKind::Direction) {
+                const std::string_view direction = directionName(arg.direction);
+                lua_pushlstring(L, direction.data(), direction.size());
+            } else if (arg.kind == ArgKind::Target && engine) {
+                sol::stack::push(L, ScriptPlayer{engine, arg.target});
+            } else {
+                lua_pushlstring(L, arg.text.data(), arg.text.size());
+            }
+            lua_rawset(L, -3);
+        }
+    }
+}
+
+ScriptRunner::ScriptRunner(std::size_t memoryLimit)
+    : m_arena(memoryLimit)
+    , m_lua(sol::default_at_panic, &LuaArena::allocate, &m_arena) {
     try {
-        // Initialize Lua state
+        // Initialize Lua state; no io, and none of the base functions that
+        // load code, write past metatables or drive the collector
         m_lua.open_libraries(
             sol::lib::base,
             sol::lib::string,
             sol::lib::table,
-            sol::lib::math,
-            sol::lib::io
+            sol::lib::math
         );
+        for (const char* unsafe : {"dofile", "loadfile", "load", "rawset", "collectgarbage"}) {
+            m_lua[unsafe] = sol::lua_nil;
+        }
+#if SOL_LUAJIT
+        // ffi reaches any memory and any C function, so scripts don't get it;
+        // the bindings build their typed views with it (see game.view()).
+        // jit stays out too, as jit.off() would slow every script in the state
+        m_lua.open_libraries(sol::lib::ffi);
+        m_lua.registry()["echomud.ffi"] = m_lua["ffi"];
+        m_lua["ffi"] = sol::lua_nil;
+#endif
         
         // Add custom error handler for better debugging
         m_lua.set_exception_handler([](lua_State*, sol::optional<const std::exception&> maybe_exception, sol::string_view description) {
@@ -27,15 +452,176 @@ ScriptRunner::ScriptRunner() {
             
             return sol::stack::push(maybe_exception ? maybe_exception->what() : description);
         });
+        
+        // Count instructions so runaway scripts can be stopped and accounted for
+        lua_sethook(m_lua.lua_state(), &countInstructions, LUA_MASKCOUNT, kInstructionHookInterval);
+        
+        // Commands suspend themselves through wait(); see run() and resumeTasks()
+        lua_register(m_lua.lua_state(), "wait", &scriptWait);
+        
+        // math.random draws from this state's own generator rather than
+        // the C library's, so states never share one and a seeded run
+        // repeats; dice and rolls cover what games roll most
+        {
+            lua_State* state = m_lua.lua_state();
+            lua_getglobal(state, "math");
+            for (const auto& [name, function] : {std::pair{"random", &scriptRandom},
+                                                 {"randomseed", &scriptRandomSeed},
+                                                 {"dice", &scriptDice},
+                                                 {"rolls", &scriptRolls}}) {
+                lua_pushlightuserdata(state, &m_random);
+                lua_pushcclosure(state, function, 1);
+                lua_setfield(state, -2, name);
+            }
+            lua_pop(state, 1);
+        }
+        
+        // The globals become the base every script environment reads through.
+        // Scripts can't reach the table itself (_G names the environment), and
+        // the libraries in it are read-only views, down to the strings' metatable
+        freezeGlobal(m_lua, "string");
+        freezeGlobal(m_lua, "table");
+        freezeGlobal(m_lua, "math");
+        lua_State* L = m_lua.lua_state();
+        lua_pushliteral(L, "");
+        lua_getmetatable(L, -1);
+        lua_pushboolean(L, 0);
+        lua_setfield(L, -2, "__metatable");
+        lua_pop(L, 2);
+        m_lua["_G"] = sol::lua_nil;
+        m_sandbox = m_lua.create_table_with("__index", m_lua.globals(), "__metatable", false);
+        
+        // Modules come from m_moduleRoot only, compiled once for the process
+        // (see ScriptModuleCache); there is no package library to reach past it
+        lua_pushlightuserdata(L, &m_moduleRoot);
+        m_sandbox.push();
+        lua_newtable(L);
+        lua_newtable(L);
+        lua_pushcclosure(L, &scriptRequire, 4);
+        lua_setglobal(L, "require");
     }
     catch (const std::exception& e) {
         std::cerr << "Error initializing Lua: " << e.what() << std::endl;
     }
 }
 
-std::expected<void, ScriptRunner::ScriptError> ScriptRunner::loadScript(
+std::expected<ScriptHandle, ScriptRunner::ScriptError> ScriptRunner::loadScript(
     const std::string& name, 
     const std::filesystem::path& scriptPath
+) {
+    if (m_lazyLoading) {
+        if (auto header = readHeader(scriptPath)) {
+            return deferScript(name, scriptPath, std::move(*header));
+        }
+    }
+    return compileAndInstall(name, scriptPath);
+}
+
+std::optional<ScriptRunner::ScriptHeader> ScriptRunner::readHeader(const std::filesystem::path& scriptPath) {
+    std::ifstream in(scriptPath);
+    if (!in) {
+        return std::nullopt;
+    }
+    
+    // Blank lines and other comments may sit among the declarations; the
+    // first line of code ends the header
+    ScriptHeader header;
+    bool lazy = false;
+    bool help = false;
+    bool description = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        const std::size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos) {
+            continue;
+        }
+        const std::string_view text = std::string_view(line).substr(start);
+        if (!text.starts_with("--")) {
+            break;
+        }
+        if (!text.starts_with("--@")) {
+            continue;
+        }
+        
+        const std::string_view declaration = text.substr(3);
+        const std::size_t space = declaration.find_first_of(" \t");
+        const std::string_view key = declaration.substr(0, space);
+        std::string_view value = space == std::string_view::npos ? std::string_view() : declaration.substr(space);
+        value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+        if (key == "lazy") {
+            lazy = true;
+        } else if (key == "pure") {
+            header.pure = true;
+        } else if (key == "help") {
+            header.help = value;
+            help = true;
+        } else if (key == "description") {
+            header.description = value;
+            description = true;
+        } else if (key == "syntax") {
+            header.syntax = value;
+        }
+    }
+    
+    if (!lazy) {
+        return std::nullopt;
+    }
+    if (!help || !description) {
+        LOG_WARN("Script {} asks to be lazy but declares no --@help or --@description; loading it now",
+                 scriptPath.string());
+        return std::nullopt;
+    }
+    return header;
+}
+
+std::expected<ScriptHandle, ScriptRunner::ScriptError> ScriptRunner::deferScript(
+    const std::string& name,
+    const std::filesystem::path& scriptPath,
+    ScriptHeader header
+) {
+    try {
+        if (!std::filesystem::exists(scriptPath)) {
+            std::cerr << std::format("Script file not found: {}", scriptPath.string()) << std::endl;
+            return std::unexpected(ScriptError::LoadFailed);
+        }
+        
+        LoadedScript deferred{name, {}, {}, header.pure};
+        deferred.deferred = scriptPath;
+        deferred.header = std::move(header);
+        const ScriptHandle handle = store(std::move(deferred));
+        // A version loaded before may have left handlers behind
+        bindEvents(handle, sol::table());
+        return handle;
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Exception deferring script {}: {}", 
+            scriptPath.string(), e.what()) << std::endl;
+        return std::unexpected(ScriptError::LoadFailed);
+    }
+}
+
+std::expected<void, ScriptRunner::ScriptError> ScriptRunner::ensureLoaded(ScriptHandle handle) {
+    if (m_scripts[handle].deferred.empty()) {
+        return {};
+    }
+    
+    // Copied out, as installing replaces the entry they live in
+    const std::string name = m_scripts[handle].name;
+    const std::filesystem::path scriptPath = m_scripts[handle].deferred;
+    auto loaded = compileAndInstall(name, scriptPath);
+    if (!loaded) {
+        // Left deferred, so a fixed file is picked up by the next call
+        return std::unexpected(loaded.error());
+    }
+    return {};
+}
+
+std::expected<ScriptHandle, ScriptRunner::ScriptError> ScriptRunner::compileAndInstall(
+    const std::string& name,
+    const std::filesystem::path& scriptPath
 ) {
     try {
         // Check if file exists
@@ -44,8 +630,105 @@ std::expected<void, ScriptRunner::ScriptError> ScriptRunner::loadScript(
             return std::unexpected(ScriptError::LoadFailed);
         }
 
-        // Load the script file
-        auto result = m_lua.safe_script_file(scriptPath.string());
+        // Compile (or fetch from the bytecode cache) and run the chunk
+        const auto modified = std::filesystem::last_write_time(scriptPath);
+        auto chunk = compileScript(scriptPath, modified);
+        if (!chunk) {
+            return std::unexpected(chunk.error());
+        }
+        
+        return install(name, scriptPath, *chunk, modified);
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Exception loading script {}: {}", 
+            scriptPath.string(), e.what()) << std::endl;
+        return std::unexpected(ScriptError::LoadFailed);
+    }
+}
+
+std::expected<ScriptHandle, ScriptRunner::ScriptError> ScriptRunner::loadCompiled(
+    const std::string& name,
+    const std::filesystem::path& scriptPath,
+    std::string_view bytecode,
+    std::filesystem::file_time_type modified
+) {
+    try {
+        sol::load_result loaded = m_lua.load_buffer(bytecode.data(), bytecode.size(), 
+            "@" + scriptPath.string(), sol::load_mode::binary);
+        if (!loaded.valid()) {
+            sol::error err = loaded;
+            std::cerr << std::format("Failed to load compiled script {}: {}", 
+                scriptPath.string(), err.what()) << std::endl;
+            return std::unexpected(ScriptError::LoadFailed);
+        }
+        sol::protected_function chunk = loaded;
+        
+        return install(name, scriptPath, chunk, modified);
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Exception loading script {}: {}", 
+            scriptPath.string(), e.what()) << std::endl;
+        return std::unexpected(ScriptError::LoadFailed);
+    }
+}
+
+std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::compileToBytecode(
+    sol::state& lua,
+    const std::filesystem::path& scriptPath,
+    std::filesystem::file_time_type modified,
+    bool useCache
+) {
+    try {
+        const std::filesystem::path cachePath = bytecodePath(scriptPath);
+        const std::string header = bytecodeHeader(scriptPath.string(), modified);
+        if (useCache) {
+            if (auto cached = readBytecodeCache(cachePath, header)) {
+                return std::move(*cached);
+            }
+        }
+        
+        sol::load_result loaded = lua.load_file(scriptPath.string(), sol::load_mode::text);
+        if (!loaded.valid()) {
+            sol::error err = loaded;
+            std::cerr << std::format("Failed to compile script {}: {}", 
+                scriptPath.string(), err.what()) << std::endl;
+            return std::unexpected(ScriptError::LoadFailed);
+        }
+        sol::protected_function chunk = loaded;
+        
+        const sol::bytecode dumped = chunk.dump();
+        std::string bytecode(dumped.as_string_view());
+        if (useCache) {
+            writeBytecodeCache(cachePath, header, bytecode);
+        }
+        return bytecode;
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Exception compiling script {}: {}", 
+            scriptPath.string(), e.what()) << std::endl;
+        return std::unexpected(ScriptError::LoadFailed);
+    }
+}
+
+std::expected<ScriptHandle, ScriptRunner::ScriptError> ScriptRunner::install(
+    const std::string& name,
+    const std::filesystem::path& scriptPath,
+    sol::protected_function& chunk,
+    std::filesystem::file_time_type modified
+) {
+    try {
+        // Each script (and each version of it) gets a fresh environment: its
+        // globals land there, and anything else is looked up in the base
+        sol::environment env(m_lua, sol::create);
+        env["_G"] = env;
+        env[sol::metatable_key] = m_sandbox;
+        // Its store is the one thing that outlives the environment
+        pushScriptStore(m_lua.lua_state(), name);
+        env["store"] = sol::object(m_lua.lua_state(), -1);
+        lua_pop(m_lua.lua_state(), 1);
+        sol::set_environment(env, chunk);
+        
+        auto result = chunk();
         if (!result.valid()) {
             sol::error err = result;
             std::cerr << std::format("Failed to load script {}: {}", 
@@ -63,12 +746,14 @@ std::expected<void, ScriptRunner::ScriptError> ScriptRunner::loadScript(
             return std::unexpected(ScriptError::InvalidScript);
         }
 
-        // Store the script and its modification time
-        m_scripts[name] = scriptTable;
-        m_scriptTimes[name] = std::filesystem::last_write_time(scriptPath);
+        // Store the script with its run function resolved once
+        sol::protected_function runFunc = scriptTable["run"];
+        const ScriptHandle handle = store({name, scriptTable, std::move(runFunc), scriptTable.get_or("pure", false)});
+        bindEvents(handle, scriptTable);
+        m_scriptTimes[name] = modified;
         
         std::cout << std::format("Successfully loaded script: {}", name) << std::endl;
-        return {};  // Success
+        return handle;
     }
     catch (const std::exception& e) {
         std::cerr << std::format("Exception loading script {}: {}", 
@@ -77,41 +762,358 @@ std::expected<void, ScriptRunner::ScriptError> ScriptRunner::loadScript(
     }
 }
 
+ScriptHandle ScriptRunner::store(LoadedScript script) {
+    // The existing slot is reused on reload so handles held by callers stay valid
+    if (auto it = m_handles.find(script.name); it != m_handles.end()) {
+        const ScriptHandle handle = it->second;
+        script.stats = m_scripts[handle].stats;   // Accounting survives reloads
+        m_scripts[handle] = std::move(script);
+        return handle;
+    }
+    const ScriptHandle handle = static_cast<ScriptHandle>(m_scripts.size());
+    m_handles.emplace(script.name, handle);
+    m_scripts.push_back(std::move(script));
+    return handle;
+}
+
+std::expected<sol::protected_function, ScriptRunner::ScriptError> ScriptRunner::compileScript(
+    const std::filesystem::path& scriptPath,
+    std::filesystem::file_time_type modified
+) {
+    const std::string source = scriptPath.string();
+    const std::string chunkName = "@" + source;
+    const std::filesystem::path cachePath = bytecodePath(scriptPath);
+    const std::string header = bytecodeHeader(source, modified);
+    
+    // Use the cached chunk if it was compiled from this file at this modification time
+    if (m_bytecodeCache) {
+        if (auto cached = readBytecodeCache(cachePath, header)) {
+            sol::load_result loaded = m_lua.load_buffer(cached->data(), cached->size(), 
+                chunkName, sol::load_mode::binary);
+            if (loaded.valid()) {
+                sol::protected_function chunk = loaded;
+                return chunk;
+            }
+            // Incompatible bytecode (e.g. a different Lua build); recompile below
+        }
+    }
+    
+    sol::load_result loaded = m_lua.load_file(source, sol::load_mode::text);
+    if (!loaded.valid()) {
+        sol::error err = loaded;
+        std::cerr << std::format("Failed to load script {}: {}", source, err.what()) << std::endl;
+        return std::unexpected(ScriptError::LoadFailed);
+    }
+    sol::protected_function chunk = loaded;
+    
+    if (m_bytecodeCache) {
+        const sol::bytecode bytecode = chunk.dump();
+        writeBytecodeCache(cachePath, header, bytecode.as_string_view());
+    }
+    
+    return chunk;
+}
+
 std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::runCommand(
     const std::string& name, 
-    const std::string& args
+    std::string_view args
 ) {
-    // Get the script
-    auto scriptResult = getScript(name);
-    if (!scriptResult) {
-        return std::unexpected(scriptResult.error());
+    auto handle = resolve(name);
+    if (!handle) {
+        std::cerr << std::format("Script command not found: {}", name) << std::endl;
+        return std::unexpected(handle.error());
+    }
+    
+    std::string output;
+    if (auto result = run(*handle, args, output); !result) {
+        return std::unexpected(result.error());
+    }
+    return output;
+}
+
+std::expected<void, ScriptRunner::ScriptError> ScriptRunner::run(
+    ScriptHandle handle, 
+    std::string_view args,
+    std::string& output,
+    const ScriptPlayer* caller,
+    const CommandArgs* parsed
+) {
+    if (handle >= m_scripts.size()) {
+        return std::unexpected(ScriptError::CommandNotFound);
+    }
+    if (auto loaded = ensureLoaded(handle); !loaded) {
+        return loaded;
     }
     
     try {
-        // Get the run function
-        sol::table script = scriptResult.value();
-        sol::protected_function runFunc = script["run"];
+        // Every call runs as a coroutine on a thread of its own; threads inherit
+        // the instruction hook from the main state, so metering is unchanged
+        Task task{handle, sol::thread::create(m_lua.lua_state()),
+                  caller ? *caller : ScriptPlayer{nullptr, kInvalidPlayerId}, {}, {}};
+        lua_State* thread = task.thread.thread_state();
         
-        // Execute the function with args
-        auto result = runFunc(args);
-        if (!result.valid()) {
-            sol::error err = result;
-            std::cerr << std::format("Error executing script {}: {}", 
-                name, err.what()) << std::endl;
-            return std::unexpected(ScriptError::ExecutionFailed);
+        // The arguments are pushed with lua_pushlstring, so they are not copied into
+        // a std::string; the caller is pushed as a Player usertype holding only its
+        // id, and parsed fields follow as a third argument
+        m_scripts[handle].run.push(thread);
+        lua_pushlstring(thread, args.data(), args.size());
+        int nargs = 1;
+        if (caller) {
+            sol::stack::push(thread, *caller);
+            ++nargs;
+        }
+        if (parsed) {
+            if (!caller) {
+                lua_pushnil(thread);
+                ++nargs;
+            }
+            pushArguments(thread, *parsed, caller ? caller->engine : nullptr);
+            ++nargs;
         }
         
-        // Convert the result to string
-        std::string output = result;
-        return output;
+        auto finished = resume(task, nargs, output);
+        if (!finished) {
+            return std::unexpected(finished.error());
+        }
+        if (!*finished) {
+            if (m_tasks.size() >= kMaxSuspendedTasks) {
+                std::cerr << std::format("Script {} was dropped: {} calls are already waiting", 
+                    m_scripts[handle].name, kMaxSuspendedTasks) << std::endl;
+                return std::unexpected(ScriptError::ExecutionFailed);
+            }
+            if (task.event.empty()) {
+                m_nextWake = std::min(m_nextWake, task.wakeAt);
+            }
+            m_tasks.push_back(std::move(task));
+        }
+        return {};
     }
     catch (const std::exception& e) {
         std::cerr << std::format("Exception running script {}: {}", 
-            name, e.what()) << std::endl;
+            m_scripts[handle].name, e.what()) << std::endl;
+        return std::unexpected(ScriptError::ExecutionFailed);
+    }
+}
+
+std::atomic<bool>& ScriptRunner::interruptFlag() noexcept {
+    return t_interrupt;
+}
+
+std::expected<bool, ScriptRunner::ScriptError> ScriptRunner::resume(Task& task, int nargs, std::string& output) {
+    LoadedScript& script = m_scripts[task.script];
+    lua_State* thread = task.thread.thread_state();
+    output.clear();
+    
+    MeteredCall meter(script.stats, m_instructionBudget);
+    ScriptCallerScope scope(task.caller.engine ? &task.caller : nullptr);
+    const Watchdog::Activity doing("script", script.name);
+    
+    int nresults = 0;
+    const int status = resumeThread(thread, m_lua.lua_state(), nargs, nresults);
+    const int first = lua_gettop(thread) - nresults + 1;
+    
+    if (status == LUA_YIELD) {
+        task.wakeAt = std::chrono::steady_clock::now();
+        task.event.clear();
+        if (nresults > 0) {
+            if (lua_type(thread, first) == LUA_TSTRING) {
+                task.event = lua_tostring(thread, first);
+            } else if (lua_type(thread, first) == LUA_TNUMBER) {
+                const double ms = std::clamp(static_cast<double>(lua_tonumber(thread, first)), 0.0, 1e12);
+                task.wakeAt += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::milli>(ms));
+            }
+        }
+        lua_pop(thread, nresults);
+        return false;
+    }
+    
+    if (status != LUA_OK) {
+        if (meter.exceeded()) {
+            std::cerr << std::format("Script {} exceeded its budget of {} instructions", 
+                script.name, m_instructionBudget) << std::endl;
+            return std::unexpected(ScriptError::BudgetExceeded);
+        }
+        const char* message = lua_tostring(thread, -1);
+        std::cerr << std::format("Error executing script {}: {}", 
+            script.name, message ? message : "(error object is not a string)") << std::endl;
+        return std::unexpected(ScriptError::ExecutionFailed);
+    }
+    
+    // Copy the returned Lua string straight into the caller's buffer
+    if (nresults > 0) {
+        const int type = lua_type(thread, first);
+        if (type == LUA_TSTRING || type == LUA_TNUMBER) {
+            std::size_t length = 0;
+            const char* text = lua_tolstring(thread, first, &length);
+            output.append(text, length);
+        }
+    }
+    lua_settop(thread, 0);
+    return true;
+}
+
+std::size_t ScriptRunner::resumeTasks(std::chrono::steady_clock::time_point now, std::vector<TaskResult>& finished) {
+    if (m_tasks.empty() || (!m_tasksSignalled && now < m_nextWake)) {
+        return 0;
+    }
+    
+    // Take the due tasks out first; those that wait again are appended back
+    auto split = std::partition(m_tasks.begin(), m_tasks.end(), [now](const Task& task) {
+        return !task.event.empty() || task.wakeAt > now;
+    });
+    std::vector<Task> due(std::make_move_iterator(split), std::make_move_iterator(m_tasks.end()));
+    m_tasks.erase(split, m_tasks.end());
+    m_tasksSignalled = false;
+    
+    std::string output;
+    for (Task& task : due) {
+        const PlayerId player = task.caller.engine ? task.caller.id : kInvalidPlayerId;
+        std::expected<bool, ScriptError> result = std::unexpected(ScriptError::ExecutionFailed);
+        try {
+            result = resume(task, 0, output);
+        }
+        catch (const std::exception& e) {
+            std::cerr << std::format("Exception resuming script {}: {}", 
+                m_scripts[task.script].name, e.what()) << std::endl;
+        }
+        
+        if (!result) {
+            finished.push_back(TaskResult{player, std::unexpected(result.error())});
+        } else if (*result) {
+            finished.push_back(TaskResult{player, output});
+        } else {
+            m_tasks.push_back(std::move(task));
+        }
+    }
+    
+    m_nextWake = std::chrono::steady_clock::time_point::max();
+    for (const Task& task : m_tasks) {
+        if (task.event.empty()) {
+            m_nextWake = std::min(m_nextWake, task.wakeAt);
+        }
+    }
+    return due.size();
+}
+
+void ScriptRunner::signal(std::string_view event) {
+    for (Task& task : m_tasks) {
+        if (!task.event.empty() && task.event == event) {
+            task.event.clear();
+            task.wakeAt = {};
+            m_tasksSignalled = true;
+        }
+    }
+}
+
+void ScriptRunner::cancelTasks(PlayerId player) {
+    // A stale m_nextWake only costs one empty pass, so it is left as is
+    std::erase_if(m_tasks, [player](const Task& task) {
+        return task.caller.engine && task.caller.id == player;
+    });
+}
+
+std::expected<void, ScriptRunner::ScriptError> ScriptRunner::runBatch(
+    const std::string& name,
+    std::span<const BatchCall> calls,
+    std::vector<std::expected<std::string, ScriptError>>& results
+) {
+    auto handle = resolve(name);
+    if (!handle) {
+        std::cerr << std::format("Script command not found: {}", name) << std::endl;
+        return std::unexpected(handle.error());
+    }
+    return runBatch(*handle, calls, results);
+}
+
+std::expected<void, ScriptRunner::ScriptError> ScriptRunner::runBatch(
+    ScriptHandle handle,
+    std::span<const BatchCall> calls,
+    std::vector<std::expected<std::string, ScriptError>>& results
+) {
+    if (handle >= m_scripts.size()) {
+        return std::unexpected(ScriptError::CommandNotFound);
+    }
+    if (auto loaded = ensureLoaded(handle); !loaded) {
+        return loaded;
+    }
+    
+    LoadedScript& script = m_scripts[handle];
+    results.resize(calls.size());
+    
+    lua_State* L = m_lua.lua_state();
+    const int base = lua_gettop(L);
+    try {
+        // One meter and one copy of the run function serve the whole batch;
+        // each record still gets its own instruction budget
+        MeteredCall meter(script.stats, m_instructionBudget);
+        script.run.push(L);
+        
+        for (std::size_t i = 0; i < calls.size(); ++i) {
+            if (i != 0) {
+                meter.next();
+            }
+            const BatchCall& call = calls[i];
+            ScriptCallerScope scope(call.caller);
+            
+            lua_pushvalue(L, base + 1);
+            lua_pushlstring(L, call.args.data(), call.args.size());
+            int nargs = 1;
+            if (call.caller) {
+                sol::stack::push(L, *call.caller);
+                ++nargs;
+            }
+            
+            auto& result = results[i];
+            if (lua_pcall(L, nargs, 1, 0) != LUA_OK) {
+                if (meter.exceeded()) {
+                    std::cerr << std::format("Script {} exceeded its budget of {} instructions", 
+                        script.name, m_instructionBudget) << std::endl;
+                    result = std::unexpected(ScriptError::BudgetExceeded);
+                } else {
+                    const char* message = lua_tostring(L, -1);
+                    std::cerr << std::format("Error executing script {}: {}", 
+                        script.name, message ? message : "(error object is not a string)") << std::endl;
+                    result = std::unexpected(ScriptError::ExecutionFailed);
+                }
+                lua_pop(L, 1);
+                continue;
+            }
+            
+            // Reuse the string left in the slot by an earlier batch
+            if (result) {
+                result->clear();
+            } else {
+                result.emplace();
+            }
+            const int type = lua_type(L, -1);
+            if (type == LUA_TSTRING || type == LUA_TNUMBER) {
+                std::size_t length = 0;
+                const char* text = lua_tolstring(L, -1, &length);
+                result->append(text, length);
+            }
+            lua_pop(L, 1);
+        }
+        
+        lua_settop(L, base);
+        return {};
+    }
+    catch (const std::exception& e) {
+        lua_settop(L, base);
+        std::cerr << std::format("Exception running script {}: {}", 
+            script.name, e.what()) << std::endl;
         return std::unexpected(ScriptError::ExecutionFailed);
     }
 }
 
+std::expected<ScriptHandle, ScriptRunner::ScriptError> ScriptRunner::resolve(const std::string& name) const {
+    auto it = m_handles.find(name);
+    if (it == m_handles.end()) {
+        return std::unexpected(ScriptError::CommandNotFound);
+    }
+    return it->second;
+}
+
 std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::getHelp(const std::string& name) {
     // Get the script
     auto scriptResult = getScript(name);
@@ -119,10 +1121,13 @@ std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::getHelp(cons
         return std::unexpected(scriptResult.error());
     }
     
+    if (!scriptResult.value()->deferred.empty()) {
+        return scriptResult.value()->header.help;
+    }
+    
     try {
         // Get the help string
-        sol::table script = scriptResult.value();
-        std::string help = script["help"];
+        std::string help = scriptResult.value()->table["help"];
         return help;
     }
     catch (const std::exception& e) {
@@ -139,10 +1144,13 @@ std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::getDescripti
         return std::unexpected(scriptResult.error());
     }
     
+    if (!scriptResult.value()->deferred.empty()) {
+        return scriptResult.value()->header.description;
+    }
+    
     try {
         // Get the description string
-        sol::table script = scriptResult.value();
-        std::string description = script["description"];
+        std::string description = scriptResult.value()->table["description"];
         return description;
     }
     catch (const std::exception& e) {
@@ -152,18 +1160,253 @@ std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::getDescripti
     }
 }
 
+std::expected<std::string, ScriptRunner::ScriptError> ScriptRunner::getSyntax(const std::string& name) {
+    auto scriptResult = getScript(name);
+    if (!scriptResult) {
+        return std::unexpected(scriptResult.error());
+    }
+    
+    if (!scriptResult.value()->deferred.empty()) {
+        return scriptResult.value()->header.syntax;
+    }
+    
+    try {
+        // Optional; a script without one gets its arguments unparsed
+        return scriptResult.value()->table.get_or("syntax", std::string());
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Error getting syntax for {}: {}", 
+            name, e.what()) << std::endl;
+        return std::unexpected(ScriptError::ExecutionFailed);
+    }
+}
+
 bool ScriptRunner::hasCommand(const std::string& name) const {
-    return m_scripts.contains(name);
+    return m_handles.contains(name);
+}
+
+bool ScriptRunner::isPure(ScriptHandle handle) const {
+    return handle < m_scripts.size() && m_scripts[handle].pure;
+}
+
+void ScriptRunner::bindEvents(ScriptHandle handle, const sol::table& scriptTable) {
+    static constexpr const char* kEventNames[] = {"enter_room", "tick", "say", "combat_round"};
+    static_assert(std::size(kEventNames) == static_cast<std::size_t>(ScriptEvent::Count));
+    
+    // A deferred script has no table yet, and so no handlers
+    sol::optional<sol::table> events;
+    if (scriptTable.valid()) {
+        events = scriptTable.get<sol::optional<sol::table>>("events");
+    }
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < m_eventHandlers.size(); ++i) {
+        auto& handlers = m_eventHandlers[i];
+        std::erase_if(handlers, [handle](const EventHandler& entry) { return entry.script == handle; });
+        if (events) {
+            sol::object handler = (*events)[kEventNames[i]];
+            if (handler.is<sol::protected_function>()) {
+                handlers.push_back({handle, handler.as<sol::protected_function>()});
+            }
+        }
+        if (!handlers.empty()) {
+            mask |= 1u << i;
+        }
+    }
+    m_eventMask.store(mask, std::memory_order_relaxed);
+}
+
+template <typename... Args>
+void ScriptRunner::emit(ScriptEvent event, const ScriptPlayer* caller, const Args&... args) {
+    ScriptCallerScope scope(caller);
+    auto& handlers = m_eventHandlers[static_cast<std::size_t>(event)];
+    // By index: a handler is free to do anything but load scripts
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        LoadedScript& script = m_scripts[handlers[i].script];
+        MeteredCall meter(script.stats, m_instructionBudget);
+        const Watchdog::Activity doing("event handler in", script.name);
+        auto result = handlers[i].handler(args...);
+        if (result.valid()) {
+            continue;
+        }
+        if (meter.exceeded()) {
+            LOG_WARN("Event handler in {} exceeded its budget of {} instructions", script.name, m_instructionBudget);
+        } else {
+            sol::error err = result;
+            LOG_ERROR("Error in event handler of {}: {}", script.name, err.what());
+        }
+    }
+}
+
+void ScriptRunner::emitEnterRoom(const ScriptPlayer& player, const ScriptRoom& room) {
+    emit(ScriptEvent::EnterRoom, &player, player, room);
+}
+
+void ScriptRunner::emitTick(std::uint64_t tick) {
+    emit(ScriptEvent::Tick, nullptr, tick);
+}
+
+void ScriptRunner::emitSay(const ScriptPlayer& player, std::string_view message) {
+    emit(ScriptEvent::Say, &player, player, message);
+}
+
+void ScriptRunner::emitCombatRound(const ScriptRoom& room, std::string_view report) {
+    emit(ScriptEvent::CombatRound, nullptr, room, report);
+}
+
+bool ScriptRunner::hasHook(const std::string& name, const std::string& hookName) {
+    auto script = resolve(name);
+    if (!script || !m_scripts[*script].deferred.empty()) {
+        return false;
+    }
+    return m_scripts[*script].table[hookName].is<sol::protected_function>();
 }
 
-std::expected<sol::table, ScriptRunner::ScriptError> ScriptRunner::getScript(const std::string& name) {
-    // Check if the command exists
-    if (!hasCommand(name)) {
+std::expected<bool, ScriptRunner::ScriptError> ScriptRunner::runHook(
+    const std::string& name,
+    const std::string& hookName,
+    std::string_view first,
+    std::string_view second
+) {
+    // Get the script
+    auto scriptResult = getScript(name);
+    if (!scriptResult) {
+        return std::unexpected(scriptResult.error());
+    }
+    
+    if (!scriptResult.value()->deferred.empty()) {
+        return true;   // hasHook() said it had none
+    }
+    
+    try {
+        LoadedScript& script = *scriptResult.value();
+        sol::protected_function hookFunc = script.table[hookName];
+        
+        MeteredCall meter(script.stats, m_instructionBudget);
+        const Watchdog::Activity doing("hook in", name);
+        auto result = hookFunc(first, second);
+        if (!result.valid()) {
+            if (meter.exceeded()) {
+                std::cerr << std::format("Hook {}.{} exceeded its budget of {} instructions", 
+                    name, hookName, m_instructionBudget) << std::endl;
+                return std::unexpected(ScriptError::BudgetExceeded);
+            }
+            sol::error err = result;
+            std::cerr << std::format("Error executing hook {}.{}: {}", 
+                name, hookName, err.what()) << std::endl;
+            return std::unexpected(ScriptError::ExecutionFailed);
+        }
+        
+        // Only an explicit false blocks; nil or no return value lets the event through
+        sol::object value = result;
+        return !(value.is<bool>() && !value.as<bool>());
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Exception running hook {}.{}: {}", 
+            name, hookName, e.what()) << std::endl;
+        return std::unexpected(ScriptError::ExecutionFailed);
+    }
+}
+
+void ScriptRunner::setGcMode(GcMode mode) {
+    lua_State* L = m_lua.lua_state();
+    
+    lua_gc(L, LUA_GCRESTART, 0);
+#ifdef LUA_GCGEN
+    if (mode == GcMode::Generational) {
+        lua_gc(L, LUA_GCGEN, 0, 0);
+    } else {
+        lua_gc(L, LUA_GCINC, 0, 0, 0);
+    }
+#endif
+    if (mode == GcMode::Scheduled) {
+        lua_gc(L, LUA_GCSTOP, 0);
+    }
+    
+    m_gcMode = mode;
+    m_gcCycleActive = false;
+    m_gcBaseline = m_arena.liveBytes();
+}
+
+void ScriptRunner::startProfiling(std::uint32_t period, std::size_t words) {
+    m_profiler = std::make_unique<ScriptProfiler>(period, words);
+    lua_State* L = m_lua.lua_state();
+    lua_pushlightuserdata(L, m_profiler.get());
+    lua_setfield(L, LUA_REGISTRYINDEX, kProfilerKey);
+    setCountHook(&sampleInstructions);
+    m_profiling = true;
+}
+
+void ScriptRunner::stopProfiling() {
+    if (!m_profiling) {
+        return;
+    }
+    setCountHook(&countInstructions);
+    lua_State* L = m_lua.lua_state();
+    lua_pushnil(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, kProfilerKey);
+    m_profiling = false;
+}
+
+void ScriptRunner::setCountHook(lua_Hook hook) {
+    // Coroutines made from here on take the main thread's hook; those
+    // already suspended keep their own until told
+    lua_sethook(m_lua.lua_state(), hook, LUA_MASKCOUNT, kInstructionHookInterval);
+    for (Task& task : m_tasks) {
+        lua_sethook(task.thread.thread_state(), hook, LUA_MASKCOUNT, kInstructionHookInterval);
+    }
+}
+
+bool ScriptRunner::collectStep(std::chrono::microseconds budget) {
+    // Start a new cycle only once the heap has grown by half (and at least 64 KiB)
+    constexpr std::size_t kMinGrowth = 64 * 1024;
+    const std::size_t live = m_arena.liveBytes();
+    if (!m_gcCycleActive && live < m_gcBaseline + std::max(kMinGrowth, m_gcBaseline / 2)) {
+        return false;
+    }
+    
+    // Small steps so the slice can stop close to its deadline
+    constexpr int kStepKilobytes = 16;
+    lua_State* L = m_lua.lua_state();
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + budget;
+    
+    bool finished = false;
+    m_gcCycleActive = true;
+    do {
+        finished = lua_gc(L, LUA_GCSTEP, kStepKilobytes) != 0;
+    } while (!finished && std::chrono::steady_clock::now() < deadline);
+    
+    const auto pause = std::chrono::steady_clock::now() - start;
+    ++m_gcStats.slices;
+    m_gcStats.totalPause += pause;
+    m_gcStats.maxPause = std::max<std::chrono::nanoseconds>(m_gcStats.maxPause, pause);
+    
+    if (finished) {
+        ++m_gcStats.cycles;
+        m_gcCycleActive = false;
+        m_gcBaseline = m_arena.liveBytes();
+    }
+    return finished;
+}
+
+std::vector<std::pair<std::string, ScriptRunner::ScriptStats>> ScriptRunner::stats() const {
+    std::vector<std::pair<std::string, ScriptStats>> result;
+    result.reserve(m_scripts.size());
+    for (const auto& script : m_scripts) {
+        result.emplace_back(script.name, script.stats);
+    }
+    return result;
+}
+
+std::expected<ScriptRunner::LoadedScript*, ScriptRunner::ScriptError> ScriptRunner::getScript(const std::string& name) {
+    // Single lookup; returns a pointer so the table is not copied
+    auto handle = resolve(name);
+    if (!handle) {
         std::cerr << std::format("Script command not found: {}", name) << std::endl;
-        return std::unexpected(ScriptError::CommandNotFound);
+        return std::unexpected(handle.error());
     }
     
-    return m_scripts[name];
+    return &m_scripts[*handle];
 }
 
 bool ScriptRunner::validateScript(const sol::table& script) const {
@@ -0,0 +1,366 @@
+#include "../include/ScriptRunnerPool.h"
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <thread>
+
+ScriptRunnerPool::ScriptRunnerPool(std::size_t size) {
+    size = std::max<std::size_t>(size, 1);
+    m_slots.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        m_slots.push_back(std::make_unique<Slot>());
+        m_slots.back()->runner.seedRandom(Random::kScriptStream + i);
+    }
+}
+
+std::size_t ScriptRunnerPool::defaultSize() {
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, 4);
+}
+
+template <typename Load>
+std::expected<ScriptHandle, ScriptRunnerPool::ScriptError> ScriptRunnerPool::loadEverywhere(
+    const std::string& name,
+    Load&& load
+) {
+    // Hold every state so no script runs against a partially loaded set
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(m_slots.size());
+    for (auto& slot : m_slots) {
+        locks.emplace_back(slot->mutex);
+    }
+
+    auto handle = load(primary().runner);
+    if (!handle) {
+        return handle;
+    }
+
+    for (std::size_t i = 1; i < m_slots.size(); ++i) {
+        auto replica = load(m_slots[i]->runner);
+        if (!replica || *replica != *handle) {
+            // Replicas must agree with the primary or the handle would name different scripts
+            std::cerr << std::format("Failed to load script {} into Lua state {}", name, i) << std::endl;
+            return std::unexpected(replica ? ScriptError::LoadFailed : replica.error());
+        }
+    }
+    return handle;
+}
+
+std::expected<ScriptHandle, ScriptRunnerPool::ScriptError> ScriptRunnerPool::loadScript(
+    const std::string& name,
+    const std::filesystem::path& scriptPath
+) {
+    return loadEverywhere(name, [&](ScriptRunner& runner) {
+        return runner.loadScript(name, scriptPath);
+    });
+}
+
+std::expected<ScriptHandle, ScriptRunnerPool::ScriptError> ScriptRunnerPool::loadCompiled(
+    const std::string& name,
+    const std::filesystem::path& scriptPath,
+    std::string_view bytecode,
+    std::filesystem::file_time_type modified
+) {
+    return loadEverywhere(name, [&](ScriptRunner& runner) {
+        return runner.loadCompiled(name, scriptPath, bytecode, modified);
+    });
+}
+
+std::unique_lock<std::mutex> ScriptRunnerPool::acquire(Slot*& slot) {
+    const std::size_t start = m_next.fetch_add(1, std::memory_order_relaxed) % m_slots.size();
+    for (std::size_t i = 0; i < m_slots.size(); ++i) {
+        Slot& candidate = *m_slots[(start + i) % m_slots.size()];
+        std::unique_lock<std::mutex> lock(candidate.mutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            slot = &candidate;
+            return lock;
+        }
+    }
+
+    slot = m_slots[start].get();
+    return std::unique_lock<std::mutex>(slot->mutex);
+}
+
+std::expected<void, ScriptRunnerPool::ScriptError> ScriptRunnerPool::run(
+    ScriptHandle handle,
+    std::string_view args,
+    std::string& output,
+    const ScriptPlayer* caller,
+    const CommandArgs* parsed
+) {
+    // Take any free state; purity is recorded identically in every state, so
+    // the one we hold can answer whether the script may stay on it
+    Slot* slot = nullptr;
+    auto lock = acquire(slot);
+    if (slot != &primary() && !slot->runner.isPure(handle)) {
+        lock.unlock();
+        slot = &primary();
+        lock = std::unique_lock<std::mutex>(slot->mutex);
+    }
+    return slot->runner.run(handle, args, output, caller, parsed);
+}
+
+std::expected<void, ScriptRunnerPool::ScriptError> ScriptRunnerPool::runBatch(
+    ScriptHandle handle,
+    std::span<const ScriptRunner::BatchCall> calls,
+    std::vector<std::expected<std::string, ScriptError>>& results
+) {
+    Slot* slot = nullptr;
+    auto lock = acquire(slot);
+    if (slot != &primary() && !slot->runner.isPure(handle)) {
+        lock.unlock();
+        slot = &primary();
+        lock = std::unique_lock<std::mutex>(slot->mutex);
+    }
+    return slot->runner.runBatch(handle, calls, results);
+}
+
+std::expected<std::string, ScriptRunnerPool::ScriptError> ScriptRunnerPool::runCommand(
+    const std::string& name,
+    std::string_view args
+) {
+    std::expected<ScriptHandle, ScriptError> handle;
+    {
+        std::lock_guard<std::mutex> lock(primary().mutex);
+        handle = primary().runner.resolve(name);
+    }
+    if (!handle) {
+        std::cerr << std::format("Script command not found: {}", name) << std::endl;
+        return std::unexpected(handle.error());
+    }
+
+    std::string output;
+    if (auto result = run(*handle, args, output); !result) {
+        return std::unexpected(result.error());
+    }
+    return output;
+}
+
+std::expected<std::string, ScriptRunnerPool::ScriptError> ScriptRunnerPool::getHelp(const std::string& name) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.getHelp(name);
+}
+
+std::expected<std::string, ScriptRunnerPool::ScriptError> ScriptRunnerPool::getDescription(const std::string& name) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.getDescription(name);
+}
+
+std::expected<std::string, ScriptRunnerPool::ScriptError> ScriptRunnerPool::getSyntax(const std::string& name) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.getSyntax(name);
+}
+
+bool ScriptRunnerPool::hasCommand(const std::string& name) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.hasCommand(name);
+}
+
+bool ScriptRunnerPool::hasHook(const std::string& name, const std::string& hookName) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.hasHook(name, hookName);
+}
+
+std::expected<bool, ScriptRunnerPool::ScriptError> ScriptRunnerPool::runHook(
+    const std::string& name,
+    const std::string& hookName,
+    std::string_view first,
+    std::string_view second
+) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.runHook(name, hookName, first, second);
+}
+
+void ScriptRunnerPool::emitEnterRoom(const ScriptPlayer& player, const ScriptRoom& room) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    primary().runner.emitEnterRoom(player, room);
+}
+
+void ScriptRunnerPool::emitTick(std::uint64_t tick) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    primary().runner.emitTick(tick);
+}
+
+void ScriptRunnerPool::emitSay(const ScriptPlayer& player, std::string_view message) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    primary().runner.emitSay(player, message);
+}
+
+void ScriptRunnerPool::emitCombatRound(const ScriptRoom& room, std::string_view report) {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    primary().runner.emitCombatRound(room, report);
+}
+
+void ScriptRunnerPool::setLazyLoading(bool enabled) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.setLazyLoading(enabled);
+    }
+}
+
+void ScriptRunnerPool::setModuleRoot(const std::filesystem::path& root) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.setModuleRoot(root);
+    }
+}
+
+void ScriptRunnerPool::setInstructionBudget(std::uint64_t instructions) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.setInstructionBudget(instructions);
+    }
+}
+
+void ScriptRunnerPool::setGcMode(ScriptRunner::GcMode mode) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.setGcMode(mode);
+    }
+}
+
+bool ScriptRunnerPool::collectIdle(std::chrono::microseconds budget) {
+    bool pending = false;
+    for (auto& slot : m_slots) {
+        std::unique_lock<std::mutex> lock(slot->mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            pending = true;
+            continue;
+        }
+        slot->runner.collectStep(budget);
+        pending = pending || slot->runner.collecting();
+    }
+    return pending;
+}
+
+ScriptRunner::GcStats ScriptRunnerPool::gcStats() {
+    ScriptRunner::GcStats total;
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        const auto stats = slot->runner.gcStats();
+        total.slices += stats.slices;
+        total.cycles += stats.cycles;
+        total.totalPause += stats.totalPause;
+        total.maxPause = std::max(total.maxPause, stats.maxPause);
+    }
+    return total;
+}
+
+std::chrono::steady_clock::time_point ScriptRunnerPool::resumeTasks(
+    std::chrono::steady_clock::time_point now,
+    std::vector<ScriptRunner::TaskResult>& finished
+) {
+    std::vector<std::string> events;
+    {
+        std::lock_guard<std::mutex> lock(m_signalMutex);
+        events.swap(m_signals);
+    }
+    
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        for (const auto& event : events) {
+            slot->runner.signal(event);
+        }
+        slot->runner.resumeTasks(now, finished);
+        next = std::min(next, slot->runner.nextWake());
+    }
+    return next;
+}
+
+void ScriptRunnerPool::signal(std::string event) {
+    std::lock_guard<std::mutex> lock(m_signalMutex);
+    m_signals.push_back(std::move(event));
+}
+
+void ScriptRunnerPool::cancelTasks(PlayerId player) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.cancelTasks(player);
+    }
+}
+
+std::size_t ScriptRunnerPool::suspendedTasks() {
+    std::size_t total = 0;
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        total += slot->runner.suspendedTasks();
+    }
+    return total;
+}
+
+void ScriptRunnerPool::setMemoryLimit(std::size_t bytesPerState) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.setMemoryLimit(bytesPerState);
+    }
+}
+
+void ScriptRunnerPool::startProfiling(std::uint32_t period) {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.startProfiling(period);
+    }
+}
+
+void ScriptRunnerPool::stopProfiling() {
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->runner.stopProfiling();
+    }
+}
+
+ScriptProfileTotals ScriptRunnerPool::foldProfiles(FoldedStacks& stacks) {
+    ScriptProfileTotals totals;
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        const ScriptProfiler* profiler = slot->runner.profiler();
+        if (!profiler) {
+            continue;
+        }
+        profiler->fold(stacks);
+        totals.samples += profiler->samples();
+        totals.dropped += profiler->dropped();
+        totals.running = totals.running || slot->runner.profiling();
+    }
+    return totals;
+}
+
+ScriptRunner::MemoryStats ScriptRunnerPool::memoryStats() {
+    ScriptRunner::MemoryStats total;
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        const auto stats = slot->runner.memoryStats();
+        total.liveBytes += stats.liveBytes;
+        total.peakBytes += stats.peakBytes;
+        total.limitBytes += stats.limitBytes;
+    }
+    return total;
+}
+
+std::uint64_t ScriptRunnerPool::instructionBudget() {
+    std::lock_guard<std::mutex> lock(primary().mutex);
+    return primary().runner.instructionBudget();
+}
+
+std::vector<std::pair<std::string, ScriptRunner::ScriptStats>> ScriptRunnerPool::stats() {
+    std::vector<std::pair<std::string, ScriptRunner::ScriptStats>> total;
+    for (auto& slot : m_slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        auto stats = slot->runner.stats();
+        
+        // Every state holds the same scripts in the same handle order
+        if (total.empty()) {
+            total = std::move(stats);
+            continue;
+        }
+        for (std::size_t i = 0; i < total.size() && i < stats.size(); ++i) {
+            auto& sum = total[i].second;
+            const auto& part = stats[i].second;
+            sum.calls += part.calls;
+            sum.instructions += part.instructions;
+            sum.wallTime += part.wallTime;
+            sum.budgetExceeded += part.budgetExceeded;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,235 @@
+#include "../include/ScriptStore.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'E', 'M', 'S', 'T', 'O', 'R', '1', '\n'};
+
+bool fits(std::string_view key, const ScriptValue& value) {
+    const auto* text = std::get_if<std::string>(&value);
+    return key.size() <= ScriptStore::kMaxKeyBytes && (!text || text->size() <= ScriptStore::kMaxStringBytes);
+}
+
+} // namespace
+
+std::optional<ScriptValue> ScriptStore::Space::get(std::string_view key) const {
+    const std::shared_lock lock(m_mutex);
+    const auto found = m_values.find(key);
+    if (found == m_values.end()) {
+        return std::nullopt;
+    }
+    return found->second;
+}
+
+bool ScriptStore::Space::set(std::string_view key, ScriptValue value) {
+    if (!fits(key, value)) {
+        return false;
+    }
+    {
+        const std::unique_lock lock(m_mutex);
+        if (const auto found = m_values.find(key); found != m_values.end()) {
+            if (found->second == value) {
+                return true;   // Nothing new to write
+            }
+            found->second = std::move(value);
+        } else {
+            m_values.emplace(std::string(key), std::move(value));
+        }
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool ScriptStore::Space::remove(std::string_view key) {
+    {
+        const std::unique_lock lock(m_mutex);
+        const auto found = m_values.find(key);
+        if (found == m_values.end()) {
+            return false;
+        }
+        m_values.erase(found);
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+std::optional<ScriptValue> ScriptStore::Space::add(std::string_view key, const ScriptValue& amount) {
+    if (std::holds_alternative<bool>(amount) || std::holds_alternative<std::string>(amount)
+        || key.size() > kMaxKeyBytes) {
+        return std::nullopt;
+    }
+    ScriptValue sum;
+    {
+        const std::unique_lock lock(m_mutex);
+        const auto [slot, added] = m_values.try_emplace(std::string(key), std::int64_t{0});
+        const ScriptValue& current = slot->second;
+        const auto* whole = std::get_if<std::int64_t>(&current);
+        const auto* amountWhole = std::get_if<std::int64_t>(&amount);
+        if (whole && amountWhole) {
+            // Wraps rather than overflowing, as Lua's integers do
+            sum = static_cast<std::int64_t>(static_cast<std::uint64_t>(*whole)
+                                            + static_cast<std::uint64_t>(*amountWhole));
+        } else if (whole || std::holds_alternative<double>(current)) {
+            const double base = whole ? static_cast<double>(*whole) : std::get<double>(current);
+            sum = base + (amountWhole ? static_cast<double>(*amountWhole) : std::get<double>(amount));
+        } else {
+            return std::nullopt;
+        }
+        slot->second = sum;
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+    return sum;
+}
+
+std::vector<std::string> ScriptStore::Space::keys() const {
+    std::vector<std::string> keys;
+    {
+        const std::shared_lock lock(m_mutex);
+        keys.reserve(m_values.size());
+        for (const auto& [key, value] : m_values) {
+            keys.push_back(key);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+std::size_t ScriptStore::Space::size() const {
+    const std::shared_lock lock(m_mutex);
+    return m_values.size();
+}
+
+ScriptStore::Space& ScriptStore::space(std::string_view name) {
+    const std::lock_guard lock(m_mutex);
+    if (const auto found = m_spaces.find(name); found != m_spaces.end()) {
+        return *found->second;
+    }
+    std::unique_ptr<Space> made(new Space(std::string(name), m_version));
+    Space& space = *made;
+    m_spaces.emplace(std::string(name), std::move(made));
+    return space;
+}
+
+const ScriptStore::Space* ScriptStore::find(std::string_view name) const {
+    const std::lock_guard lock(m_mutex);
+    const auto found = m_spaces.find(name);
+    return found != m_spaces.end() ? found->second.get() : nullptr;
+}
+
+std::size_t ScriptStore::values() const {
+    const std::lock_guard lock(m_mutex);
+    std::size_t total = 0;
+    for (const auto& [name, space] : m_spaces) {
+        total += space->size();
+    }
+    return total;
+}
+
+std::string ScriptStore::encode() const {
+    std::string table;
+    std::vector<SavedScriptEntry> entries;
+    {
+        const std::lock_guard lock(m_mutex);
+        for (const auto& [name, space] : m_spaces) {
+            const std::shared_lock values(space->m_mutex);
+            if (space->m_values.empty()) {
+                continue;
+            }
+            const SavedString spaceName = mapped::addString(table, name);
+            for (const auto& [key, value] : space->m_values) {
+                SavedScriptEntry& entry = entries.emplace_back();
+                entry.space = spaceName;
+                entry.key = mapped::addString(table, key);
+                entry.type = static_cast<std::uint32_t>(value.index());
+                if (const auto* flag = std::get_if<bool>(&value)) {
+                    entry.value = *flag ? 1 : 0;
+                } else if (const auto* whole = std::get_if<std::int64_t>(&value)) {
+                    entry.value = static_cast<std::uint64_t>(*whole);
+                } else if (const auto* number = std::get_if<double>(&value)) {
+                    entry.value = std::bit_cast<std::uint64_t>(*number);
+                } else {
+                    entry.value = std::bit_cast<std::uint64_t>(mapped::addString(table, std::get<std::string>(value)));
+                }
+            }
+        }
+    }
+
+    ScriptStoreHeader header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.headerSize = sizeof(ScriptStoreHeader);
+    std::string contents(sizeof(ScriptStoreHeader), '\0');
+    header.entries = mapped::append(contents, std::span<const SavedScriptEntry>(entries));
+    header.strings = mapped::append(contents, std::span<const char>(table));
+    if (contents.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return {};
+    }
+    header.fileSize = contents.size();
+    header.checksum = mapped::fnv1a(std::string_view(contents).substr(sizeof(ScriptStoreHeader)));
+    std::memcpy(contents.data(), &header, sizeof header);
+    return contents;
+}
+
+bool ScriptStore::decode(std::string_view bytes) {
+    if (bytes.size() < sizeof(ScriptStoreHeader)
+        || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(ScriptStoreHeader) != 0) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const ScriptStoreHeader*>(bytes.data());
+    if (header->magic != kMagic || header->version != kVersion || header->headerSize < sizeof(ScriptStoreHeader)
+        || header->headerSize > bytes.size() || header->fileSize != bytes.size()
+        || header->checksum != mapped::fnv1a(bytes.substr(header->headerSize))) {
+        return false;
+    }
+    const char* strings = mapped::section<char>(bytes, header->strings);
+    const SavedScriptEntry* entries = mapped::section<SavedScriptEntry>(bytes, header->entries);
+    if (!strings || !entries) {
+        return false;
+    }
+    const std::size_t tableSize = header->strings.count;
+    const auto text = [&](SavedString ref) { return std::string_view(strings + ref.offset, ref.size); };
+
+    // Read into a map of its own first, so a bad entry leaves the store alone
+    std::unordered_map<std::string, std::unordered_map<std::string, ScriptValue, Space::Hash, std::equal_to<>>,
+                       Space::Hash, std::equal_to<>> loaded;
+    for (const SavedScriptEntry& entry : std::span(entries, header->entries.count)) {
+        if (!mapped::inTable(entry.space, tableSize) || !mapped::inTable(entry.key, tableSize)) {
+            return false;
+        }
+        ScriptValue value;
+        switch (entry.type) {
+            case 0: value = entry.value != 0; break;
+            case 1: value = static_cast<std::int64_t>(entry.value); break;
+            case 2: value = std::bit_cast<double>(entry.value); break;
+            case 3: {
+                const auto ref = std::bit_cast<SavedString>(entry.value);
+                if (!mapped::inTable(ref, tableSize)) {
+                    return false;
+                }
+                value = std::string(text(ref));
+                break;
+            }
+            default: return false;
+        }
+        loaded[std::string(text(entry.space))].insert_or_assign(std::string(text(entry.key)), std::move(value));
+    }
+
+    const std::lock_guard lock(m_mutex);
+    for (const auto& [name, space] : m_spaces) {
+        const std::unique_lock values(space->m_mutex);
+        space->m_values.clear();
+    }
+    for (auto& [name, values] : loaded) {
+        auto found = m_spaces.find(name);
+        if (found == m_spaces.end()) {
+            found = m_spaces.emplace(name, std::unique_ptr<Space>(new Space(name, m_version))).first;
+        }
+        const std::unique_lock guard(found->second->m_mutex);
+        found->second->m_values = std::move(values);
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+    return true;
+}
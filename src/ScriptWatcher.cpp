@@ -0,0 +1,304 @@
+#include "../include/ScriptWatcher.h"
+#include "../include/ScriptRunner.h"
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <memory>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+ScriptWatcher::ScriptWatcher(bool writeBytecodeCache)
+    : m_writeCache(writeBytecodeCache) {
+}
+
+ScriptWatcher::~ScriptWatcher() {
+    stop();
+}
+
+std::filesystem::path ScriptWatcher::normalize(const std::filesystem::path& path) {
+    std::error_code ec;
+    auto absolute = std::filesystem::absolute(path, ec);
+    return (ec ? path : absolute).lexically_normal();
+}
+
+void ScriptWatcher::watch(const std::filesystem::path& scriptPath) {
+    auto file = normalize(scriptPath);
+    auto directory = file.parent_path();
+    
+    if (std::find(m_files.begin(), m_files.end(), file) == m_files.end()) {
+        m_files.push_back(std::move(file));
+    }
+    if (std::find(m_directories.begin(), m_directories.end(), directory) == m_directories.end()) {
+        m_directories.push_back(std::move(directory));
+    }
+}
+
+std::vector<ScriptWatcher::CompiledScript> ScriptWatcher::takeCompiled() {
+    std::vector<CompiledScript> compiled;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    compiled.swap(m_compiled);
+    m_pending.store(false, std::memory_order_release);
+    return compiled;
+}
+
+void ScriptWatcher::fileChanged(sol::state& compiler, const std::filesystem::path& path) {
+    auto file = path.lexically_normal();
+    if (std::find(m_files.begin(), m_files.end(), file) == m_files.end()) {
+        return;
+    }
+    
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(file, ec);
+    if (ec) {
+        // Removed or renamed away; keep running the version already loaded
+        return;
+    }
+    
+    auto bytecode = ScriptRunner::compileToBytecode(compiler, file, modified, m_writeCache);
+    if (!bytecode) {
+        // A half-written file fails to compile; the next write notification retries
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_compiled.begin(), m_compiled.end(),
+                           [&](const CompiledScript& pending) { return pending.path == file; });
+    if (it != m_compiled.end()) {
+        it->modified = modified;
+        it->bytecode = std::move(*bytecode);
+    } else {
+        m_compiled.push_back({file, modified, std::move(*bytecode)});
+    }
+    m_pending.store(true, std::memory_order_release);
+}
+
+#if defined(_WIN32)
+
+bool ScriptWatcher::start() {
+    if (m_thread.joinable()) {
+        return true;
+    }
+    if (m_directories.empty()) {
+        return false;
+    }
+    
+    m_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!m_stopEvent) {
+        return false;
+    }
+    
+    m_thread = std::thread(&ScriptWatcher::run, this);
+    return true;
+}
+
+void ScriptWatcher::stop() {
+    if (m_thread.joinable()) {
+        SetEvent(static_cast<HANDLE>(m_stopEvent));
+        m_thread.join();
+    }
+    if (m_stopEvent) {
+        CloseHandle(static_cast<HANDLE>(m_stopEvent));
+        m_stopEvent = nullptr;
+    }
+}
+
+void ScriptWatcher::run() {
+    struct DirectoryWatch {
+        std::filesystem::path path;
+        HANDLE directory = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped{};
+        alignas(DWORD) char buffer[16 * 1024];
+    };
+    
+    auto issue = [](DirectoryWatch& watch) {
+        return ReadDirectoryChangesW(watch.directory, watch.buffer, sizeof(watch.buffer), FALSE,
+                                     FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+                                     nullptr, &watch.overlapped, nullptr) != FALSE;
+    };
+    
+    // The stop event is always the first handle waited on
+    std::vector<std::unique_ptr<DirectoryWatch>> watches;
+    std::vector<HANDLE> handles{static_cast<HANDLE>(m_stopEvent)};
+    for (const auto& path : m_directories) {
+        if (handles.size() >= MAXIMUM_WAIT_OBJECTS) {
+            break;
+        }
+        
+        auto watch = std::make_unique<DirectoryWatch>();
+        watch->path = path;
+        watch->directory = CreateFileW(path.c_str(), FILE_LIST_DIRECTORY,
+                                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                       OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (watch->directory == INVALID_HANDLE_VALUE) {
+            std::cerr << std::format("Cannot watch script directory {}", path.string()) << std::endl;
+            continue;
+        }
+        watch->overlapped.hEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        if (!watch->overlapped.hEvent || !issue(*watch)) {
+            if (watch->overlapped.hEvent) {
+                CloseHandle(watch->overlapped.hEvent);
+            }
+            CloseHandle(watch->directory);
+            continue;
+        }
+        handles.push_back(watch->overlapped.hEvent);
+        watches.push_back(std::move(watch));
+    }
+    
+    sol::state compiler;
+    while (true) {
+        DWORD signalled = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+        if (signalled == WAIT_OBJECT_0 || signalled < WAIT_OBJECT_0 || signalled >= WAIT_OBJECT_0 + handles.size()) {
+            break;
+        }
+        
+        DirectoryWatch& watch = *watches[signalled - WAIT_OBJECT_0 - 1];
+        DWORD bytes = 0;
+        std::vector<std::filesystem::path> changed;
+        if (GetOverlappedResult(watch.directory, &watch.overlapped, &bytes, FALSE) && bytes > 0) {
+            auto* info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(watch.buffer);
+            while (true) {
+                if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED ||
+                    info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+                    changed.push_back(watch.path / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+                }
+                if (info->NextEntryOffset == 0) {
+                    break;
+                }
+                info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(reinterpret_cast<char*>(info) + info->NextEntryOffset);
+            }
+        }
+        issue(watch);
+        
+        // Editors often report one save as several writes
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        for (const auto& path : changed) {
+            fileChanged(compiler, path);
+        }
+    }
+    
+    for (auto& watch : watches) {
+        DWORD bytes = 0;
+        CancelIoEx(watch->directory, &watch->overlapped);
+        GetOverlappedResult(watch->directory, &watch->overlapped, &bytes, TRUE);
+        CloseHandle(watch->overlapped.hEvent);
+        CloseHandle(watch->directory);
+    }
+}
+
+#elif defined(__linux__)
+
+bool ScriptWatcher::start() {
+    if (m_thread.joinable()) {
+        return true;
+    }
+    if (m_directories.empty()) {
+        return false;
+    }
+    
+    m_notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_notifyFd < 0 || m_wakeFd < 0) {
+        stop();
+        return false;
+    }
+    
+    // Writes in place finish with IN_CLOSE_WRITE; editors that save via rename produce IN_MOVED_TO
+    m_watches.clear();
+    for (const auto& directory : m_directories) {
+        int watch = inotify_add_watch(m_notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch < 0) {
+            std::cerr << std::format("Cannot watch script directory {}", directory.string()) << std::endl;
+        }
+        m_watches.push_back(watch);
+    }
+    
+    m_thread = std::thread(&ScriptWatcher::run, this);
+    return true;
+}
+
+void ScriptWatcher::stop() {
+    if (m_thread.joinable()) {
+        const std::uint64_t wake = 1;
+        [[maybe_unused]] auto written = write(m_wakeFd, &wake, sizeof(wake));
+        m_thread.join();
+    }
+    if (m_notifyFd >= 0) {
+        close(m_notifyFd);
+        m_notifyFd = -1;
+    }
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+}
+
+void ScriptWatcher::run() {
+    alignas(inotify_event) char buffer[4096];
+    pollfd fds[2] = {
+        {m_notifyFd, POLLIN, 0},
+        {m_wakeFd, POLLIN, 0}
+    };
+    
+    sol::state compiler;
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+        
+        std::vector<std::filesystem::path> changed;
+        ssize_t length;
+        while ((length = read(m_notifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + length; ) {
+                auto* event = reinterpret_cast<inotify_event*>(p);
+                auto watch = std::find(m_watches.begin(), m_watches.end(), event->wd);
+                if (event->len > 0 && watch != m_watches.end()) {
+                    changed.push_back(m_directories[watch - m_watches.begin()] / event->name);
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        for (const auto& path : changed) {
+            fileChanged(compiler, path);
+        }
+    }
+}
+
+#else
+
+// No change-notification backend on this platform; scripts load once at startup
+bool ScriptWatcher::start() {
+    return false;
+}
+
+void ScriptWatcher::stop() {
+}
+
+void ScriptWatcher::run() {
+}
+
+#endif
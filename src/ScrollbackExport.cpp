@@ -0,0 +1,170 @@
+#include "../include/ScrollbackExport.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#if defined(ENABLE_EXPORT_GZIP)
+    #include <zlib.h>
+#endif
+
+namespace {
+
+// A file taking whole blocks, compressed or not; every failure is kept as text
+class BlockFile {
+public:
+    BlockFile(const std::filesystem::path& path, bool compress) {
+#if defined(ENABLE_EXPORT_GZIP)
+        if (compress) {
+            m_gz = gzopen(path.string().c_str(), "wb");
+            if (m_gz) {
+                gzbuffer(m_gz, ScrollbackExport::kBlockSize);
+            } else {
+                fail("cannot open");
+            }
+            return;
+        }
+#else
+        (void)compress;
+#endif
+        m_file = std::fopen(path.string().c_str(), "wb");
+        if (m_file) {
+            // Blocks are already large; stdio's buffer would only add a copy
+            std::setvbuf(m_file, nullptr, _IONBF, 0);
+        } else {
+            fail("cannot open");
+        }
+    }
+
+    ~BlockFile() { close(); }
+
+    BlockFile(const BlockFile&) = delete;
+    BlockFile& operator=(const BlockFile&) = delete;
+
+    bool write(std::string_view bytes) {
+        if (!m_error.empty() || bytes.empty()) return m_error.empty();
+#if defined(ENABLE_EXPORT_GZIP)
+        if (m_gz) {
+            if (gzwrite(m_gz, bytes.data(), static_cast<unsigned>(bytes.size())) != static_cast<int>(bytes.size())) {
+                int code = Z_OK;
+                m_error = std::string("write failed: ") + gzerror(m_gz, &code);
+            }
+            return m_error.empty();
+        }
+#endif
+        if (std::fwrite(bytes.data(), 1, bytes.size(), m_file) != bytes.size()) {
+            fail("write failed");
+        }
+        return m_error.empty();
+    }
+
+    bool close() {
+#if defined(ENABLE_EXPORT_GZIP)
+        if (m_gz) {
+            if (gzclose(m_gz) != Z_OK && m_error.empty()) {
+                m_error = "write failed on close";
+            }
+            m_gz = nullptr;
+        }
+#endif
+        if (m_file) {
+            if (std::fclose(m_file) != 0) {
+                fail("write failed on close");
+            }
+            m_file = nullptr;
+        }
+        return m_error.empty();
+    }
+
+    const std::string& error() const noexcept { return m_error; }
+
+private:
+    void fail(std::string_view what) {
+        if (m_error.empty()) {
+            m_error = std::string(what) + ": " + std::strerror(errno);
+        }
+    }
+
+    std::FILE* m_file = nullptr;
+#if defined(ENABLE_EXPORT_GZIP)
+    gzFile m_gz = nullptr;
+#endif
+    std::string m_error;
+};
+
+} // namespace
+
+ScrollbackExport::ScrollbackExport(std::filesystem::path path, Snapshot snapshot, Done done)
+    : m_path(std::move(path))
+    , m_snapshot(std::move(snapshot))
+    , m_done(std::move(done)) {
+    m_thread = std::thread([this] {
+        const auto result = write();
+        // Let the chunks go before reporting, so the arena can recycle them
+        m_snapshot = {};
+        if (m_done) {
+            m_done(m_path, result);
+        }
+        m_finished.store(true, std::memory_order_release);
+    });
+}
+
+ScrollbackExport::~ScrollbackExport() {
+    m_thread.join();
+}
+
+bool ScrollbackExport::compressionAvailable() noexcept {
+#if defined(ENABLE_EXPORT_GZIP)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::expected<ScrollbackExport::Result, std::string> ScrollbackExport::write() const {
+    Result result;
+    result.compressed = m_path.extension() == ".gz";
+    if (result.compressed && !compressionAvailable()) {
+        return std::unexpected("this build cannot compress (no zlib)");
+    }
+
+    // Written beside the target and renamed over it, so a failed export
+    // never leaves half a file under the name asked for
+    std::filesystem::path temporary = m_path;
+    temporary += ".tmp";
+    BlockFile file(temporary, result.compressed);
+
+    std::string block;
+    block.reserve(kBlockSize);
+    for (const std::string_view line : m_snapshot.lines) {
+        if (block.size() + line.size() + 1 > kBlockSize && !block.empty()) {
+            if (!file.write(block)) break;
+            block.clear();
+        }
+        if (line.size() >= kBlockSize) {
+            // Too long to gather; goes out on its own
+            if (!file.write(line)) break;
+        } else {
+            block.append(line);
+        }
+        block.push_back('\n');
+        ++result.lines;
+        result.bytes += line.size() + 1;
+    }
+    file.write(block);
+
+    std::error_code error;
+    if (!file.close()) {
+        std::filesystem::remove(temporary, error);
+        return std::unexpected(file.error());
+    }
+    result.fileBytes = std::filesystem::file_size(temporary, error);
+    std::filesystem::rename(temporary, m_path, error);
+    if (error) {
+        std::string reason = "cannot rename into place: " + error.message();
+        std::filesystem::remove(temporary, error);
+        return std::unexpected(std::move(reason));
+    }
+    return result;
+}
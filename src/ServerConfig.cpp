@@ -0,0 +1,101 @@
+#include "../include/ServerConfig.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+template <typename Number>
+bool parseNumber(std::string_view text, Number& out) {
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+// Store value under key into config; false for an unknown key or bad value
+bool assign(ServerConfig& config, std::string_view key, std::string_view value) {
+    std::uint64_t number = 0;
+    if (key == "slow_clients") {
+        if (value == "drop") {
+            config.slowClients = SlowClientPolicy::DropOutput;
+        } else if (value == "disconnect") {
+            config.slowClients = SlowClientPolicy::Disconnect;
+        } else {
+            return false;
+        }
+        return true;
+    }
+    if (!parseNumber(value, number)) {
+        return false;
+    }
+    if (key == "rate_limit") {
+        config.rateLimit = static_cast<std::uint32_t>(std::min<std::uint64_t>(number, UINT32_MAX));
+    } else if (key == "save_interval_ms" && number > 0) {
+        config.saveInterval = std::chrono::milliseconds(number);
+    } else if (key == "checkpoint_interval_ms" && number > 0) {
+        config.checkpointInterval = std::chrono::milliseconds(number);
+    } else if (key == "stats_interval_s") {
+        config.statsInterval = std::chrono::seconds(number);
+    } else if (key == "idle_budget_ms") {
+        config.idleBudget = std::chrono::milliseconds(number);
+    } else if (key == "output_high_water" && number > 0) {
+        config.outputHighWater = static_cast<std::size_t>(number);
+    } else if (key == "idle_compaction_s") {
+        config.idleCompaction = std::chrono::seconds(number);
+    } else if (key == "connections_per_ip") {
+        config.connectionsPerIp = static_cast<std::uint32_t>(std::min<std::uint64_t>(number, UINT32_MAX));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::expected<ServerConfig, std::string> ServerConfig::parse(std::string_view text, const ServerConfig& base) {
+    ServerConfig config = base;
+    std::size_t lineNumber = 0;
+    while (!text.empty()) {
+        const std::size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+        ++lineNumber;
+
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        const std::size_t equals = line.find('=');
+        if (equals == std::string_view::npos) {
+            return std::unexpected(std::format("line {}: '{}' is not key = value", lineNumber, line));
+        }
+        const std::string_view key = trim(line.substr(0, equals));
+        const std::string_view value = trim(line.substr(equals + 1));
+        if (!assign(config, key, value)) {
+            return std::unexpected(std::format("line {}: bad setting {} = {}", lineNumber, key, value));
+        }
+    }
+    return config;
+}
+
+std::expected<ServerConfig, std::string> ServerConfig::load(const std::filesystem::path& path,
+                                                            const ServerConfig& base) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return std::unexpected(std::format("cannot open {}", path.string()));
+    }
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (in.bad()) {
+        return std::unexpected(std::format("cannot read {}", path.string()));
+    }
+    return parse(text, base);
+}
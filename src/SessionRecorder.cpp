@@ -0,0 +1,56 @@
+#include "../include/SessionRecorder.h"
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Where the recorder carries on numbering, past what the directory holds
+std::uint64_t nextSequence(const std::filesystem::path& directory) {
+    return Journal::recover(directory, [](std::string_view, std::uint64_t, std::string_view) {}).nextSequence;
+}
+
+} // namespace
+
+SessionRecorder::SessionRecorder(std::filesystem::path directory, TickScheduler& ticks)
+    : m_ticks(ticks)
+    , m_journal(directory, nextSequence(directory), JournalSync::Never) {
+    // The recording before this one goes as soon as the writer gets to it
+    m_journal.release(m_journal.nextSequence() - 1);
+    m_update = m_ticks.addUpdate(1, [this](std::uint64_t) { append(RecordedKind::Tick, {}, {}); });
+}
+
+SessionRecorder::~SessionRecorder() {
+    m_ticks.removeUpdate(m_update);
+}
+
+void SessionRecorder::append(RecordedKind kind, std::string_view name, std::string_view line) {
+    RecordedHeader header;
+    header.tick = m_ticks.tickCount();
+    header.boundary = m_ticks.boundary();
+    header.kind = kind;
+    header.inTick = m_ticks.ticking() ? 1 : 0;
+    m_payload.assign(reinterpret_cast<const char*>(&header), sizeof header);
+    m_payload.append(line);
+    m_journal.append(name, m_payload);
+}
+
+std::uint64_t SessionRecorder::read(const std::filesystem::path& directory,
+                                    const std::function<void(const RecordedEvent&)>& apply) {
+    std::uint64_t events = 0;
+    Journal::recover(directory, [&](std::string_view key, std::uint64_t, std::string_view payload) {
+        if (payload.size() < sizeof(RecordedHeader)) {
+            return;
+        }
+        RecordedEvent event;
+        std::memcpy(&event.header, payload.data(), sizeof event.header);
+        if (event.header.kind > RecordedKind::Leave) {
+            return;
+        }
+        event.name = key;
+        event.line = payload.substr(sizeof event.header);
+        apply(event);
+        ++events;
+    });
+    return events;
+}
@@ -0,0 +1,220 @@
+#include "../include/ShardLink.h"
+#include "../include/SocketUtil.h"
+#include <cerrno>
+#include <string_view>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+std::expected<sockaddr_in, NetError> resolve(const std::string& address, std::uint16_t port) {
+    sockaddr_in to{};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &to.sin_addr) != 1) {
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    return to;
+}
+
+} // namespace
+
+std::expected<int, NetError> ShardLink::listen(const std::string& address, std::uint16_t port) {
+    const auto bound = resolve(address, port);
+    if (!bound) {
+        return std::unexpected(bound.error());
+    }
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || !SocketUtil::setNonBlocking(fd)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&*bound), sizeof(*bound)) != 0) {
+        ::close(fd);
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    if (::listen(fd, 16) != 0) {
+        ::close(fd);
+        return std::unexpected(NetError::LISTEN_FAILED);
+    }
+    return fd;
+}
+
+std::expected<std::unique_ptr<ShardLink>, NetError> ShardLink::connect(const std::string& address, std::uint16_t port,
+                                                                       std::chrono::milliseconds timeout) {
+    const auto to = resolve(address, port);
+    if (!to) {
+        return std::unexpected(to.error());
+    }
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || !SocketUtil::setNonBlocking(fd)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    // Non-blocking, so a shard host that is down costs no more than the timeout
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&*to), sizeof(*to)) != 0) {
+        pollfd writable{fd, POLLOUT, 0};
+        int error = 0;
+        socklen_t size = sizeof(error);
+        if (errno != EINPROGRESS || ::poll(&writable, 1, static_cast<int>(timeout.count())) != 1 ||
+            ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != 0 || error != 0) {
+            ::close(fd);
+            return std::unexpected(NetError::SOCKET_FAILED);
+        }
+    }
+    return std::make_unique<ShardLink>(fd);
+}
+
+ShardLink::ShardLink(int fd)
+    : m_fd(fd) {
+    SocketUtil::setNonBlocking(m_fd);
+    // Frames are small and a player is waiting on each
+    const int on = 1;
+    ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+ShardLink::~ShardLink() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+void ShardLink::send(ShardMessageKind kind, std::uint16_t shard, std::uint64_t session, std::string_view name,
+                     std::initializer_list<std::string_view> body) {
+    ShardMessageHeader header;
+    header.size = static_cast<std::uint32_t>(sizeof(header) + name.size());
+    for (const std::string_view part : body) {
+        header.size += static_cast<std::uint32_t>(part.size());
+    }
+    header.kind = static_cast<std::uint8_t>(kind);
+    header.shard = shard;
+    header.session = session;
+    header.nameSize = static_cast<std::uint32_t>(name.size());
+    reserve(header.size);
+    m_out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_out.append(name);
+    for (const std::string_view part : body) {
+        m_out.append(part);
+    }
+}
+
+void ShardLink::forward(const ShardMessage& message) {
+    reserve(message.bytes().size());
+    m_out.append(message.bytes());
+}
+
+void ShardLink::reserve(std::size_t size) {
+    // A message too big to share a batch gets one of its own
+    if (m_count > 0 && m_out.size() - m_batch + size > kBatchBytes) {
+        seal();
+    }
+    if (m_count == 0) {
+        m_batch = m_out.size();
+        m_out.append(sizeof(ShardBatchHeader), '\0');
+    }
+    ++m_count;
+}
+
+void ShardLink::seal() noexcept {
+    if (m_count == 0) {
+        return;
+    }
+    const ShardBatchHeader header{static_cast<std::uint32_t>(m_out.size() - m_batch), m_count};
+    std::memcpy(m_out.data() + m_batch, &header, sizeof(header));
+    m_count = 0;
+}
+
+bool ShardLink::flush() {
+    seal();
+    while (m_written < m_out.size()) {
+        const ssize_t sent = ::send(m_fd, m_out.data() + m_written, m_out.size() - m_written, SocketUtil::kSendFlags);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        m_written += static_cast<std::size_t>(sent);
+    }
+    // Keep what is left at the front, without moving it every call
+    if (m_written == m_out.size()) {
+        m_out.clear();
+        m_written = 0;
+    } else if (m_written > 64 * 1024) {
+        m_out.erase(0, m_written);
+        m_written = 0;
+    }
+    return true;
+}
+
+bool ShardLink::receive(std::vector<ShardMessage>& messages) {
+    // The views handed out last time are done with
+    messages.clear();
+    m_in.erase(0, m_consumed);
+    m_consumed = 0;
+
+    char buffer[64 * 1024];
+    bool open = true;
+    while (open) {
+        const ssize_t got = ::recv(m_fd, buffer, sizeof(buffer), 0);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (got <= 0) {
+            // Whatever came before the end still counts
+            open = false;
+            break;
+        }
+        m_in.append(buffer, static_cast<std::size_t>(got));
+    }
+
+    const std::string_view in = m_in;
+    while (in.size() - m_consumed >= sizeof(ShardBatchHeader)) {
+        ShardBatchHeader batch;
+        std::memcpy(&batch, in.data() + m_consumed, sizeof(batch));
+        if (batch.size < sizeof(batch) || batch.size > kMaxFrame) {
+            return false;
+        }
+        if (in.size() - m_consumed < batch.size) {
+            break;
+        }
+        // Every message checked to lie inside its batch, so the views never reach past it
+        std::size_t offset = m_consumed + sizeof(batch);
+        const std::size_t end = m_consumed + batch.size;
+        for (std::uint32_t i = 0; i < batch.count; ++i) {
+            ShardMessageHeader header;
+            if (end - offset < sizeof(header)) {
+                return false;
+            }
+            std::memcpy(&header, in.data() + offset, sizeof(header));
+            if (header.size < sizeof(header) || header.size > end - offset ||
+                header.nameSize > header.size - sizeof(header) ||
+                header.kind >= static_cast<std::uint8_t>(ShardMessageKind::Count)) {
+                return false;
+            }
+            messages.emplace_back(in.substr(offset, header.size));
+            offset += header.size;
+        }
+        if (offset != end) {
+            return false;
+        }
+        m_consumed = end;
+    }
+    return open;
+}
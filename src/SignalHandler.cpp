@@ -1,44 +1,96 @@
 #include "../include/SignalHandler.h"
+#include "../include/Logger.h"
+#include <cerrno>
 #include <csignal>
 #include <unordered_map>
 #include <mutex>
 #include <functional>
-#include <iostream>
-#include <format>
 #include <expected>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // Initialize static members
 std::unordered_map<int, SignalHandler::SignalCallback> SignalHandler::s_signalCallbacks;
 std::mutex SignalHandler::s_signalMutex;
+std::array<std::atomic<bool>, SignalHandler::kMaxSignal> SignalHandler::s_pending{};
+std::atomic<bool> SignalHandler::s_anyPending{false};
+std::array<std::atomic<int>, 2> SignalHandler::s_pipe{-1, -1};
 
 // Global signal handler that routes signals to our handler class
-void signalRouter(int signal) {
+extern "C" void signalRouter(int signal) {
     SignalHandler::handleSignal(signal);
 }
 
+namespace {
+
+// Install or restore the process-wide disposition of a signal
+bool setDisposition(int signal, void (*handler)(int)) {
+#ifndef _WIN32
+    // SA_RESTART: a signal costs the thread it lands on a pipe write, not
+    // an EINTR in whatever it was doing
+    struct sigaction action{};
+    action.sa_handler = handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = handler == SIG_DFL ? 0 : SA_RESTART;
+    return sigaction(signal, &action, nullptr) == 0;
+#else
+    return std::signal(signal, handler) != SIG_ERR;
+#endif
+}
+
+} // namespace
+
+// Create the self-pipe once; it lives as long as the process. Called under s_signalMutex
+bool SignalHandler::openPipe() {
+#ifndef _WIN32
+    if (s_pipe[0].load(std::memory_order_relaxed) >= 0) {
+        return true;
+    }
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    for (int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    s_pipe[1].store(fds[1], std::memory_order_release);
+    s_pipe[0].store(fds[0], std::memory_order_release);
+#endif
+    return true;
+}
+
 std::expected<void, SignalError> SignalHandler::registerHandler(int signal, SignalCallback callback) {
-    if (signal <= 0) {
+    if (signal <= 0 || signal >= kMaxSignal) {
         return std::unexpected(SignalError::InvalidSignal);
     }
-    
+
     if (!callback) {
         return std::unexpected(SignalError::CallbackError);
     }
-    
+
     try {
         // Lock during modification
         std::lock_guard<std::mutex> lock(s_signalMutex);
-        
+
+        // Without the pipe a signal would still be recorded, but a loop
+        // sleeping in poll() would not hear of it
+        if (!openPipe()) {
+            return std::unexpected(SignalError::RegisterFailed);
+        }
+
         // Register the callback
         s_signalCallbacks[signal] = std::move(callback);
-        
+
         // Set up the signal handler to point to our router
-        if (std::signal(signal, signalRouter) == SIG_ERR) {
+        if (!setDisposition(signal, signalRouter)) {
             // Revert our registration on failure
             s_signalCallbacks.erase(signal);
             return std::unexpected(SignalError::RegisterFailed);
         }
-        
+
         return {};  // Success
     } catch (...) {
         return std::unexpected(SignalError::RegisterFailed);
@@ -46,62 +98,100 @@ std::expected<void, SignalError> SignalHandler::registerHandler(int signal, Sign
 }
 
 std::expected<void, SignalError> SignalHandler::unregisterHandler(int signal) {
-    if (signal <= 0) {
+    if (signal <= 0 || signal >= kMaxSignal) {
         return std::unexpected(SignalError::InvalidSignal);
     }
-    
+
     try {
         // Lock during modification
         std::lock_guard<std::mutex> lock(s_signalMutex);
-        
+
         // Check if we have this signal registered
         if (s_signalCallbacks.find(signal) == s_signalCallbacks.end()) {
             // Nothing to unregister
             return {};
         }
-        
+
         // Remove the callback
         s_signalCallbacks.erase(signal);
-        
-        // Reset the signal handler to default
-        if (std::signal(signal, SIG_DFL) == SIG_ERR) {
+
+        // Reset the signal handler to default; one already received is dropped
+        if (!setDisposition(signal, SIG_DFL)) {
             return std::unexpected(SignalError::UnregisterFailed);
         }
-        
+        s_pending[signal].store(false, std::memory_order_relaxed);
+
         return {};  // Success
     } catch (...) {
         return std::unexpected(SignalError::UnregisterFailed);
     }
 }
 
-void SignalHandler::handleSignal(int signal) {
-    try {
-        // Lock during access - use try_lock to avoid deadlocks in signal handlers
-        std::unique_lock<std::mutex> lock(s_signalMutex, std::try_to_lock);
-        if (!lock.owns_lock()) {
-            // If we can't get the lock, log and return
-            std::cerr << std::format("Warning: Signal {} received but mutex is locked", signal) << std::endl;
-            return;
+// Runs in the signal handler: only lock-free stores and write(2)
+void SignalHandler::handleSignal(int signal) noexcept {
+    if (signal <= 0 || signal >= kMaxSignal) {
+        return;
+    }
+#ifdef _WIN32
+    // Windows resets the disposition before calling the handler
+    std::signal(signal, signalRouter);
+#endif
+    s_pending[signal].store(true, std::memory_order_relaxed);
+    s_anyPending.store(true, std::memory_order_release);
+
+#ifndef _WIN32
+    const int fd = s_pipe[1].load(std::memory_order_acquire);
+    if (fd >= 0) {
+        // A full pipe already guarantees a wakeup, and the flag above keeps
+        // the signal, so a failed write is fine
+        const int savedErrno = errno;
+        const unsigned char number = static_cast<unsigned char>(signal);
+        [[maybe_unused]] const auto written = write(fd, &number, 1);
+        errno = savedErrno;
+    }
+#endif
+}
+
+bool SignalHandler::dispatchPending() {
+    if (!s_anyPending.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
+
+#ifndef _WIN32
+    // The bytes are only a wakeup; the flags say which signals arrived
+    const int fd = s_pipe[0].load(std::memory_order_acquire);
+    if (fd >= 0) {
+        unsigned char drain[64];
+        while (read(fd, drain, sizeof(drain)) > 0) {
         }
-        
-        // Find and call the callback if it exists
-        auto it = s_signalCallbacks.find(signal);
-        if (it != s_signalCallbacks.end() && it->second) {
-            try {
-                // Call the registered callback
-                it->second();
-            } 
-            catch (const std::exception& e) {
-                // Log exception from signal handler, but don't rethrow
-                // as that would be unsafe in a signal handler
-                std::cerr << std::format("Exception in signal handler {}: {}", signal, e.what()) << std::endl;
-            }
-            catch (...) {
-                std::cerr << std::format("Unknown exception in signal handler {}", signal) << std::endl;
+    }
+#endif
+
+    bool ran = false;
+    for (int signal = 1; signal < kMaxSignal; ++signal) {
+        if (!s_pending[signal].exchange(false, std::memory_order_relaxed)) {
+            continue;
+        }
+
+        // Copy the callback so it may register or unregister handlers itself
+        SignalCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(s_signalMutex);
+            auto it = s_signalCallbacks.find(signal);
+            if (it == s_signalCallbacks.end()) {
+                continue;
             }
+            callback = it->second;
+        }
+
+        try {
+            callback();
+            ran = true;
+        } catch (const std::exception& e) {
+            LOG_WARN("Exception in handler for signal {}: {}", signal, e.what());
+        } catch (...) {
+            LOG_WARN("Unknown exception in handler for signal {}", signal);
         }
-    } catch (...) {
-        // Log error but continue - we're in a signal handler so we must be careful
-        std::cerr << std::format("Critical error in signal handler for signal {}", signal) << std::endl;
     }
-} 
\ No newline at end of file
+    return ran;
+}
@@ -0,0 +1,321 @@
+#include "../include/Socials.h"
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace {
+
+constexpr std::array<std::string_view, kSocialViewCount> kViewKeywords = {
+    "alone", "alone-room", "actor", "target", "room", "self", "self-room"
+};
+
+// What the engine starts with; lines name people rather than guess at
+// their pronouns
+constexpr std::string_view kBuiltinSocials = R"(
+social applaud
+alone      You applaud wholeheartedly.
+alone-room {0} applauds wholeheartedly.
+actor      You applaud {1}.
+target     {0} applauds you.
+room       {0} applauds {1}.
+
+social bow
+alone      You bow deeply.
+alone-room {0} bows deeply.
+actor      You bow before {1}.
+target     {0} bows before you.
+room       {0} bows before {1}.
+
+social cackle
+alone      You throw back your head and cackle with glee.
+alone-room {0} throws back their head and cackles with glee.
+actor      You cackle at {1}.
+target     {0} cackles at you.
+room       {0} cackles at {1}.
+
+social cheer
+alone      You cheer loudly.
+alone-room {0} cheers loudly.
+actor      You cheer {1} on.
+target     {0} cheers you on.
+room       {0} cheers {1} on.
+
+social chuckle
+alone      You chuckle politely.
+alone-room {0} chuckles politely.
+actor      You chuckle at {1}.
+target     {0} chuckles at you.
+room       {0} chuckles at {1}.
+
+social comfort
+alone      You look around for someone to comfort.
+alone-room {0} looks around for someone to comfort.
+actor      You comfort {1}.
+target     {0} comforts you.
+room       {0} comforts {1}.
+self       You try to take comfort in your own company.
+self-room  {0} tries to take comfort in their own company.
+
+social cry
+alone      You burst into tears.
+alone-room {0} bursts into tears.
+actor      You cry on {1}'s shoulder.
+target     {0} cries on your shoulder.
+room       {0} cries on {1}'s shoulder.
+
+social dance
+alone      You dance a merry jig.
+alone-room {0} dances a merry jig.
+actor      You sweep {1} into a dance.
+target     {0} sweeps you into a dance.
+room       {0} sweeps {1} into a dance.
+self       You dance with your shadow.
+self-room  {0} dances with their shadow.
+
+social frown
+alone      You frown.
+alone-room {0} frowns.
+actor      You frown at {1}.
+target     {0} frowns at you.
+room       {0} frowns at {1}.
+
+social giggle
+alone      You giggle.
+alone-room {0} giggles.
+actor      You giggle at {1}.
+target     {0} giggles at you.
+room       {0} giggles at {1}.
+
+social grin
+alone      You grin evilly.
+alone-room {0} grins evilly.
+actor      You grin evilly at {1}.
+target     {0} grins evilly at you.
+room       {0} grins evilly at {1}.
+
+social hug
+alone      You hug yourself.
+alone-room {0} hugs themselves.
+actor      You hug {1}.
+target     {0} hugs you.
+room       {0} hugs {1}.
+
+social laugh
+alone      You fall down laughing.
+alone-room {0} falls down laughing.
+actor      You laugh at {1}.
+target     {0} laughs at you.
+room       {0} laughs at {1}.
+self       You laugh at yourself.
+self-room  {0} laughs at themselves.
+
+social nod
+alone      You nod.
+alone-room {0} nods.
+actor      You nod to {1}.
+target     {0} nods to you.
+room       {0} nods to {1}.
+
+social pat
+alone      You pat yourself on the back.
+alone-room {0} pats themselves on the back.
+actor      You pat {1} on the head.
+target     {0} pats you on the head.
+room       {0} pats {1} on the head.
+
+social poke
+alone      You poke at the air.
+alone-room {0} pokes at the air.
+actor      You poke {1} in the ribs.
+target     {0} pokes you in the ribs.
+room       {0} pokes {1} in the ribs.
+
+social ponder
+alone      You ponder the question.
+alone-room {0} sits down and ponders.
+
+social salute
+alone      You salute smartly.
+alone-room {0} salutes smartly.
+actor      You salute {1}.
+target     {0} salutes you.
+room       {0} salutes {1}.
+
+social shrug
+alone      You shrug.
+alone-room {0} shrugs helplessly.
+actor      You shrug at {1}.
+target     {0} shrugs at you.
+room       {0} shrugs at {1}.
+
+social sigh
+alone      You sigh.
+alone-room {0} sighs loudly.
+
+social smile
+alone      You smile happily.
+alone-room {0} smiles happily.
+actor      You smile at {1}.
+target     {0} smiles at you.
+room       {0} beams a smile at {1}.
+self       You smile at yourself.
+self-room  {0} smiles at themselves.
+
+social thank
+alone      You thank everyone here.
+alone-room {0} thanks everyone here.
+actor      You thank {1} heartily.
+target     {0} thanks you heartily.
+room       {0} thanks {1} heartily.
+
+social wave
+alone      You wave.
+alone-room {0} waves happily.
+actor      You wave goodbye to {1}.
+target     {0} waves goodbye to you.
+room       {0} waves goodbye to {1}.
+
+social wink
+alone      You wink suggestively.
+alone-room {0} winks suggestively.
+actor      You wink at {1}.
+target     {0} winks at you.
+room       {0} winks at {1}.
+
+social yawn
+alone      You yawn. Must be getting late.
+alone-room {0} yawns.
+)";
+
+bool isName(std::string_view name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) { return c >= 'a' && c <= 'z'; });
+}
+
+std::string_view trimmed(std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+bool sameKeyword(std::string_view a, std::string_view b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+        return (x >= 'A' && x <= 'Z' ? static_cast<char>(x - 'A' + 'a') : x) == y;
+    });
+}
+
+} // namespace
+
+std::expected<SocialTable, std::string> SocialTable::parse(std::string_view text) {
+    SocialTable table;
+    std::string errors;
+    const auto fail = [&errors](std::size_t line, std::string_view message) {
+        std::format_to(std::back_inserter(errors), "{}line {}: {}", errors.empty() ? "" : "\n", line, message);
+    };
+    // The last social must have what every social needs once it is complete
+    std::size_t started = 0;
+    const auto finish = [&] {
+        if (table.m_socials.empty()) {
+            return;
+        }
+        const Social& social = table.m_socials.back();
+        const auto has = [&social](SocialView view) { return social.line(view) != nullptr; };
+        if (!has(SocialView::Alone) || !has(SocialView::AloneRoom)) {
+            fail(started, std::format("{} needs alone and alone-room lines", social.name));
+        }
+        if (has(SocialView::Actor) != has(SocialView::Target) || has(SocialView::Actor) != has(SocialView::Room)) {
+            fail(started, std::format("{} needs all or none of actor, target and room", social.name));
+        }
+        if (has(SocialView::Self) != has(SocialView::SelfRoom)) {
+            fail(started, std::format("{} needs both or neither of self and self-room", social.name));
+        }
+    };
+
+    std::size_t number = 0;
+    while (!text.empty()) {
+        const std::size_t end = std::min(text.find('\n'), text.size());
+        const std::string_view line = trimmed(text.substr(0, end));
+        text.remove_prefix(std::min(end + 1, text.size()));
+        ++number;
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        const std::size_t space = std::min(line.find_first_of(" \t"), line.size());
+        const std::string_view keyword = line.substr(0, space);
+        const std::string_view rest = trimmed(line.substr(space));
+
+        if (sameKeyword(keyword, "social")) {
+            finish();
+            if (!isName(rest)) {
+                fail(number, std::format("'{}' is not a social's name, a lowercase word", rest));
+            } else if (table.m_index.contains(rest)) {
+                fail(number, std::format("{} is defined twice", rest));
+            }
+            table.m_index.emplace(std::string(rest), static_cast<std::uint32_t>(table.m_socials.size()));
+            table.m_socials.push_back({std::string(rest), {}});
+            started = number;
+            continue;
+        }
+        const auto view = std::find_if(kViewKeywords.begin(), kViewKeywords.end(),
+                                       [keyword](std::string_view known) { return sameKeyword(keyword, known); });
+        if (view == kViewKeywords.end()) {
+            fail(number, std::format("unknown keyword '{}'", keyword));
+            continue;
+        }
+        if (table.m_socials.empty()) {
+            fail(number, std::format("{} before any social", keyword));
+            continue;
+        }
+        auto& slot = table.m_socials.back().lines[static_cast<std::size_t>(view - kViewKeywords.begin())];
+        if (slot) {
+            fail(number, std::format("a second {} line", *view));
+            continue;
+        }
+        auto parsed = MessageTemplate::parse(std::string(rest));
+        if (!parsed) {
+            fail(number, parsed.error());
+            continue;
+        }
+        // Only a line with a target may name one
+        const bool targeted = *view == "actor" || *view == "target" || *view == "room";
+        if (parsed->arguments() > (targeted ? 2u : 1u)) {
+            fail(number, targeted ? "only {0} and {1} may be used" : "only {0} may be used, as there is no target");
+            continue;
+        }
+        slot = std::move(*parsed);
+    }
+    finish();
+    if (!errors.empty()) {
+        return std::unexpected(std::move(errors));
+    }
+
+    // Sorted for the list, and the index pointed at the sorted places
+    std::sort(table.m_socials.begin(), table.m_socials.end(),
+              [](const Social& a, const Social& b) { return a.name < b.name; });
+    for (std::size_t i = 0; i < table.m_socials.size(); ++i) {
+        table.m_index[table.m_socials[i].name] = static_cast<std::uint32_t>(i);
+    }
+    constexpr std::size_t kColumns = 6;
+    constexpr std::size_t kColumnWidth = 12;
+    table.m_list = "Socials:";
+    for (std::size_t i = 0; i < table.m_socials.size(); ++i) {
+        if (i % kColumns == 0) {
+            table.m_list += "\n  ";
+        } else {
+            const std::size_t previous = table.m_socials[i - 1].name.size();
+            table.m_list.append(previous < kColumnWidth ? kColumnWidth - previous : 1, ' ');
+        }
+        table.m_list += table.m_socials[i].name;
+    }
+    table.m_list += "\nType one alone, or with the name of someone here.";
+    return table;
+}
+
+const SocialTable& SocialTable::builtin() {
+    static const SocialTable table = [] {
+        auto parsed = parse(kBuiltinSocials);
+        return parsed ? std::move(*parsed) : SocialTable{};
+    }();
+    return table;
+}
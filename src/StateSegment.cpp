@@ -0,0 +1,173 @@
+#include "../include/StateSegment.h"
+#include "../include/MappedRecords.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'E', 'M', 'S', 'T', 'A', 'T', 'E', '\0'};
+
+std::size_t layoutBytes(std::size_t slots) {
+    return sizeof(StateSegmentHeader) + slots * StateSegment::kSlotBytes;
+}
+
+std::string segmentName(std::string name) {
+    if (!name.starts_with('/')) {
+        name.insert(name.begin(), '/');
+    }
+    return name;
+}
+
+char* mapSegment(int fd, std::size_t bytes) {
+    void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return base == MAP_FAILED ? nullptr : static_cast<char*>(base);
+}
+
+} // namespace
+
+std::expected<std::unique_ptr<StateSegment>, std::string> StateSegment::open(std::string name, std::size_t slots) {
+    name = segmentName(std::move(name));
+    slots = std::max<std::size_t>(slots, 1);
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return std::unexpected(std::format("{}: {}", name, std::strerror(errno)));
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        const int error = errno;
+        ::close(fd);
+        return std::unexpected(std::format("{}: {}", name, std::strerror(error)));
+    }
+    // A new one is all zeroes, which check() refuses until a reset
+    std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    if (bytes < sizeof(StateSegmentHeader)) {
+        bytes = layoutBytes(slots);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            const int error = errno;
+            ::close(fd);
+            return std::unexpected(std::format("{}: {}", name, std::strerror(error)));
+        }
+    }
+    char* base = mapSegment(fd, bytes);
+    if (!base) {
+        const int error = errno;
+        ::close(fd);
+        return std::unexpected(std::format("{}: {}", name, std::strerror(error)));
+    }
+    return std::unique_ptr<StateSegment>(new StateSegment(std::move(name), fd, base, bytes));
+}
+
+void StateSegment::unlink(std::string name) {
+    ::shm_unlink(segmentName(std::move(name)).c_str());
+}
+
+StateSegment::StateSegment(std::string name, int fd, char* base, std::size_t bytes) noexcept
+    : m_name(std::move(name))
+    , m_fd(fd)
+    , m_base(base)
+    , m_bytes(bytes)
+    , m_header(reinterpret_cast<StateSegmentHeader*>(base)) {}
+
+StateSegment::~StateSegment() {
+    ::munmap(m_base, m_bytes);
+    ::close(m_fd);
+}
+
+StateSlotHeader& StateSegment::slot(std::size_t index) const noexcept {
+    return *reinterpret_cast<StateSlotHeader*>(m_base + m_header->headerSize + index * m_header->slotBytes);
+}
+
+std::expected<void, std::string> StateSegment::check(std::uint64_t token) const {
+    const StateSegmentHeader& header = *m_header;
+    if (header.magic != kMagic || header.version != kVersion || header.headerSize != sizeof(StateSegmentHeader)
+        || header.slotBytes != kSlotBytes) {
+        return std::unexpected(std::string("it holds nothing of this version"));
+    }
+    if (header.token != token) {
+        return std::unexpected(std::string("another run has reset it since"));
+    }
+    if (header.overflowed != 0) {
+        return std::unexpected(std::string("it ran out of room"));
+    }
+    if (header.used > header.slotCount || layoutBytes(header.slotCount) > m_bytes) {
+        return std::unexpected(std::string("its header is damaged"));
+    }
+    for (std::size_t i = 0; i < header.used; ++i) {
+        const StateSlotHeader& held = slot(i);
+        if (held.seal % 2 != 0) {
+            return std::unexpected(std::format("slot {} was being written", i));
+        }
+        const std::size_t bytes = std::size_t{held.keySize} + held.imageSize;
+        if (bytes > kSlotBytes - sizeof(StateSlotHeader) || held.sequence >= header.nextSequence) {
+            return std::unexpected(std::format("slot {} is damaged", i));
+        }
+        if (mapped::fnv1a({reinterpret_cast<const char*>(&held + 1), bytes}) != held.checksum) {
+            return std::unexpected(std::format("slot {} fails its checksum", i));
+        }
+    }
+    return {};
+}
+
+void StateSegment::each(const std::function<void(std::string_view, std::uint64_t, std::string_view)>& apply) const {
+    for (std::size_t i = 0; i < m_header->used; ++i) {
+        const StateSlotHeader& held = slot(i);
+        const char* text = reinterpret_cast<const char*>(&held + 1);
+        apply({text, held.keySize}, held.sequence, {text + held.keySize, held.imageSize});
+    }
+}
+
+void StateSegment::reset(std::uint64_t token, std::uint64_t nextSequence) {
+    m_keys.clear();
+    StateSegmentHeader header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.headerSize = sizeof(StateSegmentHeader);
+    header.slotBytes = kSlotBytes;
+    header.slotCount = static_cast<std::uint32_t>((m_bytes - sizeof(StateSegmentHeader)) / kSlotBytes);
+    header.token = token;
+    header.nextSequence = nextSequence;
+    *m_header = header;
+}
+
+bool StateSegment::put(std::string_view key, std::uint64_t sequence, std::string_view image) {
+    StateSegmentHeader& header = *m_header;
+    if (header.overflowed != 0) {
+        return false;
+    }
+    auto found = m_keys.find(std::string(key));
+    if (sizeof(StateSlotHeader) + key.size() + image.size() > kSlotBytes
+        || (found == m_keys.end() && header.used == header.slotCount)) {
+        header.overflowed = 1;
+        return false;
+    }
+
+    // Counted before the slot changes, so a slot that made it is always older
+    header.nextSequence = std::max(header.nextSequence, sequence + 1);
+    const bool fresh = found == m_keys.end();
+    StateSlotHeader& held = slot(fresh ? header.used : found->second);
+    std::atomic_ref<std::uint32_t> seal(held.seal);
+    const std::uint32_t open = seal.load(std::memory_order_relaxed) | 1;
+    seal.store(open, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    // A new slot is opened before it is counted, so what an older run left
+    // in it is never taken for this one's
+    if (fresh) {
+        m_keys.emplace(std::string(key), header.used++);
+    }
+    char* text = reinterpret_cast<char*>(&held + 1);
+    std::memcpy(text, key.data(), key.size());
+    std::memcpy(text + key.size(), image.data(), image.size());
+    held.keySize = static_cast<std::uint32_t>(key.size());
+    held.imageSize = static_cast<std::uint32_t>(image.size());
+    held.sequence = sequence;
+    held.checksum = mapped::fnv1a({text, key.size() + image.size()});
+    seal.store(open + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,388 @@
+#include "../include/Storage.h"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <utility>
+#ifdef ENABLE_SQLITE
+#include <sqlite3.h>
+#endif
+
+#ifdef ENABLE_SQLITE
+
+struct Storage::Connection {
+    using Statements = std::list<std::pair<std::string, sqlite3_stmt*>>;
+
+    sqlite3* db = nullptr;
+    std::size_t capacity = 1;
+    Statements statements;   // Most recently used first
+    std::unordered_map<std::string_view, Statements::iterator> index;
+    std::uint64_t prepared = 0;
+
+    ~Connection() {
+        for (auto& [sql, statement] : statements) {
+            sqlite3_finalize(statement);
+        }
+        sqlite3_close(db);
+    }
+
+    std::string error() const { return sqlite3_errmsg(db); }
+    bool exec(const char* sql) { return sqlite3_exec(db, sql, nullptr, nullptr, nullptr) == SQLITE_OK; }
+
+    sqlite3_stmt* statement(const std::string& sql) {
+        if (const auto found = index.find(sql); found != index.end()) {
+            statements.splice(statements.begin(), statements, found->second);
+            return found->second->second;
+        }
+        sqlite3_stmt* compiled = nullptr;
+        if (sqlite3_prepare_v3(db, sql.data(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT, &compiled,
+                               nullptr) != SQLITE_OK) {
+            return nullptr;
+        }
+        ++prepared;
+        statements.emplace_front(sql, compiled);
+        index.emplace(statements.front().first, statements.begin());
+        if (statements.size() > capacity) {
+            index.erase(statements.back().first);
+            sqlite3_finalize(statements.back().second);
+            statements.pop_back();
+        }
+        return compiled;
+    }
+
+    StorageResult run(const std::string& sql, const std::vector<StorageValue>& params) {
+        sqlite3_stmt* statement = this->statement(sql);
+        if (!statement) {
+            return std::unexpected(error());
+        }
+        // Reset however it ends, so a read doesn't keep its snapshot open
+        // and the next run starts unbound
+        struct Reset {
+            sqlite3_stmt* statement;
+            ~Reset() {
+                sqlite3_reset(statement);
+                sqlite3_clear_bindings(statement);
+            }
+        } reset{statement};
+
+        const int placeholders = sqlite3_bind_parameter_count(statement);
+        if (params.size() != static_cast<std::size_t>(placeholders)) {
+            return std::unexpected(std::format("{} parameters for {} placeholders", params.size(), placeholders));
+        }
+        for (int i = 0; i < placeholders; ++i) {
+            const StorageValue& param = params[static_cast<std::size_t>(i)];
+            int status = SQLITE_OK;
+            if (const auto* integer = std::get_if<std::int64_t>(&param)) {
+                status = sqlite3_bind_int64(statement, i + 1, *integer);
+            } else if (const auto* real = std::get_if<double>(&param)) {
+                status = sqlite3_bind_double(statement, i + 1, *real);
+            } else if (const auto* text = std::get_if<std::string>(&param)) {
+                // The params outlive the step, so SQLite needn't copy them
+                status = sqlite3_bind_text(statement, i + 1, text->data(), static_cast<int>(text->size()),
+                                           SQLITE_STATIC);
+            } else {
+                status = sqlite3_bind_null(statement, i + 1);
+            }
+            if (status != SQLITE_OK) {
+                return std::unexpected(error());
+            }
+        }
+
+        StorageRows rows;
+        const int columns = sqlite3_column_count(statement);
+        int status;
+        while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+            StorageRow& row = rows.rows.emplace_back();
+            row.reserve(static_cast<std::size_t>(columns));
+            for (int column = 0; column < columns; ++column) {
+                switch (sqlite3_column_type(statement, column)) {
+                    case SQLITE_INTEGER:
+                        row.emplace_back(static_cast<std::int64_t>(sqlite3_column_int64(statement, column)));
+                        break;
+                    case SQLITE_FLOAT:
+                        row.emplace_back(sqlite3_column_double(statement, column));
+                        break;
+                    case SQLITE_NULL:
+                        row.emplace_back(std::monostate{});
+                        break;
+                    default: {
+                        // Text, or a blob kept as its bytes
+                        const auto* bytes = static_cast<const char*>(sqlite3_column_blob(statement, column));
+                        const int size = sqlite3_column_bytes(statement, column);
+                        row.emplace_back(std::string(bytes ? bytes : "", static_cast<std::size_t>(size)));
+                        break;
+                    }
+                }
+            }
+        }
+        if (status != SQLITE_DONE) {
+            return std::unexpected(error());
+        }
+        return rows;
+    }
+};
+
+#else
+
+struct Storage::Connection {};
+
+#endif
+
+std::expected<std::unique_ptr<Storage>, std::string> Storage::open(const std::filesystem::path& path,
+                                                                   Options options) {
+#ifdef ENABLE_SQLITE
+    auto connection = std::make_unique<Connection>();
+    connection->capacity = std::max<std::size_t>(options.cachedStatements, 1);
+    // Only the I/O thread touches the connection, so SQLite's own locking is spared
+    const int status = sqlite3_open_v2(path.string().c_str(), &connection->db,
+                                       SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr);
+    if (status != SQLITE_OK) {
+        return std::unexpected(std::format("{}: {}", path.string(),
+                                           connection->db ? connection->error() : sqlite3_errstr(status)));
+    }
+    sqlite3_busy_timeout(connection->db, static_cast<int>(options.busyTimeout.count()));
+    // WAL lets other processes, such as a backup, read while the game writes;
+    // with it, syncing only at checkpoints loses no committed transaction to a crash
+    if (!connection->exec("PRAGMA journal_mode=WAL") || !connection->exec("PRAGMA synchronous=NORMAL")) {
+        return std::unexpected(std::format("{}: {}", path.string(), connection->error()));
+    }
+    return std::unique_ptr<Storage>(new Storage(std::move(connection), options));
+#else
+    (void)path;
+    (void)options;
+    return std::unexpected(std::string("built without SQLite"));
+#endif
+}
+
+Storage::Storage(std::unique_ptr<Connection> connection, Options options)
+    : m_options(options), m_connection(std::move(connection)), m_thread([this] { run(); }) {}
+
+Storage::~Storage() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void Storage::submit(Kind kind, std::string sql, std::vector<StorageValue> params, Callback done) {
+    if (kind == Kind::Lookup) {
+        if (auto hit = cached(sql, params)) {
+            if (done) {
+                done(std::move(*hit));
+            }
+            return;
+        }
+    }
+    enqueue(kind, std::move(sql), std::move(params), std::move(done));
+}
+
+void Storage::enqueue(Kind kind, std::string sql, std::vector<StorageValue> params, Callback done) {
+    std::uint64_t generation;
+    {
+        const std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (kind == Kind::Write) {
+            ++m_generation;
+            m_resultIndex.clear();
+            m_results.clear();
+        }
+        generation = m_generation;
+    }
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back({kind, std::move(sql), std::move(params), std::move(done), generation});
+    }
+    m_wake.notify_one();
+}
+
+std::future<StorageResult> Storage::future(Kind kind, std::string sql, std::vector<StorageValue> params) {
+    auto promise = std::make_shared<std::promise<StorageResult>>();
+    std::future<StorageResult> result = promise->get_future();
+    submit(kind, std::move(sql), std::move(params),
+           [promise](StorageResult rows) { promise->set_value(std::move(rows)); });
+    return result;
+}
+
+std::optional<StorageResult> Storage::cached(std::string_view sql, const std::vector<StorageValue>& params) {
+    if (m_options.cachedResults == 0) {
+        return std::nullopt;
+    }
+    const std::string key = cacheKey(sql, params);
+    const std::lock_guard<std::mutex> lock(m_cacheMutex);
+    const auto found = m_resultIndex.find(key);
+    if (found == m_resultIndex.end()) {
+        ++m_cacheMisses;
+        return std::nullopt;
+    }
+    ++m_cacheHits;
+    m_results.splice(m_results.begin(), m_results, found->second);
+    return StorageResult(found->second->second);
+}
+
+void Storage::remember(const Request& request, const StorageRows& rows) {
+    if (m_options.cachedResults == 0) {
+        return;
+    }
+    std::string key = cacheKey(request.sql, request.params);
+    const std::lock_guard<std::mutex> lock(m_cacheMutex);
+    // A write queued since the read may have changed the rows
+    if (request.generation != m_generation) {
+        return;
+    }
+    if (const auto found = m_resultIndex.find(key); found != m_resultIndex.end()) {
+        found->second->second = rows;
+        m_results.splice(m_results.begin(), m_results, found->second);
+        return;
+    }
+    m_results.emplace_front(std::move(key), rows);
+    m_resultIndex.emplace(m_results.front().first, m_results.begin());
+    if (m_results.size() > m_options.cachedResults) {
+        m_resultIndex.erase(m_results.back().first);
+        m_results.pop_back();
+    }
+}
+
+std::string Storage::cacheKey(std::string_view sql, const std::vector<StorageValue>& params) {
+    // The SQL, then each parameter as its type and bytes; texts carry their
+    // length, so no two statements and parameter lists share a key
+    std::string key(sql);
+    const auto appendBytes = [&key](const auto& value) {
+        char bytes[sizeof value];
+        std::memcpy(bytes, &value, sizeof value);
+        key.append(bytes, sizeof bytes);
+    };
+    for (const StorageValue& param : params) {
+        key += static_cast<char>(param.index());
+        if (const auto* integer = std::get_if<std::int64_t>(&param)) {
+            appendBytes(*integer);
+        } else if (const auto* real = std::get_if<double>(&param)) {
+            appendBytes(*real);
+        } else if (const auto* text = std::get_if<std::string>(&param)) {
+            appendBytes(text->size());
+            key += *text;
+        }
+    }
+    return key;
+}
+
+StorageStats Storage::stats() const {
+    StorageStats stats;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        stats = m_stats;
+        stats.queued = m_queue.size();
+    }
+    const std::lock_guard<std::mutex> lock(m_cacheMutex);
+    stats.cacheHits = m_cacheHits;
+    stats.cacheMisses = m_cacheMisses;
+    return stats;
+}
+
+void Storage::run() {
+    std::vector<Request> pass;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            const std::size_t take = std::min(m_queue.size(), std::max<std::size_t>(m_options.maxBatch, 1));
+            pass.assign(std::make_move_iterator(m_queue.begin()),
+                        std::make_move_iterator(m_queue.begin() + static_cast<std::ptrdiff_t>(take)));
+            m_queue.erase(m_queue.begin(), m_queue.begin() + static_cast<std::ptrdiff_t>(take));
+        }
+        runPass(pass);
+        pass.clear();
+    }
+}
+
+void Storage::runPass(std::vector<Request>& pass) {
+    std::vector<StorageResult> results;
+    results.reserve(pass.size());
+    std::uint64_t reads = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t batches = 0;
+#ifdef ENABLE_SQLITE
+    Connection& connection = *m_connection;
+    const bool anyWrites = std::any_of(pass.begin(), pass.end(),
+                                       [](const Request& request) { return request.kind == Kind::Write; });
+    // If BEGIN fails (the database is busy past the timeout), each write commits on its own
+    bool inTransaction = anyWrites && connection.exec("BEGIN IMMEDIATE");
+    // Writes of the transaction so far, which a rollback undoes
+    std::vector<std::size_t> uncommitted;
+
+    const auto failUncommitted = [&](const std::string& why) {
+        for (const std::size_t i : uncommitted) {
+            results[i] = std::unexpected(why);
+        }
+        uncommitted.clear();
+    };
+
+    for (std::size_t i = 0; i < pass.size(); ++i) {
+        const Request& request = pass[i];
+        StorageResult result = connection.run(request.sql, request.params);
+        if (request.kind == Kind::Write) {
+            ++writes;
+            if (result) {
+                result->changes = sqlite3_changes(connection.db);
+                result->lastInsertId = sqlite3_last_insert_rowid(connection.db);
+            }
+        } else {
+            ++reads;
+        }
+        // Some errors roll the whole transaction back; start another for the rest
+        if (inTransaction && sqlite3_get_autocommit(connection.db)) {
+            const std::string why = result ? std::string("rolled back")
+                                           : std::format("rolled back by: {}", result.error());
+            failUncommitted(why);
+            if (result && request.kind == Kind::Write) {
+                result = std::unexpected(why);
+            }
+            inTransaction = connection.exec("BEGIN IMMEDIATE");
+        } else if (inTransaction && result && request.kind == Kind::Write) {
+            uncommitted.push_back(i);
+        }
+        results.push_back(std::move(result));
+    }
+    if (inTransaction) {
+        if (connection.exec("COMMIT")) {
+            ++batches;
+        } else {
+            const std::string why = std::format("commit failed: {}", connection.error());
+            connection.exec("ROLLBACK");
+            failUncommitted(why);
+        }
+    }
+#else
+    for (const Request& request : pass) {
+        (request.kind == Kind::Write ? writes : reads) += 1;
+        results.push_back(std::unexpected(std::string("built without SQLite")));
+    }
+#endif
+
+    std::uint64_t failed = 0;
+    for (std::size_t i = 0; i < pass.size(); ++i) {
+        if (!results[i]) {
+            ++failed;
+        } else if (pass[i].kind == Kind::Lookup) {
+            remember(pass[i], *results[i]);
+        }
+    }
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.reads += reads;
+        m_stats.writes += writes;
+        m_stats.batches += batches;
+        m_stats.failed += failed;
+#ifdef ENABLE_SQLITE
+        m_stats.prepared = connection.prepared;
+#endif
+    }
+    // Only now, so no one hears of a write that a failed commit then undid
+    for (std::size_t i = 0; i < pass.size(); ++i) {
+        if (pass[i].done) {
+            pass[i].done(std::move(results[i]));
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#include "../include/StringInterner.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+StringInterner::~StringInterner() {
+    for (std::atomic<Entry*>& segment : m_segments) {
+        if (Entry* entries = segment.load(std::memory_order_relaxed)) {
+            MemoryAccounting::freed(MemoryTag::World, kSegmentSize * sizeof(Entry));
+            delete[] entries;
+        }
+    }
+}
+
+StringInterner& StringInterner::global() {
+    static StringInterner interner;
+    return interner;
+}
+
+Symbol StringInterner::intern(std::string_view text) {
+    const std::uint32_t hash = hashOf(text);
+    Shard& shard = m_shards[hash >> (32 - kShardBits)];
+    {
+        const std::shared_lock lock(shard.mutex);
+        if (const Symbol symbol = probe(shard, hash, text)) {
+            return symbol;
+        }
+    }
+    const std::unique_lock lock(shard.mutex);
+    // Someone else may have added it between the two locks
+    if (const Symbol symbol = probe(shard, hash, text)) {
+        return symbol;
+    }
+    const Symbol symbol = store(text);
+    insert(shard, {hash, symbol});
+    return symbol;
+}
+
+Symbol StringInterner::find(std::string_view text) const {
+    const std::uint32_t hash = hashOf(text);
+    const Shard& shard = m_shards[hash >> (32 - kShardBits)];
+    const std::shared_lock lock(shard.mutex);
+    return probe(shard, hash, text);
+}
+
+// FNV-1a; the top bits pick the shard, the low ones the slot
+std::uint32_t StringInterner::hashOf(std::string_view text) noexcept {
+    std::uint32_t hash = 2166136261u;
+    for (const char c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+Symbol StringInterner::probe(const Shard& shard, std::uint32_t hash, std::string_view text) const noexcept {
+    if (shard.slots.empty()) {
+        return kNoSymbol;
+    }
+    const std::size_t mask = shard.slots.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = shard.slots[i];
+        if (slot.symbol == kNoSymbol) {
+            return kNoSymbol;
+        }
+        if (slot.hash == hash && view(slot.symbol) == text) {
+            return slot.symbol;
+        }
+    }
+}
+
+void StringInterner::insert(Shard& shard, Slot slot) {
+    // Kept under three quarters full, so probes stay short and always end
+    if ((shard.used + 1) * 4 > shard.slots.size() * 3) {
+        std::vector<Slot> old(std::max<std::size_t>(64, shard.slots.size() * 2));
+        old.swap(shard.slots);
+        shard.used = 0;
+        for (const Slot& moved : old) {
+            if (moved.symbol != kNoSymbol) {
+                insert(shard, moved);
+            }
+        }
+    }
+    const std::size_t mask = shard.slots.size() - 1;
+    std::size_t i = slot.hash & mask;
+    while (shard.slots[i].symbol != kNoSymbol) {
+        i = (i + 1) & mask;
+    }
+    shard.slots[i] = slot;
+    ++shard.used;
+}
+
+Symbol StringInterner::store(std::string_view text) {
+    const std::lock_guard lock(m_storeMutex);
+    const Symbol symbol = m_next.load(std::memory_order_relaxed);
+    const std::size_t segmentIndex = symbol >> kSegmentBits;
+    if (segmentIndex >= kMaxSegments) {
+        throw std::length_error("String interner is full");
+    }
+
+    // Long strings get a block of their own so they don't waste the shared one
+    char* bytes;
+    if (text.size() > kBlockSize / 4) {
+        m_blocks.push_back(makeTrackedBuffer(MemoryTag::World, text.size()));
+        bytes = m_blocks.back().get();
+    } else {
+        if (text.size() > m_left) {
+            m_blocks.push_back(makeTrackedBuffer(MemoryTag::World, kBlockSize));
+            m_cursor = m_blocks.back().get();
+            m_left = kBlockSize;
+        }
+        bytes = m_cursor;
+        m_cursor += text.size();
+        m_left -= text.size();
+    }
+    if (!text.empty()) {
+        std::memcpy(bytes, text.data(), text.size());
+    }
+
+    Entry* segment = m_segments[segmentIndex].load(std::memory_order_relaxed);
+    if (!segment) {
+        segment = new Entry[kSegmentSize];
+        MemoryAccounting::allocated(MemoryTag::World, kSegmentSize * sizeof(Entry));
+        m_segments[segmentIndex].store(segment, std::memory_order_release);
+    }
+    // Written before the symbol is handed out, which is what makes it safe
+    // for whoever receives the symbol to view() it
+    segment[symbol & (kSegmentSize - 1)] = {bytes, static_cast<std::uint32_t>(text.size())};
+    m_next.store(symbol + 1, std::memory_order_release);
+    return symbol;
+}
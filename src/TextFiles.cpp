@@ -0,0 +1,93 @@
+#include "../include/TextFiles.h"
+#include <algorithm>
+#include <system_error>
+
+namespace {
+
+bool isTextName(std::string_view name) {
+    if (name.empty() || name.front() == '/' || name.back() == '/' || name.find("//") != std::string_view::npos) {
+        return false;
+    }
+    return std::ranges::all_of(name, [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_' ||
+               c == '/';
+    });
+}
+
+std::shared_ptr<const MappedText> mapText(const std::filesystem::path& path) {
+    auto text = std::make_shared<MappedText>();
+    text->file = FileView(path);
+    const std::string_view bytes = text->file.bytes();
+    if (bytes.empty()) {
+        return nullptr;
+    }
+    for (std::size_t at = bytes.find('\n'); at != std::string_view::npos; at = bytes.find('\n', at + 1)) {
+        text->ends.push_back(static_cast<std::uint32_t>(at));
+    }
+    if (bytes.back() != '\n') {
+        text->ends.push_back(static_cast<std::uint32_t>(bytes.size()));
+    }
+    // Whole, it is one message with the last break left to the line it is sent as
+    std::string whole;
+    whole.reserve(bytes.size());
+    for (std::size_t i = 0; i < text->size(); ++i) {
+        if (i > 0) {
+            whole += '\n';
+        }
+        whole += text->line(i);
+    }
+    text->whole = makeSharedMessage(std::move(whole));
+    return text;
+}
+
+} // namespace
+
+std::string_view MappedText::line(std::size_t i) const noexcept {
+    const std::string_view bytes = file.bytes();
+    const std::size_t start = i == 0 ? 0 : ends[i - 1] + 1;
+    std::string_view line = bytes.substr(start, ends[i] - start);
+    if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+TextFiles::TextFiles(std::filesystem::path directory) : m_directory(std::move(directory)) {}
+
+std::shared_ptr<const MappedText> TextFiles::get(std::string_view name) {
+    if (!isTextName(name)) {
+        return nullptr;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    auto [found, added] = m_entries.try_emplace(std::string(name));
+    Entry& entry = found->second;
+    if (added || now - entry.checked >= kRecheck) {
+        entry.checked = now;
+        ++m_stats.checks;
+        std::filesystem::path path = m_directory / name;
+        path += ".txt";
+        std::error_code error;
+        const auto modified = std::filesystem::last_write_time(path, error);
+        const std::uintmax_t size = error ? 0 : std::filesystem::file_size(path, error);
+        if (error) {
+            entry.text = nullptr;
+        } else if (added || modified != entry.modified || size != entry.size) {
+            entry = Entry{mapText(path), modified, size, now};
+            m_stats.maps += entry.text ? 1 : 0;
+        }
+    }
+    // Misses are not kept, or any name a player asks help for would stay
+    // in the map; one costs a stat() each time it is asked for
+    if (!entry.text) {
+        m_entries.erase(found);
+        return nullptr;
+    }
+    ++m_stats.reads;
+    return entry.text;
+}
+
+TextFileStats TextFiles::stats() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,122 @@
+#include "../include/TextSearch.h"
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TEXTSEARCH_SSE2 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define TEXTSEARCH_NEON 1
+#endif
+
+namespace {
+
+constexpr unsigned char fold(unsigned char ch) noexcept {
+    return ch >= 'A' && ch <= 'Z' ? static_cast<unsigned char>(ch | 0x20) : ch;
+}
+
+// Setting bit 5 folds letters as fold() does and merges a few punctuation
+// pairs besides, so the vector filter may pass a position the full
+// comparison then rejects, but never misses one
+constexpr unsigned char loose(unsigned char ch) noexcept {
+    return static_cast<unsigned char>(ch | 0x20);
+}
+
+bool equalFolded(const char* text, std::string_view needle) noexcept {
+    for (std::size_t i = 0; i < needle.size(); ++i) {
+        if (fold(static_cast<unsigned char>(text[i])) != fold(static_cast<unsigned char>(needle[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+namespace TextSearch {
+
+std::size_t find(std::string_view text, std::string_view needle, std::size_t from) noexcept {
+    const std::size_t size = needle.size();
+    if (size == 0 || from > text.size() || text.size() - from < size) {
+        return std::string_view::npos;
+    }
+    const char* data = text.data();
+    const std::size_t last = size - 1;
+    const std::size_t end = text.size() - last;   // Candidate starts lie in [from, end)
+    const unsigned char first = loose(static_cast<unsigned char>(needle.front()));
+    const unsigned char final = loose(static_cast<unsigned char>(needle.back()));
+    std::size_t i = from;
+
+    // Bit j * stride of mask marks a candidate at base + j
+    auto check = [&](std::size_t base, std::uint64_t mask, unsigned stride) -> std::size_t {
+        while (mask) {
+            const std::size_t at = base + static_cast<std::size_t>(std::countr_zero(mask)) / stride;
+            if (equalFolded(data + at, needle)) {
+                return at;
+            }
+            mask &= mask - 1;
+        }
+        return std::string_view::npos;
+    };
+
+#if defined(__AVX2__)
+    const __m256i bit32 = _mm256_set1_epi8(0x20);
+    const __m256i first32 = _mm256_set1_epi8(static_cast<char>(first));
+    const __m256i final32 = _mm256_set1_epi8(static_cast<char>(final));
+    for (; i + 32 <= end; i += 32) {
+        const __m256i head = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), bit32);
+        const __m256i tail =
+            _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + last)), bit32);
+        const __m256i both = _mm256_and_si256(_mm256_cmpeq_epi8(head, first32), _mm256_cmpeq_epi8(tail, final32));
+        if (const std::size_t at = check(i, static_cast<std::uint32_t>(_mm256_movemask_epi8(both)), 1);
+            at != std::string_view::npos) {
+            return at;
+        }
+    }
+#endif
+
+#if defined(TEXTSEARCH_SSE2)
+    const __m128i bit16 = _mm_set1_epi8(0x20);
+    const __m128i first16 = _mm_set1_epi8(static_cast<char>(first));
+    const __m128i final16 = _mm_set1_epi8(static_cast<char>(final));
+    for (; i + 16 <= end; i += 16) {
+        const __m128i head = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bit16);
+        const __m128i tail = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + last)), bit16);
+        const __m128i both = _mm_and_si128(_mm_cmpeq_epi8(head, first16), _mm_cmpeq_epi8(tail, final16));
+        if (const std::size_t at = check(i, static_cast<std::uint32_t>(_mm_movemask_epi8(both)), 1);
+            at != std::string_view::npos) {
+            return at;
+        }
+    }
+#elif defined(TEXTSEARCH_NEON)
+    // NEON has no movemask; narrowing the compare result gives 4 bits per byte
+    const uint8x16_t bit16 = vdupq_n_u8(0x20);
+    const uint8x16_t first16 = vdupq_n_u8(first);
+    const uint8x16_t final16 = vdupq_n_u8(final);
+    for (; i + 16 <= end; i += 16) {
+        const uint8x16_t head = vorrq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i)), bit16);
+        const uint8x16_t tail = vorrq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i + last)), bit16);
+        const uint8x16_t both = vandq_u8(vceqq_u8(head, first16), vceqq_u8(tail, final16));
+        const std::uint64_t mask =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(both), 4)), 0) & 0x1111111111111111ull;
+        if (const std::size_t at = check(i, mask, 4); at != std::string_view::npos) {
+            return at;
+        }
+    }
+#endif
+
+    // Scalar: the tail, or everything without vector support
+    for (; i < end; ++i) {
+        if (loose(static_cast<unsigned char>(data[i])) == first &&
+            loose(static_cast<unsigned char>(data[i + last])) == final && equalFolded(data + i, needle)) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+} // namespace TextSearch
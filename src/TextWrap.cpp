@@ -0,0 +1,266 @@
+#include "../include/TextWrap.h"
+#include "../include/Utf8.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TEXTWRAP_SSE2 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define TEXTWRAP_NEON 1
+#endif
+
+namespace {
+
+constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+constexpr std::uint64_t lowBits(unsigned count) {
+    return count >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+}
+
+/**
+ * Greedy row cutter fed one block of boundary masks at a time. Bit
+ * i * stride of a mask is set when byte base + i is a newline (or space).
+ * Newlines are visited one by one; spaces are only looked at when a row
+ * has to be cut, as the highest set bit at or below the cut, so dense prose
+ * costs a few bit operations per block rather than per word.
+ */
+class RowCutter {
+public:
+    RowCutter(std::size_t limit, std::vector<WrapSpan>& rows) : m_limit(limit), m_rows(rows) {}
+
+    void block(std::size_t base, std::size_t length, std::uint64_t newlines, std::uint64_t spaces, unsigned stride) {
+        while (newlines) {
+            const std::size_t pos = base + static_cast<std::size_t>(std::countr_zero(newlines)) / stride;
+            cutBefore(pos, base, spaces, stride);
+            if (pos > m_start) {
+                emit(m_start, pos - m_start);
+            }
+            m_start = pos + 1;
+            newlines &= newlines - 1;
+        }
+        cutBefore(base + length, base, spaces, stride);
+        if (spaces) {
+            m_lastSpace = base + static_cast<std::size_t>(std::bit_width(spaces) - 1) / stride;
+        }
+    }
+
+    void finish(std::size_t size) {
+        if (m_start < size) {
+            cutBefore(size, size, 0, 1);
+            emit(m_start, size - m_start);
+        }
+    }
+
+private:
+    // Cut rows until the text from m_start to end fits on one row
+    void cutBefore(std::size_t end, std::size_t base, std::uint64_t spaces, unsigned stride) {
+        while (end - m_start > m_limit) {
+            // The cut must fall at or before m_start + m_limit, which is never
+            // before this block: the previous block end already fit
+            const std::size_t cut = m_start + m_limit;
+            std::size_t space = m_lastSpace;
+            if (cut >= base) {
+                const std::uint64_t below = spaces & lowBits(static_cast<unsigned>((cut - base + 1) * stride));
+                if (below) {
+                    space = base + static_cast<std::size_t>(std::bit_width(below) - 1) / stride;
+                }
+            }
+            if (space != kNone && space > m_start && space <= cut) {
+                emit(m_start, space - m_start);
+                m_start = space + 1;   // The space itself is dropped
+            } else {
+                emit(m_start, m_limit);
+                m_start = cut;
+            }
+        }
+    }
+
+    void emit(std::size_t from, std::size_t length) {
+        m_rows.push_back({static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(length)});
+    }
+
+    std::size_t m_limit;
+    std::vector<WrapSpan>& m_rows;
+    std::size_t m_start = 0;          // First byte of the row being built
+    std::size_t m_lastSpace = kNone;  // Last space in blocks already passed
+};
+
+// Feed the cutter masks for every block of text, widest vectors first
+void scanBlocks(const char* data, std::size_t size, RowCutter& cutter) {
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i newline32 = _mm256_set1_epi8('\n');
+    const __m256i space32 = _mm256_set1_epi8(' ');
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto newlines = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline32)));
+        const auto spaces = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, space32)));
+        cutter.block(i, 32, newlines, spaces, 1);
+    }
+#endif
+
+#if defined(TEXTWRAP_SSE2)
+    const __m128i newline16 = _mm_set1_epi8('\n');
+    const __m128i space16 = _mm_set1_epi8(' ');
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto newlines = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline16)));
+        const auto spaces = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, space16)));
+        cutter.block(i, 16, newlines, spaces, 1);
+    }
+#elif defined(TEXTWRAP_NEON)
+    // NEON has no movemask; narrowing the compare result gives 4 bits per byte
+    const uint8x16_t newline16 = vdupq_n_u8('\n');
+    const uint8x16_t space16 = vdupq_n_u8(' ');
+    auto nibbleMask = [](uint8x16_t eq) {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0)
+               & 0x1111111111111111ull;
+    };
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t block = vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i));
+        cutter.block(i, 16, nibbleMask(vceqq_u8(block, newline16)), nibbleMask(vceqq_u8(block, space16)), 4);
+    }
+#endif
+
+    // Scalar: the tail, or everything without vector support, 64 bytes at a time
+    while (i < size) {
+        const std::size_t length = std::min<std::size_t>(size - i, 64);
+        std::uint64_t newlines = 0;
+        std::uint64_t spaces = 0;
+        for (std::size_t j = 0; j < length; ++j) {
+            newlines |= std::uint64_t{data[i + j] == '\n'} << j;
+            spaces |= std::uint64_t{data[i + j] == ' '} << j;
+        }
+        cutter.block(i, length, newlines, spaces, 1);
+        i += length;
+    }
+}
+
+// Same rules as RowCutter, counting display columns instead of bytes
+void wrapUtf8(std::string_view text, std::size_t limit, std::vector<WrapSpan>& rows) {
+    auto emit = [&](std::size_t from, std::size_t to) {
+        rows.push_back({static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to - from)});
+    };
+
+    std::size_t start = 0;            // First byte of the row being built
+    std::size_t columns = 0;          // Width of text[start, pos)
+    std::size_t lastSpace = kNone;    // Latest space after start
+    std::size_t spaceColumns = 0;     // Width of text[start, lastSpace)
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const Utf8::Decoded decoded = Utf8::decode(text, pos);
+        if (decoded.codepoint == '\n') {
+            if (pos > start) emit(start, pos);
+            start = pos + 1;
+            columns = 0;
+            lastSpace = kNone;
+            pos += 1;
+            continue;
+        }
+
+        if (decoded.codepoint == ' ' && pos > start && columns <= limit) {
+            lastSpace = pos;
+            spaceColumns = columns;
+        }
+
+        const auto width = static_cast<std::size_t>(Utf8::codepointWidth(decoded.codepoint));
+        if (columns + width > limit) {
+            if (lastSpace == pos) {
+                // This space is where the row ends; it is dropped
+                emit(start, pos);
+                start = pos + 1;
+                columns = 0;
+                lastSpace = kNone;
+                pos += 1;
+                continue;
+            }
+            if (lastSpace != kNone) {
+                // Cut at the earlier space; what followed it moves to the next row
+                emit(start, lastSpace);
+                start = lastSpace + 1;
+                columns -= spaceColumns + 1;
+                lastSpace = kNone;
+                continue;   // Re-check this code point against the new row
+            }
+            if (pos > start) {
+                emit(start, pos);
+                start = pos;
+                columns = 0;
+                continue;
+            }
+            // A wide character on a one-column row still gets a row of its own
+            emit(pos, pos + decoded.length);
+            start = pos + decoded.length;
+            pos = start;
+            continue;
+        }
+        columns += width;
+        pos += decoded.length;
+    }
+    if (start < text.size()) {
+        emit(start, text.size());
+    }
+}
+
+} // namespace
+
+namespace TextWrap {
+
+TextMetrics measure(std::string_view text) noexcept {
+    TextMetrics metrics;
+    metrics.multiline = text.find('\n') != std::string_view::npos;
+    metrics.ascii = Utf8::isAscii(text);
+    const std::size_t columns = metrics.ascii && !metrics.multiline ? text.size() : Utf8::displayWidth(text);
+    metrics.columns = static_cast<std::uint32_t>(std::min<std::size_t>(columns, UINT32_MAX));
+    return metrics;
+}
+
+void wrap(std::string_view text, int width, std::vector<WrapSpan>& rows, const TextMetrics& metrics) {
+    if (width <= 0 || text.empty()) return;
+    const auto limit = static_cast<std::size_t>(width);
+
+    if (!metrics.multiline && metrics.columns <= limit) {
+        rows.push_back({0, static_cast<std::uint32_t>(text.size())});
+    } else if (metrics.ascii) {
+        RowCutter cutter(limit, rows);
+        scanBlocks(text.data(), text.size(), cutter);
+        cutter.finish(text.size());
+    } else {
+        wrapUtf8(text, limit, rows);
+    }
+}
+
+void wrapLines(std::string_view text, int width, std::string& out, std::vector<WrapSpan>& rows) {
+    const TextMetrics metrics = measure(text);
+    if (width <= 0 || (!metrics.multiline && metrics.columns <= static_cast<std::uint32_t>(width))) {
+        out.append(text);
+        return;
+    }
+    for (std::size_t start = 0;;) {
+        const std::size_t end = std::min(text.find('\n', start), text.size());
+        const std::string_view line = text.substr(start, end - start);
+        rows.clear();
+        wrap(line, width, rows);
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            if (i > 0) {
+                out += '\n';
+            }
+            out.append(line.substr(rows[i].offset, rows[i].length));
+        }
+        if (end == text.size()) {
+            break;
+        }
+        out += '\n';
+        start = end + 1;
+    }
+}
+
+} // namespace TextWrap
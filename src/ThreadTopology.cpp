@@ -0,0 +1,275 @@
+#include "../include/ThreadTopology.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <set>
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+namespace {
+
+constexpr std::array<std::string_view, static_cast<std::size_t>(ThreadRole::Count)> kRoleNames{"game", "reactors",
+                                                                                                "workers"};
+
+std::string_view trim(std::string_view text) {
+    const std::size_t begin = text.find_first_not_of(" \t\n");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(begin, text.find_last_not_of(" \t\n") - begin + 1);
+}
+
+bool parseNumber(std::string_view text, int& value) {
+    text = trim(text);
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc() && end == text.data() + text.size() && value >= 0;
+}
+
+// Cores the machine has; 0 when it cannot tell, so none can be checked
+int coreCount() {
+#if defined(__linux__)
+    return std::min<int>(static_cast<int>(std::thread::hardware_concurrency()), CPU_SETSIZE);
+#else
+    return static_cast<int>(std::thread::hardware_concurrency());
+#endif
+}
+
+// A kernel cpulist such as "0-7,16-23", added to cores
+std::expected<void, std::string> parseCoreList(std::string_view list, std::vector<int>& cores) {
+    while (!list.empty()) {
+        const std::size_t comma = list.find(',');
+        const std::string_view item = trim(list.substr(0, comma));
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+        if (item.empty()) {
+            continue;
+        }
+        const std::size_t dash = item.find('-');
+        int first = 0;
+        int last = 0;
+        if (!parseNumber(item.substr(0, dash), first) ||
+            (dash != std::string_view::npos && !parseNumber(item.substr(dash + 1), last))) {
+            return std::unexpected(std::format("'{}' is not a core or range of cores", item));
+        }
+        if (dash == std::string_view::npos) {
+            last = first;
+        }
+        if (last < first) {
+            return std::unexpected(std::format("range '{}' runs backwards", item));
+        }
+        for (int core = first; core <= last; ++core) {
+            cores.push_back(core);
+        }
+    }
+    return {};
+}
+
+std::expected<void, std::string> parseNode(std::string_view item, std::vector<int>& cores) {
+    int node = 0;
+    if (!parseNumber(item.substr(4), node)) {
+        return std::unexpected(std::format("'{}' is not a NUMA node", item));
+    }
+    std::ifstream in(std::format("/sys/devices/system/node/node{}/cpulist", node));
+    std::string list;
+    if (!in || !std::getline(in, list)) {
+        return std::unexpected(std::format("this machine has no NUMA node {}", node));
+    }
+    return parseCoreList(list, cores);
+}
+
+// Runs of consecutive cores as ranges, such as "0-3,8"
+std::string describe(std::span<const int> cores) {
+    std::vector<int> sorted(cores.begin(), cores.end());
+    std::sort(sorted.begin(), sorted.end());
+    std::string text;
+    for (std::size_t i = 0; i < sorted.size();) {
+        std::size_t end = i + 1;
+        while (end < sorted.size() && sorted[end] == sorted[end - 1] + 1) {
+            ++end;
+        }
+        if (!text.empty()) {
+            text += ',';
+        }
+        text += end - i > 1 ? std::format("{}-{}", sorted[i], sorted[end - 1]) : std::format("{}", sorted[i]);
+        i = end;
+    }
+    return text;
+}
+
+std::string describeNodes(std::span<const int> cores) {
+    std::set<int> nodes;
+    for (const int core : cores) {
+        nodes.insert(ThreadTopology::nodeOf(core));
+    }
+    if (nodes.contains(-1)) {
+        return "unknown node";
+    }
+    const std::vector<int> list(nodes.begin(), nodes.end());
+    return std::format("node{} {}", list.size() > 1 ? "s" : "", describe(list));
+}
+
+}  // namespace
+
+std::expected<ThreadTopology, std::string> ThreadTopology::parse(std::string_view spec) {
+    ThreadTopology topology;
+    std::array<bool, kRoles> given{};
+    const int available = coreCount();
+    while (!spec.empty()) {
+        const std::size_t semicolon = spec.find(';');
+        const std::string_view entry = trim(spec.substr(0, semicolon));
+        spec = semicolon == std::string_view::npos ? std::string_view() : spec.substr(semicolon + 1);
+        if (entry.empty()) {
+            continue;
+        }
+
+        const std::size_t equals = entry.find('=');
+        const std::string_view name = trim(entry.substr(0, equals));
+        const auto role = std::find(kRoleNames.begin(), kRoleNames.end(), name);
+        if (equals == std::string_view::npos || role == kRoleNames.end()) {
+            return std::unexpected(std::format("'{}' is not game=, reactors= or workers=", entry));
+        }
+        const std::size_t index = static_cast<std::size_t>(std::distance(kRoleNames.begin(), role));
+        if (given[index]) {
+            return std::unexpected(std::format("{} is given twice", name));
+        }
+        given[index] = true;
+
+        std::vector<int>& cores = topology.m_cores[index];
+        std::string_view list = entry.substr(equals + 1);
+        while (!list.empty()) {
+            const std::size_t comma = list.find(',');
+            const std::string_view item = trim(list.substr(0, comma));
+            list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+            const auto parsed = item.starts_with("node") ? parseNode(item, cores) : parseCoreList(item, cores);
+            if (!parsed) {
+                return std::unexpected(parsed.error());
+            }
+        }
+        if (cores.empty()) {
+            return std::unexpected(std::format("{} is given no cores", name));
+        }
+        for (const int core : cores) {
+            if (available > 0 && core >= available) {
+                return std::unexpected(std::format("core {} is past the {} this machine has", core, available));
+            }
+        }
+        // In the order given, each once
+        std::set<int> seen;
+        std::erase_if(cores, [&seen](int core) { return !seen.insert(core).second; });
+    }
+    if (std::none_of(given.begin(), given.end(), [](bool role) { return role; })) {
+        return std::unexpected("no roles are given");
+    }
+
+    std::set<int> claimed;
+    for (const std::vector<int>& cores : topology.m_cores) {
+        claimed.insert(cores.begin(), cores.end());
+    }
+    for (std::size_t role = 0; role < kRoles; ++role) {
+        if (given[role]) {
+            continue;
+        }
+        // With every core claimed, a role left out runs anywhere
+        for (int core = 0; core < available; ++core) {
+            if (!claimed.contains(core)) {
+                topology.m_cores[role].push_back(core);
+            }
+        }
+    }
+    topology.m_configured = true;
+    return topology;
+}
+
+std::span<const int> ThreadTopology::cores(ThreadRole role) const noexcept {
+    return m_cores[static_cast<std::size_t>(role)];
+}
+
+int ThreadTopology::core(ThreadRole role, std::size_t index) const noexcept {
+    const std::span<const int> list = cores(role);
+    return list.empty() ? -1 : list[index % list.size()];
+}
+
+void ThreadTopology::report(std::size_t reactors, std::size_t workers) const {
+    if (!m_configured) {
+        return;
+    }
+    const auto placed = [](std::span<const int> cores) {
+        return cores.empty() ? std::string("any core") : std::format("cores {} ({})", describe(cores), describeNodes(cores));
+    };
+    LOG_INFO("Topology: game thread on {}", placed(cores(ThreadRole::Game)));
+    for (std::size_t i = 0; i < reactors; ++i) {
+        const int at = core(ThreadRole::Reactors, i);
+        LOG_INFO("Topology: reactor {} on {}", i, at < 0 ? std::string("any core") : placed(std::span(&at, 1)));
+    }
+    if (workers != 0) {
+        LOG_INFO("Topology: {} workers on {}", workers, placed(cores(ThreadRole::Workers)));
+    }
+}
+
+int ThreadTopology::nodeOf(int core) {
+#if defined(__linux__)
+    std::error_code ec;
+    const std::filesystem::path cpu = std::format("/sys/devices/system/cpu/cpu{}", core);
+    for (const auto& entry : std::filesystem::directory_iterator(cpu, ec)) {
+        const std::string name = entry.path().filename().string();
+        int node = 0;
+        if (name.starts_with("node") && parseNumber(std::string_view(name).substr(4), node)) {
+            return node;
+        }
+    }
+#else
+    static_cast<void>(core);
+#endif
+    return -1;
+}
+
+bool ThreadTopology::pin(std::thread::native_handle_type thread, std::span<const int> cores) {
+#if defined(__linux__)
+    if (cores.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int core : cores) {
+        if (core >= 0 && core < CPU_SETSIZE) {
+            CPU_SET(core, &set);
+        }
+    }
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+    static_cast<void>(thread);
+    static_cast<void>(cores);
+    return false;
+#endif
+}
+
+bool ThreadTopology::pinCurrent(std::span<const int> cores) {
+#if defined(__linux__)
+    return pin(pthread_self(), cores);
+#else
+    static_cast<void>(cores);
+    return false;
+#endif
+}
+
+ScopedAffinity::ScopedAffinity(std::span<const int> cores) {
+#if defined(__linux__)
+    if (!cores.empty() && pthread_getaffinity_np(pthread_self(), sizeof(m_previous), &m_previous) == 0) {
+        m_restore = ThreadTopology::pinCurrent(cores);
+    }
+#else
+    static_cast<void>(cores);
+#endif
+}
+
+ScopedAffinity::~ScopedAffinity() {
+#if defined(__linux__)
+    if (m_restore) {
+        pthread_setaffinity_np(pthread_self(), sizeof(m_previous), &m_previous);
+    }
+#endif
+}
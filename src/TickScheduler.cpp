@@ -0,0 +1,351 @@
+#include "../include/TickScheduler.h"
+#include "../include/Metrics.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+TickScheduler::TickScheduler(Clock::duration period)
+    : m_period(std::max<Clock::duration>(period, std::chrono::milliseconds(1)))
+    , m_commandBudget(m_period / 2)
+    , m_origin(Clock::now())
+    , m_next(m_origin)
+    , m_timers(0) {
+    setRateLimit(kDefaultRateLimit);
+}
+
+TickUpdateId TickScheduler::addUpdate(unsigned interval, Update update) {
+    if (!update) {
+        return kInvalidTickUpdateId;
+    }
+    const TickUpdateId id = m_nextUpdateId++;
+    // Appending now could reallocate the list a running update lives in
+    auto& updates = m_runningUpdates ? m_pendingUpdates : m_updates;
+    updates.push_back({id, std::max(interval, 1u), std::move(update)});
+    wake();
+    return id;
+}
+
+void TickScheduler::removeUpdate(TickUpdateId id) {
+    if (id == kInvalidTickUpdateId) {
+        return;
+    }
+    std::erase_if(m_pendingUpdates, [id](const UpdateEntry& entry) { return entry.id == id; });
+    const auto found = std::find_if(m_updates.begin(), m_updates.end(),
+                                    [id](const UpdateEntry& entry) { return entry.id == id; });
+    if (found == m_updates.end()) {
+        return;
+    }
+    if (m_runningUpdates) {
+        // Erased once the updates finish, so the running one stays put
+        found->id = kInvalidTickUpdateId;
+        m_needsCompaction = true;
+    } else {
+        m_updates.erase(found);
+    }
+}
+
+void TickScheduler::schedule(Timer& timer, std::uint64_t delay) {
+    wake();
+    m_timers.schedule(timer, delay);
+}
+
+void TickScheduler::setRateLimit(std::uint32_t perSecond, std::uint32_t burst) {
+    constexpr std::uint64_t kOne = 1u << 16;
+    if (perSecond == 0 || burst == 0) {
+        m_refill = 0;
+        m_burst = 0;
+        return;
+    }
+    // Per boundary, never so little that a bucket stops refilling
+    const std::uint64_t refill = perSecond * kOne * static_cast<std::uint64_t>(m_period.count()) /
+                                 static_cast<std::uint64_t>(Clock::duration(std::chrono::seconds(1)).count());
+    m_refill = static_cast<std::uint32_t>(std::clamp<std::uint64_t>(refill, 1, UINT32_MAX));
+    m_burst = static_cast<std::uint32_t>(std::min<std::uint64_t>(burst, UINT16_MAX) * kOne);
+}
+
+EnqueueResult TickScheduler::enqueue(SessionId session, std::string line) {
+    constexpr std::uint32_t kOne = 1u << 16;
+    auto [found, inserted] = m_queues.try_emplace(session);
+    CommandQueue& queue = found->second;
+    if (m_refill != 0) {
+        // Top up for the boundaries since the last line, then charge this one
+        const std::uint64_t now = boundary();
+        if (inserted) {
+            queue.tokens = m_burst;
+        } else {
+            // Past enough boundaries to fill the bucket, the count no longer matters
+            const std::uint64_t elapsed = now > queue.refilled ? now - queue.refilled : 0;
+            const std::uint64_t gained = std::min<std::uint64_t>(elapsed, m_burst / m_refill + 1) * m_refill;
+            queue.tokens = static_cast<std::uint32_t>(std::min<std::uint64_t>(queue.tokens + gained, m_burst));
+        }
+        queue.refilled = now;
+        // Overloaded, the bucket fills as ever but each line costs double
+        const std::uint32_t cost = m_stage == LoadStage::Throttling ? std::min(2 * kOne, m_burst) : kOne;
+        if (queue.tokens < cost) {
+            ++m_stats.commandsThrottled;
+            return EnqueueResult::Throttled;
+        }
+        queue.tokens -= cost;
+    }
+    if (queue.lines.size() - queue.head >= kMaxQueuedCommands) {
+        ++m_stats.commandsDropped;
+        return EnqueueResult::QueueFull;
+    }
+    const CommandPriority priority = m_classifier ? m_classifier(session, line) : CommandPriority::Normal;
+    queue.stamps.push_back({currentTime(), priority});
+    queue.lines.push_back(std::move(line));
+    if (!queue.listed) {
+        queue.listed = true;
+        m_ready.push_back(session);
+        wake();
+    }
+    return EnqueueResult::Queued;
+}
+
+void TickScheduler::delaySession(SessionId session, std::uint32_t ticks) {
+    const auto found = m_queues.find(session);
+    if (found == m_queues.end() || ticks == 0) {
+        return;
+    }
+    // Without a wait the next command would run at the next boundary
+    CommandQueue& queue = found->second;
+    queue.readyAt = std::max(queue.readyAt, boundary() + 1 + ticks);
+}
+
+void TickScheduler::dropSession(SessionId session) {
+    if (m_queues.erase(session) != 0) {
+        // A turn already taken this tick is skipped once its queue is gone
+        std::erase(m_ready, session);
+    }
+}
+
+std::size_t TickScheduler::queuedCommands(SessionId session) const {
+    const auto found = m_queues.find(session);
+    return found == m_queues.end() ? 0 : found->second.lines.size() - found->second.head;
+}
+
+std::vector<std::string> TickScheduler::takeQueued(SessionId session) {
+    std::vector<std::string> lines;
+    const auto found = m_queues.find(session);
+    if (found != m_queues.end()) {
+        CommandQueue& queue = found->second;
+        lines.assign(std::make_move_iterator(queue.lines.begin() + static_cast<std::ptrdiff_t>(queue.head)),
+                     std::make_move_iterator(queue.lines.end()));
+        queue.lines.clear();
+        queue.stamps.clear();
+        queue.head = 0;
+        // An empty queue has no turn to take; outside a tick only m_ready lists it
+        if (std::exchange(queue.listed, false)) {
+            std::erase(m_ready, session);
+        }
+    }
+    return lines;
+}
+
+TickScheduler::Clock::time_point TickScheduler::nextTick() const {
+    return busy() ? m_next : Clock::time_point::max();
+}
+
+void TickScheduler::wake() {
+    if (!m_idle) {
+        return;
+    }
+    // Nothing ran while idle, so the wheel is empty and may jump to the
+    // boundary just passed
+    m_next = boundaryAfter(currentTime());
+    m_timers.rebase(boundaryIndex(m_next) - 1);
+    m_idle = false;
+}
+
+TickScheduler::Clock::time_point TickScheduler::boundaryAfter(Clock::time_point now) const {
+    return m_origin + ((now - m_origin) / m_period + 1) * m_period;
+}
+
+TickScheduler::Clock::time_point TickScheduler::run(Clock::time_point now) {
+    if (m_manualClock) {
+        m_now = std::max(m_now, now);
+    }
+    if (!busy()) {
+        m_idle = true;
+        return Clock::time_point::max();
+    }
+    if (now < m_next) {
+        return m_next;
+    }
+
+    // A late tick takes the place of the boundaries it overran
+    const auto missed = (now - m_next) / m_period;
+    m_stats.missed += static_cast<std::uint64_t>(missed);
+    const std::uint64_t boundary = boundaryIndex(m_next) + static_cast<std::uint64_t>(missed);
+    m_next += (missed + 1) * m_period;
+    ++m_stats.ticks;
+
+    const auto start = Clock::now();
+    m_ticking = true;
+    {
+        const PerfScope counted(&m_updateCounters);
+        m_stats.timersRun += m_timers.advance(boundary);
+        runUpdates();
+    }
+    const auto updated = Clock::now();
+    {
+        const PerfScope counted(&m_commandCounters);
+        runCommands(updated);
+    }
+    m_ticking = false;
+    m_scratch.release();
+    const auto end = Clock::now();
+
+    m_stats.updateTime += updated - start;
+    m_stats.commandTime += end - updated;
+    m_stats.longestTick = std::max<std::chrono::nanoseconds>(m_stats.longestTick, end - start);
+    Metrics::local().histogram(MetricHistogram::TickDuration).record(end - start);
+    if (end - start > m_period) {
+        ++m_stats.overruns;
+    }
+    // Missing boundaries means the loop around the ticks is late as well
+    updateLoad(missed > 0 ? std::max<Clock::duration>(end - start, m_period) : end - start);
+
+    if (!busy()) {
+        m_idle = true;
+        return Clock::time_point::max();
+    }
+    return m_next;
+}
+
+void TickScheduler::updateLoad(Clock::duration took) {
+    m_load += (took - m_load) / 8;
+    const Clock::duration quarter = m_period / 4;
+    switch (m_stage) {
+    case LoadStage::Normal:
+        if (m_load >= 3 * quarter) {
+            m_stage = m_load >= m_period ? LoadStage::Throttling : LoadStage::Deferring;
+        }
+        break;
+    case LoadStage::Deferring:
+        if (m_load >= m_period) {
+            m_stage = LoadStage::Throttling;
+        } else if (m_load < 2 * quarter) {
+            m_stage = LoadStage::Normal;
+        }
+        break;
+    case LoadStage::Throttling:
+        if (m_load < 3 * quarter) {
+            m_stage = m_load < 2 * quarter ? LoadStage::Normal : LoadStage::Deferring;
+        }
+        break;
+    }
+    m_stats.ticksDeferring += m_stage == LoadStage::Deferring ? 1 : 0;
+    m_stats.ticksThrottling += m_stage == LoadStage::Throttling ? 1 : 0;
+}
+
+void TickScheduler::runUpdates() {
+    const std::uint64_t tick = m_stats.ticks;
+    m_runningUpdates = true;
+    for (const UpdateEntry& entry : m_updates) {
+        if (entry.id != kInvalidTickUpdateId && tick % entry.interval == 0) {
+            entry.update(tick);
+        }
+    }
+    m_runningUpdates = false;
+
+    if (m_needsCompaction) {
+        std::erase_if(m_updates, [](const UpdateEntry& entry) { return entry.id == kInvalidTickUpdateId; });
+        m_needsCompaction = false;
+    }
+    if (!m_pendingUpdates.empty()) {
+        std::move(m_pendingUpdates.begin(), m_pendingUpdates.end(), std::back_inserter(m_updates));
+        m_pendingUpdates.clear();
+    }
+}
+
+void TickScheduler::runCommands(Clock::time_point start) {
+    if (m_ready.empty() || !m_runner) {
+        return;
+    }
+
+    // Each session queued before this tick gets one turn; those with more
+    // lines, and any queued meanwhile, go to the back for the next tick
+    m_waiting.clear();
+    m_waiting.swap(m_ready);
+    if (m_classifier) {
+        rankTurns(currentTime());
+    }
+    const auto deadline = start + (m_stage == LoadStage::Throttling ? m_commandBudget / 2 : m_commandBudget);
+    std::size_t turn = 0;
+    for (; turn < m_waiting.size(); ++turn) {
+        if (turn > 0 && Clock::now() >= deadline) {
+            break;
+        }
+        const SessionId session = m_waiting[turn];
+        auto found = m_queues.find(session);
+        if (found == m_queues.end()) {
+            continue;
+        }
+        // A session in a wait state keeps its place and runs nothing
+        if (found->second.readyAt > m_timers.now()) {
+            ++m_stats.turnsWaited;
+            m_ready.push_back(session);
+            continue;
+        }
+        const QueuedStamp stamp = found->second.stamps[found->second.head];
+        std::string line = std::move(found->second.lines[found->second.head++]);
+        const auto delayHistogram = static_cast<MetricHistogram>(
+            static_cast<std::size_t>(MetricHistogram::QueueDelayUrgent) + static_cast<std::size_t>(stamp.priority));
+        Metrics::local().histogram(delayHistogram).record(currentTime() - stamp.at);
+        m_runner(session, line);
+        ++m_stats.commandsRun;
+
+        // The runner may have queued more or dropped the session
+        found = m_queues.find(session);
+        if (found == m_queues.end()) {
+            continue;
+        }
+        CommandQueue& queue = found->second;
+        if (queue.head == queue.lines.size()) {
+            queue.lines.clear();
+            queue.stamps.clear();
+            queue.head = 0;
+            queue.listed = false;
+            continue;
+        }
+        // A session that never runs dry would otherwise grow its queue forever
+        if (queue.head >= kMaxQueuedCommands) {
+            queue.lines.erase(queue.lines.begin(), queue.lines.begin() + static_cast<std::ptrdiff_t>(queue.head));
+            queue.stamps.erase(queue.stamps.begin(), queue.stamps.begin() + static_cast<std::ptrdiff_t>(queue.head));
+            queue.head = 0;
+        }
+        m_ready.push_back(session);
+    }
+
+    // Sessions the budget did not reach keep their place at the front
+    if (turn < m_waiting.size()) {
+        m_stats.commandsDeferred += m_waiting.size() - turn;
+        m_ready.insert(m_ready.begin(), m_waiting.begin() + static_cast<std::ptrdiff_t>(turn), m_waiting.end());
+    }
+    if (m_flush) {
+        m_flush();
+    }
+}
+
+// Reorder the tick's turns by the rank of each session's next line, less
+// one for every kAgingTicks it has waited; stable, so turn order holds
+// within a rank
+void TickScheduler::rankTurns(Clock::time_point now) {
+    const auto agingPeriod = m_period * kAgingTicks;
+    for (const SessionId session : m_waiting) {
+        const auto found = m_queues.find(session);
+        std::size_t rank = static_cast<std::size_t>(CommandPriority::Normal);
+        if (found != m_queues.end() && found->second.head < found->second.stamps.size()) {
+            const QueuedStamp& stamp = found->second.stamps[found->second.head];
+            const auto promoted = static_cast<std::size_t>(std::max<Clock::duration>(now - stamp.at, {}) / agingPeriod);
+            rank = static_cast<std::size_t>(stamp.priority) - std::min(promoted, static_cast<std::size_t>(stamp.priority));
+        }
+        m_ranked[rank].push_back(session);
+    }
+    m_waiting.clear();
+    for (std::vector<SessionId>& ranked : m_ranked) {
+        m_waiting.insert(m_waiting.end(), ranked.begin(), ranked.end());
+        ranked.clear();
+    }
+}
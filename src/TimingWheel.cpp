@@ -0,0 +1,133 @@
+#include "../include/TimingWheel.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+void linkBefore(TimerLink& head, TimerLink& link) noexcept {
+    link.prev = head.prev;
+    link.next = &head;
+    head.prev->next = &link;
+    head.prev = &link;
+}
+
+void unlinkFrom(TimerLink& link) noexcept {
+    link.prev->next = link.next;
+    link.next->prev = link.prev;
+    link.prev = nullptr;
+    link.next = nullptr;
+}
+
+} // namespace
+
+void Timer::cancel() noexcept {
+    if (m_wheel) {
+        m_wheel->unlink(*this);
+    }
+}
+
+TimingWheel::TimingWheel(std::uint64_t now)
+    : m_now(now) {
+    for (TimerLink& slot : m_slots) {
+        slot.prev = &slot;
+        slot.next = &slot;
+    }
+}
+
+TimingWheel::~TimingWheel() {
+    // Timers that outlive the wheel must not reach back into it
+    for (TimerLink& slot : m_slots) {
+        while (slot.next != &slot) {
+            Timer& timer = static_cast<Timer&>(*slot.next);
+            unlinkFrom(timer);
+            timer.m_wheel = nullptr;
+        }
+    }
+}
+
+void TimingWheel::schedule(Timer& timer, std::uint64_t delay) {
+    if (timer.m_wheel) {
+        timer.m_wheel->unlink(timer);
+    }
+    // Tick m_now has already run, so the soonest is the next one
+    delay = std::clamp<std::uint64_t>(delay, 1, std::numeric_limits<std::uint64_t>::max() - m_now);
+    timer.m_expires = m_now + delay;
+    timer.m_wheel = this;
+    ++m_pending;
+    place(timer);
+}
+
+void TimingWheel::rebase(std::uint64_t now) noexcept {
+    if (m_pending == 0) {
+        m_now = now;
+    }
+}
+
+void TimingWheel::place(Timer& timer) {
+    const std::uint64_t delta = timer.m_expires - m_now;
+    if (delta < std::uint64_t{1} << kFirstBits) {
+        linkBefore(m_slots[slotOf(0, timer.m_expires)], timer);
+        return;
+    }
+    for (unsigned level = 1; level < kLevels; ++level) {
+        if (delta < std::uint64_t{1} << shiftOf(level + 1)) {
+            linkBefore(m_slots[slotOf(level, timer.m_expires)], timer);
+            return;
+        }
+    }
+    // Beyond the top wheel: wait in the slot furthest out and be placed again
+    linkBefore(m_slots[slotOf(kLevels - 1, m_now + kRange - 1)], timer);
+}
+
+void TimingWheel::cascade(unsigned level) {
+    TimerLink& slot = m_slots[slotOf(level, m_now)];
+    if (slot.next == &slot) {
+        return;
+    }
+    // Detach the whole list first; a timer may land back in this wheel
+    TimerLink moving;
+    moving.next = slot.next;
+    moving.prev = slot.prev;
+    moving.next->prev = &moving;
+    moving.prev->next = &moving;
+    slot.next = &slot;
+    slot.prev = &slot;
+    while (moving.next != &moving) {
+        Timer& timer = static_cast<Timer&>(*moving.next);
+        unlinkFrom(timer);
+        place(timer);
+    }
+}
+
+void TimingWheel::unlink(Timer& timer) noexcept {
+    unlinkFrom(timer);
+    timer.m_wheel = nullptr;
+    --m_pending;
+}
+
+std::size_t TimingWheel::advance(std::uint64_t now) {
+    std::size_t ran = 0;
+    while (m_now < now) {
+        if (m_pending == 0) {
+            m_now = now;
+            break;
+        }
+        ++m_now;
+
+        // Each wheel that wraps pulls the next slot down from the one above
+        for (unsigned level = 1; level < kLevels && (m_now & ((std::uint64_t{1} << shiftOf(level)) - 1)) == 0; ++level) {
+            cascade(level);
+        }
+
+        TimerLink& due = m_slots[slotOf(0, m_now)];
+        while (due.next != &due) {
+            Timer& timer = static_cast<Timer&>(*due.next);
+            unlink(timer);
+            ++ran;
+            if (timer.m_callback) {
+                timer.m_callback();
+            }
+        }
+    }
+    return ran;
+}
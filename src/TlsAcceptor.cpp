@@ -0,0 +1,276 @@
+#include "../include/TlsAcceptor.h"
+#include "../include/AccessList.h"
+#include "../include/Logger.h"
+#include "../include/SocketUtil.h"
+#include "../include/TlsStream.h"
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+namespace {
+
+// Shared by every worker; non-blocking, so those that lose the race for a connection go back to waiting
+std::expected<int, NetError> listenOn(const std::string& address, std::uint16_t port) {
+    sockaddr_in bound{};
+    bound.sin_family = AF_INET;
+    bound.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &bound.sin_addr) != 1) {
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || !SocketUtil::setNonBlocking(fd)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return std::unexpected(NetError::SOCKET_FAILED);
+    }
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound)) != 0) {
+        ::close(fd);
+        return std::unexpected(NetError::BIND_FAILED);
+    }
+    if (::listen(fd, SOMAXCONN) != 0) {
+        ::close(fd);
+        return std::unexpected(NetError::LISTEN_FAILED);
+    }
+    return fd;
+}
+
+SSL_CTX* createContext(const TlsAcceptor::Config& config) {
+    SSL_CTX* const context = SSL_CTX_new(TLS_server_method());
+    if (!context) {
+        return nullptr;
+    }
+    SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION);
+    // No tickets: nothing is resumed, and nothing is left to write after the handshake
+    SSL_CTX_set_num_tickets(context, 0);
+    SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(context, SSL_OP_NO_COMPRESSION | SSL_OP_NO_RENEGOTIATION);
+#if defined(SSL_OP_ENABLE_KTLS)
+    if (config.kernelTls) {
+        SSL_CTX_set_options(context, SSL_OP_ENABLE_KTLS);
+    }
+#endif
+    // Thousands of idle sessions hold no record buffers
+    SSL_CTX_set_mode(context, SSL_MODE_RELEASE_BUFFERS);
+    if (SSL_CTX_use_certificate_chain_file(context, config.certificate.c_str()) != 1 ||
+        SSL_CTX_use_PrivateKey_file(context, config.key.c_str(), SSL_FILETYPE_PEM) != 1 ||
+        SSL_CTX_check_private_key(context) != 1) {
+        const char* const reason = ERR_reason_error_string(ERR_get_error());
+        LOG_ERROR("TLS certificate {} or key {} unusable: {}", config.certificate, config.key,
+                  reason ? reason : "unknown error");
+        SSL_CTX_free(context);
+        return nullptr;
+    }
+    return context;
+}
+
+} // namespace
+
+TlsAcceptor::TlsAcceptor(const Config& config, std::vector<NetReactor*> reactors)
+    : m_config(config), m_reactors(std::move(reactors)) {
+}
+
+std::expected<std::unique_ptr<TlsAcceptor>, NetError> TlsAcceptor::create(const Config& config,
+                                                                         std::vector<NetReactor*> reactors) {
+    if (reactors.empty()) {
+        return std::unexpected(NetError::POLLER_FAILED);
+    }
+    std::unique_ptr<TlsAcceptor> acceptor(new TlsAcceptor(config, std::move(reactors)));
+    acceptor->m_context = createContext(config);
+    if (!acceptor->m_context) {
+        return std::unexpected(NetError::TLS_FAILED);
+    }
+    const auto listening = listenOn(config.address, config.port);
+    if (!listening) {
+        return std::unexpected(listening.error());
+    }
+    acceptor->m_listenFd = *listening;
+    if (::pipe(acceptor->m_stopPipe.data()) != 0) {
+        return std::unexpected(NetError::POLLER_FAILED);
+    }
+    for (const int fd : acceptor->m_stopPipe) {
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    return acceptor;
+}
+
+TlsAcceptor::~TlsAcceptor() {
+    stop();
+    for (const int fd : {m_listenFd, m_stopPipe[0], m_stopPipe[1]}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    SSL_CTX_free(m_context);
+}
+
+void TlsAcceptor::start() {
+    if (!m_workers.empty()) {
+        return;
+    }
+    for (unsigned i = 0; i < std::max(1u, m_config.workers); ++i) {
+        m_workers.emplace_back(&TlsAcceptor::work, this);
+    }
+}
+
+void TlsAcceptor::stop() {
+    if (m_workers.empty()) {
+        return;
+    }
+    // Never read, so it stays readable for every worker
+    const char byte = 0;
+    [[maybe_unused]] const ssize_t written = ::write(m_stopPipe[1], &byte, 1);
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+TlsStats TlsAcceptor::stats() const noexcept {
+    return {m_kernel.load(std::memory_order_relaxed), m_partial.load(std::memory_order_relaxed),
+            m_userspace.load(std::memory_order_relaxed), m_failed.load(std::memory_order_relaxed)};
+}
+
+// Each worker carries its handshakes forward together, so clients that
+// are slow to answer (or never do) hold up no one but themselves
+void TlsAcceptor::work() {
+    std::vector<Handshake> handshakes;
+    std::vector<pollfd> ready;
+    for (;;) {
+        // Past kMaxHandshakes a worker takes no more; the backlog and the other workers do
+        const bool accepting = handshakes.size() < kMaxHandshakes;
+        ready.clear();
+        ready.push_back({m_stopPipe[0], POLLIN, 0});
+        ready.push_back({accepting ? m_listenFd : -1, POLLIN, 0});
+        auto soonest = std::chrono::steady_clock::time_point::max();
+        for (const Handshake& handshake : handshakes) {
+            ready.push_back({handshake.fd, handshake.events, 0});
+            soonest = std::min(soonest, handshake.deadline);
+        }
+        int timeoutMs = -1;
+        if (!handshakes.empty()) {
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(soonest - std::chrono::steady_clock::now());
+            timeoutMs = static_cast<int>(std::max<std::chrono::milliseconds::rep>(wait.count(), 0));
+        }
+        if (::poll(ready.data(), ready.size(), timeoutMs) < 0 && errno != EINTR) {
+            continue;
+        }
+        if (ready[0].revents != 0) {
+            // Abandoned
+            for (Handshake& handshake : handshakes) {
+                fail(handshake);
+            }
+            return;
+        }
+
+        // Those that can go on, and those out of time; the rest keep their place
+        const auto now = std::chrono::steady_clock::now();
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < handshakes.size(); ++i) {
+            Handshake& handshake = handshakes[i];
+            bool waiting = true;
+            if (ready[i + 2].revents != 0) {
+                waiting = advance(handshake);
+            } else if (now >= handshake.deadline) {
+                fail(handshake);
+                waiting = false;
+            }
+            if (waiting) {
+                handshakes[kept++] = handshake;
+            }
+        }
+        handshakes.resize(kept);
+
+        if (ready[1].revents != 0) {
+            accept(handshakes);
+        }
+    }
+}
+
+// Whatever connections are waiting, each with a handshake begun
+void TlsAcceptor::accept(std::vector<Handshake>& handshakes) {
+    while (handshakes.size() < kMaxHandshakes) {
+        const int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // The listener stays readable; wait a moment for a descriptor to come free
+                pollfd stopping{m_stopPipe[0], POLLIN, 0};
+                ::poll(&stopping, 1, 100);
+            }
+            return;
+        }
+        if (m_config.access && m_config.access->denied(fd)) {
+            ::close(fd);
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        SSL* const ssl = SSL_new(m_context);
+        Handshake handshake{fd, ssl, std::chrono::steady_clock::now() + m_config.handshakeTimeout, POLLIN};
+        if (!SocketUtil::setNonBlocking(fd) || !ssl || SSL_set_fd(ssl, fd) != 1) {
+            fail(handshake);
+            continue;
+        }
+        // The client's hello may be here already
+        if (advance(handshake)) {
+            handshakes.push_back(handshake);
+        }
+    }
+}
+
+// Take the handshake as far as the client allows; false once it is over,
+// the session given to a reactor or the connection closed
+bool TlsAcceptor::advance(Handshake& handshake) {
+    const int result = SSL_accept(handshake.ssl);
+    if (result == 1) {
+        finish(handshake);
+        return false;
+    }
+    const int error = SSL_get_error(handshake.ssl, result);
+    ERR_clear_error();
+    if (error != SSL_ERROR_WANT_READ && error != SSL_ERROR_WANT_WRITE) {
+        fail(handshake);
+        return false;
+    }
+    handshake.events = error == SSL_ERROR_WANT_READ ? POLLIN : POLLOUT;
+    return true;
+}
+
+void TlsAcceptor::fail(Handshake& handshake) {
+    SSL_free(handshake.ssl);
+    ::close(handshake.fd);
+    m_failed.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Leave the rest of the session to the kernel, or to a TlsStream, and the reactor
+void TlsAcceptor::finish(Handshake& handshake) {
+    std::unique_ptr<TlsStream> stream = TlsStream::adopt(handshake.ssl);
+    if (!stream) {
+        m_kernel.fetch_add(1, std::memory_order_relaxed);
+    } else if (stream->decrypts() && stream->encrypts()) {
+        m_userspace.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        m_partial.fetch_add(1, std::memory_order_relaxed);
+    }
+    LOG_DEBUG("Connection {}: TLS handshake done, records {}", handshake.fd,
+              !stream ? "in the kernel" : stream->decrypts() && stream->encrypts() ? "in userspace" : "split");
+    pickReactor().attach(handshake.fd, std::move(stream));
+}
+
+NetReactor& TlsAcceptor::pickReactor() const noexcept {
+    return **std::min_element(m_reactors.begin(), m_reactors.end(), [](const NetReactor* a, const NetReactor* b) {
+        return a->sessionCount() < b->sessionCount();
+    });
+}
@@ -0,0 +1,91 @@
+#include "../include/TlsStream.h"
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+namespace {
+
+constexpr std::size_t kRecordChunk = 16 * 1024;   // A whole TLS record's plain text
+
+} // namespace
+
+std::unique_ptr<TlsStream> TlsStream::adopt(ssl_st* ssl) {
+    const bool kernelSends = BIO_get_ktls_send(SSL_get_wbio(ssl)) != 0;
+    const bool kernelReceives = BIO_get_ktls_recv(SSL_get_rbio(ssl)) != 0;
+    if (kernelSends && kernelReceives) {
+        // The descriptor is the reactor's, and no close_notify is wanted yet
+        SSL_free(ssl);
+        return nullptr;
+    }
+    // The socket BIO stays only for a direction the kernel has
+    if (!kernelReceives) {
+        SSL_set0_rbio(ssl, BIO_new(BIO_s_mem()));
+    }
+    if (!kernelSends) {
+        SSL_set0_wbio(ssl, BIO_new(BIO_s_mem()));
+    }
+    return std::unique_ptr<TlsStream>(new TlsStream(ssl, !kernelReceives, !kernelSends));
+}
+
+TlsStream::TlsStream(ssl_st* ssl, bool decrypts, bool encrypts) noexcept
+    : m_ssl(ssl), m_decrypts(decrypts), m_encrypts(encrypts) {
+}
+
+TlsStream::~TlsStream() {
+    SSL_free(m_ssl);
+}
+
+bool TlsStream::decrypt(std::string_view records, std::string& out) {
+    if (!records.empty() && BIO_write(SSL_get_rbio(m_ssl), records.data(), static_cast<int>(records.size())) <= 0) {
+        return false;
+    }
+    for (;;) {
+        const std::size_t used = out.size();
+        out.resize(used + kRecordChunk);
+        const int got = SSL_read(m_ssl, out.data() + used, static_cast<int>(kRecordChunk));
+        out.resize(used + static_cast<std::size_t>(got > 0 ? got : 0));
+        if (got > 0) {
+            continue;
+        }
+        // Waiting on the rest of a record is the only way to stop cleanly
+        const int error = SSL_get_error(m_ssl, got);
+        ERR_clear_error();
+        return error == SSL_ERROR_WANT_READ;
+    }
+}
+
+bool TlsStream::encrypt(std::string_view text, std::string& out) {
+    if (!text.empty() && SSL_write(m_ssl, text.data(), static_cast<int>(text.size())) <= 0) {
+        ERR_clear_error();
+        return false;
+    }
+    return drain(out);
+}
+
+bool TlsStream::owes() const noexcept {
+    return m_encrypts && BIO_ctrl_pending(SSL_get_wbio(m_ssl)) > 0;
+}
+
+void TlsStream::close(std::string& out) {
+    if (m_closed) {
+        return;
+    }
+    m_closed = true;
+    SSL_shutdown(m_ssl);
+    ERR_clear_error();
+    if (m_encrypts) {
+        drain(out);
+    }
+}
+
+// Whatever records sit in the write BIO, onto out
+bool TlsStream::drain(std::string& out) {
+    BIO* const written = SSL_get_wbio(m_ssl);
+    char* data = nullptr;
+    const long size = BIO_get_mem_data(written, &data);
+    if (size > 0) {
+        out.append(data, static_cast<std::size_t>(size));
+        return BIO_reset(written) == 1;
+    }
+    return true;
+}
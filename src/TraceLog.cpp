@@ -0,0 +1,303 @@
+#include "../include/TraceLog.h"
+#include <format>
+#include <mutex>
+#include <new>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+std::atomic<TraceLog*> TraceLog::s_active{nullptr};
+
+namespace {
+
+// Every format string defined in this process, by id - 1, and the trace
+// they are written into; taken only to define one or start a trace
+std::mutex g_eventsMutex;
+std::vector<std::string_view> g_events;
+
+std::atomic<std::uint64_t> g_traceIds{0};
+std::atomic<std::uint32_t> g_threads{0};
+
+std::uint64_t steadyNanoseconds() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+constexpr bool kTicksAreNanoseconds =
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    false;
+#else
+    true;
+#endif
+
+} // namespace
+
+std::unique_ptr<TraceLog> TraceLog::start(const std::filesystem::path& path, std::size_t bytes) {
+#ifdef _WIN32
+    (void)path;
+    (void)bytes;
+    return nullptr;
+#else
+    const std::size_t chunkBytes = kChunkRecords * sizeof(TraceRecord);
+    const std::size_t chunksOffset = 4096 + kEventsBytes;
+    const std::size_t chunkCount = std::max<std::size_t>((bytes > chunksOffset ? bytes - chunksOffset : 0) / chunkBytes, 16);
+    const std::size_t size = chunksOffset + chunkCount * chunkBytes;
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    // Fault the pages in now rather than on the game thread's first records
+    flags |= MAP_POPULATE;
+#endif
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::unique_ptr<TraceLog> trace(new TraceLog());
+    trace->m_path = path;
+    trace->m_id = g_traceIds.fetch_add(1, std::memory_order_relaxed) + 1;
+    trace->m_mapping = static_cast<char*>(mapping);
+    trace->m_size = size;
+    trace->m_header = new (trace->m_mapping) TraceFileHeader();
+    trace->m_chunks = reinterpret_cast<TraceChunkHeader*>(trace->m_mapping + chunksOffset);
+
+    TraceFileHeader& header = *trace->m_header;
+    header.chunkRecords = static_cast<std::uint32_t>(kChunkRecords);
+    header.chunkCount = static_cast<std::uint32_t>(chunkCount);
+    header.eventsOffset = 4096;
+    header.eventsCapacity = kEventsBytes;
+    header.chunksOffset = chunksOffset;
+    header.startTicks = traceTicks();
+    header.startSteady = steadyNanoseconds();
+    header.startSystem = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    header.ticksAreNanoseconds = kTicksAreNanoseconds ? 1 : 0;
+
+    const std::lock_guard<std::mutex> lock(g_eventsMutex);
+    TraceLog* expected = nullptr;
+    if (!s_active.compare_exchange_strong(expected, trace.get())) {
+        return nullptr;
+    }
+    for (std::size_t i = 0; i < g_events.size(); ++i) {
+        trace->writeEvent(static_cast<std::uint16_t>(i + 1), g_events[i]);
+    }
+    return trace;
+#endif
+}
+
+TraceLog::~TraceLog() {
+    {
+        const std::lock_guard<std::mutex> lock(g_eventsMutex);
+        TraceLog* expected = this;
+        s_active.compare_exchange_strong(expected, nullptr);
+    }
+#ifndef _WIN32
+    if (m_mapping) {
+        ::msync(m_mapping, m_size, MS_ASYNC);
+        ::munmap(m_mapping, m_size);
+    }
+#endif
+}
+
+std::uint16_t TraceLog::define(std::string_view format) {
+    const std::lock_guard<std::mutex> lock(g_eventsMutex);
+    // Ids are 16 bits; past that, points share the last one rather than fail
+    if (g_events.size() >= 0xffff) {
+        return 0xffff;
+    }
+    g_events.push_back(format);
+    const auto id = static_cast<std::uint16_t>(g_events.size());
+    if (TraceLog* trace = s_active.load(std::memory_order_relaxed)) {
+        trace->writeEvent(id, format);
+    }
+    return id;
+}
+
+void TraceLog::writeEvent(std::uint16_t id, std::string_view format) {
+    const std::uint16_t size = static_cast<std::uint16_t>(std::min<std::size_t>(format.size(), 0xffff));
+    const std::size_t used = m_header->eventsUsed;
+    const std::size_t needed = (4 + size + 3) / 4 * 4;
+    if (used + needed > m_header->eventsCapacity) {
+        return;
+    }
+    char* at = m_mapping + m_header->eventsOffset + used;
+    std::memcpy(at, &id, sizeof id);
+    std::memcpy(at + 2, &size, sizeof size);
+    std::memcpy(at + 4, format.data(), size);
+    std::atomic_ref<std::uint64_t>(m_header->eventsUsed).store(used + needed, std::memory_order_release);
+}
+
+std::uint64_t TraceLog::chunksClaimed() const noexcept {
+    return std::atomic_ref<std::uint64_t>(m_header->nextChunk).load(std::memory_order_relaxed);
+}
+
+void TraceLog::claim(Cursor& cursor) noexcept {
+    if (cursor.thread == 0) {
+        cursor.thread = g_threads.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    const std::uint64_t claimed =
+        std::atomic_ref<std::uint64_t>(m_header->nextChunk).fetch_add(1, std::memory_order_relaxed);
+    TraceChunkHeader* chunk = reinterpret_cast<TraceChunkHeader*>(
+        reinterpret_cast<char*>(m_chunks) + (claimed % m_header->chunkCount) * kChunkRecords * sizeof(TraceRecord));
+
+    // Emptied before it is marked taken, so a reader never pairs the new
+    // generation with the old records
+    std::atomic_ref<std::uint32_t>(chunk->count).store(0, std::memory_order_relaxed);
+    chunk->thread = cursor.thread;
+    chunk->claimTicks = traceTicks();
+    chunk->claimSteady = steadyNanoseconds();
+    std::atomic_ref<std::uint64_t>(chunk->generation).store(claimed + 1, std::memory_order_release);
+
+    cursor.trace = m_id;
+    cursor.chunk = chunk;
+    cursor.next = first(chunk);
+    cursor.end = reinterpret_cast<TraceRecord*>(chunk) + kChunkRecords;
+}
+
+TraceReader TraceReader::open(const std::filesystem::path& path) {
+    TraceReader reader;
+    reader.m_file = FileView(path);
+    const std::string_view bytes = reader.m_file.bytes();
+    if (bytes.size() < sizeof(TraceFileHeader)) {
+        return {};
+    }
+    const auto* header = reinterpret_cast<const TraceFileHeader*>(bytes.data());
+    const TraceFileHeader expected;
+    const std::size_t chunkBytes = std::size_t{header->chunkRecords} * sizeof(TraceRecord);
+    if (std::memcmp(header->magic, expected.magic, sizeof expected.magic) != 0 || header->version != expected.version ||
+        header->recordSize != sizeof(TraceRecord) || header->chunkRecords < 2 ||
+        header->eventsOffset + header->eventsCapacity > bytes.size() || header->eventsUsed > header->eventsCapacity ||
+        header->chunksOffset > bytes.size() ||
+        header->chunkCount > (bytes.size() - header->chunksOffset) / chunkBytes) {
+        return {};
+    }
+
+    // Format strings
+    std::string_view events = bytes.substr(header->eventsOffset, header->eventsUsed);
+    while (events.size() >= 4) {
+        std::uint16_t id = 0;
+        std::uint16_t size = 0;
+        std::memcpy(&id, events.data(), sizeof id);
+        std::memcpy(&size, events.data() + 2, sizeof size);
+        if (4u + size > events.size()) {
+            break;
+        }
+        reader.m_events.emplace(id, events.substr(4, size));
+        events.remove_prefix(std::min<std::size_t>((4 + size + 3) / 4 * 4, events.size()));
+    }
+
+    // Ticks to nanoseconds, from the start and the latest claim
+    double nanosecondsPerTick = 1.0;
+    std::uint64_t endTicks = header->startTicks;
+    std::uint64_t endSteady = header->startSteady;
+    const char* chunks = bytes.data() + header->chunksOffset;
+    for (std::uint32_t i = 0; i < header->chunkCount; ++i) {
+        const auto* chunk = reinterpret_cast<const TraceChunkHeader*>(chunks + i * chunkBytes);
+        if (chunk->generation != 0 && chunk->claimTicks > endTicks) {
+            endTicks = chunk->claimTicks;
+            endSteady = chunk->claimSteady;
+        }
+    }
+    if (!header->ticksAreNanoseconds && endTicks > header->startTicks && endSteady > header->startSteady) {
+        nanosecondsPerTick = static_cast<double>(endSteady - header->startSteady) /
+                             static_cast<double>(endTicks - header->startTicks);
+    }
+
+    for (std::uint32_t i = 0; i < header->chunkCount; ++i) {
+        const auto* chunk = reinterpret_cast<const TraceChunkHeader*>(chunks + i * chunkBytes);
+        if (chunk->generation == 0) {
+            continue;
+        }
+        const auto* records = reinterpret_cast<const TraceRecord*>(chunk) + 1;
+        const std::uint32_t count = std::min(chunk->count, header->chunkRecords - 1);
+        for (std::uint32_t r = 0; r < count; ++r) {
+            const TraceRecord& record = records[r];
+            const double since = record.ticks >= header->startTicks
+                                     ? static_cast<double>(record.ticks - header->startTicks) * nanosecondsPerTick
+                                     : 0.0;
+            reader.m_entries.push_back({static_cast<std::uint64_t>(since), chunk->thread, &record});
+        }
+    }
+    std::stable_sort(reader.m_entries.begin(), reader.m_entries.end(),
+                     [](const Entry& a, const Entry& b) { return a.record->ticks < b.record->ticks; });
+    reader.m_header = header;
+    return reader;
+}
+
+std::string TraceReader::format(const TraceRecord& record) const {
+    const auto found = m_events.find(record.event);
+    if (found == m_events.end()) {
+        return std::format("(unknown event {})", record.event);
+    }
+    const std::string_view format = found->second;
+    const std::size_t count = std::min<std::size_t>(record.argCount, kTraceArgs);
+
+    // Each {} takes the next argument, formatted as the kind it was stored as,
+    // so its spec (such as {:x}) still applies
+    std::string out;
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+            out += c;
+            ++i;
+            continue;
+        }
+        if (c != '{') {
+            out += c;
+            continue;
+        }
+        const std::size_t close = format.find('}', i);
+        if (close == std::string_view::npos) {
+            out += format.substr(i);
+            break;
+        }
+        const std::string spec = std::string("{") + std::string(format.substr(i + 1, close - i - 1)) + "}";
+        i = close;
+        if (next >= count) {
+            out += "?";
+            continue;
+        }
+        const std::uint64_t value = record.args[next];
+        const auto kind = static_cast<TraceArg>((record.kinds >> (2 * next)) & 3);
+        ++next;
+        try {
+            switch (kind) {
+                case TraceArg::UInt:
+                    out += std::vformat(spec, std::make_format_args(value));
+                    break;
+                case TraceArg::Int: {
+                    const auto signedValue = static_cast<std::int64_t>(value);
+                    out += std::vformat(spec, std::make_format_args(signedValue));
+                    break;
+                }
+                case TraceArg::Double: {
+                    const double real = std::bit_cast<double>(value);
+                    out += std::vformat(spec, std::make_format_args(real));
+                    break;
+                }
+                case TraceArg::Text: {
+                    char text[sizeof value];
+                    std::memcpy(text, &value, sizeof value);
+                    const std::string_view view(text, std::find(text, text + sizeof text, '\0') - text);
+                    out += std::vformat(spec, std::make_format_args(view));
+                    break;
+                }
+            }
+        } catch (const std::format_error&) {
+            out += "?";
+        }
+    }
+    return out;
+}
@@ -0,0 +1,179 @@
+#include "../include/Utf8.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+struct Range {
+    char32_t first;
+    char32_t last;
+};
+
+// Nonspacing and enclosing marks, format characters and variation selectors
+// (abridged from the Unicode Mn/Me/Cf categories)
+constexpr Range kZeroWidth[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x05BF, 0x05BF},
+    {0x05C1, 0x05C2}, {0x05C4, 0x05C5}, {0x05C7, 0x05C7}, {0x0610, 0x061A},
+    {0x064B, 0x065F}, {0x0670, 0x0670}, {0x06D6, 0x06DC}, {0x06DF, 0x06E4},
+    {0x06E7, 0x06E8}, {0x06EA, 0x06ED}, {0x0900, 0x0902}, {0x093A, 0x093A},
+    {0x093C, 0x093C}, {0x0941, 0x0948}, {0x094D, 0x094D}, {0x0951, 0x0957},
+    {0x0E31, 0x0E31}, {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E}, {0x1AB0, 0x1AFF},
+    {0x1DC0, 0x1DFF}, {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x2064},
+    {0x20D0, 0x20FF}, {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F}, {0xFEFF, 0xFEFF},
+    {0xE0100, 0xE01EF},
+};
+
+// East Asian Wide and Fullwidth blocks plus the emoji planes
+constexpr Range kWide[] = {
+    {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC},
+    {0x2614, 0x2615}, {0x2648, 0x2653}, {0x26A1, 0x26A1}, {0x26AA, 0x26AB},
+    {0x26BD, 0x26BE}, {0x26C4, 0x26C5}, {0x26D4, 0x26D4}, {0x26EA, 0x26EA},
+    {0x26F2, 0x26F5}, {0x26FA, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B},
+    {0x2728, 0x2728}, {0x274C, 0x274C}, {0x2753, 0x2755}, {0x2757, 0x2757},
+    {0x2795, 0x2797}, {0x27B0, 0x27B0}, {0x27BF, 0x27BF}, {0x2B1B, 0x2B1C},
+    {0x2B50, 0x2B50}, {0x2B55, 0x2B55}, {0x2E80, 0x303E}, {0x3041, 0x33FF},
+    {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xA000, 0xA4CF}, {0xA960, 0xA97F},
+    {0xAC00, 0xD7A3}, {0xF900, 0xFAFF}, {0xFE10, 0xFE19}, {0xFE30, 0xFE6F},
+    {0xFF00, 0xFF60}, {0xFFE0, 0xFFE6}, {0x16FE0, 0x16FE4}, {0x17000, 0x18CFF},
+    {0x1B000, 0x1B2FF}, {0x1F004, 0x1F004}, {0x1F0CF, 0x1F0CF}, {0x1F18E, 0x1F18E},
+    {0x1F191, 0x1F19A}, {0x1F200, 0x1F251}, {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF},
+    {0x1F7E0, 0x1F7EB}, {0x1F90C, 0x1F9FF}, {0x1FA70, 0x1FAFF}, {0x20000, 0x2FFFD},
+    {0x30000, 0x3FFFD},
+};
+
+template <std::size_t N>
+bool inTable(const Range (&table)[N], char32_t codepoint) noexcept {
+    if (codepoint < table[0].first || codepoint > table[N - 1].last) {
+        return false;
+    }
+    auto it = std::upper_bound(std::begin(table), std::end(table), codepoint,
+                               [](char32_t cp, const Range& range) { return cp < range.first; });
+    return it != std::begin(table) && codepoint <= std::prev(it)->last;
+}
+
+bool isContinuation(unsigned char byte) noexcept {
+    return (byte & 0xC0) == 0x80;
+}
+
+} // namespace
+
+namespace Utf8 {
+
+Decoded decode(std::string_view text, std::size_t pos) noexcept {
+    const auto lead = static_cast<unsigned char>(text[pos]);
+    if (lead < 0x80) {
+        return {lead, 1};
+    }
+
+    std::uint8_t length;
+    char32_t codepoint;
+    char32_t minimum;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2; codepoint = lead & 0x1F; minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3; codepoint = lead & 0x0F; minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4; codepoint = lead & 0x07; minimum = 0x10000;
+    } else {
+        return {kReplacement, 1};
+    }
+
+    if (pos + length > text.size()) {
+        return {kReplacement, 1};
+    }
+    for (std::uint8_t i = 1; i < length; ++i) {
+        const auto byte = static_cast<unsigned char>(text[pos + i]);
+        if (!isContinuation(byte)) {
+            return {kReplacement, 1};
+        }
+        codepoint = (codepoint << 6) | (byte & 0x3F);
+    }
+
+    // Overlong forms, surrogates and values past U+10FFFF are not allowed
+    if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return {kReplacement, 1};
+    }
+    return {codepoint, length};
+}
+
+int codepointWidth(char32_t codepoint) noexcept {
+    if (codepoint < 0x300) {
+        return 1;
+    }
+    if (inTable(kZeroWidth, codepoint)) {
+        return 0;
+    }
+    return inTable(kWide, codepoint) ? 2 : 1;
+}
+
+bool isAscii(std::string_view text) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= text.size(); i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, text.data() + i, sizeof(word));
+        if (word & 0x8080808080808080ull) {
+            return false;
+        }
+    }
+    for (; i < text.size(); ++i) {
+        if (static_cast<unsigned char>(text[i]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t displayWidth(std::string_view text) noexcept {
+    std::size_t columns = 0;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const auto byte = static_cast<unsigned char>(text[pos]);
+        if (byte < 0x80) {
+            columns += byte != '\n';
+            ++pos;
+            continue;
+        }
+        const Decoded decoded = decode(text, pos);
+        columns += static_cast<std::size_t>(codepointWidth(decoded.codepoint));
+        pos += decoded.length;
+    }
+    return columns;
+}
+
+std::size_t bytesForColumns(std::string_view text, std::size_t columns) noexcept {
+    std::size_t used = 0;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const Decoded decoded = decode(text, pos);
+        const auto width = static_cast<std::size_t>(codepointWidth(decoded.codepoint));
+        if (used + width > columns) {
+            break;
+        }
+        used += width;
+        pos += decoded.length;
+    }
+    return pos;
+}
+
+std::size_t nextBoundary(std::string_view text, std::size_t pos) noexcept {
+    if (pos >= text.size()) {
+        return text.size();
+    }
+    return pos + decode(text, pos).length;
+}
+
+std::size_t prevBoundary(std::string_view text, std::size_t pos) noexcept {
+    if (pos == 0) {
+        return 0;
+    }
+    // Step back over at most three continuation bytes, then check that the
+    // sequence found really ends at pos; otherwise the last byte stands alone
+    std::size_t start = pos - 1;
+    while (start > 0 && pos - start < 4 && isContinuation(static_cast<unsigned char>(text[start]))) {
+        --start;
+    }
+    return start + decode(text, start).length == pos ? start : pos - 1;
+}
+
+} // namespace Utf8
@@ -0,0 +1,446 @@
+#include "../include/VtRenderer.h"
+#include "../include/Utf8.h"
+#include <algorithm>
+#include <cerrno>
+#include <format>
+#include <iterator>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Encode a code point as UTF-8 into out, which has room for four bytes
+std::size_t encode(char32_t codepoint, char* out) noexcept {
+    if (codepoint < 0x80) {
+        out[0] = static_cast<char>(codepoint);
+        return 1;
+    }
+    if (codepoint < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (codepoint >> 6));
+        out[1] = static_cast<char>(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    if (codepoint < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (codepoint >> 12));
+        out[1] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (codepoint >> 18));
+    out[1] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+// Cells from here on are rewritten rather than skipped with a cursor move
+// when fewer than this many unchanged ones lie between two changes
+constexpr int kRewriteGap = 4;
+
+}  // namespace
+
+VtRenderer::VtRenderer(int fd) : m_fd(fd) {}
+
+VtRenderer::~VtRenderer() {
+    end();
+}
+
+bool VtRenderer::begin(int inputFd, std::string_view enter, std::string_view leave) {
+#if defined(_WIN32)
+    static_cast<void>(inputFd);
+    static_cast<void>(enter);
+    static_cast<void>(leave);
+    return false;
+#else
+    if (m_active || tcgetattr(inputFd, &m_savedModes) != 0) {
+        return false;
+    }
+    // As curses' raw(): bytes as they are typed, unechoed, and Ctrl-C and
+    // Ctrl-Z as keys rather than signals
+    termios raw = m_savedModes;
+    raw.c_iflag &= ~static_cast<tcflag_t>(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+    raw.c_lflag &= ~static_cast<tcflag_t>(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    raw.c_cflag = (raw.c_cflag & ~static_cast<tcflag_t>(CSIZE | PARENB)) | CS8;
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(inputFd, TCSAFLUSH, &raw) != 0) {
+        return false;
+    }
+    m_active = true;
+    m_inputFd = inputFd;
+    m_leave = leave;
+
+    // The alternate screen keeps the shell's scrollback intact
+    m_out.assign("\x1b[?1049h");
+    m_out.append(enter);
+    flush();
+    m_invalid = true;
+    return true;
+#endif
+}
+
+void VtRenderer::end() {
+#if !defined(_WIN32)
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    m_out.assign("\x1b[0m\x1b[?25h");
+    m_out.append(m_leave);
+    m_out.append("\x1b[?1049l");
+    flush();
+    tcsetattr(m_inputFd, TCSAFLUSH, &m_savedModes);
+#endif
+}
+
+void VtRenderer::resize(int rows, int cols) {
+    m_rows = std::max(rows, 0);
+    m_cols = std::max(cols, 0);
+    const std::size_t cells = std::size_t(m_rows) * std::size_t(m_cols);
+    m_front.assign(cells, Cell{});
+    m_back.assign(cells, Cell{});
+    m_frontHashes.assign(std::size_t(m_rows), 0);
+    m_backHashes.assign(std::size_t(m_rows), 0);
+    if (m_scrollBottom >= m_rows) {
+        m_scrollTop = m_scrollBottom = -1;
+    }
+    m_invalid = true;
+}
+
+void VtRenderer::fill(int rowIndex, int col, int count, VtStyle style) {
+    if (rowIndex < 0 || rowIndex >= m_rows || col >= m_cols) {
+        return;
+    }
+    col = std::max(col, 0);
+    count = std::min(count, m_cols - col);
+    Cell blank;
+    blank.style = style;
+    std::fill_n(row(m_back, rowIndex) + col, std::max(count, 0), blank);
+}
+
+int VtRenderer::put(int rowIndex, int col, int endCol, std::string_view text, VtStyle style) {
+    if (rowIndex < 0 || rowIndex >= m_rows) {
+        return col;
+    }
+    endCol = std::min(endCol, m_cols);
+    Cell* cells = row(m_back, rowIndex);
+    Cell* last = nullptr;   // The cell zero-width marks join
+    std::size_t pos = 0;
+    while (pos < text.size() && col < endCol) {
+        const Utf8::Decoded decoded = Utf8::decode(text, pos);
+        pos += decoded.length;
+        const int width = Utf8::codepointWidth(decoded.codepoint);
+        if (width == 0) {
+            char bytes[4];
+            const std::size_t length = encode(decoded.codepoint, bytes);
+            if (last && last->length + length <= last->glyph.size()) {
+                std::copy_n(bytes, length, last->glyph.data() + last->length);
+                last->length = static_cast<std::uint8_t>(last->length + length);
+            }
+            continue;
+        }
+        if (col + width > endCol) {
+            break;   // A wide character cut by the edge is left out
+        }
+        Cell& cell = cells[col];
+        cell = Cell{};
+        cell.glyph[0] = '\0';
+        cell.length = static_cast<std::uint8_t>(encode(decoded.codepoint, cell.glyph.data()));
+        cell.width = static_cast<std::uint8_t>(width);
+        cell.style = style;
+        if (width == 2) {
+            Cell& next = cells[col + 1];
+            next = Cell{};
+            next.glyph[0] = '\0';
+            next.length = 0;
+            next.width = 0;
+            next.style = style;
+        }
+        last = &cell;
+        col += width;
+    }
+    return col;
+}
+
+void VtRenderer::setCursor(int rowIndex, int col, bool visible) noexcept {
+    m_wantRow = std::clamp(rowIndex, 0, std::max(m_rows - 1, 0));
+    m_wantCol = std::clamp(col, 0, std::max(m_cols - 1, 0));
+    m_wantVisible = visible;
+}
+
+void VtRenderer::setScrollRegion(int top, int bottom) noexcept {
+    if (top < 0 || bottom >= m_rows || bottom <= top) {
+        m_scrollTop = m_scrollBottom = -1;
+        return;
+    }
+    m_scrollTop = top;
+    m_scrollBottom = bottom;
+}
+
+std::size_t VtRenderer::present() {
+    m_out.clear();
+    if (m_rows == 0 || m_cols == 0) {
+        return 0;
+    }
+
+    if (m_invalid) {
+        m_out += "\x1b[0m\x1b[H\x1b[2J";
+        std::fill(m_front.begin(), m_front.end(), Cell{});
+        m_style = VtStyle{};
+        m_styleKnown = true;
+        m_atRow = 0;
+        m_atCol = 0;
+        m_invalid = false;
+    } else {
+        scrollIfMoved();
+    }
+
+    for (int index = 0; index < m_rows; ++index) {
+        diffRow(index);
+    }
+
+    // The cursor is hidden while drawing so it does not flicker across the screen
+    if (!m_out.empty() && m_cursorVisible) {
+        m_out.insert(0, "\x1b[?25l");
+        m_cursorVisible = false;
+    }
+    moveTo(m_wantRow, m_wantCol);
+    if (m_wantVisible != m_cursorVisible) {
+        m_out += m_wantVisible ? "\x1b[?25h" : "\x1b[?25l";
+        m_cursorVisible = m_wantVisible;
+    }
+    flush();
+    return m_out.size();
+}
+
+// FNV-1a over the cells' contents, for matching rows that moved
+std::uint64_t VtRenderer::rowHash(const std::vector<Cell>& grid, int index) const noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    const auto mix = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= 0x100000001b3ull;
+    };
+    const Cell* cells = grid.data() + std::size_t(index) * m_cols;
+    for (int col = 0; col < m_cols; ++col) {
+        const Cell& cell = cells[col];
+        for (std::uint8_t i = 0; i < cell.length; ++i) {
+            mix(static_cast<unsigned char>(cell.glyph[i]));
+        }
+        mix(std::uint64_t(cell.width) << 8 | cell.style.flags);
+        mix(std::uint64_t(static_cast<std::uint16_t>(cell.style.fg)) << 16 | static_cast<std::uint16_t>(cell.style.bg));
+    }
+    return hash;
+}
+
+// Scroll the region on the terminal when most of its rows are the ones it
+// already shows, moved up (new output) or down (paging back) as a block
+void VtRenderer::scrollIfMoved() {
+    if (m_scrollTop < 0) {
+        return;
+    }
+    const int top = m_scrollTop;
+    const int bottom = m_scrollBottom;
+    for (int index = top; index <= bottom; ++index) {
+        m_frontHashes[index] = rowHash(m_front, index);
+        m_backHashes[index] = rowHash(m_back, index);
+    }
+
+    // Rows that match for a shift: positive when the content moved up
+    const auto matches = [&](int shift) {
+        int count = 0;
+        for (int index = std::max(top, top - shift); index <= std::min(bottom, bottom - shift); ++index) {
+            count += m_backHashes[index] == m_frontHashes[index + shift] ? 1 : 0;
+        }
+        return count;
+    };
+    int best = 0;
+    int bestMatches = matches(0);
+    if (bestMatches == bottom - top + 1) {
+        return;
+    }
+    // The top row after moving up, or the bottom row after moving down, is
+    // one the terminal shows elsewhere in the region
+    for (int index = top + 1; index <= bottom; ++index) {
+        if (m_frontHashes[index] == m_backHashes[top]) {
+            const int count = matches(index - top);
+            if (count > bestMatches) {
+                best = index - top;
+                bestMatches = count;
+            }
+        }
+        const int upper = bottom - (index - top);
+        if (m_frontHashes[upper] == m_backHashes[bottom]) {
+            const int count = matches(upper - bottom);
+            if (count > bestMatches) {
+                best = upper - bottom;
+                bestMatches = count;
+            }
+        }
+    }
+    if (best == 0) {
+        return;
+    }
+
+    // Lines scrolled in take the current background, so reset it first
+    setStyle(VtStyle{});
+    m_out += std::format("\x1b[{};{}r", top + 1, bottom + 1);
+    if (best > 0) {
+        m_out += std::format("\x1b[{};1H", bottom + 1);
+        m_out.append(std::size_t(best), '\n');
+    } else {
+        m_out += std::format("\x1b[{};1H", top + 1);
+        for (int i = 0; i < -best; ++i) {
+            m_out += "\x1bM";
+        }
+    }
+    m_out += "\x1b[r";   // Margins back to the whole screen, which homes the cursor
+    m_atRow = 0;
+    m_atCol = 0;
+
+    // The front grid follows the terminal
+    const auto first = m_front.begin() + std::ptrdiff_t(top) * m_cols;
+    const auto last = m_front.begin() + std::ptrdiff_t(bottom + 1) * m_cols;
+    const std::ptrdiff_t moved = std::ptrdiff_t(std::abs(best)) * m_cols;
+    if (best > 0) {
+        std::move(first + moved, last, first);
+        std::fill(last - moved, last, Cell{});
+    } else {
+        std::move_backward(first, last - moved, last);
+        std::fill(first, first + moved, Cell{});
+    }
+}
+
+void VtRenderer::diffRow(int index) {
+    Cell* back = row(m_back, index);
+    Cell* front = row(m_front, index);
+
+    // Past the last non-blank cell the row can be erased with one EL
+    int backEnd = m_cols;
+    while (backEnd > 0 && back[backEnd - 1] == Cell{}) {
+        --backEnd;
+    }
+
+    int col = 0;
+    while (col < m_cols) {
+        if (back[col] == front[col]) {
+            ++col;
+            continue;
+        }
+        if (back[col].width == 0 && col > 0) {
+            --col;   // Redraw the wide character this column belongs to
+        }
+        if (col >= backEnd) {
+            moveTo(index, col);
+            setStyle(VtStyle{});
+            m_out += "\x1b[K";
+            std::fill(front + col, front + m_cols, Cell{});
+            return;
+        }
+
+        moveTo(index, col);
+        while (col < backEnd) {
+            // A wide character's second column is drawn with its first
+            if (back[col].width != 0) {
+                emit(back[col]);
+            }
+            front[col] = back[col];
+            ++col;
+            // Draw on through short runs of unchanged cells rather than move past them
+            int next = col;
+            while (next < backEnd && next - col < kRewriteGap && back[next] == front[next]) {
+                ++next;
+            }
+            if (next >= backEnd || next - col >= kRewriteGap) {
+                break;
+            }
+        }
+    }
+}
+
+void VtRenderer::moveTo(int rowIndex, int col) {
+    if (m_atRow == rowIndex && m_atCol == col) {
+        return;
+    }
+    if (m_atRow == rowIndex && m_atCol >= 0 && col > m_atCol) {
+        m_out += col - m_atCol == 1 ? std::string("\x1b[C") : std::format("\x1b[{}C", col - m_atCol);
+    } else if (col == 0 && rowIndex == m_atRow + 1 && m_atRow >= 0) {
+        m_out += "\r\n";
+    } else {
+        m_out += std::format("\x1b[{};{}H", rowIndex + 1, col + 1);
+    }
+    m_atRow = rowIndex;
+    m_atCol = col;
+}
+
+void VtRenderer::setStyle(const VtStyle& style) {
+    if (m_styleKnown && m_style == style) {
+        return;
+    }
+    // Reset and set: shorter on average than working out what to turn off
+    m_out += "\x1b[0";
+    if (style.flags & VtStyle::Bold) m_out += ";1";
+    if (style.flags & VtStyle::Underline) m_out += ";4";
+    if (style.flags & VtStyle::Blink) m_out += ";5";
+    if (style.flags & VtStyle::Reverse) m_out += ";7";
+    const auto color = [this](std::int16_t value, int base, int brightBase) {
+        if (value < 0) {
+            return;
+        }
+        if (value < 8) {
+            m_out += std::format(";{}", base + value);
+        } else if (value < 16) {
+            m_out += std::format(";{}", brightBase + value - 8);
+        } else {
+            m_out += std::format(";{};5;{}", base + 8, value);
+        }
+    };
+    color(style.fg, 30, 90);
+    color(style.bg, 40, 100);
+    m_out += 'm';
+    m_style = style;
+    m_styleKnown = true;
+}
+
+void VtRenderer::emit(const Cell& cell) {
+    setStyle(cell.style);
+    m_out.append(cell.glyph.data(), cell.length);
+    m_atCol += cell.width;
+    if (m_atCol >= m_cols) {
+        // The last column leaves the cursor waiting to wrap; where it is
+        // then differs between terminals
+        m_atRow = -1;
+        m_atCol = -1;
+    }
+}
+
+// Write the whole frame, waiting out a full terminal buffer
+void VtRenderer::flush() {
+    std::size_t done = 0;
+    while (done < m_out.size()) {
+#if defined(_WIN32)
+        const int written = _write(m_fd, m_out.data() + done, static_cast<unsigned>(m_out.size() - done));
+#else
+        const ssize_t written = ::write(m_fd, m_out.data() + done, m_out.size() - done);
+#endif
+        if (written > 0) {
+            done += std::size_t(written);
+            continue;
+        }
+#if !defined(_WIN32)
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd pfd{m_fd, POLLOUT, 0};
+            poll(&pfd, 1, -1);
+            continue;
+        }
+#endif
+        break;   // The terminal is gone
+    }
+    m_bytesWritten += done;
+}
@@ -0,0 +1,169 @@
+#include "../include/Watchdog.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <format>
+#if !defined(_WIN32) && __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define ECHOMUD_HAS_BACKTRACE 1
+#endif
+
+namespace {
+
+thread_local Watchdog* t_watchdog = nullptr;
+
+#ifdef ECHOMUD_HAS_BACKTRACE
+// SIGURG is ignored by default and nothing here asks for it, so borrowing it
+// cannot disturb anything
+constexpr int kCaptureSignal = SIGURG;
+
+// Filled by the watched thread in the handler, read by the watchdog once
+// s_captured is set; one capture is in flight at a time
+std::array<void*, Watchdog::kMaxFrames> s_frames{};
+std::atomic<int> s_frameCount{0};
+std::atomic<bool> s_captured{false};
+
+extern "C" void captureStack(int) {
+    const int savedErrno = errno;
+    s_frameCount.store(backtrace(s_frames.data(), Watchdog::kMaxFrames), std::memory_order_relaxed);
+    s_captured.store(true, std::memory_order_release);
+    errno = savedErrno;
+}
+
+bool installCapture() {
+    // backtrace() loads libgcc the first time; done here so the handler never does
+    void* frame = nullptr;
+    backtrace(&frame, 1);
+    struct sigaction action{};
+    action.sa_handler = captureStack;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    return sigaction(kCaptureSignal, &action, nullptr) == 0;
+}
+
+void removeCapture() {
+    struct sigaction action{};
+    action.sa_handler = SIG_DFL;
+    sigemptyset(&action.sa_mask);
+    sigaction(kCaptureSignal, &action, nullptr);
+}
+#endif
+
+} // namespace
+
+Watchdog::Activity::Activity(std::string_view kind, std::string_view name)
+    : m_watchdog(t_watchdog) {
+    if (!m_watchdog) {
+        return;
+    }
+    const std::lock_guard lock(m_watchdog->m_activityMutex);
+    std::string& activity = m_watchdog->m_activity;
+    m_previous = activity.size();
+    if (!activity.empty()) {
+        activity += " > ";
+    }
+    activity.append(kind).append(" ").append(name);
+}
+
+Watchdog::Activity::~Activity() {
+    if (m_watchdog) {
+        const std::lock_guard lock(m_watchdog->m_activityMutex);
+        m_watchdog->m_activity.resize(m_previous);
+    }
+}
+
+Watchdog::Watchdog(Options options)
+    : m_options(std::move(options)) {
+    m_options.threshold = std::max(m_options.threshold, std::chrono::milliseconds(100));
+    m_activity.reserve(256);
+    t_watchdog = this;
+#ifdef ECHOMUD_HAS_BACKTRACE
+    m_watched = pthread_self();
+    if (!installCapture()) {
+        LOG_WARN("Watchdog cannot capture stacks: signal {} refused", kCaptureSignal);
+    }
+#endif
+    m_thread = std::thread([this] { watch(); });
+}
+
+Watchdog::~Watchdog() {
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+#ifdef ECHOMUD_HAS_BACKTRACE
+    removeCapture();
+#endif
+    if (t_watchdog == this) {
+        t_watchdog = nullptr;
+    }
+}
+
+void Watchdog::watch() {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = m_options.threshold / 4;
+    std::uint64_t seen = m_beats.load(std::memory_order_relaxed);
+    auto since = Clock::now();
+    bool reported = false;
+
+    std::unique_lock lock(m_mutex);
+    while (!m_wake.wait_for(lock, interval, [this] { return m_stopping; })) {
+        const std::uint64_t beats = m_beats.load(std::memory_order_relaxed);
+        const auto now = Clock::now();
+        if (beats != seen || m_resting.load(std::memory_order_relaxed)) {
+            seen = beats;
+            since = now;
+            reported = false;
+            continue;
+        }
+        if (reported || now - since < m_options.threshold) {
+            continue;
+        }
+        reported = true;
+        m_stalls.fetch_add(1, std::memory_order_relaxed);
+        lock.unlock();
+        report(now - since);
+        if (m_options.onStall) {
+            m_options.onStall();
+        }
+        lock.lock();
+    }
+}
+
+void Watchdog::report(std::chrono::steady_clock::duration stuck) {
+    std::string activity;
+    {
+        const std::lock_guard lock(m_activityMutex);
+        activity = m_activity.empty() ? std::string("nothing it named") : m_activity;
+    }
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(stuck).count();
+    std::string text = std::format("Loop stalled for {} ms running {}", millis, activity);
+
+#ifdef ECHOMUD_HAS_BACKTRACE
+    s_captured.store(false, std::memory_order_relaxed);
+    if (pthread_kill(m_watched, kCaptureSignal) == 0) {
+        // A thread blocked with the signal masked never answers; give it a moment
+        for (int waited = 0; waited < 100 && !s_captured.load(std::memory_order_acquire); ++waited) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    if (s_captured.load(std::memory_order_acquire)) {
+        const int count = s_frameCount.load(std::memory_order_relaxed);
+        // Symbolised here, off the watched thread, where allocating is safe
+        char** symbols = backtrace_symbols(s_frames.data(), count);
+        // The first frames are the handler and the signal trampoline
+        for (int i = 0; i < count; ++i) {
+            text += std::format("\n  #{} {}", i, symbols ? symbols[i] : std::format("{}", s_frames[i]));
+        }
+        std::free(symbols);
+    } else {
+        text += "\n  (no stack: the thread did not answer)";
+    }
+#endif
+    LOG_ERROR("{}", text);
+}
@@ -0,0 +1,483 @@
+#include "../include/WebSocket.h"
+#include "../include/Utf8.h"
+#include <algorithm>
+#include <format>
+#include <utility>
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+#include "../include/WebSocketDeflate.h"
+#endif
+
+namespace {
+
+// Appended to the client's key before hashing (RFC 6455 section 1.3)
+constexpr std::string_view kAcceptGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+// The client window asked for when the client leaves it to the server
+constexpr int kClientWindowBits = 10;
+
+// SHA-1 (FIPS 180-4), needed only for Sec-WebSocket-Accept
+std::array<unsigned char, 20> sha1(std::string_view text) {
+    std::uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    const auto rotate = [](std::uint32_t value, int bits) { return (value << bits) | (value >> (32 - bits)); };
+
+    std::string padded(text);
+    padded.push_back(static_cast<char>(0x80));
+    while (padded.size() % 64 != 56) {
+        padded.push_back('\0');
+    }
+    const std::uint64_t bits = static_cast<std::uint64_t>(text.size()) * 8;
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        padded.push_back(static_cast<char>(bits >> shift));
+    }
+
+    for (std::size_t block = 0; block < padded.size(); block += 64) {
+        std::uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* p = reinterpret_cast<const unsigned char*>(padded.data() + block + i * 4);
+            w[i] = (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            std::uint32_t f;
+            std::uint32_t k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const std::uint32_t next = rotate(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotate(b, 30);
+            b = a;
+            a = next;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    std::array<unsigned char, 20> digest;
+    for (int i = 0; i < 20; ++i) {
+        digest[i] = static_cast<unsigned char>(h[i / 4] >> (24 - (i % 4) * 8));
+    }
+    return digest;
+}
+
+std::string base64(const unsigned char* data, std::size_t size) {
+    constexpr std::string_view kAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (std::size_t i = 0; i < size; i += 3) {
+        const std::uint32_t group = (std::uint32_t{data[i]} << 16) | (i + 1 < size ? std::uint32_t{data[i + 1]} << 8 : 0) |
+                                    (i + 2 < size ? std::uint32_t{data[i + 2]} : 0);
+        out.push_back(kAlphabet[(group >> 18) & 0x3F]);
+        out.push_back(kAlphabet[(group >> 12) & 0x3F]);
+        out.push_back(i + 1 < size ? kAlphabet[(group >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < size ? kAlphabet[group & 0x3F] : '=');
+    }
+    return out;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return (x | 0x20) == (y | 0x20); });
+}
+
+// Whether a comma-separated header value lists token
+bool listsToken(std::string_view value, std::string_view token) {
+    while (!value.empty()) {
+        const std::size_t comma = value.find(',');
+        if (equalsIgnoreCase(trim(value.substr(0, comma)), token)) {
+            return true;
+        }
+        value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+    }
+    return false;
+}
+
+// A refusal; the connection closes once it is sent
+std::string refusal(std::string_view status, std::string_view extraHeaders = {}) {
+    return std::format("HTTP/1.1 {}\r\n{}Connection: close\r\nContent-Length: 0\r\n\r\n", status, extraHeaders);
+}
+
+bool validUtf8(std::string_view text) {
+    if (Utf8::isAscii(text)) {
+        return true;
+    }
+    for (std::size_t pos = 0; pos < text.size();) {
+        const Utf8::Decoded decoded = Utf8::decode(text, pos);
+        if (decoded.codepoint == Utf8::kReplacement && decoded.length == 1) {
+            return false;
+        }
+        pos += decoded.length;
+    }
+    return true;
+}
+
+} // namespace
+
+WebSocket::WebSocket(bool allowDeflate)
+    : m_allowDeflate(allowDeflate) {
+#if !defined(ENABLE_WEBSOCKET_DEFLATE)
+    m_allowDeflate = false;
+#endif
+}
+
+WebSocket::~WebSocket() = default;
+
+void WebSocket::recycle(bool allowDeflate) {
+    m_buffer.clear();
+    m_message.clear();
+    m_messageOpcode = Opcode::Continuation;
+    m_messageCompressed = false;
+    m_allowDeflate = allowDeflate;
+#if !defined(ENABLE_WEBSOCKET_DEFLATE)
+    m_allowDeflate = false;
+#else
+    // Made for the window the last client asked for
+    m_inflater.reset();
+#endif
+    m_deflate = false;
+    m_upgraded = false;
+    m_closed = false;
+    m_clientWindowBits = 15;
+}
+
+bool WebSocket::feed(std::string_view bytes, Events& events) {
+    if (m_closed) {
+        return false;
+    }
+    m_buffer.append(bytes);
+    if (!m_upgraded) {
+        // Anything the client sent after its request is already frames
+        if (!handshake(events)) {
+            return false;
+        }
+        if (!m_upgraded) {
+            return true;
+        }
+    }
+    return parseFrames(events);
+}
+
+// Answer the upgrade request once all of it has arrived
+bool WebSocket::handshake(Events& events) {
+    const std::size_t end = m_buffer.find("\r\n\r\n");
+    if (end == std::string::npos) {
+        if (m_buffer.size() <= kMaxRequest) {
+            return true;
+        }
+        m_closed = true;
+        events.handshake(refusal("431 Request Header Fields Too Large"), false);
+        return false;
+    }
+
+    std::string_view request = std::string_view(m_buffer).substr(0, end + 2);
+    const std::size_t lineEnd = request.find("\r\n");
+    const std::string_view requestLine = request.substr(0, lineEnd);
+    request.remove_prefix(lineEnd + 2);
+
+    std::string_view upgrade, connection, key, version;
+    std::string offers;
+    while (!request.empty()) {
+        const std::size_t next = request.find("\r\n");
+        const std::string_view header = request.substr(0, next);
+        request.remove_prefix(next + 2);
+        const std::size_t colon = header.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        const std::string_view name = trim(header.substr(0, colon));
+        const std::string_view value = trim(header.substr(colon + 1));
+        if (equalsIgnoreCase(name, "Upgrade")) {
+            upgrade = value;
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            connection = value;
+        } else if (equalsIgnoreCase(name, "Sec-WebSocket-Key")) {
+            key = value;
+        } else if (equalsIgnoreCase(name, "Sec-WebSocket-Version")) {
+            version = value;
+        } else if (equalsIgnoreCase(name, "Sec-WebSocket-Extensions")) {
+            // The header may be repeated; together they are one list
+            if (!offers.empty()) {
+                offers.push_back(',');
+            }
+            offers.append(value);
+        }
+    }
+
+    const bool isGet = requestLine.starts_with("GET ") && requestLine.ends_with(" HTTP/1.1");
+    if (!isGet || !listsToken(upgrade, "websocket") || !listsToken(connection, "upgrade") || key.size() != 24) {
+        m_closed = true;
+        events.handshake(refusal("400 Bad Request"), false);
+        return false;
+    }
+    if (version != "13") {
+        m_closed = true;
+        events.handshake(refusal("426 Upgrade Required", "Sec-WebSocket-Version: 13\r\n"), false);
+        return false;
+    }
+
+    const auto digest = sha1(std::string(key) + std::string(kAcceptGuid));
+    std::string response = std::format("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                                       "Connection: Upgrade\r\nSec-WebSocket-Accept: {}\r\n",
+                                       base64(digest.data(), digest.size()));
+    m_deflate = m_allowDeflate && acceptExtensions(offers, response);
+    response.append("\r\n");
+
+    m_buffer = m_buffer.substr(end + 4);
+    m_upgraded = true;
+    return events.handshake(response, true);
+}
+
+// Take the first permessage-deflate offer this side can honour, adding the
+// agreement to response (RFC 7692 section 7.1)
+bool WebSocket::acceptExtensions(std::string_view offers, std::string& response) {
+    while (!offers.empty()) {
+        const std::size_t comma = offers.find(',');
+        std::string_view offer = offers.substr(0, comma);
+        offers = comma == std::string_view::npos ? std::string_view() : offers.substr(comma + 1);
+
+        const std::size_t semicolon = offer.find(';');
+        if (!equalsIgnoreCase(trim(offer.substr(0, semicolon)), "permessage-deflate")) {
+            continue;
+        }
+        offer = semicolon == std::string_view::npos ? std::string_view() : offer.substr(semicolon + 1);
+
+        bool acceptable = true;
+        int clientWindowBits = 15;
+        bool clientWindowNamed = false;
+        while (!offer.empty() && acceptable) {
+            const std::size_t next = offer.find(';');
+            const std::string_view parameter = trim(offer.substr(0, next));
+            offer = next == std::string_view::npos ? std::string_view() : offer.substr(next + 1);
+            const std::size_t equals = parameter.find('=');
+            const std::string_view name = trim(parameter.substr(0, equals));
+            std::string_view value = equals == std::string_view::npos ? std::string_view() : trim(parameter.substr(equals + 1));
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                value = value.substr(1, value.size() - 2);
+            }
+            if (equalsIgnoreCase(name, "server_no_context_takeover") ||
+                equalsIgnoreCase(name, "client_no_context_takeover")) {
+                continue;
+            }
+            if (equalsIgnoreCase(name, "client_max_window_bits")) {
+                // The client lets the server pick, up to the value if it gave one
+                clientWindowBits = kClientWindowBits;
+                if (!value.empty()) {
+                    const int offered = value.size() == 2 ? (value[0] - '0') * 10 + (value[1] - '0') : value[0] - '0';
+                    acceptable = value.size() <= 2 && offered >= 8 && offered <= 15;
+                    clientWindowBits = std::min(clientWindowBits, offered);
+                }
+                clientWindowNamed = true;
+                continue;
+            }
+            // A smaller server window would need a deflater of its own
+            if (equalsIgnoreCase(name, "server_max_window_bits") && value == "15") {
+                continue;
+            }
+            acceptable = false;
+        }
+        if (!acceptable) {
+            continue;
+        }
+
+        response.append("Sec-WebSocket-Extensions: permessage-deflate; server_no_context_takeover");
+        if (clientWindowNamed) {
+            response.append(std::format("; client_max_window_bits={}", clientWindowBits));
+        }
+        response.append("\r\n");
+        // zlib cannot inflate with a window of 8; a larger one still reads the stream
+        m_clientWindowBits = std::max(clientWindowBits, 9);
+        return true;
+    }
+    return false;
+}
+
+// Handle every complete frame in the buffer, keeping a partial one for later
+bool WebSocket::parseFrames(Events& events) {
+    std::size_t pos = 0;
+    bool more = true;
+    while (more && m_buffer.size() - pos >= 2) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(m_buffer.data() + pos);
+        const std::size_t available = m_buffer.size() - pos;
+        const bool fin = (bytes[0] & 0x80) != 0;
+        const bool compressed = (bytes[0] & 0x40) != 0;
+        const auto opcode = static_cast<Opcode>(bytes[0] & 0x0F);
+        const bool masked = (bytes[1] & 0x80) != 0;
+        std::uint64_t length = bytes[1] & 0x7F;
+        std::size_t header = 2;
+        if (length == 126) {
+            header = 4;
+            if (available < header) {
+                break;
+            }
+            length = (std::uint64_t{bytes[2]} << 8) | bytes[3];
+        } else if (length == 127) {
+            header = 10;
+            if (available < header) {
+                break;
+            }
+            length = 0;
+            for (int i = 2; i < 10; ++i) {
+                length = (length << 8) | bytes[i];
+            }
+            // The top bit must be clear, and no message of ours is near that big
+            if ((length >> 63) != 0) {
+                m_closed = true;
+                events.close(kMessageTooBig);
+                return false;
+            }
+        }
+
+        const bool control = (bytes[0] & 0x08) != 0;
+        const bool known = opcode == Opcode::Continuation || opcode == Opcode::Text || opcode == Opcode::Binary ||
+                           opcode == Opcode::Close || opcode == Opcode::Ping || opcode == Opcode::Pong;
+        // Only the first frame of a data message may be marked compressed
+        const bool compressedOk = !compressed || (m_deflate && !control && opcode != Opcode::Continuation);
+        if ((bytes[0] & 0x30) != 0 || !known || !masked || !compressedOk || (control && (!fin || length > 125)) ||
+            (opcode == Opcode::Continuation) != (m_messageOpcode != Opcode::Continuation && !control)) {
+            m_closed = true;
+            events.close(kProtocolError);
+            return false;
+        }
+        // Compared by subtraction, so a length the client made huge cannot wrap
+        if (!control && length > kMaxMessage - m_message.size()) {
+            m_closed = true;
+            events.close(kMessageTooBig);
+            return false;
+        }
+
+        header += 4;
+        if (available < header || available - header < length) {
+            break;
+        }
+        const unsigned char* mask = bytes + header - 4;
+        char* payload = m_buffer.data() + pos + header;
+        for (std::size_t i = 0; i < length; ++i) {
+            payload[i] = static_cast<char>(static_cast<unsigned char>(payload[i]) ^ mask[i % 4]);
+        }
+        const std::string_view data(payload, static_cast<std::size_t>(length));
+        pos += header + static_cast<std::size_t>(length);
+
+        switch (opcode) {
+            case Opcode::Text:
+            case Opcode::Binary:
+                m_messageOpcode = opcode;
+                m_messageCompressed = compressed;
+                [[fallthrough]];
+            case Opcode::Continuation:
+                m_message.append(data);
+                if (fin) {
+                    more = endMessage(events);
+                }
+                break;
+            case Opcode::Ping:
+                more = events.ping(data);
+                break;
+            case Opcode::Pong:
+                break;
+            case Opcode::Close: {
+                // Echo the client's code back; a bare close gets a normal one
+                std::uint16_t code = kNormalClosure;
+                if (data.size() >= 2) {
+                    code = static_cast<std::uint16_t>((static_cast<unsigned char>(data[0]) << 8) |
+                                                      static_cast<unsigned char>(data[1]));
+                }
+                m_closed = true;
+                events.close(data.size() == 1 ? kProtocolError : code);
+                return false;
+            }
+        }
+    }
+    // An idle session keeps no buffer
+    m_buffer = pos == m_buffer.size() ? std::string() : m_buffer.substr(pos);
+    return more && !m_closed;
+}
+
+// Hand over a reassembled message, inflated if it was sent compressed
+bool WebSocket::endMessage(Events& events) {
+    const Opcode opcode = std::exchange(m_messageOpcode, Opcode::Continuation);
+    std::string message = std::move(m_message);
+    m_message = std::string();
+#if defined(ENABLE_WEBSOCKET_DEFLATE)
+    if (m_messageCompressed) {
+        if (!m_inflater) {
+            m_inflater = WebSocketInflater::create(m_clientWindowBits);
+        }
+        std::string inflated;
+        const WebSocketInflater::Result result =
+            m_inflater ? m_inflater->inflate(message, inflated, kMaxMessage) : WebSocketInflater::Result::Invalid;
+        if (result != WebSocketInflater::Result::Ok) {
+            m_closed = true;
+            events.close(result == WebSocketInflater::Result::TooBig ? kMessageTooBig : kInvalidData);
+            return false;
+        }
+        message = std::move(inflated);
+    }
+#endif
+    if (opcode == Opcode::Text && !validUtf8(message)) {
+        m_closed = true;
+        events.close(kInvalidData);
+        return false;
+    }
+    return events.message(message);
+}
+
+std::size_t WebSocket::frameHeader(Opcode opcode, bool compressed, std::size_t length, FrameHeader& out) noexcept {
+    out[0] = static_cast<char>(0x80 | (compressed ? 0x40 : 0) | static_cast<unsigned char>(opcode));
+    if (length < 126) {
+        out[1] = static_cast<char>(length);
+        return 2;
+    }
+    if (length <= 0xFFFF) {
+        out[1] = 126;
+        out[2] = static_cast<char>(length >> 8);
+        out[3] = static_cast<char>(length);
+        return 4;
+    }
+    out[1] = 127;
+    for (int i = 0; i < 8; ++i) {
+        out[2 + i] = static_cast<char>(static_cast<std::uint64_t>(length) >> (56 - i * 8));
+    }
+    return 10;
+}
+
+void WebSocket::appendUtf8(std::string_view text, std::string& out) {
+    if (Utf8::isAscii(text)) {
+        out.append(text);
+        return;
+    }
+    for (std::size_t pos = 0; pos < text.size();) {
+        const Utf8::Decoded decoded = Utf8::decode(text, pos);
+        if (decoded.codepoint == Utf8::kReplacement && decoded.length == 1) {
+            out.append("\xEF\xBF\xBD");
+        } else {
+            out.append(text.substr(pos, decoded.length));
+        }
+        pos += decoded.length;
+    }
+}
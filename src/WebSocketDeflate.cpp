@@ -0,0 +1,113 @@
+#include "../include/WebSocketDeflate.h"
+#include <algorithm>
+#include <zlib.h>
+
+namespace {
+
+// Raw deflate, as the extension carries it; negative bits drop the zlib header
+constexpr int kServerWindowBits = 15;
+constexpr int kMemoryLevel = 5;
+constexpr std::size_t kChunk = 4096;
+
+// Ends every message after a sync flush; the sender strips it, the receiver restores it
+constexpr char kTail[] = {0x00, 0x00, static_cast<char>(0xFF), static_cast<char>(0xFF)};
+
+} // namespace
+
+WebSocketDeflater::WebSocketDeflater()
+    : m_stream(std::make_unique<z_stream>()) {
+}
+
+WebSocketDeflater::~WebSocketDeflater() {
+    deflateEnd(m_stream.get());
+}
+
+std::unique_ptr<WebSocketDeflater> WebSocketDeflater::create() {
+    std::unique_ptr<WebSocketDeflater> deflater(new WebSocketDeflater());
+    if (deflateInit2(deflater->m_stream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED, -kServerWindowBits, kMemoryLevel,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return nullptr;
+    }
+    return deflater;
+}
+
+bool WebSocketDeflater::compress(std::string_view message, std::string& out) {
+    // Starting afresh is what lets every session share the result
+    if (deflateReset(m_stream.get()) != Z_OK) {
+        return false;
+    }
+    out.clear();
+    m_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(message.data()));
+    m_stream->avail_in = static_cast<uInt>(message.size());
+    for (;;) {
+        const std::size_t used = out.size();
+        out.resize(used + kChunk);
+        m_stream->next_out = reinterpret_cast<Bytef*>(out.data() + used);
+        m_stream->avail_out = static_cast<uInt>(kChunk);
+        const int status = deflate(m_stream.get(), Z_SYNC_FLUSH);
+        out.resize(used + kChunk - m_stream->avail_out);
+        if (status == Z_STREAM_ERROR) {
+            return false;
+        }
+        if (m_stream->avail_out != 0 || status == Z_BUF_ERROR) {
+            break;
+        }
+    }
+    if (out.size() < sizeof(kTail) || std::string_view(out).substr(out.size() - sizeof(kTail)) !=
+                                          std::string_view(kTail, sizeof(kTail))) {
+        return false;
+    }
+    out.resize(out.size() - sizeof(kTail));
+    return true;
+}
+
+WebSocketInflater::WebSocketInflater()
+    : m_stream(std::make_unique<z_stream>()) {
+}
+
+WebSocketInflater::~WebSocketInflater() {
+    inflateEnd(m_stream.get());
+}
+
+std::unique_ptr<WebSocketInflater> WebSocketInflater::create(int windowBits) {
+    std::unique_ptr<WebSocketInflater> inflater(new WebSocketInflater());
+    if (inflateInit2(inflater->m_stream.get(), -windowBits) != Z_OK) {
+        return nullptr;
+    }
+    return inflater;
+}
+
+WebSocketInflater::Result WebSocketInflater::inflate(std::string_view message, std::string& out, std::size_t limit) {
+    out.clear();
+    const Result result = inflateInto(message, out, limit);
+    return result == Result::Ok ? inflateInto(std::string_view(kTail, sizeof(kTail)), out, limit) : result;
+}
+
+WebSocketInflater::Result WebSocketInflater::inflateInto(std::string_view bytes, std::string& out, std::size_t limit) {
+    m_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(bytes.data()));
+    m_stream->avail_in = static_cast<uInt>(bytes.size());
+    for (;;) {
+        const std::size_t used = out.size();
+        if (used >= limit) {
+            return Result::TooBig;
+        }
+        const std::size_t room = std::min(kChunk, limit - used);
+        out.resize(used + room);
+        m_stream->next_out = reinterpret_cast<Bytef*>(out.data() + used);
+        m_stream->avail_out = static_cast<uInt>(room);
+        const int status = ::inflate(m_stream.get(), Z_SYNC_FLUSH);
+        out.resize(used + room - m_stream->avail_out);
+        if (status == Z_STREAM_END) {
+            // A final block ends the client's context; what follows starts a new one
+            if (inflateReset(m_stream.get()) != Z_OK) {
+                return Result::Invalid;
+            }
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            return Result::Invalid;
+        }
+        // zlib stops short of filling the buffer only once the input is spent
+        if (m_stream->avail_out != 0 && (m_stream->avail_in == 0 || status == Z_BUF_ERROR)) {
+            return Result::Ok;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include "../include/WorldSnapshot.h"
+#include "../include/MappedRecords.h"
+#include <format>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+std::string_view roomName(const RoomGraph& rooms, RoomId room) {
+    return rooms.contains(room) ? rooms.name(room) : std::string_view("?");
+}
+
+} // namespace
+
+bool WorldSnapshot::write(const std::filesystem::path& path) const {
+    // Where everything is, by entity index; built here rather than on the
+    // game thread, which only shared its pages
+    std::unordered_map<std::uint32_t, RoomId> placed;
+    entities.each<InRoom>([&placed](Entity entity, const InRoom& where) { placed.emplace(entity.index, where.room); });
+    std::unordered_map<std::uint32_t, Entity> carried;
+    entities.each<CarriedBy>([&carried](Entity entity, const CarriedBy& by) { carried.emplace(entity.index, by.holder); });
+    std::unordered_map<std::uint32_t, std::string_view> names;
+    entities.each<Named>([&names](Entity entity, const Named& named) {
+        names.emplace(entity.index, StringInterner::global().view(named.name));
+    });
+    for (const PlayerImage& player : players) {
+        names.emplace(player.body.index, player.name);
+    }
+    std::unordered_map<std::uint32_t, Health> health;
+    entities.each<Health>([&health](Entity entity, const Health& value) { health.emplace(entity.index, value); });
+    std::unordered_map<std::uint32_t, std::uint32_t> decay;
+    entities.each<Decay>([&decay](Entity entity, const Decay& value) { decay.emplace(entity.index, value.ticksLeft); });
+
+    const auto healthOf = [&health](Entity entity) {
+        const auto found = health.find(entity.index);
+        return found != health.end() ? std::format("\t{}/{}", found->second.current, found->second.max) : std::string();
+    };
+
+    std::string out = std::format("# EchoMUD checkpoint at tick {}: {} rooms, {} players, {} entities\n", tick,
+                                  rooms ? rooms->size() : 0, players.size(), entities.size());
+    for (const PlayerImage& player : players) {
+        out += std::format("player\t{}\t{}{}\n", player.name, rooms ? roomName(*rooms, player.room) : "?",
+                           healthOf(player.body));
+    }
+    entities.each<Npc>([&](Entity entity, const Npc&) {
+        const auto where = placed.find(entity.index);
+        out += std::format("npc\t{}\t{}{}\n", names[entity.index],
+                           rooms && where != placed.end() ? roomName(*rooms, where->second) : "?", healthOf(entity));
+    });
+    entities.each<Item>([&](Entity entity, const Item& item) {
+        out += std::format("item\t{}", item.prototype ? std::string_view(item.prototype->name) : "?");
+        if (const auto where = placed.find(entity.index); where != placed.end()) {
+            out += std::format("\troom\t{}", rooms ? roomName(*rooms, where->second) : "?");
+        } else if (const auto by = carried.find(entity.index); by != carried.end()) {
+            out += std::format("\tcarried\t{}", names[by->second.index]);
+        }
+        if (const auto left = decay.find(entity.index); left != decay.end()) {
+            out += std::format("\tdecay\t{}", left->second);
+        }
+        out += '\n';
+    });
+
+    return mapped::replaceFile(path, out);
+}
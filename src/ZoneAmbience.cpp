@@ -0,0 +1,96 @@
+#include "../include/ZoneAmbience.h"
+#include <format>
+
+namespace {
+
+constexpr std::array<std::string_view, 4> kPhaseNames = {"night", "dawn", "day", "dusk"};
+constexpr std::array<std::string_view, 4> kSkies = {"the sky is clear", "clouds hang overhead", "it is raining",
+                                                    "a storm is raging"};
+
+} // namespace
+
+ZoneAmbience::ZoneAmbience() {
+    m_phaseMessages = {
+        makeSharedMessage(std::string("The sun sets and night falls.")),
+        makeSharedMessage(std::string("The sky lightens in the east as dawn breaks.")),
+        makeSharedMessage(std::string("The sun rises fully into the sky.")),
+        makeSharedMessage(std::string("The sun sinks toward the horizon.")),
+    };
+    m_worsens = {
+        SharedMessage{},
+        makeSharedMessage(std::string("Clouds gather overhead.")),
+        makeSharedMessage(std::string("It starts to rain.")),
+        makeSharedMessage(std::string("Thunder rolls as the rain turns to a storm.")),
+    };
+    m_clears = {
+        makeSharedMessage(std::string("The clouds break up and the sky clears.")),
+        makeSharedMessage(std::string("The rain stops.")),
+        makeSharedMessage(std::string("The storm passes, leaving a steady rain.")),
+        SharedMessage{},
+    };
+}
+
+void ZoneAmbience::addLine(ZoneId zone, std::string_view text) {
+    if (zone >= m_lines.size()) {
+        m_lines.resize(static_cast<std::size_t>(zone) + 1);
+    }
+    m_lines[zone].push_back(makeSharedMessage(std::string(text)));
+}
+
+DayPhase ZoneAmbience::phaseAt(std::uint64_t tick) noexcept {
+    const unsigned hour = hourAt(tick);
+    if (hour >= 5 && hour < 7) {
+        return DayPhase::Dawn;
+    }
+    if (hour >= 7 && hour < 19) {
+        return DayPhase::Day;
+    }
+    if (hour >= 19 && hour < 21) {
+        return DayPhase::Dusk;
+    }
+    return DayPhase::Night;
+}
+
+void ZoneAmbience::advance(std::uint64_t tick, std::span<const ZoneId> occupied, Random& random,
+                           std::vector<AmbientBroadcast>& out) {
+    ++m_stats.passes;
+    const std::size_t first = out.size();
+
+    // The day is the world's; the first pass only learns where it is
+    const DayPhase phase = phaseAt(tick);
+    const bool dayTurned = m_phase != DayPhase::Count && phase != m_phase;
+    m_phase = phase;
+
+    for (const ZoneId zone : occupied) {
+        ++m_stats.zoneUpdates;
+        if (dayTurned) {
+            out.push_back({zone, m_phaseMessages[static_cast<std::size_t>(phase)]});
+        }
+        if (zone >= m_weather.size()) {
+            m_weather.resize(static_cast<std::size_t>(zone) + 1, Weather::Clear);
+            m_seen.resize(m_weather.size(), 0);
+        }
+        // A zone's first pass starts it on any weather, unannounced
+        Weather& weather = m_weather[zone];
+        if (!m_seen[zone]) {
+            m_seen[zone] = 1;
+            weather = static_cast<Weather>(random.below(kWeathers));
+        } else if (random.below(kWeatherOdds) == 0) {
+            const auto now = static_cast<std::size_t>(weather);
+            const bool worse = now == 0 || (now + 1 < kWeathers && random.below(2) == 0);
+            const std::size_t next = worse ? now + 1 : now - 1;
+            weather = static_cast<Weather>(next);
+            out.push_back({zone, worse ? m_worsens[next] : m_clears[next]});
+        }
+        if (zone < m_lines.size() && !m_lines[zone].empty() && random.below(kLineOdds) == 0) {
+            const std::vector<SharedMessage>& lines = m_lines[zone];
+            out.push_back({zone, lines[random.below(lines.size())]});
+        }
+    }
+    m_stats.broadcasts += out.size() - first;
+}
+
+std::string ZoneAmbience::describe(std::uint64_t tick, ZoneId zone) const {
+    return std::format("It is {} ({:02}:00), and {}.", kPhaseNames[static_cast<std::size_t>(phaseAt(tick))],
+                       hourAt(tick), kSkies[static_cast<std::size_t>(weather(zone))]);
+}
@@ -0,0 +1,82 @@
+#include "../include/ZonePrefetcher.h"
+#include <utility>
+
+ZonePrefetcher::ZonePrefetcher(const AreaFile& area, DescriptionStore* descriptions)
+    : m_area(area)
+    , m_descriptions(descriptions)
+    , m_thread([this] { work(); }) {}
+
+ZonePrefetcher::~ZonePrefetcher() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+bool ZonePrefetcher::submit(ZoneId zone, std::span<const RoomId> rooms) {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.submitted;
+        if (m_queue.size() >= kQueueLimit) {
+            ++m_stats.dropped;
+            return false;
+        }
+        m_queue.push_back({zone, std::vector<RoomId>(rooms.begin(), rooms.end())});
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+std::optional<AreaFile::Zone> ZonePrefetcher::take(ZoneId zone) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_ready.find(zone);
+    if (found == m_ready.end()) {
+        return std::nullopt;
+    }
+    const std::optional<AreaFile::Zone> records = found->second;
+    m_ready.erase(found);
+    m_stats.taken += records ? 1 : 0;
+    return records;
+}
+
+PrefetchStats ZonePrefetcher::stats() const {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void ZonePrefetcher::work() {
+    std::string scratch;
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        ready(job, scratch);
+    }
+}
+
+void ZonePrefetcher::ready(const Job& job, std::string& scratch) {
+    // Ask for every page first, so the reads overlap, then wait on them
+    m_area.willNeed(job.zone);
+    for (const RoomId room : job.rooms) {
+        m_area.willNeedRoom(room);
+    }
+    std::optional<AreaFile::Zone> records = m_area.zone(job.zone);
+    if (m_descriptions) {
+        for (const RoomId room : job.rooms) {
+            scratch.clear();
+            m_descriptions->append(room, scratch);
+        }
+    }
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.readied;
+    m_ready.insert_or_assign(job.zone, std::move(records));
+}
@@ -0,0 +1,123 @@
+#include "../include/Gateway.h"
+#include "../include/SignalHandler.h"
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// HOST:PORT, the host an IPv4 address
+bool parseShard(std::string_view text, std::pair<std::string, std::uint16_t>& shard) {
+    const std::size_t colon = text.rfind(':');
+    if (colon == std::string_view::npos || colon == 0) {
+        return false;
+    }
+    const std::string_view port = text.substr(colon + 1);
+    shard.first.assign(text.substr(0, colon));
+    return std::from_chars(port.data(), port.data() + port.size(), shard.second).ec == std::errc() &&
+           shard.second != 0;
+}
+
+} // namespace
+
+// Usage: mud_gateway [--epoll] [--reactors N] [--no-compress] [--websocket PORT] [--port PORT] [--address ADDRESS]
+//                    [--tls PORT --tls-cert FILE --tls-key FILE] [--tls-workers N] [--idle-compact SECONDS] SHARD...
+// where each SHARD is HOST:PORT, a net_server's --shard-port, listed in shard order
+int main(int argc, char** argv) {
+    Gateway::Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--epoll") {
+            options.useIoUring = false;
+        } else if (arg == "--no-compress") {
+            options.compression = false;
+        } else if (arg == "--reactors" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.reactors).ec != std::errc() ||
+                options.reactors == 0) {
+                std::fprintf(stderr, "Invalid reactor count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--websocket" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.webSocketPort).ec != std::errc() ||
+                options.webSocketPort == 0) {
+                std::fprintf(stderr, "Invalid WebSocket port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--tls" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.tlsPort).ec != std::errc() ||
+                options.tlsPort == 0) {
+                std::fprintf(stderr, "Invalid TLS port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--tls-cert" && i + 1 < argc) {
+            options.tlsCertificate = argv[++i];
+        } else if (arg == "--tls-key" && i + 1 < argc) {
+            options.tlsKey = argv[++i];
+        } else if (arg == "--tls-workers" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.tlsWorkers).ec != std::errc() ||
+                options.tlsWorkers == 0) {
+                std::fprintf(stderr, "Invalid TLS worker count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--idle-compact" && i + 1 < argc) {
+            const std::string_view idle = argv[++i];
+            unsigned seconds = 0;
+            if (std::from_chars(idle.data(), idle.data() + idle.size(), seconds).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid idle compaction time: %s\n", argv[i]);
+                return 1;
+            }
+            options.idleCompaction = std::chrono::seconds(seconds);
+        } else if (arg == "--port" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.port).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--address" && i + 1 < argc) {
+            options.address = argv[++i];
+        } else if (std::pair<std::string, std::uint16_t> shard; parseShard(arg, shard)) {
+            options.shards.push_back(std::move(shard));
+        } else {
+            std::fprintf(stderr, "Invalid shard: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (options.shards.empty()) {
+        std::fprintf(stderr, "Give every shard, in order, as HOST:PORT\n");
+        return 1;
+    }
+    if (options.tlsPort != 0 && (options.tlsCertificate.empty() || options.tlsKey.empty())) {
+        std::fprintf(stderr, "A TLS port needs --tls-cert FILE and --tls-key FILE\n");
+        return 1;
+    }
+
+    auto gateway = Gateway::create(options);
+    if (!gateway) {
+        std::fprintf(stderr, "Failed to start the gateway (a shard did not answer, a port is in use, or TLS could not be set up)\n");
+        return 1;
+    }
+
+    Gateway* const running = gateway->get();
+    std::signal(SIGPIPE, SIG_IGN);
+    for (const int signal : {SIGINT, SIGTERM}) {
+        if (!SignalHandler::registerHandler(signal, [running] { running->requestStop(); })) {
+            std::fprintf(stderr, "Failed to handle signal %d\n", signal);
+            return 1;
+        }
+    }
+
+    std::fprintf(stderr, "EchoMUD gateway listening on %s:%u in front of %zu shards\n", options.address.c_str(),
+                 static_cast<unsigned>(options.port), (*gateway)->shardCount());
+    (*gateway)->run();
+    for (const int signal : {SIGINT, SIGTERM}) {
+        SignalHandler::unregisterHandler(signal);
+    }
+    return 0;
+}
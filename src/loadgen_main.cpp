@@ -0,0 +1,608 @@
+#include "../include/GameEngine.h"
+#include "../include/LatencyHistogram.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// What a simulated player does; the mix weighs them
+enum class Action : std::uint8_t { Move, Look, Say, Item, Script };
+constexpr std::size_t kActionCount = 5;
+constexpr std::array<std::string_view, kActionCount> kActionNames = {"move", "look", "say", "item", "script"};
+
+// A client waits this long for a reply before it counts as lost
+constexpr auto kReplyTimeout = std::chrono::seconds(10);
+
+struct Options {
+    bool inProcess = false;
+    std::string host = "127.0.0.1";
+    std::string port = "4000";
+    std::size_t clients = 100;
+    double rate = 0.5;   // Commands per second per client, on average
+    std::chrono::seconds duration{30};
+    std::chrono::seconds ramp{5};   // Clients join evenly over this long
+    std::array<unsigned, kActionCount> mix = {40, 30, 15, 10, 5};
+    std::uint64_t seed = 1;
+    std::string password;   // Answered at a password prompt, for servers with --accounts
+    std::string metricsPort;   // The server's --metrics port, read before and after
+    const char* world = nullptr;
+    bool zoneActors = false;
+};
+
+// Each client draws from its own generator, seeded from the run's seed and
+// its index, so what it sends and when does not depend on the others
+std::mt19937_64 clientRandom(std::uint64_t seed, std::size_t index) {
+    std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                           static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32)};
+    return std::mt19937_64(sequence);
+}
+
+Action pickAction(const Options& options, std::mt19937_64& random) {
+    std::discrete_distribution<std::size_t> pick(options.mix.begin(), options.mix.end());
+    return static_cast<Action>(pick(random));
+}
+
+std::string makeCommand(Action action, std::mt19937_64& random) {
+    static constexpr std::string_view kDirections[] = {"north", "south", "east", "west", "n", "s"};
+    static constexpr std::string_view kWords[] = {"anyone", "seen", "the", "rat", "lantern", "north", "hello",
+                                                  "gold", "quest", "tonight"};
+    switch (action) {
+        case Action::Move:
+            return std::string(kDirections[random() % std::size(kDirections)]);
+        case Action::Look:
+            return random() % 4 == 0 ? "inventory" : "look";
+        case Action::Say: {
+            std::string line = "say";
+            for (std::uint64_t words = 1 + random() % 8; words > 0; --words) {
+                line += ' ';
+                line += kWords[random() % std::size(kWords)];
+            }
+            return line;
+        }
+        case Action::Item:
+            return random() % 2 == 0 ? "get lantern" : "drop lantern";
+        case Action::Script:
+            // test.lua, where the server runs scripts; elsewhere an unknown command
+            return "test load";
+    }
+    return "look";
+}
+
+// Players think for an exponentially distributed time between commands
+Clock::duration thinkTime(const Options& options, std::mt19937_64& random) {
+    std::exponential_distribution<double> seconds(options.rate);
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds(random)));
+}
+
+// Names are letters only: Load, then the index in base 26
+std::string clientName(std::size_t index) {
+    std::string name = "Load";
+    do {
+        name += static_cast<char>('a' + index % 26);
+        index /= 26;
+    } while (index > 0);
+    return name;
+}
+
+struct Report {
+    LatencyHistogram replies;
+    std::array<std::uint64_t, kActionCount> sent{};
+    std::uint64_t lost = 0;      // Connections gone or replies timed out
+    std::uint64_t refused = 0;   // Lines the tick scheduler dropped (in process)
+    std::uint64_t bytes = 0;
+    std::uint64_t messages = 0;
+    std::chrono::nanoseconds elapsed{};
+};
+
+// The tick counters a server with --metrics serves
+struct ServerTicks {
+    double ticks = 0;
+    double overruns = 0;
+    double p99 = 0;   // Seconds, over the server's whole run
+};
+
+bool parseNumber(std::string_view text, auto& value) {
+    return std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc();
+}
+
+bool parseMix(std::string_view text, std::array<unsigned, kActionCount>& mix) {
+    mix.fill(0);
+    while (!text.empty()) {
+        const std::size_t comma = text.find(',');
+        const std::string_view item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+        const std::size_t equals = item.find('=');
+        if (equals == std::string_view::npos) {
+            return false;
+        }
+        const auto name = std::find(kActionNames.begin(), kActionNames.end(), item.substr(0, equals));
+        if (name == kActionNames.end() || !parseNumber(item.substr(equals + 1), mix[name - kActionNames.begin()])) {
+            return false;
+        }
+    }
+    return std::any_of(mix.begin(), mix.end(), [](unsigned weight) { return weight > 0; });
+}
+
+int connectTo(const std::string& host, const std::string& port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+        return -1;
+    }
+    int fd = -1;
+    for (const addrinfo* address = addresses; address && fd < 0; address = address->ai_next) {
+        fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd >= 0 && ::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+// One GET of the metrics page, and the tick counters on it
+std::optional<ServerTicks> scrapeTicks(const Options& options) {
+    const int fd = connectTo(options.host, options.metricsPort);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    const std::string request = "GET /metrics HTTP/1.0\r\nHost: " + options.host + "\r\n\r\n";
+    std::string page;
+    if (::send(fd, request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size())) {
+        char buffer[16 * 1024];
+        for (ssize_t got; (got = ::recv(fd, buffer, sizeof buffer, 0)) > 0;) {
+            page.append(buffer, static_cast<std::size_t>(got));
+        }
+    }
+    ::close(fd);
+
+    ServerTicks ticks;
+    bool found = false;
+    const auto read = [&](std::string_view name, double& value) {
+        const std::size_t at = page.find("\n" + std::string(name) + " ");
+        if (at != std::string::npos) {
+            found |= parseNumber(std::string_view(page).substr(at + name.size() + 2), value);
+        }
+    };
+    read("echomud_ticks_total", ticks.ticks);
+    read("echomud_tick_overruns_total", ticks.overruns);
+    read("echomud_tick_duration_seconds{quantile=\"0.99\"}", ticks.p99);
+    return found ? std::optional(ticks) : std::nullopt;
+}
+
+void raiseFileLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+#if defined(__APPLE__)
+        limit.rlim_cur = std::min<rlim_t>(limit.rlim_cur, OPEN_MAX);
+#endif
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+// A simulated player over the network
+struct NetClient {
+    enum class Stage : std::uint8_t { Waiting, Naming, Entering, Thinking, Replying, Gone };
+
+    int fd = -1;
+    Stage stage = Stage::Waiting;
+    std::mt19937_64 random;
+    std::string unread;       // Since the last prompt, to find one split across reads
+    Clock::time_point due;    // To join, to send the next command, or to give up on the reply
+    Clock::time_point sent;
+};
+
+// Whether what came since the last prompt holds one; only the end of it is
+// kept, enough to find a prompt the next read completes
+bool prompted(NetClient& client, std::string_view prompt) {
+    if (client.unread.find(prompt) != std::string::npos) {
+        client.unread.clear();
+        return true;
+    }
+    if (client.unread.size() >= prompt.size()) {
+        client.unread.erase(0, client.unread.size() - prompt.size() + 1);
+    }
+    return false;
+}
+
+bool sendLine(const NetClient& client, std::string_view line) {
+    std::string out(line);
+    out += "\r\n";
+    return ::send(client.fd, out.data(), out.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(out.size());
+}
+
+bool runNetwork(const Options& options, Report& report) {
+    raiseFileLimit();
+    std::vector<NetClient> clients(options.clients);
+    const auto start = Clock::now();
+    const auto end = start + options.duration;
+    for (std::size_t i = 0; i < clients.size(); ++i) {
+        clients[i].random = clientRandom(options.seed, i);
+        clients[i].due = start + options.ramp * i / clients.size();
+    }
+
+    std::vector<pollfd> ready;
+    std::vector<std::size_t> readyClients;
+    char buffer[16 * 1024];
+    std::size_t gone = 0;
+    while (gone < clients.size()) {
+        const auto now = Clock::now();
+        auto wake = now + std::chrono::seconds(1);
+        ready.clear();
+        readyClients.clear();
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            NetClient& client = clients[i];
+            if (client.stage == NetClient::Stage::Gone) {
+                continue;
+            }
+            if (now >= end && client.stage != NetClient::Stage::Replying) {
+                // Time is up; a reply on its way is still waited for
+                if (client.fd >= 0) {
+                    sendLine(client, "quit");
+                    ::close(client.fd);
+                }
+                client.stage = NetClient::Stage::Gone;
+                ++gone;
+                continue;
+            }
+            if (now >= client.due) {
+                bool ok = true;
+                switch (client.stage) {
+                    case NetClient::Stage::Waiting:
+                        client.fd = connectTo(options.host, options.port);
+                        ok = client.fd >= 0;
+                        if (ok) {
+                            const int on = 1;
+                            ::setsockopt(client.fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+                            ::fcntl(client.fd, F_SETFL, ::fcntl(client.fd, F_GETFL) | O_NONBLOCK);
+                            client.stage = NetClient::Stage::Naming;
+                            client.due = now + kReplyTimeout;
+                        }
+                        break;
+                    case NetClient::Stage::Thinking: {
+                        const Action action = pickAction(options, client.random);
+                        ok = sendLine(client, makeCommand(action, client.random));
+                        ++report.sent[static_cast<std::size_t>(action)];
+                        client.stage = NetClient::Stage::Replying;
+                        client.sent = now;
+                        client.due = now + kReplyTimeout;
+                        break;
+                    }
+                    default:
+                        ok = false;   // No reply in time
+                        break;
+                }
+                if (!ok) {
+                    if (client.fd >= 0) {
+                        ::close(client.fd);
+                    }
+                    client.stage = NetClient::Stage::Gone;
+                    ++report.lost;
+                    ++gone;
+                    continue;
+                }
+            }
+            wake = std::min(wake, client.due);
+            if (client.fd >= 0) {
+                ready.push_back({client.fd, POLLIN, 0});
+                readyClients.push_back(i);
+            }
+        }
+        if (gone == clients.size()) {
+            break;
+        }
+
+        const auto wait = std::chrono::ceil<std::chrono::milliseconds>(std::min(wake, std::max(end, now)) - now);
+        ::poll(ready.data(), ready.size(), static_cast<int>(std::max<std::chrono::milliseconds::rep>(wait.count(), 0)));
+        for (std::size_t r = 0; r < ready.size(); ++r) {
+            if (ready[r].revents == 0) {
+                continue;
+            }
+            NetClient& client = clients[readyClients[r]];
+            const ssize_t got = ::recv(client.fd, buffer, sizeof buffer, 0);
+            if (got < 0 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+            bool ok = got > 0;
+            if (ok) {
+                report.bytes += static_cast<std::uint64_t>(got);
+                client.unread.append(buffer, static_cast<std::size_t>(got));
+                const auto now = Clock::now();
+                switch (client.stage) {
+                    case NetClient::Stage::Naming:
+                        if (!options.password.empty() && prompted(client, "Password: ")) {
+                            ok = sendLine(client, options.password);
+                            client.stage = NetClient::Stage::Entering;
+                        } else if (prompted(client, "known? ")) {
+                            ok = sendLine(client, clientName(readyClients[r]));
+                            client.stage = options.password.empty() ? NetClient::Stage::Entering
+                                                                    : NetClient::Stage::Naming;
+                        }
+                        break;
+                    case NetClient::Stage::Entering:
+                    case NetClient::Stage::Replying:
+                        if (prompted(client, "> ")) {
+                            if (client.stage == NetClient::Stage::Replying) {
+                                report.replies.record(now - client.sent);
+                            }
+                            client.stage = NetClient::Stage::Thinking;
+                            client.due = now + thinkTime(options, client.random);
+                        }
+                        break;
+                    default:
+                        // Other players' speech and arrivals come without a prompt
+                        client.unread.clear();
+                        break;
+                }
+            }
+            if (!ok) {
+                ::close(client.fd);
+                client.fd = -1;
+                client.stage = NetClient::Stage::Gone;
+                ++report.lost;
+                ++gone;
+            }
+        }
+    }
+    report.elapsed = Clock::now() - start;
+    return true;
+}
+
+// A simulated player inside the engine
+struct LocalClient {
+    PlayerId player = kInvalidPlayerId;
+    std::mt19937_64 random;
+    Clock::time_point sent;
+};
+
+bool runInProcess(const Options& options, Report& report, TickStats& ticks) {
+    AreaFile area;
+    if (options.world) {
+        area = AreaFile::open(options.world);
+        if (!area.valid()) {
+            std::fprintf(stderr, "Invalid world file: %s\n", options.world);
+            return false;
+        }
+    }
+    auto engine = GameEngine::create("Loadgen", std::move(area));
+    engine->removePlayer(engine->localPlayer());
+    if (options.zoneActors) {
+        engine->setExecutionMode(ExecutionMode::ZoneActors);
+    }
+    // Their think time is the only limit on the players, as over the network
+    // it is theirs and the rate limit
+    engine->ticks().setRateLimit(0);
+
+    // Lines are run at the ticks as the server runs them: collected, then
+    // run together, and their replies count as arriving once all have run
+    std::vector<LocalClient> clients(options.clients);
+    std::vector<QueuedCommand> batch;
+    std::vector<SessionId> batchClients;
+    using Due = std::pair<Clock::time_point, SessionId>;
+    std::priority_queue<Due, std::vector<Due>, std::greater<>> due;
+    engine->ticks().setCommandRunner(
+        [&](SessionId client, std::string& line) {
+            batch.push_back({clients[client].player, std::move(line)});
+            batchClients.push_back(client);
+        },
+        [&] {
+            engine->runCommands(batch);
+            const auto now = Clock::now();
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                LocalClient& client = clients[batchClients[i]];
+                report.replies.record(now - client.sent);
+                report.bytes += batch[i].result.message.size();
+                engine->ticks().delaySession(batchClients[i], batch[i].result.lag);
+                due.push({now + thinkTime(options, client.random), batchClients[i]});
+            }
+            batch.clear();
+            batchClients.clear();
+        });
+
+    const auto start = Clock::now();
+    const auto end = start + options.duration;
+    for (std::size_t i = 0; i < clients.size(); ++i) {
+        clients[i].random = clientRandom(options.seed, i);
+        due.push({start + options.ramp * i / clients.size(), i});
+    }
+    std::vector<PlayerId> recipients;
+    std::vector<SharedMessage> messages;
+    for (;;) {
+        auto now = Clock::now();
+        if (now >= end) {
+            break;
+        }
+        while (!due.empty() && due.top().first <= now) {
+            LocalClient& client = clients[due.top().second];
+            const SessionId session = due.top().second;
+            due.pop();
+            if (client.player == kInvalidPlayerId) {
+                // Joining: the first command comes after a first thought
+                client.player = engine->addPlayer(clientName(session));
+                due.push({now + thinkTime(options, client.random), session});
+                continue;
+            }
+            const Action action = pickAction(options, client.random);
+            ++report.sent[static_cast<std::size_t>(action)];
+            client.sent = now;
+            if (engine->ticks().enqueue(session, makeCommand(action, client.random)) != EnqueueResult::Queued) {
+                ++report.refused;
+                due.push({now + thinkTime(options, client.random), session});
+            }
+        }
+
+        // What the players would be sent, dropped as a front end would send it
+        auto next = engine->idle(std::chrono::milliseconds(2));
+        engine->takeRecipients(recipients);
+        for (const PlayerId player : recipients) {
+            engine->takeMessages(player, messages);
+            report.messages += messages.size();
+        }
+        messages.clear();
+
+        next = std::min({next, engine->ticks().nextTick(), end});
+        if (!due.empty()) {
+            next = std::min(next, due.top().first);
+        }
+        std::this_thread::sleep_until(next);
+    }
+    report.elapsed = Clock::now() - start;
+    ticks = engine->ticks().stats();
+    engine->ticks().setCommandRunner(nullptr);
+    return true;
+}
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+} // namespace
+
+// Usage: mud_loadgen [--connect HOST:PORT | --in-process] [--clients N] [--rate COMMANDS_PER_SECOND]
+//                    [--duration SECONDS] [--ramp SECONDS] [--mix move=40,look=30,say=15,item=10,script=5]
+//                    [--seed N] [--password PASSWORD] [--metrics PORT] [--world FILE] [--zone-actors]
+// Simulates players, each thinking a random while between commands drawn
+// from the mix, against a server or an engine in this process, and reports
+// throughput, reply times and how the ticks kept up. The same seed makes
+// every client send the same commands at the same moments
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--in-process") {
+            options.inProcess = true;
+        } else if (arg == "--zone-actors") {
+            options.zoneActors = true;
+        } else if (arg == "--connect" && hasValue) {
+            const std::string_view address = argv[++i];
+            const std::size_t colon = address.rfind(':');
+            if (colon == std::string_view::npos || colon == 0 || colon + 1 == address.size()) {
+                std::fprintf(stderr, "Invalid address, expected HOST:PORT: %s\n", argv[i]);
+                return 1;
+            }
+            options.host = address.substr(0, colon);
+            options.port = address.substr(colon + 1);
+        } else if (arg == "--clients" && hasValue) {
+            if (!parseNumber(argv[++i], options.clients) || options.clients == 0) {
+                std::fprintf(stderr, "Invalid client count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--rate" && hasValue) {
+            if (!parseNumber(argv[++i], options.rate) || !(options.rate > 0)) {
+                std::fprintf(stderr, "Invalid command rate: %s\n", argv[i]);
+                return 1;
+            }
+        } else if ((arg == "--duration" || arg == "--ramp") && hasValue) {
+            unsigned seconds = 0;
+            if (!parseNumber(argv[++i], seconds) || (seconds == 0 && arg == "--duration")) {
+                std::fprintf(stderr, "Invalid %s: %s\n", arg == "--duration" ? "duration" : "ramp", argv[i]);
+                return 1;
+            }
+            (arg == "--duration" ? options.duration : options.ramp) = std::chrono::seconds(seconds);
+        } else if (arg == "--mix" && hasValue) {
+            if (!parseMix(argv[++i], options.mix)) {
+                std::fprintf(stderr, "Invalid mix, expected weights such as move=40,look=30,say=15,item=10,script=5: %s\n",
+                             argv[i]);
+                return 1;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            if (!parseNumber(argv[++i], options.seed)) {
+                std::fprintf(stderr, "Invalid seed: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--password" && hasValue) {
+            options.password = argv[++i];
+        } else if (arg == "--metrics" && hasValue) {
+            options.metricsPort = argv[++i];
+        } else if (arg == "--world" && hasValue) {
+            options.world = argv[++i];
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    options.ramp = std::min(options.ramp, options.duration);
+
+    Report report;
+    TickStats ticks;
+    std::optional<ServerTicks> before;
+    if (options.inProcess) {
+        std::fprintf(stderr, "Simulating %zu players in process for %lld s, seed %llu\n", options.clients,
+                     static_cast<long long>(options.duration.count()), static_cast<unsigned long long>(options.seed));
+        if (!runInProcess(options, report, ticks)) {
+            return 1;
+        }
+    } else {
+        if (!options.metricsPort.empty() && !(before = scrapeTicks(options))) {
+            std::fprintf(stderr, "No tick metrics at %s:%s\n", options.host.c_str(), options.metricsPort.c_str());
+        }
+        std::fprintf(stderr, "Simulating %zu players against %s:%s for %lld s, seed %llu\n", options.clients,
+                     options.host.c_str(), options.port.c_str(), static_cast<long long>(options.duration.count()),
+                     static_cast<unsigned long long>(options.seed));
+        runNetwork(options, report);
+    }
+
+    std::uint64_t sent = 0;
+    for (const std::uint64_t count : report.sent) {
+        sent += count;
+    }
+    const double seconds = std::chrono::duration<double>(report.elapsed).count();
+    std::printf("Sent %llu commands, %llu answered in %.1f s: %.1f per second\n", static_cast<unsigned long long>(sent),
+                static_cast<unsigned long long>(report.replies.count()), seconds,
+                static_cast<double>(report.replies.count()) / seconds);
+    std::printf("Mix:");
+    for (std::size_t i = 0; i < kActionCount; ++i) {
+        std::printf(" %s %llu", kActionNames[i].data(), static_cast<unsigned long long>(report.sent[i]));
+    }
+    std::printf("\n");
+    const LatencyHistogram& replies = report.replies;
+    std::printf("Reply time: p50 %.3f ms  p90 %.3f ms  p99 %.3f ms  p99.9 %.3f ms  max %.3f ms\n",
+                milliseconds(replies.percentile(0.5)), milliseconds(replies.percentile(0.9)),
+                milliseconds(replies.percentile(0.99)), milliseconds(replies.percentile(0.999)),
+                milliseconds(replies.max()));
+    if (options.inProcess) {
+        std::printf("Ticks: %llu run, %llu over the period, %llu boundaries missed, %.3f ms at most; "
+                    "%llu refused lines, %llu messages to players, %llu bytes of replies\n",
+                    static_cast<unsigned long long>(ticks.ticks), static_cast<unsigned long long>(ticks.overruns),
+                    static_cast<unsigned long long>(ticks.missed), milliseconds(ticks.longestTick),
+                    static_cast<unsigned long long>(report.refused), static_cast<unsigned long long>(report.messages),
+                    static_cast<unsigned long long>(report.bytes));
+    } else {
+        std::printf("%llu players lost, %llu bytes received\n", static_cast<unsigned long long>(report.lost),
+                    static_cast<unsigned long long>(report.bytes));
+        if (const std::optional<ServerTicks> after = before ? scrapeTicks(options) : std::nullopt) {
+            const double ran = after->ticks - before->ticks;
+            const double overran = after->overruns - before->overruns;
+            std::printf("Server ticks: %.0f run, %.0f over the period (%.2f%%); p99 tick %.3f ms since it started\n",
+                        ran, overran, ran > 0 ? 100 * overran / ran : 0.0, after->p99 * 1000);
+        }
+    }
+    return 0;
+}
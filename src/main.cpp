@@ -1,6 +1,7 @@
 #include "../include/ConsoleUI.h"
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <utility> // Include for std::move
 #include <memory> // Include for std::make_unique
 // Use <print> if available (C++23), otherwise fallback
@@ -35,8 +36,28 @@ std::string initErrorToString(InitError err) {
     }
 }
 
-int main() {
-    auto consoleUIResult = ConsoleUI::create();
+int main(int argc, char** argv) {
+    // --vt draws with the console's own VT100 renderer instead of curses;
+    // --connect attaches to a net_server's admin socket instead of running
+    // a game here, playing as --name
+    ConsoleBackend backend = ConsoleBackend::Curses;
+    std::string socketPath;
+    std::string operatorName = "Operator";
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--vt") {
+            backend = ConsoleBackend::Vt;
+        } else if (arg == "--connect" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--name" && i + 1 < argc) {
+            operatorName = argv[++i];
+        } else {
+            std::println(stderr, "Usage: {} [--vt] [--connect SOCKET [--name NAME]]", argv[0]);
+            return 2;
+        }
+    }
+
+    auto consoleUIResult = ConsoleUI::create(backend);
 
     if (!consoleUIResult.has_value()) {
         std::println(stderr, "Error initializing Console UI");
@@ -47,6 +68,13 @@ int main() {
     try {
         // Use a unique_ptr to ensure proper destruction even in case of exceptions
         auto consoleUI = std::make_unique<ConsoleUI>(std::move(consoleUIResult.value()));
+        if (!socketPath.empty()) {
+            if (auto attached = consoleUI->attach(socketPath, operatorName); !attached) {
+                consoleUI.reset();
+                std::println(stderr, "Couldn't attach: {}", attached.error());
+                return 1;
+            }
+        }
         
         // The run method now handles setting the global pointer
         consoleUI->run();
@@ -1,48 +1,286 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <format>
 #include <iostream>
+#include <latch>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <string>
-#include <format>
-#include <filesystem>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "../include/GameEngine.h"
+#include "../include/LatencyHistogram.h"
+
+// Runs a few commands, scripted ones among them, and prints what they
+// answer; with --bench, a throughput benchmark of the engine with scripting:
+//
+//   scripted_app --bench [--iterations N] [--threads N] [--warmup N] [--mix LIST] [--seed N]
+//
+// Each thread drives an engine of its own, with its own pool of Lua states,
+// through the same weighted mix of command lines; the engine's command path
+// runs on one thread, so this is how it scales across cores. --iterations
+// and --warmup count commands per thread, the warm-up unmeasured, so lazy
+// scripts are compiled and caches filled first. The mix is a comma-separated
+// list of LINE=WEIGHT. It reports commands per second, each line's latency
+// percentiles, and how much of the command time ran in Lua, per script.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view kDefaultMix =
+    "look=4,say Hello there=3,test=2,test With some arguments=1,north=2,south=2,help=1";
+
+struct MixEntry {
+    std::string line;
+    unsigned weight = 0;
+};
+
+struct BenchOptions {
+    std::size_t iterations = 20000;
+    std::size_t threads = 1;
+    std::size_t warmup = 1000;
+    std::uint64_t seed = 1;
+    std::vector<MixEntry> mix;
+};
+
+// What every thread adds to, per mix entry and per script
+struct BenchReport {
+    std::vector<std::unique_ptr<LatencyHistogram>> latency;   // By mix entry
+    std::vector<std::uint64_t> failed;                        // By mix entry
+    std::map<std::string, ScriptRunner::ScriptStats> scripts;
+    std::chrono::nanoseconds commandTime{0};
+    std::mutex mutex;   // For failed, scripts and commandTime
+};
+
+bool parseNumber(std::string_view text, auto& value) {
+    return !text.empty() && std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc();
+}
+
+bool parseMix(std::string_view text, std::vector<MixEntry>& mix) {
+    mix.clear();
+    while (!text.empty()) {
+        const std::size_t comma = text.find(',');
+        const std::string_view item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+        const std::size_t equals = item.rfind('=');
+        MixEntry entry;
+        if (equals == 0 || equals == std::string_view::npos || !parseNumber(item.substr(equals + 1), entry.weight)) {
+            return false;
+        }
+        entry.line = item.substr(0, equals);
+        mix.push_back(std::move(entry));
+    }
+    return std::ranges::any_of(mix, [](const MixEntry& entry) { return entry.weight > 0; });
+}
+
+// Script counters after less those before, by script
+void addScriptTime(std::map<std::string, ScriptRunner::ScriptStats>& into,
+                   const std::vector<std::pair<std::string, ScriptRunner::ScriptStats>>& before,
+                   const std::vector<std::pair<std::string, ScriptRunner::ScriptStats>>& after) {
+    for (const auto& [name, stats] : after) {
+        ScriptRunner::ScriptStats& total = into[name];
+        total.calls += stats.calls;
+        total.wallTime += stats.wallTime;
+        const auto earlier = std::ranges::find(before, name, &std::pair<std::string, ScriptRunner::ScriptStats>::first);
+        if (earlier != before.end()) {
+            total.calls -= earlier->second.calls;
+            total.wallTime -= earlier->second.wallTime;
+        }
+    }
+}
+
+void benchThread(const BenchOptions& options, std::size_t index, std::latch& ready, std::latch& go,
+                 BenchReport& report) {
+    auto engine = GameEngine::create("Bench");
+    std::mt19937_64 random(options.seed + index);
+    std::discrete_distribution<std::size_t> pick(
+        options.mix.size(), 0.0, static_cast<double>(options.mix.size()),
+        [&options](double at) { return static_cast<double>(options.mix[static_cast<std::size_t>(at)].weight); });
+
+    for (std::size_t i = 0; i < options.warmup; ++i) {
+        engine->handleCommandLine(options.mix[pick(random)].line);
+    }
+    const auto before = engine->scriptStats();
+    std::vector<std::uint64_t> failed(options.mix.size());
+    ready.count_down();
+    go.wait();
+
+    std::chrono::nanoseconds commandTime{0};
+    for (std::size_t i = 0; i < options.iterations; ++i) {
+        const std::size_t entry = pick(random);
+        const auto begun = Clock::now();
+        const CommandResult result = engine->handleCommandLine(options.mix[entry].line);
+        const auto took = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begun);
+        report.latency[entry]->record(took);
+        commandTime += took;
+        failed[entry] += result.status == CommandResult::Status::Success ? 0 : 1;
+    }
+
+    const auto after = engine->scriptStats();
+    const std::lock_guard<std::mutex> lock(report.mutex);
+    addScriptTime(report.scripts, before, after);
+    report.commandTime += commandTime;
+    for (std::size_t entry = 0; entry < failed.size(); ++entry) {
+        report.failed[entry] += failed[entry];
+    }
+}
+
+double microseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::micro>(time).count();
+}
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
 
-// Simple example demonstrating script integration
-int main() {
+int runBench(const BenchOptions& options) {
+    BenchReport report;
+    for (std::size_t i = 0; i < options.mix.size(); ++i) {
+        report.latency.push_back(std::make_unique<LatencyHistogram>());
+    }
+    report.failed.resize(options.mix.size());
+
+    // Every engine is built and warmed before the clock starts
+    std::latch ready(static_cast<std::ptrdiff_t>(options.threads));
+    std::latch go(1);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < options.threads; ++i) {
+        threads.emplace_back(benchThread, std::cref(options), i, std::ref(ready), std::ref(go), std::ref(report));
+    }
+    ready.wait();
+    const auto start = Clock::now();
+    go.count_down();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const auto elapsed = Clock::now() - start;
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const std::size_t commands = options.iterations * options.threads;
+    std::uint64_t failed = 0;
+    for (const std::uint64_t count : report.failed) {
+        failed += count;
+    }
+    std::printf("%zu commands on %zu threads in %.2f s: %.0f per second, %llu failed\n\n", commands,
+                options.threads, seconds, static_cast<double>(commands) / seconds,
+                static_cast<unsigned long long>(failed));
+
+    std::printf("%-32s %9s %9s %9s %9s %9s\n", "Command", "Count", "p50 us", "p90 us", "p99 us", "Max us");
+    for (std::size_t i = 0; i < options.mix.size(); ++i) {
+        const LatencyHistogram& latency = *report.latency[i];
+        std::printf("%-32.32s %9llu %9.2f %9.2f %9.2f %9.2f\n", options.mix[i].line.c_str(),
+                    static_cast<unsigned long long>(latency.count()), microseconds(latency.percentile(0.5)),
+                    microseconds(latency.percentile(0.9)), microseconds(latency.percentile(0.99)),
+                    microseconds(latency.max()));
+    }
+
+    // Script time is counted inside the commands that ran the scripts, so
+    // what is left of the command time is the engine's own
+    std::chrono::nanoseconds luaTime{0};
+    for (const auto& [name, stats] : report.scripts) {
+        luaTime += stats.wallTime;
+    }
+    const auto nativeTime = std::max(report.commandTime - luaTime, std::chrono::nanoseconds(0));
+    const double share = report.commandTime.count() > 0
+                             ? 100.0 * static_cast<double>(luaTime.count()) / static_cast<double>(report.commandTime.count())
+                             : 0.0;
+    std::printf("\nCommand time %.1f ms: Lua %.1f ms (%.1f%%), native %.1f ms (%.1f%%)\n",
+                milliseconds(report.commandTime), milliseconds(luaTime), share, milliseconds(nativeTime),
+                100.0 - share);
+    std::printf("%-32s %9s %12s %9s\n", "Script", "Calls", "Total ms", "Avg us");
+    for (const auto& [name, stats] : report.scripts) {
+        if (stats.calls > 0) {
+            std::printf("%-32.32s %9llu %12.1f %9.2f\n", name.c_str(), static_cast<unsigned long long>(stats.calls),
+                        milliseconds(stats.wallTime),
+                        microseconds(stats.wallTime) / static_cast<double>(stats.calls));
+        }
+    }
+    return failed == commands ? 1 : 0;
+}
+
+// The original example: a few commands, scripted ones among them, and what they answer
+int runDemo() {
+    std::cout << "Initializing MUD engine with Lua scripting..." << std::endl;
+
+    // Create the game engine
+    auto gameEngine = GameEngine::create("Player");
+
+    // Print available commands
+    std::cout << "Available commands:" << std::endl;
+    std::cout << "-------------------" << std::endl;
+
+    // Test some commands including the scripted commands
+    const std::vector<std::pair<std::string, std::string>> testCommands = {
+        {"help", ""},
+        {"look", ""},
+        {"say", "Hello, world!"},
+        {"say", ""},  // This will test the script's error handling
+        {"test", ""},  // Test the test.lua script
+        {"test", "With some arguments"},  // Test with arguments
+        {"north", ""},
+        {"look", ""},
+        {"south", ""}
+    };
+
+    // Run the test commands
+    for (const auto& [cmd, args] : testCommands) {
+        std::cout << std::format("\n> {} {}", cmd, args) << std::endl;
+        auto result = gameEngine->handleCommand(cmd, args);
+
+        if (result.status == CommandResult::Status::Success) {
+            std::cout << result.message << std::endl;
+        } else {
+            std::cerr << "Error: " << result.message << std::endl;
+        }
+    }
+
+    std::cout << "\nTest completed successfully." << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
     try {
-        std::cout << "Initializing MUD engine with Lua scripting..." << std::endl;
-        
-        // Create the game engine
-        auto gameEngine = GameEngine::create("Player");
-        
-        // Print available commands
-        std::cout << "Available commands:" << std::endl;
-        std::cout << "-------------------" << std::endl;
-        
-        // Test some commands including the scripted commands
-        const std::vector<std::pair<std::string, std::string>> testCommands = {
-            {"help", ""},
-            {"look", ""},
-            {"say", "Hello, world!"},
-            {"say", ""},  // This will test the script's error handling
-            {"test", ""},  // Test the test.lua script
-            {"test", "With some arguments"},  // Test with arguments
-            {"north", ""},
-            {"look", ""},
-            {"south", ""}
-        };
-        
-        // Run the test commands
-        for (const auto& [cmd, args] : testCommands) {
-            std::cout << std::format("\n> {} {}", cmd, args) << std::endl;
-            auto result = gameEngine->handleCommand(cmd, args);
-            
-            if (result.status == CommandResult::Status::Success) {
-                std::cout << result.message << std::endl;
+        if (argc == 1) {
+            return runDemo();
+        }
+        BenchOptions options;
+        bool bench = false;
+        bool valid = parseMix(kDefaultMix, options.mix);
+        for (int i = 1; i < argc && valid; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--bench") {
+                bench = true;
+            } else if (arg == "--iterations" && hasValue) {
+                valid = parseNumber(argv[++i], options.iterations) && options.iterations > 0;
+            } else if (arg == "--threads" && hasValue) {
+                valid = parseNumber(argv[++i], options.threads) && options.threads > 0;
+            } else if (arg == "--warmup" && hasValue) {
+                valid = parseNumber(argv[++i], options.warmup);
+            } else if (arg == "--seed" && hasValue) {
+                valid = parseNumber(argv[++i], options.seed);
+            } else if (arg == "--mix" && hasValue) {
+                valid = parseMix(argv[++i], options.mix);
             } else {
-                std::cerr << "Error: " << result.message << std::endl;
+                valid = false;
             }
         }
-        
-        std::cout << "\nTest completed successfully." << std::endl;
-        return 0;
+        if (!bench || !valid) {
+            std::fprintf(stderr, "Usage: %s [--bench [--iterations N] [--threads N] [--warmup N] [--mix LINE=WEIGHT,...] "
+                                 "[--seed N]]\n", argv[0]);
+            return 2;
+        }
+        return runBench(options);
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -52,4 +290,4 @@ int main() {
         std::cerr << "Unknown error occurred." << std::endl;
         return 2;
     }
-} 
\ No newline at end of file
+}
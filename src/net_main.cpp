@@ -0,0 +1,644 @@
+#include "../include/FileView.h"
+#include "../include/Logger.h"
+#include "../include/MemoryAccounting.h"
+#include "../include/NetServer.h"
+#include "../include/PerfCounters.h"
+#include "../include/SignalHandler.h"
+#include "../include/StartupPhases.h"
+#include "../include/TraceLog.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::string netErrorToString(NetError err) {
+    switch (err) {
+        case NetError::SOCKET_FAILED: return "Failed to create the listening socket.";
+        case NetError::BIND_FAILED: return "Failed to bind the address (bad address or port in use).";
+        case NetError::LISTEN_FAILED: return "Failed to listen on the socket.";
+        case NetError::POLLER_FAILED: return "Failed to set up the event loop.";
+        case NetError::COPYOVER_FAILED: return "Failed to read the state the previous process handed over.";
+        case NetError::TLS_FAILED: return "Failed to set up TLS (unusable certificate or key, or built without OpenSSL).";
+        case NetError::CONFIG_FAILED: return "Failed to read the config or access file (the log says which and where).";
+        case NetError::DATABASE_FAILED: return "Failed to open the database or the boards (the log says which).";
+        default: return "Unknown network error.";
+    }
+}
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+} // namespace
+
+// Usage: net_server [--epoll] [--reactors N] [--disconnect-slow] [--no-compress] [--websocket PORT] [--zone-actors]
+//                   [--rate-limit LINES_PER_SECOND] [--accounts DIR] [--login-threads N] [--save-interval SECONDS]
+//                   [--journal] [--journal-sync never|always|MILLISECONDS] [--state-segment NAME] [--checkpoint FILE]
+//                   [--checkpoint-interval SECONDS] [--record DIR] [--world FILE] [--export-world FILE]
+//                   [--trace FILE] [--trace-size MEGABYTES] [--stats-interval SECONDS] [--metrics PORT]
+//                   [--shard INDEX/COUNT --shard-port PORT] [--tls PORT --tls-cert FILE --tls-key FILE]
+//                   [--tls-workers N] [--idle-compact SECONDS] [--topology game=CORES;reactors=CORES;workers=CORES]
+//                   [--perf-counters] [--config FILE] [--watchdog SECONDS] [--seed N] [--socials FILE]
+//                   [--database FILE] [--access FILE] [--per-ip N] [--resolvers N] [--api PORT]
+//                   [--api-address ADDRESS] [--api-origin ORIGIN] [--admins NAME,NAME] [--admin-socket PATH] [--texts DIR] [--huge-pages off|transparent|explicit]
+//                   [--log-rotate MEGABYTES] [--log-keep N] [--behaviors FILE] [port] [address]
+// CORES lists cores, ranges and NUMA nodes, such as 1-7,node1 (see ThreadTopology)
+// kill -USR2 restarts the server in place; the new process is run with --copyover FD
+// kill -HUP reads the config file again (see ServerConfig for its settings)
+// --seed starts every random number generator from N rather than a fresh
+// seed, which is printed at startup so mud_replay --seed can repeat a run
+// --socials replaces the built-in socials with a table (see Socials.h)
+// --database keeps a log of logins and logouts in a SQLite file (see Storage.h)
+// --access bans and allows addresses by CIDR prefix (see AccessList.h), and
+// --per-ip caps the connections open at once from one address; kill -HUP
+// reads the access file again too
+// --resolvers looks up clients' host names on N threads, for who and the log
+// --api-address is the address the API listens on, whatever the game's:
+// 127.0.0.1 unless given. --api-origin lets pages from ORIGIN, or * for any
+// site, read it; without it browsers keep other sites' pages from it
+// --admins names the players who may snoop; it needs --accounts
+// --admin-socket listens on a Unix socket for console_app --connect, whose
+// operators play as admins with the terminal drawn in their own process
+// --state-segment keeps the journaled players in a shared-memory segment
+// as well, which a restart after a crash resumes from without reading the
+// journal back (see StateSegment.h); it needs --journal
+// --texts serves DIR/motd.txt as the greeting and DIR/help/TOPIC.txt as help,
+// mapped rather than read, and mapped again when they change (see TextFiles.h)
+// --huge-pages puts the world's and the sessions' memory on 2 MiB pages
+// (see HugePages); explicit needs vm.nr_hugepages, and falls back to
+// transparent ones without it
+// --log-rotate moves the log file aside once it reaches MEGABYTES (64 by
+// default, 0 for only once a day), and --log-keep keeps the newest N moved
+// aside (10 by default, 0 for all); see LogRotation
+// --behaviors gives NPCs behaviour trees from a file (see BehaviorTree.h)
+int main(int argc, char** argv) {
+    NetServer::Options options;
+    // A copyover runs whatever binary is at this path by then, with the
+    // same options, so a deploy only has to replace the file
+    const std::filesystem::path executable = std::filesystem::absolute(argv[0]);
+    std::vector<std::string> arguments;
+    const char* worldFile = nullptr;
+    const char* exportFile = nullptr;
+    const char* socialsFile = nullptr;
+    const char* behaviorsFile = nullptr;
+    const char* traceFile = nullptr;
+    std::size_t traceBytes = TraceLog::kDefaultBytes;
+    LogRotation logRotation;
+    std::uint64_t seed = (std::uint64_t{std::random_device{}()} << 32) | std::random_device{}();
+    std::vector<const char*> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const int first = i;
+        if (arg == Copyover::kOption && i + 1 < argc) {
+            const std::string_view fd = argv[++i];
+            if (std::from_chars(fd.data(), fd.data() + fd.size(), options.copyoverFd).ec != std::errc() ||
+                options.copyoverFd < 0) {
+                std::fprintf(stderr, "Invalid copyover state: %s\n", argv[i]);
+                return 1;
+            }
+            continue;
+        }
+        if (arg == "--epoll") {
+            options.useIoUring = false;
+        } else if (arg == "--disconnect-slow") {
+            options.slowClients = SlowClientPolicy::Disconnect;
+        } else if (arg == "--no-compress") {
+            options.compression = false;
+        } else if (arg == "--zone-actors") {
+            options.zoneActors = true;
+        } else if (arg == "--websocket" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.webSocketPort).ec != std::errc() ||
+                options.webSocketPort == 0) {
+                std::fprintf(stderr, "Invalid WebSocket port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--tls" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.tlsPort).ec != std::errc() ||
+                options.tlsPort == 0) {
+                std::fprintf(stderr, "Invalid TLS port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--tls-cert" && i + 1 < argc) {
+            options.tlsCertificate = argv[++i];
+        } else if (arg == "--tls-key" && i + 1 < argc) {
+            options.tlsKey = argv[++i];
+        } else if (arg == "--tls-workers" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.tlsWorkers).ec != std::errc() ||
+                options.tlsWorkers == 0) {
+                std::fprintf(stderr, "Invalid TLS worker count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.metricsPort).ec != std::errc() ||
+                options.metricsPort == 0) {
+                std::fprintf(stderr, "Invalid metrics port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--api" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.apiPort).ec != std::errc() ||
+                options.apiPort == 0) {
+                std::fprintf(stderr, "Invalid API port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--shard-port" && i + 1 < argc) {
+            const std::string_view port = argv[++i];
+            if (std::from_chars(port.data(), port.data() + port.size(), options.shardPort).ec != std::errc() ||
+                options.shardPort == 0) {
+                std::fprintf(stderr, "Invalid shard port: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--shard" && i + 1 < argc) {
+            const std::string_view shard = argv[++i];
+            const std::size_t slash = shard.find('/');
+            if (slash == std::string_view::npos ||
+                std::from_chars(shard.data(), shard.data() + slash, options.shard.index).ec != std::errc() ||
+                std::from_chars(shard.data() + slash + 1, shard.data() + shard.size(), options.shard.count).ec !=
+                    std::errc() ||
+                options.shard.count == 0 || options.shard.index >= options.shard.count) {
+                std::fprintf(stderr, "Invalid shard: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--rate-limit" && i + 1 < argc) {
+            const std::string_view rate = argv[++i];
+            if (std::from_chars(rate.data(), rate.data() + rate.size(), options.rateLimit).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid rate limit: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--accounts" && i + 1 < argc) {
+            options.accounts = argv[++i];
+        } else if (arg == "--database" && i + 1 < argc) {
+            options.database = argv[++i];
+        } else if (arg == "--access" && i + 1 < argc) {
+            options.access = argv[++i];
+        } else if (arg == "--per-ip" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.connectionsPerIp).ec !=
+                std::errc()) {
+                std::fprintf(stderr, "Invalid connections per address: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--resolvers" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.resolvers).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid resolver thread count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--api-address" && i + 1 < argc) {
+            options.apiAddress = argv[++i];
+        } else if (arg == "--api-origin" && i + 1 < argc) {
+            options.apiOrigin = argv[++i];
+            if (options.apiOrigin.find_first_of("\r\n") != std::string::npos) {
+                std::fprintf(stderr, "Invalid API origin: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--admin-socket" && i + 1 < argc) {
+            options.adminSocket = argv[++i];
+        } else if (arg == "--admins" && i + 1 < argc) {
+            std::string_view names = argv[++i];
+            while (!names.empty()) {
+                const std::size_t comma = names.find(',');
+                if (const std::string_view name = names.substr(0, comma); !name.empty()) {
+                    options.admins.emplace_back(name);
+                }
+                names = comma == std::string_view::npos ? std::string_view() : names.substr(comma + 1);
+            }
+        } else if (arg == "--config" && i + 1 < argc) {
+            options.config = argv[++i];
+        } else if (arg == "--watchdog" && i + 1 < argc) {
+            const std::string_view threshold = argv[++i];
+            unsigned seconds = 0;
+            if (std::from_chars(threshold.data(), threshold.data() + threshold.size(), seconds).ec != std::errc() ||
+                seconds == 0) {
+                std::fprintf(stderr, "Invalid watchdog threshold: %s\n", argv[i]);
+                return 1;
+            }
+            options.watchdog = std::chrono::seconds(seconds);
+        } else if (arg == "--login-threads" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.loginThreads).ec != std::errc() ||
+                options.loginThreads == 0) {
+                std::fprintf(stderr, "Invalid login thread count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--idle-compact" && i + 1 < argc) {
+            const std::string_view idle = argv[++i];
+            unsigned seconds = 0;
+            if (std::from_chars(idle.data(), idle.data() + idle.size(), seconds).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid idle compaction time: %s\n", argv[i]);
+                return 1;
+            }
+            options.idleCompaction = std::chrono::seconds(seconds);
+        } else if (arg == "--save-interval" && i + 1 < argc) {
+            const std::string_view interval = argv[++i];
+            unsigned seconds = 0;
+            if (std::from_chars(interval.data(), interval.data() + interval.size(), seconds).ec != std::errc() ||
+                seconds == 0) {
+                std::fprintf(stderr, "Invalid save interval: %s\n", argv[i]);
+                return 1;
+            }
+            options.saveInterval = std::chrono::seconds(seconds);
+        } else if (arg == "--journal") {
+            options.journal = true;
+        } else if (arg == "--journal-sync" && i + 1 < argc) {
+            const std::string_view sync = argv[++i];
+            unsigned ms = 0;
+            if (sync == "never") {
+                options.journalSync = JournalSync::Never;
+            } else if (sync == "always") {
+                options.journalSync = JournalSync::Always;
+            } else if (std::from_chars(sync.data(), sync.data() + sync.size(), ms).ec == std::errc() && ms > 0) {
+                options.journalSync = JournalSync::Interval;
+                options.journalSyncInterval = std::chrono::milliseconds(ms);
+            } else {
+                std::fprintf(stderr, "Invalid journal sync: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--texts" && i + 1 < argc) {
+            options.texts = argv[++i];
+        } else if (arg == "--state-segment" && i + 1 < argc) {
+            options.stateSegment = argv[++i];
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            options.checkpoint = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            options.record = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            const std::string_view interval = argv[++i];
+            unsigned seconds = 0;
+            if (std::from_chars(interval.data(), interval.data() + interval.size(), seconds).ec != std::errc() ||
+                seconds == 0) {
+                std::fprintf(stderr, "Invalid checkpoint interval: %s\n", argv[i]);
+                return 1;
+            }
+            options.checkpointInterval = std::chrono::seconds(seconds);
+        } else if (arg == "--stats-interval" && i + 1 < argc) {
+            const std::string_view interval = argv[++i];
+            unsigned seconds = 0;
+            if (std::from_chars(interval.data(), interval.data() + interval.size(), seconds).ec != std::errc() ||
+                seconds == 0) {
+                std::fprintf(stderr, "Invalid stats interval: %s\n", argv[i]);
+                return 1;
+            }
+            options.statsInterval = std::chrono::seconds(seconds);
+        } else if (arg == "--world" && i + 1 < argc) {
+            worldFile = argv[++i];
+        } else if (arg == "--export-world" && i + 1 < argc) {
+            exportFile = argv[++i];
+        } else if (arg == "--socials" && i + 1 < argc) {
+            socialsFile = argv[++i];
+        } else if (arg == "--behaviors" && i + 1 < argc) {
+            behaviorsFile = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (std::from_chars(value.data(), value.data() + value.size(), seed).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid seed: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--trace-size" && i + 1 < argc) {
+            const std::string_view size = argv[++i];
+            std::size_t megabytes = 0;
+            if (std::from_chars(size.data(), size.data() + size.size(), megabytes).ec != std::errc() ||
+                megabytes == 0) {
+                std::fprintf(stderr, "Invalid trace size: %s\n", argv[i]);
+                return 1;
+            }
+            traceBytes = megabytes << 20;
+        } else if (arg == "--perf-counters") {
+            // Each thread opens its own counters the first time it is measured
+            if (!PerfCounters::enable()) {
+                std::fprintf(stderr, "Hardware counters are not available here; running without them\n");
+            }
+        } else if (arg == "--log-rotate" && i + 1 < argc) {
+            const std::string_view size = argv[++i];
+            std::uint64_t megabytes = 0;
+            if (std::from_chars(size.data(), size.data() + size.size(), megabytes).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid log size: %s\n", argv[i]);
+                return 1;
+            }
+            logRotation.maxBytes = megabytes << 20;
+        } else if (arg == "--log-keep" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), logRotation.keep).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid log count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--huge-pages" && i + 1 < argc) {
+            // Before the world is built, so it is all allocated from the arena
+            HugePageMode mode = HugePageMode::Off;
+            if (!HugePages::parse(argv[++i], mode)) {
+                std::fprintf(stderr, "Invalid huge page mode: %s\n", argv[i]);
+                return 1;
+            }
+            HugePages::configure(mode);
+        } else if (arg == "--topology" && i + 1 < argc) {
+            auto topology = ThreadTopology::parse(argv[++i]);
+            if (!topology) {
+                std::fprintf(stderr, "Invalid topology %s: %s\n", argv[i], topology.error().c_str());
+                return 1;
+            }
+            options.topology = std::move(*topology);
+        } else if (arg == "--reactors" && i + 1 < argc) {
+            const std::string_view count = argv[++i];
+            if (std::from_chars(count.data(), count.data() + count.size(), options.reactors).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid reactor count: %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            positional.push_back(argv[i]);
+        }
+        // Kept for a copyover, each option with its value
+        arguments.insert(arguments.end(), argv + first, argv + i + 1);
+    }
+    Logger::instance().setRotation(logRotation);
+    if (positional.size() > 0) {
+        const std::string_view port = positional[0];
+        if (std::from_chars(port.data(), port.data() + port.size(), options.port).ec != std::errc()) {
+            std::fprintf(stderr, "Invalid port: %s\n", positional[0]);
+            return 1;
+        }
+    }
+    if (positional.size() > 1) {
+        options.address = positional[1];
+    }
+
+    if (options.shard.sharded() && options.shardPort == 0) {
+        std::fprintf(stderr, "A shard is reached through the gateway; give --shard-port PORT too\n");
+        return 1;
+    }
+
+    if (options.tlsPort != 0 && (options.tlsCertificate.empty() || options.tlsKey.empty())) {
+        std::fprintf(stderr, "A TLS port needs --tls-cert FILE and --tls-key FILE\n");
+        return 1;
+    }
+
+    if (options.journal && options.accounts.empty()) {
+        std::fprintf(stderr, "The journal is kept beside the accounts; give --accounts DIR too\n");
+        return 1;
+    }
+
+    if (!options.stateSegment.empty() && !options.journal) {
+        std::fprintf(stderr, "The state segment follows the journal; give --journal too\n");
+        return 1;
+    }
+
+    // The world file is mapped and checked while tracing starts; the engine
+    // builds on the world. Failures come back as the message to print
+    StartupPhases<std::string> phases("startup");
+    AreaFile area;
+    std::size_t areaZones = 0;
+    const auto world = phases.add("world file", {}, [&]() -> std::expected<void, std::string> {
+        if (worldFile) {
+            area = AreaFile::open(worldFile);
+            if (!area.valid()) {
+                return std::unexpected(std::format("Invalid world file: {}", worldFile));
+            }
+        }
+        areaZones = area.zoneCount();
+        return {};
+    });
+    // Started before the engine and ended after it, so every thread that
+    // traces has stopped by then
+    std::unique_ptr<TraceLog> trace;
+    const auto traced = phases.add("trace", {}, [&]() -> std::expected<void, std::string> {
+        if (traceFile) {
+            trace = TraceLog::start(traceFile, traceBytes);
+            if (!trace) {
+                return std::unexpected(std::format("Failed to start tracing to {}", traceFile));
+            }
+        }
+        return {};
+    });
+    GameEnginePtr engine;
+    phases.add("engine", {world, traced}, [&]() -> std::expected<void, std::string> {
+        // Before the engine, which seeds its own generator and its Lua states' from it
+        Random::setSeed(seed);
+        // The engine's built-in local player has no connection behind it
+        engine = GameEngine::create("Server", std::move(area));
+        engine->removePlayer(engine->localPlayer());
+        if (socialsFile) {
+            const FileView socials{std::filesystem::path(socialsFile)};
+            if (socials.bytes().empty()) {
+                return std::unexpected(std::format("Failed to read socials file: {}", socialsFile));
+            }
+            if (auto loaded = engine->loadSocials(socials.bytes()); !loaded) {
+                return std::unexpected(std::format("Invalid socials file {}:\n{}", socialsFile, loaded.error()));
+            }
+        }
+        if (behaviorsFile) {
+            const FileView behaviors{std::filesystem::path(behaviorsFile)};
+            if (behaviors.bytes().empty()) {
+                return std::unexpected(std::format("Failed to read behaviors file: {}", behaviorsFile));
+            }
+            if (auto loaded = engine->loadBehaviors(behaviors.bytes()); !loaded) {
+                return std::unexpected(std::format("Invalid behaviors file {}:\n{}", behaviorsFile, loaded.error()));
+            }
+        }
+        return {};
+    });
+    if (const auto started = phases.run(); !started) {
+        std::fprintf(stderr, "%s\n", started.error().c_str());
+        return 1;
+    }
+
+    // Write the world out as an area file, such as to start from the
+    // built-in one, and stop
+    if (exportFile) {
+        if (!AreaFile::write(exportFile, engine->areaSource())) {
+            std::fprintf(stderr, "Failed to write world file: %s\n", exportFile);
+            return 1;
+        }
+        return 0;
+    }
+
+    auto server = NetServer::create(engine, options);
+    if (!server) {
+        std::fprintf(stderr, "%s\n", netErrorToString(server.error()).c_str());
+        return 1;
+    }
+
+    // The callbacks run on the game thread, between its polls
+    NetServer* const running = server->get();
+    std::signal(SIGPIPE, SIG_IGN);
+    for (const int signal : {SIGINT, SIGTERM}) {
+        if (!SignalHandler::registerHandler(signal, [running] { running->requestStop(); })) {
+            std::fprintf(stderr, "Failed to handle signal %d\n", signal);
+            return 1;
+        }
+    }
+    if (!SignalHandler::registerHandler(SIGUSR2, [running] { running->requestCopyover(); })) {
+        std::fprintf(stderr, "Failed to handle signal %d\n", SIGUSR2);
+        return 1;
+    }
+    if (!SignalHandler::registerHandler(SIGHUP, [running] { running->reloadConfig(); })) {
+        std::fprintf(stderr, "Failed to handle signal %d\n", SIGHUP);
+        return 1;
+    }
+
+    std::fprintf(stderr, "EchoMUD listening on %s:%u (%zu %s reactors, seed %llu)\n", options.address.c_str(),
+                 static_cast<unsigned>(options.port), (*server)->reactorCount(),
+                 (*server)->usingIoUring() ? "io_uring" : "poller", static_cast<unsigned long long>(seed));
+    if (HugePages::mode() != HugePageMode::Off) {
+        std::fprintf(stderr, "%s\n", HugePages::report().c_str());
+    }
+    (*server)->run();
+    // Nothing dispatches the callbacks any more; a second Ctrl+C now ends the process
+    for (const int signal : {SIGINT, SIGTERM, SIGUSR2, SIGHUP}) {
+        SignalHandler::unregisterHandler(signal);
+    }
+
+    // Everyone is saved and the sockets are ready to go; only the state
+    // that goes with them is left to write
+    if (std::optional<CopyoverState> handover = (*server)->handover()) {
+        // Its threads and the trace's buffers do not survive the exec
+        server->reset();
+        trace.reset();
+        Logger::instance().flush();
+        const int stateFd = Copyover::save(*handover);
+        if (stateFd >= 0) {
+            std::fprintf(stderr, "Copyover: handing %zu connections to %s\n", handover->sessions.size(),
+                         executable.string().c_str());
+            Copyover::exec(executable, arguments, *handover, stateFd);
+        }
+        std::fprintf(stderr, "Copyover failed: %s\n", std::strerror(errno));
+        return 1;
+    }
+
+    if (const CompressionStats stats = (*server)->compression(); stats.bytesIn > 0) {
+        std::fprintf(stderr, "MCCP2 sent %llu bytes of output as %llu\n",
+                     static_cast<unsigned long long>(stats.bytesIn), static_cast<unsigned long long>(stats.bytesOut));
+    }
+
+    if (const TickStats& ticks = engine->ticks().stats(); ticks.ticks > 0) {
+        std::fprintf(stderr,
+                     "Ran %llu ticks (%llu over budget, %llu boundaries missed) and %llu timers: %.3f ms updates and "
+                     "%.3f ms commands per tick on average, %.3f ms at most; %llu commands run, %llu deferred, "
+                     "%llu dropped, %llu throttled; %llu turns spent waiting; %llu ticks deferring ambient work, "
+                     "%llu throttling commands\n",
+                     static_cast<unsigned long long>(ticks.ticks), static_cast<unsigned long long>(ticks.overruns),
+                     static_cast<unsigned long long>(ticks.missed), static_cast<unsigned long long>(ticks.timersRun),
+                     milliseconds(ticks.updateTime) / ticks.ticks,
+                     milliseconds(ticks.commandTime) / ticks.ticks, milliseconds(ticks.longestTick),
+                     static_cast<unsigned long long>(ticks.commandsRun),
+                     static_cast<unsigned long long>(ticks.commandsDeferred),
+                     static_cast<unsigned long long>(ticks.commandsDropped),
+                     static_cast<unsigned long long>(ticks.commandsThrottled),
+                     static_cast<unsigned long long>(ticks.turnsWaited),
+                     static_cast<unsigned long long>(ticks.ticksDeferring),
+                     static_cast<unsigned long long>(ticks.ticksThrottling));
+    }
+
+    if (const LoginStats* logins = (*server)->logins(); logins && logins->submitted > 0) {
+        std::fprintf(stderr, "Checked %llu logins: %llu accepted, %llu new accounts, %llu wrong passwords, %llu failed\n",
+                     static_cast<unsigned long long>(logins->submitted), static_cast<unsigned long long>(logins->accepted),
+                     static_cast<unsigned long long>(logins->created), static_cast<unsigned long long>(logins->rejected),
+                     static_cast<unsigned long long>(logins->failed));
+    }
+
+    if (const std::optional<SaveStats> saves = (*server)->saves(); saves && saves->submitted > 0) {
+        std::fprintf(stderr, "Saved players %llu times in %llu batches (%llu snapshots coalesced, %llu failed)\n",
+                     static_cast<unsigned long long>(saves->written), static_cast<unsigned long long>(saves->batches),
+                     static_cast<unsigned long long>(saves->coalesced), static_cast<unsigned long long>(saves->failed));
+    }
+
+    if (const std::optional<JournalStats> journal = (*server)->journal(); journal && journal->records > 0) {
+        std::fprintf(stderr,
+                     "Journaled %llu player records in %llu group commits (%llu bytes, %llu syncs, %.3f ms at most; "
+                     "%llu overflowed the ring, %llu failed)\n",
+                     static_cast<unsigned long long>(journal->records), static_cast<unsigned long long>(journal->batches),
+                     static_cast<unsigned long long>(journal->bytes), static_cast<unsigned long long>(journal->syncs),
+                     milliseconds(journal->longestSync), static_cast<unsigned long long>(journal->overflowed),
+                     static_cast<unsigned long long>(journal->failed));
+    }
+
+    if (const std::optional<JournalStats> recording = (*server)->recording(); recording && recording->records > 0) {
+        std::fprintf(stderr, "Recorded %llu session events (%llu bytes) into %s\n",
+                     static_cast<unsigned long long>(recording->records),
+                     static_cast<unsigned long long>(recording->bytes), options.record.c_str());
+    }
+
+    if (const std::optional<CheckpointStats> checkpoints = (*server)->checkpoints();
+        checkpoints && checkpoints->submitted > 0) {
+        std::fprintf(stderr,
+                     "Wrote %llu world checkpoints (%llu skipped, %llu failed), %.3f ms at most; "
+                     "%llu entity pages copied on write\n",
+                     static_cast<unsigned long long>(checkpoints->written),
+                     static_cast<unsigned long long>(checkpoints->skipped),
+                     static_cast<unsigned long long>(checkpoints->failed), milliseconds(checkpoints->longestWrite),
+                     static_cast<unsigned long long>(engine->entities().pagesCopied()));
+    }
+
+    if (const std::uint64_t scrapes = (*server)->metricsScrapes(); scrapes > 0) {
+        std::fprintf(stderr, "Served %llu metrics scrapes\n", static_cast<unsigned long long>(scrapes));
+    }
+
+    if (areaZones > 0) {
+        std::fprintf(stderr, "Loaded %llu of %zu world zones, %zu rooms; unloaded %llu left empty\n",
+                     static_cast<unsigned long long>(engine->npcStats().zonesLoaded), areaZones,
+                     engine->world().size(), static_cast<unsigned long long>(engine->npcStats().zonesUnloaded));
+        ZoneRepopStats total;
+        std::chrono::nanoseconds slowest{};
+        std::size_t slowestZone = 0;
+        const std::vector<ZoneRepopStats> repops = engine->repopStats();
+        for (std::size_t zone = 0; zone < repops.size(); ++zone) {
+            total.spawned += repops[zone].spawned;
+            total.slices += repops[zone].slices;
+            total.time += repops[zone].time;
+            if (repops[zone].time > slowest) {
+                slowest = repops[zone].time;
+                slowestZone = zone;
+            }
+        }
+        if (total.slices > 0) {
+            std::fprintf(stderr, "Spawned %llu area records in %llu slices taking %.3f ms; zone %zu took longest, %.3f ms\n",
+                         static_cast<unsigned long long>(total.spawned), static_cast<unsigned long long>(total.slices),
+                         std::chrono::duration<double, std::milli>(total.time).count(), slowestZone,
+                         std::chrono::duration<double, std::milli>(slowest).count());
+        }
+    }
+
+    if (const InstanceStats& instances = engine->instanceStats(); instances.created > 0) {
+        std::fprintf(stderr, "Opened %llu zone instances (%llu on reused rooms), closed %llu; %llu room copies\n",
+                     static_cast<unsigned long long>(instances.created),
+                     static_cast<unsigned long long>(instances.reused),
+                     static_cast<unsigned long long>(instances.closed),
+                     static_cast<unsigned long long>(instances.rooms));
+    }
+
+    if (const ZoneStats& zones = engine->zoneStats(); zones.batches > 0) {
+        std::fprintf(stderr,
+                     "Zone actors ran %llu batches over %llu zone runs: %llu commands in zones, %llu serially, "
+                     "%llu moves handed between zones\n",
+                     static_cast<unsigned long long>(zones.batches), static_cast<unsigned long long>(zones.zoneRuns),
+                     static_cast<unsigned long long>(zones.commands),
+                     static_cast<unsigned long long>(zones.serialCommands),
+                     static_cast<unsigned long long>(zones.handoffs));
+    }
+
+    if (trace) {
+        const std::uint64_t claimed = trace->chunksClaimed();
+        std::fprintf(stderr, "Traced into %llu of %u chunks of %s%s; read it with tracedump\n",
+                     static_cast<unsigned long long>(std::min<std::uint64_t>(claimed, trace->chunkCount())),
+                     trace->chunkCount(), trace->path().string().c_str(),
+                     claimed > trace->chunkCount() ? ", the oldest overwritten" : "");
+    }
+
+    return 0;
+}
@@ -0,0 +1,287 @@
+#include "../include/GameEngine.h"
+#include "../include/PlayerSave.h"
+#include "../include/SessionRecorder.h"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A recorded event with its own copies of the strings, which the journal's
+// mapping only lends for the length of the callback
+struct Event {
+    RecordedHeader header;
+    std::string name;
+    std::string line;
+};
+
+// FNV-1a over 64 bits, continued from hash
+std::uint64_t mix(std::uint64_t hash, std::string_view bytes) {
+    for (const char c : bytes) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Plays a recording back into an engine: each tick at the boundary it ran
+// at, with what happened during it run from the tick's command runner, and
+// what happened between ticks between them
+class Replay {
+public:
+    Replay(GameEngine& engine, std::span<const Event> events) : m_engine(engine), m_events(events) {
+        // The one session is the replay's; it runs a tick's events at the
+        // point the tick ran the players' lines
+        m_engine.ticks().setRateLimit(0);
+        m_engine.ticks().setCommandRunner([this](SessionId, std::string&) { runTickEvents(); },
+                                          [this] { runBatch(); });
+    }
+
+    ~Replay() { m_engine.ticks().setCommandRunner(nullptr); }
+
+    // speed 0 for as fast as it goes, 1 for the pace it was recorded at
+    void run(double speed) {
+        TickScheduler& ticks = m_engine.ticks();
+        const auto start = Clock::now();
+        const auto first = m_events.empty() ? ticks.boundaryTime(0) : ticks.boundaryTime(m_events[0].header.boundary);
+        while (m_next < m_events.size()) {
+            const Event& event = m_events[m_next++];
+            const RecordedHeader& header = event.header;
+            if (header.kind != RecordedKind::Tick) {
+                // Before the first tick, or between two; one during a tick
+                // the tick's runner has missed is run the same way
+                ticks.setTime(ticks.boundaryTime(header.boundary));
+                apply(event);
+                runBatch();
+                continue;
+            }
+            const auto at = ticks.boundaryTime(header.boundary);
+            if (speed > 0) {
+                std::this_thread::sleep_until(
+                    start + std::chrono::duration_cast<Clock::duration>((at - first) / speed));
+            }
+            // Queued just before the boundary, so the tick runs exactly there
+            ticks.setTime(ticks.boundaryTime(header.boundary > 0 ? header.boundary - 1 : 0));
+            ticks.enqueue(0, {});
+            ticks.run(at);
+            if (ticks.tickCount() != header.tick) {
+                ++m_diverged;
+            }
+            drainMessages();
+        }
+        drainMessages();
+        // Where everyone still playing ended up
+        for (const auto& [name, player] : m_players) {
+            m_checksum = mix(m_checksum, name);
+            m_checksum = mix(m_checksum, std::to_string(m_engine.players().room(player)));
+        }
+        m_elapsed = Clock::now() - start;
+    }
+
+    std::uint64_t ticks() const noexcept { return m_ticks; }
+    std::uint64_t commands() const noexcept { return m_commands; }
+    std::uint64_t joins() const noexcept { return m_joins; }
+    std::uint64_t messages() const noexcept { return m_messages; }
+    std::uint64_t unknown() const noexcept { return m_unknown; }
+    std::uint64_t diverged() const noexcept { return m_diverged; }
+    std::uint64_t checksum() const noexcept { return m_checksum; }
+    std::chrono::nanoseconds elapsed() const noexcept { return m_elapsed; }
+
+private:
+    void runTickEvents() {
+        ++m_ticks;
+        while (m_next < m_events.size() && m_events[m_next].header.kind != RecordedKind::Tick &&
+               m_events[m_next].header.inTick != 0) {
+            apply(m_events[m_next++]);
+        }
+    }
+
+    void apply(const Event& event) {
+        switch (event.header.kind) {
+            case RecordedKind::Join: {
+                const PlayerId player = m_engine.addPlayer(event.name);
+                m_engine.restorePlayer(player, PlayerSave::decode(event.line));
+                m_players.insert_or_assign(event.name, player);
+                ++m_joins;
+                break;
+            }
+            case RecordedKind::Command: {
+                const auto found = m_players.find(event.name);
+                if (found == m_players.end()) {
+                    ++m_unknown;
+                    break;
+                }
+                ++m_commands;
+                // Zone actors run the tick's commands together, as the server does
+                if (m_engine.executionMode() == ExecutionMode::ZoneActors) {
+                    m_batch.push_back({found->second, event.line});
+                    break;
+                }
+                m_checksum = mix(m_checksum, m_engine.handleCommandLine(found->second, event.line).message);
+                break;
+            }
+            case RecordedKind::Leave: {
+                const auto found = m_players.find(event.name);
+                if (found == m_players.end()) {
+                    ++m_unknown;
+                    break;
+                }
+                // Gone before the tick's batch runs, as from the server
+                m_engine.removePlayer(found->second, event.line == "1");
+                m_players.erase(found);
+                break;
+            }
+            case RecordedKind::Tick:
+                break;
+        }
+    }
+
+    void runBatch() {
+        if (m_batch.empty()) {
+            return;
+        }
+        m_engine.runCommands(m_batch);
+        for (const QueuedCommand& command : m_batch) {
+            m_checksum = mix(m_checksum, command.result.message);
+        }
+        m_batch.clear();
+    }
+
+    // What the players would have been sent, in the order they were sent it
+    void drainMessages() {
+        m_engine.takeRecipients(m_recipients);
+        for (const PlayerId player : m_recipients) {
+            m_engine.takeMessages(player, m_sent);
+            for (const SharedMessage& message : m_sent) {
+                m_checksum = mix(m_checksum, *message);
+            }
+            m_messages += m_sent.size();
+        }
+        m_sent.clear();
+    }
+
+    GameEngine& m_engine;
+    std::span<const Event> m_events;
+    std::size_t m_next = 0;
+    std::unordered_map<std::string, PlayerId> m_players;   // By name, while playing
+    std::vector<QueuedCommand> m_batch;
+    std::vector<PlayerId> m_recipients;
+    std::vector<SharedMessage> m_sent;
+
+    std::uint64_t m_ticks = 0;
+    std::uint64_t m_commands = 0;
+    std::uint64_t m_joins = 0;
+    std::uint64_t m_messages = 0;
+    std::uint64_t m_unknown = 0;    // Commands or departures of players the recording never had join
+    std::uint64_t m_diverged = 0;   // Ticks whose number differs from the recording's
+    std::uint64_t m_checksum = 14695981039346656037ull;
+    std::chrono::nanoseconds m_elapsed{};
+};
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+} // namespace
+
+// Usage: mud_replay DIR [--speed FACTOR] [--world FILE] [--zone-actors] [--seed N]
+// Plays back what net_server --record DIR recorded against an engine in
+// this process: every tick at the boundary it ran at and every player's
+// commands in the tick they ran in, so the same recording and world always
+// end in the same checksum. --speed 1 keeps the recorded pace, 2 twice it;
+// the default, 0, runs the ticks back to back. --seed gives the seed the
+// server printed, without which fights and scripts roll differently
+int main(int argc, char** argv) {
+    const char* directory = nullptr;
+    const char* worldFile = nullptr;
+    double speed = 0;
+    bool zoneActors = false;
+    std::uint64_t seed = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--speed" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (std::from_chars(value.data(), value.data() + value.size(), speed).ec != std::errc() || speed < 0) {
+                std::fprintf(stderr, "Invalid speed: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--world" && i + 1 < argc) {
+            worldFile = argv[++i];
+        } else if (arg == "--zone-actors") {
+            zoneActors = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (std::from_chars(value.data(), value.data() + value.size(), seed).ec != std::errc()) {
+                std::fprintf(stderr, "Invalid seed: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (!directory && !arg.starts_with("--")) {
+            directory = argv[i];
+        } else {
+            std::fprintf(stderr, "Usage: mud_replay DIR [--speed FACTOR] [--world FILE] [--zone-actors] [--seed N]\n");
+            return 1;
+        }
+    }
+    if (!directory) {
+        std::fprintf(stderr, "Usage: mud_replay DIR [--speed FACTOR] [--world FILE] [--zone-actors] [--seed N]\n");
+        return 1;
+    }
+
+    std::vector<Event> events;
+    SessionRecorder::read(directory, [&](const RecordedEvent& event) {
+        events.push_back({event.header, std::string(event.name), std::string(event.line)});
+    });
+    if (events.empty()) {
+        std::fprintf(stderr, "No recording in %s\n", directory);
+        return 1;
+    }
+
+    AreaFile area;
+    if (worldFile) {
+        area = AreaFile::open(worldFile);
+        if (!area.valid()) {
+            std::fprintf(stderr, "Invalid world file: %s\n", worldFile);
+            return 1;
+        }
+    }
+    // The server's seed, and its world: a name alone for the one built in
+    Random::setSeed(seed);
+    auto engine = worldFile ? GameEngine::create("Replay", std::move(area)) : GameEngine::create("Replay");
+    engine->removePlayer(engine->localPlayer());
+    if (zoneActors) {
+        engine->setExecutionMode(ExecutionMode::ZoneActors);
+    }
+
+    Replay replay(*engine, events);
+    replay.run(speed);
+
+    const TickStats& ticks = engine->ticks().stats();
+    const double seconds = std::chrono::duration<double>(replay.elapsed()).count();
+    std::printf("Replayed %zu events in %.2f s: %llu ticks, %llu joins, %llu commands (%.0f per second), "
+                "%llu messages\n",
+                events.size(), seconds, static_cast<unsigned long long>(replay.ticks()),
+                static_cast<unsigned long long>(replay.joins()), static_cast<unsigned long long>(replay.commands()),
+                seconds > 0 ? static_cast<double>(replay.commands()) / seconds : 0.0,
+                static_cast<unsigned long long>(replay.messages()));
+    std::printf("Ticks: %.3f ms updates and %.3f ms commands on average, %.3f ms at most\n",
+                ticks.ticks > 0 ? milliseconds(ticks.updateTime) / static_cast<double>(ticks.ticks) : 0.0,
+                ticks.ticks > 0 ? milliseconds(ticks.commandTime) / static_cast<double>(ticks.ticks) : 0.0,
+                milliseconds(ticks.longestTick));
+    std::printf("Checksum %016llx\n", static_cast<unsigned long long>(replay.checksum()));
+    if (replay.unknown() > 0) {
+        std::fprintf(stderr, "%llu events named players the recording never had enter\n",
+                     static_cast<unsigned long long>(replay.unknown()));
+    }
+    if (replay.diverged() > 0) {
+        std::fprintf(stderr, "%llu ticks ran at a different count than recorded; the recording may be cut short\n",
+                     static_cast<unsigned long long>(replay.diverged()));
+    }
+    return replay.unknown() > 0 || replay.diverged() > 0 ? 1 : 0;
+}
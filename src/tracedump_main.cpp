@@ -0,0 +1,44 @@
+#include "../include/TraceLog.h"
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Usage: tracedump [--summary] FILE
+// Prints a trace written by net_server --trace, one event per line in time
+// order: milliseconds since the trace started, the thread and the event
+int main(int argc, char** argv) {
+    bool summaryOnly = false;
+    const char* input = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--summary") {
+            summaryOnly = true;
+        } else {
+            input = argv[i];
+        }
+    }
+    if (!input) {
+        std::fprintf(stderr, "Usage: tracedump [--summary] FILE\n");
+        return 1;
+    }
+
+    const TraceReader reader = TraceReader::open(input);
+    if (!reader.valid()) {
+        std::fprintf(stderr, "%s: missing or not a trace file\n", input);
+        return 1;
+    }
+    if (!summaryOnly) {
+        for (const TraceReader::Entry& entry : reader.entries()) {
+            const std::string text = reader.format(*entry.record);
+            std::printf("%14.6f  t%-3u %s\n", static_cast<double>(entry.nanoseconds) / 1e6, entry.thread, text.c_str());
+        }
+    }
+
+    const TraceFileHeader& header = reader.header();
+    const std::uint64_t claimed = header.nextChunk;
+    std::fprintf(stderr, "%zu records of %zu trace points from %llu of %u chunks%s\n", reader.entries().size(),
+                 reader.eventCount(),
+                 static_cast<unsigned long long>(claimed < header.chunkCount ? claimed : header.chunkCount),
+                 header.chunkCount, claimed > header.chunkCount ? ", the oldest overwritten" : "");
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "../include/AreaCompiler.h"
+#include "../include/AreaFile.h"
+#include "../include/FileView.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Usage: worldc [-o OUTPUT] AREA...
+// Compiles text areas (see AreaCompiler.h) into one area file for
+// net_server --world; OUTPUT defaults to world.area
+int main(int argc, char** argv) {
+    std::string output = "world.area";
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    if (inputs.empty()) {
+        std::fprintf(stderr, "Usage: worldc [-o OUTPUT] AREA...\n");
+        return 1;
+    }
+
+    AreaCompiler compiler;
+    for (const char* input : inputs) {
+        const FileView text{std::filesystem::path(input)};
+        if (text.bytes().empty()) {
+            std::fprintf(stderr, "%s: missing or empty\n", input);
+            return 1;
+        }
+        compiler.add(text.bytes(), input);
+    }
+    const std::optional<AreaSource> source = compiler.finish();
+    for (const std::string& error : compiler.errors()) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+    }
+    if (!source) {
+        return 1;
+    }
+    if (!AreaFile::write(output, *source)) {
+        std::fprintf(stderr, "Failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    // Read it back as the server will, which also checks the layout
+    const AreaFile area = AreaFile::open(output);
+    if (!area.valid()) {
+        std::fprintf(stderr, "%s was written but does not read back\n", output.c_str());
+        return 1;
+    }
+    const AreaHeader& header = area.header();
+    std::fprintf(stderr,
+                 "Compiled %zu rooms in %zu zones, %u item prototypes, %u NPCs and %u items into %s "
+                 "(%llu bytes, %u of them strings)\n",
+                 area.roomCount(), area.zoneCount(), header.prototypes.count, header.npcs.count, header.items.count,
+                 output.c_str(), static_cast<unsigned long long>(header.fileSize), header.strings.count);
+    if (!area.packedRooms().empty()) {
+        const auto packed = std::count(area.packedRooms().begin(), area.packedRooms().end(), std::uint8_t{1});
+        std::fprintf(stderr, "Packed %td room descriptions, %llu bytes as text, against a %zu-byte dictionary\n",
+                     packed, static_cast<unsigned long long>(header.packedTextSize), area.dictionary().size());
+    }
+    return 0;
+}